@@ -50,7 +50,13 @@ typedef enum {
   // number of V-cycles
   NUM_VCYCLES,
   // disables or enables logging
-  VERBOSE
+  VERBOSE,
+  // computes a first partition with label propagation only, which is improved in V-cycles
+  ANYTIME,
+  // maximum number of partitions kept in the in-memory result cache (0 = disabled)
+  RESULT_CACHE_SIZE,
+  // directory in which computed partitions are cached (empty = disabled)
+  RESULT_CACHE_DIRECTORY
 } mt_kahypar_context_parameter_type_t;
 
 /**
@@ -71,9 +77,86 @@ typedef enum {
   SPEED,
   // extends speed preset with flow-based refinement
   // -> computes high-quality partitions (corresponds to Mt-KaHyPar-D-F)
-  HIGH_QUALITY
+  HIGH_QUALITY,
+  // n-level partitioning mode (corresponds to Mt-KaHyPar-Q)
+  QUALITY,
+  // extends quality preset with flow-based refinement
+  // -> computes the best partitions, but is slower (corresponds to Mt-KaHyPar-Q-F)
+  HIGHEST_QUALITY
 } mt_kahypar_preset_type_t;
 
+/**
+ * Phases reported to the progress callback.
+ */
+typedef enum {
+  PHASE_COARSENING,
+  PHASE_INITIAL_PARTITIONING,
+  // reported after each level of the uncoarsening phase
+  PHASE_REFINEMENT,
+  PHASE_VCYCLE,
+  PHASE_FINISHED
+} mt_kahypar_progress_phase_t;
+
+/**
+ * Progress update passed to the progress callback.
+ */
+typedef struct {
+  mt_kahypar_progress_phase_t phase;
+  // number of the current V-cycle (0 = initial multilevel cycle)
+  size_t vcycle;
+  // current level of the hierarchy during refinement (0 = input (hyper)graph)
+  size_t level;
+  size_t num_levels;
+  // objective (km1 or cut) and imbalance of the current partition (-1, if there is no partition yet)
+  mt_kahypar_hyperedge_weight_t objective;
+  double imbalance;
+  // seconds since the start of the partitioning call
+  double elapsed_seconds;
+} mt_kahypar_progress_t;
+
+/**
+ * Progress callback. Returning false requests the partitioner to stop as soon as possible
+ * (the current partition is still returned).
+ */
+typedef bool (*mt_kahypar_progress_callback_t)(const mt_kahypar_progress_t* progress, void* user_data);
+
+/**
+ * Current level of the uncoarsening phase passed to the refinement callback. The partition is a
+ * view of the block IDs stored in the partitioned (hyper)graph. The incidence structure is exported
+ * once per level in CSR format, i.e., the pins of hyperedge e are pins[hyperedge_indices[e]] ...
+ * pins[hyperedge_indices[e + 1] - 1]. All pointers are only valid during the callback.
+ * Disabled nodes and hyperedges (e.g., removed degree-zero nodes) have no pins and no incident nets.
+ */
+typedef struct {
+  // current level of the hierarchy (0 = input (hyper)graph)
+  size_t level;
+  size_t num_levels;
+  mt_kahypar_partition_id_t num_blocks;
+  mt_kahypar_hypernode_id_t num_nodes;
+  mt_kahypar_hyperedge_id_t num_edges;
+  const size_t* hyperedge_indices;
+  const mt_kahypar_hypernode_id_t* pins;
+  const size_t* incident_net_indices;
+  const mt_kahypar_hyperedge_id_t* incident_nets;
+  const mt_kahypar_hypernode_weight_t* node_weights;
+  const mt_kahypar_hyperedge_weight_t* edge_weights;
+  const mt_kahypar_partition_id_t* partition;
+  const mt_kahypar_hypernode_weight_t* block_weights;
+  const mt_kahypar_hypernode_weight_t* max_block_weights;
+  // internal state (see mt_kahypar_refinement_level_pin_count_in_part(...))
+  const void* internal;
+} mt_kahypar_refinement_level_t;
+
+/**
+ * Refinement callback. The callback writes the moves it wants to perform into nodes and blocks
+ * (at most num_nodes moves, each node at most once) and returns the number of moves. Moves that
+ * violate the maximum allowed block weight of their target block are skipped.
+ */
+typedef size_t (*mt_kahypar_refinement_callback_t)(const mt_kahypar_refinement_level_t* level,
+                                                   mt_kahypar_hypernode_id_t* nodes,
+                                                   mt_kahypar_partition_id_t* blocks,
+                                                   void* user_data);
+
 
 // ####################### Setup Context #######################
 
@@ -96,7 +179,8 @@ MT_KAHYPAR_API void mt_kahypar_configure_context_from_file(mt_kahypar_context_t*
 /**
  * Loads a partitioning context of a predefined preset type.
  * Possible preset types are DETERMINISTIC (corresponds to Mt-KaHyPar-SDet),
- * SPEED (corresponds to Mt-KaHyPar-D) and HIGH_QUALITY (corresponds to Mt-KaHyPar-D-F)
+ * SPEED (corresponds to Mt-KaHyPar-D), HIGH_QUALITY (corresponds to Mt-KaHyPar-D-F),
+ * QUALITY (corresponds to Mt-KaHyPar-Q) and HIGHEST_QUALITY (corresponds to Mt-KaHyPar-Q-F)
  */
 MT_KAHYPAR_API void mt_kahypar_load_preset(mt_kahypar_context_t* context,
                                            const mt_kahypar_preset_type_t preset);
@@ -123,6 +207,33 @@ MT_KAHYPAR_API void mt_kahypar_set_partitioning_parameters(mt_kahypar_context_t*
                                                            const mt_kahypar_objective_t objective,
                                                            const size_t seed);
 
+/**
+ * Registers a callback that receives phase transitions and the metrics of the current partition
+ * after each level of the uncoarsening phase (in direct k-way mode). The callback is called on the
+ * thread that runs the partitioning call and should return quickly. Passing NULL removes the callback.
+ */
+MT_KAHYPAR_API void mt_kahypar_set_progress_callback(mt_kahypar_context_t* context,
+                                                     mt_kahypar_progress_callback_t callback,
+                                                     void* user_data);
+
+/**
+ * Registers an external refiner that is called on each level of the uncoarsening phase after the
+ * built-in refiners (multilevel partitioners in direct k-way mode only). The moves returned by the
+ * callback are applied by the partitioner such that all internal data structures stay consistent.
+ * The callback is called on a thread of the partitioner. Passing NULL removes the callback.
+ */
+MT_KAHYPAR_API void mt_kahypar_set_refinement_callback(mt_kahypar_context_t* context,
+                                                       mt_kahypar_refinement_callback_t callback,
+                                                       void* user_data);
+
+/**
+ * Returns the number of pins of a hyperedge in a block on the current level
+ * (may only be called during the refinement callback).
+ */
+MT_KAHYPAR_API mt_kahypar_hypernode_id_t mt_kahypar_refinement_level_pin_count_in_part(const mt_kahypar_refinement_level_t* level,
+                                                                                      const mt_kahypar_hyperedge_id_t he,
+                                                                                      const mt_kahypar_partition_id_t block);
+
 /**
  * Sets individual target block weights for each block of the partition.
  * A balanced partition then satisfies that the weight of each block is smaller or equal than the
@@ -135,16 +246,58 @@ MT_KAHYPAR_API void mt_kahypar_set_individual_target_block_weights(mt_kahypar_co
 
 // ####################### Thread Pool Initialization #######################
 
+/**
+ * Initializes the global thread pool with the given number of threads. Calling the function
+ * again changes the number of threads of the global thread pool. This must not happen while
+ * partitioning calls are running.
+ */
 MT_KAHYPAR_API void mt_kahypar_initialize_thread_pool(const size_t num_threads,
                                                       const bool interleaved_allocations);
 
+/**
+ * Creates a thread pool with its own thread budget. Partitioning calls with a context
+ * assigned to the thread pool (see mt_kahypar_set_thread_pool(...)) use at most num_threads
+ * threads and do not compete with calls running in other thread pools for work. This allows
+ * to run several partitioning calls side by side (e.g., in separate threads or with
+ * mt_kahypar_partition_hypergraph_async(...)) with isolated core allocations.
+ *
+ * If cpus is not NULL, it must contain num_threads CPU IDs and the threads of the pool are
+ * pinned to these CPUs.
+ *
+ * \note The threads of all thread pools are drawn from the global thread pool
+ *       (see mt_kahypar_initialize_thread_pool(...)). Thus, num_threads is limited by the
+ *       size of the global thread pool, which should be at least as large as the total
+ *       number of threads of all thread pools used concurrently.
+ */
+MT_KAHYPAR_API mt_kahypar_thread_pool_t* mt_kahypar_thread_pool_new(const size_t num_threads,
+                                                                    const int* cpus);
+
+/**
+ * Releases the thread pool handle. The thread pool is destroyed once no context uses it anymore.
+ */
+MT_KAHYPAR_API void mt_kahypar_free_thread_pool(mt_kahypar_thread_pool_t* thread_pool);
+
+/**
+ * Executes all partitioning calls with the given context in the thread pool
+ * (NULL = global thread pool). The number of threads of the context is set to the
+ * size of the thread pool. Batch calls (see mt_kahypar_partition_hypergraphs(...))
+ * ignore the thread pool of their contexts.
+ */
+MT_KAHYPAR_API void mt_kahypar_set_thread_pool(mt_kahypar_context_t* context,
+                                               mt_kahypar_thread_pool_t* thread_pool);
+
 // ####################### Load/Construct Hypergraph #######################
 
 /**
  * Reads a (hyper)graph from a file. The file can be either in hMetis or Metis file format.
  *
- * \note Note that for deterministic partitioning, you must call
- *       mt_kahypar_load_preset(context, DETERMINISTIC) before reading the hypergraph.
+ * The data structure used to represent the input is selected at runtime based on the file format
+ * and the given context: n-level presets (QUALITY and HIGHEST_QUALITY) use a dynamic data structure,
+ * all other presets a static one. Inputs in Metis format read with mt_kahypar_read_hypergraph_from_file(...)
+ * are represented as plain graphs.
+ *
+ * \note Note that for deterministic or n-level partitioning, you must call mt_kahypar_load_preset(...)
+ *       with the corresponding preset type before reading the hypergraph.
  * \note When reading a hMetis file with mt_kahypar_read_graph_from_file(...), make sure that
  *       the file represents graph. Otherwise, your program terminates.
  */
@@ -165,6 +318,8 @@ MT_KAHYPAR_API mt_kahypar_graph_t* mt_kahypar_read_graph_from_file(const char* f
  *
  * \note For unweighted hypergraphs, you can pass nullptr to either hyperedge_weights or vertex_weights.
  * \note After construction, the arguments of this function are no longer needed and can be deleted.
+ * \note The hypergraph uses a static data structure and can not be partitioned with the n-level presets
+ *       (QUALITY and HIGHEST_QUALITY).
  */
 MT_KAHYPAR_API mt_kahypar_hypergraph_t* mt_kahypar_create_hypergraph(const mt_kahypar_hypernode_id_t num_vertices,
                                                                      const mt_kahypar_hyperedge_id_t num_hyperedges,
@@ -182,6 +337,8 @@ MT_KAHYPAR_API mt_kahypar_hypergraph_t* mt_kahypar_create_hypergraph(const mt_ka
  *
  * \note For unweighted graphs, you can pass nullptr to either hyperedge_weights or vertex_weights.
  * \note After construction, the arguments of this function are no longer needed and can be deleted.
+ * \note The graph uses a static data structure and can not be partitioned with the n-level presets
+ *       (QUALITY and HIGHEST_QUALITY).
  */
 MT_KAHYPAR_API mt_kahypar_graph_t* mt_kahypar_create_graph(const mt_kahypar_hypernode_id_t num_vertices,
                                                            const mt_kahypar_hyperedge_id_t num_edges,
@@ -189,6 +346,67 @@ MT_KAHYPAR_API mt_kahypar_graph_t* mt_kahypar_create_graph(const mt_kahypar_hype
                                                            const mt_kahypar_hyperedge_weight_t* edge_weights,
                                                            const mt_kahypar_hypernode_weight_t* vertex_weights);
 
+/**
+ * Constructs a graph from its adjacency arrays in CSR format (as used by Metis).
+ * The neighbors of vertex u are stored in adjncy[xadj[u]], ..., adjncy[xadj[u + 1] - 1]
+ * and each edge must occur in the adjacency arrays of both of its endpoints.
+ *
+ * Example:
+ * xadj:         | 0 2 4 6 8 |
+ * adjncy:       | 1 2 | 0 3 | 0 3 | 1 2 |
+ * Defines a graph with four edges -> e_0 = {0,1}, e_1 = {0,2}, e_2 = {1,3}, e_3 = {2,3}
+ *
+ * \note For unweighted graphs, you can pass nullptr to either adjacency_weights or vertex_weights.
+ *       The weights in adjacency_weights are given per adjacency entry (as adjwgt in Metis).
+ * \note The graph is constructed directly from the adjacency arrays without an intermediate
+ *       edge list. After construction, the arguments of this function are no longer needed
+ *       and can be deleted.
+ * \note The graph uses a static data structure and can not be partitioned with the n-level presets
+ *       (QUALITY and HIGHEST_QUALITY).
+ */
+MT_KAHYPAR_API mt_kahypar_graph_t* mt_kahypar_create_graph_from_csr(const mt_kahypar_hypernode_id_t num_vertices,
+                                                                    const size_t* xadj,
+                                                                    const mt_kahypar_hypernode_id_t* adjncy,
+                                                                    const mt_kahypar_hyperedge_weight_t* adjacency_weights,
+                                                                    const mt_kahypar_hypernode_weight_t* vertex_weights);
+
+/**
+ * Creates a builder for a hypergraph with num_vertices vertices, whose hyperedges are
+ * added incrementally with mt_kahypar_hypergraph_builder_add_hyperedge(...). This avoids
+ * assembling the complete adjacency array required by mt_kahypar_create_hypergraph(...).
+ *
+ * \note For unweighted hypergraphs, you can pass nullptr to vertex_weights.
+ * \note The hypergraph uses a static data structure and can not be partitioned with the n-level presets
+ *       (QUALITY and HIGHEST_QUALITY).
+ */
+MT_KAHYPAR_API mt_kahypar_hypergraph_builder_t* mt_kahypar_hypergraph_builder_new(const mt_kahypar_hypernode_id_t num_vertices,
+                                                                                  const mt_kahypar_hypernode_weight_t* vertex_weights);
+
+/**
+ * Adds a hyperedge with the given pins to the builder. The function is thread-safe, i.e.,
+ * several threads can add hyperedges concurrently. Each thread appends its hyperedges to
+ * its own buffers. The hyperedges of one thread keep their relative order, whereas the
+ * order between different threads is unspecified.
+ *
+ * \note After the call, the pins are no longer needed and can be deleted.
+ */
+MT_KAHYPAR_API void mt_kahypar_hypergraph_builder_add_hyperedge(mt_kahypar_hypergraph_builder_t* builder,
+                                                                const mt_kahypar_hypernode_id_t* pins,
+                                                                const size_t num_pins,
+                                                                const mt_kahypar_hyperedge_weight_t weight);
+
+/**
+ * Constructs the hypergraph from all hyperedges added to the builder. Afterwards, the
+ * builder is empty, but must still be deleted with mt_kahypar_free_hypergraph_builder(...).
+ *
+ * \note Must not be called concurrently with mt_kahypar_hypergraph_builder_add_hyperedge(...).
+ */
+MT_KAHYPAR_API mt_kahypar_hypergraph_t* mt_kahypar_hypergraph_builder_finalize(mt_kahypar_hypergraph_builder_t* builder);
+
+/**
+ * Deletes the builder object.
+ */
+MT_KAHYPAR_API void mt_kahypar_free_hypergraph_builder(mt_kahypar_hypergraph_builder_t* builder);
 
 /**
  * Deletes the (hyper)graph object.
@@ -219,6 +437,17 @@ MT_KAHYPAR_API mt_kahypar_hypernode_id_t mt_kahypar_num_pins(mt_kahypar_hypergra
 MT_KAHYPAR_API mt_kahypar_hypernode_id_t mt_kahypar_hypergraph_weight(mt_kahypar_hypergraph_t* hypergraph);
 MT_KAHYPAR_API mt_kahypar_hypernode_id_t mt_kahypar_graph_weight(mt_kahypar_graph_t* graph);
 
+/**
+ * Fixes node i of the (hyper)graph to block fixed_vertices[i] (-1 = not fixed).
+ *
+ * \note Fixed vertices are only supported in the (non-deterministic) direct k-way mode
+ *       and not with the n-level presets (QUALITY and HIGHEST_QUALITY).
+ */
+MT_KAHYPAR_API void mt_kahypar_add_fixed_vertices(mt_kahypar_hypergraph_t* hypergraph,
+                                                  const mt_kahypar_partition_id_t* fixed_vertices);
+MT_KAHYPAR_API void mt_kahypar_add_fixed_nodes(mt_kahypar_graph_t* graph,
+                                               const mt_kahypar_partition_id_t* fixed_nodes);
+
 // ####################### Partition #######################
 
 /**
@@ -233,6 +462,77 @@ MT_KAHYPAR_API mt_kahypar_partitioned_hypergraph_t* mt_kahypar_partition_hypergr
 MT_KAHYPAR_API mt_kahypar_partitioned_graph_t* mt_kahypar_partition_graph(mt_kahypar_graph_t* graph,
                                                                           mt_kahypar_context_t* context);
 
+/**
+ * Partitions several (hyper)graphs concurrently. The i-th (hyper)graph is partitioned according
+ * to the i-th partitioning context and the result is stored in partitioned_hypergraphs[i].
+ * Each job runs with a budget of num_threads_per_job threads (e.g., one for small instances).
+ * All jobs share the thread pool, and idle threads steal work from other jobs. If num_threads_per_job
+ * is zero, the threads of the thread pool are evenly distributed among the jobs.
+ * This is useful for many small (hyper)graphs, where a single call can not utilize all threads.
+ *
+ * \note Each job requires its own partitioning context.
+ * \note The random number generators are seeded once with the seed of the first context.
+ */
+MT_KAHYPAR_API void mt_kahypar_partition_hypergraphs(mt_kahypar_hypergraph_t** hypergraphs,
+                                                     mt_kahypar_context_t** contexts,
+                                                     const size_t num_hypergraphs,
+                                                     const size_t num_threads_per_job,
+                                                     mt_kahypar_partitioned_hypergraph_t** partitioned_hypergraphs);
+MT_KAHYPAR_API void mt_kahypar_partition_graphs(mt_kahypar_graph_t** graphs,
+                                                mt_kahypar_context_t** contexts,
+                                                const size_t num_graphs,
+                                                const size_t num_threads_per_job,
+                                                mt_kahypar_partitioned_graph_t** partitioned_graphs);
+
+/**
+ * Starts partitioning a (hyper)graph in the background and returns immediately. The job can be
+ * polled, cancelled and waited for. If time_limit is positive, the job is cancelled once the
+ * time limit (in seconds) is exceeded. A cancelled job stops all remaining work at the next
+ * safe point (e.g., after the current refinement round) and still returns a valid partition.
+ *
+ * \note The (hyper)graph must not be modified or freed until the job is finished.
+ * \note The partitioning context is copied and can be reused immediately.
+ * \note As for all other partitioning calls, only one job can run at a time.
+ */
+MT_KAHYPAR_API mt_kahypar_partitioning_job_t* mt_kahypar_partition_hypergraph_async(mt_kahypar_hypergraph_t* hypergraph,
+                                                                                    mt_kahypar_context_t* context,
+                                                                                    const double time_limit);
+MT_KAHYPAR_API mt_kahypar_partitioning_job_t* mt_kahypar_partition_graph_async(mt_kahypar_graph_t* graph,
+                                                                               mt_kahypar_context_t* context,
+                                                                               const double time_limit);
+
+/**
+ * Returns true, if the partitioning job is finished.
+ */
+MT_KAHYPAR_API bool mt_kahypar_poll_partitioning_job(mt_kahypar_partitioning_job_t* job);
+
+/**
+ * Copies the best partition found so far by the partitioning job into the given array (one entry per node)
+ * and returns its version. The version is increased each time the job finds an improved partition. If the
+ * job has not found a partition yet, zero is returned and the array is not modified.
+ *
+ * \note In anytime mode (see ANYTIME), a first partition is available early and improved in the V-cycles.
+ */
+MT_KAHYPAR_API size_t mt_kahypar_get_partitioning_job_snapshot(mt_kahypar_partitioning_job_t* job,
+                                                               mt_kahypar_partition_id_t* partition);
+
+/**
+ * Requests the partitioning job to stop as soon as possible.
+ */
+MT_KAHYPAR_API void mt_kahypar_cancel_partitioning_job(mt_kahypar_partitioning_job_t* job);
+
+/**
+ * Waits until the partitioning job is finished and returns the partitioned (hyper)graph.
+ * The ownership of the partitioned (hyper)graph is passed to the caller. Can only be called once.
+ */
+MT_KAHYPAR_API mt_kahypar_partitioned_hypergraph_t* mt_kahypar_wait_hypergraph_partitioning_job(mt_kahypar_partitioning_job_t* job);
+MT_KAHYPAR_API mt_kahypar_partitioned_graph_t* mt_kahypar_wait_graph_partitioning_job(mt_kahypar_partitioning_job_t* job);
+
+/**
+ * Cancels the partitioning job (if still running), waits for it and frees all its resources.
+ */
+MT_KAHYPAR_API void mt_kahypar_free_partitioning_job(mt_kahypar_partitioning_job_t* job);
+
 /**
  * Improves a given partition (using the V-cycle technique).
  *
@@ -247,6 +547,86 @@ MT_KAHYPAR_API void mt_kahypar_improve_graph_partition(mt_kahypar_partitioned_gr
                                                        mt_kahypar_context_t* context,
                                                        const size_t num_vcycles);
 
+/**
+ * Partitions an updated (hyper)graph starting from the partition of a previous run, e.g.,
+ * after hyperedges were inserted or deleted and vertex weights changed.
+ * previous_partition[v] must contain the block of vertex v in the previous partition or
+ * MT_KAHYPAR_NEW_VERTEX, if v was inserted since then. Inserted vertices are assigned to
+ * the block to which they are most strongly connected and afterwards, num_vcycles V-cycles
+ * are performed to improve the resulting partition (num_vcycles = 0 only projects the
+ * previous partition).
+ *
+ * \note The number of blocks specified in the partitioning context must be equal to the
+ *       number of blocks of the previous partition.
+ * \note The balance constraint is not guaranteed to hold if vertex weights changed significantly.
+ */
+MT_KAHYPAR_API mt_kahypar_partitioned_hypergraph_t* mt_kahypar_repartition_hypergraph(mt_kahypar_hypergraph_t* hypergraph,
+                                                                                      mt_kahypar_context_t* context,
+                                                                                      const mt_kahypar_partition_id_t* previous_partition,
+                                                                                      const size_t num_vcycles);
+MT_KAHYPAR_API mt_kahypar_partitioned_graph_t* mt_kahypar_repartition_graph(mt_kahypar_graph_t* graph,
+                                                                            mt_kahypar_context_t* context,
+                                                                            const mt_kahypar_partition_id_t* previous_partition,
+                                                                            const size_t num_vcycles);
+
+/**
+ * Computes a partition of the (hyper)graph for each of the num_targets (k, epsilon) targets given
+ * by num_blocks[i] and epsilons[i]. Preprocessing and coarsening are performed only once
+ * and all targets share the resulting multilevel hierarchy. The block of vertex v in the
+ * partition of the i-th target is written to partitions[i * num_nodes + v].
+ *
+ * \note The number of blocks and the imbalance specified in the partitioning context are ignored.
+ * \note Only supported for the multilevel presets.
+ */
+MT_KAHYPAR_API void mt_kahypar_partition_hypergraph_for_targets(mt_kahypar_hypergraph_t* hypergraph,
+                                                                mt_kahypar_context_t* context,
+                                                                const size_t num_targets,
+                                                                const mt_kahypar_partition_id_t* num_blocks,
+                                                                const double* epsilons,
+                                                                mt_kahypar_partition_id_t* partitions);
+MT_KAHYPAR_API void mt_kahypar_partition_graph_for_targets(mt_kahypar_graph_t* graph,
+                                                           mt_kahypar_context_t* context,
+                                                           const size_t num_targets,
+                                                           const mt_kahypar_partition_id_t* num_blocks,
+                                                           const double* epsilons,
+                                                           mt_kahypar_partition_id_t* partitions);
+
+// ####################### Partitioner Session #######################
+
+/**
+ * Creates a new partitioner session. Partitioning calls within a session allocate their large
+ * internal data structures from a memory pool that keeps its memory after each call. The memory
+ * pool grows to the size required by the largest (hyper)graph partitioned so far and subsequent
+ * calls reuse its memory. This avoids the cost of allocating (and page-faulting) that memory on
+ * each call when many (hyper)graphs are partitioned one after another.
+ *
+ * \note The thread pool is shared by all calls and must be initialized before
+ *       (see mt_kahypar_initialize_thread_pool(...)).
+ * \note Calls of a session are executed one after another. They must not run concurrently
+ *       with other partitioning calls of this library.
+ */
+MT_KAHYPAR_API mt_kahypar_session_t* mt_kahypar_session_new();
+
+/**
+ * Deletes the session and frees the memory held by it.
+ */
+MT_KAHYPAR_API void mt_kahypar_free_session(mt_kahypar_session_t* session);
+
+/**
+ * Partitions a (hyper)graph according to the parameters specified in the partitioning context
+ * and writes the block of each vertex to partition (the array must have one entry per vertex).
+ * In contrast to mt_kahypar_partition_hypergraph(...), the partitioned (hyper)graph is not returned.
+ * This allows the session to reuse all internal data structures in the next call.
+ */
+MT_KAHYPAR_API void mt_kahypar_session_partition_hypergraph(mt_kahypar_session_t* session,
+                                                            mt_kahypar_hypergraph_t* hypergraph,
+                                                            mt_kahypar_context_t* context,
+                                                            mt_kahypar_partition_id_t* partition);
+MT_KAHYPAR_API void mt_kahypar_session_partition_graph(mt_kahypar_session_t* session,
+                                                       mt_kahypar_graph_t* graph,
+                                                       mt_kahypar_context_t* context,
+                                                       mt_kahypar_partition_id_t* partition);
+
 /**
  * Constructs a partitioned (hyper)graph out of the given partition.
  */
@@ -258,7 +638,7 @@ MT_KAHYPAR_API mt_kahypar_partitioned_graph_t* mt_kahypar_create_partitioned_gra
                                                                                    const mt_kahypar_partition_id_t* partition);
 
 /**
- * Constructs a partitioned (hyper)graph from a given partition file.
+ * Constructs a partitioned (hyper)graph from a given partition file (text or binary format).
  */
 MT_KAHYPAR_API mt_kahypar_partitioned_hypergraph_t* mt_kahypar_read_hypergraph_partition_from_file(mt_kahypar_hypergraph_t* hypergraph,
                                                                                                    const mt_kahypar_partition_id_t num_blocks,
@@ -275,6 +655,15 @@ MT_KAHYPAR_API void mt_kahypar_write_hypergraph_partition_to_file(const mt_kahyp
 MT_KAHYPAR_API void mt_kahypar_write_graph_partition_to_file(const mt_kahypar_partitioned_graph_t* partitioned_graph,
                                                              const char* partition_file);
 
+/**
+ * Writes a partition to a file in binary format (header followed by an int32 array
+ * of the block IDs). The read functions above detect the format automatically.
+ */
+MT_KAHYPAR_API void mt_kahypar_write_hypergraph_partition_to_binary_file(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
+                                                                         const char* partition_file);
+MT_KAHYPAR_API void mt_kahypar_write_graph_partition_to_binary_file(const mt_kahypar_partitioned_graph_t* partitioned_graph,
+                                                                    const char* partition_file);
+
 /**
  * Extracts a partition from a partitioned (hyper)graph.
  */
@@ -283,6 +672,14 @@ MT_KAHYPAR_API void mt_kahypar_get_hypergraph_partition(const mt_kahypar_partiti
 MT_KAHYPAR_API void mt_kahypar_get_graph_partition(const mt_kahypar_partitioned_graph_t* partitioned_graph,
                                                    mt_kahypar_partition_id_t* partition);
 
+/**
+ * Returns the block IDs of all nodes without copying them. The array is owned by the
+ * partitioned (hyper)graph. It remains valid until the partitioned (hyper)graph is freed
+ * and reflects all subsequent changes of the partition.
+ */
+MT_KAHYPAR_API const mt_kahypar_partition_id_t* mt_kahypar_get_hypergraph_partition_view(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg);
+MT_KAHYPAR_API const mt_kahypar_partition_id_t* mt_kahypar_get_graph_partition_view(const mt_kahypar_partitioned_graph_t* partitioned_graph);
+
 /**
  * Extracts the weight of each block from a partition.
  */
@@ -315,6 +712,45 @@ MT_KAHYPAR_API mt_kahypar_hyperedge_weight_t mt_kahypar_km1(const mt_kahypar_par
  */
 MT_KAHYPAR_API mt_kahypar_hyperedge_weight_t mt_kahypar_soed(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg);
 
+/**
+ * Computes the sum of the weights of all hyperedges that connect two blocks for each pair of blocks
+ * and writes the pairs with a non-zero cut weight as a sparse list of (block_0, block_1, weight)
+ * triplets with block_0 < block_1, sorted by block pair, into the given arrays. Returns the number
+ * of such pairs. At most max_entries pairs are written, i.e., the list can be queried in two calls
+ * by passing null arrays first.
+ *
+ * \note A hyperedge with connectivity l contributes to all l * (l - 1) / 2 pairs of blocks it connects.
+ */
+MT_KAHYPAR_API size_t mt_kahypar_get_hypergraph_block_pair_cuts(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
+                                                                mt_kahypar_partition_id_t* block_0,
+                                                                mt_kahypar_partition_id_t* block_1,
+                                                                mt_kahypar_hyperedge_weight_t* weights,
+                                                                const size_t max_entries);
+MT_KAHYPAR_API size_t mt_kahypar_get_graph_block_pair_cuts(const mt_kahypar_partitioned_graph_t* partitioned_graph,
+                                                           mt_kahypar_partition_id_t* block_0,
+                                                           mt_kahypar_partition_id_t* block_1,
+                                                           mt_kahypar_hyperedge_weight_t* weights,
+                                                           const size_t max_entries);
+
+/**
+ * Writes a JSON report of the partitioning run that computed the partition into the given buffer
+ * and returns the length of the report (without the terminating null character). The report contains
+ * the quality metrics, the hierarchical timings, the collected statistics, the objective before and after
+ * each refiner on each level and the memory consumption of the partition. At most buffer_size bytes
+ * (including the terminating null character) are written, i.e., the report can be queried in two calls
+ * by passing a null buffer first.
+ *
+ * \note The context must be the one used for partitioning.
+ */
+MT_KAHYPAR_API size_t mt_kahypar_get_hypergraph_report(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
+                                                       const mt_kahypar_context_t* context,
+                                                       char* buffer,
+                                                       const size_t buffer_size);
+MT_KAHYPAR_API size_t mt_kahypar_get_graph_report(const mt_kahypar_partitioned_graph_t* partitioned_graph,
+                                                  const mt_kahypar_context_t* context,
+                                                  char* buffer,
+                                                  const size_t buffer_size);
+
 
 /**
  * Deletes the partitioned (hyper)graph object.
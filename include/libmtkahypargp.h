@@ -61,6 +61,28 @@ MT_KAHYPAR_API mt_kahypar_graph_t* mt_kahypar_create_graph(const mt_kahypar_hype
                                                            const mt_kahypar_hyperedge_weight_t* edge_weights,
                                                            const mt_kahypar_hypernode_weight_t* vertex_weights);
 
+/**
+ * Constructs a graph from its adjacency arrays in CSR format (as used by Metis).
+ * The neighbors of vertex u are stored in adjncy[xadj[u]], ..., adjncy[xadj[u + 1] - 1]
+ * and each edge must occur in the adjacency arrays of both of its endpoints.
+ *
+ * Example:
+ * xadj:         | 0 2 4 6 8 |
+ * adjncy:       | 1 2 | 0 3 | 0 3 | 1 2 |
+ * Defines a graph with four edges -> e_0 = {0,1}, e_1 = {0,2}, e_2 = {1,3}, e_3 = {2,3}
+ *
+ * \note For unweighted graphs, you can pass nullptr to either adjacency_weights or vertex_weights.
+ *       The weights in adjacency_weights are given per adjacency entry (as adjwgt in Metis).
+ * \note The graph is constructed directly from the adjacency arrays without an intermediate
+ *       edge list. After construction, the arguments of this function are no longer needed
+ *       and can be deleted.
+ */
+MT_KAHYPAR_API mt_kahypar_graph_t* mt_kahypar_create_graph_from_csr(const mt_kahypar_hypernode_id_t num_vertices,
+                                                                    const size_t* xadj,
+                                                                    const mt_kahypar_hypernode_id_t* adjncy,
+                                                                    const mt_kahypar_hyperedge_weight_t* adjacency_weights,
+                                                                    const mt_kahypar_hypernode_weight_t* vertex_weights);
+
 /**
  * Deletes the graph object.
  */
@@ -81,6 +103,14 @@ MT_KAHYPAR_API mt_kahypar_hyperedge_id_t mt_kahypar_num_edges(mt_kahypar_graph_t
  */
 MT_KAHYPAR_API mt_kahypar_hypernode_id_t mt_kahypar_total_weight(mt_kahypar_graph_t* graph);
 
+/**
+ * Fixes node i of the graph to block fixed_nodes[i] (-1 = not fixed).
+ *
+ * \note Fixed nodes are only supported in the (non-deterministic) direct k-way mode.
+ */
+MT_KAHYPAR_API void mt_kahypar_add_fixed_nodes(mt_kahypar_graph_t* graph,
+                                               const mt_kahypar_partition_id_t* fixed_nodes);
+
 // ####################### Partition #######################
 
 /**
@@ -93,6 +123,40 @@ MT_KAHYPAR_API mt_kahypar_hypernode_id_t mt_kahypar_total_weight(mt_kahypar_grap
 MT_KAHYPAR_API mt_kahypar_partitioned_graph_t* mt_kahypar_partition(mt_kahypar_graph_t* graph,
                                                                     mt_kahypar_context_t* context);
 
+/**
+ * Partitions several graphs concurrently. The i-th graph is partitioned according to the
+ * i-th partitioning context and the result is stored in partitioned_graphs[i]. Each job is
+ * partitioned with a budget of num_threads_per_job threads. The jobs share the thread pool
+ * and idle threads steal work from other jobs. If num_threads_per_job is zero, the threads
+ * of the thread pool are evenly distributed among the jobs (but each job uses at least one thread).
+ * This is useful for many small graphs, where a single call can not utilize all threads.
+ *
+ * \note Each job requires its own partitioning context.
+ * \note The random number generators are seeded once with the seed of the first context.
+ */
+MT_KAHYPAR_API void mt_kahypar_partition_batch(mt_kahypar_graph_t** graphs,
+                                               mt_kahypar_context_t** contexts,
+                                               const size_t num_graphs,
+                                               const size_t num_threads_per_job,
+                                               mt_kahypar_partitioned_graph_t** partitioned_graphs);
+
+/**
+ * Partitions a graph and writes the block of each vertex to partition.
+ * In contrast to mt_kahypar_partition(...), large internal data structures are allocated
+ * from the memory pool. The memory pool grows to the size required by the largest graph
+ * partitioned so far and keeps its memory after the call such that subsequent calls can
+ * reuse it. Calls to this function must not run concurrently with any other partitioning
+ * call of this library.
+ */
+MT_KAHYPAR_API void mt_kahypar_partition_with_memory_pool(mt_kahypar_graph_t* graph,
+                                                          mt_kahypar_context_t* context,
+                                                          mt_kahypar_partition_id_t* partition);
+
+/**
+ * Frees all memory held by the memory pool.
+ */
+MT_KAHYPAR_API void mt_kahypar_free_memory_pool();
+
 /**
  * Improves a given partition (using the V-cycle technique).
  *
@@ -104,6 +168,37 @@ MT_KAHYPAR_API void mt_kahypar_improve_partition(mt_kahypar_partitioned_graph_t*
                                                  mt_kahypar_context_t* context,
                                                  const size_t num_vcycles);
 
+/**
+ * Partitions an updated graph starting from the partition of a previous run.
+ * previous_partition[v] must contain the block of vertex v in the previous partition or
+ * MT_KAHYPAR_NEW_VERTEX, if v was inserted since then. Inserted vertices are assigned to
+ * the block to which they are most strongly connected and afterwards, num_vcycles V-cycles
+ * are performed to improve the resulting partition.
+ *
+ * \note The number of blocks specified in the partitioning context must be equal to the
+ *       number of blocks of the previous partition.
+ */
+MT_KAHYPAR_API mt_kahypar_partitioned_graph_t* mt_kahypar_repartition(mt_kahypar_graph_t* graph,
+                                                                       mt_kahypar_context_t* context,
+                                                                       const mt_kahypar_partition_id_t* previous_partition,
+                                                                       const size_t num_vcycles);
+
+/**
+ * Computes a partition of the graph for each of the num_targets (k, epsilon) targets given
+ * by num_blocks[i] and epsilons[i]. Preprocessing and coarsening are performed only once
+ * and all targets share the resulting multilevel hierarchy. The block of vertex v in the
+ * partition of the i-th target is written to partitions[i * num_nodes + v].
+ *
+ * \note The number of blocks and the imbalance specified in the partitioning context are ignored.
+ * \note Only supported for the multilevel presets.
+ */
+MT_KAHYPAR_API void mt_kahypar_partition_for_targets(mt_kahypar_graph_t* graph,
+                                                     mt_kahypar_context_t* context,
+                                                     const size_t num_targets,
+                                                     const mt_kahypar_partition_id_t* num_blocks,
+                                                     const double* epsilons,
+                                                     mt_kahypar_partition_id_t* partitions);
+
 /**
  * Constructs a partitioned graph out of the given partition.
  */
@@ -112,7 +207,7 @@ MT_KAHYPAR_API mt_kahypar_partitioned_graph_t* mt_kahypar_create_partitioned_gra
                                                                                    const mt_kahypar_partition_id_t* partition);
 
 /**
- * Constructs a partitioned graph from a given partition file.
+ * Constructs a partitioned graph from a given partition file (text or binary format).
  */
 MT_KAHYPAR_API mt_kahypar_partitioned_graph_t* mt_kahypar_read_partition_from_file(mt_kahypar_graph_t* graph,
                                                                                    const mt_kahypar_partition_id_t num_blocks,
@@ -124,12 +219,26 @@ MT_KAHYPAR_API mt_kahypar_partitioned_graph_t* mt_kahypar_read_partition_from_fi
 MT_KAHYPAR_API void mt_kahypar_write_partition_to_file(const mt_kahypar_partitioned_graph_t* partitioned_graph,
                                                        const char* partition_file);
 
+/**
+ * Writes a partition to a file in binary format (header followed by an int32 array
+ * of the block IDs). Partition files are faster to write and read in this format.
+ */
+MT_KAHYPAR_API void mt_kahypar_write_partition_to_binary_file(const mt_kahypar_partitioned_graph_t* partitioned_graph,
+                                                              const char* partition_file);
+
 /**
  * Extracts a partition from a partitioned graph.
  */
 MT_KAHYPAR_API void mt_kahypar_get_partition(const mt_kahypar_partitioned_graph_t* partitioned_graph,
                                              mt_kahypar_partition_id_t* partition);
 
+/**
+ * Returns the block IDs of all nodes without copying them. The array is owned by the
+ * partitioned graph. It remains valid until the partitioned graph is freed and
+ * reflects all subsequent changes of the partition (e.g., by mt_kahypar_improve_partition).
+ */
+MT_KAHYPAR_API const mt_kahypar_partition_id_t* mt_kahypar_get_partition_view(const mt_kahypar_partitioned_graph_t* partitioned_graph);
+
 /**
  * Extracts the weight of each block from a partition.
  */
@@ -147,6 +256,34 @@ MT_KAHYPAR_API double mt_kahypar_imbalance(const mt_kahypar_partitioned_graph_t*
  */
 MT_KAHYPAR_API mt_kahypar_hyperedge_weight_t mt_kahypar_cut(const mt_kahypar_partitioned_graph_t* partitioned_graph);
 
+/**
+ * Computes the sum of the weights of all edges that connect two blocks for each pair of blocks
+ * and writes the pairs with a non-zero cut weight as a sparse list of (block_0, block_1, weight)
+ * triplets with block_0 < block_1, sorted by block pair, into the given arrays. Returns the number
+ * of such pairs. At most max_entries pairs are written, i.e., the list can be queried in two calls
+ * by passing null arrays first.
+ */
+MT_KAHYPAR_API size_t mt_kahypar_get_block_pair_cuts(const mt_kahypar_partitioned_graph_t* partitioned_graph,
+                                                     mt_kahypar_partition_id_t* block_0,
+                                                     mt_kahypar_partition_id_t* block_1,
+                                                     mt_kahypar_hyperedge_weight_t* weights,
+                                                     const size_t max_entries);
+
+/**
+ * Writes a JSON report of the partitioning run that computed the partition into the given buffer
+ * and returns the length of the report (without the terminating null character). The report contains
+ * the quality metrics, the hierarchical timings, the collected statistics, the objective before and after
+ * each refiner on each level and the memory consumption of the partition. At most buffer_size bytes
+ * (including the terminating null character) are written, i.e., the report can be queried in two calls
+ * by passing a null buffer first.
+ *
+ * \note The context must be the one used for partitioning.
+ */
+MT_KAHYPAR_API size_t mt_kahypar_get_report(const mt_kahypar_partitioned_graph_t* partitioned_graph,
+                                            const mt_kahypar_context_t* context,
+                                            char* buffer,
+                                            const size_t buffer_size);
+
 
 /**
  * Deletes the partitioned graph object.
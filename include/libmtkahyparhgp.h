@@ -63,6 +63,40 @@ MT_KAHYPAR_API mt_kahypar_hypergraph_t* mt_kahypar_create_hypergraph(const mt_ka
                                                                      const mt_kahypar_hyperedge_weight_t* hyperedge_weights,
                                                                      const mt_kahypar_hypernode_weight_t* vertex_weights);
 
+/**
+ * Creates a builder for a hypergraph with num_vertices vertices, whose hyperedges are
+ * added incrementally with mt_kahypar_hypergraph_builder_add_hyperedge(...).
+ *
+ * \note For unweighted hypergraphs, you can pass nullptr to vertex_weights.
+ */
+MT_KAHYPAR_API mt_kahypar_hypergraph_builder_t* mt_kahypar_hypergraph_builder_new(const mt_kahypar_hypernode_id_t num_vertices,
+                                                                                  const mt_kahypar_hypernode_weight_t* vertex_weights);
+
+/**
+ * Adds a hyperedge with the given pins to the builder. The function is thread-safe, i.e.,
+ * several threads can add hyperedges concurrently. The hyperedges of one thread keep
+ * their relative order, whereas the order between different threads is unspecified.
+ *
+ * \note After the call, the pins are no longer needed and can be deleted.
+ */
+MT_KAHYPAR_API void mt_kahypar_hypergraph_builder_add_hyperedge(mt_kahypar_hypergraph_builder_t* builder,
+                                                                const mt_kahypar_hypernode_id_t* pins,
+                                                                const size_t num_pins,
+                                                                const mt_kahypar_hyperedge_weight_t weight);
+
+/**
+ * Constructs the hypergraph from all hyperedges added to the builder. Afterwards, the
+ * builder is empty, but must still be deleted with mt_kahypar_free_hypergraph_builder(...).
+ *
+ * \note Must not be called concurrently with mt_kahypar_hypergraph_builder_add_hyperedge(...).
+ */
+MT_KAHYPAR_API mt_kahypar_hypergraph_t* mt_kahypar_hypergraph_builder_finalize(mt_kahypar_hypergraph_builder_t* builder);
+
+/**
+ * Deletes the builder object.
+ */
+MT_KAHYPAR_API void mt_kahypar_free_hypergraph_builder(mt_kahypar_hypergraph_builder_t* builder);
+
 /**
  * Deletes the hypergraph object.
  */
@@ -88,6 +122,14 @@ MT_KAHYPAR_API mt_kahypar_hypernode_id_t mt_kahypar_num_pins(mt_kahypar_hypergra
  */
 MT_KAHYPAR_API mt_kahypar_hypernode_id_t mt_kahypar_total_weight(mt_kahypar_hypergraph_t* hypergraph);
 
+/**
+ * Fixes vertex i of the hypergraph to block fixed_vertices[i] (-1 = not fixed).
+ *
+ * \note Fixed vertices are only supported in the (non-deterministic) direct k-way mode.
+ */
+MT_KAHYPAR_API void mt_kahypar_add_fixed_vertices(mt_kahypar_hypergraph_t* hypergraph,
+                                                  const mt_kahypar_partition_id_t* fixed_vertices);
+
 // ####################### Partition #######################
 
 /**
@@ -100,6 +142,40 @@ MT_KAHYPAR_API mt_kahypar_hypernode_id_t mt_kahypar_total_weight(mt_kahypar_hype
 MT_KAHYPAR_API mt_kahypar_partitioned_hypergraph_t* mt_kahypar_partition(mt_kahypar_hypergraph_t* hypergraph,
                                                                          mt_kahypar_context_t* context);
 
+/**
+ * Partitions several hypergraphs concurrently. The i-th hypergraph is partitioned according to the
+ * i-th partitioning context and the result is stored in partitioned_hypergraphs[i]. Each job is
+ * partitioned with a budget of num_threads_per_job threads. The jobs share the thread pool
+ * and idle threads steal work from other jobs. If num_threads_per_job is zero, the threads
+ * of the thread pool are evenly distributed among the jobs (but each job uses at least one thread).
+ * This is useful for many small hypergraphs, where a single call can not utilize all threads.
+ *
+ * \note Each job requires its own partitioning context.
+ * \note The random number generators are seeded once with the seed of the first context.
+ */
+MT_KAHYPAR_API void mt_kahypar_partition_batch(mt_kahypar_hypergraph_t** hypergraphs,
+                                               mt_kahypar_context_t** contexts,
+                                               const size_t num_hypergraphs,
+                                               const size_t num_threads_per_job,
+                                               mt_kahypar_partitioned_hypergraph_t** partitioned_hypergraphs);
+
+/**
+ * Partitions a hypergraph and writes the block of each vertex to partition.
+ * In contrast to mt_kahypar_partition(...), large internal data structures are allocated
+ * from the memory pool. The memory pool grows to the size required by the largest hypergraph
+ * partitioned so far and keeps its memory after the call such that subsequent calls can
+ * reuse it. Calls to this function must not run concurrently with any other partitioning
+ * call of this library.
+ */
+MT_KAHYPAR_API void mt_kahypar_partition_with_memory_pool(mt_kahypar_hypergraph_t* hypergraph,
+                                                          mt_kahypar_context_t* context,
+                                                          mt_kahypar_partition_id_t* partition);
+
+/**
+ * Frees all memory held by the memory pool.
+ */
+MT_KAHYPAR_API void mt_kahypar_free_memory_pool();
+
 /**
  * Improves a given partition (using the V-cycle technique).
  *
@@ -111,6 +187,37 @@ MT_KAHYPAR_API void mt_kahypar_improve_partition(mt_kahypar_partitioned_hypergra
                                                  mt_kahypar_context_t* context,
                                                  const size_t num_vcycles);
 
+/**
+ * Partitions an updated hypergraph starting from the partition of a previous run.
+ * previous_partition[v] must contain the block of vertex v in the previous partition or
+ * MT_KAHYPAR_NEW_VERTEX, if v was inserted since then. Inserted vertices are assigned to
+ * the block to which they are most strongly connected and afterwards, num_vcycles V-cycles
+ * are performed to improve the resulting partition.
+ *
+ * \note The number of blocks specified in the partitioning context must be equal to the
+ *       number of blocks of the previous partition.
+ */
+MT_KAHYPAR_API mt_kahypar_partitioned_hypergraph_t* mt_kahypar_repartition(mt_kahypar_hypergraph_t* hypergraph,
+                                                                           mt_kahypar_context_t* context,
+                                                                           const mt_kahypar_partition_id_t* previous_partition,
+                                                                           const size_t num_vcycles);
+
+/**
+ * Computes a partition of the hypergraph for each of the num_targets (k, epsilon) targets given
+ * by num_blocks[i] and epsilons[i]. Preprocessing and coarsening are performed only once
+ * and all targets share the resulting multilevel hierarchy. The block of vertex v in the
+ * partition of the i-th target is written to partitions[i * num_nodes + v].
+ *
+ * \note The number of blocks and the imbalance specified in the partitioning context are ignored.
+ * \note Only supported for the multilevel presets.
+ */
+MT_KAHYPAR_API void mt_kahypar_partition_for_targets(mt_kahypar_hypergraph_t* hypergraph,
+                                                     mt_kahypar_context_t* context,
+                                                     const size_t num_targets,
+                                                     const mt_kahypar_partition_id_t* num_blocks,
+                                                     const double* epsilons,
+                                                     mt_kahypar_partition_id_t* partitions);
+
 /**
  * Constructs a partitioned hypergraph out of the given partition.
  */
@@ -119,7 +226,7 @@ MT_KAHYPAR_API mt_kahypar_partitioned_hypergraph_t* mt_kahypar_create_partitione
                                                                                              const mt_kahypar_partition_id_t* partition);
 
 /**
- * Constructs a partitioned hypergraph from a given partition file.
+ * Constructs a partitioned hypergraph from a given partition file (text or binary format).
  */
 MT_KAHYPAR_API mt_kahypar_partitioned_hypergraph_t* mt_kahypar_read_partition_from_file(mt_kahypar_hypergraph_t* hypergraph,
                                                                                         const mt_kahypar_partition_id_t num_blocks,
@@ -131,12 +238,28 @@ MT_KAHYPAR_API mt_kahypar_partitioned_hypergraph_t* mt_kahypar_read_partition_fr
 MT_KAHYPAR_API void mt_kahypar_write_partition_to_file(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
                                                        const char* partition_file);
 
+/**
+ * Writes a partition to a file in binary format (header followed by an int32 array
+ * of the block IDs). Partition files are faster to write and read in this format.
+ */
+MT_KAHYPAR_API void mt_kahypar_write_partition_to_binary_file(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
+                                                              const char* partition_file);
+
 /**
  * Extracts a partition from a partitioned hypergraph.
  */
 MT_KAHYPAR_API void mt_kahypar_get_partition(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
                                              mt_kahypar_partition_id_t* partition);
 
+/**
+ * Returns the block IDs of all nodes without copying them. The array is owned by the
+ * partitioned hypergraph. It remains valid until the partitioned hypergraph is freed and
+ * reflects all subsequent changes of the partition (e.g., by mt_kahypar_improve_partition).
+ * Returns NULL if the library is built with narrow block IDs (KAHYPAR_USE_8_BIT_PART_IDS or
+ * KAHYPAR_USE_16_BIT_PART_IDS). Use mt_kahypar_get_partition(...) in this case.
+ */
+MT_KAHYPAR_API const mt_kahypar_partition_id_t* mt_kahypar_get_partition_view(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg);
+
 /**
  * Extracts the weight of each block from a partition.
  */
@@ -164,6 +287,36 @@ MT_KAHYPAR_API mt_kahypar_hyperedge_weight_t mt_kahypar_km1(const mt_kahypar_par
  */
 MT_KAHYPAR_API mt_kahypar_hyperedge_weight_t mt_kahypar_soed(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg);
 
+/**
+ * Computes the sum of the weights of all hyperedges that connect two blocks for each pair of blocks
+ * and writes the pairs with a non-zero cut weight as a sparse list of (block_0, block_1, weight)
+ * triplets with block_0 < block_1, sorted by block pair, into the given arrays. Returns the number
+ * of such pairs. At most max_entries pairs are written, i.e., the list can be queried in two calls
+ * by passing null arrays first.
+ *
+ * \note A hyperedge with connectivity l contributes to all l * (l - 1) / 2 pairs of blocks it connects.
+ */
+MT_KAHYPAR_API size_t mt_kahypar_get_block_pair_cuts(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
+                                                     mt_kahypar_partition_id_t* block_0,
+                                                     mt_kahypar_partition_id_t* block_1,
+                                                     mt_kahypar_hyperedge_weight_t* weights,
+                                                     const size_t max_entries);
+
+/**
+ * Writes a JSON report of the partitioning run that computed the partition into the given buffer
+ * and returns the length of the report (without the terminating null character). The report contains
+ * the quality metrics, the hierarchical timings, the collected statistics, the objective before and after
+ * each refiner on each level and the memory consumption of the partition. At most buffer_size bytes
+ * (including the terminating null character) are written, i.e., the report can be queried in two calls
+ * by passing a null buffer first.
+ *
+ * \note The context must be the one used for partitioning.
+ */
+MT_KAHYPAR_API size_t mt_kahypar_get_report(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
+                                            const mt_kahypar_context_t* context,
+                                            char* buffer,
+                                            const size_t buffer_size);
+
 
 /**
  * Deletes the partitioned hypergraph object.
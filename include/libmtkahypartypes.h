@@ -7,6 +7,10 @@ typedef struct mt_kahypar_hypergraph_s mt_kahypar_hypergraph_t;
 typedef struct mt_kahypar_graph_s mt_kahypar_graph_t;
 typedef struct mt_kahypar_partitioned_hypergraph_s mt_kahypar_partitioned_hypergraph_t;
 typedef struct mt_kahypar_partitioned_graph_s mt_kahypar_partitioned_graph_t;
+typedef struct mt_kahypar_session_s mt_kahypar_session_t;
+typedef struct mt_kahypar_thread_pool_s mt_kahypar_thread_pool_t;
+typedef struct mt_kahypar_partitioning_job_s mt_kahypar_partitioning_job_t;
+typedef struct mt_kahypar_hypergraph_builder_s mt_kahypar_hypergraph_builder_t;
 
 typedef unsigned long int mt_kahypar_hypernode_id_t;
 typedef unsigned long int mt_kahypar_hyperedge_id_t;
@@ -14,6 +18,9 @@ typedef int mt_kahypar_hypernode_weight_t;
 typedef int mt_kahypar_hyperedge_weight_t;
 typedef int mt_kahypar_partition_id_t;
 
+// Block of a vertex that is not part of a previous partition (see mt_kahypar_repartition_hypergraph(...))
+#define MT_KAHYPAR_NEW_VERTEX (-1)
+
 /**
  * Supported (hyper)graph file formats.
  */
@@ -28,6 +28,17 @@
 #include "libmtkahypar.h"
 #include "libmtkahyparhgp.h"
 #include "libmtkahypargp.h"
+#include "libmtkahyparnlevel.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tbb/task_group.h"
 
 #include "mt-kahypar/parallel/tbb_initializer.h"
 #include "mt-kahypar/partition/context.h"
@@ -37,6 +48,229 @@
 namespace {
   template<typename T>
   using vec = mt_kahypar::parallel::scalable_vector<T>;
+
+  // Backend library that owns the object behind a handle
+  enum class Backend : uint8_t {
+    static_hypergraph, // mtkahyparhgp
+    dynamic_hypergraph, // mtkahyparhgpnlevel
+    static_graph, // mtkahypargp
+    dynamic_graph // mtkahypargpnlevel
+  };
+
+  // All (partitioned) (hyper)graphs handed out by this library are wrapped
+  // into a handle that stores the backend which constructed the object.
+  struct Handle {
+    Backend backend;
+    void* object;
+  };
+
+  template<typename Handle_T, typename T>
+  Handle_T* wrap(const Backend backend, T* object) {
+    return reinterpret_cast<Handle_T*>(new Handle { backend, reinterpret_cast<void*>(object) });
+  }
+
+  template<typename T, typename Handle_T>
+  T* unwrap(Handle_T* handle) {
+    return reinterpret_cast<T*>(reinterpret_cast<const Handle*>(handle)->object);
+  }
+
+  template<typename Handle_T>
+  Backend backend_of(const Handle_T* handle) {
+    return reinterpret_cast<const Handle*>(handle)->backend;
+  }
+
+  bool is_nlevel(const mt_kahypar::Context& context) {
+    return context.coarsening.algorithm == mt_kahypar::CoarseningAlgorithm::nlevel_coarsener;
+  }
+
+  bool is_graph_backend(const Backend backend) {
+    return backend == Backend::static_graph || backend == Backend::dynamic_graph;
+  }
+
+  bool is_nlevel_backend(const Backend backend) {
+    return backend == Backend::dynamic_hypergraph || backend == Backend::dynamic_graph;
+  }
+
+  // Inputs in Metis format only contain edges with exactly two pins. They are
+  // represented with the graph data structures, which avoid the overhead of
+  // storing each edge as a hyperedge. The n-level presets require one of the
+  // dynamic data structures.
+  Backend select_backend(const mt_kahypar::Context& context, const bool is_graph) {
+    if ( is_graph ) {
+      return is_nlevel(context) ? Backend::dynamic_graph : Backend::static_graph;
+    } else {
+      return is_nlevel(context) ? Backend::dynamic_hypergraph : Backend::static_hypergraph;
+    }
+  }
+
+  static constexpr size_t NUM_BACKENDS = 4;
+
+  // A session keeps track of the backends whose memory pool holds
+  // memory allocated by calls of the session
+  struct Session {
+    std::array<bool, NUM_BACKENDS> uses_memory_pool;
+  };
+
+  // Each backend has its own memory pool, which can only be used by one call
+  // at a time. Therefore, we serialize all calls of all sessions.
+  std::mutex session_mutex;
+
+  // A partitioning job runs a partitioning call on a separate thread. The job
+  // owns a copy of the context, whose cancellation token is shared with all
+  // contexts derived from it during partitioning.
+  struct PartitioningJob {
+    PartitioningJob(const mt_kahypar::Context& c, const bool graph) :
+      context(c),
+      is_graph(graph),
+      finished(false),
+      result(nullptr),
+      thread(),
+      snapshot_mutex(),
+      snapshot(),
+      snapshot_version(0) { }
+
+    mt_kahypar::Context context;
+    const bool is_graph;
+    std::atomic<bool> finished;
+    // Partitioned (hyper)graph handle (not yet claimed by the caller)
+    void* result;
+    std::thread thread;
+    // Best partition published by the partitioner so far
+    std::mutex snapshot_mutex;
+    vec<mt_kahypar_partition_id_t> snapshot;
+    size_t snapshot_version;
+  };
+
+  template<typename Func>
+  mt_kahypar_partitioning_job_t* start_partitioning_job(mt_kahypar_context_t* context,
+                                                        const double time_limit,
+                                                        const bool is_graph,
+                                                        Func partition) {
+    PartitioningJob* job = new PartitioningJob(
+      *reinterpret_cast<const mt_kahypar::Context*>(context), is_graph);
+    job->context.cancellation_token = std::make_shared<mt_kahypar::utils::CancellationToken>();
+    if ( time_limit > 0 ) {
+      job->context.cancellation_token->setTimeLimit(time_limit);
+    }
+    job->context.on_improved_partition = [job](const vec<mt_kahypar::PartitionID>& partition) {
+      std::lock_guard<std::mutex> lock(job->snapshot_mutex);
+      job->snapshot.assign(partition.begin(), partition.end());
+      ++job->snapshot_version;
+    };
+    job->thread = std::thread([job, partition] {
+      job->result = partition(reinterpret_cast<mt_kahypar_context_t*>(&job->context));
+      job->finished.store(true, std::memory_order_release);
+    });
+    return reinterpret_cast<mt_kahypar_partitioning_job_t*>(job);
+  }
+
+  PartitioningJob& job_of(mt_kahypar_partitioning_job_t* job) {
+    return *reinterpret_cast<PartitioningJob*>(job);
+  }
+
+  void* wait_for(PartitioningJob& job) {
+    if ( job.thread.joinable() ) {
+      job.thread.join();
+    }
+    void* result = job.result;
+    job.result = nullptr;
+    return result;
+  }
+
+  void check_compatibility(const Backend backend, const mt_kahypar::Context& context) {
+    if ( is_nlevel(context) != is_nlevel_backend(backend) ) {
+      ERR("The" << (is_graph_backend(backend) ? "graph" : "hypergraph")
+        << "was constructed with a" << (is_nlevel_backend(backend) ? "dynamic" : "static")
+        << "data structure, but the context requires a"
+        << (is_nlevel(context) ? "dynamic" : "static") << "one."
+        << "Please load the preset of the context before reading the (hyper)graph.");
+    }
+  }
+
+  // Partitions all jobs assigned to one backend with the batch function of the backend
+  template<typename Object_T, typename PartitionedObject_T,
+           typename Handle_T, typename PartitionedHandle_T, typename BatchFunc>
+  void partition_backend_batch(const Backend backend,
+                               Handle_T** handles,
+                               mt_kahypar_context_t** contexts,
+                               const vec<size_t>& jobs,
+                               const size_t num_threads_per_job,
+                               PartitionedHandle_T** partitioned_handles,
+                               const BatchFunc& batch_func) {
+    vec<Object_T*> objects;
+    vec<mt_kahypar_context_t*> job_contexts;
+    vec<PartitionedObject_T*> partitioned_objects(jobs.size(), nullptr);
+    for ( const size_t i : jobs ) {
+      objects.push_back(unwrap<Object_T>(handles[i]));
+      job_contexts.push_back(contexts[i]);
+    }
+    batch_func(objects.data(), job_contexts.data(), jobs.size(),
+      num_threads_per_job, partitioned_objects.data());
+    for ( size_t j = 0; j < jobs.size(); ++j ) {
+      partitioned_handles[jobs[j]] = wrap<PartitionedHandle_T>(backend, partitioned_objects[j]);
+    }
+  }
+
+  template<typename Handle_T, typename PartitionedHandle_T>
+  void partition_batch(Handle_T** handles,
+                       mt_kahypar_context_t** contexts,
+                       const size_t num_jobs,
+                       const size_t num_threads_per_job,
+                       PartitionedHandle_T** partitioned_handles) {
+    if ( num_jobs == 0 ) {
+      return;
+    }
+
+    // Each backend library partitions the jobs of its own data structure
+    std::array<vec<size_t>, NUM_BACKENDS> jobs;
+    for ( size_t i = 0; i < num_jobs; ++i ) {
+      const Backend backend = backend_of(handles[i]);
+      check_compatibility(backend, *reinterpret_cast<const mt_kahypar::Context*>(contexts[i]));
+      jobs[static_cast<size_t>(backend)].push_back(i);
+    }
+    const size_t threads_per_job = num_threads_per_job > 0 ? num_threads_per_job :
+      std::max(mt_kahypar::TBBInitializer::instance().total_number_of_threads() / num_jobs, UL(1));
+
+    tbb::task_group tg;
+    for ( size_t b = 0; b < NUM_BACKENDS; ++b ) {
+      if ( jobs[b].empty() ) {
+        continue;
+      }
+      tg.run([&, b] {
+        const Backend backend = static_cast<Backend>(b);
+        switch ( backend ) {
+          case Backend::static_hypergraph:
+            partition_backend_batch<mt_kahypar_hypergraph_t, mt_kahypar_partitioned_hypergraph_t>(
+              backend, handles, contexts, jobs[b], threads_per_job,
+              partitioned_handles, hgp::mt_kahypar_partition_batch); break;
+          case Backend::dynamic_hypergraph:
+            partition_backend_batch<mt_kahypar_hypergraph_t, mt_kahypar_partitioned_hypergraph_t>(
+              backend, handles, contexts, jobs[b], threads_per_job,
+              partitioned_handles, hgp_nlevel::mt_kahypar_partition_batch); break;
+          case Backend::static_graph:
+            partition_backend_batch<mt_kahypar_graph_t, mt_kahypar_partitioned_graph_t>(
+              backend, handles, contexts, jobs[b], threads_per_job,
+              partitioned_handles, gp::mt_kahypar_partition_batch); break;
+          case Backend::dynamic_graph:
+            partition_backend_batch<mt_kahypar_graph_t, mt_kahypar_partitioned_graph_t>(
+              backend, handles, contexts, jobs[b], threads_per_job,
+              partitioned_handles, gp_nlevel::mt_kahypar_partition_batch); break;
+        }
+      });
+    }
+    tg.wait();
+  }
+
+  // Runs a partitioning call in the thread pool of its context
+  // (or in the task arena of the calling thread, if it has none)
+  template<typename F>
+  auto execute_in_thread_pool(const mt_kahypar_context_t* context, const F& f) -> decltype(f()) {
+    const mt_kahypar::Context& c = *reinterpret_cast<const mt_kahypar::Context*>(context);
+    if ( c.thread_pool ) {
+      return c.thread_pool->execute(f);
+    }
+    return f();
+  }
 }
 
 
@@ -70,6 +304,12 @@ void mt_kahypar_load_preset(mt_kahypar_context_t* context,
     case HIGH_QUALITY:
       c.load_default_flow_preset();
       break;
+    case QUALITY:
+      c.load_quality_preset();
+      break;
+    case HIGHEST_QUALITY:
+      c.load_quality_flow_preset();
+      break;
   }
 }
 
@@ -106,6 +346,15 @@ int mt_kahypar_set_context_parameter(mt_kahypar_context_t* context,
     case VERBOSE:
       c.partition.verbose_output = atoi(value);
       return 0;
+    case ANYTIME:
+      c.partition.anytime = atoi(value);
+      return 0;
+    case RESULT_CACHE_SIZE:
+      c.partition.result_cache_size = atoi(value);
+      return 0;
+    case RESULT_CACHE_DIRECTORY:
+      c.partition.result_cache_directory = value;
+      return 0;
   }
   return 1; /** no valid parameter type **/
 }
@@ -123,6 +372,76 @@ void mt_kahypar_set_partitioning_parameters(mt_kahypar_context_t* context,
   c.partition.seed = seed;
 }
 
+void mt_kahypar_set_progress_callback(mt_kahypar_context_t* context,
+                                      mt_kahypar_progress_callback_t callback,
+                                      void* user_data) {
+  mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(context);
+  if ( callback == nullptr ) {
+    c.progress_reporter = nullptr;
+    return;
+  }
+  c.progress_reporter = std::make_shared<mt_kahypar::utils::ProgressReporter>(
+    [callback, user_data](const mt_kahypar::utils::ProgressUpdate& update) {
+      mt_kahypar_progress_t progress;
+      progress.phase = static_cast<mt_kahypar_progress_phase_t>(update.phase);
+      progress.vcycle = update.vcycle;
+      progress.level = update.level;
+      progress.num_levels = update.num_levels;
+      progress.objective = update.objective;
+      progress.imbalance = update.imbalance;
+      progress.elapsed_seconds = update.elapsed_seconds;
+      return callback(&progress, user_data);
+    });
+}
+
+void mt_kahypar_set_refinement_callback(mt_kahypar_context_t* context,
+                                        mt_kahypar_refinement_callback_t callback,
+                                        void* user_data) {
+  static_assert(sizeof(mt_kahypar_hypernode_id_t) == sizeof(uint64_t) &&
+                sizeof(mt_kahypar_hyperedge_id_t) == sizeof(uint64_t),
+                "Exported IDs can not be passed without conversion");
+  static_assert(std::is_same<mt_kahypar_partition_id_t, mt_kahypar::PartitionID>::value &&
+                std::is_same<mt_kahypar_hypernode_weight_t, mt_kahypar::HypernodeWeight>::value &&
+                std::is_same<mt_kahypar_hyperedge_weight_t, mt_kahypar::HyperedgeWeight>::value);
+  mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(context);
+  if ( callback == nullptr ) {
+    c.external_refinement_hook = nullptr;
+    return;
+  }
+  c.external_refinement_hook = std::make_shared<mt_kahypar::utils::ExternalRefinementHook>(
+    [callback, user_data](const mt_kahypar::utils::ExternalRefinementLevel& level,
+                          uint64_t* nodes,
+                          mt_kahypar::PartitionID* blocks) {
+      mt_kahypar_refinement_level_t refinement_level;
+      refinement_level.level = level.level;
+      refinement_level.num_levels = level.num_levels;
+      refinement_level.num_blocks = level.k;
+      refinement_level.num_nodes = level.num_nodes;
+      refinement_level.num_edges = level.num_edges;
+      refinement_level.hyperedge_indices = level.hyperedge_indices;
+      refinement_level.pins = reinterpret_cast<const mt_kahypar_hypernode_id_t*>(level.pins);
+      refinement_level.incident_net_indices = level.incident_net_indices;
+      refinement_level.incident_nets = reinterpret_cast<const mt_kahypar_hyperedge_id_t*>(level.incident_nets);
+      refinement_level.node_weights = level.node_weights;
+      refinement_level.edge_weights = level.edge_weights;
+      refinement_level.partition = level.part_ids;
+      refinement_level.block_weights = level.block_weights;
+      refinement_level.max_block_weights = level.max_block_weights;
+      refinement_level.internal = &level;
+      return callback(&refinement_level,
+        reinterpret_cast<mt_kahypar_hypernode_id_t*>(nodes), blocks, user_data);
+    });
+}
+
+mt_kahypar_hypernode_id_t mt_kahypar_refinement_level_pin_count_in_part(const mt_kahypar_refinement_level_t* level,
+                                                                       const mt_kahypar_hyperedge_id_t he,
+                                                                       const mt_kahypar_partition_id_t block) {
+  const mt_kahypar::utils::ExternalRefinementLevel& internal_level =
+    *reinterpret_cast<const mt_kahypar::utils::ExternalRefinementLevel*>(level->internal);
+  ASSERT(he < internal_level.num_edges && block < internal_level.k);
+  return internal_level.pin_count_in_part(internal_level.partitioned_hg, he, block);
+}
+
 void mt_kahypar_set_individual_target_block_weights(mt_kahypar_context_t* context,
                                                     const mt_kahypar_partition_id_t num_blocks,
                                                     const mt_kahypar_hypernode_weight_t* block_weights) {
@@ -146,8 +465,9 @@ void mt_kahypar_initialize_thread_pool(const size_t num_threads,
     P = num_available_cpus;
   }
 
-  // Initialize TBB task arenas on numa nodes
-  mt_kahypar::TBBInitializer::instance(P);
+  // Initialize TBB task arenas on numa nodes (or change
+  // the size of the global thread pool on subsequent calls)
+  mt_kahypar::TBBInitializer::instance(P).resize(P);
 
   if ( interleaved_allocations ) {
     // We set the membind policy to interleaved allocations in order to
@@ -158,16 +478,79 @@ void mt_kahypar_initialize_thread_pool(const size_t num_threads,
   }
 }
 
+mt_kahypar_thread_pool_t* mt_kahypar_thread_pool_new(const size_t num_threads,
+                                                     const int* cpus) {
+  if ( num_threads == 0 ) {
+    ERR("A thread pool requires at least one thread.");
+  }
+  // The threads of the thread pool are drawn from the global thread pool
+  size_t P = num_threads;
+  const size_t num_global_threads = mt_kahypar::TBBInitializer::instance().total_number_of_threads();
+  if ( num_global_threads < num_threads ) {
+    WARNING("The global thread pool has only" << num_global_threads << "threads."
+      << "Setting number of threads of the thread pool from" << num_threads
+      << "to" << num_global_threads);
+    P = num_global_threads;
+  }
+  std::vector<int> pinned_cpus;
+  if ( cpus != nullptr ) {
+    pinned_cpus.assign(cpus, cpus + P);
+  }
+  return reinterpret_cast<mt_kahypar_thread_pool_t*>(new std::shared_ptr<mt_kahypar::ThreadPool>(
+    std::make_shared<mt_kahypar::ThreadPool>(static_cast<int>(P), pinned_cpus)));
+}
+
+void mt_kahypar_free_thread_pool(mt_kahypar_thread_pool_t* thread_pool) {
+  if ( thread_pool == nullptr ) {
+    return;
+  }
+  // The thread pool itself is destroyed when the last context using it is freed
+  delete reinterpret_cast<std::shared_ptr<mt_kahypar::ThreadPool>*>(thread_pool);
+}
+
+void mt_kahypar_set_thread_pool(mt_kahypar_context_t* context,
+                                mt_kahypar_thread_pool_t* thread_pool) {
+  mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(context);
+  if ( thread_pool == nullptr ) {
+    c.thread_pool.reset();
+  } else {
+    c.thread_pool = *reinterpret_cast<std::shared_ptr<mt_kahypar::ThreadPool>*>(thread_pool);
+  }
+}
+
 mt_kahypar_hypergraph_t* mt_kahypar_read_hypergraph_from_file(const char* file_name,
                                                               const mt_kahypar_context_t* context,
                                                               const mt_kahypar_file_format_type_t file_format) {
-  return hgp::mt_kahypar_read_hypergraph_from_file(file_name, context, file_format);
+  const mt_kahypar::Context& c = *reinterpret_cast<const mt_kahypar::Context*>(context);
+  const Backend backend = select_backend(c, file_format == METIS);
+  switch ( backend ) {
+    case Backend::static_hypergraph:
+      return wrap<mt_kahypar_hypergraph_t>(backend,
+        hgp::mt_kahypar_read_hypergraph_from_file(file_name, context, file_format));
+    case Backend::dynamic_hypergraph:
+      return wrap<mt_kahypar_hypergraph_t>(backend,
+        hgp_nlevel::mt_kahypar_read_hypergraph_from_file(file_name, context, file_format));
+    case Backend::static_graph:
+      return wrap<mt_kahypar_hypergraph_t>(backend,
+        gp::mt_kahypar_read_graph_from_file(file_name, context, file_format));
+    case Backend::dynamic_graph:
+      return wrap<mt_kahypar_hypergraph_t>(backend,
+        gp_nlevel::mt_kahypar_read_graph_from_file(file_name, context, file_format));
+  }
+  return nullptr;
 }
 
 mt_kahypar_graph_t* mt_kahypar_read_graph_from_file(const char* file_name,
                                                     const mt_kahypar_context_t* context,
                                                     const mt_kahypar_file_format_type_t file_format) {
-  return gp::mt_kahypar_read_graph_from_file(file_name, context, file_format);
+  const mt_kahypar::Context& c = *reinterpret_cast<const mt_kahypar::Context*>(context);
+  const Backend backend = select_backend(c, true);
+  if ( backend == Backend::dynamic_graph ) {
+    return wrap<mt_kahypar_graph_t>(backend,
+      gp_nlevel::mt_kahypar_read_graph_from_file(file_name, context, file_format));
+  }
+  return wrap<mt_kahypar_graph_t>(backend,
+    gp::mt_kahypar_read_graph_from_file(file_name, context, file_format));
 }
 
 mt_kahypar_hypergraph_t* mt_kahypar_create_hypergraph(const mt_kahypar_hypernode_id_t num_vertices,
@@ -176,8 +559,30 @@ mt_kahypar_hypergraph_t* mt_kahypar_create_hypergraph(const mt_kahypar_hypernode
                                                       const mt_kahypar_hyperedge_id_t* hyperedges,
                                                       const mt_kahypar_hyperedge_weight_t* hyperedge_weights,
                                                       const mt_kahypar_hypernode_weight_t* vertex_weights) {
-  return hgp::mt_kahypar_create_hypergraph(num_vertices, num_hyperedges,
-    hyperedge_indices, hyperedges, hyperedge_weights, vertex_weights);
+  return wrap<mt_kahypar_hypergraph_t>(Backend::static_hypergraph,
+    hgp::mt_kahypar_create_hypergraph(num_vertices, num_hyperedges,
+      hyperedge_indices, hyperedges, hyperedge_weights, vertex_weights));
+}
+
+mt_kahypar_hypergraph_builder_t* mt_kahypar_hypergraph_builder_new(const mt_kahypar_hypernode_id_t num_vertices,
+                                                                   const mt_kahypar_hypernode_weight_t* vertex_weights) {
+  return hgp::mt_kahypar_hypergraph_builder_new(num_vertices, vertex_weights);
+}
+
+void mt_kahypar_hypergraph_builder_add_hyperedge(mt_kahypar_hypergraph_builder_t* builder,
+                                                 const mt_kahypar_hypernode_id_t* pins,
+                                                 const size_t num_pins,
+                                                 const mt_kahypar_hyperedge_weight_t weight) {
+  hgp::mt_kahypar_hypergraph_builder_add_hyperedge(builder, pins, num_pins, weight);
+}
+
+mt_kahypar_hypergraph_t* mt_kahypar_hypergraph_builder_finalize(mt_kahypar_hypergraph_builder_t* builder) {
+  return wrap<mt_kahypar_hypergraph_t>(Backend::static_hypergraph,
+    hgp::mt_kahypar_hypergraph_builder_finalize(builder));
+}
+
+void mt_kahypar_free_hypergraph_builder(mt_kahypar_hypergraph_builder_t* builder) {
+  hgp::mt_kahypar_free_hypergraph_builder(builder);
 }
 
 mt_kahypar_graph_t* mt_kahypar_create_graph(const mt_kahypar_hypernode_id_t num_vertices,
@@ -185,152 +590,835 @@ mt_kahypar_graph_t* mt_kahypar_create_graph(const mt_kahypar_hypernode_id_t num_
                                             const mt_kahypar_hypernode_id_t* edges,
                                             const mt_kahypar_hyperedge_weight_t* edge_weights,
                                             const mt_kahypar_hypernode_weight_t* vertex_weights) {
-  return gp::mt_kahypar_create_graph(num_vertices, num_edges, edges, edge_weights, vertex_weights);
+  return wrap<mt_kahypar_graph_t>(Backend::static_graph,
+    gp::mt_kahypar_create_graph(num_vertices, num_edges, edges, edge_weights, vertex_weights));
+}
+
+mt_kahypar_graph_t* mt_kahypar_create_graph_from_csr(const mt_kahypar_hypernode_id_t num_vertices,
+                                                     const size_t* xadj,
+                                                     const mt_kahypar_hypernode_id_t* adjncy,
+                                                     const mt_kahypar_hyperedge_weight_t* adjacency_weights,
+                                                     const mt_kahypar_hypernode_weight_t* vertex_weights) {
+  return wrap<mt_kahypar_graph_t>(Backend::static_graph,
+    gp::mt_kahypar_create_graph_from_csr(num_vertices, xadj, adjncy, adjacency_weights, vertex_weights));
 }
 
 void mt_kahypar_free_hypergraph(mt_kahypar_hypergraph_t* hypergraph) {
-  hgp::mt_kahypar_free_hypergraph(hypergraph);
+  if (hypergraph == nullptr) {
+    return;
+  }
+  Handle* handle = reinterpret_cast<Handle*>(hypergraph);
+  switch ( handle->backend ) {
+    case Backend::static_hypergraph:
+      hgp::mt_kahypar_free_hypergraph(unwrap<mt_kahypar_hypergraph_t>(hypergraph)); break;
+    case Backend::dynamic_hypergraph:
+      hgp_nlevel::mt_kahypar_free_hypergraph(unwrap<mt_kahypar_hypergraph_t>(hypergraph)); break;
+    case Backend::static_graph:
+      gp::mt_kahypar_free_graph(unwrap<mt_kahypar_graph_t>(hypergraph)); break;
+    case Backend::dynamic_graph:
+      gp_nlevel::mt_kahypar_free_graph(unwrap<mt_kahypar_graph_t>(hypergraph)); break;
+  }
+  delete handle;
 }
 
 void mt_kahypar_free_graph(mt_kahypar_graph_t* graph) {
-  gp::mt_kahypar_free_graph(graph);
+  if (graph == nullptr) {
+    return;
+  }
+  Handle* handle = reinterpret_cast<Handle*>(graph);
+  if ( handle->backend == Backend::dynamic_graph ) {
+    gp_nlevel::mt_kahypar_free_graph(unwrap<mt_kahypar_graph_t>(graph));
+  } else {
+    gp::mt_kahypar_free_graph(unwrap<mt_kahypar_graph_t>(graph));
+  }
+  delete handle;
 }
 
 mt_kahypar_hypernode_id_t mt_kahypar_num_hypernodes(mt_kahypar_hypergraph_t* hypergraph) {
-  return hgp::mt_kahypar_num_nodes(hypergraph);
+  switch ( backend_of(hypergraph) ) {
+    case Backend::static_hypergraph:
+      return hgp::mt_kahypar_num_nodes(unwrap<mt_kahypar_hypergraph_t>(hypergraph));
+    case Backend::dynamic_hypergraph:
+      return hgp_nlevel::mt_kahypar_num_nodes(unwrap<mt_kahypar_hypergraph_t>(hypergraph));
+    case Backend::static_graph:
+      return gp::mt_kahypar_num_nodes(unwrap<mt_kahypar_graph_t>(hypergraph));
+    case Backend::dynamic_graph:
+      return gp_nlevel::mt_kahypar_num_nodes(unwrap<mt_kahypar_graph_t>(hypergraph));
+  }
+  return 0;
 }
 
 mt_kahypar_hypernode_id_t mt_kahypar_num_nodes(mt_kahypar_graph_t* graph) {
-  return gp::mt_kahypar_num_nodes(graph);
+  return backend_of(graph) == Backend::dynamic_graph ?
+    gp_nlevel::mt_kahypar_num_nodes(unwrap<mt_kahypar_graph_t>(graph)) :
+    gp::mt_kahypar_num_nodes(unwrap<mt_kahypar_graph_t>(graph));
 }
 
 mt_kahypar_hyperedge_id_t mt_kahypar_num_hyperedges(mt_kahypar_hypergraph_t* hypergraph) {
-  return hgp::mt_kahypar_num_hyperedges(hypergraph);
+  switch ( backend_of(hypergraph) ) {
+    case Backend::static_hypergraph:
+      return hgp::mt_kahypar_num_hyperedges(unwrap<mt_kahypar_hypergraph_t>(hypergraph));
+    case Backend::dynamic_hypergraph:
+      return hgp_nlevel::mt_kahypar_num_hyperedges(unwrap<mt_kahypar_hypergraph_t>(hypergraph));
+    case Backend::static_graph:
+      return gp::mt_kahypar_num_edges(unwrap<mt_kahypar_graph_t>(hypergraph));
+    case Backend::dynamic_graph:
+      return gp_nlevel::mt_kahypar_num_edges(unwrap<mt_kahypar_graph_t>(hypergraph));
+  }
+  return 0;
 }
 
 mt_kahypar_hyperedge_id_t mt_kahypar_num_edges(mt_kahypar_graph_t* graph) {
-  return gp::mt_kahypar_num_edges(graph);
+  return backend_of(graph) == Backend::dynamic_graph ?
+    gp_nlevel::mt_kahypar_num_edges(unwrap<mt_kahypar_graph_t>(graph)) :
+    gp::mt_kahypar_num_edges(unwrap<mt_kahypar_graph_t>(graph));
 }
 
 mt_kahypar_hypernode_id_t mt_kahypar_num_pins(mt_kahypar_hypergraph_t* hypergraph) {
-  return hgp::mt_kahypar_num_pins(hypergraph);
+  switch ( backend_of(hypergraph) ) {
+    case Backend::static_hypergraph:
+      return hgp::mt_kahypar_num_pins(unwrap<mt_kahypar_hypergraph_t>(hypergraph));
+    case Backend::dynamic_hypergraph:
+      return hgp_nlevel::mt_kahypar_num_pins(unwrap<mt_kahypar_hypergraph_t>(hypergraph));
+    case Backend::static_graph:
+    case Backend::dynamic_graph:
+      // Each edge of a graph contains exactly two pins
+      return 2 * mt_kahypar_num_hyperedges(hypergraph);
+  }
+  return 0;
 }
 
 mt_kahypar_hypernode_id_t mt_kahypar_hypergraph_weight(mt_kahypar_hypergraph_t* hypergraph) {
-  return hgp::mt_kahypar_total_weight(hypergraph);
+  switch ( backend_of(hypergraph) ) {
+    case Backend::static_hypergraph:
+      return hgp::mt_kahypar_total_weight(unwrap<mt_kahypar_hypergraph_t>(hypergraph));
+    case Backend::dynamic_hypergraph:
+      return hgp_nlevel::mt_kahypar_total_weight(unwrap<mt_kahypar_hypergraph_t>(hypergraph));
+    case Backend::static_graph:
+      return gp::mt_kahypar_total_weight(unwrap<mt_kahypar_graph_t>(hypergraph));
+    case Backend::dynamic_graph:
+      return gp_nlevel::mt_kahypar_total_weight(unwrap<mt_kahypar_graph_t>(hypergraph));
+  }
+  return 0;
 }
 
 mt_kahypar_hypernode_id_t mt_kahypar_graph_weight(mt_kahypar_graph_t* graph) {
-  return gp::mt_kahypar_total_weight(graph);
+  return backend_of(graph) == Backend::dynamic_graph ?
+    gp_nlevel::mt_kahypar_total_weight(unwrap<mt_kahypar_graph_t>(graph)) :
+    gp::mt_kahypar_total_weight(unwrap<mt_kahypar_graph_t>(graph));
+}
+
+void mt_kahypar_add_fixed_vertices(mt_kahypar_hypergraph_t* hypergraph,
+                                   const mt_kahypar_partition_id_t* fixed_vertices) {
+  switch ( backend_of(hypergraph) ) {
+    case Backend::static_hypergraph:
+      hgp::mt_kahypar_add_fixed_vertices(unwrap<mt_kahypar_hypergraph_t>(hypergraph), fixed_vertices); break;
+    case Backend::dynamic_hypergraph:
+      hgp_nlevel::mt_kahypar_add_fixed_vertices(unwrap<mt_kahypar_hypergraph_t>(hypergraph), fixed_vertices); break;
+    case Backend::static_graph:
+      gp::mt_kahypar_add_fixed_nodes(unwrap<mt_kahypar_graph_t>(hypergraph), fixed_vertices); break;
+    case Backend::dynamic_graph:
+      gp_nlevel::mt_kahypar_add_fixed_nodes(unwrap<mt_kahypar_graph_t>(hypergraph), fixed_vertices); break;
+  }
+}
+
+void mt_kahypar_add_fixed_nodes(mt_kahypar_graph_t* graph,
+                                const mt_kahypar_partition_id_t* fixed_nodes) {
+  if ( backend_of(graph) == Backend::dynamic_graph ) {
+    gp_nlevel::mt_kahypar_add_fixed_nodes(unwrap<mt_kahypar_graph_t>(graph), fixed_nodes);
+  } else {
+    gp::mt_kahypar_add_fixed_nodes(unwrap<mt_kahypar_graph_t>(graph), fixed_nodes);
+  }
 }
 
 void mt_kahypar_free_partitioned_hypergraph(mt_kahypar_partitioned_hypergraph_t* partitioned_hg) {
-  hgp::mt_kahypar_free_partitioned_hypergraph(partitioned_hg);
+  if (partitioned_hg == nullptr) {
+    return;
+  }
+  Handle* handle = reinterpret_cast<Handle*>(partitioned_hg);
+  switch ( handle->backend ) {
+    case Backend::static_hypergraph:
+      hgp::mt_kahypar_free_partitioned_hypergraph(
+        unwrap<mt_kahypar_partitioned_hypergraph_t>(partitioned_hg)); break;
+    case Backend::dynamic_hypergraph:
+      hgp_nlevel::mt_kahypar_free_partitioned_hypergraph(
+        unwrap<mt_kahypar_partitioned_hypergraph_t>(partitioned_hg)); break;
+    case Backend::static_graph:
+      gp::mt_kahypar_free_partitioned_graph(
+        unwrap<mt_kahypar_partitioned_graph_t>(partitioned_hg)); break;
+    case Backend::dynamic_graph:
+      gp_nlevel::mt_kahypar_free_partitioned_graph(
+        unwrap<mt_kahypar_partitioned_graph_t>(partitioned_hg)); break;
+  }
+  delete handle;
 }
 
 void mt_kahypar_free_partitioned_graph(mt_kahypar_partitioned_graph_t* partitioned_graph) {
-  gp::mt_kahypar_free_partitioned_graph(partitioned_graph);
+  if (partitioned_graph == nullptr) {
+    return;
+  }
+  Handle* handle = reinterpret_cast<Handle*>(partitioned_graph);
+  if ( handle->backend == Backend::dynamic_graph ) {
+    gp_nlevel::mt_kahypar_free_partitioned_graph(unwrap<mt_kahypar_partitioned_graph_t>(partitioned_graph));
+  } else {
+    gp::mt_kahypar_free_partitioned_graph(unwrap<mt_kahypar_partitioned_graph_t>(partitioned_graph));
+  }
+  delete handle;
 }
 
 mt_kahypar_partitioned_hypergraph_t* mt_kahypar_partition_hypergraph(mt_kahypar_hypergraph_t* hypergraph,
                                                                      mt_kahypar_context_t* context) {
-  return hgp::mt_kahypar_partition(hypergraph, context);
+  const Backend backend = backend_of(hypergraph);
+  check_compatibility(backend, *reinterpret_cast<const mt_kahypar::Context*>(context));
+  return execute_in_thread_pool(context, [&]() -> mt_kahypar_partitioned_hypergraph_t* {
+    switch ( backend ) {
+      case Backend::static_hypergraph:
+        return wrap<mt_kahypar_partitioned_hypergraph_t>(backend,
+          hgp::mt_kahypar_partition(unwrap<mt_kahypar_hypergraph_t>(hypergraph), context));
+      case Backend::dynamic_hypergraph:
+        return wrap<mt_kahypar_partitioned_hypergraph_t>(backend,
+          hgp_nlevel::mt_kahypar_partition(unwrap<mt_kahypar_hypergraph_t>(hypergraph), context));
+      case Backend::static_graph:
+        return wrap<mt_kahypar_partitioned_hypergraph_t>(backend,
+          gp::mt_kahypar_partition(unwrap<mt_kahypar_graph_t>(hypergraph), context));
+      case Backend::dynamic_graph:
+        return wrap<mt_kahypar_partitioned_hypergraph_t>(backend,
+          gp_nlevel::mt_kahypar_partition(unwrap<mt_kahypar_graph_t>(hypergraph), context));
+    }
+    return nullptr;
+  });
 }
 
 mt_kahypar_partitioned_graph_t* mt_kahypar_partition_graph(mt_kahypar_graph_t* graph,
                                                            mt_kahypar_context_t* context) {
-  return gp::mt_kahypar_partition(graph, context);
+  const Backend backend = backend_of(graph);
+  check_compatibility(backend, *reinterpret_cast<const mt_kahypar::Context*>(context));
+  return execute_in_thread_pool(context, [&]() -> mt_kahypar_partitioned_graph_t* {
+    if ( backend == Backend::dynamic_graph ) {
+      return wrap<mt_kahypar_partitioned_graph_t>(backend,
+        gp_nlevel::mt_kahypar_partition(unwrap<mt_kahypar_graph_t>(graph), context));
+    }
+    return wrap<mt_kahypar_partitioned_graph_t>(backend,
+      gp::mt_kahypar_partition(unwrap<mt_kahypar_graph_t>(graph), context));
+  });
 }
 
+mt_kahypar_partitioning_job_t* mt_kahypar_partition_hypergraph_async(mt_kahypar_hypergraph_t* hypergraph,
+                                                                     mt_kahypar_context_t* context,
+                                                                     const double time_limit) {
+  check_compatibility(backend_of(hypergraph), *reinterpret_cast<const mt_kahypar::Context*>(context));
+  return start_partitioning_job(context, time_limit, false, [hypergraph](mt_kahypar_context_t* c) {
+    return reinterpret_cast<void*>(mt_kahypar_partition_hypergraph(hypergraph, c));
+  });
+}
+
+mt_kahypar_partitioning_job_t* mt_kahypar_partition_graph_async(mt_kahypar_graph_t* graph,
+                                                                mt_kahypar_context_t* context,
+                                                                const double time_limit) {
+  check_compatibility(backend_of(graph), *reinterpret_cast<const mt_kahypar::Context*>(context));
+  return start_partitioning_job(context, time_limit, true, [graph](mt_kahypar_context_t* c) {
+    return reinterpret_cast<void*>(mt_kahypar_partition_graph(graph, c));
+  });
+}
+
+bool mt_kahypar_poll_partitioning_job(mt_kahypar_partitioning_job_t* job) {
+  return job_of(job).finished.load(std::memory_order_acquire);
+}
+
+size_t mt_kahypar_get_partitioning_job_snapshot(mt_kahypar_partitioning_job_t* job,
+                                                mt_kahypar_partition_id_t* partition) {
+  PartitioningJob& j = job_of(job);
+  std::lock_guard<std::mutex> lock(j.snapshot_mutex);
+  std::copy(j.snapshot.begin(), j.snapshot.end(), partition);
+  return j.snapshot_version;
+}
+
+void mt_kahypar_cancel_partitioning_job(mt_kahypar_partitioning_job_t* job) {
+  job_of(job).context.cancellation_token->cancel();
+}
+
+mt_kahypar_partitioned_hypergraph_t* mt_kahypar_wait_hypergraph_partitioning_job(mt_kahypar_partitioning_job_t* job) {
+  if ( job_of(job).is_graph ) {
+    ERR("The partitioning job partitions a graph. Use mt_kahypar_wait_graph_partitioning_job(...) instead.");
+  }
+  return reinterpret_cast<mt_kahypar_partitioned_hypergraph_t*>(wait_for(job_of(job)));
+}
+
+mt_kahypar_partitioned_graph_t* mt_kahypar_wait_graph_partitioning_job(mt_kahypar_partitioning_job_t* job) {
+  if ( !job_of(job).is_graph ) {
+    ERR("The partitioning job partitions a hypergraph. Use mt_kahypar_wait_hypergraph_partitioning_job(...) instead.");
+  }
+  return reinterpret_cast<mt_kahypar_partitioned_graph_t*>(wait_for(job_of(job)));
+}
+
+void mt_kahypar_free_partitioning_job(mt_kahypar_partitioning_job_t* job) {
+  if ( job == nullptr ) {
+    return;
+  }
+  PartitioningJob& j = job_of(job);
+  j.context.cancellation_token->cancel();
+  void* result = wait_for(j);
+  if ( result ) {
+    if ( j.is_graph ) {
+      mt_kahypar_free_partitioned_graph(reinterpret_cast<mt_kahypar_partitioned_graph_t*>(result));
+    } else {
+      mt_kahypar_free_partitioned_hypergraph(reinterpret_cast<mt_kahypar_partitioned_hypergraph_t*>(result));
+    }
+  }
+  delete &j;
+}
+
+void mt_kahypar_partition_hypergraphs(mt_kahypar_hypergraph_t** hypergraphs,
+                                      mt_kahypar_context_t** contexts,
+                                      const size_t num_hypergraphs,
+                                      const size_t num_threads_per_job,
+                                      mt_kahypar_partitioned_hypergraph_t** partitioned_hypergraphs) {
+  partition_batch(hypergraphs, contexts, num_hypergraphs, num_threads_per_job, partitioned_hypergraphs);
+}
+
+void mt_kahypar_partition_graphs(mt_kahypar_graph_t** graphs,
+                                 mt_kahypar_context_t** contexts,
+                                 const size_t num_graphs,
+                                 const size_t num_threads_per_job,
+                                 mt_kahypar_partitioned_graph_t** partitioned_graphs) {
+  partition_batch(graphs, contexts, num_graphs, num_threads_per_job, partitioned_graphs);
+}
 
 void mt_kahypar_improve_hypergraph_partition(mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
                                              mt_kahypar_context_t* context,
                                              const size_t num_vcycles) {
-  hgp::mt_kahypar_improve_partition(partitioned_hg, context, num_vcycles);
+  const Backend backend = backend_of(partitioned_hg);
+  check_compatibility(backend, *reinterpret_cast<const mt_kahypar::Context*>(context));
+  execute_in_thread_pool(context, [&] {
+    switch ( backend ) {
+      case Backend::static_hypergraph:
+        hgp::mt_kahypar_improve_partition(
+          unwrap<mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), context, num_vcycles); break;
+      case Backend::dynamic_hypergraph:
+        hgp_nlevel::mt_kahypar_improve_partition(
+          unwrap<mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), context, num_vcycles); break;
+      case Backend::static_graph:
+        gp::mt_kahypar_improve_partition(
+          unwrap<mt_kahypar_partitioned_graph_t>(partitioned_hg), context, num_vcycles); break;
+      case Backend::dynamic_graph:
+        gp_nlevel::mt_kahypar_improve_partition(
+          unwrap<mt_kahypar_partitioned_graph_t>(partitioned_hg), context, num_vcycles); break;
+    }
+  });
 }
 
 void mt_kahypar_improve_graph_partition(mt_kahypar_partitioned_graph_t* partitioned_graph,
                                         mt_kahypar_context_t* context,
                                         const size_t num_vcycles) {
-  gp::mt_kahypar_improve_partition(partitioned_graph, context, num_vcycles);
+  const Backend backend = backend_of(partitioned_graph);
+  check_compatibility(backend, *reinterpret_cast<const mt_kahypar::Context*>(context));
+  execute_in_thread_pool(context, [&] {
+    if ( backend == Backend::dynamic_graph ) {
+      gp_nlevel::mt_kahypar_improve_partition(
+        unwrap<mt_kahypar_partitioned_graph_t>(partitioned_graph), context, num_vcycles);
+    } else {
+      gp::mt_kahypar_improve_partition(
+        unwrap<mt_kahypar_partitioned_graph_t>(partitioned_graph), context, num_vcycles);
+    }
+  });
+}
+
+mt_kahypar_partitioned_hypergraph_t* mt_kahypar_repartition_hypergraph(mt_kahypar_hypergraph_t* hypergraph,
+                                                                       mt_kahypar_context_t* context,
+                                                                       const mt_kahypar_partition_id_t* previous_partition,
+                                                                       const size_t num_vcycles) {
+  const Backend backend = backend_of(hypergraph);
+  check_compatibility(backend, *reinterpret_cast<const mt_kahypar::Context*>(context));
+  return execute_in_thread_pool(context, [&]() -> mt_kahypar_partitioned_hypergraph_t* {
+    switch ( backend ) {
+      case Backend::static_hypergraph:
+        return wrap<mt_kahypar_partitioned_hypergraph_t>(backend, hgp::mt_kahypar_repartition(
+          unwrap<mt_kahypar_hypergraph_t>(hypergraph), context, previous_partition, num_vcycles));
+      case Backend::dynamic_hypergraph:
+        return wrap<mt_kahypar_partitioned_hypergraph_t>(backend, hgp_nlevel::mt_kahypar_repartition(
+          unwrap<mt_kahypar_hypergraph_t>(hypergraph), context, previous_partition, num_vcycles));
+      case Backend::static_graph:
+        return wrap<mt_kahypar_partitioned_hypergraph_t>(backend, gp::mt_kahypar_repartition(
+          unwrap<mt_kahypar_graph_t>(hypergraph), context, previous_partition, num_vcycles));
+      case Backend::dynamic_graph:
+        return wrap<mt_kahypar_partitioned_hypergraph_t>(backend, gp_nlevel::mt_kahypar_repartition(
+          unwrap<mt_kahypar_graph_t>(hypergraph), context, previous_partition, num_vcycles));
+    }
+    return nullptr;
+  });
+}
+
+mt_kahypar_partitioned_graph_t* mt_kahypar_repartition_graph(mt_kahypar_graph_t* graph,
+                                                             mt_kahypar_context_t* context,
+                                                             const mt_kahypar_partition_id_t* previous_partition,
+                                                             const size_t num_vcycles) {
+  const Backend backend = backend_of(graph);
+  check_compatibility(backend, *reinterpret_cast<const mt_kahypar::Context*>(context));
+  return execute_in_thread_pool(context, [&]() -> mt_kahypar_partitioned_graph_t* {
+    if ( backend == Backend::dynamic_graph ) {
+      return wrap<mt_kahypar_partitioned_graph_t>(backend, gp_nlevel::mt_kahypar_repartition(
+        unwrap<mt_kahypar_graph_t>(graph), context, previous_partition, num_vcycles));
+    }
+    return wrap<mt_kahypar_partitioned_graph_t>(backend, gp::mt_kahypar_repartition(
+      unwrap<mt_kahypar_graph_t>(graph), context, previous_partition, num_vcycles));
+  });
+}
+
+void mt_kahypar_partition_hypergraph_for_targets(mt_kahypar_hypergraph_t* hypergraph,
+                                                 mt_kahypar_context_t* context,
+                                                 const size_t num_targets,
+                                                 const mt_kahypar_partition_id_t* num_blocks,
+                                                 const double* epsilons,
+                                                 mt_kahypar_partition_id_t* partitions) {
+  const Backend backend = backend_of(hypergraph);
+  check_compatibility(backend, *reinterpret_cast<const mt_kahypar::Context*>(context));
+  execute_in_thread_pool(context, [&] {
+    switch ( backend ) {
+      case Backend::static_hypergraph:
+        hgp::mt_kahypar_partition_for_targets(unwrap<mt_kahypar_hypergraph_t>(hypergraph),
+          context, num_targets, num_blocks, epsilons, partitions); break;
+      case Backend::dynamic_hypergraph:
+        hgp_nlevel::mt_kahypar_partition_for_targets(unwrap<mt_kahypar_hypergraph_t>(hypergraph),
+          context, num_targets, num_blocks, epsilons, partitions); break;
+      case Backend::static_graph:
+        gp::mt_kahypar_partition_for_targets(unwrap<mt_kahypar_graph_t>(hypergraph),
+          context, num_targets, num_blocks, epsilons, partitions); break;
+      case Backend::dynamic_graph:
+        gp_nlevel::mt_kahypar_partition_for_targets(unwrap<mt_kahypar_graph_t>(hypergraph),
+          context, num_targets, num_blocks, epsilons, partitions); break;
+    }
+  });
+}
+
+void mt_kahypar_partition_graph_for_targets(mt_kahypar_graph_t* graph,
+                                            mt_kahypar_context_t* context,
+                                            const size_t num_targets,
+                                            const mt_kahypar_partition_id_t* num_blocks,
+                                            const double* epsilons,
+                                            mt_kahypar_partition_id_t* partitions) {
+  const Backend backend = backend_of(graph);
+  check_compatibility(backend, *reinterpret_cast<const mt_kahypar::Context*>(context));
+  execute_in_thread_pool(context, [&] {
+    if ( backend == Backend::dynamic_graph ) {
+      gp_nlevel::mt_kahypar_partition_for_targets(unwrap<mt_kahypar_graph_t>(graph),
+        context, num_targets, num_blocks, epsilons, partitions);
+    } else {
+      gp::mt_kahypar_partition_for_targets(unwrap<mt_kahypar_graph_t>(graph),
+        context, num_targets, num_blocks, epsilons, partitions);
+    }
+  });
+}
+
+mt_kahypar_session_t* mt_kahypar_session_new() {
+  Session* session = new Session();
+  session->uses_memory_pool.fill(false);
+  return reinterpret_cast<mt_kahypar_session_t*>(session);
+}
+
+void mt_kahypar_free_session(mt_kahypar_session_t* session) {
+  if (session == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(session_mutex);
+  Session* s = reinterpret_cast<Session*>(session);
+  if ( s->uses_memory_pool[static_cast<size_t>(Backend::static_hypergraph)] ) hgp::mt_kahypar_free_memory_pool();
+  if ( s->uses_memory_pool[static_cast<size_t>(Backend::dynamic_hypergraph)] ) hgp_nlevel::mt_kahypar_free_memory_pool();
+  if ( s->uses_memory_pool[static_cast<size_t>(Backend::static_graph)] ) gp::mt_kahypar_free_memory_pool();
+  if ( s->uses_memory_pool[static_cast<size_t>(Backend::dynamic_graph)] ) gp_nlevel::mt_kahypar_free_memory_pool();
+  delete s;
+}
+
+void mt_kahypar_session_partition_hypergraph(mt_kahypar_session_t* session,
+                                             mt_kahypar_hypergraph_t* hypergraph,
+                                             mt_kahypar_context_t* context,
+                                             mt_kahypar_partition_id_t* partition) {
+  const Backend backend = backend_of(hypergraph);
+  check_compatibility(backend, *reinterpret_cast<const mt_kahypar::Context*>(context));
+  execute_in_thread_pool(context, [&] {
+    std::lock_guard<std::mutex> lock(session_mutex);
+    reinterpret_cast<Session*>(session)->uses_memory_pool[static_cast<size_t>(backend)] = true;
+    switch ( backend ) {
+      case Backend::static_hypergraph:
+        hgp::mt_kahypar_partition_with_memory_pool(
+          unwrap<mt_kahypar_hypergraph_t>(hypergraph), context, partition); break;
+      case Backend::dynamic_hypergraph:
+        hgp_nlevel::mt_kahypar_partition_with_memory_pool(
+          unwrap<mt_kahypar_hypergraph_t>(hypergraph), context, partition); break;
+      case Backend::static_graph:
+        gp::mt_kahypar_partition_with_memory_pool(
+          unwrap<mt_kahypar_graph_t>(hypergraph), context, partition); break;
+      case Backend::dynamic_graph:
+        gp_nlevel::mt_kahypar_partition_with_memory_pool(
+          unwrap<mt_kahypar_graph_t>(hypergraph), context, partition); break;
+    }
+  });
+}
+
+void mt_kahypar_session_partition_graph(mt_kahypar_session_t* session,
+                                        mt_kahypar_graph_t* graph,
+                                        mt_kahypar_context_t* context,
+                                        mt_kahypar_partition_id_t* partition) {
+  const Backend backend = backend_of(graph);
+  check_compatibility(backend, *reinterpret_cast<const mt_kahypar::Context*>(context));
+  execute_in_thread_pool(context, [&] {
+    std::lock_guard<std::mutex> lock(session_mutex);
+    reinterpret_cast<Session*>(session)->uses_memory_pool[static_cast<size_t>(backend)] = true;
+    if ( backend == Backend::dynamic_graph ) {
+      gp_nlevel::mt_kahypar_partition_with_memory_pool(
+        unwrap<mt_kahypar_graph_t>(graph), context, partition);
+    } else {
+      gp::mt_kahypar_partition_with_memory_pool(
+        unwrap<mt_kahypar_graph_t>(graph), context, partition);
+    }
+  });
 }
 
 mt_kahypar_partitioned_hypergraph_t* mt_kahypar_create_partitioned_hypergraph(mt_kahypar_hypergraph_t* hypergraph,
                                                                               const mt_kahypar_partition_id_t num_blocks,
                                                                               const mt_kahypar_partition_id_t* partition) {
-  return hgp::mt_kahypar_create_partitioned_hypergraph(hypergraph, num_blocks, partition);
+  const Backend backend = backend_of(hypergraph);
+  switch ( backend ) {
+    case Backend::static_hypergraph:
+      return wrap<mt_kahypar_partitioned_hypergraph_t>(backend, hgp::mt_kahypar_create_partitioned_hypergraph(
+        unwrap<mt_kahypar_hypergraph_t>(hypergraph), num_blocks, partition));
+    case Backend::dynamic_hypergraph:
+      return wrap<mt_kahypar_partitioned_hypergraph_t>(backend, hgp_nlevel::mt_kahypar_create_partitioned_hypergraph(
+        unwrap<mt_kahypar_hypergraph_t>(hypergraph), num_blocks, partition));
+    case Backend::static_graph:
+      return wrap<mt_kahypar_partitioned_hypergraph_t>(backend, gp::mt_kahypar_create_partitioned_graph(
+        unwrap<mt_kahypar_graph_t>(hypergraph), num_blocks, partition));
+    case Backend::dynamic_graph:
+      return wrap<mt_kahypar_partitioned_hypergraph_t>(backend, gp_nlevel::mt_kahypar_create_partitioned_graph(
+        unwrap<mt_kahypar_graph_t>(hypergraph), num_blocks, partition));
+  }
+  return nullptr;
 }
 
 mt_kahypar_partitioned_graph_t* mt_kahypar_create_partitioned_graph(mt_kahypar_graph_t* graph,
                                                                     const mt_kahypar_partition_id_t num_blocks,
                                                                     const mt_kahypar_partition_id_t* partition) {
-  return gp::mt_kahypar_create_partitioned_graph(graph, num_blocks, partition);
+  const Backend backend = backend_of(graph);
+  if ( backend == Backend::dynamic_graph ) {
+    return wrap<mt_kahypar_partitioned_graph_t>(backend, gp_nlevel::mt_kahypar_create_partitioned_graph(
+      unwrap<mt_kahypar_graph_t>(graph), num_blocks, partition));
+  }
+  return wrap<mt_kahypar_partitioned_graph_t>(backend, gp::mt_kahypar_create_partitioned_graph(
+    unwrap<mt_kahypar_graph_t>(graph), num_blocks, partition));
 }
 
 mt_kahypar_partitioned_hypergraph_t* mt_kahypar_read_hypergraph_partition_from_file(mt_kahypar_hypergraph_t* hypergraph,
                                                                                     const mt_kahypar_partition_id_t num_blocks,
                                                                                     const char* partition_file) {
-  return hgp::mt_kahypar_read_partition_from_file(hypergraph, num_blocks, partition_file);
+  const Backend backend = backend_of(hypergraph);
+  switch ( backend ) {
+    case Backend::static_hypergraph:
+      return wrap<mt_kahypar_partitioned_hypergraph_t>(backend, hgp::mt_kahypar_read_partition_from_file(
+        unwrap<mt_kahypar_hypergraph_t>(hypergraph), num_blocks, partition_file));
+    case Backend::dynamic_hypergraph:
+      return wrap<mt_kahypar_partitioned_hypergraph_t>(backend, hgp_nlevel::mt_kahypar_read_partition_from_file(
+        unwrap<mt_kahypar_hypergraph_t>(hypergraph), num_blocks, partition_file));
+    case Backend::static_graph:
+      return wrap<mt_kahypar_partitioned_hypergraph_t>(backend, gp::mt_kahypar_read_partition_from_file(
+        unwrap<mt_kahypar_graph_t>(hypergraph), num_blocks, partition_file));
+    case Backend::dynamic_graph:
+      return wrap<mt_kahypar_partitioned_hypergraph_t>(backend, gp_nlevel::mt_kahypar_read_partition_from_file(
+        unwrap<mt_kahypar_graph_t>(hypergraph), num_blocks, partition_file));
+  }
+  return nullptr;
 }
 
 mt_kahypar_partitioned_graph_t* mt_kahypar_read_graph_partition_from_file(mt_kahypar_graph_t* graph,
                                                                           const mt_kahypar_partition_id_t num_blocks,
                                                                           const char* partition_file) {
-  return gp::mt_kahypar_read_partition_from_file(graph, num_blocks, partition_file);
+  const Backend backend = backend_of(graph);
+  if ( backend == Backend::dynamic_graph ) {
+    return wrap<mt_kahypar_partitioned_graph_t>(backend, gp_nlevel::mt_kahypar_read_partition_from_file(
+      unwrap<mt_kahypar_graph_t>(graph), num_blocks, partition_file));
+  }
+  return wrap<mt_kahypar_partitioned_graph_t>(backend, gp::mt_kahypar_read_partition_from_file(
+    unwrap<mt_kahypar_graph_t>(graph), num_blocks, partition_file));
 }
 
 void mt_kahypar_write_hypergraph_partition_to_file(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
                                                    const char* partition_file) {
-  hgp::mt_kahypar_write_partition_to_file(partitioned_hg, partition_file);
+  switch ( backend_of(partitioned_hg) ) {
+    case Backend::static_hypergraph:
+      hgp::mt_kahypar_write_partition_to_file(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), partition_file); break;
+    case Backend::dynamic_hypergraph:
+      hgp_nlevel::mt_kahypar_write_partition_to_file(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), partition_file); break;
+    case Backend::static_graph:
+      gp::mt_kahypar_write_partition_to_file(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg), partition_file); break;
+    case Backend::dynamic_graph:
+      gp_nlevel::mt_kahypar_write_partition_to_file(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg), partition_file); break;
+  }
 }
 
 void mt_kahypar_write_graph_partition_to_file(const mt_kahypar_partitioned_graph_t* partitioned_graph,
                                               const char* partition_file) {
-  gp::mt_kahypar_write_partition_to_file(partitioned_graph, partition_file);
+  if ( backend_of(partitioned_graph) == Backend::dynamic_graph ) {
+    gp_nlevel::mt_kahypar_write_partition_to_file(
+      unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph), partition_file);
+  } else {
+    gp::mt_kahypar_write_partition_to_file(
+      unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph), partition_file);
+  }
+}
+
+void mt_kahypar_write_hypergraph_partition_to_binary_file(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
+                                                          const char* partition_file) {
+  switch ( backend_of(partitioned_hg) ) {
+    case Backend::static_hypergraph:
+      hgp::mt_kahypar_write_partition_to_binary_file(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), partition_file); break;
+    case Backend::dynamic_hypergraph:
+      hgp_nlevel::mt_kahypar_write_partition_to_binary_file(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), partition_file); break;
+    case Backend::static_graph:
+      gp::mt_kahypar_write_partition_to_binary_file(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg), partition_file); break;
+    case Backend::dynamic_graph:
+      gp_nlevel::mt_kahypar_write_partition_to_binary_file(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg), partition_file); break;
+  }
+}
+
+void mt_kahypar_write_graph_partition_to_binary_file(const mt_kahypar_partitioned_graph_t* partitioned_graph,
+                                                     const char* partition_file) {
+  if ( backend_of(partitioned_graph) == Backend::dynamic_graph ) {
+    gp_nlevel::mt_kahypar_write_partition_to_binary_file(
+      unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph), partition_file);
+  } else {
+    gp::mt_kahypar_write_partition_to_binary_file(
+      unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph), partition_file);
+  }
 }
 
 void mt_kahypar_get_hypergraph_partition(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
                                          mt_kahypar_partition_id_t* partition) {
-  hgp::mt_kahypar_get_partition(partitioned_hg, partition);
+  switch ( backend_of(partitioned_hg) ) {
+    case Backend::static_hypergraph:
+      hgp::mt_kahypar_get_partition(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), partition); break;
+    case Backend::dynamic_hypergraph:
+      hgp_nlevel::mt_kahypar_get_partition(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), partition); break;
+    case Backend::static_graph:
+      gp::mt_kahypar_get_partition(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg), partition); break;
+    case Backend::dynamic_graph:
+      gp_nlevel::mt_kahypar_get_partition(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg), partition); break;
+  }
 }
 
 void mt_kahypar_get_graph_partition(const mt_kahypar_partitioned_graph_t* partitioned_graph,
                                     mt_kahypar_partition_id_t* partition) {
-  gp::mt_kahypar_get_partition(partitioned_graph, partition);
+  if ( backend_of(partitioned_graph) == Backend::dynamic_graph ) {
+    gp_nlevel::mt_kahypar_get_partition(
+      unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph), partition);
+  } else {
+    gp::mt_kahypar_get_partition(
+      unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph), partition);
+  }
+}
+
+const mt_kahypar_partition_id_t* mt_kahypar_get_hypergraph_partition_view(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg) {
+  switch ( backend_of(partitioned_hg) ) {
+    case Backend::static_hypergraph:
+      return hgp::mt_kahypar_get_partition_view(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg));
+    case Backend::dynamic_hypergraph:
+      return hgp_nlevel::mt_kahypar_get_partition_view(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg));
+    case Backend::static_graph:
+      return gp::mt_kahypar_get_partition_view(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg));
+    case Backend::dynamic_graph:
+      return gp_nlevel::mt_kahypar_get_partition_view(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg));
+  }
+  return nullptr;
+}
+
+const mt_kahypar_partition_id_t* mt_kahypar_get_graph_partition_view(const mt_kahypar_partitioned_graph_t* partitioned_graph) {
+  if ( backend_of(partitioned_graph) == Backend::dynamic_graph ) {
+    return gp_nlevel::mt_kahypar_get_partition_view(
+      unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph));
+  } else {
+    return gp::mt_kahypar_get_partition_view(
+      unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph));
+  }
 }
 
 void mt_kahypar_get_hypergraph_block_weights(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
                                              mt_kahypar_hypernode_weight_t* block_weights) {
-  hgp::mt_kahypar_get_block_weights(partitioned_hg, block_weights);
+  switch ( backend_of(partitioned_hg) ) {
+    case Backend::static_hypergraph:
+      hgp::mt_kahypar_get_block_weights(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), block_weights); break;
+    case Backend::dynamic_hypergraph:
+      hgp_nlevel::mt_kahypar_get_block_weights(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), block_weights); break;
+    case Backend::static_graph:
+      gp::mt_kahypar_get_block_weights(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg), block_weights); break;
+    case Backend::dynamic_graph:
+      gp_nlevel::mt_kahypar_get_block_weights(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg), block_weights); break;
+  }
 }
 
 void mt_kahypar_get_graph_block_weights(const mt_kahypar_partitioned_graph_t* partitioned_graph,
                                         mt_kahypar_hypernode_weight_t* block_weights) {
-  gp::mt_kahypar_get_block_weights(partitioned_graph, block_weights);
+  if ( backend_of(partitioned_graph) == Backend::dynamic_graph ) {
+    gp_nlevel::mt_kahypar_get_block_weights(
+      unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph), block_weights);
+  } else {
+    gp::mt_kahypar_get_block_weights(
+      unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph), block_weights);
+  }
 }
 
 double mt_kahypar_hypergraph_imbalance(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
                                        const mt_kahypar_context_t* context) {
-  return hgp::mt_kahypar_imbalance(partitioned_hg, context);
+  switch ( backend_of(partitioned_hg) ) {
+    case Backend::static_hypergraph:
+      return hgp::mt_kahypar_imbalance(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), context);
+    case Backend::dynamic_hypergraph:
+      return hgp_nlevel::mt_kahypar_imbalance(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), context);
+    case Backend::static_graph:
+      return gp::mt_kahypar_imbalance(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg), context);
+    case Backend::dynamic_graph:
+      return gp_nlevel::mt_kahypar_imbalance(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg), context);
+  }
+  return 0.0;
 }
 
 double mt_kahypar_graph_imbalance(const mt_kahypar_partitioned_graph_t* partitioned_graph,
                             const mt_kahypar_context_t* context) {
-  return gp::mt_kahypar_imbalance(partitioned_graph, context);
+  return backend_of(partitioned_graph) == Backend::dynamic_graph ?
+    gp_nlevel::mt_kahypar_imbalance(unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph), context) :
+    gp::mt_kahypar_imbalance(unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph), context);
 }
 
 mt_kahypar_hyperedge_weight_t mt_kahypar_hypergraph_cut(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg) {
-  return hgp::mt_kahypar_cut(partitioned_hg);
+  switch ( backend_of(partitioned_hg) ) {
+    case Backend::static_hypergraph:
+      return hgp::mt_kahypar_cut(unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg));
+    case Backend::dynamic_hypergraph:
+      return hgp_nlevel::mt_kahypar_cut(unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg));
+    case Backend::static_graph:
+      return gp::mt_kahypar_cut(unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg));
+    case Backend::dynamic_graph:
+      return gp_nlevel::mt_kahypar_cut(unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg));
+  }
+  return 0;
 }
 
 mt_kahypar_hyperedge_weight_t mt_kahypar_graph_cut(const mt_kahypar_partitioned_graph_t* partitioned_graph) {
-  return gp::mt_kahypar_cut(partitioned_graph);
+  return backend_of(partitioned_graph) == Backend::dynamic_graph ?
+    gp_nlevel::mt_kahypar_cut(unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph)) :
+    gp::mt_kahypar_cut(unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph));
 }
 
 mt_kahypar_hyperedge_weight_t mt_kahypar_km1(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg) {
-  return hgp::mt_kahypar_km1(partitioned_hg);
+  switch ( backend_of(partitioned_hg) ) {
+    case Backend::static_hypergraph:
+      return hgp::mt_kahypar_km1(unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg));
+    case Backend::dynamic_hypergraph:
+      return hgp_nlevel::mt_kahypar_km1(unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg));
+    case Backend::static_graph:
+    case Backend::dynamic_graph:
+      // For graphs, the connectivity metric is equal to the edge cut
+      return mt_kahypar_hypergraph_cut(partitioned_hg);
+  }
+  return 0;
 }
 
 mt_kahypar_hyperedge_weight_t mt_kahypar_soed(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg) {
-  return hgp::mt_kahypar_soed(partitioned_hg);
-}
\ No newline at end of file
+  switch ( backend_of(partitioned_hg) ) {
+    case Backend::static_hypergraph:
+      return hgp::mt_kahypar_soed(unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg));
+    case Backend::dynamic_hypergraph:
+      return hgp_nlevel::mt_kahypar_soed(unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg));
+    case Backend::static_graph:
+    case Backend::dynamic_graph:
+      // Each cut edge of a graph connects exactly two blocks
+      return 2 * mt_kahypar_hypergraph_cut(partitioned_hg);
+  }
+  return 0;
+}
+
+size_t mt_kahypar_get_hypergraph_block_pair_cuts(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
+                                                 mt_kahypar_partition_id_t* block_0,
+                                                 mt_kahypar_partition_id_t* block_1,
+                                                 mt_kahypar_hyperedge_weight_t* weights,
+                                                 const size_t max_entries) {
+  switch ( backend_of(partitioned_hg) ) {
+    case Backend::static_hypergraph:
+      return hgp::mt_kahypar_get_block_pair_cuts(unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg),
+        block_0, block_1, weights, max_entries);
+    case Backend::dynamic_hypergraph:
+      return hgp_nlevel::mt_kahypar_get_block_pair_cuts(unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg),
+        block_0, block_1, weights, max_entries);
+    case Backend::static_graph:
+      return gp::mt_kahypar_get_block_pair_cuts(unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg),
+        block_0, block_1, weights, max_entries);
+    case Backend::dynamic_graph:
+      return gp_nlevel::mt_kahypar_get_block_pair_cuts(unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg),
+        block_0, block_1, weights, max_entries);
+  }
+  return 0;
+}
+
+size_t mt_kahypar_get_graph_block_pair_cuts(const mt_kahypar_partitioned_graph_t* partitioned_graph,
+                                            mt_kahypar_partition_id_t* block_0,
+                                            mt_kahypar_partition_id_t* block_1,
+                                            mt_kahypar_hyperedge_weight_t* weights,
+                                            const size_t max_entries) {
+  return backend_of(partitioned_graph) == Backend::dynamic_graph ?
+    gp_nlevel::mt_kahypar_get_block_pair_cuts(unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph),
+      block_0, block_1, weights, max_entries) :
+    gp::mt_kahypar_get_block_pair_cuts(unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph),
+      block_0, block_1, weights, max_entries);
+}
+
+size_t mt_kahypar_get_hypergraph_report(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
+                                        const mt_kahypar_context_t* context,
+                                        char* buffer,
+                                        const size_t buffer_size) {
+  switch ( backend_of(partitioned_hg) ) {
+    case Backend::static_hypergraph:
+      return hgp::mt_kahypar_get_report(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), context, buffer, buffer_size);
+    case Backend::dynamic_hypergraph:
+      return hgp_nlevel::mt_kahypar_get_report(
+        unwrap<const mt_kahypar_partitioned_hypergraph_t>(partitioned_hg), context, buffer, buffer_size);
+    case Backend::static_graph:
+      return gp::mt_kahypar_get_report(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg), context, buffer, buffer_size);
+    case Backend::dynamic_graph:
+      return gp_nlevel::mt_kahypar_get_report(
+        unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_hg), context, buffer, buffer_size);
+  }
+  return 0;
+}
+
+size_t mt_kahypar_get_graph_report(const mt_kahypar_partitioned_graph_t* partitioned_graph,
+                                   const mt_kahypar_context_t* context,
+                                   char* buffer,
+                                   const size_t buffer_size) {
+  return backend_of(partitioned_graph) == Backend::dynamic_graph ?
+    gp_nlevel::mt_kahypar_get_report(
+      unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph), context, buffer, buffer_size) :
+    gp::mt_kahypar_get_report(
+      unwrap<const mt_kahypar_partitioned_graph_t>(partitioned_graph), context, buffer, buffer_size);
+}
@@ -26,9 +26,16 @@
  ******************************************************************************/
 
 #include "libmtkahypargp.h"
+#ifdef USE_STRONG_PARTITIONER
+#include "libmtkahyparnlevel.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
 
 #include "tbb/parallel_for.h"
 #include "tbb/parallel_invoke.h"
+#include "tbb/task_group.h"
 
 #ifndef USE_GRAPH_PARTITIONER
 #define USE_GRAPH_PARTITIONER
@@ -41,9 +48,11 @@
 #include "mt-kahypar/parallel/memory_pool.h"
 #include "mt-kahypar/parallel/parallel_prefix_sum.h"
 #include "mt-kahypar/partition/partitioner.h"
+#include "mt-kahypar/partition/partition_cache.h"
 #include "mt-kahypar/partition/registries/register_memory_pool.h"
 #include "mt-kahypar/partition/metrics.h"
 #include "mt-kahypar/io/hypergraph_io.h"
+#include "mt-kahypar/io/json_report.h"
 #include "mt-kahypar/utils/randomize.h"
 #include "mt-kahypar/utils/utilities.h"
 
@@ -52,7 +61,11 @@ namespace {
   using vec = mt_kahypar::parallel::scalable_vector<T>;
 }
 
+#ifdef USE_STRONG_PARTITIONER
+namespace gp_nlevel {
+#else
 namespace gp {
+#endif
 
 using Graph = mt_kahypar::Hypergraph;
 using PartitionedGraph = mt_kahypar::PartitionedHypergraph;
@@ -89,6 +102,18 @@ mt_kahypar_graph_t* mt_kahypar_create_graph(const mt_kahypar_hypernode_id_t num_
   return reinterpret_cast<mt_kahypar_graph_t*>(graph);
 }
 
+mt_kahypar_graph_t* mt_kahypar_create_graph_from_csr(const mt_kahypar_hypernode_id_t num_vertices,
+                                                     const size_t* xadj,
+                                                     const mt_kahypar_hypernode_id_t* adjncy,
+                                                     const mt_kahypar_hyperedge_weight_t* adjacency_weights,
+                                                     const mt_kahypar_hypernode_weight_t* vertex_weights) {
+  Graph* graph = new Graph();
+  *graph = mt_kahypar::HypergraphFactory::construct_from_csr(
+    num_vertices, xadj, adjncy, adjacency_weights, vertex_weights);
+
+  return reinterpret_cast<mt_kahypar_graph_t*>(graph);
+}
+
 void mt_kahypar_free_graph(mt_kahypar_graph_t* graph) {
   if (graph == nullptr) {
     return;
@@ -108,6 +133,16 @@ mt_kahypar_hypernode_id_t mt_kahypar_total_weight(mt_kahypar_graph_t* graph) {
   return reinterpret_cast<Graph*>(graph)->totalWeight();
 }
 
+void mt_kahypar_add_fixed_nodes(mt_kahypar_graph_t* graph,
+                                const mt_kahypar_partition_id_t* fixed_nodes) {
+  Graph& g = *reinterpret_cast<Graph*>(graph);
+  for ( mt_kahypar::HypernodeID u = 0; u < g.initialNumNodes(); ++u ) {
+    if ( fixed_nodes[u] != mt_kahypar::kInvalidPartition ) {
+      g.fixToBlock(u, fixed_nodes[u]);
+    }
+  }
+}
+
 void mt_kahypar_free_partitioned_graph(mt_kahypar_partitioned_graph_t* partitioned_graph) {
   if (partitioned_graph == nullptr) {
     return;
@@ -118,8 +153,15 @@ void mt_kahypar_free_partitioned_graph(mt_kahypar_partitioned_graph_t* partition
 namespace {
   void prepare_context(mt_kahypar::Context& context) {
     context.partition.mode = mt_kahypar::Mode::direct;
-    context.shared_memory.original_num_threads = mt_kahypar::TBBInitializer::instance().total_number_of_threads();
-    context.shared_memory.num_threads = mt_kahypar::TBBInitializer::instance().total_number_of_threads();
+#ifdef USE_STRONG_PARTITIONER
+    context.partition.paradigm = mt_kahypar::Paradigm::nlevel;
+#else
+    context.partition.paradigm = mt_kahypar::Paradigm::multilevel;
+#endif
+    const size_t num_threads = context.thread_pool ? context.thread_pool->total_number_of_threads() :
+      mt_kahypar::TBBInitializer::instance().total_number_of_threads();
+    context.shared_memory.original_num_threads = num_threads;
+    context.shared_memory.num_threads = num_threads;
     context.utility_id = mt_kahypar::utils::Utilities::instance().registerNewUtilityObjects();
 
     context.partition.perfect_balance_part_weights.clear();
@@ -160,17 +202,100 @@ namespace {
 mt_kahypar_partitioned_graph_t* mt_kahypar_partition(mt_kahypar_graph_t* graph,
                                                      mt_kahypar_context_t* context) {
   Graph& gr = *reinterpret_cast<Graph*>(graph);
-  PartitionedGraph* p_graph = new PartitionedGraph();
   mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(context);
   prepare_context(c);
   mt_kahypar::utils::Randomize::instance().setSeed(c.partition.seed);
 
+  // Return the cached partition, if the same input was partitioned before
+  mt_kahypar::PartitionCache& cache = mt_kahypar::PartitionCache::instance();
+  const bool use_cache = mt_kahypar::PartitionCache::isEnabled(c);
+  const uint64_t cache_key = use_cache ? mt_kahypar::PartitionCache::key(gr, c) : 0;
+  vec<mt_kahypar::PartitionID> cached_partition;
+  if ( use_cache && cache.lookup(cache_key, c, gr.initialNumNodes(), cached_partition) ) {
+    return mt_kahypar_create_partitioned_graph(graph, c.partition.k, cached_partition.data());
+  }
+
   // Partition Graph
+  PartitionedGraph* p_graph = new PartitionedGraph();
   *p_graph = mt_kahypar::partition(gr, c);
+  if ( use_cache ) {
+    cache.insert(cache_key, c, *p_graph);
+  }
 
   return reinterpret_cast<mt_kahypar_partitioned_graph_t*>(p_graph);
 }
 
+void mt_kahypar_partition_batch(mt_kahypar_graph_t** graphs,
+                                mt_kahypar_context_t** contexts,
+                                const size_t num_graphs,
+                                const size_t num_threads_per_job,
+                                mt_kahypar_partitioned_graph_t** partitioned_graphs) {
+  if ( num_graphs == 0 ) {
+    return;
+  }
+
+  const size_t num_threads = mt_kahypar::TBBInitializer::instance().total_number_of_threads();
+  const size_t threads_per_job = num_threads_per_job > 0 ?
+    std::min(num_threads_per_job, num_threads) : std::max(num_threads / num_graphs, UL(1));
+  // The thread budget of a job is modeled via the number of threads in its context
+  // (similar to recursive bipartitioning calls with a smaller number of threads)
+  for ( size_t i = 0; i < num_graphs; ++i ) {
+    mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(contexts[i]);
+    prepare_context(c);
+    c.shared_memory.original_num_threads = threads_per_job;
+    c.shared_memory.num_threads = threads_per_job;
+  }
+  mt_kahypar::utils::Randomize::instance().setSeed(
+    reinterpret_cast<mt_kahypar::Context*>(contexts[0])->partition.seed);
+
+  // Partition Graphs
+  tbb::task_group tg;
+  for ( size_t i = 0; i < num_graphs; ++i ) {
+    tg.run([&, i] {
+      Graph& gr = *reinterpret_cast<Graph*>(graphs[i]);
+      mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(contexts[i]);
+      PartitionedGraph* p_graph = new PartitionedGraph();
+      *p_graph = mt_kahypar::partition(gr, c);
+      partitioned_graphs[i] = reinterpret_cast<mt_kahypar_partitioned_graph_t*>(p_graph);
+    });
+  }
+  tg.wait();
+}
+
+void mt_kahypar_partition_with_memory_pool(mt_kahypar_graph_t* graph,
+                                          mt_kahypar_context_t* context,
+                                          mt_kahypar_partition_id_t* partition) {
+  ASSERT(partition != nullptr);
+  Graph& gr = *reinterpret_cast<Graph*>(graph);
+  mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(context);
+  prepare_context(c);
+  mt_kahypar::utils::Randomize::instance().setSeed(c.partition.seed);
+
+  // Memory chunks are only reallocated if the graph requires
+  // more memory than all graphs partitioned before
+  mt_kahypar::parallel::MemoryPool& pool = mt_kahypar::parallel::MemoryPool::instance();
+  mt_kahypar::apply_memory_limit(gr, c);
+  mt_kahypar::register_memory_pool(gr, c);
+  pool.enable_memory_requests();
+
+  // Partition Graph
+  {
+    PartitionedGraph p_graph = mt_kahypar::partition(gr, c);
+    p_graph.doParallelForAllNodes([&](const mt_kahypar::HypernodeID& hn) {
+      partition[hn] = p_graph.partID(hn);
+    });
+  }
+
+  // All data structures allocated from the memory pool are destroyed at this point
+  // => restore memory pool for the next call
+  pool.reset();
+  pool.disable_memory_requests();
+}
+
+void mt_kahypar_free_memory_pool() {
+  mt_kahypar::parallel::MemoryPool::instance().free_memory_chunks();
+}
+
 void mt_kahypar_improve_partition(mt_kahypar_partitioned_graph_t* partitioned_graph,
                                   mt_kahypar_context_t* context,
                                   const size_t num_vcycles) {
@@ -184,6 +309,46 @@ void mt_kahypar_improve_partition(mt_kahypar_partitioned_graph_t* partitioned_gr
   mt_kahypar::partitionVCycle(p_graph, c);
 }
 
+mt_kahypar_partitioned_graph_t* mt_kahypar_repartition(mt_kahypar_graph_t* graph,
+                                                       mt_kahypar_context_t* context,
+                                                       const mt_kahypar_partition_id_t* previous_partition,
+                                                       const size_t num_vcycles) {
+  Graph& gr = *reinterpret_cast<Graph*>(graph);
+  PartitionedGraph* p_graph = new PartitionedGraph();
+  mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(context);
+  c.partition.num_vcycles = num_vcycles;
+  prepare_context(c);
+  mt_kahypar::utils::Randomize::instance().setSeed(c.partition.seed);
+
+  // Project previous partition and perform V-Cycles
+  vec<mt_kahypar::PartitionID> partition(previous_partition, previous_partition + gr.initialNumNodes());
+  *p_graph = mt_kahypar::repartition(gr, partition, c);
+
+  return reinterpret_cast<mt_kahypar_partitioned_graph_t*>(p_graph);
+}
+
+void mt_kahypar_partition_for_targets(mt_kahypar_graph_t* graph,
+                                      mt_kahypar_context_t* context,
+                                      const size_t num_targets,
+                                      const mt_kahypar_partition_id_t* num_blocks,
+                                      const double* epsilons,
+                                      mt_kahypar_partition_id_t* partitions) {
+  Graph& gr = *reinterpret_cast<Graph*>(graph);
+  mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(context);
+  prepare_context(c);
+  mt_kahypar::utils::Randomize::instance().setSeed(c.partition.seed);
+
+  vec<std::pair<mt_kahypar::PartitionID, double>> targets;
+  for ( size_t i = 0; i < num_targets; ++i ) {
+    targets.emplace_back(num_blocks[i], epsilons[i]);
+  }
+  const size_t num_nodes = gr.initialNumNodes();
+  const auto target_partitions = mt_kahypar::partitionMultipleTargets(gr, targets, c);
+  for ( size_t i = 0; i < num_targets; ++i ) {
+    std::copy(target_partitions[i].begin(), target_partitions[i].end(), partitions + i * num_nodes);
+  }
+}
+
 mt_kahypar_partitioned_graph_t* mt_kahypar_create_partitioned_graph(mt_kahypar_graph_t* graph,
                                                                     const mt_kahypar_partition_id_t num_blocks,
                                                                     const mt_kahypar_partition_id_t* partition) {
@@ -204,7 +369,7 @@ mt_kahypar_partitioned_graph_t* mt_kahypar_read_partition_from_file(mt_kahypar_g
                                                                     const char* partition_file) {
   std::vector<mt_kahypar::PartitionID> partition;
   mt_kahypar::io::readPartitionFile(partition_file, partition);
-  return gp::mt_kahypar_create_partitioned_graph(graph, num_blocks, partition.data());
+  return mt_kahypar_create_partitioned_graph(graph, num_blocks, partition.data());
 }
 
 void mt_kahypar_write_partition_to_file(const mt_kahypar_partitioned_graph_t* partitioned_graph,
@@ -213,6 +378,12 @@ void mt_kahypar_write_partition_to_file(const mt_kahypar_partitioned_graph_t* pa
   mt_kahypar::io::writePartitionFile(gr, partition_file);
 }
 
+void mt_kahypar_write_partition_to_binary_file(const mt_kahypar_partitioned_graph_t* partitioned_graph,
+                                               const char* partition_file) {
+  const PartitionedGraph& gr = *reinterpret_cast<const PartitionedGraph*>(partitioned_graph);
+  mt_kahypar::io::writePartitionFile(gr, partition_file, true);
+}
+
 void mt_kahypar_get_partition(const mt_kahypar_partitioned_graph_t* partitioned_graph,
                               mt_kahypar_partition_id_t* partition) {
   ASSERT(partition != nullptr);
@@ -223,6 +394,11 @@ void mt_kahypar_get_partition(const mt_kahypar_partitioned_graph_t* partitioned_
   });
 }
 
+const mt_kahypar_partition_id_t* mt_kahypar_get_partition_view(const mt_kahypar_partitioned_graph_t* partitioned_graph) {
+  static_assert(std::is_same<mt_kahypar_partition_id_t, mt_kahypar::PartitionID>::value);
+  return reinterpret_cast<const PartitionedGraph*>(partitioned_graph)->partIDs();
+}
+
 void mt_kahypar_get_block_weights(const mt_kahypar_partitioned_graph_t* partitioned_graph,
                                   mt_kahypar_hypernode_weight_t* block_weights) {
   ASSERT(block_weights != nullptr);
@@ -245,4 +421,37 @@ mt_kahypar_hyperedge_weight_t mt_kahypar_cut(const mt_kahypar_partitioned_graph_
     *reinterpret_cast<const PartitionedGraph*>(partitioned_graph));
 }
 
+size_t mt_kahypar_get_block_pair_cuts(const mt_kahypar_partitioned_graph_t* partitioned_graph,
+                                      mt_kahypar_partition_id_t* block_0,
+                                      mt_kahypar_partition_id_t* block_1,
+                                      mt_kahypar_hyperedge_weight_t* weights,
+                                      const size_t max_entries) {
+  const mt_kahypar::vec<mt_kahypar::metrics::BlockPairCut> block_pair_cuts =
+    mt_kahypar::metrics::blockPairCuts(*reinterpret_cast<const PartitionedGraph*>(partitioned_graph));
+  if ( block_0 != nullptr && block_1 != nullptr && weights != nullptr ) {
+    const size_t num_entries = std::min(block_pair_cuts.size(), max_entries);
+    for ( size_t i = 0; i < num_entries; ++i ) {
+      block_0[i] = block_pair_cuts[i].block_0;
+      block_1[i] = block_pair_cuts[i].block_1;
+      weights[i] = block_pair_cuts[i].weight;
+    }
+  }
+  return block_pair_cuts.size();
+}
+
+size_t mt_kahypar_get_report(const mt_kahypar_partitioned_graph_t* partitioned_graph,
+                             const mt_kahypar_context_t* context,
+                             char* buffer,
+                             const size_t buffer_size) {
+  const std::string report = mt_kahypar::io::json::serializeRunReport(
+    *reinterpret_cast<const PartitionedGraph*>(partitioned_graph),
+    *reinterpret_cast<const mt_kahypar::Context*>(context));
+  if ( buffer != nullptr && buffer_size > 0 ) {
+    const size_t length = std::min(report.size(), buffer_size - 1);
+    std::memcpy(buffer, report.data(), length);
+    buffer[length] = '\0';
+  }
+  return report.size();
+}
+
 } // namespace gp
\ No newline at end of file
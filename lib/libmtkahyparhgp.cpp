@@ -26,29 +26,46 @@
  ******************************************************************************/
 
 #include "libmtkahyparhgp.h"
+#ifdef USE_STRONG_PARTITIONER
+#include "libmtkahyparnlevel.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
 
 #include "tbb/parallel_for.h"
 #include "tbb/parallel_invoke.h"
+#include "tbb/task_group.h"
 
 #include "mt-kahypar/io/command_line_options.h"
 #include "mt-kahypar/macros.h"
 #include "mt-kahypar/definitions.h"
+#include "mt-kahypar/datastructures/hypergraph_builder.h"
 #include "mt-kahypar/partition/context.h"
 #include "mt-kahypar/parallel/memory_pool.h"
 #include "mt-kahypar/parallel/parallel_prefix_sum.h"
 #include "mt-kahypar/partition/partitioner.h"
+#include "mt-kahypar/partition/partition_cache.h"
 #include "mt-kahypar/partition/registries/register_memory_pool.h"
 #include "mt-kahypar/partition/metrics.h"
 #include "mt-kahypar/io/hypergraph_io.h"
+#include "mt-kahypar/io/json_report.h"
 #include "mt-kahypar/utils/randomize.h"
 #include "mt-kahypar/utils/utilities.h"
 
 namespace {
   template<typename T>
   using vec = mt_kahypar::parallel::scalable_vector<T>;
+
+  using HypergraphBuilder = mt_kahypar::ds::HypergraphBuilder<
+    mt_kahypar::Hypergraph, mt_kahypar::HypergraphFactory>;
 }
 
+#ifdef USE_STRONG_PARTITIONER
+namespace hgp_nlevel {
+#else
 namespace hgp {
+#endif
 
 mt_kahypar_hypergraph_t* mt_kahypar_read_hypergraph_from_file(const char* file_name,
                                                               const mt_kahypar_context_t* context,
@@ -88,6 +105,32 @@ mt_kahypar_hypergraph_t* mt_kahypar_create_hypergraph(const mt_kahypar_hypernode
   return reinterpret_cast<mt_kahypar_hypergraph_t*>(hypergraph);
 }
 
+mt_kahypar_hypergraph_builder_t* mt_kahypar_hypergraph_builder_new(const mt_kahypar_hypernode_id_t num_vertices,
+                                                                   const mt_kahypar_hypernode_weight_t* vertex_weights) {
+  return reinterpret_cast<mt_kahypar_hypergraph_builder_t*>(
+    new HypergraphBuilder(num_vertices, vertex_weights));
+}
+
+void mt_kahypar_hypergraph_builder_add_hyperedge(mt_kahypar_hypergraph_builder_t* builder,
+                                                 const mt_kahypar_hypernode_id_t* pins,
+                                                 const size_t num_pins,
+                                                 const mt_kahypar_hyperedge_weight_t weight) {
+  reinterpret_cast<HypergraphBuilder*>(builder)->addHyperedge(pins, num_pins, weight);
+}
+
+mt_kahypar_hypergraph_t* mt_kahypar_hypergraph_builder_finalize(mt_kahypar_hypergraph_builder_t* builder) {
+  mt_kahypar::Hypergraph* hypergraph = new mt_kahypar::Hypergraph();
+  *hypergraph = reinterpret_cast<HypergraphBuilder*>(builder)->finalize();
+  return reinterpret_cast<mt_kahypar_hypergraph_t*>(hypergraph);
+}
+
+void mt_kahypar_free_hypergraph_builder(mt_kahypar_hypergraph_builder_t* builder) {
+  if (builder == nullptr) {
+    return;
+  }
+  delete reinterpret_cast<HypergraphBuilder*>(builder);
+}
+
 void mt_kahypar_free_hypergraph(mt_kahypar_hypergraph_t* hypergraph) {
   if (hypergraph == nullptr) {
     return;
@@ -111,6 +154,16 @@ mt_kahypar_hypernode_id_t mt_kahypar_total_weight(mt_kahypar_hypergraph_t* hyper
   return reinterpret_cast<mt_kahypar::Hypergraph*>(hypergraph)->totalWeight();
 }
 
+void mt_kahypar_add_fixed_vertices(mt_kahypar_hypergraph_t* hypergraph,
+                                   const mt_kahypar_partition_id_t* fixed_vertices) {
+  mt_kahypar::Hypergraph& hg = *reinterpret_cast<mt_kahypar::Hypergraph*>(hypergraph);
+  for ( mt_kahypar::HypernodeID hn = 0; hn < hg.initialNumNodes(); ++hn ) {
+    if ( fixed_vertices[hn] != mt_kahypar::kInvalidPartition ) {
+      hg.fixToBlock(hn, fixed_vertices[hn]);
+    }
+  }
+}
+
 void mt_kahypar_free_partitioned_hypergraph(mt_kahypar_partitioned_hypergraph_t* partitioned_hg) {
   if (partitioned_hg == nullptr) {
     return;
@@ -121,8 +174,15 @@ void mt_kahypar_free_partitioned_hypergraph(mt_kahypar_partitioned_hypergraph_t*
 namespace {
   void prepare_context(mt_kahypar::Context& context) {
     context.partition.mode = mt_kahypar::Mode::direct;
-    context.shared_memory.original_num_threads = mt_kahypar::TBBInitializer::instance().total_number_of_threads();
-    context.shared_memory.num_threads = mt_kahypar::TBBInitializer::instance().total_number_of_threads();
+#ifdef USE_STRONG_PARTITIONER
+    context.partition.paradigm = mt_kahypar::Paradigm::nlevel;
+#else
+    context.partition.paradigm = mt_kahypar::Paradigm::multilevel;
+#endif
+    const size_t num_threads = context.thread_pool ? context.thread_pool->total_number_of_threads() :
+      mt_kahypar::TBBInitializer::instance().total_number_of_threads();
+    context.shared_memory.original_num_threads = num_threads;
+    context.shared_memory.num_threads = num_threads;
     context.utility_id = mt_kahypar::utils::Utilities::instance().registerNewUtilityObjects();
 
     context.partition.perfect_balance_part_weights.clear();
@@ -163,17 +223,100 @@ namespace {
 mt_kahypar_partitioned_hypergraph_t* mt_kahypar_partition(mt_kahypar_hypergraph_t* hypergraph,
                                                           mt_kahypar_context_t* context) {
   mt_kahypar::Hypergraph& hg = *reinterpret_cast<mt_kahypar::Hypergraph*>(hypergraph);
-  mt_kahypar::PartitionedHypergraph* phg = new mt_kahypar::PartitionedHypergraph();
   mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(context);
   prepare_context(c);
   mt_kahypar::utils::Randomize::instance().setSeed(c.partition.seed);
 
+  // Return the cached partition, if the same input was partitioned before
+  mt_kahypar::PartitionCache& cache = mt_kahypar::PartitionCache::instance();
+  const bool use_cache = mt_kahypar::PartitionCache::isEnabled(c);
+  const uint64_t cache_key = use_cache ? mt_kahypar::PartitionCache::key(hg, c) : 0;
+  vec<mt_kahypar::PartitionID> cached_partition;
+  if ( use_cache && cache.lookup(cache_key, c, hg.initialNumNodes(), cached_partition) ) {
+    return mt_kahypar_create_partitioned_hypergraph(hypergraph, c.partition.k, cached_partition.data());
+  }
+
   // Partition Hypergraph
+  mt_kahypar::PartitionedHypergraph* phg = new mt_kahypar::PartitionedHypergraph();
   *phg = mt_kahypar::partition(hg, c);
+  if ( use_cache ) {
+    cache.insert(cache_key, c, *phg);
+  }
 
   return reinterpret_cast<mt_kahypar_partitioned_hypergraph_t*>(phg);
 }
 
+void mt_kahypar_partition_batch(mt_kahypar_hypergraph_t** hypergraphs,
+                                mt_kahypar_context_t** contexts,
+                                const size_t num_hypergraphs,
+                                const size_t num_threads_per_job,
+                                mt_kahypar_partitioned_hypergraph_t** partitioned_hypergraphs) {
+  if ( num_hypergraphs == 0 ) {
+    return;
+  }
+
+  const size_t num_threads = mt_kahypar::TBBInitializer::instance().total_number_of_threads();
+  const size_t threads_per_job = num_threads_per_job > 0 ?
+    std::min(num_threads_per_job, num_threads) : std::max(num_threads / num_hypergraphs, UL(1));
+  // The thread budget of a job is modeled via the number of threads in its context
+  // (similar to recursive bipartitioning calls with a smaller number of threads)
+  for ( size_t i = 0; i < num_hypergraphs; ++i ) {
+    mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(contexts[i]);
+    prepare_context(c);
+    c.shared_memory.original_num_threads = threads_per_job;
+    c.shared_memory.num_threads = threads_per_job;
+  }
+  mt_kahypar::utils::Randomize::instance().setSeed(
+    reinterpret_cast<mt_kahypar::Context*>(contexts[0])->partition.seed);
+
+  // Partition Hypergraphs
+  tbb::task_group tg;
+  for ( size_t i = 0; i < num_hypergraphs; ++i ) {
+    tg.run([&, i] {
+      mt_kahypar::Hypergraph& hg = *reinterpret_cast<mt_kahypar::Hypergraph*>(hypergraphs[i]);
+      mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(contexts[i]);
+      mt_kahypar::PartitionedHypergraph* phg = new mt_kahypar::PartitionedHypergraph();
+      *phg = mt_kahypar::partition(hg, c);
+      partitioned_hypergraphs[i] = reinterpret_cast<mt_kahypar_partitioned_hypergraph_t*>(phg);
+    });
+  }
+  tg.wait();
+}
+
+void mt_kahypar_partition_with_memory_pool(mt_kahypar_hypergraph_t* hypergraph,
+                                          mt_kahypar_context_t* context,
+                                          mt_kahypar_partition_id_t* partition) {
+  ASSERT(partition != nullptr);
+  mt_kahypar::Hypergraph& hg = *reinterpret_cast<mt_kahypar::Hypergraph*>(hypergraph);
+  mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(context);
+  prepare_context(c);
+  mt_kahypar::utils::Randomize::instance().setSeed(c.partition.seed);
+
+  // Memory chunks are only reallocated if the hypergraph requires
+  // more memory than all hypergraphs partitioned before
+  mt_kahypar::parallel::MemoryPool& pool = mt_kahypar::parallel::MemoryPool::instance();
+  mt_kahypar::apply_memory_limit(hg, c);
+  mt_kahypar::register_memory_pool(hg, c);
+  pool.enable_memory_requests();
+
+  // Partition Hypergraph
+  {
+    mt_kahypar::PartitionedHypergraph phg = mt_kahypar::partition(hg, c);
+    phg.doParallelForAllNodes([&](const mt_kahypar::HypernodeID& hn) {
+      partition[hn] = phg.partID(hn);
+    });
+  }
+
+  // All data structures allocated from the memory pool are destroyed at this point
+  // => restore memory pool for the next call
+  pool.reset();
+  pool.disable_memory_requests();
+}
+
+void mt_kahypar_free_memory_pool() {
+  mt_kahypar::parallel::MemoryPool::instance().free_memory_chunks();
+}
+
 void mt_kahypar_improve_partition(mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
                                   mt_kahypar_context_t* context,
                                   const size_t num_vcycles) {
@@ -187,6 +330,46 @@ void mt_kahypar_improve_partition(mt_kahypar_partitioned_hypergraph_t* partition
   mt_kahypar::partitionVCycle(phg, c);
 }
 
+mt_kahypar_partitioned_hypergraph_t* mt_kahypar_repartition(mt_kahypar_hypergraph_t* hypergraph,
+                                                            mt_kahypar_context_t* context,
+                                                            const mt_kahypar_partition_id_t* previous_partition,
+                                                            const size_t num_vcycles) {
+  mt_kahypar::Hypergraph& hg = *reinterpret_cast<mt_kahypar::Hypergraph*>(hypergraph);
+  mt_kahypar::PartitionedHypergraph* phg = new mt_kahypar::PartitionedHypergraph();
+  mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(context);
+  c.partition.num_vcycles = num_vcycles;
+  prepare_context(c);
+  mt_kahypar::utils::Randomize::instance().setSeed(c.partition.seed);
+
+  // Project previous partition and perform V-Cycles
+  vec<mt_kahypar::PartitionID> partition(previous_partition, previous_partition + hg.initialNumNodes());
+  *phg = mt_kahypar::repartition(hg, partition, c);
+
+  return reinterpret_cast<mt_kahypar_partitioned_hypergraph_t*>(phg);
+}
+
+void mt_kahypar_partition_for_targets(mt_kahypar_hypergraph_t* hypergraph,
+                                      mt_kahypar_context_t* context,
+                                      const size_t num_targets,
+                                      const mt_kahypar_partition_id_t* num_blocks,
+                                      const double* epsilons,
+                                      mt_kahypar_partition_id_t* partitions) {
+  mt_kahypar::Hypergraph& hg = *reinterpret_cast<mt_kahypar::Hypergraph*>(hypergraph);
+  mt_kahypar::Context& c = *reinterpret_cast<mt_kahypar::Context*>(context);
+  prepare_context(c);
+  mt_kahypar::utils::Randomize::instance().setSeed(c.partition.seed);
+
+  vec<std::pair<mt_kahypar::PartitionID, double>> targets;
+  for ( size_t i = 0; i < num_targets; ++i ) {
+    targets.emplace_back(num_blocks[i], epsilons[i]);
+  }
+  const size_t num_nodes = hg.initialNumNodes();
+  const auto target_partitions = mt_kahypar::partitionMultipleTargets(hg, targets, c);
+  for ( size_t i = 0; i < num_targets; ++i ) {
+    std::copy(target_partitions[i].begin(), target_partitions[i].end(), partitions + i * num_nodes);
+  }
+}
+
 mt_kahypar_partitioned_hypergraph_t* mt_kahypar_create_partitioned_hypergraph(mt_kahypar_hypergraph_t* hypergraph,
                                                                               const mt_kahypar_partition_id_t num_blocks,
                                                                               const mt_kahypar_partition_id_t* partition) {
@@ -207,7 +390,7 @@ mt_kahypar_partitioned_hypergraph_t* mt_kahypar_read_partition_from_file(mt_kahy
                                                                          const char* partition_file) {
   std::vector<mt_kahypar::PartitionID> partition;
   mt_kahypar::io::readPartitionFile(partition_file, partition);
-  return hgp::mt_kahypar_create_partitioned_hypergraph(hypergraph, num_blocks, partition.data());
+  return mt_kahypar_create_partitioned_hypergraph(hypergraph, num_blocks, partition.data());
 }
 
 void mt_kahypar_write_partition_to_file(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
@@ -216,6 +399,12 @@ void mt_kahypar_write_partition_to_file(const mt_kahypar_partitioned_hypergraph_
   mt_kahypar::io::writePartitionFile(hg, partition_file);
 }
 
+void mt_kahypar_write_partition_to_binary_file(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
+                                               const char* partition_file) {
+  const mt_kahypar::PartitionedHypergraph& hg = *reinterpret_cast<const mt_kahypar::PartitionedHypergraph*>(partitioned_hg);
+  mt_kahypar::io::writePartitionFile(hg, partition_file, true);
+}
+
 void mt_kahypar_get_partition(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
                               mt_kahypar_partition_id_t* partition) {
   ASSERT(partition != nullptr);
@@ -226,6 +415,12 @@ void mt_kahypar_get_partition(const mt_kahypar_partitioned_hypergraph_t* partiti
   });
 }
 
+const mt_kahypar_partition_id_t* mt_kahypar_get_partition_view(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg) {
+  static_assert(std::is_same<mt_kahypar_partition_id_t, mt_kahypar::PartitionID>::value);
+  // nullptr if block IDs are stored with a narrow type
+  return reinterpret_cast<const mt_kahypar::PartitionedHypergraph*>(partitioned_hg)->partIDs();
+}
+
 void mt_kahypar_get_block_weights(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
                                   mt_kahypar_hypernode_weight_t* block_weights) {
   ASSERT(block_weights != nullptr);
@@ -258,4 +453,37 @@ mt_kahypar_hyperedge_weight_t mt_kahypar_soed(const mt_kahypar_partitioned_hyper
     *reinterpret_cast<const mt_kahypar::PartitionedHypergraph*>(partitioned_hg));
 }
 
+size_t mt_kahypar_get_block_pair_cuts(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
+                                      mt_kahypar_partition_id_t* block_0,
+                                      mt_kahypar_partition_id_t* block_1,
+                                      mt_kahypar_hyperedge_weight_t* weights,
+                                      const size_t max_entries) {
+  const mt_kahypar::vec<mt_kahypar::metrics::BlockPairCut> block_pair_cuts =
+    mt_kahypar::metrics::blockPairCuts(*reinterpret_cast<const mt_kahypar::PartitionedHypergraph*>(partitioned_hg));
+  if ( block_0 != nullptr && block_1 != nullptr && weights != nullptr ) {
+    const size_t num_entries = std::min(block_pair_cuts.size(), max_entries);
+    for ( size_t i = 0; i < num_entries; ++i ) {
+      block_0[i] = block_pair_cuts[i].block_0;
+      block_1[i] = block_pair_cuts[i].block_1;
+      weights[i] = block_pair_cuts[i].weight;
+    }
+  }
+  return block_pair_cuts.size();
+}
+
+size_t mt_kahypar_get_report(const mt_kahypar_partitioned_hypergraph_t* partitioned_hg,
+                             const mt_kahypar_context_t* context,
+                             char* buffer,
+                             const size_t buffer_size) {
+  const std::string report = mt_kahypar::io::json::serializeRunReport(
+    *reinterpret_cast<const mt_kahypar::PartitionedHypergraph*>(partitioned_hg),
+    *reinterpret_cast<const mt_kahypar::Context*>(context));
+  if ( buffer != nullptr && buffer_size > 0 ) {
+    const size_t length = std::min(report.size(), buffer_size - 1);
+    std::memcpy(buffer, report.data(), length);
+    buffer[length] = '\0';
+  }
+  return report.size();
+}
+
 } // namespace hgp
\ No newline at end of file
@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2020 Lars Gottesbüren <lars.gottesbueren@kit.edu>
+ * Copyright (C) 2020 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#ifndef LIBMTKAHYPARNLEVEL_H
+#define LIBMTKAHYPARNLEVEL_H
+
+/**
+ * Declares the interface of the n-level backends. They are compiled from the
+ * same sources as the multilevel backends (libmtkahyparhgp.cpp and libmtkahypargp.cpp)
+ * with USE_STRONG_PARTITIONER defined and export their functions in the namespaces
+ * hgp_nlevel (dynamic hypergraph) and gp_nlevel (dynamic graph). The declarations
+ * are obtained by including the public headers a second time with the namespaces
+ * renamed.
+ */
+
+#include "libmtkahyparhgp.h"
+#include "libmtkahypargp.h"
+
+#undef LIBMTKAHYPARHGP_H
+#undef LIBMTKAHYPARGP_H
+#define hgp hgp_nlevel
+#define gp gp_nlevel
+#include "libmtkahyparhgp.h"
+#include "libmtkahypargp.h"
+#undef hgp
+#undef gp
+
+#endif // LIBMTKAHYPARNLEVEL_H
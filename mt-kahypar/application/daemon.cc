@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <string>
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/io/partitioning_daemon.h"
+
+namespace po = boost::program_options;
+
+int main(int argc, char* argv[]) {
+  mt_kahypar::io::DaemonParameters params;
+  params.num_threads = mt_kahypar::HardwareTopology::instance().num_cpus();
+
+  po::options_description options("Options");
+  options.add_options()
+    ("help", "show help message")
+    ("socket,s",
+    po::value<std::string>(&params.socket_path)->value_name("<string>")->required(),
+    "Path of the Unix domain socket on which the daemon accepts jobs. Each connection\n"
+    "sends one line with the command line arguments of a job (e.g., \"-h <hgr> -p <ini>\n"
+    "-k 8 -e 0.03 -o km1 -m direct\") or \"shutdown\" to stop the daemon.")
+    ("threads,t",
+    po::value<size_t>(&params.num_threads)->value_name("<size_t>"),
+    "Number of threads shared by all jobs (default: number of cpus)")
+    ("max-concurrent-jobs",
+    po::value<size_t>(&params.max_concurrent_jobs)->value_name("<size_t>")->default_value(1),
+    "Number of jobs executed concurrently. Each job uses threads / max-concurrent-jobs threads.\n"
+    "Only a single job at a time reuses the memory pool across jobs.")
+    ("input-cache-size",
+    po::value<size_t>(&params.input_cache_size)->value_name("<size_t>")->default_value(4),
+    "Number of recently used input hypergraphs kept in memory (0 = no caching)");
+
+  po::variables_map cmd_vm;
+  po::store(po::parse_command_line(argc, argv, options), cmd_vm);
+  if ( cmd_vm.count("help") != 0 || argc == 1 ) {
+    LOG << options;
+    return 0;
+  }
+  po::notify(cmd_vm);
+
+  if ( params.max_concurrent_jobs == 0 ) {
+    ERR("Number of concurrent jobs must be at least one");
+  }
+  const size_t num_available_cpus = mt_kahypar::HardwareTopology::instance().num_cpus();
+  if ( num_available_cpus < params.num_threads ) {
+    WARNING("There are currently only" << num_available_cpus << "cpus available."
+      << "Setting number of threads from" << params.num_threads
+      << "to" << num_available_cpus);
+    params.num_threads = num_available_cpus;
+  }
+  mt_kahypar::TBBInitializer::instance(params.num_threads);
+
+  mt_kahypar::io::PartitioningDaemon daemon(params);
+  LOG << "Listening on" << params.socket_path << "with" << params.num_threads << "threads";
+  daemon.run();
+
+  mt_kahypar::TBBInitializer::instance().terminate();
+  return 0;
+}
@@ -29,11 +29,13 @@
 
 
 #include "mt-kahypar/io/command_line_options.h"
+#include "mt-kahypar/partition/auto_configuration.h"
 #include "mt-kahypar/partition/registries/register_memory_pool.h"
 #include "mt-kahypar/io/hypergraph_io.h"
 #include "mt-kahypar/io/sql_plottools_serializer.h"
 #include "mt-kahypar/io/csv_output.h"
 #include "mt-kahypar/io/partitioning_output.h"
+#include "mt-kahypar/parallel/phase_concurrency.h"
 #include "mt-kahypar/partition/partitioner.h"
 #include "mt-kahypar/utils/randomize.h"
 #include "mt-kahypar/utils/utilities.h"
@@ -62,30 +64,89 @@ int main(int argc, char* argv[]) {
   }
 
   // Initialize TBB task arenas on numa nodes
-  mt_kahypar::TBBInitializer::instance(context.shared_memory.num_threads);
+  mt_kahypar::TBBInitializer::instance(context.shared_memory.num_threads,
+    context.shared_memory.thread_placement);
+  if ( mt_kahypar::TBBInitializer::instance().total_number_of_threads() <
+       static_cast<int>(context.shared_memory.num_threads) ) {
+    WARNING("Thread placement policy" << context.shared_memory.thread_placement
+      << "uses only" << mt_kahypar::TBBInitializer::instance().total_number_of_threads() << "threads");
+    context.shared_memory.num_threads = mt_kahypar::TBBInitializer::instance().total_number_of_threads();
+  }
 
-  // We set the membind policy to interleaved allocations in order to
-  // distribute allocations evenly across NUMA nodes
-  hwloc_cpuset_t cpuset = mt_kahypar::TBBInitializer::instance().used_cpuset();
-  mt_kahypar::parallel::HardwareTopology<>::instance().activate_interleaved_membind_policy(cpuset);
-  hwloc_bitmap_free(cpuset);
+  // Threads on hyperthreads are only used in memory-bound phases, all other
+  // phases run in a task arena with one thread per physical core
+  size_t compute_bound_num_threads = 0;
+  if ( context.shared_memory.thread_placement == mt_kahypar::ThreadPlacementPolicy::smt_for_memory_bound_phases ) {
+    compute_bound_num_threads = mt_kahypar::TBBInitializer::instance().number_of_used_physical_cores();
+    if ( context.shared_memory.fm_num_threads == 0 ) {
+      context.shared_memory.fm_num_threads = context.shared_memory.num_threads;
+    }
+    if ( context.shared_memory.contraction_num_threads == 0 ) {
+      context.shared_memory.contraction_num_threads = context.shared_memory.num_threads;
+    }
+  }
+
+  if ( context.shared_memory.numa_placement == mt_kahypar::NumaPlacementPolicy::interleaved ) {
+    // We set the membind policy to interleaved allocations in order to
+    // distribute allocations evenly across NUMA nodes
+    hwloc_cpuset_t cpuset = mt_kahypar::TBBInitializer::instance().used_cpuset();
+    mt_kahypar::parallel::HardwareTopology<>::instance().activate_interleaved_membind_policy(cpuset);
+    hwloc_bitmap_free(cpuset);
+  } else {
+    // Large arrays are split into consecutive ID ranges and each range is bound
+    // to one NUMA node. All other allocations remain on the NUMA node of the
+    // allocating thread (first-touch).
+    mt_kahypar::parallel::MemoryPool::instance().register_memory_placement_function(
+      [](const char* data, const size_t size_in_bytes) {
+        mt_kahypar::TBBInitializer::instance().bind_memory_to_used_numa_nodes(data, size_in_bytes);
+      });
+  }
+
+  if ( context.shared_memory.use_huge_pages ) {
+    mt_kahypar::parallel::MemoryPool::instance().activate_huge_pages();
+  }
 
-  // Read Hypergraph
   mt_kahypar::utils::Timer& timer =
     mt_kahypar::utils::Utilities::instance().getTimer(context.utility_id);
+  if ( context.partition.measure_hardware_counters && !timer.enableHardwareCounters() ) {
+    WARNING("Hardware counters are not available on this machine"
+      << "(check /proc/sys/kernel/perf_event_paranoid)");
+  }
+  if ( context.partition.profile_scalability && !timer.enableThreadProfiling() ) {
+    WARNING("Per-thread CPU clocks are not available on this machine");
+  }
+  if ( !context.partition.trace_file.empty() ) {
+    if ( mt_kahypar::utils::TraceRecorder::isCompiledIn() ) {
+      mt_kahypar::utils::TraceRecorder::instance().activate();
+    } else {
+      WARNING("Tracing is disabled (compile with -DKAHYPAR_ENABLE_TRACING=ON)");
+    }
+  }
+
+  // Read Hypergraph
   timer.start_timer("io_hypergraph", "I/O Hypergraph");
   mt_kahypar::Hypergraph hypergraph = mt_kahypar::io::readInputFile(
       context.partition.graph_filename,
       context.partition.file_format,
       context.preprocessing.stable_construction_of_incident_edges);
+  if ( !context.partition.fixed_vertex_filename.empty() ) {
+    mt_kahypar::io::readFixedVertexFile(context.partition.fixed_vertex_filename, hypergraph);
+  }
   timer.stop_timer("io_hypergraph");
 
+  // Select parameters of the auto preset based on the input
+  mt_kahypar::apply_auto_configuration(hypergraph, context);
+
   // Initialize Memory Pool
+  mt_kahypar::apply_memory_limit(hypergraph, context);
   mt_kahypar::register_memory_pool(hypergraph, context);
 
   // Partition Hypergraph
   mt_kahypar::HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
-  mt_kahypar::PartitionedHypergraph partitioned_hypergraph = mt_kahypar::partition(hypergraph, context);
+  mt_kahypar::PartitionedHypergraph partitioned_hypergraph =
+    mt_kahypar::parallel::executeWithConcurrencyLimit(compute_bound_num_threads, [&] {
+      return mt_kahypar::partition(hypergraph, context);
+    });
   mt_kahypar::HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
 
   // Print Stats
@@ -102,7 +163,12 @@ int main(int argc, char* argv[]) {
   }
 
   if (context.partition.write_partition_file) {
-    mt_kahypar::io::writePartitionFile(partitioned_hypergraph, context.partition.graph_partition_filename);
+    mt_kahypar::io::writePartitionFile(partitioned_hypergraph,
+      context.partition.graph_partition_filename, context.partition.binary_partition_file);
+  }
+
+  if ( mt_kahypar::utils::TraceRecorder::instance().isActive() ) {
+    mt_kahypar::utils::TraceRecorder::instance().writeChromeTrace(context.partition.trace_file);
   }
 
   mt_kahypar::parallel::MemoryPool::instance().free_memory_chunks();
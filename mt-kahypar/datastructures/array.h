@@ -147,6 +147,21 @@ class Array {
 
   };
 
+  // ! Frees memory allocated in allocate_data(...), which is either
+  // ! backed by huge pages or allocated via scalable_malloc
+  struct ArrayDeleter {
+    void operator()(T* data) {
+      if ( huge_page_size > 0 ) {
+        parallel::MemoryPool::instance().free_huge_pages(
+          reinterpret_cast<char*>(data), huge_page_size);
+      } else {
+        scalable_free(data);
+      }
+    }
+
+    size_t huge_page_size = 0;
+  };
+
  public:
 
   // Type Traits
@@ -334,6 +349,16 @@ class Array {
     }
   }
 
+  // ! Uses memory that is owned by someone else (e.g., a memory-mapped file)
+  // ! as underlying data. The array does not release the memory on destruction.
+  void use_external_memory(value_type* data, const size_type size) {
+    if ( _data || _underlying_data ) {
+      ERR("Memory of vector already allocated");
+    }
+    _size = size;
+    _underlying_data = data;
+  }
+
   // ! Replaces the contents of the container
   void assign(const size_type count,
               const value_type value,
@@ -359,15 +384,25 @@ class Array {
 
  private:
   void allocate_data(const size_type size) {
-    _data = parallel::make_unique<value_type>(size);
+    const size_t size_in_bytes = sizeof(value_type) * size;
+    char* data = parallel::MemoryPool::instance().allocate_huge_pages(size_in_bytes);
+    if ( data ) {
+      _data = std::unique_ptr<value_type, ArrayDeleter>(
+        reinterpret_cast<value_type*>(data), ArrayDeleter { size_in_bytes });
+    } else {
+      _data = std::unique_ptr<value_type, ArrayDeleter>(
+        static_cast<value_type*>(scalable_malloc(size_in_bytes)), ArrayDeleter { });
+    }
     _underlying_data = _data.get();
     _size = size;
+    parallel::MemoryPool::instance().place_memory(
+      reinterpret_cast<const char*>(_underlying_data), sizeof(value_type) * size);
   }
 
   std::string _group;
   std::string _key;
   size_type _size;
-  parallel::tbb_unique_ptr<value_type> _data;
+  std::unique_ptr<value_type, ArrayDeleter> _data;
   value_type* _underlying_data;
 };
 
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/datastructures/array.h"
+#include "mt-kahypar/parallel/atomic_wrapper.h"
+
+namespace mt_kahypar {
+namespace ds {
+
+/*!
+ * Bit vector that allows concurrent modifications of different bits.
+ * Compared to a fast reset flag array (16 bits per entry), it uses one bit
+ * per entry, but resetting all flags takes time linear in size() / 64.
+ */
+class AtomicBitVector {
+
+ public:
+  using Block = uint64_t;
+  static constexpr size_t BITS_PER_BLOCK = sizeof(Block) * 8;
+
+  AtomicBitVector() :
+    _size(0),
+    _blocks() { }
+
+  AtomicBitVector(const AtomicBitVector&) = delete;
+  AtomicBitVector & operator= (const AtomicBitVector &) = delete;
+
+  AtomicBitVector(AtomicBitVector&&) = default;
+  AtomicBitVector & operator= (AtomicBitVector&&) = default;
+
+  size_t size() const {
+    return _size;
+  }
+
+  bool operator[] (const size_t i) const {
+    ASSERT(i < _size);
+    return _blocks[block(i)].load(std::memory_order_relaxed) & mask(i);
+  }
+
+  void set(const size_t i, const bool value) {
+    ASSERT(i < _size);
+    if ( value ) {
+      _blocks[block(i)].fetch_or(mask(i), std::memory_order_relaxed);
+    } else {
+      _blocks[block(i)].fetch_and(~mask(i), std::memory_order_relaxed);
+    }
+  }
+
+  // ! Sets flag i and returns its previous value
+  bool testAndSet(const size_t i) {
+    ASSERT(i < _size);
+    return _blocks[block(i)].fetch_or(mask(i), std::memory_order_relaxed) & mask(i);
+  }
+
+  // ! Sets all flags to false
+  void reset() {
+    _blocks.assign(_blocks.size(), AtomicBlock(0));
+  }
+
+  // ! Allocates the bit vector (all flags are initialized with value)
+  void setSize(const size_t size, const bool value = false) {
+    ASSERT(_blocks.size() == 0, "Bit vector is already allocated");
+    _size = size;
+    _blocks.resize(numBlocks(size), AtomicBlock(value ? ~Block(0) : Block(0)));
+    if ( value && size % BITS_PER_BLOCK != 0 ) {
+      // Bits beyond size() are always false
+      _blocks[block(size)] = AtomicBlock(mask(size) - 1);
+    }
+  }
+
+  // ! Allocates the bit vector as a copy of other
+  void copy(const AtomicBitVector& other) {
+    ASSERT(_blocks.size() == 0, "Bit vector is already allocated");
+    _size = other._size;
+    _blocks.resize(other._blocks.size(), AtomicBlock(0));
+    if ( !_blocks.empty() ) {
+      std::memcpy(_blocks.data(), other._blocks.data(), other.size_in_bytes());
+    }
+  }
+
+  // ! Uses blocks owned by someone else (e.g., another bit vector or a memory-mapped
+  // ! file) as underlying data. The bit vector does not release the memory on destruction.
+  void use_external_memory(Block* blocks, const size_t size) {
+    _size = size;
+    _blocks.use_external_memory(reinterpret_cast<AtomicBlock*>(blocks), numBlocks(size));
+  }
+
+  // ! Underlying blocks (bit i is stored in block i / 64)
+  const Block* data() const {
+    return reinterpret_cast<const Block*>(_blocks.data());
+  }
+
+  void freeInternalData() {
+    _size = 0;
+    parallel::free(_blocks);
+  }
+
+  size_t size_in_bytes() const {
+    return _blocks.size() * sizeof(AtomicBlock);
+  }
+
+  static size_t numBlocks(const size_t size) {
+    return (size + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+  }
+
+ private:
+  using AtomicBlock = parallel::IntegralAtomicWrapper<Block>;
+  static_assert(sizeof(AtomicBlock) == sizeof(Block));
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static size_t block(const size_t i) {
+    return i / BITS_PER_BLOCK;
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static Block mask(const size_t i) {
+    return Block(1) << (i % BITS_PER_BLOCK);
+  }
+
+  size_t _size;
+  Array<AtomicBlock> _blocks;
+};
+
+}  // namespace ds
+}  // namespace mt_kahypar
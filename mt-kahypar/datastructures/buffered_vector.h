@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <tbb/scalable_allocator.h>
 #include <tbb/enumerable_thread_specific.h>
@@ -40,12 +41,12 @@ public:
 
   BufferedVector(size_t max_size) :
     data(max_size, T()),
-    buffers([&] { vec_t x; x.reserve(MAX_BUFFER_SIZE); return x; })
+    buffers()
   { }
 
   void clear() {
     back.store(0, std::memory_order_relaxed);
-    assert(std::all_of(buffers.begin(), buffers.end(), [&](vec_t& x) { return x.empty(); }));
+    assert(std::all_of(buffers.begin(), buffers.end(), [&](Buffer& x) { return x.elements.empty(); }));
   }
 
   size_t size() const {
@@ -69,16 +70,19 @@ public:
   }
 
   void push_back_buffered(const T& element) {
-    vec_t& buffer = buffers.local();
-    buffer.push_back(element);
-    if (buffer.size() == MAX_BUFFER_SIZE) {
-      flush_buffer(buffer);
+    Buffer& buffer = buffers.local();
+    buffer.elements.push_back(element);
+    if (buffer.elements.size() == buffer.flush_threshold) {
+      flush_buffer(buffer.elements);
+      // Threads that produce many elements flush less often and write longer
+      // consecutive runs of data, which are then (first-)touched by the same thread
+      buffer.flush_threshold = std::min(2 * buffer.flush_threshold, MAX_BUFFER_SIZE);
     }
   }
 
   void finalize() {
-    for (vec_t& buffer : buffers) {
-      flush_buffer(buffer);
+    for (Buffer& buffer : buffers) {
+      flush_buffer(buffer.elements);
     }
   }
 
@@ -109,9 +113,22 @@ private:
     }
   }
 
+  static constexpr size_t MIN_BUFFER_SIZE = 64;
+  static constexpr size_t MAX_BUFFER_SIZE = 4096;
+
+  // Thread-local buffer whose flush threshold grows geometrically with each flush.
+  // Threads that produce only few elements keep small buffers.
+  struct Buffer {
+    Buffer() : elements(), flush_threshold(MIN_BUFFER_SIZE) {
+      elements.reserve(MIN_BUFFER_SIZE);
+    }
+
+    vec_t elements;
+    size_t flush_threshold;
+  };
+
   vec_t data;
   std::atomic<size_t> back{0};
-  tbb::enumerable_thread_specific<vec_t> buffers;
-  static constexpr size_t MAX_BUFFER_SIZE = 1024;
+  tbb::enumerable_thread_specific<Buffer> buffers;
 };
 }
\ No newline at end of file
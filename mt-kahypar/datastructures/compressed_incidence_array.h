@@ -0,0 +1,297 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_invoke.h"
+#include "tbb/parallel_scan.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/datastructures/array.h"
+#include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/parallel/parallel_prefix_sum.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+#include "mt-kahypar/utils/memory_tree.h"
+#include "mt-kahypar/utils/range.h"
+
+namespace mt_kahypar {
+namespace ds {
+
+/*!
+ * Stores a sequence of sorted ID lists (e.g., the pins of each hyperedge or
+ * the incident nets of each vertex) in compressed form. The first ID of a list
+ * is stored as is and each further ID as the difference to its predecessor.
+ * Each value is encoded as a varint (7 bits per byte, the most significant
+ * bit of a byte indicates that further bytes follow). Since pins and incident
+ * nets are usually clustered, most differences fit into one or two bytes.
+ * The iterator returned by get(i) decodes the list on the fly.
+ *
+ * Note that the lists are sorted during construction. Thus, the order of the
+ * IDs in a list can differ from the order in the original data structure.
+ */
+template<typename ID>
+class CompressedIncidenceArray {
+
+  static_assert(std::is_unsigned<ID>::value, "Only unsigned IDs can be compressed");
+
+  static constexpr uint8_t CONTINUATION_BIT = 0x80;
+  static constexpr uint8_t PAYLOAD_MASK = 0x7F;
+  static constexpr size_t MAX_BYTES_PER_VALUE = (sizeof(ID) * 8 + 6) / 7;
+
+ public:
+  // ! Iterator over the IDs of a compressed list
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ID;
+    using reference = ID;
+    using pointer = const ID*;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator(const uint8_t* pos, const uint8_t* end) :
+      _pos(pos),
+      _next(pos),
+      _end(end),
+      _value(0) {
+      decode();
+    }
+
+    ID operator* () const {
+      ASSERT(_pos < _end);
+      return _value;
+    }
+
+    Iterator& operator++ () {
+      _pos = _next;
+      decode();
+      return *this;
+    }
+
+    Iterator operator++ (int) {
+      Iterator copy = *this;
+      operator++ ();
+      return copy;
+    }
+
+    bool operator!= (const Iterator& rhs) const {
+      return _pos != rhs._pos;
+    }
+
+    bool operator== (const Iterator& rhs) const {
+      return _pos == rhs._pos;
+    }
+
+   private:
+    // ! Decodes the value at position _pos and adds it to the
+    // ! last decoded value (first value of a list is added to zero)
+    MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void decode() {
+      if ( _pos < _end ) {
+        _value += decodeVarint(_next);
+      }
+    }
+
+    const uint8_t* _pos;
+    const uint8_t* _next;
+    const uint8_t* _end;
+    ID _value;
+  };
+
+  CompressedIncidenceArray() :
+    _num_entries(0),
+    _offsets(),
+    _data() { }
+
+  /*!
+   * Compresses num_lists lists. The function list_of(i) must return a range
+   * over the IDs of the i-th list.
+   */
+  template<typename F>
+  CompressedIncidenceArray(const size_t num_lists, const F& list_of) :
+    _num_entries(0),
+    _offsets(),
+    _data() {
+    construct(num_lists, list_of);
+  }
+
+  CompressedIncidenceArray(const CompressedIncidenceArray&) = delete;
+  CompressedIncidenceArray & operator= (const CompressedIncidenceArray &) = delete;
+
+  CompressedIncidenceArray(CompressedIncidenceArray&&) = default;
+  CompressedIncidenceArray & operator= (CompressedIncidenceArray &&) = default;
+
+  // ! Compresses the pins of each hyperedge of the hypergraph
+  template<typename Hypergraph>
+  static CompressedIncidenceArray fromPins(const Hypergraph& hypergraph) {
+    return CompressedIncidenceArray(hypergraph.initialNumEdges(),
+      [&](const HyperedgeID he) { return hypergraph.pins(he); });
+  }
+
+  // ! Compresses the incident nets of each vertex of the hypergraph
+  template<typename Hypergraph>
+  static CompressedIncidenceArray fromIncidentNets(const Hypergraph& hypergraph) {
+    return CompressedIncidenceArray(hypergraph.initialNumNodes(),
+      [&](const HypernodeID hn) { return hypergraph.incidentEdges(hn); });
+  }
+
+  // ! Number of compressed lists
+  size_t numLists() const {
+    return _offsets.size() > 0 ? _offsets.size() - 1 : 0;
+  }
+
+  // ! Total number of IDs in all lists
+  size_t numEntries() const {
+    return _num_entries;
+  }
+
+  // ! Returns a range to iterate over the IDs of the i-th list
+  IteratorRange<Iterator> get(const size_t i) const {
+    ASSERT(i < numLists());
+    const uint8_t* end = _data.data() + _offsets[i + 1];
+    return IteratorRange<Iterator>(
+      Iterator(_data.data() + _offsets[i], end), Iterator(end, end));
+  }
+
+  // ! Number of IDs in the i-th list
+  size_t size(const size_t i) const {
+    ASSERT(i < numLists());
+    // Each encoded value ends with a byte without continuation bit
+    return std::count_if(_data.data() + _offsets[i], _data.data() + _offsets[i + 1],
+      [&](const uint8_t byte) { return !(byte & CONTINUATION_BIT); });
+  }
+
+  // ! Size of the compressed representation in bytes
+  size_t sizeInBytes() const {
+    return sizeof(uint8_t) * _data.size() + sizeof(size_t) * _offsets.size();
+  }
+
+  void memoryConsumption(utils::MemoryTreeNode* parent) const {
+    ASSERT(parent);
+    parent->addChild("Compressed Lists", sizeof(uint8_t) * _data.size());
+    parent->addChild("Compressed List Offsets", sizeof(size_t) * _offsets.size());
+  }
+
+ private:
+  template<typename F>
+  void construct(const size_t num_lists, const F& list_of) {
+    // Sorts the i-th list into the thread-local buffer
+    tbb::enumerable_thread_specific<parallel::scalable_vector<ID>> local_list;
+    auto sorted_list = [&](const size_t i) -> parallel::scalable_vector<ID>& {
+      parallel::scalable_vector<ID>& list = local_list.local();
+      list.clear();
+      for ( const ID id : list_of(i) ) {
+        list.push_back(id);
+      }
+      std::sort(list.begin(), list.end());
+      return list;
+    };
+
+    // Compute number of bytes required to encode each list
+    _offsets.resize(num_lists + 1);
+    tbb::enumerable_thread_specific<size_t> local_num_entries(0);
+    tbb::parallel_for(UL(0), num_lists, [&](const size_t i) {
+      const parallel::scalable_vector<ID>& list = sorted_list(i);
+      size_t num_bytes = 0;
+      ID last = 0;
+      for ( const ID id : list ) {
+        num_bytes += encodedSize(id - last);
+        last = id;
+      }
+      _offsets[i + 1] = num_bytes;
+      local_num_entries.local() += list.size();
+    });
+    _offsets[0] = 0;
+    _num_entries = local_num_entries.combine(std::plus<size_t>());
+
+    parallel::TBBPrefixSum<size_t, Array> offset_prefix_sum(_offsets);
+    tbb::parallel_scan(tbb::blocked_range<size_t>(UL(0), num_lists + 1), offset_prefix_sum);
+    _data.resize(offset_prefix_sum.total_sum());
+
+    // Encode lists
+    tbb::parallel_for(UL(0), num_lists, [&](const size_t i) {
+      const parallel::scalable_vector<ID>& list = sorted_list(i);
+      uint8_t* pos = _data.data() + _offsets[i];
+      ID last = 0;
+      for ( const ID id : list ) {
+        pos = encodeVarint(id - last, pos);
+        last = id;
+      }
+      ASSERT(pos == _data.data() + _offsets[i + 1]);
+    });
+  }
+
+  static size_t encodedSize(ID value) {
+    size_t num_bytes = 1;
+    while ( value > PAYLOAD_MASK ) {
+      value >>= 7;
+      ++num_bytes;
+    }
+    return num_bytes;
+  }
+
+  static uint8_t* encodeVarint(ID value, uint8_t* pos) {
+    while ( value > PAYLOAD_MASK ) {
+      *pos++ = static_cast<uint8_t>(value & PAYLOAD_MASK) | CONTINUATION_BIT;
+      value >>= 7;
+    }
+    *pos++ = static_cast<uint8_t>(value);
+    return pos;
+  }
+
+  // ! Decodes the value at position pos and advances pos
+  // ! to the beginning of the next value
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static ID decodeVarint(const uint8_t*& pos) {
+    // Fast path: most differences fit into one byte
+    if ( !(*pos & CONTINUATION_BIT) ) {
+      return *pos++;
+    }
+    ID value = 0;
+    size_t shift = 0;
+    uint8_t byte;
+    do {
+      ASSERT(shift < 7 * MAX_BYTES_PER_VALUE);
+      byte = *pos++;
+      value |= static_cast<ID>(byte & PAYLOAD_MASK) << shift;
+      shift += 7;
+    } while ( byte & CONTINUATION_BIT );
+    return value;
+  }
+
+  size_t _num_entries;
+  // ! Byte offset of each list in _data (with sentinel)
+  Array<size_t> _offsets;
+  // ! Varint-encoded differences of all lists
+  Array<uint8_t> _data;
+};
+
+}  // namespace ds
+}  // namespace mt_kahypar
@@ -33,6 +33,8 @@
 
 #include "tbb/task_arena.h"
 #include "tbb/task_group.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
 
 #include "kahypar/meta/mandatory.h"
 
@@ -156,5 +158,169 @@ class ConcurrentBucketMap {
   std::vector<SpinLock> _spin_locks;
   parallel::scalable_vector<Bucket> _buckets;
 };
+/*!
+ * Lock-free alternative to the ConcurrentBucketMap. Key-value pairs are
+ * first inserted into thread-local buffers (pre-bucketing). Calling finalize()
+ * counts the elements of each bucket per thread, computes a prefix sum over
+ * all (bucket, thread) pairs and scatters the elements in parallel into one
+ * contiguous array. Afterwards, each bucket is a contiguous range of that
+ * array. In contrast to the ConcurrentBucketMap, threads do not serialize
+ * on buckets with many collisions and the per-bucket processing afterwards
+ * scans consecutive memory.
+ * Note, the order of the elements inside a bucket is not deterministic.
+ */
+template <typename Value>
+class LockFreeBucketMap {
+
+  static constexpr bool debug = false;
+  static constexpr size_t BUCKET_FACTOR = 128;
+
+  struct Entry {
+    size_t bucket;
+    Value value;
+  };
+
+  using LocalEntries = parallel::scalable_vector<Entry>;
+
+ public:
+  // ! Contiguous range of the elements of a bucket
+  class Bucket {
+   public:
+    Bucket(Value* first, Value* last) :
+      _first(first),
+      _last(last) { }
+
+    Value* begin() const {
+      return _first;
+    }
+
+    Value* end() const {
+      return _last;
+    }
+
+    Value* data() const {
+      return _first;
+    }
+
+    size_t size() const {
+      return _last - _first;
+    }
+
+    Value& operator[](const size_t i) const {
+      ASSERT(i < size());
+      return _first[i];
+    }
+
+   private:
+    Value* _first;
+    Value* _last;
+  };
+
+  LockFreeBucketMap() :
+    _num_buckets(align_to_next_power_of_two(
+      BUCKET_FACTOR * std::thread::hardware_concurrency())),
+    _mod_mask(_num_buckets - 1),
+    _local_entries(),
+    _thread_offsets(),
+    _bucket_begin(_num_buckets + 1, 0),
+    _values() { }
+
+  LockFreeBucketMap(const LockFreeBucketMap&) = delete;
+  LockFreeBucketMap & operator= (const LockFreeBucketMap &) = delete;
+
+  LockFreeBucketMap(LockFreeBucketMap&&) = delete;
+  LockFreeBucketMap & operator= (LockFreeBucketMap &&) = delete;
+
+  // ! Returns the number of buckets
+  size_t numBuckets() const {
+    return _num_buckets;
+  }
+
+  // ! Returns the corresponding bucket (only valid after finalize())
+  Bucket getBucket(const size_t bucket) {
+    ASSERT(bucket < _num_buckets);
+    return Bucket(_values.data() + _bucket_begin[bucket],
+                  _values.data() + _bucket_begin[bucket + 1]);
+  }
+
+  // ! Reserves memory for the contiguous bucket array
+  void reserve_for_estimated_number_of_insertions(const size_t estimated_num_insertions) {
+    _values.reserve(estimated_num_insertions);
+  }
+
+  // ! Inserts a key-value pair into the buffer of the calling thread
+  void insert(const size_t& key, Value&& value) {
+    _local_entries.local().push_back(Entry { key & _mod_mask, std::move(value) });
+  }
+
+  // ! Distributes all inserted key-value pairs into their buckets.
+  // ! Must be called before the buckets are accessed.
+  void finalize() {
+    vec<LocalEntries*> locals;
+    for ( LocalEntries& local : _local_entries ) {
+      locals.push_back(&local);
+    }
+    const size_t num_locals = locals.size();
+
+    // Count elements per (thread, bucket)
+    _thread_offsets.assign(num_locals * _num_buckets, 0);
+    tbb::parallel_for(UL(0), num_locals, [&](const size_t t) {
+      size_t* offsets = _thread_offsets.data() + t * _num_buckets;
+      for ( const Entry& entry : *locals[t] ) {
+        ++offsets[entry.bucket];
+      }
+    });
+
+    // Exclusive prefix sum over the threads of each bucket and over all buckets
+    tbb::parallel_for(UL(0), _num_buckets, [&](const size_t bucket) {
+      size_t bucket_size = 0;
+      for ( size_t t = 0; t < num_locals; ++t ) {
+        const size_t count = _thread_offsets[t * _num_buckets + bucket];
+        _thread_offsets[t * _num_buckets + bucket] = bucket_size;
+        bucket_size += count;
+      }
+      _bucket_begin[bucket + 1] = bucket_size;
+    });
+    _bucket_begin[0] = 0;
+    for ( size_t bucket = 0; bucket < _num_buckets; ++bucket ) {
+      _bucket_begin[bucket + 1] += _bucket_begin[bucket];
+    }
+
+    // Scatter elements into their bucket ranges
+    _values.resize(_bucket_begin[_num_buckets]);
+    tbb::parallel_for(UL(0), num_locals, [&](const size_t t) {
+      size_t* offsets = _thread_offsets.data() + t * _num_buckets;
+      for ( Entry& entry : *locals[t] ) {
+        _values[_bucket_begin[entry.bucket] + offsets[entry.bucket]++] = std::move(entry.value);
+      }
+      locals[t]->clear();
+    });
+    DBG << "Distributed" << _values.size() << "elements from" << num_locals
+        << "threads into" << _num_buckets << "buckets";
+  }
+
+  // ! Frees the memory of all buckets
+  void free() {
+    for ( LocalEntries& local : _local_entries ) {
+      parallel::free(local);
+    }
+    parallel::free(_thread_offsets);
+    parallel::free(_values);
+    std::fill(_bucket_begin.begin(), _bucket_begin.end(), 0);
+  }
+
+ private:
+  size_t align_to_next_power_of_two(const size_t size) const {
+    return std::pow(2.0, std::ceil(std::log2(static_cast<double>(size))));
+  }
+
+  const size_t _num_buckets;
+  const size_t _mod_mask;
+  tbb::enumerable_thread_specific<LocalEntries> _local_entries;
+  // ! Position of the first element of a thread inside a bucket
+  parallel::scalable_vector<size_t> _thread_offsets;
+  parallel::scalable_vector<size_t> _bucket_begin;
+  parallel::scalable_vector<Value> _values;
+};
 }  // namespace ds
 }  // namespace mt_kahypar
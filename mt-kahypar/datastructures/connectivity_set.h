@@ -27,6 +27,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <type_traits>
 #include <limits>
@@ -56,6 +57,13 @@ namespace ds {
  *      to add a part. One correct way is to keep an atomic count of pins for each hyperedge and part. Then only the thread
  *      raising the counter from zero to one performs the add, and only the thread decreasing the counter from one to zero
  *      performs the removal.
+ *
+ *      For k > 64, we additionally store a summary bitmap in front of the bits of each hyperedge. The i-th bit
+ *      of the summary is set, if the i-th word of the connectivity set is non-zero. Iterating over a connectivity
+ *      set then only visits non-zero words, i.e., the iteration cost is proportional to the connectivity
+ *      (plus k / 4096) instead of k / 64. A summary bit is toggled whenever its word changes from zero to non-zero
+ *      or vice versa. Since these transitions alternate for each word and toggles commute, the summary is
+ *      consistent with the words once all concurrent updates are finished.
  */
 class ConnectivitySets {
 public:
@@ -67,6 +75,7 @@ public:
     _k(0),
     _num_hyperedges(0),
     _num_blocks_per_hyperedge(0),
+    _num_summary_blocks_per_hyperedge(0),
     _bits() { }
 
   ConnectivitySets(const HyperedgeID num_hyperedges,
@@ -74,11 +83,12 @@ public:
                    const bool assign_parallel = true) :
     _k(k),
     _num_hyperedges(num_hyperedges),
-    _num_blocks_per_hyperedge(k / BITS_PER_BLOCK + (k % BITS_PER_BLOCK != 0)),
+    _num_blocks_per_hyperedge(num_blocks(k)),
+    _num_summary_blocks_per_hyperedge(num_summary_blocks(k)),
     _bits() {
       if ( num_hyperedges > 0 ) {
         _bits.resize("Refinement", "connectivity_set",
-          static_cast<size_t>(num_hyperedges) * _num_blocks_per_hyperedge, true, assign_parallel);
+          num_elements(num_hyperedges, k), true, assign_parallel);
       }
     }
 
@@ -93,14 +103,19 @@ public:
   bool contains(const HyperedgeID he, const PartitionID p) const {
     const size_t div = p / BITS_PER_BLOCK;
     const size_t rem = p % BITS_PER_BLOCK;
-    const size_t pos = static_cast<size_t>(he) * _num_blocks_per_hyperedge + div;
+    const size_t pos = firstBlock(he) + div;
     return _bits[pos].load(std::memory_order_relaxed) & (UnsafeBlock(1) << rem);
   }
 
+  // ! Prefetches the connectivity set of the hyperedge
+  void prefetch(const HyperedgeID he) const {
+    MT_KAHYPAR_PREFETCH(_bits.data() + static_cast<size_t>(he) * stride());
+  }
+
   // not threadsafe
   void clear(const HyperedgeID he) {
-    const size_t start = static_cast<size_t>(he) * _num_blocks_per_hyperedge;
-    const size_t end = ( static_cast<size_t>(he) + 1 ) * _num_blocks_per_hyperedge;
+    const size_t start = static_cast<size_t>(he) * stride();
+    const size_t end = ( static_cast<size_t>(he) + 1 ) * stride();
     for (size_t i = start; i < end; ++i) {
       _bits[i].store(0, std::memory_order_relaxed);
     }
@@ -114,14 +129,31 @@ public:
 
   PartitionID connectivity(const HyperedgeID he) const {
     PartitionID conn = 0;
-    const size_t start = static_cast<size_t>(he) * _num_blocks_per_hyperedge;
-    const size_t end = ( static_cast<size_t>(he) + 1 ) * _num_blocks_per_hyperedge;
-    for (size_t i = start; i < end; ++i) {
-      conn += utils::popcount_64(_bits[i].load(std::memory_order_relaxed));
-    }
+    forEachNonZeroBlock(he, [&](const PartitionID, const UnsafeBlock bits) {
+      conn += utils::popcount_64(bits);
+    });
     return conn;
   }
 
+  // ! Adds value to aggregator[p] for each block p in the connectivity set of he.
+  // ! Instead of iterating over the set bits, each bit is expanded to a mask and the
+  // ! value is added to all entries of the block without branches. This allows the
+  // ! compiler to vectorize the loop, which is faster than the iterator for small k.
+  template<typename T>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void addToAllBlocks(const HyperedgeID he,
+                                                          const T value,
+                                                          T* aggregator) const {
+    static_assert(std::is_integral<T>::value, "Masked addition requires an integral type");
+    forEachNonZeroBlock(he, [&](const PartitionID i, const UnsafeBlock bits) {
+      const PartitionID offset = i * BITS_PER_BLOCK;
+      const PartitionID length = std::min(BITS_PER_BLOCK, _k - offset);
+      T* block_aggregator = aggregator + offset;
+      for (PartitionID j = 0; j < length; ++j) {
+        block_aggregator[j] += value & -static_cast<T>((bits >> j) & UnsafeBlock(1));
+      }
+    });
+  }
+
   void freeInternalData() {
     parallel::free(_bits);
   }
@@ -133,7 +165,7 @@ public:
 
   static size_t num_elements(const HyperedgeID num_hyperedges,
                              const PartitionID k) {
-    return static_cast<size_t>(num_hyperedges) * (k / BITS_PER_BLOCK + (k % BITS_PER_BLOCK != 0));
+    return static_cast<size_t>(num_hyperedges) * (num_blocks(k) + num_summary_blocks(k));
   }
 
 private:
@@ -141,19 +173,71 @@ private:
   using Block = parallel::IntegralAtomicWrapper<UnsafeBlock>;
   using BlockIterator = Array<Block>::const_iterator;
 
+  static PartitionID num_blocks(const PartitionID k) {
+    return k / BITS_PER_BLOCK + (k % BITS_PER_BLOCK != 0);
+  }
+
+  // ! The summary is only maintained if a connectivity set consists of more than one block
+  static PartitionID num_summary_blocks(const PartitionID k) {
+    const PartitionID blocks = num_blocks(k);
+    return blocks > 1 ? blocks / BITS_PER_BLOCK + (blocks % BITS_PER_BLOCK != 0) : 0;
+  }
+
+  size_t stride() const {
+    return _num_summary_blocks_per_hyperedge + _num_blocks_per_hyperedge;
+  }
+
+  // ! Position of the first block of the connectivity set of he (behind its summary)
+  size_t firstBlock(const HyperedgeID he) const {
+    return static_cast<size_t>(he) * stride() + _num_summary_blocks_per_hyperedge;
+  }
+
+  // ! Calls f(i, bits) for each non-zero block i of the connectivity set of he
+  template<typename F>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void forEachNonZeroBlock(const HyperedgeID he, const F& f) const {
+    const size_t start = firstBlock(he);
+    if ( _num_summary_blocks_per_hyperedge == 0 ) {
+      for (PartitionID i = 0; i < _num_blocks_per_hyperedge; ++i) {
+        const UnsafeBlock bits = _bits[start + i].load(std::memory_order_relaxed);
+        if (bits != 0) {
+          f(i, bits);
+        }
+      }
+    } else {
+      const size_t summary_start = start - _num_summary_blocks_per_hyperedge;
+      for (PartitionID s = 0; s < _num_summary_blocks_per_hyperedge; ++s) {
+        UnsafeBlock summary = _bits[summary_start + s].load(std::memory_order_relaxed);
+        while (summary != 0) {
+          const PartitionID i = s * BITS_PER_BLOCK + utils::lowest_set_bit_64(summary);
+          const UnsafeBlock bits = _bits[start + i].load(std::memory_order_relaxed);
+          if (bits != 0) {
+            f(i, bits);
+          }
+          summary &= summary - 1;
+        }
+      }
+    }
+  }
 
 	PartitionID _k;
 	HyperedgeID _num_hyperedges;
 	PartitionID _num_blocks_per_hyperedge;
+	PartitionID _num_summary_blocks_per_hyperedge;
 	Array<Block> _bits;
 
 	void toggle(const HyperedgeID he, const PartitionID p) {
 	  assert(p < _k);
 	  assert(he < _num_hyperedges);
     const size_t div = p / BITS_PER_BLOCK, rem = p % BITS_PER_BLOCK;
-    const size_t idx = static_cast<size_t>(he) * _num_blocks_per_hyperedge + div;
+    const size_t idx = firstBlock(he) + div;
     assert(idx < _bits.size());
-	  _bits[idx].fetch_xor(UnsafeBlock(1) << rem, std::memory_order_relaxed);
+    const UnsafeBlock mask = UnsafeBlock(1) << rem;
+	  const UnsafeBlock before = _bits[idx].fetch_xor(mask, std::memory_order_relaxed);
+    if ( _num_summary_blocks_per_hyperedge > 0 && ( before == 0 || before == mask ) ) {
+      // The block changed from zero to non-zero or vice versa
+      const size_t summary_idx = static_cast<size_t>(he) * stride() + div / BITS_PER_BLOCK;
+      _bits[summary_idx].fetch_xor(UnsafeBlock(1) << (div % BITS_PER_BLOCK), std::memory_order_relaxed);
+    }
 	}
 
 public:
@@ -166,7 +250,12 @@ public:
     using pointer = PartitionID*;
     using difference_type = std::ptrdiff_t;
 
-    Iterator(BlockIterator first, PartitionID part, PartitionID k) : currentPartition(part), _k(k), firstBlockIt(first) {
+    Iterator(BlockIterator first, PartitionID num_summary_blocks, PartitionID part, PartitionID k) :
+      currentPartition(part),
+      _k(k),
+      _num_blocks(num_blocks(k)),
+      _num_summary_blocks(num_summary_blocks),
+      firstBlockIt(first) {
       findNextBit();
     }
 
@@ -196,34 +285,70 @@ public:
   private:
     PartitionID currentPartition;
     PartitionID _k;
+    PartitionID _num_blocks;
+    PartitionID _num_summary_blocks;
+    // ! Points to the summary of the connectivity set (or to its first
+    // ! block, if no summary is maintained)
     BlockIterator firstBlockIt;
 
     void findNextBit() {
       ++currentPartition;
-      UnsafeBlock b = currentBlock()->load(std::memory_order_relaxed);
-      while (b >> (currentPartition % BITS_PER_BLOCK) == 0 && currentPartition < _k) {
-        currentPartition += (BITS_PER_BLOCK - (currentPartition % BITS_PER_BLOCK));   // skip rest of block
-        b = currentBlock()->load(std::memory_order_relaxed);
-      }
-      if (currentPartition < _k) {
-        currentPartition += utils::lowest_set_bit_64(b >> (currentPartition % BITS_PER_BLOCK));
-      } else {
+      if (currentPartition >= _k) {
         currentPartition = _k;
+        return;
+      }
+      PartitionID i = currentPartition / BITS_PER_BLOCK;
+      const UnsafeBlock b = block(i) >> (currentPartition % BITS_PER_BLOCK);
+      if (b != 0) {
+        currentPartition += utils::lowest_set_bit_64(b);
+        return;
       }
+      // skip rest of block and all following zero blocks
+      for (i = nextNonZeroBlock(i + 1); i < _num_blocks; i = nextNonZeroBlock(i + 1)) {
+        const UnsafeBlock bits = block(i);
+        if (bits != 0) {
+          currentPartition = i * BITS_PER_BLOCK + utils::lowest_set_bit_64(bits);
+          return;
+        }
+      }
+      currentPartition = _k;
     }
 
-    BlockIterator currentBlock() const {
-      return firstBlockIt + currentPartition / BITS_PER_BLOCK;
+    UnsafeBlock block(const PartitionID i) const {
+      return (firstBlockIt + _num_summary_blocks + i)->load(std::memory_order_relaxed);
+    }
+
+    // ! Returns the first block >= i that is marked as non-zero in the summary
+    // ! (or _num_blocks, if there is none)
+    PartitionID nextNonZeroBlock(PartitionID i) const {
+      if (_num_summary_blocks == 0) {
+        while (i < _num_blocks && block(i) == 0) {
+          ++i;
+        }
+        return i;
+      }
+      for (PartitionID s = i / BITS_PER_BLOCK; s < _num_summary_blocks; ++s) {
+        UnsafeBlock summary = (firstBlockIt + s)->load(std::memory_order_relaxed);
+        if (s == i / BITS_PER_BLOCK) {
+          summary &= ~UnsafeBlock(0) << (i % BITS_PER_BLOCK);
+        }
+        if (summary != 0) {
+          return std::min(_num_blocks, s * BITS_PER_BLOCK + utils::lowest_set_bit_64(summary));
+        }
+      }
+      return _num_blocks;
     }
 
   };
 
 	Iterator hyperedgeBegin(const HyperedgeID he) const {
-	  return Iterator(_bits.cbegin() + static_cast<size_t>(he) * _num_blocks_per_hyperedge, -1, _k);
+	  return Iterator(_bits.cbegin() + static_cast<size_t>(he) * stride(),
+	    _num_summary_blocks_per_hyperedge, -1, _k);
 	}
 
 	Iterator hyperedgeEnd(const HyperedgeID he) const {
-	  return Iterator(_bits.cbegin() + static_cast<size_t>(he) * _num_blocks_per_hyperedge, _k-1, _k);
+	  return Iterator(_bits.cbegin() + static_cast<size_t>(he) * stride(),
+	    _num_summary_blocks_per_hyperedge, _k-1, _k);
 	}
 
 
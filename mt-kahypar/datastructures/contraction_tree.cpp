@@ -43,15 +43,11 @@ namespace ds {
 // ! Initializes the data structure in parallel
 void ContractionTree::initialize(const HypernodeID num_hypernodes) {
   _num_hypernodes = num_hypernodes;
-  tbb::parallel_invoke([&] {
-    _tree.resize(_num_hypernodes);
-    tbb::parallel_for(ID(0), _num_hypernodes, [&](const HypernodeID hn) {
-      node(hn).setParent(hn);
-    });
-  }, [&] {
-    _out_degrees.assign(_num_hypernodes + 1, parallel::IntegralAtomicWrapper<HypernodeID>(0));
-  }, [&] {
-    _incidence_array.resize(_num_hypernodes);
+  // The out degrees and the incidence array are only needed after finalize
+  // and are allocated there to keep the memory footprint of the contraction phase low
+  _tree.resize(_num_hypernodes);
+  tbb::parallel_for(ID(0), _num_hypernodes, [&](const HypernodeID hn) {
+    node(hn).setParent(hn);
   });
 }
 
@@ -60,6 +56,7 @@ void ContractionTree::initialize(const HypernodeID num_hypernodes) {
 // ! computing the subtree sizes.
 void ContractionTree::finalize(const size_t num_versions) {
   ASSERT(!_finalized, "Contraction tree already finalized");
+  _out_degrees.assign(_num_hypernodes + 1, parallel::IntegralAtomicWrapper<HypernodeID>(0));
   // Compute out degrees of each tree node
   tbb::parallel_for(ID(0), _num_hypernodes, [&](const HypernodeID hn) {
     ASSERT(node(hn).pendingContractions() == 0, "There are"
@@ -80,6 +77,8 @@ void ContractionTree::finalize(const size_t num_versions) {
   }, [&] {
     incidence_array_pos.assign(_num_hypernodes, parallel::IntegralAtomicWrapper<HypernodeID>(0));
   });
+  // Only non-root nodes are stored in the incidence array
+  _incidence_array.resize(_out_degrees[_num_hypernodes]);
 
   // Reverse parent pointer of contraction tree such that it can be traversed in top-down fashion
   StreamingVector<HypernodeID> tmp_roots;
@@ -141,28 +140,30 @@ void ContractionTree::finalize(const size_t num_versions) {
     tmp_version_roots[i].clear_parallel();
   });
 
-  // Compute subtree sizes of each root in parallel via dfs
-  tbb::parallel_for(UL(0), _roots.size(), [&](const size_t i) {
-    parallel::scalable_vector<HypernodeID> dfs;
-    dfs.push_back(_roots[i]);
-    while( !dfs.empty() ) {
-      const HypernodeID u = dfs.back();
-      if ( subtreeSize(u) == 0 ) {
-        // Visit u for the first time => push all childs on the dfs stack
-        for ( const HypernodeID& v : childs(u)) {
-          dfs.push_back(v);
-        }
-        // Mark u as visited
-        node(u).setSubtreeSize(1);
-      } else {
-        // Visit u for second time => accumulate subtree sizes and pop u
-        dfs.pop_back();
-        HypernodeID subtree_size = 0;
-        for ( const HypernodeID& v : childs(u) ) {
-          subtree_size += ( subtreeSize(v) + 1 );
-        }
-        node(u).setSubtreeSize(subtree_size);
+  // Compute subtree sizes in parallel in a bottom-up fashion. A single dfs per root
+  // would be sequential for large subtrees. Instead, each leaf of the contraction tree
+  // walks towards its root. After reversing the parent pointers, incidence_array_pos[u]
+  // contains the number of childs of u, which we use as counter for the number of
+  // childs whose subtree size is not computed yet. The child that decrements the counter
+  // of its parent to zero computes the subtree size of the parent and continues
+  // with it. Thus, each tree node is processed exactly once.
+  tbb::parallel_for(ID(0), _num_hypernodes, [&](const HypernodeID hn) {
+    if ( node(hn).parent() == hn || _out_degrees[hn + 1] - _out_degrees[hn] > 0 ) {
+      // Node hn is a root or an inner node of the contraction tree
+      return;
+    }
+    node(hn).setSubtreeSize(0);
+    HypernodeID u = hn;
+    HypernodeID p = node(u).parent();
+    while ( p != u && incidence_array_pos[p].fetch_sub(1) == 1 ) {
+      // All childs of p are processed => accumulate subtree sizes
+      HypernodeID subtree_size = 0;
+      for ( const HypernodeID& v : childs(p) ) {
+        subtree_size += ( subtreeSize(v) + 1 );
       }
+      node(p).setSubtreeSize(subtree_size);
+      u = p;
+      p = node(u).parent();
     }
   });
 
@@ -260,11 +261,9 @@ void ContractionTree::reset() {
   tbb::parallel_invoke([&] {
     tbb::parallel_for(ID(0), _num_hypernodes, [&](const HypernodeID hn) {
       _tree[hn].reset(hn);
-      _out_degrees[hn].store(0);
     });
-    _out_degrees[_num_hypernodes].store(0);
   }, [&] {
-    parallel::parallel_free(_version_roots);
+    parallel::parallel_free(_version_roots, _out_degrees, _incidence_array);
     _roots.clear();
   });
   _finalized = false;
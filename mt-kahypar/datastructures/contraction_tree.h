@@ -174,15 +174,19 @@ class ContractionTree {
  private:
   /**
    * Represents a node in contraction tree and contains all information
-   * associated with that node.
+   * associated with that node. The number of pending contractions is only
+   * needed before and the subtree size only after the contraction tree is
+   * finalized. Thus, both share the same field, which together with 32-bit
+   * version numbers reduces the size of a node from 32 to 20 bytes.
    */
   class Node {
+    static constexpr uint32_t kInvalidNodeVersion = std::numeric_limits<uint32_t>::max();
+
     public:
       Node() :
         _parent(0),
-        _pending_contractions(0),
-        _subtree_size(0),
-        _version(kInvalidVersion),
+        _pending_contractions_or_subtree_size(0),
+        _version(kInvalidNodeVersion),
         _interval() { }
 
       inline HypernodeID parent() const {
@@ -194,31 +198,32 @@ class ContractionTree {
       }
 
       inline HypernodeID pendingContractions() const {
-        return _pending_contractions;
+        return _pending_contractions_or_subtree_size;
       }
 
       inline void incrementPendingContractions() {
-        ++_pending_contractions;
+        ++_pending_contractions_or_subtree_size;
       }
 
       inline void decrementPendingContractions() {
-        --_pending_contractions;
+        --_pending_contractions_or_subtree_size;
       }
 
       inline HypernodeID subtreeSize() const {
-        return _subtree_size;
+        return _pending_contractions_or_subtree_size;
       }
 
       inline void setSubtreeSize(const HypernodeID subtree_size) {
-        _subtree_size = subtree_size;
+        _pending_contractions_or_subtree_size = subtree_size;
       }
 
       inline size_t version() const {
-        return _version;
+        return _version == kInvalidNodeVersion ? kInvalidVersion : _version;
       }
 
       inline void setVersion(const size_t version) {
-        _version = version;
+        ASSERT(version == kInvalidVersion || version < kInvalidNodeVersion);
+        _version = version == kInvalidVersion ? kInvalidNodeVersion : static_cast<uint32_t>(version);
       }
 
       inline Interval interval() const {
@@ -233,9 +238,8 @@ class ContractionTree {
 
       inline void reset(const HypernodeID u) {
         _parent = u;
-        _pending_contractions = 0;
-        _subtree_size = 0;
-        _version = kInvalidVersion;
+        _pending_contractions_or_subtree_size = 0;
+        _version = kInvalidNodeVersion;
         _interval.start = kInvalidHypernode;
         _interval.end = kInvalidHypernode;
       }
@@ -243,12 +247,10 @@ class ContractionTree {
     private:
       // ! Parent in the contraction tree
       HypernodeID _parent;
-      // ! Number of pending contractions
-      HypernodeID _pending_contractions;
-      // ! Size of the subtree
-      HypernodeID _subtree_size;
+      // ! Number of pending contractions (before finalize) or size of the subtree (after finalize)
+      HypernodeID _pending_contractions_or_subtree_size;
       // ! Version number of the hypergraph for which contract the corresponding vertex
-      size_t _version;
+      uint32_t _version;
       // ! "Time" interval on which the contraction of this node takes place
       Interval _interval;
   };
@@ -305,6 +307,7 @@ class ContractionTree {
 
   // ! Number of pending contractions of node u
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE HypernodeID pendingContractions(const HypernodeID u) const {
+    ASSERT(!_finalized, "Information not available after finalize");
     return node(u).pendingContractions();
   }
 
@@ -500,7 +503,7 @@ class ContractionTree {
 
   // ! Finalizes the contraction tree which involve reversing the parent pointers
   // ! such that the contraction tree can be traversed in a top-down fashion and
-  // ! computing the subtree sizes.
+  // ! computing the subtree sizes. The child arrays (CSR) are only allocated here.
   void finalize(const size_t num_versions = 1);
 
   // ####################### Copy #######################
@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "mt-kahypar/datastructures/atomic_bit_vector.h"
+#include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+#include "mt-kahypar/parallel/stl/thread_locals.h"
+
+namespace mt_kahypar {
+namespace ds {
+
+/*!
+ * Maintains the set of cut nets of a partition incrementally. A net is marked in a
+ * bit vector while it is cut. Additionally, a net that becomes cut is appended to a
+ * thread-local list of candidates, if it is not already contained in one of the lists.
+ * The candidate lists may contain nets that are no longer cut and are compacted
+ * whenever the cut nets are enumerated. Thus, enumerating the cut nets takes time
+ * linear in the number of cut nets plus the number of nets that became cut since
+ * the last enumeration (instead of linear in the number of nets).
+ * Note that the state of a net must only be changed by one thread at a time
+ * (e.g., while holding the pin count update lock of the net).
+ */
+class CutNetIndex {
+
+ public:
+  explicit CutNetIndex(const HyperedgeID num_edges) :
+    _is_cut(),
+    _is_candidate(),
+    _cut_nets(),
+    _new_candidates() {
+    _is_cut.setSize(num_edges);
+    _is_candidate.setSize(num_edges);
+  }
+
+  CutNetIndex(const CutNetIndex&) = delete;
+  CutNetIndex(CutNetIndex&&) = delete;
+  CutNetIndex & operator= (const CutNetIndex &) = delete;
+  CutNetIndex & operator= (CutNetIndex &&) = delete;
+
+  bool isCut(const HyperedgeID he) const {
+    return _is_cut[he];
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void setCut(const HyperedgeID he) {
+    if ( !_is_cut[he] ) {
+      _is_cut.set(he, true);
+      if ( !_is_candidate.testAndSet(he) ) {
+        _new_candidates.local().push_back(he);
+      }
+    }
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void setUncut(const HyperedgeID he) {
+    _is_cut.set(he, false);
+  }
+
+  // ! Updates the state of a net after a move with the resulting pin counts
+  // ! (see TrackedObjective::cutDelta(...))
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void update(const HyperedgeID he,
+                                                 const HypernodeID edge_size,
+                                                 const HypernodeID pin_count_in_from_part_after,
+                                                 const HypernodeID pin_count_in_to_part_after) {
+    if ( pin_count_in_to_part_after == edge_size ) {
+      setUncut(he);
+    } else if ( pin_count_in_from_part_after == edge_size - 1 && pin_count_in_to_part_after == 1 ) {
+      setCut(he);
+    }
+  }
+
+  // ! Returns all cut nets (not thread-safe, must not be called concurrently to moves)
+  const vec<HyperedgeID>& cutNets() {
+    for ( vec<HyperedgeID>& new_candidates : _new_candidates ) {
+      _cut_nets.insert(_cut_nets.end(), new_candidates.begin(), new_candidates.end());
+      new_candidates.clear();
+    }
+    size_t num_cut_nets = 0;
+    for ( size_t i = 0; i < _cut_nets.size(); ++i ) {
+      const HyperedgeID he = _cut_nets[i];
+      if ( _is_cut[he] ) {
+        _cut_nets[num_cut_nets++] = he;
+      } else {
+        _is_candidate.set(he, false);
+      }
+    }
+    _cut_nets.resize(num_cut_nets);
+    return _cut_nets;
+  }
+
+  // ! Removes all nets from the index (not thread-safe)
+  void reset() {
+    _is_cut.reset();
+    _is_candidate.reset();
+    _cut_nets.clear();
+    for ( vec<HyperedgeID>& new_candidates : _new_candidates ) {
+      new_candidates.clear();
+    }
+  }
+
+ private:
+  AtomicBitVector _is_cut;
+  AtomicBitVector _is_candidate;
+  vec<HyperedgeID> _cut_nets;
+  tls_enumerable_thread_specific< vec<HyperedgeID> > _new_candidates;
+};
+
+}  // namespace ds
+}  // namespace mt_kahypar
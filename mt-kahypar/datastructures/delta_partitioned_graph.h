@@ -28,12 +28,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <type_traits>
 
 #include "kahypar/meta/mandatory.h"
 
 #include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/datastructures/prefetching.h"
 #include "mt-kahypar/datastructures/sparse_map.h"
 #include "mt-kahypar/parallel/stl/scalable_vector.h"
 #include "mt-kahypar/partition/context.h"
@@ -52,6 +54,16 @@ class DeltaPartitionedGraph {
   static constexpr size_t MAP_SIZE_LARGE = 16384;
   static constexpr size_t MAP_SIZE_MOVE_DELTA = 8192;
   static constexpr size_t MAP_SIZE_SMALL = 128;
+  static constexpr size_t NUM_LOCAL_BLOCKS = 3;
+
+  // ! Incident weight deltas of a node for the first NUM_LOCAL_BLOCKS touched blocks.
+  // ! Deltas of further blocks are stored in a separate map (rarely used, since a
+  // ! localized search usually touches only few blocks in the neighborhood of a node).
+  struct IncidentWeightDeltas {
+    PartitionID blocks[NUM_LOCAL_BLOCKS];
+    HyperedgeWeight deltas[NUM_LOCAL_BLOCKS];
+    uint32_t size;
+  };
 
   using HypernodeIterator = typename PartitionedGraph::HypernodeIterator;
   using HyperedgeIterator = typename PartitionedGraph::HyperedgeIterator;
@@ -60,6 +72,7 @@ class DeltaPartitionedGraph {
 
  public:
   static constexpr bool supports_connectivity_set = false;
+  static constexpr bool supports_sparse_gain_cache = true;
   static constexpr HyperedgeID HIGH_DEGREE_THRESHOLD = PartitionedGraph::HIGH_DEGREE_THRESHOLD;
 
   DeltaPartitionedGraph() :
@@ -67,17 +80,23 @@ class DeltaPartitionedGraph {
     _pg(nullptr),
     _part_weights_delta(0, 0),
     _part_ids_delta(),
-    _incident_weight_in_part_delta() {}
+    _incident_weight_in_part_delta(),
+    _overflowing_incident_weight_in_part_delta(),
+    _target_blocks() {}
 
   DeltaPartitionedGraph(const Context& context) :
     _k(context.partition.k),
     _pg(nullptr),
     _part_weights_delta(context.partition.k, 0),
     _part_ids_delta(),
-    _incident_weight_in_part_delta() {
+    _incident_weight_in_part_delta(),
+    _overflowing_incident_weight_in_part_delta(),
+    _target_blocks() {
       const bool top_level = context.type == ContextType::main;
       _part_ids_delta.initialize(MAP_SIZE_SMALL);
-      _incident_weight_in_part_delta.initialize(top_level ? MAP_SIZE_LARGE : MAP_SIZE_MOVE_DELTA);
+      // Each entry holds the deltas of several blocks of a node
+      _incident_weight_in_part_delta.initialize((top_level ? MAP_SIZE_LARGE : MAP_SIZE_MOVE_DELTA) / 2);
+      _overflowing_incident_weight_in_part_delta.initialize(MAP_SIZE_SMALL);
     }
 
   DeltaPartitionedGraph(const DeltaPartitionedGraph&) = delete;
@@ -118,6 +137,22 @@ class DeltaPartitionedGraph {
     return _pg->pins(e);
   }
 
+  // ! Calls f(e) for each incident net e of u and prefetches the partition
+  // ! information of the underlying partitioned graph
+  template<size_t distance = PREFETCH_DISTANCE, typename F>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void forEachIncidentEdgeWithPrefetching(const HypernodeID u, const F& f) const {
+    ASSERT(_pg);
+    _pg->template forEachIncidentEdgeWithPrefetching<distance>(u, f);
+  }
+
+  // ! Calls f(pin) for each pin of e and prefetches the blocks of the underlying
+  // ! partitioned graph
+  template<size_t distance = PREFETCH_DISTANCE, typename F>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void forEachPinWithPrefetching(const HyperedgeID e, const F& f) const {
+    ASSERT(_pg);
+    _pg->template forEachPinWithPrefetching<distance>(e, f);
+  }
+
   // ####################### Hypernode Information #######################
 
   HypernodeWeight nodeWeight(const HypernodeID u) const {
@@ -125,6 +160,11 @@ class DeltaPartitionedGraph {
     return _pg->nodeWeight(u);
   }
 
+  bool isFixed(const HypernodeID u) const {
+    ASSERT(_pg);
+    return _pg->isFixed(u);
+  }
+
   HyperedgeID nodeDegree(const HypernodeID u) const {
     ASSERT(_pg);
     return _pg->nodeDegree(u);
@@ -173,6 +213,9 @@ class DeltaPartitionedGraph {
       _part_ids_delta[u] = to;
       _part_weights_delta[to] += weight;
       _part_weights_delta[from] -= weight;
+      if ( std::find(_target_blocks.begin(), _target_blocks.end(), to) == _target_blocks.end() ) {
+        _target_blocks.push_back(to);
+      }
 
       for (const HyperedgeID edge : _pg->incidentEdges(u)) {
         const PartitionID target_part = partID(_pg->edgeTarget(edge));
@@ -221,10 +264,9 @@ class DeltaPartitionedGraph {
                        const PartitionID from, const HypernodeID /*pin_count_in_from_part_after*/,
                        const PartitionID to, const HypernodeID /*pin_count_in_to_part_after*/) {
     const HypernodeID target = _pg->edgeTarget(he);
-    const size_t index_in_from_part = incident_weight_index(target, from);
-    _incident_weight_in_part_delta[index_in_from_part] -= we;
-    const size_t index_in_to_part = incident_weight_index(target, to);
-    _incident_weight_in_part_delta[index_in_to_part] += we;
+    IncidentWeightDeltas& deltas_of_target = _incident_weight_in_part_delta[target];
+    addIncidentWeightDelta(deltas_of_target, target, from, -we);
+    addIncidentWeightDelta(deltas_of_target, target, to, we);
   }
 
   // ! Returns the block of hypernode u
@@ -260,21 +302,30 @@ class DeltaPartitionedGraph {
   HyperedgeWeight moveFromPenalty(const HypernodeID u) const {
     ASSERT(_pg);
     const PartitionID part_id = partID(u);
-    const HyperedgeWeight* incident_weight_delta_u =
-      _incident_weight_in_part_delta.get_if_contained(incident_weight_index(u, part_id));
-    const HyperedgeWeight incident_weight_u = _pg->incidentWeightInPart(u, part_id) +
-                                              (incident_weight_delta_u ? *incident_weight_delta_u : 0);
-    return incident_weight_u;
+    return _pg->incidentWeightInPart(u, part_id) + incidentWeightDelta(u, part_id);
   }
 
   HyperedgeWeight moveToBenefit(const HypernodeID u, const PartitionID p) const {
     ASSERT(_pg);
     ASSERT(p != kInvalidPartition && p < _k);
-    const HyperedgeWeight* incident_weight_delta_p =
-      _incident_weight_in_part_delta.get_if_contained(incident_weight_index(u, p));
-    const HyperedgeWeight incident_weight_p = _pg->incidentWeightInPart(u, p) +
-                                              (incident_weight_delta_p ? *incident_weight_delta_p : 0);
-    return incident_weight_p;
+    return _pg->incidentWeightInPart(u, p) + incidentWeightDelta(u, p);
+  }
+
+  // ! See PartitionedGraph::doForAllSparseBenefitTerms(...)
+  template<typename F>
+  bool doForAllSparseBenefitTerms(const HypernodeID u, const F& f) const {
+    ASSERT(_pg);
+    const bool success = _pg->doForAllSparseBenefitTerms(u,
+      [&](const PartitionID p, const HyperedgeWeight) {
+        f(p, moveToBenefit(u, p));
+      });
+    if ( success ) {
+      // Moves only increase incident weights in their target blocks
+      for ( const PartitionID p : _target_blocks ) {
+        f(p, moveToBenefit(u, p));
+      }
+    }
+    return success;
   }
 
   Gain km1Gain(const HypernodeID u, const PartitionID from, const PartitionID to) const {
@@ -288,6 +339,10 @@ class DeltaPartitionedGraph {
     _pg->initializeGainCacheEntry(u, benefit_aggregator);
   }
 
+  bool initializeGainCacheEntryIfInvalid(const HypernodeID u, vec<Gain>& benefit_aggregator) {
+    return _pg->initializeGainCacheEntryIfInvalid(u, benefit_aggregator);
+  }
+
   // ! Clears all deltas applied to the partitioned hypergraph
   void clear() {
     // O(k)
@@ -295,6 +350,8 @@ class DeltaPartitionedGraph {
     // Constant Time
     _part_ids_delta.clear();
     _incident_weight_in_part_delta.clear();
+    _overflowing_incident_weight_in_part_delta.clear();
+    _target_blocks.clear();
   }
 
   void dropMemory() {
@@ -302,12 +359,14 @@ class DeltaPartitionedGraph {
       _memory_dropped = true;
       _part_ids_delta.freeInternalData();
       _incident_weight_in_part_delta.freeInternalData();
+      _overflowing_incident_weight_in_part_delta.freeInternalData();
     }
   }
 
   size_t combinedMemoryConsumption() const {
     return _part_ids_delta.size_in_bytes()
-           + _incident_weight_in_part_delta.size_in_bytes();
+           + _incident_weight_in_part_delta.size_in_bytes()
+           + _overflowing_incident_weight_in_part_delta.size_in_bytes();
   }
 
   PartitionID k() const {
@@ -330,7 +389,8 @@ class DeltaPartitionedGraph {
     utils::MemoryTreeNode* part_ids_node = delta_pg_node->addChild("Delta Part IDs");
     part_ids_node->updateSize(_part_ids_delta.size_in_bytes());
     utils::MemoryTreeNode* _incident_weight_in_part_node = delta_pg_node->addChild("Delta Incident Weight In Part");
-    _incident_weight_in_part_node->updateSize(_incident_weight_in_part_delta.size_in_bytes());
+    _incident_weight_in_part_node->updateSize(_incident_weight_in_part_delta.size_in_bytes() +
+      _overflowing_incident_weight_in_part_delta.size_in_bytes());
   }
 
  private:
@@ -339,6 +399,44 @@ class DeltaPartitionedGraph {
     return size_t(u) * _k  + p;
   }
 
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
+  void addIncidentWeightDelta(IncidentWeightDeltas& deltas_of_u,
+                              const HypernodeID u,
+                              const PartitionID p,
+                              const HyperedgeWeight delta) {
+    for ( uint32_t i = 0; i < deltas_of_u.size; ++i ) {
+      if ( deltas_of_u.blocks[i] == p ) {
+        deltas_of_u.deltas[i] += delta;
+        return;
+      }
+    }
+    if ( deltas_of_u.size < NUM_LOCAL_BLOCKS ) {
+      deltas_of_u.blocks[deltas_of_u.size] = p;
+      deltas_of_u.deltas[deltas_of_u.size] = delta;
+      ++deltas_of_u.size;
+    } else {
+      _overflowing_incident_weight_in_part_delta[incident_weight_index(u, p)] += delta;
+    }
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
+  HyperedgeWeight incidentWeightDelta(const HypernodeID u, const PartitionID p) const {
+    const IncidentWeightDeltas* deltas_of_u = _incident_weight_in_part_delta.get_if_contained(u);
+    if ( deltas_of_u ) {
+      for ( uint32_t i = 0; i < deltas_of_u->size; ++i ) {
+        if ( deltas_of_u->blocks[i] == p ) {
+          return deltas_of_u->deltas[i];
+        }
+      }
+      if ( deltas_of_u->size == NUM_LOCAL_BLOCKS ) {
+        const HyperedgeWeight* delta =
+          _overflowing_incident_weight_in_part_delta.get_if_contained(incident_weight_index(u, p));
+        return delta ? *delta : 0;
+      }
+    }
+    return 0;
+  }
+
   bool _memory_dropped = false;
 
   // ! Number of blocks
@@ -353,9 +451,15 @@ class DeltaPartitionedGraph {
   // ! Stores for each locally moved node its new block id
   DynamicFlatMap<HypernodeID, PartitionID> _part_ids_delta;
 
-  // ! Stores the delta of each locally touched incident weight in part entry
-  // ! relative to the _incident_weight_in_part member in '_pg'
-  DynamicFlatMap<size_t, HyperedgeWeight> _incident_weight_in_part_delta;
+  // ! Stores for each locally touched node the deltas of its incident weight in part
+  // ! entries relative to the _incident_weight_in_part member in '_pg'
+  DynamicFlatMap<HypernodeID, IncidentWeightDeltas> _incident_weight_in_part_delta;
+
+  // ! Incident weight in part deltas of nodes that do not fit into IncidentWeightDeltas
+  DynamicFlatMap<size_t, HyperedgeWeight> _overflowing_incident_weight_in_part_delta;
+
+  // ! Target blocks of all local moves
+  vec<PartitionID> _target_blocks;
 };
 
 } // namespace ds
@@ -27,12 +27,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <type_traits>
+#include <utility>
 
 #include "kahypar/meta/mandatory.h"
 
 #include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/datastructures/prefetching.h"
 #include "mt-kahypar/datastructures/sparse_map.h"
 #include "mt-kahypar/parallel/stl/scalable_vector.h"
 #include "mt-kahypar/partition/context.h"
@@ -70,6 +73,7 @@ class DeltaPartitionedHypergraph {
 
  public:
   static constexpr bool supports_connectivity_set = false;
+  static constexpr bool supports_sparse_gain_cache = true;
   static constexpr HyperedgeID HIGH_DEGREE_THRESHOLD = PartitionedHypergraph::HIGH_DEGREE_THRESHOLD;
 
   DeltaPartitionedHypergraph() :
@@ -78,7 +82,9 @@ class DeltaPartitionedHypergraph {
     _part_weights_delta(0, 0),
     _part_ids_delta(),
     _pins_in_part_delta(),
-    _gain_cache_delta() {}
+    _gain_cache_delta(),
+    _gain_cache_updates(),
+    _target_blocks() {}
 
   DeltaPartitionedHypergraph(const Context& context) :
     _k(context.partition.k),
@@ -86,7 +92,9 @@ class DeltaPartitionedHypergraph {
     _part_weights_delta(context.partition.k, 0),
     _part_ids_delta(),
     _pins_in_part_delta(),
-    _gain_cache_delta() {
+    _gain_cache_delta(),
+    _gain_cache_updates(),
+    _target_blocks() {
       const bool top_level = context.type == ContextType::main;
       _part_ids_delta.initialize(MAP_SIZE_SMALL);
       _pins_in_part_delta.initialize(MAP_SIZE_LARGE);
@@ -131,6 +139,22 @@ class DeltaPartitionedHypergraph {
     return _phg->pins(e);
   }
 
+  // ! Calls f(e) for each incident net e of u and prefetches the partition
+  // ! information of the underlying partitioned hypergraph
+  template<size_t distance = PREFETCH_DISTANCE, typename F>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void forEachIncidentEdgeWithPrefetching(const HypernodeID u, const F& f) const {
+    ASSERT(_phg);
+    _phg->template forEachIncidentEdgeWithPrefetching<distance>(u, f);
+  }
+
+  // ! Calls f(pin) for each pin of e and prefetches the blocks of the underlying
+  // ! partitioned hypergraph
+  template<size_t distance = PREFETCH_DISTANCE, typename F>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void forEachPinWithPrefetching(const HyperedgeID e, const F& f) const {
+    ASSERT(_phg);
+    _phg->template forEachPinWithPrefetching<distance>(e, f);
+  }
+
   // ####################### Hypernode Information #######################
 
   HypernodeWeight nodeWeight(const HypernodeID u) const {
@@ -138,6 +162,11 @@ class DeltaPartitionedHypergraph {
     return _phg->nodeWeight(u);
   }
 
+  bool isFixed(const HypernodeID u) const {
+    ASSERT(_phg);
+    return _phg->isFixed(u);
+  }
+
   HyperedgeID nodeDegree(const HypernodeID u) const {
     ASSERT(_phg);
     return _phg->nodeDegree(u);
@@ -175,11 +204,15 @@ class DeltaPartitionedHypergraph {
       _part_ids_delta[u] = to;
       _part_weights_delta[to] += wu;
       _part_weights_delta[from] -= wu;
+      if ( std::find(_target_blocks.begin(), _target_blocks.end(), to) == _target_blocks.end() ) {
+        _target_blocks.push_back(to);
+      }
       for ( const HyperedgeID& he : _phg->incidentEdges(u) ) {
         const HypernodeID pin_count_in_from_part_after = decrementPinCountInPart(he, from);
         const HypernodeID pin_count_in_to_part_after = incrementPinCountInPart(he, to);
         delta_func(he, _phg->edgeWeight(he), _phg->edgeSize(he), pin_count_in_from_part_after, pin_count_in_to_part_after);
       }
+      applyGainCacheUpdates();
       return true;
     } else {
       return false;
@@ -205,6 +238,8 @@ class DeltaPartitionedHypergraph {
     return changeNodePart(u, from, to, max_weight_to, delta_gain_func);
   }
 
+  // ! Note that the gain cache updates are buffered and only applied
+  // ! at the end of changeNodePart(...) (see applyGainCacheUpdates()).
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
   void gainCacheUpdate(const HyperedgeID he, const HyperedgeWeight we,
                        const PartitionID from, const HypernodeID pin_count_in_from_part_after,
@@ -213,23 +248,23 @@ class DeltaPartitionedHypergraph {
     if (pin_count_in_from_part_after == 1) {
       for (HypernodeID u : pins(he)) {
         if (partID(u) == from) {
-          _gain_cache_delta[penalty_index(u)] -= we;
+          _gain_cache_updates.emplace_back(penalty_index(u), -we);
         }
       }
     } else if (pin_count_in_from_part_after == 0) {
       for (HypernodeID u : pins(he)) {
-        _gain_cache_delta[benefit_index(u, from)] -= we;
+        _gain_cache_updates.emplace_back(benefit_index(u, from), -we);
       }
     }
 
     if (pin_count_in_to_part_after == 1) {
       for (HypernodeID u : pins(he)) {
-        _gain_cache_delta[benefit_index(u, to)] += we;
+        _gain_cache_updates.emplace_back(benefit_index(u, to), we);
       }
     } else if (pin_count_in_to_part_after == 2) {
       for (HypernodeID u : pins(he)) {
         if (partID(u) == to) {
-          _gain_cache_delta[penalty_index(u)] += we;
+          _gain_cache_updates.emplace_back(penalty_index(u), we);
         }
       }
     }
@@ -264,6 +299,7 @@ class DeltaPartitionedHypergraph {
   // ! More formally, p(u) := w({ e \in I(u) | pin_count(e, partID(u)) > 1 })
   HyperedgeWeight moveFromPenalty(const HypernodeID u) const {
     ASSERT(_phg);
+    ASSERT(_gain_cache_updates.empty());
     const HyperedgeWeight* move_from_benefit_delta =
       _gain_cache_delta.get_if_contained(penalty_index(u));
     return _phg->moveFromPenalty(u) + ( move_from_benefit_delta ? *move_from_benefit_delta : 0 );
@@ -275,11 +311,32 @@ class DeltaPartitionedHypergraph {
   HyperedgeWeight moveToBenefit(const HypernodeID u, const PartitionID p) const {
     ASSERT(_phg);
     ASSERT(p != kInvalidPartition && p < _k);
+    ASSERT(_gain_cache_updates.empty());
     const HyperedgeWeight* move_to_penalty_delta =
       _gain_cache_delta.get_if_contained(benefit_index(u, p));
     return _phg->moveToBenefit(u, p) + ( move_to_penalty_delta ? *move_to_penalty_delta : 0 );
   }
 
+  // ! If the gain cache of the global partitioned hypergraph uses the sparse representation,
+  // ! f(p, b(u, p)) is called for each block p for which either the global partitioned hypergraph
+  // ! stores a benefit term of u or to which a node was moved locally. All other blocks have a
+  // ! benefit term of zero. Returns false, if this is not possible (see PartitionedHypergraph).
+  template<typename F>
+  bool doForAllSparseBenefitTerms(const HypernodeID u, const F& f) const {
+    ASSERT(_phg);
+    const bool success = _phg->doForAllSparseBenefitTerms(u,
+      [&](const PartitionID p, const HyperedgeWeight) {
+        f(p, moveToBenefit(u, p));
+      });
+    if ( success ) {
+      // Moves only increase benefit terms of their target blocks
+      for ( const PartitionID p : _target_blocks ) {
+        f(p, moveToBenefit(u, p));
+      }
+    }
+    return success;
+  }
+
   Gain km1Gain(const HypernodeID u, const PartitionID from, const PartitionID to) const {
     unused(from);
     ASSERT(from == partID(u), "While gain computation works for from != partID(u), such a query makes no sense");
@@ -291,6 +348,10 @@ class DeltaPartitionedHypergraph {
     _phg->initializeGainCacheEntry(u, benefit_aggregator);
   }
 
+  bool initializeGainCacheEntryIfInvalid(const HypernodeID u, vec<Gain>& benefit_aggregator) {
+    return _phg->initializeGainCacheEntryIfInvalid(u, benefit_aggregator);
+  }
+
   // ! Clears all deltas applied to the partitioned hypergraph
   void clear() {
     // O(k)
@@ -299,6 +360,8 @@ class DeltaPartitionedHypergraph {
     _part_ids_delta.clear();
     _pins_in_part_delta.clear();
     _gain_cache_delta.clear();
+    _gain_cache_updates.clear();
+    _target_blocks.clear();
   }
 
   void dropMemory() {
@@ -307,12 +370,14 @@ class DeltaPartitionedHypergraph {
       _part_ids_delta.freeInternalData();
       _pins_in_part_delta.freeInternalData();
       _gain_cache_delta.freeInternalData();
+      parallel::free(_gain_cache_updates);
     }
   }
 
   size_t combinedMemoryConsumption() const {
     return _pins_in_part_delta.size_in_bytes()
            + _gain_cache_delta.size_in_bytes()
+           + _gain_cache_updates.capacity() * sizeof(GainCacheUpdate)
            + _part_ids_delta.size_in_bytes();
   }
 
@@ -338,10 +403,40 @@ class DeltaPartitionedHypergraph {
     utils::MemoryTreeNode* pins_in_part_node = delta_phg_node->addChild("Delta Pins In Part");
     pins_in_part_node->updateSize(_pins_in_part_delta.size_in_bytes());
     utils::MemoryTreeNode* gain_cache_delta_node = delta_phg_node->addChild("Delta Gain Cache");
-    gain_cache_delta_node->updateSize(_gain_cache_delta.size_in_bytes());
+    gain_cache_delta_node->updateSize(_gain_cache_delta.size_in_bytes() +
+      _gain_cache_updates.capacity() * sizeof(GainCacheUpdate));
   }
 
  private:
+  // ! Buffered gain cache update (index of the gain cache entry, delta)
+  using GainCacheUpdate = std::pair<size_t, HyperedgeWeight>;
+
+  // ! Applies all gain cache updates buffered during the last move. A move typically
+  // ! updates the same gain cache entry several times (e.g., if a neighbor shares several
+  // ! nets with the moved node or a net becomes a cut net in both blocks). We therefore sort the
+  // ! updates by their index and aggregate them such that each touched gain cache entry is looked
+  // ! up only once in the hash table. Entries with an aggregated delta of zero are skipped.
+  void applyGainCacheUpdates() {
+    if ( _gain_cache_updates.empty() ) {
+      return;
+    }
+    std::sort(_gain_cache_updates.begin(), _gain_cache_updates.end(),
+      [](const GainCacheUpdate& lhs, const GainCacheUpdate& rhs) {
+        return lhs.first < rhs.first;
+      });
+    size_t i = 0;
+    while ( i < _gain_cache_updates.size() ) {
+      const size_t index = _gain_cache_updates[i].first;
+      HyperedgeWeight delta = 0;
+      for ( ; i < _gain_cache_updates.size() && _gain_cache_updates[i].first == index; ++i ) {
+        delta += _gain_cache_updates[i].second;
+      }
+      if ( delta != 0 ) {
+        _gain_cache_delta[index] += delta;
+      }
+    }
+    _gain_cache_updates.clear();
+  }
 
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
   size_t penalty_index(const HypernodeID u) const {
@@ -386,6 +481,12 @@ class DeltaPartitionedHypergraph {
   // ! Stores the delta of each locally touched gain cache entry
   // ! relative to the gain cache in '_phg'
   DynamicFlatMap<size_t, HyperedgeWeight> _gain_cache_delta;
+
+  // ! Gain cache updates of the current move that are not yet applied to '_gain_cache_delta'
+  vec<GainCacheUpdate> _gain_cache_updates;
+
+  // ! Target blocks of all local moves
+  vec<PartitionID> _target_blocks;
 };
 
 } // namespace ds
@@ -159,10 +159,6 @@ void DynamicAdjacencyArray::construct(const EdgeVector& edge_vector, const Hyper
     _header_array.resize(_num_nodes + 1);
   }, [&] {
     _edges.resize(2 * num_edges);
-  }, [&] {
-    _removable_edges.setSize(2 * num_edges);
-  }, [&] {
-    _edge_mapping.resize(2 * num_edges);
   }, [&] {
     node_degrees.resize(_num_nodes);
   }, [&] {
@@ -315,6 +311,7 @@ void DynamicAdjacencyArray::uncontract(const HypernodeID u,
 parallel::scalable_vector<DynamicAdjacencyArray::RemovedEdge> DynamicAdjacencyArray::removeSinglePinAndParallelEdges() {
   // TODO(maas): special case for high degree nodes?
   StreamingVector<RemovedEdge> tmp_removed_edges;
+  allocateAuxiliaryDataIfNecessary();
   _removable_edges.reset();
   initializeEdgeMapping(_edge_mapping);
 
@@ -407,6 +404,7 @@ parallel::scalable_vector<DynamicAdjacencyArray::RemovedEdge> DynamicAdjacencyAr
 
 void DynamicAdjacencyArray::restoreSinglePinAndParallelEdges(
       const parallel::scalable_vector<DynamicAdjacencyArray::RemovedEdge>& edges_to_restore) {
+  allocateAuxiliaryDataIfNecessary();
   _removable_edges.reset();
   initializeEdgeMapping(_edge_mapping);
 
@@ -481,6 +479,7 @@ void DynamicAdjacencyArray::reset() {
 
 void DynamicAdjacencyArray::sortIncidentEdges() {
   // this is a bit complicated because we need to update the back edges
+  allocateAuxiliaryDataIfNecessary();
   Array<HyperedgeID> edge_permutation;
   edge_permutation.resize(_edges.size());
   initializeEdgeMapping(edge_permutation);
@@ -525,10 +524,6 @@ DynamicAdjacencyArray DynamicAdjacencyArray::copy(parallel_tag_t) const {
   }, [&] {
     adjacency_array._edges.resize(_edges.size());
     memcpy(adjacency_array._edges.data(), _edges.data(), sizeof(Edge) * _edges.size());
-  },[&] {
-    adjacency_array._removable_edges.setSize(_edges.size());
-  }, [&] {
-    adjacency_array._edge_mapping.resize(_edge_mapping.size());
   });
 
   return adjacency_array;
@@ -543,8 +538,6 @@ DynamicAdjacencyArray DynamicAdjacencyArray::copy() const {
     sizeof(Header) * _header_array.size());
   adjacency_array._edges.resize(_edges.size());
   memcpy(adjacency_array._edges.data(), _edges.data(), sizeof(Edge) * _edges.size());
-  adjacency_array._removable_edges.setSize(_edges.size());
-  adjacency_array._edge_mapping.resize(_edge_mapping.size());
   return adjacency_array;
 }
 
@@ -37,6 +37,7 @@
 #include "mt-kahypar/datastructures/hypergraph_common.h"
 #include "mt-kahypar/datastructures/streaming_vector.h"
 #include "mt-kahypar/datastructures/array.h"
+#include "mt-kahypar/datastructures/atomic_bit_vector.h"
 #include "mt-kahypar/parallel/stl/scalable_vector.h"
 #include "mt-kahypar/parallel/stl/scalable_unique_ptr.h"
 #include "mt-kahypar/parallel/atomic_wrapper.h"
@@ -389,6 +390,7 @@ class DynamicAdjacencyArray {
   size_t size_in_bytes() const {
     return _edges.size() * sizeof(Edge)
       + _edge_mapping.size() * sizeof(HyperedgeID)
+      + _removable_edges.size_in_bytes()
       + _header_array.size() * sizeof(Header);
   }
 
@@ -483,6 +485,20 @@ class DynamicAdjacencyArray {
       HeaderIterator(u, this, true));
   }
 
+  // ! The auxiliary arrays for removing and restoring edges are only allocated
+  // ! on first use (e.g., copies of the graph that are never coarsened do not need them)
+  void allocateAuxiliaryDataIfNecessary() {
+    if ( _edge_mapping.size() != _edges.size() ) {
+      tbb::parallel_invoke([&] {
+        _removable_edges.freeInternalData();
+        _removable_edges.setSize(_edges.size());
+      }, [&] {
+        parallel::free(_edge_mapping);
+        _edge_mapping.resize(_edges.size());
+      });
+    }
+  }
+
   void initializeEdgeMapping(Array<HyperedgeID>& mapping) {
     ASSERT(mapping.size() == _edges.size());
     tbb::parallel_for(ID(0), ID(mapping.size()), [&](const HyperedgeID e) {
@@ -521,7 +537,8 @@ class DynamicAdjacencyArray {
   Array<Edge> _edges;
   // data used during parallel edge removal
   ThreadLocalParallelEdgeVector _thread_local_vec;
-  kahypar::ds::FastResetFlagArray<> _removable_edges;
+  // ! One bit per edge (concurrently modified)
+  AtomicBitVector _removable_edges;
   Array<HyperedgeID> _edge_mapping;
 };
 
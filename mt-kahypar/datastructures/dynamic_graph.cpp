@@ -110,6 +110,37 @@ size_t DynamicGraph::contract(const HypernodeID v,
   return num_contractions;
 }
 
+/**!
+ * Contracts a matching of vertex pairs in parallel. For each memento (u,v),
+ * v is contracted onto representative u. Since the vertices of the matching are
+ * pairwise disjoint, no other contraction modifies the contraction tree entries,
+ * weights or adjacency lists of u and v concurrently. Therefore, we can skip
+ * the registration step and all vertex locks.
+ */
+size_t DynamicGraph::contractMatching(const Batch& matching,
+                                      const HypernodeWeight max_node_weight) {
+  const HypernodeID contraction_start = _contraction_index.load();
+  tbb::enumerable_thread_specific<size_t> num_contractions(0);
+  tbb::parallel_for(UL(0), matching.size(), [&](const size_t i) {
+    const HypernodeID u = matching[i].u;
+    const HypernodeID v = matching[i].v;
+    ASSERT(u != v);
+    ASSERT(nodeIsEnabled(u) && nodeIsEnabled(v));
+    ASSERT(_contraction_tree.parent(u) == u && _contraction_tree.parent(v) == v);
+    ASSERT(_contraction_tree.pendingContractions(v) == 0);
+    if ( nodeWeight(u) + nodeWeight(v) <= max_node_weight ) {
+      _contraction_tree.registerContraction(u, v, _version);
+      hypernode(u).setWeight(nodeWeight(u) + nodeWeight(v));
+      hypernode(v).disable();
+      _adjacency_array.contract(u, v);
+      const HypernodeID contraction_end = ++_contraction_index;
+      _contraction_tree.unregisterContraction(u, v, contraction_start, contraction_end);
+      ++num_contractions.local();
+    }
+  });
+  return num_contractions.combine(std::plus<size_t>());
+}
+
 /**!
  * Contracts a previously registered contraction. The contraction of u and v is
  * performed if there are no pending contractions in the subtree of v and the
@@ -404,12 +404,12 @@ class DynamicGraph {
   }
 
   // ! Initial number of pins
-  HypernodeID initialNumPins() const {
+  size_t initialNumPins() const {
     return _num_edges;
   }
 
   // ! Initial sum of the degree of all vertices
-  HypernodeID initialTotalVertexDegree() const {
+  size_t initialTotalVertexDegree() const {
     return _num_edges;
   }
 
@@ -611,6 +611,24 @@ class DynamicGraph {
     return hypernode(u).setCommunityID(community_id);
   }
 
+  // ####################### Fixed Vertex Support #######################
+
+  bool hasFixedVertices() const {
+    return false;
+  }
+
+  bool isFixed(const HypernodeID) const {
+    return false;
+  }
+
+  PartitionID fixedVertexBlock(const HypernodeID) const {
+    return kInvalidPartition;
+  }
+
+  void fixToBlock(const HypernodeID, const PartitionID) {
+    ERR("Fixed vertices are not supported in dynamic graph");
+  }
+
   // ! Reset internal community information
   void setCommunityIDs(const parallel::scalable_vector<PartitionID>& community_ids) {
     ASSERT(community_ids.size() == UI64(numNodes()));
@@ -621,7 +639,7 @@ class DynamicGraph {
 
   // ####################### Contract / Uncontract #######################
 
-  DynamicGraph contract(parallel::scalable_vector<HypernodeID>&) {
+  DynamicGraph contract(parallel::scalable_vector<HypernodeID>&, const bool = false) {
     ERR("contract(c, id) is not supported in dynamic graph");
     return DynamicGraph();
   }
@@ -646,6 +664,18 @@ class DynamicGraph {
   size_t contract(const HypernodeID v,
                   const HypernodeWeight max_node_weight = std::numeric_limits<HypernodeWeight>::max());
 
+  /**!
+   * Contracts a matching of vertex pairs in parallel. For each memento (u,v),
+   * v is contracted onto representative u. The vertices of the matching must be
+   * pairwise disjoint, enabled and must not have pending contractions. Thus,
+   * the contractions do not have to be registered in the contraction tree
+   * beforehand and no vertex locks are required. Contractions that would
+   * violate the maximum allowed node weight are skipped.
+   * Returns the number of performed contractions.
+   */
+  size_t contractMatching(const Batch& matching,
+                          const HypernodeWeight max_node_weight = std::numeric_limits<HypernodeWeight>::max());
+
   /**
    * Uncontracts a batch of contractions in parallel. The batches must be uncontracted exactly
    * in the order computed by the function createBatchUncontractionHierarchy(...).
@@ -744,6 +774,17 @@ class DynamicGraph {
   // ! Copy dynamic hypergraph sequential
   DynamicGraph copy() const;
 
+  // ! Contractions modify a dynamic hypergraph in place.
+  // ! Therefore, it can not share its structure with a copy.
+  DynamicGraph sharedCopy() const {
+    return copy(parallel_tag_t());
+  }
+
+  // ! See sharedCopy()
+  DynamicGraph copyOnWrite(parallel_tag_t) {
+    return copy(parallel_tag_t());
+  }
+
   // ! Reset internal data structure
   void reset() {
     _contraction_tree.reset();
@@ -58,6 +58,46 @@ DynamicGraph DynamicGraphFactory::construct(
     edge_weight, node_weight, stable_construction_of_incident_edges);
 }
 
+template<typename NodeIndex>
+DynamicGraph DynamicGraphFactory::construct_from_csr(
+        const HypernodeID num_nodes,
+        const size_t* xadj,
+        const NodeIndex* adjncy,
+        const HyperedgeWeight* adjwgt,
+        const HypernodeWeight* node_weight) {
+  // The dynamic graph stores each edge in a separate data structure. Thus,
+  // we extract the edges {u,v} with u < v from the adjacency arrays.
+  Counter num_forward_edges(num_nodes, 0);
+  tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID u) {
+    for ( size_t pos = xadj[u]; pos < xadj[u + 1]; ++pos ) {
+      num_forward_edges[u] += u < adjncy[pos];
+    }
+  });
+  parallel::TBBPrefixSum<size_t> forward_edge_prefix_sum(num_forward_edges);
+  tbb::parallel_scan(tbb::blocked_range<size_t>( UL(0), UI64(num_nodes)), forward_edge_prefix_sum);
+  const HyperedgeID num_edges = forward_edge_prefix_sum.total_sum();
+  if ( 2 * num_edges != xadj[num_nodes] ) {
+    ERR("Adjacency arrays are not symmetric.");
+  }
+
+  EdgeVector edges(num_edges);
+  parallel::scalable_vector<HyperedgeWeight> edge_weight(adjwgt ? num_edges : 0);
+  tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID u) {
+    size_t e = forward_edge_prefix_sum[u];
+    for ( size_t pos = xadj[u]; pos < xadj[u + 1]; ++pos ) {
+      if ( u < adjncy[pos] ) {
+        edges[e] = { u, static_cast<HypernodeID>(adjncy[pos]) };
+        if ( adjwgt ) {
+          edge_weight[e] = adjwgt[pos];
+        }
+        ++e;
+      }
+    }
+  });
+  return construct_from_graph_edges(num_nodes, num_edges, edges,
+    adjwgt ? edge_weight.data() : nullptr, node_weight, true);
+}
+
 DynamicGraph DynamicGraphFactory::construct_from_graph_edges(
         const HypernodeID num_nodes,
         const HyperedgeID num_edges,
@@ -172,4 +212,9 @@ std::pair<DynamicGraph, parallel::scalable_vector<HypernodeID> > DynamicGraphFac
   return std::make_pair(std::move(compactified_graph), std::move(hn_mapping));
 }
 
+template DynamicGraph DynamicGraphFactory::construct_from_csr(
+  const HypernodeID, const size_t*, const uint32_t*, const HyperedgeWeight*, const HypernodeWeight*);
+template DynamicGraph DynamicGraphFactory::construct_from_csr(
+  const HypernodeID, const size_t*, const uint64_t*, const HyperedgeWeight*, const HypernodeWeight*);
+
 }
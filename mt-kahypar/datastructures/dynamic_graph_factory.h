@@ -62,6 +62,17 @@ class DynamicGraphFactory {
                                                 const HypernodeWeight* node_weight = nullptr,
                                                 const bool stable_construction_of_incident_edges = false);
 
+  // ! Constructs the graph from its adjacency arrays in CSR format (as used by
+  // ! Metis). Each undirected edge occurs in the adjacency arrays of both of its
+  // ! endpoints, but is only inserted once (from its endpoint with the smaller ID).
+  // ! The adjacency arrays can either use 32-bit or 64-bit node IDs.
+  template<typename NodeIndex>
+  static DynamicGraph construct_from_csr(const HypernodeID num_nodes,
+                                         const size_t* xadj,
+                                         const NodeIndex* adjncy,
+                                         const HyperedgeWeight* adjwgt = nullptr,
+                                         const HypernodeWeight* node_weight = nullptr);
+
   static std::pair<DynamicGraph, parallel::scalable_vector<HypernodeID> > compactify(const DynamicGraph&);
 
  private:
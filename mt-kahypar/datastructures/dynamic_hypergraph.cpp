@@ -110,6 +110,38 @@ size_t DynamicHypergraph::contract(const HypernodeID v,
 }
 
 
+/**!
+ * Contracts a matching of vertex pairs in parallel. For each memento (u,v),
+ * v is contracted onto representative u. Since the vertices of the matching are
+ * pairwise disjoint, no other contraction modifies the contraction tree entries,
+ * weights or incident net lists of u and v concurrently. Therefore, we can skip
+ * the registration step and all vertex locks. Only hyperedges shared between
+ * several contractions of the matching are still protected by their ownership flag.
+ */
+size_t DynamicHypergraph::contractMatching(const Batch& matching,
+                                           const HypernodeWeight max_node_weight) {
+  const HypernodeID contraction_start = _contraction_index.load();
+  tbb::enumerable_thread_specific<size_t> num_contractions(0);
+  tbb::parallel_for(UL(0), matching.size(), [&](const size_t i) {
+    const HypernodeID u = matching[i].u;
+    const HypernodeID v = matching[i].v;
+    ASSERT(u != v);
+    ASSERT(nodeIsEnabled(u) && nodeIsEnabled(v));
+    ASSERT(_contraction_tree.parent(u) == u && _contraction_tree.parent(v) == v);
+    ASSERT(_contraction_tree.pendingContractions(v) == 0);
+    if ( nodeWeight(u) + nodeWeight(v) <= max_node_weight ) {
+      _contraction_tree.registerContraction(u, v, _version);
+      hypernode(u).setWeight(nodeWeight(u) + nodeWeight(v));
+      hypernode(v).disable();
+      contractPinsAndIncidentNets(u, v, NOOP_LOCK_FUNC, NOOP_LOCK_FUNC);
+      const HypernodeID contraction_end = ++_contraction_index;
+      _contraction_tree.unregisterContraction(u, v, contraction_start, contraction_end);
+      ++num_contractions.local();
+    }
+  });
+  return num_contractions.combine(std::plus<size_t>());
+}
+
 /**
  * Uncontracts a batch of contractions in parallel. The batches must be uncontracted exactly
  * in the order computed by the function createBatchUncontractionHierarchy(...).
@@ -257,7 +289,7 @@ parallel::scalable_vector<DynamicHypergraph::ParallelHyperedge> DynamicHypergrap
   // insert all other hyperedges into a bucket data structure such that
   // hyperedges with the same hash/footprint are placed in the same bucket.
   StreamingVector<ParallelHyperedge> tmp_removed_hyperedges;
-  ConcurrentBucketMap<ContractedHyperedgeInformation> hyperedge_hash_map;
+  LockFreeBucketMap<ContractedHyperedgeInformation> hyperedge_hash_map;
   hyperedge_hash_map.reserve_for_estimated_number_of_insertions(_num_hyperedges);
   doParallelForAllEdges([&](const HyperedgeID& he) {
     const HypernodeID edge_size = edgeSize(he);
@@ -303,8 +335,9 @@ parallel::scalable_vector<DynamicHypergraph::ParallelHyperedge> DynamicHypergrap
   // after its hash. A bucket is processed by one thread and parallel
   // hyperedges are detected by comparing the pins of hyperedges with
   // the same hash.
+  hyperedge_hash_map.finalize();
   tbb::parallel_for(UL(0), hyperedge_hash_map.numBuckets(), [&](const size_t bucket) {
-    auto& hyperedge_bucket = hyperedge_hash_map.getBucket(bucket);
+    auto hyperedge_bucket = hyperedge_hash_map.getBucket(bucket);
     std::sort(hyperedge_bucket.begin(), hyperedge_bucket.end(),
       [&](const ContractedHyperedgeInformation& lhs, const ContractedHyperedgeInformation& rhs) {
         return lhs.hash < rhs.hash || (lhs.hash == rhs.hash && lhs.size < rhs.size)||
@@ -338,8 +371,8 @@ parallel::scalable_vector<DynamicHypergraph::ParallelHyperedge> DynamicHypergrap
         hyperedge(lhs_he).setWeight(lhs_weight);
       }
     }
-    hyperedge_hash_map.free(bucket);
   });
+  hyperedge_hash_map.free();
 
   // Remove single-pin and parallel nets from incident net vector of vertices
   doParallelForAllNodes([&](const HypernodeID& u) {
@@ -574,36 +607,12 @@ DynamicHypergraph::ContractionResult DynamicHypergraph::contract(const Hypernode
     releaseHypernode(v);
 
     HypernodeID contraction_start = _contraction_index.load();
-    kahypar::ds::FastResetFlagArray<>& shared_incident_nets_u_and_v = _he_bitset.local();
-    shared_incident_nets_u_and_v.reset();
-    parallel::scalable_vector<HyperedgeID>& failed_hyperedge_contractions = _failed_hyperedge_contractions.local();
-    for ( const HyperedgeID& he : incidentEdges(v) ) {
-      // Try to acquire ownership of hyperedge. In case of success, we perform the
-      // contraction and otherwise, we remember the hyperedge and try later again.
-      if ( tryAcquireHyperedge(he) ) {
-        contractHyperedge(u, v, he, shared_incident_nets_u_and_v);
-        releaseHyperedge(he);
-      } else {
-        failed_hyperedge_contractions.push_back(he);
-      }
-    }
-
-    // Perform contraction on which we failed to acquire ownership on the first try
-    for ( const HyperedgeID& he : failed_hyperedge_contractions ) {
-      acquireHyperedge(he);
-      contractHyperedge(u, v, he, shared_incident_nets_u_and_v);
-      releaseHyperedge(he);
-    }
-
-    // Contract incident net lists of u and v
-    _incident_nets.contract(u, v, shared_incident_nets_u_and_v,
+    contractPinsAndIncidentNets(u, v,
       [&](const HypernodeID u) {
         acquireHypernode(u);
       }, [&](const HypernodeID u) {
         releaseHypernode(u);
       });
-    shared_incident_nets_u_and_v.reset();
-    failed_hyperedge_contractions.clear();
 
     HypernodeID contraction_end = ++_contraction_index;
     acquireHypernode(u);
@@ -624,6 +633,39 @@ DynamicHypergraph::ContractionResult DynamicHypergraph::contract(const Hypernode
   }
 }
 
+// ! Replaces v with u in all hyperedges incident to v and merges the
+// ! incident net lists of u and v
+void DynamicHypergraph::contractPinsAndIncidentNets(const HypernodeID u,
+                                                    const HypernodeID v,
+                                                    const LockFunction& acquire_lock,
+                                                    const LockFunction& release_lock) {
+  kahypar::ds::FastResetFlagArray<>& shared_incident_nets_u_and_v = _he_bitset.local();
+  shared_incident_nets_u_and_v.reset();
+  parallel::scalable_vector<HyperedgeID>& failed_hyperedge_contractions = _failed_hyperedge_contractions.local();
+  for ( const HyperedgeID& he : incidentEdges(v) ) {
+    // Try to acquire ownership of hyperedge. In case of success, we perform the
+    // contraction and otherwise, we remember the hyperedge and try later again.
+    if ( tryAcquireHyperedge(he) ) {
+      contractHyperedge(u, v, he, shared_incident_nets_u_and_v);
+      releaseHyperedge(he);
+    } else {
+      failed_hyperedge_contractions.push_back(he);
+    }
+  }
+
+  // Perform contraction on which we failed to acquire ownership on the first try
+  for ( const HyperedgeID& he : failed_hyperedge_contractions ) {
+    acquireHyperedge(he);
+    contractHyperedge(u, v, he, shared_incident_nets_u_and_v);
+    releaseHyperedge(he);
+  }
+
+  // Contract incident net lists of u and v
+  _incident_nets.contract(u, v, shared_incident_nets_u_and_v, acquire_lock, release_lock);
+  shared_incident_nets_u_and_v.reset();
+  failed_hyperedge_contractions.clear();
+}
+
 // ! Performs the contraction of (u,v) inside hyperedge he
 void DynamicHypergraph::contractHyperedge(const HypernodeID u,
                                           const HypernodeID v,
@@ -380,6 +380,7 @@ class DynamicHypergraph {
   using ThreadLocalHyperedgeVector = tbb::enumerable_thread_specific<parallel::scalable_vector<HyperedgeID>>;
   using ThreadLocalBitset = tbb::enumerable_thread_specific<kahypar::ds::FastResetFlagArray<>>;
   using ThreadLocalBitvector = tbb::enumerable_thread_specific<parallel::scalable_vector<bool>>;
+  using LockFunction = std::function<void (const HypernodeID)>;
 
  public:
   static constexpr bool is_graph = false;
@@ -516,12 +517,12 @@ class DynamicHypergraph {
   }
 
   // ! Initial number of pins
-  HypernodeID initialNumPins() const {
+  size_t initialNumPins() const {
     return _num_pins;
   }
 
   // ! Initial sum of the degree of all vertices
-  HypernodeID initialTotalVertexDegree() const {
+  size_t initialTotalVertexDegree() const {
     return _total_degree;
   }
 
@@ -720,9 +721,27 @@ class DynamicHypergraph {
     return hypernode(u).setCommunityID(community_id);
   }
 
+  // ####################### Fixed Vertex Support #######################
+
+  bool hasFixedVertices() const {
+    return false;
+  }
+
+  bool isFixed(const HypernodeID) const {
+    return false;
+  }
+
+  PartitionID fixedVertexBlock(const HypernodeID) const {
+    return kInvalidPartition;
+  }
+
+  void fixToBlock(const HypernodeID, const PartitionID) {
+    ERR("Fixed vertices are not supported in dynamic hypergraph");
+  }
+
   // ####################### Contract / Uncontract #######################
 
-  DynamicHypergraph contract(parallel::scalable_vector<HypernodeID>&) {
+  DynamicHypergraph contract(parallel::scalable_vector<HypernodeID>&, const bool = false) {
     ERR("contract(c, id) is not supported in dynamic hypergraph");
     return DynamicHypergraph();
   }
@@ -747,6 +766,18 @@ class DynamicHypergraph {
   size_t contract(const HypernodeID v,
                   const HypernodeWeight max_node_weight = std::numeric_limits<HypernodeWeight>::max());
 
+  /**!
+   * Contracts a matching of vertex pairs in parallel. For each memento (u,v),
+   * v is contracted onto representative u. The vertices of the matching must be
+   * pairwise disjoint, enabled and must not have pending contractions. Thus,
+   * the contractions do not have to be registered in the contraction tree
+   * beforehand and no vertex locks are required. Contractions that would
+   * violate the maximum allowed node weight are skipped.
+   * Returns the number of performed contractions.
+   */
+  size_t contractMatching(const Batch& matching,
+                          const HypernodeWeight max_node_weight = std::numeric_limits<HypernodeWeight>::max());
+
   /**
    * Uncontracts a batch of contractions in parallel. The batches must be uncontracted exactly
    * in the order computed by the function createBatchUncontractionHierarchy(...).
@@ -884,6 +915,17 @@ class DynamicHypergraph {
   // ! Copy dynamic hypergraph sequential
   DynamicHypergraph copy() const;
 
+  // ! Contractions modify a dynamic hypergraph in place.
+  // ! Therefore, it can not share its structure with a copy.
+  DynamicHypergraph sharedCopy() const {
+    return copy(parallel_tag_t());
+  }
+
+  // ! See sharedCopy()
+  DynamicHypergraph copyOnWrite(parallel_tag_t) {
+    return copy(parallel_tag_t());
+  }
+
   // ! Reset internal data structure
   void reset() {
     _contraction_tree.reset();
@@ -1006,6 +1048,13 @@ class DynamicHypergraph {
                              const HypernodeID v,
                              const HypernodeWeight max_node_weight);
 
+  // ! Replaces v with u in all hyperedges incident to v and merges the
+  // ! incident net lists of u and v
+  void contractPinsAndIncidentNets(const HypernodeID u,
+                                   const HypernodeID v,
+                                   const LockFunction& acquire_lock,
+                                   const LockFunction& release_lock);
+
   // ! Performs the contraction of (u,v) inside hyperedge he
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void contractHyperedge(const HypernodeID u, const HypernodeID v, const HyperedgeID he,
                                                             kahypar::ds::FastResetFlagArray<>& shared_incident_nets_u_and_v);
@@ -1066,9 +1115,9 @@ class DynamicHypergraph {
   // ! Maximum size of a hyperedge
   HypernodeID _max_edge_size;
   // ! Number of pins
-  HypernodeID _num_pins;
+  size_t _num_pins;
   // ! Total degree of all vertices
-  HypernodeID _total_degree;
+  size_t _total_degree;
   // ! Total weight of hypergraph
   HypernodeWeight _total_weight;
   // ! Version of the hypergraph, each time we remove a single-pin and parallel nets,
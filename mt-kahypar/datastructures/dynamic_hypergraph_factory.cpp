@@ -141,6 +141,28 @@ DynamicHypergraph DynamicHypergraphFactory::construct(
   return hypergraph;
 }
 
+DynamicHypergraph DynamicHypergraphFactory::construct_from_incidence_array(
+        const HypernodeID num_hypernodes,
+        const HyperedgeID num_hyperedges,
+        const parallel::scalable_vector<size_t>& pin_offsets,
+        Array<HypernodeID>&& incidence_array,
+        const HyperedgeWeight* hyperedge_weight,
+        const HypernodeWeight* hypernode_weight,
+        const bool stable_construction_of_incident_edges) {
+  ASSERT(pin_offsets.size() == num_hyperedges + 1);
+  ASSERT(pin_offsets.back() == incidence_array.size());
+  // The dynamic hypergraph stores additional data per pin,
+  // so we simply convert the incidence array to an edge vector.
+  HyperedgeVector edge_vector(num_hyperedges);
+  tbb::parallel_for(ID(0), num_hyperedges, [&](const HyperedgeID he) {
+    edge_vector[he].assign(incidence_array.data() + pin_offsets[he],
+                           incidence_array.data() + pin_offsets[he + 1]);
+  });
+  parallel::free(incidence_array);
+  return construct(num_hypernodes, num_hyperedges, edge_vector,
+    hyperedge_weight, hypernode_weight, stable_construction_of_incident_edges);
+}
+
 /**
  * Compactifies a given hypergraph such that it only contains enabled vertices and hyperedges within
  * a consecutive range of IDs.
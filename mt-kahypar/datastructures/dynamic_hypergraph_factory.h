@@ -55,6 +55,17 @@ class DynamicHypergraphFactory {
                                     const HypernodeWeight* hypernode_weight = nullptr,
                                     const bool stable_construction_of_incident_edges = false);
 
+  // ! Constructs a hypergraph from an incidence array that contains the pins of all
+  // ! hyperedges, where the pins of hyperedge e are stored in the range
+  // ! [pin_offsets[e], pin_offsets[e + 1]) (same interface as the static hypergraph factory).
+  static DynamicHypergraph construct_from_incidence_array(const HypernodeID num_hypernodes,
+                                                          const HyperedgeID num_hyperedges,
+                                                          const parallel::scalable_vector<size_t>& pin_offsets,
+                                                          Array<HypernodeID>&& incidence_array,
+                                                          const HyperedgeWeight* hyperedge_weight = nullptr,
+                                                          const HypernodeWeight* hypernode_weight = nullptr,
+                                                          const bool stable_construction_of_incident_edges = false);
+
   /**
    * Compactifies a given hypergraph such that it only contains enabled vertices and hyperedges within
    * a consecutive range of IDs.
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+
+namespace mt_kahypar {
+namespace ds {
+
+/*!
+ * Stores the block to which a vertex is fixed (kInvalidPartition, if the
+ * vertex is not fixed). The block array is only allocated if at least one
+ * vertex is fixed. Thus, hypergraphs without fixed vertices pay one
+ * (well-predictable) branch per query and no memory.
+ *
+ * During coarsening, vertices fixed to different blocks are never contracted.
+ * A coarse vertex is fixed to a block, if one of its fine vertices is fixed
+ * to that block.
+ */
+class FixedVertexSupport {
+
+ public:
+  FixedVertexSupport() :
+    _fixed_vertex_block(),
+    _fixed_vertices() { }
+
+  bool hasFixedVertices() const {
+    return !_fixed_vertices.empty();
+  }
+
+  HypernodeID numFixedVertices() const {
+    return _fixed_vertices.size();
+  }
+
+  // ! Fixed vertices in the order in which they were fixed
+  const vec<HypernodeID>& fixedVertices() const {
+    return _fixed_vertices;
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool isFixed(const HypernodeID hn) const {
+    return hasFixedVertices() && _fixed_vertex_block[hn] != kInvalidPartition;
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE PartitionID fixedVertexBlock(const HypernodeID hn) const {
+    return hasFixedVertices() ? _fixed_vertex_block[hn] : kInvalidPartition;
+  }
+
+  // ! Note, this function is not thread-safe
+  void fixToBlock(const HypernodeID hn,
+                  const PartitionID block,
+                  const HypernodeID num_nodes) {
+    ASSERT(hn < num_nodes && block != kInvalidPartition);
+    if ( _fixed_vertex_block.empty() ) {
+      _fixed_vertex_block.assign(num_nodes, kInvalidPartition);
+    }
+    if ( _fixed_vertex_block[hn] == kInvalidPartition ) {
+      _fixed_vertices.push_back(hn);
+    } else if ( _fixed_vertex_block[hn] != block ) {
+      ERR("Vertex" << hn << "is fixed to block" << _fixed_vertex_block[hn]
+        << "and can not be fixed to block" << block);
+    }
+    _fixed_vertex_block[hn] = block;
+  }
+
+  // ! Returns the fixed vertices of the coarse hypergraph, where fine vertex hn
+  // ! is mapped to coarse vertex map_to_coarse(hn) (kInvalidHypernode = removed).
+  // ! Fixed vertices of different blocks must not be mapped to the same coarse vertex.
+  template<typename F>
+  FixedVertexSupport contract(const F& map_to_coarse,
+                              const HypernodeID num_coarse_nodes) const {
+    FixedVertexSupport coarse_fixed_vertices;
+    for ( const HypernodeID& hn : _fixed_vertices ) {
+      const HypernodeID coarse_hn = map_to_coarse(hn);
+      if ( coarse_hn != kInvalidHypernode ) {
+        coarse_fixed_vertices.fixToBlock(coarse_hn, _fixed_vertex_block[hn], num_coarse_nodes);
+      }
+    }
+    return coarse_fixed_vertices;
+  }
+
+  size_t sizeInBytes() const {
+    return sizeof(PartitionID) * _fixed_vertex_block.capacity() +
+      sizeof(HypernodeID) * _fixed_vertices.capacity();
+  }
+
+ private:
+  vec<PartitionID> _fixed_vertex_block;
+  vec<HypernodeID> _fixed_vertices;
+};
+
+}  // namespace ds
+}  // namespace mt_kahypar
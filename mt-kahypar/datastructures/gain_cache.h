@@ -0,0 +1,315 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "tbb/concurrent_unordered_map.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/datastructures/array.h"
+#include "mt-kahypar/parallel/atomic_wrapper.h"
+
+namespace mt_kahypar {
+namespace ds {
+
+/*!
+ * Stores the penalty term p(u) and the benefit terms b(u, V_j) of the connectivity
+ * gain g(u, V_j) = b(u, V_j) - p(u) for each node u and block V_j.
+ * For small k, we store k + 1 entries per node (dense representation). For large k,
+ * this is not feasible. If k exceeds SPARSE_THRESHOLD_K, we therefore only store the
+ * benefit terms of blocks adjacent to a node: NUM_SPARSE_ENTRIES (block, benefit) pairs
+ * per node, further entries are spilled to a hash map. A block that is not stored has a
+ * benefit term of zero.
+ * All updates are thread-safe. However, initializing the entries of a node must not be
+ * interleaved with updates of the same node.
+ */
+class GainCache {
+
+  static constexpr bool debug = false;
+
+ public:
+  using Value = CAtomic<HyperedgeWeight>;
+
+  // ! If k exceeds this threshold, we use the sparse representation
+  static constexpr PartitionID SPARSE_THRESHOLD_K = 256;
+  // ! Number of (block, benefit) pairs stored per node in the sparse representation
+  static constexpr size_t NUM_SPARSE_ENTRIES = 16;
+
+  GainCache() :
+    _num_nodes(0),
+    _k(0),
+    _is_sparse(false),
+    _entries_per_node(0),
+    _gain_cache(),
+    _sparse_blocks(),
+    _has_spilled_entries(),
+    _spilled_entries() { }
+
+  GainCache(const GainCache&) = delete;
+  GainCache & operator= (const GainCache &) = delete;
+
+  GainCache(GainCache&& other) :
+    _num_nodes(other._num_nodes),
+    _k(other._k),
+    _is_sparse(other._is_sparse),
+    _entries_per_node(other._entries_per_node),
+    _gain_cache(std::move(other._gain_cache)),
+    _sparse_blocks(std::move(other._sparse_blocks)),
+    _has_spilled_entries(std::move(other._has_spilled_entries)),
+    _spilled_entries(std::move(other._spilled_entries)) { }
+
+  GainCache & operator= (GainCache&& other) {
+    _num_nodes = other._num_nodes;
+    _k = other._k;
+    _is_sparse = other._is_sparse;
+    _entries_per_node = other._entries_per_node;
+    _gain_cache = std::move(other._gain_cache);
+    _sparse_blocks = std::move(other._sparse_blocks);
+    _has_spilled_entries = std::move(other._has_spilled_entries);
+    _spilled_entries = std::move(other._spilled_entries);
+    return *this;
+  }
+
+  // ! Allocates the data structure (all entries are zero afterwards)
+  void initialize(const HypernodeID num_nodes, const PartitionID k) {
+    ASSERT(!isAllocated());
+    _num_nodes = num_nodes;
+    _k = k;
+    _is_sparse = use_sparse_representation(k);
+    _entries_per_node = num_entries_per_node(k);
+    _gain_cache.resize("Refinement", "gain_cache",
+      static_cast<size_t>(num_nodes) * _entries_per_node, true);
+    if ( _is_sparse ) {
+      _sparse_blocks.resize("Refinement", "gain_cache_blocks",
+        static_cast<size_t>(num_nodes) * NUM_SPARSE_ENTRIES);
+      _sparse_blocks.assign(_sparse_blocks.size(), CAtomic<PartitionID>(kInvalidPartition));
+      _has_spilled_entries.resize(num_nodes, CAtomic<uint8_t>(false));
+    }
+  }
+
+  bool isAllocated() const {
+    return _gain_cache.size() > 0;
+  }
+
+  // ! Returns whether or not the sparse representation is used
+  bool isSparse() const {
+    return _is_sparse;
+  }
+
+  // ! Resets all entries to zero (not thread-safe)
+  void reset() {
+    _gain_cache.assign(_gain_cache.size(), Value(0));
+    if ( _is_sparse ) {
+      _sparse_blocks.assign(_sparse_blocks.size(), CAtomic<PartitionID>(kInvalidPartition));
+      _has_spilled_entries.assign(_has_spilled_entries.size(), CAtomic<uint8_t>(false));
+      _spilled_entries.clear();
+    }
+  }
+
+  // ! Returns the penalty term p(u)
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE HyperedgeWeight penalty(const HypernodeID u) const {
+    ASSERT(u < _num_nodes);
+    return _gain_cache[penalty_index(u)].load(std::memory_order_relaxed);
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void storePenalty(const HypernodeID u,
+                                                       const HyperedgeWeight value) {
+    ASSERT(u < _num_nodes);
+    _gain_cache[penalty_index(u)].store(value, std::memory_order_relaxed);
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void addPenalty(const HypernodeID u,
+                                                     const HyperedgeWeight delta) {
+    ASSERT(u < _num_nodes);
+    _gain_cache[penalty_index(u)].fetch_add(delta, std::memory_order_relaxed);
+  }
+
+  // ! Returns the benefit term b(u, p)
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE HyperedgeWeight benefit(const HypernodeID u,
+                                                             const PartitionID p) const {
+    ASSERT(u < _num_nodes);
+    ASSERT(p != kInvalidPartition && p < _k);
+    if ( _is_sparse ) {
+      const Value* entry = findSparseEntry(u, p);
+      return entry ? entry->load(std::memory_order_relaxed) : 0;
+    }
+    return _gain_cache[benefit_index(u, p)].load(std::memory_order_relaxed);
+  }
+
+  // ! Sets the benefit term b(u, p) to value. In the sparse representation, this
+  // ! must not be interleaved with updates of node u.
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void storeBenefit(const HypernodeID u,
+                                                       const PartitionID p,
+                                                       const HyperedgeWeight value) {
+    ASSERT(u < _num_nodes);
+    ASSERT(p != kInvalidPartition && p < _k);
+    if ( _is_sparse ) {
+      Value* entry = value != 0 ? &sparseEntry(u, p) : findSparseEntry(u, p);
+      if ( entry ) {
+        entry->store(value, std::memory_order_relaxed);
+      }
+      return;
+    }
+    _gain_cache[benefit_index(u, p)].store(value, std::memory_order_relaxed);
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void addBenefit(const HypernodeID u,
+                                                     const PartitionID p,
+                                                     const HyperedgeWeight delta) {
+    ASSERT(u < _num_nodes);
+    ASSERT(p != kInvalidPartition && p < _k);
+    if ( _is_sparse ) {
+      sparseEntry(u, p).fetch_add(delta, std::memory_order_relaxed);
+      return;
+    }
+    _gain_cache[benefit_index(u, p)].fetch_add(delta, std::memory_order_relaxed);
+  }
+
+  // ! Calls f(p, b(u, p)) for each block p for which the sparse representation stores
+  // ! a benefit term of node u. All other blocks have a benefit term of zero. Returns
+  // ! false without visiting any block, if this is not possible in constant time per block
+  // ! (dense representation or node has spilled entries).
+  template<typename F>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool doForAllSparseBenefitTerms(const HypernodeID u, const F& f) const {
+    ASSERT(u < _num_nodes);
+    if ( !_is_sparse || _has_spilled_entries[u].load(std::memory_order_relaxed) ) {
+      return false;
+    }
+    const size_t start = static_cast<size_t>(u) * NUM_SPARSE_ENTRIES;
+    for ( size_t i = 0; i < NUM_SPARSE_ENTRIES; ++i ) {
+      const PartitionID block = _sparse_blocks[start + i].load(std::memory_order_relaxed);
+      if ( block == kInvalidPartition ) {
+        break;
+      }
+      f(block, _gain_cache[penalty_index(u) + 1 + i].load(std::memory_order_relaxed));
+    }
+    return true;
+  }
+
+  void freeInternalData() {
+    parallel::parallel_free(_gain_cache, _sparse_blocks, _has_spilled_entries);
+    _spilled_entries.clear();
+  }
+
+  // ! Returns the size in bytes of this data structure
+  size_t size_in_bytes() const {
+    return sizeof(Value) * _gain_cache.size() +
+      sizeof(CAtomic<PartitionID>) * _sparse_blocks.size() +
+      sizeof(CAtomic<uint8_t>) * _has_spilled_entries.size() +
+      ( sizeof(size_t) + sizeof(Value) ) * _spilled_entries.size();
+  }
+
+  static size_t num_elements(const HypernodeID num_nodes, const PartitionID k) {
+    return static_cast<size_t>(num_nodes) * num_entries_per_node(k);
+  }
+
+  static size_t num_sparse_block_elements(const HypernodeID num_nodes, const PartitionID k) {
+    return use_sparse_representation(k) ? static_cast<size_t>(num_nodes) * NUM_SPARSE_ENTRIES : 0;
+  }
+
+  static bool use_sparse_representation(const PartitionID k) {
+    return k > SPARSE_THRESHOLD_K;
+  }
+
+ private:
+  // ! In the dense representation, we store the penalty term followed by the k
+  // ! benefit terms for each node. In the sparse representation, the penalty term is
+  // ! followed by NUM_SPARSE_ENTRIES benefit terms whose blocks are stored in _sparse_blocks.
+  static size_t num_entries_per_node(const PartitionID k) {
+    return use_sparse_representation(k) ? NUM_SPARSE_ENTRIES + 1 : static_cast<size_t>(k) + 1;
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE size_t penalty_index(const HypernodeID u) const {
+    return static_cast<size_t>(u) * _entries_per_node;
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE size_t benefit_index(const HypernodeID u, const PartitionID p) const {
+    return static_cast<size_t>(u) * _entries_per_node + p + 1;
+  }
+
+  size_t spilledEntryKey(const HypernodeID u, const PartitionID p) const {
+    return static_cast<size_t>(u) * _k + p;
+  }
+
+  // ! Blocks are stored in the first free slot of a node. Since slots are never
+  // ! released (except on reset), the occupied slots always form a prefix.
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE const Value* findSparseEntry(const HypernodeID u,
+                                                                  const PartitionID p) const {
+    const size_t start = static_cast<size_t>(u) * NUM_SPARSE_ENTRIES;
+    for ( size_t i = 0; i < NUM_SPARSE_ENTRIES; ++i ) {
+      const PartitionID block = _sparse_blocks[start + i].load(std::memory_order_relaxed);
+      if ( block == p ) {
+        return &_gain_cache[penalty_index(u) + 1 + i];
+      } else if ( block == kInvalidPartition ) {
+        return nullptr;
+      }
+    }
+    if ( _has_spilled_entries[u].load(std::memory_order_relaxed) ) {
+      auto it = _spilled_entries.find(spilledEntryKey(u, p));
+      if ( it != _spilled_entries.end() ) {
+        return &it->second;
+      }
+    }
+    return nullptr;
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE Value* findSparseEntry(const HypernodeID u,
+                                                            const PartitionID p) {
+    return const_cast<Value*>(static_cast<const GainCache&>(*this).findSparseEntry(u, p));
+  }
+
+  // ! Returns the entry of block p for node u and inserts it, if it does not exist
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE Value& sparseEntry(const HypernodeID u, const PartitionID p) {
+    const size_t start = static_cast<size_t>(u) * NUM_SPARSE_ENTRIES;
+    for ( size_t i = 0; i < NUM_SPARSE_ENTRIES; ++i ) {
+      CAtomic<PartitionID>& slot = _sparse_blocks[start + i];
+      PartitionID block = slot.load(std::memory_order_relaxed);
+      if ( block == kInvalidPartition ) {
+        // On failure, block contains the block of the thread that claimed the slot
+        slot.compare_exchange_strong(block, p, std::memory_order_relaxed);
+      }
+      if ( block == kInvalidPartition || block == p ) {
+        return _gain_cache[penalty_index(u) + 1 + i];
+      }
+    }
+    _has_spilled_entries[u].store(true, std::memory_order_relaxed);
+    // Note, insert does not modify the map if the key is already contained
+    return _spilled_entries.insert(std::make_pair(spilledEntryKey(u, p), Value(0))).first->second;
+  }
+
+  HypernodeID _num_nodes;
+  PartitionID _k;
+  bool _is_sparse;
+  size_t _entries_per_node;
+  Array<Value> _gain_cache;
+  Array< CAtomic<PartitionID> > _sparse_blocks;
+  Array< CAtomic<uint8_t> > _has_spilled_entries;
+  tbb::concurrent_unordered_map<size_t, Value> _spilled_entries;
+};
+
+}  // namespace ds
+}  // namespace mt_kahypar
@@ -26,6 +26,7 @@
  ******************************************************************************/
 
 #include "graph.h"
+#include "star_expansion_view.h"
 
 
 #include <tbb/parallel_for.h>
@@ -37,6 +38,7 @@
 #include "mt-kahypar/parallel/atomic_wrapper.h"
 #include "mt-kahypar/utils/timer.h"
 #include "mt-kahypar/parallel/parallel_counting_sort.h"
+#include "mt-kahypar/parallel/parallel_radix_sort.h"
 
 namespace mt_kahypar::ds {
 
@@ -124,25 +126,31 @@ namespace mt_kahypar::ds {
   }
 
   Graph Graph::contract_low_memory(Clustering& communities) {
+    return contractLowMemory(*this, communities);
+  }
+
+  template<typename FineGraph>
+  Graph Graph::contractLowMemory(const FineGraph& fine_graph, Clustering& communities) {
+    const size_t num_nodes = fine_graph.numNodes();
     // map cluster IDs to consecutive range
-    vec<NodeID> mapping(numNodes(), 0);   // TODO use memory pool?
-    tbb::parallel_for(UL(0), numNodes(), [&](NodeID u) { mapping[communities[u]] = 1; });
-    parallel_prefix_sum(mapping.begin(), mapping.begin() + numNodes(), mapping.begin(), std::plus<>(), 0);
-    NodeID num_coarse_nodes = mapping[numNodes() - 1];
+    vec<NodeID> mapping(num_nodes, 0);   // TODO use memory pool?
+    tbb::parallel_for(UL(0), num_nodes, [&](NodeID u) { mapping[communities[u]] = 1; });
+    parallel_prefix_sum(mapping.begin(), mapping.begin() + num_nodes, mapping.begin(), std::plus<>(), 0);
+    NodeID num_coarse_nodes = mapping[num_nodes - 1];
     // apply mapping to cluster IDs. subtract one because prefix sum is inclusive
-    tbb::parallel_for(UL(0), numNodes(), [&](NodeID u) { communities[u] = mapping[communities[u]] - 1; });
+    tbb::parallel_for(UL(0), num_nodes, [&](NodeID u) { communities[u] = mapping[communities[u]] - 1; });
 
     // sort nodes by cluster
     auto get_cluster = [&](NodeID u) { assert(u < communities.size()); return communities[u]; };
     vec<NodeID> nodes_sorted_by_cluster(std::move(mapping));    // reuse memory from mapping since it's no longer needed
-    auto cluster_bounds = parallel::counting_sort(nodes(), nodes_sorted_by_cluster, num_coarse_nodes,
+    auto cluster_bounds = parallel::counting_sort(fine_graph.nodes(), nodes_sorted_by_cluster, num_coarse_nodes,
                                                   get_cluster, TBBInitializer::instance().total_number_of_threads());
 
     Graph coarse_graph;
     coarse_graph._num_nodes = num_coarse_nodes;
     coarse_graph._indices.resize(num_coarse_nodes + 1);
     coarse_graph._node_volumes.resize(num_coarse_nodes);
-    coarse_graph._total_volume = totalVolume();
+    coarse_graph._total_volume = fine_graph.totalVolume();
 
     struct ClearList {
       vec<NodeID> used;
@@ -159,8 +167,8 @@ namespace mt_kahypar::ds {
       ArcWeight volume_cu = 0.0;
       for (auto i = cluster_bounds[cu]; i < cluster_bounds[cu + 1]; ++i) {
         NodeID fu = nodes_sorted_by_cluster[i];
-        volume_cu += nodeVolume(fu);
-        for (const Arc& arc : arcsOf(fu)) {
+        volume_cu += fine_graph.nodeVolume(fu);
+        for (const Arc& arc : fine_graph.arcsOf(fu)) {
           NodeID cv = get_cluster(arc.head);
           if (cv != cu && clear_list.values[cv] == 0.0) {
             clear_list.used.push_back(cv);
@@ -188,7 +196,7 @@ namespace mt_kahypar::ds {
     tbb::parallel_for(0U, num_coarse_nodes, [&](NodeID cu) {
       auto& clear_list = clear_lists.local();
       for (auto i = cluster_bounds[cu]; i < cluster_bounds[cu+1]; ++i) {
-        for (const Arc& arc : arcsOf(nodes_sorted_by_cluster[i])) {
+        for (const Arc& arc : fine_graph.arcsOf(nodes_sorted_by_cluster[i])) {
           NodeID cv = get_cluster(arc.head);
           if (cv != cu) {
             if (clear_list.values[cv] == 0.0) {
@@ -209,6 +217,10 @@ namespace mt_kahypar::ds {
     return coarse_graph;
   }
 
+  Graph StarExpansionView::contract(Clustering& communities, bool) {
+    return Graph::contractLowMemory(*this, communities);
+  }
+
 
   /*!
  * Contracts the graph based on the community structure passed as argument.
@@ -296,39 +308,70 @@ namespace mt_kahypar::ds {
     // #################### STAGE 3 ####################
     // Aggregate weights of arcs that are equal in each community.
     // Therefore, we sort the arcs according to their endpoints
-    // and aggregate weight of arcs with equal endpoints.
-    tbb::enumerable_thread_specific<size_t> local_max_degree(0);
-    tbb::parallel_for(0U, static_cast<NodeID>(coarse_graph._num_nodes), [&](const NodeID u) {
-      const size_t tmp_arc_start = tmp_indices_prefix_sum[u];
-      const size_t tmp_arc_end = tmp_indices_prefix_sum[u + 1];
-      // commented out comparison is needed for deterministic arc weights
-      // auto comp = [](const Arc& lhs, const Arc& rhs) { return std::tie(lhs.head, lhs.weight) < std::tie(rhs.head, rhs.weight); };
-      auto comp = [](const Arc& lhs, const Arc& rhs) { return lhs.head < rhs.head; };
-      std::sort(tmp_arcs.begin() + tmp_arc_start, tmp_arcs.begin() + tmp_arc_end, comp);
-
-      size_t arc_rep = tmp_arc_start;
-      size_t degree = tmp_arc_start < tmp_arc_end ? 1 : 0;
-      for ( size_t pos = tmp_arc_start + 1; pos < tmp_arc_end; ++pos ) {
-        if ( tmp_arcs[arc_rep].head == tmp_arcs[pos].head ) {
-          tmp_arcs[arc_rep].weight += tmp_arcs[pos].weight;
-          valid_arcs[pos] = UL(0);
-        } else {
-          arc_rep = pos;
-          ++degree;
+    // and aggregate weight of arcs with equal endpoints. If a community
+    // has extremely many incident arcs, sorting them would become a sequential
+    // bottleneck. In that case, we semisort all arcs by (source, target) with
+    // a parallel radix sort and reduce runs of equal arcs instead.
+    const size_t max_tmp_degree = tbb::parallel_reduce(
+      tbb::blocked_range<NodeID>(0U, static_cast<NodeID>(coarse_graph._num_nodes)), UL(0),
+      [&](const tbb::blocked_range<NodeID>& range, size_t max_degree) {
+        for ( NodeID u = range.begin(); u < range.end(); ++u ) {
+          const size_t tmp_arc_start = tmp_indices_prefix_sum[u];
+          const size_t tmp_arc_end = tmp_indices_prefix_sum[u + 1];
+          max_degree = std::max(max_degree, tmp_arc_end - tmp_arc_start);
         }
-      }
-      local_max_degree.local() = std::max(local_max_degree.local(), degree);
-    });
-    coarse_graph._max_degree = local_max_degree.combine(
-            [&](const size_t& lhs, const size_t& rhs) {
-              return std::max(lhs, rhs);
-            });
+        return max_degree;
+      }, [](const size_t lhs, const size_t rhs) { return std::max(lhs, rhs); });
+
+    const bool sort_based_aggregation = max_tmp_degree > HIGH_DEGREE_CONTRACTION_THRESHOLD;
+    if ( sort_based_aggregation ) {
+      aggregateArcsBySorting(coarse_graph._num_nodes, tmp_indices_prefix_sum);
+    } else {
+      tbb::enumerable_thread_specific<size_t> local_max_degree(0);
+      tbb::parallel_for(0U, static_cast<NodeID>(coarse_graph._num_nodes), [&](const NodeID u) {
+        const size_t tmp_arc_start = tmp_indices_prefix_sum[u];
+        const size_t tmp_arc_end = tmp_indices_prefix_sum[u + 1];
+        // commented out comparison is needed for deterministic arc weights
+        // auto comp = [](const Arc& lhs, const Arc& rhs) { return std::tie(lhs.head, lhs.weight) < std::tie(rhs.head, rhs.weight); };
+        auto comp = [](const Arc& lhs, const Arc& rhs) { return lhs.head < rhs.head; };
+        std::sort(tmp_arcs.begin() + tmp_arc_start, tmp_arcs.begin() + tmp_arc_end, comp);
+
+        size_t arc_rep = tmp_arc_start;
+        size_t degree = tmp_arc_start < tmp_arc_end ? 1 : 0;
+        for ( size_t pos = tmp_arc_start + 1; pos < tmp_arc_end; ++pos ) {
+          if ( tmp_arcs[arc_rep].head == tmp_arcs[pos].head ) {
+            tmp_arcs[arc_rep].weight += tmp_arcs[pos].weight;
+            valid_arcs[pos] = UL(0);
+          } else {
+            arc_rep = pos;
+            ++degree;
+          }
+        }
+        local_max_degree.local() = std::max(local_max_degree.local(), degree);
+      });
+      coarse_graph._max_degree = local_max_degree.combine(
+              [&](const size_t& lhs, const size_t& rhs) {
+                return std::max(lhs, rhs);
+              });
+    }
 
     // Write all arcs to coarse graph
     parallel::TBBPrefixSum<size_t, ds::Array> valid_arcs_prefix_sum(valid_arcs);
     tbb::parallel_scan(tbb::blocked_range<size_t>(UL(0),
                                                   tmp_indices_prefix_sum.total_sum()), valid_arcs_prefix_sum);
     coarse_graph._num_arcs = valid_arcs_prefix_sum.total_sum();
+    if ( sort_based_aggregation ) {
+      coarse_graph._max_degree = tbb::parallel_reduce(
+        tbb::blocked_range<NodeID>(0U, static_cast<NodeID>(coarse_graph._num_nodes)), UL(0),
+        [&](const tbb::blocked_range<NodeID>& range, size_t max_degree) {
+          for ( NodeID u = range.begin(); u < range.end(); ++u ) {
+            const size_t degree = valid_arcs_prefix_sum[tmp_indices_prefix_sum[u + 1]] -
+                                  valid_arcs_prefix_sum[tmp_indices_prefix_sum[u]];
+            max_degree = std::max(max_degree, degree);
+          }
+          return max_degree;
+        }, [](const size_t lhs, const size_t rhs) { return std::max(lhs, rhs); });
+    }
 
     // Move memory down to coarse graph
     coarse_graph._indices = std::move(_indices);
@@ -360,6 +403,54 @@ namespace mt_kahypar::ds {
   }
 
 
+  /*!
+   * Aggregates the parallel arcs of the tmp adjacence array. All arcs are semisorted
+   * by (source, target) with a parallel radix sort. Since the source is the most
+   * significant part of the key, the arcs of each coarse node remain in its range.
+   * The weights of runs of equal arcs are then accumulated in the first arc of each
+   * run and all other arcs are marked as invalid, which balances the work independent
+   * of the degree distribution.
+   */
+  void Graph::aggregateArcsBySorting(const size_t num_coarse_nodes,
+                                     const TmpIndicesPrefixSum& tmp_indices_prefix_sum) {
+    struct SortableArc {
+      NodeID source;
+      Arc arc;
+    };
+    ds::Array<Arc>& tmp_arcs = _tmp_graph_buffer->tmp_arcs;
+    ds::Array<size_t>& valid_arcs = _tmp_graph_buffer->valid_arcs;
+    const size_t num_tasks = TBBInitializer::instance().total_number_of_threads();
+    const size_t num_tmp_arcs = tmp_indices_prefix_sum.total_sum();
+    vec<SortableArc> sorted_arcs(num_tmp_arcs);
+    vec<SortableArc> buffer;
+    tbb::parallel_for(0U, static_cast<NodeID>(num_coarse_nodes), [&](const NodeID u) {
+      const size_t tmp_arc_start = tmp_indices_prefix_sum[u];
+      const size_t tmp_arc_end = tmp_indices_prefix_sum[u + 1];
+      tbb::parallel_for(tmp_arc_start, tmp_arc_end, [&](const size_t pos) {
+        sorted_arcs[pos] = SortableArc { u, tmp_arcs[pos] };
+      });
+    });
+
+    auto get_key = [&](const SortableArc& a) -> uint64_t {
+      return static_cast<uint64_t>(a.source) * num_coarse_nodes + a.arc.head;
+    };
+    const uint64_t max_key = static_cast<uint64_t>(num_coarse_nodes) * num_coarse_nodes - 1;
+    parallel::radix_sort(sorted_arcs, buffer, max_key, get_key, num_tasks);
+
+    tbb::parallel_for(UL(0), num_tmp_arcs, [&](const size_t pos) {
+      tmp_arcs[pos] = sorted_arcs[pos].arc;
+      valid_arcs[pos] = pos == 0 || get_key(sorted_arcs[pos - 1]) != get_key(sorted_arcs[pos]);
+    });
+    parallel::reduce_runs(sorted_arcs,
+      [&](const SortableArc& lhs, const SortableArc& rhs) {
+        return get_key(lhs) == get_key(rhs);
+      }, [](SortableArc& lhs, const SortableArc& rhs) {
+        lhs.arc.weight += rhs.arc.weight;
+      }, [&](const size_t pos, const SortableArc& a) {
+        tmp_arcs[pos].weight = a.arc.weight;
+      }, num_tasks);
+  }
+
   Graph::Graph() :
           _num_nodes(0),
           _num_arcs(0),
@@ -34,6 +34,7 @@
 #include "mt-kahypar/definitions.h"
 #include "mt-kahypar/datastructures/array.h"
 #include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/parallel/parallel_prefix_sum.h"
 #include "mt-kahypar/partition/context_enum_classes.h"
 #include "mt-kahypar/utils/range.h"
 
@@ -49,6 +50,11 @@ class Graph {
   static constexpr bool debug = false;
   static constexpr bool enable_heavy_assert = false;
 
+  // ! If a coarse node has more incident arcs than this threshold during contraction,
+  // ! parallel arcs are aggregated with a parallel radix sort over all arcs instead of
+  // ! sorting the arcs of each coarse node sequentially.
+  static constexpr size_t HIGH_DEGREE_CONTRACTION_THRESHOLD = 100000;
+
   struct TmpGraphBuffer {
     explicit TmpGraphBuffer(const size_t num_nodes,
                             const size_t num_arcs) :
@@ -65,6 +71,8 @@ class Graph {
     ds::Array<size_t> valid_arcs;
   };
 
+  using TmpIndicesPrefixSum = parallel::TBBPrefixSum<parallel::IntegralAtomicWrapper<size_t>, ds::Array>;
+
  public:
   using AdjacenceIterator = typename ds::Array<Arc>::const_iterator;
 
@@ -144,6 +152,13 @@ class Graph {
 
   Graph contract_low_memory(Clustering& communities);
 
+  /*!
+   * Contracts an arbitrary (possibly implicit) graph without reusing its memory.
+   * The fine graph only has to provide the read-only interface of this class.
+   */
+  template<typename FineGraph>
+  static Graph contractLowMemory(const FineGraph& fine_graph, Clustering& communities);
+
   void allocateContractionBuffers() {
     _tmp_graph_buffer = new TmpGraphBuffer(_num_nodes, _num_arcs);
   }
@@ -164,6 +179,9 @@ class Graph {
   void constructGraph(const Hypergraph& hypergraph,
                       const F& edge_weight_func);
 
+  void aggregateArcsBySorting(const size_t num_coarse_nodes,
+                              const TmpIndicesPrefixSum& tmp_indices_prefix_sum);
+
   ArcWeight computeNodeVolume(const NodeID u) {
     ASSERT(u < _num_nodes);
     ArcWeight x = 0.0;
@@ -0,0 +1,181 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstring>
+
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/datastructures/array.h"
+#include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+
+namespace mt_kahypar {
+namespace ds {
+
+/**
+ * Constructs a hypergraph from hyperedges that are added incrementally (e.g., while
+ * streaming an input file). Hyperedges can be added concurrently. Each thread appends
+ * them to its own list of chunks, which are never reallocated once they are full.
+ * finalize() copies all chunks into the incidence array of the hypergraph with one
+ * parallel scatter and constructs the hypergraph from it.
+ *
+ * Hyperedges added by the same thread keep their relative order. If hyperedges are
+ * added concurrently, the order between hyperedges of different threads is unspecified.
+ */
+template<typename Hypergraph, typename HypergraphFactory>
+class HypergraphBuilder {
+
+  static constexpr bool debug = false;
+
+  // ! Minimum number of pins of a chunk
+  static constexpr size_t CHUNK_SIZE = 1 << 16;
+
+  struct Chunk {
+    explicit Chunk(const size_t capacity) :
+      pins(),
+      edge_sizes(),
+      edge_weights() {
+      pins.reserve(capacity);
+    }
+
+    vec<HypernodeID> pins;
+    vec<HypernodeID> edge_sizes;
+    vec<HyperedgeWeight> edge_weights;
+  };
+
+  using ChunkList = vec<Chunk>;
+
+ public:
+  explicit HypergraphBuilder(const HypernodeID num_hypernodes,
+                             const HypernodeWeight* hypernode_weight = nullptr) :
+    _num_hypernodes(num_hypernodes),
+    _hypernode_weights(),
+    _local_chunks() {
+    if ( hypernode_weight ) {
+      _hypernode_weights.assign(hypernode_weight, hypernode_weight + num_hypernodes);
+    }
+  }
+
+  HypergraphBuilder(const HypergraphBuilder&) = delete;
+  HypergraphBuilder & operator= (const HypergraphBuilder &) = delete;
+
+  HypergraphBuilder(HypergraphBuilder&&) = delete;
+  HypergraphBuilder & operator= (HypergraphBuilder &&) = delete;
+
+  HypernodeID numNodes() const {
+    return _num_hypernodes;
+  }
+
+  // ! Adds a hyperedge to the hypergraph (thread-safe)
+  template<typename PinID>
+  void addHyperedge(const PinID* pins,
+                    const size_t num_pins,
+                    const HyperedgeWeight weight = 1) {
+    ChunkList& chunks = _local_chunks.local();
+    if ( chunks.empty() || chunks.back().pins.size() + num_pins > chunks.back().pins.capacity() ) {
+      chunks.emplace_back(std::max(CHUNK_SIZE, num_pins));
+    }
+    Chunk& chunk = chunks.back();
+    for ( size_t i = 0; i < num_pins; ++i ) {
+      if ( pins[i] >= _num_hypernodes ) {
+        ERR("Invalid pin" << pins[i] << "in hyperedge (number of nodes:" << _num_hypernodes << ")");
+      }
+      chunk.pins.push_back(static_cast<HypernodeID>(pins[i]));
+    }
+    chunk.edge_sizes.push_back(num_pins);
+    chunk.edge_weights.push_back(weight);
+  }
+
+  // ! Number of hyperedges added so far (not thread-safe)
+  HyperedgeID numAddedHyperedges() const {
+    HyperedgeID num_hyperedges = 0;
+    for ( const ChunkList& chunks : _local_chunks ) {
+      for ( const Chunk& chunk : chunks ) {
+        num_hyperedges += chunk.edge_sizes.size();
+      }
+    }
+    return num_hyperedges;
+  }
+
+  // ! Constructs the hypergraph from all added hyperedges. Afterwards, the
+  // ! builder is empty. Must not be called concurrently with addHyperedge(...).
+  Hypergraph finalize(const bool stable_construction_of_incident_edges = false) {
+    // Assign a consecutive range of hyperedge IDs and pin positions to each chunk
+    vec<Chunk*> chunks;
+    vec<size_t> first_edge(1, 0);
+    vec<size_t> first_pin(1, 0);
+    for ( ChunkList& local_chunks : _local_chunks ) {
+      for ( Chunk& chunk : local_chunks ) {
+        chunks.push_back(&chunk);
+        first_edge.push_back(first_edge.back() + chunk.edge_sizes.size());
+        first_pin.push_back(first_pin.back() + chunk.pins.size());
+      }
+    }
+    const HyperedgeID num_hyperedges = first_edge.back();
+    const size_t num_pins = first_pin.back();
+    DBG << "Finalize hypergraph with" << _num_hypernodes << "nodes," << num_hyperedges
+        << "hyperedges and" << num_pins << "pins from" << chunks.size() << "chunks";
+
+    vec<size_t> pin_offsets(num_hyperedges + 1, 0);
+    vec<HyperedgeWeight> hyperedge_weights(num_hyperedges, 0);
+    Array<HypernodeID> incidence_array;
+    incidence_array.resize(num_pins);
+    tbb::parallel_for(UL(0), chunks.size(), [&](const size_t i) {
+      Chunk& chunk = *chunks[i];
+      std::memcpy(incidence_array.data() + first_pin[i], chunk.pins.data(),
+                  sizeof(HypernodeID) * chunk.pins.size());
+      size_t pos = first_pin[i];
+      for ( size_t j = 0; j < chunk.edge_sizes.size(); ++j ) {
+        const size_t he = first_edge[i] + j;
+        pin_offsets[he] = pos;
+        hyperedge_weights[he] = chunk.edge_weights[j];
+        pos += chunk.edge_sizes[j];
+      }
+      parallel::free(chunk.pins);
+      parallel::free(chunk.edge_sizes);
+      parallel::free(chunk.edge_weights);
+    });
+    pin_offsets[num_hyperedges] = num_pins;
+    _local_chunks.clear();
+
+    return HypergraphFactory::construct_from_incidence_array(
+      _num_hypernodes, num_hyperedges, pin_offsets, std::move(incidence_array),
+      hyperedge_weights.data(), _hypernode_weights.empty() ? nullptr : _hypernode_weights.data(),
+      stable_construction_of_incident_edges);
+  }
+
+ private:
+  const HypernodeID _num_hypernodes;
+  vec<HypernodeWeight> _hypernode_weights;
+  tbb::enumerable_thread_specific<ChunkList> _local_chunks;
+};
+
+}  // namespace ds
+}  // namespace mt_kahypar
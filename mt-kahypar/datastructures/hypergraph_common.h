@@ -29,15 +29,18 @@
 
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 
 #include "mt-kahypar/parallel/stl/scalable_vector.h"
 #include "mt-kahypar/parallel/hardware_topology.h"
 #include "mt-kahypar/parallel/tbb_initializer.h"
+#include "mt-kahypar/parallel/thread_pool.h"
 
 namespace mt_kahypar {
 
 using HardwareTopology = mt_kahypar::parallel::HardwareTopology<>;
-using TBBInitializer = mt_kahypar::parallel::TBBInitializer<HardwareTopology, false>;
+using TBBInitializer = mt_kahypar::parallel::TBBInitializer<HardwareTopology, true>;
+using ThreadPool = mt_kahypar::parallel::ThreadPool<HardwareTopology>;
 
 #define UI64(X) static_cast<uint64_t>(X)
 
@@ -56,6 +59,15 @@ using HypernodeWeight = int32_t;
 using HyperedgeWeight = int32_t;
 using PartitionID = int32_t;
 using Gain = HyperedgeWeight;
+// Storage type of the block IDs in the partitioned hypergraph. Narrow types are
+// unsigned and encode kInvalidPartition with their largest value.
+#if KAHYPAR_USE_8_BIT_PART_IDS
+using PartIDStorage = uint8_t;
+#elif KAHYPAR_USE_16_BIT_PART_IDS
+using PartIDStorage = uint16_t;
+#else
+using PartIDStorage = PartitionID;
+#endif
 
 // Graph Types
 using NodeID = uint32_t;
@@ -76,6 +88,9 @@ struct Arc {
 
 // Constant Declarations
 static constexpr PartitionID kInvalidPartition = -1;
+// ! Largest number of blocks that can be represented by PartIDStorage
+static constexpr PartitionID kMaxNumBlocks = std::is_same<PartIDStorage, PartitionID>::value ?
+  std::numeric_limits<PartitionID>::max() : static_cast<PartitionID>(std::numeric_limits<PartIDStorage>::max());
 static constexpr HypernodeID kInvalidHypernode = std::numeric_limits<HypernodeID>::max();
 static constexpr HypernodeID kInvalidHyperedge = std::numeric_limits<HyperedgeID>::max();
 static constexpr Gain kInvalidGain = std::numeric_limits<HyperedgeID>::min();
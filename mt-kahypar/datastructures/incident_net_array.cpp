@@ -40,6 +40,7 @@ IncidentNetIterator::IncidentNetIterator(const HypernodeID u,
   _current_u(u),
   _current_size(incident_net_array->header(u)->size),
   _current_pos(0),
+  _current_entries(incident_net_array->firstEntry(u)),
   _incident_net_array(incident_net_array),
   _end(end) {
   if ( end ) {
@@ -69,7 +70,7 @@ IncidentNetIterator::IncidentNetIterator(const HypernodeID u,
 
 HyperedgeID IncidentNetIterator::operator* () const {
   ASSERT(!_end);
-  return _incident_net_array->firstEntry(_current_u)[_current_pos].e;
+  return _current_entries[_current_pos].e;
 }
 
 IncidentNetIterator & IncidentNetIterator::operator++ () {
@@ -93,15 +94,16 @@ void IncidentNetIterator::next_iterator() {
   while ( _current_pos == _current_size ) {
     const HypernodeID last_u = _current_u;
     _current_u = _incident_net_array->header(_current_u)->it_next;
+    const IncidentNetArray::Header* current_header = _incident_net_array->header(_current_u);
     _current_pos = 0;
-    _current_size = _incident_net_array->header(_current_u)->size;
+    _current_size = current_header->size;
+    _current_entries = _incident_net_array->firstEntry(_current_u);
     // It can happen that due to a contraction the current vertex
     // we iterate over becomes empty or the head of the current vertex
     // changes. Therefore, we set the end flag if we reach the current
     // head of the list or it_next is equal with the current vertex (means
     // that list becomes empty due to a contraction)
-    if ( _incident_net_array->header(_current_u)->is_head ||
-         last_u == _current_u ) {
+    if ( current_header->is_head || last_u == _current_u ) {
       _end = true;
       break;
     }
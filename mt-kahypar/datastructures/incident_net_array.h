@@ -50,6 +50,15 @@ namespace ds {
 // forward declaration
 class IncidentNetArray;
 
+// Represents one incident net of a vertex.
+// A incident net is associated with a version number. Incident nets
+// with a version number greater or equal than the version number in
+// header (see Header -> current_version) are active.
+struct IncidentNetEntry {
+  HyperedgeID e;
+  HypernodeID version;
+};
+
 // Iterator over the incident nets of a vertex u
 class IncidentNetIterator {
   public:
@@ -85,6 +94,9 @@ class IncidentNetIterator {
   HypernodeID _current_u;
   HypernodeID _current_size;
   size_t _current_pos;
+  // ! Incident nets of the current list (avoids a lookup
+  // ! in the index array each time the iterator is dereferenced)
+  const IncidentNetEntry* _current_entries;
   const IncidentNetArray* _incident_net_array;
   bool _end;
 };
@@ -104,14 +116,7 @@ class IncidentNetArray {
 
   static_assert(sizeof(char) == 1);
 
-  // Represents one incident net of a vertex.
-  // A incident net is associated with a version number. Incident nets
-  // with a version number greater or equal than the version number in
-  // header (see Header -> current_version) are active.
-  struct Entry {
-    HyperedgeID e;
-    HypernodeID version;
-  };
+  using Entry = IncidentNetEntry;
 
   // Header of the incident net list of a vertex. The incident net lists
   // contracted into one vertex are concatenated in a double linked list.
@@ -31,15 +31,21 @@
 #include <atomic>
 #include <type_traits>
 #include <mutex>
+#include <algorithm>
 
+#include "tbb/parallel_for.h"
 #include "tbb/parallel_invoke.h"
 
 #include "kahypar/meta/mandatory.h"
 
+#include "mt-kahypar/datastructures/atomic_bit_vector.h"
 #include "mt-kahypar/datastructures/hypergraph_common.h"
 #include "mt-kahypar/datastructures/connectivity_set.h"
+#include "mt-kahypar/datastructures/gain_cache.h"
+#include "mt-kahypar/datastructures/prefetching.h"
 #include "mt-kahypar/datastructures/thread_safe_fast_reset_flag_array.h"
 #include "mt-kahypar/parallel/atomic_wrapper.h"
+#include "mt-kahypar/parallel/chunking.h"
 #include "mt-kahypar/parallel/stl/scalable_vector.h"
 #include "mt-kahypar/parallel/stl/thread_locals.h"
 #include "mt-kahypar/utils/range.h"
@@ -148,8 +154,10 @@ private:
 
  public:
   static constexpr bool is_static_hypergraph = Hypergraph::is_static_hypergraph;
+  static constexpr bool is_graph = Hypergraph::is_graph;
   static constexpr bool is_partitioned = true;
   static constexpr bool supports_connectivity_set = true;
+  static constexpr bool supports_sparse_gain_cache = true;
 
   static constexpr HyperedgeID HIGH_DEGREE_THRESHOLD = ID(100000);
   static constexpr size_t SIZE_OF_EDGE_LOCK = sizeof(EdgeLock);
@@ -164,13 +172,15 @@ private:
   explicit PartitionedGraph(const PartitionID k,
                             Hypergraph& hypergraph) :
     _is_gain_cache_initialized(false),
+    _is_gain_cache_initialized_lazily(false),
     _top_level_num_nodes(hypergraph.initialNumNodes()),
     _k(k),
     _hg(&hypergraph),
-    _part_weights(k, CAtomic<HypernodeWeight>(0)),
+    _part_weights(k, PaddedCAtomic<HypernodeWeight>(0)),
     _part_ids(
       "Refinement", "part_ids", hypergraph.initialNumNodes(), false, false),
-    _incident_weight_in_part(),
+    _gain_cache(),
+    _valid_gain_cache_entries(),
     _edge_locks(
       "Refinement", "edge_locks", hypergraph.maxUniqueID(), false, false),
     _edge_markers(Hypergraph::is_static_hypergraph ? 0 : hypergraph.maxUniqueID()) {
@@ -181,12 +191,14 @@ private:
                             Hypergraph& hypergraph,
                             parallel_tag_t) :
     _is_gain_cache_initialized(false),
+    _is_gain_cache_initialized_lazily(false),
     _top_level_num_nodes(hypergraph.initialNumNodes()),
     _k(k),
     _hg(&hypergraph),
-    _part_weights(k, CAtomic<HypernodeWeight>(0)),
+    _part_weights(k, PaddedCAtomic<HypernodeWeight>(0)),
     _part_ids(),
-    _incident_weight_in_part(),
+    _gain_cache(),
+    _valid_gain_cache_entries(),
     _edge_locks(),
     _edge_markers() {
     tbb::parallel_invoke([&] {
@@ -216,12 +228,15 @@ private:
 
   void resetData() {
     _is_gain_cache_initialized = false;
+    _is_gain_cache_initialized_lazily = false;
     resetMoveState();
     tbb::parallel_invoke([&] {
     }, [&] {
       _part_ids.assign(_part_ids.size(), CAtomic<PartitionID>(kInvalidPartition));
     }, [&] {
-      _incident_weight_in_part.assign(_incident_weight_in_part.size(),  CAtomic<HyperedgeWeight>(0));
+      if ( _gain_cache.isAllocated() ) {
+        _gain_cache.reset();
+      }
     }, [&] {
       for (auto& x : _part_weights) x.store(0, std::memory_order_relaxed);
     });
@@ -254,12 +269,12 @@ private:
   }
 
   // ! Initial number of pins
-  HypernodeID initialNumPins() const {
+  size_t initialNumPins() const {
     return _hg->initialNumPins();
   }
 
   // ! Initial sum of the degree of all vertices
-  HypernodeID initialTotalVertexDegree() const {
+  size_t initialTotalVertexDegree() const {
     return _hg->initialTotalVertexDegree();
   }
 
@@ -349,6 +364,20 @@ private:
     return _hg->nodeIsEnabled(u);
   }
 
+  bool hasFixedVertices() const {
+    return _hg->hasFixedVertices();
+  }
+
+  // ! Returns true, if hypernode u is fixed to a block
+  bool isFixed(const HypernodeID u) const {
+    return _hg->isFixed(u);
+  }
+
+  // ! Block to which hypernode u is fixed (kInvalidPartition, if u is not fixed)
+  PartitionID fixedVertexBlock(const HypernodeID u) const {
+    return _hg->fixedVertexBlock(u);
+  }
+
   // ! Restores a degree zero hypernode
   void restoreDegreeZeroHypernode(const HypernodeID u, const PartitionID to) {
     _hg->restoreDegreeZeroHypernode(u);
@@ -419,8 +448,8 @@ private:
           // the edge weight is added to u and v
           const PartitionID block = partID(u);
           const HyperedgeWeight we = edgeWeight(e);
-          _incident_weight_in_part[incident_weight_index(u, block)].fetch_add(we, std::memory_order_relaxed);
-          _incident_weight_in_part[incident_weight_index(v, block)].fetch_add(we, std::memory_order_relaxed);
+          _gain_cache.addBenefit(u, block, we);
+          _gain_cache.addBenefit(v, block, we);
         }
       },
       [&](const HypernodeID u, const HypernodeID v, const HyperedgeID e) {
@@ -429,8 +458,8 @@ private:
           // the edge weight shifts from u to v
           const PartitionID targetBlock = partID(edgeTarget(e));
           const HyperedgeWeight we = edgeWeight(e);
-          _incident_weight_in_part[incident_weight_index(u, targetBlock)].fetch_sub(we, std::memory_order_relaxed);
-          _incident_weight_in_part[incident_weight_index(v, targetBlock)].fetch_add(we, std::memory_order_relaxed);
+          _gain_cache.addBenefit(u, targetBlock, -we);
+          _gain_cache.addBenefit(v, targetBlock, we);
         }
       });
   }
@@ -454,6 +483,47 @@ private:
     return _part_ids[u].load(std::memory_order_relaxed);
   }
 
+  // ! Prefetches the block of vertex u
+  void prefetchPartID(const HypernodeID u) const {
+    MT_KAHYPAR_PREFETCH(_part_ids.data() + u);
+  }
+
+  // ! Prefetches the block of the target of edge e, which is accessed
+  // ! when the gain of the source is computed
+  void prefetchEdge(const HyperedgeID e) const {
+    prefetchPartID(edgeTarget(e));
+  }
+
+  // ! Calls f(e) for each incident edge e of u. The block of the target
+  // ! of the edge that is distance positions ahead is prefetched.
+  template<size_t distance = PREFETCH_DISTANCE, typename F>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void forEachIncidentEdgeWithPrefetching(const HypernodeID u, const F& f) const {
+    forEachWithLookAhead<distance>(incidentEdges(u), [&](const HyperedgeID e) { prefetchEdge(e); }, f);
+  }
+
+  // ! Calls f(pin) for each pin of edge e
+  template<size_t distance = PREFETCH_DISTANCE, typename F>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void forEachPinWithPrefetching(const HyperedgeID e, const F& f) const {
+    forEachWithLookAhead<distance>(pins(e), [&](const HypernodeID pin) { prefetchPartID(pin); }, f);
+  }
+
+  // ! Block IDs of all vertices (indexed by vertex ID). The array is owned by
+  // ! the partitioned graph and reflects all subsequent changes. It must not be
+  // ! read while vertices are moved concurrently.
+  const PartitionID* partIDs() const {
+    static_assert(sizeof(CAtomic<PartitionID>) == sizeof(PartitionID) &&
+                  alignof(CAtomic<PartitionID>) == alignof(PartitionID),
+                  "Block IDs are not stored as a plain array");
+    return reinterpret_cast<const PartitionID*>(_part_ids.data());
+  }
+
+  // ! Writes the block IDs of all vertices to part_ids (indexed by vertex ID)
+  void copyPartIDs(PartitionID* part_ids) const {
+    tbb::parallel_for(ID(0), initialNumNodes(), [&](const HypernodeID u) {
+      part_ids[u] = partID(u);
+    });
+  }
+
   void extractPartIDs(Array<CAtomic<PartitionID>>& part_ids) {
     // If we pass the input hypergraph to initial partitioning, then initial partitioning
     // will pass an part ID vector of size |V'|, where V' are the number of nodes of
@@ -535,6 +605,81 @@ private:
                                              NoOpDeltaFunc());
   }
 
+  // ! The edge locks of a moved vertex are collected and restored in one sequence,
+  // ! therefore moves of high-degree vertices are not parallelized for graphs
+  template<typename SuccessFunc, typename DeltaFunc>
+  bool changeNodePartInParallel(const HypernodeID u,
+                                PartitionID from,
+                                PartitionID to,
+                                HypernodeWeight max_weight_to,
+                                SuccessFunc&& report_success,
+                                DeltaFunc&& delta_func) {
+    return changeNodePart(u, from, to, max_weight_to, report_success, delta_func);
+  }
+
+  template<typename SuccessFunc, typename DeltaFunc>
+  bool changeNodePartWithGainCacheUpdateInParallel(const HypernodeID u,
+                                                   PartitionID from,
+                                                   PartitionID to,
+                                                   HypernodeWeight max_weight_to,
+                                                   SuccessFunc&& report_success,
+                                                   DeltaFunc&& delta_func) {
+    return changeNodePartWithGainCacheUpdate(u, from, to, max_weight_to, report_success, delta_func);
+  }
+
+  // ####################### Objective Tracking #######################
+
+  // ! Objective tracking is not supported for graphs, since moves without locking
+  // ! (e.g., during rollbacks) do not know the block of the other endpoint of an edge.
+  // ! Thus, the objective is always recomputed (see metrics::objective(...)).
+  void enableObjectiveTracking() { }
+
+  void disableObjectiveTracking() { }
+
+  bool isObjectiveTracked() const {
+    return false;
+  }
+
+  HyperedgeWeight trackedKm1() const {
+    ERR("Objective tracking is not supported for graphs");
+  }
+
+  HyperedgeWeight trackedCut() const {
+    ERR("Objective tracking is not supported for graphs");
+  }
+
+  // ####################### Cut Net Tracking #######################
+
+  // ! Cut net tracking is not supported for graphs for the same reason.
+  // ! Border nodes are always enumerated by scanning all nodes.
+  void enableCutNetTracking() { }
+
+  void disableCutNetTracking() { }
+
+  bool isCutNetTracked() const {
+    return false;
+  }
+
+  // ! Calls f once for each cut edge (see doParallelForAllCutNets(...) of the hypergraph)
+  template<typename F>
+  void doParallelForAllCutNets(const F& f) {
+    doParallelForAllEdges([&](const HyperedgeID& e) {
+      if ( connectivity(e) > 1 ) {
+        f(e);
+      }
+    });
+  }
+
+  // ! Calls f once for each border node (see isBorderNode(...))
+  template<typename F>
+  void doParallelForAllBorderNodes(const F& f) {
+    doParallelForAllNodes([&](const HypernodeID& hn) {
+      if ( isBorderNode(hn) ) {
+        f(hn);
+      }
+    });
+  }
+
   // ! Weight of a block
   HypernodeWeight partWeight(const PartitionID p) const {
     ASSERT(p != kInvalidPartition && p < _k);
@@ -596,19 +741,30 @@ private:
     return count;
   }
 
+  // ! For graphs, the gain cache stores the incident edge weight of each node
+  // ! in each block as benefit term. The penalty term of a node is the
+  // ! incident weight in its own block (the penalty entries are unused).
   HyperedgeWeight moveFromPenalty(const HypernodeID u) const {
     ASSERT(_is_gain_cache_initialized, "Gain cache is not initialized");
-    return _incident_weight_in_part[incident_weight_index(u, partID(u))].load(std::memory_order_relaxed);
+    return _gain_cache.benefit(u, partID(u));
   }
 
   HyperedgeWeight moveToBenefit(const HypernodeID u, PartitionID p) const {
     ASSERT(_is_gain_cache_initialized, "Gain cache is not initialized");
-    return _incident_weight_in_part[incident_weight_index(u, p)].load(std::memory_order_relaxed);
+    return _gain_cache.benefit(u, p);
   }
 
   HyperedgeWeight incidentWeightInPart(const HypernodeID u, PartitionID p) const {
     ASSERT(_is_gain_cache_initialized, "Gain cache is not initialized");
-    return _incident_weight_in_part[incident_weight_index(u, p)].load(std::memory_order_relaxed);
+    return _gain_cache.benefit(u, p);
+  }
+
+  // ! If the gain cache uses the sparse representation, f(p, b(u, p)) is called for
+  // ! each block p in which u has incident edges (and possibly some blocks with zero
+  // ! incident weight). Returns false, if the caller has to iterate over all blocks.
+  template<typename F>
+  bool doForAllSparseBenefitTerms(const HypernodeID u, const F& f) const {
+    return _gain_cache.doForAllSparseBenefitTerms(u, f);
   }
 
   void initializeGainCacheEntry(const HypernodeID u, parallel::scalable_vector<Gain>& benefit_aggregator) {
@@ -619,8 +775,7 @@ private:
     }
 
     for (PartitionID i = 0; i < _k; ++i) {
-      _incident_weight_in_part[incident_weight_index(u, i)].store(
-        benefit_aggregator[i], std::memory_order_relaxed);
+      _gain_cache.storeBenefit(u, i, benefit_aggregator[i]);
       benefit_aggregator[i] = 0;
     }
   }
@@ -652,26 +807,88 @@ private:
                             [&](HypernodeID u) { return partID(u) == kInvalidPartition || partID(u) > k(); }) );
     // assert that current gain values are zero
     ASSERT(!_is_gain_cache_initialized
-           && std::none_of(_incident_weight_in_part.begin(), _incident_weight_in_part.end(),
-                           [&](const auto& weight) { return weight.load() != 0; }));
+           && std::all_of(nodes().begin(), nodes().end(), [&](const HypernodeID u) {
+             for ( PartitionID p = 0; p < _k; ++p ) {
+               if ( _gain_cache.benefit(u, p) != 0 ) return false;
+             }
+             return true;
+           }));
 
     // Calculate gain in parallel over all edges. Note that because the edges
     // are grouped by source node, this is still cache-efficient.
     doParallelForAllEdges([&](const HyperedgeID e) {
       const HypernodeID node = edgeSource(e);
       if (nodeIsEnabled(node) && !isSinglePin(e)) {
-        size_t index = incident_weight_index(node, partID(edgeTarget(e)));
-        _incident_weight_in_part[index].fetch_add(edgeWeight(e), std::memory_order_relaxed);
+        _gain_cache.addBenefit(node, partID(edgeTarget(e)), edgeWeight(e));
       }
     });
 
     _is_gain_cache_initialized = true;
+    _is_gain_cache_initialized_lazily = false;
+  }
+
+  // ! Initializes only the gain cache entries of border nodes and their neighbors.
+  // ! All other entries are invalid until they are initialized via
+  // ! initializeGainCacheEntryIfInvalid(...). Delta updates are applied to all entries,
+  // ! but only valid entries reflect the current state of the partition.
+  void initializeGainCacheLazily(const HypernodeID) {
+    allocateGainTableIfNecessary();
+    if ( _valid_gain_cache_entries.size() == 0 ) {
+      _valid_gain_cache_entries.setSize(_top_level_num_nodes);
+    } else {
+      _valid_gain_cache_entries.reset();
+    }
+
+    // Mark border nodes and their neighbors ...
+    doParallelForAllNodes([&](const HypernodeID u) {
+      if ( isBorderNode(u) ) {
+        _valid_gain_cache_entries.set(u, true);
+        for ( const HyperedgeID& e : incidentEdges(u) ) {
+          const HypernodeID v = edgeTarget(e);
+          if ( !_valid_gain_cache_entries[v] ) {
+            _valid_gain_cache_entries.set(v, true);
+          }
+        }
+      }
+    });
+
+    // ... and initialize their entries
+    tbb::enumerable_thread_specific< parallel::scalable_vector<Gain> > ets_benefit_aggregator(_k, 0);
+    doParallelForAllNodes([&](const HypernodeID u) {
+      if ( _valid_gain_cache_entries[u] ) {
+        initializeGainCacheEntry(u, ets_benefit_aggregator.local());
+      }
+    });
+
+    _is_gain_cache_initialized = true;
+    _is_gain_cache_initialized_lazily = true;
+  }
+
+  // ! Returns whether the gain cache entry of u reflects the current state of
+  // ! the partition (always true, if the gain cache is not initialized lazily)
+  bool isGainCacheEntryValid(const HypernodeID u) const {
+    return !_is_gain_cache_initialized_lazily || _valid_gain_cache_entries[u];
+  }
+
+  // ! Initializes the gain cache entry of u, if it is invalid. Returns true, if the entry
+  // ! was initialized. Must not be called concurrently for the same node. Note that the entry
+  // ! may be inaccurate, if an incident edge of u changes concurrently.
+  bool initializeGainCacheEntryIfInvalid(const HypernodeID u,
+                                         parallel::scalable_vector<Gain>& benefit_aggregator) {
+    if ( !isGainCacheEntryValid(u) ) {
+      initializeGainCacheEntry(u, benefit_aggregator);
+      _valid_gain_cache_entries.set(u, true);
+      return true;
+    }
+    return false;
   }
 
   // ! Reset partition (not thread-safe)
   void resetPartition() {
     _part_ids.assign(_part_ids.size(), CAtomic<PartitionID>(kInvalidPartition), false);
-    _incident_weight_in_part.assign(_incident_weight_in_part.size(),  CAtomic<HyperedgeWeight>(0), false);
+    if ( _gain_cache.isAllocated() ) {
+      _gain_cache.reset();
+    }
     for (auto& weight : _part_weights) {
       weight.store(0, std::memory_order_relaxed);
     }
@@ -708,8 +925,8 @@ private:
   }
 
   void allocateGainTableIfNecessary() {
-    if (_incident_weight_in_part.size() == 0) {
-      _incident_weight_in_part.resize("Refinement", "incident_weight_in_part", _top_level_num_nodes * size_t(_k), true);
+    if ( !_gain_cache.isAllocated() ) {
+      _gain_cache.initialize(_top_level_num_nodes, _k);
     }
   }
 
@@ -791,9 +1008,10 @@ private:
     utils::MemoryTreeNode* hypergraph_node = parent->addChild("Hypergraph");
     _hg->memoryConsumption(hypergraph_node);
 
-    parent->addChild("Part Weights", sizeof(CAtomic<HypernodeWeight>) * _k);
+    parent->addChild("Part Weights", sizeof(PaddedCAtomic<HypernodeWeight>) * _k);
     parent->addChild("Part IDs", sizeof(PartitionID) * _hg->initialNumNodes());
-    parent->addChild("Incident Weight in Part", sizeof(CAtomic<HyperedgeWeight>) * _incident_weight_in_part.size());
+    parent->addChild("Incident Weight in Part", _gain_cache.size_in_bytes());
+    parent->addChild("Valid Gain Cache Entries", _valid_gain_cache_entries.size_in_bytes());
   }
 
   // ####################### Extract Block #######################
@@ -881,9 +1099,125 @@ private:
     return extracted_graph;
   }
 
+  // ! Extracts all blocks of the partition as separate graphs (see extract(...)).
+  // ! Vertex and edge IDs of all blocks are computed in a single pass over the graph
+  // ! and the k graphs are constructed concurrently. The i-th graph corresponds to block i.
+  // ! The returned vertex-mapping maps each vertex to its ID in the graph of its block.
+  std::pair<vec<Hypergraph>, vec<HypernodeID> > extractAllBlocks(
+          bool /*cut_net_splitting*/,
+          bool stable_construction_of_incident_edges) {
+    const PartitionID k = _k;
+    const HypernodeID num_nodes = _hg->initialNumNodes();
+    const HyperedgeID num_edges = _hg->initialNumEdges();
+    vec<HypernodeID> node_mapping(num_nodes, kInvalidHypernode);
+    auto block_of_edge = [&](const HyperedgeID edge) {
+      if ( !edgeIsEnabled(edge) ) {
+        return kInvalidPartition;
+      }
+      const HypernodeID source = edgeSource(edge);
+      const HypernodeID target = edgeTarget(edge);
+      const PartitionID block = partID(source);
+      return block == partID(target) && source < target ? block : kInvalidPartition;
+    };
+
+    // Vertex and edge IDs of a block are assigned in increasing order of their original IDs.
+    // Each chunk counts its vertices and edges per block and a prefix sum over the chunks
+    // yields the first ID of each chunk and block.
+    const size_t num_chunks = std::max(UL(1), std::min(
+      static_cast<size_t>(std::max(num_nodes, num_edges)) / UL(1024),
+      UL(4) * static_cast<size_t>(tbb::this_task_arena::max_concurrency())));
+    const size_t node_chunk_size = parallel::chunking::idiv_ceil(num_nodes, num_chunks);
+    const size_t edge_chunk_size = parallel::chunking::idiv_ceil(num_edges, num_chunks);
+    vec<HypernodeID> node_offsets(num_chunks * k, 0);
+    vec<HyperedgeID> edge_offsets(num_chunks * k, 0);
+    tbb::parallel_for(UL(0), num_chunks, [&](const size_t chunk) {
+      const auto [first_node, last_node] = parallel::chunking::bounds(chunk, num_nodes, node_chunk_size);
+      for ( HypernodeID node = first_node; node < last_node; ++node ) {
+        if ( nodeIsEnabled(node) ) {
+          ++node_offsets[chunk * k + partID(node)];
+        }
+      }
+      const auto [first_edge, last_edge] = parallel::chunking::bounds(chunk, num_edges, edge_chunk_size);
+      for ( HyperedgeID edge = first_edge; edge < last_edge; ++edge ) {
+        const PartitionID block = block_of_edge(edge);
+        if ( block != kInvalidPartition ) {
+          ++edge_offsets[chunk * k + block];
+        }
+      }
+    });
+    vec<HypernodeID> num_block_nodes(k, 0);
+    vec<HyperedgeID> num_block_edges(k, 0);
+    for ( size_t chunk = 0; chunk < num_chunks; ++chunk ) {
+      for ( PartitionID block = 0; block < k; ++block ) {
+        const size_t idx = chunk * k + block;
+        std::swap(num_block_nodes[block], node_offsets[idx]);
+        num_block_nodes[block] += node_offsets[idx];
+        std::swap(num_block_edges[block], edge_offsets[idx]);
+        num_block_edges[block] += edge_offsets[idx];
+      }
+    }
+
+    // Assign the IDs and store the original vertices and edges of each block
+    vec<vec<HypernodeID>> block_nodes(k);
+    vec<vec<HyperedgeID>> block_edges(k);
+    tbb::parallel_for(0, k, [&](const PartitionID block) {
+      block_nodes[block].resize(num_block_nodes[block]);
+      block_edges[block].resize(num_block_edges[block]);
+    });
+    tbb::parallel_for(UL(0), num_chunks, [&](const size_t chunk) {
+      const auto [first_node, last_node] = parallel::chunking::bounds(chunk, num_nodes, node_chunk_size);
+      for ( HypernodeID node = first_node; node < last_node; ++node ) {
+        if ( nodeIsEnabled(node) ) {
+          const PartitionID block = partID(node);
+          const HypernodeID id = node_offsets[chunk * k + block]++;
+          node_mapping[node] = id;
+          block_nodes[block][id] = node;
+        }
+      }
+      const auto [first_edge, last_edge] = parallel::chunking::bounds(chunk, num_edges, edge_chunk_size);
+      for ( HyperedgeID edge = first_edge; edge < last_edge; ++edge ) {
+        const PartitionID block = block_of_edge(edge);
+        if ( block != kInvalidPartition ) {
+          block_edges[block][edge_offsets[chunk * k + block]++] = edge;
+        }
+      }
+    });
+
+    // Construct the graphs of all blocks concurrently
+    vec<Hypergraph> extracted_graphs(k);
+    tbb::parallel_for(0, k, [&](const PartitionID block) {
+      const vec<HypernodeID>& nodes_of_block = block_nodes[block];
+      const vec<HyperedgeID>& edges_of_block = block_edges[block];
+      vec<std::pair<HypernodeID, HypernodeID>> edge_vector(edges_of_block.size());
+      vec<HyperedgeWeight> edge_weight(edges_of_block.size());
+      vec<HypernodeWeight> node_weight(nodes_of_block.size());
+      tbb::parallel_invoke([&] {
+        tbb::parallel_for(UL(0), edges_of_block.size(), [&](const size_t i) {
+          const HyperedgeID edge = edges_of_block[i];
+          edge_vector[i] = { node_mapping[edgeSource(edge)], node_mapping[edgeTarget(edge)] };
+          edge_weight[i] = edgeWeight(edge);
+        });
+      }, [&] {
+        tbb::parallel_for(UL(0), nodes_of_block.size(), [&](const size_t i) {
+          node_weight[i] = nodeWeight(nodes_of_block[i]);
+        });
+      });
+
+      Hypergraph& extracted_graph = extracted_graphs[block];
+      extracted_graph = HypergraphFactory::construct_from_graph_edges(
+        nodes_of_block.size(), edges_of_block.size(), edge_vector, edge_weight.data(),
+        node_weight.data(), stable_construction_of_incident_edges);
+      tbb::parallel_for(UL(0), nodes_of_block.size(), [&](const size_t i) {
+        extracted_graph.setCommunityID(i, _hg->communityID(nodes_of_block[i]));
+      });
+    });
+    return std::make_pair(std::move(extracted_graphs), std::move(node_mapping));
+  }
+
   void freeInternalData() {
     if ( _k > 0 ) {
-      parallel::parallel_free(_part_ids, _incident_weight_in_part, _edge_locks);
+      parallel::parallel_free(_part_ids, _edge_locks);
+      _gain_cache.freeInternalData();
     }
     _k = 0;
   }
@@ -892,17 +1226,25 @@ private:
   void gainCacheUpdate(const HyperedgeID he, const HyperedgeWeight we,
                        const PartitionID from, const HypernodeID /*pin_count_in_from_part_after*/,
                        const PartitionID to, const HypernodeID /*pin_count_in_to_part_after*/) {
+    // Only the two entries of the other endpoint for the source and target block change
     const HypernodeID target = edgeTarget(he);
-    const size_t index_in_from_part = incident_weight_index(target, from);
-    _incident_weight_in_part[index_in_from_part].fetch_sub(we, std::memory_order_relaxed);
-    const size_t index_in_to_part = incident_weight_index(target, to);
-    _incident_weight_in_part[index_in_to_part].fetch_add(we, std::memory_order_relaxed);
+    _gain_cache.addBenefit(target, from, -we);
+    _gain_cache.addBenefit(target, to, we);
   }
 
  private:
-  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
-  size_t incident_weight_index(const HypernodeID u, const PartitionID p) const {
-    return size_t(u) * _k  + p;
+
+  // ! Adds weight to block p, if its weight does not exceed max_weight afterwards.
+  // ! Unbounded moves use a single fetch_add, bounded moves a compare-and-swap loop
+  // ! that never exceeds the limit (not even temporarily).
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool reservePartWeight(const PartitionID p,
+                                                            const HypernodeWeight weight,
+                                                            const HypernodeWeight max_weight) {
+    if ( max_weight == std::numeric_limits<HypernodeWeight>::max() ) {
+      _part_weights[p].fetch_add(weight, std::memory_order_relaxed);
+      return true;
+    }
+    return _part_weights[p].add_if_at_most(weight, max_weight, std::memory_order_relaxed);
   }
 
   template<bool HandleLocks, typename SuccessFunc, typename DeltaFunc>
@@ -915,8 +1257,7 @@ private:
     ASSERT(partID(u) == from);
     ASSERT(from != to);
     const HypernodeWeight weight = nodeWeight(u);
-    const HypernodeWeight to_weight_after = _part_weights[to].add_fetch(weight, std::memory_order_relaxed);
-    if (to_weight_after <= max_weight_to) {
+    if (reservePartWeight(to, weight, max_weight_to)) {
       _part_weights[from].fetch_sub(weight, std::memory_order_relaxed);
       report_success();
       if (HandleLocks) {
@@ -939,7 +1280,6 @@ private:
       }
       return true;
     } else {
-      _part_weights[to].fetch_sub(weight, std::memory_order_relaxed);
       return false;
     }
   }
@@ -1107,6 +1447,9 @@ private:
   // ! Indicate whether gain cache is initialized
   bool _is_gain_cache_initialized;
 
+  // ! Indicates whether only the entries in _valid_gain_cache_entries are initialized
+  bool _is_gain_cache_initialized_lazily;
+
   size_t _top_level_num_nodes = 0;
 
   // ! Number of blocks
@@ -1115,14 +1458,19 @@ private:
   // ! Hypergraph object around which this partitioned hypergraph is wrapped
   Hypergraph* _hg = nullptr;
 
-  // ! Weight and information for all blocks.
-  parallel::scalable_vector< CAtomic<HypernodeWeight> > _part_weights;
+  // ! Weight and information for all blocks. Each weight occupies its own
+  // ! cache line, since moves into different blocks are performed concurrently.
+  parallel::scalable_vector< PaddedCAtomic<HypernodeWeight> > _part_weights;
 
   // ! Current block IDs of the vertices
   Array< CAtomic<PartitionID> > _part_ids;
 
   // ! For each node and block, the sum of incident edge weights where the target is in that part
-  Array< CAtomic<HyperedgeWeight> > _incident_weight_in_part;
+  // ! (sparse representation for large k, see GainCache)
+  GainCache _gain_cache;
+
+  // ! Gain cache entries that are initialized, if the gain cache is initialized lazily
+  AtomicBitVector _valid_gain_cache_entries;
 
   // ! For each edge we use an atomic lock to synchronize moves
   Array< EdgeLock > _edge_locks;
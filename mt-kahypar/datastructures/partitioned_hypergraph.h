@@ -28,17 +28,30 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <type_traits>
 #include <mutex>
+#include <algorithm>
 
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_for_each.h"
 #include "tbb/parallel_invoke.h"
+#include "tbb/parallel_sort.h"
 
 #include "kahypar/meta/mandatory.h"
 
+#include "mt-kahypar/datastructures/array.h"
+#include "mt-kahypar/datastructures/atomic_bit_vector.h"
 #include "mt-kahypar/datastructures/hypergraph_common.h"
 #include "mt-kahypar/datastructures/connectivity_set.h"
+#include "mt-kahypar/datastructures/cut_net_index.h"
+#include "mt-kahypar/datastructures/gain_cache.h"
 #include "mt-kahypar/datastructures/pin_count_in_part.h"
+#include "mt-kahypar/datastructures/prefetching.h"
+#include "mt-kahypar/datastructures/tracked_objective.h"
 #include "mt-kahypar/parallel/atomic_wrapper.h"
+#include "mt-kahypar/parallel/chunking.h"
+#include "mt-kahypar/parallel/parallel_prefix_sum.h"
 #include "mt-kahypar/parallel/stl/scalable_vector.h"
 #include "mt-kahypar/parallel/stl/thread_locals.h"
 #include "mt-kahypar/utils/range.h"
@@ -65,12 +78,31 @@ private:
 
   static constexpr bool enable_heavy_assert = false;
 
+  // ! Gain cache update of a net collected during batch uncontraction: either a pin joined
+  // ! the block of u in net he or u was replaced by its contraction partner in net he
+  struct UncontractionGainUpdate {
+    HyperedgeID he;
+    HypernodeID u;
+    PartitionID block;
+    bool u_replaced;
+  };
+
  public:
   static constexpr bool is_static_hypergraph = Hypergraph::is_static_hypergraph;
+  static constexpr bool is_graph = Hypergraph::is_graph;
   static constexpr bool is_partitioned = true;
   static constexpr bool supports_connectivity_set = true;
+  static constexpr bool supports_sparse_gain_cache = true;
 
   static constexpr HyperedgeID HIGH_DEGREE_THRESHOLD = ID(100000);
+  // ! Number of degree-weighted chunks per thread of loops with skewed work per index
+  static constexpr size_t NUM_WEIGHTED_CHUNKS_PER_THREAD = 4;
+  // ! Up to this number of blocks, benefit terms are aggregated with
+  // ! a vectorized masked addition over the connectivity set
+  static constexpr PartitionID MAX_K_FOR_VECTORIZED_BENEFIT_AGGREGATION = 64;
+  // ! If a vertex is involved in at least this fraction of its incident nets in the
+  // ! uncontractions of a batch, its gain cache entry is recomputed instead of updated
+  static constexpr double GAIN_CACHE_RECOMPUTATION_THRESHOLD = 0.5;
 
   using HypernodeIterator = typename Hypergraph::HypernodeIterator;
   using HyperedgeIterator = typename Hypergraph::HyperedgeIterator;
@@ -82,37 +114,46 @@ private:
   explicit PartitionedHypergraph(const PartitionID k,
                                  Hypergraph& hypergraph) :
     _is_gain_cache_initialized(false),
+    _is_gain_cache_initialized_lazily(false),
     _top_level_num_nodes(hypergraph.initialNumNodes()),
     _k(k),
     _hg(&hypergraph),
-    _part_weights(k, CAtomic<HypernodeWeight>(0)),
+    _part_weights(k, PaddedCAtomic<HypernodeWeight>(0)),
     _part_ids(
         "Refinement", "part_ids", hypergraph.initialNumNodes(), false, false),
     _pins_in_part(hypergraph.initialNumEdges(), k, hypergraph.maxEdgeSize(), false),
     _connectivity_set(hypergraph.initialNumEdges(), k, false),
     _gain_cache(),
+    _valid_gain_cache_entries(),
     _pin_count_update_ownership(
-        "Refinement", "pin_count_update_ownership", hypergraph.initialNumEdges(), true, false) {
-    _part_ids.assign(hypergraph.initialNumNodes(), kInvalidPartition, false);
+        "Refinement", "pin_count_update_ownership", hypergraph.initialNumEdges(), true, false),
+    _tracked_objective(),
+    _cut_net_index() {
+    ASSERT(k <= kMaxNumBlocks);
+    _part_ids.assign(hypergraph.initialNumNodes(), encodePartID(kInvalidPartition), false);
   }
 
   explicit PartitionedHypergraph(const PartitionID k,
                                  Hypergraph& hypergraph,
                                  parallel_tag_t) :
     _is_gain_cache_initialized(false),
+    _is_gain_cache_initialized_lazily(false),
     _top_level_num_nodes(hypergraph.initialNumNodes()),
     _k(k),
     _hg(&hypergraph),
-    _part_weights(k, CAtomic<HypernodeWeight>(0)),
+    _part_weights(k, PaddedCAtomic<HypernodeWeight>(0)),
     _part_ids(),
     _pins_in_part(),
     _connectivity_set(0, 0),
     _gain_cache(),
-    _pin_count_update_ownership() {
+    _valid_gain_cache_entries(),
+    _pin_count_update_ownership(),
+    _tracked_objective(),
+    _cut_net_index() {
     tbb::parallel_invoke([&] {
       _part_ids.resize(
         "Refinement", "vertex_part_info", hypergraph.initialNumNodes());
-      _part_ids.assign(hypergraph.initialNumNodes(), kInvalidPartition);
+      _part_ids.assign(hypergraph.initialNumNodes(), encodePartID(kInvalidPartition));
     }, [&] {
       _pins_in_part.initialize(hypergraph.initialNumEdges(), k, hypergraph.maxEdgeSize());
     }, [&] {
@@ -136,16 +177,23 @@ private:
 
   void resetData() {
     _is_gain_cache_initialized = false;
+    _is_gain_cache_initialized_lazily = false;
     tbb::parallel_invoke([&] {
     }, [&] {
-      _part_ids.assign(_part_ids.size(), kInvalidPartition);
+      _part_ids.assign(_part_ids.size(), encodePartID(kInvalidPartition));
     }, [&] {
-      _pins_in_part.data().assign(_pins_in_part.data().size(), 0);
+      _pins_in_part.reset();
     }, [&] {
       _connectivity_set.reset();
     }, [&] {
       for (auto& x : _part_weights) x.store(0, std::memory_order_relaxed);
     });
+    if ( _tracked_objective ) {
+      _tracked_objective->reset(0, 0);
+    }
+    if ( _cut_net_index ) {
+      _cut_net_index->reset();
+    }
   }
 
   // ####################### General Hypergraph Stats ######################
@@ -175,12 +223,12 @@ private:
   }
 
   // ! Initial number of pins
-  HypernodeID initialNumPins() const {
+  size_t initialNumPins() const {
     return _hg->initialNumPins();
   }
 
   // ! Initial sum of the degree of all vertices
-  HypernodeID initialTotalVertexDegree() const {
+  size_t initialTotalVertexDegree() const {
     return _hg->initialTotalVertexDegree();
   }
 
@@ -280,6 +328,20 @@ private:
     return _hg->nodeIsEnabled(u);
   }
 
+  bool hasFixedVertices() const {
+    return _hg->hasFixedVertices();
+  }
+
+  // ! Returns true, if hypernode u is fixed to a block
+  bool isFixed(const HypernodeID u) const {
+    return _hg->isFixed(u);
+  }
+
+  // ! Block to which hypernode u is fixed (kInvalidPartition, if u is not fixed)
+  PartitionID fixedVertexBlock(const HypernodeID u) const {
+    return _hg->fixedVertexBlock(u);
+  }
+
   // ! Enables a hypernode (must be disabled before)
   void enableHypernode(const HypernodeID u) {
     _hg->enableHypernode(u);
@@ -310,6 +372,10 @@ private:
 
   // ! Sets the weight of a hyperedge
   void setEdgeWeight(const HyperedgeID e, const HyperedgeWeight weight) {
+    if ( _tracked_objective && connectivity(e) > 1 ) {
+      const HyperedgeWeight delta = weight - edgeWeight(e);
+      _tracked_objective->add((connectivity(e) - 1) * delta, delta);
+    }
     _hg->setEdgeWeight(e, weight);
   }
 
@@ -351,66 +417,27 @@ private:
     });
 
     _hg->uncontract(batch,
-      [&](const HypernodeID u, const HypernodeID v, const HyperedgeID he) {
+      [&](const HypernodeID u, const HypernodeID, const HyperedgeID he) {
         // In this case, u and v are incident to hyperedge he after uncontraction
         const PartitionID block = partID(u);
         const HypernodeID pin_count_in_part_after = incrementPinCountInPartWithoutGainUpdate(he, block);
-        ASSERT(pin_count_in_part_after > 1, V(u) << V(v) << V(he));
-
+        ASSERT(pin_count_in_part_after > 1, V(u) << V(he));
+        unused(pin_count_in_part_after);
         if ( _is_gain_cache_initialized ) {
-          // If u was the only pin of hyperedge he in its block before then moving out vertex u
-          // of hyperedge he does not decrease the connectivity any more after the
-          // uncontraction => b(u) -= w(he)
-          const HyperedgeWeight edge_weight = edgeWeight(he);
-          if ( pin_count_in_part_after == 2 ) {
-            // u might be replaced by an other vertex in the batch
-            // => search for other pin of the corresponding block and
-            // substract edge weight.
-            for ( const HypernodeID& pin : pins(he) ) {
-              if ( pin != v && partID(pin) == block ) {
-                _gain_cache[penalty_index(pin)].add_fetch(edge_weight, std::memory_order_relaxed);
-                break;
-              }
-            }
-          }
-
-          _gain_cache[penalty_index(v)].add_fetch(edge_weight, std::memory_order_relaxed);
-          // For all blocks contained in the connectivity set of hyperedge he
-          // we increase the move_to_benefit for vertex v by w(e)
-          for ( const PartitionID block : _connectivity_set.connectivitySet(he) ) {
-            _gain_cache[benefit_index(v, block)].add_fetch(
-              edge_weight, std::memory_order_relaxed);
-          }
+          _ets_uncontraction_gain_updates.local().push_back(UncontractionGainUpdate { he, u, block, false });
         }
       },
-      [&](const HypernodeID u, const HypernodeID v, const HyperedgeID he) {
+      [&](const HypernodeID u, const HypernodeID, const HyperedgeID he) {
         // In this case, u is replaced by v in hyperedge he
         // => Pin counts of hyperedge he does not change
         if ( _is_gain_cache_initialized ) {
-          const PartitionID block = partID(u);
-          const HyperedgeWeight edge_weight = edgeWeight(he);
-          // Since u is no longer incident to hyperedge he its contribution for decreasing
-          // the connectivity of he is shifted to vertex v
-          if ( pinCountInPart(he, block) == 1 ) {
-            _gain_cache[penalty_index(u)].add_fetch(edge_weight, std::memory_order_relaxed);
-            _gain_cache[penalty_index(v)].sub_fetch(edge_weight, std::memory_order_relaxed);
-          }
-
-          _gain_cache[penalty_index(u)].sub_fetch(
-            edge_weight, std::memory_order_relaxed);
-          _gain_cache[penalty_index(v)].add_fetch(
-            edge_weight, std::memory_order_relaxed);
-          // For all blocks contained in the connectivity set of hyperedge he
-          // we increase the move_to_benefit for vertex v by w(e) and decrease
-          // it for vertex u by w(e)
-          for ( const PartitionID block : _connectivity_set.connectivitySet(he) ) {
-            _gain_cache[benefit_index(u, block)].sub_fetch(
-              edge_weight, std::memory_order_relaxed);
-            _gain_cache[benefit_index(v, block)].add_fetch(
-              edge_weight, std::memory_order_relaxed);
-          }
+          _ets_uncontraction_gain_updates.local().push_back(UncontractionGainUpdate { he, u, partID(u), true });
         }
       });
+
+    if ( _is_gain_cache_initialized ) {
+      updateGainCacheAfterUncontraction(batch);
+    }
   }
 
   // ####################### Restore Hyperedges #######################
@@ -422,11 +449,10 @@ private:
     _hg->restoreLargeEdge(he);
 
     // Recalculate pin count in parts
-    const size_t incidence_array_start = _hg->hyperedge(he).firstEntry();
-    const size_t incidence_array_end = _hg->hyperedge(he).firstInvalidEntry();
+    const IncidenceIterator first_pin = _hg->pins(he).begin();
     tls_enumerable_thread_specific< vec<HypernodeID> > ets_pin_count_in_part(_k, 0);
-    tbb::parallel_for(incidence_array_start, incidence_array_end, [&](const size_t pos) {
-      const HypernodeID pin = _hg->_incidence_array[pos];
+    tbb::parallel_for(UL(0), UI64(_hg->edgeSize(he)), [&](const size_t i) {
+      const HypernodeID pin = *(first_pin + i);
       const PartitionID block = partID(pin);
       ++ets_pin_count_in_part.local()[block];
     });
@@ -443,6 +469,13 @@ private:
         _connectivity_set.add(he, block);
       }
     }
+
+    if ( _tracked_objective && connectivity(he) > 1 ) {
+      _tracked_objective->add((connectivity(he) - 1) * edgeWeight(he), edgeWeight(he));
+    }
+    if ( _cut_net_index && connectivity(he) > 1 ) {
+      _cut_net_index->setCut(he);
+    }
   }
 
   /**
@@ -456,6 +489,7 @@ private:
     // Compute pin counts of restored hyperedges and gain cache values of vertices contained
     // single-pin hyperedges. Note, that restoring parallel hyperedges does not change any
     // value in the gain cache, since it already contributes to the gain via its representative.
+    // For the same reason, the objective does not change.
     tls_enumerable_thread_specific< vec<HypernodeID> > ets_pin_count_in_part(_k, 0);
     tbb::parallel_for(UL(0), hes_to_restore.size(), [&](const size_t i) {
       const HyperedgeID he = hes_to_restore[i].removed_hyperedge;
@@ -475,9 +509,7 @@ private:
         _pins_in_part.setPinCountInPart(he, block_of_single_pin, 1);
 
         if ( _is_gain_cache_initialized ) {
-          _gain_cache[benefit_index(
-            single_vertex_of_he, block_of_single_pin)].add_fetch(
-              edgeWeight(he), std::memory_order_relaxed);
+          _gain_cache.addBenefit(single_vertex_of_he, block_of_single_pin, edgeWeight(he));
         }
       } else {
         // Restore parallel net => pin count information given by representative
@@ -486,6 +518,9 @@ private:
           _connectivity_set.add(he, block);
           _pins_in_part.setPinCountInPart(he, block, pinCountInPart(representative, block));
         }
+        if ( _cut_net_index && connectivity(he) > 1 ) {
+          _cut_net_index->setCut(he);
+        }
 
         HEAVY_REFINEMENT_ASSERT([&] {
           for ( PartitionID block = 0; block < _k; ++block ) {
@@ -507,36 +542,101 @@ private:
   // ! Block that vertex u belongs to
   PartitionID partID(const HypernodeID u) const {
     ASSERT(u < initialNumNodes(), "Hypernode" << u << "does not exist");
-    return _part_ids[u];
+    return decodePartID(_part_ids[u]);
+  }
+
+  // ! Prefetches the block of vertex u
+  void prefetchPartID(const HypernodeID u) const {
+    MT_KAHYPAR_PREFETCH(_part_ids.data() + u);
+  }
+
+  // ! Prefetches the pin counts, the connectivity set and the weight of hyperedge e,
+  // ! which are accessed when the gain of one of its pins is computed
+  void prefetchEdge(const HyperedgeID e) const {
+    _pins_in_part.prefetch(e);
+    _connectivity_set.prefetch(e);
+    if constexpr ( Hypergraph::is_static_hypergraph ) {
+      _hg->prefetchHyperedge(e);
+    }
+  }
+
+  // ! Calls f(e) for each incident net e of u. The partition information of the
+  // ! incident net that is distance positions ahead is prefetched.
+  template<size_t distance = PREFETCH_DISTANCE, typename F>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void forEachIncidentEdgeWithPrefetching(const HypernodeID u, const F& f) const {
+    forEachWithLookAhead<distance>(incidentEdges(u), [&](const HyperedgeID e) { prefetchEdge(e); }, f);
+  }
+
+  // ! Calls f(pin) for each pin of hyperedge e. The block of the pin that
+  // ! is distance positions ahead is prefetched.
+  template<size_t distance = PREFETCH_DISTANCE, typename F>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void forEachPinWithPrefetching(const HyperedgeID e, const F& f) const {
+    forEachWithLookAhead<distance>(pins(e), [&](const HypernodeID pin) { prefetchPartID(pin); }, f);
   }
 
-  void extractPartIDs(Array<PartitionID>& part_ids) {
+  // ! Block IDs of all vertices (indexed by vertex ID). The array is owned by
+  // ! the partitioned hypergraph and reflects all subsequent changes.
+  // ! Returns nullptr if block IDs are stored with a narrow type (see PartIDStorage).
+  const PartitionID* partIDs() const {
+    if constexpr ( std::is_same<PartIDStorage, PartitionID>::value ) {
+      return reinterpret_cast<const PartitionID*>(_part_ids.data());
+    } else {
+      return nullptr;
+    }
+  }
+
+  // ! Writes the block IDs of all vertices to part_ids (indexed by vertex ID)
+  void copyPartIDs(PartitionID* part_ids) const {
+    tbb::parallel_for(ID(0), initialNumNodes(), [&](const HypernodeID u) {
+      part_ids[u] = partID(u);
+    });
+  }
+
+  template<typename PartIDType>
+  void extractPartIDs(Array<PartIDType>& part_ids) {
     // If we pass the input hypergraph to initial partitioning, then initial partitioning
     // will pass an part ID vector of size |V'|, where V' are the number of nodes of
     // smallest hypergraph, while the _part_ids vector of the input hypergraph is initialized
     // with the original number of nodes. This can cause segmentation fault when we simply swap them
     // during main uncoarsening.
-    if ( _part_ids.size() == part_ids.size() ) {
-      std::swap(_part_ids, part_ids);
-    } else {
-      ASSERT(part_ids.size() <= _part_ids.size());
-      tbb::parallel_for(UL(0), part_ids.size(), [&](const size_t i) {
-        part_ids[i] = _part_ids[i];
-      });
+    if constexpr ( std::is_same<PartIDStorage, PartIDType>::value ) {
+      if ( _part_ids.size() == part_ids.size() ) {
+        std::swap(_part_ids, part_ids);
+        return;
+      }
     }
+    ASSERT(part_ids.size() <= _part_ids.size());
+    tbb::parallel_for(UL(0), part_ids.size(), [&](const size_t i) {
+      part_ids[i] = decodePartID(_part_ids[i]);
+    });
   }
 
   void setOnlyNodePart(const HypernodeID u, PartitionID p) {
     ASSERT(p != kInvalidPartition && p < _k);
-    ASSERT(_part_ids[u] == kInvalidPartition);
-    _part_ids[u] = p;
+    ASSERT(partID(u) == kInvalidPartition);
+    _part_ids[u] = encodePartID(p);
   }
 
   void setNodePart(const HypernodeID u, PartitionID p) {
     setOnlyNodePart(u, p);
     _part_weights[p].fetch_add(nodeWeight(u), std::memory_order_relaxed);
+    HyperedgeWeight km1_delta = 0;
+    HyperedgeWeight cut_delta = 0;
     for (HyperedgeID he : incidentEdges(u)) {
-      incrementPinCountInPartWithoutGainUpdate(he, p);
+      if ( incrementPinCountInPartWithoutGainUpdate(he, p) == 1 ) {
+        // Unassigned pins do not contribute to the connectivity of a hyperedge
+        const PartitionID connectivity_after = connectivity(he);
+        if ( _tracked_objective ) {
+          km1_delta += connectivity_after > 1 ? edgeWeight(he) : 0;
+          cut_delta += connectivity_after == 2 ? edgeWeight(he) : 0;
+        }
+        if ( _cut_net_index && connectivity_after > 1 ) {
+          _cut_net_index->setCut(he);
+        }
+      }
+    }
+    if ( _tracked_objective ) {
+      _tracked_objective->add(km1_delta, cut_delta);
     }
   }
 
@@ -552,17 +652,32 @@ private:
     ASSERT(partID(u) == from);
     ASSERT(from != to);
     const HypernodeWeight wu = nodeWeight(u);
-    const HypernodeWeight to_weight_after = _part_weights[to].add_fetch(wu, std::memory_order_relaxed);
-    if (to_weight_after <= max_weight_to) {
-      _part_ids[u] = to;
+    if (reservePartWeight(to, wu, max_weight_to)) {
+      _part_ids[u] = encodePartID(to);
       _part_weights[from].fetch_sub(wu, std::memory_order_relaxed);
       report_success();
-      for ( const HyperedgeID he : incidentEdges(u) ) {
-        updatePinCountOfHyperedge(he, from, to, delta_func);
+      if ( _tracked_objective ) {
+        // The deltas of all incident hyperedges are aggregated locally
+        // and then added to the shard of the calling thread
+        HyperedgeWeight km1_delta = 0;
+        HyperedgeWeight cut_delta = 0;
+        auto tracking_delta_func = [&](const HyperedgeID he, const HyperedgeWeight edge_weight, const HypernodeID edge_size,
+                                       const HypernodeID pin_count_in_from_part_after, const HypernodeID pin_count_in_to_part_after) {
+          delta_func(he, edge_weight, edge_size, pin_count_in_from_part_after, pin_count_in_to_part_after);
+          km1_delta += TrackedObjective::km1Delta(edge_weight, pin_count_in_from_part_after, pin_count_in_to_part_after);
+          cut_delta += TrackedObjective::cutDelta(edge_weight, edge_size, pin_count_in_from_part_after, pin_count_in_to_part_after);
+        };
+        for ( const HyperedgeID he : incidentEdges(u) ) {
+          updatePinCountOfHyperedge(he, from, to, tracking_delta_func);
+        }
+        _tracked_objective->add(km1_delta, cut_delta);
+      } else {
+        for ( const HyperedgeID he : incidentEdges(u) ) {
+          updatePinCountOfHyperedge(he, from, to, delta_func);
+        }
       }
       return true;
     } else {
-      _part_weights[to].fetch_sub(wu, std::memory_order_relaxed);
       return false;
     }
   }
@@ -600,6 +715,173 @@ private:
                                              NoOpDeltaFunc());
   }
 
+  // ! Same as changeNodePart(...), but the pin counts of the incident hyperedges are updated
+  // ! with a nested parallel loop. Intended for vertices with more than HIGH_DEGREE_THRESHOLD
+  // ! incident hyperedges, whose move would otherwise stall the calling thread. The move is
+  // ! safe with concurrent moves of other vertices, but delta_func must be thread-safe.
+  template<typename SuccessFunc, typename DeltaFunc>
+  bool changeNodePartInParallel(const HypernodeID u,
+                                PartitionID from,
+                                PartitionID to,
+                                HypernodeWeight max_weight_to,
+                                SuccessFunc&& report_success,
+                                DeltaFunc&& delta_func) {
+    ASSERT(partID(u) == from);
+    ASSERT(from != to);
+    const HypernodeWeight wu = nodeWeight(u);
+    if (reservePartWeight(to, wu, max_weight_to)) {
+      _part_ids[u] = encodePartID(to);
+      _part_weights[from].fetch_sub(wu, std::memory_order_relaxed);
+      report_success();
+      auto tracking_delta_func = [&](const HyperedgeID he, const HyperedgeWeight edge_weight, const HypernodeID edge_size,
+                                     const HypernodeID pin_count_in_from_part_after, const HypernodeID pin_count_in_to_part_after) {
+        delta_func(he, edge_weight, edge_size, pin_count_in_from_part_after, pin_count_in_to_part_after);
+        if ( _tracked_objective ) {
+          _tracked_objective->add(
+            TrackedObjective::km1Delta(edge_weight, pin_count_in_from_part_after, pin_count_in_to_part_after),
+            TrackedObjective::cutDelta(edge_weight, edge_size, pin_count_in_from_part_after, pin_count_in_to_part_after));
+        }
+      };
+      IteratorRange<IncidentNetsIterator> incident_edges = incidentEdges(u);
+      tbb::parallel_for_each(incident_edges.begin(), incident_edges.end(), [&](const HyperedgeID he) {
+        updatePinCountOfHyperedge(he, from, to, tracking_delta_func);
+      });
+      return true;
+    } else {
+      return false;
+    }
+  }
+
+  // ! Parallel version of changeNodePartWithGainCacheUpdate(...) (see changeNodePartInParallel(...))
+  template<typename SuccessFunc, typename DeltaFunc>
+  bool changeNodePartWithGainCacheUpdateInParallel(const HypernodeID u,
+                                                   PartitionID from,
+                                                   PartitionID to,
+                                                   HypernodeWeight max_weight_to,
+                                                   SuccessFunc&& report_success,
+                                                   DeltaFunc&& delta_func) {
+    auto my_delta_func = [&](const HyperedgeID he, const HyperedgeWeight edge_weight, const HypernodeID edge_size,
+            const HypernodeID pin_count_in_from_part_after, const HypernodeID pin_count_in_to_part_after) {
+      delta_func(he, edge_weight, edge_size, pin_count_in_from_part_after, pin_count_in_to_part_after);
+      gainCacheUpdate(he, edge_weight, from, pin_count_in_from_part_after, to, pin_count_in_to_part_after);
+    };
+    return changeNodePartInParallel(u, from, to, max_weight_to, report_success, my_delta_func);
+  }
+
+  // ####################### Objective Tracking #######################
+
+  // ! Maintains the km1 and cut metric incrementally from now on, such that
+  // ! they can be queried in time linear in the number of threads (see TrackedObjective).
+  // ! The objective is recomputed whenever the partition is initialized.
+  void enableObjectiveTracking() {
+    if ( !_tracked_objective ) {
+      _tracked_objective = std::make_unique<TrackedObjective>();
+      recomputeTrackedObjective();
+    }
+  }
+
+  void disableObjectiveTracking() {
+    _tracked_objective.reset();
+  }
+
+  bool isObjectiveTracked() const {
+    return _tracked_objective != nullptr;
+  }
+
+  HyperedgeWeight trackedKm1() const {
+    ASSERT(isObjectiveTracked());
+    return _tracked_objective->km1();
+  }
+
+  HyperedgeWeight trackedCut() const {
+    ASSERT(isObjectiveTracked());
+    return _tracked_objective->cut();
+  }
+
+  // ####################### Cut Net Tracking #######################
+
+  // ! Maintains the set of cut hyperedges incrementally from now on, such that
+  // ! they can be enumerated in time linear in the size of the cut (see CutNetIndex).
+  // ! The set is recomputed whenever the partition is initialized.
+  void enableCutNetTracking() {
+    if ( !_cut_net_index ) {
+      _cut_net_index = std::make_unique<CutNetIndex>(_hg->initialNumEdges());
+      recomputeCutNetIndex();
+    }
+  }
+
+  void disableCutNetTracking() {
+    _cut_net_index.reset();
+  }
+
+  bool isCutNetTracked() const {
+    return _cut_net_index != nullptr;
+  }
+
+  // ! Returns all cut hyperedges (not thread-safe, must not be called concurrently to moves)
+  const vec<HyperedgeID>& cutNets() {
+    ASSERT(isCutNetTracked());
+    return _cut_net_index->cutNets();
+  }
+
+  // ! Returns all cut hyperedges that connect block i and j
+  // ! (not thread-safe, must not be called concurrently to moves)
+  vec<HyperedgeID> cutNetsBetween(const PartitionID i, const PartitionID j) {
+    ASSERT(isCutNetTracked());
+    ASSERT(i != j && i < _k && j < _k);
+    vec<HyperedgeID> cut_nets_between;
+    for ( const HyperedgeID& he : _cut_net_index->cutNets() ) {
+      if ( pinCountInPart(he, i) > 0 && pinCountInPart(he, j) > 0 ) {
+        cut_nets_between.push_back(he);
+      }
+    }
+    return cut_nets_between;
+  }
+
+  // ! Calls f once for each cut hyperedge. If cut net tracking is enabled, only the cut
+  // ! hyperedges are visited. Otherwise, all hyperedges are scanned.
+  // ! Must not be called concurrently to moves.
+  template<typename F>
+  void doParallelForAllCutNets(const F& f) {
+    if ( _cut_net_index ) {
+      const vec<HyperedgeID>& cut_nets = _cut_net_index->cutNets();
+      tbb::parallel_for(UL(0), cut_nets.size(), [&](const size_t i) {
+        f(cut_nets[i]);
+      });
+    } else {
+      doParallelForAllEdges([&](const HyperedgeID& he) {
+        if ( connectivity(he) > 1 ) {
+          f(he);
+        }
+      });
+    }
+  }
+
+  // ! Calls f once for each border node (see isBorderNode(...)). If cut net tracking is
+  // ! enabled, only the pins of cut hyperedges are visited. Otherwise, all nodes are scanned.
+  // ! Must not be called concurrently to moves.
+  template<typename F>
+  void doParallelForAllBorderNodes(const F& f) {
+    if ( _cut_net_index ) {
+      const vec<HyperedgeID>& cut_nets = _cut_net_index->cutNets();
+      AtomicBitVector visited;
+      visited.setSize(_hg->initialNumNodes());
+      tbb::parallel_for(UL(0), cut_nets.size(), [&](const size_t i) {
+        for ( const HypernodeID& pin : pins(cut_nets[i]) ) {
+          if ( nodeDegree(pin) <= HIGH_DEGREE_THRESHOLD && !visited.testAndSet(pin) ) {
+            f(pin);
+          }
+        }
+      });
+    } else {
+      doParallelForAllNodes([&](const HypernodeID& hn) {
+        if ( isBorderNode(hn) ) {
+          f(hn);
+        }
+      });
+    }
+  }
+
   // ! Weight of a block
   HypernodeWeight partWeight(const PartitionID p) const {
     ASSERT(p != kInvalidPartition && p < _k);
@@ -638,6 +920,12 @@ private:
   PartitionID connectivity(const HyperedgeID e) const {
     ASSERT(e < _hg->initialNumEdges(), "Hyperedge" << e << "does not exist");
     ASSERT(edgeIsEnabled(e), "Hyperedge" << e << "is disabled");
+    if ( _k == 2 ) {
+      // Bipartitions are the dominating case in recursive bipartitioning, deep
+      // multilevel and initial partitioning. Here, the connectivity follows
+      // from the pin counts and we do not have to access the connectivity set.
+      return _pins_in_part.twoWayConnectivity(e);
+    }
     return _connectivity_set.connectivity(e);
   }
 
@@ -660,7 +948,7 @@ private:
   // ! More formally, p(u) := w({ e \in I(u) | pin_count(e, partID(u)) > 1 })
   HyperedgeWeight moveFromPenalty(const HypernodeID u) const {
     //ASSERT(_is_gain_cache_initialized, "Gain cache is not initialized");
-    return _gain_cache[penalty_index(u)].load(std::memory_order_relaxed);
+    return _gain_cache.penalty(u);
   }
 
   // ! The move to benefit term stores the weight of all incident edges of u
@@ -668,7 +956,16 @@ private:
   // ! More formally, b(u, p) := w({ e \in I(u) | pin_count(e, p) >= 1 })
   HyperedgeWeight moveToBenefit(const HypernodeID u, PartitionID p) const {
     //ASSERT(_is_gain_cache_initialized, "Gain cache is not initialized");
-    return _gain_cache[benefit_index(u, p)].load(std::memory_order_relaxed);
+    return _gain_cache.benefit(u, p);
+  }
+
+  // ! If the gain cache uses the sparse representation, f(p, b(u, p)) is called for
+  // ! each block p for which a benefit term of u is stored (all other blocks have a
+  // ! benefit term of zero). Returns false, if the benefit terms can not be enumerated
+  // ! this way and the caller has to iterate over all blocks.
+  template<typename F>
+  bool doForAllSparseBenefitTerms(const HypernodeID u, const F& f) const {
+    return _gain_cache.doForAllSparseBenefitTerms(u, f);
   }
 
   // ! The gain of moving a node u from its current block to a target block to can
@@ -685,9 +982,8 @@ private:
   }
 
   void allocateGainTableIfNecessary() {
-    if (_gain_cache.size() == 0) {
-      _gain_cache.resize(
-              "Refinement", "gain_cache", _top_level_num_nodes * size_t(_k + 1), true);
+    if ( !_gain_cache.isAllocated() ) {
+      _gain_cache.initialize(_top_level_num_nodes, _k);
     }
   }
 
@@ -707,7 +1003,7 @@ private:
   }
 
   void recomputeMoveFromPenalty(const HypernodeID u) {
-    _gain_cache[penalty_index(u)].store(moveFromPenaltyRecomputed(u), std::memory_order_relaxed);
+    _gain_cache.storePenalty(u, moveFromPenaltyRecomputed(u));
   }
 
   // ! Only for testing
@@ -732,28 +1028,48 @@ private:
             [&] { initializeBlockWeights(); },
             [&] { initializePinCountInPart(); }
     );
+    if ( _tracked_objective ) {
+      recomputeTrackedObjective();
+    }
+    if ( _cut_net_index ) {
+      recomputeCutNetIndex();
+    }
   }
 
   bool isGainCacheInitialized() const {
     return _is_gain_cache_initialized;
   }
 
+  // ! Adds the weight of hyperedge he to the benefit term of all blocks in its connectivity set
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void aggregateBenefit(const HyperedgeID he,
+                                                           const HyperedgeWeight edge_weight,
+                                                           vec<HyperedgeWeight>& benefit_aggregator) const {
+    if ( _k == 2 ) {
+      benefit_aggregator[0] += pinCountInPart(he, 0) > 0 ? edge_weight : 0;
+      benefit_aggregator[1] += pinCountInPart(he, 1) > 0 ? edge_weight : 0;
+    } else if ( _k <= MAX_K_FOR_VECTORIZED_BENEFIT_AGGREGATION ) {
+      _connectivity_set.addToAllBlocks(he, edge_weight, benefit_aggregator.data());
+    } else {
+      for (const PartitionID block : connectivitySet(he)) {
+        benefit_aggregator[block] += edge_weight;
+      }
+    }
+  }
+
   void initializeGainCacheEntry(const HypernodeID u, vec<Gain>& benefit_aggregator) {
     PartitionID pu = partID(u);
     Gain penalty = 0;
-    for (const HyperedgeID& e : incidentEdges(u)) {
+    forEachIncidentEdgeWithPrefetching(u, [&](const HyperedgeID e) {
       HyperedgeWeight ew = edgeWeight(e);
       if (pinCountInPart(e, pu) > 1) {
         penalty += ew;
       }
-      for (const PartitionID& i : connectivitySet(e)) {
-        benefit_aggregator[i] += ew;
-      }
-    }
+      aggregateBenefit(e, ew, benefit_aggregator);
+    });
 
-    _gain_cache[penalty_index(u)].store(penalty, std::memory_order_relaxed);
+    _gain_cache.storePenalty(u, penalty);
     for (PartitionID i = 0; i < _k; ++i) {
-      _gain_cache[benefit_index(u, i)].store(benefit_aggregator[i], std::memory_order_relaxed);
+      _gain_cache.storeBenefit(u, i, benefit_aggregator[i]);
       benefit_aggregator[i] = 0;
     }
   }
@@ -763,6 +1079,10 @@ private:
   // ! current state of the partition
   void initializeGainCache() {
     allocateGainTableIfNecessary();
+    if ( _gain_cache.isSparse() ) {
+      // The sparse representation only overwrites non-zero benefit terms
+      _gain_cache.reset();
+    }
 
     // check whether part has been initialized
     ASSERT(std::none_of(nodes().begin(), nodes().end(),
@@ -777,10 +1097,7 @@ private:
       if (pinCountInPart(he, block_of_u) > 1) {
         l_move_from_penalty += edge_weight;
       }
-
-      for (const PartitionID block : connectivitySet(he)) {
-        l_move_to_benefit[block] += edge_weight;
-      }
+      aggregateBenefit(he, edge_weight, l_move_to_benefit);
     };
 
 
@@ -792,23 +1109,28 @@ private:
     std::mutex high_degree_vertex_mutex;
     parallel::scalable_vector<HypernodeID> high_degree_vertices;
 
-    // Compute gain of all low degree vertices sequential (iterating over all vertices in parallel)
-    tbb::parallel_for(tbb::blocked_range<HypernodeID>(HypernodeID(0), initialNumNodes()),
-      [&](tbb::blocked_range<HypernodeID>& r) {
+    // Compute gain of all low degree vertices sequential (iterating over all vertices in parallel).
+    // The vertices are split into chunks with roughly the same number of incident nets.
+    parallel::chunking::WeightedChunks chunks;
+    chunks.build(initialNumNodes(), NUM_WEIGHTED_CHUNKS_PER_THREAD * tbb::this_task_arena::max_concurrency(),
+      [&](const HypernodeID u) {
+        return nodeIsEnabled(u) && nodeDegree(u) <= HIGH_DEGREE_THRESHOLD ? nodeDegree(u) : 0;
+      });
+    chunks.parallelFor([&](const HypernodeID first, const HypernodeID last) {
         vec<HyperedgeWeight>& l_move_to_benefit = ets_mtb.local();
-        for (HypernodeID u = r.begin(); u < r.end(); ++u) {
+        for (HypernodeID u = first; u < last; ++u) {
           if ( nodeIsEnabled(u)) {
             if ( nodeDegree(u) <= HIGH_DEGREE_THRESHOLD) {
               const PartitionID from = partID(u);
               HyperedgeWeight l_move_from_penalty = 0;
-              for (HyperedgeID he : incidentEdges(u)) {
+              forEachIncidentEdgeWithPrefetching(u, [&](const HyperedgeID he) {
                 aggregate_contribution_of_he_for_vertex(from, he,
                   l_move_from_penalty, l_move_to_benefit);
-              }
+              });
 
-              _gain_cache[penalty_index(u)].store(l_move_from_penalty, std::memory_order_relaxed);
+              _gain_cache.storePenalty(u, l_move_from_penalty);
               for (PartitionID p = 0; p < _k; ++p) {
-                _gain_cache[benefit_index(u,p)].store(l_move_to_benefit[p], std::memory_order_relaxed);
+                _gain_cache.storeBenefit(u, p, l_move_to_benefit[p]);
                 l_move_to_benefit[p] = 0;
               }
             } else {
@@ -842,23 +1164,89 @@ private:
 
       // Aggregate thread locals to compute overall gain of the high degree vertex
       const HyperedgeWeight penalty_term = ets_mfp.combine(std::plus<HyperedgeWeight>());
-      _gain_cache[penalty_index(u)].store(penalty_term, std::memory_order_relaxed);
+      _gain_cache.storePenalty(u, penalty_term);
       for (PartitionID p = 0; p < _k; ++p) {
         HyperedgeWeight move_to_benefit = 0;
         for ( auto& l_move_to_benefit : ets_mtb ) {
           move_to_benefit += l_move_to_benefit[p];
           l_move_to_benefit[p] = 0;
         }
-        _gain_cache[benefit_index(u, p)].store(move_to_benefit, std::memory_order_relaxed);
+        _gain_cache.storeBenefit(u, p, move_to_benefit);
       }
     }
 
     _is_gain_cache_initialized = true;
+    _is_gain_cache_initialized_lazily = false;
+  }
+
+  // ! Initializes only the gain cache entries of border nodes and of nodes that share
+  // ! a net with less than ignore_net_size_threshold pins with a border node. On fine levels,
+  // ! this is usually a small fraction of all nodes. All other entries are invalid until they
+  // ! are initialized via initializeGainCacheEntryIfInvalid(...). Delta updates are applied
+  // ! to all entries, but only valid entries reflect the current state of the partition.
+  // ! NOTE: Requires that pin counts are already initialized and reflect the
+  // ! current state of the partition
+  void initializeGainCacheLazily(const HypernodeID ignore_net_size_threshold) {
+    allocateGainTableIfNecessary();
+    if ( _gain_cache.isSparse() ) {
+      // The sparse representation only overwrites non-zero benefit terms
+      _gain_cache.reset();
+    }
+    if ( _valid_gain_cache_entries.size() == 0 ) {
+      _valid_gain_cache_entries.setSize(_top_level_num_nodes);
+    } else {
+      _valid_gain_cache_entries.reset();
+    }
+
+    // Mark border nodes and their neighbors ...
+    doParallelForAllNodes([&](const HypernodeID u) {
+      if ( isBorderNode(u) ) {
+        _valid_gain_cache_entries.set(u, true);
+        for ( const HyperedgeID& he : incidentEdges(u) ) {
+          if ( edgeSize(he) < ignore_net_size_threshold ) {
+            for ( const HypernodeID& pin : pins(he) ) {
+              if ( !_valid_gain_cache_entries[pin] ) {
+                _valid_gain_cache_entries.set(pin, true);
+              }
+            }
+          }
+        }
+      }
+    });
+
+    // ... and initialize their entries
+    tbb::enumerable_thread_specific< vec<Gain> > ets_mtb(_k, 0);
+    doParallelForAllNodes([&](const HypernodeID u) {
+      if ( _valid_gain_cache_entries[u] ) {
+        initializeGainCacheEntry(u, ets_mtb.local());
+      }
+    });
+
+    _is_gain_cache_initialized = true;
+    _is_gain_cache_initialized_lazily = true;
+  }
+
+  // ! Returns whether the gain cache entry of u reflects the current state of
+  // ! the partition (always true, if the gain cache is not initialized lazily)
+  bool isGainCacheEntryValid(const HypernodeID u) const {
+    return !_is_gain_cache_initialized_lazily || _valid_gain_cache_entries[u];
+  }
+
+  // ! Initializes the gain cache entry of u, if it is invalid. Returns true, if the entry
+  // ! was initialized. Must not be called concurrently for the same node. Note that the entry
+  // ! may be inaccurate, if an incident net of u changes concurrently.
+  bool initializeGainCacheEntryIfInvalid(const HypernodeID u, vec<Gain>& benefit_aggregator) {
+    if ( !isGainCacheEntryValid(u) ) {
+      initializeGainCacheEntry(u, benefit_aggregator);
+      _valid_gain_cache_entries.set(u, true);
+      return true;
+    }
+    return false;
   }
 
   // ! Reset partition (not thread-safe)
   void resetPartition() {
-    _part_ids.assign(_part_ids.size(), kInvalidPartition, false);
+    _part_ids.assign(_part_ids.size(), encodePartID(kInvalidPartition), false);
     for (auto& x : _part_weights) x.store(0, std::memory_order_relaxed);
 
     // Reset pin count in part and connectivity set
@@ -868,6 +1256,12 @@ private:
       }
       _connectivity_set.clear(he);
     }
+    if ( _tracked_objective ) {
+      _tracked_objective->reset(0, 0);
+    }
+    if ( _cut_net_index ) {
+      _cut_net_index->reset();
+    }
   }
 
   // ! Should be called e.g. after a rollback (see PartitionedGraph).
@@ -947,10 +1341,13 @@ private:
     utils::MemoryTreeNode* connectivity_set_node = parent->addChild("Connectivity Sets");
     _connectivity_set.memoryConsumption(connectivity_set_node);
 
-    parent->addChild("Part Weights", sizeof(CAtomic<HypernodeWeight>) * _k);
+    parent->addChild("Part Weights", sizeof(PaddedCAtomic<HypernodeWeight>) * _k);
     parent->addChild("Part IDs", sizeof(PartitionID) * _hg->initialNumNodes());
     parent->addChild("Pin Count In Part", _pins_in_part.size_in_bytes());
-    parent->addChild("Gain Cache", sizeof(HyperedgeWeight) * _gain_cache.size());
+    parent->addChild("Gain Cache", _gain_cache.size_in_bytes());
+    parent->addChild("Valid Gain Cache Entries", _valid_gain_cache_entries.size_in_bytes());
+    parent->addChild("Uncontraction Gain Updates", sizeof(UncontractionGainUpdate) *
+      _uncontraction_gain_updates.capacity() + _recompute_gain_cache_entry.size_in_bytes());
     parent->addChild("HE Ownership", sizeof(SpinLock) * _hg->initialNumNodes());
   }
 
@@ -998,26 +1395,25 @@ private:
       }
     });
 
-    // Extract plain hypergraph data for corresponding block
-    using HyperedgeVector = vec<vec<HypernodeID>>;
-    HyperedgeVector edge_vector;
+    // Extract plain hypergraph data for corresponding block. The number of pins
+    // of an extracted hyperedge is equal to its pin count in the block. Thus, we can
+    // compute the pin offsets upfront and write the pins directly into a flat incidence
+    // array (instead of allocating a separate pin vector for each hyperedge).
+    parallel::scalable_vector<size_t> pin_offsets;
     vec<HyperedgeWeight> hyperedge_weight;
     vec<HypernodeWeight> hypernode_weight;
     tbb::parallel_invoke([&] {
-      edge_vector.resize(num_hyperedges);
+      pin_offsets.assign(num_hyperedges + 1, 0);
       hyperedge_weight.resize(num_hyperedges);
       doParallelForAllEdges([&](const HyperedgeID he) {
-        if ( pinCountInPart(he, block) > 1 &&
-             (cut_net_splitting || connectivity(he) == 1) ) {
+        if ( he_mapping[he] != kInvalidHyperedge ) {
           ASSERT(he_mapping[he] < num_hyperedges);
           hyperedge_weight[he_mapping[he]] = edgeWeight(he);
-          for ( const HypernodeID& pin : pins(he) ) {
-            if ( partID(pin) == block ) {
-              edge_vector[he_mapping[he]].push_back(hn_mapping[pin]);
-            }
-          }
+          pin_offsets[he_mapping[he] + 1] = pinCountInPart(he, block);
         }
       });
+      parallel_prefix_sum(pin_offsets.begin(), pin_offsets.end(),
+        pin_offsets.begin(), std::plus<size_t>(), UL(0));
     }, [&] {
       hypernode_weight.resize(num_hypernodes);
       doParallelForAllNodes([&](const HypernodeID hn) {
@@ -1027,9 +1423,24 @@ private:
       });
     });
 
+    Array<HypernodeID> incidence_array;
+    incidence_array.resize(pin_offsets.back());
+    doParallelForAllEdges([&](const HyperedgeID he) {
+      if ( he_mapping[he] != kInvalidHyperedge ) {
+        size_t pos = pin_offsets[he_mapping[he]];
+        for ( const HypernodeID& pin : pins(he) ) {
+          if ( partID(pin) == block ) {
+            incidence_array[pos++] = hn_mapping[pin];
+          }
+        }
+        ASSERT(pos == pin_offsets[he_mapping[he] + 1]);
+      }
+    });
+
     // Construct hypergraph
-    Hypergraph extracted_hypergraph = HypergraphFactory::construct(num_hypernodes, num_hyperedges,
-            edge_vector, hyperedge_weight.data(), hypernode_weight.data(), stable_construction_of_incident_edges);
+    Hypergraph extracted_hypergraph = HypergraphFactory::construct_from_incidence_array(
+      num_hypernodes, num_hyperedges, pin_offsets, std::move(incidence_array),
+      hyperedge_weight.data(), hypernode_weight.data(), stable_construction_of_incident_edges);
 
     // Set community ids
     doParallelForAllNodes([&](const HypernodeID& hn) {
@@ -1041,12 +1452,145 @@ private:
     return extracted_hypergraph;
   }
 
+  // ! Extracts all blocks of the partition as separate hypergraphs (see extract(...)).
+  // ! In contrast to calling extract(...) for each block, vertex and hyperedge IDs of all
+  // ! blocks are computed in a single pass over the hypergraph and the k hypergraphs are
+  // ! constructed concurrently. The i-th hypergraph corresponds to block i. Since each vertex
+  // ! is contained in exactly one block, the returned vertex-mapping maps each vertex to its ID
+  // ! in the hypergraph of its block.
+  std::pair<vec<Hypergraph>, vec<HypernodeID> > extractAllBlocks(
+          bool cut_net_splitting,
+          bool stable_construction_of_incident_edges) {
+    const PartitionID k = _k;
+    const HypernodeID num_nodes = _hg->initialNumNodes();
+    const HyperedgeID num_edges = _hg->initialNumEdges();
+    vec<HypernodeID> hn_mapping(num_nodes, kInvalidHypernode);
+    auto contains_edge = [&](const HyperedgeID he, const PartitionID block) {
+      return pinCountInPart(he, block) > 1 && (cut_net_splitting || connectivity(he) == 1);
+    };
+
+    // Vertex and hyperedge IDs of a block are assigned in increasing order of their original IDs
+    // (same as in extract(...)). Therefore, we count the vertices and hyperedges of each block
+    // per chunk and compute the first ID of each chunk and block via a prefix sum over the chunks.
+    const size_t num_chunks = std::max(UL(1), std::min(
+      static_cast<size_t>(std::max(num_nodes, num_edges)) / UL(1024),
+      UL(4) * static_cast<size_t>(tbb::this_task_arena::max_concurrency())));
+    const size_t node_chunk_size = parallel::chunking::idiv_ceil(num_nodes, num_chunks);
+    const size_t edge_chunk_size = parallel::chunking::idiv_ceil(num_edges, num_chunks);
+    vec<HypernodeID> node_offsets(num_chunks * k, 0);
+    vec<HyperedgeID> edge_offsets(num_chunks * k, 0);
+    tbb::parallel_for(UL(0), num_chunks, [&](const size_t chunk) {
+      const auto [first_hn, last_hn] = parallel::chunking::bounds(chunk, num_nodes, node_chunk_size);
+      for ( HypernodeID hn = first_hn; hn < last_hn; ++hn ) {
+        if ( nodeIsEnabled(hn) ) {
+          ++node_offsets[chunk * k + partID(hn)];
+        }
+      }
+      const auto [first_he, last_he] = parallel::chunking::bounds(chunk, num_edges, edge_chunk_size);
+      for ( HyperedgeID he = first_he; he < last_he; ++he ) {
+        if ( edgeIsEnabled(he) ) {
+          for ( const PartitionID block : connectivitySet(he) ) {
+            if ( contains_edge(he, block) ) {
+              ++edge_offsets[chunk * k + block];
+            }
+          }
+        }
+      }
+    });
+    vec<HypernodeID> num_hypernodes(k, 0);
+    vec<HyperedgeID> num_hyperedges(k, 0);
+    for ( size_t chunk = 0; chunk < num_chunks; ++chunk ) {
+      for ( PartitionID block = 0; block < k; ++block ) {
+        const size_t idx = chunk * k + block;
+        std::swap(num_hypernodes[block], node_offsets[idx]);
+        num_hypernodes[block] += node_offsets[idx];
+        std::swap(num_hyperedges[block], edge_offsets[idx]);
+        num_hyperedges[block] += edge_offsets[idx];
+      }
+    }
+
+    // Assign the IDs and store the original vertices and hyperedges of each block
+    vec<vec<HypernodeID>> block_nodes(k);
+    vec<vec<HyperedgeID>> block_edges(k);
+    tbb::parallel_for(0, k, [&](const PartitionID block) {
+      block_nodes[block].resize(num_hypernodes[block]);
+      block_edges[block].resize(num_hyperedges[block]);
+    });
+    tbb::parallel_for(UL(0), num_chunks, [&](const size_t chunk) {
+      const auto [first_hn, last_hn] = parallel::chunking::bounds(chunk, num_nodes, node_chunk_size);
+      for ( HypernodeID hn = first_hn; hn < last_hn; ++hn ) {
+        if ( nodeIsEnabled(hn) ) {
+          const PartitionID block = partID(hn);
+          const HypernodeID id = node_offsets[chunk * k + block]++;
+          hn_mapping[hn] = id;
+          block_nodes[block][id] = hn;
+        }
+      }
+      const auto [first_he, last_he] = parallel::chunking::bounds(chunk, num_edges, edge_chunk_size);
+      for ( HyperedgeID he = first_he; he < last_he; ++he ) {
+        if ( edgeIsEnabled(he) ) {
+          for ( const PartitionID block : connectivitySet(he) ) {
+            if ( contains_edge(he, block) ) {
+              block_edges[block][edge_offsets[chunk * k + block]++] = he;
+            }
+          }
+        }
+      }
+    });
+
+    // Construct the hypergraphs of all blocks concurrently
+    vec<Hypergraph> extracted_hypergraphs(k);
+    tbb::parallel_for(0, k, [&](const PartitionID block) {
+      const vec<HypernodeID>& nodes_of_block = block_nodes[block];
+      const vec<HyperedgeID>& edges_of_block = block_edges[block];
+      parallel::scalable_vector<size_t> pin_offsets;
+      vec<HyperedgeWeight> hyperedge_weight;
+      vec<HypernodeWeight> hypernode_weight;
+      tbb::parallel_invoke([&] {
+        pin_offsets.assign(edges_of_block.size() + 1, 0);
+        hyperedge_weight.resize(edges_of_block.size());
+        tbb::parallel_for(UL(0), edges_of_block.size(), [&](const size_t i) {
+          hyperedge_weight[i] = edgeWeight(edges_of_block[i]);
+          pin_offsets[i + 1] = pinCountInPart(edges_of_block[i], block);
+        });
+        parallel_prefix_sum(pin_offsets.begin(), pin_offsets.end(),
+          pin_offsets.begin(), std::plus<size_t>(), UL(0));
+      }, [&] {
+        hypernode_weight.resize(nodes_of_block.size());
+        tbb::parallel_for(UL(0), nodes_of_block.size(), [&](const size_t i) {
+          hypernode_weight[i] = nodeWeight(nodes_of_block[i]);
+        });
+      });
+
+      Array<HypernodeID> incidence_array;
+      incidence_array.resize(pin_offsets.back());
+      tbb::parallel_for(UL(0), edges_of_block.size(), [&](const size_t i) {
+        size_t pos = pin_offsets[i];
+        for ( const HypernodeID& pin : pins(edges_of_block[i]) ) {
+          if ( partID(pin) == block ) {
+            incidence_array[pos++] = hn_mapping[pin];
+          }
+        }
+        ASSERT(pos == pin_offsets[i + 1]);
+      });
+
+      Hypergraph& extracted_hypergraph = extracted_hypergraphs[block];
+      extracted_hypergraph = HypergraphFactory::construct_from_incidence_array(
+        nodes_of_block.size(), edges_of_block.size(), pin_offsets, std::move(incidence_array),
+        hyperedge_weight.data(), hypernode_weight.data(), stable_construction_of_incident_edges);
+      tbb::parallel_for(UL(0), nodes_of_block.size(), [&](const size_t i) {
+        extracted_hypergraph.setCommunityID(i, _hg->communityID(nodes_of_block[i]));
+      });
+    });
+    return std::make_pair(std::move(extracted_hypergraphs), std::move(hn_mapping));
+  }
+
   void freeInternalData() {
     if ( _k > 0 ) {
       tbb::parallel_invoke( [&] {
         parallel::parallel_free(_part_ids, _pin_count_update_ownership);
       }, [&] {
-        parallel::free(_pins_in_part.data());
+        _pins_in_part.freeInternalData();
       }, [&] {
         _connectivity_set.freeInternalData();
       } );
@@ -1063,26 +1607,26 @@ private:
       for (const HypernodeID& u : pins(he)) {
         nodeGainAssertions(u, from);
         if (partID(u) == from) {
-          _gain_cache[penalty_index(u)].fetch_sub(we, std::memory_order_relaxed);
+          _gain_cache.addPenalty(u, -we);
         }
       }
     } else if (pin_count_in_from_part_after == 0) {
       for (const HypernodeID& u : pins(he)) {
         nodeGainAssertions(u, from);
-        _gain_cache[benefit_index(u, from)].fetch_sub(we, std::memory_order_relaxed);
+        _gain_cache.addBenefit(u, from, -we);
       }
     }
 
     if (pin_count_in_to_part_after == 1) {
       for (const HypernodeID& u : pins(he)) {
         nodeGainAssertions(u, to);
-        _gain_cache[benefit_index(u, to)].fetch_add(we, std::memory_order_relaxed);
+        _gain_cache.addBenefit(u, to, we);
       }
     } else if (pin_count_in_to_part_after == 2) {
       for (const HypernodeID& u : pins(he)) {
         nodeGainAssertions(u, to);
         if (partID(u) == to) {
-          _gain_cache[penalty_index(u)].fetch_add(we, std::memory_order_relaxed);
+          _gain_cache.addPenalty(u, we);
         }
       }
     }
@@ -1090,14 +1634,54 @@ private:
 
  private:
 
-  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
-  size_t penalty_index(const HypernodeID u) const {
-    return size_t(u) * ( _k + 1 );
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static PartitionID decodePartID(const PartIDStorage p) {
+    if constexpr ( std::is_same<PartIDStorage, PartitionID>::value ) {
+      return p;
+    } else {
+      return p == std::numeric_limits<PartIDStorage>::max() ? kInvalidPartition : static_cast<PartitionID>(p);
+    }
   }
 
-  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
-  size_t benefit_index(const HypernodeID u, const PartitionID p) const {
-    return size_t(u) * ( _k + 1 )  + p + 1;
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static PartIDStorage encodePartID(const PartitionID p) {
+    // kInvalidPartition (-1) is mapped to the largest value of unsigned storage types
+    return static_cast<PartIDStorage>(p);
+  }
+
+  // ! Adds weight to block p, if its weight does not exceed max_weight afterwards.
+  // ! Unbounded moves use a single fetch_add, bounded moves a compare-and-swap loop
+  // ! that never exceeds the limit (not even temporarily).
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool reservePartWeight(const PartitionID p,
+                                                            const HypernodeWeight weight,
+                                                            const HypernodeWeight max_weight) {
+    if ( max_weight == std::numeric_limits<HypernodeWeight>::max() ) {
+      _part_weights[p].fetch_add(weight, std::memory_order_relaxed);
+      return true;
+    }
+    return _part_weights[p].add_if_at_most(weight, max_weight, std::memory_order_relaxed);
+  }
+
+  void recomputeTrackedObjective() {
+    ASSERT(_tracked_objective);
+    tbb::enumerable_thread_specific<HyperedgeWeight> km1(0);
+    tbb::enumerable_thread_specific<HyperedgeWeight> cut(0);
+    doParallelForAllEdges([&](const HyperedgeID he) {
+      const PartitionID connectivity_of_he = connectivity(he);
+      if ( connectivity_of_he > 1 ) {
+        km1.local() += (connectivity_of_he - 1) * edgeWeight(he);
+        cut.local() += edgeWeight(he);
+      }
+    });
+    _tracked_objective->reset(km1.combine(std::plus<>()), cut.combine(std::plus<>()));
+  }
+
+  void recomputeCutNetIndex() {
+    ASSERT(_cut_net_index);
+    _cut_net_index->reset();
+    doParallelForAllEdges([&](const HyperedgeID he) {
+      if ( connectivity(he) > 1 ) {
+        _cut_net_index->setCut(he);
+      }
+    });
   }
 
   void applyPartWeightUpdates(vec<HypernodeWeight>& part_weight_deltas) {
@@ -1128,14 +1712,50 @@ private:
   void initializePinCountInPart() {
     tls_enumerable_thread_specific< vec<HypernodeID> > ets_pin_count_in_part(_k, 0);
 
-    auto assign = [&](tbb::blocked_range<HyperedgeID>& r) {
+    auto assign = [&](const HyperedgeID first, const HyperedgeID last) {
       vec<HypernodeID>& pin_counts = ets_pin_count_in_part.local();
-      for (HyperedgeID he = r.begin(); he < r.end(); ++he) {
-        if ( edgeIsEnabled(he) ) {
+      for (HyperedgeID he = first; he < last; ++he) {
+        if ( !edgeIsEnabled(he) ) {
+          continue;
+        }
+        const HypernodeID edge_size = edgeSize(he);
+        if ( edge_size == 2 ) {
+          // Two-pin nets (the majority in most graph-like hypergraphs) are
+          // initialized directly from the blocks of both pins
+          HypernodeID pin_of_he[2];
+          size_t i = 0;
           for (const HypernodeID& pin : pins(he)) {
-            ++pin_counts[partID(pin)];
+            pin_of_he[i++] = pin;
+          }
+          const PartitionID p0 = partID(pin_of_he[0]);
+          const PartitionID p1 = partID(pin_of_he[1]);
+          _connectivity_set.add(he, p0);
+          if ( p0 == p1 ) {
+            _pins_in_part.setPinCountInPart(he, p0, 2);
+          } else {
+            _connectivity_set.add(he, p1);
+            _pins_in_part.setPinCountInPart(he, p0, 1);
+            _pins_in_part.setPinCountInPart(he, p1, 1);
           }
+          continue;
+        }
+
+        for (const HypernodeID& pin : pins(he)) {
+          ++pin_counts[partID(pin)];
+        }
 
+        if ( edge_size < static_cast<HypernodeID>(_k) ) {
+          // Only visit the blocks that contain a pin of the hyperedge
+          for (const HypernodeID& pin : pins(he)) {
+            const PartitionID p = partID(pin);
+            if (pin_counts[p] > 0) {
+              ASSERT(pinCountInPart(he, p) == 0);
+              _connectivity_set.add(he, p);
+              _pins_in_part.setPinCountInPart(he, p, pin_counts[p]);
+              pin_counts[p] = 0;
+            }
+          }
+        } else {
           for (PartitionID p = 0; p < _k; ++p) {
             ASSERT(pinCountInPart(he, p) == 0);
             if (pin_counts[p] > 0) {
@@ -1148,7 +1768,13 @@ private:
       }
     };
 
-    tbb::parallel_for(tbb::blocked_range<HyperedgeID>(HyperedgeID(0), initialNumEdges()), assign);
+    // The hyperedges are split into chunks with roughly the same work (pins + min(pins, k))
+    parallel::chunking::WeightedChunks chunks;
+    chunks.build(initialNumEdges(), NUM_WEIGHTED_CHUNKS_PER_THREAD * tbb::this_task_arena::max_concurrency(),
+      [&](const HyperedgeID he) {
+        return edgeIsEnabled(he) ? edgeSize(he) + std::min(edgeSize(he), static_cast<HypernodeID>(_k)) : 0;
+      });
+    chunks.parallelFor(assign);
   }
 
   HypernodeID pinCountInPartRecomputed(const HyperedgeID e, PartitionID p) const {
@@ -1167,7 +1793,7 @@ private:
     ASSERT(u < initialNumNodes(), "Hypernode" << u << "does not exist");
     ASSERT(nodeIsEnabled(u), "Hypernode" << u << "is disabled");
     ASSERT(p != kInvalidPartition && p < _k);
-    ASSERT(benefit_index(u, p) < _gain_cache.size());
+    ASSERT(_gain_cache.isAllocated());
   }
 
   // ! Updates pin count in part using a spinlock.
@@ -1179,6 +1805,11 @@ private:
     _pin_count_update_ownership[he].lock();
     const HypernodeID pin_count_in_from_part_after = decrementPinCountInPartWithoutGainUpdate(he, from);
     const HypernodeID pin_count_in_to_part_after = incrementPinCountInPartWithoutGainUpdate(he, to);
+    if ( _cut_net_index ) {
+      // Must happen while holding the lock such that the state transitions
+      // of a hyperedge are applied in the same order as the pin count updates
+      _cut_net_index->update(he, edgeSize(he), pin_count_in_from_part_after, pin_count_in_to_part_after);
+    }
     _pin_count_update_ownership[he].unlock();
     delta_func(he, edgeWeight(he), edgeSize(he), pin_count_in_from_part_after, pin_count_in_to_part_after);
   }
@@ -1195,6 +1826,113 @@ private:
     return pin_count_after;
   }
 
+  // ! Applies the gain cache updates collected during the uncontraction of a batch. The gain cache
+  // ! entries of the uncontracted vertices and of vertices involved in many of their incident nets
+  // ! are recomputed from the final pin counts. All other entries are updated in one parallel pass
+  // ! over the affected blocks of each net: a vertex replaced by its contraction partner looses the
+  // ! contribution of the net and, if pins joined a block with only one pin before the batch,
+  // ! moving that pin out of the block no longer decreases the connectivity.
+  void updateGainCacheAfterUncontraction(const Batch& batch) {
+    vec<UncontractionGainUpdate>& updates = _uncontraction_gain_updates;
+    size_t num_updates = 0;
+    for ( const vec<UncontractionGainUpdate>& local_updates : _ets_uncontraction_gain_updates ) {
+      num_updates += local_updates.size();
+    }
+    updates.resize(num_updates);
+    size_t pos = 0;
+    for ( vec<UncontractionGainUpdate>& local_updates : _ets_uncontraction_gain_updates ) {
+      std::copy(local_updates.begin(), local_updates.end(), updates.begin() + pos);
+      pos += local_updates.size();
+      local_updates.clear();
+    }
+
+    if ( _recompute_gain_cache_entry.size() == 0 ) {
+      _recompute_gain_cache_entry.setSize(_top_level_num_nodes);
+    }
+
+    // Recompute the entries of all uncontracted vertices ...
+    vec<HypernodeID>& recompute = _recompute_gain_cache_entries;
+    recompute.clear();
+    for ( const Memento& memento : batch ) {
+      _recompute_gain_cache_entry.set(memento.v, true);
+      recompute.push_back(memento.v);
+    }
+    // ... and of the vertices involved in many of their incident nets
+    tbb::parallel_sort(updates.begin(), updates.end(),
+      [&](const UncontractionGainUpdate& lhs, const UncontractionGainUpdate& rhs) {
+        return lhs.u < rhs.u;
+      });
+    for ( size_t i = 0; i < updates.size(); ) {
+      const HypernodeID u = updates[i].u;
+      size_t j = i + 1;
+      while ( j < updates.size() && updates[j].u == u ) { ++j; }
+      if ( !_recompute_gain_cache_entry[u] &&
+           j - i >= GAIN_CACHE_RECOMPUTATION_THRESHOLD * nodeDegree(u) ) {
+        _recompute_gain_cache_entry.set(u, true);
+        recompute.push_back(u);
+      }
+      i = j;
+    }
+
+    // Delta updates for all other vertices (each block of an affected net is processed once)
+    tbb::parallel_sort(updates.begin(), updates.end(),
+      [&](const UncontractionGainUpdate& lhs, const UncontractionGainUpdate& rhs) {
+        return lhs.he < rhs.he || (lhs.he == rhs.he && lhs.block < rhs.block);
+      });
+    tbb::parallel_for(UL(0), updates.size(), [&](const size_t start) {
+      const HyperedgeID he = updates[start].he;
+      const PartitionID block = updates[start].block;
+      if ( start > 0 && updates[start - 1].he == he && updates[start - 1].block == block ) {
+        return;
+      }
+      size_t end = start;
+      HypernodeID num_joined_pins = 0;
+      while ( end < updates.size() && updates[end].he == he && updates[end].block == block ) {
+        num_joined_pins += !updates[end].u_replaced;
+        ++end;
+      }
+
+      const HyperedgeWeight edge_weight = edgeWeight(he);
+      const HypernodeID pin_count_before = pinCountInPart(he, block) - num_joined_pins;
+      for ( size_t i = start; i < end; ++i ) {
+        const HypernodeID u = updates[i].u;
+        if ( updates[i].u_replaced && !_recompute_gain_cache_entry[u] ) {
+          if ( pin_count_before > 1 ) {
+            _gain_cache.addPenalty(u, -edge_weight);
+          }
+          for ( const PartitionID to : _connectivity_set.connectivitySet(he) ) {
+            _gain_cache.addBenefit(u, to, -edge_weight);
+          }
+        }
+      }
+
+      if ( num_joined_pins > 0 && pin_count_before == 1 ) {
+        // The only pin of the block before the batch (if it is still incident to the net)
+        for ( const HypernodeID& pin : pins(he) ) {
+          if ( partID(pin) == block && !_recompute_gain_cache_entry[pin] ) {
+            _gain_cache.addPenalty(pin, edge_weight);
+            break;
+          }
+        }
+      }
+    });
+
+    tbb::parallel_for(UL(0), recompute.size(), [&](const size_t i) {
+      const HypernodeID u = recompute[i];
+      vec<Gain>& benefit_aggregator = _ets_benefit_aggregator.local();
+      if ( benefit_aggregator.size() < static_cast<size_t>(_k) ) {
+        benefit_aggregator.assign(_k, 0);
+      }
+      initializeGainCacheEntry(u, benefit_aggregator);
+      if ( _is_gain_cache_initialized_lazily ) {
+        _valid_gain_cache_entries.set(u, true);
+      }
+    });
+    for ( const HypernodeID u : recompute ) {
+      _recompute_gain_cache_entry.set(u, false);
+    }
+  }
+
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
   HypernodeID incrementPinCountInPartWithoutGainUpdate(const HyperedgeID e, const PartitionID p) {
     ASSERT(e < _hg->initialNumEdges(), "Hyperedge" << e << "does not exist");
@@ -1211,6 +1949,9 @@ private:
   // ! Indicate wheater gain cache is initialized
   bool _is_gain_cache_initialized;
 
+  // ! Indicates whether only the entries in _valid_gain_cache_entries are initialized
+  bool _is_gain_cache_initialized_lazily;
+
   size_t _top_level_num_nodes = 0;
 
   // ! Number of blocks
@@ -1219,11 +1960,13 @@ private:
   // ! Hypergraph object around which this partitioned hypergraph is wrapped
   Hypergraph* _hg = nullptr;
 
-  // ! Weight and information for all blocks.
-  vec< CAtomic<HypernodeWeight> > _part_weights;
+  // ! Weight and information for all blocks. Each weight occupies its own
+  // ! cache line, since moves into different blocks are performed concurrently.
+  vec< PaddedCAtomic<HypernodeWeight> > _part_weights;
 
   // ! Current block IDs of the vertices
-  Array< PartitionID > _part_ids;
+  // ! Block of each vertex (see PartIDStorage)
+  Array< PartIDStorage > _part_ids;
 
   // ! For each hyperedge and each block, _pins_in_part stores the
   // ! number of pins in that block
@@ -1238,11 +1981,29 @@ private:
   // !            = b(u, V_j) - p(u)
   // ! We call b(u, V_j) the benefit term and p(u) the penalty term. Our gain cache stores and maintains these
   // ! entries for each node and block. Thus, the gain cache stores k + 1 entries per node.
-  Array< CAtomic<HyperedgeWeight> > _gain_cache;
+  // ! For large k, only the benefit terms of adjacent blocks are stored (see GainCache).
+  GainCache _gain_cache;
+
+  // ! Gain cache entries that are initialized, if the gain cache is initialized lazily
+  AtomicBitVector _valid_gain_cache_entries;
+
+  // ! Gain cache updates collected during the uncontraction of a batch
+  // ! (see updateGainCacheAfterUncontraction(...))
+  tls_enumerable_thread_specific< vec<UncontractionGainUpdate> > _ets_uncontraction_gain_updates;
+  vec<UncontractionGainUpdate> _uncontraction_gain_updates;
+  AtomicBitVector _recompute_gain_cache_entry;
+  vec<HypernodeID> _recompute_gain_cache_entries;
+  tls_enumerable_thread_specific< vec<Gain> > _ets_benefit_aggregator;
 
   // ! In order to update the pin count of a hyperedge thread-safe, a thread must acquire
   // ! the ownership of a hyperedge via a CAS operation.
   Array<SpinLock> _pin_count_update_ownership;
+
+  // ! Incrementally maintained km1 and cut metric (nullptr, if objective tracking is disabled)
+  std::unique_ptr<TrackedObjective> _tracked_objective;
+
+  // ! Incrementally maintained set of cut hyperedges (nullptr, if cut net tracking is disabled)
+  std::unique_ptr<CutNetIndex> _cut_net_index;
 };
 
 } // namespace ds
@@ -30,6 +30,7 @@
 
 #include <cmath>
 
+#include "tbb/concurrent_unordered_map.h"
 
 #include "mt-kahypar/macros.h"
 #include "mt-kahypar/datastructures/hypergraph_common.h"
@@ -47,6 +48,10 @@ namespace ds {
  * each entry occupies exactly the number of bits it requires to store the
  * maximum value. To do so, we store several pin count entries in a 64-bit unsigned
  * integer.
+ * For large k, storing k entries per hyperedge is not feasible. If k times the bits
+ * per entry exceeds SPARSE_THRESHOLD_BITS, we therefore switch to a sparse
+ * representation that stores NUM_SPARSE_ENTRIES (block, pin count) pairs per hyperedge.
+ * Pin counts of further blocks are spilled to a hash map.
  * Note, this data structure is not thread-safe. Updates of a pin count entry
  * of a hyperedge must be done exclusively. Different hyperedges can be updated
  * concurrently.
@@ -58,6 +63,11 @@ class PinCountInPart {
  public:
   using Value = uint64_t;
 
+  // ! If k times the bits per entry exceeds this threshold, we use the sparse representation
+  static constexpr size_t SPARSE_THRESHOLD_BITS = 4096;
+  // ! Number of (block, pin count) pairs stored per hyperedge in the sparse representation
+  static constexpr size_t NUM_SPARSE_ENTRIES = 8;
+
   PinCountInPart() :
     _num_hyperedges(0),
     _k(0),
@@ -66,7 +76,10 @@ class PinCountInPart {
     _entries_per_value(0),
     _values_per_hyperedge(0),
     _extraction_mask(0),
-    _pin_count_in_part() { }
+    _is_sparse(false),
+    _pin_count_in_part(),
+    _has_spilled_entries(),
+    _spilled_entries() { }
 
   PinCountInPart(const HyperedgeID num_hyperedges,
                  const PartitionID k,
@@ -79,7 +92,10 @@ class PinCountInPart {
     _entries_per_value(0),
     _values_per_hyperedge(0),
     _extraction_mask(0),
-    _pin_count_in_part() {
+    _is_sparse(false),
+    _pin_count_in_part(),
+    _has_spilled_entries(),
+    _spilled_entries() {
     initialize(num_hyperedges, k, max_value, assign_parallel);
   }
 
@@ -94,7 +110,10 @@ class PinCountInPart {
     _entries_per_value(other._entries_per_value),
     _values_per_hyperedge(other._values_per_hyperedge),
     _extraction_mask(other._extraction_mask),
-    _pin_count_in_part(std::move(other._pin_count_in_part)) { }
+    _is_sparse(other._is_sparse),
+    _pin_count_in_part(std::move(other._pin_count_in_part)),
+    _has_spilled_entries(std::move(other._has_spilled_entries)),
+    _spilled_entries(std::move(other._spilled_entries)) { }
 
   PinCountInPart & operator= (PinCountInPart&& other) {
     _num_hyperedges = other._num_hyperedges;
@@ -104,7 +123,10 @@ class PinCountInPart {
     _entries_per_value = other._entries_per_value;
     _values_per_hyperedge = other._values_per_hyperedge;
     _extraction_mask = other._extraction_mask;
+    _is_sparse = other._is_sparse;
     _pin_count_in_part = std::move(other._pin_count_in_part);
+    _has_spilled_entries = std::move(other._has_spilled_entries);
+    _spilled_entries = std::move(other._spilled_entries);
     return *this;
   }
 
@@ -122,13 +144,34 @@ class PinCountInPart {
       _entries_per_value = num_entries_per_value(k, max_value);
       _values_per_hyperedge = num_values_per_hyperedge(k, max_value);
       _extraction_mask = std::pow(2UL, _bits_per_element) - UL(1);
+      _is_sparse = use_sparse_representation(k, max_value);
+      if ( _is_sparse ) {
+        _values_per_hyperedge = NUM_SPARSE_ENTRIES;
+        _has_spilled_entries.resize(num_hyperedges, false, assign_parallel);
+      }
       _pin_count_in_part.resize("Refinement", "pin_count_in_part",
         num_hyperedges * _values_per_hyperedge, true, assign_parallel);
     }
   }
 
-  Array<Value>& data() {
-    return _pin_count_in_part;
+  // ! Returns whether or not the sparse representation is used
+  bool isSparse() const {
+    return _is_sparse;
+  }
+
+  // ! Resets all pin counts to zero
+  void reset() {
+    _pin_count_in_part.assign(_pin_count_in_part.size(), 0);
+    if ( _is_sparse ) {
+      _has_spilled_entries.assign(_has_spilled_entries.size(), false);
+      _spilled_entries.clear();
+    }
+  }
+
+  void freeInternalData() {
+    parallel::free(_pin_count_in_part);
+    parallel::free(_has_spilled_entries);
+    _spilled_entries.clear();
   }
 
   // ! Returns the pin count of the hyperedge in the corresponding block
@@ -136,18 +179,43 @@ class PinCountInPart {
                                     const PartitionID id) const {
     ASSERT(he < _num_hyperedges);
     ASSERT(id != kInvalidPartition && id < _k);
+    if ( _is_sparse ) {
+      return sparsePinCountInPart(he, id);
+    }
     const size_t value_pos = he * _values_per_hyperedge + id / _entries_per_value;
     const size_t bit_pos = (id % _entries_per_value) * _bits_per_element;
     const Value mask = _extraction_mask << bit_pos;
     return (_pin_count_in_part[value_pos] & mask) >> bit_pos;
   }
 
+  // ! Prefetches the pin counts of the hyperedge
+  inline void prefetch(const HyperedgeID he) const {
+    ASSERT(he < _num_hyperedges);
+    MT_KAHYPAR_PREFETCH(_pin_count_in_part.data() +
+      static_cast<size_t>(he) * ( _is_sparse ? NUM_SPARSE_ENTRIES : _values_per_hyperedge ));
+  }
+
+  // ! Returns the number of blocks with a non-zero pin count for a bipartition.
+  // ! Both pin counts of a hyperedge are stored in the same value, which
+  // ! allows us to derive the connectivity with a single memory access.
+  inline PartitionID twoWayConnectivity(const HyperedgeID he) const {
+    ASSERT(he < _num_hyperedges);
+    ASSERT(_k == 2 && !_is_sparse && _entries_per_value == 2);
+    const Value value = _pin_count_in_part[he];
+    return ( ( value & _extraction_mask ) != 0 ) +
+      ( ( ( value >> _bits_per_element ) & _extraction_mask ) != 0 );
+  }
+
   // ! Sets the pin count of the hyperedge in the corresponding block to value
   inline void setPinCountInPart(const HyperedgeID he,
                                 const PartitionID id,
                                 const HypernodeID value) {
     ASSERT(he < _num_hyperedges);
     ASSERT(id != kInvalidPartition && id < _k);
+    if ( _is_sparse ) {
+      setSparsePinCountInPart(he, id, value);
+      return;
+    }
     const size_t value_pos = he * _values_per_hyperedge + id / _entries_per_value;
     const size_t bit_pos = (id % _entries_per_value) * _bits_per_element;
     updateEntry(_pin_count_in_part[value_pos], bit_pos, value);
@@ -158,6 +226,12 @@ class PinCountInPart {
                                              const PartitionID id) {
     ASSERT(he < _num_hyperedges);
     ASSERT(id != kInvalidPartition && id < _k);
+    if ( _is_sparse ) {
+      const HypernodeID pin_count_in_part = sparsePinCountInPart(he, id);
+      ASSERT(pin_count_in_part + 1 <= _max_value);
+      setSparsePinCountInPart(he, id, pin_count_in_part + 1);
+      return pin_count_in_part + 1;
+    }
     const size_t value_pos = he * _values_per_hyperedge + id / _entries_per_value;
     const size_t bit_pos = (id % _entries_per_value) * _bits_per_element;
     const Value mask = _extraction_mask << bit_pos;
@@ -173,6 +247,12 @@ class PinCountInPart {
                                              const PartitionID id) {
     ASSERT(he < _num_hyperedges);
     ASSERT(id != kInvalidPartition && id < _k);
+    if ( _is_sparse ) {
+      const HypernodeID pin_count_in_part = sparsePinCountInPart(he, id);
+      ASSERT(pin_count_in_part > UL(0));
+      setSparsePinCountInPart(he, id, pin_count_in_part - 1);
+      return pin_count_in_part - 1;
+    }
     const size_t value_pos = he * _values_per_hyperedge + id / _entries_per_value;
     const size_t bit_pos = (id % _entries_per_value) * _bits_per_element;
     const Value mask = _extraction_mask << bit_pos;
@@ -185,16 +265,92 @@ class PinCountInPart {
 
   // ! Returns the size in bytes of this data structure
   size_t size_in_bytes() const {
-    return sizeof(Value) * _pin_count_in_part.size();
+    return sizeof(Value) * _pin_count_in_part.size() +
+      sizeof(bool) * _has_spilled_entries.size() +
+      ( sizeof(size_t) + sizeof(HypernodeID) ) * _spilled_entries.size();
   }
 
   static size_t num_elements(const HyperedgeID num_hyperedges,
                              const PartitionID k,
                              const HypernodeID max_value) {
-    return num_hyperedges * num_values_per_hyperedge(k, max_value);
+    return num_hyperedges * ( use_sparse_representation(k, max_value) ?
+      NUM_SPARSE_ENTRIES : num_values_per_hyperedge(k, max_value) );
+  }
+
+  static bool use_sparse_representation(const PartitionID k,
+                                        const HypernodeID max_value) {
+    return static_cast<size_t>(k) * num_bits_per_element(max_value) > SPARSE_THRESHOLD_BITS;
   }
 
  private:
+  // ! In the sparse representation, an entry stores the block ID (plus one) in the
+  // ! upper and the pin count in the lower 32 bits. A zero entry is unused.
+  static constexpr Value SPARSE_PIN_COUNT_MASK = (UL(1) << 32) - 1;
+
+  static Value sparseKey(const PartitionID id) {
+    return static_cast<Value>(id) + 1;
+  }
+
+  size_t spilledEntryKey(const HyperedgeID he, const PartitionID id) const {
+    return static_cast<size_t>(he) * _k + id;
+  }
+
+  inline HypernodeID sparsePinCountInPart(const HyperedgeID he,
+                                          const PartitionID id) const {
+    const Value key = sparseKey(id);
+    const size_t start = he * NUM_SPARSE_ENTRIES;
+    for ( size_t pos = start; pos < start + NUM_SPARSE_ENTRIES; ++pos ) {
+      const Value entry = _pin_count_in_part[pos];
+      if ( ( entry >> 32 ) == key ) {
+        return entry & SPARSE_PIN_COUNT_MASK;
+      }
+    }
+    if ( _has_spilled_entries[he] ) {
+      auto it = _spilled_entries.find(spilledEntryKey(he, id));
+      if ( it != _spilled_entries.end() ) {
+        return it->second;
+      }
+    }
+    return 0;
+  }
+
+  // ! Note, the pin count of a block is either stored in one of the
+  // ! entries of the hyperedge or in the spilled entries, but never in both.
+  inline void setSparsePinCountInPart(const HyperedgeID he,
+                                      const PartitionID id,
+                                      const HypernodeID value) {
+    ASSERT(value <= _max_value);
+    const Value key = sparseKey(id);
+    const size_t start = he * NUM_SPARSE_ENTRIES;
+    size_t free_pos = start + NUM_SPARSE_ENTRIES;
+    for ( size_t pos = start; pos < start + NUM_SPARSE_ENTRIES; ++pos ) {
+      const Value entry = _pin_count_in_part[pos];
+      if ( ( entry >> 32 ) == key ) {
+        _pin_count_in_part[pos] = value > 0 ? ( key << 32 ) | value : 0;
+        return;
+      } else if ( entry == 0 && free_pos == start + NUM_SPARSE_ENTRIES ) {
+        free_pos = pos;
+      }
+    }
+
+    if ( _has_spilled_entries[he] ) {
+      auto it = _spilled_entries.find(spilledEntryKey(he, id));
+      if ( it != _spilled_entries.end() ) {
+        it->second = value;
+        return;
+      }
+    }
+
+    if ( value > 0 ) {
+      if ( free_pos < start + NUM_SPARSE_ENTRIES ) {
+        _pin_count_in_part[free_pos] = ( key << 32 ) | value;
+      } else {
+        _has_spilled_entries[he] = true;
+        _spilled_entries.emplace(spilledEntryKey(he, id), value);
+      }
+    }
+  }
+
   inline void updateEntry(Value& value,
                           const size_t bit_pos,
                           const Value new_value) {
@@ -230,7 +386,10 @@ class PinCountInPart {
   size_t _entries_per_value;
   size_t _values_per_hyperedge;
   Value _extraction_mask;
+  bool _is_sparse;
   Array<Value> _pin_count_in_part;
+  Array<bool> _has_spilled_entries;
+  tbb::concurrent_unordered_map<size_t, HypernodeID> _spilled_entries;
 };
 }  // namespace ds
 }  // namespace mt_kahypar
@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "mt-kahypar/macros.h"
+
+namespace mt_kahypar {
+namespace ds {
+
+// ! Default number of elements that the prefetching iteration helpers look ahead.
+// ! It should cover the memory latency of the prefetched accesses, but should be small
+// ! enough such that prefetched cache lines are not evicted before they are used.
+static constexpr size_t PREFETCH_DISTANCE = 4;
+
+template<typename Iterator, typename = void>
+struct is_random_access_iterator : std::false_type { };
+
+template<typename Iterator>
+struct is_random_access_iterator<Iterator, std::void_t<
+  decltype(std::declval<Iterator>() + 1),
+  decltype(std::declval<Iterator>() - std::declval<Iterator>())>> : std::true_type { };
+
+/*!
+ * Calls f(element) for each element of the range. Before an element is processed,
+ * prefetch(element') is called for the element that is distance positions ahead,
+ * which should issue prefetches for the data-dependent memory accesses of f (e.g.,
+ * the block of a pin). Ranges without random access iterators are iterated without
+ * prefetching.
+ */
+template<size_t distance = PREFETCH_DISTANCE, typename Range, typename Prefetch, typename F>
+MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void forEachWithLookAhead(Range range,
+                                                             const Prefetch& prefetch,
+                                                             const F& f) {
+  using Iterator = std::decay_t<decltype(range.begin())>;
+  if constexpr ( distance > 0 && is_random_access_iterator<Iterator>::value ) {
+    const Iterator first = range.begin();
+    const size_t size = range.end() - first;
+    for ( size_t i = 0; i < std::min(distance, size); ++i ) {
+      prefetch(*(first + i));
+    }
+    for ( size_t i = 0; i < size; ++i ) {
+      if ( i + distance < size ) {
+        prefetch(*(first + (i + distance)));
+      }
+      f(*(first + i));
+    }
+  } else {
+    for ( const auto& element : range ) {
+      f(element);
+    }
+  }
+}
+
+}  // namespace ds
+}  // namespace mt_kahypar
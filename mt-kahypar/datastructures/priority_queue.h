@@ -334,5 +334,332 @@ public:
 template<typename KeyT, typename IdT>
 using MaxHeap = Heap<KeyT, IdT, std::less<KeyT>, 2>;
 
+/*!
+ * Max-priority queue for integer keys in the range [-max_key, max_key], e.g., the
+ * gains of vertex moves, if max_key is the maximum weighted degree of a vertex.
+ * Each key has its own bucket (an intrusive doubly-linked list over the elements).
+ * Thus, insertions, removals and key updates take constant time. The highest
+ * non-empty bucket is maintained lazily. Keys smaller than -max_key share the
+ * lowest bucket (e.g., the gain of a vertex without a feasible target block) and
+ * keys larger than max_key share the highest bucket, where the order is not exact.
+ * Elements with the same key are extracted in LIFO order.
+ * Provides the same interface as Heap and also stores the position of an element
+ * in the external handles.
+ */
+template<typename KeyT, typename IdT>
+class BucketQueue {
+ public:
+  explicit BucketQueue(PosT* positions, size_t positions_size, const KeyT max_key = 0) :
+    elements(),
+    heads(),
+    max_key(0),
+    max_bucket(0),
+    positions(positions),
+    positions_size(positions_size) {
+    setMaxKey(max_key);
+  }
+
+  // ! Changes the range of the keys. The queue must be empty.
+  void setMaxKey(const KeyT key) {
+    assert(empty() && key >= 0);
+    max_key = key;
+    heads.assign(2 * static_cast<size_t>(max_key) + 2, invalid_position);
+    max_bucket = 0;
+  }
+
+  IdT top() const {
+    return elements[heads[topBucket()]].id;
+  }
+
+  KeyT topKey() const {
+    return elements[heads[topBucket()]].key;
+  }
+
+  void deleteTop() {
+    assert(!empty());
+    remove(top());
+  }
+
+  void insert(const IdT e, const KeyT k) {
+    ASSERT(!contains(e));
+    ASSERT(size() < positions_size);
+    const PosT pos = size();
+    positions[e] = pos;
+    elements.push_back({ k, e, invalid_position, invalid_position });
+    link(pos);
+  }
+
+  void remove(const IdT e) {
+    assert(!empty() && contains(e));
+    const PosT pos = positions[e];
+    unlink(pos);
+    const PosT last = size() - 1;
+    if ( pos != last ) {
+      // Move the last element into the gap
+      elements[pos] = elements[last];
+      const Element& moved = elements[pos];
+      positions[moved.id] = pos;
+      if ( moved.prev != invalid_position ) {
+        elements[moved.prev].next = pos;
+      } else {
+        heads[bucket(moved.key)] = pos;
+      }
+      if ( moved.next != invalid_position ) {
+        elements[moved.next].prev = pos;
+      }
+    }
+    elements.pop_back();
+    positions[e] = invalid_position;
+  }
+
+  void increaseKey(const IdT e, const KeyT newKey) {
+    adjustKey(e, newKey);
+  }
+
+  void decreaseKey(const IdT e, const KeyT newKey) {
+    adjustKey(e, newKey);
+  }
+
+  void adjustKey(const IdT e, const KeyT newKey) {
+    assert(contains(e));
+    const PosT pos = positions[e];
+    if ( bucket(elements[pos].key) != bucket(newKey) ) {
+      unlink(pos);
+      elements[pos].key = newKey;
+      link(pos);
+    } else {
+      elements[pos].key = newKey;
+    }
+  }
+
+  KeyT getKey(const IdT e) const {
+    assert(contains(e));
+    return elements[positions[e]].key;
+  }
+
+  void insertOrAdjustKey(const IdT e, const KeyT newKey) {
+    if (contains(e)) {
+      adjustKey(e, newKey);
+    } else {
+      insert(e, newKey);
+    }
+  }
+
+  void clear() {
+    for ( const Element& element : elements ) {
+      heads[bucket(element.key)] = invalid_position;
+    }
+    elements.clear();
+    max_bucket = 0;
+  }
+
+  bool contains(const IdT e) const {
+    assert(fits(e));
+    return positions[e] < elements.size() && elements[positions[e]].id == e;
+  }
+
+  PosT size() const {
+    return static_cast<PosT>(elements.size());
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  KeyT keyAtPos(const PosT pos) const {
+    return elements[pos].key;
+  }
+
+  KeyT keyOf(const IdT id) const {
+    return elements[positions[id]].key;
+  }
+
+  IdT at(const PosT pos) const {
+    return elements[pos].id;
+  }
+
+  void setHandle(PosT* pos, size_t pos_size) {
+    clear();
+    positions = pos;
+    positions_size = pos_size;
+  }
+
+  size_t size_in_bytes() const {
+    return elements.capacity() * sizeof(Element) + heads.capacity() * sizeof(PosT);
+  }
+
+ private:
+  struct Element {
+    KeyT key;
+    IdT id;
+    // ! Neighbors in the bucket list of the element
+    PosT prev;
+    PosT next;
+  };
+
+  bool fits(const IdT id) const {
+    return static_cast<size_t>(id) < positions_size;
+  }
+
+  size_t bucket(const KeyT key) const {
+    if ( key < -max_key ) {
+      return 0;
+    } else if ( key > max_key ) {
+      return heads.size() - 1;
+    }
+    return static_cast<size_t>(key + max_key) + 1;
+  }
+
+  size_t topBucket() const {
+    assert(!empty());
+    while ( heads[max_bucket] == invalid_position ) {
+      --max_bucket;
+    }
+    return max_bucket;
+  }
+
+  void link(const PosT pos) {
+    Element& element = elements[pos];
+    const size_t b = bucket(element.key);
+    element.prev = invalid_position;
+    element.next = heads[b];
+    if ( element.next != invalid_position ) {
+      elements[element.next].prev = pos;
+    }
+    heads[b] = pos;
+    max_bucket = std::max(max_bucket, b);
+  }
+
+  void unlink(const PosT pos) {
+    const Element& element = elements[pos];
+    if ( element.prev != invalid_position ) {
+      elements[element.prev].next = element.next;
+    } else {
+      heads[bucket(element.key)] = element.next;
+    }
+    if ( element.next != invalid_position ) {
+      elements[element.next].prev = element.prev;
+    }
+  }
+
+  vec<Element> elements;
+  // ! First element of each bucket
+  vec<PosT> heads;
+  KeyT max_key;
+  // ! Upper bound for the highest non-empty bucket
+  mutable size_t max_bucket;
+  PosT* positions;
+  size_t positions_size;
+};
+
+/*!
+ * Max-priority queue that uses a BucketQueue, if the keys are in a small range
+ * (see setMaxKey), and a binary MaxHeap otherwise. Both share the external handles.
+ */
+template<typename KeyT, typename IdT>
+class AdaptiveMaxPQ {
+ public:
+  explicit AdaptiveMaxPQ(PosT* positions, size_t positions_size, const KeyT max_key = 0) :
+    use_buckets(max_key > 0),
+    heap(positions, positions_size),
+    buckets(positions, positions_size, max_key) { }
+
+  // ! Uses a bucket queue for keys in [-max_key, max_key], if max_key > 0, and a
+  // ! binary heap otherwise. The queue must be empty.
+  void setMaxKey(const KeyT max_key) {
+    assert(empty());
+    use_buckets = max_key > 0;
+    if ( use_buckets ) {
+      buckets.setMaxKey(max_key);
+    }
+  }
+
+  bool usesBuckets() const {
+    return use_buckets;
+  }
+
+  IdT top() const {
+    return use_buckets ? buckets.top() : heap.top();
+  }
+
+  KeyT topKey() const {
+    return use_buckets ? buckets.topKey() : heap.topKey();
+  }
+
+  void deleteTop() {
+    use_buckets ? buckets.deleteTop() : heap.deleteTop();
+  }
+
+  void insert(const IdT e, const KeyT k) {
+    use_buckets ? buckets.insert(e, k) : heap.insert(e, k);
+  }
+
+  void remove(const IdT e) {
+    use_buckets ? buckets.remove(e) : heap.remove(e);
+  }
+
+  void increaseKey(const IdT e, const KeyT newKey) {
+    use_buckets ? buckets.increaseKey(e, newKey) : heap.increaseKey(e, newKey);
+  }
+
+  void decreaseKey(const IdT e, const KeyT newKey) {
+    use_buckets ? buckets.decreaseKey(e, newKey) : heap.decreaseKey(e, newKey);
+  }
+
+  void adjustKey(const IdT e, const KeyT newKey) {
+    use_buckets ? buckets.adjustKey(e, newKey) : heap.adjustKey(e, newKey);
+  }
+
+  KeyT getKey(const IdT e) const {
+    return use_buckets ? buckets.getKey(e) : heap.getKey(e);
+  }
+
+  void insertOrAdjustKey(const IdT e, const KeyT newKey) {
+    use_buckets ? buckets.insertOrAdjustKey(e, newKey) : heap.insertOrAdjustKey(e, newKey);
+  }
+
+  void clear() {
+    use_buckets ? buckets.clear() : heap.clear();
+  }
+
+  bool contains(const IdT e) const {
+    return use_buckets ? buckets.contains(e) : heap.contains(e);
+  }
+
+  PosT size() const {
+    return use_buckets ? buckets.size() : heap.size();
+  }
+
+  bool empty() const {
+    return size() == 0;
+  }
+
+  KeyT keyAtPos(const PosT pos) const {
+    return use_buckets ? buckets.keyAtPos(pos) : heap.keyAtPos(pos);
+  }
+
+  KeyT keyOf(const IdT id) const {
+    return use_buckets ? buckets.keyOf(id) : heap.keyOf(id);
+  }
+
+  IdT at(const PosT pos) const {
+    return use_buckets ? buckets.at(pos) : heap.at(pos);
+  }
+
+  void setHandle(PosT* pos, size_t pos_size) {
+    heap.setHandle(pos, pos_size);
+    buckets.setHandle(pos, pos_size);
+  }
+
+  size_t size_in_bytes() const {
+    return heap.size_in_bytes() + buckets.size_in_bytes();
+  }
+
+ private:
+  bool use_buckets;
+  MaxHeap<KeyT, IdT> heap;
+  BucketQueue<KeyT, IdT> buckets;
+};
+
 }
 }
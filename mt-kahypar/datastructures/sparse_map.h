@@ -38,6 +38,12 @@
 #include <utility>
 #include <vector>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "kahypar/macros.h"
 #include "kahypar/meta/mandatory.h"
@@ -237,15 +243,153 @@ class SparseMap final : public SparseMapBase<Key, Value, SparseMap<Key, Value> >
   using Base::_size;
 };
 
+/*!
+ * Index structure of a Swiss-table-like hash table. The slots are organized
+ * in groups of GROUP_SIZE slots. Each slot has a control byte that is either
+ * EMPTY or stores the 7 lowest bits of the hash of its key (h2). A lookup
+ * compares the control bytes of a complete group with one SIMD instruction
+ * and only inspects the keys of slots with a matching h2. A slot stores the
+ * index of its element in the dense array of the sparse map.
+ * Each group has a timestamp. A group whose timestamp differs from the current
+ * timestamp of the map is considered empty and its control bytes are reset
+ * lazily on the first insertion. Thus, clearing the map is O(1).
+ * Note, the index does not support deletions and assumes that at least one
+ * slot is empty.
+ */
+template <typename Key = Mandatory>
+class GroupedSparseIndex {
+
+ public:
+  static constexpr size_t GROUP_SIZE = 16;
+  static constexpr size_t NOT_FOUND_MASK = ~(std::numeric_limits<size_t>::max() >> 1); // MSB is set
+  static constexpr uint8_t EMPTY = 0x80;
+
+  GroupedSparseIndex() :
+    _num_groups(0),
+    _group_timestamps(nullptr),
+    _slots(nullptr),
+    _ctrl(nullptr) { }
+
+  // ! Number of bytes required by the index for the given number of slots
+  static size_t size_in_bytes(const size_t capacity) {
+    ASSERT(capacity >= GROUP_SIZE && capacity % GROUP_SIZE == 0);
+    return ( capacity / GROUP_SIZE ) * sizeof(size_t) +
+      capacity * ( sizeof(uint32_t) + sizeof(uint8_t) );
+  }
+
+  // ! Sets up the index on a zero-initialized memory chunk of size_in_bytes(capacity) bytes
+  void setup(uint8_t* data, const size_t capacity) {
+    ASSERT(capacity >= GROUP_SIZE && ( capacity & ( capacity - 1 ) ) == 0);
+    _num_groups = capacity / GROUP_SIZE;
+    _group_timestamps = reinterpret_cast<size_t*>(data);
+    _slots = reinterpret_cast<uint32_t*>(data + _num_groups * sizeof(size_t));
+    _ctrl = data + _num_groups * sizeof(size_t) + capacity * sizeof(uint32_t);
+  }
+
+  void reset() {
+    _num_groups = 0;
+    _group_timestamps = nullptr;
+    _slots = nullptr;
+    _ctrl = nullptr;
+  }
+
+  /*!
+   * Returns the slot of the key or, if the key is not contained, the slot
+   * where it should be inserted with NOT_FOUND_MASK set. The function key_at
+   * returns the key of the element at a position of the dense array.
+   */
+  template<typename KeyAt>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE size_t find(const Key key,
+                                                 const size_t timestamp,
+                                                 const KeyAt& key_at) const {
+    const uint64_t h = hash(key);
+    const uint8_t h2 = h >> 57;
+    size_t group = ( h >> 32 ) & ( _num_groups - 1 );
+    while ( true ) {
+      const size_t first_slot = group * GROUP_SIZE;
+      if ( _group_timestamps[group] != timestamp ) {
+        return first_slot | NOT_FOUND_MASK;
+      }
+      const uint8_t* ctrl = _ctrl + first_slot;
+      for ( uint32_t match = matchByte(ctrl, h2); match; match &= match - 1 ) {
+        const size_t slot = first_slot + __builtin_ctz(match);
+        if ( key_at(_slots[slot]) == key ) {
+          return slot;
+        }
+      }
+      const uint32_t empty = matchEmpty(ctrl);
+      if ( empty ) {
+        return ( first_slot + __builtin_ctz(empty) ) | NOT_FOUND_MASK;
+      }
+      group = ( group + 1 ) & ( _num_groups - 1 );
+    }
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE uint32_t denseIndex(const size_t slot) const {
+    return _slots[slot];
+  }
+
+  // ! Occupies an empty slot returned by find(...)
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void insert(const Key key,
+                                                 const size_t slot,
+                                                 const size_t dense_index,
+                                                 const size_t timestamp) {
+    ASSERT(slot < _num_groups * GROUP_SIZE);
+    ASSERT(dense_index <= std::numeric_limits<uint32_t>::max());
+    const size_t group = slot / GROUP_SIZE;
+    if ( _group_timestamps[group] != timestamp ) {
+      memset(_ctrl + group * GROUP_SIZE, EMPTY, GROUP_SIZE);
+      _group_timestamps[group] = timestamp;
+    }
+    ASSERT(_ctrl[slot] == EMPTY);
+    _ctrl[slot] = hash(key) >> 57;
+    _slots[slot] = dense_index;
+  }
+
+ private:
+  static MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE uint64_t hash(const Key key) {
+    return static_cast<uint64_t>(key) * UINT64_C(0x9E3779B97F4A7C15);
+  }
+
+  // ! Bitmask of all slots of the group whose control byte is equal to b
+  static MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE uint32_t matchByte(const uint8_t* ctrl, const uint8_t b) {
+    #if defined(__SSE2__)
+    const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(b))));
+    #else
+    uint32_t mask = 0;
+    for ( size_t i = 0; i < GROUP_SIZE; ++i ) {
+      mask |= static_cast<uint32_t>(ctrl[i] == b) << i;
+    }
+    return mask;
+    #endif
+  }
+
+  // ! Bitmask of all empty slots of the group (only EMPTY has the MSB set)
+  static MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE uint32_t matchEmpty(const uint8_t* ctrl) {
+    #if defined(__SSE2__)
+    return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)));
+    #else
+    return matchByte(ctrl, EMPTY);
+    #endif
+  }
+
+  size_t _num_groups;
+  size_t* _group_timestamps;
+  uint32_t* _slots;
+  uint8_t* _ctrl;
+};
+
 /*!
  * Sparse map implementation that uses a fixed size.
  * In contrast to the implementation in KaHyPar (see kahypar/datastructure/sparse_map.h),
  * which uses as size the cardinality of the key universe, hash collisions have to be handled
- * explicitly. Hash collisions are resolved with linear probing.
+ * explicitly. Hash collisions are resolved with linear probing over groups of
+ * slots (see GroupedSparseIndex).
  * Advantage of the implementation is that it uses significantly less space than the
  * version in KaHyPar and should be therefore more cache-efficient.
  * Note, there is no fallback strategy if all slots of the sparse map are occupied by an
- * element. Please make sure that no more than MAP_SIZE elements are inserted into the
+ * element. Please make sure that less than MAP_SIZE elements are inserted into the
  * sparse map. Otherwise, the behavior is undefined.
  */
 template <typename Key = Mandatory,
@@ -257,14 +401,12 @@ class FixedSizeSparseMap {
     Value value;
   };
 
-  struct SparseElement {
-    MapElement* element;
-    size_t timestamp;
-  };
+  using Index = GroupedSparseIndex<Key>;
+  static constexpr size_t NOT_FOUND_MASK = Index::NOT_FOUND_MASK;
 
  public:
 
-  static constexpr size_t MAP_SIZE = 32768; // Size of sparse map is approx. 1 MB
+  static constexpr size_t MAP_SIZE = 32768; // Size of sparse map is approx. 0.5 MB
 
   static_assert(MAP_SIZE && ((MAP_SIZE & (MAP_SIZE - 1)) == UL(0)), "Size of map is not a power of two!");
 
@@ -274,7 +416,7 @@ class FixedSizeSparseMap {
     _data(nullptr),
     _size(0),
     _timestamp(1),
-    _sparse(nullptr),
+    _index(),
     _dense(nullptr) {
     allocate(MAP_SIZE);
   }
@@ -286,7 +428,7 @@ class FixedSizeSparseMap {
     _data(nullptr),
     _size(0),
     _timestamp(1),
-    _sparse(nullptr),
+    _index(),
     _dense(nullptr) {
     allocate(max_size);
   }
@@ -300,10 +442,10 @@ class FixedSizeSparseMap {
     _data(std::move(other._data)),
     _size(other._size),
     _timestamp(other._timestamp),
-    _sparse(std::move(other._sparse)),
+    _index(other._index),
     _dense(std::move(other._dense)) {
     other._data = nullptr;
-    other._sparse = nullptr;
+    other._index.reset();
     other._dense = nullptr;
   }
 
@@ -341,25 +483,24 @@ class FixedSizeSparseMap {
   }
 
   bool contains(const Key key) const {
-    SparseElement* s = find(key);
-    return containsValidElement(key, s);
+    return find(key) < NOT_FOUND_MASK;
   }
 
   Value& operator[] (const Key key) {
-    SparseElement* s = find(key);
-    if ( containsValidElement(key, s) ) {
-      ASSERT(s->element);
-      return s->element->value;
+    const size_t slot = find(key);
+    if ( slot < NOT_FOUND_MASK ) {
+      return _dense[_index.denseIndex(slot)].value;
     } else {
-      return addElement(key, _initial_value, s)->value;
+      return addElement(key, _initial_value, slot & ~NOT_FOUND_MASK)->value;
     }
   }
 
   const Value & get(const Key key) const {
     ASSERT(contains(key));
-    return find(key)->element->value;
+    return _dense[_index.denseIndex(find(key))].value;
   }
 
+  // ! Clearing the map is O(1), the groups of the index are reset lazily
   void clear() {
     _size = 0;
     ++_timestamp;
@@ -369,52 +510,38 @@ class FixedSizeSparseMap {
     _size = 0;
     _timestamp = 0;
     _data = nullptr;
-    _sparse = nullptr;
+    _index.reset();
     _dense = nullptr;
   }
 
  private:
-  inline SparseElement* find(const Key key) const {
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE size_t find(const Key key) const {
     ASSERT(_size < _map_size);
-    size_t hash = key & ( _map_size - 1 );
-    while ( _sparse[hash].timestamp == _timestamp ) {
-      ASSERT(_sparse[hash].element);
-      if ( _sparse[hash].element->key == key ) {
-        return &_sparse[hash];
-      }
-      hash = (hash + 1) & ( _map_size - 1 );
-    }
-    return &_sparse[hash];
-  }
-
-  inline bool containsValidElement(const Key key,
-                                   const SparseElement* s) const {
-    unused(key);
-    ASSERT(s);
-    const bool is_contained = s->timestamp == _timestamp;
-    ASSERT(!is_contained || s->element->key == key);
-    return is_contained;
+    return _index.find(key, _timestamp, [&](const size_t pos) {
+      return _dense[pos].key;
+    });
   }
 
   inline MapElement* addElement(const Key key,
                                 const Value value,
-                                SparseElement* s) {
-    ASSERT(find(key) == s);
+                                const size_t slot) {
+    ASSERT(find(key) == ( slot | NOT_FOUND_MASK ));
     _dense[_size] = MapElement { key, value };
-    *s = SparseElement { &_dense[_size++], _timestamp };
-    return s->element;
+    _index.insert(key, slot, _size, _timestamp);
+    return &_dense[_size++];
   }
 
   void allocate(const size_t size) {
     if ( _data == nullptr ) {
-      _map_size = align_to_next_power_of_two(size);
-      _data = std::make_unique<uint8_t[]>(
-        _map_size * sizeof(MapElement) + _map_size * sizeof(SparseElement));
+      _map_size = align_to_next_power_of_two(std::max(size, Index::GROUP_SIZE));
+      const size_t index_size = Index::size_in_bytes(_map_size);
+      const size_t alloc_size = index_size + _map_size * sizeof(MapElement);
+      _data = std::make_unique<uint8_t[]>(alloc_size);
       _size = 0;
       _timestamp = 1;
-      _sparse = reinterpret_cast<SparseElement*>(_data.get());
-      _dense = reinterpret_cast<MapElement*>(_data.get() +  + sizeof(SparseElement) * _map_size);
-      memset(_data.get(), 0, _map_size * (sizeof(MapElement) + sizeof(SparseElement)));
+      _index.setup(_data.get(), _map_size);
+      _dense = reinterpret_cast<MapElement*>(_data.get() + index_size);
+      memset(_data.get(), 0, alloc_size);
     }
 
   }
@@ -429,10 +556,101 @@ class FixedSizeSparseMap {
 
   size_t _size;
   size_t _timestamp;
-  SparseElement* _sparse;
+  Index _index;
   MapElement* _dense;
 };
 
+/*!
+ * Sparse map for a small number of elements that stores its elements inline
+ * (no heap allocation). Elements are found with a linear scan over the
+ * dense array, which is faster than hashing if only a few elements are stored.
+ * Note, there is no fallback strategy if more than MAP_SIZE elements are
+ * inserted into the map. Otherwise, the behavior is undefined.
+ */
+template <typename Key = Mandatory,
+          typename Value = Mandatory,
+          size_t Capacity = 32>
+class SmallSparseMap {
+
+  struct MapElement {
+    Key key;
+    Value value;
+  };
+
+ public:
+  static constexpr size_t MAP_SIZE = Capacity;
+
+  explicit SmallSparseMap(const Value initial_value) :
+    _initial_value(initial_value),
+    _size(0) { }
+
+  SmallSparseMap(const SmallSparseMap&) = delete;
+  SmallSparseMap& operator= (const SmallSparseMap& other) = delete;
+
+  size_t capacity() const {
+    return MAP_SIZE;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  const MapElement* begin() const {
+    return _dense;
+  }
+
+  const MapElement* end() const {
+    return _dense + _size;
+  }
+
+  MapElement* begin() {
+    return _dense;
+  }
+
+  MapElement* end() {
+    return _dense + _size;
+  }
+
+  bool contains(const Key key) const {
+    return find(key) < _size;
+  }
+
+  Value& operator[] (const Key key) {
+    const size_t pos = find(key);
+    if ( pos < _size ) {
+      return _dense[pos].value;
+    } else {
+      ASSERT(_size < MAP_SIZE);
+      _dense[_size] = MapElement { key, _initial_value };
+      return _dense[_size++].value;
+    }
+  }
+
+  const Value & get(const Key key) const {
+    ASSERT(contains(key));
+    return _dense[find(key)].value;
+  }
+
+  void clear() {
+    _size = 0;
+  }
+
+ private:
+  // ! Returns the position of the key in the dense array or _size if not contained
+  inline size_t find(const Key key) const {
+    for ( size_t i = 0; i < _size; ++i ) {
+      if ( _dense[i].key == key ) {
+        return i;
+      }
+    }
+    return _size;
+  }
+
+  const Value _initial_value;
+  size_t _size;
+  MapElement _dense[MAP_SIZE];
+};
+
 
 template <typename Key = Mandatory,
           typename Value = Mandatory,
@@ -469,7 +687,7 @@ class DynamicMapBase {
 
   void initialize(const size_t capacity) {
     _size = 0;
-    _capacity = align_to_next_power_of_two(capacity);
+    _capacity = align_to_next_power_of_two(std::max(capacity, INITIAL_CAPACITY));
     _timestamp = 1;
     const size_t alloc_size = static_cast<const Derived*>(this)->size_in_bytes();
     _data = std::make_unique<uint8_t[]>(alloc_size);
@@ -558,20 +776,19 @@ class DynamicSparseMap final : public DynamicMapBase<Key, Value, DynamicSparseMa
     Value value;
   };
 
-  struct SparseElement {
-    MapElement* element;
-    size_t timestamp;
-  };
-
+  using Index = GroupedSparseIndex<Key>;
   using Base = DynamicMapBase<Key, Value, DynamicSparseMap<Key, Value>>;
   using Base::INVALID_POS_MASK;
 
+  static_assert(Base::INITIAL_CAPACITY >= Index::GROUP_SIZE, "Initial capacity is smaller than a group");
+  static_assert(INVALID_POS_MASK == Index::NOT_FOUND_MASK, "Position masks do not match");
+
   friend Base;
 
  public:
   explicit DynamicSparseMap() :
     Base(),
-    _sparse(nullptr),
+    _index(),
     _dense(nullptr) {
     Base::initialize(_capacity);
   }
@@ -604,42 +821,36 @@ class DynamicSparseMap final : public DynamicMapBase<Key, Value, DynamicSparseMa
     _size = 0;
     _timestamp = 0;
     _data = nullptr;
-    _sparse = nullptr;
+    _index.reset();
     _dense = nullptr;
   }
 
   size_t size_in_bytes() const {
-    return _capacity * (sizeof(SparseElement) + sizeof(MapElement));
+    return Index::size_in_bytes(_capacity) + _capacity * sizeof(MapElement);
   }
 
  private:
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE size_t findImpl(const Key key) const {
-    size_t hash = key & (_capacity - 1);
-    while ( _sparse[hash].timestamp == _timestamp ) {
-      if ( _sparse[hash].element->key == key ) {
-        return hash;
-      }
-      hash = (hash + 1) & (_capacity - 1);
-    }
-    return hash | INVALID_POS_MASK;
+    return _index.find(key, _timestamp, [&](const size_t pos) {
+      return _dense[pos].key;
+    });
   }
 
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE Value& valueAtPos(const size_t pos) const {
     ASSERT(pos < _capacity);
-    ASSERT(_sparse[pos].timestamp == _timestamp);
-    return _sparse[pos].element->value;
+    return _dense[_index.denseIndex(pos)].value;
   }
 
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE Value& addElementImpl(const Key key, const Value value, const size_t pos) {
     ASSERT(pos < _capacity);
     _dense[_size] = MapElement { key, value };
-    _sparse[pos] = SparseElement { &_dense[_size++], _timestamp };
-    return _sparse[pos].element->value;
+    _index.insert(key, pos, _size, _timestamp);
+    return _dense[_size++].value;
   }
 
   void initializeImpl() {
-    _sparse = reinterpret_cast<SparseElement*>(_data.get());
-    _dense = reinterpret_cast<MapElement*>(_data.get() + sizeof(SparseElement) * _capacity);
+    _index.setup(_data.get(), _capacity);
+    _dense = reinterpret_cast<MapElement*>(_data.get() + Index::size_in_bytes(_capacity));
   }
 
   void rehashImpl(const uint8_t* old_data_begin,
@@ -647,7 +858,7 @@ class DynamicSparseMap final : public DynamicMapBase<Key, Value, DynamicSparseMa
                   const size_t old_capacity,
                   const size_t) {
     const MapElement* elements = reinterpret_cast<const MapElement*>(
-      old_data_begin + sizeof(SparseElement) * old_capacity);
+      old_data_begin + Index::size_in_bytes(old_capacity));
     for (size_t i = 0; i < old_size; ++i ) {
       const size_t pos = findImpl(elements[i].key) & ~INVALID_POS_MASK;
       addElementImpl(elements[i].key, elements[i].value, pos);
@@ -661,7 +872,7 @@ class DynamicSparseMap final : public DynamicMapBase<Key, Value, DynamicSparseMa
   using Base::_timestamp;
   using Base::_data;
 
-  SparseElement* _sparse;
+  Index _index;
   MapElement* _dense;
 };
 
@@ -0,0 +1,258 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Lars Gottesbüren <lars.gottesbueren@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <iterator>
+#include <type_traits>
+#include <boost/range/irange.hpp>
+
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/enumerable_thread_specific.h>
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/datastructures/array.h"
+#include "mt-kahypar/datastructures/graph.h"
+#include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/datastructures/static_hypergraph.h"
+#include "mt-kahypar/partition/context_enum_classes.h"
+#include "mt-kahypar/utils/range.h"
+
+namespace mt_kahypar {
+namespace ds {
+
+/*!
+ * Implicit bipartite star-expansion graph of a static hypergraph. The view provides
+ * the same interface as ds::Graph, but the arcs are computed on the fly from the
+ * incident nets and pins of the hypergraph. Node IDs in [0, |V|) are the hypernodes
+ * and node IDs in [|V|, |V| + |E|) are the hyperedges. The arcs and their weights
+ * are the same (and in the same order) as in the materialized ds::Graph. Only the
+ * node volumes are stored explicitly. Contracting the view yields a ds::Graph.
+ */
+class StarExpansionView {
+
+  static_assert(std::is_same<HypernodeID, HyperedgeID>::value,
+                "Incident nets and pins must be stored in the same array type");
+  using IDIterator = std::remove_const_t<typename StaticHypergraph::IncidenceIterator>;
+
+ public:
+  // ! Iterator over the arcs of a node. Dereferencing it computes the arc.
+  class ArcIterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Arc;
+    using reference = Arc;
+    using pointer = const Arc*;
+    using difference_type = std::ptrdiff_t;
+
+    ArcIterator(const StarExpansionView* view, const NodeID source, const IDIterator& pos) :
+      _view(view),
+      _source(source),
+      _pos(pos) { }
+
+    Arc operator*() const {
+      return _view->arc(_source, *_pos);
+    }
+
+    ArcIterator& operator++() {
+      ++_pos;
+      return *this;
+    }
+
+    ArcIterator operator+(const difference_type n) const {
+      return ArcIterator(_view, _source, _pos + n);
+    }
+
+    bool operator==(const ArcIterator& other) const {
+      return _pos == other._pos;
+    }
+
+    bool operator!=(const ArcIterator& other) const {
+      return _pos != other._pos;
+    }
+
+   private:
+    const StarExpansionView* _view;
+    NodeID _source;
+    IDIterator _pos;
+  };
+
+  using AdjacenceIterator = ArcIterator;
+
+  StarExpansionView(const StaticHypergraph& hypergraph, const LouvainEdgeWeight edge_weight_type) :
+    _hg(hypergraph),
+    _edge_weight_type(edge_weight_type),
+    _num_hypernodes(hypergraph.initialNumNodes()),
+    _num_nodes(hypergraph.initialNumNodes() + hypergraph.initialNumEdges()),
+    _num_arcs(2 * hypergraph.initialNumPins()),
+    _total_volume(0),
+    _max_degree(0),
+    _node_volumes() {
+    if ( edge_weight_type != LouvainEdgeWeight::uniform &&
+         edge_weight_type != LouvainEdgeWeight::non_uniform &&
+         edge_weight_type != LouvainEdgeWeight::degree ) {
+      ERR("No valid louvain edge weight");
+    }
+    _node_volumes.resize("Preprocessing", "node_volumes", _num_nodes);
+
+    // same summation order as in ds::Graph, such that both have the same volumes
+    tbb::enumerable_thread_specific<size_t> local_max_degree(0);
+    tbb::parallel_for(0U, static_cast<NodeID>(_num_nodes), [&](const NodeID u) {
+      ArcWeight volume = 0.0;
+      for ( const Arc& arc : arcsOf(u) ) {
+        volume += arc.weight;
+      }
+      _node_volumes[u] = volume;
+      local_max_degree.local() = std::max(local_max_degree.local(), degree(u));
+    });
+    _max_degree = local_max_degree.combine([&](const size_t& lhs, const size_t& rhs) {
+      return std::max(lhs, rhs);
+    });
+
+    auto aggregate_volume = [&](const tbb::blocked_range<NodeID>& r, ArcWeight partial_volume) -> ArcWeight {
+      for (NodeID u = r.begin(); u < r.end(); ++u) {
+        partial_volume += nodeVolume(u);
+      }
+      return partial_volume;
+    };
+    auto r = tbb::blocked_range<NodeID>(0U, numNodes(), 1000);
+    _total_volume = tbb::parallel_deterministic_reduce(r, 0.0, aggregate_volume, std::plus<>());
+  }
+
+  StarExpansionView(const StarExpansionView&) = delete;
+  StarExpansionView& operator= (const StarExpansionView&) = delete;
+
+  // ! Number of nodes in the graph
+  size_t numNodes() const {
+    return _num_nodes;
+  }
+
+  // ! Number of arcs in the graph
+  size_t numArcs() const {
+    return _num_arcs;
+  }
+
+  // ! Iterator over all nodes of the graph
+  auto nodes() const {
+    return boost::irange<NodeID>(0, static_cast<NodeID>(numNodes()));
+  }
+
+  // ! Iterator over all adjacent vertices of u
+  // ! If 'n' is set, then only an iterator over the first n elements is returned
+  IteratorRange<ArcIterator> arcsOf(const NodeID u,
+                                    const size_t n = std::numeric_limits<size_t>::max()) const {
+    ASSERT(u < _num_nodes);
+    auto ids = isHypernode(u) ? _hg.incidentEdges(u) : _hg.pins(u - _num_hypernodes);
+    const IDIterator first = ids.begin();
+    return IteratorRange<ArcIterator>(ArcIterator(this, u, first),
+      ArcIterator(this, u, first + std::min(n, degree(u))));
+  }
+
+  // ! Degree of vertex u
+  size_t degree(const NodeID u) const {
+    ASSERT(u < _num_nodes);
+    return isHypernode(u) ? _hg.nodeDegree(u) : _hg.edgeSize(u - _num_hypernodes);
+  }
+
+  // ! Maximum degree of a vertex
+  size_t max_degree() const {
+    return _max_degree;
+  }
+
+  // ! Total Volume of the graph
+  ArcWeight totalVolume() const {
+    return _total_volume;
+  }
+
+  // ! Node volume of vertex u
+  ArcWeight nodeVolume(const NodeID u) const {
+    ASSERT(u < _num_nodes);
+    return _node_volumes[u];
+  }
+
+  // ! Projects the clustering of the star-expansion to the hypergraph
+  void restrictClusteringToHypernodes(const StaticHypergraph& hg, ds::Clustering& C) const {
+    C.resize(hg.initialNumNodes());
+  }
+
+  bool canBeUsed(const bool = true) const {
+    return true;
+  }
+
+  /*!
+   * Contracts the star-expansion based on the community structure passed as argument.
+   * The view does not own memory that the coarse graph could reuse. Thus, the low memory
+   * contraction is always used and the coarse graph is materialized.
+   */
+  Graph contract(Clustering& communities, bool low_memory);
+
+ private:
+  bool isHypernode(const NodeID u) const {
+    return u < _num_hypernodes;
+  }
+
+  // ! Arc from source to the node represented by id (an incident net or a pin of source)
+  Arc arc(const NodeID source, const HypernodeID id) const {
+    if ( isHypernode(source) ) {
+      return Arc(id + _num_hypernodes, arcWeight(id, _hg.nodeDegree(source)));
+    } else {
+      return Arc(id, arcWeight(source - _num_hypernodes, _hg.nodeDegree(id)));
+    }
+  }
+
+  ArcWeight arcWeight(const HyperedgeID he, const HyperedgeID node_degree) const {
+    const HyperedgeWeight edge_weight = _hg.edgeWeight(he);
+    switch ( _edge_weight_type ) {
+      case LouvainEdgeWeight::non_uniform:
+        return static_cast<ArcWeight>(edge_weight) /
+               static_cast<ArcWeight>(_hg.edgeSize(he));
+      case LouvainEdgeWeight::degree:
+        return static_cast<ArcWeight>(edge_weight) *
+               (static_cast<ArcWeight>(node_degree) /
+                static_cast<ArcWeight>(_hg.edgeSize(he)));
+      default:
+        return static_cast<ArcWeight>(edge_weight);
+    }
+  }
+
+  const StaticHypergraph& _hg;
+  const LouvainEdgeWeight _edge_weight_type;
+  const HypernodeID _num_hypernodes;
+  // ! Number of nodes
+  size_t _num_nodes;
+  // ! Number of arcs
+  size_t _num_arcs;
+  // ! Total volume of the graph (= sum of arc weights)
+  ArcWeight _total_volume;
+  // ! Maximum degree of a node
+  size_t _max_degree;
+  // ! Node Volumes (= sum of arc weights for each node)
+  ds::Array<ArcWeight> _node_volumes;
+};
+
+}  // namespace ds
+}  // namespace mt_kahypar
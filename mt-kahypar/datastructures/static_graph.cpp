@@ -29,6 +29,8 @@
 #include "static_graph.h"
 
 #include "mt-kahypar/parallel/parallel_prefix_sum.h"
+#include "mt-kahypar/parallel/parallel_radix_sort.h"
+#include "mt-kahypar/parallel/tbb_initializer.h"
 #include "mt-kahypar/datastructures/concurrent_bucket_map.h"
 #include "mt-kahypar/utils/timer.h"
 #include "mt-kahypar/utils/memory_tree.h"
@@ -46,7 +48,8 @@ namespace mt_kahypar::ds {
    *
    * \param communities Community structure that should be contracted
    */
-  StaticGraph StaticGraph::contract(parallel::scalable_vector<HypernodeID>& communities) {
+  StaticGraph StaticGraph::contract(parallel::scalable_vector<HypernodeID>& communities,
+                                    const bool) {
     ASSERT(communities.size() == _num_nodes);
 
     if ( !_tmp_contraction_buffer ) {
@@ -164,20 +167,29 @@ namespace mt_kahypar::ds {
 
     // #################### STAGE 3 ####################
     // In this step, we deduplicate parallel edges. To this end, the incident edges
-    // of each vertex are sorted and aggregated. However, there is a special treatment
-    // for vertices with extremely high degree, as they might become a bottleneck
-    // otherwise. Afterwards, for all parallel edges all but one are invalidated and
-    // the weight of the remaining edge is set to the sum of the weights.
-
-    // A list of high degree vertices that are processed afterwards
-    parallel::scalable_vector<HypernodeID> high_degree_vertices;
-    std::mutex high_degree_vertex_mutex;
+    // of each vertex are sorted and aggregated. However, sorting the incident edges
+    // of a vertex with extremely high degree becomes a sequential bottleneck. If such
+    // a vertex exists, we semisort all edges by (source, target) with a parallel radix
+    // sort instead and reduce runs of parallel edges, which balances the work independent
+    // of the degree distribution. Afterwards, for all parallel edges all but one are
+    // invalidated and the weight of the remaining edge is set to the sum of the weights.
+    const size_t max_tmp_degree = tbb::parallel_reduce(
+      tbb::blocked_range<HypernodeID>(ID(0), coarsened_num_nodes), UL(0),
+      [&](const tbb::blocked_range<HypernodeID>& range, size_t max_degree) {
+        for ( HypernodeID coarse_node = range.begin(); coarse_node < range.end(); ++coarse_node ) {
+          const size_t incident_edges_start = tmp_incident_edges_prefix_sum[coarse_node];
+          const size_t incident_edges_end = tmp_incident_edges_prefix_sum[coarse_node + 1];
+          max_degree = std::max(max_degree, incident_edges_end - incident_edges_start);
+        }
+        return max_degree;
+      }, [](const size_t lhs, const size_t rhs) { return std::max(lhs, rhs); });
+    const bool sort_based_aggregation = max_tmp_degree > HIGH_DEGREE_CONTRACTION_THRESHOLD;
+
     tbb::parallel_for(ID(0), coarsened_num_nodes, [&](const HypernodeID& coarse_node) {
-      // Remove duplicates
       const size_t incident_edges_start = tmp_incident_edges_prefix_sum[coarse_node];
-      const size_t incident_edges_end = tmp_incident_edges_prefix_sum[coarse_node + 1];
-      const size_t tmp_degree = incident_edges_end - incident_edges_start;
-      if (tmp_degree <= std::max(coarsened_num_nodes, HIGH_DEGREE_CONTRACTION_THRESHOLD)) {
+      if ( !sort_based_aggregation ) {
+        // Remove duplicates
+        const size_t incident_edges_end = tmp_incident_edges_prefix_sum[coarse_node + 1];
         std::sort(tmp_edges.begin() + incident_edges_start, tmp_edges.begin() + incident_edges_end,
                   [](const TmpEdgeInformation& e1, const TmpEdgeInformation& e2) {
                     return e1._target < e2._target;
@@ -228,68 +240,70 @@ namespace mt_kahypar::ds {
         const bool is_non_empty = (incident_edges_start < incident_edges_end) && tmp_edges[valid_edge_index].isValid();
         const HyperedgeID contracted_size = is_non_empty ? (valid_edge_index - incident_edges_start + 1) : 0;
         node_sizes[coarse_node] = contracted_size;
-      } else {
-        std::lock_guard<std::mutex> lock(high_degree_vertex_mutex);
-        high_degree_vertices.push_back(coarse_node);
       }
       tmp_nodes[coarse_node].setWeight(node_weights[coarse_node]);
       tmp_nodes[coarse_node].setFirstEntry(incident_edges_start);
     });
 
-    if ( !high_degree_vertices.empty() ) {
-      // High degree vertices are treated special, because sorting and afterwards
-      // removing duplicates can become a major sequential bottleneck. Therefore,
-      // we sum the parallel incident edges of a high degree vertex using an atomic
-      // vector. Then, the index is calculated with a prefix sum.
-      parallel::scalable_vector<parallel::IntegralAtomicWrapper<HyperedgeWeight>> summed_edge_weights_for_target;
-      summed_edge_weights_for_target.assign(coarsened_num_nodes, parallel::IntegralAtomicWrapper<HyperedgeWeight>(0));
-      parallel::scalable_vector<parallel::IntegralAtomicWrapper<HyperedgeID>> min_edge_id_for_target;
-      min_edge_id_for_target.assign(coarsened_num_nodes,
-        parallel::IntegralAtomicWrapper<HyperedgeID>(std::numeric_limits<HyperedgeID>::max()));
-      parallel::scalable_vector<HyperedgeID> incident_edges_inclusion;
-      incident_edges_inclusion.assign(coarsened_num_nodes, 0);
-      for ( const HypernodeID& coarse_node : high_degree_vertices ) {
+    if ( sort_based_aggregation ) {
+      // The source is the most significant part of the key. Thus, the sorted edges of each
+      // coarse vertex remain in its range of the temporary edge array. Invalid edges have
+      // target coarsened_num_nodes and are therefore sorted to the end of each range.
+      struct SortableEdge {
+        HypernodeID source;
+        TmpEdgeInformation edge;
+      };
+      const size_t num_tasks = TBBInitializer::instance().total_number_of_threads();
+      const size_t num_tmp_edges = tmp_incident_edges_prefix_sum.total_sum();
+      vec<SortableEdge> sorted_edges(num_tmp_edges);
+      vec<SortableEdge> buffer;
+      tbb::parallel_for(ID(0), coarsened_num_nodes, [&](const HypernodeID& coarse_node) {
         const size_t incident_edges_start = tmp_incident_edges_prefix_sum[coarse_node];
         const size_t incident_edges_end = tmp_incident_edges_prefix_sum[coarse_node + 1];
-
-        // sum edge weights for each target node and calculate id
         tbb::parallel_for(incident_edges_start, incident_edges_end, [&](const size_t pos) {
-          TmpEdgeInformation& edge = tmp_edges[pos];
-          if (edge.isValid()) {
-            const HyperedgeID target = edge.getTarget();
-            const HyperedgeID id = edge.getID();
-            summed_edge_weights_for_target[target].fetch_add(edge.getWeight());
-            HyperedgeID expected = min_edge_id_for_target[target].load();
-            while (id < expected) {
-              min_edge_id_for_target[target].compare_exchange_weak(expected, id);
-            }
-          }
-        });
-
-        // each edge with weight greater than zero is included
-        tbb::parallel_for(ID(0), coarsened_num_nodes, [&](const size_t target) {
-          bool include = summed_edge_weights_for_target[target].load() > 0;
-          incident_edges_inclusion[target] = include ? 1 : 0;
+          sorted_edges[pos] = SortableEdge { coarse_node, tmp_edges[pos] };
         });
+      });
 
-        // calculate relative index of edges via prefix sum
-        parallel::TBBPrefixSum<HyperedgeID, parallel::scalable_vector> incident_edges_pos(incident_edges_inclusion);
-        tbb::parallel_scan(tbb::blocked_range<size_t>(ID(0), static_cast<size_t>(coarsened_num_nodes)), incident_edges_pos);
-
-        // insert edges
-        tbb::parallel_for(ID(0), coarsened_num_nodes, [&](const size_t target) {
-          const HyperedgeWeight weight = summed_edge_weights_for_target[target].load();
-          if (weight > 0) {
-            const HyperedgeID id = min_edge_id_for_target[target].load();
-            tmp_edges[incident_edges_start + incident_edges_pos[target]] = TmpEdgeInformation(target, weight, id);
-            summed_edge_weights_for_target[target].store(0);
-            min_edge_id_for_target[target].store(std::numeric_limits<HyperedgeID>::max());
+      auto get_key = [&](const SortableEdge& e) -> uint64_t {
+        const HypernodeID target = e.edge.isValid() ? e.edge.getTarget() : coarsened_num_nodes;
+        return static_cast<uint64_t>(e.source) * (coarsened_num_nodes + 1) + target;
+      };
+      const uint64_t max_key = static_cast<uint64_t>(coarsened_num_nodes + 1) * (coarsened_num_nodes + 1) - 1;
+      parallel::radix_sort(sorted_edges, buffer, max_key, get_key, num_tasks);
+
+      // The first valid edge of each run of parallel edges remains in the coarse graph. Its
+      // position in the range of the source is the number of runs before it in that range.
+      vec<HyperedgeID> run_heads(num_tmp_edges, 0);
+      tbb::parallel_for(UL(0), num_tmp_edges, [&](const size_t pos) {
+        run_heads[pos] = sorted_edges[pos].edge.isValid() &&
+          ( pos == 0 || get_key(sorted_edges[pos - 1]) != get_key(sorted_edges[pos]) );
+      });
+      parallel::TBBPrefixSum<HyperedgeID, parallel::scalable_vector> run_heads_prefix_sum(run_heads);
+      tbb::parallel_scan(tbb::blocked_range<size_t>(UL(0), num_tmp_edges), run_heads_prefix_sum);
+
+      parallel::reduce_runs(sorted_edges,
+        [&](const SortableEdge& lhs, const SortableEdge& rhs) {
+          return get_key(lhs) == get_key(rhs);
+        }, [](SortableEdge& lhs, const SortableEdge& rhs) {
+          if ( lhs.edge.isValid() ) {
+            lhs.edge.addWeight(rhs.edge.getWeight());
+            lhs.edge.updateID(rhs.edge.getID());
           }
-        });
+        }, [&](const size_t pos, const SortableEdge& e) {
+          if ( e.edge.isValid() ) {
+            const size_t incident_edges_start = tmp_incident_edges_prefix_sum[e.source];
+            tmp_edges[incident_edges_start + run_heads_prefix_sum[pos] -
+              run_heads_prefix_sum[incident_edges_start]] = e.edge;
+          }
+        }, num_tasks);
 
-        const size_t contracted_size = incident_edges_pos.total_sum();
-        node_sizes[coarse_node] = contracted_size;
-      }
+      tbb::parallel_for(ID(0), coarsened_num_nodes, [&](const HypernodeID& coarse_node) {
+        const size_t incident_edges_start = tmp_incident_edges_prefix_sum[coarse_node];
+        const size_t incident_edges_end = tmp_incident_edges_prefix_sum[coarse_node + 1];
+        node_sizes[coarse_node] = run_heads_prefix_sum[incident_edges_end] -
+          run_heads_prefix_sum[incident_edges_start];
+      });
     }
 
     // #################### STAGE 4 ####################
@@ -408,6 +422,7 @@ namespace mt_kahypar::ds {
     );
 
     hypergraph._total_weight = _total_weight;
+    hypergraph._fixed_vertices = _fixed_vertices.contract(map_to_coarse_graph, coarsened_num_nodes);
     hypergraph._tmp_contraction_buffer = _tmp_contraction_buffer;
     _tmp_contraction_buffer = nullptr;
     return hypergraph;
@@ -437,6 +452,30 @@ namespace mt_kahypar::ds {
              sizeof(HyperedgeID) * _unique_edge_ids.size());
     }, [&] {
       hypergraph._community_ids = _community_ids;
+    }, [&] {
+      hypergraph._fixed_vertices = _fixed_vertices;
+    });
+    return hypergraph;
+  }
+
+  StaticGraph StaticGraph::sharedCopy() const {
+    StaticGraph hypergraph;
+
+    hypergraph._num_nodes = _num_nodes;
+    hypergraph._num_removed_nodes = _num_removed_nodes;
+    hypergraph._num_edges = _num_edges;
+    hypergraph._total_weight = _total_weight;
+
+    hypergraph._nodes.use_external_memory(
+      const_cast<Node*>(_nodes.data()), _nodes.size());
+    hypergraph._edges.use_external_memory(
+      const_cast<Edge*>(_edges.data()), _edges.size());
+    hypergraph._unique_edge_ids.use_external_memory(
+      const_cast<HyperedgeID*>(_unique_edge_ids.data()), _unique_edge_ids.size());
+    tbb::parallel_invoke([&] {
+      hypergraph._community_ids = _community_ids;
+    }, [&] {
+      hypergraph._fixed_vertices = _fixed_vertices;
     });
     return hypergraph;
   }
@@ -463,6 +502,7 @@ namespace mt_kahypar::ds {
            sizeof(HyperedgeID) * _unique_edge_ids.size());
 
     hypergraph._community_ids = _community_ids;
+    hypergraph._fixed_vertices = _fixed_vertices;
 
     return hypergraph;
   }
@@ -475,6 +515,9 @@ namespace mt_kahypar::ds {
     parent->addChild("Hypernodes", sizeof(Node) * _nodes.size());
     parent->addChild("Hyperedges", 2 * sizeof(Edge) * _edges.size());
     parent->addChild("Communities", sizeof(PartitionID) * _community_ids.capacity());
+    if ( _fixed_vertices.hasFixedVertices() ) {
+      parent->addChild("Fixed Vertices", _fixed_vertices.sizeInBytes());
+    }
   }
 
   // ! Computes the total node weight of the hypergraph
@@ -34,6 +34,7 @@
 
 #include "mt-kahypar/macros.h"
 #include "mt-kahypar/datastructures/array.h"
+#include "mt-kahypar/datastructures/fixed_vertex_support.h"
 #include "mt-kahypar/datastructures/hypergraph_common.h"
 #include "mt-kahypar/parallel/atomic_wrapper.h"
 #include "mt-kahypar/parallel/stl/scalable_vector.h"
@@ -58,8 +59,9 @@ class StaticGraph {
   // vertex to consecutive range in a temporary incident nets structure.
   // Afterwards, we sort that range and remove duplicates. However, it turned
   // out that this become a major sequential bottleneck in presence of high
-  // degree vertices. Therefore, all vertices with temporary degree greater
-  // than this threshold are contracted with a special procedure.
+  // degree vertices. Therefore, if a vertex has a temporary degree greater
+  // than this threshold, the parallel edges of all vertices are aggregated
+  // with a parallel radix sort over (source, target) pairs instead.
   // TODO: what is a good value?
   static constexpr HyperedgeID HIGH_DEGREE_CONTRACTION_THRESHOLD = ID(100000);
 
@@ -459,6 +461,7 @@ class StaticGraph {
     _edges(),
     _unique_edge_ids(),
     _community_ids(),
+    _fixed_vertices(),
     _tmp_contraction_buffer(nullptr) { }
 
   StaticGraph(const StaticGraph&) = delete;
@@ -473,6 +476,7 @@ class StaticGraph {
     _edges(std::move(other._edges)),
     _unique_edge_ids(std::move(other._unique_edge_ids)),
     _community_ids(std::move(other._community_ids)),
+    _fixed_vertices(std::move(other._fixed_vertices)),
     _tmp_contraction_buffer(std::move(other._tmp_contraction_buffer)) {
     other._tmp_contraction_buffer = nullptr;
   }
@@ -486,6 +490,7 @@ class StaticGraph {
     _edges = std::move(other._edges);
     _unique_edge_ids = std::move(other._unique_edge_ids);
     _community_ids = std::move(other._community_ids),
+    _fixed_vertices = std::move(other._fixed_vertices);
     _tmp_contraction_buffer = std::move(other._tmp_contraction_buffer);
     other._tmp_contraction_buffer = nullptr;
     return *this;
@@ -528,12 +533,12 @@ class StaticGraph {
   }
 
   // ! Initial number of pins
-  HypernodeID initialNumPins() const {
+  size_t initialNumPins() const {
     return _num_edges;
   }
 
   // ! Initial sum of the degree of all vertices
-  HypernodeID initialTotalVertexDegree() const {
+  size_t initialTotalVertexDegree() const {
     return _num_edges;
   }
 
@@ -702,6 +707,31 @@ class StaticGraph {
     _community_ids[u] = community_id;
   }
 
+  // ####################### Fixed Vertex Support #######################
+
+  bool hasFixedVertices() const {
+    return _fixed_vertices.hasFixedVertices();
+  }
+
+  // ! Returns true, if hypernode u is fixed to a block
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool isFixed(const HypernodeID u) const {
+    return _fixed_vertices.isFixed(u);
+  }
+
+  // ! Block to which hypernode u is fixed (kInvalidPartition, if u is not fixed)
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE PartitionID fixedVertexBlock(const HypernodeID u) const {
+    return _fixed_vertices.fixedVertexBlock(u);
+  }
+
+  const FixedVertexSupport& fixedVertexSupport() const {
+    return _fixed_vertices;
+  }
+
+  // ! Fixes hypernode u to the given block (not thread-safe)
+  void fixToBlock(const HypernodeID u, const PartitionID block) {
+    _fixed_vertices.fixToBlock(u, block, initialNumNodes());
+  }
+
   // ####################### Contract / Uncontract #######################
 
   /*!
@@ -712,8 +742,11 @@ class StaticGraph {
    * community label (given in 'communities') to a vertex in the coarse hypergraph.
    *
    * \param communities Community structure that should be contracted
+   * \param low_memory Ignored, the graph contraction does not copy the edges
+   *                   into a temporary buffer of the size of the graph
    */
-  StaticGraph contract(parallel::scalable_vector<HypernodeID>& communities);
+  StaticGraph contract(parallel::scalable_vector<HypernodeID>& communities,
+                       const bool low_memory = false);
 
   bool registerContraction(const HypernodeID, const HypernodeID) {
     ERR("registerContraction(u, v) is not supported in static graph");
@@ -727,6 +760,13 @@ class StaticGraph {
     return 0;
   }
 
+  size_t contractMatching(const Batch&,
+                          const HypernodeWeight max_node_weight = std::numeric_limits<HypernodeWeight>::max()) {
+    unused(max_node_weight);
+    ERR("contractMatching(matching, max_node_weight) is not supported in static graph");
+    return 0;
+  }
+
   void uncontract(const Batch&,
                   const MarkEdgeFunc& mark_edge,
                   const UncontractionFunction& case_one_func = NOOP_BATCH_FUNC,
@@ -793,6 +833,18 @@ class StaticGraph {
   // ! Copy static hypergraph sequential
   StaticGraph copy() const;
 
+  // ! Returns a hypergraph that shares its structure arrays with this hypergraph
+  // ! (only community IDs and fixed vertices are copied). The shared arrays are
+  // ! read-only, i.e., the copy must not be modified (contracting it is fine),
+  // ! and this hypergraph must outlive the copy.
+  StaticGraph sharedCopy() const;
+
+  // ! A static graph does not separate its structure from the
+  // ! mutable attributes. Therefore, this is a deep copy.
+  StaticGraph copyOnWrite(parallel_tag_t) {
+    return copy(parallel_tag_t());
+  }
+
   // ! Reset internal data structure
   void reset() { }
 
@@ -889,6 +941,9 @@ class StaticGraph {
   // ! Communities
   ds::Clustering _community_ids;
 
+  // ! Blocks to which vertices are fixed
+  FixedVertexSupport _fixed_vertices;
+
   // ! Data that is reused throughout the multilevel hierarchy
   // ! to contract the hypergraph and to prevent expensive allocations
   TmpContractionBuffer* _tmp_contraction_buffer;
@@ -28,6 +28,9 @@
 
 #include "static_graph_factory.h"
 
+#include <algorithm>
+#include <functional>
+
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_invoke.h>
 
@@ -182,4 +185,143 @@ namespace mt_kahypar::ds {
     graph.computeAndSetTotalNodeWeight(parallel_tag_t());
     return graph;
   }
-}
\ No newline at end of file
+
+  template<typename NodeIndex>
+  StaticGraph StaticGraphFactory::construct_from_csr(
+          const HypernodeID num_nodes,
+          const size_t* xadj,
+          const NodeIndex* adjncy,
+          const HyperedgeWeight* adjwgt,
+          const HypernodeWeight* node_weight) {
+    return construct_from_adjacency(num_nodes, xadj, [&](AdjacencyWriter& writer) {
+      tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID u) {
+        if ( node_weight ) {
+          writer.setNodeWeight(u, node_weight[u]);
+        }
+        for ( size_t pos = xadj[u]; pos < xadj[u + 1]; ++pos ) {
+          if ( adjncy[pos] >= num_nodes ) {
+            ERR("Invalid adjacency entry" << adjncy[pos] << "of node" << u << "(out of range).");
+          }
+          writer.setEntry(pos, u, adjncy[pos], adjwgt ? adjwgt[pos] : 1);
+        }
+      });
+    });
+  }
+
+  StaticGraph StaticGraphFactory::construct_from_adjacency(
+          const HypernodeID num_nodes,
+          const size_t* xadj,
+          const std::function<void(AdjacencyWriter&)>& write_adjacency) {
+    const size_t num_entries = xadj[num_nodes];
+    if ( num_entries % 2 != 0 ) {
+      ERR("Adjacency arrays are not symmetric (odd number of entries).");
+    }
+    const HyperedgeID num_edges = num_entries / 2;
+
+    StaticGraph graph;
+    graph._num_nodes = num_nodes;
+    graph._num_edges = num_entries;
+    tbb::parallel_invoke([&] {
+      graph._nodes.resize(num_nodes + 1);
+      tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID u) {
+        graph._nodes[u].enable();
+        graph._nodes[u].setFirstEntry(xadj[u]);
+      });
+    }, [&] {
+      graph._edges.resize(num_entries);
+    }, [&] {
+      graph._unique_edge_ids.resize(num_entries);
+    }, [&] {
+      graph._community_ids.resize(num_nodes, 0);
+    });
+    AdjacencyWriter writer(graph);
+    write_adjacency(writer);
+
+    // The edge array of the graph has the same layout as the adjacency arrays.
+    // Thus, the adjacency list of each node is already at its final position
+    // without counting degrees or atomic insertion positions.
+    auto by_target = [](const StaticGraph::Edge& lhs, const StaticGraph::Edge& rhs) {
+      return lhs.target() < rhs.target();
+    };
+    // Parallel edges are additionally sorted by their weight, which ensures
+    // that they are matched with reverse edges of the same weight
+    auto by_target_and_weight = [](const StaticGraph::Edge& lhs, const StaticGraph::Edge& rhs) {
+      return lhs.target() < rhs.target() ||
+        (lhs.target() == rhs.target() && lhs.weight() < rhs.weight());
+    };
+    // An undirected edge {u,v} with u < v is stored as forward edge at u
+    // and as backward edge at v. After sorting, the backward edges of a node
+    // precede its forward edges (there are no self-loops).
+    Counter first_forward_edge(num_nodes, 0);
+    Counter num_forward_edges(num_nodes, 0);
+    tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID u) {
+      bool is_sorted = true;
+      for ( size_t pos = xadj[u]; pos < xadj[u + 1]; ++pos ) {
+        const StaticGraph::Edge& edge = graph._edges[pos];
+        ASSERT(edge.source() == u);
+        if ( edge.target() >= num_nodes || edge.target() == u ) {
+          ERR("Invalid adjacency entry" << edge.target() << "of node" << u
+            << "(either out of range or a self-loop).");
+        }
+        is_sorted &= pos == xadj[u] || !by_target_and_weight(edge, graph._edges[pos - 1]);
+      }
+      if ( !is_sorted ) {
+        std::sort(graph._edges.begin() + xadj[u],
+          graph._edges.begin() + xadj[u + 1], by_target_and_weight);
+      }
+
+      first_forward_edge[u] = std::upper_bound(graph._edges.begin() + xadj[u],
+        graph._edges.begin() + xadj[u + 1], StaticGraph::Edge(u, u), by_target) - graph._edges.begin();
+      num_forward_edges[u] = xadj[u + 1] - first_forward_edge[u];
+    });
+
+    // The forward edges of node u get the unique ids
+    // forward_edge_prefix_sum[u] ... forward_edge_prefix_sum[u + 1] - 1
+    parallel::TBBPrefixSum<size_t> forward_edge_prefix_sum(num_forward_edges);
+    tbb::parallel_scan(tbb::blocked_range<size_t>( UL(0), UI64(num_nodes)), forward_edge_prefix_sum);
+    if ( forward_edge_prefix_sum.total_sum() != num_edges ) {
+      ERR("Adjacency arrays are not symmetric.");
+    }
+
+    // The i-th parallel edge from u to v is matched with the i-th parallel
+    // edge from v to u. Since the incident edges are sorted, we find the
+    // reverse edge with a binary search in the adjacency list of v.
+    auto find_reverse_edge = [&](const HypernodeID u, const size_t pos) {
+      const HypernodeID v = graph._edges[pos].target();
+      const size_t first_parallel_edge = std::lower_bound(graph._edges.begin() + xadj[u],
+        graph._edges.begin() + pos, StaticGraph::Edge(v, v), by_target) - graph._edges.begin();
+      const size_t reverse_pos = std::lower_bound(graph._edges.begin() + xadj[v],
+        graph._edges.begin() + xadj[v + 1], StaticGraph::Edge(u, u), by_target) - graph._edges.begin()
+        + (pos - first_parallel_edge);
+      if ( reverse_pos >= xadj[v + 1] || graph._edges[reverse_pos].target() != u ||
+           graph._edges[reverse_pos].weight() != graph._edges[pos].weight() ) {
+        ERR("Adjacency arrays are not symmetric: edge (" << u << "," << v
+          << ") has no reverse edge with the same weight.");
+      }
+      return reverse_pos;
+    };
+
+    tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID u) {
+      for ( size_t pos = xadj[u]; pos < first_forward_edge[u]; ++pos ) {
+        const HypernodeID v = graph._edges[pos].target();
+        graph._unique_edge_ids[pos] = forward_edge_prefix_sum[v] +
+          (find_reverse_edge(u, pos) - first_forward_edge[v]);
+      }
+      for ( size_t pos = first_forward_edge[u]; pos < xadj[u + 1]; ++pos ) {
+        // Only verifies that a reverse edge exists
+        find_reverse_edge(u, pos);
+        graph._unique_edge_ids[pos] = forward_edge_prefix_sum[u] + (pos - first_forward_edge[u]);
+      }
+    });
+
+    // Add Sentinel
+    graph._nodes.back() = StaticGraph::Node(graph._edges.size());
+    graph.computeAndSetTotalNodeWeight(parallel_tag_t());
+    return graph;
+  }
+
+  template StaticGraph StaticGraphFactory::construct_from_csr(
+    const HypernodeID, const size_t*, const uint32_t*, const HyperedgeWeight*, const HypernodeWeight*);
+  template StaticGraph StaticGraphFactory::construct_from_csr(
+    const HypernodeID, const size_t*, const uint64_t*, const HyperedgeWeight*, const HypernodeWeight*);
+}
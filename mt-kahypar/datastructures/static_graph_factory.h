@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "tbb/enumerable_thread_specific.h"
 
 #include "mt-kahypar/datastructures/static_graph.h"
@@ -62,6 +64,53 @@ class StaticGraphFactory {
                                                 const HypernodeWeight* node_weight = nullptr,
                                                 const bool stable_construction_of_incident_edges = false);
 
+  // ! Constructs the graph directly from its adjacency arrays in CSR format
+  // ! (as used by Metis), i.e., the neighbors of node u are stored in
+  // ! adjncy[xadj[u]] ... adjncy[xadj[u + 1] - 1] and each undirected edge
+  // ! occurs in the adjacency arrays of both of its endpoints. The edge weights
+  // ! adjwgt are given per adjacency entry. The incident edges of each node are
+  // ! always sorted by their target node.
+  // ! The adjacency arrays can either use 32-bit or 64-bit node IDs.
+  template<typename NodeIndex>
+  static StaticGraph construct_from_csr(const HypernodeID num_nodes,
+                                        const size_t* xadj,
+                                        const NodeIndex* adjncy,
+                                        const HyperedgeWeight* adjwgt = nullptr,
+                                        const HypernodeWeight* node_weight = nullptr);
+
+  // ! Writes the entries of the adjacency arrays directly into the
+  // ! edge array of a graph (see construct_from_adjacency(...))
+  class AdjacencyWriter {
+   public:
+    explicit AdjacencyWriter(StaticGraph& graph) :
+      _graph(graph) { }
+
+    // ! Sets the entry at position pos of the adjacency arrays, which belongs to node u
+    void setEntry(const size_t pos, const HypernodeID u, const HypernodeID v, const HyperedgeWeight weight) {
+      StaticGraph::Edge& edge = _graph._edges[pos];
+      edge.setSource(u);
+      edge.setTarget(v);
+      edge.setWeight(weight);
+    }
+
+    void setNodeWeight(const HypernodeID u, const HypernodeWeight weight) {
+      _graph._nodes[u].setWeight(weight);
+    }
+
+   private:
+    StaticGraph& _graph;
+  };
+
+  // ! Same as construct_from_csr(...), but the adjacency arrays are not passed
+  // ! explicitly. Instead, write_adjacency(writer) must set all entries of the
+  // ! adjacency arrays with the given writer (possibly in parallel), which writes
+  // ! them directly into the edge array of the graph. This allows to construct
+  // ! the graph without materializing the adjacency arrays (e.g., when reading
+  // ! a Metis file, where only the degrees of the nodes are known upfront).
+  static StaticGraph construct_from_adjacency(const HypernodeID num_nodes,
+                                              const size_t* xadj,
+                                              const std::function<void(AdjacencyWriter&)>& write_adjacency);
+
   static std::pair<StaticGraph, parallel::scalable_vector<HypernodeID> > compactify(const StaticGraph&) {
     ERR("Compactify not implemented for static graph.");
   }
@@ -29,13 +29,35 @@
 
 #include "mt-kahypar/parallel/parallel_prefix_sum.h"
 #include "mt-kahypar/datastructures/concurrent_bucket_map.h"
+#include "mt-kahypar/utils/hash.h"
 #include "mt-kahypar/utils/timer.h"
 #include "mt-kahypar/utils/memory_tree.h"
 
 #include <tbb/parallel_reduce.h>
+#include <tbb/parallel_sort.h>
 
 namespace mt_kahypar::ds {
 
+  namespace {
+    template<typename T>
+    void copyArray(Array<T>& dst, const Array<T>& src, const bool parallel) {
+      dst.resize(src.size(), T(), parallel);
+      if ( src.size() > 0 ) {
+        memcpy(dst.data(), src.data(), sizeof(T) * src.size());
+      }
+    }
+
+    // ! The shared array is read-only (see sharedCopy())
+    template<typename T>
+    void shareArray(Array<T>& dst, const Array<T>& src) {
+      dst.use_external_memory(const_cast<T*>(src.data()), src.size());
+    }
+
+    void shareBitVector(AtomicBitVector& dst, const AtomicBitVector& src) {
+      dst.use_external_memory(const_cast<AtomicBitVector::Block*>(src.data()), src.size());
+    }
+  }
+
 
   /*!
   * This struct is used during multilevel coarsening to efficiently
@@ -56,14 +78,22 @@ namespace mt_kahypar::ds {
    * community label (given in 'communities') to a vertex in the coarse hypergraph.
    *
    * \param communities Community structure that should be contracted
+   * \param low_memory If true, the contraction does not use temporary buffers
+   *                   for pins and incident nets (see contract_low_memory(...))
    */
-  StaticHypergraph StaticHypergraph::contract(parallel::scalable_vector<HypernodeID>& communities) {
+  StaticHypergraph StaticHypergraph::contract(parallel::scalable_vector<HypernodeID>& communities,
+                                              const bool low_memory) {
+    if ( low_memory ) {
+      return contract_low_memory(communities);
+    }
 
     ASSERT(communities.size() == _num_hypernodes);
 
     if ( !_tmp_contraction_buffer ) {
-      allocateTmpContractionBuffer();
+      allocateTmpContractionBuffer(false);
     }
+    ASSERT(_tmp_contraction_buffer->tmp_incidence_array.size() > 0 || _num_pins == 0,
+           "Contraction buffer was allocated in low memory mode");
 
     // Auxiliary buffers - reused during multilevel hierarchy to prevent expensive allocations
     Array<size_t>& mapping = _tmp_contraction_buffer->mapping;
@@ -146,23 +176,22 @@ namespace mt_kahypar::ds {
     // graph are also aggregate in a consecutive memory range and duplicates are removed. Note
     // that parallel and single-pin hyperedges are not removed from the incident nets (will be done
     // in a postprocessing step).
-    auto cs2 = [](const HypernodeID x) { return x * x; };
-    ConcurrentBucketMap<ContractedHyperedgeInformation> hyperedge_hash_map;
-    hyperedge_hash_map.reserve_for_estimated_number_of_insertions(_num_hyperedges);
+    Array<ContractedHyperedgeInformation> contracted_hyperedges;
+    contracted_hyperedges.resize(_num_hyperedges);
     tbb::parallel_invoke([&] {
       // Contract Hyperedges
       tbb::parallel_for(ID(0), _num_hyperedges, [&](const HyperedgeID& he) {
         if ( edgeIsEnabled(he) ) {
           // Copy hyperedge and pins to temporary buffer
-          const Hyperedge& e = _hyperedges[he];
+          const size_t incidence_array_start = firstPinEntry(he);
+          const size_t incidence_array_end = firstInvalidPinEntry(he);
           ASSERT(static_cast<size_t>(he) < tmp_hyperedges.size());
-          ASSERT(e.firstInvalidEntry() <= tmp_incidence_array.size());
-          tmp_hyperedges[he] = e;
+          ASSERT(incidence_array_end <= tmp_incidence_array.size());
+          tmp_hyperedges[he] = Hyperedge(incidence_array_start,
+            incidence_array_end - incidence_array_start, edgeWeight(he));
           valid_hyperedges[he] = 1;
 
           // Map pins to vertex ids in coarse graph
-          const size_t incidence_array_start = tmp_hyperedges[he].firstEntry();
-          const size_t incidence_array_end = tmp_hyperedges[he].firstInvalidEntry();
           for ( size_t pos = incidence_array_start; pos < incidence_array_end; ++pos ) {
             const HypernodeID pin = _incidence_array[pos];
             ASSERT(pos < tmp_incidence_array.size());
@@ -185,19 +214,19 @@ namespace mt_kahypar::ds {
 
           if ( contracted_size > 1 ) {
             // Compute hash of contracted hyperedge
-            size_t footprint = kEdgeHashSeed;
-            for ( size_t pos = incidence_array_start; pos < incidence_array_start + contracted_size; ++pos ) {
-              footprint += cs2(tmp_incidence_array[pos]);
-            }
-            hyperedge_hash_map.insert(footprint,
-                                      ContractedHyperedgeInformation{ he, footprint, contracted_size, true });
+            const size_t footprint = hashing::set::footprint(
+              tmp_incidence_array.data() + incidence_array_start, contracted_size);
+            contracted_hyperedges[he] =
+              ContractedHyperedgeInformation{ he, footprint, contracted_size, true };
           } else {
             // Hyperedge becomes a single-pin hyperedge
             valid_hyperedges[he] = 0;
             tmp_hyperedges[he].disable();
+            contracted_hyperedges[he] = ContractedHyperedgeInformation{ he, kEdgeHashSeed, 0, false };
           }
         } else {
           valid_hyperedges[he] = 0;
+          contracted_hyperedges[he] = ContractedHyperedgeInformation{ he, kEdgeHashSeed, 0, false };
         }
       });
     }, [&] {
@@ -222,7 +251,7 @@ namespace mt_kahypar::ds {
                                    tmp_incident_nets_pos[coarse_hn].fetch_add(node_degree);
         ASSERT(incident_nets_pos + node_degree <= tmp_incident_nets_prefix_sum[coarse_hn + 1]);
         memcpy(tmp_incident_nets.data() + incident_nets_pos,
-               _incident_nets.data() + _hypernodes[hn].firstEntry(),
+               _incident_nets.data() + firstIncidentNetEntry(hn),
                sizeof(HyperedgeID) * node_degree);
       });
 
@@ -294,69 +323,101 @@ namespace mt_kahypar::ds {
     });
 
     // #################### STAGE 3 ####################
-    // In the step before we aggregated hyperedges within a bucket data structure.
-    // Hyperedges with the same hash/footprint are stored inside the same bucket.
-    // We iterate now in parallel over each bucket and sort each bucket
-    // after its hash. A bucket is processed by one thread and parallel
-    // hyperedges are detected by comparing the pins of hyperedges with
-    // the same hash.
-
-    // Helper function that checks if two hyperedges are parallel
+    // In the step before we computed a hash/footprint for each contracted hyperedge.
+    // We sort the contracted hyperedges in parallel after their hash and size such
+    // that parallel hyperedges form consecutive runs. Each run is then processed
+    // independently. Runs are usually small, but for skewed net size distributions
+    // (e.g., many identical small nets) a few runs can become very large. Therefore,
+    // we sort the hyperedges of a run lexicographically after their pins (in parallel
+    // for large runs) and only compare adjacent hyperedges of a run. This avoids the
+    // quadratic number of comparisons of a pairwise comparison within a run.
+
+    // Lexicographic comparison of the pins of two hyperedges with same size.
     // Note, pins inside the hyperedges are sorted.
-    auto check_if_hyperedges_are_parallel = [&](const HyperedgeID lhs,
-                                                const HyperedgeID rhs) {
+    auto compare_pins = [&](const HyperedgeID lhs, const HyperedgeID rhs) {
       const Hyperedge& lhs_he = tmp_hyperedges[lhs];
       const Hyperedge& rhs_he = tmp_hyperedges[rhs];
-      if ( lhs_he.size() == rhs_he.size() ) {
-        const size_t lhs_start = lhs_he.firstEntry();
-        const size_t rhs_start = rhs_he.firstEntry();
-        for ( size_t i = 0; i < lhs_he.size(); ++i ) {
-          const size_t lhs_pos = lhs_start + i;
-          const size_t rhs_pos = rhs_start + i;
-          if ( tmp_incidence_array[lhs_pos] != tmp_incidence_array[rhs_pos] ) {
-            return false;
-          }
+      ASSERT(lhs_he.size() == rhs_he.size());
+      const size_t lhs_start = lhs_he.firstEntry();
+      const size_t rhs_start = rhs_he.firstEntry();
+      for ( size_t i = 0; i < lhs_he.size(); ++i ) {
+        const HypernodeID lhs_pin = tmp_incidence_array[lhs_start + i];
+        const HypernodeID rhs_pin = tmp_incidence_array[rhs_start + i];
+        if ( lhs_pin != rhs_pin ) {
+          return lhs_pin < rhs_pin ? -1 : 1;
         }
-        return true;
-      } else {
-        return false;
       }
+      return 0;
     };
 
-    tbb::parallel_for(UL(0), hyperedge_hash_map.numBuckets(), [&](const size_t bucket) {
-      auto& hyperedge_bucket = hyperedge_hash_map.getBucket(bucket);
-      std::sort(hyperedge_bucket.begin(), hyperedge_bucket.end(),
-                [&](const ContractedHyperedgeInformation& lhs, const ContractedHyperedgeInformation& rhs) {
-                  return std::tie(lhs.hash, lhs.size, lhs.he) < std::tie(rhs.hash, rhs.size, rhs.he);
-                });
+    ContractedHyperedgeInformation* contracted_hyperedges_begin = contracted_hyperedges.data();
+    tbb::parallel_sort(contracted_hyperedges_begin, contracted_hyperedges_begin + _num_hyperedges,
+      [&](const ContractedHyperedgeInformation& lhs, const ContractedHyperedgeInformation& rhs) {
+        return std::make_tuple(!lhs.valid, lhs.hash, lhs.size, lhs.he) <
+               std::make_tuple(!rhs.valid, rhs.hash, rhs.size, rhs.he);
+      });
+    // Invalid hyperedges are at the end of the sorted sequence
+    const size_t num_valid_hyperedges = std::distance(contracted_hyperedges_begin,
+      std::partition_point(contracted_hyperedges_begin, contracted_hyperedges_begin + _num_hyperedges,
+        [&](const ContractedHyperedgeInformation& info) { return info.valid; }));
+
+    auto in_same_run = [&](const size_t lhs, const size_t rhs) {
+      return contracted_hyperedges[lhs].hash == contracted_hyperedges[rhs].hash &&
+             contracted_hyperedges[lhs].size == contracted_hyperedges[rhs].size;
+    };
+
+    tbb::parallel_for(UL(0), num_valid_hyperedges, [&](const size_t run_start) {
+      if ( run_start > 0 && in_same_run(run_start - 1, run_start) ) {
+        // Not the start of a run
+        return;
+      }
+      size_t run_end = run_start + 1;
+      while ( run_end < num_valid_hyperedges && in_same_run(run_start, run_end) ) {
+        ++run_end;
+      }
+      if ( run_end - run_start == 1 ) {
+        // Hyperedge has no parallel hyperedge
+        return;
+      }
+
+      // Sort hyperedges of the run lexicographically after their pins. Equal hyperedges
+      // are ordered after their ID such that the hyperedge with the smallest ID becomes
+      // the representative of its parallel hyperedges.
+      auto lexicographic_less = [&](const ContractedHyperedgeInformation& lhs,
+                                    const ContractedHyperedgeInformation& rhs) {
+        const int cmp = compare_pins(lhs.he, rhs.he);
+        return cmp < 0 || ( cmp == 0 && lhs.he < rhs.he );
+      };
+      const size_t run_pins = ( run_end - run_start ) * contracted_hyperedges[run_start].size;
+      if ( run_pins > PARALLEL_NET_DETECTION_SORT_THRESHOLD ) {
+        tbb::parallel_sort(contracted_hyperedges_begin + run_start,
+                           contracted_hyperedges_begin + run_end, lexicographic_less);
+      } else {
+        std::sort(contracted_hyperedges_begin + run_start,
+                  contracted_hyperedges_begin + run_end, lexicographic_less);
+      }
 
       // Parallel Hyperedge Detection
-      for ( size_t i = 0; i < hyperedge_bucket.size(); ++i ) {
-        ContractedHyperedgeInformation& contracted_he_lhs = hyperedge_bucket[i];
-        if ( contracted_he_lhs.valid ) {
-          const HyperedgeID lhs_he = contracted_he_lhs.he;
-          HyperedgeWeight lhs_weight = tmp_hyperedges[lhs_he].weight();
-          for ( size_t j = i + 1; j < hyperedge_bucket.size(); ++j ) {
-            ContractedHyperedgeInformation& contracted_he_rhs = hyperedge_bucket[j];
-            const HyperedgeID rhs_he = contracted_he_rhs.he;
-            if ( contracted_he_rhs.valid &&
-                 contracted_he_lhs.hash == contracted_he_rhs.hash &&
-                 check_if_hyperedges_are_parallel(lhs_he, rhs_he) ) {
-              // Hyperedges are parallel
-              lhs_weight += tmp_hyperedges[rhs_he].weight();
-              contracted_he_rhs.valid = false;
-              valid_hyperedges[rhs_he] = false;
-            } else if ( contracted_he_lhs.hash != contracted_he_rhs.hash  ) {
-              // In case, hash of both are not equal we go to the next hyperedge
-              // because we compared it with all hyperedges that had an equal hash
-              break;
-            }
+      size_t representative = run_start;
+      HyperedgeWeight representative_weight = tmp_hyperedges[contracted_hyperedges[run_start].he].weight();
+      for ( size_t i = run_start + 1; i <= run_end; ++i ) {
+        if ( i < run_end && compare_pins(contracted_hyperedges[representative].he,
+                                         contracted_hyperedges[i].he) == 0 ) {
+          // Hyperedges are parallel
+          const HyperedgeID parallel_he = contracted_hyperedges[i].he;
+          representative_weight += tmp_hyperedges[parallel_he].weight();
+          contracted_hyperedges[i].valid = false;
+          valid_hyperedges[parallel_he] = false;
+        } else {
+          tmp_hyperedges[contracted_hyperedges[representative].he].setWeight(representative_weight);
+          if ( i < run_end ) {
+            representative = i;
+            representative_weight = tmp_hyperedges[contracted_hyperedges[i].he].weight();
           }
-          tmp_hyperedges[lhs_he].setWeight(lhs_weight);
         }
       }
-      hyperedge_hash_map.free(bucket);
     });
+    parallel::free(contracted_hyperedges);
 
     // #################### STAGE 4 ####################
     // Coarsened hypergraph is constructed here by writting data from temporary
@@ -372,15 +433,15 @@ namespace mt_kahypar::ds {
 
     // Compute number of hyperedges in coarse graph (those flagged as valid)
     parallel::TBBPrefixSum<size_t, Array> he_mapping(valid_hyperedges);
+    hypergraph._num_hypernodes = num_hypernodes;
     tbb::parallel_invoke([&] {
       tbb::parallel_scan(tbb::blocked_range<size_t>(
               UL(0), UI64(_num_hyperedges)), he_mapping);
     }, [&] {
-      hypergraph._hypernodes.resize(num_hypernodes);
+      hypergraph.allocateHypernodes(true);
     });
 
     const HyperedgeID num_hyperedges = he_mapping.total_sum();
-    hypergraph._num_hypernodes = num_hypernodes;
     hypergraph._num_hyperedges = num_hyperedges;
 
     auto assign_communities = [&] {
@@ -406,9 +467,9 @@ namespace mt_kahypar::ds {
 
         const size_t num_pins = num_pins_prefix_sum.total_sum();
         hypergraph._num_pins = num_pins;
-        hypergraph._incidence_array.resize(num_pins);
+        allocateLevelArray(hypergraph._incidence_array, num_pins);
       }, [&] {
-        hypergraph._hyperedges.resize(num_hyperedges);
+        hypergraph.allocateHyperedges(true);
       });
 
       // Write hyperedges from temporary buffers to incidence array
@@ -417,17 +478,17 @@ namespace mt_kahypar::ds {
         if ( he_mapping.value(id) /* hyperedge is valid */ ) {
           const size_t he_pos = he_mapping[id];
           const size_t incidence_array_start = num_pins_prefix_sum[id];
-          Hyperedge& he = hypergraph._hyperedges[he_pos];
-          he = std::move(tmp_hyperedges[id]);
-          const size_t tmp_incidence_array_start = he.firstEntry();
+          const Hyperedge& he = tmp_hyperedges[id];
           const size_t edge_size = he.size();
           local_max_edge_size.local() = std::max(local_max_edge_size.local(), edge_size);
           std::memcpy(hypergraph._incidence_array.data() + incidence_array_start,
-                      tmp_incidence_array.data() + tmp_incidence_array_start,
+                      tmp_incidence_array.data() + he.firstEntry(),
                       sizeof(HypernodeID) * edge_size);
-          he.setFirstEntry(incidence_array_start);
+          hypergraph._hyperedges.first_entry[he_pos] = incidence_array_start;
+          hypergraph._hyperedges.weight[he_pos] = he.weight();
         }
       });
+      hypergraph._hyperedges.first_entry[num_hyperedges] = hypergraph._num_pins;
       hypergraph._max_edge_size = local_max_edge_size.combine(
               [&](const size_t lhs, const size_t rhs) {
                 return std::max(lhs, rhs);
@@ -461,23 +522,295 @@ namespace mt_kahypar::ds {
               UL(0), UI64(num_hypernodes)), num_incident_nets_prefix_sum);
       const size_t total_degree = num_incident_nets_prefix_sum.total_sum();
       hypergraph._total_degree = total_degree;
-      hypergraph._incident_nets.resize(total_degree);
+      allocateLevelArray(hypergraph._incident_nets, total_degree);
       // Write incident nets from temporary buffer to incident nets array
       tbb::parallel_for(ID(0), num_hypernodes, [&](const HypernodeID& id) {
         const size_t incident_nets_start = num_incident_nets_prefix_sum[id];
-        Hypernode& hn = hypergraph._hypernodes[id];
-        hn = std::move(tmp_hypernodes[id]);
-        const size_t tmp_incident_nets_start = hn.firstEntry();
+        const Hypernode& hn = tmp_hypernodes[id];
         std::memcpy(hypergraph._incident_nets.data() + incident_nets_start,
-                    tmp_incident_nets.data() + tmp_incident_nets_start,
+                    tmp_incident_nets.data() + hn.firstEntry(),
                     sizeof(HyperedgeID) * hn.size());
-        hn.setFirstEntry(incident_nets_start);
+        hypergraph._hypernodes.first_entry[id] = incident_nets_start;
+        hypergraph._hypernodes.degree[id] = hn.size();
+        hypergraph._hypernodes.weight[id] = hn.weight();
       });
+      hypergraph._hypernodes.first_entry[num_hypernodes] = total_degree;
     };
 
     tbb::parallel_invoke( assign_communities, setup_hyperedges, setup_hypernodes);
 
     hypergraph._total_weight = _total_weight;   // didn't lose any vertices
+    hypergraph._fixed_vertices = _fixed_vertices.contract(map_to_coarse_hypergraph, num_hypernodes);
+    hypergraph._tmp_contraction_buffer = _tmp_contraction_buffer;
+    _tmp_contraction_buffer = nullptr;
+    return hypergraph;
+  }
+
+  /*!
+   * Same as contract(...), but the contraction does not copy the pins and incident nets
+   * into temporary buffers of the size of the current hypergraph. Instead, the contracted
+   * pin list of a hyperedge is recomputed from the fine incidence array whenever it is
+   * needed (hashing, parallel net detection and writing the coarse incidence array) and
+   * the incident nets of the coarse vertices are obtained by transposing the coarse
+   * incidence array. This roughly halves the peak memory of the contraction at the cost
+   * of additional running time. The resulting hypergraph is equal to the one computed
+   * by contract(...) up to the order of the incident nets of each vertex.
+   */
+  StaticHypergraph StaticHypergraph::contract_low_memory(parallel::scalable_vector<HypernodeID>& communities) {
+
+    ASSERT(communities.size() == _num_hypernodes);
+
+    if ( !_tmp_contraction_buffer ) {
+      allocateTmpContractionBuffer(true);
+    }
+
+    Array<size_t>& mapping = _tmp_contraction_buffer->mapping;
+    Array<parallel::IntegralAtomicWrapper<size_t>>& tmp_num_incident_nets =
+            _tmp_contraction_buffer->tmp_num_incident_nets;
+    Array<parallel::IntegralAtomicWrapper<HypernodeWeight>>& hn_weights =
+            _tmp_contraction_buffer->hn_weights;
+    Array<size_t>& he_sizes = _tmp_contraction_buffer->he_sizes;
+    Array<size_t>& valid_hyperedges = _tmp_contraction_buffer->valid_hyperedges;
+
+    ASSERT(static_cast<size_t>(_num_hypernodes) <= mapping.size());
+    ASSERT(static_cast<size_t>(_num_hypernodes) <= tmp_num_incident_nets.size());
+    ASSERT(static_cast<size_t>(_num_hypernodes) <= hn_weights.size());
+    ASSERT(static_cast<size_t>(_num_hyperedges) <= he_sizes.size());
+    ASSERT(static_cast<size_t>(_num_hyperedges) <= valid_hyperedges.size());
+
+    // #################### STAGE 1 ####################
+    // Compute vertex ids of coarse hypergraph with a parallel prefix sum
+    mapping.assign(_num_hypernodes, 0);
+
+    doParallelForAllNodes([&](const HypernodeID& hn) {
+      ASSERT(static_cast<size_t>(communities[hn]) < mapping.size());
+      mapping[communities[hn]] = UL(1);
+    });
+
+    parallel::TBBPrefixSum<size_t, Array> mapping_prefix_sum(mapping);
+    tbb::parallel_scan(tbb::blocked_range<size_t>(UL(0), _num_hypernodes), mapping_prefix_sum);
+    HypernodeID num_hypernodes = mapping_prefix_sum.total_sum();
+
+    // Remap community ids
+    tbb::parallel_for(ID(0), _num_hypernodes, [&](const HypernodeID& hn) {
+      if ( nodeIsEnabled(hn) ) {
+        communities[hn] = mapping_prefix_sum[communities[hn]];
+      } else {
+        communities[hn] = kInvalidHypernode;
+      }
+
+      if ( hn < num_hypernodes ) {
+        hn_weights[hn] = 0;
+        tmp_num_incident_nets[hn] = 0;
+      }
+    });
+
+    auto map_to_coarse_hypergraph = [&](const HypernodeID hn) {
+      ASSERT(hn < communities.size());
+      return communities[hn];
+    };
+
+    doParallelForAllNodes([&](const HypernodeID& hn) {
+      const HypernodeID coarse_hn = map_to_coarse_hypergraph(hn);
+      ASSERT(coarse_hn < num_hypernodes, V(coarse_hn) << V(num_hypernodes));
+      hn_weights[coarse_hn] += nodeWeight(hn);
+    });
+
+    // Writes the sorted and duplicate-free pins of hyperedge he in the
+    // coarse hypergraph to the given buffer
+    auto compute_contracted_pins = [&](const HyperedgeID he,
+                                       parallel::scalable_vector<HypernodeID>& pins) {
+      pins.clear();
+      for ( const HypernodeID& pin : this->pins(he) ) {
+        pins.push_back(map_to_coarse_hypergraph(pin));
+      }
+      std::sort(pins.begin(), pins.end());
+      pins.erase(std::unique(pins.begin(), pins.end()), pins.end());
+      while ( !pins.empty() && pins.back() == kInvalidHypernode ) {
+        pins.pop_back();
+      }
+    };
+    tbb::enumerable_thread_specific<parallel::scalable_vector<HypernodeID>> local_lhs_pins;
+    tbb::enumerable_thread_specific<parallel::scalable_vector<HypernodeID>> local_rhs_pins;
+
+    // #################### STAGE 2 ####################
+    // Compute the size and hash of each contracted hyperedge. Single-pin
+    // hyperedges are marked as invalid.
+    parallel::scalable_vector<HyperedgeWeight> he_weights;
+    LockFreeBucketMap<ContractedHyperedgeInformation> hyperedge_hash_map;
+    tbb::parallel_invoke([&] {
+      he_weights.assign(_num_hyperedges, 0);
+    }, [&] {
+      hyperedge_hash_map.reserve_for_estimated_number_of_insertions(_num_hyperedges);
+    });
+    tbb::parallel_for(ID(0), _num_hyperedges, [&](const HyperedgeID& he) {
+      valid_hyperedges[he] = 0;
+      he_sizes[he] = 0;
+      if ( edgeIsEnabled(he) ) {
+        parallel::scalable_vector<HypernodeID>& pins = local_lhs_pins.local();
+        compute_contracted_pins(he, pins);
+        if ( pins.size() > 1 ) {
+          const size_t footprint = hashing::set::footprint(pins.data(), pins.size());
+          valid_hyperedges[he] = 1;
+          he_sizes[he] = pins.size();
+          he_weights[he] = edgeWeight(he);
+          hyperedge_hash_map.insert(footprint,
+                                    ContractedHyperedgeInformation{ he, footprint, pins.size(), true });
+        }
+      }
+    });
+
+    // #################### STAGE 3 ####################
+    // Parallel hyperedge detection. Pins are recomputed for hyperedges with equal
+    // hash and size. The weight of parallel hyperedges is aggregated at the
+    // hyperedge with the smallest id.
+    hyperedge_hash_map.finalize();
+    tbb::parallel_for(UL(0), hyperedge_hash_map.numBuckets(), [&](const size_t bucket) {
+      auto hyperedge_bucket = hyperedge_hash_map.getBucket(bucket);
+      std::sort(hyperedge_bucket.begin(), hyperedge_bucket.end(),
+                [&](const ContractedHyperedgeInformation& lhs, const ContractedHyperedgeInformation& rhs) {
+                  return std::tie(lhs.hash, lhs.size, lhs.he) < std::tie(rhs.hash, rhs.size, rhs.he);
+                });
+
+      parallel::scalable_vector<HypernodeID>& lhs_pins = local_lhs_pins.local();
+      parallel::scalable_vector<HypernodeID>& rhs_pins = local_rhs_pins.local();
+      for ( size_t i = 0; i < hyperedge_bucket.size(); ++i ) {
+        ContractedHyperedgeInformation& contracted_he_lhs = hyperedge_bucket[i];
+        if ( contracted_he_lhs.valid ) {
+          const HyperedgeID lhs_he = contracted_he_lhs.he;
+          bool lhs_pins_computed = false;
+          for ( size_t j = i + 1; j < hyperedge_bucket.size(); ++j ) {
+            ContractedHyperedgeInformation& contracted_he_rhs = hyperedge_bucket[j];
+            if ( contracted_he_lhs.hash != contracted_he_rhs.hash ||
+                 contracted_he_lhs.size != contracted_he_rhs.size ) {
+              // Bucket is sorted by hash and size => no further parallel hyperedges
+              break;
+            }
+            if ( contracted_he_rhs.valid ) {
+              if ( !lhs_pins_computed ) {
+                compute_contracted_pins(lhs_he, lhs_pins);
+                lhs_pins_computed = true;
+              }
+              const HyperedgeID rhs_he = contracted_he_rhs.he;
+              compute_contracted_pins(rhs_he, rhs_pins);
+              if ( lhs_pins == rhs_pins ) {
+                // Hyperedges are parallel
+                he_weights[lhs_he] += he_weights[rhs_he];
+                contracted_he_rhs.valid = false;
+                valid_hyperedges[rhs_he] = 0;
+                he_sizes[rhs_he] = 0;
+              }
+            }
+          }
+        }
+      }
+    });
+    hyperedge_hash_map.free();
+
+    // #################### STAGE 4 ####################
+    // Construct the hyperedges and incidence array of the coarse hypergraph
+    // by recomputing the contracted pins of each valid hyperedge. Afterwards,
+    // the incident nets are obtained by transposing the coarse incidence array.
+    StaticHypergraph hypergraph;
+
+    parallel::TBBPrefixSum<size_t, Array> he_mapping(valid_hyperedges);
+    parallel::TBBPrefixSum<size_t, Array> num_pins_prefix_sum(he_sizes);
+    hypergraph._num_hypernodes = num_hypernodes;
+    tbb::parallel_invoke([&] {
+      tbb::parallel_scan(tbb::blocked_range<size_t>(
+              UL(0), UI64(_num_hyperedges)), he_mapping);
+    }, [&] {
+      tbb::parallel_scan(tbb::blocked_range<size_t>(
+              UL(0), UI64(_num_hyperedges)), num_pins_prefix_sum);
+    }, [&] {
+      hypergraph.allocateHypernodes(true);
+    }, [&] {
+      hypergraph._community_ids.resize(num_hypernodes, 0);
+      doParallelForAllNodes([&](HypernodeID fine_hn) {
+        hypergraph.setCommunityID(map_to_coarse_hypergraph(fine_hn), communityID(fine_hn));
+      });
+    });
+
+    const HyperedgeID num_hyperedges = he_mapping.total_sum();
+    const size_t num_pins = num_pins_prefix_sum.total_sum();
+    hypergraph._num_hyperedges = num_hyperedges;
+    hypergraph._num_pins = num_pins;
+    hypergraph._total_degree = num_pins;
+    tbb::parallel_invoke([&] {
+      hypergraph.allocateHyperedges(true);
+    }, [&] {
+      allocateLevelArray(hypergraph._incidence_array, num_pins);
+    }, [&] {
+      allocateLevelArray(hypergraph._incident_nets, num_pins);
+    });
+
+    // Write hyperedges and pins of the coarse hypergraph
+    tbb::enumerable_thread_specific<size_t> local_max_edge_size(UL(0));
+    tbb::parallel_for(ID(0), _num_hyperedges, [&](const HyperedgeID& id) {
+      if ( he_mapping.value(id) /* hyperedge is valid */ ) {
+        parallel::scalable_vector<HypernodeID>& pins = local_lhs_pins.local();
+        compute_contracted_pins(id, pins);
+        ASSERT(pins.size() == num_pins_prefix_sum.value(id));
+        const size_t incidence_array_start = num_pins_prefix_sum[id];
+        hypergraph._hyperedges.first_entry[he_mapping[id]] = incidence_array_start;
+        hypergraph._hyperedges.weight[he_mapping[id]] = he_weights[id];
+        local_max_edge_size.local() = std::max(local_max_edge_size.local(), pins.size());
+        std::memcpy(hypergraph._incidence_array.data() + incidence_array_start,
+                    pins.data(), sizeof(HypernodeID) * pins.size());
+        for ( const HypernodeID& pin : pins ) {
+          ++tmp_num_incident_nets[pin];
+        }
+      }
+    });
+    hypergraph._hyperedges.first_entry[num_hyperedges] = num_pins;
+    hypergraph._max_edge_size = local_max_edge_size.combine(
+            [&](const size_t lhs, const size_t rhs) {
+              return std::max(lhs, rhs);
+            });
+    parallel::free(he_weights);
+
+    // Compute start position of the incident nets for each vertex inside
+    // the coarsened incident net array
+    parallel::TBBPrefixSum<parallel::IntegralAtomicWrapper<size_t>, Array>
+            num_incident_nets_prefix_sum(tmp_num_incident_nets);
+    parallel::scalable_vector<parallel::IntegralAtomicWrapper<size_t>> incident_nets_pos;
+    tbb::parallel_invoke([&] {
+      tbb::parallel_scan(tbb::blocked_range<size_t>(
+              UL(0), UI64(num_hypernodes)), num_incident_nets_prefix_sum);
+    }, [&] {
+      incident_nets_pos.assign(num_hypernodes, parallel::IntegralAtomicWrapper<size_t>(0));
+    });
+    ASSERT(num_incident_nets_prefix_sum.total_sum() == num_pins);
+
+    // Transpose the coarse incidence array
+    tbb::parallel_for(ID(0), num_hyperedges, [&](const HyperedgeID& he) {
+      for ( size_t pos = hypergraph.firstPinEntry(he); pos < hypergraph.firstInvalidPinEntry(he); ++pos ) {
+        const HypernodeID pin = hypergraph._incidence_array[pos];
+        hypergraph._incident_nets[num_incident_nets_prefix_sum[pin] +
+          incident_nets_pos[pin].fetch_add(1)] = he;
+      }
+    });
+
+    // Setup hypernodes. The incident nets are sorted, since the order in which
+    // they are written to the incident nets array is non-deterministic.
+    tbb::parallel_for(ID(0), num_hypernodes, [&](const HypernodeID& id) {
+      const size_t incident_nets_start = num_incident_nets_prefix_sum[id];
+      const size_t incident_nets_end = num_incident_nets_prefix_sum[id + 1];
+      if ( incident_nets_end - incident_nets_start <= HIGH_DEGREE_CONTRACTION_THRESHOLD ) {
+        std::sort(hypergraph._incident_nets.begin() + incident_nets_start,
+                  hypergraph._incident_nets.begin() + incident_nets_end);
+      } else {
+        tbb::parallel_sort(hypergraph._incident_nets.data() + incident_nets_start,
+                           hypergraph._incident_nets.data() + incident_nets_end);
+      }
+      hypergraph._hypernodes.first_entry[id] = incident_nets_start;
+      hypergraph._hypernodes.degree[id] = incident_nets_end - incident_nets_start;
+      hypergraph._hypernodes.weight[id] = hn_weights[id];
+    });
+    hypergraph._hypernodes.first_entry[num_hypernodes] = num_pins;
+
+    hypergraph._total_weight = _total_weight;   // didn't lose any vertices
+    hypergraph._fixed_vertices = _fixed_vertices.contract(map_to_coarse_hypergraph, num_hypernodes);
     hypergraph._tmp_contraction_buffer = _tmp_contraction_buffer;
     _tmp_contraction_buffer = nullptr;
     return hypergraph;
@@ -498,23 +831,113 @@ namespace mt_kahypar::ds {
     hypergraph._total_weight = _total_weight;
 
     tbb::parallel_invoke([&] {
-      hypergraph._hypernodes.resize(_hypernodes.size());
-      memcpy(hypergraph._hypernodes.data(), _hypernodes.data(),
-             sizeof(Hypernode) * _hypernodes.size());
+      copyElementArrays(hypergraph, true);
     }, [&] {
       hypergraph._incident_nets.resize(_incident_nets.size());
       memcpy(hypergraph._incident_nets.data(), _incident_nets.data(),
              sizeof(HyperedgeID) * _incident_nets.size());
-    }, [&] {
-      hypergraph._hyperedges.resize(_hyperedges.size());
-      memcpy(hypergraph._hyperedges.data(), _hyperedges.data(),
-             sizeof(Hyperedge) * _hyperedges.size());
     }, [&] {
       hypergraph._incidence_array.resize(_incidence_array.size());
       memcpy(hypergraph._incidence_array.data(), _incidence_array.data(),
              sizeof(HypernodeID) * _incidence_array.size());
     }, [&] {
       hypergraph._community_ids = _community_ids;
+    }, [&] {
+      hypergraph._fixed_vertices = _fixed_vertices;
+    });
+    return hypergraph;
+  }
+
+  StaticHypergraph StaticHypergraph::sharedCopy() const {
+    StaticHypergraph hypergraph;
+
+    hypergraph._num_hypernodes = _num_hypernodes;
+    hypergraph._num_removed_hypernodes = _num_removed_hypernodes;
+    hypergraph._num_hyperedges = _num_hyperedges;
+    hypergraph._num_removed_hyperedges = _num_removed_hyperedges;
+    hypergraph._max_edge_size = _max_edge_size;
+    hypergraph._num_pins = _num_pins;
+    hypergraph._total_degree = _total_degree;
+    hypergraph._total_weight = _total_weight;
+
+    shareArray(hypergraph._hypernodes.first_entry, _hypernodes.first_entry);
+    shareArray(hypergraph._hypernodes.degree, _hypernodes.degree);
+    shareArray(hypergraph._hypernodes.weight, _hypernodes.weight);
+    shareBitVector(hypergraph._hypernodes.enabled, _hypernodes.enabled);
+    hypergraph._incident_nets.use_external_memory(
+      const_cast<HyperedgeID*>(_incident_nets.data()), _incident_nets.size());
+    shareArray(hypergraph._hyperedges.first_entry, _hyperedges.first_entry);
+    shareArray(hypergraph._hyperedges.weight, _hyperedges.weight);
+    shareBitVector(hypergraph._hyperedges.enabled, _hyperedges.enabled);
+    hypergraph._incidence_array.use_external_memory(
+      const_cast<HypernodeID*>(_incidence_array.data()), _incidence_array.size());
+    tbb::parallel_invoke([&] {
+      hypergraph._community_ids = _community_ids;
+    }, [&] {
+      hypergraph._fixed_vertices = _fixed_vertices;
+    });
+    return hypergraph;
+  }
+
+  struct StaticHypergraph::SharedTopology {
+    IncidentNets incident_nets;
+    IncidenceArray incidence_array;
+    // ! Keeps the memory alive to which the arrays above may point
+    // ! (e.g., a memory-mapped snapshot or a previously shared topology)
+    std::shared_ptr<void> memory_owner;
+  };
+
+  void StaticHypergraph::shareTopology() {
+    if ( _shared_topology && _incident_nets_shared ) {
+      return;
+    }
+    // Moving the arrays does not move the underlying memory, which
+    // is now owned by the topology
+    auto topology = std::make_shared<SharedTopology>();
+    topology->incident_nets = std::move(_incident_nets);
+    topology->incidence_array = std::move(_incidence_array);
+    topology->memory_owner = _shared_topology ? _shared_topology : _external_memory;
+    _incident_nets.use_external_memory(
+      topology->incident_nets.data(), topology->incident_nets.size());
+    _incidence_array.use_external_memory(
+      topology->incidence_array.data(), topology->incidence_array.size());
+    _shared_topology = std::move(topology);
+    _incident_nets_shared = true;
+  }
+
+  void StaticHypergraph::copyIncidentNetsOnWrite() {
+    ASSERT(_incident_nets_shared);
+    IncidentNets incident_nets;
+    incident_nets.resize(_incident_nets.size());
+    memcpy(incident_nets.data(), _incident_nets.data(),
+           sizeof(HyperedgeID) * _incident_nets.size());
+    _incident_nets = std::move(incident_nets);
+    _incident_nets_shared = false;
+  }
+
+  StaticHypergraph StaticHypergraph::copyOnWrite(parallel_tag_t) {
+    shareTopology();
+    StaticHypergraph hypergraph;
+
+    hypergraph._num_hypernodes = _num_hypernodes;
+    hypergraph._num_removed_hypernodes = _num_removed_hypernodes;
+    hypergraph._num_hyperedges = _num_hyperedges;
+    hypergraph._num_removed_hyperedges = _num_removed_hyperedges;
+    hypergraph._max_edge_size = _max_edge_size;
+    hypergraph._num_pins = _num_pins;
+    hypergraph._total_degree = _total_degree;
+    hypergraph._total_weight = _total_weight;
+
+    hypergraph._incident_nets.use_external_memory(_incident_nets.data(), _incident_nets.size());
+    hypergraph._incidence_array.use_external_memory(_incidence_array.data(), _incidence_array.size());
+    hypergraph._shared_topology = _shared_topology;
+    hypergraph._incident_nets_shared = true;
+    tbb::parallel_invoke([&] {
+      copyElementArrays(hypergraph, true);
+    }, [&] {
+      hypergraph._community_ids = _community_ids;
+    }, [&] {
+      hypergraph._fixed_vertices = _fixed_vertices;
     });
     return hypergraph;
   }
@@ -532,21 +955,17 @@ namespace mt_kahypar::ds {
     hypergraph._total_degree = _total_degree;
     hypergraph._total_weight = _total_weight;
 
-    hypergraph._hypernodes.resize(_hypernodes.size());
-    memcpy(hypergraph._hypernodes.data(), _hypernodes.data(),
-           sizeof(Hypernode) * _hypernodes.size());
+    copyElementArrays(hypergraph, false);
     hypergraph._incident_nets.resize(_incident_nets.size());
     memcpy(hypergraph._incident_nets.data(), _incident_nets.data(),
            sizeof(HyperedgeID) * _incident_nets.size());
 
-    hypergraph._hyperedges.resize(_hyperedges.size());
-    memcpy(hypergraph._hyperedges.data(), _hyperedges.data(),
-           sizeof(Hyperedge) * _hyperedges.size());
     hypergraph._incidence_array.resize(_incidence_array.size());
     memcpy(hypergraph._incidence_array.data(), _incidence_array.data(),
            sizeof(HypernodeID) * _incidence_array.size());
 
     hypergraph._community_ids = _community_ids;
+    hypergraph._fixed_vertices = _fixed_vertices;
 
     return hypergraph;
   }
@@ -554,13 +973,75 @@ namespace mt_kahypar::ds {
 
 
 
+  void StaticHypergraph::allocateHypernodes(const bool use_level_arena) {
+    auto allocate = [&](auto& array, const size_t size, const auto init_value) {
+      if ( use_level_arena ) {
+        allocateLevelArray(array, size, init_value);
+      } else {
+        array.resize(size, init_value);
+      }
+    };
+    tbb::parallel_invoke([&] {
+      allocate(_hypernodes.first_entry, UI64(_num_hypernodes) + 1, UL(0));
+    }, [&] {
+      allocate(_hypernodes.degree, _num_hypernodes, ID(0));
+    }, [&] {
+      allocate(_hypernodes.weight, _num_hypernodes, HypernodeWeight(1));
+    }, [&] {
+      _hypernodes.enabled.setSize(_num_hypernodes, true);
+    });
+  }
+
+  void StaticHypergraph::allocateHyperedges(const bool use_level_arena) {
+    auto allocate = [&](auto& array, const size_t size, const auto init_value) {
+      if ( use_level_arena ) {
+        allocateLevelArray(array, size, init_value);
+      } else {
+        array.resize(size, init_value);
+      }
+    };
+    tbb::parallel_invoke([&] {
+      allocate(_hyperedges.first_entry, UI64(_num_hyperedges) + 1, UL(0));
+    }, [&] {
+      allocate(_hyperedges.weight, _num_hyperedges, HyperedgeWeight(1));
+    }, [&] {
+      _hyperedges.enabled.setSize(_num_hyperedges, true);
+    });
+  }
+
+  void StaticHypergraph::copyElementArrays(StaticHypergraph& hypergraph, const bool parallel) const {
+    auto copy_hypernodes = [&] {
+      copyArray(hypergraph._hypernodes.first_entry, _hypernodes.first_entry, parallel);
+      copyArray(hypergraph._hypernodes.degree, _hypernodes.degree, parallel);
+      copyArray(hypergraph._hypernodes.weight, _hypernodes.weight, parallel);
+      hypergraph._hypernodes.enabled.copy(_hypernodes.enabled);
+    };
+    auto copy_hyperedges = [&] {
+      copyArray(hypergraph._hyperedges.first_entry, _hyperedges.first_entry, parallel);
+      copyArray(hypergraph._hyperedges.weight, _hyperedges.weight, parallel);
+      hypergraph._hyperedges.enabled.copy(_hyperedges.enabled);
+    };
+    if ( parallel ) {
+      tbb::parallel_invoke(copy_hypernodes, copy_hyperedges);
+    } else {
+      copy_hypernodes();
+      copy_hyperedges();
+    }
+  }
+
   void StaticHypergraph::memoryConsumption(utils::MemoryTreeNode* parent) const {
     ASSERT(parent);
-    parent->addChild("Hypernodes", sizeof(Hypernode) * _hypernodes.size());
+    parent->addChild("Hypernodes", sizeof(size_t) * _hypernodes.first_entry.size() +
+      sizeof(HyperedgeID) * _hypernodes.degree.size() +
+      sizeof(HypernodeWeight) * _hypernodes.weight.size() + _hypernodes.enabled.size_in_bytes());
     parent->addChild("Incident Nets", sizeof(HyperedgeID) * _incident_nets.size());
-    parent->addChild("Hyperedges", sizeof(Hyperedge) * _hyperedges.size());
+    parent->addChild("Hyperedges", sizeof(size_t) * _hyperedges.first_entry.size() +
+      sizeof(HyperedgeWeight) * _hyperedges.weight.size() + _hyperedges.enabled.size_in_bytes());
     parent->addChild("Incidence Array", sizeof(HypernodeID) * _incidence_array.size());
     parent->addChild("Communities", sizeof(PartitionID) * _community_ids.capacity());
+    if ( _fixed_vertices.hasFixedVertices() ) {
+      parent->addChild("Fixed Vertices", _fixed_vertices.sizeInBytes());
+    }
   }
 
   // ! Computes the total node weight of the hypergraph
@@ -570,7 +1051,7 @@ namespace mt_kahypar::ds {
                                            HypernodeWeight weight = init;
                                            for (HypernodeID hn = range.begin(); hn < range.end(); ++hn) {
                                              if (nodeIsEnabled(hn)) {
-                                               weight += this->_hypernodes[hn].weight();
+                                               weight += this->_hypernodes.weight[hn];
                                              }
                                            }
                                            return weight;
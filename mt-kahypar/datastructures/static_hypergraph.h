@@ -27,13 +27,17 @@
 
 #pragma once
 
+#include <memory>
 
 #include "tbb/parallel_for.h"
 
 #include "mt-kahypar/macros.h"
 #include "mt-kahypar/datastructures/array.h"
+#include "mt-kahypar/datastructures/atomic_bit_vector.h"
+#include "mt-kahypar/datastructures/fixed_vertex_support.h"
 #include "mt-kahypar/datastructures/hypergraph_common.h"
 #include "mt-kahypar/parallel/atomic_wrapper.h"
+#include "mt-kahypar/parallel/level_arena.h"
 #include "mt-kahypar/parallel/stl/scalable_vector.h"
 #include "mt-kahypar/partition/context_enum_classes.h"
 #include "mt-kahypar/utils/memory_tree.h"
@@ -59,6 +63,10 @@ class StaticHypergraph {
   // degree vertices. Therefore, all vertices with temporary degree greater
   // than this threshold are contracted with a special procedure.
   static constexpr HyperedgeID HIGH_DEGREE_CONTRACTION_THRESHOLD = ID(500000);
+  // Hyperedges with equal hash and size are sorted lexicographically during
+  // parallel net detection. If such a run contains more pins than this threshold
+  // in total, it is sorted in parallel.
+  static constexpr size_t PARALLEL_NET_DETECTION_SORT_THRESHOLD = UL(100000);
 
   static_assert(std::is_unsigned<HypernodeID>::value, "Hypernode ID must be unsigned");
   static_assert(std::is_unsigned<HyperedgeID>::value, "Hyperedge ID must be unsigned");
@@ -69,8 +77,9 @@ class StaticHypergraph {
   #define NOOP_BATCH_FUNC [] (const HypernodeID, const HypernodeID, const HyperedgeID) { }
 
   /**
-   * Represents a hypernode of the hypergraph and contains all information
-   * associated with a vertex.
+   * Represents a hypernode in the temporary buffers of the contraction. Note that
+   * the hypergraph itself stores its hypernodes as structure-of-arrays
+   * (see HypernodeArrays).
    */
   class Hypernode {
    public:
@@ -88,13 +97,6 @@ class StaticHypergraph {
       _weight(1),
       _valid(valid) { }
 
-    // Sentinel Constructor
-    Hypernode(const size_t begin) :
-      _begin(begin),
-      _size(0),
-      _weight(1),
-      _valid(false) { }
-
     bool isDisabled() const {
       return _valid == false;
     }
@@ -156,8 +158,9 @@ class StaticHypergraph {
   };
 
   /**
-   * Represents a hyperedge of the hypergraph and contains all information
-   * associated with a net (except connectivity information).
+   * Represents a hyperedge in the temporary buffers of the contraction. Note that
+   * the hypergraph itself stores its hyperedges as structure-of-arrays
+   * (see HyperedgeArrays).
    */
   class Hyperedge {
    public:
@@ -169,12 +172,12 @@ class StaticHypergraph {
       _weight(1),
       _valid(false) { }
 
-    // Sentinel Constructor
-    Hyperedge(const size_t begin) :
+    // ! Constructs an enabled hyperedge
+    Hyperedge(const size_t begin, const size_t size, const HyperedgeWeight weight) :
       _begin(begin),
-      _size(0),
-      _weight(1),
-      _valid(false) { }
+      _size(size),
+      _weight(weight),
+      _valid(true) { }
 
     // ! Disables the hypernode/hyperedge. Disable hypernodes/hyperedges will be skipped
     // ! when iterating over the set of all nodes/edges.
@@ -259,15 +262,15 @@ class StaticHypergraph {
    * the set of hyperedges.
    *
    * In order to be as generic as possible, the iterator does not expose the
-   * internal Hypernode/Hyperedge representations. Instead only handles to
+   * internal hypernode/hyperedge representations. Instead only handles to
    * the respective elements are returned, i.e. the IDs of the corresponding
-   * hypernodes/hyperedges.
+   * hypernodes/hyperedges. The iterator only reads the enabled flags of the
+   * elements.
    *
    */
-  template <typename ElementType>
+  template <typename IDType>
   class HypergraphElementIterator {
    public:
-    using IDType = typename ElementType::IDType;
     using iterator_category = std::forward_iterator_tag;
     using value_type = IDType;
     using reference = IDType&;
@@ -281,15 +284,15 @@ class StaticHypergraph {
      * If start_element is invalid, the iterator advances to the first valid
      * element.
      *
-     * \param start_element A pointer to the starting position
-     * \param id The index of the element the pointer points to
+     * \param enabled Enabled flags of the elements
+     * \param id The index of the element the iterator points to
      * \param max_id The maximum index allowed
      */
-    HypergraphElementIterator(const ElementType* start_element, IDType id, IDType max_id) :
+    HypergraphElementIterator(const AtomicBitVector* enabled, IDType id, IDType max_id) :
       _id(id),
       _max_id(max_id),
-      _element(start_element) {
-      if (_id != _max_id && _element->isDisabled()) {
+      _enabled(enabled) {
+      if (_id != _max_id && !(*_enabled)[_id]) {
         operator++ ();
       }
     }
@@ -304,8 +307,7 @@ class StaticHypergraph {
       ASSERT(_id < _max_id);
       do {
         ++_id;
-        ++_element;
-      } while (_id < _max_id && _element->isDisabled());
+      } while (_id < _max_id && !(*_enabled)[_id]);
       return *this;
     }
 
@@ -329,13 +331,42 @@ class StaticHypergraph {
     IDType _id = 0;
     // Maximum allowed index
     IDType _max_id = 0;
-    // HypergraphElement the iterator currently points to
-    const ElementType* _element = nullptr;
+    // Enabled flags of the HypergraphElements
+    const AtomicBitVector* _enabled = nullptr;
   };
 
   static_assert(std::is_trivially_copyable<Hypernode>::value, "Hypernode is not trivially copyable");
   static_assert(std::is_trivially_copyable<Hyperedge>::value, "Hyperedge is not trivially copyable");
 
+  /**
+   * The hypernodes and hyperedges of the hypergraph are stored as structure-of-arrays.
+   * Sweeps that only need one attribute (e.g., the weights in gain computations and
+   * metrics or the sizes during rating) therefore do not load the other attributes
+   * into the cache. The offset arrays contain a sentinel element such that the size
+   * of a hyperedge is derived from two adjacent offsets. The degree of a hypernode
+   * is stored explicitly, since removing a hyperedge shrinks the incident nets of
+   * its pins in place.
+   */
+  struct HypernodeArrays {
+    // ! Index of the first element in _incident_nets (contains a sentinel)
+    Array<size_t> first_entry;
+    // ! Number of incident nets
+    Array<HyperedgeID> degree;
+    // ! Hypernode weights
+    Array<HypernodeWeight> weight;
+    // ! Flags indicating whether or not a hypernode is active
+    AtomicBitVector enabled;
+  };
+
+  struct HyperedgeArrays {
+    // ! Index of the first element in _incidence_array (contains a sentinel)
+    Array<size_t> first_entry;
+    // ! Hyperedge weights
+    Array<HyperedgeWeight> weight;
+    // ! Flags indicating whether or not a hyperedge is active
+    AtomicBitVector enabled;
+  };
+
   using IncidenceArray = Array<HypernodeID>;
   using IncidentNets = Array<HyperedgeID>;
 
@@ -343,23 +374,34 @@ class StaticHypergraph {
   // ! Struct is allocated on top level hypergraph and passed to each contracted
   // ! hypergraph such that memory can be reused in consecutive contractions.
   struct TmpContractionBuffer {
+    // ! In low memory mode, the temporary buffers for hypernodes, hyperedges,
+    // ! pins and incident nets are not allocated (see contract_low_memory(...))
     explicit TmpContractionBuffer(const HypernodeID num_hypernodes,
                                   const HyperedgeID num_hyperedges,
-                                  const HyperedgeID num_pins) {
+                                  const HyperedgeID num_pins,
+                                  const bool low_memory) {
       tbb::parallel_invoke([&] {
         mapping.resize("Coarsening", "mapping", num_hypernodes);
       }, [&] {
-        tmp_hypernodes.resize("Coarsening", "tmp_hypernodes", num_hypernodes);
+        if ( !low_memory ) {
+          tmp_hypernodes.resize("Coarsening", "tmp_hypernodes", num_hypernodes);
+        }
       }, [&] {
-        tmp_incident_nets.resize("Coarsening", "tmp_incident_nets", num_pins);
+        if ( !low_memory ) {
+          tmp_incident_nets.resize("Coarsening", "tmp_incident_nets", num_pins);
+        }
       }, [&] {
         tmp_num_incident_nets.resize("Coarsening", "tmp_num_incident_nets", num_hypernodes);
       }, [&] {
         hn_weights.resize("Coarsening", "hn_weights", num_hypernodes);
       }, [&] {
-        tmp_hyperedges.resize("Coarsening", "tmp_hyperedges", num_hyperedges);
+        if ( !low_memory ) {
+          tmp_hyperedges.resize("Coarsening", "tmp_hyperedges", num_hyperedges);
+        }
       }, [&] {
-        tmp_incidence_array.resize("Coarsening", "tmp_incidence_array", num_pins);
+        if ( !low_memory ) {
+          tmp_incidence_array.resize("Coarsening", "tmp_incidence_array", num_pins);
+        }
       }, [&] {
         he_sizes.resize("Coarsening", "he_sizes", num_hyperedges);
       }, [&] {
@@ -386,9 +428,9 @@ class StaticHypergraph {
   static constexpr size_t SIZE_OF_HYPEREDGE = sizeof(Hyperedge);
 
   // ! Iterator to iterate over the hypernodes
-  using HypernodeIterator = HypergraphElementIterator<const Hypernode>;
+  using HypernodeIterator = HypergraphElementIterator<HypernodeID>;
   // ! Iterator to iterate over the hyperedges
-  using HyperedgeIterator = HypergraphElementIterator<const Hyperedge>;
+  using HyperedgeIterator = HypergraphElementIterator<HyperedgeID>;
   // ! Iterator to iterate over the pins of a hyperedge
   using IncidenceIterator = typename IncidenceArray::const_iterator;
   // ! Iterator to iterate over the incident nets of a hypernode
@@ -414,7 +456,11 @@ class StaticHypergraph {
     _hyperedges(),
     _incidence_array(),
     _community_ids(0),
-    _tmp_contraction_buffer(nullptr) { }
+    _fixed_vertices(),
+    _tmp_contraction_buffer(nullptr),
+    _external_memory(nullptr),
+    _shared_topology(nullptr),
+    _incident_nets_shared(false) { }
 
   StaticHypergraph(const StaticHypergraph&) = delete;
   StaticHypergraph & operator= (const StaticHypergraph &) = delete;
@@ -434,7 +480,11 @@ class StaticHypergraph {
     _hyperedges(std::move(other._hyperedges)),
     _incidence_array(std::move(other._incidence_array)),
     _community_ids(std::move(other._community_ids)),
-    _tmp_contraction_buffer(std::move(other._tmp_contraction_buffer)) {
+    _fixed_vertices(std::move(other._fixed_vertices)),
+    _tmp_contraction_buffer(std::move(other._tmp_contraction_buffer)),
+    _external_memory(std::move(other._external_memory)),
+    _shared_topology(std::move(other._shared_topology)),
+    _incident_nets_shared(other._incident_nets_shared) {
     other._tmp_contraction_buffer = nullptr;
   }
 
@@ -453,7 +503,11 @@ class StaticHypergraph {
     _hyperedges = std::move(other._hyperedges);
     _incidence_array = std::move(other._incidence_array);
     _community_ids = std::move(other._community_ids),
+    _fixed_vertices = std::move(other._fixed_vertices);
     _tmp_contraction_buffer = std::move(other._tmp_contraction_buffer);
+    _external_memory = std::move(other._external_memory);
+    _shared_topology = std::move(other._shared_topology);
+    _incident_nets_shared = other._incident_nets_shared;
     other._tmp_contraction_buffer = nullptr;
     return *this;
   }
@@ -499,12 +553,12 @@ class StaticHypergraph {
   }
 
   // ! Initial number of pins
-  HypernodeID initialNumPins() const {
+  size_t initialNumPins() const {
     return _num_pins;
   }
 
   // ! Initial sum of the degree of all vertices
-  HypernodeID initialTotalVertexDegree() const {
+  size_t initialTotalVertexDegree() const {
     return _total_degree;
   }
 
@@ -543,72 +597,85 @@ class StaticHypergraph {
   // ! Returns a range of the active nodes of the hypergraph
   IteratorRange<HypernodeIterator> nodes() const {
     return IteratorRange<HypernodeIterator>(
-      HypernodeIterator(_hypernodes.data(), ID(0), _num_hypernodes),
-      HypernodeIterator(_hypernodes.data() + _num_hypernodes, _num_hypernodes, _num_hypernodes));
+      HypernodeIterator(&_hypernodes.enabled, ID(0), _num_hypernodes),
+      HypernodeIterator(&_hypernodes.enabled, _num_hypernodes, _num_hypernodes));
   }
 
   // ! Returns a range of the active edges of the hypergraph
   IteratorRange<HyperedgeIterator> edges() const {
     return IteratorRange<HyperedgeIterator>(
-      HyperedgeIterator(_hyperedges.data(), ID(0), _num_hyperedges),
-      HyperedgeIterator(_hyperedges.data() + _num_hyperedges, _num_hyperedges, _num_hyperedges));
+      HyperedgeIterator(&_hyperedges.enabled, ID(0), _num_hyperedges),
+      HyperedgeIterator(&_hyperedges.enabled, _num_hyperedges, _num_hyperedges));
   }
 
   // ! Returns a range to loop over the incident nets of hypernode u.
   IteratorRange<IncidentNetsIterator> incidentEdges(const HypernodeID u) const {
-    ASSERT(!hypernode(u).isDisabled(), "Hypernode" << u << "is disabled");
-    const Hypernode& hn = hypernode(u);
+    ASSERT(nodeIsEnabled(u), "Hypernode" << u << "is disabled");
     return IteratorRange<IncidentNetsIterator>(
-      _incident_nets.cbegin() + hn.firstEntry(),
-      _incident_nets.cbegin() + hn.firstInvalidEntry());
+      _incident_nets.cbegin() + firstIncidentNetEntry(u),
+      _incident_nets.cbegin() + firstInvalidIncidentNetEntry(u));
   }
 
   // ! Returns a range to loop over the pins of hyperedge e.
   IteratorRange<IncidenceIterator> pins(const HyperedgeID e) const {
-    ASSERT(!hyperedge(e).isDisabled(), "Hyperedge" << e << "is disabled");
-    const Hyperedge& he = hyperedge(e);
+    ASSERT(edgeIsEnabled(e), "Hyperedge" << e << "is disabled");
     return IteratorRange<IncidenceIterator>(
-      _incidence_array.cbegin() + he.firstEntry(),
-      _incidence_array.cbegin() + he.firstInvalidEntry());
+      _incidence_array.cbegin() + firstPinEntry(e),
+      _incidence_array.cbegin() + firstInvalidPinEntry(e));
+  }
+
+  // ! Prefetches the pin offsets and the weight of hyperedge e
+  void prefetchHyperedge(const HyperedgeID e) const {
+    MT_KAHYPAR_PREFETCH(_hyperedges.first_entry.data() + e);
+    MT_KAHYPAR_PREFETCH(_hyperedges.weight.data() + e);
+  }
+
+  // ! Prefetches the first pins of hyperedge e (reads the pin offset of e)
+  void prefetchPins(const HyperedgeID e) const {
+    MT_KAHYPAR_PREFETCH(_incidence_array.data() + firstPinEntry(e));
   }
 
     // ####################### Hypernode Information #######################
 
   // ! Weight of a vertex
   HypernodeWeight nodeWeight(const HypernodeID u) const {
-    return hypernode(u).weight();
+    ASSERT(u < _num_hypernodes, "Hypernode" << u << "does not exist");
+    return _hypernodes.weight[u];
   }
 
   // ! Sets the weight of a vertex
   void setNodeWeight(const HypernodeID u, const HypernodeWeight weight) {
-    ASSERT(!hypernode(u).isDisabled(), "Hypernode" << u << "is disabled");
-    return hypernode(u).setWeight(weight);
+    ASSERT(nodeIsEnabled(u), "Hypernode" << u << "is disabled");
+    _hypernodes.weight[u] = weight;
   }
 
   // ! Degree of a hypernode
   HyperedgeID nodeDegree(const HypernodeID u) const {
-    ASSERT(!hypernode(u).isDisabled(), "Hypernode" << u << "is disabled");
-    return hypernode(u).size();
+    ASSERT(nodeIsEnabled(u), "Hypernode" << u << "is disabled");
+    return _hypernodes.degree[u];
   }
 
   // ! Returns, whether a hypernode is enabled or not
   bool nodeIsEnabled(const HypernodeID u) const {
-    return !hypernode(u).isDisabled();
+    ASSERT(u < _num_hypernodes, "Hypernode" << u << "does not exist");
+    return _hypernodes.enabled[u];
   }
 
   // ! Enables a hypernode (must be disabled before)
   void enableHypernode(const HypernodeID u) {
-    hypernode(u).enable();
+    ASSERT(!nodeIsEnabled(u), "Hypernode" << u << "is enabled");
+    _hypernodes.enabled.set(u, true);
   }
 
   // ! Disables a hypernode (must be enabled before)
   void disableHypernode(const HypernodeID u) {
-    hypernode(u).disable();
+    ASSERT(nodeIsEnabled(u), "Hypernode" << u << "is disabled");
+    _hypernodes.enabled.set(u, false);
   }
 
   // ! Removes a hypernode (must be enabled before)
   void removeHypernode(const HypernodeID u) {
-    hypernode(u).disable();
+    disableHypernode(u);
     ++_num_removed_hypernodes;
   }
 
@@ -621,7 +688,7 @@ class StaticHypergraph {
 
   // ! Restores a degree zero hypernode
   void restoreDegreeZeroHypernode(const HypernodeID u) {
-    hypernode(u).enable();
+    enableHypernode(u);
     ASSERT(nodeDegree(u) == 0);
     _removed_degree_zero_hn_weight -= nodeWeight(u);
   }
@@ -630,20 +697,20 @@ class StaticHypergraph {
 
   // ! Weight of a hyperedge
   HypernodeWeight edgeWeight(const HyperedgeID e) const {
-    ASSERT(!hyperedge(e).isDisabled(), "Hyperedge" << e << "is disabled");
-    return hyperedge(e).weight();
+    ASSERT(edgeIsEnabled(e), "Hyperedge" << e << "is disabled");
+    return _hyperedges.weight[e];
   }
 
   // ! Sets the weight of a hyperedge
   void setEdgeWeight(const HyperedgeID e, const HyperedgeWeight weight) {
-    ASSERT(!hyperedge(e).isDisabled(), "Hyperedge" << e << "is disabled");
-    return hyperedge(e).setWeight(weight);
+    ASSERT(edgeIsEnabled(e), "Hyperedge" << e << "is disabled");
+    _hyperedges.weight[e] = weight;
   }
 
   // ! Number of pins of a hyperedge
   HypernodeID edgeSize(const HyperedgeID e) const {
-    ASSERT(!hyperedge(e).isDisabled(), "Hyperedge" << e << "is disabled");
-    return hyperedge(e).size();
+    ASSERT(edgeIsEnabled(e), "Hyperedge" << e << "is disabled");
+    return firstInvalidPinEntry(e) - firstPinEntry(e);
   }
 
   // ! Maximum size of a hyperedge
@@ -653,17 +720,20 @@ class StaticHypergraph {
 
   // ! Returns, whether a hyperedge is enabled or not
   bool edgeIsEnabled(const HyperedgeID e) const {
-    return !hyperedge(e).isDisabled();
+    ASSERT(e < _num_hyperedges, "Hyperedge" << e << "does not exist");
+    return _hyperedges.enabled[e];
   }
 
   // ! Enables a hyperedge (must be disabled before)
   void enableHyperedge(const HyperedgeID e) {
-    hyperedge(e).enable();
+    ASSERT(!edgeIsEnabled(e), "Hyperedge" << e << "is enabled");
+    _hyperedges.enabled.set(e, true);
   }
 
   // ! Disabled a hyperedge (must be enabled before)
   void disableHyperedge(const HyperedgeID e) {
-    hyperedge(e).disable();
+    ASSERT(edgeIsEnabled(e), "Hyperedge" << e << "is disabled");
+    _hyperedges.enabled.set(e, false);
   }
 
   // ! Community id which hypernode u is assigned to
@@ -676,6 +746,31 @@ class StaticHypergraph {
     _community_ids[u] = community_id;
   }
 
+  // ####################### Fixed Vertex Support #######################
+
+  bool hasFixedVertices() const {
+    return _fixed_vertices.hasFixedVertices();
+  }
+
+  // ! Returns true, if hypernode u is fixed to a block
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool isFixed(const HypernodeID u) const {
+    return _fixed_vertices.isFixed(u);
+  }
+
+  // ! Block to which hypernode u is fixed (kInvalidPartition, if u is not fixed)
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE PartitionID fixedVertexBlock(const HypernodeID u) const {
+    return _fixed_vertices.fixedVertexBlock(u);
+  }
+
+  const FixedVertexSupport& fixedVertexSupport() const {
+    return _fixed_vertices;
+  }
+
+  // ! Fixes hypernode u to the given block (not thread-safe)
+  void fixToBlock(const HypernodeID u, const PartitionID block) {
+    _fixed_vertices.fixToBlock(u, block, initialNumNodes());
+  }
+
   // ####################### Contract / Uncontract #######################
 
   /*!
@@ -686,8 +781,11 @@ class StaticHypergraph {
    * community label (given in 'communities') to a vertex in the coarse hypergraph.
    *
    * \param communities Community structure that should be contracted
+   * \param low_memory If true, the contraction does not use temporary buffers
+   *                   for pins and incident nets (see contract_low_memory(...))
    */
-  StaticHypergraph contract(parallel::scalable_vector<HypernodeID>& communities);
+  StaticHypergraph contract(parallel::scalable_vector<HypernodeID>& communities,
+                            const bool low_memory = false);
 
   bool registerContraction(const HypernodeID, const HypernodeID) {
     ERR("registerContraction(u, v) is not supported in static hypergraph");
@@ -701,6 +799,13 @@ class StaticHypergraph {
     return 0;
   }
 
+  size_t contractMatching(const Batch&,
+                          const HypernodeWeight max_node_weight = std::numeric_limits<HypernodeWeight>::max()) {
+    unused(max_node_weight);
+    ERR("contractMatching(matching, max_node_weight) is not supported in static hypergraph");
+    return 0;
+  }
+
   void uncontract(const Batch&,
                   const UncontractionFunction& case_one_func = NOOP_BATCH_FUNC,
                   const UncontractionFunction& case_two_func = NOOP_BATCH_FUNC) {
@@ -725,6 +830,7 @@ class StaticHypergraph {
   */
   void removeEdge(const HyperedgeID he) {
     ASSERT(edgeIsEnabled(he), "Hyperedge" << he << "is disabled");
+    detachIncidentNets();
     for ( const HypernodeID& pin : pins(he) ) {
       removeIncidentEdgeFromHypernode(he, pin);
     }
@@ -742,8 +848,9 @@ class StaticHypergraph {
   */
   void removeLargeEdge(const HyperedgeID he) {
     ASSERT(edgeIsEnabled(he), "Hyperedge" << he << "is disabled");
-    const size_t incidence_array_start = hyperedge(he).firstEntry();
-    const size_t incidence_array_end = hyperedge(he).firstInvalidEntry();
+    detachIncidentNets();
+    const size_t incidence_array_start = firstPinEntry(he);
+    const size_t incidence_array_end = firstInvalidPinEntry(he);
     tbb::parallel_for(incidence_array_start, incidence_array_end, [&](const size_t pos) {
       const HypernodeID pin = _incidence_array[pos];
       removeIncidentEdgeFromHypernode(he, pin);
@@ -756,9 +863,10 @@ class StaticHypergraph {
    */
   void restoreLargeEdge(const HyperedgeID& he) {
     ASSERT(!edgeIsEnabled(he), "Hyperedge" << he << "is enabled");
+    detachIncidentNets();
     enableHyperedge(he);
-    const size_t incidence_array_start = hyperedge(he).firstEntry();
-    const size_t incidence_array_end = hyperedge(he).firstInvalidEntry();
+    const size_t incidence_array_start = firstPinEntry(he);
+    const size_t incidence_array_end = firstInvalidPinEntry(he);
     tbb::parallel_for(incidence_array_start, incidence_array_end, [&](const size_t pos) {
       const HypernodeID pin = _incidence_array[pos];
       insertIncidentEdgeToHypernode(he, pin);
@@ -795,6 +903,19 @@ class StaticHypergraph {
   // ! Copy static hypergraph sequential
   StaticHypergraph copy() const;
 
+  // ! Returns a hypergraph that shares its structure arrays with this hypergraph
+  // ! (only community IDs and fixed vertices are copied). The shared arrays are
+  // ! read-only, i.e., the copy must not be modified (contracting it is fine),
+  // ! and this hypergraph must outlive the copy.
+  StaticHypergraph sharedCopy() const;
+
+  // ! Returns a copy that shares the incidence arrays (the topology) with this
+  // ! hypergraph through reference counting. Only the hypernode and hyperedge
+  // ! attributes (weights, enabled flags, offsets), community IDs and fixed vertices
+  // ! are duplicated. Both hypergraphs copy the shared incident nets once they
+  // ! remove or restore hyperedges (copy-on-write).
+  StaticHypergraph copyOnWrite(parallel_tag_t);
+
   // ! Reset internal data structure
   void reset() { }
 
@@ -832,37 +953,68 @@ class StaticHypergraph {
 
   // ####################### Hypernode Information #######################
 
-  // ! Accessor for hypernode-related information
-  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE const Hypernode& hypernode(const HypernodeID u) const {
+  // ! Index of the first incident net of vertex u in _incident_nets
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE size_t firstIncidentNetEntry(const HypernodeID u) const {
     ASSERT(u <= _num_hypernodes, "Hypernode" << u << "does not exist");
-    return _hypernodes[u];
+    return _hypernodes.first_entry[u];
   }
 
-  // ! To avoid code duplication we implement non-const version in terms of const version
-  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE Hypernode& hypernode(const HypernodeID u) {
-    return const_cast<Hypernode&>(static_cast<const StaticHypergraph&>(*this).hypernode(u));
+  // ! Index after the last incident net of vertex u in _incident_nets
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE size_t firstInvalidIncidentNetEntry(const HypernodeID u) const {
+    ASSERT(u < _num_hypernodes, "Hypernode" << u << "does not exist");
+    return _hypernodes.first_entry[u] + _hypernodes.degree[u];
   }
 
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE IteratorRange<IncidentNetsIterator> incident_nets_of(const HypernodeID u,
                                                                                           const size_t pos = 0) const {
-    ASSERT(!hypernode(u).isDisabled(), "Hypernode" << u << "is disabled");
-    const Hypernode& hn = hypernode(u);
+    ASSERT(nodeIsEnabled(u), "Hypernode" << u << "is disabled");
     return IteratorRange<IncidentNetsIterator>(
-      _incident_nets.cbegin() + hn.firstEntry() + pos,
-      _incident_nets.cbegin() + hn.firstInvalidEntry());
+      _incident_nets.cbegin() + firstIncidentNetEntry(u) + pos,
+      _incident_nets.cbegin() + firstInvalidIncidentNetEntry(u));
   }
 
   // ####################### Hyperedge Information #######################
 
-  // ! Accessor for hyperedge-related information
-  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE const Hyperedge& hyperedge(const HyperedgeID e) const {
+  // ! Index of the first pin of hyperedge e in _incidence_array
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE size_t firstPinEntry(const HyperedgeID e) const {
     ASSERT(e <= _num_hyperedges, "Hyperedge" << e << "does not exist");
-    return _hyperedges[e];
+    return _hyperedges.first_entry[e];
   }
 
-  // ! To avoid code duplication we implement non-const version in terms of const version
-  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE Hyperedge& hyperedge(const HyperedgeID e) {
-    return const_cast<Hyperedge&>(static_cast<const StaticHypergraph&>(*this).hyperedge(e));
+  // ! Index after the last pin of hyperedge e in _incidence_array
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE size_t firstInvalidPinEntry(const HyperedgeID e) const {
+    ASSERT(e < _num_hyperedges, "Hyperedge" << e << "does not exist");
+    return _hyperedges.first_entry[e + 1];
+  }
+
+  // ####################### Hypernode / Hyperedge Arrays #######################
+
+  // ! Allocates the hypernode arrays for _num_hypernodes vertices. All vertices are
+  // ! enabled and have unit weight. The offsets (including the sentinel) must be set
+  // ! by the caller. If use_level_arena is true, the arrays are allocated in the
+  // ! level arena (see allocateLevelArray(...)).
+  void allocateHypernodes(const bool use_level_arena);
+
+  // ! Allocates the hyperedge arrays for _num_hyperedges nets (see allocateHypernodes(...))
+  void allocateHyperedges(const bool use_level_arena);
+
+  // ! Copies the hypernode and hyperedge arrays to the given hypergraph
+  void copyElementArrays(StaticHypergraph& hypergraph, const bool parallel) const;
+
+  // ####################### Contract / Uncontract #######################
+
+  // ! Allocates an array of the contracted hypergraph in the level arena, if it is
+  // ! active and not exhausted. Otherwise, the array allocates its own memory.
+  template<typename T>
+  static void allocateLevelArray(Array<T>& array, const size_t size,
+                                 const typename Array<T>::value_type init_value = T()) {
+    char* data = parallel::LevelArena::instance().request(size * sizeof(T));
+    if ( data ) {
+      array.use_external_memory(reinterpret_cast<T*>(data), size);
+      array.assign(size, init_value);
+    } else {
+      array.resize(size, init_value);
+    }
   }
 
   // ####################### Remove / Restore Hyperedges #######################
@@ -871,31 +1023,30 @@ class StaticHypergraph {
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void removeIncidentEdgeFromHypernode(const HyperedgeID e,
                                                                           const HypernodeID u) {
     using std::swap;
-    ASSERT(!hypernode(u).isDisabled(), "Hypernode" << u << "is disabled");
+    ASSERT(nodeIsEnabled(u), "Hypernode" << u << "is disabled");
 
-    Hypernode& hn = hypernode(u);
-    size_t incident_nets_pos = hn.firstEntry();
-    for ( ; incident_nets_pos < hn.firstInvalidEntry(); ++incident_nets_pos ) {
+    const size_t incident_nets_end = firstInvalidIncidentNetEntry(u);
+    size_t incident_nets_pos = firstIncidentNetEntry(u);
+    for ( ; incident_nets_pos < incident_nets_end; ++incident_nets_pos ) {
       if ( _incident_nets[incident_nets_pos] == e ) {
         break;
       }
     }
-    ASSERT(incident_nets_pos < hn.firstInvalidEntry());
-    swap(_incident_nets[incident_nets_pos], _incident_nets[hn.firstInvalidEntry() - 1]);
-    hn.setSize(hn.size() - 1);
+    ASSERT(incident_nets_pos < incident_nets_end);
+    swap(_incident_nets[incident_nets_pos], _incident_nets[incident_nets_end - 1]);
+    --_hypernodes.degree[u];
   }
 
   // ! Inserts hyperedge he to incident nets array of vertex hn
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void insertIncidentEdgeToHypernode(const HyperedgeID e,
                                                                         const HypernodeID u) {
     using std::swap;
-    Hypernode& hn = hypernode(u);
-    ASSERT(!hn.isDisabled(), "Hypernode" << u << "is disabled");
-    HEAVY_REFINEMENT_ASSERT(std::count(_incident_nets.cbegin() + hn.firstEntry(),
-                                       _incident_nets.cbegin() + hn.firstInvalidEntry(), e) == 0,
+    ASSERT(nodeIsEnabled(u), "Hypernode" << u << "is disabled");
+    HEAVY_REFINEMENT_ASSERT(std::count(_incident_nets.cbegin() + firstIncidentNetEntry(u),
+                                       _incident_nets.cbegin() + firstInvalidIncidentNetEntry(u), e) == 0,
                         "HN" << u << "is already connected to HE" << e);
-    const size_t incident_nets_start = hn.firstInvalidEntry();
-    const size_t incident_nets_end = hypernode(u + 1).firstEntry();
+    const size_t incident_nets_start = firstInvalidIncidentNetEntry(u);
+    const size_t incident_nets_end = firstIncidentNetEntry(u + 1);
     size_t incident_nets_pos = incident_nets_start;
     for ( ; incident_nets_pos < incident_nets_end; ++incident_nets_pos ) {
       if ( _incident_nets[incident_nets_pos] == e ) {
@@ -904,17 +1055,35 @@ class StaticHypergraph {
     }
     ASSERT(incident_nets_pos < incident_nets_end);
     swap(_incident_nets[incident_nets_start], _incident_nets[incident_nets_pos]);
-    hn.setSize(hn.size() + 1);
+    ++_hypernodes.degree[u];
+  }
+
+  struct SharedTopology;
+
+  // ! Moves the incidence arrays into a reference-counted topology that
+  // ! can be shared with copies of this hypergraph (see copyOnWrite(...))
+  void shareTopology();
+
+  // ! If the incident nets are shared with another hypergraph, this hypergraph
+  // ! gets its own copy before the incident nets are modified
+  void detachIncidentNets() {
+    if ( _incident_nets_shared ) {
+      copyIncidentNetsOnWrite();
+    }
   }
 
+  void copyIncidentNetsOnWrite();
+
   // ! Allocate the temporary contraction buffer
-  void allocateTmpContractionBuffer() {
+  void allocateTmpContractionBuffer(const bool low_memory) {
     if ( !_tmp_contraction_buffer ) {
       _tmp_contraction_buffer = new TmpContractionBuffer(
-        _num_hypernodes, _num_hyperedges, _num_pins);
+        _num_hypernodes, _num_hyperedges, _num_pins, low_memory);
     }
   }
 
+  StaticHypergraph contract_low_memory(parallel::scalable_vector<HypernodeID>& communities);
+
   // ! Number of hypernodes
   HypernodeID _num_hypernodes;
   // ! Number of removed hypernodes
@@ -928,27 +1097,40 @@ class StaticHypergraph {
   // ! Maximum size of a hyperedge
   HypernodeID _max_edge_size;
   // ! Number of pins
-  HypernodeID _num_pins;
+  size_t _num_pins;
   // ! Total degree of all vertices
-  HypernodeID _total_degree;
+  size_t _total_degree;
   // ! Total weight of hypergraph
   HypernodeWeight _total_weight;
 
   // ! Hypernodes
-  Array<Hypernode> _hypernodes;
+  HypernodeArrays _hypernodes;
   // ! Pins of hyperedges
   IncidentNets _incident_nets;
   // ! Hyperedges
-  Array<Hyperedge> _hyperedges;
+  HyperedgeArrays _hyperedges;
   // ! Incident nets of hypernodes
   IncidenceArray _incidence_array;
 
   // ! Communities
   ds::Clustering _community_ids;
 
+  // ! Blocks to which vertices are fixed
+  FixedVertexSupport _fixed_vertices;
+
   // ! Data that is reused throughout the multilevel hierarchy
   // ! to contract the hypergraph and to prevent expensive allocations
   TmpContractionBuffer* _tmp_contraction_buffer;
+
+  // ! Keeps the memory alive to which the arrays above point if the
+  // ! hypergraph was loaded from a memory-mapped snapshot
+  std::shared_ptr<void> _external_memory;
+
+  // ! Keeps the incidence arrays alive that are shared with copies
+  // ! of this hypergraph (see copyOnWrite(...))
+  std::shared_ptr<void> _shared_topology;
+  // ! True, if the incident nets point into the shared topology
+  bool _incident_nets_shared;
 };
 
 } // namespace ds
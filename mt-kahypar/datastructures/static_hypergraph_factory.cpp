@@ -27,9 +27,14 @@
 
 #include "static_hypergraph_factory.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_invoke.h>
+#include <tbb/task_arena.h>
 
+#include "mt-kahypar/parallel/chunking.h"
 #include "mt-kahypar/parallel/parallel_prefix_sum.h"
 #include "mt-kahypar/utils/timer.h"
 
@@ -45,41 +50,78 @@ namespace mt_kahypar::ds {
     StaticHypergraph hypergraph;
     hypergraph._num_hypernodes = num_hypernodes;
     hypergraph._num_hyperedges = num_hyperedges;
-    hypergraph._hypernodes.resize(num_hypernodes + 1);
-    hypergraph._hyperedges.resize(num_hyperedges + 1);
+    tbb::parallel_invoke([&] {
+      hypergraph.allocateHypernodes(false);
+    }, [&] {
+      hypergraph.allocateHyperedges(false);
+    });
 
     ASSERT(edge_vector.size() == num_hyperedges);
 
+    // For a stable construction, we transpose the incidence structure: The hyperedges
+    // are split into consecutive ranges (one per task) and each task counts the pins
+    // of its range per vertex. The counters of all tasks are then turned into the
+    // write offsets of each task within the incident nets of a vertex. Since each
+    // task scatters its hyperedges in increasing order, the incident nets of each
+    // vertex are sorted without atomics and without sorting them afterwards.
+    const size_t num_tasks = stable_construction_of_incident_edges ? std::max(UL(1),
+      std::min(static_cast<size_t>(tbb::this_task_arena::max_concurrency()), UI64(num_hyperedges))) : 0;
+    const size_t chunk_size = num_tasks > 0 ? parallel::chunking::idiv_ceil(UI64(num_hyperedges), num_tasks) : 0;
+    parallel::scalable_vector<Counter> task_incident_nets_per_vertex(num_tasks);
+
     // Compute number of pins per hyperedge and number
     // of incident nets per vertex
     Counter num_pins_per_hyperedge(num_hyperedges, 0);
-    ThreadLocalCounter local_incident_nets_per_vertex(num_hypernodes, 0);
+    Counter num_incident_nets_per_vertex(num_hypernodes, 0);
     tbb::enumerable_thread_specific<size_t> local_max_edge_size(UL(0));
-    tbb::parallel_for(ID(0), num_hyperedges, [&](const size_t pos) {
-      Counter& num_incident_nets_per_vertex = local_incident_nets_per_vertex.local();
+    auto count_pins_of_hyperedge = [&](const size_t pos, Counter& num_incident_nets) {
       num_pins_per_hyperedge[pos] = edge_vector[pos].size();
       local_max_edge_size.local() = std::max(
               local_max_edge_size.local(), edge_vector[pos].size());
       for ( const HypernodeID& pin : edge_vector[pos] ) {
         ASSERT(pin < num_hypernodes, V(pin) << V(num_hypernodes));
-        ++num_incident_nets_per_vertex[pin];
+        ++num_incident_nets[pin];
       }
-    });
+    };
+    if ( stable_construction_of_incident_edges ) {
+      tbb::parallel_for(UL(0), num_tasks, [&](const size_t task) {
+        Counter& num_incident_nets = task_incident_nets_per_vertex[task];
+        num_incident_nets.assign(num_hypernodes, 0);
+        for ( auto [pos, last] = parallel::chunking::bounds(task, num_hyperedges, chunk_size); pos < last; ++pos ) {
+          count_pins_of_hyperedge(pos, num_incident_nets);
+        }
+      });
+
+      // Each task writes its incident nets of a vertex behind the ones of all previous tasks
+      tbb::parallel_for(ID(0), num_hypernodes, [&](const HypernodeID hn) {
+        size_t num_incident_nets = 0;
+        for ( size_t task = 0; task < num_tasks; ++task ) {
+          const size_t num_incident_nets_of_task = task_incident_nets_per_vertex[task][hn];
+          task_incident_nets_per_vertex[task][hn] = num_incident_nets;
+          num_incident_nets += num_incident_nets_of_task;
+        }
+        num_incident_nets_per_vertex[hn] = num_incident_nets;
+      });
+    } else {
+      ThreadLocalCounter local_incident_nets_per_vertex(num_hypernodes, 0);
+      tbb::parallel_for(ID(0), num_hyperedges, [&](const size_t pos) {
+        count_pins_of_hyperedge(pos, local_incident_nets_per_vertex.local());
+      });
+
+      // We sum up the number of incident nets per vertex only thread local.
+      // To obtain the global number of incident nets per vertex, we iterate
+      // over each thread local counter and sum it up.
+      for ( Counter& c : local_incident_nets_per_vertex ) {
+        tbb::parallel_for(ID(0), num_hypernodes, [&](const size_t pos) {
+          num_incident_nets_per_vertex[pos] += c[pos];
+        });
+      }
+    }
     hypergraph._max_edge_size = local_max_edge_size.combine(
             [&](const size_t lhs, const size_t rhs) {
               return std::max(lhs, rhs);
             });
 
-    // We sum up the number of incident nets per vertex only thread local.
-    // To obtain the global number of incident nets per vertex, we iterate
-    // over each thread local counter and sum it up.
-    Counter num_incident_nets_per_vertex(num_hypernodes, 0);
-    for ( Counter& c : local_incident_nets_per_vertex ) {
-      tbb::parallel_for(ID(0), num_hypernodes, [&](const size_t pos) {
-        num_incident_nets_per_vertex[pos] += c[pos];
-      });
-    }
-
     // Compute prefix sum over the number of pins per hyperedge and the
     // number of incident nets per vertex. The prefix sum is used than as
     // start position for each hyperedge resp. hypernode in the incidence
@@ -100,26 +142,147 @@ namespace mt_kahypar::ds {
     hypergraph._incident_nets.resize(hypergraph._num_pins);
     hypergraph._incidence_array.resize(hypergraph._num_pins);
 
+    AtomicCounter incident_nets_position(stable_construction_of_incident_edges ? 0 : num_hypernodes,
+                                         parallel::IntegralAtomicWrapper<size_t>(0));
+
+    auto setup_hyperedge = [&](const size_t pos, const auto& next_incident_nets_position) {
+      hypergraph._hyperedges.first_entry[pos] = pin_prefix_sum[pos];
+      if ( hyperedge_weight ) {
+        hypergraph._hyperedges.weight[pos] = hyperedge_weight[pos];
+      }
+
+      const HyperedgeID he = pos;
+      size_t incidence_array_pos = pin_prefix_sum[pos];
+      for ( const HypernodeID& pin : edge_vector[pos] ) {
+        ASSERT(incidence_array_pos < pin_prefix_sum[pos + 1]);
+        ASSERT(pin < num_hypernodes);
+        // Add pin to incidence array
+        hypergraph._incidence_array[incidence_array_pos++] = pin;
+        // Add hyperedge he as a incident net to pin
+        const size_t incident_nets_pos = incident_net_prefix_sum[pin] + next_incident_nets_position(pin);
+        ASSERT(incident_nets_pos < incident_net_prefix_sum[pin + 1]);
+        hypergraph._incident_nets[incident_nets_pos] = he;
+      }
+    };
+
+    auto setup_hyperedges = [&] {
+      if ( stable_construction_of_incident_edges ) {
+        tbb::parallel_for(UL(0), num_tasks, [&](const size_t task) {
+          Counter& incident_nets_offset = task_incident_nets_per_vertex[task];
+          for ( auto [pos, last] = parallel::chunking::bounds(task, num_hyperedges, chunk_size); pos < last; ++pos ) {
+            setup_hyperedge(pos, [&](const HypernodeID pin) {
+              return incident_nets_offset[pin]++;
+            });
+          }
+        });
+      } else {
+        tbb::parallel_for(ID(0), num_hyperedges, [&](const size_t pos) {
+          setup_hyperedge(pos, [&](const HypernodeID pin) {
+            return incident_nets_position[pin]++;
+          });
+        });
+      }
+    };
+
+    auto setup_hypernodes = [&] {
+      tbb::parallel_for(ID(0), num_hypernodes, [&](const size_t pos) {
+        hypergraph._hypernodes.first_entry[pos] = incident_net_prefix_sum[pos];
+        hypergraph._hypernodes.degree[pos] = incident_net_prefix_sum.value(pos);
+        if ( hypernode_weight ) {
+          hypergraph._hypernodes.weight[pos] = hypernode_weight[pos];
+        }
+      });
+    };
+
+    auto init_communities = [&] {
+      hypergraph._community_ids.resize(num_hypernodes, 0);
+    };
+
+    tbb::parallel_invoke(setup_hyperedges, setup_hypernodes, init_communities);
+    ASSERT(!stable_construction_of_incident_edges || [&] {
+      for ( HypernodeID hn = 0; hn < num_hypernodes; ++hn ) {
+        if ( !std::is_sorted(hypergraph._incident_nets.begin() + hypergraph.firstIncidentNetEntry(hn),
+                             hypergraph._incident_nets.begin() + hypergraph.firstInvalidIncidentNetEntry(hn)) ) {
+          return false;
+        }
+      }
+      return true;
+    }(), "Incident nets are not sorted");
+
+    // Add Sentinels
+    hypergraph._hypernodes.first_entry[num_hypernodes] = hypergraph._incident_nets.size();
+    hypergraph._hyperedges.first_entry[num_hyperedges] = hypergraph._incidence_array.size();
+
+    hypergraph.computeAndSetTotalNodeWeight(parallel_tag_t());
+    return hypergraph;
+  }
+
+
+  StaticHypergraph StaticHypergraphFactory::construct_from_incidence_array(
+          const HypernodeID num_hypernodes,
+          const HyperedgeID num_hyperedges,
+          const parallel::scalable_vector<size_t>& pin_offsets,
+          Array<HypernodeID>&& incidence_array,
+          const HyperedgeWeight* hyperedge_weight,
+          const HypernodeWeight* hypernode_weight,
+          const bool stable_construction_of_incident_edges) {
+    ASSERT(pin_offsets.size() == num_hyperedges + 1);
+    ASSERT(pin_offsets.back() == incidence_array.size());
+    StaticHypergraph hypergraph;
+    hypergraph._num_hypernodes = num_hypernodes;
+    hypergraph._num_hyperedges = num_hyperedges;
+    hypergraph._num_pins = incidence_array.size();
+    hypergraph._total_degree = incidence_array.size();
+    hypergraph._incidence_array = std::move(incidence_array);
+
+    // Compute number of incident nets per vertex. In contrast to construct(...),
+    // we use atomic counters instead of thread-local counters to keep the
+    // memory overhead independent of the number of threads.
     AtomicCounter incident_nets_position(num_hypernodes,
                                          parallel::IntegralAtomicWrapper<size_t>(0));
+    tbb::enumerable_thread_specific<size_t> local_max_edge_size(UL(0));
+    tbb::parallel_invoke([&] {
+      tbb::parallel_for(ID(0), num_hyperedges, [&](const HyperedgeID he) {
+        local_max_edge_size.local() = std::max(
+          local_max_edge_size.local(), pin_offsets[he + 1] - pin_offsets[he]);
+        for ( size_t pos = pin_offsets[he]; pos < pin_offsets[he + 1]; ++pos ) {
+          ASSERT(hypergraph._incidence_array[pos] < num_hypernodes);
+          incident_nets_position[hypergraph._incidence_array[pos]].fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+    }, [&] {
+      hypergraph.allocateHypernodes(false);
+    }, [&] {
+      hypergraph.allocateHyperedges(false);
+    }, [&] {
+      hypergraph._incident_nets.resize(hypergraph._num_pins);
+    });
+    hypergraph._max_edge_size = local_max_edge_size.combine(
+            [&](const size_t lhs, const size_t rhs) {
+              return std::max(lhs, rhs);
+            });
+
+    // Prefix sum over the number of incident nets per vertex determines
+    // the start position of each hypernode in the incident nets array
+    Counter num_incident_nets_per_vertex(num_hypernodes, 0);
+    tbb::parallel_for(ID(0), num_hypernodes, [&](const HypernodeID hn) {
+      num_incident_nets_per_vertex[hn] = incident_nets_position[hn].load(std::memory_order_relaxed);
+      incident_nets_position[hn].store(0, std::memory_order_relaxed);
+    });
+    parallel::TBBPrefixSum<size_t> incident_net_prefix_sum(num_incident_nets_per_vertex);
+    tbb::parallel_scan(tbb::blocked_range<size_t>(
+            UL(0), UI64(num_hypernodes)), incident_net_prefix_sum);
+    ASSERT(incident_net_prefix_sum.total_sum() == hypergraph._num_pins);
 
     auto setup_hyperedges = [&] {
-      tbb::parallel_for(ID(0), num_hyperedges, [&](const size_t pos) {
-        StaticHypergraph::Hyperedge& hyperedge = hypergraph._hyperedges[pos];
-        hyperedge.enable();
-        hyperedge.setFirstEntry(pin_prefix_sum[pos]);
-        hyperedge.setSize(pin_prefix_sum.value(pos));
+      tbb::parallel_for(ID(0), num_hyperedges, [&](const HyperedgeID he) {
+        hypergraph._hyperedges.first_entry[he] = pin_offsets[he];
         if ( hyperedge_weight ) {
-          hyperedge.setWeight(hyperedge_weight[pos]);
+          hypergraph._hyperedges.weight[he] = hyperedge_weight[he];
         }
 
-        const HyperedgeID he = pos;
-        size_t incidence_array_pos = hyperedge.firstEntry();
-        for ( const HypernodeID& pin : edge_vector[pos] ) {
-          ASSERT(incidence_array_pos < hyperedge.firstInvalidEntry());
-          ASSERT(pin < num_hypernodes);
-          // Add pin to incidence array
-          hypergraph._incidence_array[incidence_array_pos++] = pin;
+        for ( size_t pos = pin_offsets[he]; pos < pin_offsets[he + 1]; ++pos ) {
+          const HypernodeID pin = hypergraph._incidence_array[pos];
           // Add hyperedge he as a incident net to pin
           const size_t incident_nets_pos = incident_net_prefix_sum[pin] + incident_nets_position[pin]++;
           ASSERT(incident_nets_pos < incident_net_prefix_sum[pin + 1]);
@@ -129,13 +292,11 @@ namespace mt_kahypar::ds {
     };
 
     auto setup_hypernodes = [&] {
-      tbb::parallel_for(ID(0), num_hypernodes, [&](const size_t pos) {
-        StaticHypergraph::Hypernode& hypernode = hypergraph._hypernodes[pos];
-        hypernode.enable();
-        hypernode.setFirstEntry(incident_net_prefix_sum[pos]);
-        hypernode.setSize(incident_net_prefix_sum.value(pos));
+      tbb::parallel_for(ID(0), num_hypernodes, [&](const HypernodeID hn) {
+        hypergraph._hypernodes.first_entry[hn] = incident_net_prefix_sum[hn];
+        hypergraph._hypernodes.degree[hn] = incident_net_prefix_sum.value(hn);
         if ( hypernode_weight ) {
-          hypernode.setWeight(hypernode_weight[pos]);
+          hypergraph._hypernodes.weight[hn] = hypernode_weight[hn];
         }
       });
     };
@@ -147,20 +308,182 @@ namespace mt_kahypar::ds {
     tbb::parallel_invoke(setup_hyperedges, setup_hypernodes, init_communities);
 
     if (stable_construction_of_incident_edges) {
-      // sort incident hyperedges of each node, so their ordering is independent of scheduling (and the same as a typical sequential implementation)
+      // sort incident hyperedges of each node, so their ordering is independent of scheduling
       tbb::parallel_for(ID(0), num_hypernodes, [&](HypernodeID u) {
-        auto b = hypergraph._incident_nets.begin() + hypergraph.hypernode(u).firstEntry();
-        auto e = hypergraph._incident_nets.begin() + hypergraph.hypernode(u).firstInvalidEntry();
+        auto b = hypergraph._incident_nets.begin() + hypergraph.firstIncidentNetEntry(u);
+        auto e = hypergraph._incident_nets.begin() + hypergraph.firstInvalidIncidentNetEntry(u);
         std::sort(b, e);
       });
     }
 
     // Add Sentinels
-    hypergraph._hypernodes.back() = StaticHypergraph::Hypernode(hypergraph._incident_nets.size());
-    hypergraph._hyperedges.back() = StaticHypergraph::Hyperedge(hypergraph._incidence_array.size());
+    hypergraph._hypernodes.first_entry[num_hypernodes] = hypergraph._incident_nets.size();
+    hypergraph._hyperedges.first_entry[num_hyperedges] = hypergraph._incidence_array.size();
 
     hypergraph.computeAndSetTotalNodeWeight(parallel_tag_t());
     return hypergraph;
   }
 
+  namespace {
+    size_t align_snapshot_offset(const size_t offset) {
+      const size_t alignment = StaticHypergraphSnapshotHeader::ALIGNMENT;
+      return ( ( offset + alignment - 1 ) / alignment ) * alignment;
+    }
+
+    template<typename T>
+    void write_snapshot_array(std::ostream& out, size_t& pos, const size_t offset,
+                              const T* data, const size_t size) {
+      ASSERT(pos <= offset);
+      const char zeros[StaticHypergraphSnapshotHeader::ALIGNMENT] = { };
+      out.write(zeros, offset - pos);
+      out.write(reinterpret_cast<const char*>(data), sizeof(T) * size);
+      pos = offset + sizeof(T) * size;
+    }
+  }
+
+  StaticHypergraphSnapshotHeader StaticHypergraphFactory::snapshot_header(const StaticHypergraph& hypergraph) {
+    StaticHypergraphSnapshotHeader header;
+    std::memset(&header, 0, sizeof(StaticHypergraphSnapshotHeader));
+    header.magic = StaticHypergraphSnapshotHeader::MAGIC;
+    header.version = StaticHypergraphSnapshotHeader::VERSION;
+    header.hypernode_id_size = sizeof(HypernodeID);
+    header.hyperedge_id_size = sizeof(HyperedgeID);
+    header.hypernode_weight_size = sizeof(HypernodeWeight);
+    header.hyperedge_weight_size = sizeof(HyperedgeWeight);
+    header.num_hypernodes = hypergraph._num_hypernodes;
+    header.num_removed_hypernodes = hypergraph._num_removed_hypernodes;
+    header.removed_degree_zero_hn_weight = hypergraph._removed_degree_zero_hn_weight;
+    header.num_hyperedges = hypergraph._num_hyperedges;
+    header.num_removed_hyperedges = hypergraph._num_removed_hyperedges;
+    header.max_edge_size = hypergraph._max_edge_size;
+    header.num_pins = hypergraph._num_pins;
+    header.total_degree = hypergraph._total_degree;
+    header.total_weight = hypergraph._total_weight;
+
+    // The offset arrays contain an additional sentinel element
+    const size_t num_hypernodes = hypergraph._num_hypernodes;
+    const size_t num_hyperedges = hypergraph._num_hyperedges;
+    const size_t num_pins = hypergraph._incidence_array.size();
+    const size_t num_incident_nets = hypergraph._incident_nets.size();
+    ASSERT(hypergraph._hypernodes.first_entry.size() == num_hypernodes + 1);
+    ASSERT(hypergraph._hyperedges.first_entry.size() == num_hyperedges + 1);
+    ASSERT(num_pins == hypergraph._num_pins);
+    ASSERT(num_incident_nets == hypergraph._total_degree);
+    header.hn_first_entry_offset = align_snapshot_offset(sizeof(StaticHypergraphSnapshotHeader));
+    header.hn_degree_offset = align_snapshot_offset(header.hn_first_entry_offset +
+      sizeof(size_t) * ( num_hypernodes + 1 ));
+    header.hn_weight_offset = align_snapshot_offset(header.hn_degree_offset +
+      sizeof(HyperedgeID) * num_hypernodes);
+    header.hn_enabled_offset = align_snapshot_offset(header.hn_weight_offset +
+      sizeof(HypernodeWeight) * num_hypernodes);
+    header.he_first_entry_offset = align_snapshot_offset(header.hn_enabled_offset +
+      hypergraph._hypernodes.enabled.size_in_bytes());
+    header.he_weight_offset = align_snapshot_offset(header.he_first_entry_offset +
+      sizeof(size_t) * ( num_hyperedges + 1 ));
+    header.he_enabled_offset = align_snapshot_offset(header.he_weight_offset +
+      sizeof(HyperedgeWeight) * num_hyperedges);
+    header.incidence_array_offset = align_snapshot_offset(header.he_enabled_offset +
+      hypergraph._hyperedges.enabled.size_in_bytes());
+    header.incident_nets_offset = align_snapshot_offset(header.incidence_array_offset +
+      sizeof(HypernodeID) * num_pins);
+    header.total_size = header.incident_nets_offset + sizeof(HyperedgeID) * num_incident_nets;
+    return header;
+  }
+
+  size_t StaticHypergraphFactory::snapshot_size(const StaticHypergraph& hypergraph) {
+    return snapshot_header(hypergraph).total_size;
+  }
+
+  void StaticHypergraphFactory::write_snapshot(const StaticHypergraph& hypergraph, std::ostream& out) {
+    const StaticHypergraphSnapshotHeader header = snapshot_header(hypergraph);
+    const size_t num_hypernodes = hypergraph._num_hypernodes;
+    const size_t num_hyperedges = hypergraph._num_hyperedges;
+    const size_t num_pins = hypergraph._incidence_array.size();
+    const size_t num_incident_nets = hypergraph._incident_nets.size();
+    const StaticHypergraph::HypernodeArrays& hypernodes = hypergraph._hypernodes;
+    const StaticHypergraph::HyperedgeArrays& hyperedges = hypergraph._hyperedges;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(StaticHypergraphSnapshotHeader));
+    size_t pos = sizeof(StaticHypergraphSnapshotHeader);
+    write_snapshot_array(out, pos, header.hn_first_entry_offset,
+      hypernodes.first_entry.data(), num_hypernodes + 1);
+    write_snapshot_array(out, pos, header.hn_degree_offset, hypernodes.degree.data(), num_hypernodes);
+    write_snapshot_array(out, pos, header.hn_weight_offset, hypernodes.weight.data(), num_hypernodes);
+    write_snapshot_array(out, pos, header.hn_enabled_offset, hypernodes.enabled.data(),
+      AtomicBitVector::numBlocks(num_hypernodes));
+    write_snapshot_array(out, pos, header.he_first_entry_offset,
+      hyperedges.first_entry.data(), num_hyperedges + 1);
+    write_snapshot_array(out, pos, header.he_weight_offset, hyperedges.weight.data(), num_hyperedges);
+    write_snapshot_array(out, pos, header.he_enabled_offset, hyperedges.enabled.data(),
+      AtomicBitVector::numBlocks(num_hyperedges));
+    if ( num_pins > 0 ) {
+      write_snapshot_array(out, pos, header.incidence_array_offset,
+        hypergraph._incidence_array.data(), num_pins);
+    }
+    if ( num_incident_nets > 0 ) {
+      write_snapshot_array(out, pos, header.incident_nets_offset,
+        hypergraph._incident_nets.data(), num_incident_nets);
+    }
+  }
+
+  StaticHypergraph StaticHypergraphFactory::construct_from_snapshot(char* data,
+                                                                    const size_t length,
+                                                                    std::shared_ptr<void> memory_owner) {
+    if ( length < sizeof(StaticHypergraphSnapshotHeader) ) {
+      ERR("Snapshot is too small to contain a valid header");
+    }
+    StaticHypergraphSnapshotHeader header;
+    std::memcpy(&header, data, sizeof(StaticHypergraphSnapshotHeader));
+    if ( header.magic != StaticHypergraphSnapshotHeader::MAGIC ) {
+      ERR("File is not a hypergraph snapshot");
+    }
+    if ( header.version != StaticHypergraphSnapshotHeader::VERSION ) {
+      ERR("Unsupported snapshot version" << header.version
+        << "(expected version" << StaticHypergraphSnapshotHeader::VERSION << ")");
+    }
+    if ( header.hypernode_id_size != sizeof(HypernodeID) ||
+         header.hyperedge_id_size != sizeof(HyperedgeID) ||
+         header.hypernode_weight_size != sizeof(HypernodeWeight) ||
+         header.hyperedge_weight_size != sizeof(HyperedgeWeight) ) {
+      ERR("Snapshot was created by a build with a different memory layout");
+    }
+    if ( header.total_size > length ) {
+      ERR("Snapshot is truncated" << V(header.total_size) << V(length));
+    }
+
+    StaticHypergraph hypergraph;
+    hypergraph._num_hypernodes = header.num_hypernodes;
+    hypergraph._num_removed_hypernodes = header.num_removed_hypernodes;
+    hypergraph._removed_degree_zero_hn_weight = header.removed_degree_zero_hn_weight;
+    hypergraph._num_hyperedges = header.num_hyperedges;
+    hypergraph._num_removed_hyperedges = header.num_removed_hyperedges;
+    hypergraph._max_edge_size = header.max_edge_size;
+    hypergraph._num_pins = header.num_pins;
+    hypergraph._total_degree = header.total_degree;
+    hypergraph._total_weight = header.total_weight;
+
+    StaticHypergraph::HypernodeArrays& hypernodes = hypergraph._hypernodes;
+    StaticHypergraph::HyperedgeArrays& hyperedges = hypergraph._hyperedges;
+    hypernodes.first_entry.use_external_memory(reinterpret_cast<size_t*>(
+      data + header.hn_first_entry_offset), header.num_hypernodes + 1);
+    hypernodes.degree.use_external_memory(reinterpret_cast<HyperedgeID*>(
+      data + header.hn_degree_offset), header.num_hypernodes);
+    hypernodes.weight.use_external_memory(reinterpret_cast<HypernodeWeight*>(
+      data + header.hn_weight_offset), header.num_hypernodes);
+    hypernodes.enabled.use_external_memory(reinterpret_cast<AtomicBitVector::Block*>(
+      data + header.hn_enabled_offset), header.num_hypernodes);
+    hyperedges.first_entry.use_external_memory(reinterpret_cast<size_t*>(
+      data + header.he_first_entry_offset), header.num_hyperedges + 1);
+    hyperedges.weight.use_external_memory(reinterpret_cast<HyperedgeWeight*>(
+      data + header.he_weight_offset), header.num_hyperedges);
+    hyperedges.enabled.use_external_memory(reinterpret_cast<AtomicBitVector::Block*>(
+      data + header.he_enabled_offset), header.num_hyperedges);
+    hypergraph._incidence_array.use_external_memory(reinterpret_cast<HypernodeID*>(
+      data + header.incidence_array_offset), header.num_pins);
+    hypergraph._incident_nets.use_external_memory(reinterpret_cast<HyperedgeID*>(
+      data + header.incident_nets_offset), header.total_degree);
+    hypergraph._community_ids.resize(header.num_hypernodes, 0);
+    hypergraph._external_memory = std::move(memory_owner);
+    return hypergraph;
+  }
+
 }
\ No newline at end of file
@@ -27,6 +27,9 @@
 
 #pragma once
 
+#include <memory>
+#include <ostream>
+
 #include "tbb/enumerable_thread_specific.h"
 
 #include "mt-kahypar/datastructures/static_hypergraph.h"
@@ -35,6 +38,49 @@
 
 namespace mt_kahypar::ds {
 
+/**
+ * Header of a binary snapshot of a static hypergraph. The header is followed by the
+ * internal arrays of the hypergraph (hypernode and hyperedge arrays, incidence array
+ * and incident nets) in the in-memory representation of this build. Each array starts
+ * at a cache-line aligned byte offset such that a memory-mapped snapshot can be used
+ * in place without parsing. Since the memory layout depends on the platform and on
+ * the size of the ID types, a snapshot can only be loaded by a build with the same
+ * layout (which is verified via the stored sizes).
+ */
+struct StaticHypergraphSnapshotHeader {
+  static constexpr uint64_t MAGIC = 0x50414e5352474854; // "THGRSNAP"
+  static constexpr uint32_t VERSION = 2;
+  static constexpr uint64_t ALIGNMENT = 64;
+
+  uint64_t magic;
+  uint32_t version;
+  uint32_t hypernode_id_size;
+  uint32_t hyperedge_id_size;
+  uint32_t hypernode_weight_size;
+  uint32_t hyperedge_weight_size;
+  uint32_t padding;
+  uint64_t num_hypernodes;
+  uint64_t num_removed_hypernodes;
+  int64_t removed_degree_zero_hn_weight;
+  uint64_t num_hyperedges;
+  uint64_t num_removed_hyperedges;
+  uint64_t max_edge_size;
+  uint64_t num_pins;
+  uint64_t total_degree;
+  int64_t total_weight;
+  // Byte offsets of the arrays relative to the beginning of the snapshot
+  uint64_t hn_first_entry_offset;
+  uint64_t hn_degree_offset;
+  uint64_t hn_weight_offset;
+  uint64_t hn_enabled_offset;
+  uint64_t he_first_entry_offset;
+  uint64_t he_weight_offset;
+  uint64_t he_enabled_offset;
+  uint64_t incidence_array_offset;
+  uint64_t incident_nets_offset;
+  uint64_t total_size;
+};
+
 class StaticHypergraphFactory {
 
   using HyperedgeVector = parallel::scalable_vector<parallel::scalable_vector<HypernodeID>>;
@@ -50,12 +96,41 @@ class StaticHypergraphFactory {
                                     const HypernodeWeight* hypernode_weight = nullptr,
                                     const bool stable_construction_of_incident_edges = false);
 
+  // ! Constructs a hypergraph from an incidence array that already contains the pins
+  // ! of all hyperedges, where the pins of hyperedge e are stored in the range
+  // ! [pin_offsets[e], pin_offsets[e + 1]). In contrast to construct(...), no
+  // ! intermediate edge vector is required.
+  static StaticHypergraph construct_from_incidence_array(const HypernodeID num_hypernodes,
+                                                         const HyperedgeID num_hyperedges,
+                                                         const parallel::scalable_vector<size_t>& pin_offsets,
+                                                         Array<HypernodeID>&& incidence_array,
+                                                         const HyperedgeWeight* hyperedge_weight = nullptr,
+                                                         const HypernodeWeight* hypernode_weight = nullptr,
+                                                         const bool stable_construction_of_incident_edges = false);
+
+  // ! Writes a binary snapshot of the hypergraph to the output stream
+  // ! (see StaticHypergraphSnapshotHeader)
+  static void write_snapshot(const StaticHypergraph& hypergraph, std::ostream& out);
+
+  // ! Size in bytes of the binary snapshot written by write_snapshot(...)
+  static size_t snapshot_size(const StaticHypergraph& hypergraph);
+
+  // ! Constructs a hypergraph from a binary snapshot located at data. The arrays of
+  // ! the hypergraph point directly into the snapshot, which must therefore be writable
+  // ! (e.g., a private memory mapping). The hypergraph shares ownership of the snapshot
+  // ! memory via memory_owner.
+  static StaticHypergraph construct_from_snapshot(char* data,
+                                                  const size_t length,
+                                                  std::shared_ptr<void> memory_owner);
+
   static std::pair<StaticHypergraph, vec<HypernodeID>> compactify(const StaticHypergraph&) {
     ERR("Compactify not implemented for static hypergraph.");
   }
 
  private:
   StaticHypergraphFactory() { }
+
+  static StaticHypergraphSnapshotHeader snapshot_header(const StaticHypergraph& hypergraph);
 };
 
 } // namespace mt_kahypar
\ No newline at end of file
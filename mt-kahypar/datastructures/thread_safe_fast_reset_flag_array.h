@@ -47,14 +47,16 @@ public:
   explicit ThreadSafeFastResetFlagArray(const size_t size) :
     _v(std::make_unique<Type[]>(size)),
     _threshold(1),
-    _size(size) {
+    _size(size),
+    _capacity(size) {
     initialize();
   }
 
   ThreadSafeFastResetFlagArray() :
     _v(nullptr),
     _threshold(1),
-    _size(0) { }
+    _size(0),
+    _capacity(0) { }
 
   ThreadSafeFastResetFlagArray(const ThreadSafeFastResetFlagArray&) = delete;
   ThreadSafeFastResetFlagArray& operator= (const ThreadSafeFastResetFlagArray&) = delete;
@@ -68,6 +70,8 @@ public:
     using std::swap;
     swap(_v, other._v);
     swap(_threshold, other._threshold);
+    swap(_size, other._size);
+    swap(_capacity, other._capacity);
   }
 
   bool operator[] (const size_t i) const {
@@ -111,16 +115,28 @@ public:
     ASSERT(_v == nullptr, "Error");
     _v = std::make_unique<Type[]>(size);
     _size = size;
+    _capacity = size;
     initialize(init);
   }
 
+  // ! Memory is only reallocated if the new size exceeds the capacity of the
+  // ! array. If the array grows within its capacity, all flags are reset
+  // ! (as it would be the case for a newly allocated array).
   void resize(const size_t size, const bool init = false) {
-    if ( size > _size ) {
+    if ( size > _capacity ) {
       std::unique_ptr<Type[]> tmp_v =
         std::make_unique<Type[]>(size);
       std::swap(_v, tmp_v);
       _size = size;
+      _capacity = size;
       initialize(init);
+    } else if ( size > _size ) {
+      _size = size;
+      if ( init ) {
+        initialize(init);
+      } else {
+        reset();
+      }
     } else {
       _size = size;
     }
@@ -136,11 +152,17 @@ public:
     for ( size_t i = 0; i < _size; ++i ) {
       __atomic_store_n(&_v[i], init_value, __ATOMIC_RELAXED);
     }
+    // Entries beyond the current size must not hold a valid threshold
+    // once the array grows again within its capacity
+    for ( size_t i = _size; i < _capacity; ++i ) {
+      __atomic_store_n(&_v[i], 0, __ATOMIC_RELAXED);
+    }
   }
 
   std::unique_ptr<Type[]> _v;
   Type _threshold;
   size_t _size;
+  size_t _capacity;
 };
 
 template <typename Type>
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/stl/thread_locals.h"
+
+namespace mt_kahypar {
+namespace ds {
+
+/*!
+ * Maintains the connectivity (km1) and cut metric of a partition incrementally.
+ * The deltas of concurrent moves are accumulated in thread-local shards such that
+ * moves do not contend on a shared counter. Querying the objective sums up the
+ * shards, which takes time linear in the number of threads.
+ */
+class TrackedObjective {
+
+  struct Shard {
+    HyperedgeWeight km1 = 0;
+    HyperedgeWeight cut = 0;
+  };
+
+ public:
+  TrackedObjective() :
+    _km1(0),
+    _cut(0),
+    _shards() { }
+
+  TrackedObjective(const TrackedObjective&) = delete;
+  TrackedObjective(TrackedObjective&&) = delete;
+  TrackedObjective & operator= (const TrackedObjective &) = delete;
+  TrackedObjective & operator= (TrackedObjective &&) = delete;
+
+  // ! Delta of the km1 metric for a hyperedge with the given pin counts after a move
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static HyperedgeWeight km1Delta(const HyperedgeWeight edge_weight,
+                                                                     const HypernodeID pin_count_in_from_part_after,
+                                                                     const HypernodeID pin_count_in_to_part_after) {
+    return ( pin_count_in_to_part_after == 1 ? edge_weight : 0 ) -
+           ( pin_count_in_from_part_after == 0 ? edge_weight : 0 );
+  }
+
+  // ! Delta of the cut metric for a hyperedge with the given pin counts after a move
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static HyperedgeWeight cutDelta(const HyperedgeWeight edge_weight,
+                                                                     const HypernodeID edge_size,
+                                                                     const HypernodeID pin_count_in_from_part_after,
+                                                                     const HypernodeID pin_count_in_to_part_after) {
+    return ( pin_count_in_from_part_after == edge_size - 1 && pin_count_in_to_part_after == 1 ? edge_weight : 0 ) -
+           ( pin_count_in_to_part_after == edge_size ? edge_weight : 0 );
+  }
+
+  // ! Sets the objective and discards all accumulated deltas (not thread-safe)
+  void reset(const HyperedgeWeight km1, const HyperedgeWeight cut) {
+    _km1 = km1;
+    _cut = cut;
+    for ( Shard& shard : _shards ) {
+      shard = Shard { };
+    }
+  }
+
+  void add(const HyperedgeWeight km1_delta, const HyperedgeWeight cut_delta) {
+    Shard& shard = _shards.local();
+    shard.km1 += km1_delta;
+    shard.cut += cut_delta;
+  }
+
+  // ! Note, the result is only exact if no move is performed concurrently
+  HyperedgeWeight km1() const {
+    HyperedgeWeight km1 = _km1;
+    for ( const Shard& shard : _shards ) {
+      km1 += shard.km1;
+    }
+    return km1;
+  }
+
+  // ! Note, the result is only exact if no move is performed concurrently
+  HyperedgeWeight cut() const {
+    HyperedgeWeight cut = _cut;
+    for ( const Shard& shard : _shards ) {
+      cut += shard.cut;
+    }
+    return cut;
+  }
+
+ private:
+  HyperedgeWeight _km1;
+  HyperedgeWeight _cut;
+  tls_enumerable_thread_specific<Shard> _shards;
+};
+
+}  // namespace ds
+}  // namespace mt_kahypar
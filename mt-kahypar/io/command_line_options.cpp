@@ -77,6 +77,10 @@ namespace mt_kahypar {
             ("write-partition-file",
              po::value<bool>(&context.partition.write_partition_file)->value_name("<bool>")->default_value(false),
              "If true, then partition output file is generated")
+            ("binary-partition-file",
+             po::value<bool>(&context.partition.binary_partition_file)->value_name("<bool>")->default_value(false),
+             "If true, then the partition output file is written in binary format\n"
+             "(header followed by an int32 array of the block IDs)")
             ("partition-output-folder",
              po::value<std::string>(&context.partition.graph_partition_output_folder)->value_name("<string>"),
              "Output folder for partition file")
@@ -86,11 +90,18 @@ namespace mt_kahypar {
                  context.partition.file_format = FileFormat::hMetis;
                } else if (s == "metis") {
                  context.partition.file_format = FileFormat::Metis;
+               } else if (s == "snapshot") {
+                 context.partition.file_format = FileFormat::Snapshot;
+               } else if (s == "shared_snapshot") {
+                 context.partition.file_format = FileFormat::SharedSnapshot;
                }
              }),
              "Input file format: \n"
              " - hmetis : hMETIS hypergraph file format \n"
-             " - metis : METIS graph file format")
+             " - metis : METIS graph file format \n"
+             " - snapshot : binary hypergraph snapshot (see HgrToSnapshot) \n"
+             " - shared_snapshot : hypergraph snapshot in a POSIX shared memory segment, the\n"
+             "   hypergraph filename is the name of the segment (see HgrToSnapshot)")
             ("instance-type",
              po::value<std::string>()->value_name("<string>")->notifier([&](const std::string& type) {
                context.partition.instance_type = instanceTypeFromString(type);
@@ -107,16 +118,49 @@ namespace mt_kahypar {
              " - default (Mt-KaHyPar-D)\n"
              " - default_flows (Mt-KaHyPar-D-F)\n"
              " - quality (Mt-KaHyPar-Q)\n"
-             " - quality_flows (Mt-KaHyPar-Q-F)\n")
+             " - quality_flows (Mt-KaHyPar-Q-F)\n"
+             " - auto (configures Mt-KaHyPar-D-F based on the input and time limit)\n")
             ("seed",
              po::value<int>(&context.partition.seed)->value_name("<int>")->default_value(0),
              "Seed for random number generator")
             ("num-vcycles",
              po::value<size_t>(&context.partition.num_vcycles)->value_name("<size_t>")->default_value(0),
              "Number of V-Cycles")
+            ("localized-vcycles",
+             po::value<bool>(&context.partition.localized_vcycles)->value_name("<bool>")->default_value(false),
+             "If true, each V-cycle contracts all vertices with a distance greater than\n"
+             "--localized-vcycle-distance to the cut into one vertex per block. Coarsening,\n"
+             "initial partitioning and refinement then only work on a band around the cut.\n"
+             "(only supported in the multilevel paradigm)")
+            ("localized-vcycle-distance",
+             po::value<size_t>(&context.partition.localized_vcycle_distance)->value_name("<size_t>")->default_value(2),
+             "Vertices within this distance (in hyperedges) to a cut hyperedge are not\n"
+             "contracted before coarsening in localized V-cycles")
+            ("anytime",
+             po::value<bool>(&context.partition.anytime)->value_name("<bool>")->default_value(false),
+             "If true, a first partition is computed with label propagation refinement only, which\n"
+             "is then improved with all configured refiners in (at least one) V-cycles.")
+            ("checkpoint-file",
+             po::value<std::string>(&context.partition.checkpoint_file)->value_name("<string>"),
+             "If set, the partition is written to this file after each V-cycle. If the file already\n"
+             "contains a checkpoint for the same input, k and seed, the run resumes from it.")
+            ("fixed-vertices",
+             po::value<std::string>(&context.partition.fixed_vertex_filename)->value_name("<string>"),
+             "File that contains the block to which each vertex is fixed (one line per vertex,\n"
+             "-1 = not fixed). Only supported in the (non-deterministic) direct k-way mode.")
             ("perform-parallel-recursion-in-deep-multilevel",
              po::value<bool>(&context.partition.perform_parallel_recursion_in_deep_multilevel)->value_name("<bool>")->default_value(true),
              "If true, then we perform parallel recursion within the deep multilevel scheme.")
+            ("streaming-buffer-size",
+             po::value<HypernodeID>(&context.partition.streaming_buffer_size)->value_name("<uint32_t>")->default_value(32768),
+             "Number of consecutive vertices that are assigned and refined together in the streaming mode.")
+            ("streaming-refinement-rounds",
+             po::value<size_t>(&context.partition.streaming_refinement_rounds)->value_name("<size_t>")->default_value(3),
+             "Maximum number of label propagation rounds on each buffer in the streaming mode (0 = no refinement).")
+            ("multisection-k1",
+             po::value<PartitionID>(&context.partition.multisection_k1)->value_name("<int>")->default_value(0),
+             "Number of top-level blocks in the multisection mode. Each top-level block is then partitioned\n"
+             "into (about) k / multisection-k1 blocks (0 = round(sqrt(k))).")
             ("smallest-maxnet-threshold",
             po::value<uint32_t>(&context.partition.smallest_large_he_size_threshold)->value_name("<uint32_t>"),
             "No hyperedge whose size is smaller than this threshold is removed in the large hyperedge removal step (see maxnet-removal-factor)")
@@ -128,6 +172,16 @@ namespace mt_kahypar {
              po::value<HyperedgeID>(&context.partition.ignore_hyperedge_size_threshold)->value_name(
                      "<uint64_t>")->default_value(1000),
              "Hyperedges larger than this threshold are ignored during partitioning.")
+            ("maxnet-pin-sample-size",
+             po::value<HypernodeID>(&context.partition.large_hyperedge_pin_sample_size)->value_name(
+                     "<uint32_t>")->default_value(0),
+             "If greater than zero, large hyperedges are not removed before partitioning (see maxnet-removal-factor) "
+             "and hyperedges larger than maxnet-ignore are represented by a sample of this many pins during rating "
+             "instead of being ignored.")
+            ("small-instance-num-pins-threshold",
+             po::value<size_t>(&context.partition.small_instance_num_pins_threshold)->value_name("<size_t>"),
+             "Hypergraphs with fewer pins are partitioned sequentially in a single-thread task arena without\n"
+             "allocating the memory pool (0 = disabled).")
             ("show-detailed-timings",
              po::value<bool>(&context.partition.show_detailed_timings)->value_name("<bool>")->default_value(false),
              "If true, shows detailed subtimings of each multilevel phase at the end of the partitioning process.")
@@ -142,6 +196,19 @@ namespace mt_kahypar {
             ("timings-output-depth",
              po::value<size_t>(&context.partition.timings_output_depth)->value_name("<size_t>"),
              "Number of levels shown in timing output")
+            ("measure-hardware-counters",
+             po::value<bool>(&context.partition.measure_hardware_counters)->value_name("<bool>")->default_value(false),
+             "If true, measures cycles, last-level cache misses, branch mispredictions and remote NUMA accesses\n"
+             "for each timing of a multilevel phase via perf_event (linux only) and shows them in the timing output.")
+            ("profile-scalability",
+             po::value<bool>(&context.partition.profile_scalability)->value_name("<bool>")->default_value(false),
+             "If true, measures the busy time of each thread for each timing of a multilevel phase and shows\n"
+             "the parallel efficiency, load imbalance and slowest thread of the phase in the timing output.")
+            ("trace-file",
+             po::value<std::string>(&context.partition.trace_file)->value_name("<string>"),
+             "If set, the timeline of all timed phases, initial partitioning runs, flow searches and localized\n"
+             "FM searches of each thread is written to this file in the Chrome trace format (view it with\n"
+             "chrome://tracing or ui.perfetto.dev). Requires compilation with KAHYPAR_ENABLE_TRACING.")
             ("show-memory-consumption",
              po::value<bool>(&context.partition.show_memory_consumption)->value_name("<bool>")->default_value(false),
              "If true, shows detailed information on how much memory was allocated and how memory was reused throughout partitioning.")
@@ -152,7 +219,22 @@ namespace mt_kahypar {
              po::value<bool>(&context.partition.enable_progress_bar)->value_name("<bool>")->default_value(false),
              "If true, shows a progress bar during coarsening and refinement phase.")
             ("time-limit", po::value<int>(&context.partition.time_limit)->value_name("<int>"),
-             "Time limit in seconds (currently not supported)")
+             "Time limit in seconds. Once reached, the partitioner stops coarsening and refinement\n"
+             "and returns the current partition projected to the input hypergraph (default: 0 = unlimited).\n"
+             "In direct k-way mode, the time limit is divided across the phases and the levels of the\n"
+             "uncoarsening phase, and the refiners of each level finish within their time slice.")
+            ("memory-limit", po::value<size_t>(&context.partition.memory_limit)->value_name("<size_t>"),
+             "Memory limit in MB (default: 0 = unlimited). If the predicted peak memory exceeds the limit,\n"
+             "the partitioner switches to lower-memory algorithms (low-memory contraction, smaller flow problems,\n"
+             "FM without gain cache and finally no FM refinement).")
+            ("result-cache-size",
+             po::value<size_t>(&context.partition.result_cache_size)->value_name("<size_t>")->default_value(0),
+             "Maximum number of partitions kept in the in-memory result cache of the library.\n"
+             "Repeated calls with the same input and parameters return the cached partition (default: 0 = disabled)")
+            ("result-cache-directory",
+             po::value<std::string>(&context.partition.result_cache_directory)->value_name("<string>"),
+             "Partitions computed by the library are stored in and loaded from this directory\n"
+             "(default: disabled)")
             ("sp-process,s",
              po::value<bool>(&context.partition.sp_process_output)->value_name("<bool>")->default_value(false),
              "Summarize partitioning results in RESULT line compatible with sqlplottools "
@@ -187,6 +269,14 @@ namespace mt_kahypar {
              po::value<bool>(&context.preprocessing.disable_community_detection_for_mesh_graphs)->value_name("<bool>")->default_value(true),
              "If true, community detection is dynamically disabled for mesh graphs (as it is not effective for this type of graphs).")
             #endif
+            ("p-remove-twin-vertices",
+             po::value<bool>(&context.preprocessing.remove_twin_vertices)->value_name("<bool>")->default_value(false),
+             "If true, vertices with identical incident nets (twins) are merged into one vertex before coarsening "
+             "(as long as its weight does not exceed the maximum allowed node weight).")
+            ("p-reorder-for-locality",
+             po::value<bool>(&context.preprocessing.reorder_for_locality)->value_name("<bool>")->default_value(false),
+             "If true, vertices and nets are renumbered in BFS order (Cuthill-McKee) before partitioning, "
+             "which improves the memory locality of inputs with (almost) random IDs.")
             ("p-louvain-edge-weight-function",
              po::value<std::string>()->value_name("<string>")->notifier(
                      [&](const std::string& type) {
@@ -206,6 +296,12 @@ namespace mt_kahypar {
              po::value<bool>(&context.preprocessing.community_detection.low_memory_contraction)->value_name(
                      "<bool>")->default_value(false),
              "Maximum number of iterations over all nodes of one louvain pass")
+            ("p-louvain-implicit-star-expansion",
+             po::value<bool>(&context.preprocessing.community_detection.implicit_star_expansion)->value_name(
+                     "<bool>")->default_value(false),
+             "If true, the first louvain level runs on an implicit view of the star-expansion of the hypergraph\n"
+             "that computes the arcs on the fly. Only the contracted levels are materialized.\n"
+             "(only used for static hypergraphs, otherwise the star-expansion is always materialized).")
             ("p-louvain-min-vertex-move-fraction",
              po::value<long double>(&context.preprocessing.community_detection.min_vertex_move_fraction)->value_name(
                      "<long double>")->default_value(0.01),
@@ -214,10 +310,26 @@ namespace mt_kahypar {
              po::value<size_t>(&context.preprocessing.community_detection.vertex_degree_sampling_threshold)->value_name(
                      "<size_t>")->default_value(std::numeric_limits<size_t>::max()),
              "If set, then neighbors of a vertex are sampled during rating if its degree is greater than this threshold.")
+            ("p-louvain-active-set-pruning",
+             po::value<bool>(&context.preprocessing.community_detection.use_active_set_pruning)->value_name(
+                     "<bool>")->default_value(true),
+             "If true, then only neighbors of moved vertices are visited in the next louvain pass\n"
+             "(only used for non-deterministic community detection).")
+            ("p-louvain-high-degree-threshold",
+             po::value<size_t>(&context.preprocessing.community_detection.high_degree_vertex_threshold)->value_name(
+                     "<size_t>")->default_value(50000),
+             "Vertices with a degree greater than this threshold are moved after all other vertices of a louvain pass.\n"
+             "The incident cluster weights of such vertices are aggregated in parallel and without sampling\n"
+             "(only used for non-deterministic community detection).")
             ("p-num-sub-rounds",
              po::value<size_t>(&context.preprocessing.community_detection.num_sub_rounds_deterministic)->value_name(
                      "<size_t>")->default_value(16),
-             "Number of sub-rounds used for deterministic community detection in preprocessing.");
+             "Number of sub-rounds used for deterministic community detection in preprocessing.")
+            ("p-community-cache-directory",
+             po::value<std::string>(&context.preprocessing.community_detection.cache_directory)->value_name(
+                     "<string>")->default_value(""),
+             "If set, the communities of the input are stored in this directory and reused by subsequent runs\n"
+             "on the same input with the same community detection parameters (e.g., when only k, epsilon or the seed changes).");
     return options;
   }
 
@@ -232,6 +344,7 @@ namespace mt_kahypar {
                      })->default_value("multilevel_coarsener"),
              "Coarsening Algorithm:\n"
              " - multilevel_coarsener"
+             " - two_hop_multilevel_coarsener"
              " - nlevel_coarsener"
              " - deterministic_multilevel_coarsener"
              )
@@ -287,7 +400,71 @@ namespace mt_kahypar {
             ("c-num-sub-rounds",
              po::value<size_t>(&context.coarsening.num_sub_rounds_deterministic)->value_name(
                      "<size_t>")->default_value(16),
-             "Number of sub-rounds used for deterministic coarsening.");
+             "Number of sub-rounds used for deterministic coarsening.")
+            ("c-deterministic-conflict-resolution",
+             po::value<bool>(&context.coarsening.deterministic_conflict_resolution)->value_name("<bool>")->default_value(false),
+             "If true, a vertex that other vertices of the same sub-round want to join stays in its cluster\n"
+             "during deterministic coarsening. This allows fewer sub-rounds (c-num-sub-rounds) without\n"
+             "losing contractions to swaps and chains of moves.")
+            ("c-low-memory-contraction",
+             po::value<bool>(&context.coarsening.low_memory_contraction)->value_name("<bool>")->default_value(false),
+             "If true, the contraction of the static hypergraph does not use temporary buffers for pins and\n"
+             "incident nets. This reduces the peak memory usage of coarsening at the cost of a slower contraction.")
+            ("c-vertex-order-tile-size",
+             po::value<size_t>(&context.coarsening.vertex_order_tile_size)->value_name("<size_t>")->default_value(0),
+             "If greater than zero, the coarsener visits the vertices in tiles of consecutive vertex IDs of this size\n"
+             "and randomizes the order only within each tile. This improves the cache locality of the rating.\n"
+             "(default: 0 = global random shuffle)")
+            ("c-order-clusters-by-community",
+             po::value<bool>(&context.coarsening.order_clusters_by_community)->value_name("<bool>")->default_value(false),
+             "If true, the clusters are relabeled in order of their community IDs before contraction. The vertices\n"
+             "of a community then have consecutive IDs in the contracted hypergraph, which improves cache locality.")
+            ("c-reuse-hierarchy-in-rb",
+             po::value<bool>(&context.coarsening.reuse_hierarchy_in_rb)->value_name("<bool>")->default_value(false),
+             "If true, recursive bipartitioning restricts the multilevel hierarchy of a bipartition to each of its\n"
+             "blocks and contracts the first levels of the block according to it instead of coarsening the block\n"
+             "from scratch. Clusters that straddle the cut are split. (not supported by the n-level coarsener)")
+            ("c-use-min-hash-sparsifier",
+             po::value<bool>(&context.coarsening.use_min_hash_sparsifier)->value_name("<bool>")->default_value(false),
+             "If true, similar nets of each coarse hypergraph are merged before it is coarsened further. Candidates\n"
+             "are found via MinHash-based locality-sensitive hashing. Refinement uses the original coarse hypergraph.")
+            ("c-min-hash-num-hash-functions",
+             po::value<size_t>(&context.coarsening.min_hash_num_hash_functions)->value_name("<size_t>")->default_value(2),
+             "Number of MinHash values combined into the signature of a net (more = fewer, but more similar candidates)")
+            ("c-min-hash-similarity-threshold",
+             po::value<double>(&context.coarsening.min_hash_similarity_threshold)->value_name("<double>")->default_value(0.75),
+             "Two nets with the same signature are merged if their Jaccard similarity is at least this threshold")
+            ("c-similar-net-combiner-strategy",
+             po::value<std::string>()->value_name("<string>")->notifier(
+                     [&](const std::string& strategy) {
+                       context.coarsening.similar_net_combiner_strategy =
+                               mt_kahypar::similiarNetCombinerStrategyFromString(strategy);
+                     })->default_value("union"),
+             "Determines the pins of a net that replaces several similar nets:\n"
+             "- union: union of the pins of all nets\n"
+             "- max_size: pins of the largest net\n"
+             "- importance: pins contained in nets with at least half of the total weight")
+            ("c-nlevel-contraction-batch-size",
+             po::value<size_t>(&context.coarsening.nlevel_contraction_batch_size)->value_name("<size_t>")->default_value(0),
+             "If greater than zero, the n-level coarsener rates batches of vertices of this size in parallel and\n"
+             "contracts a conflict-free matching of the ratings in bulk without per-vertex locking.\n"
+             "(default: 0 = register and contract each vertex pair individually)")
+            ("c-level-arena-factor",
+             po::value<double>(&context.coarsening.level_arena_factor)->value_name("<double>")->default_value(0.0),
+             "If greater than zero, a region of this size relative to the size of the input hypergraph is allocated\n"
+             "and touched before coarsening. The coarse hypergraphs of the multilevel hierarchy are then allocated\n"
+             "in this region instead of allocating and page faulting each level individually. If the levels shrink by\n"
+             "a factor of two, the hierarchy requires roughly the size of the input hypergraph (factor 1.0).\n"
+             "Levels that do not fit use regular allocations. (only supported by the static hypergraph data structure)")
+            ("c-offload-directory",
+             po::value<std::string>(&context.coarsening.offload_directory)->value_name("<string>")->default_value(""),
+             "If set, each level of the multilevel hierarchy is written to a temporary snapshot in this directory\n"
+             "once the next coarser level is contracted and is then accessed via a memory mapping. Thus, the\n"
+             "operating system can evict levels that are not refined at the moment from main memory.\n"
+             "(only supported by the static hypergraph data structure)")
+            ("c-offload-min-num-pins",
+             po::value<size_t>(&context.coarsening.offload_min_num_pins)->value_name("<size_t>")->default_value(0),
+             "Only levels with at least this number of pins are offloaded to disk (see c-offload-directory).");
     return options;
   }
 
@@ -306,6 +483,14 @@ namespace mt_kahypar {
                               &context.initial_partitioning.refinement.relative_improvement_threshold))->value_name(
                      "<double>")->default_value(0.0),
              "If the relative improvement during a refinement pass is less than this threshold, than refinement is aborted.")
+            ((initial_partitioning ? "i-r-fuse-lp-and-fm" : "r-fuse-lp-and-fm"),
+             po::value<bool>((!initial_partitioning ? &context.refinement.fuse_lp_and_fm :
+                              &context.initial_partitioning.refinement.fuse_lp_and_fm))->value_name(
+                     "<bool>")->default_value(false),
+             "If true, the gain cache is initialized before label propagation and label propagation keeps it\n"
+             "up-to-date such that FM can reuse it. FM then starts its localized searches only from the vertices\n"
+             "moved by label propagation (or from all border vertices, if label propagation moved no vertex).\n"
+             "Only supported in multilevel mode.")
             (( initial_partitioning ? "i-r-max-batch-size" : "r-max-batch-size"),
              po::value<size_t>((!initial_partitioning ? &context.refinement.max_batch_size :
                                 &context.initial_partitioning.refinement.max_batch_size))->value_name("<size_t>")->default_value(1000),
@@ -314,6 +499,46 @@ namespace mt_kahypar {
              po::value<size_t>((!initial_partitioning ? &context.refinement.min_border_vertices_per_thread :
                                 &context.initial_partitioning.refinement.min_border_vertices_per_thread))->value_name("<size_t>")->default_value(0),
              "Minimum number of border vertices per thread with which we perform a localized search (n-Level Partitioner).")
+            (( initial_partitioning ? "i-r-min-border-vertices-fraction" : "r-min-border-vertices-fraction"),
+             po::value<double>((!initial_partitioning ? &context.refinement.min_border_vertices_fraction :
+                                &context.initial_partitioning.refinement.min_border_vertices_fraction))->value_name("<double>")->default_value(0.0),
+             "Minimum number of border vertices with which we perform a localized search relative to the current number\n"
+             "of nodes. Thus, the number of uncontractions between two localized searches grows geometrically with the\n"
+             "size of the hypergraph (n-Level Partitioner, default disabled).")
+            ((initial_partitioning ? "i-r-track-objective" : "r-track-objective"),
+             po::value<bool>((!initial_partitioning ? &context.refinement.track_objective :
+                              &context.initial_partitioning.refinement.track_objective))->value_name(
+                     "<bool>")->default_value(false),
+             "If true, the km1 and cut metric are maintained incrementally during uncoarsening such that\n"
+             "querying the objective does not require a pass over all hyperedges (not supported for graphs).")
+            ((initial_partitioning ? "i-r-track-cut-nets" : "r-track-cut-nets"),
+             po::value<bool>((!initial_partitioning ? &context.refinement.track_cut_nets :
+                              &context.initial_partitioning.refinement.track_cut_nets))->value_name(
+                     "<bool>")->default_value(false),
+             "If true, the set of cut hyperedges is maintained incrementally during uncoarsening such that\n"
+             "border vertices are enumerated via the pins of cut hyperedges instead of a pass over all\n"
+             "vertices (not supported for graphs).")
+            ((initial_partitioning ? "i-r-defer-high-degree-moves" : "r-defer-high-degree-moves"),
+             po::value<bool>((!initial_partitioning ? &context.refinement.defer_high_degree_moves :
+                              &context.initial_partitioning.refinement.defer_high_degree_moves))->value_name(
+                     "<bool>")->default_value(false),
+             "If true, label propagation and FM defer moves of vertices with a very high degree to a\n"
+             "dedicated phase that updates the pin counts and gain cache of their incident hyperedges in\n"
+             "parallel.")
+            ((initial_partitioning ? "i-r-low-value-level-border-fraction" : "r-low-value-level-border-fraction"),
+             po::value<double>((!initial_partitioning ? &context.refinement.low_value_level_border_fraction :
+                                &context.initial_partitioning.refinement.low_value_level_border_fraction))->value_name(
+                     "<double>")->default_value(0.0),
+             "If the projection of the partition to the next level introduces fewer new border vertices than this\n"
+             "fraction of all border vertices, the level is only refined with label propagation. The finest level\n"
+             "is always refined with all algorithms (Multilevel Partitioner, default disabled).")
+            ((initial_partitioning ? "i-r-max-uncoarsening-time" : "r-max-uncoarsening-time"),
+             po::value<double>((!initial_partitioning ? &context.refinement.max_uncoarsening_time :
+                                &context.initial_partitioning.refinement.max_uncoarsening_time))->value_name(
+                     "<double>")->default_value(std::numeric_limits<double>::max()),
+             "Time budget (in seconds) for refinement during uncoarsening. Refiners are limited to the remaining\n"
+             "budget and, once it is exhausted, the partition is only projected to the remaining levels\n"
+             "(Multilevel Partitioner, default unlimited).")
             ((initial_partitioning ? "i-r-lp-type" : "r-lp-type"),
              po::value<std::string>()->value_name("<string>")->notifier(
                      [&, initial_partitioning](const std::string& type) {
@@ -357,6 +582,15 @@ namespace mt_kahypar {
                       &context.initial_partitioning.refinement.label_propagation.hyperedge_size_activation_threshold))->value_name(
                      "<size_t>")->default_value(100),
              "LP refiner activates only neighbors of moved vertices that are part of hyperedges with a size less than this threshold")
+            ((initial_partitioning ? "i-r-lp-dense-frontier-threshold" : "r-lp-dense-frontier-threshold"),
+             po::value<double>(
+                     (!initial_partitioning ? &context.refinement.label_propagation.dense_frontier_threshold
+                                            :
+                      &context.initial_partitioning.refinement.label_propagation.dense_frontier_threshold))->value_name(
+                     "<double>")->default_value(0.1),
+             "If the active nodes of the next LP round exceed this fraction of the nodes, they are collected\n"
+             "from the activation bitmap in ID order and only shuffled within tiles (memory-sequential rounds).\n"
+             "Smaller frontiers are kept as a sparse list in random order. A value >= 1.0 disables the dense mode.")
             ((initial_partitioning ? "i-r-fm-type" : "r-fm-type"),
              po::value<std::string>()->value_name("<string>")->notifier(
                      [&, initial_partitioning](const std::string& type) {
@@ -369,8 +603,12 @@ namespace mt_kahypar {
              "FM Algorithm:\n"
              "- fm_gain_cache\n"
              "- fm_gain_cache_on_demand\n"
+             "- fm_gain_cache_lazy\n"
              "- fm_gain_delta\n"
              "- fm_recompute_gain\n"
+             "- jet\n"
+             "- pairwise_fm\n"
+             "- deterministic\n"
              "- do_nothing")
             ((initial_partitioning ? "i-r-fm-multitry-rounds" : "r-fm-multitry-rounds"),
              po::value<size_t>((initial_partitioning ? &context.initial_partitioning.refinement.fm.multitry_rounds :
@@ -410,10 +648,33 @@ namespace mt_kahypar {
              po::value<double>((initial_partitioning ? &context.initial_partitioning.refinement.fm.min_improvement :
                                 &context.refinement.fm.min_improvement))->value_name("<double>")->default_value(-1.0),
              "Min improvement for FM (default disabled)")
+            ((initial_partitioning ? "i-r-fm-min-expected-improvement" : "r-fm-min-expected-improvement"),
+             po::value<double>((initial_partitioning ? &context.initial_partitioning.refinement.fm.min_expected_improvement :
+                                &context.refinement.fm.min_expected_improvement))->value_name("<double>")->default_value(-1.0),
+             "Multitry FM stops if the predicted relative improvement of the next round is below this value.\n"
+             "The improvement of the last round is extrapolated with the average decrease of the improvement\n"
+             "between consecutive rounds observed on the previous levels (default disabled)")
+            ((initial_partitioning ? "i-r-fm-order-seeds-by-gain" : "r-fm-order-seeds-by-gain"),
+             po::value<bool>((initial_partitioning ? &context.initial_partitioning.refinement.fm.order_seeds_by_gain :
+                              &context.refinement.fm.order_seeds_by_gain))->value_name("<bool>")->default_value(false),
+             "If true, localized FM searches are started from the border nodes with the highest gain\n"
+             "(extracted from a relaxed concurrent priority queue). Only supported by the gain cache FM strategy.\n"
+             "Otherwise, seed nodes are extracted in arbitrary order.")
             ((initial_partitioning ? "i-r-fm-release-nodes" : "r-fm-release-nodes"),
              po::value<bool>((initial_partitioning ? &context.initial_partitioning.refinement.fm.release_nodes :
                               &context.refinement.fm.release_nodes))->value_name("<bool>")->default_value(true),
              "FM releases nodes that weren't moved, so they might be found by another search.")
+            ((initial_partitioning ? "i-r-fm-adaptive-stop-rule" : "r-fm-adaptive-stop-rule"),
+             po::value<bool>((initial_partitioning ? &context.initial_partitioning.refinement.fm.adaptive_stop_rule :
+                              &context.refinement.fm.adaptive_stop_rule))->value_name("<bool>")->default_value(false),
+             "If true, the stop rule of the localized FM searches becomes more aggressive if most moves are reverted\n"
+             "locally and more relaxed if only a few moves are reverted (adapted after each multitry round).")
+            ((initial_partitioning ? "i-r-fm-bucket-queue-max-gain" : "r-fm-bucket-queue-max-gain"),
+             po::value<HyperedgeWeight>((initial_partitioning ? &context.initial_partitioning.refinement.fm.bucket_queue_max_gain :
+                                         &context.refinement.fm.bucket_queue_max_gain))->value_name("<int>")->default_value(256),
+             "The localized FM searches use bucket queues instead of binary heaps, if the maximum weighted degree\n"
+             "of a vertex (an upper bound for the gain of a move) is at most this value (only for cut and km1).\n"
+             "Set to 0 for disabling.")
             ((initial_partitioning ? "i-r-fm-obey-minimal-parallelism" : "r-fm-obey-minimal-parallelism"),
              po::value<bool>(
                      (initial_partitioning ? &context.initial_partitioning.refinement.fm.obey_minimal_parallelism :
@@ -425,6 +686,11 @@ namespace mt_kahypar {
              "If the FM time exceeds time_limit := k * factor * coarsening_time, than the FM config is switched into a light version."
              "If the FM refiner exceeds 2 * time_limit, than the current multitry FM run is aborted and the algorithm proceeds to"
              "the next finer level.")
+            ((initial_partitioning ? "i-r-fm-jet-negative-gain-factor" : "r-fm-jet-negative-gain-factor"),
+             po::value<double>((initial_partitioning ? &context.initial_partitioning.refinement.fm.jet_negative_gain_factor :
+                                &context.refinement.fm.jet_negative_gain_factor))->value_name("<double>")->default_value(0.25),
+             "Jet refiner (r-fm-type=jet): A vertex with a negative gain becomes a move candidate, if the loss is smaller\n"
+             "than this factor times the weight of its nets that are internal to its block.")
             #ifdef USE_STRONG_PARTITIONER
             ((initial_partitioning ? "i-r-use-global-fm" : "r-use-global-fm"),
              po::value<bool>((!initial_partitioning ? &context.refinement.global_fm.use_global_fm :
@@ -467,7 +733,8 @@ namespace mt_kahypar {
                      })->default_value("do_nothing"),
              "Flow Algorithms:\n"
              "- do_nothing\n"
-             "- flow_cutter")
+             "- flow_cutter\n"
+             "- graph_flow_cutter (only for graphs, selected automatically instead of flow_cutter)")
             ((initial_partitioning ? "i-r-flow-parallel-search-multiplier" : "r-flow-parallel-search-multiplier"),
              po::value<double>((initial_partitioning ? &context.initial_partitioning.refinement.flows.parallel_searches_multiplier :
                       &context.refinement.flows.parallel_searches_multiplier))->value_name("<double>"),
@@ -497,6 +764,37 @@ namespace mt_kahypar {
              po::value<bool>((initial_partitioning ? &context.initial_partitioning.refinement.flows.pierce_in_bulk :
                               &context.refinement.flows.pierce_in_bulk))->value_name("<bool>"),
              "If true, then FlowCutter is accelerated by piercing multiple nodes at a time")
+            ((initial_partitioning ? "i-r-flow-prioritize-block-pairs" : "r-flow-prioritize-block-pairs"),
+             po::value<bool>((initial_partitioning ? &context.initial_partitioning.refinement.flows.prioritize_block_pairs :
+                              &context.refinement.flows.prioritize_block_pairs))->value_name("<bool>"),
+             "If true, then the block pairs of each active block scheduling round are scheduled in decreasing order\n"
+             "of their expected improvement per pin of the flow problem (estimated from previous searches)")
+            ((initial_partitioning ? "i-r-flow-unproductive-block-pair-cut-change" : "r-flow-unproductive-block-pair-cut-change"),
+             po::value<double>((initial_partitioning ? &context.initial_partitioning.refinement.flows.unproductive_block_pair_cut_change :
+                              &context.refinement.flows.unproductive_block_pair_cut_change))->value_name("<double>"),
+             "If greater than zero, block pairs on which all flow searches failed on the previous level and whose\n"
+             "cut weight changed by at most this fraction are not scheduled in the first round of the current level.\n"
+             "They are scheduled later if one of their blocks becomes active. (default: 0.0 = disabled)")
+            ((initial_partitioning ? "i-r-flow-parallel-apply-moves" : "r-flow-parallel-apply-moves"),
+             po::value<bool>((initial_partitioning ? &context.initial_partitioning.refinement.flows.parallel_apply_moves :
+                              &context.refinement.flows.parallel_apply_moves))->value_name("<bool>"),
+             "If true, then the move sequences of successful flow searches are applied concurrently if they\n"
+             "touch disjoint sets of blocks (otherwise, they are applied one after another)")
+            ((initial_partitioning ? "i-r-flow-reorder-nodes" : "r-flow-reorder-nodes"),
+             po::value<bool>((initial_partitioning ? &context.initial_partitioning.refinement.flows.reorder_nodes :
+                              &context.refinement.flows.reorder_nodes))->value_name("<bool>"),
+             "If true, then the nodes of flow networks constructed in parallel are renumbered in the order in which\n"
+             "they first occur in the pin lists of the hyperedges (improves locality of the flow algorithm)")
+            ((initial_partitioning ? "i-r-flow-localized-refinement" : "r-flow-localized-refinement"),
+             po::value<bool>((initial_partitioning ? &context.initial_partitioning.refinement.flows.use_localized_flows :
+                              &context.refinement.flows.use_localized_flows))->value_name("<bool>"),
+             "If true, then n-level uncoarsening runs flow-based refinement on small flow problems grown around\n"
+             "the border vertices of each uncontracted batch (in addition to the global flow refinement)")
+            ((initial_partitioning ? "i-r-flow-localized-max-bfs-distance" : "r-flow-localized-max-bfs-distance"),
+             po::value<size_t>((initial_partitioning ? &context.initial_partitioning.refinement.flows.localized_max_bfs_distance :
+                              &context.refinement.flows.localized_max_bfs_distance))->value_name("<size_t>"),
+             "Maximum BFS distance from a cut hyperedge incident to a seed vertex to any vertex\n"
+             "of a flow problem constructed for localized flow refinement")
             ((initial_partitioning ? "i-r-flow-scaling" : "r-flow-scaling"),
              po::value<double>((initial_partitioning ? &context.initial_partitioning.refinement.flows.alpha :
                       &context.refinement.flows.alpha))->value_name("<double>"),
@@ -505,10 +803,33 @@ namespace mt_kahypar {
              po::value<uint32_t>((initial_partitioning ? &context.initial_partitioning.refinement.flows.max_num_pins :
                       &context.refinement.flows.max_num_pins))->value_name("<uint32_t>"),
              "Maximum number of pins a flow problem is allowed to contain")
+            ((initial_partitioning ? "i-r-flow-max-num-pins-of-concurrent-searches" : "r-flow-max-num-pins-of-concurrent-searches"),
+             po::value<size_t>((initial_partitioning ? &context.initial_partitioning.refinement.flows.max_num_pins_of_concurrent_searches :
+                      &context.refinement.flows.max_num_pins_of_concurrent_searches))->value_name("<size_t>"),
+             "Maximum number of pins of all flow problems that are constructed or solved concurrently.\n"
+             "If the budget is tight, flow problems are grown smaller instead of exceeding it (bounds peak memory).\n"
+             "The budget may be exceeded by the degree of the vertices added last to a flow problem.")
+            ((initial_partitioning ? "i-r-flow-min-num-pins-for-parallel-flow" : "r-flow-min-num-pins-for-parallel-flow"),
+             po::value<uint32_t>((initial_partitioning ? &context.initial_partitioning.refinement.flows.min_num_pins_for_parallel_flow :
+                      &context.refinement.flows.min_num_pins_for_parallel_flow))->value_name("<uint32_t>"),
+             "Flow problems with less pins are solved with the sequential flow algorithm, even if more threads are available.\n"
+             "The remaining threads are made available to other searches, such that large flow problems can use the\n"
+             "parallel push-relabel algorithm (default: 0)")
+            ((initial_partitioning ? "i-r-flow-min-num-pins-for-parallel-region-growing" : "r-flow-min-num-pins-for-parallel-region-growing"),
+             po::value<uint32_t>((initial_partitioning ? &context.initial_partitioning.refinement.flows.min_num_pins_for_parallel_region_growing :
+                      &context.refinement.flows.min_num_pins_for_parallel_region_growing))->value_name("<uint32_t>"),
+             "If the region grown around the cut of a flow problem contains more pins, we continue with a\n"
+             "level-synchronous parallel BFS (default: 4294967295)")
             ((initial_partitioning ? "i-r-flow-find-most-balanced-cut" : "r-flow-find-most-balanced-cut"),
              po::value<bool>((initial_partitioning ? &context.initial_partitioning.refinement.flows.find_most_balanced_cut :
                       &context.refinement.flows.find_most_balanced_cut))->value_name("<bool>"),
              "If true, than hyperflowcutter searches for the most balanced minimum cut.")
+            ((initial_partitioning ? "i-r-flow-most-balanced-cut-portfolio-size" : "r-flow-most-balanced-cut-portfolio-size"),
+             po::value<size_t>((initial_partitioning ? &context.initial_partitioning.refinement.flows.most_balanced_cut_portfolio_size :
+                      &context.refinement.flows.most_balanced_cut_portfolio_size))->value_name("<size_t>"),
+             "If more than one thread is assigned to a flow search and the most balanced minimum cut is searched,\n"
+             "we run up to this number of sequential flowcutters with different seeds on copies of the flow network\n"
+             "and take the first balanced cut (default: 1, which disables the portfolio)")
             ((initial_partitioning ? "i-r-flow-determine-distance-from-cut" : "r-flow-determine-distance-from-cut"),
              po::value<bool>((initial_partitioning ? &context.initial_partitioning.refinement.flows.determine_distance_from_cut :
                       &context.refinement.flows.determine_distance_from_cut))->value_name("<bool>"),
@@ -527,7 +848,9 @@ namespace mt_kahypar {
              "Mode of initial partitioning:\n"
              "- direct\n"
              "- deep\n"
-             "- rb")
+             "- rb\n"
+             "- streaming\n"
+             "- multisection")
             ("i-enabled-ip-algos",
             po::value<std::vector<bool> >(&context.initial_partitioning.enabled_ip_algos)->multitoken(),
             "Indicate which IP algorithms should be executed. E.g. i-enabled-ip-algos=1 1 0 1 0 1 1 1 0\n"
@@ -554,10 +877,29 @@ namespace mt_kahypar {
              po::value<size_t>(&context.initial_partitioning.min_adaptive_ip_runs)->value_name("<size_t>")->default_value(5),
              "If adaptive IP runs is enabled, than each initial partitioner performs minimum min_adaptive_ip_runs runs before\n"
              "it decides if it should terminate.")
+            ("i-use-racing-scheduler",
+             po::value<bool>(&context.initial_partitioning.use_ip_racing_scheduler)->value_name("<bool>")->default_value(true),
+             "If true and adaptive IP runs are enabled, the runs of the initial partitioners are not scheduled upfront.\n"
+             "Instead, each thread repeatedly picks the partitioner that is most likely to produce a new best partition\n"
+             "and cancels the remaining runs of partitioners that are unlikely to win (not used in deterministic mode).")
             ("i-population-size",
              po::value<size_t>(&context.initial_partitioning.population_size)->value_name("<size_t>")->default_value(16),
              "Size of population of flat bipartitions to perform secondary FM refinement on in deterministic mode."
              "Values < num threads are set to num threads. Does not affect behavior in non-deterministic mode.")
+            ("i-nested-parallelism-min-nodes",
+             po::value<size_t>(&context.initial_partitioning.nested_parallelism_min_nodes)->value_name("<size_t>")->default_value(100000),
+             "If the hypergraph has at least this many nodes, the label propagation initial partitioner and the\n"
+             "LP refiner of the initial partitioning runs use nested parallelism (not used in deterministic mode).")
+            ("i-portfolio-levels",
+             po::value<size_t>(&context.initial_partitioning.portfolio_levels)->value_name("<size_t>")->default_value(1),
+             "Number of coarsest levels of the multilevel hierarchy that are initially partitioned concurrently.\n"
+             "The partitions are compared after a short label propagation run on the finest of these levels and\n"
+             "uncoarsening continues from the level of the best one (1 = disabled, not used in deterministic mode).")
+            ("i-heavy-vertex-weight-fraction",
+             po::value<double>(&context.initial_partitioning.heavy_vertex_weight_fraction)->value_name("<double>"),
+             "Vertices heavier than this fraction of the smallest maximum block weight are assigned to blocks\n"
+             "with a longest-processing-time-first bin packing before greedy growing and are not moved by the\n"
+             "greedy initial partitioners (0 = disabled).")
             ("i-perform-refinement-on-best-partitions",
              po::value<bool>(&context.initial_partitioning.perform_refinement_on_best_partitions)->value_name("<bool>")->default_value(false),
              "If true, then we perform an additional refinement on the best thread local partitions after IP.")
@@ -603,7 +945,58 @@ namespace mt_kahypar {
             ("s-shuffle-block-size",
              po::value<size_t>(&context.shared_memory.shuffle_block_size)->value_name("<size_t>"),
              "If we perform a localized random shuffle in parallel, we perform a parallel for over blocks of size"
-             "'shuffle_block_size' and shuffle them sequential.");
+             "'shuffle_block_size' and shuffle them sequential.")
+            ("s-numa-placement",
+             po::value<std::string>()->value_name("<string>")->notifier(
+                     [&](const std::string& policy) {
+                       context.shared_memory.numa_placement = numaPlacementPolicyFromString(policy);
+                     })->default_value("interleaved"),
+             "Placement of memory allocations on NUMA nodes:\n"
+             "- interleaved: All allocations are interleaved across the used NUMA nodes\n"
+             "- node_id_ranges: Large arrays (hypergraph, pin counts, connectivity sets, gain cache, ...) are split\n"
+             "  into consecutive ID ranges, each bound to one used NUMA node proportional to its number of threads.\n"
+             "  All other allocations are placed on the NUMA node of the allocating thread.")
+            ("s-thread-placement",
+             po::value<std::string>()->value_name("<string>")->notifier(
+                     [&](const std::string& policy) {
+                       context.shared_memory.thread_placement = threadPlacementPolicyFromString(policy);
+                     })->default_value("physical_cores_first"),
+             "Placement of the threads on the CPUs:\n"
+             "- physical_cores_first: One thread per physical core (NUMA node by NUMA node), hyperthreads are\n"
+             "  only used if there are more threads than physical cores\n"
+             "- compact: Fills the physical cores and then the hyperthreads of a NUMA node before the next one\n"
+             "- scatter: Distributes the threads round-robin across the NUMA nodes (sockets)\n"
+             "- physical_cores_only: Never uses hyperthreads (limits the number of threads to the number of physical cores)\n"
+             "- smt_for_memory_bound_phases: Uses all threads (including hyperthreads) only in memory-bound phases\n"
+             "  (FM, contraction), all other phases use one thread per physical core")
+            ("s-fm-threads",
+             po::value<size_t>(&context.shared_memory.fm_num_threads)->value_name("<size_t>"),
+             "Number of threads used by FM refinement (0 = all threads)")
+            ("s-contraction-threads",
+             po::value<size_t>(&context.shared_memory.contraction_num_threads)->value_name("<size_t>"),
+             "Number of threads used for contracting the hypergraph during coarsening (0 = all threads)")
+            ("s-use-huge-pages",
+             po::value<bool>(&context.shared_memory.use_huge_pages)->value_name("<bool>"),
+             "If true, memory chunks of the memory pool and large arrays are allocated via mmap and backed by\n"
+             "transparent huge pages (madvise(MADV_HUGEPAGE)), which reduces TLB misses on large inputs.\n"
+             "Requires that transparent huge pages are enabled in 'madvise' or 'always' mode.")
+            ("s-release-memory-between-phases",
+             po::value<bool>(&context.shared_memory.release_memory_between_phases)->value_name("<bool>")->default_value(true),
+             "If true, memory freed by phase-local data structures (e.g., the community detection graph,\n"
+             "the rating maps of the coarsener or the thread-local data of initial partitioning) is returned\n"
+             "to the operating system after each phase, which reduces the peak memory of later phases.")
+            ("s-elastic-num-threads",
+             po::value<bool>(&context.shared_memory.elastic_num_threads)->value_name("<bool>")->default_value(false),
+             "If true, the number of threads is adapted to the CPU quota of the cgroup of the process\n"
+             "(e.g., set by a container platform) at the beginning of coarsening, initial partitioning\n"
+             "and refinement. Without a quota, all CPUs are used. Must not be used if several partitioning\n"
+             "calls share the global thread pool concurrently.")
+            ("s-numa-aware-refinement",
+             po::value<bool>(&context.shared_memory.numa_aware_refinement)->value_name("<bool>")->default_value(false),
+             "If true, the node IDs are split into consecutive ranges, one for each used NUMA node (as with\n"
+             "--s-numa-placement=node_id_ranges). Label propagation processes the active nodes of each range in a\n"
+             "task arena pinned to the NUMA node, and FM assigns each seed node to a thread of its NUMA node.\n"
+             "Intended to be used together with --s-numa-placement=node_id_ranges.");
 
     return shared_memory_options;
   }
@@ -644,7 +1037,9 @@ namespace mt_kahypar {
              "Partitioning mode: \n"
              " - direct: direct k-way partitioning\n"
              " - rb: recursive bipartitioning\n"
-             " - deep: deep multilevel partitioning"
+             " - deep: deep multilevel partitioning\n"
+             " - streaming: one-pass buffered streaming (lower quality, no hierarchy)\n"
+             " - multisection: partitions into k1 blocks and then each block into k / k1 blocks (for large k)"
              );
 
     po::options_description preset_options("Preset Options", num_columns);
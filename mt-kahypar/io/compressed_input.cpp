@@ -0,0 +1,176 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "compressed_input.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef KAHYPAR_ENABLE_COMPRESSED_INPUT
+#include <zlib.h>
+#endif
+
+#include "tbb/parallel_for.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+
+namespace mt_kahypar::io {
+
+namespace {
+  // ! Size of the fixed part of a gzip header and of the gzip footer (CRC32 + ISIZE)
+  static constexpr size_t GZIP_HEADER_SIZE = 12;
+  static constexpr size_t GZIP_FOOTER_SIZE = 8;
+  // ! Zero padding behind the decompressed data
+  static constexpr size_t PADDING = 16;
+
+  uint32_t readLittleEndian(const char* data, const size_t num_bytes) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    uint32_t value = 0;
+    for ( size_t i = 0; i < num_bytes; ++i ) {
+      value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+  }
+
+  // ! Returns the size of the BGZF block starting at pos (0, if there is no valid
+  // ! BGZF header at pos). The BGZF header is a gzip header with the extra
+  // ! subfield 'BC' that stores the total block size minus one.
+  size_t bgzfBlockSize(const char* data,
+                       const size_t pos,
+                       const size_t length,
+                       size_t& header_size) {
+    if ( pos + GZIP_HEADER_SIZE > length ) {
+      return 0;
+    }
+    const uint8_t* header = reinterpret_cast<const uint8_t*>(data + pos);
+    if ( header[0] != 31 || header[1] != 139 || header[2] != 8 || !(header[3] & 4) ) {
+      return 0;
+    }
+    const size_t extra_length = readLittleEndian(data + pos + 10, 2);
+    if ( pos + GZIP_HEADER_SIZE + extra_length > length ) {
+      return 0;
+    }
+    const char* extra = data + pos + GZIP_HEADER_SIZE;
+    for ( size_t i = 0; i + 4 <= extra_length; ) {
+      const size_t subfield_length = readLittleEndian(extra + i + 2, 2);
+      if ( i + 4 + subfield_length > extra_length ) {
+        break;
+      }
+      if ( extra[i] == 'B' && extra[i + 1] == 'C' && subfield_length == 2 ) {
+        header_size = GZIP_HEADER_SIZE + extra_length;
+        return readLittleEndian(extra + i + 4, 2) + 1;
+      }
+      i += 4 + subfield_length;
+    }
+    return 0;
+  }
+}
+
+bool isBGZFCompressed(const char* data, const size_t length) {
+  size_t header_size = 0;
+  return bgzfBlockSize(data, 0, length, header_size) > 0;
+}
+
+#ifdef KAHYPAR_ENABLE_COMPRESSED_INPUT
+char* decompressBGZF(const char* data, const size_t length, size_t& decompressed_length) {
+  struct Block {
+    size_t compressed_offset;
+    size_t compressed_size;
+    size_t decompressed_offset;
+    size_t decompressed_size;
+    uint32_t crc;
+  };
+
+  // Locate all blocks. This only touches the block headers and
+  // footers, which is cheap compared to the decompression.
+  vec<Block> blocks;
+  decompressed_length = 0;
+  size_t pos = 0;
+  while ( pos < length ) {
+    size_t header_size = 0;
+    const size_t block_size = bgzfBlockSize(data, pos, length, header_size);
+    if ( block_size < header_size + GZIP_FOOTER_SIZE || pos + block_size > length ) {
+      ERR("Invalid or truncated BGZF block at byte" << pos);
+    }
+    const char* footer = data + pos + block_size - GZIP_FOOTER_SIZE;
+    const size_t decompressed_size = readLittleEndian(footer + 4, 4);
+    blocks.push_back(Block { pos + header_size, block_size - header_size - GZIP_FOOTER_SIZE,
+      decompressed_length, decompressed_size, readLittleEndian(footer, 4) });
+    decompressed_length += decompressed_size;
+    pos += block_size;
+  }
+
+  char* decompressed_data = static_cast<char*>(std::malloc(decompressed_length + PADDING));
+  if ( decompressed_data == nullptr ) {
+    throw std::bad_alloc();
+  }
+  std::memset(decompressed_data + decompressed_length, 0, PADDING);
+
+  std::atomic<bool> success(true);
+  tbb::parallel_for(UL(0), blocks.size(), [&](const size_t i) {
+    const Block& block = blocks[i];
+    if ( block.decompressed_size == 0 ) {
+      // Empty block (e.g., the EOF marker of bgzip)
+      return;
+    }
+    Bytef* out = reinterpret_cast<Bytef*>(decompressed_data + block.decompressed_offset);
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(z_stream));
+    // Negative window bits => raw deflate stream without gzip header
+    if ( inflateInit2(&stream, -MAX_WBITS) != Z_OK ) {
+      success = false;
+      return;
+    }
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data + block.compressed_offset));
+    stream.avail_in = block.compressed_size;
+    stream.next_out = out;
+    stream.avail_out = block.decompressed_size;
+    const int res = inflate(&stream, Z_FINISH);
+    if ( res != Z_STREAM_END || stream.total_out != block.decompressed_size ||
+         crc32(0, out, block.decompressed_size) != block.crc ) {
+      success = false;
+    }
+    inflateEnd(&stream);
+  });
+
+  if ( !success ) {
+    std::free(decompressed_data);
+    ERR("Corrupted BGZF block in compressed input file");
+  }
+  return decompressed_data;
+}
+#else
+char* decompressBGZF(const char*, const size_t, size_t&) {
+  ERR("Compressed input files are not supported (compile with -DKAHYPAR_ENABLE_COMPRESSED_INPUT=ON)");
+  return nullptr;
+}
+#endif
+
+}  // namespace mt_kahypar::io
@@ -0,0 +1,44 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+namespace mt_kahypar::io {
+
+// ! Returns true, if the data starts with a BGZF block. BGZF (the output format of bgzip)
+// ! is a sequence of independent gzip members that store their compressed size in the
+// ! header, which allows us to locate and decompress all blocks in parallel.
+bool isBGZFCompressed(const char* data, const size_t length);
+
+// ! Decompresses a BGZF compressed file in parallel. The returned buffer contains
+// ! decompressed_length characters followed by zero padding (such that parsers can
+// ! look ahead) and must be released with std::free. Requires compilation with
+// ! KAHYPAR_ENABLE_COMPRESSED_INPUT.
+char* decompressBGZF(const char* data, const size_t length, size_t& decompressed_length);
+
+}  // namespace mt_kahypar::io
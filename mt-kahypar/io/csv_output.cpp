@@ -38,7 +38,10 @@ namespace mt_kahypar::io::csv {
 
   std::string header() {
     return "algorithm,threads,graph,k,seed,epsilon,imbalance,"
-           "objective,km1,cut,initial_km1,partitionTime,fmTime,lpTime,coarseningTime,ipTime,preprocessingTime"
+           "objective,km1,cut,initial_km1,partitionTime,fmTime,lpTime,coarseningTime,ipTime,preprocessingTime,"
+           "coarseningCycles,coarseningLLCMisses,coarseningBranchMisses,coarseningRemoteNUMAAccesses,"
+           "ipCycles,ipLLCMisses,ipBranchMisses,ipRemoteNUMAAccesses,"
+           "refinementCycles,refinementLLCMisses,refinementBranchMisses,refinementRemoteNUMAAccesses"
            "\n";
   }
 
@@ -77,7 +80,21 @@ namespace mt_kahypar::io::csv {
     s << (timer.get("label_propagation") + timer.get("initialize_lp_refiner")) << sep;
     s << timer.get("coarsening") << sep;
     s << timer.get("initial_partitioning") << sep;
-    s << timer.get("preprocessing");
+    s << timer.get("preprocessing") << sep;
+
+    // Hardware counters (zero, if not measured)
+    auto print_counters = [&](const std::string& key, const bool last) {
+      const utils::HardwareCounterValues counters = timer.get_counters(key);
+      for ( size_t i = 0; i < utils::NUM_HARDWARE_COUNTERS; ++i ) {
+        s << counters.values[i];
+        if ( !last || i + 1 < utils::NUM_HARDWARE_COUNTERS ) {
+          s << sep;
+        }
+      }
+    };
+    print_counters("coarsening", false);
+    print_counters("initial_partitioning", false);
+    print_counters("refinement", true);
 
     return s.str();
   }
@@ -27,6 +27,10 @@
 
 #include "hypergraph_io.h"
 
+#include <atomic>
+#include <cstdio>
+#include <cerrno>
+#include <cstdlib>
 #include <cstring>
 #include <fstream>
 #include <iostream>
@@ -47,6 +51,12 @@
 
 
 #include "tbb/parallel_for.h"
+#include "tbb/parallel_scan.h"
+#include "tbb/enumerable_thread_specific.h"
+#include "mt-kahypar/io/compressed_input.h"
+#include "mt-kahypar/io/number_parsing.h"
+#include "mt-kahypar/parallel/chunking.h"
+#include "mt-kahypar/parallel/parallel_prefix_sum.h"
 #include "mt-kahypar/partition/context_enum_classes.h"
 #include "mt-kahypar/utils/timer.h"
 
@@ -57,6 +67,8 @@ namespace mt_kahypar::io {
     int fd;
     char* mapped_file;
     size_t length;
+    // ! True, if mapped_file is a buffer that contains the decompressed file
+    bool is_decompressed = false;
 
     void closeHandle() {
       close(fd);
@@ -68,6 +80,8 @@ namespace mt_kahypar::io {
     HANDLE hMem;
     char* mapped_file;
     size_t length;
+    // ! True, if mapped_file is a buffer that contains the decompressed file
+    bool is_decompressed = false;
 
     void closeHandle() {
       CloseHandle(hFile);
@@ -85,7 +99,9 @@ namespace mt_kahypar::io {
     return static_cast<size_t>(stat_buf.st_size);
   }
 
-  FileHandle mmap_file(const std::string& filename) {
+  // ! If copy_on_write is set, the mapping is private and writable, which means that
+  // ! modifications are not written back to the file.
+  FileHandle mmap_file(const std::string& filename, const bool copy_on_write = false) {
     FileHandle handle;
     handle.length = file_size(filename);
 
@@ -116,14 +132,16 @@ namespace mt_kahypar::io {
       }
 
       // Create file mapping
-      handle.hMem = CreateFileMapping( handle.hFile, &sa, PAGE_READONLY, 0, handle.length, NULL);
+      handle.hMem = CreateFileMapping( handle.hFile, &sa,
+        copy_on_write ? PAGE_WRITECOPY : PAGE_READONLY, 0, handle.length, NULL);
       free(pSD);
       if (handle.hMem == NULL) {
         ERR("Invalid file mapping when opening:" << filename);
       }
 
       // map file to memory
-      handle.mapped_file = (char*) MapViewOfFile(handle.hMem, FILE_MAP_READ, 0, 0, 0);
+      handle.mapped_file = (char*) MapViewOfFile(handle.hMem,
+        copy_on_write ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
       if ( handle.mapped_file == NULL ) {
         ERR("Failed to map file to main memory:" << filename);
       }
@@ -132,7 +150,9 @@ namespace mt_kahypar::io {
       if ( handle.fd < -1 ) {
         ERR("Could not open:" << filename);
       }
-      handle.mapped_file = (char*) mmap(0, handle.length, PROT_READ, MAP_SHARED, handle.fd, 0);
+      handle.mapped_file = copy_on_write ?
+        (char*) mmap(0, handle.length, PROT_READ | PROT_WRITE, MAP_PRIVATE, handle.fd, 0) :
+        (char*) mmap(0, handle.length, PROT_READ, MAP_SHARED, handle.fd, 0);
       if ( handle.mapped_file == MAP_FAILED ) {
         close(handle.fd);
         ERR("Error while mapping file to memory");
@@ -143,6 +163,10 @@ namespace mt_kahypar::io {
   }
 
   void munmap_file(FileHandle& handle) {
+    if ( handle.is_decompressed ) {
+      std::free(handle.mapped_file);
+      return;
+    }
     #ifdef _WIN32
     UnmapViewOfFile(handle.mapped_file);
     #elif __linux__
@@ -151,12 +175,22 @@ namespace mt_kahypar::io {
     handle.closeHandle();
   }
 
-
-  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
-  bool is_line_ending(char* mapped_file, size_t pos) {
-    return mapped_file[pos] == '\r' || mapped_file[pos] == '\n' || mapped_file[pos] == '\0';
+  // ! Maps the input file to memory. BGZF compressed files (bgzip) are
+  // ! detected by their header and decompressed in parallel into a buffer.
+  FileHandle open_input_file(const std::string& filename) {
+    FileHandle handle = mmap_file(filename);
+    if ( isBGZFCompressed(handle.mapped_file, handle.length) ) {
+      size_t length = 0;
+      char* decompressed_file = decompressBGZF(handle.mapped_file, handle.length, length);
+      munmap_file(handle);
+      handle.mapped_file = decompressed_file;
+      handle.length = length;
+      handle.is_decompressed = true;
+    }
+    return handle;
   }
 
+
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
   void do_line_ending(char* mapped_file, size_t& pos) {
     ASSERT(is_line_ending(mapped_file, pos));
@@ -179,25 +213,6 @@ namespace mt_kahypar::io {
     }
   }
 
-  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
-  int64_t read_number(char* mapped_file, size_t& pos, const size_t length) {
-    int64_t number = 0;
-    while ( mapped_file[pos] == ' ' ) {
-      ++pos;
-    }
-    for ( ; pos < length; ++pos ) {
-      if ( mapped_file[pos] == ' ' || is_line_ending(mapped_file, pos) ) {
-        while ( mapped_file[pos] == ' ' ) {
-          ++pos;
-        }
-        break;
-      }
-      ASSERT(mapped_file[pos] >= '0' && mapped_file[pos] <= '9');
-      number = number * 10 + (mapped_file[pos] - '0');
-    }
-    return number;
-  }
-
   void readHGRHeader(char* mapped_file,
                      size_t& pos,
                      const size_t length,
@@ -254,6 +269,119 @@ namespace mt_kahypar::io {
     size_t num_hes_with_duplicated_pins;
   };
 
+  parallel::scalable_vector<HyperedgeRange> computeHyperedgeRanges(char* mapped_file,
+                                                                    size_t& pos,
+                                                                    const size_t length,
+                                                                    const HyperedgeID num_hyperedges,
+                                                                    const bool has_hyperedge_weights,
+                                                                    const bool remove_single_pin_hes,
+                                                                    HyperedgeReadResult& res) {
+    // Sequential pass over all hyperedges to determine ranges in the
+    // input file that are read in parallel.
+    parallel::scalable_vector<HyperedgeRange> hyperedge_ranges;
+    size_t current_range_start = pos;
+    HyperedgeID current_range_start_id = 0;
+    HyperedgeID current_range_num_hyperedges = 0;
+    HyperedgeID current_num_hyperedges = 0;
+    const HyperedgeID num_hyperedges_per_range = std::max(
+            (num_hyperedges / ( 2 * std::thread::hardware_concurrency())), ID(1));
+    while ( current_num_hyperedges < num_hyperedges ) {
+      // Skip Comments
+      ASSERT(pos < length);
+      while ( mapped_file[pos] == '%' ) {
+        goto_next_line(mapped_file, pos, length);
+        ASSERT(pos < length);
+      }
+
+      // This check is fine even with windows line endings!
+      ASSERT(mapped_file[pos - 1] == '\n');
+      if ( !remove_single_pin_hes || !isSinglePinHyperedge(mapped_file, pos, length, has_hyperedge_weights) ) {
+        ++current_range_num_hyperedges;
+      } else {
+        ++res.num_removed_single_pin_hyperedges;
+      }
+      ++current_num_hyperedges;
+      goto_next_line(mapped_file, pos, length);
+
+      // If there are enough hyperedges in the current scanned range
+      // we store that range, which will be later processed in parallel
+      if ( current_range_num_hyperedges == num_hyperedges_per_range ) {
+        hyperedge_ranges.push_back(HyperedgeRange {
+                current_range_start, pos, current_range_start_id, current_range_num_hyperedges});
+        current_range_start = pos;
+        current_range_start_id += current_range_num_hyperedges;
+        current_range_num_hyperedges = 0;
+      }
+    }
+    if ( current_range_num_hyperedges > 0 ) {
+      hyperedge_ranges.push_back(HyperedgeRange {
+              current_range_start, pos, current_range_start_id, current_range_num_hyperedges});
+    }
+    return hyperedge_ranges;
+  }
+
+  // ! Calls f(id, pos, end) for each (not removed) hyperedge in the range, where
+  // ! pos points to the beginning of its line. f must consume the line including
+  // ! its line ending.
+  template<typename F>
+  void forEachHyperedgeInRange(char* mapped_file,
+                               const HyperedgeRange& range,
+                               const bool has_hyperedge_weights,
+                               const bool remove_single_pin_hes,
+                               const F& f) {
+    size_t current_pos = range.start;
+    const size_t current_end = range.end;
+    HyperedgeID current_id = range.start_id;
+    const HyperedgeID last_id = current_id + range.num_hyperedges;
+
+    while ( current_id < last_id ) {
+      // Skip Comments
+      ASSERT(current_pos < current_end);
+      while ( mapped_file[current_pos] == '%' ) {
+        goto_next_line(mapped_file, current_pos, current_end);
+        ASSERT(current_pos < current_end);
+      }
+
+      if ( !remove_single_pin_hes || !isSinglePinHyperedge(mapped_file, current_pos, current_end, has_hyperedge_weights) ) {
+        f(current_id, current_pos, current_end);
+        ++current_id;
+      } else {
+        goto_next_line(mapped_file, current_pos, current_end);
+      }
+    }
+  }
+
+  // ! Reads the pins of the hyperedge line at the current position and removes
+  // ! duplicated pins. Returns the number of removed pins.
+  size_t readPins(char* mapped_file,
+                  size_t& pos,
+                  const size_t end,
+                  Hyperedge& hyperedge) {
+    // Note, a hyperedge line must contain at least one pin
+    HypernodeID pin = read_number(mapped_file, pos, end);
+    ASSERT(pin > 0);
+    hyperedge.push_back(pin - 1);
+    while ( !is_line_ending(mapped_file, pos) ) {
+      pin = read_number(mapped_file, pos, end);
+      ASSERT(pin > 0);
+      hyperedge.push_back(pin - 1);
+    }
+    do_line_ending(mapped_file, pos);
+
+    // Detect duplicated pins
+    std::sort(hyperedge.begin(), hyperedge.end());
+    size_t j = 1;
+    for ( size_t i = 1; i < hyperedge.size(); ++i ) {
+      if ( hyperedge[j - 1] != hyperedge[i] ) {
+        std::swap(hyperedge[i], hyperedge[j++]);
+      }
+    }
+    const size_t num_duplicated_pins = hyperedge.size() - j;
+    // Remove duplicated pins
+    hyperedge.resize(j);
+    return num_duplicated_pins;
+  }
+
   HyperedgeReadResult readHyperedges(char* mapped_file,
                                      size_t& pos,
                                      const size_t length,
@@ -269,46 +397,8 @@ namespace mt_kahypar::io {
 
     parallel::scalable_vector<HyperedgeRange> hyperedge_ranges;
     tbb::parallel_invoke([&] {
-      // Sequential pass over all hyperedges to determine ranges in the
-      // input file that are read in parallel.
-      size_t current_range_start = pos;
-      HyperedgeID current_range_start_id = 0;
-      HyperedgeID current_range_num_hyperedges = 0;
-      HyperedgeID current_num_hyperedges = 0;
-      const HyperedgeID num_hyperedges_per_range = std::max(
-              (num_hyperedges / ( 2 * std::thread::hardware_concurrency())), ID(1));
-      while ( current_num_hyperedges < num_hyperedges ) {
-        // Skip Comments
-        ASSERT(pos < length);
-        while ( mapped_file[pos] == '%' ) {
-          goto_next_line(mapped_file, pos, length);
-          ASSERT(pos < length);
-        }
-
-        // This check is fine even with windows line endings!
-        ASSERT(mapped_file[pos - 1] == '\n');
-        if ( !remove_single_pin_hes || !isSinglePinHyperedge(mapped_file, pos, length, has_hyperedge_weights) ) {
-          ++current_range_num_hyperedges;
-        } else {
-          ++res.num_removed_single_pin_hyperedges;
-        }
-        ++current_num_hyperedges;
-        goto_next_line(mapped_file, pos, length);
-
-        // If there are enough hyperedges in the current scanned range
-        // we store that range, which will be later processed in parallel
-        if ( current_range_num_hyperedges == num_hyperedges_per_range ) {
-          hyperedge_ranges.push_back(HyperedgeRange {
-                  current_range_start, pos, current_range_start_id, current_range_num_hyperedges});
-          current_range_start = pos;
-          current_range_start_id += current_range_num_hyperedges;
-          current_range_num_hyperedges = 0;
-        }
-      }
-      if ( current_range_num_hyperedges > 0 ) {
-        hyperedge_ranges.push_back(HyperedgeRange {
-                current_range_start, pos, current_range_start_id, current_range_num_hyperedges});
-      }
+      hyperedge_ranges = computeHyperedgeRanges(mapped_file, pos, length,
+        num_hyperedges, has_hyperedge_weights, remove_single_pin_hes, res);
     }, [&] {
       hyperedges.resize(num_hyperedges);
     }, [&] {
@@ -325,61 +415,21 @@ namespace mt_kahypar::io {
 
     // Process all ranges in parallel and build hyperedge vector
     tbb::parallel_for(UL(0), hyperedge_ranges.size(), [&](const size_t i) {
-      HyperedgeRange& range = hyperedge_ranges[i];
-      size_t current_pos = range.start;
-      const size_t current_end = range.end;
-      HyperedgeID current_id = range.start_id;
-      const HyperedgeID last_id = current_id + range.num_hyperedges;
-
-      while ( current_id < last_id ) {
-        // Skip Comments
-        ASSERT(current_pos < current_end);
-        while ( mapped_file[current_pos] == '%' ) {
-          goto_next_line(mapped_file, current_pos, current_end);
-          ASSERT(current_pos < current_end);
-        }
-
-        if ( !remove_single_pin_hes || !isSinglePinHyperedge(mapped_file, current_pos, current_end, has_hyperedge_weights) ) {
+      forEachHyperedgeInRange(mapped_file, hyperedge_ranges[i], has_hyperedge_weights,
+        remove_single_pin_hes, [&](const HyperedgeID current_id, size_t& current_pos, const size_t current_end) {
           ASSERT(current_id < hyperedges.size());
           if ( has_hyperedge_weights ) {
             hyperedges_weight[current_id] = read_number(mapped_file, current_pos, current_end);
           }
 
           Hyperedge& hyperedge = hyperedges[current_id];
-          // Note, a hyperedge line must contain at least one pin
-          HypernodeID pin = read_number(mapped_file, current_pos, current_end);
-          ASSERT(pin > 0, V(current_id));
-          hyperedge.push_back(pin - 1);
-          while ( !is_line_ending(mapped_file, current_pos) ) {
-            pin = read_number(mapped_file, current_pos, current_end);
-            ASSERT(pin > 0, V(current_id));
-            hyperedge.push_back(pin - 1);
-          }
-          do_line_ending(mapped_file, current_pos);
-
-          // Detect duplicated pins
-          std::sort(hyperedge.begin(), hyperedge.end());
-          size_t j = 1;
-          for ( size_t i = 1; i < hyperedge.size(); ++i ) {
-            if ( hyperedge[j - 1] != hyperedge[i] ) {
-              std::swap(hyperedge[i], hyperedge[j++]);
-            }
-          }
-          if ( j < hyperedge.size() ) {
-            // Remove duplicated pins
+          const size_t num_duplicated_pins = readPins(mapped_file, current_pos, current_end, hyperedge);
+          if ( num_duplicated_pins > 0 ) {
             __atomic_fetch_add(&res.num_hes_with_duplicated_pins, 1, __ATOMIC_RELAXED);
-            __atomic_fetch_add(&res.num_duplicated_pins, hyperedge.size() - j, __ATOMIC_RELAXED);
-            for ( size_t i = j; i < hyperedge.size(); ++i ) {
-              hyperedge.pop_back();
-            }
+            __atomic_fetch_add(&res.num_duplicated_pins, num_duplicated_pins, __ATOMIC_RELAXED);
           }
-
           ASSERT(hyperedge.size() >= 2);
-          ++current_id;
-        } else {
-          goto_next_line(mapped_file, current_pos, current_end);
-        }
-      }
+        });
     });
     return res;
   }
@@ -393,6 +443,8 @@ namespace mt_kahypar::io {
     bool has_hypernode_weights = type == mt_kahypar::Type::NodeWeights ||
                                  type == mt_kahypar::Type::EdgeAndNodeWeights ?
                                  true : false;
+    // Unweighted inputs do not allocate a weight array. The hypergraph factories
+    // then keep the unit weights stored in the vertex and net structs.
     if ( has_hypernode_weights ) {
       hypernodes_weight.resize(num_hypernodes);
       for ( HypernodeID hn = 0; hn < num_hypernodes; ++hn ) {
@@ -414,7 +466,7 @@ namespace mt_kahypar::io {
                           parallel::scalable_vector<HypernodeWeight>& hypernodes_weight,
                           const bool remove_single_pin_hes) {
     ASSERT(!filename.empty(), "No filename for hypergraph file specified");
-    FileHandle handle = mmap_file(filename);
+    FileHandle handle = open_input_file(filename);
     size_t pos = 0;
 
     // Read Hypergraph Header
@@ -440,9 +492,120 @@ namespace mt_kahypar::io {
     munmap_file(handle);
   }
 
+  #if !defined(USE_GRAPH_PARTITIONER) && !defined(USE_STRONG_PARTITIONER)
+  // ! Reads the hypergraph directly into the incidence array of the static hypergraph
+  // ! without materializing an intermediate edge vector. Therefore, the hyperedges are
+  // ! parsed twice: the first pass determines the hyperedge sizes and the second pass
+  // ! writes the pins to their final position.
+  Hypergraph readStaticHypergraphFile(const std::string& filename,
+                                      const bool stable_construction_of_incident_edges,
+                                      const bool remove_single_pin_hes) {
+    ASSERT(!filename.empty(), "No filename for hypergraph file specified");
+    FileHandle handle = open_input_file(filename);
+    char* mapped_file = handle.mapped_file;
+    size_t pos = 0;
+
+    // Read Hypergraph Header
+    HyperedgeID num_hyperedges = 0;
+    HypernodeID num_hypernodes = 0;
+    mt_kahypar::Type type = mt_kahypar::Type::Unweighted;
+    readHGRHeader(mapped_file, pos, handle.length, num_hyperedges, num_hypernodes, type);
+    const bool has_hyperedge_weights = type == mt_kahypar::Type::EdgeWeights ||
+                                       type == mt_kahypar::Type::EdgeAndNodeWeights ?
+                                       true : false;
+
+    HyperedgeReadResult res;
+    parallel::scalable_vector<HyperedgeRange> hyperedge_ranges;
+    parallel::scalable_vector<size_t> hyperedge_sizes;
+    parallel::scalable_vector<HyperedgeWeight> hyperedges_weight;
+    tbb::parallel_invoke([&] {
+      hyperedge_ranges = computeHyperedgeRanges(mapped_file, pos, handle.length,
+        num_hyperedges, has_hyperedge_weights, remove_single_pin_hes, res);
+    }, [&] {
+      hyperedge_sizes.resize(num_hyperedges);
+    }, [&] {
+      if ( has_hyperedge_weights ) {
+        hyperedges_weight.resize(num_hyperedges);
+      }
+    });
+    num_hyperedges -= res.num_removed_single_pin_hyperedges;
+    hyperedge_sizes.resize(num_hyperedges);
+    if ( has_hyperedge_weights ) {
+      hyperedges_weight.resize(num_hyperedges);
+    }
+
+    // First pass determines the size of each hyperedge (after removing duplicated pins)
+    tbb::enumerable_thread_specific<Hyperedge> local_hyperedge;
+    tbb::parallel_for(UL(0), hyperedge_ranges.size(), [&](const size_t i) {
+      Hyperedge& hyperedge = local_hyperedge.local();
+      forEachHyperedgeInRange(mapped_file, hyperedge_ranges[i], has_hyperedge_weights,
+        remove_single_pin_hes, [&](const HyperedgeID current_id, size_t& current_pos, const size_t current_end) {
+          ASSERT(current_id < num_hyperedges);
+          if ( has_hyperedge_weights ) {
+            hyperedges_weight[current_id] = read_number(mapped_file, current_pos, current_end);
+          }
+          hyperedge.clear();
+          const size_t num_duplicated_pins = readPins(mapped_file, current_pos, current_end, hyperedge);
+          if ( num_duplicated_pins > 0 ) {
+            __atomic_fetch_add(&res.num_hes_with_duplicated_pins, 1, __ATOMIC_RELAXED);
+            __atomic_fetch_add(&res.num_duplicated_pins, num_duplicated_pins, __ATOMIC_RELAXED);
+          }
+          hyperedge_sizes[current_id] = hyperedge.size();
+        });
+    });
+
+    parallel::scalable_vector<size_t> pin_offsets(num_hyperedges + 1, 0);
+    parallel_prefix_sum(hyperedge_sizes.cbegin(), hyperedge_sizes.cend(),
+      pin_offsets.begin() + 1, std::plus<size_t>(), UL(0));
+    parallel::free(hyperedge_sizes);
+
+    // Second pass writes the pins of each hyperedge to its final position
+    ds::Array<HypernodeID> incidence_array;
+    incidence_array.resize(pin_offsets.back());
+    tbb::parallel_for(UL(0), hyperedge_ranges.size(), [&](const size_t i) {
+      Hyperedge& hyperedge = local_hyperedge.local();
+      forEachHyperedgeInRange(mapped_file, hyperedge_ranges[i], has_hyperedge_weights,
+        remove_single_pin_hes, [&](const HyperedgeID current_id, size_t& current_pos, const size_t current_end) {
+          if ( has_hyperedge_weights ) {
+            read_number(mapped_file, current_pos, current_end);
+          }
+          hyperedge.clear();
+          readPins(mapped_file, current_pos, current_end, hyperedge);
+          ASSERT(pin_offsets[current_id] + hyperedge.size() == pin_offsets[current_id + 1]);
+          std::copy(hyperedge.cbegin(), hyperedge.cend(), incidence_array.begin() + pin_offsets[current_id]);
+        });
+    });
+    parallel::free(hyperedge_ranges);
+    local_hyperedge.clear();
+
+    if ( res.num_hes_with_duplicated_pins > 0 ) {
+      WARNING("Removed" << res.num_duplicated_pins << "duplicated pins in"
+        << res.num_hes_with_duplicated_pins << "hyperedges!");
+    }
+
+    // Read Hypernode Weights
+    parallel::scalable_vector<HypernodeWeight> hypernodes_weight;
+    readHypernodeWeights(mapped_file, pos, handle.length, num_hypernodes, type, hypernodes_weight);
+    ASSERT(pos == handle.length);
+    munmap_file(handle);
+
+    // Construct Hypergraph
+    Hypergraph hypergraph = HypergraphFactory::construct_from_incidence_array(
+      num_hypernodes, num_hyperedges, pin_offsets, std::move(incidence_array),
+      hyperedges_weight.data(), hypernodes_weight.data(),
+      stable_construction_of_incident_edges);
+    hypergraph.setNumRemovedHyperedges(res.num_removed_single_pin_hyperedges);
+    return hypergraph;
+  }
+  #endif
+
   Hypergraph readHypergraphFile(const std::string& filename,
                                 const bool stable_construction_of_incident_edges,
                                 const bool remove_single_pin_hes) {
+    #if !defined(USE_GRAPH_PARTITIONER) && !defined(USE_STRONG_PARTITIONER)
+    return readStaticHypergraphFile(filename,
+      stable_construction_of_incident_edges, remove_single_pin_hes);
+    #else
     // Read Hypergraph File
     HyperedgeID num_hyperedges = 0;
     HypernodeID num_hypernodes = 0;
@@ -461,37 +624,351 @@ namespace mt_kahypar::io {
       stable_construction_of_incident_edges);
     hypergraph.setNumRemovedHyperedges(num_removed_single_pin_hyperedges);
     return hypergraph;
+    #endif
+  }
+
+  namespace {
+    // ! Header of a binary partition file. The header is followed
+    // ! by the block IDs of all vertices (int32 array).
+    struct PartitionFileHeader {
+      static constexpr uint64_t MAGIC = 0x4d544b4850415231; // "MTKHPAR1"
+      uint64_t magic;
+      uint64_t num_nodes;
+    };
+
+    // ! Number of vertices formatted by one task of the partition writer
+    static constexpr size_t PARTITION_WRITER_CHUNK_SIZE = UL(1) << 16;
+
+    // ! Number of characters of a line in a text partition file (including the newline)
+    size_t partitionFileLineLength(const PartitionID block) {
+      size_t length = block < 0 ? 2 : 1;
+      uint64_t value = block < 0 ? -static_cast<int64_t>(block) : block;
+      do {
+        ++length;
+        value /= 10;
+      } while ( value > 0 );
+      return length;
+    }
+
+    // ! Writes the line of the block to out and returns a pointer behind the line
+    char* formatPartitionFileLine(const PartitionID block, char* out) {
+      char* end = out + partitionFileLineLength(block);
+      char* pos = end - 1;
+      *pos = '\n';
+      uint64_t value = block < 0 ? -static_cast<int64_t>(block) : block;
+      do {
+        *(--pos) = '0' + value % 10;
+        value /= 10;
+      } while ( value > 0 );
+      if ( block < 0 ) {
+        *(--pos) = '-';
+      }
+      return end;
+    }
+
+    // ! Writes a file that consists of num_chunks consecutive chunks, where chunk i starts at
+    // ! byte chunk_offsets[i]. The chunks are formatted in parallel into thread-local buffers
+    // ! via format_chunk(i, buffer) and written with one positioned write per chunk.
+    template<typename F>
+    void writeChunksInParallel(const std::string& filename,
+                               const vec<size_t>& chunk_offsets,
+                               const F& format_chunk) {
+      ASSERT(!chunk_offsets.empty());
+      const size_t num_chunks = chunk_offsets.size() - 1;
+      #ifdef __linux__
+      tbb::enumerable_thread_specific<vec<char>> ets_buffer;
+      const int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if ( fd < 0 ) {
+        ERR("Could not open:" << filename);
+      }
+      std::atomic<bool> success(true);
+      tbb::parallel_for(UL(0), num_chunks, [&](const size_t chunk) {
+        vec<char>& buffer = ets_buffer.local();
+        buffer.resize(chunk_offsets[chunk + 1] - chunk_offsets[chunk]);
+        format_chunk(chunk, buffer.data());
+        size_t written = 0;
+        while ( written < buffer.size() ) {
+          const ssize_t res = pwrite(fd, buffer.data() + written,
+            buffer.size() - written, chunk_offsets[chunk] + written);
+          if ( res <= 0 ) {
+            success = false;
+            break;
+          }
+          written += res;
+        }
+      });
+      close(fd);
+      if ( !success ) {
+        ERR("Error while writing to" << filename);
+      }
+      #else
+      // Chunks are formatted in parallel and written sequentially
+      std::ofstream out_stream(filename.c_str(), std::ios::binary);
+      if ( !out_stream ) {
+        ERR("Could not open:" << filename);
+      }
+      vec<vec<char>> buffers(num_chunks);
+      tbb::parallel_for(UL(0), num_chunks, [&](const size_t chunk) {
+        buffers[chunk].resize(chunk_offsets[chunk + 1] - chunk_offsets[chunk]);
+        format_chunk(chunk, buffers[chunk].data());
+      });
+      for ( const vec<char>& buffer : buffers ) {
+        out_stream.write(buffer.data(), buffer.size());
+      }
+      if ( !out_stream ) {
+        ERR("Error while writing to" << filename);
+      }
+      #endif
+    }
+  }
+
+  namespace {
+    // ! Number of bytes of a text partition file parsed by one task
+    static constexpr size_t PARTITION_READER_CHUNK_SIZE = UL(1) << 20;
+
+    MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool isPartitionFileSeparator(const char c) {
+      return c == ' ' || c == '\n' || c == '\r';
+    }
+
+    void readBinaryPartitionFile(const char* mapped_file,
+                                 const size_t length,
+                                 const std::string& filename,
+                                 std::vector<PartitionID>& partition) {
+      PartitionFileHeader header;
+      std::memcpy(&header, mapped_file, sizeof(PartitionFileHeader));
+      if ( length < sizeof(PartitionFileHeader) + sizeof(PartitionID) * header.num_nodes ) {
+        ERR("Binary partition file" << filename << "is truncated");
+      }
+      partition.resize(header.num_nodes);
+      const char* blocks = mapped_file + sizeof(PartitionFileHeader);
+      const size_t num_chunks = parallel::chunking::idiv_ceil(
+        header.num_nodes, PARTITION_WRITER_CHUNK_SIZE);
+      tbb::parallel_for(UL(0), num_chunks, [&](const size_t chunk) {
+        const auto [first, last] = parallel::chunking::bounds(
+          chunk, header.num_nodes, PARTITION_WRITER_CHUNK_SIZE);
+        std::memcpy(partition.data() + first, blocks + sizeof(PartitionID) * first,
+          sizeof(PartitionID) * (last - first));
+      });
+    }
+
+    // ! The file is split into chunks that start at the beginning of a line. We first count
+    // ! the block IDs in each chunk, which determines the position of its first vertex in
+    // ! the partition vector, and then parse the chunks in parallel.
+    void readTextPartitionFile(const char* mapped_file,
+                               const size_t length,
+                               const std::string& filename,
+                               std::vector<PartitionID>& partition) {
+      const size_t num_chunks = parallel::chunking::idiv_ceil(length, PARTITION_READER_CHUNK_SIZE);
+      vec<size_t> chunk_begin(num_chunks + 1, length);
+      tbb::parallel_for(UL(0), num_chunks, [&](const size_t chunk) {
+        size_t pos = chunk * PARTITION_READER_CHUNK_SIZE;
+        while ( pos > 0 && pos < length && mapped_file[pos - 1] != '\n' ) {
+          ++pos;
+        }
+        chunk_begin[chunk] = pos;
+      });
+
+      vec<size_t> first_vertex_of_chunk(num_chunks + 1, 0);
+      tbb::parallel_for(UL(0), num_chunks, [&](const size_t chunk) {
+        size_t num_blocks = 0;
+        for ( size_t pos = chunk_begin[chunk]; pos < chunk_begin[chunk + 1]; ++pos ) {
+          num_blocks += !isPartitionFileSeparator(mapped_file[pos]) &&
+            ( pos == chunk_begin[chunk] || isPartitionFileSeparator(mapped_file[pos - 1]) );
+        }
+        first_vertex_of_chunk[chunk + 1] = num_blocks;
+      });
+      for ( size_t chunk = 0; chunk < num_chunks; ++chunk ) {
+        first_vertex_of_chunk[chunk + 1] += first_vertex_of_chunk[chunk];
+      }
+
+      partition.resize(first_vertex_of_chunk[num_chunks]);
+      tbb::parallel_for(UL(0), num_chunks, [&](const size_t chunk) {
+        size_t pos = chunk_begin[chunk];
+        const size_t end = chunk_begin[chunk + 1];
+        size_t hn = first_vertex_of_chunk[chunk];
+        while ( true ) {
+          while ( pos < end && isPartitionFileSeparator(mapped_file[pos]) ) {
+            ++pos;
+          }
+          if ( pos == end ) {
+            break;
+          }
+          const bool negative = mapped_file[pos] == '-';
+          pos += negative;
+          if ( pos == end || mapped_file[pos] < '0' || mapped_file[pos] > '9' ||
+               hn == first_vertex_of_chunk[chunk + 1] ) {
+            ERR("Invalid block ID of vertex" << hn << "in partition file" << filename);
+          }
+          const PartitionID block = read_number(mapped_file, pos, end);
+          if ( pos < end && !isPartitionFileSeparator(mapped_file[pos]) &&
+               !isPartitionFileSeparator(mapped_file[pos - 1]) ) {
+            ERR("Invalid block ID of vertex" << hn << "in partition file" << filename);
+          }
+          partition[hn++] = negative ? -block : block;
+        }
+        ASSERT(hn == first_vertex_of_chunk[chunk + 1]);
+      });
+    }
   }
 
   void readPartitionFile(const std::string& filename, std::vector<PartitionID>& partition) {
     ASSERT(!filename.empty(), "No filename for partition file specified");
     ASSERT(partition.empty(), "Partition vector is not empty");
+    if ( file_size(filename) == 0 ) {
+      return;
+    }
+
+    FileHandle handle = open_input_file(filename);
+    if ( handle.length >= sizeof(PartitionFileHeader) &&
+         std::memcmp(handle.mapped_file, &PartitionFileHeader::MAGIC, sizeof(uint64_t)) == 0 ) {
+      readBinaryPartitionFile(handle.mapped_file, handle.length, filename, partition);
+    } else {
+      readTextPartitionFile(handle.mapped_file, handle.length, filename, partition);
+    }
+    munmap_file(handle);
+  }
+
+  void readFixedVertexFile(const std::string& filename, Hypergraph& hypergraph) {
     std::ifstream file(filename);
-    if (file) {
-      int part;
-      while (file >> part) {
-        partition.push_back(part);
+    if ( !file ) {
+      ERR("Could not open fixed vertex file:" << filename);
+    }
+    HypernodeID hn = 0;
+    PartitionID block = kInvalidPartition;
+    while ( file >> block ) {
+      if ( hn >= hypergraph.initialNumNodes() ) {
+        ERR("Fixed vertex file" << filename << "contains more lines than the hypergraph has vertices");
       }
-      file.close();
-    } else {
-      std::cerr << "Error: File not found: " << std::endl;
+      if ( block >= 0 ) {
+        hypergraph.fixToBlock(hn, block);
+      } else if ( block != -1 ) {
+        ERR("Invalid block" << block << "for vertex" << hn << "in fixed vertex file" << filename);
+      }
+      ++hn;
+    }
+    if ( hn != hypergraph.initialNumNodes() ) {
+      ERR("Fixed vertex file" << filename << "contains" << hn << "lines, but the hypergraph has"
+        << hypergraph.initialNumNodes() << "vertices");
     }
   }
 
-  void writePartitionFile(const PartitionedHypergraph& phg, const std::string& filename) {
+  void writePartitionFile(const PartitionedHypergraph& phg,
+                          const std::string& filename,
+                          const bool binary) {
     if (filename.empty()) {
       LOG << "No filename for partition file specified";
-    } else {
-      std::ofstream out_stream(filename.c_str());
-      std::vector<PartitionID> partition(phg.initialNumNodes(), -1);
-      for (const HypernodeID& hn : phg.nodes()) {
-        ASSERT(hn < partition.size());
-        partition[hn] = phg.partID(hn);
+      return;
+    }
+
+    // Disabled vertices are written as unassigned (-1)
+    auto block_of = [&](const HypernodeID hn) {
+      return phg.nodeIsEnabled(hn) ? phg.partID(hn) : kInvalidPartition;
+    };
+    const size_t num_nodes = phg.initialNumNodes();
+    const size_t num_chunks = std::max(parallel::chunking::idiv_ceil(
+      num_nodes, PARTITION_WRITER_CHUNK_SIZE), UL(1));
+    vec<size_t> chunk_offsets(num_chunks + 1, 0);
+    if ( binary ) {
+      for ( size_t chunk = 0; chunk < num_chunks; ++chunk ) {
+        const auto [first, last] = parallel::chunking::bounds(chunk, num_nodes, PARTITION_WRITER_CHUNK_SIZE);
+        chunk_offsets[chunk + 1] = chunk_offsets[chunk] + sizeof(PartitionID) * (last - first) +
+          ( chunk == 0 ? sizeof(PartitionFileHeader) : 0 );
       }
-      for (const PartitionID& part : partition) {
-        out_stream << part << std::endl;
+      writeChunksInParallel(filename, chunk_offsets, [&](const size_t chunk, char* out) {
+        if ( chunk == 0 ) {
+          const PartitionFileHeader header { PartitionFileHeader::MAGIC, num_nodes };
+          std::memcpy(out, &header, sizeof(PartitionFileHeader));
+          out += sizeof(PartitionFileHeader);
+        }
+        const auto [first, last] = parallel::chunking::bounds(chunk, num_nodes, PARTITION_WRITER_CHUNK_SIZE);
+        for ( HypernodeID hn = first; hn < last; ++hn ) {
+          const PartitionID block = block_of(hn);
+          std::memcpy(out, &block, sizeof(PartitionID));
+          out += sizeof(PartitionID);
+        }
+      });
+    } else {
+      // The length of each chunk is computed in advance, such that
+      // the chunks can be formatted and written independently
+      tbb::parallel_for(UL(0), num_chunks, [&](const size_t chunk) {
+        const auto [first, last] = parallel::chunking::bounds(chunk, num_nodes, PARTITION_WRITER_CHUNK_SIZE);
+        size_t length = 0;
+        for ( HypernodeID hn = first; hn < last; ++hn ) {
+          length += partitionFileLineLength(block_of(hn));
+        }
+        chunk_offsets[chunk + 1] = length;
+      });
+      for ( size_t chunk = 0; chunk < num_chunks; ++chunk ) {
+        chunk_offsets[chunk + 1] += chunk_offsets[chunk];
       }
-      out_stream.close();
+      writeChunksInParallel(filename, chunk_offsets, [&](const size_t chunk, char* out) {
+        const auto [first, last] = parallel::chunking::bounds(chunk, num_nodes, PARTITION_WRITER_CHUNK_SIZE);
+        for ( HypernodeID hn = first; hn < last; ++hn ) {
+          out = formatPartitionFileLine(block_of(hn), out);
+        }
+      });
+    }
+  }
+
+  namespace {
+    // ! Header of a binary community file
+    struct CommunityCacheFileHeader {
+      static constexpr uint64_t MAGIC = 0x4d544b4843434331; // "MTKHCCC1"
+      uint64_t magic;
+      uint64_t fingerprint;
+      uint64_t num_nodes;
+    };
+  }
+
+  bool readCommunityCacheFile(const std::string& filename,
+                              const uint64_t fingerprint,
+                              ds::Clustering& communities) {
+    std::ifstream in_stream(filename.c_str(), std::ios::binary);
+    if ( !in_stream ) {
+      return false;
+    }
+    CommunityCacheFileHeader header;
+    in_stream.read(reinterpret_cast<char*>(&header), sizeof(CommunityCacheFileHeader));
+    if ( !in_stream || header.magic != CommunityCacheFileHeader::MAGIC ||
+         header.fingerprint != fingerprint ) {
+      return false;
+    }
+    ds::Clustering tmp_communities(header.num_nodes);
+    in_stream.read(reinterpret_cast<char*>(tmp_communities.data()),
+      sizeof(PartitionID) * header.num_nodes);
+    if ( !in_stream ) {
+      WARNING("Community file" << filename << "is truncated");
+      return false;
+    }
+    communities = std::move(tmp_communities);
+    return true;
+  }
+
+  void writeCommunityCacheFile(const std::string& filename,
+                               const uint64_t fingerprint,
+                               const ds::Clustering& communities) {
+    // Write to a temporary file first such that concurrent runs
+    // never read a partially written community file
+    #ifdef __linux__
+    const size_t process_id = getpid();
+    #elif _WIN32
+    const size_t process_id = _getpid();
+    #endif
+    const std::string tmp_filename = filename + ".tmp" + std::to_string(process_id);
+    std::ofstream out_stream(tmp_filename.c_str(), std::ios::binary);
+    if ( !out_stream ) {
+      WARNING("Could not open:" << tmp_filename);
+      return;
+    }
+    const CommunityCacheFileHeader header { CommunityCacheFileHeader::MAGIC,
+      fingerprint, communities.size() };
+    out_stream.write(reinterpret_cast<const char*>(&header), sizeof(CommunityCacheFileHeader));
+    out_stream.write(reinterpret_cast<const char*>(communities.data()),
+      sizeof(PartitionID) * communities.size());
+    out_stream.close();
+    if ( !out_stream || std::rename(tmp_filename.c_str(), filename.c_str()) != 0 ) {
+      WARNING("Error while writing community file" << filename);
+      std::remove(tmp_filename.c_str());
     }
   }
 
@@ -683,7 +1160,7 @@ namespace mt_kahypar::io {
                      parallel::scalable_vector<HyperedgeWeight>& edges_weight,
                      parallel::scalable_vector<HypernodeWeight>& vertices_weight) {
     ASSERT(!filename.empty(), "No filename for metis file specified");
-    FileHandle handle = mmap_file(filename);
+    FileHandle handle = open_input_file(filename);
     size_t pos = 0;
 
     // Read Metis Header
@@ -700,8 +1177,163 @@ namespace mt_kahypar::io {
     munmap_file(handle);
   }
 
+  #if defined(USE_GRAPH_PARTITIONER) && !defined(USE_STRONG_PARTITIONER)
+  // ! Byte range [start, end) of the vertex section of a Metis file, which
+  // ! starts at the beginning of a line and contains the vertices
+  // ! [first_vertex, first_vertex + num_vertices)
+  struct MetisChunk {
+    size_t start;
+    size_t end;
+    HypernodeID first_vertex;
+    HypernodeID num_vertices;
+  };
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool is_digit(const char c) {
+    return c >= '0' && c <= '9';
+  }
+
+  // ! Reads a Metis file in one parallel pass over the vertex section and writes the
+  // ! adjacency lists directly into the edge array of the static graph. In contrast to
+  // ! readGraphFile(...) above, the vertex section is split at arbitrary line boundaries
+  // ! (no sequential scan over all vertices) and no intermediate edge vector is built.
+  Hypergraph readMetisFileIntoStaticGraph(const std::string& filename) {
+    ASSERT(!filename.empty(), "No filename for metis file specified");
+    FileHandle handle = open_input_file(filename);
+    char* mapped_file = handle.mapped_file;
+    const size_t length = handle.length;
+    size_t pos = 0;
+
+    // Read Metis Header
+    HyperedgeID num_edges = 0;
+    HypernodeID num_vertices = 0;
+    bool has_edge_weights = false;
+    bool has_vertex_weights = false;
+    readMetisHeader(mapped_file, pos, length, num_edges,
+      num_vertices, has_edge_weights, has_vertex_weights);
+
+    // Split the vertex section into chunks of roughly equal size. Each chunk
+    // starts at the beginning of a line.
+    static constexpr size_t MIN_CHUNK_SIZE = UL(1) << 16;
+    const size_t num_chunks = std::max(UL(1), std::min((length - pos) / MIN_CHUNK_SIZE,
+      UL(4) * std::thread::hardware_concurrency()));
+    parallel::scalable_vector<MetisChunk> chunks;
+    size_t chunk_start = pos;
+    for ( size_t i = 1; i <= num_chunks; ++i ) {
+      size_t chunk_end = std::max(chunk_start, pos + (i * (length - pos)) / num_chunks);
+      while ( chunk_end < length && mapped_file[chunk_end - 1] != '\n' ) {
+        ++chunk_end;
+      }
+      if ( chunk_end > chunk_start ) {
+        chunks.push_back(MetisChunk { chunk_start, chunk_end, 0, 0 });
+        chunk_start = chunk_end;
+      }
+    }
+
+    // Count the vertices and their degrees in each chunk. The degree of a
+    // vertex is determined by the number of tokens in its line.
+    const size_t tokens_per_entry = has_edge_weights ? 2 : 1;
+    parallel::scalable_vector<parallel::scalable_vector<size_t>> degrees(chunks.size());
+    tbb::parallel_for(UL(0), chunks.size(), [&](const size_t i) {
+      MetisChunk& chunk = chunks[i];
+      size_t current_pos = chunk.start;
+      while ( current_pos < chunk.end && mapped_file[current_pos] != '\0' ) {
+        if ( mapped_file[current_pos] == '%' ) {
+          goto_next_line(mapped_file, current_pos, chunk.end);
+          continue;
+        }
+        size_t num_tokens = 0;
+        bool in_token = false;
+        for ( ; current_pos < chunk.end && !is_line_ending(mapped_file, current_pos); ++current_pos ) {
+          const bool digit = is_digit(mapped_file[current_pos]);
+          num_tokens += digit && !in_token;
+          in_token = digit;
+        }
+        if ( current_pos < chunk.end ) {
+          do_line_ending(mapped_file, current_pos);
+        }
+        if ( num_tokens == 0 ) {
+          // Empty line (isolated vertex or trailing newline)
+          degrees[i].push_back(0);
+        } else if ( (num_tokens - has_vertex_weights) % tokens_per_entry != 0 ) {
+          ERR("Invalid vertex line in Metis file" << filename);
+        } else {
+          degrees[i].push_back((num_tokens - has_vertex_weights) / tokens_per_entry);
+        }
+      }
+      chunk.num_vertices = degrees[i].size();
+    });
+
+    HypernodeID num_lines = 0;
+    for ( MetisChunk& chunk : chunks ) {
+      chunk.first_vertex = num_lines;
+      num_lines += chunk.num_vertices;
+    }
+    if ( num_lines < num_vertices ) {
+      ERR("Metis file" << filename << "contains fewer vertices than specified in its header"
+        << V(num_lines) << V(num_vertices));
+    }
+
+    // Compute the offsets of the adjacency lists. Lines after the last vertex are
+    // accepted if they are empty (e.g., trailing newlines).
+    parallel::scalable_vector<size_t> xadj(num_vertices + 1, 0);
+    tbb::parallel_for(UL(0), chunks.size(), [&](const size_t i) {
+      for ( HypernodeID j = 0; j < chunks[i].num_vertices; ++j ) {
+        const HypernodeID u = chunks[i].first_vertex + j;
+        if ( u < num_vertices ) {
+          xadj[u + 1] = degrees[i][j];
+        } else if ( degrees[i][j] > 0 ) {
+          ERR("Metis file" << filename << "contains more vertices than specified in its header");
+        }
+      }
+    });
+    parallel::TBBPrefixSum<size_t> xadj_prefix_sum(xadj);
+    tbb::parallel_scan(tbb::blocked_range<size_t>(UL(0), xadj.size()), xadj_prefix_sum);
+    if ( xadj[num_vertices] != 2 * static_cast<size_t>(num_edges) ) {
+      ERR("Metis file" << filename << "contains" << xadj[num_vertices]
+        << "adjacency entries, but its header specifies" << num_edges << "edges");
+    }
+
+    // Parse the adjacency lists and write them directly into the graph
+    Hypergraph graph = HypergraphFactory::construct_from_adjacency(num_vertices, xadj.data(),
+      [&](HypergraphFactory::AdjacencyWriter& writer) {
+        tbb::parallel_for(UL(0), chunks.size(), [&](const size_t i) {
+          const MetisChunk& chunk = chunks[i];
+          const HypernodeID last_vertex = std::min(chunk.first_vertex + chunk.num_vertices, num_vertices);
+          size_t current_pos = chunk.start;
+          for ( HypernodeID u = chunk.first_vertex; u < last_vertex; ++u ) {
+            while ( mapped_file[current_pos] == '%' ) {
+              goto_next_line(mapped_file, current_pos, chunk.end);
+            }
+            if ( has_vertex_weights ) {
+              writer.setNodeWeight(u, read_number(mapped_file, current_pos, chunk.end));
+            }
+            for ( size_t entry = xadj[u]; entry < xadj[u + 1]; ++entry ) {
+              const HypernodeID target = read_number(mapped_file, current_pos, chunk.end);
+              const HyperedgeWeight weight = has_edge_weights ?
+                read_number(mapped_file, current_pos, chunk.end) : 1;
+              // Target IDs are 1-based, an invalid ID 0 is rejected by the factory
+              writer.setEntry(entry, u, target - 1, weight);
+            }
+            if ( current_pos < chunk.end ) {
+              do_line_ending(mapped_file, current_pos);
+            }
+          }
+        });
+      });
+
+    munmap_file(handle);
+    return graph;
+  }
+  #endif
+
   Hypergraph readGraphFile(const std::string& filename,
                            const bool stable_construction_of_incident_edges) {
+    #if defined(USE_GRAPH_PARTITIONER) && !defined(USE_STRONG_PARTITIONER)
+    // The adjacency list of each node is sorted by target during construction,
+    // which makes the construction stable in any case.
+    unused(stable_construction_of_incident_edges);
+    return readMetisFileIntoStaticGraph(filename);
+    #else
     // Read Metis File
     HyperedgeID num_edges = 0;
     HypernodeID num_vertices = 0;
@@ -722,8 +1354,146 @@ namespace mt_kahypar::io {
             edges, edges_weight.data(), nodes_weight.data(),
             stable_construction_of_incident_edges);
     #endif
+    #endif
   }
 
+  #if !defined(USE_GRAPH_PARTITIONER) && !defined(USE_STRONG_PARTITIONER)
+  Hypergraph readHypergraphSnapshot(const std::string& filename) {
+    ASSERT(!filename.empty(), "No filename for hypergraph snapshot specified");
+    // The arrays of the hypergraph point directly into the mapped file. Since the
+    // hypergraph is modified during partitioning, we use a private mapping such
+    // that only pages that are actually written are copied.
+    std::shared_ptr<FileHandle> handle(new FileHandle(mmap_file(filename, true)),
+      [](FileHandle* handle) {
+        munmap_file(*handle);
+        delete handle;
+      });
+    char* mapped_file = handle->mapped_file;
+    const size_t length = handle->length;
+    return HypergraphFactory::construct_from_snapshot(mapped_file, length, std::move(handle));
+  }
+
+  void writeHypergraphSnapshot(const Hypergraph& hypergraph, const std::string& filename) {
+    std::ofstream out_stream(filename.c_str(), std::ios::binary);
+    if ( !out_stream ) {
+      ERR("Could not open:" << filename);
+    }
+    HypergraphFactory::write_snapshot(hypergraph, out_stream);
+    if ( !out_stream ) {
+      ERR("Error while writing hypergraph snapshot to" << filename);
+    }
+  }
+
+  namespace {
+    // ! Output buffer that writes into a fixed-size memory region
+    class MemoryOutputBuffer : public std::streambuf {
+     public:
+      MemoryOutputBuffer(char* data, const size_t length) {
+        setp(data, data + length);
+      }
+    };
+  }
+
+  void writeHypergraphSnapshotToSharedMemory(const Hypergraph& hypergraph, const std::string& name) {
+    #ifdef __linux__
+    const size_t length = HypergraphFactory::snapshot_size(hypergraph);
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if ( fd < 0 ) {
+      ERR("Could not create shared memory segment" << name << "(" << std::strerror(errno) << ")");
+    }
+    if ( ftruncate(fd, length) != 0 ) {
+      close(fd);
+      shm_unlink(name.c_str());
+      ERR("Could not resize shared memory segment" << name);
+    }
+    char* data = (char*) mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if ( data == MAP_FAILED ) {
+      shm_unlink(name.c_str());
+      ERR("Error while mapping shared memory segment" << name);
+    }
+    MemoryOutputBuffer buffer(data, length);
+    std::ostream out_stream(&buffer);
+    HypergraphFactory::write_snapshot(hypergraph, out_stream);
+    munmap(data, length);
+    if ( !out_stream ) {
+      shm_unlink(name.c_str());
+      ERR("Error while writing hypergraph snapshot to shared memory segment" << name);
+    }
+    #else
+    unused(hypergraph);
+    ERR("POSIX shared memory is not supported on this platform:" << name);
+    #endif
+  }
+
+  Hypergraph readSharedHypergraphSnapshot(const std::string& name) {
+    #ifdef __linux__
+    FileHandle handle;
+    handle.fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if ( handle.fd < 0 ) {
+      ERR("Could not open shared memory segment" << name << "(" << std::strerror(errno) << ")");
+    }
+    struct stat stat_buf;
+    if ( fstat(handle.fd, &stat_buf) != 0 ) {
+      handle.closeHandle();
+      ERR("Could not determine size of shared memory segment" << name);
+    }
+    handle.length = static_cast<size_t>(stat_buf.st_size);
+    // The segment is opened read-only. The private mapping shares all pages with the
+    // other processes attached to the segment and only copies pages that are written.
+    handle.mapped_file = (char*) mmap(0, handle.length,
+      PROT_READ | PROT_WRITE, MAP_PRIVATE, handle.fd, 0);
+    if ( handle.mapped_file == MAP_FAILED ) {
+      handle.closeHandle();
+      ERR("Error while mapping shared memory segment" << name);
+    }
+    std::shared_ptr<FileHandle> shared_handle(new FileHandle(handle),
+      [](FileHandle* handle) {
+        munmap_file(*handle);
+        delete handle;
+      });
+    return HypergraphFactory::construct_from_snapshot(
+      handle.mapped_file, handle.length, std::move(shared_handle));
+    #else
+    ERR("POSIX shared memory is not supported on this platform:" << name);
+    #endif
+  }
+
+  void removeSharedHypergraphSnapshot(const std::string& name) {
+    #ifdef __linux__
+    if ( shm_unlink(name.c_str()) != 0 ) {
+      ERR("Could not remove shared memory segment" << name << "(" << std::strerror(errno) << ")");
+    }
+    #else
+    ERR("POSIX shared memory is not supported on this platform:" << name);
+    #endif
+  }
+
+  void offloadHypergraphToDisk(Hypergraph& hypergraph, const std::string& directory) {
+    static std::atomic<size_t> num_offloaded_hypergraphs(0);
+    #ifdef __linux__
+    const size_t process_id = getpid();
+    #elif _WIN32
+    const size_t process_id = _getpid();
+    #endif
+    const std::string filename = directory + "/mt_kahypar_" + std::to_string(process_id) +
+      "_" + std::to_string(num_offloaded_hypergraphs++) + ".snapshot";
+    writeHypergraphSnapshot(hypergraph, filename);
+
+    // The file is only removed after unmapping it, since this is not
+    // possible for files that are still in use on all platforms.
+    std::shared_ptr<FileHandle> handle(new FileHandle(mmap_file(filename, true)),
+      [filename](FileHandle* handle) {
+        munmap_file(*handle);
+        std::remove(filename.c_str());
+        delete handle;
+      });
+    char* mapped_file = handle->mapped_file;
+    const size_t length = handle->length;
+    hypergraph = HypergraphFactory::construct_from_snapshot(mapped_file, length, std::move(handle));
+  }
+  #endif
+
   Hypergraph readInputFile(const std::string& filename,
                            const FileFormat format,
                            const bool stable_construction_of_incident_edges,
@@ -736,6 +1506,18 @@ namespace mt_kahypar::io {
       case FileFormat::Metis:
         return readGraphFile(filename,
           stable_construction_of_incident_edges);
+      case FileFormat::Snapshot:
+        #if !defined(USE_GRAPH_PARTITIONER) && !defined(USE_STRONG_PARTITIONER)
+        return readHypergraphSnapshot(filename);
+        #else
+        ERR("Hypergraph snapshots are only supported by the static hypergraph data structure");
+        #endif
+      case FileFormat::SharedSnapshot:
+        #if !defined(USE_GRAPH_PARTITIONER) && !defined(USE_STRONG_PARTITIONER)
+        return readSharedHypergraphSnapshot(filename);
+        #else
+        ERR("Hypergraph snapshots are only supported by the static hypergraph data structure");
+        #endif
         // omit default case to trigger compiler warning for missing cases
     }
     return hypergraph;
@@ -66,13 +66,58 @@ namespace io {
   Hypergraph readGraphFile(const std::string& filename,
                            const bool stable_construction_of_incident_edges = false);
 
+  #if !defined(USE_GRAPH_PARTITIONER) && !defined(USE_STRONG_PARTITIONER)
+  // ! Loads a binary snapshot of a static hypergraph. The hypergraph uses the
+  // ! memory-mapped file in place (see StaticHypergraphSnapshotHeader).
+  Hypergraph readHypergraphSnapshot(const std::string& filename);
+
+  void writeHypergraphSnapshot(const Hypergraph& hypergraph, const std::string& filename);
+
+  // ! Writes a snapshot of the hypergraph into a new POSIX shared memory segment with
+  // ! the given name (e.g., "/my_hypergraph"). Since the snapshot layout is relocatable,
+  // ! other processes can attach to the segment via readSharedHypergraphSnapshot(...).
+  void writeHypergraphSnapshotToSharedMemory(const Hypergraph& hypergraph, const std::string& name);
+
+  // ! Attaches read-only to a shared memory segment that contains a hypergraph snapshot.
+  // ! The pages of the segment are shared between all attached processes and only
+  // ! pages modified during partitioning are copied.
+  Hypergraph readSharedHypergraphSnapshot(const std::string& name);
+
+  void removeSharedHypergraphSnapshot(const std::string& name);
+
+  // ! Writes the hypergraph to a temporary snapshot in the given directory and
+  // ! replaces it with a memory-mapped version of that snapshot. The pages of the
+  // ! mapping are backed by the file and can be evicted by the operating system
+  // ! as long as the hypergraph is not accessed. The file is removed once the
+  // ! hypergraph is destroyed.
+  void offloadHypergraphToDisk(Hypergraph& hypergraph, const std::string& directory);
+  #endif
+
   Hypergraph readInputFile(const std::string& filename,
                            const FileFormat format,
                            const bool stable_construction_of_incident_edges = false,
                            const bool remove_single_pin_hes = true);
 
+  // ! Reads a partition file in text format (one block per line)
+  // ! or binary format (see writePartitionFile(...))
   void readPartitionFile(const std::string& filename, std::vector<PartitionID>& partition);
-  void writePartitionFile(const PartitionedHypergraph& phg, const std::string& filename);
+  // ! Fixes the vertices of the hypergraph to the blocks given in the file
+  // ! (one line per vertex, -1 = not fixed)
+  void readFixedVertexFile(const std::string& filename, Hypergraph& hypergraph);
+  // ! Writes the block of each vertex in parallel. The text format contains one block
+  // ! per line. The binary format consists of a small header followed by an int32 array.
+  void writePartitionFile(const PartitionedHypergraph& phg,
+                          const std::string& filename,
+                          const bool binary = false);
+
+  // ! Reads a binary community file written by writeCommunityCacheFile(...). Returns
+  // ! false, if the file does not exist or was written for a different fingerprint.
+  bool readCommunityCacheFile(const std::string& filename,
+                              const uint64_t fingerprint,
+                              ds::Clustering& communities);
+  void writeCommunityCacheFile(const std::string& filename,
+                               const uint64_t fingerprint,
+                               const ds::Clustering& communities);
 
 }  // namespace io
 }  // namespace mt_kahypar
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "json_report.h"
+
+#include <sstream>
+
+#include "mt-kahypar/parallel/memory_pool.h"
+#include "mt-kahypar/partition/metrics.h"
+#include "mt-kahypar/utils/memory_tree.h"
+#include "mt-kahypar/utils/utilities.h"
+
+namespace mt_kahypar::io::json {
+
+  std::string serializeRunReport(const PartitionedHypergraph& phg, const Context& context) {
+    std::stringstream s;
+    s << "{\"objective\":\"" << context.partition.objective << "\""
+      << ",\"k\":" << context.partition.k
+      << ",\"epsilon\":" << context.partition.epsilon
+      << ",\"seed\":" << context.partition.seed
+      << ",\"num_threads\":" << context.shared_memory.num_threads
+      << ",\"num_nodes\":" << phg.initialNumNodes()
+      << ",\"num_edges\":" << phg.initialNumEdges()
+      << ",\"num_pins\":" << phg.initialNumPins()
+      << ",\"km1\":" << metrics::km1(phg)
+      << ",\"cut\":" << metrics::hyperedgeCut(phg)
+      << ",\"imbalance\":" << metrics::imbalance(phg, context);
+
+    utils::Utilities& utilities = utils::Utilities::instance();
+    s << ",\"timings\":";
+    utilities.getTimer(context.utility_id).serializeJSON(s);
+    s << ",\"stats\":";
+    utilities.getStats(context.utility_id).serializeJSON(s);
+    s << ",\"levels\":";
+    utilities.getLevelStats(context.utility_id).serializeJSON(s);
+
+    utils::MemoryTreeNode hypergraph_memory("Partitioned Hypergraph", utils::OutputType::BYTES);
+    phg.memoryConsumption(&hypergraph_memory);
+    hypergraph_memory.finalize();
+    utils::MemoryTreeNode memory_pool("Memory Pool", utils::OutputType::BYTES);
+    parallel::MemoryPool::instance().memory_consumption(&memory_pool);
+    memory_pool.finalize();
+    s << ",\"memory\":";
+    hypergraph_memory.serializeJSON(s);
+    s << ",\"memory_pool\":";
+    memory_pool.serializeJSON(s);
+    s << "}";
+    return s.str();
+  }
+}
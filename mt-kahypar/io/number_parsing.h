@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <emmintrin.h>
+#define MT_KAHYPAR_SIMD_NUMBER_PARSING
+#elif defined(__ARM_NEON) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <arm_neon.h>
+#define MT_KAHYPAR_SIMD_NUMBER_PARSING
+#endif
+
+#include "mt-kahypar/macros.h"
+
+namespace mt_kahypar {
+namespace io {
+
+MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static bool is_line_ending(const char* mapped_file, size_t pos) {
+  return mapped_file[pos] == '\r' || mapped_file[pos] == '\n' || mapped_file[pos] == '\0';
+}
+
+// ! Parses the number at the current position character by character and
+// ! skips all spaces before and after the number.
+MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static int64_t read_number_scalar(const char* mapped_file,
+                                                                    size_t& pos,
+                                                                    const size_t length) {
+  int64_t number = 0;
+  while ( mapped_file[pos] == ' ' ) {
+    ++pos;
+  }
+  for ( ; pos < length; ++pos ) {
+    if ( mapped_file[pos] == ' ' || is_line_ending(mapped_file, pos) ) {
+      while ( mapped_file[pos] == ' ' ) {
+        ++pos;
+      }
+      break;
+    }
+    ASSERT(mapped_file[pos] >= '0' && mapped_file[pos] <= '9');
+    number = number * 10 + (mapped_file[pos] - '0');
+  }
+  return number;
+}
+
+#ifdef MT_KAHYPAR_SIMD_NUMBER_PARSING
+namespace simd {
+
+static constexpr size_t BLOCK_SIZE = 16;
+
+// ! Returns the number of consecutive digits at the beginning of the
+// ! 16 characters starting at chars (BLOCK_SIZE, if all are digits).
+MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static size_t count_leading_digits(const char* chars) {
+  #ifdef __SSE2__
+  const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars));
+  // Characters greater or equal than 128 are negative and therefore also smaller than '0'
+  const __m128i non_digits = _mm_or_si128(
+    _mm_cmplt_epi8(block, _mm_set1_epi8('0')), _mm_cmpgt_epi8(block, _mm_set1_epi8('9')));
+  const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(non_digits));
+  return mask == 0 ? BLOCK_SIZE : __builtin_ctz(mask);
+  #else
+  const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(chars));
+  const uint8x16_t non_digits = vorrq_u8(
+    vcltq_u8(block, vdupq_n_u8('0')), vcgtq_u8(block, vdupq_n_u8('9')));
+  // NEON has no movemask instruction. Narrowing shift yields a 64-bit mask
+  // where each character is represented by four bits.
+  const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(
+    vshrn_n_u16(vreinterpretq_u16_u8(non_digits), 4)), 0);
+  return mask == 0 ? BLOCK_SIZE : __builtin_ctzll(mask) / 4;
+  #endif
+}
+
+// ! Converts up to eight digits starting at chars to an integer with
+// ! a few multiplications (SWAR). Requires that eight characters are readable.
+MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static uint64_t parse_digits(const char* chars,
+                                                               const size_t num_digits) {
+  ASSERT(num_digits > 0 && num_digits <= 8);
+  uint64_t val;
+  std::memcpy(&val, chars, sizeof(uint64_t));
+  val -= 0x3030303030303030;
+  // Remove all characters after the last digit and pad the number with leading zeros
+  val <<= 8 * (8 - num_digits);
+  val = (val * 10) + (val >> 8);
+  val = (((val & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+         (((val >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+  return val;
+}
+
+} // namespace simd
+#endif
+
+// ! Parses the number at the current position and skips all spaces before and
+// ! after the number. If enough characters are left, the end of the number is
+// ! determined with vector instructions and its digits are converted in bulk.
+// ! Otherwise, we fall back to the scalar implementation.
+MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static int64_t read_number(const char* mapped_file,
+                                                             size_t& pos,
+                                                             const size_t length) {
+  #ifdef MT_KAHYPAR_SIMD_NUMBER_PARSING
+  while ( mapped_file[pos] == ' ' ) {
+    ++pos;
+  }
+  if ( pos + simd::BLOCK_SIZE <= length ) {
+    const size_t num_digits = simd::count_leading_digits(mapped_file + pos);
+    if ( num_digits > 0 && num_digits < simd::BLOCK_SIZE ) {
+      ASSERT(mapped_file[pos + num_digits] == ' ' || is_line_ending(mapped_file, pos + num_digits));
+      const int64_t number = num_digits <= 8 ?
+        simd::parse_digits(mapped_file + pos, num_digits) :
+        simd::parse_digits(mapped_file + pos, num_digits - 8) * 100000000 +
+        simd::parse_digits(mapped_file + pos + num_digits - 8, 8);
+      pos += num_digits;
+      while ( mapped_file[pos] == ' ' ) {
+        ++pos;
+      }
+      return number;
+    }
+  }
+  #endif
+  return read_number_scalar(mapped_file, pos, length);
+}
+
+}  // namespace io
+}  // namespace mt_kahypar
@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "mt-kahypar/io/partition_checkpoint.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <unistd.h>
+#elif _WIN32
+#include <process.h>
+#endif
+
+#include "tbb/parallel_for.h"
+
+#include "mt-kahypar/utils/randomize.h"
+
+namespace mt_kahypar::io {
+
+namespace {
+  // ! Header of a binary checkpoint file
+  struct PartitionCheckpointHeader {
+    static constexpr uint64_t MAGIC = 0x4d544b4843504b31; // "MTKHCPK1"
+    uint64_t magic;
+    uint64_t num_nodes;
+    uint64_t num_edges;
+    uint64_t num_pins;
+    int64_t k;
+    int64_t seed;
+    uint64_t num_completed_vcycles;
+    uint64_t random_state_size;
+  };
+}
+
+bool readPartitionCheckpoint(const std::string& filename,
+                             const Hypergraph& hypergraph,
+                             const Context& context,
+                             PartitionCheckpoint& checkpoint) {
+  std::ifstream in_stream(filename.c_str(), std::ios::binary);
+  if ( !in_stream ) {
+    return false;
+  }
+  PartitionCheckpointHeader header;
+  in_stream.read(reinterpret_cast<char*>(&header), sizeof(PartitionCheckpointHeader));
+  if ( !in_stream || header.magic != PartitionCheckpointHeader::MAGIC ) {
+    WARNING(filename << "is not a checkpoint file");
+    return false;
+  }
+  if ( header.num_nodes != hypergraph.initialNumNodes() ||
+       header.num_edges != hypergraph.initialNumEdges() ||
+       header.num_pins != hypergraph.initialNumPins() ||
+       header.k != context.partition.k ||
+       header.seed != context.partition.seed ) {
+    WARNING("Checkpoint" << filename << "was written for a different input, k or seed");
+    return false;
+  }
+
+  PartitionCheckpoint tmp_checkpoint;
+  tmp_checkpoint.num_completed_vcycles = header.num_completed_vcycles;
+  tmp_checkpoint.partition.resize(header.num_nodes);
+  in_stream.read(reinterpret_cast<char*>(tmp_checkpoint.partition.data()),
+    sizeof(PartitionID) * header.num_nodes);
+  tmp_checkpoint.random_state.resize(header.random_state_size);
+  in_stream.read(&tmp_checkpoint.random_state[0], header.random_state_size);
+  if ( !in_stream ) {
+    WARNING("Checkpoint" << filename << "is truncated");
+    return false;
+  }
+  for ( const PartitionID& block : tmp_checkpoint.partition ) {
+    if ( block < 0 || block >= context.partition.k ) {
+      WARNING("Checkpoint" << filename << "contains an invalid block ID" << block);
+      return false;
+    }
+  }
+  checkpoint = std::move(tmp_checkpoint);
+  return true;
+}
+
+PartitionCheckpointWriter::PartitionCheckpointWriter(const std::string& filename,
+                                                     const Hypergraph& hypergraph,
+                                                     const Context& context) :
+  _filename(filename),
+  _num_nodes(hypergraph.initialNumNodes()),
+  _num_edges(hypergraph.initialNumEdges()),
+  _num_pins(hypergraph.initialNumPins()),
+  _k(context.partition.k),
+  _seed(context.partition.seed),
+  _checkpoint(),
+  _writer() { }
+
+void PartitionCheckpointWriter::writeAsync(const PartitionedHypergraph& partitioned_hg,
+                                           const size_t num_completed_vcycles) {
+  wait();
+  ASSERT(partitioned_hg.initialNumNodes() == _num_nodes);
+  _checkpoint.num_completed_vcycles = num_completed_vcycles;
+  _checkpoint.partition.resize(_num_nodes);
+  tbb::parallel_for(UL(0), _checkpoint.partition.size(), [&](const size_t hn) {
+    _checkpoint.partition[hn] = partitioned_hg.partID(hn);
+  });
+  std::ostringstream random_state;
+  utils::Randomize::instance().serializeState(random_state);
+  _checkpoint.random_state = random_state.str();
+  _writer = std::thread([this] { write(); });
+}
+
+void PartitionCheckpointWriter::wait() {
+  if ( _writer.joinable() ) {
+    _writer.join();
+  }
+}
+
+void PartitionCheckpointWriter::write() const {
+  #ifdef __linux__
+  const size_t process_id = getpid();
+  #elif _WIN32
+  const size_t process_id = _getpid();
+  #endif
+  const std::string tmp_filename = _filename + ".tmp" + std::to_string(process_id);
+  std::ofstream out_stream(tmp_filename.c_str(), std::ios::binary);
+  if ( !out_stream ) {
+    WARNING("Could not open:" << tmp_filename);
+    return;
+  }
+  const PartitionCheckpointHeader header { PartitionCheckpointHeader::MAGIC,
+    _num_nodes, _num_edges, _num_pins, _k, _seed,
+    _checkpoint.num_completed_vcycles, _checkpoint.random_state.size() };
+  out_stream.write(reinterpret_cast<const char*>(&header), sizeof(PartitionCheckpointHeader));
+  out_stream.write(reinterpret_cast<const char*>(_checkpoint.partition.data()),
+    sizeof(PartitionID) * _checkpoint.partition.size());
+  out_stream.write(_checkpoint.random_state.data(), _checkpoint.random_state.size());
+  out_stream.close();
+  if ( !out_stream || std::rename(tmp_filename.c_str(), _filename.c_str()) != 0 ) {
+    WARNING("Error while writing checkpoint" << _filename);
+    std::remove(tmp_filename.c_str());
+  }
+}
+
+}  // namespace mt_kahypar::io
@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <string>
+#include <thread>
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+
+namespace mt_kahypar::io {
+
+// ! State of a partitioning run at the end of a V-cycle
+struct PartitionCheckpoint {
+  vec<PartitionID> partition;
+  // ! Number of V-cycles performed to compute the partition
+  size_t num_completed_vcycles = 0;
+  // ! State of the random number generators (see utils::Randomize::serializeState)
+  std::string random_state;
+};
+
+// ! Reads a checkpoint written by PartitionCheckpointWriter. Returns false, if the file
+// ! does not exist or was written for a different hypergraph, k or seed.
+bool readPartitionCheckpoint(const std::string& filename,
+                             const Hypergraph& hypergraph,
+                             const Context& context,
+                             PartitionCheckpoint& checkpoint);
+
+/*!
+ * Writes checkpoints of a partitioning run in a compact binary format.
+ * The partition is copied when the checkpoint is taken and the file is
+ * written on a separate (non-TBB) thread such that the partitioner can
+ * proceed immediately. A new checkpoint waits for the previous write.
+ * Each checkpoint is written to a temporary file first and then renamed,
+ * such that a preempted run never leaves a partially written checkpoint.
+ */
+class PartitionCheckpointWriter {
+
+ public:
+  PartitionCheckpointWriter(const std::string& filename,
+                            const Hypergraph& hypergraph,
+                            const Context& context);
+
+  PartitionCheckpointWriter(const PartitionCheckpointWriter&) = delete;
+  PartitionCheckpointWriter(PartitionCheckpointWriter&&) = delete;
+  PartitionCheckpointWriter & operator= (const PartitionCheckpointWriter &) = delete;
+  PartitionCheckpointWriter & operator= (PartitionCheckpointWriter &&) = delete;
+
+  ~PartitionCheckpointWriter() {
+    wait();
+  }
+
+  // ! Takes a checkpoint of the current partition and the random number generators
+  // ! and writes it asynchronously
+  void writeAsync(const PartitionedHypergraph& partitioned_hg,
+                  const size_t num_completed_vcycles);
+
+  // ! Blocks until the last checkpoint is written
+  void wait();
+
+ private:
+  void write() const;
+
+  const std::string _filename;
+  const HypernodeID _num_nodes;
+  const HyperedgeID _num_edges;
+  const size_t _num_pins;
+  const PartitionID _k;
+  const int _seed;
+  PartitionCheckpoint _checkpoint;
+  std::thread _writer;
+};
+
+}  // namespace mt_kahypar::io
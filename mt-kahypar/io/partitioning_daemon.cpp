@@ -0,0 +1,343 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "mt-kahypar/io/partitioning_daemon.h"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "mt-kahypar/io/command_line_options.h"
+#include "mt-kahypar/io/hypergraph_io.h"
+#include "mt-kahypar/parallel/memory_pool.h"
+#include "mt-kahypar/partition/auto_configuration.h"
+#include "mt-kahypar/partition/metrics.h"
+#include "mt-kahypar/partition/partitioner.h"
+#include "mt-kahypar/partition/registries/register_memory_pool.h"
+#include "mt-kahypar/utils/randomize.h"
+#include "mt-kahypar/utils/utilities.h"
+
+namespace mt_kahypar {
+namespace io {
+
+namespace {
+  // The help option (and unique prefixes of it) terminates the process
+  bool isHelpOption(const std::string& arg) {
+    const std::string help = "--help";
+    return arg.size() > 3 && arg.size() <= help.size() && help.compare(0, arg.size(), arg) == 0;
+  }
+
+  std::string readRequest(const int connection) {
+    std::string request;
+    char buffer[4096];
+    while ( request.find('\n') == std::string::npos ) {
+      const ssize_t num_bytes = ::recv(connection, buffer, sizeof(buffer), 0);
+      if ( num_bytes < 0 && errno == EINTR ) {
+        continue;
+      } else if ( num_bytes <= 0 ) {
+        break;
+      }
+      request.append(buffer, num_bytes);
+    }
+    request = request.substr(0, request.find('\n'));
+    if ( !request.empty() && request.back() == '\r' ) {
+      request.pop_back();
+    }
+    return request;
+  }
+
+  void writeResponse(const int connection, const std::string& response) {
+    size_t written = 0;
+    while ( written < response.size() ) {
+      // The client might have closed the connection => no SIGPIPE
+      const ssize_t num_bytes = ::send(connection, response.data() + written,
+        response.size() - written, MSG_NOSIGNAL);
+      if ( num_bytes < 0 && errno == EINTR ) {
+        continue;
+      } else if ( num_bytes <= 0 ) {
+        break;
+      }
+      written += num_bytes;
+    }
+  }
+}
+
+std::shared_ptr<const Hypergraph> InputCache::get(const Context& context) {
+  const std::string cache_key = key(context);
+  if ( _capacity > 0 ) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _index.find(cache_key);
+    if ( it != _index.end() ) {
+      _entries.splice(_entries.begin(), _entries, it->second);
+      return it->second->second;
+    }
+  }
+
+  // Reading the input is not protected by the lock. Thus, concurrent
+  // jobs on the same uncached input might both read the input file.
+  std::shared_ptr<const Hypergraph> hypergraph = std::make_shared<Hypergraph>(
+    readInputFile(context.partition.graph_filename, context.partition.file_format,
+      context.preprocessing.stable_construction_of_incident_edges));
+
+  if ( _capacity > 0 ) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if ( _index.find(cache_key) == _index.end() ) {
+      _entries.emplace_front(cache_key, hypergraph);
+      _index[cache_key] = _entries.begin();
+      while ( _entries.size() > _capacity ) {
+        _index.erase(_entries.back().first);
+        _entries.pop_back();
+      }
+    }
+  }
+  return hypergraph;
+}
+
+std::string InputCache::key(const Context& context) {
+  const std::string& filename = context.partition.graph_filename;
+  std::stringstream ss;
+  ss << filename << "|" << static_cast<int>(context.partition.file_format)
+     << "|" << context.preprocessing.stable_construction_of_incident_edges;
+  // Shared memory segments are identified by their name
+  if ( context.partition.file_format != FileFormat::SharedSnapshot ) {
+    struct stat stat_buf;
+    if ( stat(filename.c_str(), &stat_buf) != 0 ) {
+      throw std::invalid_argument("Input file does not exist: " + filename);
+    }
+    ss << "|" << stat_buf.st_size << "|" << stat_buf.st_mtim.tv_sec << "." << stat_buf.st_mtim.tv_nsec;
+  }
+  return ss.str();
+}
+
+PartitioningDaemon::PartitioningDaemon(const DaemonParameters& params) :
+  _params(params),
+  _input_cache(params.input_cache_size),
+  _utility_ids(),
+  _socket(-1),
+  _is_shutdown(false),
+  _queue_mutex(),
+  _queue_cv(),
+  _connections() {
+  ASSERT(_params.max_concurrent_jobs > 0);
+  for ( size_t i = 0; i < _params.max_concurrent_jobs; ++i ) {
+    _utility_ids.push_back(utils::Utilities::instance().registerNewUtilityObjects());
+  }
+}
+
+void PartitioningDaemon::run() {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if ( _params.socket_path.empty() || _params.socket_path.size() >= sizeof(address.sun_path) ) {
+    ERR("Invalid socket path:" << _params.socket_path);
+  }
+  std::strncpy(address.sun_path, _params.socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+  _socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if ( _socket < 0 ) {
+    ERR("Could not create socket:" << std::strerror(errno));
+  }
+  // Remove the socket of a previous daemon
+  ::unlink(_params.socket_path.c_str());
+  if ( ::bind(_socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+       ::listen(_socket, SOMAXCONN) != 0 ) {
+    ERR("Could not listen on socket" << _params.socket_path << ":" << std::strerror(errno));
+  }
+
+  // Concurrent jobs can not share the memory chunks of the memory pool
+  parallel::MemoryPool& pool = parallel::MemoryPool::instance();
+  if ( _params.max_concurrent_jobs == 1 ) {
+    pool.enable_memory_requests();
+  } else {
+    pool.disable_memory_requests();
+  }
+
+  std::vector<std::thread> workers;
+  for ( size_t i = 0; i < _params.max_concurrent_jobs; ++i ) {
+    workers.emplace_back([&, i] {
+      processConnections(i);
+    });
+  }
+
+  while ( !_is_shutdown ) {
+    const int connection = ::accept(_socket, nullptr, nullptr);
+    if ( connection < 0 ) {
+      if ( !_is_shutdown && errno != EINTR ) {
+        WARNING("Could not accept connection:" << std::strerror(errno));
+      }
+      continue;
+    }
+    std::lock_guard<std::mutex> lock(_queue_mutex);
+    _connections.push(connection);
+    _queue_cv.notify_one();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_queue_mutex);
+    _queue_cv.notify_all();
+  }
+  for ( std::thread& worker : workers ) {
+    worker.join();
+  }
+  ::close(_socket);
+  ::unlink(_params.socket_path.c_str());
+  pool.free_memory_chunks();
+}
+
+std::string PartitioningDaemon::processRequest(const std::string& request, const size_t worker) {
+  ASSERT(worker < _utility_ids.size());
+  std::vector<std::string> args { "MtKaHyPar" };
+  std::istringstream tokens(request);
+  std::string token;
+  while ( tokens >> token ) {
+    if ( isHelpOption(token) ) {
+      return "ERROR option --help is not supported by the daemon";
+    }
+    args.push_back(token);
+  }
+  if ( args.size() == 1 ) {
+    return "ERROR empty request";
+  }
+  std::vector<char*> argv;
+  for ( std::string& arg : args ) {
+    argv.push_back(&arg[0]);
+  }
+
+  Context context(false);
+  std::shared_ptr<const Hypergraph> input;
+  try {
+    processCommandLineInput(context, static_cast<int>(argv.size()), argv.data());
+    input = _input_cache.get(context);
+  } catch ( const std::exception& e ) {
+    return std::string("ERROR ") + e.what();
+  }
+
+  // Each worker reuses its utility objects
+  context.utility_id = _utility_ids[worker];
+  utils::Utilities::instance().getTimer(context.utility_id).clear();
+  utils::Utilities::instance().getStats(context.utility_id).clear();
+  utils::Utilities::instance().getLevelStats(context.utility_id).clear();
+
+  // The thread budget of a job is modeled via the number of threads in its
+  // context (similar to the batch partitioning of the library interface)
+  const size_t threads_per_job = std::max(_params.num_threads / _params.max_concurrent_jobs, UL(1));
+  context.shared_memory.num_threads = std::min(context.shared_memory.num_threads, threads_per_job);
+  context.shared_memory.original_num_threads = context.shared_memory.num_threads;
+  const bool use_memory_pool = _params.max_concurrent_jobs == 1;
+  if ( use_memory_pool ) {
+    // The random number generators are shared by all jobs
+    utils::Randomize::instance().setSeed(context.partition.seed);
+  }
+
+  std::stringstream response;
+  {
+    Hypergraph hypergraph = input->copy(parallel_tag_t());
+    input.reset();
+    if ( !context.partition.fixed_vertex_filename.empty() ) {
+      readFixedVertexFile(context.partition.fixed_vertex_filename, hypergraph);
+    }
+    apply_auto_configuration(hypergraph, context);
+    apply_memory_limit(hypergraph, context);
+    if ( use_memory_pool ) {
+      // Memory chunks are only reallocated if the hypergraph requires
+      // more memory than all hypergraphs partitioned before
+      register_memory_pool(hypergraph, context);
+    }
+
+    HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+    PartitionedHypergraph partitioned_hypergraph = partition(hypergraph, context);
+    HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed_seconds(end - start);
+
+    if ( context.partition.write_partition_file ) {
+      writePartitionFile(partitioned_hypergraph,
+        context.partition.graph_partition_filename, context.partition.binary_partition_file);
+    }
+    response << "OK objective=" << metrics::objective(partitioned_hypergraph, context.partition.objective)
+             << " imbalance=" << metrics::imbalance(partitioned_hypergraph, context)
+             << " time=" << elapsed_seconds.count();
+    DBG << "Finished job" << V(request) << V(response.str());
+  }
+
+  // All data structures allocated from the memory pool are
+  // destroyed at this point => restore it for the next job
+  if ( use_memory_pool ) {
+    parallel::MemoryPool::instance().reset();
+  }
+  return response.str();
+}
+
+void PartitioningDaemon::processConnections(const size_t worker) {
+  while ( true ) {
+    int connection = -1;
+    {
+      std::unique_lock<std::mutex> lock(_queue_mutex);
+      _queue_cv.wait(lock, [&] {
+        return !_connections.empty() || _is_shutdown;
+      });
+      if ( _connections.empty() ) {
+        // Queued jobs are finished before the daemon terminates
+        return;
+      }
+      connection = _connections.front();
+      _connections.pop();
+    }
+
+    const std::string request = readRequest(connection);
+    std::string response;
+    if ( request == "shutdown" ) {
+      requestShutdown();
+      response = "OK";
+    } else {
+      response = processRequest(request, worker);
+    }
+    writeResponse(connection, response + "\n");
+    ::close(connection);
+  }
+}
+
+void PartitioningDaemon::requestShutdown() {
+  {
+    std::lock_guard<std::mutex> lock(_queue_mutex);
+    _is_shutdown = true;
+    _queue_cv.notify_all();
+  }
+  // Wakes up the blocking accept call
+  ::shutdown(_socket, SHUT_RDWR);
+}
+
+}  // namespace io
+}  // namespace mt_kahypar
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+
+namespace mt_kahypar {
+namespace io {
+
+struct DaemonParameters {
+  // ! Path of the Unix domain socket on which the daemon accepts jobs
+  std::string socket_path { };
+  // ! Total number of threads shared by all running jobs
+  size_t num_threads = 1;
+  // ! Number of jobs that are executed concurrently. With a single job at a time,
+  // ! all jobs reuse the memory chunks of the memory pool.
+  size_t max_concurrent_jobs = 1;
+  // ! Maximum number of inputs that are kept in memory (0 = no caching)
+  size_t input_cache_size = 4;
+};
+
+/*!
+ * Bounded LRU cache for constructed input hypergraphs. The key consists of
+ * the filename, the file format, the construction parameters and the last
+ * modification time of the file, such that modified input files are read again.
+ * Jobs partition a copy of the cached hypergraph, since the partitioner modifies
+ * its input (e.g., fixed vertices, community structure or removed nets).
+ */
+class InputCache {
+
+  using Entry = std::pair<std::string, std::shared_ptr<const Hypergraph>>;
+
+ public:
+  explicit InputCache(const size_t capacity) :
+    _capacity(capacity),
+    _mutex(),
+    _entries(),
+    _index() { }
+
+  InputCache(const InputCache&) = delete;
+  InputCache(InputCache&&) = delete;
+  InputCache & operator= (const InputCache &) = delete;
+  InputCache & operator= (InputCache &&) = delete;
+
+  // ! Returns the input hypergraph of the context and reads it, if it is not cached.
+  // ! Throws std::invalid_argument, if the input file does not exist.
+  std::shared_ptr<const Hypergraph> get(const Context& context);
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+  }
+
+ private:
+  static std::string key(const Context& context);
+
+  const size_t _capacity;
+  mutable std::mutex _mutex;
+  // ! Most recently used entry first
+  std::list<Entry> _entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> _index;
+};
+
+/*!
+ * Long-running partitioning process that avoids paying for process startup,
+ * thread pool creation, memory pool allocation and input parsing on each call.
+ * Clients connect to a Unix domain socket and send a single line containing the
+ * command line arguments of the job (same as for the MtKaHyPar binary, e.g.
+ * "-h ibm01.hgr -p config/default_preset.ini -k 8 -e 0.03 -o km1 -m direct").
+ * The daemon answers with a single line that starts either with "OK" followed
+ * by the objective, imbalance and partitioning time of the job or with "ERROR"
+ * followed by a description of the error. The request "shutdown" stops the
+ * daemon after all queued jobs are finished. Arguments are separated by
+ * whitespaces and can not be quoted.
+ *
+ * Accepted connections are queued and processed by max_concurrent_jobs workers.
+ * Each worker owns a fixed set of utility objects (timer and stats) that is
+ * cleared before each job.
+ */
+class PartitioningDaemon {
+
+  static constexpr bool debug = false;
+
+ public:
+  explicit PartitioningDaemon(const DaemonParameters& params);
+
+  PartitioningDaemon(const PartitioningDaemon&) = delete;
+  PartitioningDaemon(PartitioningDaemon&&) = delete;
+  PartitioningDaemon & operator= (const PartitioningDaemon &) = delete;
+  PartitioningDaemon & operator= (PartitioningDaemon &&) = delete;
+
+  // ! Accepts jobs on the socket until a shutdown request is received
+  void run();
+
+  // ! Executes the job described by the request line on the
+  // ! utility objects of the given worker and returns the response
+  std::string processRequest(const std::string& request, const size_t worker);
+
+  const InputCache& inputCache() const {
+    return _input_cache;
+  }
+
+ private:
+  void processConnections(const size_t worker);
+
+  void requestShutdown();
+
+  const DaemonParameters _params;
+  InputCache _input_cache;
+  // ! Utility ids are registered upfront, since registering new
+  // ! utility objects while other jobs are running is not thread-safe
+  std::vector<size_t> _utility_ids;
+
+  int _socket;
+  std::atomic<bool> _is_shutdown;
+  std::mutex _queue_mutex;
+  std::condition_variable _queue_cv;
+  std::queue<int> _connections;
+};
+
+}  // namespace io
+}  // namespace mt_kahypar
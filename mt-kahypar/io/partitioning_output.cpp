@@ -149,7 +149,7 @@ namespace mt_kahypar::io {
     const double stdev_hn_weight = utils::parallel_stdev(hn_weights, avg_hn_weight, num_hypernodes);
 
     HyperedgeID num_hyperedges = hypergraph.initialNumEdges();
-    HypernodeID num_pins = hypergraph.initialNumPins();
+    const size_t num_pins = hypergraph.initialNumPins();
     const double avg_he_size = utils::avgHyperedgeDegree(hypergraph);
     hypergraph.doParallelForAllEdges([&](const HyperedgeID& he) {
       he_sizes[he] = hypergraph.edgeSize(he);
@@ -378,29 +378,11 @@ namespace mt_kahypar::io {
 
   void printCutMatrix(const PartitionedHypergraph& hypergraph) {
     const PartitionID k = hypergraph.k();
-
-    using MCell = parallel::IntegralAtomicWrapper<HyperedgeWeight>;
-    using MCol = std::vector<MCell>;
-    std::vector<MCol> cut_matrix(k, MCol(k, MCell(0)));
-
-    hypergraph.doParallelForAllEdges([&](const HyperedgeID& he) {
-      if ( hypergraph.connectivity(he) > 1 ) {
-        const HyperedgeWeight edge_weight = hypergraph.edgeWeight(he);
-        for ( const PartitionID& block_1 : hypergraph.connectivitySet(he) ) {
-          for ( const PartitionID& block_2 : hypergraph.connectivitySet(he) ) {
-            if ( block_1 < block_2 ) {
-              cut_matrix[block_1][block_2] += edge_weight;
-            }
-          }
-        }
-      }
-    });
+    const vec<metrics::BlockPairCut> block_pair_cuts = metrics::blockPairCuts(hypergraph);
 
     HyperedgeWeight max_cut = 0;
-    for ( PartitionID block_1 = 0; block_1 < k; ++block_1 ) {
-      for ( PartitionID block_2 = block_1 + 1; block_2 < k; ++block_2 ) {
-        max_cut = std::max(max_cut, cut_matrix[block_1][block_2].load());
-      }
+    for ( const metrics::BlockPairCut& cut : block_pair_cuts ) {
+      max_cut = std::max(max_cut, cut.weight);
     }
 
     // HEADER
@@ -411,12 +393,17 @@ namespace mt_kahypar::io {
     }
     std::cout << std::endl;
 
-    // CUT MATRIX
+    // CUT MATRIX (the block pairs are sorted, so each row is a consecutive range)
+    size_t pos = 0;
     for ( PartitionID block_1 = 0; block_1 < k; ++block_1 ) {
       std::cout << std::right << std::setw(column_width) << block_1;
       for ( PartitionID block_2 = 0; block_2 < k; ++block_2 ) {
-        std::cout << std::right << std::setw(column_width)
-                  << (Hypergraph::is_graph ? cut_matrix[block_1][block_2].load() / 2 : cut_matrix[block_1][block_2].load());
+        HyperedgeWeight cut_weight = 0;
+        if ( pos < block_pair_cuts.size() && block_pair_cuts[pos].block_0 == block_1 &&
+             block_pair_cuts[pos].block_1 == block_2 ) {
+          cut_weight = block_pair_cuts[pos++].weight;
+        }
+        std::cout << std::right << std::setw(column_width) << cut_weight;
       }
       std::cout << std::endl;
     }
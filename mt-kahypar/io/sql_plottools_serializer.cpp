@@ -55,25 +55,40 @@ std::string serialize(const PartitionedHypergraph& hypergraph,
         << " epsilon=" << context.partition.epsilon
         << " seed=" << context.partition.seed
         << " num_vcycles=" << context.partition.num_vcycles
+        << " localized_vcycles=" << context.partition.localized_vcycles
+        << " localized_vcycle_distance=" << context.partition.localized_vcycle_distance
+        << " anytime=" << context.partition.anytime
         << " deterministic=" << context.partition.deterministic
-        << " perform_parallel_recursion_in_deep_multilevel=" << context.partition.perform_parallel_recursion_in_deep_multilevel;
+        << " perform_parallel_recursion_in_deep_multilevel=" << context.partition.perform_parallel_recursion_in_deep_multilevel
+        << " streaming_buffer_size=" << context.partition.streaming_buffer_size
+        << " streaming_refinement_rounds=" << context.partition.streaming_refinement_rounds
+        << " multisection_k1=" << context.partition.multisection_k1;
     oss << " large_hyperedge_size_threshold_factor=" << context.partition.large_hyperedge_size_threshold_factor
         << " smallest_large_he_size_threshold=" << context.partition.smallest_large_he_size_threshold
         << " large_hyperedge_size_threshold=" << context.partition.large_hyperedge_size_threshold
         << " ignore_hyperedge_size_threshold=" << context.partition.ignore_hyperedge_size_threshold
+        << " large_hyperedge_pin_sample_size=" << context.partition.large_hyperedge_pin_sample_size
+        << " small_instance_num_pins_threshold=" << context.partition.small_instance_num_pins_threshold
         << " time_limit=" << context.partition.time_limit
+        << " memory_limit=" << context.partition.memory_limit
+        << " result_cache_size=" << context.partition.result_cache_size
         << " use_individual_part_weights=" << context.partition.use_individual_part_weights
         << " perfect_balance_part_weight=" << context.partition.perfect_balance_part_weights[0]
         << " max_part_weight=" << context.partition.max_part_weights[0]
         << " total_graph_weight=" << hypergraph.totalWeight();
     oss << " use_community_detection=" << std::boolalpha << context.preprocessing.use_community_detection
         << " disable_community_detection_for_mesh_graphs=" << std::boolalpha << context.preprocessing.disable_community_detection_for_mesh_graphs
+        << " remove_twin_vertices=" << std::boolalpha << context.preprocessing.remove_twin_vertices
+        << " reorder_for_locality=" << std::boolalpha << context.preprocessing.reorder_for_locality
         << " community_edge_weight_function=" << context.preprocessing.community_detection.edge_weight_function
         << " community_max_pass_iterations=" << context.preprocessing.community_detection.max_pass_iterations
         << " community_min_vertex_move_fraction=" << context.preprocessing.community_detection.min_vertex_move_fraction
         << " community_vertex_degree_sampling_threshold=" << context.preprocessing.community_detection.vertex_degree_sampling_threshold
+        << " community_use_active_set_pruning=" << std::boolalpha << context.preprocessing.community_detection.use_active_set_pruning
+        << " community_high_degree_vertex_threshold=" << context.preprocessing.community_detection.high_degree_vertex_threshold
         << " community_num_sub_rounds_deterministic=" << context.preprocessing.community_detection.num_sub_rounds_deterministic
-        << " community_low_memory_contraction=" << context.preprocessing.community_detection.low_memory_contraction;
+        << " community_low_memory_contraction=" << context.preprocessing.community_detection.low_memory_contraction
+        << " community_implicit_star_expansion=" << context.preprocessing.community_detection.implicit_star_expansion;
     oss << " coarsening_algorithm=" << context.coarsening.algorithm
         << " coarsening_contraction_limit_multiplier=" << context.coarsening.contraction_limit_multiplier
         << " coarsening_use_adaptive_edge_size=" << std::boolalpha << context.coarsening.use_adaptive_edge_size
@@ -83,7 +98,19 @@ std::string serialize(const PartitionedHypergraph& hypergraph,
         << " coarsening_max_allowed_node_weight=" << context.coarsening.max_allowed_node_weight
         << " coarsening_vertex_degree_sampling_threshold=" << context.coarsening.vertex_degree_sampling_threshold
         << " coarsening_num_sub_rounds_deterministic=" << context.coarsening.num_sub_rounds_deterministic
+        << " coarsening_low_memory_contraction=" << std::boolalpha << context.coarsening.low_memory_contraction
+        << " coarsening_deterministic_conflict_resolution=" << context.coarsening.deterministic_conflict_resolution
+        << " coarsening_vertex_order_tile_size=" << context.coarsening.vertex_order_tile_size
+        << " coarsening_order_clusters_by_community=" << std::boolalpha << context.coarsening.order_clusters_by_community
+        << " coarsening_use_min_hash_sparsifier=" << std::boolalpha << context.coarsening.use_min_hash_sparsifier
+        << " coarsening_reuse_hierarchy_in_rb=" << std::boolalpha << context.coarsening.reuse_hierarchy_in_rb
+        << " coarsening_min_hash_num_hash_functions=" << context.coarsening.min_hash_num_hash_functions
+        << " coarsening_min_hash_similarity_threshold=" << context.coarsening.min_hash_similarity_threshold
+        << " coarsening_similar_net_combiner_strategy=" << context.coarsening.similar_net_combiner_strategy
+        << " coarsening_nlevel_contraction_batch_size=" << context.coarsening.nlevel_contraction_batch_size
+        << " coarsening_level_arena_factor=" << context.coarsening.level_arena_factor
         << " coarsening_contraction_limit=" << context.coarsening.contraction_limit
+        << " coarsening_offload_min_num_pins=" << context.coarsening.offload_min_num_pins
         << " rating_function=" << context.coarsening.rating.rating_function
         << " rating_heavy_node_penalty_policy=" << context.coarsening.rating.heavy_node_penalty_policy
         << " rating_acceptance_policy=" << context.coarsening.rating.acceptance_policy;
@@ -91,20 +118,32 @@ std::string serialize(const PartitionedHypergraph& hypergraph,
         << " initial_partitioning_runs=" << context.initial_partitioning.runs
         << " initial_partitioning_use_adaptive_ip_runs=" << std::boolalpha << context.initial_partitioning.use_adaptive_ip_runs
         << " initial_partitioning_min_adaptive_ip_runs=" << context.initial_partitioning.min_adaptive_ip_runs
+        << " initial_partitioning_use_ip_racing_scheduler=" << std::boolalpha << context.initial_partitioning.use_ip_racing_scheduler
         << " initial_partitioning_perform_refinement_on_best_partitions=" << std::boolalpha << context.initial_partitioning.perform_refinement_on_best_partitions
         << " initial_partitioning_fm_refinment_rounds=" << std::boolalpha << context.initial_partitioning.fm_refinment_rounds
         << " initial_partitioning_remove_degree_zero_hns_before_ip=" << std::boolalpha << context.initial_partitioning.remove_degree_zero_hns_before_ip
         << " initial_partitioning_lp_maximum_iterations=" << context.initial_partitioning.lp_maximum_iterations
         << " initial_partitioning_lp_initial_block_size=" << context.initial_partitioning.lp_initial_block_size
-        << " initial_partitioning_population_size=" << context.initial_partitioning.population_size;
+        << " initial_partitioning_population_size=" << context.initial_partitioning.population_size
+        << " initial_partitioning_nested_parallelism_min_nodes=" << context.initial_partitioning.nested_parallelism_min_nodes
+        << " initial_partitioning_portfolio_levels=" << context.initial_partitioning.portfolio_levels
+        << " initial_partitioning_heavy_vertex_weight_fraction=" << context.initial_partitioning.heavy_vertex_weight_fraction;
     oss << " refine_until_no_improvement=" << std::boolalpha << context.refinement.refine_until_no_improvement
         << " relative_improvement_threshold=" << context.refinement.relative_improvement_threshold
+        << " fuse_lp_and_fm=" << std::boolalpha << context.refinement.fuse_lp_and_fm
         << " max_batch_size=" << context.refinement.max_batch_size
         << " min_border_vertices_per_thread=" << context.refinement.min_border_vertices_per_thread
+        << " min_border_vertices_fraction=" << context.refinement.min_border_vertices_fraction
+        << " track_objective=" << std::boolalpha << context.refinement.track_objective
+        << " track_cut_nets=" << std::boolalpha << context.refinement.track_cut_nets
+        << " defer_high_degree_moves=" << std::boolalpha << context.refinement.defer_high_degree_moves
+        << " low_value_level_border_fraction=" << context.refinement.low_value_level_border_fraction
+        << " max_uncoarsening_time=" << context.refinement.max_uncoarsening_time
         << " lp_algorithm=" << context.refinement.label_propagation.algorithm
         << " lp_maximum_iterations=" << context.refinement.label_propagation.maximum_iterations
         << " lp_rebalancing=" << std::boolalpha << context.refinement.label_propagation.rebalancing
         << " lp_hyperedge_size_activation_threshold=" << context.refinement.label_propagation.hyperedge_size_activation_threshold
+        << " lp_dense_frontier_threshold=" << context.refinement.label_propagation.dense_frontier_threshold
         << " sync_lp_num_sub_rounds_sync_lp=" << context.refinement.deterministic_refinement.num_sub_rounds_sync_lp
         << " sync_lp_use_active_node_set=" << context.refinement.deterministic_refinement.use_active_node_set
         << " sync_lp_recalculate_gains_on_second_apply=" << context.refinement.deterministic_refinement.recalculate_gains_on_second_apply;
@@ -115,12 +154,17 @@ std::string serialize(const PartitionedHypergraph& hypergraph,
         << " fm_rollback_sensitive_to_num_moves=" << std::boolalpha << context.refinement.fm.iter_moves_on_recalc
         << " fm_rollback_balance_violation_factor=" << context.refinement.fm.rollback_balance_violation_factor
         << " fm_min_improvement=" << context.refinement.fm.min_improvement
+        << " fm_min_expected_improvement=" << context.refinement.fm.min_expected_improvement
         << " fm_release_nodes=" << context.refinement.fm.release_nodes
+        << " fm_adaptive_stop_rule=" << std::boolalpha << context.refinement.fm.adaptive_stop_rule
+        << " fm_bucket_queue_max_gain=" << context.refinement.fm.bucket_queue_max_gain
         << " fm_iter_moves_on_recalc=" << context.refinement.fm.iter_moves_on_recalc
         << " fm_num_seed_nodes=" << context.refinement.fm.num_seed_nodes
         << " fm_time_limit_factor=" << context.refinement.fm.time_limit_factor
         << " fm_obey_minimal_parallelism=" << std::boolalpha << context.refinement.fm.obey_minimal_parallelism
         << " fm_shuffle=" << std::boolalpha << context.refinement.fm.shuffle
+        << " fm_order_seeds_by_gain=" << std::boolalpha << context.refinement.fm.order_seeds_by_gain
+        << " fm_jet_negative_gain_factor=" << context.refinement.fm.jet_negative_gain_factor
         << " global_fm_use_global_fm=" << std::boolalpha << context.refinement.global_fm.use_global_fm
         << " global_fm_refine_until_no_improvement=" << std::boolalpha << context.refinement.global_fm.refine_until_no_improvement
         << " global_fm_num_seed_nodes=" << context.refinement.global_fm.num_seed_nodes
@@ -134,14 +178,32 @@ std::string serialize(const PartitionedHypergraph& hypergraph,
         << " flow_skip_small_cuts=" << std::boolalpha << context.refinement.flows.skip_small_cuts
         << " flow_skip_unpromising_blocks=" << std::boolalpha << context.refinement.flows.skip_unpromising_blocks
         << " flow_pierce_in_bulk=" << std::boolalpha << context.refinement.flows.pierce_in_bulk
+        << " flow_prioritize_block_pairs=" << std::boolalpha << context.refinement.flows.prioritize_block_pairs
+        << " flow_unproductive_block_pair_cut_change=" << context.refinement.flows.unproductive_block_pair_cut_change
+        << " flow_parallel_apply_moves=" << std::boolalpha << context.refinement.flows.parallel_apply_moves
+        << " flow_reorder_nodes=" << std::boolalpha << context.refinement.flows.reorder_nodes
+        << " flow_use_localized_flows=" << std::boolalpha << context.refinement.flows.use_localized_flows
+        << " flow_localized_max_bfs_distance=" << context.refinement.flows.localized_max_bfs_distance
         << " flow_alpha=" << context.refinement.flows.alpha
         << " flow_max_num_pins=" << context.refinement.flows.max_num_pins
+        << " flow_max_num_pins_of_concurrent_searches=" << context.refinement.flows.max_num_pins_of_concurrent_searches
+        << " flow_min_num_pins_for_parallel_flow=" << context.refinement.flows.min_num_pins_for_parallel_flow
+        << " flow_min_num_pins_for_parallel_region_growing=" << context.refinement.flows.min_num_pins_for_parallel_region_growing
         << " flow_find_most_balanced_cut=" << std::boolalpha << context.refinement.flows.find_most_balanced_cut
+        << " flow_most_balanced_cut_portfolio_size=" << context.refinement.flows.most_balanced_cut_portfolio_size
         << " flow_determine_distance_from_cut=" << std::boolalpha << context.refinement.flows.determine_distance_from_cut;
     oss << " num_threads=" << context.shared_memory.num_threads
         << " use_localized_random_shuffle=" << std::boolalpha << context.shared_memory.use_localized_random_shuffle
         << " shuffle_block_size=" << context.shared_memory.shuffle_block_size
-        << " static_balancing_work_packages=" << context.shared_memory.static_balancing_work_packages;
+        << " numa_placement=" << context.shared_memory.numa_placement
+        << " thread_placement=" << context.shared_memory.thread_placement
+        << " fm_num_threads=" << context.shared_memory.fm_num_threads
+        << " contraction_num_threads=" << context.shared_memory.contraction_num_threads
+        << " static_balancing_work_packages=" << context.shared_memory.static_balancing_work_packages
+        << " use_huge_pages=" << std::boolalpha << context.shared_memory.use_huge_pages
+        << " release_memory_between_phases=" << std::boolalpha << context.shared_memory.release_memory_between_phases
+        << " elastic_num_threads=" << std::boolalpha << context.shared_memory.elastic_num_threads
+        << " numa_aware_refinement=" << std::boolalpha << context.shared_memory.numa_aware_refinement;
 
     // Metrics
     if ( hypergraph.initialNumEdges() > 0 ) {
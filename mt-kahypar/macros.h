@@ -52,8 +52,11 @@
 
 #if defined(__GNUC__) || defined(__clang__)
 #define MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE __attribute__ ((always_inline)) inline
+// Read prefetch of the cache line containing ADDR into all cache levels
+#define MT_KAHYPAR_PREFETCH(ADDR) __builtin_prefetch(ADDR, 0, 3)
 #else
 #define MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
+#define MT_KAHYPAR_PREFETCH(ADDR) ((void) (ADDR))
 #endif
 
 #define HEAVY_ASSERT0(cond) \
@@ -31,6 +31,8 @@
 #pragma GCC diagnostic ignored "-Weffc++"
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 template<typename T>
@@ -62,7 +64,46 @@ public:
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE T sub_fetch(T i, std::memory_order m = std::memory_order_seq_cst) {
     return Base::fetch_sub(i, m) - i;
   }
+
+  // ! Adds i (>= 0), if the result does not exceed max_value. Returns false otherwise.
+  // ! In contrast to add_fetch(...) followed by a rollback, a failed attempt does not
+  // ! modify the value. Thus, failed attempts near the limit neither invalidate the
+  // ! cache line in other caches nor let concurrent attempts fail spuriously.
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool add_if_at_most(T i, T max_value, std::memory_order m = std::memory_order_seq_cst) {
+    T current = Base::load(std::memory_order_relaxed);
+    while ( current <= max_value - i ) {
+      if ( Base::compare_exchange_weak(current, current + i, m, std::memory_order_relaxed) ) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+// ! Size of a cache line in bytes
+static constexpr size_t CACHE_LINE_SIZE = 64;
+
+#ifdef KAHYPAR_PAD_HOT_ATOMICS
+// ! Atomic that occupies a whole cache line. Frequently modified atomics that are
+// ! stored next to each other (e.g., the weights of the blocks) are updated by
+// ! different threads. Without padding, they share a cache line and each update
+// ! invalidates the line in the caches of all other threads (false sharing).
+// ! Note that consecutive elements are CACHE_LINE_SIZE bytes apart and therefore
+// ! never share a cache line, even if the array itself is not aligned.
+template<typename T>
+class PaddedCAtomic : public CAtomic<T> {
+  static_assert(sizeof(CAtomic<T>) < CACHE_LINE_SIZE);
+
+public:
+  using CAtomic<T>::CAtomic;
+
+private:
+  uint8_t _padding[CACHE_LINE_SIZE - sizeof(CAtomic<T>)];
 };
+#else
+template<typename T>
+using PaddedCAtomic = CAtomic<T>;
+#endif
 
 class SpinLock {
 public:
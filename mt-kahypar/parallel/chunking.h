@@ -28,8 +28,14 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <algorithm>
 
+#include "tbb/parallel_for.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+
 namespace mt_kahypar::parallel::chunking {
   template <typename T1, typename T2>
   inline auto idiv_ceil(T1 a, T2 b) {
@@ -39,4 +45,79 @@ namespace mt_kahypar::parallel::chunking {
   inline std::pair<size_t, size_t> bounds(size_t i, size_t n, size_t chunk_size) {
     return std::make_pair(i * chunk_size, std::min(n, (i+1) * chunk_size));
   }
+
+  /*!
+   * Splits [0, n) into consecutive chunks of roughly equal work, where weight(i) is the
+   * (estimated) work of index i (e.g., the degree of a vertex or the size of a hyperedge).
+   * On inputs with a skewed degree distribution, the work per index varies by orders of
+   * magnitude and a range splitting based on the number of indices is unbalanced. The chunk
+   * boundaries are computed via a prefix sum over the weights of fixed-size blocks of indices.
+   * Thus, a single chunk can contain more work than the target, if a block contains a very
+   * heavy index.
+   */
+  class WeightedChunks {
+    static constexpr size_t BLOCK_SIZE = 256;
+
+   public:
+    WeightedChunks() :
+      _chunk_bounds() { }
+
+    // ! Computes at most num_chunks chunks of [0, n). Each index contributes
+    // ! weight(i) + 1 such that indices with zero weight are also balanced.
+    template<typename F>
+    void build(const size_t n, const size_t num_chunks, const F& weight) {
+      ASSERT(num_chunks > 0);
+      const size_t num_blocks = idiv_ceil(n, BLOCK_SIZE);
+      vec<uint64_t> block_prefix_sum(num_blocks + 1, 0);
+      tbb::parallel_for(UL(0), num_blocks, [&](const size_t b) {
+        const auto [first, last] = bounds(b, n, BLOCK_SIZE);
+        uint64_t block_weight = 0;
+        for ( size_t i = first; i < last; ++i ) {
+          block_weight += static_cast<uint64_t>(weight(i)) + 1;
+        }
+        block_prefix_sum[b + 1] = block_weight;
+      });
+      for ( size_t b = 0; b < num_blocks; ++b ) {
+        block_prefix_sum[b + 1] += block_prefix_sum[b];
+      }
+
+      const uint64_t target_weight = std::max(uint64_t(1),
+        idiv_ceil(block_prefix_sum.back(), num_chunks));
+      _chunk_bounds.clear();
+      _chunk_bounds.push_back(0);
+      for ( size_t c = 1; c < num_chunks; ++c ) {
+        // First block that starts after the work of the first c chunks
+        const size_t block = std::lower_bound(block_prefix_sum.begin(),
+          block_prefix_sum.end(), c * target_weight) - block_prefix_sum.begin();
+        const size_t bound = std::min(n, block * BLOCK_SIZE);
+        if ( bound > _chunk_bounds.back() && bound < n ) {
+          _chunk_bounds.push_back(bound);
+        }
+      }
+      if ( n > 0 ) {
+        _chunk_bounds.push_back(n);
+      }
+    }
+
+    size_t numChunks() const {
+      return _chunk_bounds.empty() ? 0 : _chunk_bounds.size() - 1;
+    }
+
+    std::pair<size_t, size_t> chunk(const size_t c) const {
+      ASSERT(c < numChunks());
+      return std::make_pair(_chunk_bounds[c], _chunk_bounds[c + 1]);
+    }
+
+    // ! Calls f(first, last) for each chunk in parallel
+    template<typename F>
+    void parallelFor(const F& f) const {
+      tbb::parallel_for(UL(0), numChunks(), [&](const size_t c) {
+        const auto [first, last] = chunk(c);
+        f(first, last);
+      });
+    }
+
+   private:
+    vec<size_t> _chunk_bounds;
+  };
 }
\ No newline at end of file
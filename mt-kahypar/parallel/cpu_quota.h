@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace mt_kahypar {
+namespace parallel {
+
+/*!
+ * Reads the CPU quota of the cgroup of the process. Container platforms may
+ * change the quota while the process is running, which is why the partitioner
+ * can re-check it at phase boundaries (see TBBInitializer::adapt_to_cpu_quota(...)).
+ */
+namespace cpu_quota {
+
+// ! Parses the content of a cgroup v2 cpu.max file ("<quota> <period>" or "max <period>")
+// ! and returns the quota rounded up to full CPUs (0 = unlimited or invalid)
+inline int parse_cgroup_v2_cpu_max(const std::string& content) {
+  std::istringstream in(content);
+  std::string quota;
+  long long period = 0;
+  if ( !(in >> quota >> period) || quota == "max" || period <= 0 ) {
+    return 0;
+  }
+  try {
+    const long long quota_us = std::stoll(quota);
+    return quota_us > 0 ? static_cast<int>(std::ceil(static_cast<double>(quota_us) / period)) : 0;
+  } catch ( ... ) {
+    return 0;
+  }
+}
+
+// ! Returns the quota of a cgroup v1 cpu controller rounded up to full CPUs
+// ! (0 = unlimited or invalid, a quota of -1 means unlimited)
+inline int parse_cgroup_v1_cpu_quota(const long long quota_us, const long long period_us) {
+  if ( quota_us <= 0 || period_us <= 0 ) {
+    return 0;
+  }
+  return static_cast<int>(std::ceil(static_cast<double>(quota_us) / period_us));
+}
+
+// ! CPU quota of the cgroup of the process rounded up to full CPUs (0 = unlimited)
+inline int cgroup_cpu_limit() {
+  std::ifstream cpu_max("/sys/fs/cgroup/cpu.max");
+  if ( cpu_max ) {
+    std::stringstream content;
+    content << cpu_max.rdbuf();
+    return parse_cgroup_v2_cpu_max(content.str());
+  }
+  std::ifstream quota("/sys/fs/cgroup/cpu/cpu.cfs_quota_us");
+  std::ifstream period("/sys/fs/cgroup/cpu/cpu.cfs_period_us");
+  long long quota_us = 0;
+  long long period_us = 0;
+  if ( quota && period && (quota >> quota_us) && (period >> period_us) ) {
+    return parse_cgroup_v1_cpu_quota(quota_us, period_us);
+  }
+  return 0;
+}
+
+}  // namespace cpu_quota
+}  // namespace parallel
+}  // namespace mt_kahypar
@@ -33,6 +33,9 @@
 #include <vector>
 #include <algorithm>
 #include <random>
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 #include "mt-kahypar/macros.h"
 
@@ -246,6 +249,20 @@ class HardwareTopology {
     hwloc_set_membind(_topology, cpuset, HWLOC_MEMBIND_INTERLEAVE, HWLOC_MEMBIND_MIGRATE);
   }
 
+  // ! Binds all pages of the memory area to the NUMA node. Pages that
+  // ! are only partially covered by the memory area are not bound.
+  void bind_memory_to_numa_node(const char* data, const size_t size_in_bytes, const int node) const {
+    ASSERT(node < (int)_numa_nodes.size());
+    ASSERT(_numa_nodes[node].get_id() == node);
+    const uintptr_t page_size = get_page_size();
+    const uintptr_t begin = page_size * ( ( reinterpret_cast<uintptr_t>(data) + page_size - 1 ) / page_size );
+    const uintptr_t end = page_size * ( ( reinterpret_cast<uintptr_t>(data) + size_in_bytes ) / page_size );
+    if ( begin < end ) {
+      hwloc_set_area_membind(_topology, reinterpret_cast<const void*>(begin), end - begin,
+        _numa_nodes[node].get_cpuset(), HWLOC_MEMBIND_BIND, HWLOC_MEMBIND_MIGRATE);
+    }
+  }
+
  private:
   HardwareTopology() :
     _num_cpus(0),
@@ -257,6 +274,14 @@ class HardwareTopology {
     init_numa_nodes();
   }
 
+  static uintptr_t get_page_size() {
+    #ifdef __linux__
+    return sysconf(_SC_PAGESIZE);
+    #else
+    return 4096;
+    #endif
+  }
+
   void init_numa_nodes() {
     Node node = HwTopology::get_first_numa_node(_topology);
     while (node != nullptr) {
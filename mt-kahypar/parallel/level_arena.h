@@ -0,0 +1,201 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+#include "tbb/parallel_for.h"
+#include "tbb/scalable_allocator.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/memory_pool.h"
+
+namespace mt_kahypar {
+namespace parallel {
+
+/*!
+ * Preallocated memory region for the coarse hypergraphs of the multilevel hierarchy.
+ * Each contraction allocates the arrays of a new coarse hypergraph, which are alive
+ * until the end of uncoarsening. With many levels, this results in many large
+ * allocations whose pages are touched for the first time during the contraction.
+ * The arena reserves one region, whose size is derived from the size of the input
+ * hypergraph, and touches it in parallel upfront. Coarse hypergraphs then request
+ * their arrays via a lock-free bump allocation. If the arena is exhausted or not
+ * active, request(...) returns nullptr and the caller falls back to a regular allocation.
+ *
+ * The arena is active while at least one user holds it (see acquire() and release()).
+ * Once the hierarchy is complete, the owner seals the arena such that coarse hypergraphs
+ * created afterwards (e.g., during initial partitioning) do not consume its memory.
+ * Memory is not reclaimed before the last user releases it, thus all arrays allocated
+ * in the arena must be destroyed before.
+ */
+class LevelArena {
+
+  // ! Allocations are aligned to cache lines
+  static constexpr size_t ALIGNMENT = 64;
+  static constexpr size_t PAGE_SIZE = 4096;
+
+ public:
+  LevelArena(const LevelArena&) = delete;
+  LevelArena(LevelArena&&) = delete;
+  LevelArena & operator= (const LevelArena &) = delete;
+  LevelArena & operator= (LevelArena &&) = delete;
+
+  ~LevelArena() {
+    free();
+  }
+
+  static LevelArena& instance() {
+    static LevelArena instance;
+    return instance;
+  }
+
+  // ! Registers a user of the arena. The first user reserves a region of the given size.
+  void acquire(const size_t size_in_bytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if ( _num_users++ == 0 && size_in_bytes > 0 ) {
+      allocate(size_in_bytes);
+    }
+  }
+
+  // ! Unregisters a user of the arena. The region is freed, if it was the last user.
+  void release() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ASSERT(_num_users > 0);
+    if ( --_num_users == 0 ) {
+      free();
+    }
+  }
+
+  // ! No further requests are served until the arena is freed
+  void seal() {
+    _sealed.store(true, std::memory_order_relaxed);
+  }
+
+  // ! Returns uninitialized memory of the given size or nullptr,
+  // ! if the arena is not active, sealed or exhausted
+  char* request(const size_t size_in_bytes) {
+    char* data = _data.load(std::memory_order_acquire);
+    if ( data && size_in_bytes > 0 && !_sealed.load(std::memory_order_relaxed) ) {
+      const size_t aligned_size = alignUp(size_in_bytes);
+      const size_t offset = _offset.fetch_add(aligned_size, std::memory_order_relaxed);
+      if ( offset + aligned_size <= _size_in_bytes ) {
+        return data + offset;
+      }
+      _num_failed_requests.fetch_add(1, std::memory_order_relaxed);
+    }
+    return nullptr;
+  }
+
+  bool isActive() const {
+    return _data.load(std::memory_order_acquire) != nullptr;
+  }
+
+  size_t sizeInBytes() const {
+    return _size_in_bytes;
+  }
+
+  // ! Number of bytes handed out by the arena
+  size_t usedBytes() const {
+    return std::min(_offset.load(std::memory_order_relaxed), _size_in_bytes);
+  }
+
+  // ! Number of requests that did not fit into the arena
+  size_t numFailedRequests() const {
+    return _num_failed_requests.load(std::memory_order_relaxed);
+  }
+
+ private:
+  LevelArena() :
+    _mutex(),
+    _num_users(0),
+    _data(nullptr),
+    _size_in_bytes(0),
+    _huge_page_size(0),
+    _offset(0),
+    _num_failed_requests(0),
+    _sealed(false) { }
+
+  void allocate(const size_t size_in_bytes) {
+    ASSERT(!_data.load());
+    const size_t size = alignUp(size_in_bytes);
+    char* data = MemoryPool::instance().allocate_huge_pages(size);
+    if ( data ) {
+      _huge_page_size = size;
+    } else {
+      data = static_cast<char*>(scalable_aligned_malloc(size, PAGE_SIZE));
+      if ( !data ) {
+        // The coarse hypergraphs use regular allocations
+        return;
+      }
+    }
+    // Touch all pages in parallel such that page faults do not occur during contraction
+    tbb::parallel_for(UL(0), size, PAGE_SIZE * 16, [&](const size_t start) {
+      std::memset(data + start, 0, std::min(PAGE_SIZE * 16, size - start));
+    });
+    MemoryPool::instance().place_memory(data, size);
+    _size_in_bytes = size;
+    _offset.store(0, std::memory_order_relaxed);
+    _num_failed_requests.store(0, std::memory_order_relaxed);
+    _sealed.store(false, std::memory_order_relaxed);
+    _data.store(data, std::memory_order_release);
+  }
+
+  void free() {
+    char* data = _data.exchange(nullptr, std::memory_order_acq_rel);
+    if ( data ) {
+      if ( _huge_page_size > 0 ) {
+        MemoryPool::instance().free_huge_pages(data, _huge_page_size);
+      } else {
+        scalable_aligned_free(data);
+      }
+    }
+    _size_in_bytes = 0;
+    _huge_page_size = 0;
+    _offset.store(0, std::memory_order_relaxed);
+  }
+
+  static size_t alignUp(const size_t size_in_bytes) {
+    return (size_in_bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  }
+
+  std::mutex _mutex;
+  size_t _num_users;
+  std::atomic<char*> _data;
+  size_t _size_in_bytes;
+  // ! Size of the region, if it is backed by huge pages
+  size_t _huge_page_size;
+  std::atomic<size_t> _offset;
+  std::atomic<size_t> _num_failed_requests;
+  std::atomic<bool> _sealed;
+};
+
+}  // namespace parallel
+}  // namespace mt_kahypar
@@ -34,8 +34,10 @@
 #include <atomic>
 #include <vector>
 #include <algorithm>
+#include <functional>
 #ifdef __linux__
 #include <unistd.h>
+#include <sys/mman.h>
 #elif _WIN32
 #include <sysinfoapi.h>
 #endif
@@ -61,6 +63,8 @@ class MemoryPoolT {
   static constexpr size_t kInvalidMemoryChunk = std::numeric_limits<size_t>::max();
 
   static constexpr size_t MINIMUM_ALLOCATION_SIZE = 10000000; // 10 MB
+  // ! Size of a (transparent) huge page on x86-64
+  static constexpr size_t HUGE_PAGE_SIZE = 2097152; // 2 MB
 
   // ! Represents a memory group.
   struct MemoryGroup {
@@ -91,28 +95,35 @@ class MemoryPoolT {
     explicit MemoryChunk(const size_t num_elements,
                          const size_t size) :
       _chunk_mutex(),
+      _registered_num_elements(num_elements),
+      _registered_size(size),
       _num_elements(num_elements),
       _size(size),
       _initial_size(size * num_elements),
       _used_size(size * num_elements),
       _total_size(size * num_elements),
       _data(nullptr),
+      _huge_page_size(0),
       _next_memory_chunk_id(kInvalidMemoryChunk),
       _defer_allocation(false),
       _is_assigned(false) { }
 
     MemoryChunk(MemoryChunk&& other) :
       _chunk_mutex(),
+      _registered_num_elements(other._registered_num_elements),
+      _registered_size(other._registered_size),
       _num_elements(other._num_elements),
       _size(other._size),
       _initial_size(other._initial_size),
       _used_size(other._used_size),
       _total_size(other._total_size),
       _data(std::move(other._data)),
+      _huge_page_size(other._huge_page_size),
       _next_memory_chunk_id(other._next_memory_chunk_id),
       _defer_allocation(other._defer_allocation),
       _is_assigned(other._is_assigned) {
       other._data = nullptr;
+      other._huge_page_size = 0;
       other._next_memory_chunk_id = kInvalidMemoryChunk;
       other._defer_allocation = true;
       other._is_assigned = false;
@@ -156,9 +167,17 @@ class MemoryPoolT {
 
     // ! Allocates the memory chunk
     // ! Note, the memory chunk is zero initialized.
-    bool allocate() {
+    bool allocate(const bool use_huge_pages) {
       if ( !_data && !_defer_allocation ) {
-        _data = (char*) scalable_calloc(_num_elements, _size);
+        const size_t size_in_bytes = _num_elements * _size;
+        if ( use_huge_pages && size_in_bytes >= HUGE_PAGE_SIZE ) {
+          _data = map_huge_pages(size_in_bytes);
+          _huge_page_size = _data ? size_in_bytes : 0;
+        }
+        if ( !_data ) {
+          // Huge pages are disabled or not available
+          _data = (char*) scalable_calloc(_num_elements, _size);
+        }
         return true;
       } else {
         return false;
@@ -168,11 +187,46 @@ class MemoryPoolT {
     // ! Frees the memory chunk
     void free() {
       if ( _data ) {
-        scalable_free(_data);
+        if ( _huge_page_size > 0 ) {
+          unmap_huge_pages(_data, _huge_page_size);
+          _huge_page_size = 0;
+        } else {
+          scalable_free(_data);
+        }
         _data = nullptr;
       }
     }
 
+    // ! Increases the registered size of the memory chunk. Returns true,
+    // ! if the memory chunk has to be reallocated.
+    bool grow(const size_t num_elements, const size_t size) {
+      if ( num_elements * size > _registered_num_elements * _registered_size ) {
+        _registered_num_elements = num_elements;
+        _registered_size = size;
+        return true;
+      }
+      return false;
+    }
+
+    // ! Frees the memory chunk and restores the registered size
+    // ! (undoes memory optimizations)
+    void restore_registered_size() {
+      free();
+      _num_elements = _registered_num_elements;
+      _size = _registered_size;
+      _initial_size = _num_elements * _size;
+      _used_size = _initial_size;
+      _total_size = _initial_size;
+      _next_memory_chunk_id = kInvalidMemoryChunk;
+      _defer_allocation = false;
+      _is_assigned = false;
+    }
+
+    // ! Returns the size in bytes of the memory chunk that is backed by huge pages
+    size_t huge_page_size_in_bytes() const {
+      return _data ? _huge_page_size : 0;
+    }
+
     // ! Returns the size in bytes of the memory chunk
     size_t size_in_bytes() const {
       size_t size = 0;
@@ -193,18 +247,25 @@ class MemoryPoolT {
     }
 
     std::mutex _chunk_mutex;
+    // ! Number of elements and data type size as registered
+    // ! (before memory optimizations are applied)
+    size_t _registered_num_elements;
+    size_t _registered_size;
     // ! Number of elements to allocate
     size_t _num_elements;
     // ! Data type size in bytes
     size_t _size;
     // ! Initial size in bytes of the memory chunk
-    const size_t _initial_size;
+    size_t _initial_size;
     // ! Used size in bytes of the memory chunk
     size_t _used_size;
     // ! Total size in bytes of the memory chunk
     size_t _total_size;
     // ! Memory chunk
     char* _data;
+    // ! Size in bytes of the memory mapping, if the memory chunk is backed
+    // ! by huge pages (otherwise, allocated via scalable_calloc)
+    size_t _huge_page_size;
     // ! Memory chunk id where this memory chunk is transfered
     // ! to if memory is not needed any more
     size_t _next_memory_chunk_id;
@@ -218,6 +279,9 @@ class MemoryPoolT {
 
 
  public:
+  // ! Memory placement is only applied to allocations of at least this size
+  static constexpr size_t MINIMUM_PLACEMENT_SIZE = 10000000; // 10 MB
+
   MemoryPoolT(const MemoryPoolT&) = delete;
   MemoryPoolT & operator= (const MemoryPoolT &) = delete;
 
@@ -265,28 +329,49 @@ class MemoryPoolT {
       if ( !mem_group.containsKey(key) ) {
         mem_group.insert(key, memory_id);
         _memory_chunks.emplace_back(num_elements, size);
+        _requires_reallocation |= _is_initialized;
         DBG << "Registers memory chunk (" << group << "," << key << ")"
             << "of" <<  size_in_megabyte(num_elements * size) << "MB"
             << "in memory pool";
+      } else if ( _memory_chunks[mem_group.getKey(key)].grow(num_elements, size) ) {
+        // Memory chunk is already registered, but the new request is larger
+        // => memory chunk is reallocated in next call to allocate_memory_chunks()
+        _requires_reallocation |= _is_initialized;
+        DBG << "Increases size of memory chunk (" << group << "," << key << ")"
+            << "to" <<  size_in_megabyte(num_elements * size) << "MB";
       }
     }
   }
 
-  // ! Allocates all registered memory chunks in parallel
+  // ! Allocates all registered memory chunks in parallel. If the memory pool
+  // ! is already initialized, memory chunks are only reallocated, if a memory
+  // ! chunk was registered or increased since the last allocation. Note that
+  // ! the memory chunks must not be in use during reallocation.
   void allocate_memory_chunks(const bool optimize_allocations = true) {
     std::unique_lock<std::shared_timed_mutex> lock(_memory_mutex);
+    if ( _is_initialized ) {
+      if ( !_requires_reallocation ) {
+        return;
+      }
+      DBG << "Reallocate memory chunks";
+      tbb::parallel_for(UL(0), _memory_chunks.size(), [&](const size_t i) {
+        _memory_chunks[i].restore_registered_size();
+      });
+    }
     if ( optimize_allocations ) {
       optimize_memory_allocations();
     }
     const size_t num_memory_segments = _memory_chunks.size();
     tbb::parallel_for(UL(0), num_memory_segments, [&](const size_t i) {
-      if (_memory_chunks[i].allocate()) {
+      if (_memory_chunks[i].allocate(_use_huge_pages)) {
         DBG << "Allocate memory chunk of size"
             << size_in_megabyte(_memory_chunks[i].size_in_bytes()) << "MB";
+        place_memory(_memory_chunks[i]._data, _memory_chunks[i].size_in_bytes());
       }
     });
     update_active_memory_chunks();
     _is_initialized = true;
+    _requires_reallocation = false;
   }
 
   // ! Returns the memory chunk registered under the corresponding
@@ -302,7 +387,7 @@ class MemoryPoolT {
     DBG << "Requests memory chunk (" << group << "," << key << ")"
         << "of" <<  size_in_megabyte(size_in_bytes) << "MB"
         << "in memory pool";
-    if ( !_use_minimum_allocation_size || size_in_bytes > MINIMUM_ALLOCATION_SIZE ) {
+    if ( _serves_requests && ( !_use_minimum_allocation_size || size_in_bytes > MINIMUM_ALLOCATION_SIZE ) ) {
       std::shared_lock<std::shared_timed_mutex> lock(_memory_mutex);
       MemoryChunk* chunk = find_memory_chunk(group, key);
 
@@ -325,7 +410,7 @@ class MemoryPoolT {
   char* request_unused_mem_chunk(const size_t num_elements,
                                  const size_t size,
                                  const bool align_with_page_size = true) {
-    if ( _is_initialized ) {
+    if ( _is_initialized && _serves_requests ) {
       DBG << "Request unused memory chunk of"
           << size_in_megabyte(num_elements * size) << "MB";
       const size_t size_in_bytes = num_elements * size;
@@ -392,7 +477,7 @@ class MemoryPoolT {
   void release_mem_group(const std::string& group) {
     std::unique_lock<std::shared_timed_mutex> lock(_memory_mutex);
 
-    if ( _memory_groups.find(group) != _memory_groups.end() ) {
+    if ( _serves_requests && _memory_groups.find(group) != _memory_groups.end() ) {
       ASSERT([&] {
         for ( const auto& key : _memory_groups.at(group)._key_to_memory_id ) {
           const size_t memory_id = key.second;
@@ -426,9 +511,18 @@ class MemoryPoolT {
     }
   }
 
+  // ! Returns memory, which was freed by data structures of a previous phase but
+  // ! is still cached by the scalable allocator, to the operating system
+  void release_allocator_caches() const {
+    scalable_allocation_command(TBBMALLOC_CLEAN_ALL_BUFFERS, nullptr);
+  }
+
   // Resets the memory pool to the state after all memory chunks are allocated
   void reset() {
     std::unique_lock<std::shared_timed_mutex> lock(_memory_mutex);
+    if ( !_serves_requests ) {
+      return;
+    }
 
     // Find all root memory chunks of an optimization path
     std::vector<size_t> in_degree(_memory_chunks.size(), 0);
@@ -460,6 +554,20 @@ class MemoryPoolT {
     update_active_memory_chunks();
   }
 
+  // ! Registers a function that is called for each memory chunk and each large
+  // ! array allocated outside of the memory pool (e.g., to bind it to NUMA nodes)
+  void register_memory_placement_function(std::function<void(const char*, const size_t)> placement) {
+    _memory_placement = std::move(placement);
+  }
+
+  // ! Applies the registered memory placement function to the memory area,
+  // ! if its size is at least MINIMUM_PLACEMENT_SIZE
+  void place_memory(const char* data, const size_t size_in_bytes) const {
+    if ( _memory_placement && size_in_bytes >= MINIMUM_PLACEMENT_SIZE ) {
+      _memory_placement(data, size_in_bytes);
+    }
+  }
+
   // ! Frees all memory chunks in parallel
   void free_memory_chunks() {
     std::unique_lock<std::shared_timed_mutex> lock(_memory_mutex);
@@ -471,6 +579,18 @@ class MemoryPoolT {
     _memory_groups.clear();
     _active_memory_chunks.clear();
     _is_initialized = false;
+    _requires_reallocation = false;
+  }
+
+  // ! Memory chunk requests are only served if enabled (default in
+  // ! application mode). Otherwise, all requests fail and releasing
+  // ! or resetting the memory pool has no effect.
+  void enable_memory_requests() {
+    _serves_requests = true;
+  }
+
+  void disable_memory_requests() {
+    _serves_requests = false;
   }
 
   // ! Only for testing
@@ -483,6 +603,58 @@ class MemoryPoolT {
     _use_minimum_allocation_size = false;
   }
 
+  // ! Memory chunks and large arrays allocated outside of the memory pool
+  // ! are backed by transparent huge pages (if supported by the system)
+  void activate_huge_pages() {
+    _use_huge_pages = true;
+  }
+
+  void deactivate_huge_pages() {
+    _use_huge_pages = false;
+  }
+
+  bool uses_huge_pages() const {
+    return _use_huge_pages;
+  }
+
+  // ! Allocates zero-initialized memory backed by huge pages for arrays
+  // ! outside of the memory pool. Returns nullptr, if huge pages are
+  // ! disabled, the size is smaller than a huge page or the allocation fails.
+  char* allocate_huge_pages(const size_t size_in_bytes) {
+    char* data = nullptr;
+    if ( _use_huge_pages && size_in_bytes >= HUGE_PAGE_SIZE ) {
+      data = map_huge_pages(size_in_bytes);
+      if ( data ) {
+        _huge_page_size_of_arrays.fetch_add(size_in_bytes, std::memory_order_relaxed);
+      }
+    }
+    return data;
+  }
+
+  // ! Frees memory allocated via allocate_huge_pages(...)
+  void free_huge_pages(char* data, const size_t size_in_bytes) {
+    if ( data ) {
+      unmap_huge_pages(data, size_in_bytes);
+      _huge_page_size_of_arrays.fetch_sub(size_in_bytes, std::memory_order_relaxed);
+    }
+  }
+
+  // ! Returns the size in bytes of all memory chunks backed by huge pages
+  size_t huge_page_size_of_memory_chunks() const {
+    std::shared_lock<std::shared_timed_mutex> lock(_memory_mutex);
+    size_t size = 0;
+    for ( const MemoryChunk& chunk : _memory_chunks ) {
+      size += chunk.huge_page_size_in_bytes();
+    }
+    return size;
+  }
+
+  // ! Returns the size in bytes of all arrays outside of the
+  // ! memory pool that are currently backed by huge pages
+  size_t huge_page_size_of_arrays() const {
+    return _huge_page_size_of_arrays.load(std::memory_order_relaxed);
+  }
+
   void activate_unused_memory_allocations() {
     _use_unused_memory_chunks = true;
   }
@@ -574,12 +746,26 @@ class MemoryPoolT {
     LOG << "  Size of registered memory chunks         =" << size_in_megabyte(total_size) << "MB";
     LOG << "  Initial allocated size of memory chunks  =" << size_in_megabyte(allocated_size) << "MB";
     LOG << "  Saved memory due to memory optimizations =" << size_in_megabyte(total_size - allocated_size) << "MB";
+    if ( _use_huge_pages ) {
+      size_t huge_page_size = 0;
+      for ( const MemoryChunk& chunk : _memory_chunks ) {
+        huge_page_size += chunk.huge_page_size_in_bytes();
+      }
+      LOG << "  Huge-page backed memory chunks           =" << size_in_megabyte(huge_page_size) << "MB";
+      LOG << "  Huge-page backed arrays outside of pool  =" << size_in_megabyte(huge_page_size_of_arrays()) << "MB";
+    }
   }
 
  private:
   explicit MemoryPoolT() :
     _memory_mutex(),
     _is_initialized(false),
+    _requires_reallocation(false),
+    #ifdef MT_KAHYPAR_LIBRARY_MODE
+    _serves_requests(false),
+    #else
+    _serves_requests(true),
+    #endif
     _page_size(0),
     _memory_groups(),
     _memory_chunks(),
@@ -587,7 +773,10 @@ class MemoryPoolT {
     _active_memory_chunks(),
     _use_round_robin_assignment(true),
     _use_minimum_allocation_size(true),
-    _use_unused_memory_chunks(true) { 
+    _use_unused_memory_chunks(true),
+    _use_huge_pages(false),
+    _huge_page_size_of_arrays(0),
+    _memory_placement() {
     #ifdef __linux__
       _page_size = sysconf(_SC_PAGE_SIZE);
     #elif _WIN32
@@ -597,6 +786,55 @@ class MemoryPoolT {
     #endif
   }
 
+  static size_t align_with_huge_page_size(const size_t size_in_bytes) {
+    return HUGE_PAGE_SIZE * ( size_in_bytes / HUGE_PAGE_SIZE +
+      ( ( size_in_bytes % HUGE_PAGE_SIZE ) != 0 ) );
+  }
+
+  // ! Maps anonymous (zero-initialized) memory aligned at a huge page boundary
+  // ! and advises the kernel to back it with transparent huge pages.
+  // ! Returns nullptr, if the mapping fails.
+  static char* map_huge_pages(const size_t size_in_bytes) {
+    #if defined(__linux__) && defined(MADV_HUGEPAGE)
+    const size_t size = align_with_huge_page_size(size_in_bytes);
+    // We map one additional huge page such that we can align the
+    // start of the memory area and unmap the unaligned head and tail
+    const size_t mapped_size = size + HUGE_PAGE_SIZE;
+    void* mapping = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if ( mapping == MAP_FAILED ) {
+      return nullptr;
+    }
+    char* begin = static_cast<char*>(mapping);
+    const uintptr_t address = reinterpret_cast<uintptr_t>(begin);
+    const size_t head = align_with_huge_page_size(address) - address;
+    const size_t tail = mapped_size - head - size;
+    if ( head > 0 ) {
+      munmap(begin, head);
+    }
+    if ( tail > 0 ) {
+      munmap(begin + head + size, tail);
+    }
+    char* data = begin + head;
+    // If transparent huge pages are disabled, madvise fails and
+    // the memory remains backed by regular pages
+    madvise(data, size, MADV_HUGEPAGE);
+    return data;
+    #else
+    unused(size_in_bytes);
+    return nullptr;
+    #endif
+  }
+
+  static void unmap_huge_pages(char* data, const size_t size_in_bytes) {
+    #if defined(__linux__) && defined(MADV_HUGEPAGE)
+    munmap(data, align_with_huge_page_size(size_in_bytes));
+    #else
+    unused(data);
+    unused(size_in_bytes);
+    #endif
+  }
+
   // ! Returns a pointer to memory chunk under the corresponding group with
   // ! the specified key.
   MemoryChunk* find_memory_chunk(const std::string& group,
@@ -729,6 +967,10 @@ class MemoryPoolT {
   mutable std::shared_timed_mutex _memory_mutex;
   // ! Initialize Flag
   bool _is_initialized;
+  // ! True, if a memory chunk was registered or increased after allocation
+  bool _requires_reallocation;
+  // ! If false, all memory chunk requests fail
+  std::atomic<bool> _serves_requests;
   // ! Page size of the system
   size_t _page_size;
   // ! Mapping from group-key to a memory chunk id
@@ -744,101 +986,23 @@ class MemoryPoolT {
   bool _use_round_robin_assignment;
   bool _use_minimum_allocation_size;
   bool _use_unused_memory_chunks;
+  // ! Memory chunks and large arrays are backed by huge pages
+  bool _use_huge_pages;
+  // ! Size in bytes of arrays outside of the memory pool backed by huge pages
+  std::atomic<size_t> _huge_page_size_of_arrays;
+  // ! Places large allocations on NUMA nodes
+  std::function<void(const char*, const size_t)> _memory_placement;
 };
 
 /**
  * Currently, the memory pool only works if we partition one instance at a time.
  * However, when using the library interface, it is possible that several
- * instances are partitioned simultanously. Therefore, we disable the memory
- * pool in case we compile the library interface.
+ * instances are partitioned simultanously. Therefore, the memory pool does not
+ * serve any requests in case we compile the library interface, except during
+ * the calls of a partitioner session (see mt_kahypar_session_t), which
+ * explicitly enables it.
  */
-class DoNothingMemoryPool {
-
- public:
-  DoNothingMemoryPool(const DoNothingMemoryPool&) = delete;
-  DoNothingMemoryPool & operator= (const DoNothingMemoryPool &) = delete;
-
-  DoNothingMemoryPool(DoNothingMemoryPool&&) = delete;
-  DoNothingMemoryPool & operator= (DoNothingMemoryPool &&) = delete;
-
-  static DoNothingMemoryPool& instance() {
-    static DoNothingMemoryPool instance;
-    return instance;
-  }
-
-  bool isInitialized() const {
-    return true;
-  }
-
-  void register_memory_group(const std::string&,
-                             const size_t) { }
-
-  void register_memory_chunk(const std::string&,
-                             const std::string&,
-                             const size_t,
-                             const size_t) { }
-
-  void allocate_memory_chunks() { }
-  void allocate_memory_chunks(const bool) { }
-
-  char* request_mem_chunk(const std::string&,
-                          const std::string&,
-                          const size_t,
-                          const size_t) {
-    return nullptr;
-  }
-
-  char* request_unused_mem_chunk(const size_t,
-                                 const size_t) {
-    return nullptr;
-  }
-  char* request_unused_mem_chunk(const size_t,
-                                 const size_t,
-                                 const bool) {
-    return nullptr;
-  }
-
-  char* mem_chunk(const std::string&,
-                  const std::string&) {
-    return nullptr;
-  }
-  void release_mem_chunk(const std::string&,
-                         const std::string&) { }
-
-  void release_mem_group(const std::string&) { }
-
-  void reset() { }
-
-  void free_memory_chunks() {}
-
-  // ! Only for testing
-  void deactivate_round_robin_assignment() { }
-
-  // ! Only for testing
-  void deactivate_minimum_allocation_size() { }
-
-  void activate_unused_memory_allocations() { }
-
-  void deactivate_unused_memory_allocations() { }
-
-  size_t size_in_bytes(const std::string&,
-                       const std::string&) {
-    return 0;
-  }
-
-  void memory_consumption(utils::MemoryTreeNode*) const { }
-
-  void explain_optimizations() const { }
-
- private:
-  DoNothingMemoryPool() { }
-};
-
-#ifdef MT_KAHYPAR_LIBRARY_MODE
-using MemoryPool = DoNothingMemoryPool;
-#else
 using MemoryPool = MemoryPoolT;
-#endif
 
 }  // namespace parallel
 }  // namespace mt_kahypar
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include "tbb/parallel_for.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/atomic_wrapper.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+#include "mt-kahypar/utils/memory_tree.h"
+
+namespace mt_kahypar {
+
+/**
+ * Relaxed concurrent max-priority queue (MultiQueue). The queue consists of
+ * several sequential binary heaps, each protected by a spin lock. An element
+ * is extracted from the better of two randomly chosen heaps. Thus, extracted
+ * elements are not necessarily the global maximum, but have a high priority
+ * with high probability.
+ *
+ * Similar to the WorkContainer, the queue has an insertion phase in which
+ * each thread inserts into its own heaps (no concurrent extractions allowed)
+ * followed by an extraction phase that must be started by calling build().
+ */
+template<typename T, typename Key>
+class MultiQueue {
+
+  static constexpr size_t QUEUES_PER_THREAD = 2;
+  static constexpr Key EMPTY = std::numeric_limits<Key>::min();
+
+  struct Entry {
+    Key key;
+    T element;
+
+    bool operator< (const Entry& other) const {
+      return key < other.key;
+    }
+  };
+
+  struct Queue {
+    Queue() :
+      lock(),
+      top(EMPTY),
+      heap() { }
+
+    void updateTop() {
+      top.store(heap.empty() ? EMPTY : heap.front().key, std::memory_order_release);
+    }
+
+    SpinLock lock;
+    // ! Key of the top element (read without holding the lock)
+    CAtomic<Key> top;
+    vec<Entry> heap;
+  };
+
+  // ! Padded to a cache line to avoid false sharing between threads
+  struct RandomState {
+    uint64_t state = 0;
+    uint8_t padding[56];
+  };
+
+ public:
+  explicit MultiQueue(const size_t num_threads = 0) :
+    _queues(),
+    _random_states() {
+    initialize(num_threads);
+  }
+
+  void initialize(const size_t num_threads) {
+    _queues.assign(QUEUES_PER_THREAD * num_threads, Queue());
+    _random_states.assign(num_threads, RandomState());
+    for ( size_t i = 0; i < num_threads; ++i ) {
+      _random_states[i].state = 0x9E3779B97F4A7C15ULL * (i + 1);
+    }
+  }
+
+  size_t unsafe_size() const {
+    size_t sz = 0;
+    for ( const Queue& q : _queues ) {
+      sz += q.heap.size();
+    }
+    return sz;
+  }
+
+  // ! Assumes that no thread is currently calling try_pop. Each
+  // ! thread only inserts into its own heaps.
+  void safe_push(const T el, const Key key, const size_t thread_id) {
+    ASSERT(thread_id < _random_states.size());
+    ASSERT(key > EMPTY, "Minimum key is reserved for empty heaps");
+    const size_t q = thread_id * QUEUES_PER_THREAD + nextRandom(thread_id) % QUEUES_PER_THREAD;
+    _queues[q].heap.push_back(Entry { key, el });
+  }
+
+  // ! Establishes the heap property of all heaps. Must be called
+  // ! after the insertion and before the extraction phase.
+  void build() {
+    tbb::parallel_for(UL(0), _queues.size(), [&](const size_t i) {
+      std::make_heap(_queues[i].heap.begin(), _queues[i].heap.end());
+      _queues[i].updateTop();
+    });
+  }
+
+  // ! Extracts an element with high priority. Returns false, if all heaps are empty.
+  bool try_pop(T& dest, const size_t thread_id) {
+    ASSERT(thread_id < _random_states.size());
+    const size_t num_queues = _queues.size();
+    if ( num_queues == 0 ) {
+      return false;
+    }
+    // Two-choice extraction: lock the better of two random heaps
+    for ( size_t attempt = 0; attempt < num_queues; ++attempt ) {
+      const size_t q1 = nextRandom(thread_id) % num_queues;
+      const size_t q2 = nextRandom(thread_id) % num_queues;
+      const Key k1 = _queues[q1].top.load(std::memory_order_acquire);
+      const Key k2 = _queues[q2].top.load(std::memory_order_acquire);
+      if ( k1 == EMPTY && k2 == EMPTY ) {
+        break;
+      }
+      Queue& q = _queues[k1 >= k2 ? q1 : q2];
+      if ( q.lock.tryLock() ) {
+        const bool success = pop(q, dest);
+        q.lock.unlock();
+        if ( success ) {
+          return true;
+        }
+      }
+    }
+    // Most heaps are empty => scan all heaps
+    for ( Queue& q : _queues ) {
+      if ( q.top.load(std::memory_order_acquire) != EMPTY ) {
+        q.lock.lock();
+        const bool success = pop(q, dest);
+        q.lock.unlock();
+        if ( success ) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  void clear() {
+    for ( Queue& q : _queues ) {
+      q.heap.clear();
+      q.updateTop();
+    }
+  }
+
+  void memoryConsumption(utils::MemoryTreeNode* parent) const {
+    ASSERT(parent);
+
+    utils::MemoryTreeNode* multi_queue_node = parent->addChild("Multi Queue");
+    for ( const Queue& q : _queues ) {
+      multi_queue_node->updateSize(q.heap.capacity() * sizeof(Entry));
+    }
+  }
+
+ private:
+  bool pop(Queue& q, T& dest) {
+    if ( q.heap.empty() ) {
+      return false;
+    }
+    std::pop_heap(q.heap.begin(), q.heap.end());
+    dest = q.heap.back().element;
+    q.heap.pop_back();
+    q.updateTop();
+    return true;
+  }
+
+  // ! xorshift64
+  size_t nextRandom(const size_t thread_id) {
+    uint64_t& x = _random_states[thread_id].state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return static_cast<size_t>(x);
+  }
+
+  vec<Queue> _queues;
+  vec<RandomState> _random_states;
+};
+
+}  // namespace mt_kahypar
@@ -62,19 +62,25 @@ vec<uint32_t> counting_sort(const InputRange& input, OutputRange& output,
       }
     });
 
-    // prefix sum local bucket sizes for local offsets
-    if (max_num_buckets > 1 << 10) {
-      tbb::parallel_for(UL(0), max_num_buckets, [&](size_t bucket) {
-        for (size_t i = 1; i < num_tasks; ++i) {
-          thread_local_bucket_ends[i][bucket] += thread_local_bucket_ends[i - 1][bucket]; // EVIL for locality!
+    // prefix sum local bucket sizes for local offsets.
+    // adds the bucket counts of consecutive tasks row by row over a block of buckets,
+    // which accesses memory contiguously and can be vectorized
+    auto add_previous_task_counts = [&](const size_t first_bucket, const size_t last_bucket) {
+      for (size_t i = 1; i < num_tasks; ++i) {
+        const uint32_t* previous = thread_local_bucket_ends[i - 1].data();
+        uint32_t* current = thread_local_bucket_ends[i].data();
+        for (size_t bucket = first_bucket; bucket < last_bucket; ++bucket) {
+          current[bucket] += previous[bucket];
         }
+      }
+    };
+    if (max_num_buckets > 1 << 10) {
+      tbb::parallel_for(tbb::blocked_range<size_t>(UL(0), max_num_buckets, 1 << 10),
+                        [&](const tbb::blocked_range<size_t>& r) {
+        add_previous_task_counts(r.begin(), r.end());
       });
     } else {
-      for (size_t bucket = 0; bucket < max_num_buckets; ++bucket) {
-        for (size_t i = 1; i < num_tasks; ++i) {
-          thread_local_bucket_ends[i][bucket] += thread_local_bucket_ends[i - 1][bucket]; // EVIL for locality!
-        }
-      }
+      add_previous_task_counts(0, max_num_buckets);
     }
 
     // prefix sum over bucket
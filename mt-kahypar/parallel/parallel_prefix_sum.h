@@ -27,61 +27,21 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <numeric>
+#include <thread>
 #include <vector>
 
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_scan.h>
+#include <tbb/task_arena.h>
 
 #include "mt-kahypar/parallel/stl/scalable_vector.h"
 
 namespace mt_kahypar {
 
-  template<typename InIt, typename OutIt, typename BinOp>
-  struct ParallelPrefixSumBody {
-    using T = typename ::std::iterator_traits<InIt>::value_type;
-
-    InIt first;
-    OutIt out;
-    T sum, neutral_element;
-    BinOp& f;
-
-    ParallelPrefixSumBody(InIt first, OutIt out, T neutral_element, BinOp& f):
-      first(first),
-      out(out),
-      sum(neutral_element),
-      neutral_element(neutral_element),
-      f(f) { }
-
-    ParallelPrefixSumBody(ParallelPrefixSumBody& other, tbb::split) :
-      first(other.first),
-      out(other.out),
-      sum(other.neutral_element),
-      neutral_element(other.neutral_element),
-      f(other.f) { }
-
-    void operator()(const tbb::blocked_range<size_t>& r, tbb::pre_scan_tag ) {
-      for (size_t i = r.begin(); i < r.end(); ++i) {
-        sum = f(sum, *(first + i));
-      }
-    }
-
-    void operator()(const tbb::blocked_range<size_t>& r, tbb::final_scan_tag ) {
-      for (size_t i = r.begin(); i < r.end(); ++i) {
-        sum = f(sum, *(first + i));
-        *(out + i) = sum;
-      }
-    }
-
-    void reverse_join(ParallelPrefixSumBody& other) {
-      sum = f(sum, other.sum);
-    }
-
-    void assign(ParallelPrefixSumBody& other) {
-      sum = other.sum;
-    }
-
-  };
-
   template <class InIt, class OutIt, class BinOp>
   static void sequential_prefix_sum(InIt first, InIt last, OutIt d, typename std::iterator_traits<InIt>::value_type init, BinOp f) {
     while (first != last) {
@@ -102,8 +62,64 @@ namespace mt_kahypar {
       return sequential_prefix_sum(first, last, d, neutral_element, f);
     }
 
-    ParallelPrefixSumBody<InIt, OutIt, BinOp> body(first, d, neutral_element, f);
-    tbb::parallel_scan(tbb::blocked_range<size_t>(0, static_cast<size_t>(n)), body);
+    using T = typename std::iterator_traits<InIt>::value_type;
+    static constexpr size_t BLOCK_SIZE = 1 << 12;
+    static constexpr uint8_t NOT_READY = 0;
+    static constexpr uint8_t AGGREGATE_READY = 1;
+    static constexpr uint8_t PREFIX_READY = 2;
+
+    // Single-pass scan with decoupled look-back (Merrill and Garland). Blocks are
+    // claimed in increasing order. Each block publishes its aggregate and afterwards
+    // its inclusive prefix. Its exclusive prefix is then obtained by looking back at
+    // the published values of its predecessors, which are already in progress.
+    // Thus, the final scan of a block reads its elements from cache and the input is
+    // read only once from memory (tbb::parallel_scan reads it twice).
+    const size_t num_elements = static_cast<size_t>(n);
+    const size_t num_blocks = (num_elements + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    std::unique_ptr<std::atomic<uint8_t>[]> status(new std::atomic<uint8_t>[num_blocks]());
+    vec<T> aggregate(num_blocks, neutral_element);
+    vec<T> inclusive_prefix(num_blocks, neutral_element);
+    std::atomic<size_t> next_block(0);
+
+    const size_t num_tasks = std::min(num_blocks,
+      static_cast<size_t>(tbb::this_task_arena::max_concurrency()));
+    tbb::parallel_for(size_t(0), num_tasks, [&](const size_t) {
+      for ( size_t block = next_block++; block < num_blocks; block = next_block++ ) {
+        const size_t begin = block * BLOCK_SIZE;
+        const size_t end = std::min(begin + BLOCK_SIZE, num_elements);
+        T local_sum = neutral_element;
+        for ( size_t i = begin; i < end; ++i ) {
+          local_sum = f(local_sum, *(first + i));
+        }
+
+        T exclusive_prefix = neutral_element;
+        if ( block > 0 ) {
+          aggregate[block] = local_sum;
+          status[block].store(AGGREGATE_READY, std::memory_order_release);
+          for ( size_t pred = block; pred > 0; ) {
+            --pred;
+            uint8_t pred_status = status[pred].load(std::memory_order_acquire);
+            while ( pred_status == NOT_READY ) {
+              std::this_thread::yield();
+              pred_status = status[pred].load(std::memory_order_acquire);
+            }
+            if ( pred_status == PREFIX_READY ) {
+              exclusive_prefix = f(inclusive_prefix[pred], exclusive_prefix);
+              break;
+            }
+            exclusive_prefix = f(aggregate[pred], exclusive_prefix);
+          }
+        }
+        inclusive_prefix[block] = f(exclusive_prefix, local_sum);
+        status[block].store(PREFIX_READY, std::memory_order_release);
+
+        T sum = exclusive_prefix;
+        for ( size_t i = begin; i < end; ++i ) {
+          sum = f(sum, *(first + i));
+          *(d + i) = sum;
+        }
+      }
+    });
   }
 
 }
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "tbb/parallel_for.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/chunking.h"
+#include "mt-kahypar/parallel/parallel_counting_sort.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+
+namespace mt_kahypar::parallel {
+
+static constexpr size_t RADIX_SORT_BITS_PER_PASS = 11;
+
+// Sorts data by the integral key get_key(element) <= max_key with a least-significant-digit
+// radix sort. Each pass is a stable counting sort over the next RADIX_SORT_BITS_PER_PASS bits
+// of the key. Thus, the work of each task only depends on the number of elements and not on
+// the distribution of the keys. buffer is used as scratch memory.
+template <class T, class KeyFunc>
+void radix_sort(vec<T>& data, vec<T>& buffer, const uint64_t max_key,
+                KeyFunc& get_key, const size_t num_tasks) {
+  constexpr size_t num_buckets = UL(1) << RADIX_SORT_BITS_PER_PASS;
+  buffer.resize(data.size());
+  size_t shift = 0;
+  do {
+    auto get_digit = [&](const T& element) -> size_t {
+      return (get_key(element) >> shift) & (num_buckets - 1);
+    };
+    counting_sort(data, buffer, num_buckets, get_digit, num_tasks);
+    std::swap(data, buffer);
+    shift += RADIX_SORT_BITS_PER_PASS;
+  } while ( shift < 64 && (max_key >> shift) > 0 );
+}
+
+// Reduces each maximal run of consecutive elements of data for which same_run(data[i - 1], data[i])
+// holds. The range is split into chunks of equal size and the partial results of runs spanning several
+// chunks are combined afterwards, such that long runs do not serialize the reduction. write(i, value)
+// is called exactly once (and possibly concurrently) for the first position i of each run.
+template <class Range, class SameRun, class Combine, class Write>
+void reduce_runs(const Range& data, const SameRun& same_run, const Combine& combine,
+                 const Write& write, const size_t num_tasks) {
+  using T = std::decay_t<decltype(data[0])>;
+  const size_t n = data.size();
+  if ( n == 0 ) {
+    return;
+  }
+  const size_t num_chunks = std::min(n, std::max(UL(1), 4 * num_tasks));
+  const size_t chunk_size = chunking::idiv_ceil(n, num_chunks);
+
+  // Partial result of the elements at the front of a chunk that continue a run of a previous chunk
+  vec<T> leading(num_chunks);
+  vec<uint8_t> has_leading(num_chunks, false);
+  vec<uint8_t> leading_covers_chunk(num_chunks, false);
+  // Partial result of the last run of a chunk, if it continues in the next chunk
+  vec<T> trailing(num_chunks);
+  vec<size_t> trailing_begin(num_chunks, n);
+  tbb::parallel_for(UL(0), num_chunks, [&](const size_t chunk) {
+    const auto [first, last] = chunking::bounds(chunk, n, chunk_size);
+    size_t i = first;
+    if ( i > 0 && i < last && same_run(data[i - 1], data[i]) ) {
+      T value = data[i++];
+      while ( i < last && same_run(data[i - 1], data[i]) ) {
+        combine(value, data[i++]);
+      }
+      leading[chunk] = value;
+      has_leading[chunk] = true;
+      leading_covers_chunk[chunk] = i == last;
+    }
+    while ( i < last ) {
+      const size_t run_begin = i;
+      T value = data[i++];
+      while ( i < last && same_run(data[i - 1], data[i]) ) {
+        combine(value, data[i++]);
+      }
+      if ( i < n && same_run(data[i - 1], data[i]) ) {
+        trailing[chunk] = value;
+        trailing_begin[chunk] = run_begin;
+      } else {
+        write(run_begin, value);
+      }
+    }
+  });
+
+  // Each leading part belongs to exactly one trailing run => linear in the number of chunks
+  for ( size_t chunk = 0; chunk < num_chunks; ++chunk ) {
+    if ( trailing_begin[chunk] < n ) {
+      T value = trailing[chunk];
+      for ( size_t next = chunk + 1; next < num_chunks && has_leading[next]; ++next ) {
+        combine(value, leading[next]);
+        if ( !leading_covers_chunk[next] ) {
+          break;
+        }
+      }
+      write(trailing_begin[chunk], value);
+    }
+  }
+}
+
+}  // namespace mt_kahypar::parallel
@@ -0,0 +1,57 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+#include "tbb/task_arena.h"
+
+namespace mt_kahypar {
+namespace parallel {
+
+/*!
+ * Executes f in a nested task arena with max_threads thread slots and returns
+ * its result. This limits (or extends, if the enclosing task arena has fewer
+ * slots) the number of threads working on a phase of the partitioner, e.g.,
+ * memory-bound phases often do not profit from all hyperthreads of a core.
+ * The threads are still drawn from the global thread pool. If max_threads is
+ * zero or equals the concurrency of the enclosing task arena, f is executed
+ * directly.
+ */
+template<typename F>
+auto executeWithConcurrencyLimit(const size_t max_threads, const F& f) -> decltype(f()) {
+  if ( max_threads > 0 &&
+       static_cast<int>(max_threads) != tbb::this_task_arena::max_concurrency() ) {
+    tbb::task_arena arena(static_cast<int>(max_threads));
+    return arena.execute(f);
+  } else {
+    return f();
+  }
+}
+
+}  // namespace parallel
+}  // namespace mt_kahypar
@@ -0,0 +1,189 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "tbb/scalable_allocator.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+
+namespace mt_kahypar {
+namespace parallel {
+
+/*!
+ * Thread-local bump allocator for temporary arrays of refinement algorithms.
+ * Refiners are called on each level of the multilevel hierarchy (and many more
+ * times in the n-level and deep multilevel scheme). Allocating their temporary
+ * arrays in each call puts pressure on the memory allocator. The arena retains
+ * its memory and allocations are released in bulk when the enclosing scope ends.
+ *
+ * Each thread has its own arena (see local()). All allocations must be made
+ * inside a ScratchArena::Scope on the same thread and must not be used after the
+ * scope ends. Scopes are strictly nested, which also holds for TBB tasks stolen
+ * by a thread that waits for the completion of a parallel loop. Only trivially
+ * destructible types can be allocated, since no destructors are called.
+ */
+class ScratchArena {
+
+  static constexpr size_t MIN_BLOCK_SIZE = 1UL << 16; // 64 KB
+
+  struct Block {
+    char* data;
+    size_t size;
+  };
+
+  struct Position {
+    size_t block;
+    size_t offset;
+  };
+
+ public:
+  // ! Releases all allocations of the arena made after
+  // ! its construction when it goes out of scope
+  class Scope {
+   public:
+    Scope() :
+      _arena(ScratchArena::local()),
+      _position(_arena._position) { }
+
+    Scope(const Scope&) = delete;
+    Scope(Scope&&) = delete;
+    Scope & operator= (const Scope &) = delete;
+    Scope & operator= (Scope &&) = delete;
+
+    ~Scope() {
+      _arena._position = _position;
+    }
+
+   private:
+    ScratchArena& _arena;
+    const Position _position;
+  };
+
+  ScratchArena() :
+    _blocks(),
+    _position { 0, 0 } { }
+
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena(ScratchArena&&) = delete;
+  ScratchArena & operator= (const ScratchArena &) = delete;
+  ScratchArena & operator= (ScratchArena &&) = delete;
+
+  ~ScratchArena() {
+    for ( Block& block : _blocks ) {
+      scalable_aligned_free(block.data);
+    }
+  }
+
+  // ! Arena of the calling thread
+  static ScratchArena& local() {
+    static thread_local ScratchArena arena;
+    return arena;
+  }
+
+  // ! Allocates an uninitialized array of n elements
+  template<typename T>
+  T* allocate(const size_t n) {
+    static_assert(std::is_trivially_destructible<T>::value,
+      "Destructors of objects in the scratch arena are not called");
+    return reinterpret_cast<T*>(allocateBytes(n * sizeof(T), alignof(T)));
+  }
+
+  // ! Allocates an array of n elements initialized with value
+  template<typename T>
+  T* allocate(const size_t n, const T& value) {
+    T* data = allocate<T>(n);
+    std::uninitialized_fill_n(data, n, value);
+    return data;
+  }
+
+  // ! Number of bytes retained by the arena
+  size_t sizeInBytes() const {
+    size_t size = 0;
+    for ( const Block& block : _blocks ) {
+      size += block.size;
+    }
+    return size;
+  }
+
+ private:
+  char* allocateBytes(const size_t size, const size_t alignment) {
+    ASSERT(alignment <= MAX_ALIGNMENT);
+    while ( _position.block < _blocks.size() ) {
+      const Block& block = _blocks[_position.block];
+      const size_t offset = alignUp(_position.offset, alignment);
+      if ( offset + size <= block.size ) {
+        _position.offset = offset + size;
+        return block.data + offset;
+      } else if ( _position.block + 1 < _blocks.size() &&
+                  _blocks[_position.block + 1].size >= size ) {
+        // Continue in the next retained block
+        _position = Position { _position.block + 1, 0 };
+      } else {
+        break;
+      }
+    }
+
+    // The retained blocks behind the current position are not in use
+    // and too small => replace them with a larger block
+    const size_t first_unused_block = std::min(_position.block + 1, _blocks.size());
+    size_t block_size = std::max(MIN_BLOCK_SIZE, size);
+    for ( size_t i = 0; i < _blocks.size(); ++i ) {
+      block_size = std::max(block_size, 2 * _blocks[i].size);
+      if ( i >= first_unused_block ) {
+        scalable_aligned_free(_blocks[i].data);
+      }
+    }
+    _blocks.resize(first_unused_block);
+    char* data = static_cast<char*>(scalable_aligned_malloc(block_size, MAX_ALIGNMENT));
+    if ( data == nullptr ) {
+      throw std::bad_alloc();
+    }
+    _blocks.push_back(Block { data, block_size });
+    _position = Position { _blocks.size() - 1, size };
+    return data;
+  }
+
+  static size_t alignUp(const size_t offset, const size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+  }
+
+  static constexpr size_t MAX_ALIGNMENT = alignof(std::max_align_t);
+
+  vec<Block> _blocks;
+  Position _position;
+};
+
+}  // namespace parallel
+}  // namespace mt_kahypar
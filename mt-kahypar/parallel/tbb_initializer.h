@@ -32,20 +32,26 @@
 #include <memory>
 #include <shared_mutex>
 #include <functional>
+#include <algorithm>
+#include <tuple>
 
+#include "tbb/parallel_for.h"
 #include "tbb/task_arena.h"
 #include "tbb/task_group.h"
 #include "tbb/global_control.h"
 
 #include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/cpu_quota.h"
 #include "mt-kahypar/parallel/thread_pinning_observer.h"
+#include "mt-kahypar/partition/context_enum_classes.h"
 
 namespace mt_kahypar {
 namespace parallel {
 /**
- * Creates number of NUMA nodes TBB task arenas. Each task arena is pinned
- * to a unique NUMA node. Each task arena can then be used to execute tasks
- * on specific NUMA node.
+ * Initializes the global thread pool. If is_numa_aware is set and the used CPUs span
+ * several NUMA nodes, it additionally creates one TBB task arena per used NUMA node.
+ * The threads of each task arena are pinned to the CPUs of its NUMA node, such that
+ * work can be executed on a specific NUMA node (see execute_on_numa_nodes(...)).
  */
 template <typename HwTopology, bool is_numa_aware>
 class TBBInitializer {
@@ -62,15 +68,29 @@ class TBBInitializer {
   TBBInitializer(TBBInitializer&&) = delete;
   TBBInitializer & operator= (TBBInitializer &&) = delete;
 
-  static TBBInitializer& instance(const size_t num_threads = std::thread::hardware_concurrency()) {
-    static TBBInitializer instance(num_threads);
+  static TBBInitializer& instance(const size_t num_threads = std::thread::hardware_concurrency(),
+                                  const ThreadPlacementPolicy placement = ThreadPlacementPolicy::physical_cores_first) {
+    static TBBInitializer instance(num_threads, placement);
     return instance;
   }
 
+  // ! Note, the number of threads can be smaller than requested,
+  // ! if the placement policy does not use hyperthreads
   int total_number_of_threads() const {
     return _num_threads;
   }
 
+  ThreadPlacementPolicy placement_policy() const {
+    return _placement;
+  }
+
+  // ! Number of used CPUs that are not hyperthreads
+  int number_of_used_physical_cores() const {
+    HwTopology& topology = HwTopology::instance();
+    return std::count_if(_cpus.cbegin(), _cpus.cend(),
+      [&](const int cpu_id) { return !topology.is_hyperthread(cpu_id); });
+  }
+
   int number_of_used_cpus_on_numa_node(const int node) const {
     ASSERT(static_cast<size_t>(node) < _numa_node_to_cpu_id.size());
     return _numa_node_to_cpu_id[node].size();
@@ -80,6 +100,17 @@ class TBBInitializer {
     return _numa_node_to_cpu_id.size();
   }
 
+  // ! NUMA node of each thread of the global thread pool (threads are pinned to the
+  // ! CPU of their slot in the global task arena, if thread pinning is enabled)
+  std::vector<int> numa_node_of_threads(const size_t num_threads) const {
+    HwTopology& topology = HwTopology::instance();
+    std::vector<int> numa_node_of_thread(num_threads, 0);
+    for ( size_t i = 0; i < num_threads && i < _cpus.size(); ++i ) {
+      numa_node_of_thread[i] = topology.numa_node_of_cpu(_cpus[i]);
+    }
+    return numa_node_of_thread;
+  }
+
   hwloc_cpuset_t used_cpuset() const {
     hwloc_cpuset_t cpuset = hwloc_bitmap_alloc();
     for ( const auto& numa_node : _numa_node_to_cpu_id ) {
@@ -90,44 +121,150 @@ class TBBInitializer {
     return cpuset;
   }
 
+  // ! Splits [0, num_elements) into consecutive ranges, one for each used NUMA node. The size
+  // ! of a range is proportional to the number of used CPUs on the corresponding NUMA node.
+  // ! The range of NUMA node i is [boundaries[i], boundaries[i + 1]).
+  std::vector<size_t> numa_node_boundaries(const size_t num_elements) const {
+    std::vector<size_t> boundaries(_numa_node_to_cpu_id.size() + 1, 0);
+    size_t num_visited_cpus = 0;
+    for ( size_t node = 0; node < _numa_node_to_cpu_id.size(); ++node ) {
+      num_visited_cpus += _numa_node_to_cpu_id[node].size();
+      boundaries[node + 1] = num_visited_cpus == _cpus.size() ? num_elements :
+        static_cast<size_t>(static_cast<double>(num_elements) * num_visited_cpus / _cpus.size());
+    }
+    boundaries.back() = num_elements;
+    return boundaries;
+  }
+
+  // ! Splits the memory area into consecutive ranges, one for each used NUMA node,
+  // ! and binds each range to its NUMA node (see numa_node_boundaries(...)).
+  void bind_memory_to_used_numa_nodes(const char* data, const size_t size_in_bytes) const {
+    if ( _numa_node_to_cpu_id.size() > 1 ) {
+      HwTopology& topology = HwTopology::instance();
+      const std::vector<size_t> boundaries = numa_node_boundaries(size_in_bytes);
+      for ( size_t node = 0; node < _numa_node_to_cpu_id.size(); ++node ) {
+        if ( boundaries[node] < boundaries[node + 1] ) {
+          topology.bind_memory_to_numa_node(data + boundaries[node],
+            boundaries[node + 1] - boundaries[node], node);
+        }
+      }
+    }
+  }
+
+  // ! True, if work can be executed on specific NUMA nodes (see execute_on_numa_nodes(...))
+  bool has_numa_arenas() const {
+    return !_numa_arenas.empty();
+  }
+
+  // ! Executes f(node) for each used NUMA node concurrently. If the NUMA task arenas exist,
+  // ! f(node) is executed in the task arena of the NUMA node, i.e., f(node) and all tasks
+  // ! spawned by it run on the CPUs of that NUMA node. Otherwise, f is executed for all
+  // ! NUMA nodes in the current task arena.
+  template<typename F>
+  void execute_on_numa_nodes(const F& f) {
+    const int num_numa_nodes = num_used_numa_nodes();
+    if ( has_numa_arenas() ) {
+      // A task group must be waited for in the task arena in which its tasks were spawned
+      std::vector<tbb::task_group> groups(num_numa_nodes);
+      for ( int node = 0; node < num_numa_nodes; ++node ) {
+        if ( _numa_arenas[node] ) {
+          _numa_arenas[node]->execute([&, node] {
+            groups[node].run([&, node] { f(node); });
+          });
+        }
+      }
+      for ( int node = 0; node < num_numa_nodes; ++node ) {
+        if ( _numa_arenas[node] ) {
+          _numa_arenas[node]->execute([&, node] { groups[node].wait(); });
+        }
+      }
+    } else {
+      tbb::parallel_for(0, std::max(num_numa_nodes, 1), [&](const int node) { f(node); });
+    }
+  }
+
+  // ! Changes the number of threads of the global thread pool. Must not be
+  // ! called while tasks are executed in the global thread pool.
+  void resize(const int num_threads) {
+    resize(num_threads, _placement);
+  }
+
+  void resize(const int num_threads, const ThreadPlacementPolicy placement) {
+    if ( num_threads != _num_threads || placement != _placement ) {
+      terminate();
+      _numa_observers.clear();
+      _numa_arenas.clear();
+      _global_observer.reset();
+      _gc.reset();
+      initialize(num_threads, placement);
+    }
+  }
+
+  // ! Resizes the global thread pool to the current CPU quota of the cgroup of the process
+  // ! (at most one thread per CPU of the hardware topology). If the process has no quota,
+  // ! all CPUs are used. Must not be called while tasks are executed in the global thread
+  // ! pool. Returns the new number of threads.
+  int adapt_to_cpu_quota() {
+    int num_threads = static_cast<int>(HwTopology::instance().get_all_cpus().size());
+    const int limit = cpu_quota::cgroup_cpu_limit();
+    if ( limit > 0 ) {
+      num_threads = std::min(num_threads, limit);
+    }
+    num_threads = std::max(num_threads, 1);
+    if ( num_threads != _num_threads ) {
+      DBG << "CPU quota changed: Resize global thread pool from"
+          << _num_threads << "to" << num_threads << "threads";
+      resize(num_threads);
+    }
+    return _num_threads;
+  }
+
   void terminate() {
+    for ( auto& observer : _numa_observers ) {
+      if ( observer ) {
+        observer->observe(false);
+      }
+    }
     if ( _global_observer ) {
       _global_observer->observe(false);
     }
   }
 
  private:
-  explicit TBBInitializer(const int num_threads) :
+  explicit TBBInitializer(const int num_threads, const ThreadPlacementPolicy placement) :
     _num_threads(num_threads),
-    _gc(tbb::global_control::max_allowed_parallelism, num_threads),
+    _placement(placement),
+    _gc(nullptr),
     _global_observer(nullptr),
     _cpus(),
-    _numa_node_to_cpu_id() {
+    _numa_node_to_cpu_id(),
+    _numa_arenas(),
+    _numa_observers() {
+    initialize(num_threads, placement);
+  }
+
+  void initialize(const int num_threads, const ThreadPlacementPolicy placement) {
     HwTopology& topology = HwTopology::instance();
     int num_numa_nodes = topology.num_numa_nodes();
-    DBG << "Initialize TBB with" << num_threads << "threads";
-    _cpus = topology.get_all_cpus();
-    // Sort cpus in the following order
-    // 1.) Non-hyperthread first
-    // 2.) Increasing order of numa node
-    // 3.) Increasing order of cpu id
-    // ...
-    std::sort(_cpus.begin(), _cpus.end(),
-              [&](const int& lhs, const int& rhs) {
-          int node_lhs = topology.numa_node_of_cpu(lhs);
-          int node_rhs = topology.numa_node_of_cpu(rhs);
-          bool is_hyperthread_lhs = topology.is_hyperthread(lhs);
-          bool is_hyperthread_rhs = topology.is_hyperthread(rhs);
-          return is_hyperthread_lhs < is_hyperthread_rhs ||
-          (is_hyperthread_lhs == is_hyperthread_rhs && node_lhs < node_rhs) ||
-          (is_hyperthread_lhs == is_hyperthread_rhs && node_lhs == node_rhs && lhs < rhs);
-        });
+    _placement = placement;
+    _cpus = sort_cpus(topology, placement);
+    if ( placement == ThreadPlacementPolicy::physical_cores_only ) {
+      while ( !_cpus.empty() && topology.is_hyperthread(_cpus.back()) ) {
+        _cpus.pop_back();
+      }
+    }
     // ... this ensure that we first pop nodes in hyperthreading
-    while (static_cast<int>(_cpus.size()) > _num_threads) {
+    while (static_cast<int>(_cpus.size()) > num_threads) {
       _cpus.pop_back();
     }
+    _num_threads = placement == ThreadPlacementPolicy::physical_cores_only && !_cpus.empty() ?
+      std::min(num_threads, static_cast<int>(_cpus.size())) : num_threads;
+    DBG << "Initialize TBB with" << _num_threads << "threads";
+    _gc = std::make_unique<tbb::global_control>(
+      tbb::global_control::max_allowed_parallelism, _num_threads);
     _global_observer = std::make_unique<ThreadPinningObserver>(_cpus);
 
+    _numa_node_to_cpu_id.clear();
     _numa_node_to_cpu_id.resize(num_numa_nodes);
     for ( const int cpu_id : _cpus ) {
       int node = topology.numa_node_of_cpu(cpu_id);
@@ -137,13 +274,89 @@ class TBBInitializer {
     while( !_numa_node_to_cpu_id.empty() && _numa_node_to_cpu_id.back().empty() ) {
       _numa_node_to_cpu_id.pop_back();
     }
+
+    if constexpr ( is_numa_aware ) {
+      if ( _numa_node_to_cpu_id.size() > 1 ) {
+        _numa_arenas.resize(_numa_node_to_cpu_id.size());
+        _numa_observers.resize(_numa_node_to_cpu_id.size());
+        for ( size_t node = 0; node < _numa_node_to_cpu_id.size(); ++node ) {
+          const std::vector<int>& cpus = _numa_node_to_cpu_id[node];
+          if ( !cpus.empty() ) {
+            DBG << "Initialize task arena with" << cpus.size() << "threads on NUMA node" << node;
+            _numa_arenas[node] = std::make_unique<tbb::task_arena>(static_cast<int>(cpus.size()));
+            _numa_arenas[node]->initialize();
+            _numa_observers[node] = std::make_unique<ThreadPinningObserver>(
+              *_numa_arenas[node], static_cast<int>(node), cpus);
+          }
+        }
+      }
+    }
+  }
+
+  // ! Returns all CPUs in the order in which they are assigned to threads
+  static std::vector<int> sort_cpus(HwTopology& topology, const ThreadPlacementPolicy placement) {
+    std::vector<int> cpus = topology.get_all_cpus();
+    // Default order (physical_cores_first, physical_cores_only, smt_for_memory_bound_phases):
+    // 1.) Non-hyperthread first
+    // 2.) Increasing order of numa node
+    // 3.) Increasing order of cpu id
+    // compact:
+    // 1.) Increasing order of numa node
+    // 2.) Non-hyperthread first
+    // 3.) Increasing order of cpu id
+    const bool numa_node_first = placement == ThreadPlacementPolicy::compact;
+    std::sort(cpus.begin(), cpus.end(),
+              [&](const int& lhs, const int& rhs) {
+          const int node_lhs = topology.numa_node_of_cpu(lhs);
+          const int node_rhs = topology.numa_node_of_cpu(rhs);
+          const bool is_hyperthread_lhs = topology.is_hyperthread(lhs);
+          const bool is_hyperthread_rhs = topology.is_hyperthread(rhs);
+          if ( numa_node_first ) {
+            return std::make_tuple(node_lhs, is_hyperthread_lhs, lhs) <
+              std::make_tuple(node_rhs, is_hyperthread_rhs, rhs);
+          }
+          return std::make_tuple(is_hyperthread_lhs, node_lhs, lhs) <
+            std::make_tuple(is_hyperthread_rhs, node_rhs, rhs);
+        });
+
+    if ( placement == ThreadPlacementPolicy::scatter ) {
+      // Assign the CPUs round-robin to the NUMA nodes such that consecutive
+      // threads run on different sockets (non-hyperthreads are still used first)
+      std::vector<std::vector<int>> cpus_of_numa_node(topology.num_numa_nodes());
+      for ( const int cpu_id : cpus ) {
+        cpus_of_numa_node[topology.numa_node_of_cpu(cpu_id)].push_back(cpu_id);
+      }
+      std::vector<int> scattered_cpus;
+      for ( const bool hyperthreads : { false, true } ) {
+        std::vector<size_t> pos(cpus_of_numa_node.size(), 0);
+        bool found_cpu = true;
+        while ( found_cpu ) {
+          found_cpu = false;
+          for ( size_t node = 0; node < cpus_of_numa_node.size(); ++node ) {
+            const std::vector<int>& node_cpus = cpus_of_numa_node[node];
+            if ( pos[node] < node_cpus.size() &&
+                 topology.is_hyperthread(node_cpus[pos[node]]) == hyperthreads ) {
+              scattered_cpus.push_back(node_cpus[pos[node]++]);
+              found_cpu = true;
+            }
+          }
+        }
+      }
+      ASSERT(scattered_cpus.size() == cpus.size());
+      cpus = std::move(scattered_cpus);
+    }
+    return cpus;
   }
 
   int _num_threads;
-  tbb::global_control _gc;
+  ThreadPlacementPolicy _placement;
+  std::unique_ptr<tbb::global_control> _gc;
   std::unique_ptr<ThreadPinningObserver> _global_observer;
   std::vector<int> _cpus;
   std::vector<std::vector<int>> _numa_node_to_cpu_id;
+  std::vector<std::unique_ptr<tbb::task_arena>> _numa_arenas;
+  // ! Must be destroyed before the task arenas
+  std::vector<std::unique_ptr<ThreadPinningObserver>> _numa_observers;
 };
 }  // namespace parallel
 }  // namespace mt_kahypar
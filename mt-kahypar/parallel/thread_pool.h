@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "tbb/task_arena.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/thread_pinning_observer.h"
+
+namespace mt_kahypar {
+namespace parallel {
+
+/**
+ * Task arena with its own thread budget, which can be used to run several
+ * partitioning calls side by side within the same process. Tasks spawned by a
+ * call executed in the thread pool stay in its task arena. Thus, the call can
+ * use at most the number of threads of the thread pool, and does not compete
+ * with calls running in other thread pools for work stealing.
+ *
+ * The threads of all task arenas are drawn from the global thread pool
+ * (see TBBInitializer). Thus, the global thread pool should be large enough to
+ * serve all thread pools that run calls concurrently. Optionally, the threads
+ * joining the task arena are pinned to a dedicated set of CPUs.
+ */
+template <typename HwTopology>
+class ThreadPool {
+
+  using ThreadPinningObserver = mt_kahypar::parallel::ThreadPinningObserver<HwTopology>;
+
+ public:
+  // ! If cpus is not empty, the i-th thread slot of the task arena is pinned
+  // ! to cpus[i] (requires cpus.size() == num_threads).
+  ThreadPool(const int num_threads, const std::vector<int>& cpus) :
+    _arena(num_threads),
+    _pinning_observer(nullptr) {
+    ASSERT(num_threads > 0);
+    _arena.initialize();
+    if ( !cpus.empty() ) {
+      ASSERT(cpus.size() == static_cast<size_t>(num_threads));
+      _pinning_observer = std::make_unique<ThreadPinningObserver>(
+        _arena, HwTopology::instance().numa_node_of_cpu(cpus[0]), cpus);
+      _pinning_observer->observe(true);
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool & operator= (const ThreadPool &) = delete;
+
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool & operator= (ThreadPool &&) = delete;
+
+  ~ThreadPool() {
+    if ( _pinning_observer ) {
+      _pinning_observer->observe(false);
+    }
+  }
+
+  int total_number_of_threads() const {
+    return _arena.max_concurrency();
+  }
+
+  // ! Executes f in the task arena of the thread pool and returns its result.
+  // ! The calling thread joins the task arena.
+  template<typename F>
+  auto execute(const F& f) -> decltype(f()) {
+    return _arena.execute(f);
+  }
+
+ private:
+  tbb::task_arena _arena;
+  // ! Must be destroyed before the task arena
+  std::unique_ptr<ThreadPinningObserver> _pinning_observer;
+};
+
+}  // namespace parallel
+}  // namespace mt_kahypar
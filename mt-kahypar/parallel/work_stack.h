@@ -27,6 +27,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+
 #include <tbb/parallel_for_each.h>
 
 #include "mt-kahypar/parallel/atomic_wrapper.h"
@@ -61,16 +66,69 @@ struct ThreadQueue {
   }
 };
 
+/*!
+ * Thread-local work queues with work stealing. Elements are inserted in an insertion
+ * phase (safe_push) and removed in a subsequent deletion phase (try_pop). A thread
+ * first pops from its own queue. Afterwards, it steals from the queues of threads on
+ * the same NUMA node and then from the remaining ones (see setLocalityGroups(...)).
+ * Each steal attempt starts at a random victim within the current group to avoid that
+ * all idle threads contend on the same queues. Since no elements are inserted in the
+ * deletion phase, the container is marked as exhausted after the first steal attempt
+ * that finds all queues empty, and subsequent steal attempts return immediately.
+ */
 template<typename T>
 struct WorkContainer {
 
+  // ! Queues visited by a thread when stealing work
+  struct StealOrder {
+    // ! Threads of the same locality group first, then all other threads
+    vec<uint32_t> victims;
+    size_t num_local_victims = 0;
+  };
+
   WorkContainer(size_t maxNumThreads = 0) :
-    tls_queues(maxNumThreads) { }
+    tls_queues(),
+    steal_orders(),
+    exhausted(false) {
+    resize(maxNumThreads);
+  }
+
+  // ! Resets the number of threads and assigns all threads to the same locality group
+  void resize(const size_t num_threads) {
+    tls_queues.resize(num_threads);
+    setLocalityGroups(std::vector<int>(num_threads, 0));
+  }
+
+  // ! Threads with the same locality group (e.g., the NUMA node of their CPU) prefer to
+  // ! steal from each other. Must be called before the insertion phase.
+  void setLocalityGroups(const std::vector<int>& locality_group_of_thread) {
+    ASSERT(locality_group_of_thread.size() == tls_queues.size());
+    const size_t num_threads = tls_queues.size();
+    steal_orders.assign(num_threads, StealOrder());
+    for ( size_t t = 0; t < num_threads; ++t ) {
+      StealOrder& order = steal_orders[t];
+      // Visiting the victims in cyclic order starting at the next thread ID
+      // distributes the first steal attempts of the threads among the queues
+      for ( size_t i = 1; i < num_threads; ++i ) {
+        const size_t victim = (t + i) % num_threads;
+        if ( locality_group_of_thread[victim] == locality_group_of_thread[t] ) {
+          order.victims.push_back(victim);
+        }
+      }
+      order.num_local_victims = order.victims.size();
+      for ( size_t i = 1; i < num_threads; ++i ) {
+        const size_t victim = (t + i) % num_threads;
+        if ( locality_group_of_thread[victim] != locality_group_of_thread[t] ) {
+          order.victims.push_back(victim);
+        }
+      }
+    }
+  }
 
   size_t unsafe_size() const {
     size_t sz = 0;
     for (const ThreadQueue<T>& q : tls_queues) {
-      sz += q.elements.size() - q.front.load(std::memory_order_relaxed);
+      sz += q.elements.size() - std::min(q.elements.size(), q.front.load(std::memory_order_relaxed));
     }
     return sz;
   }
@@ -84,19 +142,32 @@ struct WorkContainer {
 
   bool try_pop(T& dest, size_t thread_id) {
     ASSERT(thread_id < tls_queues.size());
-    return tls_queues[thread_id].try_pop(dest) || steal_work(dest);
+    ThreadQueue<T>& q = tls_queues[thread_id];
+    return (!is_empty(q) && q.try_pop(dest)) || steal_work(dest, thread_id);
   }
 
-  bool steal_work(T& dest) {
-    for (ThreadQueue<T>& q : tls_queues) {
-      if (q.try_pop(dest)) {
-        return true;
-      }
+  bool steal_work(T& dest, const size_t thread_id) {
+    if ( exhausted.load(std::memory_order_relaxed) ) {
+      return false;
+    }
+
+    ASSERT(thread_id < steal_orders.size());
+    const StealOrder& order = steal_orders[thread_id];
+    if ( try_steal(dest, order.victims, 0, order.num_local_victims) ||
+         try_steal(dest, order.victims, order.num_local_victims, order.victims.size()) ) {
+      return true;
+    }
+
+    // The queues are only drained in the deletion phase
+    // => if all queues are empty, they remain empty
+    if ( is_empty(tls_queues[thread_id]) ) {
+      exhausted.store(true, std::memory_order_relaxed);
     }
     return false;
   }
 
   void shuffle() {
+    exhausted.store(false, std::memory_order_relaxed);
     tbb::parallel_for_each(tls_queues, [&](ThreadQueue<T>& q) {
       utils::Randomize::instance().shuffleVector(q.elements);
     });
@@ -106,9 +177,13 @@ struct WorkContainer {
     for (ThreadQueue<T>& q : tls_queues) {
       q.clear();
     }
+    exhausted.store(false, std::memory_order_relaxed);
   }
 
   vec<ThreadQueue<T>> tls_queues;
+  vec<StealOrder> steal_orders;
+  // ! True, if a steal attempt found all queues empty in the current deletion phase
+  CAtomic<bool> exhausted;
 
   using SubRange = IteratorRange< typename vec<T>::const_iterator >;
   using Range = ConcatenatedRange<SubRange>;
@@ -130,6 +205,37 @@ struct WorkContainer {
       local_work_queue_node->updateSize(q.elements.capacity() * sizeof(T));
     }
   }
+
+ private:
+  static bool is_empty(const ThreadQueue<T>& q) {
+    return q.front.load(std::memory_order_relaxed) >= q.elements.size();
+  }
+
+  // ! Visits the victims in [begin, end) in cyclic order starting at a random
+  // ! position. Empty queues are skipped without modifying their front pointer.
+  bool try_steal(T& dest, const vec<uint32_t>& victims, const size_t begin, const size_t end) {
+    const size_t num_victims = end - begin;
+    if ( num_victims == 0 ) {
+      return false;
+    }
+    const size_t start = random_index(num_victims);
+    for ( size_t i = 0; i < num_victims; ++i ) {
+      ThreadQueue<T>& q = tls_queues[victims[begin + (start + i) % num_victims]];
+      if ( !is_empty(q) && q.try_pop(dest) ) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  static size_t random_index(const size_t n) {
+    // xorshift (the steal order only needs a cheap thread-local source of randomness)
+    static thread_local uint32_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state % n;
+  }
 };
 
 }
\ No newline at end of file
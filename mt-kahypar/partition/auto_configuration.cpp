@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "mt-kahypar/partition/auto_configuration.h"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/utils/hypergraph_statistics.h"
+
+namespace mt_kahypar {
+
+namespace {
+  struct CostModel {
+    // ! Seconds per pin on one thread
+    double cost_per_pin;
+    // ! Relative increase of the running time per doubling of k
+    double cost_per_log_k;
+    // ! Relative increase of the running time per unit of node degree skew
+    double cost_per_degree_skew;
+  };
+
+  // ! Rough per-pin costs of the configurations. They should be refit whenever the
+  // ! running times of the presets change significantly on the benchmark set.
+  static constexpr std::array<CostModel, 5> COST_MODELS = {{
+    { 1.5e-6, 0.05, 0.02 }, // label_propagation
+    { 2.5e-6, 0.10, 0.05 }, // fast_fm
+    { 4.0e-6, 0.15, 0.05 }, // fm
+    { 8.0e-6, 0.20, 0.05 }, // fm_and_small_flows
+    { 1.2e-5, 0.25, 0.05 }  // fm_and_flows
+  }};
+
+  // ! Parallel efficiency of the partitioner decreases with the number of threads
+  static constexpr double THREAD_SCALING_EXPONENT = 0.85;
+  // ! The node degree skew is capped to prevent that a few high degree
+  // ! vertices dominate the prediction
+  static constexpr double MAX_DEGREE_SKEW = 10.0;
+  static constexpr size_t FAST_FM_MULTITRY_ROUNDS = 3;
+  static constexpr double SMALL_FLOWS_ALPHA = 8;
+
+  template<typename T>
+  double coefficientOfVariation(const std::vector<T>& data) {
+    if ( data.size() < 2 ) {
+      return 0.0;
+    }
+    const double avg = utils::parallel_avg(data, data.size());
+    return avg > 0.0 ? utils::parallel_stdev(data, avg, data.size()) / avg : 0.0;
+  }
+} // namespace
+
+std::ostream & operator<< (std::ostream& os, const AutoRefinementConfiguration& config) {
+  switch ( config ) {
+    case AutoRefinementConfiguration::label_propagation: return os << "label_propagation";
+    case AutoRefinementConfiguration::fast_fm: return os << "fast_fm";
+    case AutoRefinementConfiguration::fm: return os << "fm";
+    case AutoRefinementConfiguration::fm_and_small_flows: return os << "fm_and_small_flows";
+    case AutoRefinementConfiguration::fm_and_flows: return os << "fm_and_flows";
+      // omit default case to trigger compiler warning for missing cases
+  }
+  return os << static_cast<uint8_t>(config);
+}
+
+InstanceFeatures computeInstanceFeatures(const Hypergraph& hypergraph, const Context& context) {
+  InstanceFeatures features;
+  features.num_nodes = hypergraph.initialNumNodes();
+  features.num_edges = Hypergraph::is_graph ?
+    hypergraph.initialNumEdges() / 2 : hypergraph.initialNumEdges();
+  features.num_pins = hypergraph.initialNumPins();
+  features.is_graph = Hypergraph::is_graph || hypergraph.maxEdgeSize() == 2;
+  features.k = context.partition.k;
+
+  std::vector<HyperedgeID> node_degrees(hypergraph.initialNumNodes(), 0);
+  hypergraph.doParallelForAllNodes([&](const HypernodeID& hn) {
+    node_degrees[hn] = hypergraph.nodeDegree(hn);
+  });
+  features.node_degree_skew = coefficientOfVariation(node_degrees);
+  if ( !features.is_graph ) {
+    std::vector<HypernodeID> edge_sizes(hypergraph.initialNumEdges(), 0);
+    hypergraph.doParallelForAllEdges([&](const HyperedgeID& he) {
+      edge_sizes[he] = hypergraph.edgeSize(he);
+    });
+    features.edge_size_skew = coefficientOfVariation(edge_sizes);
+  }
+  return features;
+}
+
+double predictRunningTime(const InstanceFeatures& features,
+                          const AutoRefinementConfiguration config,
+                          const size_t num_threads) {
+  const CostModel& model = COST_MODELS[static_cast<size_t>(config)];
+  const double log_k = std::log2(std::max(features.k, 2));
+  const double degree_skew = std::min(features.node_degree_skew, MAX_DEGREE_SKEW);
+  const double sequential_time = model.cost_per_pin * features.num_pins *
+    ( 1.0 + model.cost_per_log_k * log_k ) * ( 1.0 + model.cost_per_degree_skew * degree_skew );
+  return sequential_time / std::pow(std::max(num_threads, UL(1)), THREAD_SCALING_EXPONENT);
+}
+
+AutoRefinementConfiguration selectRefinementConfiguration(const InstanceFeatures& features,
+                                                          const int time_limit,
+                                                          const size_t num_threads) {
+  if ( time_limit <= 0 ) {
+    return AutoRefinementConfiguration::fm_and_flows;
+  }
+  for ( int i = static_cast<int>(COST_MODELS.size()) - 1; i > 0; --i ) {
+    const AutoRefinementConfiguration config = static_cast<AutoRefinementConfiguration>(i);
+    if ( predictRunningTime(features, config, num_threads) <= time_limit ) {
+      return config;
+    }
+  }
+  return AutoRefinementConfiguration::label_propagation;
+}
+
+void apply_auto_configuration(const Hypergraph& hypergraph, Context& context) {
+  if ( context.partition.preset_type != PresetType::auto_preset ) {
+    return;
+  }
+
+  const InstanceFeatures features = computeInstanceFeatures(hypergraph, context);
+  const size_t num_threads = context.shared_memory.num_threads;
+  const AutoRefinementConfiguration config =
+    selectRefinementConfiguration(features, context.partition.time_limit, num_threads);
+
+  switch ( config ) {
+    case AutoRefinementConfiguration::label_propagation:
+      context.refinement.fm.algorithm = FMAlgorithm::do_nothing;
+      context.refinement.flows.algorithm = FlowAlgorithm::do_nothing;
+      context.refinement.refine_until_no_improvement = false;
+      break;
+    case AutoRefinementConfiguration::fast_fm:
+      context.refinement.fm.multitry_rounds = std::min(
+        context.refinement.fm.multitry_rounds, FAST_FM_MULTITRY_ROUNDS);
+      context.refinement.flows.algorithm = FlowAlgorithm::do_nothing;
+      context.refinement.refine_until_no_improvement = false;
+      break;
+    case AutoRefinementConfiguration::fm:
+      context.refinement.flows.algorithm = FlowAlgorithm::do_nothing;
+      context.refinement.refine_until_no_improvement = false;
+      break;
+    case AutoRefinementConfiguration::fm_and_small_flows:
+      context.refinement.flows.alpha = std::min(context.refinement.flows.alpha, SMALL_FLOWS_ALPHA);
+      break;
+    case AutoRefinementConfiguration::fm_and_flows:
+      break;
+  }
+
+  // Direct k-way coarsening cannot reach its contraction limit if there are too few
+  // vertices per block. Deep multilevel partitioning coarsens to a limit independent of k.
+  if ( context.partition.mode == Mode::direct && !context.partition.deterministic &&
+       static_cast<double>(features.k) * context.coarsening.contraction_limit_multiplier >=
+       features.num_nodes ) {
+    context.partition.mode = Mode::deep_multilevel;
+  }
+
+  if ( context.partition.verbose_output ) {
+    LOG << "Auto preset: n =" << features.num_nodes << ", m =" << features.num_edges
+        << ", p =" << features.num_pins << ", k =" << features.k
+        << ", degree skew =" << features.node_degree_skew
+        << ", edge size skew =" << features.edge_size_skew;
+    LOG << "Auto preset: selected" << config << "refinement (predicted time ="
+        << predictRunningTime(features, config, num_threads) << "s ) and"
+        << context.partition.mode << "mode";
+  }
+}
+
+} // namespace mt_kahypar
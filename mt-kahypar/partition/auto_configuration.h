@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <ostream>
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+
+namespace mt_kahypar {
+
+// ! Cheap features of the input that determine the parameters of the auto preset
+struct InstanceFeatures {
+  HypernodeID num_nodes = 0;
+  HyperedgeID num_edges = 0;
+  HypernodeID num_pins = 0;
+  bool is_graph = false;
+  // ! Coefficient of variation of the hyperedge sizes and node degrees
+  double edge_size_skew = 0.0;
+  double node_degree_skew = 0.0;
+  PartitionID k = 0;
+};
+
+// ! Refinement configurations of the auto preset ordered by increasing expected quality
+enum class AutoRefinementConfiguration : uint8_t {
+  label_propagation,
+  fast_fm,
+  fm,
+  fm_and_small_flows,
+  fm_and_flows
+};
+
+std::ostream & operator<< (std::ostream& os, const AutoRefinementConfiguration& config);
+
+InstanceFeatures computeInstanceFeatures(const Hypergraph& hypergraph, const Context& context);
+
+// ! Predicts the running time in seconds of partitioning an instance with the given
+// ! features and refinement configuration based on a per-pin cost model
+double predictRunningTime(const InstanceFeatures& features,
+                          const AutoRefinementConfiguration config,
+                          const size_t num_threads);
+
+// ! Returns the configuration with the highest expected quality whose predicted running
+// ! time fits into the time limit (in seconds, 0 = unlimited). If none fits, the fastest
+// ! configuration is returned.
+AutoRefinementConfiguration selectRefinementConfiguration(const InstanceFeatures& features,
+                                                          const int time_limit,
+                                                          const size_t num_threads);
+
+// ! Configures the parameters of the auto preset based on the features of the input.
+// ! Expects that the context is initialized with the default flow preset and must be
+// ! called before the memory pool is registered.
+void apply_auto_configuration(const Hypergraph& hypergraph, Context& context);
+
+} // namespace mt_kahypar
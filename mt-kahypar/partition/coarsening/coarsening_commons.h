@@ -28,8 +28,15 @@
 
 #pragma once
 
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_sort.h"
+
 #include "mt-kahypar/definitions.h"
+#include "mt-kahypar/io/hypergraph_io.h"
+#include "mt-kahypar/parallel/level_arena.h"
+#include "mt-kahypar/parallel/phase_concurrency.h"
 #include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/preprocessing/sparsification/min_hash_sparsifier.h"
 #include "mt-kahypar/utils/timer.h"
 
 namespace mt_kahypar {
@@ -40,6 +47,8 @@ public:
                  parallel::scalable_vector<HypernodeID>&& communities,
                  double coarsening_time) :
     _contracted_hypergraph(std::move(contracted_hypergraph)),
+    _sparsified_hypergraph(),
+    _is_sparsified(false),
     _communities(std::move(communities)),
     _coarsening_time(coarsening_time) { }
 
@@ -51,6 +60,26 @@ public:
     return _contracted_hypergraph;
   }
 
+  // ! Hypergraph that is coarsened further, which is the contracted hypergraph
+  // ! with merged similar nets if the level was sparsified
+  Hypergraph& coarseningHypergraph() {
+    return _is_sparsified ? _sparsified_hypergraph : _contracted_hypergraph;
+  }
+
+  void setSparsifiedHypergraph(Hypergraph&& sparsified_hypergraph) {
+    ASSERT(sparsified_hypergraph.initialNumNodes() == _contracted_hypergraph.initialNumNodes());
+    _sparsified_hypergraph = std::move(sparsified_hypergraph);
+    _is_sparsified = true;
+  }
+
+  // ! The sparsified hypergraph is only required until the level is contracted
+  void freeSparsifiedHypergraph() {
+    if ( _is_sparsified ) {
+      _sparsified_hypergraph.freeInternalData();
+      _is_sparsified = false;
+    }
+  }
+
   // ! Maps a global vertex id of the representative hypergraph
   // ! to its global vertex id in the contracted hypergraph
   HypernodeID mapToContractedHypergraph(const HypernodeID hn) const {
@@ -65,6 +94,8 @@ public:
   void freeInternalData() {
     tbb::parallel_invoke([&] {
       _contracted_hypergraph.freeInternalData();
+    }, [&] {
+      freeSparsifiedHypergraph();
     }, [&] {
       parallel::free(_communities);
     });
@@ -73,6 +104,9 @@ public:
 private:
   // ! Contracted Hypergraph
   Hypergraph _contracted_hypergraph;
+  // ! Contracted hypergraph with merged similar nets (see MinHashSparsifier)
+  Hypergraph _sparsified_hypergraph;
+  bool _is_sparsified;
   // ! Defines the communities that are contracted
   // ! in the coarse hypergraph
   parallel::scalable_vector<HypernodeID> _communities;
@@ -99,6 +133,7 @@ public:
             std::log2(context.coarsening.maximum_shrink_factor) ) + UL(1);
         }
         hierarchy.reserve(estimated_number_of_levels);
+        acquireLevelArena();
       }
       is_phg_initialized = false;
       partitioned_hg = std::make_unique<PartitionedHypergraph>();
@@ -108,6 +143,11 @@ public:
     tbb::parallel_for(UL(0), hierarchy.size(), [&](const size_t i) {
       (hierarchy)[i].freeInternalData();
     }, tbb::static_partitioner());
+    if ( _uses_level_arena ) {
+      // All levels allocated in the arena are freed
+      hierarchy.clear();
+      parallel::LevelArena::instance().release();
+    }
   }
 
   void setPartitionedHypergraph(PartitionedHypergraph&& phg) {
@@ -132,6 +172,7 @@ public:
       // Free memory of temporary contraction buffer and
       // release coarsening memory in memory pool
       if (!hierarchy.empty()) {
+        hierarchy.back().freeSparsifiedHypergraph();
         hierarchy.back().contractedHypergraph().freeTmpContractionBuffer();
       } else {
         _hg.freeTmpContractionBuffer();
@@ -139,6 +180,14 @@ public:
       if (_context.type == ContextType::main) {
         parallel::MemoryPool::instance().release_mem_group("Coarsening");
       }
+      if (_uses_level_arena) {
+        parallel::LevelArena& arena = parallel::LevelArena::instance();
+        arena.seal();
+        utils::Stats& stats = utils::Utilities::instance().getStats(_context.utility_id);
+        stats.add_stat("level_arena_size_in_bytes", static_cast<int64_t>(arena.sizeInBytes()));
+        stats.add_stat("level_arena_used_bytes", static_cast<int64_t>(arena.usedBytes()));
+        stats.add_stat("level_arena_failed_requests", static_cast<int64_t>(arena.numFailedRequests()));
+      }
 
       // Construct partitioned hypergraph for initial partitioning
       if ( !is_phg_initialized ) {
@@ -157,12 +206,51 @@ public:
           parallel::scalable_vector<HypernodeID>&& communities,
           const HighResClockTimepoint& round_start) {
     ASSERT(!is_finalized);
-    Hypergraph& current_hg = hierarchy.empty() ? _hg : hierarchy.back().contractedHypergraph();
+    Hypergraph& current_hg = hierarchy.empty() ? _hg : hierarchy.back().coarseningHypergraph();
     ASSERT(current_hg.initialNumNodes() == communities.size());
-    Hypergraph contracted_hg = current_hg.contract(communities);
+    if ( _context.coarsening.order_clusters_by_community ) {
+      orderClustersByCommunity(current_hg, communities);
+    }
+    Hypergraph contracted_hg = parallel::executeWithConcurrencyLimit(
+      _context.shared_memory.contraction_num_threads, [&] {
+        return current_hg.contract(communities, _context.coarsening.low_memory_contraction);
+      });
     const HighResClockTimepoint round_end = std::chrono::high_resolution_clock::now();
     const double elapsed_time = std::chrono::duration<double>(round_end - round_start).count();
+    if ( !hierarchy.empty() ) {
+      // The previous level is not accessed again until uncoarsening
+      hierarchy.back().freeSparsifiedHypergraph();
+      offloadToDisk(hierarchy.back().contractedHypergraph());
+    }
     hierarchy.emplace_back(std::move(contracted_hg), std::move(communities), elapsed_time);
+    if ( _context.coarsening.use_min_hash_sparsifier &&
+         hierarchy.back().contractedHypergraph().initialNumNodes() > _context.coarsening.contraction_limit ) {
+      sparsifyCoarsestLevel();
+    }
+  }
+
+  // ! Replaces the partitioned hypergraph with an unpartitioned one with k blocks
+  // ! on the coarsest level. This allows to reuse the multilevel hierarchy to
+  // ! compute several partitions (e.g., for different values of k).
+  void resetPartitionedHypergraph(const PartitionID k) {
+    ASSERT(is_finalized && !nlevel);
+    *partitioned_hg = PartitionedHypergraph(k, _hg, parallel_tag_t());
+    if (!hierarchy.empty()) {
+      partitioned_hg->setHypergraph(hierarchy.back().contractedHypergraph());
+    }
+  }
+
+  // ! Removes the coarsest levels of the multilevel hierarchy such that the
+  // ! hypergraph of the former level hierarchy.size() - num_levels becomes
+  // ! the coarsest one. The partitioned hypergraph must be reset beforehand.
+  void removeCoarsestLevels(const size_t num_levels) {
+    ASSERT(is_finalized && !nlevel);
+    ASSERT(num_levels < hierarchy.size());
+    for ( size_t i = 0; i < num_levels; ++i ) {
+      hierarchy.back().freeInternalData();
+      hierarchy.pop_back();
+    }
+    partitioned_hg->setHypergraph(hierarchy.back().contractedHypergraph());
   }
 
   PartitionedHypergraph& coarsestPartitionedHypergraph() {
@@ -200,7 +288,103 @@ public:
   bool nlevel;
 
 private:
+  // ! The coarse levels of the main hierarchy are allocated in a preallocated region
+  // ! whose size is derived from the size of the input hypergraph (see parallel::LevelArena)
+  void acquireLevelArena() {
+    if constexpr ( Hypergraph::is_static_hypergraph && !Hypergraph::is_graph ) {
+      if ( _context.coarsening.level_arena_factor > 0.0 &&
+           _context.type == ContextType::main ) {
+        const size_t input_size_in_bytes =
+          _hg.initialNumNodes() * Hypergraph::SIZE_OF_HYPERNODE +
+          _hg.initialNumEdges() * Hypergraph::SIZE_OF_HYPEREDGE +
+          _hg.initialNumPins() * ( sizeof(HypernodeID) + sizeof(HyperedgeID) );
+        parallel::LevelArena::instance().acquire(static_cast<size_t>(
+          _context.coarsening.level_arena_factor * input_size_in_bytes));
+        _uses_level_arena = true;
+      }
+    }
+  }
+
+  // ! Relabels the clusters such that clusters of the same community get consecutive
+  // ! IDs (ties are broken by the old cluster ID). The contraction assigns coarse vertex
+  // ! IDs in increasing order of the cluster IDs, which places the vertices of a community
+  // ! next to each other in the contracted hypergraph.
+  void orderClustersByCommunity(const Hypergraph& hypergraph,
+                                parallel::scalable_vector<HypernodeID>& communities) {
+    utils::Timer& timer = utils::Utilities::instance().getTimer(_context.utility_id);
+    timer.start_timer("order_clusters_by_community", "Order Clusters by Community");
+    const HypernodeID num_nodes = hypergraph.initialNumNodes();
+    parallel::scalable_vector<uint8_t> is_cluster(num_nodes, false);
+    hypergraph.doParallelForAllNodes([&](const HypernodeID hn) {
+      ASSERT(communities[hn] < num_nodes);
+      is_cluster[communities[hn]] = true;
+    });
+
+    tbb::enumerable_thread_specific<parallel::scalable_vector<HypernodeID>> local_clusters;
+    tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID c) {
+      if ( is_cluster[c] ) {
+        local_clusters.local().push_back(c);
+      }
+    });
+    parallel::scalable_vector<HypernodeID> clusters;
+    for ( const auto& local : local_clusters ) {
+      clusters.insert(clusters.end(), local.begin(), local.end());
+    }
+    tbb::parallel_sort(clusters.begin(), clusters.end(),
+      [&](const HypernodeID lhs, const HypernodeID rhs) {
+        const PartitionID lhs_community = hypergraph.communityID(lhs);
+        const PartitionID rhs_community = hypergraph.communityID(rhs);
+        return lhs_community < rhs_community || (lhs_community == rhs_community && lhs < rhs);
+      });
+
+    // The new cluster IDs are the positions in the sorted order
+    parallel::scalable_vector<HypernodeID> new_cluster_id(num_nodes, kInvalidHypernode);
+    tbb::parallel_for(UL(0), clusters.size(), [&](const size_t pos) {
+      new_cluster_id[clusters[pos]] = pos;
+    });
+    hypergraph.doParallelForAllNodes([&](const HypernodeID hn) {
+      communities[hn] = new_cluster_id[communities[hn]];
+    });
+    timer.stop_timer("order_clusters_by_community");
+  }
+
+  // ! Merges similar nets of the coarsest hypergraph. The next level is contracted from the
+  // ! sparsified hypergraph, while uncoarsening projects the partition onto the original
+  // ! hypergraph of the level (both have the same vertex IDs).
+  void sparsifyCoarsestLevel() {
+    utils::Timer& timer = utils::Utilities::instance().getTimer(_context.utility_id);
+    timer.start_timer("min_hash_sparsifier", "MinHash Sparsifier");
+    Level& level = hierarchy.back();
+    Hypergraph sparsified_hg;
+    MinHashSparsifier sparsifier(_context);
+    const HyperedgeID num_removed_nets = sparsifier.sparsify(level.contractedHypergraph(), sparsified_hg);
+    if ( num_removed_nets > 0 ) {
+      // The contraction of the sparsified hypergraph allocates its own (smaller) buffer
+      level.contractedHypergraph().freeTmpContractionBuffer();
+      level.setSparsifiedHypergraph(std::move(sparsified_hg));
+      utils::Utilities::instance().getStats(_context.utility_id).add_stat(
+        "min_hash_removed_nets", static_cast<int64_t>(num_removed_nets));
+    }
+    timer.stop_timer("min_hash_sparsifier");
+  }
+
+  void offloadToDisk(Hypergraph& hypergraph) {
+    #if !defined(USE_GRAPH_PARTITIONER) && !defined(USE_STRONG_PARTITIONER)
+    if ( !_context.coarsening.offload_directory.empty() &&
+         _context.type == ContextType::main &&
+         hypergraph.initialNumPins() >= _context.coarsening.offload_min_num_pins ) {
+      utils::Timer& timer = utils::Utilities::instance().getTimer(_context.utility_id);
+      timer.start_timer("offload_level", "Offload Level to Disk");
+      io::offloadHypergraphToDisk(hypergraph, _context.coarsening.offload_directory);
+      timer.stop_timer("offload_level");
+    }
+    #else
+    unused(hypergraph);
+    #endif
+  }
+
   Hypergraph& _hg;
   const Context& _context;
+  bool _uses_level_arena = false;
 };
 }
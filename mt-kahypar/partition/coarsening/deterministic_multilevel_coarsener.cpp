@@ -61,6 +61,10 @@ bool DeterministicMultilevelCoarsener::coarseningPassImpl() {
       }
     });
 
+    if (_context.coarsening.deterministic_conflict_resolution) {
+      resolveConflictingPropositions(first, last);
+    }
+
     tbb::enumerable_thread_specific<size_t> num_contracted_nodes { 0 };
 
     // already approve if we can grant all requests for proposed cluster
@@ -154,6 +158,27 @@ void DeterministicMultilevelCoarsener::calculatePreferredTargetCluster(Hypernode
   }
 }
 
+void DeterministicMultilevelCoarsener::resolveConflictingPropositions(const size_t first, const size_t last) {
+  const Hypergraph& hg = currentHypergraph();
+  // u is a singleton cluster when it proposes a move. thus, other vertices of this sub-round want to join u,
+  // if its opportunistic cluster weight is larger than its weight. in that case, u stays in its cluster.
+  // the decisions only depend on the propositions (and not on the order of the cancellations).
+  tbb::parallel_for(first, last, [&](size_t pos) {
+    const HypernodeID u = permutation.at(pos);
+    if (propositions[u] != u && opportunistic_cluster_weight[u] > hg.nodeWeight(u)) {
+      nodes_in_too_heavy_clusters.push_back_buffered(u);
+    }
+  });
+  nodes_in_too_heavy_clusters.finalize();
+
+  tbb::parallel_for(UL(0), nodes_in_too_heavy_clusters.size(), [&](size_t pos) {
+    const HypernodeID u = nodes_in_too_heavy_clusters[pos];
+    __atomic_fetch_sub(&opportunistic_cluster_weight[propositions[u]], hg.nodeWeight(u), __ATOMIC_RELAXED);
+    propositions[u] = u;
+  });
+  nodes_in_too_heavy_clusters.clear();
+}
+
 size_t DeterministicMultilevelCoarsener::approveVerticesInTooHeavyClusters(vec<HypernodeID>& clusters) {
   const Hypergraph& hg = currentHypergraph();
   tbb::enumerable_thread_specific<size_t> num_contracted_nodes { 0 };
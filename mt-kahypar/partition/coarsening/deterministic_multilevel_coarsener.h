@@ -113,6 +113,9 @@ private:
 
   void calculatePreferredTargetCluster(HypernodeID u, const vec<HypernodeID>& clusters);
 
+  // a vertex that is the target of a proposition of the same sub-round does not leave its cluster
+  void resolveConflictingPropositions(size_t first, size_t last);
+
   size_t approveVerticesInTooHeavyClusters(vec<HypernodeID>& clusters);
 
   HypernodeID currentNumberOfNodesImpl() const override {
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/utils/hash.h"
+
+namespace mt_kahypar {
+
+/*!
+ * Calls f for a bounded sample of the pins of hyperedge he (all pins, if the
+ * hyperedge has at most sample_size pins). The sample consists of pins with
+ * equal distance in the pin list, starting at an offset that depends on the
+ * hyperedge and the rated vertex u. Thus, the sample is deterministic, but
+ * different vertices see different pins of the same hyperedge.
+ */
+template<typename HyperGraph, typename F>
+MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void forEachSampledPin(const HyperGraph& hypergraph,
+                                                          const HyperedgeID he,
+                                                          const HypernodeID u,
+                                                          const HypernodeID sample_size,
+                                                          const F& f) {
+  const HypernodeID edge_size = hypergraph.edgeSize(he);
+  if constexpr ( !HyperGraph::is_graph ) {
+    if ( edge_size > sample_size ) {
+      using namespace hashing::integer;
+      const auto first_pin = hypergraph.pins(he).begin();
+      const uint64_t step = edge_size / sample_size;
+      const uint64_t offset = combine64(hash64(he), hash64(u)) % edge_size;
+      for ( uint64_t i = 0; i < sample_size; ++i ) {
+        f(*(first_pin + ((offset + i * step) % edge_size)));
+      }
+      return;
+    }
+  }
+  for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+    f(pin);
+  }
+}
+
+}  // namespace mt_kahypar
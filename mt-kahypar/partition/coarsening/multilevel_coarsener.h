@@ -28,11 +28,13 @@
 #pragma once
 
 #include <string>
+#include <type_traits>
 
 #include "tbb/concurrent_queue.h"
 #include "tbb/task_group.h"
 #include "tbb/parallel_for.h"
 #include "tbb/parallel_reduce.h"
+#include "tbb/parallel_sort.h"
 
 #include "kahypar/meta/mandatory.h"
 
@@ -72,10 +74,13 @@ class MultilevelCoarsener : public ICoarsener,
   #define STATE(X) static_cast<uint8_t>(X)
   using AtomicMatchingState = parallel::IntegralAtomicWrapper<uint8_t>;
   using AtomicWeight = parallel::IntegralAtomicWrapper<HypernodeWeight>;
+  using AtomicBlock = parallel::IntegralAtomicWrapper<PartitionID>;
 
   static constexpr bool debug = false;
   static constexpr bool enable_heavy_assert = false;
   static constexpr HypernodeID kInvalidHypernode = std::numeric_limits<HypernodeID>::max();
+  // ! Maximum number of vertices processed sequentially during two-hop clustering
+  static constexpr size_t TWO_HOP_CHUNK_SIZE = 1024;
 
  public:
   MultilevelCoarsener(Hypergraph& hypergraph,
@@ -88,6 +93,7 @@ class MultilevelCoarsener : public ICoarsener,
     _matching_state(),
     _cluster_weight(),
     _matching_partner(),
+    _cluster_fixed_block(),
     _pass_nr(0),
     _progress_bar(hypergraph.initialNumNodes(), 0, false),
     _enable_randomization(true) {
@@ -102,6 +108,10 @@ class MultilevelCoarsener : public ICoarsener,
       _cluster_weight.resize(hypergraph.initialNumNodes());
     }, [&] {
       _matching_partner.resize(hypergraph.initialNumNodes());
+    }, [&] {
+      if ( hypergraph.hasFixedVertices() ) {
+        _cluster_fixed_block.resize(hypergraph.initialNumNodes());
+      }
     });
   }
 
@@ -113,7 +123,7 @@ class MultilevelCoarsener : public ICoarsener,
   ~MultilevelCoarsener() {
     parallel::parallel_free(
       _current_vertices, _matching_state,
-      _cluster_weight, _matching_partner);
+      _cluster_weight, _matching_partner, _cluster_fixed_block);
   }
 
   void disableRandomization() {
@@ -141,6 +151,7 @@ class MultilevelCoarsener : public ICoarsener,
 
     // Random shuffle vertices of current hypergraph
     _current_vertices.resize(current_hg.initialNumNodes());
+    const bool has_fixed_vertices = current_hg.hasFixedVertices();
     parallel::scalable_vector<HypernodeID> cluster_ids(current_hg.initialNumNodes());
     tbb::parallel_for(ID(0), current_hg.initialNumNodes(), [&](const HypernodeID hn) {
       ASSERT(hn < _current_vertices.size());
@@ -152,10 +163,21 @@ class MultilevelCoarsener : public ICoarsener,
       if ( current_hg.nodeIsEnabled(hn) ) {
         _cluster_weight[hn] = current_hg.nodeWeight(hn);
       }
+      if ( has_fixed_vertices ) {
+        _cluster_fixed_block[hn] = current_hg.fixedVertexBlock(hn);
+      }
     });
 
     if ( _enable_randomization ) {
-      utils::Randomize::instance().parallelShuffleVector( _current_vertices, UL(0), _current_vertices.size());
+      if ( _context.coarsening.vertex_order_tile_size > 0 ) {
+        // Vertices are visited in tiles of consecutive IDs. Thus, the rating of
+        // vertices processed by the same thread touches nearby parts of the
+        // incidence array and cluster ids.
+        utils::Randomize::instance().parallelTiledShuffleVector(
+          _current_vertices, UL(0), _current_vertices.size(), _context.coarsening.vertex_order_tile_size);
+      } else {
+        utils::Randomize::instance().parallelShuffleVector( _current_vertices, UL(0), _current_vertices.size());
+      }
     }
 
     // We iterate in parallel over all vertices of the hypergraph and compute its contraction partner.
@@ -174,51 +196,70 @@ class MultilevelCoarsener : public ICoarsener,
     HypernodeID current_num_nodes = num_hns_before_pass;
     tbb::enumerable_thread_specific<HypernodeID> contracted_nodes(0);
     tbb::enumerable_thread_specific<HypernodeID> num_nodes_update_threshold(0);
-    tbb::parallel_for(0U, current_hg.initialNumNodes(), [&](const HypernodeID id) {
-      ASSERT(id < _current_vertices.size());
-      const HypernodeID hn = _current_vertices[id];
-      if (current_hg.nodeIsEnabled(hn)) {
-        // We perform rating if ...
-        //  1.) The contraction limit of the current level is not reached
-        //  2.) Vertex hn is not matched before
-        const HypernodeID u = hn;
-        if (_matching_state[u] == STATE(MatchingState::UNMATCHED)) {
-          if (current_num_nodes > hierarchy_contraction_limit) {
-            ASSERT(current_hg.nodeIsEnabled(hn));
-            const Rating rating = _rater.rate(current_hg, hn,
-              cluster_ids, _cluster_weight, _context.coarsening.max_allowed_node_weight);
-            if (rating.target != kInvalidHypernode) {
-              const HypernodeID v = rating.target;
-              HypernodeID& local_contracted_nodes = contracted_nodes.local();
-              matchVertices(current_hg, u, v, cluster_ids, local_contracted_nodes);
-
-              // To maintain the current number of nodes of the hypergraph each PE sums up
-              // its number of contracted nodes locally. To compute the current number of
-              // nodes, we have to sum up the number of contracted nodes of each PE. This
-              // operation becomes more expensive the more PEs are participating in coarsening.
-              // In order to prevent expensive updates of the current number of nodes, we
-              // define a threshold which the local number of contracted nodes have to exceed
-              // before the current PE updates the current number of nodes. This threshold is defined
-              // by the distance to the current contraction limit divided by the number of PEs.
-              // Once one PE exceeds this bound the first time it is not possible that the
-              // contraction limit is reached, because otherwise an other PE would update
-              // the global current number of nodes before. After update the threshold is
-              // increased by the new difference (in number of nodes) to the contraction limit
-              // divided by the number of PEs.
-              if (local_contracted_nodes >= num_nodes_update_threshold.local()) {
-                current_num_nodes = num_hns_before_pass -
-                                    contracted_nodes.combine(std::plus<HypernodeID>());
-                const HypernodeID dist_to_contraction_limit =
-                  current_num_nodes > hierarchy_contraction_limit ?
-                  current_num_nodes - hierarchy_contraction_limit : 0;
-                num_nodes_update_threshold.local() +=
-                  dist_to_contraction_limit / _context.shared_memory.original_num_threads;
+    // The clustering is instantiated once with and once without support for fixed
+    // vertices such that hypergraphs without fixed vertices run the same code as before
+    auto cluster_vertices = [&](auto has_fixed_vertices_tag) {
+      constexpr bool kHasFixedVertices = decltype(has_fixed_vertices_tag)::value;
+      tbb::parallel_for(0U, current_hg.initialNumNodes(), [&](const HypernodeID id) {
+        ASSERT(id < _current_vertices.size());
+        const HypernodeID hn = _current_vertices[id];
+        if (current_hg.nodeIsEnabled(hn)) {
+          // We perform rating if ...
+          //  1.) The contraction limit of the current level is not reached
+          //  2.) Vertex hn is not matched before
+          const HypernodeID u = hn;
+          if (_matching_state[u] == STATE(MatchingState::UNMATCHED)) {
+            if (current_num_nodes > hierarchy_contraction_limit) {
+              ASSERT(current_hg.nodeIsEnabled(hn));
+              const Rating rating = _rater.template rate<kHasFixedVertices>(current_hg, hn,
+                cluster_ids, _cluster_weight, _cluster_fixed_block, _context.coarsening.max_allowed_node_weight);
+              if (rating.target != kInvalidHypernode) {
+                const HypernodeID v = rating.target;
+                HypernodeID& local_contracted_nodes = contracted_nodes.local();
+                matchVertices<kHasFixedVertices>(current_hg, u, v, cluster_ids, local_contracted_nodes);
+
+                // To maintain the current number of nodes of the hypergraph each PE sums up
+                // its number of contracted nodes locally. To compute the current number of
+                // nodes, we have to sum up the number of contracted nodes of each PE. This
+                // operation becomes more expensive the more PEs are participating in coarsening.
+                // In order to prevent expensive updates of the current number of nodes, we
+                // define a threshold which the local number of contracted nodes have to exceed
+                // before the current PE updates the current number of nodes. This threshold is defined
+                // by the distance to the current contraction limit divided by the number of PEs.
+                // Once one PE exceeds this bound the first time it is not possible that the
+                // contraction limit is reached, because otherwise an other PE would update
+                // the global current number of nodes before. After update the threshold is
+                // increased by the new difference (in number of nodes) to the contraction limit
+                // divided by the number of PEs.
+                if (local_contracted_nodes >= num_nodes_update_threshold.local()) {
+                  current_num_nodes = num_hns_before_pass -
+                                      contracted_nodes.combine(std::plus<HypernodeID>());
+                  const HypernodeID dist_to_contraction_limit =
+                    current_num_nodes > hierarchy_contraction_limit ?
+                    current_num_nodes - hierarchy_contraction_limit : 0;
+                  num_nodes_update_threshold.local() +=
+                    dist_to_contraction_limit / _context.shared_memory.original_num_threads;
+                }
               }
             }
           }
         }
+      });
+    };
+    if ( has_fixed_vertices ) {
+      cluster_vertices(std::true_type());
+    } else {
+      cluster_vertices(std::false_type());
+    }
+
+    if ( _context.coarsening.algorithm == CoarseningAlgorithm::two_hop_multilevel_coarsener ) {
+      current_num_nodes = num_hns_before_pass - contracted_nodes.combine(std::plus<>());
+      if ( current_num_nodes > hierarchy_contraction_limit ) {
+        contracted_nodes.local() += twoHopClustering(current_hg, cluster_ids,
+          current_num_nodes - hierarchy_contraction_limit);
       }
-    });
+    }
+
     if ( _context.partition.show_detailed_clustering_timings ) {
       _timer.stop_timer("clustering_level_" + std::to_string(_pass_nr));
     }
@@ -292,7 +333,10 @@ class MultilevelCoarsener : public ICoarsener,
    *   2.) u is matched with v and v is matched an other vertex w concurrently
    * The following functions guarantees that our invariant is fullfilled, if
    * vertices are matched concurrently.
+   * If has_fixed_vertices is true, u only joins a cluster if the cluster is
+   * not fixed to a different block than u (see joinFixedVertexBlock(...)).
    */
+  template<bool has_fixed_vertices>
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool matchVertices(const Hypergraph& hypergraph,
                                                         const HypernodeID u,
                                                         const HypernodeID v,
@@ -322,16 +366,19 @@ class MultilevelCoarsener : public ICoarsener,
           if ( v == cluster_ids[v] ) {
             // In case v is also the representative of the cluster,
             // we change the cluster id of u to v, ...
-            cluster_ids[u] = v;
-            _cluster_weight[v] += weight_u;
-            ++contracted_nodes;
-            success = true;
+            if ( joinFixedVertexBlock<has_fixed_vertices>(u, v) ) {
+              cluster_ids[u] = v;
+              _cluster_weight[v] += weight_u;
+              ++contracted_nodes;
+              success = true;
+            }
           } else {
             // ... otherwise, we try again to match u with the
             // representative of the cluster.
             const HypernodeID cluster_v = cluster_ids[v];
             weight_v = _cluster_weight[cluster_v];
-            if ( weight_u + weight_v <= _context.coarsening.max_allowed_node_weight ) {
+            if ( weight_u + weight_v <= _context.coarsening.max_allowed_node_weight &&
+                 joinFixedVertexBlock<has_fixed_vertices>(u, cluster_v) ) {
               ASSERT(_matching_state[cluster_v] == STATE(MatchingState::MATCHED));
               cluster_ids[u] = cluster_v;
               _cluster_weight[cluster_v] += weight_u;
@@ -341,12 +388,15 @@ class MultilevelCoarsener : public ICoarsener,
           }
         } else if ( _matching_state[v].compare_exchange_strong(unmatched, match_in_progress) ) {
           // Current thread has the "ownership" for u and v and can change the cluster id
-          // of both vertices thread-safe.
-          cluster_ids[u] = v;
-          _cluster_weight[v] += weight_u;
-          ++contracted_nodes;
+          // of both vertices thread-safe. If u can not join v due to fixed vertices,
+          // v still becomes a (singleton) cluster, since other threads may wait for v.
+          if ( joinFixedVertexBlock<has_fixed_vertices>(u, v) ) {
+            cluster_ids[u] = v;
+            _cluster_weight[v] += weight_u;
+            ++contracted_nodes;
+            success = true;
+          }
           _matching_state[v] = STATE(MatchingState::MATCHED);
-          success = true;
         } else {
           // State of v must be either MATCHING_IN_PROGRESS or an other thread changed the state
           // in the meantime to MATCHED. We have to wait until the state of v changed to
@@ -367,12 +417,14 @@ class MultilevelCoarsener : public ICoarsener,
             // Vertex with smallest id starts to resolve conflict
             const bool is_in_cyclic_dependency = _matching_partner[cur_u] == u;
             if ( is_in_cyclic_dependency && u == smallest_node_id_in_cycle) {
-              cluster_ids[u] = v;
-              _cluster_weight[v] += weight_u;
-              ++contracted_nodes;
+              if ( joinFixedVertexBlock<has_fixed_vertices>(u, v) ) {
+                cluster_ids[u] = v;
+                _cluster_weight[v] += weight_u;
+                ++contracted_nodes;
+                success = true;
+              }
               _matching_state[v] = STATE(MatchingState::MATCHED);
               _matching_state[u] = STATE(MatchingState::MATCHED);
-              success = true;
             }
           }
 
@@ -383,7 +435,8 @@ class MultilevelCoarsener : public ICoarsener,
             ASSERT( _matching_state[v] == STATE(MatchingState::MATCHED) );
             const HypernodeID cluster_v = cluster_ids[v];
             const HypernodeWeight weight_v = _cluster_weight[cluster_v];
-            if ( weight_u + weight_v <= _context.coarsening.max_allowed_node_weight ){
+            if ( weight_u + weight_v <= _context.coarsening.max_allowed_node_weight &&
+                 joinFixedVertexBlock<has_fixed_vertices>(u, cluster_v) ) {
               cluster_ids[u] = cluster_v;
               _cluster_weight[cluster_v] += weight_u;
               ++contracted_nodes;
@@ -400,6 +453,119 @@ class MultilevelCoarsener : public ICoarsener,
     return success;
   }
 
+  // ! Returns true, if u can join the cluster with representative rep without
+  // ! contracting vertices fixed to different blocks. If u is fixed, the cluster
+  // ! becomes fixed to the block of u. Note, u must not be part of a cluster.
+  template<bool has_fixed_vertices>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool joinFixedVertexBlock(const HypernodeID u,
+                                                               const HypernodeID rep) {
+    if constexpr ( has_fixed_vertices ) {
+      const PartitionID block_u = _cluster_fixed_block[u];
+      if ( block_u != kInvalidPartition ) {
+        PartitionID block_rep = kInvalidPartition;
+        return _cluster_fixed_block[rep].compare_exchange_strong(block_rep, block_u) ||
+          block_rep == block_u;
+      }
+    } else {
+      unused(u);
+      unused(rep);
+    }
+    return true;
+  }
+
+  /*!
+   * On star-like and power-law hypergraphs, many vertices remain unmatched after
+   * the rating phase, since their preferred neighbor is already part of a cluster
+   * that reached the maximum allowed node weight. However, these vertices often
+   * share the same preferred neighbor (e.g., the leaves of a star). Two-hop
+   * clustering merges unmatched vertices with the same preferred neighbor into
+   * clusters (even if they are not adjacent) such that the hierarchy keeps
+   * shrinking geometrically. Returns the number of contracted nodes.
+   */
+  HypernodeID twoHopClustering(const Hypergraph& hypergraph,
+                               parallel::scalable_vector<HypernodeID>& cluster_ids,
+                               const HypernodeID max_num_contractions) {
+    // Compute the preferred neighbor cluster of each unmatched vertex
+    // while ignoring the maximum allowed node weight
+    tbb::enumerable_thread_specific<vec<std::pair<HypernodeID, HypernodeID>>> local_candidates;
+    hypergraph.doParallelForAllNodes([&](const HypernodeID& hn) {
+      if ( _matching_state[hn] == STATE(MatchingState::UNMATCHED) ) {
+        ASSERT(cluster_ids[hn] == hn);
+        const Rating rating = hypergraph.hasFixedVertices() ?
+          _rater.template rate<true>(hypergraph, hn,
+            cluster_ids, _cluster_weight, _cluster_fixed_block, hypergraph.totalWeight()) :
+          _rater.template rate<false>(hypergraph, hn,
+            cluster_ids, _cluster_weight, _cluster_fixed_block, hypergraph.totalWeight());
+        if ( rating.target != kInvalidHypernode ) {
+          local_candidates.local().emplace_back(rating.target, hn);
+        }
+      }
+    });
+    vec<std::pair<HypernodeID, HypernodeID>> candidates;
+    for ( const auto& local : local_candidates ) {
+      candidates.insert(candidates.end(), local.begin(), local.end());
+    }
+    // Vertices with the same preferred neighbor form consecutive runs
+    tbb::parallel_sort(candidates.begin(), candidates.end());
+
+    // Each run is split into chunks of bounded size that are processed in
+    // parallel. Vertices of a chunk are greedily merged into the cluster of
+    // the first vertex as long as the maximum allowed node weight is not exceeded.
+    // Vertices fixed to a different block than the cluster are skipped.
+    const bool has_fixed_vertices = hypergraph.hasFixedVertices();
+    const HypernodeWeight max_allowed_node_weight = _context.coarsening.max_allowed_node_weight;
+    parallel::IntegralAtomicWrapper<HypernodeID> num_contractions(0);
+    tbb::parallel_for(UL(0), candidates.size(), [&](const size_t chunk_start) {
+      const HypernodeID preferred_neighbor = candidates[chunk_start].first;
+      if ( chunk_start % TWO_HOP_CHUNK_SIZE != 0 && chunk_start > 0 &&
+           candidates[chunk_start - 1].first == preferred_neighbor ) {
+        // Not the start of a chunk
+        return;
+      }
+
+      HypernodeID leader = candidates[chunk_start].second;
+      HypernodeWeight leader_weight = _cluster_weight[leader];
+      PartitionID leader_block = has_fixed_vertices ?
+        _cluster_fixed_block[leader].load() : kInvalidPartition;
+      auto finalize_cluster = [&] {
+        if ( leader_weight != _cluster_weight[leader] ) {
+          _cluster_weight[leader] = leader_weight;
+          _matching_state[leader] = STATE(MatchingState::MATCHED);
+          if ( has_fixed_vertices ) {
+            _cluster_fixed_block[leader] = leader_block;
+          }
+        }
+      };
+      for ( size_t i = chunk_start + 1; i < candidates.size() &&
+            i % TWO_HOP_CHUNK_SIZE != 0 && candidates[i].first == preferred_neighbor; ++i ) {
+        if ( num_contractions.load(std::memory_order_relaxed) >= max_num_contractions ) {
+          break;
+        }
+        const HypernodeID u = candidates[i].second;
+        const HypernodeWeight weight_u = hypergraph.nodeWeight(u);
+        const PartitionID block_u = has_fixed_vertices ? hypergraph.fixedVertexBlock(u) : kInvalidPartition;
+        if ( block_u != kInvalidPartition && leader_block != kInvalidPartition && block_u != leader_block ) {
+          continue;
+        }
+        if ( leader_weight + weight_u <= max_allowed_node_weight ) {
+          cluster_ids[u] = leader;
+          leader_weight += weight_u;
+          leader_block = block_u != kInvalidPartition ? block_u : leader_block;
+          _matching_state[u] = STATE(MatchingState::MATCHED);
+          ++num_contractions;
+        } else {
+          // Start a new cluster
+          finalize_cluster();
+          leader = u;
+          leader_weight = _cluster_weight[u];
+          leader_block = block_u;
+        }
+      }
+      finalize_cluster();
+    });
+    return num_contractions.load();
+  }
+
   HypernodeID currentNumberOfNodesImpl() const override {
     return Base::currentNumNodes();
   }
@@ -425,6 +591,8 @@ class MultilevelCoarsener : public ICoarsener,
   parallel::scalable_vector<AtomicMatchingState> _matching_state;
   parallel::scalable_vector<AtomicWeight> _cluster_weight;
   parallel::scalable_vector<HypernodeID> _matching_partner;
+  // ! Block to which a cluster is fixed (only allocated if the hypergraph contains fixed vertices)
+  parallel::scalable_vector<AtomicBlock> _cluster_fixed_block;
   int _pass_nr;
   utils::ProgressBar _progress_bar;
   bool _enable_randomization;
@@ -72,7 +72,7 @@ class MultilevelCoarsenerBase {
     if ( _uncoarseningData.hierarchy.empty() ) {
       return _hg;
     } else {
-      return _uncoarseningData.hierarchy.back().contractedHypergraph();
+      return _uncoarseningData.hierarchy.back().coarseningHypergraph();
     }
   }
 
@@ -30,17 +30,29 @@
 #include "mt-kahypar/definitions.h"
 #include "mt-kahypar/io/partitioning_output.h"
 #include "mt-kahypar/partition/refinement/i_refiner.h"
+#include "mt-kahypar/parallel/phase_concurrency.h"
 #include "mt-kahypar/partition/metrics.h"
 #include "mt-kahypar/partition/refinement/flows/scheduler.h"
 #include "mt-kahypar/partition/refinement/rebalancing/rebalancer.h"
 #include "mt-kahypar/utils/stats.h"
 
+#include <tbb/parallel_reduce.h>
+
 namespace mt_kahypar {
 
   void MultilevelUncoarsener::initializeImpl() {
     PartitionedHypergraph& partitioned_hg = *_uncoarseningData.partitioned_hg;
+    if ( _context.refinement.track_objective ) {
+      partitioned_hg.enableObjectiveTracking();
+    }
+    if ( _context.refinement.track_cut_nets ) {
+      partitioned_hg.enableCutNetTracking();
+    }
     _current_metrics = initializeMetrics(partitioned_hg);
     initializeRefinementAlgorithms();
+    if ( _context.usesExternalRefiner() ) {
+      _external_refiner = std::make_unique<ExternalRefiner>(_context);
+    }
 
     if (_context.type == ContextType::main) {
       _context.initial_km1 = _current_metrics.km1;
@@ -55,6 +67,7 @@ namespace mt_kahypar {
 
     _current_level = _uncoarseningData.hierarchy.size();
     _num_levels = _current_level;
+    _start = std::chrono::high_resolution_clock::now();
   }
 
   bool MultilevelUncoarsener::isTopLevelImpl() const {
@@ -76,6 +89,11 @@ namespace mt_kahypar {
       // Project partition to the hypergraph on the next level of the hierarchy
       _timer.start_timer("projecting_partition", "Projecting Partition");
       const size_t num_nodes_on_previous_level = partitioned_hg.initialNumNodes();
+      // The number of border nodes introduced by the projection estimates how much
+      // refinement on the next level can improve the partition
+      const bool skip_low_value_levels = _context.refinement.low_value_level_border_fraction > 0.0;
+      const HypernodeID num_border_nodes_before =
+        skip_low_value_levels ? numBorderNodes(partitioned_hg) : 0;
       if (_current_level == 0) {
         partitioned_hg.setHypergraph(_hg);
       } else {
@@ -97,8 +115,23 @@ namespace mt_kahypar {
       partitioned_hg.initializePartition();
       _timer.stop_timer("projecting_partition");
 
+      if ( skip_low_value_levels && _current_level > 0 ) {
+        // The finest level is always refined with all refinement algorithms
+        const HypernodeID num_border_nodes = numBorderNodes(partitioned_hg);
+        const HypernodeID num_new_border_nodes = num_border_nodes > num_border_nodes_before ?
+          num_border_nodes - num_border_nodes_before : 0;
+        _label_propagation_only = num_new_border_nodes <
+          _context.refinement.low_value_level_border_fraction * num_border_nodes;
+        if ( _label_propagation_only ) {
+          ++_num_label_propagation_only_levels;
+          DBG << "Level" << _current_level << "is only refined with label propagation"
+              << V(num_new_border_nodes) << V(num_border_nodes);
+        }
+      }
+
       // Improve partition
       refine();
+      _label_propagation_only = false;
 
       // Update Progress Bar
       _progress.setObjective(
@@ -111,6 +144,12 @@ namespace mt_kahypar {
             V(_current_metrics.getMetric(Mode::direct, _context.partition.objective))
             << V(metrics::objective(*_uncoarseningData.partitioned_hg, _context.partition.objective)));
 
+    reportProgress(partitioned_hg, _current_metrics, _current_level, _num_levels);
+    if ( _current_level == 0 && _context.type == ContextType::main &&
+         _context.refinement.low_value_level_border_fraction > 0.0 ) {
+      utils::Utilities::instance().getStats(_context.utility_id).add_stat(
+        "num_label_propagation_only_levels", static_cast<int64_t>(_num_label_propagation_only_levels));
+    }
     --_current_level;
   }
 
@@ -188,9 +227,92 @@ namespace mt_kahypar {
     return std::move(*_uncoarseningData.partitioned_hg);
   }
 
+  HypernodeID MultilevelUncoarsener::numBorderNodes(PartitionedHypergraph& phg) const {
+    if ( phg.isCutNetTracked() ) {
+      // Only visits the pins of cut hyperedges
+      tbb::enumerable_thread_specific<HypernodeID> num_border_nodes(0);
+      phg.doParallelForAllBorderNodes([&](const HypernodeID) {
+        ++num_border_nodes.local();
+      });
+      return num_border_nodes.combine(std::plus<>());
+    }
+    return tbb::parallel_reduce(
+      tbb::blocked_range<HypernodeID>(ID(0), phg.initialNumNodes()), ID(0),
+      [&](const tbb::blocked_range<HypernodeID>& range, HypernodeID num_border_nodes) {
+        for ( HypernodeID hn = range.begin(); hn < range.end(); ++hn ) {
+          if ( phg.nodeIsEnabled(hn) && phg.isBorderNode(hn) ) {
+            ++num_border_nodes;
+          }
+        }
+        return num_border_nodes;
+      }, std::plus<HypernodeID>());
+  }
+
+  size_t MultilevelUncoarsener::levelNumPins(const int level) const {
+    // Level i is the hypergraph contracted in step i - 1 of the hierarchy (level 0 = input)
+    return level == 0 ? _hg.initialNumPins() :
+      (_uncoarseningData.hierarchy)[level - 1].contractedHypergraph().initialNumPins();
+  }
+
+  void MultilevelUncoarsener::startLevelTimeBudget() {
+    if ( utils::TimeBudget* budget = _context.mainTimeBudget() ) {
+      // The remaining levels are the current and all finer levels
+      double remaining_num_pins = 0.0;
+      for ( int level = 0; level <= _current_level; ++level ) {
+        remaining_num_pins += levelNumPins(level);
+      }
+      budget->startLevel(levelNumPins(_current_level), remaining_num_pins);
+    }
+  }
+
+  double MultilevelUncoarsener::remainingUncoarseningTime() const {
+    double remaining_time = std::numeric_limits<double>::max();
+    if ( _context.refinement.max_uncoarsening_time != std::numeric_limits<double>::max() ) {
+      const HighResClockTimepoint now = std::chrono::high_resolution_clock::now();
+      remaining_time = _context.refinement.max_uncoarsening_time -
+        std::chrono::duration<double>(now - _start).count();
+    }
+    if ( const utils::TimeBudget* budget = _context.mainTimeBudget() ) {
+      remaining_time = std::min(remaining_time, budget->remainingLevelTime());
+    }
+    return remaining_time;
+  }
+
+  void MultilevelUncoarsener::recordRefinerRun(const std::string& refiner,
+                                               const HyperedgeWeight objective_before,
+                                               const HighResClockTimepoint& start) {
+    if ( _context.type == ContextType::main ) {
+      const double seconds = std::chrono::duration<double>(
+        std::chrono::high_resolution_clock::now() - start).count();
+      utils::Utilities::instance().getLevelStats(_context.utility_id).addRefinerRun(refiner,
+        objective_before, _current_metrics.getMetric(Mode::direct, _context.partition.objective), seconds);
+    }
+  }
+
   void MultilevelUncoarsener::refineImpl() {
+    if ( _context.isCancelled() ) {
+      // The partition is only projected to the remaining levels
+      return;
+    }
+
+    // If the uncoarsening time budget is exhausted, the partition is only projected
+    // to the remaining levels. Otherwise, the refiners must finish within the budget
+    // and the time slice of the current level.
+    startLevelTimeBudget();
+    const double remaining_time = remainingUncoarseningTime();
+    if ( remaining_time <= 0.0 ) {
+      return;
+    }
+
     PartitionedHypergraph& partitioned_hypergraph = *_uncoarseningData.partitioned_hg;
-    const double time_limit = refinementTimeLimit(_context, (_uncoarseningData.hierarchy)[_current_level].coarseningTime());
+    const double time_limit = std::min(remaining_time,
+      refinementTimeLimit(_context, (_uncoarseningData.hierarchy)[_current_level].coarseningTime()));
+
+    if ( _context.type == ContextType::main ) {
+      utils::Utilities::instance().getLevelStats(_context.utility_id).startLevel(_current_level,
+        partitioned_hypergraph.initialNumNodes(), partitioned_hypergraph.initialNumEdges(),
+        partitioned_hypergraph.initialNumPins());
+    }
 
     if ( debug && _context.type == ContextType::main ) {
       io::printHypergraphInfo(partitioned_hypergraph.hypergraph(), "Refinement Hypergraph", false);
@@ -199,42 +321,87 @@ namespace mt_kahypar {
     }
 
     parallel::scalable_vector<HypernodeID> dummy;
+    const bool use_label_propagation = _label_propagation &&
+      _context.refinement.label_propagation.algorithm != LabelPropagationAlgorithm::do_nothing;
+    const bool use_fm = _fm && _context.refinement.fm.algorithm != FMAlgorithm::do_nothing &&
+      !_label_propagation_only;
+    const bool use_flows = _flows && _context.refinement.flows.algorithm != FlowAlgorithm::do_nothing &&
+      !_label_propagation_only;
+    const bool fuse_lp_and_fm = _context.refinement.fuse_lp_and_fm && use_label_propagation && use_fm;
+    if ( _external_refiner ) {
+      _external_refiner->setLevel(_current_level, _num_levels);
+    }
     bool improvement_found = true;
     while( improvement_found ) {
       improvement_found = false;
       const HyperedgeWeight metric_before = _current_metrics.getMetric(
         Mode::direct, _context.partition.objective);
 
-      if ( _label_propagation && _context.refinement.label_propagation.algorithm != LabelPropagationAlgorithm::do_nothing ) {
+      if ( fuse_lp_and_fm ) {
+        // FM initializes the gain cache, which is then kept up-to-date by LP
+        _timer.start_timer("initialize_fm_refiner", "Initialize FM Refiner");
+        _fm->initialize(partitioned_hypergraph);
+        _timer.stop_timer("initialize_fm_refiner");
+      }
+
+      if ( use_label_propagation ) {
         _timer.start_timer("initialize_lp_refiner", "Initialize LP Refiner");
         _label_propagation->initialize(partitioned_hypergraph);
         _timer.stop_timer("initialize_lp_refiner");
 
         _timer.start_timer("label_propagation", "Label Propagation");
+        const HighResClockTimepoint lp_start = std::chrono::high_resolution_clock::now();
+        const HyperedgeWeight lp_before = _current_metrics.getMetric(Mode::direct, _context.partition.objective);
         improvement_found |= _label_propagation->refine(partitioned_hypergraph, dummy, _current_metrics, time_limit);
+        recordRefinerRun("label_propagation", lp_before, lp_start);
         _timer.stop_timer("label_propagation");
       }
 
-      if ( _fm && _context.refinement.fm.algorithm != FMAlgorithm::do_nothing ) {
-        _timer.start_timer("initialize_fm_refiner", "Initialize FM Refiner");
-        _fm->initialize(partitioned_hypergraph);
-        _timer.stop_timer("initialize_fm_refiner");
+      if ( use_fm ) {
+        if ( !fuse_lp_and_fm ) {
+          _timer.start_timer("initialize_fm_refiner", "Initialize FM Refiner");
+          _fm->initialize(partitioned_hypergraph);
+          _timer.stop_timer("initialize_fm_refiner");
+        }
 
+        // If LP and FM are fused, FM starts from the vertices moved by LP. If LP has not
+        // moved any vertex (empty set), FM starts from all border vertices.
+        const parallel::scalable_vector<HypernodeID>& fm_refinement_nodes =
+          fuse_lp_and_fm ? _label_propagation->movedNodes() : dummy;
         _timer.start_timer("fm", "FM");
-        improvement_found |= _fm->refine(partitioned_hypergraph, dummy, _current_metrics, time_limit);
+        const HighResClockTimepoint fm_start = std::chrono::high_resolution_clock::now();
+        const HyperedgeWeight fm_before = _current_metrics.getMetric(Mode::direct, _context.partition.objective);
+        improvement_found |= parallel::executeWithConcurrencyLimit(
+          _context.shared_memory.fm_num_threads, [&] {
+            return _fm->refine(partitioned_hypergraph, fm_refinement_nodes, _current_metrics, time_limit);
+          });
+        recordRefinerRun("fm", fm_before, fm_start);
         _timer.stop_timer("fm");
       }
 
-      if ( _flows && _context.refinement.flows.algorithm != FlowAlgorithm::do_nothing ) {
+      if ( use_flows ) {
         _timer.start_timer("initialize_flow_scheduler", "Initialize Flow Scheduler");
         _flows->initialize(partitioned_hypergraph);
         _timer.stop_timer("initialize_flow_scheduler");
 
         _timer.start_timer("flow_refinement_scheduler", "Flow Refinement Scheduler");
+        const HighResClockTimepoint flows_start = std::chrono::high_resolution_clock::now();
+        const HyperedgeWeight flows_before = _current_metrics.getMetric(Mode::direct, _context.partition.objective);
         improvement_found |= _flows->refine(partitioned_hypergraph, dummy, _current_metrics, time_limit);
+        recordRefinerRun("flows", flows_before, flows_start);
         _timer.stop_timer("flow_refinement_scheduler");
       }
 
+      if ( _external_refiner ) {
+        _timer.start_timer("external_refiner", "External Refiner");
+        _external_refiner->initialize(partitioned_hypergraph);
+        const HighResClockTimepoint external_start = std::chrono::high_resolution_clock::now();
+        const HyperedgeWeight external_before = _current_metrics.getMetric(Mode::direct, _context.partition.objective);
+        improvement_found |= _external_refiner->refine(partitioned_hypergraph, dummy, _current_metrics, time_limit);
+        recordRefinerRun("external", external_before, external_start);
+        _timer.stop_timer("external_refiner");
+      }
+
       if ( _context.type == ContextType::main ) {
         ASSERT(_current_metrics.getMetric(Mode::direct, _context.partition.objective)
                == metrics::objective(partitioned_hypergraph, _context.partition.objective),
@@ -247,7 +414,8 @@ namespace mt_kahypar {
       const double relative_improvement = 1.0 -
         static_cast<double>(metric_after) / metric_before;
       if ( !_context.refinement.refine_until_no_improvement ||
-           relative_improvement <= _context.refinement.relative_improvement_threshold ) {
+           relative_improvement <= _context.refinement.relative_improvement_threshold ||
+           _context.isCancelled() || remainingUncoarseningTime() <= 0.0 ) {
         break;
       }
     }
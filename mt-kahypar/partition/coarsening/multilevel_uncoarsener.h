@@ -32,6 +32,7 @@
 #include "mt-kahypar/partition/coarsening/coarsening_commons.h"
 #include "mt-kahypar/partition/coarsening/i_uncoarsener.h"
 #include "mt-kahypar/partition/coarsening/uncoarsener_base.h"
+#include "mt-kahypar/partition/refinement/external/external_refiner.h"
 #include "mt-kahypar/utils/progress_bar.h"
 
 namespace mt_kahypar {
@@ -48,7 +49,11 @@ namespace mt_kahypar {
       _num_levels(0),
       _block_ids(hypergraph.initialNumNodes(), PartIdType(kInvalidPartition)),
       _current_metrics(),
-      _progress(hypergraph.initialNumNodes(), 0, false) { }
+      _progress(hypergraph.initialNumNodes(), 0, false),
+      _label_propagation_only(false),
+      _num_label_propagation_only_levels(0),
+      _start(std::chrono::high_resolution_clock::now()),
+      _external_refiner(nullptr) { }
 
   MultilevelUncoarsener(const MultilevelUncoarsener&) = delete;
   MultilevelUncoarsener(MultilevelUncoarsener&&) = delete;
@@ -74,11 +79,35 @@ namespace mt_kahypar {
 
   PartitionedHypergraph&& movePartitionedHypergraphImpl() override;
 
+  HypernodeID numBorderNodes(PartitionedHypergraph& phg) const;
+
+  size_t levelNumPins(const int level) const;
+
+  // ! Assigns a slice of the remaining refinement time of the main context
+  // ! to the current level proportional to its number of pins
+  void startLevelTimeBudget();
+
+  // ! Records the objective before and after a refiner run on the current level
+  // ! in the level statistics of the main context
+  void recordRefinerRun(const std::string& refiner,
+                        const HyperedgeWeight objective_before,
+                        const HighResClockTimepoint& start);
+
+  // ! Remaining time of the uncoarsening time budget and the time slice of
+  // ! the current level (can be negative)
+  double remainingUncoarseningTime() const;
+
   int _current_level;
   int _num_levels;
   ds::Array<PartIdType> _block_ids;
   Metrics _current_metrics;
   utils::ProgressBar _progress;
+  // ! If true, the current level is only refined with label propagation
+  bool _label_propagation_only;
+  size_t _num_label_propagation_only_levels;
+  HighResClockTimepoint _start;
+  // ! Calls the user-defined refiner of the context (see utils::ExternalRefinementHook)
+  std::unique_ptr<ExternalRefiner> _external_refiner;
 };
 
 }
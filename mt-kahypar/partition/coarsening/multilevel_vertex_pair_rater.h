@@ -37,10 +37,12 @@
 #include "kahypar/datastructure/fast_reset_flag_array.h"
 #include "kahypar/meta/mandatory.h"
 
+#include "mt-kahypar/datastructures/prefetching.h"
 #include "mt-kahypar/datastructures/sparse_map.h"
 
 #include "mt-kahypar/definitions.h"
 #include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/coarsening/large_hyperedge_pin_sampling.h"
 
 namespace mt_kahypar {
 template <typename ScorePolicy = Mandatory,
@@ -49,6 +51,7 @@ template <typename ScorePolicy = Mandatory,
 class MultilevelVertexPairRater {
   using LargeTmpRatingMap = ds::SparseMap<HypernodeID, RatingType>;
   using CacheEfficientRatingMap = ds::FixedSizeSparseMap<HypernodeID, RatingType>;
+  using SmallRatingMap = ds::SmallSparseMap<HypernodeID, RatingType>;
   using ThreadLocalCacheEfficientRatingMap = tbb::enumerable_thread_specific<CacheEfficientRatingMap>;
   using ThreadLocalVertexDegreeBoundedRatingMap = tbb::enumerable_thread_specific<CacheEfficientRatingMap>;
   using ThreadLocalLargeTmpRatingMap = tbb::enumerable_thread_specific<LargeTmpRatingMap>;
@@ -81,12 +84,14 @@ class MultilevelVertexPairRater {
   };
 
   enum class RatingMapType {
+    SMALL_RATING_MAP,
     CACHE_EFFICIENT_RATING_MAP,
     VERTEX_DEGREE_BOUNDED_RATING_MAP,
     LARGE_RATING_MAP
   };
 
   using AtomicWeight = parallel::IntegralAtomicWrapper<HypernodeWeight>;
+  using AtomicBlock = parallel::IntegralAtomicWrapper<PartitionID>;
 
  public:
   using Rating = VertexPairRating;
@@ -113,24 +118,34 @@ class MultilevelVertexPairRater {
   MultilevelVertexPairRater(MultilevelVertexPairRater&&) = delete;
   MultilevelVertexPairRater & operator= (MultilevelVertexPairRater &&) = delete;
 
+  // ! If has_fixed_vertices is true, clusters fixed to a different block than u
+  // ! (see cluster_fixed_block) are not considered as contraction partner
+  template<bool has_fixed_vertices>
   VertexPairRating rate(const Hypergraph& hypergraph,
                         const HypernodeID u,
                         const parallel::scalable_vector<HypernodeID>& cluster_ids,
                         const parallel::scalable_vector<AtomicWeight>& cluster_weight,
+                        const parallel::scalable_vector<AtomicBlock>& cluster_fixed_block,
                         const HypernodeWeight max_allowed_node_weight) {
 
     const RatingMapType rating_map_type = getRatingMapTypeForRatingOfHypernode(hypergraph, u);
-    if ( rating_map_type == RatingMapType::CACHE_EFFICIENT_RATING_MAP ) {
-      return rate(hypergraph, u, _local_cache_efficient_rating_map.local(),
-        cluster_ids, cluster_weight, max_allowed_node_weight, false);
+    if ( rating_map_type == RatingMapType::SMALL_RATING_MAP ) {
+      // Vertices with a small neighborhood (e.g., almost all vertices of graph-like
+      // hypergraphs) are rated with a stack-allocated map to avoid hashing overheads
+      SmallRatingMap small_rating_map(0.0);
+      return rate<has_fixed_vertices>(hypergraph, u, small_rating_map,
+        cluster_ids, cluster_weight, cluster_fixed_block, max_allowed_node_weight, false);
+    } else if ( rating_map_type == RatingMapType::CACHE_EFFICIENT_RATING_MAP ) {
+      return rate<has_fixed_vertices>(hypergraph, u, _local_cache_efficient_rating_map.local(),
+        cluster_ids, cluster_weight, cluster_fixed_block, max_allowed_node_weight, false);
     } else if ( rating_map_type == RatingMapType::VERTEX_DEGREE_BOUNDED_RATING_MAP ) {
-      return rate(hypergraph, u, _local_vertex_degree_bounded_rating_map.local(),
-        cluster_ids, cluster_weight, max_allowed_node_weight, true);
+      return rate<has_fixed_vertices>(hypergraph, u, _local_vertex_degree_bounded_rating_map.local(),
+        cluster_ids, cluster_weight, cluster_fixed_block, max_allowed_node_weight, true);
     } else {
       LargeTmpRatingMap& large_tmp_rating_map = _local_large_rating_map.local();
       large_tmp_rating_map.setMaxSize(_current_num_nodes);
-      return rate(hypergraph, u, large_tmp_rating_map,
-        cluster_ids, cluster_weight, max_allowed_node_weight, false);
+      return rate<has_fixed_vertices>(hypergraph, u, large_tmp_rating_map,
+        cluster_ids, cluster_weight, cluster_fixed_block, max_allowed_node_weight, false);
     }
   }
 
@@ -151,12 +166,13 @@ class MultilevelVertexPairRater {
   }
 
  private:
-  template<typename RatingMap>
+  template<bool has_fixed_vertices, typename RatingMap>
   VertexPairRating rate(const Hypergraph& hypergraph,
                         const HypernodeID u,
                         RatingMap& tmp_ratings,
                         const parallel::scalable_vector<HypernodeID>& cluster_ids,
                         const parallel::scalable_vector<AtomicWeight>& cluster_weight,
+                        const parallel::scalable_vector<AtomicBlock>& cluster_fixed_block,
                         const HypernodeWeight max_allowed_node_weight,
                         const bool use_vertex_degree_sampling) {
 
@@ -169,6 +185,10 @@ class MultilevelVertexPairRater {
     int cpu_id = SCHED_GETCPU;
     const HypernodeWeight weight_u = cluster_weight[u];
     const PartitionID community_u_id = hypergraph.communityID(u);
+    PartitionID fixed_block_u = kInvalidPartition;
+    if constexpr ( has_fixed_vertices ) {
+      fixed_block_u = cluster_fixed_block[u];
+    }
     RatingType max_rating = std::numeric_limits<RatingType>::min();
     HypernodeID target = std::numeric_limits<HypernodeID>::max();
     HypernodeID target_id = std::numeric_limits<HypernodeID>::max();
@@ -177,6 +197,15 @@ class MultilevelVertexPairRater {
       const HypernodeID tmp_target = tmp_target_id;
       const HypernodeWeight target_weight = cluster_weight[tmp_target_id];
 
+      if constexpr ( has_fixed_vertices ) {
+        // Never rate clusters fixed to a different block
+        const PartitionID fixed_block_target = cluster_fixed_block[tmp_target_id];
+        if ( fixed_block_u != kInvalidPartition && fixed_block_target != kInvalidPartition &&
+             fixed_block_u != fixed_block_target ) {
+          continue;
+        }
+      }
+
       if ( tmp_target != u && weight_u + target_weight <= max_allowed_node_weight ) {
         HypernodeWeight penalty = HeavyNodePenaltyPolicy::penalty(weight_u, target_weight);
         penalty = penalty == 0 ? std::max(std::max(weight_u, target_weight), 1) : penalty;
@@ -210,8 +239,23 @@ class MultilevelVertexPairRater {
                      const HypernodeID u,
                      RatingMap& tmp_ratings,
                      const parallel::scalable_vector<HypernodeID>& cluster_ids) {
+    if constexpr ( Hypergraph::is_graph && Hypergraph::is_static_hypergraph ) {
+      if ( ID(2) < _context.partition.ignore_hyperedge_size_threshold ) {
+        fillRatingMapOfGraphNode(hypergraph, u, tmp_ratings, cluster_ids);
+        return;
+      }
+    }
+
     kahypar::ds::FastResetFlagArray<>& bloom_filter = _local_bloom_filter.local();
-    for ( const HyperedgeID& he : hypergraph.incidentEdges(u) ) {
+    // The cluster ids of the pins are accessed in random order => we prefetch the pins of
+    // the upcoming incident nets and the cluster ids of the upcoming pins
+    auto prefetch_net = [&](const HyperedgeID he) {
+      prefetchNet(hypergraph, he);
+    };
+    auto prefetch_cluster_id = [&](const HypernodeID v) {
+      MT_KAHYPAR_PREFETCH(cluster_ids.data() + v);
+    };
+    ds::forEachWithLookAhead(hypergraph.incidentEdges(u), prefetch_net, [&](const HyperedgeID he) {
       HypernodeID edge_size = hypergraph.edgeSize(he);
       ASSERT(edge_size > 1, V(he));
       if ( edge_size < _context.partition.ignore_hyperedge_size_threshold ) {
@@ -219,7 +263,7 @@ class MultilevelVertexPairRater {
           std::max(adaptiveEdgeSize(hypergraph, he, bloom_filter, cluster_ids), ID(2)) : edge_size;
         const RatingType score = ScorePolicy::score(
           hypergraph.edgeWeight(he), edge_size);
-        for ( const HypernodeID& v : hypergraph.pins(he) ) {
+        ds::forEachWithLookAhead(hypergraph.pins(he), prefetch_cluster_id, [&](const HypernodeID v) {
           const HypernodeID representative = cluster_ids[v];
           ASSERT(representative < hypergraph.initialNumNodes());
           const HypernodeID bloom_filter_rep = representative & _bloom_filter_mask;
@@ -227,8 +271,56 @@ class MultilevelVertexPairRater {
             tmp_ratings[representative] += score;
             bloom_filter.set(bloom_filter_rep, true);
           }
-        }
+        });
         bloom_filter.reset();
+      } else if ( _context.partition.large_hyperedge_pin_sample_size > 0 ) {
+        // Large hyperedges contribute to the rating of the sampled pins
+        const RatingType score = ScorePolicy::score(
+          hypergraph.edgeWeight(he), edge_size);
+        forEachSampledPin(hypergraph, he, u, _context.partition.large_hyperedge_pin_sample_size,
+          [&](const HypernodeID v) {
+            const HypernodeID representative = cluster_ids[v];
+            const HypernodeID bloom_filter_rep = representative & _bloom_filter_mask;
+            if ( !bloom_filter[bloom_filter_rep] ) {
+              tmp_ratings[representative] += score;
+              bloom_filter.set(bloom_filter_rep, true);
+            }
+          });
+        bloom_filter.reset();
+      }
+    });
+  }
+
+  template<typename HG>
+  static void prefetchNet(const HG& hypergraph, const HyperedgeID he) {
+    if constexpr ( HG::is_static_hypergraph && !HG::is_graph ) {
+      hypergraph.prefetchHyperedge(he);
+      hypergraph.prefetchPins(he);
+    } else {
+      unused(hypergraph);
+      unused(he);
+    }
+  }
+
+  // ! On static graphs, each edge has exactly two pins and its (adaptive) edge size
+  // ! is always two. Thus, we can accumulate the ratings in a tight loop over the
+  // ! adjacency array without pin iterators and per-edge bloom filter resets. The
+  // ! ratings are inserted in the same order as in fillRatingMap(...) (source before
+  // ! target), which produces the same contraction partners.
+  template<typename Graph, typename RatingMap>
+  void fillRatingMapOfGraphNode(const Graph& graph,
+                                const HypernodeID u,
+                                RatingMap& tmp_ratings,
+                                const parallel::scalable_vector<HypernodeID>& cluster_ids) {
+    for ( const HyperedgeID& e : graph.incidentEdges(u) ) {
+      const RatingType score = ScorePolicy::score(graph.edgeWeight(e), ID(2));
+      const HypernodeID source_rep = cluster_ids[graph.edgeSource(e)];
+      const HypernodeID target_rep = cluster_ids[graph.edgeTarget(e)];
+      ASSERT(source_rep < graph.initialNumNodes() && target_rep < graph.initialNumNodes());
+      tmp_ratings[source_rep] += score;
+      // The general case skips the target, if both representatives collide in the bloom filter
+      if ( (source_rep & _bloom_filter_mask) != (target_rep & _bloom_filter_mask) ) {
+        tmp_ratings[target_rep] += score;
       }
     }
   }
@@ -263,6 +355,23 @@ class MultilevelVertexPairRater {
           }
         }
         bloom_filter.reset();
+      } else if ( _context.partition.large_hyperedge_pin_sample_size > 0 ) {
+        const HypernodeID sample_size = _context.partition.large_hyperedge_pin_sample_size;
+        if ( num_tmp_rating_map_accesses + sample_size > _vertex_degree_sampling_threshold  ) {
+          break;
+        }
+        const RatingType score = ScorePolicy::score(
+          hypergraph.edgeWeight(he), edge_size);
+        forEachSampledPin(hypergraph, he, u, sample_size, [&](const HypernodeID v) {
+          const HypernodeID representative = cluster_ids[v];
+          const HypernodeID bloom_filter_rep = representative & _bloom_filter_mask;
+          if ( !bloom_filter[bloom_filter_rep] ) {
+            tmp_ratings[representative] += score;
+            bloom_filter.set(bloom_filter_rep, true);
+            ++num_tmp_rating_map_accesses;
+          }
+        });
+        bloom_filter.reset();
       }
     }
   }
@@ -295,6 +404,20 @@ class MultilevelVertexPairRater {
     const size_t size_of_smaller_rating_map = std::min(
       vertex_degree_bounded_rating_map_size, cache_efficient_rating_map_size);
 
+    // The sum of the sizes of the incident nets is an upper bound for the number of
+    // neighbors of u. If it fits into the small rating map, we use it.
+    HypernodeID small_ub_neighbors_u = 0;
+    for ( const HyperedgeID& he : hypergraph.incidentEdges(u) ) {
+      const HypernodeID edge_size = hypergraph.edgeSize(he);
+      small_ub_neighbors_u += numRatedPins(edge_size);
+      if ( small_ub_neighbors_u > SmallRatingMap::MAP_SIZE ) {
+        break;
+      }
+    }
+    if ( small_ub_neighbors_u <= SmallRatingMap::MAP_SIZE ) {
+      return RatingMapType::SMALL_RATING_MAP;
+    }
+
     // In case the current number of nodes is smaller than size
     // of the cache-efficient sparse map, the large tmp rating map
     // consumes less memory
@@ -306,8 +429,8 @@ class MultilevelVertexPairRater {
     HypernodeID ub_neighbors_u = 0;
     for ( const HyperedgeID& he : hypergraph.incidentEdges(u) ) {
       const HypernodeID edge_size = hypergraph.edgeSize(he);
-      // Ignore large hyperedges
-      ub_neighbors_u += edge_size < _context.partition.ignore_hyperedge_size_threshold ? edge_size : 0;
+      // Large hyperedges are ignored or sampled
+      ub_neighbors_u += numRatedPins(edge_size);
       // If the number of estimated neighbors is greater than the size of the cache efficient rating map / 3, we
       // use the large sparse map. The division by 3 also ensures that the fill grade
       // of the cache efficient sparse map would be small enough such that linear probing
@@ -324,6 +447,12 @@ class MultilevelVertexPairRater {
     return RatingMapType::CACHE_EFFICIENT_RATING_MAP;
   }
 
+  // ! Number of pins of a hyperedge that are inserted into the rating map
+  inline HypernodeID numRatedPins(const HypernodeID edge_size) const {
+    return edge_size < _context.partition.ignore_hyperedge_size_threshold ? edge_size :
+      std::min(edge_size, _context.partition.large_hyperedge_pin_sample_size);
+  }
+
   LargeTmpRatingMap construct_large_tmp_rating_map() {
     return LargeTmpRatingMap(_current_num_nodes);
   }
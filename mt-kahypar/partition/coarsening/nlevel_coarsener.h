@@ -35,6 +35,8 @@
 #include "kahypar/meta/mandatory.h"
 
 #include "mt-kahypar/definitions.h"
+#include "mt-kahypar/datastructures/streaming_vector.h"
+#include "mt-kahypar/datastructures/thread_safe_fast_reset_flag_array.h"
 #include "mt-kahypar/partition/coarsening/nlevel_coarsener_base.h"
 #include "mt-kahypar/partition/coarsening/nlevel_vertex_pair_rater.h"
 #include "mt-kahypar/partition/coarsening/i_coarsener.h"
@@ -135,6 +137,9 @@ class NLevelCoarsener : public ICoarsener,
     _current_vertices(),
     _tmp_current_vertices(),
     _enabled_vertex_flag_array(),
+    _claimed_vertices(context.coarsening.nlevel_contraction_batch_size > 0 ?
+      hypergraph.initialNumNodes() : 0),
+    _matching(),
     _cl_tracker(context),
     _pass_nr(0),
     _progress_bar(hypergraph.initialNumNodes(), 0, false),
@@ -187,13 +192,17 @@ class NLevelCoarsener : public ICoarsener,
 
     HighResClockTimepoint round_start = std::chrono::high_resolution_clock::now();
     _timer.start_timer("clustering", "Clustering");
-    tbb::parallel_for(UL(0), _current_vertices.size(), [&](const size_t i) {
-      if ( _cl_tracker.currentNumNodes() > contraction_limit ) {
-        const HypernodeID& hn = _current_vertices[i];
-        const HypernodeID num_contractions = contract(hn);
-        _cl_tracker.update(num_contractions, contraction_limit);
-      }
-    });
+    if ( _context.coarsening.nlevel_contraction_batch_size > 0 ) {
+      contractInBatches(contraction_limit);
+    } else {
+      tbb::parallel_for(UL(0), _current_vertices.size(), [&](const size_t i) {
+        if ( _cl_tracker.currentNumNodes() > contraction_limit ) {
+          const HypernodeID& hn = _current_vertices[i];
+          const HypernodeID num_contractions = contract(hn);
+          _cl_tracker.update(num_contractions, contraction_limit);
+        }
+      });
+    }
     _timer.stop_timer("clustering");
 
     // Remove single-pin and parallel nets
@@ -253,6 +262,53 @@ class NLevelCoarsener : public ICoarsener,
     return num_contractions;
   }
 
+  // ! Rates the vertices of _current_vertices in batches of nlevel_contraction_batch_size
+  // ! vertices. The ratings of a batch are reduced to a conflict-free matching, which is
+  // ! then contracted in bulk. Since rating and contraction are separated and the vertex
+  // ! pairs of the matching are disjoint, the contractions need no vertex locks.
+  void contractInBatches(const double contraction_limit) {
+    const size_t batch_size = _context.coarsening.nlevel_contraction_batch_size;
+    for ( size_t first = 0; first < _current_vertices.size() &&
+          _cl_tracker.currentNumNodes() > contraction_limit; first += batch_size ) {
+      const size_t last = std::min(first + batch_size, _current_vertices.size());
+      _claimed_vertices.reset();
+      tbb::parallel_for(first, last, [&](const size_t i) {
+        const HypernodeID hn = _current_vertices[i];
+        if ( _hg.nodeIsEnabled(hn) && _claimed_vertices.compare_and_set_to_true(hn) ) {
+          const Rating rating = _rater.rate(_hg, hn, _context.coarsening.max_allowed_node_weight);
+          if ( rating.target != kInvalidHypernode &&
+               _claimed_vertices.compare_and_set_to_true(rating.target) ) {
+            HypernodeID u = rating.target;
+            HypernodeID v = hn;
+            // In case v is a high degree vertex, we reverse contraction order to improve performance
+            if ( _hg.nodeDegree(u) < _hg.nodeDegree(v) && _hg.nodeDegree(v) > HIGH_DEGREE_VERTEX_THRESHOLD ) {
+              std::swap(u, v);
+            }
+            _rater.markAsMatched(u);
+            _rater.markAsMatched(v);
+            _matching.stream(Memento { u, v });
+          } else {
+            // Release hn such that other vertices of the batch can still be matched with it
+            _claimed_vertices.set(hn, false);
+          }
+        }
+      });
+
+      Batch matching = _matching.copy_parallel();
+      _matching.clear_parallel();
+      // Do not contract more vertex pairs than required to reach the contraction limit
+      const size_t max_num_contractions = std::ceil(_cl_tracker.currentNumNodes() - contraction_limit);
+      if ( matching.size() > max_num_contractions ) {
+        matching.resize(max_num_contractions);
+      }
+      const HypernodeID num_contractions = _hg.contractMatching(
+        matching, _context.coarsening.max_allowed_node_weight);
+      _progress_bar += num_contractions;
+      _cl_tracker.update(num_contractions, contraction_limit);
+      _cl_tracker.updateCurrentNumNodes();
+    }
+  }
+
   HypernodeID currentNumberOfNodesImpl() const override {
     return _cl_tracker.currentNumNodes();
   }
@@ -301,6 +357,9 @@ class NLevelCoarsener : public ICoarsener,
   parallel::scalable_vector<HypernodeID> _current_vertices;
   parallel::scalable_vector<HypernodeID> _tmp_current_vertices;
   parallel::scalable_vector<size_t> _enabled_vertex_flag_array;
+  // ! Vertices that are already part of the matching of the current batch
+  ds::ThreadSafeFastResetFlagArray<> _claimed_vertices;
+  ds::StreamingVector<Memento> _matching;
   ContractionLimitTracker _cl_tracker;
   int _pass_nr;
   utils::ProgressBar _progress_bar;
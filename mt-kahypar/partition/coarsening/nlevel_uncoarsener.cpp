@@ -31,6 +31,7 @@
 #include "kahypar/datastructure/fast_reset_flag_array.h"
 
 #include "mt-kahypar/definitions.h"
+#include "mt-kahypar/parallel/phase_concurrency.h"
 #include "mt-kahypar/partition/refinement/flows/scheduler.h"
 #include "mt-kahypar/partition/refinement/rebalancing/rebalancer.h"
 #include "mt-kahypar/utils/progress_bar.h"
@@ -43,6 +44,7 @@ namespace mt_kahypar {
     // Initialize n-level batch uncontraction hierarchy
     _timer.start_timer("create_batch_uncontraction_hierarchy", "Create n-Level Hierarchy");
     _hierarchy = _hg.createBatchUncontractionHierarchy(_context.refinement.max_batch_size);
+    _num_levels = _hierarchy.size();
     ASSERT(_uncoarseningData.removed_hyperedges_batches.size() == _hierarchy.size() - 1);
     _timer.stop_timer("create_batch_uncontraction_hierarchy");
 
@@ -68,12 +70,19 @@ namespace mt_kahypar {
       _uncoarseningData.partitioned_hg->setOnlyNodePart(hn, block_id);
     });
     _uncoarseningData.partitioned_hg->initializePartition();
+    if ( _context.refinement.track_objective ) {
+      _uncoarseningData.partitioned_hg->enableObjectiveTracking();
+    }
+    if ( _context.refinement.track_cut_nets ) {
+      _uncoarseningData.partitioned_hg->enableCutNetTracking();
+    }
 
-    // Initialize Gain Cache
+    // Initialize Gain Cache (uncontractions only update a fully initialized gain cache)
     if ( _context.refinement.fm.algorithm == FMAlgorithm::fm_gain_cache
-        || _context.refinement.fm.algorithm == FMAlgorithm::fm_gain_cache_on_demand ) {
+        || _context.refinement.fm.algorithm == FMAlgorithm::fm_gain_cache_on_demand
+        || _context.refinement.fm.algorithm == FMAlgorithm::fm_gain_cache_lazy ) {
       _uncoarseningData.partitioned_hg->allocateGainTableIfNecessary();
-      if ( _context.refinement.fm.algorithm == FMAlgorithm::fm_gain_cache ) {
+      if ( _context.refinement.fm.algorithm != FMAlgorithm::fm_gain_cache_on_demand ) {
         _uncoarseningData.partitioned_hg->initializeGainCache();
       }
     }
@@ -161,8 +170,9 @@ namespace mt_kahypar {
         _timer.stop_timer("collect_border_vertices", _force_measure_timings);
 
         // We perform localized refinement around the uncontracted nodes if the current number
-        // of border nodes is greater than a predefined threshold.
-        if ( _tmp_refinement_nodes.size() >= _stats.min_num_border_vertices ) {
+        // of border nodes is greater than a predefined threshold (which optionally grows
+        // with the current number of nodes).
+        if ( _tmp_refinement_nodes.size() >= _stats.minNumBorderVertices() ) {
           localizedRefine(*_uncoarseningData.partitioned_hg);
         }
 
@@ -222,6 +232,8 @@ namespace mt_kahypar {
         _timer.enable();
       }
     }
+
+    reportProgress(*_uncoarseningData.partitioned_hg, _current_metrics, _hierarchy.size(), _num_levels);
   }
 
   void NLevelUncoarsener::refineImpl() {
@@ -323,13 +335,21 @@ namespace mt_kahypar {
         _timer.stop_timer("fm", _force_measure_timings);
       }
 
+      if ( _flows && _context.refinement.flows.algorithm != FlowAlgorithm::do_nothing &&
+           _context.refinement.flows.use_localized_flows ) {
+        _timer.start_timer("localized_flows", "Localized Flows", false, _force_measure_timings);
+        improvement_found |= _flows->refine(partitioned_hypergraph,
+          refinement_nodes, _current_metrics, std::numeric_limits<double>::max());
+        _timer.stop_timer("localized_flows", _force_measure_timings);
+      }
+
       if ( _context.type == ContextType::main ) {
         ASSERT(_current_metrics.km1 == metrics::km1(partitioned_hypergraph),
                "Actual metric" << V(metrics::km1(partitioned_hypergraph))
                << "does not match the metric updated by the refiners" << V(_current_metrics.km1));
       }
 
-      if ( !_context.refinement.refine_until_no_improvement ) {
+      if ( !_context.refinement.refine_until_no_improvement || _context.isCancelled() ) {
         break;
       }
     }
@@ -378,7 +398,10 @@ namespace mt_kahypar {
 
         if ( _fm && _context.refinement.fm.algorithm != FMAlgorithm::do_nothing ) {
           _timer.start_timer("fm", "FM");
-          improvement_found |= _fm->refine(partitioned_hypergraph, {}, _current_metrics, time_limit);
+          improvement_found |= parallel::executeWithConcurrencyLimit(
+            _context.shared_memory.fm_num_threads, [&] {
+              return _fm->refine(partitioned_hypergraph, {}, _current_metrics, time_limit);
+            });
           _timer.stop_timer("fm");
         }
 
@@ -403,7 +426,8 @@ namespace mt_kahypar {
         const double relative_improvement = 1.0 -
           static_cast<double>(metric_after) / metric_before;
         if ( !_context.refinement.global_fm.refine_until_no_improvement ||
-            relative_improvement <= _context.refinement.relative_improvement_threshold ) {
+            relative_improvement <= _context.refinement.relative_improvement_threshold ||
+            _context.isCancelled() ) {
           break;
         }
       }
@@ -51,7 +51,8 @@ class NLevelUncoarsener : public IUncoarsener,
       num_batches(0),
       total_batch_sizes(0),
       current_number_of_nodes(0),
-      min_num_border_vertices(0) {
+      min_num_border_vertices(0),
+      min_border_vertices_fraction(context.refinement.min_border_vertices_fraction) {
       min_num_border_vertices = std::max(context.refinement.max_batch_size,
         context.shared_memory.num_threads * context.refinement.min_border_vertices_per_thread);
     }
@@ -65,11 +66,19 @@ class NLevelUncoarsener : public IUncoarsener,
       DBG << V(num_batches) << V(avg_batch_size);
     }
 
+    // ! Localized refinement is performed if the number of collected border vertices
+    // ! is at least max(min_num_border_vertices, min_border_vertices_fraction * current_number_of_nodes)
+    size_t minNumBorderVertices() const {
+      return std::max(min_num_border_vertices, static_cast<size_t>(
+        min_border_vertices_fraction * current_number_of_nodes));
+    }
+
     const size_t utility_id;
     size_t num_batches;
     size_t total_batch_sizes;
     HypernodeID current_number_of_nodes;
     size_t min_num_border_vertices;
+    double min_border_vertices_fraction;
   };
 
  public:
@@ -83,6 +92,7 @@ class NLevelUncoarsener : public IUncoarsener,
     _stats(context),
     _current_metrics(),
     _progress(hypergraph.initialNumNodes(), 0, false),
+    _num_levels(0),
     _is_timer_disabled(false),
     _force_measure_timings(context.partition.measure_detailed_uncontraction_timings && context.type == ContextType::main) { }
 
@@ -129,6 +139,7 @@ class NLevelUncoarsener : public IUncoarsener,
   NLevelStats _stats;
   Metrics _current_metrics;
   utils::ProgressBar _progress;
+  size_t _num_levels;
   bool _is_timer_disabled;
   bool _force_measure_timings;
 };
@@ -40,6 +40,7 @@
 
 #include "mt-kahypar/definitions.h"
 #include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/coarsening/large_hyperedge_pin_sampling.h"
 
 namespace mt_kahypar {
 template <typename ScorePolicy = Mandatory,
@@ -198,6 +199,13 @@ class NLevelVertexPairRater {
         for ( const HypernodeID& v : hypergraph.pins(he) ) {
           tmp_ratings[v] += score;
         }
+      } else if ( edge_size > 1 && _context.partition.large_hyperedge_pin_sample_size > 0 ) {
+        // Large hyperedges contribute to the rating of the sampled pins
+        const RatingType score = ScorePolicy::score(hypergraph.edgeWeight(he), edge_size);
+        forEachSampledPin(hypergraph, he, u, _context.partition.large_hyperedge_pin_sample_size,
+          [&](const HypernodeID v) {
+            tmp_ratings[v] += score;
+          });
       }
     }
   }
@@ -220,6 +228,16 @@ class NLevelVertexPairRater {
           tmp_ratings[v] += score;
           ++num_tmp_rating_map_accesses;
         }
+      } else if ( edge_size > 1 && _context.partition.large_hyperedge_pin_sample_size > 0 ) {
+        const HypernodeID sample_size = _context.partition.large_hyperedge_pin_sample_size;
+        if ( num_tmp_rating_map_accesses + sample_size > _vertex_degree_sampling_threshold  ) {
+          break;
+        }
+        const RatingType score = ScorePolicy::score(hypergraph.edgeWeight(he), edge_size);
+        forEachSampledPin(hypergraph, he, u, sample_size, [&](const HypernodeID v) {
+          tmp_ratings[v] += score;
+          ++num_tmp_rating_map_accesses;
+        });
       }
     }
   }
@@ -245,8 +263,9 @@ class NLevelVertexPairRater {
     HypernodeID ub_neighbors_u = 0;
     for ( const HyperedgeID& he : hypergraph.incidentEdges(u) ) {
       const HypernodeID edge_size = hypergraph.edgeSize(he);
-      // Ignore large hyperedges
-      ub_neighbors_u += edge_size < _context.partition.ignore_hyperedge_size_threshold ? edge_size : 0;
+      // Large hyperedges are ignored or sampled
+      ub_neighbors_u += edge_size < _context.partition.ignore_hyperedge_size_threshold ? edge_size :
+        std::min(edge_size, _context.partition.large_hyperedge_pin_sample_size);
       // If the number of estimated neighbors is greater than the size of the cache efficient rating map / 3, we
       // use the large sparse map. The division by 3 also ensures that the fill grade
       // of the cache efficient sparse map would be small enough such that linear probing
@@ -74,6 +74,23 @@ class UncoarsenerBase {
 
  protected:
 
+  // ! Reports the metrics of the current partition after refining a level
+  // ! of the hierarchy to the progress callback of the context
+  void reportProgress(const PartitionedHypergraph& phg,
+                      const Metrics& current_metrics,
+                      const size_t level,
+                      const size_t num_levels) const {
+    if ( _context.reportsProgress() ) {
+      utils::ProgressUpdate update;
+      update.phase = utils::ProgressPhase::refinement;
+      update.level = level;
+      update.num_levels = num_levels;
+      update.objective = current_metrics.getMetric(Mode::direct, _context.partition.objective);
+      update.imbalance = metrics::imbalance(phg, _context);
+      _context.reportProgress(update);
+    }
+  }
+
   double refinementTimeLimit(const Context& context, const double time) {
     if ( context.refinement.fm.time_limit_factor != std::numeric_limits<double>::max() ) {
       const double time_limit_factor = std::max(1.0,  context.refinement.fm.time_limit_factor * context.partition.k);
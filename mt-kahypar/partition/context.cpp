@@ -51,8 +51,36 @@ namespace mt_kahypar {
     str << "  epsilon:                            " << params.epsilon << std::endl;
     str << "  seed:                               " << params.seed << std::endl;
     str << "  Number of V-Cycles:                 " << params.num_vcycles << std::endl;
+    if ( params.num_vcycles > 0 && params.localized_vcycles ) {
+      str << "  Localized V-Cycle Distance:         " << params.localized_vcycle_distance << std::endl;
+    }
+    str << "  Anytime Mode:                       " << std::boolalpha << params.anytime << std::endl;
+    if ( params.time_limit > 0 ) {
+      str << "  Time Limit:                         " << params.time_limit << " s" << std::endl;
+    }
+    if ( !params.checkpoint_file.empty() ) {
+      str << "  Checkpoint File:                    " << params.checkpoint_file << std::endl;
+    }
+    if ( !params.fixed_vertex_filename.empty() ) {
+      str << "  Fixed Vertex File:                  " << params.fixed_vertex_filename << std::endl;
+    }
     str << "  Ignore HE Size Threshold:           " << params.ignore_hyperedge_size_threshold << std::endl;
     str << "  Large HE Size Threshold:            " << params.large_hyperedge_size_threshold << std::endl;
+    if ( params.large_hyperedge_pin_sample_size > 0 ) {
+      str << "  Large HE Pin Sample Size:           " << params.large_hyperedge_pin_sample_size << std::endl;
+    }
+    if ( params.small_instance_num_pins_threshold > 0 ) {
+      str << "  Small Instance Pin Threshold:       " << params.small_instance_num_pins_threshold << std::endl;
+    }
+    if ( params.memory_limit > 0 ) {
+      str << "  Memory Limit:                       " << params.memory_limit << " MB" << std::endl;
+    }
+    if ( params.result_cache_size > 0 ) {
+      str << "  Result Cache Size:                  " << params.result_cache_size << std::endl;
+    }
+    if ( !params.result_cache_directory.empty() ) {
+      str << "  Result Cache Directory:             " << params.result_cache_directory << std::endl;
+    }
     if ( params.use_individual_part_weights ) {
       str << "  Individual Part Weights:            ";
       for ( const HypernodeWeight& w : params.max_part_weights ) {
@@ -64,6 +92,13 @@ namespace mt_kahypar {
       str << "  Perform Parallel Recursion:         " << std::boolalpha
           << params.perform_parallel_recursion_in_deep_multilevel << std::endl;
     }
+    if ( params.mode == Mode::streaming ) {
+      str << "  Streaming Buffer Size:              " << params.streaming_buffer_size << std::endl;
+      str << "  Streaming Refinement Rounds:        " << params.streaming_refinement_rounds << std::endl;
+    }
+    if ( params.mode == Mode::multisection ) {
+      str << "  Multisection Top-Level Blocks:      " << params.multisection_k1 << std::endl;
+    }
     return str;
   }
 
@@ -73,7 +108,13 @@ namespace mt_kahypar {
     str << "    Maximum Louvain-Pass Iterations:     " << params.max_pass_iterations << std::endl;
     str << "    Minimum Vertex Move Fraction:        " << params.min_vertex_move_fraction << std::endl;
     str << "    Vertex Degree Sampling Threshold:    " << params.vertex_degree_sampling_threshold << std::endl;
+    str << "    Use Active Set Pruning:              " << std::boolalpha << params.use_active_set_pruning << std::endl;
+    str << "    High Degree Vertex Threshold:        " << params.high_degree_vertex_threshold << std::endl;
     str << "    Number of subrounds (deterministic): " << params.num_sub_rounds_deterministic << std::endl;
+    str << "    Implicit Star-Expansion:             " << std::boolalpha << params.implicit_star_expansion << std::endl;
+    if ( !params.cache_directory.empty() ) {
+      str << "    Cache Directory:                     " << params.cache_directory << std::endl;
+    }
     return str;
   }
 
@@ -83,6 +124,8 @@ namespace mt_kahypar {
     #ifdef USE_GRAPH_PARTITIONER
     str << "  Disable C. D. for Mesh Graphs:      " << std::boolalpha << params.disable_community_detection_for_mesh_graphs << std::endl;
     #endif
+    str << "  Remove Twin Vertices:               " << std::boolalpha << params.remove_twin_vertices << std::endl;
+    str << "  Reorder For Locality:               " << std::boolalpha << params.reorder_for_locality << std::endl;
     if (params.use_community_detection) {
       str << std::endl << params.community_detection;
     }
@@ -109,6 +152,23 @@ namespace mt_kahypar {
     str << "  Maximum Shrink Factor:              " << params.maximum_shrink_factor << std::endl;
     str << "  Vertex Degree Sampling Threshold:   " << params.vertex_degree_sampling_threshold << std::endl;
     str << "  Number of subrounds (deterministic):" << params.num_sub_rounds_deterministic << std::endl;
+    str << "  Conflict Resolution (deterministic):" << std::boolalpha << params.deterministic_conflict_resolution << std::endl;
+    str << "  Low Memory Contraction:             " << std::boolalpha << params.low_memory_contraction << std::endl;
+    str << "  Vertex Order Tile Size:             " << params.vertex_order_tile_size << std::endl;
+    str << "  Order Clusters by Community:        " << std::boolalpha << params.order_clusters_by_community << std::endl;
+    str << "  Use MinHash Sparsifier:             " << std::boolalpha << params.use_min_hash_sparsifier << std::endl;
+    str << "  Reuse Hierarchy in RB:              " << std::boolalpha << params.reuse_hierarchy_in_rb << std::endl;
+    if ( params.use_min_hash_sparsifier ) {
+      str << "  MinHash Number of Hash Functions:   " << params.min_hash_num_hash_functions << std::endl;
+      str << "  MinHash Similarity Threshold:       " << params.min_hash_similarity_threshold << std::endl;
+      str << "  Similar Net Combiner Strategy:      " << params.similar_net_combiner_strategy << std::endl;
+    }
+    str << "  N-Level Contraction Batch Size:     " << params.nlevel_contraction_batch_size << std::endl;
+    str << "  Level Arena Factor:                 " << params.level_arena_factor << std::endl;
+    if ( !params.offload_directory.empty() ) {
+      str << "  Offload Directory:                  " << params.offload_directory << std::endl;
+      str << "  Offload Min Number of Pins:         " << params.offload_min_num_pins << std::endl;
+    }
     str << std::endl << params.rating;
     return str;
   }
@@ -120,6 +180,7 @@ namespace mt_kahypar {
       str << "    Maximum Iterations:               " << params.maximum_iterations << std::endl;
       str << "    Rebalancing:                      " << std::boolalpha << params.rebalancing << std::endl;
       str << "    HE Size Activation Threshold:     " << std::boolalpha << params.hyperedge_size_activation_threshold << std::endl;
+      str << "    Dense Frontier Threshold:         " << params.dense_frontier_threshold << std::endl;
     }
     return str;
   }
@@ -134,10 +195,17 @@ namespace mt_kahypar {
       out << "    Rollback Bal. Violation Factor:   " << params.rollback_balance_violation_factor << std::endl;
       out << "    Num Seed Nodes:                   " << params.num_seed_nodes << std::endl;
       out << "    Enable Random Shuffle:            " << std::boolalpha << params.shuffle << std::endl;
+      out << "    Order Seeds By Gain:              " << std::boolalpha << params.order_seeds_by_gain << std::endl;
       out << "    Obey Minimal Parallelism:         " << std::boolalpha << params.obey_minimal_parallelism << std::endl;
       out << "    Minimum Improvement Factor:       " << params.min_improvement << std::endl;
+      out << "    Minimum Expected Improvement:     " << params.min_expected_improvement << std::endl;
       out << "    Release Nodes:                    " << std::boolalpha << params.release_nodes << std::endl;
+      out << "    Adaptive Stop Rule:               " << std::boolalpha << params.adaptive_stop_rule << std::endl;
+      out << "    Bucket Queue Max Gain:            " << params.bucket_queue_max_gain << std::endl;
       out << "    Time Limit Factor:                " << params.time_limit_factor << std::endl;
+      if ( params.algorithm == FMAlgorithm::jet ) {
+        out << "    Jet Negative Gain Factor:         " << params.jet_negative_gain_factor << std::endl;
+      }
     }
     out << std::flush;
     return out;
@@ -159,7 +227,11 @@ namespace mt_kahypar {
     if ( params.algorithm != FlowAlgorithm::do_nothing ) {
       out << "    Flow Scaling:                     " << params.alpha << std::endl;
       out << "    Maximum Number of Pins:           " << params.max_num_pins << std::endl;
+      out << "    Max. Num. Pins of Conc. Searches: " << params.max_num_pins_of_concurrent_searches << std::endl;
+      out << "    Min. Num. Pins for Parallel Flow: " << params.min_num_pins_for_parallel_flow << std::endl;
+      out << "    Min. Num. Pins for Par. Growing:  " << params.min_num_pins_for_parallel_region_growing << std::endl;
       out << "    Find Most Balanced Cut:           " << std::boolalpha << params.find_most_balanced_cut << std::endl;
+      out << "    Most Balanced Cut Portfolio Size: " << params.most_balanced_cut_portfolio_size << std::endl;
       out << "    Determine Distance From Cut:      " << std::boolalpha << params.determine_distance_from_cut << std::endl;
       out << "    Parallel Searches Multiplier:     " << params.parallel_searches_multiplier << std::endl;
       out << "    Number of Parallel Searches:      " << params.num_parallel_searches << std::endl;
@@ -169,6 +241,12 @@ namespace mt_kahypar {
       out << "    Skip Small Cuts:                  " << std::boolalpha << params.skip_small_cuts << std::endl;
       out << "    Skip Unpromising Blocks:          " << std::boolalpha << params.skip_unpromising_blocks << std::endl;
       out << "    Pierce in Bulk:                   " << std::boolalpha << params.pierce_in_bulk << std::endl;
+      out << "    Prioritize Block Pairs:           " << std::boolalpha << params.prioritize_block_pairs << std::endl;
+      out << "    Unproductive Pair Cut Change:     " << params.unproductive_block_pair_cut_change << std::endl;
+      out << "    Parallel Apply Moves:             " << std::boolalpha << params.parallel_apply_moves << std::endl;
+      out << "    Reorder Nodes:                    " << std::boolalpha << params.reorder_nodes << std::endl;
+      out << "    Use Localized Flows:              " << std::boolalpha << params.use_localized_flows << std::endl;
+      out << "    Localized Max. BFS Distance:      " << params.localized_max_bfs_distance << std::endl;
       out << std::flush;
     }
     return out;
@@ -186,9 +264,16 @@ namespace mt_kahypar {
     str << "Refinement Parameters:" << std::endl;
     str << "  Refine Until No Improvement:        " << std::boolalpha << params.refine_until_no_improvement << std::endl;
     str << "  Relative Improvement Threshold:     " << params.relative_improvement_threshold << std::endl;
+    str << "  Fuse LP and FM:                     " << std::boolalpha << params.fuse_lp_and_fm << std::endl;
+    str << "  Track Objective:                    " << std::boolalpha << params.track_objective << std::endl;
+    str << "  Track Cut Nets:                     " << std::boolalpha << params.track_cut_nets << std::endl;
+    str << "  Defer High-Degree Moves:            " << std::boolalpha << params.defer_high_degree_moves << std::endl;
+    str << "  Low-Value Level Border Fraction:    " << params.low_value_level_border_fraction << std::endl;
+    str << "  Max Uncoarsening Time:              " << params.max_uncoarsening_time << std::endl;
 #ifdef USE_STRONG_PARTITIONER
     str << "  Maximum Batch Size:                 " << params.max_batch_size << std::endl;
     str << "  Min Border Vertices Per Thread:     " << params.min_border_vertices_per_thread << std::endl;
+    str << "  Min Border Vertices Fraction:       " << params.min_border_vertices_fraction << std::endl;
 #endif
     str << "\n" << params.label_propagation;
     str << "\n" << params.fm;
@@ -206,12 +291,16 @@ namespace mt_kahypar {
     str << "  Use Adaptive IP Runs:               " << std::boolalpha << params.use_adaptive_ip_runs << std::endl;
     if ( params.use_adaptive_ip_runs ) {
       str << "  Min Adaptive IP Runs:               " << params.min_adaptive_ip_runs << std::endl;
+      str << "  Use IP Racing Scheduler:            " << std::boolalpha << params.use_ip_racing_scheduler << std::endl;
     }
     str << "  Perform Refinement On Best:         " << std::boolalpha << params.perform_refinement_on_best_partitions << std::endl;
     str << "  Fm Refinement Rounds:               " << params.fm_refinment_rounds << std::endl;
     str << "  Remove Degree-Zero HNs Before IP:   " << std::boolalpha << params.remove_degree_zero_hns_before_ip << std::endl;
     str << "  Maximum Iterations of LP IP:        " << params.lp_maximum_iterations << std::endl;
     str << "  Initial Block Size of LP IP:        " << params.lp_initial_block_size << std::endl;
+    str << "  Nested Parallelism Min Nodes:       " << params.nested_parallelism_min_nodes << std::endl;
+    str << "  Portfolio Levels:                   " << params.portfolio_levels << std::endl;
+    str << "  Heavy Vertex Weight Fraction:       " << params.heavy_vertex_weight_fraction << std::endl;
     str << "\nInitial Partitioning ";
     str << params.refinement << std::endl;
     return str;
@@ -221,15 +310,32 @@ namespace mt_kahypar {
     str << "Shared Memory Parameters:             " << std::endl;
     str << "  Number of Threads:                  " << params.num_threads << std::endl;
     str << "  Number of used NUMA nodes:          " << TBBInitializer::instance().num_used_numa_nodes() << std::endl;
+    str << "  NUMA Placement Policy:              " << params.numa_placement << std::endl;
+    str << "  Thread Placement Policy:            " << params.thread_placement << std::endl;
+    str << "  Number of Threads in FM:            " << (params.fm_num_threads > 0 ?
+      params.fm_num_threads : params.num_threads) << std::endl;
+    str << "  Number of Threads in Contraction:   " << (params.contraction_num_threads > 0 ?
+      params.contraction_num_threads : params.num_threads) << std::endl;
+    str << "  Use Huge Pages:                     " << std::boolalpha << params.use_huge_pages << std::endl;
+    str << "  Release Memory Between Phases:      " << std::boolalpha << params.release_memory_between_phases << std::endl;
+    str << "  Elastic Number of Threads:          " << std::boolalpha << params.elastic_num_threads << std::endl;
+    str << "  NUMA-Aware Refinement:              " << std::boolalpha << params.numa_aware_refinement << std::endl;
     str << "  Use Localized Random Shuffle:       " << std::boolalpha << params.use_localized_random_shuffle << std::endl;
     str << "  Random Shuffle Block Size:          " << params.shuffle_block_size << std::endl;
     return str;
   }
 
+  void Context::reportProgress(const utils::ProgressUpdate& update) const {
+    if ( reportsProgress() && !progress_reporter->report(update) && cancellation_token ) {
+      cancellation_token->cancel();
+    }
+  }
+
   bool Context::forceGainCacheUpdates() const {
     return partition.paradigm == Paradigm::nlevel ||
       partition.mode == Mode::deep_multilevel ||
-      refinement.refine_until_no_improvement;
+      refinement.refine_until_no_improvement ||
+      refinement.fuse_lp_and_fm;
   }
 
   void Context::setupPartWeights(const HypernodeWeight total_hypergraph_weight) {
@@ -304,8 +410,14 @@ namespace mt_kahypar {
   }
 
   void Context::sanityCheck() {
+    if ( partition.k > kMaxNumBlocks ) {
+      ERR("The number of blocks exceeds the maximum supported by this build (k <=" << kMaxNumBlocks << ")."
+          << "Compile without KAHYPAR_USE_8_BIT_PART_IDS/KAHYPAR_USE_16_BIT_PART_IDS to partition into more blocks.");
+    }
+
     if ( partition.paradigm == Paradigm::nlevel &&
-         coarsening.algorithm == CoarseningAlgorithm::multilevel_coarsener ) {
+         ( coarsening.algorithm == CoarseningAlgorithm::multilevel_coarsener ||
+           coarsening.algorithm == CoarseningAlgorithm::two_hop_multilevel_coarsener ) ) {
         ALGO_SWITCH("Coarsening algorithm" << coarsening.algorithm << "is only supported in multilevel mode."
                                            << "Do you want to use the n-level version instead (Y/N)?",
                     "Partitioning with" << coarsening.algorithm
@@ -399,15 +511,41 @@ namespace mt_kahypar {
                   partition.max_part_weights.size());
     }
 
+    for ( FlowParameters* flows : { &refinement.flows, &initial_partitioning.refinement.flows } ) {
+      #ifdef USE_GRAPH_PARTITIONER
+      // On graphs, flow networks do not have to be expanded into flow hypergraphs
+      if ( flows->algorithm == FlowAlgorithm::flow_cutter ) {
+        flows->algorithm = FlowAlgorithm::graph_flow_cutter;
+      }
+      #else
+      if ( flows->algorithm == FlowAlgorithm::graph_flow_cutter ) {
+        WARNING("Flow algorithm" << flows->algorithm << "is only supported for graphs."
+                << "Switching to" << FlowAlgorithm::flow_cutter << ".");
+        flows->algorithm = FlowAlgorithm::flow_cutter;
+      }
+      #endif
+    }
+
+    #if defined(USE_GRAPH_PARTITIONER) || defined(USE_STRONG_PARTITIONER)
+    if ( !coarsening.offload_directory.empty() ) {
+      WARNING("Offloading the multilevel hierarchy to disk is only supported by the"
+              << "static hypergraph data structure. Option is ignored.");
+      coarsening.offload_directory = "";
+    }
+    #endif
 
     shared_memory.static_balancing_work_packages = std::clamp(shared_memory.static_balancing_work_packages, UL(4), UL(256));
 
     if ( partition.deterministic ) {
       coarsening.algorithm = CoarseningAlgorithm::deterministic_multilevel_coarsener;
 
-      // disable FM until we have a deterministic version
-      refinement.fm.algorithm = FMAlgorithm::do_nothing;
-      initial_partitioning.refinement.fm.algorithm = FMAlgorithm::do_nothing;
+      // switch silently to the deterministic FM version
+      if ( refinement.fm.algorithm != FMAlgorithm::do_nothing ) {
+        refinement.fm.algorithm = FMAlgorithm::deterministic;
+      }
+      if ( initial_partitioning.refinement.fm.algorithm != FMAlgorithm::do_nothing ) {
+        initial_partitioning.refinement.fm.algorithm = FMAlgorithm::deterministic;
+      }
 
       // disable adaptive IP
       initial_partitioning.use_adaptive_ip_runs = false;
@@ -427,7 +565,8 @@ namespace mt_kahypar {
   }
 
   void Context::setupThreadsPerFlowSearch() {
-    if ( refinement.flows.algorithm == FlowAlgorithm::flow_cutter ) {
+    if ( refinement.flows.algorithm == FlowAlgorithm::flow_cutter ||
+         refinement.flows.algorithm == FlowAlgorithm::graph_flow_cutter ) {
       // = min(t, min(tau * k, k * (k - 1) / 2))
       // t = number of threads
       // k * (k - 1) / 2 = maximum number of edges in the quotient graph
@@ -444,6 +583,7 @@ namespace mt_kahypar {
     partition.smallest_large_he_size_threshold = 50000;
     partition.ignore_hyperedge_size_threshold = 1000;
     partition.num_vcycles = 0;
+    partition.small_instance_num_pins_threshold = 10000;
 
     // shared_memory
     shared_memory.use_localized_random_shuffle = false;
@@ -455,6 +595,8 @@ namespace mt_kahypar {
     preprocessing.community_detection.max_pass_iterations = 5;
     preprocessing.community_detection.min_vertex_move_fraction = 0.01;
     preprocessing.community_detection.vertex_degree_sampling_threshold = 200000;
+    preprocessing.community_detection.use_active_set_pruning = true;
+    preprocessing.community_detection.high_degree_vertex_threshold = 50000;
 
     // coarsening
     coarsening.algorithm = CoarseningAlgorithm::multilevel_coarsener;
@@ -475,11 +617,13 @@ namespace mt_kahypar {
     initial_partitioning.runs = 20;
     initial_partitioning.use_adaptive_ip_runs = true;
     initial_partitioning.min_adaptive_ip_runs = 5;
+    initial_partitioning.use_ip_racing_scheduler = true;
     initial_partitioning.perform_refinement_on_best_partitions = true;
     initial_partitioning.fm_refinment_rounds = 1;
     initial_partitioning.lp_maximum_iterations = 20;
     initial_partitioning.lp_initial_block_size = 5;
     initial_partitioning.remove_degree_zero_hns_before_ip = true;
+    initial_partitioning.heavy_vertex_weight_fraction = 0.5;
 
     // initial partitioning -> refinement
     initial_partitioning.refinement.refine_until_no_improvement = false;
@@ -550,7 +694,159 @@ namespace mt_kahypar {
     refinement.flows.algorithm = FlowAlgorithm::flow_cutter;
     refinement.flows.alpha = 16;
     refinement.flows.max_num_pins = 4294967295;
+    refinement.flows.max_num_pins_of_concurrent_searches = std::numeric_limits<size_t>::max();
+    refinement.flows.min_num_pins_for_parallel_flow = 0;
+    refinement.flows.min_num_pins_for_parallel_region_growing = 4294967295;
+    refinement.flows.find_most_balanced_cut = true;
+    refinement.flows.most_balanced_cut_portfolio_size = 1;
+    refinement.flows.determine_distance_from_cut = true;
+    refinement.flows.parallel_searches_multiplier = 1.0;
+    refinement.flows.max_bfs_distance = 2;
+    refinement.flows.time_limit_factor = 8;
+    refinement.flows.skip_small_cuts = true;
+    refinement.flows.skip_unpromising_blocks = true;
+    refinement.flows.pierce_in_bulk = true;
+    refinement.flows.prioritize_block_pairs = false;
+    refinement.flows.reorder_nodes = false;
+    refinement.flows.use_localized_flows = false;
+    refinement.flows.localized_max_bfs_distance = 1;
+    refinement.flows.min_relative_improvement_per_round = 0.001;
+  }
+
+  void Context::load_quality_preset() {
+    // General
+    partition.large_hyperedge_size_threshold_factor = 0.01;
+    partition.smallest_large_he_size_threshold = 50000;
+    partition.ignore_hyperedge_size_threshold = 1000;
+    partition.num_vcycles = 0;
+    partition.small_instance_num_pins_threshold = 10000;
+
+    // shared_memory
+    shared_memory.use_localized_random_shuffle = false;
+    shared_memory.static_balancing_work_packages = 128;
+
+    // preprocessing
+    preprocessing.use_community_detection = true;
+    preprocessing.community_detection.edge_weight_function = LouvainEdgeWeight::hybrid;
+    preprocessing.community_detection.max_pass_iterations = 5;
+    preprocessing.community_detection.min_vertex_move_fraction = 0.01;
+    preprocessing.community_detection.vertex_degree_sampling_threshold = 200000;
+    preprocessing.community_detection.use_active_set_pruning = true;
+    preprocessing.community_detection.high_degree_vertex_threshold = 50000;
+
+    // coarsening
+    coarsening.algorithm = CoarseningAlgorithm::nlevel_coarsener;
+    coarsening.use_adaptive_edge_size= true;
+    coarsening.minimum_shrink_factor = 1.01;
+    coarsening.maximum_shrink_factor = 100.0;
+    coarsening.max_allowed_weight_multiplier = 1.0;
+    coarsening.contraction_limit_multiplier = 160;
+    coarsening.vertex_degree_sampling_threshold = 200000;
+
+    // coarsening -> rating
+    coarsening.rating.rating_function = RatingFunction::heavy_edge;
+    coarsening.rating.heavy_node_penalty_policy = HeavyNodePenaltyPolicy::no_penalty;
+    coarsening.rating.acceptance_policy = AcceptancePolicy::best_prefer_unmatched;
+
+    // initial partitioning
+    initial_partitioning.mode = Mode::recursive_bipartitioning;
+    initial_partitioning.runs = 20;
+    initial_partitioning.use_adaptive_ip_runs = true;
+    initial_partitioning.min_adaptive_ip_runs = 5;
+    initial_partitioning.use_ip_racing_scheduler = true;
+    initial_partitioning.perform_refinement_on_best_partitions = true;
+    initial_partitioning.fm_refinment_rounds = 2147483647;
+    initial_partitioning.lp_maximum_iterations = 20;
+    initial_partitioning.lp_initial_block_size = 5;
+    initial_partitioning.remove_degree_zero_hns_before_ip = true;
+    initial_partitioning.heavy_vertex_weight_fraction = 0.5;
+
+    // initial partitioning -> refinement
+    initial_partitioning.refinement.refine_until_no_improvement = true;
+    initial_partitioning.refinement.max_batch_size = 1000;
+    initial_partitioning.refinement.min_border_vertices_per_thread = 0;
+
+    // initial partitioning -> refinement -> label propagation
+    initial_partitioning.refinement.label_propagation.algorithm = LabelPropagationAlgorithm::label_propagation_km1;
+    initial_partitioning.refinement.label_propagation.maximum_iterations = 5;
+    initial_partitioning.refinement.label_propagation.rebalancing = true;
+    initial_partitioning.refinement.label_propagation.hyperedge_size_activation_threshold = 100;
+
+    // initial partitioning -> refinement -> fm
+    initial_partitioning.refinement.fm.algorithm = FMAlgorithm::fm_gain_cache;
+    initial_partitioning.refinement.fm.multitry_rounds = 5;
+    initial_partitioning.refinement.fm.perform_moves_global = false;
+    initial_partitioning.refinement.fm.rollback_parallel = false;
+    initial_partitioning.refinement.fm.rollback_balance_violation_factor = 1;
+    initial_partitioning.refinement.fm.num_seed_nodes = 5;
+    initial_partitioning.refinement.fm.obey_minimal_parallelism = false;
+    initial_partitioning.refinement.fm.release_nodes = true;
+    initial_partitioning.refinement.fm.time_limit_factor = 0.25;
+
+    // initial partitioning -> refinement -> flows
+    initial_partitioning.refinement.flows.algorithm = FlowAlgorithm::do_nothing;
+
+    // initial partitioning -> refinement -> global fm
+    initial_partitioning.refinement.global_fm.use_global_fm = false;
+
+    // refinement
+    refinement.refine_until_no_improvement = true;
+    refinement.max_batch_size = 1000;
+    refinement.min_border_vertices_per_thread = 50;
+
+    // refinement -> label propagation
+    refinement.label_propagation.algorithm = LabelPropagationAlgorithm::label_propagation_km1;
+    refinement.label_propagation.maximum_iterations = 5;
+    refinement.label_propagation.rebalancing = true;
+    refinement.label_propagation.hyperedge_size_activation_threshold = 100;
+
+    // refinement -> fm
+    refinement.fm.algorithm = FMAlgorithm::fm_gain_cache;
+    refinement.fm.multitry_rounds = 10;
+    refinement.fm.perform_moves_global = false;
+    refinement.fm.rollback_parallel = false;
+    refinement.fm.rollback_balance_violation_factor = 1.25;
+    refinement.fm.num_seed_nodes = 5;
+    refinement.fm.release_nodes = true;
+    refinement.fm.min_improvement = -1;
+    refinement.fm.obey_minimal_parallelism = false;
+    refinement.fm.time_limit_factor = 0.25;
+    refinement.fm.iter_moves_on_recalc = true;
+
+    // refinement -> flows
+    refinement.flows.algorithm = FlowAlgorithm::do_nothing;
+
+    // refinement -> global fm
+    refinement.global_fm.use_global_fm = true;
+    refinement.global_fm.refine_until_no_improvement = false;
+    refinement.global_fm.num_seed_nodes = 5;
+    refinement.global_fm.obey_minimal_parallelism = true;
+  }
+
+  void Context::load_quality_flow_preset() {
+    load_quality_preset();
+
+    // initial partitioning -> refinement
+    initial_partitioning.refinement.relative_improvement_threshold = 0.0;
+
+    // refinement
+    refinement.relative_improvement_threshold = 0.0025;
+
+    // refinement -> fm
+    refinement.fm.iter_moves_on_recalc = false;
+
+    // refinement -> global fm
+    refinement.global_fm.refine_until_no_improvement = true;
+
+    // refinement -> flows;
+    refinement.flows.algorithm = FlowAlgorithm::flow_cutter;
+    refinement.flows.alpha = 16;
+    refinement.flows.max_num_pins = 4294967295;
+    refinement.flows.max_num_pins_of_concurrent_searches = std::numeric_limits<size_t>::max();
+    refinement.flows.min_num_pins_for_parallel_flow = 0;
+    refinement.flows.min_num_pins_for_parallel_region_growing = 4294967295;
     refinement.flows.find_most_balanced_cut = true;
+    refinement.flows.most_balanced_cut_portfolio_size = 1;
     refinement.flows.determine_distance_from_cut = true;
     refinement.flows.parallel_searches_multiplier = 1.0;
     refinement.flows.max_bfs_distance = 2;
@@ -558,6 +854,10 @@ namespace mt_kahypar {
     refinement.flows.skip_small_cuts = true;
     refinement.flows.skip_unpromising_blocks = true;
     refinement.flows.pierce_in_bulk = true;
+    refinement.flows.prioritize_block_pairs = false;
+    refinement.flows.reorder_nodes = false;
+    refinement.flows.use_localized_flows = false;
+    refinement.flows.localized_max_bfs_distance = 1;
     refinement.flows.min_relative_improvement_per_round = 0.001;
   }
 
@@ -580,6 +880,8 @@ namespace mt_kahypar {
     preprocessing.community_detection.max_pass_iterations = 5;
     preprocessing.community_detection.min_vertex_move_fraction = 0.01;
     preprocessing.community_detection.vertex_degree_sampling_threshold = 200000;
+    preprocessing.community_detection.use_active_set_pruning = true;
+    preprocessing.community_detection.high_degree_vertex_threshold = 50000;
     preprocessing.community_detection.low_memory_contraction = true;
     preprocessing.community_detection.num_sub_rounds_deterministic = 16;
 
@@ -609,6 +911,7 @@ namespace mt_kahypar {
     initial_partitioning.lp_initial_block_size = 5;
     initial_partitioning.population_size = 64;
     initial_partitioning.remove_degree_zero_hns_before_ip = true;
+    initial_partitioning.heavy_vertex_weight_fraction = 0.5;
 
     // initial partitioning -> refinement
     initial_partitioning.refinement.refine_until_no_improvement = false;
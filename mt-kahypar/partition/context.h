@@ -27,8 +27,15 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include "mt-kahypar/datastructures/hypergraph_common.h"
 #include "mt-kahypar/partition/context_enum_classes.h"
+#include "mt-kahypar/utils/cancellation_token.h"
+#include "mt-kahypar/utils/external_refinement_hook.h"
+#include "mt-kahypar/utils/progress_reporter.h"
+#include "mt-kahypar/utils/time_budget.h"
 #include "mt-kahypar/utils/utilities.h"
 
 namespace mt_kahypar {
@@ -47,9 +54,37 @@ struct PartitioningParameters {
   PartitionID k = std::numeric_limits<PartitionID>::max();
   int seed = 0;
   size_t num_vcycles = 0;
+  // ! If true, each V-cycle contracts all vertices with a distance greater than
+  // ! localized_vcycle_distance to the cut into one vertex per block before coarsening
+  bool localized_vcycles = false;
+  size_t localized_vcycle_distance = 2;
+  // ! Computes a first partition with label propagation only and improves
+  // ! it afterwards with the configured refiners in (at least one) V-cycles
+  bool anytime = false;
+  // ! The partition is written to this file after each V-cycle and a
+  // ! run with V-cycles resumes from it, if it exists (empty = disabled)
+  std::string checkpoint_file { };
+  // ! File that contains the block of each fixed vertex (one line per vertex, -1 = not fixed)
+  std::string fixed_vertex_filename { };
   bool perform_parallel_recursion_in_deep_multilevel = true;
-
+  // ! Number of consecutive vertices that are assigned and refined together in the streaming mode
+  HypernodeID streaming_buffer_size = 32768;
+  // ! Maximum number of label propagation rounds on each buffer in the streaming mode
+  size_t streaming_refinement_rounds = 3;
+  // ! Number of top-level blocks in the multisection mode (0 = round(sqrt(k)))
+  PartitionID multisection_k1 = 0;
+
+  // ! Time limit in seconds (0 = unlimited, see Context::cancellation_token)
   int time_limit = 0;
+  // ! Memory limit in MB (0 = unlimited). If the predicted peak memory exceeds
+  // ! the limit, the partitioner switches to lower-memory algorithms.
+  size_t memory_limit = 0;
+  // ! Maximum number of partitions kept in the in-memory result cache of the
+  // ! library (0 = disabled, see PartitionCache)
+  size_t result_cache_size = 0;
+  // ! Partitions computed by the library are stored in and loaded from this
+  // ! directory in the binary partition format (empty = disabled)
+  std::string result_cache_directory { };
   bool use_individual_part_weights = false;
   std::vector<HypernodeWeight> perfect_balance_part_weights;
   std::vector<HypernodeWeight> max_part_weights;
@@ -57,18 +92,32 @@ struct PartitioningParameters {
   HypernodeID large_hyperedge_size_threshold = std::numeric_limits<HypernodeID>::max();
   HypernodeID smallest_large_he_size_threshold = std::numeric_limits<HypernodeID>::max();
   HypernodeID ignore_hyperedge_size_threshold = std::numeric_limits<HypernodeID>::max();
+  // ! If greater than zero, large hyperedges are not removed before partitioning and
+  // ! hyperedges above the ignore threshold are represented by a sample of this many
+  // ! pins during rating (instead of being ignored)
+  HypernodeID large_hyperedge_pin_sample_size = 0;
+  // ! Inputs with fewer pins are partitioned sequentially in a single-thread task
+  // ! arena without a memory pool (0 = disabled, see Context::isSmallInstance)
+  size_t small_instance_num_pins_threshold = 0;
 
   bool verbose_output = true;
   bool show_detailed_timings = false;
   bool show_detailed_clustering_timings = false;
   bool measure_detailed_uncontraction_timings = false;
   size_t timings_output_depth = std::numeric_limits<size_t>::max();
+  bool measure_hardware_counters = false;
+  bool profile_scalability = false;
+  // ! Timeline of all phases and parallel tasks is written to this file in the Chrome
+  // ! trace format (requires compilation with KAHYPAR_ENABLE_TRACING, empty = disabled)
+  std::string trace_file { };
   bool show_memory_consumption = false;
   bool show_advanced_cut_analysis = false;
   bool enable_progress_bar = false;
   bool sp_process_output = false;
   bool csv_output = false;
   bool write_partition_file = false;
+  // ! Partition file is written in the binary format (see io::writePartitionFile(...))
+  bool binary_partition_file = false;
   bool deterministic = false;
 
   std::string graph_filename { };
@@ -84,9 +133,17 @@ struct CommunityDetectionParameters {
   LouvainEdgeWeight edge_weight_function = LouvainEdgeWeight::UNDEFINED;
   uint32_t max_pass_iterations = std::numeric_limits<uint32_t>::max();
   bool low_memory_contraction = false;
+  // If true, Louvain runs on an implicit view of the star-expansion of the hypergraph
+  // instead of a materialized graph. Only the contracted Louvain levels are materialized.
+  bool implicit_star_expansion = false;
   long double min_vertex_move_fraction = std::numeric_limits<long double>::max();
   size_t vertex_degree_sampling_threshold = std::numeric_limits<size_t>::max();
+  bool use_active_set_pruning = false;
+  size_t high_degree_vertex_threshold = std::numeric_limits<size_t>::max();
   size_t num_sub_rounds_deterministic = 16;
+  // Communities are stored in and loaded from this directory. The file name is a
+  // fingerprint of the input and the community detection parameters (empty = disabled)
+  std::string cache_directory = "";
 };
 
 std::ostream & operator<< (std::ostream& str, const CommunityDetectionParameters& params);
@@ -95,6 +152,10 @@ struct PreprocessingParameters {
   bool stable_construction_of_incident_edges = false;
   bool use_community_detection = false;
   bool disable_community_detection_for_mesh_graphs = true;
+  // ! Merges vertices with identical incident nets before coarsening
+  bool remove_twin_vertices = false;
+  // ! Renumbers vertices and nets in BFS order before partitioning to improve locality
+  bool reorder_for_locality = false;
   CommunityDetectionParameters community_detection = { };
 };
 
@@ -118,6 +179,38 @@ struct CoarseningParameters {
   double maximum_shrink_factor = std::numeric_limits<double>::max();
   size_t vertex_degree_sampling_threshold = std::numeric_limits<size_t>::max();
   size_t num_sub_rounds_deterministic = 16;
+  // If true, a vertex that other vertices of the same sub-round want to join does not
+  // leave its cluster. This avoids swaps and chains of moves within a sub-round,
+  // such that the deterministic coarsener needs fewer sub-rounds (i.e., barriers).
+  bool deterministic_conflict_resolution = false;
+  bool low_memory_contraction = false;
+  // If greater than zero, the n-level coarsener rates this number of vertices at once
+  // and contracts a conflict-free matching of the ratings in bulk (instead of
+  // registering and contracting each vertex pair individually)
+  size_t nlevel_contraction_batch_size = 0;
+  // If greater than zero, vertices are only shuffled within tiles of consecutive
+  // vertex IDs of this size before rating (instead of a global random shuffle)
+  size_t vertex_order_tile_size = 0;
+  // If true, the clusters are relabeled in order of their community IDs before contraction,
+  // such that the vertices of a community have consecutive IDs in the contracted hypergraph
+  bool order_clusters_by_community = false;
+  // If true, similar nets of each coarse hypergraph are merged (MinHash-based locality-sensitive
+  // hashing) before it is coarsened further. Refinement still uses the original coarse hypergraph.
+  bool use_min_hash_sparsifier = false;
+  // If true, recursive bipartitioning contracts the first levels of the hierarchy of each block
+  // according to the hierarchy of the bipartition restricted to the block (instead of coarsening
+  // each block from scratch)
+  bool reuse_hierarchy_in_rb = false;
+  size_t min_hash_num_hash_functions = 2;
+  double min_hash_similarity_threshold = 0.75;
+  SimiliarNetCombinerStrategy similar_net_combiner_strategy = SimiliarNetCombinerStrategy::UNDEFINED;
+  // If greater than zero, the coarse hypergraphs of the multilevel hierarchy are allocated in
+  // a preallocated region of this size relative to the size of the input hypergraph (level arena)
+  double level_arena_factor = 0.0;
+  // Levels of the multilevel hierarchy with at least this number of pins
+  // are moved to a memory-mapped snapshot in this directory (empty = disabled)
+  std::string offload_directory = "";
+  size_t offload_min_num_pins = 0;
 
   // Those will be determined dynamically
   HypernodeWeight max_allowed_node_weight = 0;
@@ -133,6 +226,9 @@ struct LabelPropagationParameters {
   bool rebalancing = true;
   bool execute_sequential = false;
   size_t hyperedge_size_activation_threshold = std::numeric_limits<size_t>::max();
+  // ! If the active nodes of the next round exceed this fraction of the nodes, they are
+  // ! collected from the activation bitmap in ID order and only shuffled within tiles
+  double dense_frontier_threshold = 0.1;
 };
 
 std::ostream & operator<< (std::ostream& str, const LabelPropagationParameters& params);
@@ -145,14 +241,26 @@ struct FMParameters {
 
   double rollback_balance_violation_factor = std::numeric_limits<double>::max();
   double min_improvement = -1.0;
+  // ! Stop multitry FM if the predicted relative improvement of the next round is below this value
+  double min_expected_improvement = -1.0;
   double time_limit_factor = std::numeric_limits<double>::max();
 
   bool perform_moves_global = false;
   bool rollback_parallel = true;
   bool iter_moves_on_recalc = false;
   bool shuffle = true;
+  bool order_seeds_by_gain = false;
   mutable bool obey_minimal_parallelism = false;
   bool release_nodes = true;
+  // ! Adapt the sensitivity of the stop rule to the fraction of locally reverted moves
+  bool adaptive_stop_rule = false;
+  // ! The vertex PQs are bucket queues, if the maximum weighted vertex degree
+  // ! (an upper bound for the gain of a move) is at most this value
+  HyperedgeWeight bucket_queue_max_gain = 256;
+
+  // ! Jet refiner: a vertex with a negative gain becomes a move candidate, if the loss
+  // ! is smaller than this factor times the weight of its nets internal to its block
+  double jet_negative_gain_factor = 0.25;
 };
 
 std::ostream& operator<<(std::ostream& out, const FMParameters& params);
@@ -170,7 +278,11 @@ struct FlowParameters {
   FlowAlgorithm algorithm = FlowAlgorithm::do_nothing;
   double alpha = 0.0;
   HypernodeID max_num_pins = std::numeric_limits<HypernodeID>::max();
+  size_t max_num_pins_of_concurrent_searches = std::numeric_limits<size_t>::max();
+  HypernodeID min_num_pins_for_parallel_flow = 0;
+  HypernodeID min_num_pins_for_parallel_region_growing = std::numeric_limits<HypernodeID>::max();
   bool find_most_balanced_cut = false;
+  size_t most_balanced_cut_portfolio_size = 1;
   bool determine_distance_from_cut = false;
   double parallel_searches_multiplier = 1.0;
   size_t num_parallel_searches = 0;
@@ -180,6 +292,16 @@ struct FlowParameters {
   bool skip_small_cuts = false;
   bool skip_unpromising_blocks = false;
   bool pierce_in_bulk = false;
+  bool prioritize_block_pairs = false;
+  // If greater than zero, block pairs on which all searches failed since the last level and
+  // whose cut weight changed by at most this fraction are not scheduled in the first round
+  double unproductive_block_pair_cut_change = 0.0;
+  // If true, move sequences of successful searches that touch disjoint sets of blocks
+  // are applied concurrently (instead of one after another by the apply lock holder)
+  bool parallel_apply_moves = false;
+  bool reorder_nodes = false;
+  bool use_localized_flows = false;
+  size_t localized_max_bfs_distance = 1;
 };
 
 std::ostream& operator<<(std::ostream& out, const FlowParameters& params);
@@ -200,8 +322,28 @@ struct RefinementParameters {
   FlowParameters flows;
   bool refine_until_no_improvement = false;
   double relative_improvement_threshold = 0.0;
+  // ! LP maintains the gain cache for FM and FM starts from the vertices moved by LP
+  bool fuse_lp_and_fm = false;
   size_t max_batch_size = std::numeric_limits<size_t>::max();
   size_t min_border_vertices_per_thread = 0;
+  // ! n-level: minimum number of border vertices for a localized refinement relative
+  // ! to the current number of nodes (grows the batches geometrically)
+  double min_border_vertices_fraction = 0.0;
+  // ! The partitioned hypergraph maintains the km1 and cut metric incrementally during
+  // ! uncoarsening instead of recomputing it each time it is queried
+  bool track_objective = false;
+  // ! The partitioned hypergraph maintains the set of cut hyperedges incrementally during
+  // ! uncoarsening such that border vertices can be enumerated in time linear in the size of the cut
+  bool track_cut_nets = false;
+  // ! Label propagation and FM defer moves of vertices with more than HIGH_DEGREE_THRESHOLD
+  // ! incident hyperedges to a dedicated phase that updates their incident hyperedges in parallel
+  bool defer_high_degree_moves = false;
+  // ! Multilevel: levels on which the projection introduces fewer new border vertices than
+  // ! this fraction of all border vertices are only refined with label propagation (0 = disabled)
+  double low_value_level_border_fraction = 0.0;
+  // ! Multilevel: time budget (in seconds) for refinement during uncoarsening. If it is
+  // ! exhausted, the partition is only projected to the remaining levels.
+  double max_uncoarsening_time = std::numeric_limits<double>::max();
 };
 
 std::ostream & operator<< (std::ostream& str, const RefinementParameters& params);
@@ -217,12 +359,22 @@ struct InitialPartitioningParameters {
   size_t runs = 1;
   bool use_adaptive_ip_runs = false;
   size_t min_adaptive_ip_runs = std::numeric_limits<size_t>::max();
+  bool use_ip_racing_scheduler = false;
   bool perform_refinement_on_best_partitions = false;
   size_t fm_refinment_rounds = 1;
   bool remove_degree_zero_hns_before_ip = false;
   size_t lp_maximum_iterations = 1;
   size_t lp_initial_block_size = 1;
   size_t population_size = 16;
+  // ! Minimum number of nodes of the hypergraph such that initial
+  // ! partitioning runs use nested parallelism
+  size_t nested_parallelism_min_nodes = 100000;
+  // ! Number of coarsest levels of the hierarchy that are initially partitioned
+  // ! concurrently (the most promising one is uncoarsened, 1 = disabled)
+  size_t portfolio_levels = 1;
+  // ! Vertices heavier than this fraction of the smallest maximum block weight are
+  // ! assigned to blocks via bin packing and fixed during greedy growing (0 = disabled)
+  double heavy_vertex_weight_fraction = 0.0;
 };
 
 std::ostream & operator<< (std::ostream& str, const InitialPartitioningParameters& params);
@@ -234,6 +386,21 @@ struct SharedMemoryParameters {
   bool use_localized_random_shuffle = false;
   size_t shuffle_block_size = 2;
   double degree_of_parallelism = 1.0;
+  NumaPlacementPolicy numa_placement = NumaPlacementPolicy::interleaved;
+  ThreadPlacementPolicy thread_placement = ThreadPlacementPolicy::physical_cores_first;
+  // ! Phase-specific number of threads (0 = all threads)
+  size_t fm_num_threads = 0;
+  size_t contraction_num_threads = 0;
+  bool use_huge_pages = false;
+  // ! If true, memory freed by phase-local data structures is returned to the
+  // ! operating system at the transition between two phases of the main run
+  bool release_memory_between_phases = true;
+  // ! If true, the global thread pool is resized to the current CPU quota of the process
+  // ! at the phase boundaries of the main run (coarsening, initial partitioning, refinement)
+  bool elastic_num_threads = false;
+  // ! If true, label propagation and FM process the nodes of each NUMA node's ID range
+  // ! (see NumaPlacementPolicy::node_id_ranges) with the threads of that NUMA node
+  bool numa_aware_refinement = false;
 };
 
 std::ostream & operator<< (std::ostream& str, const SharedMemoryParameters& params);
@@ -251,6 +418,20 @@ class Context {
   std::string algorithm_name = "Mt-KaHyPar";
   mutable size_t initial_km1 = std::numeric_limits<size_t>::max();
   size_t utility_id = std::numeric_limits<size_t>::max();
+  // ! Shared by all copies of the context (nullptr = the run cannot be cancelled)
+  std::shared_ptr<utils::CancellationToken> cancellation_token;
+  // ! Called with the block IDs of the input hypergraph each time the partitioner
+  // ! found an improved partition in direct k-way mode (e.g., after each V-cycle)
+  std::function<void(const vec<PartitionID>&)> on_improved_partition;
+  // ! Shared by all copies of the context (nullptr = no progress updates)
+  std::shared_ptr<utils::ProgressReporter> progress_reporter;
+  // ! Shared by all copies of the context (nullptr = no external refiner)
+  std::shared_ptr<utils::ExternalRefinementHook> external_refinement_hook;
+  // ! Shared by all copies of the context (nullptr = no time limit)
+  std::shared_ptr<utils::TimeBudget> time_budget;
+  // ! Thread pool in which library calls with this context are executed
+  // ! (nullptr = global thread pool, see TBBInitializer)
+  std::shared_ptr<ThreadPool> thread_pool;
 
   Context(const bool register_utilities = true) {
     if ( register_utilities ) {
@@ -258,8 +439,48 @@ class Context {
     }
   }
 
+  // ! Returns true, if the run was cancelled or its deadline is reached. In this
+  // ! case, the partitioner finishes as fast as possible with the current partition.
+  bool isCancelled() const {
+    return cancellation_token && cancellation_token->isCancelled();
+  }
+
+  // ! Returns the time budget if this context partitions the input hypergraph in
+  // ! direct k-way mode. Otherwise, the phases of the context are not budgeted.
+  utils::TimeBudget* mainTimeBudget() const {
+    return type == ContextType::main && partition.mode == Mode::direct ? time_budget.get() : nullptr;
+  }
+
+  // ! Starts the given phase of the time budget of the main context
+  void startBudgetPhase(const utils::BudgetPhase phase) const {
+    if ( utils::TimeBudget* budget = mainTimeBudget() ) {
+      budget->startPhase(phase);
+    }
+  }
+
+  // ! Returns true, if progress updates of this context are reported
+  bool reportsProgress() const {
+    return progress_reporter && type == ContextType::main;
+  }
+
+  // ! Returns true, if the external refiner is called on each level of this context
+  bool usesExternalRefiner() const {
+    return external_refinement_hook && type == ContextType::main;
+  }
+
+  // ! Reports a progress update of the main context. If the callback
+  // ! requests to stop, the run is cancelled.
+  void reportProgress(const utils::ProgressUpdate& update) const;
+
   bool forceGainCacheUpdates() const;
 
+  // ! Returns true, if a hypergraph with the given number of pins is small enough
+  // ! to be partitioned sequentially (task creation and the memory pool setup
+  // ! would dominate the running time of a parallel run)
+  bool isSmallInstance(const size_t num_pins) const {
+    return num_pins < partition.small_instance_num_pins_threshold;
+  }
+
   void setupPartWeights(const HypernodeWeight total_hypergraph_weight);
 
   void setupContractionLimit(const HypernodeWeight total_hypergraph_weight);
@@ -274,6 +495,10 @@ class Context {
 
   void load_default_flow_preset();
 
+  void load_quality_preset();
+
+  void load_quality_flow_preset();
+
   void load_deterministic_preset();
 };
 
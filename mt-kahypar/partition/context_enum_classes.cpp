@@ -46,6 +46,8 @@ namespace mt_kahypar {
     switch (format) {
       case FileFormat::hMetis: return os << "hMetis";
       case FileFormat::Metis: return os << "Metis";
+      case FileFormat::Snapshot: return os << "Snapshot";
+      case FileFormat::SharedSnapshot: return os << "SharedSnapshot";
         // omit default case to trigger compiler warning for missing cases
     }
     return os << static_cast<uint8_t>(format);
@@ -68,6 +70,7 @@ namespace mt_kahypar {
       case PresetType::default_flows: return os << "default_flows";
       case PresetType::quality_preset: return os << "quality";
       case PresetType::quality_flows: return os << "quality_flows";
+      case PresetType::auto_preset: return os << "auto";
       case PresetType::UNDEFINED: return os << "UNDEFINED";
         // omit default case to trigger compiler warning for missing cases
     }
@@ -97,6 +100,8 @@ namespace mt_kahypar {
       case Mode::recursive_bipartitioning: return os << "recursive_bipartitioning";
       case Mode::direct: return os << "direct_kway";
       case Mode::deep_multilevel: return os << "deep_multilevel";
+      case Mode::streaming: return os << "streaming";
+      case Mode::multisection: return os << "multisection";
       case Mode::UNDEFINED: return os << "UNDEFINED";
         // omit default case to trigger compiler warning for missing cases
     }
@@ -139,6 +144,7 @@ namespace mt_kahypar {
   std::ostream & operator<< (std::ostream& os, const CoarseningAlgorithm& algo) {
     switch (algo) {
       case CoarseningAlgorithm::multilevel_coarsener: return os << "multilevel_coarsener";
+      case CoarseningAlgorithm::two_hop_multilevel_coarsener: return os << "two_hop_multilevel_coarsener";
       case CoarseningAlgorithm::deterministic_multilevel_coarsener: return os << "deterministic_multilevel_coarsener";
       case CoarseningAlgorithm::nlevel_coarsener: return os << "nlevel_coarsener";
       case CoarseningAlgorithm::UNDEFINED: return os << "UNDEFINED";
@@ -209,8 +215,12 @@ namespace mt_kahypar {
     switch (algo) {
       case FMAlgorithm::fm_gain_cache: return os << "fm_gain_cache";
       case FMAlgorithm::fm_gain_cache_on_demand : return os << "fm_gain_cache_on_demand";
+      case FMAlgorithm::fm_gain_cache_lazy : return os << "fm_gain_cache_lazy";
       case FMAlgorithm::fm_gain_delta: return os << "fm_gain_delta";
       case FMAlgorithm::fm_recompute_gain: return os << "fm_recompute_gain";
+      case FMAlgorithm::jet: return os << "jet";
+      case FMAlgorithm::pairwise_fm: return os << "pairwise_fm";
+      case FMAlgorithm::deterministic: return os << "deterministic";
       case FMAlgorithm::do_nothing: return os << "fm_do_nothing";
         // omit default case to trigger compiler warning for missing cases
     }
@@ -220,6 +230,7 @@ namespace mt_kahypar {
   std::ostream & operator<< (std::ostream& os, const FlowAlgorithm& algo) {
     switch (algo) {
       case FlowAlgorithm::flow_cutter: return os << "flow_cutter";
+      case FlowAlgorithm::graph_flow_cutter: return os << "graph_flow_cutter";
       case FlowAlgorithm::mock: return os << "mock";
       case FlowAlgorithm::do_nothing: return os << "do_nothing";
         // omit default case to trigger compiler warning for missing cases
@@ -227,6 +238,27 @@ namespace mt_kahypar {
     return os << static_cast<uint8_t>(algo);
   }
 
+  std::ostream & operator<< (std::ostream& os, const NumaPlacementPolicy& policy) {
+    switch (policy) {
+      case NumaPlacementPolicy::interleaved: return os << "interleaved";
+      case NumaPlacementPolicy::node_id_ranges: return os << "node_id_ranges";
+        // omit default case to trigger compiler warning for missing cases
+    }
+    return os << static_cast<uint8_t>(policy);
+  }
+
+  std::ostream & operator<< (std::ostream& os, const ThreadPlacementPolicy& policy) {
+    switch (policy) {
+      case ThreadPlacementPolicy::physical_cores_first: return os << "physical_cores_first";
+      case ThreadPlacementPolicy::compact: return os << "compact";
+      case ThreadPlacementPolicy::scatter: return os << "scatter";
+      case ThreadPlacementPolicy::physical_cores_only: return os << "physical_cores_only";
+      case ThreadPlacementPolicy::smt_for_memory_bound_phases: return os << "smt_for_memory_bound_phases";
+        // omit default case to trigger compiler warning for missing cases
+    }
+    return os << static_cast<uint8_t>(policy);
+  }
+
   Mode modeFromString(const std::string& mode) {
     if (mode == "rb") {
       return Mode::recursive_bipartitioning;
@@ -234,6 +266,10 @@ namespace mt_kahypar {
       return Mode::direct;
     } else if (mode == "deep") {
       return Mode::deep_multilevel;
+    } else if (mode == "streaming") {
+      return Mode::streaming;
+    } else if (mode == "multisection") {
+      return Mode::multisection;
     }
     ERR("Illegal option: " + mode);
     return Mode::UNDEFINED;
@@ -260,6 +296,8 @@ namespace mt_kahypar {
       return PresetType::quality_preset;
     } else if (type == "quality_flows") {
       return PresetType::quality_flows;
+    } else if (type == "auto") {
+      return PresetType::auto_preset;
     }
     ERR("Illegal option: " + type);
     return PresetType::UNDEFINED;
@@ -294,6 +332,8 @@ namespace mt_kahypar {
   CoarseningAlgorithm coarseningAlgorithmFromString(const std::string& type) {
     if (type == "multilevel_coarsener") {
       return CoarseningAlgorithm::multilevel_coarsener;
+    } else if (type == "two_hop_multilevel_coarsener") {
+      return CoarseningAlgorithm::two_hop_multilevel_coarsener;
     } else if (type == "nlevel_coarsener") {
       return CoarseningAlgorithm::nlevel_coarsener;
     } else if (type == "deterministic_multilevel_coarsener") {
@@ -378,10 +418,18 @@ namespace mt_kahypar {
       return FMAlgorithm::fm_gain_cache;
     } else if (type == "fm_gain_cache_on_demand") {
       return FMAlgorithm::fm_gain_cache_on_demand;
+    } else if (type == "fm_gain_cache_lazy") {
+      return FMAlgorithm::fm_gain_cache_lazy;
     } else if (type == "fm_gain_delta") {
       return FMAlgorithm::fm_gain_delta;
     } else if (type == "fm_recompute_gain") {
       return FMAlgorithm::fm_recompute_gain;
+    } else if (type == "jet") {
+      return FMAlgorithm::jet;
+    } else if (type == "pairwise_fm") {
+      return FMAlgorithm::pairwise_fm;
+    } else if (type == "deterministic") {
+      return FMAlgorithm::deterministic;
     } else if (type == "do_nothing") {
       return FMAlgorithm::do_nothing;
     }
@@ -392,10 +440,38 @@ namespace mt_kahypar {
   FlowAlgorithm flowAlgorithmFromString(const std::string& type) {
     if (type == "flow_cutter") {
       return FlowAlgorithm::flow_cutter;
+    } else if (type == "graph_flow_cutter") {
+      return FlowAlgorithm::graph_flow_cutter;
     } else if (type == "do_nothing") {
       return FlowAlgorithm::do_nothing;
     }
     ERR("Illegal option: " + type);
     return FlowAlgorithm::do_nothing;
   }
+
+  NumaPlacementPolicy numaPlacementPolicyFromString(const std::string& policy) {
+    if (policy == "interleaved") {
+      return NumaPlacementPolicy::interleaved;
+    } else if (policy == "node_id_ranges") {
+      return NumaPlacementPolicy::node_id_ranges;
+    }
+    ERR("Illegal option: " + policy);
+    return NumaPlacementPolicy::interleaved;
+  }
+
+  ThreadPlacementPolicy threadPlacementPolicyFromString(const std::string& policy) {
+    if (policy == "physical_cores_first") {
+      return ThreadPlacementPolicy::physical_cores_first;
+    } else if (policy == "compact") {
+      return ThreadPlacementPolicy::compact;
+    } else if (policy == "scatter") {
+      return ThreadPlacementPolicy::scatter;
+    } else if (policy == "physical_cores_only") {
+      return ThreadPlacementPolicy::physical_cores_only;
+    } else if (policy == "smt_for_memory_bound_phases") {
+      return ThreadPlacementPolicy::smt_for_memory_bound_phases;
+    }
+    ERR("Illegal option: " + policy);
+    return ThreadPlacementPolicy::physical_cores_first;
+  }
 }
\ No newline at end of file
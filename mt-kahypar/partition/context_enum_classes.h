@@ -42,6 +42,8 @@ enum class Type : int8_t {
 enum class FileFormat : int8_t {
   hMetis = 0,
   Metis = 1,
+  Snapshot = 2,
+  SharedSnapshot = 3
 };
 
 enum class InstanceType : int8_t {
@@ -56,6 +58,7 @@ enum class PresetType : int8_t {
   default_flows,
   quality_preset,
   quality_flows,
+  auto_preset,
   UNDEFINED
 };
 
@@ -73,6 +76,8 @@ enum class Mode : uint8_t {
   recursive_bipartitioning,
   direct,
   deep_multilevel,
+  streaming,
+  multisection,
   UNDEFINED
 };
 
@@ -99,6 +104,7 @@ enum class SimiliarNetCombinerStrategy : uint8_t {
 
 enum class CoarseningAlgorithm : uint8_t {
   multilevel_coarsener,
+  two_hop_multilevel_coarsener,
   deterministic_multilevel_coarsener,
   nlevel_coarsener,
   UNDEFINED
@@ -146,17 +152,35 @@ enum class LabelPropagationAlgorithm : uint8_t {
 enum class FMAlgorithm : uint8_t {
   fm_gain_cache,
   fm_gain_cache_on_demand,
+  fm_gain_cache_lazy,
   fm_gain_delta,
   fm_recompute_gain,
+  jet,
+  pairwise_fm,
+  deterministic,
   do_nothing
 };
 
 enum class FlowAlgorithm : uint8_t {
   flow_cutter,
+  graph_flow_cutter,
   mock,
   do_nothing
 };
 
+enum class NumaPlacementPolicy : uint8_t {
+  interleaved,
+  node_id_ranges
+};
+
+enum class ThreadPlacementPolicy : uint8_t {
+  physical_cores_first,
+  compact,
+  scatter,
+  physical_cores_only,
+  smt_for_memory_bound_phases
+};
+
 std::ostream & operator<< (std::ostream& os, const Type& type);
 
 std::ostream & operator<< (std::ostream& os, const FileFormat& type);
@@ -193,6 +217,10 @@ std::ostream & operator<< (std::ostream& os, const FMAlgorithm& algo);
 
 std::ostream & operator<< (std::ostream& os, const FlowAlgorithm& algo);
 
+std::ostream & operator<< (std::ostream& os, const NumaPlacementPolicy& policy);
+
+std::ostream & operator<< (std::ostream& os, const ThreadPlacementPolicy& policy);
+
 Mode modeFromString(const std::string& mode);
 
 InstanceType instanceTypeFromString(const std::string& type);
@@ -219,4 +247,8 @@ FMAlgorithm fmAlgorithmFromString(const std::string& type);
 
 FlowAlgorithm flowAlgorithmFromString(const std::string& type);
 
+NumaPlacementPolicy numaPlacementPolicyFromString(const std::string& policy);
+
+ThreadPlacementPolicy threadPlacementPolicyFromString(const std::string& policy);
+
 }  // namesapce mt_kahypar
@@ -28,6 +28,7 @@
 #include "mt-kahypar/partition/deep_multilevel.h"
 
 #include <algorithm>
+#include <atomic>
 #include <limits>
 #include <vector>
 
@@ -454,7 +455,7 @@ void bipartition_each_block(PartitionedHypergraph& partitioned_hg,
   vec<DeepPartitioningResult> bipartitions(current_k);
   vec<PartitionID> block_ranges(1, 0);
   vec<HypernodeID> mapping(partitioned_hg.initialNumNodes(), kInvalidHypernode);
-  tbb::task_group tg;
+  vec<PartitionID> blocks_to_bipartition;
   for ( PartitionID block = 0; block < current_k; ++block ) {
     // The recursive bipartitioning tree stores for each block of the current partition
     // the number of blocks in which we have to further bipartition the corresponding block
@@ -462,13 +463,7 @@ void bipartition_each_block(PartitionedHypergraph& partitioned_hg,
     // that the final k-way partition is balanced.
     const PartitionID desired_blocks = rb_tree.desiredNumberOfBlocks(current_k, block);
     if ( desired_blocks > 1 ) {
-      // Spawn a task that bipartitions the corresponding block
-      tg.run([&, block, desired_blocks] {
-        const auto target_blocks = rb_tree.targetBlocksInFinalPartition(current_k, block);
-        bipartitions[block] = bipartition_block(partitioned_hg, context,
-          info, block, mapping, target_blocks.first, target_blocks.second);
-        bipartitions[block].partitioned_hg.setHypergraph(bipartitions[block].hypergraph);
-      });
+      blocks_to_bipartition.push_back(block);
       block_ranges.push_back(block_ranges.back() + 2);
     } else {
       // No further bipartitions required for the corresponding block
@@ -476,6 +471,32 @@ void bipartition_each_block(PartitionedHypergraph& partitioned_hg,
       block_ranges.push_back(block_ranges.back() + 1);
     }
   }
+
+  // The blocks can have very different weights. If we spawn one task per block, the
+  // heaviest block might start last and all other threads wait for it at the end.
+  // Therefore, each task repeatedly takes the heaviest remaining block. Heavy blocks
+  // start first and threads that run out of blocks steal the parallel work (e.g.,
+  // initial partitioning runs) of the blocks that are still being bipartitioned.
+  std::sort(blocks_to_bipartition.begin(), blocks_to_bipartition.end(),
+    [&](const PartitionID lhs, const PartitionID rhs) {
+      return partitioned_hg.partWeight(lhs) > partitioned_hg.partWeight(rhs) ||
+        ( partitioned_hg.partWeight(lhs) == partitioned_hg.partWeight(rhs) && lhs < rhs );
+    });
+  std::atomic<size_t> next_block(0);
+  const size_t num_tasks = std::min(blocks_to_bipartition.size(),
+    std::max(context.shared_memory.num_threads, UL(1)));
+  tbb::task_group tg;
+  for ( size_t i = 0; i < num_tasks; ++i ) {
+    tg.run([&] {
+      for ( size_t idx = next_block++; idx < blocks_to_bipartition.size(); idx = next_block++ ) {
+        const PartitionID block = blocks_to_bipartition[idx];
+        const auto target_blocks = rb_tree.targetBlocksInFinalPartition(current_k, block);
+        bipartitions[block] = bipartition_block(partitioned_hg, context,
+          info, block, mapping, target_blocks.first, target_blocks.second);
+        bipartitions[block].partitioned_hg.setHypergraph(bipartitions[block].hypergraph);
+      }
+    });
+  }
   tg.wait();
 
   // Apply all bipartitions to current hypergraph
@@ -784,8 +805,9 @@ DeepPartitioningResult deep_multilevel_recursion(const Hypergraph& hypergraph,
   r_context.partition.k = rb_tree.get_maximum_number_of_blocks(hypergraph.initialNumNodes());
   r_context.partition.perfect_balance_part_weights = rb_tree.perfectlyBalancedWeightVector(r_context.partition.k);
   r_context.partition.max_part_weights = rb_tree.maxPartWeightVector(r_context.partition.k);
-  // Copy hypergraph
-  result.hypergraph = hypergraph.copy(parallel_tag_t());
+  // All parallel recursions share the structure of the hypergraph, since they
+  // only read it. Each recursion has its own partition and coarser hypergraphs.
+  result.hypergraph = hypergraph.sharedCopy();
   result.partitioned_hg = PartitionedHypergraph(
     r_context.partition.k, result.hypergraph, parallel_tag_t());
   result.valid = true;
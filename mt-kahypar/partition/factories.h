@@ -51,6 +51,9 @@ using MultilevelCoarsenerDispatcher = kahypar::meta::StaticMultiDispatchFactory<
                                                                                                         HeavyNodePenaltyPolicies,
                                                                                                         AcceptancePolicies> >;
 
+// ! Same coarsener, but clusters unmatched vertices with a common neighbor after each pass
+using TwoHopMultilevelCoarsenerDispatcher = MultilevelCoarsenerDispatcher;
+
 using NLevelCoarsenerDispatcher = kahypar::meta::StaticMultiDispatchFactory<NLevelCoarsener,
                                                                             ICoarsener,
                                                                             kahypar::meta::Typelist<RatingScorePolicies,
@@ -26,6 +26,8 @@
 
 #include "mt-kahypar/partition/initial_partitioning/bfs_initial_partitioner.h"
 
+#include <type_traits>
+
 #include "mt-kahypar/partition/initial_partitioning/policies/pseudo_peripheral_start_nodes.h"
 #include "mt-kahypar/utils/randomize.h"
 
@@ -35,6 +37,7 @@ void BFSInitialPartitioner::partitionImpl() {
   if ( _ip_data.should_initial_partitioner_run(InitialPartitioningAlgorithm::bfs) ) {
     HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
     PartitionedHypergraph& hypergraph = _ip_data.local_partitioned_hypergraph();
+    const CompactHypergraph& compact_hg = _ip_data.compact_hypergraph();
     kahypar::ds::FastResetFlagArray<>& hypernodes_in_queue =
             _ip_data.local_hypernode_fast_reset_flag_array();
     kahypar::ds::FastResetFlagArray<>& hyperedges_in_queue =
@@ -94,8 +97,13 @@ void BFSInitialPartitioner::partitionImpl() {
           ASSERT(hypergraph.partID(hn) == kInvalidPartition, V(block) << V(hypergraph.partID(hn)));
           hypergraph.setNodePart(hn, block);
           ++num_assigned_hypernodes;
-          pushIncidentHypernodesIntoQueue(hypergraph, _context, queues[block],
-                                          hypernodes_in_queue, hyperedges_in_queue, hn, block);
+          if ( compact_hg.isInitialized() ) {
+            pushIncidentHypernodesIntoQueue(hypergraph, compact_hg, _context, queues[block],
+                                            hypernodes_in_queue, hyperedges_in_queue, hn, block);
+          } else {
+            pushIncidentHypernodesIntoQueue(hypergraph, hypergraph, _context, queues[block],
+                                            hypernodes_in_queue, hyperedges_in_queue, hn, block);
+          }
         } else {
           ASSERT(queues[block].empty());
         }
@@ -110,7 +118,9 @@ void BFSInitialPartitioner::partitionImpl() {
 
 // ! Pushes all adjacent hypernodes (not visited before) of hypernode hn
 // ! into the BFS queue of the corresponding block.
+template<typename IncidenceStructure>
 inline void BFSInitialPartitioner::pushIncidentHypernodesIntoQueue(const PartitionedHypergraph& hypergraph,
+                                                                   const IncidenceStructure& incidence_structure,
                                                                    const Context& context,
                                                                    Queue& queue,
                                                                    kahypar::ds::FastResetFlagArray<>& hypernodes_in_queue,
@@ -118,10 +128,12 @@ inline void BFSInitialPartitioner::pushIncidentHypernodesIntoQueue(const Partiti
                                                                    const HypernodeID hn,
                                                                    const PartitionID block) {
   ASSERT(hn != kInvalidHypernode && block != kInvalidPartition);
-  for ( const HyperedgeID& he : hypergraph.incidentEdges(hn) ) {
+  for ( const HyperedgeID he : incidence_structure.incidentEdges(hn) ) {
     if ( !hyperedges_in_queue[block * hypergraph.initialNumEdges() + he] ) {
-      if ( hypergraph.edgeSize(he) <= context.partition.ignore_hyperedge_size_threshold ) {
-        for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+      // Note that the compact hypergraph does not store the pins of large hyperedges
+      if ( std::is_same<IncidenceStructure, CompactHypergraph>::value ||
+           hypergraph.edgeSize(he) <= context.partition.ignore_hyperedge_size_threshold ) {
+        for ( const HypernodeID pin : incidence_structure.pins(he) ) {
           if ( !hypernodes_in_queue[block * hypergraph.initialNumNodes() + pin] &&
                 hypergraph.partID(pin) == kInvalidPartition ) {
             queue.push(pin);
@@ -60,8 +60,11 @@ class BFSInitialPartitioner : public IInitialPartitioner {
   }
 
   // ! Pushes all adjacent hypernodes (not visited before) of hypernode hn
-  // ! into the BFS queue of the corresponding block.
+  // ! into the BFS queue of the corresponding block. The incidence structure
+  // ! is either the hypergraph itself or its flat copy (see CompactHypergraph).
+  template<typename IncidenceStructure>
   inline void pushIncidentHypernodesIntoQueue(const PartitionedHypergraph& hypergraph,
+                                              const IncidenceStructure& incidence_structure,
                                               const Context& context,
                                               Queue& queue,
                                               kahypar::ds::FastResetFlagArray<>& hypernodes_in_queue,
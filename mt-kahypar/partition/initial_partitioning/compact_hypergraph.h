@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+#include "mt-kahypar/utils/range.h"
+
+namespace mt_kahypar {
+
+/*!
+ * Flat copy of the incidence structure of the hypergraph passed to initial
+ * partitioning. The hypergraphs on which we compute initial partitions are
+ * usually small, but they are traversed hundreds of times by the BFS-based
+ * initial partitioners. This class stores the incident nets of each vertex and
+ * the pins of each net in two plain arrays with 16-bit IDs. Thus, a BFS touches
+ * considerably less memory than on the original hypergraph data structure and
+ * does not have to look up the hypernode and hyperedge objects. Pins of nets
+ * larger than the ignore threshold are omitted, since the BFS skips them anyway.
+ *
+ * The structure can only be constructed for hypergraphs with at most
+ * MAX_NUM_ELEMENTS vertices and nets (see fits(...)).
+ */
+class CompactHypergraph {
+
+ public:
+  using ID = uint16_t;
+  using Range = IteratorRange<const ID*>;
+
+  static constexpr size_t MAX_NUM_ELEMENTS = std::numeric_limits<ID>::max();
+
+  CompactHypergraph() :
+    _is_initialized(false),
+    _incident_nets_offsets(),
+    _incident_nets(),
+    _pin_offsets(),
+    _pins() { }
+
+  CompactHypergraph(const CompactHypergraph&) = delete;
+  CompactHypergraph & operator= (const CompactHypergraph &) = delete;
+
+  CompactHypergraph(CompactHypergraph&&) = default;
+  CompactHypergraph & operator= (CompactHypergraph &&) = default;
+
+  template<typename Hypergraph>
+  static bool fits(const Hypergraph& hypergraph) {
+    return hypergraph.initialNumNodes() <= MAX_NUM_ELEMENTS &&
+           hypergraph.initialNumEdges() <= MAX_NUM_ELEMENTS;
+  }
+
+  // ! Constructs the flat incidence structure of the hypergraph (only
+  // ! enabled vertices and nets). Pins of nets with more than
+  // ! ignore_hyperedge_size_threshold pins are not stored.
+  template<typename Hypergraph>
+  void construct(const Hypergraph& hypergraph,
+                 const HypernodeID ignore_hyperedge_size_threshold) {
+    ASSERT(fits(hypergraph));
+    _incident_nets_offsets.assign(hypergraph.initialNumNodes() + 1, 0);
+    _incident_nets.clear();
+    for ( HypernodeID hn = 0; hn < hypergraph.initialNumNodes(); ++hn ) {
+      if ( hypergraph.nodeIsEnabled(hn) ) {
+        for ( const HyperedgeID& he : hypergraph.incidentEdges(hn) ) {
+          if ( hypergraph.edgeIsEnabled(he) ) {
+            _incident_nets.push_back(static_cast<ID>(he));
+          }
+        }
+      }
+      _incident_nets_offsets[hn + 1] = _incident_nets.size();
+    }
+
+    _pin_offsets.assign(hypergraph.initialNumEdges() + 1, 0);
+    _pins.clear();
+    for ( HyperedgeID he = 0; he < hypergraph.initialNumEdges(); ++he ) {
+      if ( hypergraph.edgeIsEnabled(he) &&
+           hypergraph.edgeSize(he) <= ignore_hyperedge_size_threshold ) {
+        for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+          _pins.push_back(static_cast<ID>(pin));
+        }
+      }
+      _pin_offsets[he + 1] = _pins.size();
+    }
+    _is_initialized = true;
+  }
+
+  bool isInitialized() const {
+    return _is_initialized;
+  }
+
+  // ! Returns a range over the incident nets of vertex hn
+  Range incidentEdges(const HypernodeID hn) const {
+    ASSERT(_is_initialized && hn + 1 < _incident_nets_offsets.size());
+    return Range(_incident_nets.data() + _incident_nets_offsets[hn],
+                 _incident_nets.data() + _incident_nets_offsets[hn + 1]);
+  }
+
+  // ! Returns a range over the pins of net he (empty, if the
+  // ! net is larger than the ignore threshold)
+  Range pins(const HyperedgeID he) const {
+    ASSERT(_is_initialized && he + 1 < _pin_offsets.size());
+    return Range(_pins.data() + _pin_offsets[he],
+                 _pins.data() + _pin_offsets[he + 1]);
+  }
+
+ private:
+  bool _is_initialized;
+  parallel::scalable_vector<uint32_t> _incident_nets_offsets;
+  parallel::scalable_vector<ID> _incident_nets;
+  parallel::scalable_vector<uint32_t> _pin_offsets;
+  parallel::scalable_vector<ID> _pins;
+};
+
+} // namespace mt_kahypar
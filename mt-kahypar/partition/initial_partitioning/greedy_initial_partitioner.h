@@ -78,6 +78,20 @@ class GreedyInitialPartitioner : public IInitialPartitioner {
         }
       }
 
+      // Heavy vertices are fixed to the blocks of a bin packing of their weights.
+      // They are never inserted into the PQs and the remaining vertices are grown
+      // around them, which prevents infeasible partitions on inputs with a few
+      // vertices close to the maximum block weight.
+      for ( const auto& heavy_vertex : _ip_data.heavy_vertex_assignment().nodes ) {
+        const HypernodeID hn = heavy_vertex.first;
+        const PartitionID block = heavy_vertex.second;
+        if ( _default_block == kInvalidPartition ) {
+          hg.setNodePart(hn, block);
+        } else if ( block != _default_block ) {
+          hg.changeNodePart(hn, _default_block, block);
+        }
+      }
+
       // Insert start vertices into its corresponding PQs
       _ip_data.reset_unassigned_hypernodes(_rng);
       parallel::scalable_vector<HypernodeID> start_nodes =
@@ -86,7 +100,11 @@ class GreedyInitialPartitioner : public IInitialPartitioner {
       kway_pq.clear();
       for ( PartitionID block = 0; block < _context.partition.k; ++block ) {
         if ( block != _default_block ) {
-          insertVertexIntoPQ(hg, kway_pq, start_nodes[block], block);
+          if ( _ip_data.is_heavy_vertex(start_nodes[block]) ) {
+            insertUnassignedVertexIntoPQ(hg, kway_pq, block);
+          } else {
+            insertVertexIntoPQ(hg, kway_pq, start_nodes[block], block);
+          }
         }
       }
 
@@ -184,7 +202,8 @@ class GreedyInitialPartitioner : public IInitialPartitioner {
                                     KWayPriorityQueue& pq,
                                     const PartitionID to) {
     ASSERT(to != _default_block);
-    const HypernodeID unassigned_hn = _ip_data.get_unassigned_hypernode(_default_block);
+    const HypernodeID unassigned_hn = _ip_data.get_unassigned_hypernode(
+      _default_block, true /* skip heavy vertices */);
     if ( unassigned_hn != kInvalidHypernode ) {
       insertVertexIntoPQ(hypergraph, pq, unassigned_hn, to);
     }
@@ -219,7 +238,8 @@ class GreedyInitialPartitioner : public IInitialPartitioner {
     for ( const HyperedgeID& he : hypergraph.incidentEdges(hn)) {
       if ( !hyperedges_in_queue[to * hypergraph.initialNumEdges() + he] ) {
         for ( const HypernodeID& pin : hypergraph.pins(he) ) {
-          if ( hypergraph.partID(pin) == _default_block && !pq.contains(pin, to) ) {
+          if ( hypergraph.partID(pin) == _default_block &&
+               !_ip_data.is_heavy_vertex(pin) && !pq.contains(pin, to) ) {
             insertVertexIntoPQ(hypergraph, pq, pin, to);
           }
         }
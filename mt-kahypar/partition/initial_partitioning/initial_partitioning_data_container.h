@@ -26,12 +26,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <sstream>
 #include <mutex>
 
 #include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_sort.h"
+#include "tbb/task_arena.h"
 
 #include "mt-kahypar/partition/initial_partitioning/initial_partitioning_commons.h"
+#include "mt-kahypar/partition/initial_partitioning/compact_hypergraph.h"
 
 #include "mt-kahypar/definitions.h"
 #include "mt-kahypar/partition/context.h"
@@ -93,6 +97,61 @@ class InitialPartitioningDataContainer {
     size_t _deterministic_tag = std::numeric_limits<size_t>::max();
   };
 
+  // ! Stores a partition of the nodes with the smallest integer type that can
+  // ! represent all block IDs (8 bit for k < 255, 16 bit for k < 65535). The
+  // ! largest value of the type represents an unassigned node.
+  class CompactPartition {
+   public:
+    CompactPartition() :
+      _bytes_per_block(0),
+      _num_nodes(0),
+      _data() { }
+
+    void initialize(const HypernodeID num_nodes, const PartitionID k) {
+      _bytes_per_block = k < std::numeric_limits<uint8_t>::max() ? sizeof(uint8_t) :
+        k < std::numeric_limits<uint16_t>::max() ? sizeof(uint16_t) : sizeof(PartitionID);
+      _num_nodes = num_nodes;
+      _data.assign(_bytes_per_block * num_nodes, std::numeric_limits<uint8_t>::max());
+    }
+
+    size_t size() const {
+      return _num_nodes;
+    }
+
+    PartitionID operator[](const HypernodeID hn) const {
+      ASSERT(hn < _num_nodes);
+      switch ( _bytes_per_block ) {
+        case sizeof(uint8_t): return decode(_data[hn]);
+        case sizeof(uint16_t): return decode(reinterpret_cast<const uint16_t*>(_data.data())[hn]);
+        default: return reinterpret_cast<const PartitionID*>(_data.data())[hn];
+      }
+    }
+
+    void set(const HypernodeID hn, const PartitionID block) {
+      ASSERT(hn < _num_nodes);
+      ASSERT(block != kInvalidPartition);
+      switch ( _bytes_per_block ) {
+        case sizeof(uint8_t): _data[hn] = block; break;
+        case sizeof(uint16_t): reinterpret_cast<uint16_t*>(_data.data())[hn] = block; break;
+        default: reinterpret_cast<PartitionID*>(_data.data())[hn] = block;
+      }
+    }
+
+    void freeInternalData() {
+      parallel::free(_data);
+    }
+
+   private:
+    template<typename T>
+    static PartitionID decode(const T block) {
+      return block == std::numeric_limits<T>::max() ? kInvalidPartition : block;
+    }
+
+    size_t _bytes_per_block;
+    HypernodeID _num_nodes;
+    parallel::scalable_vector<uint8_t> _data;
+  };
+
   // ! Aggregates global stats about the partitions produced by an specific
   // ! initial partitioning algorithm.
   struct InitialPartitioningRunStats {
@@ -177,6 +236,48 @@ class InitialPartitioningDataContainer {
              _stats[algo_idx].average_quality - 2.0 * _stats[algo_idx].stddev() <= _best_quality;
     }
 
+    // ! Racing scheduler: Selects the initial partitioner that should perform the
+    // ! next run and returns the index of that run. First, each initial partitioner
+    // ! starts min_adaptive_ip_runs runs such that we obtain a first estimate of its
+    // ! quality distribution. Afterwards, the remaining runs of all partitioners which
+    // ! are unlikely to produce a new global best partition (see
+    // ! should_initial_partitioner_run(...)) are cancelled and the next run is assigned
+    // ! to the partitioner with the most promising quality (avg_quality - 2 * stddev_quality).
+    // ! Returns InitialPartitioningAlgorithm::UNDEFINED, if no runs are left.
+    std::pair<InitialPartitioningAlgorithm, size_t> next_racing_run(vec<size_t>& remaining_runs,
+                                                                    vec<size_t>& started_runs) {
+      ASSERT(remaining_runs.size() == _stats.size() && started_runs.size() == _stats.size());
+      std::lock_guard<std::mutex> _lock(_stat_mutex);
+      InitialPartitioningAlgorithm best_algorithm = InitialPartitioningAlgorithm::UNDEFINED;
+      std::pair<bool, double> best_key(true, std::numeric_limits<double>::max());
+      for ( size_t algo_idx = 0; algo_idx < _stats.size(); ++algo_idx ) {
+        if ( remaining_runs[algo_idx] == 0 ) continue;
+        const InitialPartitioningAlgorithm algorithm = _stats[algo_idx].algorithm;
+        const bool is_warm_up = started_runs[algo_idx] < _context.initial_partitioning.min_adaptive_ip_runs;
+        if ( !is_warm_up && !should_initial_partitioner_run_ignoring_deterministic(algorithm) ) {
+          // Cancel remaining runs of initial partitioners that are unlikely to win
+          remaining_runs[algo_idx] = 0;
+          continue;
+        }
+        // Warm-up runs have precedence and are distributed evenly
+        const std::pair<bool, double> key = is_warm_up ?
+          std::make_pair(false, static_cast<double>(started_runs[algo_idx])) :
+          std::make_pair(true, _stats[algo_idx].average_quality - 2.0 * _stats[algo_idx].stddev());
+        if ( best_algorithm == InitialPartitioningAlgorithm::UNDEFINED || key < best_key ) {
+          best_algorithm = algorithm;
+          best_key = key;
+        }
+      }
+
+      size_t run = 0;
+      if ( best_algorithm != InitialPartitioningAlgorithm::UNDEFINED ) {
+        const uint8_t algo_idx = static_cast<uint8_t>(best_algorithm);
+        run = started_runs[algo_idx]++;
+        --remaining_runs[algo_idx];
+      }
+      return std::make_pair(best_algorithm, run);
+    }
+
     std::mutex _stat_mutex;
     const Context& _context;
     parallel::scalable_vector<InitialPartitioningRunStats> _stats;
@@ -192,7 +293,7 @@ class InitialPartitioningDataContainer {
       _partitioned_hypergraph(context.partition.k, hypergraph),
       _context(context),
       _global_stats(global_stats),
-      _partition(hypergraph.initialNumNodes(), kInvalidPartition),
+      _partition(),
       _result(InitialPartitioningAlgorithm::UNDEFINED,
               std::numeric_limits<HypernodeWeight>::max(),
               std::numeric_limits<HypernodeWeight>::max(),
@@ -204,6 +305,7 @@ class InitialPartitioningDataContainer {
       for ( uint8_t algo = 0; algo < static_cast<size_t>(InitialPartitioningAlgorithm::UNDEFINED); ++algo ) {
         _stats.emplace_back(static_cast<InitialPartitioningAlgorithm>(algo));
       }
+      _partition.initialize(hypergraph.initialNumNodes(), context.partition.k);
 
       if ( _context.partition.k == 2 && !disable_fm ) {
         // In case of a bisection we instantiate the 2-way FM refiner
@@ -252,7 +354,7 @@ class InitialPartitioningDataContainer {
       return result;
     }
 
-    PartitioningResult performRefinementOnPartition(vec<PartitionID>& partition,
+    PartitioningResult performRefinementOnPartition(const CompactPartition& partition,
                                                     PartitioningResult& input, std::mt19937& prng) {
       Metrics current_metric = {
         input._objective,
@@ -292,16 +394,16 @@ class InitialPartitioningDataContainer {
           const PartitionID part_id = _partitioned_hypergraph.partID(hn);
           ASSERT(hn < _partition.size());
           ASSERT(part_id != kInvalidPartition);
-          _partition[hn] = part_id;
+          _partition.set(hn, part_id);
         }
         _result = refined;
       }
     }
 
-    void copyPartition(vec<PartitionID>& partition_store) const {
+    void copyPartition(CompactPartition& partition_store) const {
       for (HypernodeID node : _partitioned_hypergraph.nodes()) {
         ASSERT(_partitioned_hypergraph.partID(node) != kInvalidPartition);
-        partition_store[node] = _partitioned_hypergraph.partID(node);
+        partition_store.set(node, _partitioned_hypergraph.partID(node));
       }
     }
 
@@ -312,9 +414,13 @@ class InitialPartitioningDataContainer {
           improvement = _twoway_fm->refine(current_metric, prng);
         }
       } else if ( _label_propagation ) {
-        _label_propagation->initialize(_partitioned_hypergraph);
-        _label_propagation->refine(_partitioned_hypergraph, {},
-          current_metric, std::numeric_limits<double>::max());
+        // If the LP refiner runs in parallel, the waiting thread must not start
+        // another initial partitioning run on its thread-local hypergraph
+        tbb::this_task_arena::isolate([&] {
+          _label_propagation->initialize(_partitioned_hypergraph);
+          _label_propagation->refine(_partitioned_hypergraph, {},
+            current_metric, std::numeric_limits<double>::max());
+        });
       }
 
       HEAVY_INITIAL_PARTITIONING_ASSERT(
@@ -333,14 +439,14 @@ class InitialPartitioningDataContainer {
       tbb::parallel_invoke([&] {
         _partitioned_hypergraph.freeInternalData();
       }, [&] {
-        parallel::free(_partition);
+        _partition.freeInternalData();
       });
     }
 
     PartitionedHypergraph _partitioned_hypergraph;
     const Context& _context;
     GlobalInitialPartitioningStats& _global_stats;
-    parallel::scalable_vector<PartitionID> _partition;
+    CompactPartition _partition;
     PartitioningResult _result;
     std::unique_ptr<IRefiner> _label_propagation;
     std::unique_ptr<SequentialTwoWayFmRefiner> _twoway_fm;
@@ -351,12 +457,33 @@ class InitialPartitioningDataContainer {
   using ThreadLocalUnassignedHypernodes = tbb::enumerable_thread_specific<parallel::scalable_vector<HypernodeID>>;
 
  public:
+  // ! Candidates for the start nodes of the BFS-based initial partitioners
+  // ! (see PseudoPeripheralStartNodes), which are computed once per hypergraph
+  struct StartNodeCandidates {
+    std::once_flag is_initialized;
+    parallel::scalable_vector<HypernodeID> nodes;
+    // ! distances[i * nodes.size() + j] is the BFS distance from nodes[i] to nodes[j]
+    // ! (kInvalidHypernode, if nodes[j] is not reachable from nodes[i])
+    parallel::scalable_vector<HypernodeID> distances;
+  };
+
+  // ! Blocks of the heavy vertices, which are computed once per hypergraph with a
+  // ! longest-processing-time-first bin packing (see computeHeavyVertexAssignment)
+  struct HeavyVertexAssignment {
+    HypernodeWeight weight_threshold = std::numeric_limits<HypernodeWeight>::max();
+    // ! Heavy vertices in decreasing order of their weight and their blocks
+    parallel::scalable_vector<std::pair<HypernodeID, PartitionID>> nodes;
+  };
+
   InitialPartitioningDataContainer(PartitionedHypergraph& hypergraph,
                                     const Context& context,
                                     const bool disable_fm = false) :
     _partitioned_hg(hypergraph),
     _context(context),
     _disable_fm(disable_fm),
+    _use_nested_parallelism(!context.partition.deterministic &&
+      context.shared_memory.num_threads > 1 &&
+      hypergraph.initialNumNodes() >= context.initial_partitioning.nested_parallelism_min_nodes),
     _global_stats(context),
     _local_hg([&] {
       return construct_local_partitioned_hypergraph();
@@ -367,15 +494,28 @@ class InitialPartitioningDataContainer {
     _local_he_visited(_context.partition.k * hypergraph.initialNumEdges()),
     _local_unassigned_hypernodes(),
     _local_unassigned_hypernode_pointer(std::numeric_limits<size_t>::max()),
+    _compact_hg(),
+    _heavy_vertex_assignment(),
     _max_pop_size(_context.initial_partitioning.population_size)  {
     // Setup Label Propagation IRefiner Config for Initial Partitioning
     _context.refinement = _context.initial_partitioning.refinement;
-    _context.refinement.label_propagation.execute_sequential = true;
+    _context.refinement.label_propagation.execute_sequential = !_use_nested_parallelism;
+
+    // The BFS-based initial partitioners traverse the hypergraph many times.
+    // If it is small enough, we provide a flat copy of its incidence structure.
+    if ( CompactHypergraph::fits(hypergraph) ) {
+      _compact_hg.construct(hypergraph.hypergraph(),
+        _context.partition.ignore_hyperedge_size_threshold);
+    }
+
+    if ( _context.initial_partitioning.heavy_vertex_weight_fraction > 0.0 ) {
+      computeHeavyVertexAssignment();
+    }
 
     if (_context.partition.deterministic) {
       _best_partitions.resize(_max_pop_size);
       for (size_t i = 0; i < _max_pop_size; ++i) {
-        _best_partitions[i].second.resize(hypergraph.initialNumNodes(), kInvalidPartition);
+        _best_partitions[i].second.initialize(hypergraph.initialNumNodes(), _context.partition.k);
       }
     }
   }
@@ -404,6 +544,14 @@ class InitialPartitioningDataContainer {
     return _local_hg.local()._partitioned_hypergraph;
   }
 
+  // ! If true, the hypergraph is large enough such that the initial partitioners
+  // ! and the LP refiner use nested parallelism. Note that nested parallel regions
+  // ! must be isolated (see tbb::this_task_arena::isolate). Otherwise, a waiting
+  // ! thread could start another run that works on the same thread-local data.
+  bool use_nested_parallelism() const {
+    return _use_nested_parallelism;
+  }
+
   KWayPriorityQueue& local_kway_priority_queue() {
     bool& is_local_pq_initialized = _is_local_pq_initialized.local();
     KWayPriorityQueue& local_kway_pq = _local_kway_pq.local();
@@ -414,6 +562,26 @@ class InitialPartitioningDataContainer {
     return local_kway_pq;
   }
 
+  // ! Flat copy of the incidence structure of the hypergraph (only
+  // ! initialized, if the hypergraph is small enough)
+  const CompactHypergraph& compact_hypergraph() const {
+    return _compact_hg;
+  }
+
+  // ! Shared by all threads, initialized by the first run that requests start nodes
+  StartNodeCandidates& start_node_candidates() {
+    return _start_node_candidates;
+  }
+
+  // ! Heavy vertices and their blocks, which are fixed during greedy growing
+  const HeavyVertexAssignment& heavy_vertex_assignment() const {
+    return _heavy_vertex_assignment;
+  }
+
+  bool is_heavy_vertex(const HypernodeID hn) const {
+    return _partitioned_hg.nodeWeight(hn) > _heavy_vertex_assignment.weight_threshold;
+  }
+
   kahypar::ds::FastResetFlagArray<>& local_hypernode_fast_reset_flag_array() {
     return _local_hn_visited.local();
   }
@@ -440,7 +608,8 @@ class InitialPartitioningDataContainer {
     unassigned_hypernode_pointer = unassigned_hypernodes.size();
   }
 
-  HypernodeID get_unassigned_hypernode(const PartitionID unassigned_block = kInvalidPartition) {
+  HypernodeID get_unassigned_hypernode(const PartitionID unassigned_block = kInvalidPartition,
+                                       const bool skip_heavy_vertices = false) {
     const PartitionedHypergraph& hypergraph = local_partitioned_hypergraph();
     parallel::scalable_vector<HypernodeID>& unassigned_hypernodes =
       _local_unassigned_hypernodes.local();
@@ -451,7 +620,8 @@ class InitialPartitioningDataContainer {
     while ( unassigned_hypernode_pointer > 0 ) {
       const HypernodeID current_hn = unassigned_hypernodes[0];
       // In case the current hypernode is unassigned we return it
-      if ( hypergraph.partID(current_hn) == unassigned_block ) {
+      if ( hypergraph.partID(current_hn) == unassigned_block &&
+           !( skip_heavy_vertices && is_heavy_vertex(current_hn) ) ) {
         return current_hn;
       }
       // In case the hypernode on the first position is already assigned,
@@ -466,6 +636,11 @@ class InitialPartitioningDataContainer {
     return _global_stats.should_initial_partitioner_run(algorithm);
   }
 
+  std::pair<InitialPartitioningAlgorithm, size_t> next_racing_run(vec<size_t>& remaining_runs,
+                                                                  vec<size_t>& started_runs) {
+    return _global_stats.next_racing_run(remaining_runs, started_runs);
+  }
+
   /*!
    * Commits the current partition computed on the local hypergraph. Partition replaces
    * the best local partition, if it has a better quality (or better imbalance).
@@ -542,7 +717,7 @@ class InitialPartitioningDataContainer {
         auto refinement_task = [&](size_t i) {
           auto& my_data = _local_hg.local();
           auto& my_phg = my_data._partitioned_hypergraph;
-          vec<PartitionID>& my_partition = _best_partitions[i].second;
+          CompactPartition& my_partition = _best_partitions[i].second;
           PartitioningResult& my_objectives = _best_partitions[i].first;
           std::mt19937 prng(_context.partition.seed + 420 + my_phg.initialNumPins() + i);
           auto refined = my_data.performRefinementOnPartition(my_partition, my_objectives, prng);
@@ -551,7 +726,7 @@ class InitialPartitioningDataContainer {
 
           if (my_objectives.is_other_better(refined, _context.partition.epsilon)) {
             for (HypernodeID node : my_phg.nodes()) {
-              my_partition[node] = my_phg.partID(node);
+              my_partition.set(node, my_phg.partID(node));
             }
             my_objectives = refined;
           }
@@ -573,10 +748,10 @@ class InitialPartitioningDataContainer {
 
       best_flat_algo = _best_partitions[best_index].first._algorithm;
       best_feasible_objective = _best_partitions[best_index].first._objective;
-      const vec<PartitionID>& best_partition = _best_partitions[best_index].second;
-      assert(std::all_of(best_partition.begin(), best_partition.end(), [&](PartitionID p) { return p != kInvalidPartition; }));
+      const CompactPartition& best_partition = _best_partitions[best_index].second;
 
       _partitioned_hg.doParallelForAllNodes([&](HypernodeID node) {
+        ASSERT(best_partition[node] != kInvalidPartition);
         _partitioned_hg.setOnlyNodePart(node, best_partition[node]);
       });
 
@@ -657,9 +832,61 @@ class InitialPartitioningDataContainer {
       _partitioned_hg.hypergraph(), _context, _global_stats, _disable_fm);
   }
 
+  // ! Vertices heavier than a fraction of the smallest maximum block weight are
+  // ! assigned in decreasing order of their weight to the block with the largest
+  // ! remaining capacity (LPT). If a few vertices are close to the maximum block
+  // ! weight, greedy growing often produces infeasible partitions otherwise.
+  void computeHeavyVertexAssignment() {
+    const PartitionID k = _context.partition.k;
+    const std::vector<HypernodeWeight>& max_part_weights = _context.partition.max_part_weights;
+    ASSERT(max_part_weights.size() == static_cast<size_t>(k));
+    const HypernodeWeight threshold = static_cast<HypernodeWeight>(
+      _context.initial_partitioning.heavy_vertex_weight_fraction *
+      *std::min_element(max_part_weights.cbegin(), max_part_weights.cend()));
+
+    tbb::enumerable_thread_specific<parallel::scalable_vector<HypernodeID>> local_heavy_vertices;
+    _partitioned_hg.doParallelForAllNodes([&](const HypernodeID hn) {
+      if ( _partitioned_hg.nodeWeight(hn) > threshold ) {
+        local_heavy_vertices.local().push_back(hn);
+      }
+    });
+    parallel::scalable_vector<HypernodeID> heavy_vertices;
+    for ( const parallel::scalable_vector<HypernodeID>& local : local_heavy_vertices ) {
+      heavy_vertices.insert(heavy_vertices.end(), local.begin(), local.end());
+    }
+    if ( heavy_vertices.empty() ) {
+      return;
+    }
+    tbb::parallel_sort(heavy_vertices.begin(), heavy_vertices.end(),
+      [&](const HypernodeID lhs, const HypernodeID rhs) {
+        const HypernodeWeight lhs_weight = _partitioned_hg.nodeWeight(lhs);
+        const HypernodeWeight rhs_weight = _partitioned_hg.nodeWeight(rhs);
+        return lhs_weight > rhs_weight || (lhs_weight == rhs_weight && lhs < rhs);
+      });
+
+    // The number of heavy vertices is bounded by k / fraction (up to the imbalance),
+    // which is why we scan all blocks for each of them
+    parallel::scalable_vector<HypernodeWeight> part_weights(k, 0);
+    _heavy_vertex_assignment.weight_threshold = threshold;
+    for ( const HypernodeID& hn : heavy_vertices ) {
+      PartitionID best_block = 0;
+      for ( PartitionID block = 1; block < k; ++block ) {
+        if ( max_part_weights[block] - part_weights[block] >
+             max_part_weights[best_block] - part_weights[best_block] ) {
+          best_block = block;
+        }
+      }
+      part_weights[best_block] += _partitioned_hg.nodeWeight(hn);
+      _heavy_vertex_assignment.nodes.emplace_back(hn, best_block);
+    }
+    DBG << "Fixed" << heavy_vertices.size() << "heavy vertices with a weight larger than"
+        << threshold << "during greedy growing";
+  }
+
   PartitionedHypergraph& _partitioned_hg;
   Context _context;
   const bool _disable_fm;
+  const bool _use_nested_parallelism;
 
   GlobalInitialPartitioningStats _global_stats;
 
@@ -671,10 +898,13 @@ class InitialPartitioningDataContainer {
   ThreadLocalFastResetFlagArray _local_he_visited;
   ThreadLocalUnassignedHypernodes _local_unassigned_hypernodes;
   tbb::enumerable_thread_specific<size_t> _local_unassigned_hypernode_pointer;
+  CompactHypergraph _compact_hg;
+  StartNodeCandidates _start_node_candidates;
+  HeavyVertexAssignment _heavy_vertex_assignment;
 
   size_t _max_pop_size;
   SpinLock _pop_lock;
-  vec< std::pair<PartitioningResult, vec<PartitionID>>  > _best_partitions;
+  vec< std::pair<PartitioningResult, CompactPartition>  > _best_partitions;
 };
 
 } // namespace mt_kahypar
@@ -26,6 +26,10 @@
 
 #include "mt-kahypar/partition/initial_partitioning/label_propagation_initial_partitioner.h"
 
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
 #include "mt-kahypar/partition/initial_partitioning/policies/pseudo_peripheral_start_nodes.h"
 #include "mt-kahypar/partition/initial_partitioning/policies/gain_computation_policy.h"
 #include "mt-kahypar/utils/randomize.h"
@@ -61,13 +65,17 @@ void LabelPropagationInitialPartitioner::partitionImpl() {
 
     bool converged = false;
     for ( size_t i = 0; i < _context.initial_partitioning.lp_maximum_iterations && !converged; ++i ) {
-      converged = true;
+      if ( _ip_data.use_nested_parallelism() ) {
+        converged = parallelLabelPropagationRound(hg);
+        continue;
+      }
 
+      converged = true;
       for ( const HypernodeID& hn : hg.nodes() ) {
 
         if (hg.nodeDegree(hn) > 0) {
           // Assign vertex to the block where FM gain is maximized
-          MaxGainMove max_gain_move = computeMaxGainMove(hg, hn);
+          MaxGainMove max_gain_move = computeMaxGainMove(hg, hn, _gain_data);
 
           const PartitionID to = max_gain_move.block;
           if ( to != kInvalidPartition ) {
@@ -141,12 +149,60 @@ void LabelPropagationInitialPartitioner::partitionImpl() {
   }
 }
 
-MaxGainMove LabelPropagationInitialPartitioner::computeMaxGainMoveForUnassignedVertex(PartitionedHypergraph& hypergraph,
-                                                                                      const HypernodeID hn) {
+bool LabelPropagationInitialPartitioner::parallelLabelPropagationRound(PartitionedHypergraph& hypergraph) {
+  tbb::enumerable_thread_specific<GainComputationData> local_gain_data(_context.partition.k);
+  vec<PartitionID> target_blocks(BATCH_SIZE, kInvalidPartition);
+  bool converged = true;
+  const HypernodeID num_nodes = hypergraph.initialNumNodes();
+  for ( HypernodeID batch_begin = 0; batch_begin < num_nodes; batch_begin += BATCH_SIZE ) {
+    const HypernodeID batch_end = std::min(batch_begin + BATCH_SIZE, num_nodes);
+    // The target blocks are computed on the partition at the beginning of the batch.
+    // The calling thread must not start another initial partitioning run while
+    // it waits, since it would work on the same thread-local hypergraph.
+    tbb::this_task_arena::isolate([&] {
+      tbb::parallel_for(batch_begin, batch_end, [&](const HypernodeID hn) {
+        PartitionID& to = target_blocks[hn - batch_begin];
+        to = kInvalidPartition;
+        if ( hypergraph.nodeIsEnabled(hn) && hypergraph.nodeDegree(hn) > 0 ) {
+          to = computeMaxGainMove(hypergraph, hn, local_gain_data.local()).block;
+        }
+      });
+    });
+
+    // Apply moves sequentially. Since the gains may be outdated due to
+    // moves of other nodes of the batch, we only check the balance constraint.
+    for ( HypernodeID hn = batch_begin; hn < batch_end; ++hn ) {
+      if ( !hypergraph.nodeIsEnabled(hn) ) {
+        continue;
+      }
+      const PartitionID from = hypergraph.partID(hn);
+      const PartitionID to = target_blocks[hn - batch_begin];
+      if ( hypergraph.nodeDegree(hn) > 0 ) {
+        if ( to != kInvalidPartition && to != from && fitsIntoBlock(hypergraph, hn, to) ) {
+          converged = false;
+          if ( from == kInvalidPartition ) {
+            hypergraph.setNodePart(hn, to);
+          } else {
+            hypergraph.changeNodePart(hn, from, to);
+          }
+        }
+      } else if ( from == kInvalidPartition ) {
+        // In case vertex hn is a degree zero vertex we assign it
+        // to the block with minimum weight
+        assignVertexToBlockWithMinimumWeight(hypergraph, hn);
+      }
+    }
+  }
+  return converged;
+}
+
+MaxGainMove LabelPropagationInitialPartitioner::computeMaxGainMoveForUnassignedVertex(const PartitionedHypergraph& hypergraph,
+                                                                                      const HypernodeID hn,
+                                                                                      GainComputationData& data) const {
   ASSERT(hypergraph.partID(hn) == kInvalidPartition);
-  ASSERT(std::all_of(_tmp_scores.begin(), _tmp_scores.end(), [](Gain i) { return i == 0; }),
+  ASSERT(std::all_of(data.tmp_scores.begin(), data.tmp_scores.end(), [](Gain i) { return i == 0; }),
           "Temp gain array not initialized properly");
-  _valid_blocks.reset();
+  data.valid_blocks.reset();
 
   HyperedgeWeight internal_weight = 0;
   for (const HyperedgeID& he : hypergraph.incidentEdges(hn)) {
@@ -156,27 +212,28 @@ MaxGainMove LabelPropagationInitialPartitioner::computeMaxGainMoveForUnassignedV
       // assign the vertex to an different block than the one already contained
       // in the hyperedge
       const PartitionID connected_block = *hypergraph.connectivitySet(he).begin();
-      _valid_blocks.set(connected_block, true);
+      data.valid_blocks.set(connected_block, true);
       internal_weight += he_weight;
-      _tmp_scores[connected_block] += he_weight;
+      data.tmp_scores[connected_block] += he_weight;
     } else {
       // Otherwise we can assign the vertex to a block already contained
       // in the hyperedge without affecting cut
       for (const PartitionID& target_part : hypergraph.connectivitySet(he)) {
-        _valid_blocks.set(target_part, true);
+        data.valid_blocks.set(target_part, true);
       }
     }
   }
 
-  return findMaxGainMove(hypergraph, hn, internal_weight);
+  return findMaxGainMove(hypergraph, hn, internal_weight, data);
 }
 
-MaxGainMove LabelPropagationInitialPartitioner::computeMaxGainMoveForAssignedVertex(PartitionedHypergraph& hypergraph,
-                                                                                    const HypernodeID hn) {
+MaxGainMove LabelPropagationInitialPartitioner::computeMaxGainMoveForAssignedVertex(const PartitionedHypergraph& hypergraph,
+                                                                                    const HypernodeID hn,
+                                                                                    GainComputationData& data) const {
   ASSERT(hypergraph.partID(hn) != kInvalidPartition);
-  ASSERT(std::all_of(_tmp_scores.begin(), _tmp_scores.end(), [](Gain i) { return i == 0; }),
+  ASSERT(std::all_of(data.tmp_scores.begin(), data.tmp_scores.end(), [](Gain i) { return i == 0; }),
           "Temp gain array not initialized properly");
-  _valid_blocks.reset();
+  data.valid_blocks.reset();
 
   const PartitionID from = hypergraph.partID(hn);
   HyperedgeWeight internal_weight = 0;
@@ -192,44 +249,45 @@ MaxGainMove LabelPropagationInitialPartitioner::computeMaxGainMoveForAssignedVer
       internal_weight += he_weight;
     } else if ( connectivity == 2 ) {
       for (const PartitionID& to : hypergraph.connectivitySet(he)) {
-        _valid_blocks.set(to, true);
+        data.valid_blocks.set(to, true);
         // In case connectivity is two and hn is the last vertex in hyperedge
         // he of block from, we would make that hyperedge a non-cut hyperedge.
         if ( pins_in_from_part == 1 && hypergraph.pinCountInPart(he, to) > 0 ) {
-          _tmp_scores[to] += he_weight;
+          data.tmp_scores[to] += he_weight;
         }
       }
     } else {
       // Otherwise we can assign the vertex to a block already contained
       // in the hyperedge without affecting cut
       for (const PartitionID& to : hypergraph.connectivitySet(he)) {
-        _valid_blocks.set(to, true);
+        data.valid_blocks.set(to, true);
       }
     }
   }
 
-  return findMaxGainMove(hypergraph, hn, internal_weight);
+  return findMaxGainMove(hypergraph, hn, internal_weight, data);
 }
 
 
-MaxGainMove LabelPropagationInitialPartitioner::findMaxGainMove(PartitionedHypergraph& hypergraph,
+MaxGainMove LabelPropagationInitialPartitioner::findMaxGainMove(const PartitionedHypergraph& hypergraph,
                                                                 const HypernodeID hn,
-                                                                const HypernodeWeight internal_weight) {
+                                                                const HypernodeWeight internal_weight,
+                                                                GainComputationData& data) const {
   const PartitionID from = hypergraph.partID(hn);
   PartitionID best_block = from;
   Gain best_score = from == kInvalidPartition ? std::numeric_limits<Gain>::min() : 0;
   for (PartitionID block = 0; block < _context.partition.k; ++block) {
-    if (from != block && _valid_blocks[block]) {
-      _tmp_scores[block] -= internal_weight;
+    if (from != block && data.valid_blocks[block]) {
+      data.tmp_scores[block] -= internal_weight;
 
       // Since we perform size-constraint label propagation, the move to the
       // corresponding block is only valid, if it fullfils the balanced constraint.
-      if (fitsIntoBlock(hypergraph, hn, block) && _tmp_scores[block] > best_score) {
-        best_score = _tmp_scores[block];
+      if (fitsIntoBlock(hypergraph, hn, block) && data.tmp_scores[block] > best_score) {
+        best_score = data.tmp_scores[block];
         best_block = block;
       }
     }
-    _tmp_scores[block] = 0;
+    data.tmp_scores[block] = 0;
   }
   return MaxGainMove { best_block, best_score };
 }
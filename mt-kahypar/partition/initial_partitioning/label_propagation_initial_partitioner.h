@@ -46,21 +46,37 @@ class LabelPropagationInitialPartitioner : public IInitialPartitioner {
     const Gain gain;
   };
 
+ private:
+  // ! Temporary data of the gain computation
+  struct GainComputationData {
+    explicit GainComputationData(const PartitionID k) :
+      valid_blocks(k),
+      tmp_scores(k) { }
+
+    kahypar::ds::FastResetFlagArray<> valid_blocks;
+    parallel::scalable_vector<Gain> tmp_scores;
+  };
+
+  // ! Number of nodes for which the target blocks are computed in
+  // ! parallel before they are moved (nested parallelism)
+  static constexpr HypernodeID BATCH_SIZE = 4096;
+
+ public:
+
   LabelPropagationInitialPartitioner(const InitialPartitioningAlgorithm,
                                       InitialPartitioningDataContainer& ip_data,
                                       const Context& context,
                                       const int seed, const int tag) :
     _ip_data(ip_data),
     _context(context),
-    _valid_blocks(context.partition.k),
-    _tmp_scores(context.partition.k),
+    _gain_data(context.partition.k),
     _rng(seed),
     _tag(tag) { }
 
  private:
   void partitionImpl() final;
 
-  bool fitsIntoBlock(PartitionedHypergraph& hypergraph,
+  bool fitsIntoBlock(const PartitionedHypergraph& hypergraph,
                      const HypernodeID hn,
                      const PartitionID block) const {
     ASSERT(block != kInvalidPartition && block < _context.partition.k);
@@ -69,24 +85,33 @@ class LabelPropagationInitialPartitioner : public IInitialPartitioner {
       std::min(1.005, 1 + _context.partition.epsilon);
   }
 
-  MaxGainMove computeMaxGainMove(PartitionedHypergraph& hypergraph,
-                                 const HypernodeID hn) {
+  MaxGainMove computeMaxGainMove(const PartitionedHypergraph& hypergraph,
+                                 const HypernodeID hn,
+                                 GainComputationData& data) const {
     if ( hypergraph.partID(hn) == kInvalidPartition ) {
-      return computeMaxGainMoveForUnassignedVertex(hypergraph, hn);
+      return computeMaxGainMoveForUnassignedVertex(hypergraph, hn, data);
     } else {
-      return computeMaxGainMoveForAssignedVertex(hypergraph, hn);
+      return computeMaxGainMoveForAssignedVertex(hypergraph, hn, data);
     }
   }
 
-  MaxGainMove computeMaxGainMoveForUnassignedVertex(PartitionedHypergraph& hypergraph,
-                                                    const HypernodeID hn);
+  MaxGainMove computeMaxGainMoveForUnassignedVertex(const PartitionedHypergraph& hypergraph,
+                                                    const HypernodeID hn,
+                                                    GainComputationData& data) const;
 
-  MaxGainMove computeMaxGainMoveForAssignedVertex(PartitionedHypergraph& hypergraph,
-                                                  const HypernodeID hn);
+  MaxGainMove computeMaxGainMoveForAssignedVertex(const PartitionedHypergraph& hypergraph,
+                                                  const HypernodeID hn,
+                                                  GainComputationData& data) const;
 
-  MaxGainMove findMaxGainMove(PartitionedHypergraph& hypergraph,
+  MaxGainMove findMaxGainMove(const PartitionedHypergraph& hypergraph,
                               const HypernodeID hn,
-                              const HypernodeWeight internal_weight);
+                              const HypernodeWeight internal_weight,
+                              GainComputationData& data) const;
+
+  // ! Label propagation round, in which the target blocks of the nodes are
+  // ! computed in parallel (in batches of BATCH_SIZE nodes) and the moves are
+  // ! applied sequentially afterwards. Returns true, if no node was moved.
+  bool parallelLabelPropagationRound(PartitionedHypergraph& hypergraph);
 
   void extendBlockToInitialBlockSize(PartitionedHypergraph& hypergraph,
                                      HypernodeID seed_vertex,
@@ -97,8 +122,7 @@ class LabelPropagationInitialPartitioner : public IInitialPartitioner {
 
   InitialPartitioningDataContainer& _ip_data;
   const Context& _context;
-  kahypar::ds::FastResetFlagArray<> _valid_blocks;
-  parallel::scalable_vector<Gain> _tmp_scores;
+  GainComputationData _gain_data;
   std::mt19937 _rng;
   const int _tag;
 };
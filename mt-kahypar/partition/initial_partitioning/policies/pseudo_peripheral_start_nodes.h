@@ -26,6 +26,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <mutex>
+#include <type_traits>
+
 #include "tbb/task.h"
 
 #include "mt-kahypar/parallel/stl/scalable_vector.h"
@@ -40,13 +44,66 @@ class PseudoPeripheralStartNodes {
   using Queue = parallel::scalable_queue<HypernodeID>;
 
   static constexpr bool debug = false;
+  static constexpr size_t MAX_NUM_CANDIDATES = 64;
 
  public:
+  // ! Computes k start nodes that are "far" away from each other. The start nodes
+  // ! are sampled from a set of up to 64 pseudo-peripheral candidates, which is
+  // ! computed once per hypergraph and shared by all runs. If there are fewer
+  // ! candidates than blocks, we perform k - 1 BFS on the hypergraph instead.
   static inline StartNodes computeStartNodes(InitialPartitioningDataContainer& ip_data,
                                              const Context& context,
                                              const PartitionID default_block,
                                              std::mt19937& rng) {
+    InitialPartitioningDataContainer::StartNodeCandidates& candidates = ip_data.start_node_candidates();
+    std::call_once(candidates.is_initialized, [&] {
+      computeStartNodeCandidates(ip_data, context, candidates);
+    });
+
+    const size_t num_candidates = candidates.nodes.size();
+    if ( num_candidates < static_cast<size_t>(context.partition.k) ) {
+      return computeStartNodesWithRepeatedBFS(ip_data, context, default_block, rng);
+    }
+
+    // The first start node is a random candidate. Each further start node is
+    // the candidate with the largest distance to the start nodes chosen so far
+    // (ties are broken randomly).
+    StartNodes start_nodes;
+    parallel::scalable_vector<HypernodeID> min_distance(num_candidates, kInvalidHypernode);
+    parallel::scalable_vector<bool> is_chosen(num_candidates, false);
+    size_t current = std::uniform_int_distribution<size_t>(0, num_candidates - 1)(rng);
+    for ( PartitionID i = 0; i < context.partition.k; ++i ) {
+      start_nodes.push_back(candidates.nodes[current]);
+      is_chosen[current] = true;
+      const HypernodeID* distances = candidates.distances.data() + current * num_candidates;
+      size_t next = num_candidates;
+      size_t num_ties = 0;
+      for ( size_t j = 0; j < num_candidates; ++j ) {
+        min_distance[j] = std::min(min_distance[j], distances[j]);
+        if ( !is_chosen[j] ) {
+          if ( next == num_candidates || min_distance[j] > min_distance[next] ) {
+            next = j;
+            num_ties = 1;
+          } else if ( min_distance[j] == min_distance[next] &&
+                      std::uniform_int_distribution<size_t>(0, num_ties++)(rng) == 0 ) {
+            next = j;
+          }
+        }
+      }
+      current = next;
+    }
+
+    ASSERT(start_nodes.size() == static_cast<size_t>(context.partition.k));
+    return start_nodes;
+  }
+
+ private:
+  static inline StartNodes computeStartNodesWithRepeatedBFS(InitialPartitioningDataContainer& ip_data,
+                                                            const Context& context,
+                                                            const PartitionID default_block,
+                                                            std::mt19937& rng) {
     PartitionedHypergraph& hypergraph = ip_data.local_partitioned_hypergraph();
+    const CompactHypergraph& compact_hg = ip_data.compact_hypergraph();
     kahypar::ds::FastResetFlagArray<>& hypernodes_in_queue =
       ip_data.local_hypernode_fast_reset_flag_array();
     kahypar::ds::FastResetFlagArray<>& hyperedges_in_queue =
@@ -86,18 +143,12 @@ class PseudoPeripheralStartNodes {
 
         // Add all adjacent non-visited vertices of the current visited hypernode
         // to queue.
-        for ( const HyperedgeID& he : hypergraph.incidentEdges(last_hypernode_touched) ) {
-          if ( !hyperedges_in_queue[he] ) {
-            if ( hypergraph.edgeSize(he) <= context.partition.ignore_hyperedge_size_threshold ) {
-              for ( const HypernodeID& pin : hypergraph.pins(he) ) {
-                if ( !hypernodes_in_queue[pin] ) {
-                  queue.push(pin);
-                  hypernodes_in_queue.set(pin, true);
-                }
-              }
-            }
-            hyperedges_in_queue.set(he, true);
-          }
+        if ( compact_hg.isInitialized() ) {
+          pushAdjacentHypernodesIntoQueue(hypergraph, compact_hg, context, queue,
+            hypernodes_in_queue, hyperedges_in_queue, last_hypernode_touched);
+        } else {
+          pushAdjacentHypernodesIntoQueue(hypergraph, hypergraph, context, queue,
+            hypernodes_in_queue, hyperedges_in_queue, last_hypernode_touched);
         }
 
         // In case the queue is empty and we have not visited all hypernodes.
@@ -123,7 +174,151 @@ class PseudoPeripheralStartNodes {
     return start_nodes;
   }
 
- private:
+  // ! The candidates are the nodes last reached by a BFS from random sources.
+  // ! Both the BFS from the random sources and the BFS from the candidates,
+  // ! which computes the pairwise distances of the candidates, are performed
+  // ! simultaneously for up to 64 sources (see bitParallelBFS(...)).
+  static inline void computeStartNodeCandidates(InitialPartitioningDataContainer& ip_data,
+                                                const Context& context,
+                                                InitialPartitioningDataContainer::StartNodeCandidates& candidates) {
+    const PartitionedHypergraph& hypergraph = ip_data.local_partitioned_hypergraph();
+    const CompactHypergraph& compact_hg = ip_data.compact_hypergraph();
+    StartNodes sources;
+    for ( const HypernodeID& hn : hypergraph.nodes() ) {
+      sources.push_back(hn);
+    }
+    std::mt19937 prng(context.partition.seed);
+    std::shuffle(sources.begin(), sources.end(), prng);
+    sources.resize(std::min(sources.size(), MAX_NUM_CANDIDATES));
+
+    StartNodes last_reached(sources.size(), kInvalidHypernode);
+    auto bfs = [&](const StartNodes& start_nodes, const auto& visit) {
+      if ( compact_hg.isInitialized() ) {
+        bitParallelBFS(hypergraph, compact_hg, context, start_nodes, visit);
+      } else {
+        bitParallelBFS(hypergraph, hypergraph, context, start_nodes, visit);
+      }
+    };
+    bfs(sources, [&](const HypernodeID hn, uint64_t reached_by, const HypernodeID) {
+      for ( ; reached_by; reached_by &= reached_by - 1 ) {
+        last_reached[__builtin_ctzll(reached_by)] = hn;
+      }
+    });
+
+    StartNodes& nodes = candidates.nodes;
+    for ( const HypernodeID& hn : last_reached ) {
+      if ( std::find(nodes.begin(), nodes.end(), hn) == nodes.end() ) {
+        nodes.push_back(hn);
+      }
+    }
+
+    const size_t num_candidates = nodes.size();
+    parallel::scalable_vector<uint8_t> candidate_index(hypergraph.initialNumNodes(), MAX_NUM_CANDIDATES);
+    for ( size_t i = 0; i < num_candidates; ++i ) {
+      candidate_index[nodes[i]] = i;
+    }
+    candidates.distances.assign(num_candidates * num_candidates, kInvalidHypernode);
+    bfs(nodes, [&](const HypernodeID hn, uint64_t reached_by, const HypernodeID distance) {
+      const size_t j = candidate_index[hn];
+      if ( j < num_candidates ) {
+        for ( ; reached_by; reached_by &= reached_by - 1 ) {
+          candidates.distances[__builtin_ctzll(reached_by) * num_candidates + j] = distance;
+        }
+      }
+    });
+    DBG << "Computed" << num_candidates << "start node candidates";
+  }
+
+  // ! Performs a BFS from each of the (at most 64) sources simultaneously. Bit i
+  // ! of the label of a node is set, if the node is reached by the BFS from sources[i].
+  // ! Thus, a node is processed at most once per BFS level and only the sources
+  // ! that reached it in the previous level are propagated to its neighbors.
+  // ! visit(hn, reached_by, distance) is called for each node and each distance at
+  // ! which new sources reach the node.
+  template<typename IncidenceStructure, typename F>
+  static inline void bitParallelBFS(const PartitionedHypergraph& hypergraph,
+                                    const IncidenceStructure& incidence_structure,
+                                    const Context& context,
+                                    const StartNodes& sources,
+                                    const F& visit) {
+    ASSERT(sources.size() <= MAX_NUM_CANDIDATES);
+    const HypernodeID num_nodes = hypergraph.initialNumNodes();
+    parallel::scalable_vector<uint64_t> visited(num_nodes, 0);
+    parallel::scalable_vector<uint64_t> frontier(num_nodes, 0);
+    parallel::scalable_vector<uint64_t> next_frontier(num_nodes, 0);
+    StartNodes active;
+    StartNodes next_active;
+    for ( size_t i = 0; i < sources.size(); ++i ) {
+      if ( frontier[sources[i]] == 0 ) {
+        active.push_back(sources[i]);
+      }
+      frontier[sources[i]] |= UINT64_C(1) << i;
+      visited[sources[i]] |= UINT64_C(1) << i;
+    }
+    for ( const HypernodeID& hn : active ) {
+      visit(hn, frontier[hn], 0);
+    }
+
+    for ( HypernodeID distance = 1; !active.empty(); ++distance ) {
+      for ( const HypernodeID& hn : active ) {
+        for ( const HyperedgeID he : incidence_structure.incidentEdges(hn) ) {
+          // Note that the compact hypergraph does not store the pins of large hyperedges
+          if ( std::is_same<IncidenceStructure, CompactHypergraph>::value ||
+               hypergraph.edgeSize(he) <= context.partition.ignore_hyperedge_size_threshold ) {
+            for ( const HypernodeID pin : incidence_structure.pins(he) ) {
+              const uint64_t reached_by = frontier[hn] & ~visited[pin];
+              if ( reached_by ) {
+                if ( next_frontier[pin] == 0 ) {
+                  next_active.push_back(pin);
+                }
+                next_frontier[pin] |= reached_by;
+              }
+            }
+          }
+        }
+      }
+
+      for ( const HypernodeID& hn : active ) {
+        frontier[hn] = 0;
+      }
+      for ( const HypernodeID& hn : next_active ) {
+        frontier[hn] = next_frontier[hn];
+        visited[hn] |= next_frontier[hn];
+        next_frontier[hn] = 0;
+        visit(hn, frontier[hn], distance);
+      }
+      std::swap(active, next_active);
+      next_active.clear();
+    }
+  }
+
+  // ! The incidence structure is either the hypergraph itself
+  // ! or its flat copy (see CompactHypergraph)
+  template<typename IncidenceStructure>
+  static inline void pushAdjacentHypernodesIntoQueue(const PartitionedHypergraph& hypergraph,
+                                                     const IncidenceStructure& incidence_structure,
+                                                     const Context& context,
+                                                     Queue& queue,
+                                                     kahypar::ds::FastResetFlagArray<>& hypernodes_in_queue,
+                                                     kahypar::ds::FastResetFlagArray<>& hyperedges_in_queue,
+                                                     const HypernodeID hn) {
+    for ( const HyperedgeID he : incidence_structure.incidentEdges(hn) ) {
+      if ( !hyperedges_in_queue[he] ) {
+        // Note that the compact hypergraph does not store the pins of large hyperedges
+        if ( std::is_same<IncidenceStructure, CompactHypergraph>::value ||
+             hypergraph.edgeSize(he) <= context.partition.ignore_hyperedge_size_threshold ) {
+          for ( const HypernodeID pin : incidence_structure.pins(he) ) {
+            if ( !hypernodes_in_queue[pin] ) {
+              queue.push(pin);
+              hypernodes_in_queue.set(pin, true);
+            }
+          }
+        }
+        hyperedges_in_queue.set(he, true);
+      }
+    }
+  }
+
   static inline void initializeQueue(Queue& queue, StartNodes& start_nodes,
                                      kahypar::ds::FastResetFlagArray<>& hypernodes_in_queue) {
     for ( const HypernodeID& hn : start_nodes ) {
@@ -26,8 +26,13 @@
 
 #include "pool_initial_partitioner.h"
 
+#include <sstream>
+
 #include "tbb/task_group.h"
 
+#include "mt-kahypar/parallel/atomic_wrapper.h"
+#include "mt-kahypar/utils/trace_recorder.h"
+
 #include "mt-kahypar/partition/registries/register_initial_partitioning_algorithms.h"
 
 namespace mt_kahypar {
@@ -64,13 +69,64 @@ void bipartition(PartitionedHypergraph& hypergraph, const Context& context) {
 
   tbb::task_group tg;
   InitialPartitioningDataContainer ip_data(hypergraph, context);
-  for ( const auto [algorithm, seed, tag] : _ip_task_lists ) {
-    tg.run([&, algorithm, seed, tag] {
-      std::unique_ptr<IInitialPartitioner> initial_partitioner =
-        InitialPartitionerFactory::getInstance().createObject(
-          algorithm, algorithm, ip_data, context, seed, tag);
-      initial_partitioner->partition();
-    });
+  CAtomic<size_t> finished_runs(0);
+  auto run_initial_partitioner = [&](const InitialPartitioningAlgorithm algorithm,
+                                     const int seed,
+                                     const int tag) {
+    if ( context.isCancelled() && finished_runs.load(std::memory_order_relaxed) > 0 ) {
+      // Once the partitioning run is cancelled, we only wait for
+      // the first initial partition and skip all remaining runs
+      return;
+    }
+    MT_KAHYPAR_TRACE_SCOPE("initial_partitioning", [&] {
+      std::stringstream name;
+      name << algorithm;
+      return name.str();
+    }());
+    std::unique_ptr<IInitialPartitioner> initial_partitioner =
+      InitialPartitionerFactory::getInstance().createObject(
+        algorithm, algorithm, ip_data, context, seed, tag);
+    initial_partitioner->partition();
+    finished_runs.fetch_add(1, std::memory_order_relaxed);
+  };
+
+  if ( context.initial_partitioning.use_ip_racing_scheduler &&
+       context.initial_partitioning.use_adaptive_ip_runs &&
+       !context.partition.deterministic ) {
+    // Racing scheduler: Instead of scheduling all runs upfront, each worker
+    // repeatedly asks the IP data container for the most promising initial
+    // partitioner. Runs of partitioners that are unlikely to produce a new
+    // best partition are cancelled and their threads work on the remaining
+    // partitioners.
+    const size_t num_algorithms = static_cast<size_t>(InitialPartitioningAlgorithm::UNDEFINED);
+    vec<vec<IPTask>> tasks_of_algorithm(num_algorithms);
+    for ( const IPTask& task : _ip_task_lists ) {
+      tasks_of_algorithm[static_cast<size_t>(std::get<0>(task))].push_back(task);
+    }
+    vec<size_t> remaining_runs(num_algorithms, 0);
+    vec<size_t> started_runs(num_algorithms, 0);
+    for ( size_t i = 0; i < num_algorithms; ++i ) {
+      remaining_runs[i] = tasks_of_algorithm[i].size();
+    }
+
+    const size_t num_workers = std::min(
+      context.shared_memory.num_threads, _ip_task_lists.size());
+    for ( size_t i = 0; i < num_workers; ++i ) {
+      tg.run([&] {
+        while ( true ) {
+          const auto [algorithm, run] = ip_data.next_racing_run(remaining_runs, started_runs);
+          if ( algorithm == InitialPartitioningAlgorithm::UNDEFINED ) break;
+          const IPTask& task = tasks_of_algorithm[static_cast<size_t>(algorithm)][run];
+          run_initial_partitioner(algorithm, std::get<1>(task), std::get<2>(task));
+        }
+      });
+    }
+  } else {
+    for ( const auto [algorithm, seed, tag] : _ip_task_lists ) {
+      tg.run([&, algorithm, seed, tag] {
+        run_initial_partitioner(algorithm, seed, tag);
+      });
+    }
   }
   tg.wait();
   ip_data.apply();
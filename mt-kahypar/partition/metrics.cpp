@@ -31,8 +31,13 @@
 #include <cmath>
 #include <algorithm>
 
+#include "tbb/parallel_for.h"
+
+#include "mt-kahypar/datastructures/sparse_map.h"
+
 namespace mt_kahypar::metrics {
-  HyperedgeWeight hyperedgeCut(const PartitionedHypergraph& hypergraph, const bool parallel) {
+  namespace {
+  HyperedgeWeight recomputeHyperedgeCut(const PartitionedHypergraph& hypergraph, const bool parallel) {
     if ( parallel ) {
       tbb::enumerable_thread_specific<HyperedgeWeight> cut(0);
       hypergraph.doParallelForAllEdges([&](const HyperedgeID he) {
@@ -52,7 +57,7 @@ namespace mt_kahypar::metrics {
     }
   }
 
-  HyperedgeWeight km1(const PartitionedHypergraph& hypergraph, const bool parallel) {
+  HyperedgeWeight recomputeKm1(const PartitionedHypergraph& hypergraph, const bool parallel) {
     if ( parallel ) {
       tbb::enumerable_thread_specific<HyperedgeWeight> km1(0);
       hypergraph.doParallelForAllEdges([&](const HyperedgeID he) {
@@ -68,7 +73,7 @@ namespace mt_kahypar::metrics {
     }
   }
 
-  HyperedgeWeight soed(const PartitionedHypergraph& hypergraph, const bool parallel) {
+  HyperedgeWeight recomputeSoed(const PartitionedHypergraph& hypergraph, const bool parallel) {
     if ( parallel ) {
       tbb::enumerable_thread_specific<HyperedgeWeight> soed(0);
       hypergraph.doParallelForAllEdges([&](const HyperedgeID he) {
@@ -90,6 +95,53 @@ namespace mt_kahypar::metrics {
     }
   }
 
+  } // namespace
+
+  // If the partitioned hypergraph tracks its objective, the metrics are answered from the
+  // tracked values. In debug builds, they are cross-checked against a full recomputation.
+  HyperedgeWeight hyperedgeCut(const PartitionedHypergraph& hypergraph, const bool parallel) {
+    if ( hypergraph.isObjectiveTracked() ) {
+      ASSERT(hypergraph.trackedCut() == recomputeHyperedgeCut(hypergraph, parallel),
+        V(hypergraph.trackedCut()) << V(recomputeHyperedgeCut(hypergraph, parallel)));
+      return hypergraph.trackedCut();
+    }
+    return recomputeHyperedgeCut(hypergraph, parallel);
+  }
+
+  HyperedgeWeight km1(const PartitionedHypergraph& hypergraph, const bool parallel) {
+    if ( hypergraph.isObjectiveTracked() ) {
+      ASSERT(hypergraph.trackedKm1() == recomputeKm1(hypergraph, parallel),
+        V(hypergraph.trackedKm1()) << V(recomputeKm1(hypergraph, parallel)));
+      return hypergraph.trackedKm1();
+    }
+    return recomputeKm1(hypergraph, parallel);
+  }
+
+  HyperedgeWeight soed(const PartitionedHypergraph& hypergraph, const bool parallel) {
+    if ( hypergraph.isObjectiveTracked() ) {
+      // Each cut hyperedge contributes its weight once more than to the km1 metric
+      const HyperedgeWeight soed = hypergraph.trackedKm1() + hypergraph.trackedCut();
+      ASSERT(soed == recomputeSoed(hypergraph, parallel),
+        V(soed) << V(recomputeSoed(hypergraph, parallel)));
+      return soed;
+    }
+    return recomputeSoed(hypergraph, parallel);
+  }
+
+  bool validateTrackedObjective(const PartitionedHypergraph& hypergraph) {
+    if ( hypergraph.isObjectiveTracked() ) {
+      const HyperedgeWeight expected_km1 = recomputeKm1(hypergraph, true);
+      const HyperedgeWeight expected_cut = recomputeHyperedgeCut(hypergraph, true);
+      if ( hypergraph.trackedKm1() != expected_km1 || hypergraph.trackedCut() != expected_cut ) {
+        LOG << "Tracked objective differs from recomputed objective:"
+            << V(hypergraph.trackedKm1()) << V(expected_km1)
+            << V(hypergraph.trackedCut()) << V(expected_cut);
+        return false;
+      }
+    }
+    return true;
+  }
+
   bool isBalanced(const PartitionedHypergraph& phg, const Context& context) {
     size_t num_empty_parts = 0;
     for (PartitionID i = 0; i < context.partition.k; ++i) {
@@ -129,4 +181,63 @@ namespace mt_kahypar::metrics {
     return max_balance - 1.0;
   }
 
+  vec<BlockPairCut> blockPairCuts(const PartitionedHypergraph& hypergraph) {
+    using CutWeightMap = ds::DynamicSparseMap<uint64_t, HyperedgeWeight>;
+    const PartitionID k = hypergraph.k();
+    // Each thread aggregates the cut weights in one hash map per range of rows of the
+    // block-pair matrix, such that the ranges can be merged independently of each other
+    const size_t num_ranges = std::min(static_cast<size_t>(k), UL(64));
+    auto range_of = [&](const PartitionID block) {
+      return static_cast<size_t>(block) * num_ranges / k;
+    };
+    tbb::enumerable_thread_specific<vec<CutWeightMap>> local_cut_weights([&] {
+      return vec<CutWeightMap>(num_ranges);
+    });
+    hypergraph.doParallelForAllEdges([&](const HyperedgeID he) {
+      if ( hypergraph.connectivity(he) > 1 ) {
+        vec<CutWeightMap>& cut_weights = local_cut_weights.local();
+        const HyperedgeWeight edge_weight = hypergraph.edgeWeight(he);
+        for ( const PartitionID block_0 : hypergraph.connectivitySet(he) ) {
+          for ( const PartitionID block_1 : hypergraph.connectivitySet(he) ) {
+            if ( block_0 < block_1 ) {
+              cut_weights[range_of(block_0)][
+                static_cast<uint64_t>(block_0) * k + block_1] += edge_weight;
+            }
+          }
+        }
+      }
+    });
+
+    // Merge the thread-local maps of each range and sort its entries by block pair
+    vec<vec<BlockPairCut>> range_cuts(num_ranges);
+    tbb::parallel_for(UL(0), num_ranges, [&](const size_t range) {
+      CutWeightMap cut_weights;
+      for ( const vec<CutWeightMap>& local : local_cut_weights ) {
+        for ( const auto& entry : local[range] ) {
+          cut_weights[entry.key] += entry.value;
+        }
+      }
+      for ( const auto& entry : cut_weights ) {
+        // Each edge of a graph is visited in both directions
+        range_cuts[range].push_back(BlockPairCut { static_cast<PartitionID>(entry.key / k),
+          static_cast<PartitionID>(entry.key % k), entry.value / (Hypergraph::is_graph ? 2 : 1) });
+      }
+      std::sort(range_cuts[range].begin(), range_cuts[range].end(),
+        [&](const BlockPairCut& lhs, const BlockPairCut& rhs) {
+          return lhs.block_0 < rhs.block_0 || ( lhs.block_0 == rhs.block_0 && lhs.block_1 < rhs.block_1 );
+        });
+    });
+
+    vec<size_t> offsets(num_ranges + 1, 0);
+    for ( size_t range = 0; range < num_ranges; ++range ) {
+      offsets[range + 1] = offsets[range] + range_cuts[range].size();
+    }
+    vec<BlockPairCut> block_pair_cuts(offsets[num_ranges]);
+    tbb::parallel_for(UL(0), num_ranges, [&](const size_t range) {
+      std::copy(range_cuts[range].begin(), range_cuts[range].end(),
+                block_pair_cuts.begin() + offsets[range]);
+    });
+    return block_pair_cuts;
+  }
+
 } // namespace mt_kahypar::metrics
\ No newline at end of file
@@ -47,7 +47,7 @@ struct Metrics {
     }
   }
 
-  HyperedgeWeight getMetric(const Mode mode, const Objective objective) {
+  HyperedgeWeight getMetric(const Mode mode, const Objective objective) const {
     if (mode == Mode::recursive_bipartitioning || objective == Objective::cut) {
       // in recursive bisection, km1 is also optimized via the cut net metric
       return cut;
@@ -66,6 +66,10 @@ HyperedgeWeight km1(const PartitionedHypergraph& hypergraph, bool parallel = tru
 
 HyperedgeWeight soed(const PartitionedHypergraph& hypergraph, bool parallel = true);
 
+// ! Returns false, if the objective tracked by the partitioned hypergraph (see
+// ! PartitionedHypergraph::enableObjectiveTracking()) differs from a full recomputation
+bool validateTrackedObjective(const PartitionedHypergraph& hypergraph);
+
 bool isBalanced(const PartitionedHypergraph& phg, const Context& context);
 
 HyperedgeWeight objective(
@@ -75,5 +79,17 @@ HyperedgeWeight objective(
 
 double imbalance(const PartitionedHypergraph& hypergraph, const Context& context);
 
+// ! Cut weight between two blocks (block_0 < block_1)
+struct BlockPairCut {
+  PartitionID block_0;
+  PartitionID block_1;
+  HyperedgeWeight weight;
+};
+
+// ! Returns the sum of the weights of all hyperedges that connect block_0 and block_1 for
+// ! each pair of blocks with a non-zero cut weight (sorted by block pair). A hyperedge with
+// ! connectivity l contributes to all l * (l - 1) / 2 pairs of its connectivity set.
+vec<BlockPairCut> blockPairCuts(const PartitionedHypergraph& hypergraph);
+
 }  // namespace metrics
 }  // namespace mt_kahypar
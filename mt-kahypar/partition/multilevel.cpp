@@ -27,20 +27,36 @@
 
 #include "mt-kahypar/partition/multilevel.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <sstream>
 
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
 #include "tbb/task.h"
 
+#include "mt-kahypar/datastructures/thread_safe_fast_reset_flag_array.h"
+
 #include "mt-kahypar/partition/factories.h"
+#include "mt-kahypar/partition/metrics.h"
+#include "mt-kahypar/partition/refinement/i_refiner.h"
 #include "mt-kahypar/partition/preprocessing/sparsification/degree_zero_hn_remover.h"
 #include "mt-kahypar/partition/preprocessing/sparsification/large_he_remover.h"
 #include "mt-kahypar/partition/initial_partitioning/pool_initial_partitioner.h"
 #include "mt-kahypar/partition/recursive_bipartitioning.h"
 #include "mt-kahypar/partition/deep_multilevel.h"
+#include "mt-kahypar/partition/streaming.h"
+#include "mt-kahypar/partition/multisection.h"
 #include "mt-kahypar/parallel/memory_pool.h"
+#include "mt-kahypar/parallel/tbb_initializer.h"
 #include "mt-kahypar/io/partitioning_output.h"
+#include "mt-kahypar/io/partition_checkpoint.h"
 #include "mt-kahypar/partition/coarsening/multilevel_uncoarsener.h"
 #include "mt-kahypar/partition/coarsening/nlevel_uncoarsener.h"
+#include "mt-kahypar/utils/randomize.h"
 #include "mt-kahypar/utils/utilities.h"
 
 namespace mt_kahypar::multilevel {
@@ -64,23 +80,155 @@ namespace {
     }
   }
 
-  PartitionedHypergraph multilevel_partitioning(Hypergraph& hypergraph,
-                                                const Context& context,
-                                                const bool is_vcycle) {
-    PartitionedHypergraph partitioned_hg;
+  // ! Returns the memory freed by the data structures of the previous phase
+  // ! to the operating system (only in the main run)
+  void releasePhaseMemory(const Context& context) {
+    if ( context.type == ContextType::main && context.shared_memory.release_memory_between_phases ) {
+      parallel::MemoryPool::instance().release_allocator_caches();
+    }
+  }
+
+  // ! Resizes the global thread pool to the current CPU quota of the process at a phase
+  // ! boundary of the main run (if enabled) and returns the number of threads of the next
+  // ! phase. Calls executed in their own thread pool keep their number of threads.
+  size_t adaptNumberOfThreads(const Context& context) {
+    if ( context.type == ContextType::main && context.shared_memory.elastic_num_threads &&
+         !context.thread_pool ) {
+      const size_t num_threads = TBBInitializer::instance().adapt_to_cpu_quota();
+      if ( num_threads != context.shared_memory.num_threads ) {
+        LOG << "Adapt number of threads to CPU quota:" << context.shared_memory.num_threads
+            << "->" << num_threads;
+      }
+      return num_threads;
+    }
+    return context.shared_memory.num_threads;
+  }
+
+  bool supportsReusedHierarchy(const Hypergraph& hypergraph,
+                                const UncoarseningData& uncoarseningData) {
+    return !uncoarseningData.nlevel && !hypergraph.hasFixedVertices();
+  }
+
+  // ! Contracts the first levels of the multilevel hierarchy according to the given clusterings
+  // ! of the input nodes (see partitionWithHierarchy(...)). We stop reusing levels once the
+  // ! current hypergraph reaches the contraction limit, a cluster exceeds the maximum allowed
+  // ! node weight or a level does not shrink the hypergraph sufficiently. Returns the number
+  // ! of reused levels.
+  size_t contractReusedLevels(Hypergraph& hypergraph,
+                              const Context& context,
+                              const CoarseningHierarchy& reused_hierarchy,
+                              UncoarseningData& uncoarseningData) {
+    const HypernodeID num_nodes = hypergraph.initialNumNodes();
+    // Node of the current level that contains the input node
+    vec<HypernodeID> current(num_nodes);
+    tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID& hn) {
+      current[hn] = hn;
+    });
+
+    size_t num_reused_levels = 0;
+    for ( const vec<HypernodeID>& clustering : reused_hierarchy ) {
+      ASSERT(clustering.size() == num_nodes);
+      const HighResClockTimepoint round_start = std::chrono::high_resolution_clock::now();
+      const HypernodeID current_num_nodes = uncoarseningData.hierarchy.empty() ? num_nodes :
+        uncoarseningData.hierarchy.back().contractedHypergraph().initialNumNodes();
+      if ( current_num_nodes <= context.coarsening.contraction_limit ) {
+        break;
+      }
+
+      // Each cluster is represented by its node with the smallest ID on the current level
+      const HypernodeID num_clusters = tbb::parallel_reduce(
+        tbb::blocked_range<HypernodeID>(ID(0), num_nodes), ID(0),
+        [&](const tbb::blocked_range<HypernodeID>& range, HypernodeID max_cluster) {
+          for ( HypernodeID hn = range.begin(); hn < range.end(); ++hn ) {
+            max_cluster = std::max(max_cluster, clustering[hn] + 1);
+          }
+          return max_cluster;
+        }, [](const HypernodeID lhs, const HypernodeID rhs) { return std::max(lhs, rhs); });
+      vec<HypernodeID> representative(num_clusters, kInvalidHypernode);
+      vec<HypernodeWeight> cluster_weight(num_clusters, 0);
+      tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID& hn) {
+        HypernodeID* rep = &representative[clustering[hn]];
+        HypernodeID rep_hn = __atomic_load_n(rep, __ATOMIC_RELAXED);
+        while ( current[hn] < rep_hn && !__atomic_compare_exchange_n(
+          rep, &rep_hn, current[hn], true, __ATOMIC_RELAXED, __ATOMIC_RELAXED) ) { }
+        __atomic_fetch_add(&cluster_weight[clustering[hn]], hypergraph.nodeWeight(hn), __ATOMIC_RELAXED);
+      });
+      const auto [num_non_empty_clusters, max_cluster_weight] = tbb::parallel_reduce(
+        tbb::blocked_range<HypernodeID>(ID(0), num_clusters), std::make_pair(ID(0), HypernodeWeight(0)),
+        [&](const tbb::blocked_range<HypernodeID>& range, std::pair<HypernodeID, HypernodeWeight> res) {
+          for ( HypernodeID c = range.begin(); c < range.end(); ++c ) {
+            res.first += representative[c] != kInvalidHypernode;
+            res.second = std::max(res.second, cluster_weight[c]);
+          }
+          return res;
+        }, [](const auto& lhs, const auto& rhs) {
+          return std::make_pair(lhs.first + rhs.first, std::max(lhs.second, rhs.second));
+        });
+      if ( max_cluster_weight > context.coarsening.max_allowed_node_weight ||
+           static_cast<double>(current_num_nodes) / num_non_empty_clusters <=
+             context.coarsening.minimum_shrink_factor ) {
+        break;
+      }
 
+      parallel::scalable_vector<HypernodeID> communities(current_num_nodes);
+      tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID& hn) {
+        // All input nodes of a current node belong to the same cluster
+        communities[current[hn]] = representative[clustering[hn]];
+      });
+      uncoarseningData.performMultilevelContraction(std::move(communities), round_start);
+      const Level& level = uncoarseningData.hierarchy.back();
+      tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID& hn) {
+        current[hn] = level.mapToContractedHypergraph(current[hn]);
+      });
+      ++num_reused_levels;
+    }
+    return num_reused_levels;
+  }
+
+  // ! Stores the node of each coarse hypergraph that contains the input node
+  void storeHierarchy(const Hypergraph& hypergraph,
+                      const UncoarseningData& uncoarseningData,
+                      CoarseningHierarchy& hierarchy) {
+    const HypernodeID num_nodes = hypergraph.initialNumNodes();
+    const vec<Level>& levels = uncoarseningData.hierarchy;
+    hierarchy.resize(levels.size());
+    for ( size_t i = 0; i < levels.size(); ++i ) {
+      hierarchy[i].resize(num_nodes);
+      tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID& hn) {
+        hierarchy[i][hn] = levels[i].mapToContractedHypergraph(i == 0 ? hn : hierarchy[i - 1][hn]);
+      });
+    }
+  }
+
+  void coarsen(Hypergraph& hypergraph,
+               const Context& context,
+               UncoarseningData& uncoarseningData,
+               CoarseningHierarchy* hierarchy = nullptr) {
     // ################## COARSENING ##################
     mt_kahypar::io::printCoarseningBanner(context);
 
-    const bool nlevel = context.coarsening.algorithm == CoarseningAlgorithm::nlevel_coarsener;
-    UncoarseningData uncoarseningData(nlevel, hypergraph, context);
-
     utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
     timer.start_timer("coarsening", "Coarsening");
+    context.startBudgetPhase(utils::BudgetPhase::coarsening);
+    // The coarsener uses thread-local data structures, which grow with the number of threads
+    adaptNumberOfThreads(context);
+    const bool use_hierarchy = hierarchy && supportsReusedHierarchy(hypergraph, uncoarseningData);
+    if ( use_hierarchy && !hierarchy->empty() ) {
+      timer.start_timer("contract_reused_levels", "Contract Reused Levels");
+      const size_t num_reused_levels = contractReusedLevels(hypergraph, context, *hierarchy, uncoarseningData);
+      utils::Utilities::instance().getStats(context.utility_id).add_stat(
+        "reused_coarsening_levels", static_cast<int64_t>(num_reused_levels));
+      timer.stop_timer("contract_reused_levels");
+    }
     {
       std::unique_ptr<ICoarsener> coarsener = CoarsenerFactory::getInstance().createObject(
         context.coarsening.algorithm, hypergraph, context, uncoarseningData);
       coarsener->coarsen();
+      if ( use_hierarchy ) {
+        storeHierarchy(hypergraph, uncoarseningData, *hierarchy);
+      } else if ( hierarchy ) {
+        hierarchy->clear();
+      }
 
       if (context.partition.verbose_output) {
         Hypergraph& coarsestHypergraph = coarsener->coarsestHypergraph();
@@ -88,11 +236,223 @@ namespace {
           "Coarsened Hypergraph", context.partition.show_memory_consumption);
       }
     }
+    // The rating and clustering data of the coarsener is not required any more
+    releasePhaseMemory(context);
     timer.stop_timer("coarsening");
+  }
+
+  // ! Initial partitioning ignores fixed vertices. Afterwards, the blocks are relabeled
+  // ! such that the weight of the fixed vertices already assigned to their block is
+  // ! (greedily) maximized and the remaining fixed vertices are moved to their block.
+  // ! If this violates the balance constraint, the refiners rebalance the partition.
+  void assignFixedVertices(PartitionedHypergraph& phg, const Context& context) {
+    const PartitionID k = context.partition.k;
+    // fixed_weight[b * k + f] = weight of vertices in block b that are fixed to block f
+    vec<HypernodeWeight> fixed_weight(k * k, 0);
+    for ( const HypernodeID& hn : phg.nodes() ) {
+      if ( phg.isFixed(hn) ) {
+        fixed_weight[phg.partID(hn) * k + phg.fixedVertexBlock(hn)] += phg.nodeWeight(hn);
+      }
+    }
+
+    vec<std::pair<PartitionID, PartitionID>> block_pairs;
+    for ( PartitionID from = 0; from < k; ++from ) {
+      for ( PartitionID to = 0; to < k; ++to ) {
+        if ( fixed_weight[from * k + to] > 0 ) {
+          block_pairs.emplace_back(from, to);
+        }
+      }
+    }
+    std::sort(block_pairs.begin(), block_pairs.end(),
+      [&](const auto& lhs, const auto& rhs) {
+        return fixed_weight[lhs.first * k + lhs.second] > fixed_weight[rhs.first * k + rhs.second];
+      });
+    vec<PartitionID> block_mapping(k, kInvalidPartition);
+    vec<bool> is_target(k, false);
+    for ( const auto& [from, to] : block_pairs ) {
+      if ( block_mapping[from] == kInvalidPartition && !is_target[to] ) {
+        block_mapping[from] = to;
+        is_target[to] = true;
+      }
+    }
+    PartitionID next_target = 0;
+    for ( PartitionID from = 0; from < k; ++from ) {
+      if ( block_mapping[from] == kInvalidPartition ) {
+        while ( is_target[next_target] ) {
+          ++next_target;
+        }
+        block_mapping[from] = next_target;
+        is_target[next_target] = true;
+      }
+    }
+
+    vec<PartitionID> part_ids(phg.initialNumNodes(), kInvalidPartition);
+    phg.doParallelForAllNodes([&](const HypernodeID hn) {
+      part_ids[hn] = phg.isFixed(hn) ? phg.fixedVertexBlock(hn) : block_mapping[phg.partID(hn)];
+    });
+    phg.resetPartition();
+    phg.doParallelForAllNodes([&](const HypernodeID hn) {
+      phg.setOnlyNodePart(hn, part_ids[hn]);
+    });
+    phg.initializePartition();
+  }
+
+  void initialPartition(PartitionedHypergraph& phg, const Context& ip_context) {
+    switch ( ip_context.initial_partitioning.mode ) {
+      case Mode::direct:
+        // The pool initial partitioner consist of several flat bipartitioning
+        // techniques. This case runs as a base case (k = 2) within recursive bipartitioning
+        // or the deep multilevel scheme.
+        pool::bipartition(phg, ip_context); break;
+      // k-way partitions can be computed either by recursive bipartitioning
+      // or deep multilevel partitioning.
+      case Mode::recursive_bipartitioning:
+        recursive_bipartitioning::partition(phg, ip_context); break;
+      case Mode::deep_multilevel:
+        deep_multilevel::partition(phg, ip_context); break;
+      case Mode::streaming:
+        streaming::partition(phg, ip_context); break;
+      case Mode::multisection:
+        multisection::partition(phg, ip_context); break;
+      case Mode::UNDEFINED: ERR("Undefined initial partitioning algorithm");
+    }
+  }
+
+  bool usePortfolioInitialPartitioning(const PartitionedHypergraph& phg,
+                                       const Context& context,
+                                       const UncoarseningData& uncoarseningData) {
+    return context.initial_partitioning.portfolio_levels > 1 &&
+      !uncoarseningData.nlevel && uncoarseningData.hierarchy.size() > 1 &&
+      !phg.hasFixedVertices() && !context.partition.deterministic;
+  }
+
+  struct PortfolioCandidate {
+    // ! Level of the multilevel hierarchy on which the candidate is partitioned
+    size_t level = 0;
+    std::unique_ptr<Hypergraph> hypergraph;
+    std::unique_ptr<PartitionedHypergraph> partitioned_hg;
+    HyperedgeWeight objective = 0;
+    bool is_balanced = false;
+    double imbalance = 0.0;
+  };
+
+  // ! Portfolio initial partitioning: The coarsest levels of the hierarchy are partitioned
+  // ! concurrently (each with a share of the threads). The partitions are projected to the
+  // ! finest of these levels and improved with a short label propagation run there. The
+  // ! level with the best outcome becomes the coarsest level of the hierarchy and keeps
+  // ! its (unrefined) initial partition. Returns the number of removed levels.
+  size_t portfolioInitialPartitioning(PartitionedHypergraph& phg,
+                                      const Context& context,
+                                      const Context& ip_context,
+                                      UncoarseningData& uncoarseningData,
+                                      DegreeZeroHypernodeRemover& degree_zero_hn_remover) {
+    vec<Level>& hierarchy = uncoarseningData.hierarchy;
+    const size_t num_levels = hierarchy.size();
+    const size_t num_candidates = std::min(context.initial_partitioning.portfolio_levels, num_levels);
+    const size_t num_threads = std::max(context.shared_memory.num_threads / num_candidates, UL(1));
+    const double thread_reduction_factor = static_cast<double>(num_threads) / context.shared_memory.num_threads;
+    Context c_context(ip_context);
+    c_context.shared_memory.num_threads = num_threads;
+    c_context.shared_memory.degree_of_parallelism *= thread_reduction_factor;
+    c_context.initial_partitioning.runs = std::max(
+      std::ceil(static_cast<double>(context.initial_partitioning.runs) *
+        thread_reduction_factor), 1.0);
+
+    // Candidate i is partitioned on the hypergraph of level num_levels - i, where the
+    // hypergraph of level l is hierarchy[l - 1].contractedHypergraph(). Candidate 0
+    // uses the coarsest partitioned hypergraph itself, all others work on a copy.
+    vec<PortfolioCandidate> candidates(num_candidates);
+    tbb::parallel_for(UL(0), num_candidates, [&](const size_t i) {
+      PortfolioCandidate& candidate = candidates[i];
+      candidate.level = num_levels - i;
+      if ( i == 0 ) {
+        initialPartition(phg, c_context);
+        degree_zero_hn_remover.restoreDegreeZeroHypernodes(phg);
+      } else {
+        candidate.hypergraph = std::make_unique<Hypergraph>(
+          hierarchy[candidate.level - 1].contractedHypergraph().copyOnWrite(parallel_tag_t()));
+        candidate.partitioned_hg = std::make_unique<PartitionedHypergraph>(
+          context.partition.k, *candidate.hypergraph, parallel_tag_t());
+        DegreeZeroHypernodeRemover remover(context);
+        if ( context.initial_partitioning.remove_degree_zero_hns_before_ip ) {
+          remover.removeDegreeZeroHypernodes(*candidate.hypergraph);
+        }
+        initialPartition(*candidate.partitioned_hg, c_context);
+        remover.restoreDegreeZeroHypernodes(*candidate.partitioned_hg);
+      }
+    });
+
+    // Each candidate is projected to the finest candidate level and
+    // refined there with label propagation to estimate its quality
+    const size_t finest_level = candidates.back().level;
+    Hypergraph& finest_hg = hierarchy[finest_level - 1].contractedHypergraph();
+    Context eval_context(c_context);
+    eval_context.refinement = context.refinement;
+    eval_context.refinement.label_propagation.maximum_iterations =
+      std::min(eval_context.refinement.label_propagation.maximum_iterations, UL(2));
+    tbb::parallel_for(UL(0), num_candidates, [&](const size_t i) {
+      PortfolioCandidate& candidate = candidates[i];
+      const PartitionedHypergraph& candidate_phg = i == 0 ? phg : *candidate.partitioned_hg;
+      PartitionedHypergraph eval_phg(context.partition.k, finest_hg, parallel_tag_t());
+      eval_phg.doParallelForAllNodes([&](const HypernodeID hn) {
+        HypernodeID coarse_hn = hn;
+        for ( size_t level = finest_level; level < candidate.level; ++level ) {
+          coarse_hn = hierarchy[level].mapToContractedHypergraph(coarse_hn);
+        }
+        eval_phg.setOnlyNodePart(hn, candidate_phg.partID(coarse_hn));
+      });
+      eval_phg.initializePartition();
+
+      Metrics current_metrics = { metrics::km1(eval_phg), metrics::hyperedgeCut(eval_phg),
+                                  metrics::imbalance(eval_phg, eval_context) };
+      if ( eval_context.refinement.label_propagation.algorithm != LabelPropagationAlgorithm::do_nothing ) {
+        parallel::scalable_vector<HypernodeID> dummy;
+        std::unique_ptr<IRefiner> label_propagation = LabelPropagationFactory::getInstance().createObject(
+          eval_context.refinement.label_propagation.algorithm, finest_hg, eval_context);
+        label_propagation->initialize(eval_phg);
+        label_propagation->refine(eval_phg, dummy, current_metrics, std::numeric_limits<double>::max());
+      }
+      candidate.objective = metrics::objective(eval_phg, context.partition.objective);
+      candidate.is_balanced = metrics::isBalanced(eval_phg, eval_context);
+      candidate.imbalance = metrics::imbalance(eval_phg, eval_context);
+    });
+
+    // Prefer balanced candidates with the best objective. On ties,
+    // the coarser level wins since it leaves more work to refinement.
+    size_t best = 0;
+    for ( size_t i = 1; i < num_candidates; ++i ) {
+      const PortfolioCandidate& lhs = candidates[i];
+      const PortfolioCandidate& rhs = candidates[best];
+      if ( lhs.is_balanced != rhs.is_balanced ? lhs.is_balanced :
+           lhs.is_balanced ? lhs.objective < rhs.objective : lhs.imbalance < rhs.imbalance ) {
+        best = i;
+      }
+    }
+
+    if ( best > 0 ) {
+      const PartitionedHypergraph& winner = *candidates[best].partitioned_hg;
+      phg.resetPartition();
+      uncoarseningData.removeCoarsestLevels(best);
+      phg.doParallelForAllNodes([&](const HypernodeID hn) {
+        phg.setOnlyNodePart(hn, winner.partID(hn));
+      });
+      phg.initializePartition();
+    }
+    return best;
+  }
+
+  PartitionedHypergraph initialPartitioningAndUncoarsening(Hypergraph& hypergraph,
+                                                           const Context& context,
+                                                           UncoarseningData& uncoarseningData,
+                                                           const bool is_vcycle) {
+    PartitionedHypergraph partitioned_hg;
 
     // ################## INITIAL PARTITIONING ##################
+    context.reportProgress(utils::ProgressUpdate { utils::ProgressPhase::initial_partitioning });
     io::printInitialPartitioningBanner(context);
+    utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
     timer.start_timer("initial_partitioning", "Initial Partitioning");
+    context.startBudgetPhase(utils::BudgetPhase::initial_partitioning);
     PartitionedHypergraph& phg = uncoarseningData.coarsestPartitionedHypergraph();
 
     if ( !is_vcycle ) {
@@ -102,26 +462,27 @@ namespace {
       }
 
       Context ip_context(context);
+      ip_context.shared_memory.num_threads = adaptNumberOfThreads(context);
       ip_context.type = ContextType::initial_partitioning;
       ip_context.partition.verbose_output = false;
       ip_context.refinement = context.initial_partitioning.refinement;
       disableTimerAndStats(context);
-      switch ( context.initial_partitioning.mode ) {
-        case Mode::direct:
-          // The pool initial partitioner consist of several flat bipartitioning
-          // techniques. This case runs as a base case (k = 2) within recursive bipartitioning
-          // or the deep multilevel scheme.
-          pool::bipartition(phg, ip_context); break;
-        // k-way partitions can be computed either by recursive bipartitioning
-        // or deep multilevel partitioning.
-        case Mode::recursive_bipartitioning:
-          recursive_bipartitioning::partition(phg, ip_context); break;
-        case Mode::deep_multilevel:
-          deep_multilevel::partition(phg, ip_context); break;
-        case Mode::UNDEFINED: ERR("Undefined initial partitioning algorithm");
+      size_t skipped_levels = 0;
+      if ( usePortfolioInitialPartitioning(phg, context, uncoarseningData) ) {
+        skipped_levels = portfolioInitialPartitioning(
+          phg, context, ip_context, uncoarseningData, degree_zero_hn_remover);
+      } else {
+        initialPartition(phg, ip_context);
+        degree_zero_hn_remover.restoreDegreeZeroHypernodes(phg);
       }
       enableTimerAndStats(context);
-      degree_zero_hn_remover.restoreDegreeZeroHypernodes(phg);
+      if ( context.initial_partitioning.portfolio_levels > 1 ) {
+        utils::Utilities::instance().getStats(context.utility_id).add_stat(
+          "portfolio_ip_skipped_levels", static_cast<int64_t>(skipped_levels));
+      }
+      if ( phg.hasFixedVertices() ) {
+        assignFixedVertices(phg, context);
+      }
     } else {
       // When performing a V-cycle, we store the block IDs
       // of the input hypergraph as community IDs
@@ -140,16 +501,22 @@ namespace {
       utils::Utilities::instance().getInitialPartitioningStats(
         context.utility_id).printInitialPartitioningStats();
     }
+    // The thread-local data of the initial partitioners is not required any more
+    releasePhaseMemory(context);
     timer.stop_timer("initial_partitioning");
 
     // ################## UNCOARSENING ##################
     io::printLocalSearchBanner(context);
     timer.start_timer("refinement", "Refinement");
+    context.startBudgetPhase(utils::BudgetPhase::refinement);
+    // The refiners allocate their per-thread data structures (e.g., of the FM searches) on construction
+    Context r_context(context);
+    r_context.shared_memory.num_threads = adaptNumberOfThreads(context);
     std::unique_ptr<IUncoarsener> uncoarsener(nullptr);
     if (uncoarseningData.nlevel) {
-      uncoarsener = std::make_unique<NLevelUncoarsener>(hypergraph, context, uncoarseningData);
+      uncoarsener = std::make_unique<NLevelUncoarsener>(hypergraph, r_context, uncoarseningData);
     } else {
-      uncoarsener = std::make_unique<MultilevelUncoarsener>(hypergraph, context, uncoarseningData);
+      uncoarsener = std::make_unique<MultilevelUncoarsener>(hypergraph, r_context, uncoarseningData);
     }
     partitioned_hg = uncoarsener->uncoarsen();
 
@@ -158,48 +525,295 @@ namespace {
 
     return partitioned_hg;
   }
-}
 
-PartitionedHypergraph partition(Hypergraph& hypergraph, const Context& context) {
-  PartitionedHypergraph partitioned_hg = multilevel_partitioning(hypergraph, context, false);
+  PartitionedHypergraph multilevel_partitioning(Hypergraph& hypergraph,
+                                                const Context& context,
+                                                const bool is_vcycle,
+                                                CoarseningHierarchy* hierarchy = nullptr) {
+    const bool nlevel = context.coarsening.algorithm == CoarseningAlgorithm::nlevel_coarsener;
+    UncoarseningData uncoarseningData(nlevel, hypergraph, context);
+    context.reportProgress(utils::ProgressUpdate { utils::ProgressPhase::coarsening });
+    coarsen(hypergraph, context, uncoarseningData, hierarchy);
+    return initialPartitioningAndUncoarsening(hypergraph, context, uncoarseningData, is_vcycle);
+  }
+
+  // ! Localized V-cycle: All vertices with a distance greater than localized_vcycle_distance
+  // ! to a cut net are contracted into one vertex per block before coarsening. Since these
+  // ! vertices are unlikely to move, coarsening, initial partitioning and refinement
+  // ! only work on the band around the cut.
+  PartitionedHypergraph localizedVCycle(Hypergraph& hypergraph,
+                                        const PartitionedHypergraph& partitioned_hg,
+                                        const Context& context) {
+    const HypernodeID num_nodes = hypergraph.initialNumNodes();
+    ds::ThreadSafeFastResetFlagArray<> in_band(num_nodes);
+    ds::ThreadSafeFastResetFlagArray<> visited_net(hypergraph.initialNumEdges());
+    tbb::enumerable_thread_specific<vec<HypernodeID>> ets_frontier;
+    auto visit_net = [&](const HyperedgeID& he) {
+      if ( visited_net.compare_and_set_to_true(he) ) {
+        for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+          if ( in_band.compare_and_set_to_true(pin) ) {
+            ets_frontier.local().push_back(pin);
+          }
+        }
+      }
+    };
+
+    // Pins of cut nets have distance zero. Afterwards, we expand the band
+    // level by level, but do not traverse nets above the ignore threshold.
+    hypergraph.doParallelForAllEdges([&](const HyperedgeID& he) {
+      if ( partitioned_hg.connectivity(he) > 1 ) {
+        visit_net(he);
+      }
+    });
+    for ( size_t distance = 0; distance < context.partition.localized_vcycle_distance; ++distance ) {
+      vec<HypernodeID> frontier;
+      for ( vec<HypernodeID>& local_frontier : ets_frontier ) {
+        frontier.insert(frontier.end(), local_frontier.begin(), local_frontier.end());
+        local_frontier.clear();
+      }
+      if ( frontier.empty() ) {
+        break;
+      }
+      tbb::parallel_for(UL(0), frontier.size(), [&](const size_t i) {
+        for ( const HyperedgeID& he : hypergraph.incidentEdges(frontier[i]) ) {
+          if ( hypergraph.edgeSize(he) <= context.partition.ignore_hyperedge_size_threshold ) {
+            visit_net(he);
+          }
+        }
+      });
+    }
+
+    // The vertex with smallest ID outside of the band represents the interior of its block
+    vec<HypernodeID> representative(partitioned_hg.k(), kInvalidHypernode);
+    hypergraph.doParallelForAllNodes([&](const HypernodeID& hn) {
+      if ( !in_band[hn] ) {
+        HypernodeID* rep = &representative[partitioned_hg.partID(hn)];
+        HypernodeID current = __atomic_load_n(rep, __ATOMIC_RELAXED);
+        while ( hn < current && !__atomic_compare_exchange_n(
+          rep, &current, hn, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED) ) { }
+      }
+    });
+    parallel::scalable_vector<HypernodeID> communities(num_nodes);
+    tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID& hn) {
+      communities[hn] = hn;
+    });
+    hypergraph.doParallelForAllNodes([&](const HypernodeID& hn) {
+      if ( !in_band[hn] ) {
+        communities[hn] = representative[partitioned_hg.partID(hn)];
+      }
+    });
+
+    // The contracted hypergraph inherits the block IDs stored as community IDs
+    Hypergraph band_hypergraph = hypergraph.contract(
+      communities, context.coarsening.low_memory_contraction);
+    PartitionedHypergraph band_phg = multilevel_partitioning(
+      band_hypergraph, context, true /* V-cycle flag */);
 
-  // ################## V-CYCLES ##################
-  if ( context.partition.num_vcycles > 0 && context.type == ContextType::main ) {
-    partitionVCycle(hypergraph, partitioned_hg, context);
+    PartitionedHypergraph improved_phg(partitioned_hg.k(), hypergraph, parallel_tag_t());
+    hypergraph.doParallelForAllNodes([&](const HypernodeID& hn) {
+      improved_phg.setOnlyNodePart(hn, band_phg.partID(communities[hn]));
+    });
+    improved_phg.initializePartition();
+    return improved_phg;
   }
 
-  return partitioned_hg;
-}
+  void performVCycles(Hypergraph& hypergraph,
+                      PartitionedHypergraph& partitioned_hg,
+                      const Context& context,
+                      const size_t num_completed_vcycles,
+                      const std::function<void(const PartitionedHypergraph&, const size_t)>& on_vcycle) {
+    for ( size_t i = num_completed_vcycles; i < context.partition.num_vcycles; ++i ) {
+      if ( context.isCancelled() ) {
+        break;
+      }
 
-void partitionVCycle(Hypergraph& hypergraph,
-                     PartitionedHypergraph& partitioned_hg,
-                     const Context& context) {
-  ASSERT(context.partition.num_vcycles > 0);
+      // Reset memory pool
+      hypergraph.reset();
+      parallel::MemoryPool::instance().reset();
+      parallel::MemoryPool::instance().release_mem_group("Preprocessing");
 
-  for ( size_t i = 0; i < context.partition.num_vcycles; ++i ) {
-    // Reset memory pool
-    hypergraph.reset();
-    parallel::MemoryPool::instance().reset();
-    parallel::MemoryPool::instance().release_mem_group("Preprocessing");
+      if ( context.partition.paradigm == Paradigm::nlevel ) {
+        // Workaround: reset() function of hypergraph reinserts all removed hyperedges again.
+        LargeHyperedgeRemover large_he_remover(context);
+        large_he_remover.removeLargeHyperedgesInNLevelVCycle(hypergraph);
+      }
+
+      // The block IDs of the current partition are stored as community IDs.
+      // This way coarsening does not contract nodes that do not belong to same block
+      // of the input partition. For initial partitioning, we use the community IDs of
+      // smallest hypergraph as initial partition.
+      hypergraph.doParallelForAllNodes([&](const HypernodeID& hn) {
+        hypergraph.setCommunityID(hn, partitioned_hg.partID(hn));
+      });
 
-    if ( context.partition.paradigm == Paradigm::nlevel ) {
-      // Workaround: reset() function of hypergraph reinserts all removed hyperedges again.
-      LargeHyperedgeRemover large_he_remover(context);
-      large_he_remover.removeLargeHyperedgesInNLevelVCycle(hypergraph);
+      // Perform V-cycle
+      if ( context.reportsProgress() ) {
+        utils::ProgressUpdate update;
+        update.phase = utils::ProgressPhase::vcycle;
+        update.vcycle = i + 1;
+        update.objective = metrics::objective(partitioned_hg, context.partition.objective);
+        update.imbalance = metrics::imbalance(partitioned_hg, context);
+        context.reportProgress(update);
+      }
+      io::printVCycleBanner(context, i + 1);
+      if ( context.partition.localized_vcycles &&
+           context.partition.paradigm == Paradigm::multilevel ) {
+        partitioned_hg = localizedVCycle(hypergraph, partitioned_hg, context);
+      } else {
+        partitioned_hg = multilevel_partitioning(hypergraph, context, true /* V-cycle flag */ );
+      }
+      if ( on_vcycle ) {
+        on_vcycle(partitioned_hg, i + 1);
+      }
+    }
+  }
+
+  // ! In anytime mode, the first partition is computed with a single initial
+  // ! partitioning run and label propagation refinement only
+  Context anytimeContext(const Context& context) {
+    Context anytime_context(context);
+    anytime_context.initial_partitioning.runs = 1;
+    anytime_context.initial_partitioning.use_adaptive_ip_runs = false;
+    for ( RefinementParameters* refinement : { &anytime_context.refinement,
+                                               &anytime_context.initial_partitioning.refinement } ) {
+      refinement->fm.algorithm = FMAlgorithm::do_nothing;
+      refinement->flows.algorithm = FlowAlgorithm::do_nothing;
+      refinement->global_fm.use_global_fm = false;
     }
+    return anytime_context;
+  }
 
-    // The block IDs of the current partition are stored as community IDs.
-    // This way coarsening does not contract nodes that do not belong to same block
-    // of the input partition. For initial partitioning, we use the community IDs of
-    // smallest hypergraph as initial partition.
+  PartitionedHypergraph restorePartition(Hypergraph& hypergraph,
+                                         const Context& context,
+                                         const io::PartitionCheckpoint& checkpoint) {
+    PartitionedHypergraph partitioned_hg(context.partition.k, hypergraph, parallel_tag_t());
     hypergraph.doParallelForAllNodes([&](const HypernodeID& hn) {
-      hypergraph.setCommunityID(hn, partitioned_hg.partID(hn));
+      partitioned_hg.setOnlyNodePart(hn, checkpoint.partition[hn]);
     });
+    partitioned_hg.initializePartition();
+    std::istringstream random_state(checkpoint.random_state);
+    if ( !utils::Randomize::instance().deserializeState(random_state) ) {
+      WARNING("Could not restore the random number generators from the checkpoint"
+        << "(the results of the remaining V-cycles are not reproducible)");
+    }
+    return partitioned_hg;
+  }
+
+  PartitionedHypergraph partitionImpl(Hypergraph& hypergraph,
+                                      const Context& context,
+                                      const PartitionCallback& on_improved_partition,
+                                      CoarseningHierarchy* hierarchy) {
+    const bool is_main = context.type == ContextType::main;
+    const bool perform_vcycles = context.partition.num_vcycles > 0 && is_main;
 
-    // Perform V-cycle
-    io::printVCycleBanner(context, i + 1);
-    partitioned_hg = multilevel_partitioning(hypergraph, context, true /* V-cycle flag */ );
+    // Balanced partitions are preferred over imbalanced ones. Otherwise,
+    // a partition is only published if it improves the objective.
+    bool is_published = false;
+    bool is_best_balanced = false;
+    HyperedgeWeight best_objective = std::numeric_limits<HyperedgeWeight>::max();
+    auto publish = [&](const PartitionedHypergraph& phg) {
+      if ( on_improved_partition ) {
+        const bool is_balanced = metrics::isBalanced(phg, context);
+        const HyperedgeWeight objective = metrics::objective(phg, context.partition.objective);
+        if ( !is_published || ( is_balanced && !is_best_balanced ) ||
+             ( is_balanced == is_best_balanced && objective < best_objective ) ) {
+          is_published = true;
+          is_best_balanced = is_balanced;
+          best_objective = objective;
+          on_improved_partition(phg);
+        }
+      }
+    };
+
+    PartitionedHypergraph partitioned_hg;
+    size_t num_completed_vcycles = 0;
+    bool is_restored = false;
+    std::unique_ptr<io::PartitionCheckpointWriter> checkpoint_writer;
+    if ( perform_vcycles && !context.partition.checkpoint_file.empty() ) {
+      // Resume from the last checkpoint, if it exists
+      io::PartitionCheckpoint checkpoint;
+      checkpoint_writer = std::make_unique<io::PartitionCheckpointWriter>(
+        context.partition.checkpoint_file, hypergraph, context);
+      if ( io::readPartitionCheckpoint(context.partition.checkpoint_file, hypergraph, context, checkpoint) ) {
+        if ( context.partition.verbose_output ) {
+          LOG << "Resume from checkpoint" << context.partition.checkpoint_file
+              << "after" << checkpoint.num_completed_vcycles << "V-cycles";
+        }
+        partitioned_hg = restorePartition(hypergraph, context, checkpoint);
+        num_completed_vcycles = checkpoint.num_completed_vcycles;
+        is_restored = true;
+        if ( hierarchy ) {
+          hierarchy->clear();
+        }
+      }
+    }
+
+    if ( !is_restored ) {
+      if ( context.partition.anytime && is_main && context.partition.mode == Mode::direct ) {
+        // The first partition is computed as fast as possible and then
+        // improved with the configured refiners in the V-cycles
+        partitioned_hg = multilevel_partitioning(hypergraph, anytimeContext(context), false, hierarchy);
+      } else {
+        partitioned_hg = multilevel_partitioning(hypergraph, context, false, hierarchy);
+      }
+      if ( checkpoint_writer ) {
+        checkpoint_writer->writeAsync(partitioned_hg, 0);
+      }
+    }
+    publish(partitioned_hg);
+
+    // ################## V-CYCLES ##################
+    if ( perform_vcycles ) {
+      performVCycles(hypergraph, partitioned_hg, context, num_completed_vcycles,
+        [&](const PartitionedHypergraph& phg, const size_t num_vcycles) {
+          if ( checkpoint_writer ) {
+            checkpoint_writer->writeAsync(phg, num_vcycles);
+          }
+          publish(phg);
+        });
+    }
+
+    return partitioned_hg;
+  }
+}
+
+PartitionedHypergraph partition(Hypergraph& hypergraph,
+                                const Context& context,
+                                const PartitionCallback& on_improved_partition) {
+  return partitionImpl(hypergraph, context, on_improved_partition, nullptr);
+}
+
+PartitionedHypergraph partitionWithHierarchy(Hypergraph& hypergraph,
+                                             const Context& context,
+                                             CoarseningHierarchy& hierarchy) {
+  return partitionImpl(hypergraph, context, nullptr, &hierarchy);
+}
+
+void partitionMultipleTargets(Hypergraph& hypergraph,
+                              const Context& coarsening_context,
+                              const vec<Context>& target_contexts,
+                              const std::function<void(PartitionedHypergraph&, const size_t)>& on_partition) {
+  ASSERT(coarsening_context.coarsening.algorithm != CoarseningAlgorithm::nlevel_coarsener);
+  UncoarseningData uncoarseningData(false, hypergraph, coarsening_context);
+  coarsen(hypergraph, coarsening_context, uncoarseningData);
+
+  // The levels of the hierarchy are only read during initial partitioning and
+  // uncoarsening. Thus, we can reuse them for each target.
+  for ( size_t i = 0; i < target_contexts.size(); ++i ) {
+    const Context& context = target_contexts[i];
+    ASSERT(context.partition.k <= coarsening_context.partition.k);
+    uncoarseningData.resetPartitionedHypergraph(context.partition.k);
+    PartitionedHypergraph partitioned_hg = initialPartitioningAndUncoarsening(
+      hypergraph, context, uncoarseningData, false);
+    on_partition(partitioned_hg, i);
   }
 }
 
+void partitionVCycle(Hypergraph& hypergraph,
+                     PartitionedHypergraph& partitioned_hg,
+                     const Context& context) {
+  ASSERT(context.partition.num_vcycles > 0);
+  performVCycles(hypergraph, partitioned_hg, context, 0, nullptr);
+}
+
 }
@@ -27,13 +27,42 @@
 
 #pragma once
 
+#include <functional>
+
 #include "mt-kahypar/definitions.h"
 #include "mt-kahypar/partition/context.h"
 
 namespace mt_kahypar::multilevel {
 
-// ! Partitions a hypergraph using the multilevel paradigm.
-PartitionedHypergraph partition(Hypergraph& hypergraph, const Context& context);
+using PartitionCallback = std::function<void(const PartitionedHypergraph&)>;
+
+// ! Partitions a hypergraph using the multilevel paradigm. If a callback is passed,
+// ! it is called with the first partition and each improved partition of the V-cycles.
+PartitionedHypergraph partition(Hypergraph& hypergraph,
+                                const Context& context,
+                                const PartitionCallback& on_improved_partition = nullptr);
+
+// ! Nodes of the coarse hypergraphs of a multilevel hierarchy: hierarchy[i][u] is the node
+// ! of the (i + 1)-th coarse hypergraph that contains node u of the input hypergraph
+using CoarseningHierarchy = vec<vec<HypernodeID>>;
+
+// ! Same as partition(...), but the first levels of the multilevel hierarchy are contracted
+// ! according to the given hierarchy (if not empty) before the coarsener takes over.
+// ! Afterwards, the hierarchy contains the coarse nodes of all levels used for partitioning
+// ! (empty for the n-level coarsener or if the hypergraph contains fixed vertices).
+PartitionedHypergraph partitionWithHierarchy(Hypergraph& hypergraph,
+                                             const Context& context,
+                                             CoarseningHierarchy& hierarchy);
+
+// ! Coarsens the hypergraph only once and computes a partition for each target context
+// ! (e.g., for different values of k and epsilon) based on the same multilevel hierarchy.
+// ! The coarsening context must use the largest k and smallest epsilon of all targets,
+// ! since the resulting hierarchy then respects the maximum allowed node weight of each
+// ! target. The partition of the i-th target is passed to on_partition(phg, i).
+void partitionMultipleTargets(Hypergraph& hypergraph,
+                              const Context& coarsening_context,
+                              const vec<Context>& target_contexts,
+                              const std::function<void(PartitionedHypergraph&, const size_t)>& on_partition);
 
 // ! Improves an existing partition using the iterated multilevel cycle technique
 // ! (also called V-cycle).
@@ -0,0 +1,237 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "mt-kahypar/partition/multisection.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/memory_pool.h"
+#include "mt-kahypar/parallel/phase_concurrency.h"
+#include "mt-kahypar/partition/factories.h"
+#include "mt-kahypar/partition/metrics.h"
+#include "mt-kahypar/partition/multilevel.h"
+#include "mt-kahypar/partition/refinement/i_refiner.h"
+#include "mt-kahypar/partition/refinement/rebalancing/rebalancer.h"
+#include "mt-kahypar/utils/timer.h"
+#include "mt-kahypar/utils/utilities.h"
+
+namespace mt_kahypar {
+namespace multisection {
+
+namespace {
+
+static constexpr bool debug = false;
+
+PartitionID numTopLevelBlocks(const Context& context) {
+  const PartitionID k = context.partition.k;
+  const PartitionID k1 = context.partition.multisection_k1 > 0 ? context.partition.multisection_k1 :
+    static_cast<PartitionID>(std::round(std::sqrt(static_cast<double>(k))));
+  return std::max(std::min(k1, k), 2);
+}
+
+// ! Top-level block i is partitioned into the blocks [firstBlock(i), firstBlock(i + 1))
+PartitionID firstBlock(const PartitionID i, const PartitionID k, const PartitionID k1) {
+  return i * (k / k1) + std::min(i, k % k1);
+}
+
+// ! The perfect weight of a top-level block is the sum of the perfect weights of its final
+// ! blocks. The imbalance is split such that (1 + eps_top)^2 = 1 + eps, i.e., the second
+// ! level can still compensate the imbalance of the first level.
+Context setupTopLevelContext(const Hypergraph& hypergraph, const Context& context, const PartitionID k1) {
+  Context t_context(context);
+  const PartitionID k = context.partition.k;
+  t_context.partition.k = k1;
+  t_context.partition.verbose_output = false;
+  t_context.partition.num_vcycles = 0;
+
+  HypernodeWeight perfect_weight_sum = 0;
+  HypernodeWeight max_weight_sum = 0;
+  for ( PartitionID block = 0; block < k; ++block ) {
+    perfect_weight_sum += context.partition.perfect_balance_part_weights[block];
+    max_weight_sum += context.partition.max_part_weights[block];
+  }
+  const double base = max_weight_sum / static_cast<double>(std::max(perfect_weight_sum, 1));
+  t_context.partition.epsilon = std::min(0.99, std::max(std::sqrt(base) - 1.0, 0.0));
+
+  t_context.partition.perfect_balance_part_weights.assign(k1, 0);
+  t_context.partition.max_part_weights.assign(k1, 0);
+  for ( PartitionID i = 0; i < k1; ++i ) {
+    for ( PartitionID block = firstBlock(i, k, k1); block < firstBlock(i + 1, k, k1); ++block ) {
+      t_context.partition.perfect_balance_part_weights[i] += context.partition.perfect_balance_part_weights[block];
+    }
+    t_context.partition.max_part_weights[i] = std::round((1 + t_context.partition.epsilon) *
+      t_context.partition.perfect_balance_part_weights[i]);
+  }
+  t_context.setupContractionLimit(hypergraph.totalWeight());
+  t_context.setupThreadsPerFlowSearch();
+  return t_context;
+}
+
+// ! The subproblem of a top-level block uses the weights of its final blocks
+Context setupSubproblemContext(const Hypergraph& sub_hypergraph,
+                               const Context& context,
+                               const PartitionID k0,
+                               const PartitionID k1) {
+  Context s_context(context);
+  s_context.partition.k = k1 - k0;
+  s_context.partition.verbose_output = false;
+  s_context.partition.num_vcycles = 0;
+
+  s_context.partition.perfect_balance_part_weights.assign(s_context.partition.k, 0);
+  s_context.partition.max_part_weights.assign(s_context.partition.k, 0);
+  for ( PartitionID block = k0; block < k1; ++block ) {
+    s_context.partition.perfect_balance_part_weights[block - k0] =
+      context.partition.perfect_balance_part_weights[block];
+    s_context.partition.max_part_weights[block - k0] =
+      context.partition.max_part_weights[block];
+  }
+  s_context.setupContractionLimit(sub_hypergraph.totalWeight());
+  s_context.setupThreadsPerFlowSearch();
+  return s_context;
+}
+
+// ! Flat k-way refinement of the combined partition. For large k, the gain cache of
+// ! FM automatically switches to its sparse representation.
+void refine(PartitionedHypergraph& phg, const Context& context) {
+  Hypergraph& hypergraph = phg.hypergraph();
+  Metrics current_metrics = { metrics::km1(phg), metrics::hyperedgeCut(phg),
+                              metrics::imbalance(phg, context) };
+  parallel::scalable_vector<HypernodeID> dummy;
+  std::unique_ptr<IRefiner> label_propagation = LabelPropagationFactory::getInstance().createObject(
+    context.refinement.label_propagation.algorithm, hypergraph, context);
+  std::unique_ptr<IRefiner> fm = FMFactory::getInstance().createObject(
+    context.refinement.fm.algorithm, hypergraph, context);
+
+  utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
+  timer.start_timer("label_propagation", "Label Propagation");
+  label_propagation->initialize(phg);
+  label_propagation->refine(phg, dummy, current_metrics, std::numeric_limits<double>::max());
+  timer.stop_timer("label_propagation");
+
+  timer.start_timer("fm", "FM");
+  fm->initialize(phg);
+  parallel::executeWithConcurrencyLimit(context.shared_memory.fm_num_threads, [&] {
+    return fm->refine(phg, dummy, current_metrics, std::numeric_limits<double>::max());
+  });
+  timer.stop_timer("fm");
+
+  if ( !metrics::isBalanced(phg, context) && !context.partition.deterministic ) {
+    timer.start_timer("rebalance", "Rebalance");
+    if ( context.partition.objective == Objective::km1 ) {
+      Km1Rebalancer rebalancer(phg, context);
+      rebalancer.rebalance(current_metrics);
+    } else if ( context.partition.objective == Objective::cut ) {
+      CutRebalancer rebalancer(phg, context);
+      rebalancer.rebalance(current_metrics);
+    }
+    timer.stop_timer("rebalance");
+  }
+}
+
+} // namespace
+
+PartitionedHypergraph partition(Hypergraph& hypergraph, const Context& context) {
+  PartitionedHypergraph partitioned_hypergraph(
+    context.partition.k, hypergraph, parallel_tag_t());
+  partition(partitioned_hypergraph, context);
+  return partitioned_hypergraph;
+}
+
+void partition(PartitionedHypergraph& phg, const Context& context) {
+  if ( phg.hasFixedVertices() ) {
+    ERR("Multisection partitioning does not support fixed vertices");
+  }
+  utils::Utilities& utils = utils::Utilities::instance();
+  utils::Timer& timer = utils.getTimer(context.utility_id);
+  timer.start_timer("multisection", "Multisection");
+
+  Hypergraph& hypergraph = phg.hypergraph();
+  const PartitionID k = context.partition.k;
+  const PartitionID k1 = numTopLevelBlocks(context);
+  if ( context.type == ContextType::main ) {
+    parallel::MemoryPool::instance().deactivate_unused_memory_allocations();
+    utils.getTimer(context.utility_id).disable();
+    utils.getStats(context.utility_id).disable();
+  }
+
+  // Partition the hypergraph into k1 blocks
+  const Context top_level_context = setupTopLevelContext(hypergraph, context, k1);
+  PartitionedHypergraph top_level_phg = multilevel::partition(hypergraph, top_level_context);
+  DBG << "Multisection top-level partition -" << V(k1)
+      << "Objective =" << metrics::objective(top_level_phg, context.partition.objective)
+      << "Imbalance =" << metrics::imbalance(top_level_phg, top_level_context);
+
+  // Partition each top-level block into its final blocks. The subproblems are solved one
+  // after another (each of them in parallel), such that only the data structures of one
+  // subproblem exist at the same time.
+  const bool cut_net_splitting = context.partition.objective == Objective::km1;
+  for ( PartitionID i = 0; i < k1; ++i ) {
+    const PartitionID first_block = firstBlock(i, k, k1);
+    const PartitionID last_block = firstBlock(i + 1, k, k1);
+    if ( last_block - first_block == 1 ) {
+      top_level_phg.doParallelForAllNodes([&](const HypernodeID& hn) {
+        if ( top_level_phg.partID(hn) == i ) {
+          phg.setOnlyNodePart(hn, first_block);
+        }
+      });
+      continue;
+    }
+
+    auto extracted_hypergraph = top_level_phg.extract(i, cut_net_splitting,
+      context.preprocessing.stable_construction_of_incident_edges);
+    Hypergraph& sub_hypergraph = extracted_hypergraph.first;
+    const auto& mapping = extracted_hypergraph.second;
+    if ( sub_hypergraph.initialNumNodes() > 0 ) {
+      const Context sub_context = setupSubproblemContext(sub_hypergraph, context, first_block, last_block);
+      PartitionedHypergraph sub_phg = multilevel::partition(sub_hypergraph, sub_context);
+      top_level_phg.doParallelForAllNodes([&](const HypernodeID& hn) {
+        if ( top_level_phg.partID(hn) == i ) {
+          ASSERT(hn < mapping.size());
+          phg.setOnlyNodePart(hn, first_block + sub_phg.partID(mapping[hn]));
+        }
+      });
+    }
+  }
+  phg.initializePartition();
+
+  if ( context.type == ContextType::main ) {
+    parallel::MemoryPool::instance().activate_unused_memory_allocations();
+    utils.getTimer(context.utility_id).enable();
+    utils.getStats(context.utility_id).enable();
+  }
+
+  refine(phg, context);
+  DBG << "Multisection k-way partition -" << V(k) << V(k1)
+      << "Objective =" << metrics::objective(phg, context.partition.objective)
+      << "Imbalance =" << metrics::imbalance(phg, context);
+  timer.stop_timer("multisection");
+}
+
+}  // namespace multisection
+}  // namespace mt_kahypar
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "mt-kahypar/partition/partition_cache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
+
+#include "mt-kahypar/io/hypergraph_io.h"
+#include "mt-kahypar/utils/hash.h"
+#include "mt-kahypar/utils/hypergraph_statistics.h"
+
+namespace mt_kahypar {
+
+uint64_t PartitionCache::key(const Hypergraph& hypergraph, const Context& context) {
+  using namespace hashing::integer;
+  uint64_t fixed_vertex_hash_sum = 0;
+  if ( hypergraph.hasFixedVertices() ) {
+    fixed_vertex_hash_sum = tbb::parallel_reduce(tbb::blocked_range<HypernodeID>(
+      ID(0), hypergraph.initialNumNodes()), UL(0), [&](const tbb::blocked_range<HypernodeID>& range, uint64_t sum) {
+      for ( HypernodeID hn = range.begin(); hn < range.end(); ++hn ) {
+        if ( hypergraph.isFixed(hn) ) {
+          sum += hash64(combine64(hash64(hn), hash64(hypergraph.fixedVertexBlock(hn))));
+        }
+      }
+      return sum;
+    }, std::plus<uint64_t>());
+  }
+
+  // The algorithm parameters are hashed via their textual representation,
+  // which covers presets as well as individually modified parameters
+  const PartitioningParameters& params = context.partition;
+  std::stringstream config;
+  config << params.objective << " " << params.mode << " " << params.paradigm << " "
+         << params.preset_type << " " << params.k << " " << params.epsilon << " "
+         << params.seed << " " << params.num_vcycles << " " << params.anytime << " "
+         << params.time_limit << " " << params.deterministic << " "
+         << params.use_individual_part_weights << " ";
+  if ( params.use_individual_part_weights ) {
+    for ( const HypernodeWeight& weight : params.max_part_weights ) {
+      config << weight << " ";
+    }
+  }
+  config << context.preprocessing << context.coarsening
+         << context.initial_partitioning << context.refinement;
+  const std::string config_str = config.str();
+
+  uint64_t key = combine64(utils::hypergraphFingerprint(hypergraph), hash64(fixed_vertex_hash_sum));
+  for ( size_t i = 0; i < config_str.size(); i += sizeof(uint64_t) ) {
+    uint64_t word = 0;
+    std::memcpy(&word, config_str.data() + i, std::min(sizeof(uint64_t), config_str.size() - i));
+    key = combine64(key, hash64(word));
+  }
+  return key;
+}
+
+bool PartitionCache::lookup(const uint64_t key,
+                            const Context& context,
+                            const HypernodeID num_nodes,
+                            vec<PartitionID>& partition) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _index.find(key);
+    if ( it != _index.end() && it->second->second.size() == num_nodes ) {
+      // Mark entry as most recently used
+      _entries.splice(_entries.begin(), _entries, it->second);
+      partition = it->second->second;
+      return true;
+    }
+  }
+
+  if ( !context.partition.result_cache_directory.empty() ) {
+    const std::string file = filename(context, key);
+    if ( std::ifstream(file).good() ) {
+      std::vector<PartitionID> cached_partition;
+      io::readPartitionFile(file, cached_partition);
+      if ( cached_partition.size() == num_nodes ) {
+        partition.assign(cached_partition.begin(), cached_partition.end());
+        if ( context.partition.result_cache_size > 0 ) {
+          std::lock_guard<std::mutex> lock(_mutex);
+          insertIntoMemory(key, context.partition.result_cache_size, vec<PartitionID>(partition));
+        }
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void PartitionCache::insert(const uint64_t key,
+                            const Context& context,
+                            const PartitionedHypergraph& partitioned_hg) {
+  if ( context.isCancelled() ) {
+    // A cancelled run does not return the partition of a complete run
+    return;
+  }
+
+  if ( context.partition.result_cache_size > 0 ) {
+    vec<PartitionID> partition(partitioned_hg.initialNumNodes());
+    tbb::parallel_for(ID(0), partitioned_hg.initialNumNodes(), [&](const HypernodeID& hn) {
+      partition[hn] = partitioned_hg.partID(hn);
+    });
+    std::lock_guard<std::mutex> lock(_mutex);
+    insertIntoMemory(key, context.partition.result_cache_size, std::move(partition));
+  }
+
+  if ( !context.partition.result_cache_directory.empty() ) {
+    // Concurrent calls with the same key must never read a partially written
+    // file. Therefore, we write to a temporary file and rename it afterwards.
+    const std::string file = filename(context, key);
+    std::stringstream tmp_file;
+    tmp_file << file << "." << std::hex << reinterpret_cast<uintptr_t>(&partitioned_hg) << ".tmp";
+    io::writePartitionFile(partitioned_hg, tmp_file.str(), true);
+    if ( std::rename(tmp_file.str().c_str(), file.c_str()) != 0 ) {
+      std::remove(tmp_file.str().c_str());
+    }
+  }
+}
+
+std::string PartitionCache::filename(const Context& context, const uint64_t key) {
+  std::stringstream filename;
+  filename << context.partition.result_cache_directory << "/"
+           << std::hex << key << ".partition";
+  return filename.str();
+}
+
+void PartitionCache::insertIntoMemory(const uint64_t key,
+                                      const size_t capacity,
+                                      vec<PartitionID>&& partition) {
+  auto it = _index.find(key);
+  if ( it != _index.end() ) {
+    _entries.erase(it->second);
+    _index.erase(it);
+  }
+  _entries.emplace_front(key, std::move(partition));
+  _index[key] = _entries.begin();
+  while ( _entries.size() > capacity ) {
+    _index.erase(_entries.back().first);
+    _entries.pop_back();
+  }
+}
+
+}  // namespace mt_kahypar
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+
+namespace mt_kahypar {
+
+/*!
+ * Content-addressed cache for partitions computed by the library. The key combines a
+ * parallel hash of the input (see utils::hypergraphFingerprint(...)) with the fixed
+ * vertices and all context parameters that influence the result (k, epsilon, objective,
+ * seed, preset and algorithm parameters). Partitions are kept in a bounded in-memory
+ * LRU cache (see PartitioningParameters::result_cache_size) and optionally in the
+ * binary partition format in a directory (see PartitioningParameters::result_cache_directory).
+ *
+ * Note that the number of threads is not part of the key. Thus, a non-deterministic
+ * configuration returns the partition of the first call for all later calls.
+ */
+class PartitionCache {
+
+  using Entry = std::pair<uint64_t, vec<PartitionID>>;
+
+ public:
+  static PartitionCache& instance() {
+    static PartitionCache instance;
+    return instance;
+  }
+
+  PartitionCache(const PartitionCache&) = delete;
+  PartitionCache(PartitionCache&&) = delete;
+  PartitionCache & operator= (const PartitionCache &) = delete;
+  PartitionCache & operator= (PartitionCache &&) = delete;
+
+  static bool isEnabled(const Context& context) {
+    return context.partition.result_cache_size > 0 ||
+      !context.partition.result_cache_directory.empty();
+  }
+
+  // ! Must be computed before partitioning, since the partitioner modifies the context
+  static uint64_t key(const Hypergraph& hypergraph, const Context& context);
+
+  // ! Returns true and stores the cached partition in the given vector, if
+  // ! the in-memory cache or the cache directory contains the key
+  bool lookup(const uint64_t key,
+              const Context& context,
+              const HypernodeID num_nodes,
+              vec<PartitionID>& partition);
+
+  void insert(const uint64_t key,
+              const Context& context,
+              const PartitionedHypergraph& partitioned_hg);
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+  }
+
+  // ! Removes all partitions from the in-memory cache
+  void clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _index.clear();
+  }
+
+ private:
+  PartitionCache() :
+    _mutex(),
+    _entries(),
+    _index() { }
+
+  static std::string filename(const Context& context, const uint64_t key);
+
+  // ! Inserts the partition as most recently used entry and evicts
+  // ! the least recently used entries exceeding the capacity
+  void insertIntoMemory(const uint64_t key, const size_t capacity, vec<PartitionID>&& partition);
+
+  mutable std::mutex _mutex;
+  // ! Most recently used entry first
+  std::list<Entry> _entries;
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> _index;
+};
+
+}  // namespace mt_kahypar
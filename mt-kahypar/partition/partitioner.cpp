@@ -27,13 +27,30 @@
 
 #include "partitioner.h"
 
+#include <cmath>
+#include <cstring>
+#include <sstream>
+
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_invoke.h"
+#include "tbb/parallel_reduce.h"
+#include "tbb/parallel_sort.h"
+#include "tbb/task_arena.h"
+
+#include "mt-kahypar/io/hypergraph_io.h"
 #include "mt-kahypar/io/partitioning_output.h"
+#include "mt-kahypar/partition/metrics.h"
 #include "mt-kahypar/partition/multilevel.h"
 #include "mt-kahypar/partition/preprocessing/sparsification/degree_zero_hn_remover.h"
 #include "mt-kahypar/partition/preprocessing/sparsification/large_he_remover.h"
+#include "mt-kahypar/partition/preprocessing/sparsification/twin_vertex_remover.h"
 #include "mt-kahypar/partition/preprocessing/community_detection/parallel_louvain.h"
+#include "mt-kahypar/partition/preprocessing/locality_reordering.h"
 #include "mt-kahypar/partition/recursive_bipartitioning.h"
 #include "mt-kahypar/partition/deep_multilevel.h"
+#include "mt-kahypar/partition/streaming.h"
+#include "mt-kahypar/partition/multisection.h"
+#include "mt-kahypar/utils/hash.h"
 #include "mt-kahypar/utils/hypergraph_statistics.h"
 #include "mt-kahypar/utils/stats.h"
 #include "mt-kahypar/utils/timer.h"
@@ -41,6 +58,26 @@
 
 namespace mt_kahypar {
 
+  // ! Predicts the relative costs of the phases from the size of the input and the
+  // ! enabled algorithms. Coarsening and refinement scale with the number of pins,
+  // ! while initial partitioning scales with the size of the coarsest hypergraph.
+  utils::TimeBudget::PhaseCosts predictPhaseCosts(const Hypergraph& hypergraph, const Context& context) {
+    const double num_pins = hypergraph.initialNumPins();
+    const double coarsest_size = static_cast<double>(context.partition.k) *
+      std::min(context.coarsening.contraction_limit_multiplier, hypergraph.initialNumNodes());
+    const bool use_fm = context.refinement.fm.algorithm != FMAlgorithm::do_nothing;
+    const bool use_flows = context.refinement.flows.algorithm != FlowAlgorithm::do_nothing;
+    utils::TimeBudget::PhaseCosts costs;
+    costs[static_cast<size_t>(utils::BudgetPhase::preprocessing)] =
+      ( context.preprocessing.use_community_detection ? 1.0 : 0.1 ) * num_pins;
+    costs[static_cast<size_t>(utils::BudgetPhase::coarsening)] = num_pins;
+    costs[static_cast<size_t>(utils::BudgetPhase::initial_partitioning)] =
+      10.0 * std::log2(std::max(context.partition.k, 2)) * coarsest_size;
+    costs[static_cast<size_t>(utils::BudgetPhase::refinement)] =
+      ( 0.5 + ( use_fm ? 1.0 : 0.0 ) + ( use_flows ? 2.0 : 0.0 ) ) * num_pins;
+    return costs;
+  }
+
   void setupContext(Hypergraph& hypergraph, Context& context) {
     context.partition.large_hyperedge_size_threshold = std::max(hypergraph.initialNumNodes() *
                                                                 context.partition.large_hyperedge_size_threshold_factor, 100.0);
@@ -49,6 +86,40 @@ namespace mt_kahypar {
     context.setupContractionLimit(hypergraph.totalWeight());
     context.setupThreadsPerFlowSearch();
 
+    if ( hypergraph.hasFixedVertices() ) {
+      if ( context.partition.mode != Mode::direct || context.partition.deterministic ) {
+        ERR("Fixed vertices are only supported in the (non-deterministic) direct k-way mode");
+      }
+      for ( const HypernodeID& hn : hypergraph.nodes() ) {
+        if ( hypergraph.fixedVertexBlock(hn) >= context.partition.k ) {
+          ERR("Vertex" << hn << "is fixed to block" << hypergraph.fixedVertexBlock(hn)
+            << ", but k =" << context.partition.k);
+        }
+      }
+    }
+
+    if ( context.partition.anytime && context.partition.num_vcycles == 0 ) {
+      // The first partition of the anytime mode is improved in the V-cycles
+      context.partition.num_vcycles = 1;
+    }
+
+    if ( context.partition.time_limit > 0 ) {
+      if ( !context.cancellation_token ) {
+        context.cancellation_token = std::make_shared<utils::CancellationToken>();
+      }
+      context.cancellation_token->setTimeLimit(context.partition.time_limit);
+      context.time_budget = std::make_shared<utils::TimeBudget>(
+        context.partition.time_limit, predictPhaseCosts(hypergraph, context));
+    }
+
+    if ( context.progress_reporter ) {
+      // The progress callback can request to stop the run
+      if ( !context.cancellation_token ) {
+        context.cancellation_token = std::make_shared<utils::CancellationToken>();
+      }
+      context.progress_reporter->start();
+    }
+
     // Setup enabled IP algorithms
     if ( context.initial_partitioning.enabled_ip_algos.size() > 0 &&
          context.initial_partitioning.enabled_ip_algos.size() <
@@ -80,19 +151,102 @@ namespace mt_kahypar {
     }
   }
 
+  // ! Structural properties of the input hypergraph required by the preprocessing steps
+  struct InputStatistics {
+    bool is_graph = false;
+    bool is_mesh_graph = false;
+    // ! Candidates for the degree-zero vertex and large hyperedge removal
+    // ! (in increasing order of their IDs)
+    vec<HypernodeID> degree_zero_hypernodes;
+    vec<HyperedgeID> large_hyperedges;
+  };
+
+  template<typename T>
+  vec<T> collectSorted(tbb::enumerable_thread_specific<vec<T>>& local_elements) {
+    vec<T> elements;
+    local_elements.combine_each([&](const vec<T>& local) {
+      elements.insert(elements.end(), local.begin(), local.end());
+    });
+    tbb::parallel_sort(elements.begin(), elements.end());
+    return elements;
+  }
+
+  // ! Computes all statistics with one parallel pass over the vertices and one over
+  // ! the hyperedges, instead of a separate pass for each preprocessing step.
+  // ! A graph is considered a mesh graph, if the standard deviation of its vertex
+  // ! degrees is at most half of the average degree and at most 0.1% of its
+  // ! vertices have a degree larger than four times the average degree.
+  InputStatistics computeInputStatistics(const Hypergraph& hypergraph,
+                                         const HypernodeID large_hyperedge_threshold) {
+    struct DegreeStatistics {
+      double squared_deviation = 0.0;
+      HypernodeID num_high_degree_nodes = 0;
+    };
+
+    InputStatistics stats;
+    tbb::parallel_invoke([&] {
+      const HypernodeID num_nodes = hypergraph.initialNumNodes();
+      const double avg_hn_degree = utils::avgHypernodeDegree(hypergraph);
+      tbb::enumerable_thread_specific<vec<HypernodeID>> degree_zero_hypernodes;
+      const DegreeStatistics degree_stats = tbb::parallel_reduce(
+        tbb::blocked_range<HypernodeID>(ID(0), num_nodes), DegreeStatistics(),
+        [&](const tbb::blocked_range<HypernodeID>& range, DegreeStatistics local_stats) {
+          vec<HypernodeID>& local_degree_zero_hypernodes = degree_zero_hypernodes.local();
+          for ( HypernodeID hn = range.begin(); hn < range.end(); ++hn ) {
+            const bool is_enabled = hypergraph.nodeIsEnabled(hn);
+            const HyperedgeID degree = is_enabled ? hypergraph.nodeDegree(hn) : 0;
+            local_stats.squared_deviation += (degree - avg_hn_degree) * (degree - avg_hn_degree);
+            local_stats.num_high_degree_nodes += (degree > 4 * avg_hn_degree);
+            if ( is_enabled && degree == 0 && !hypergraph.isFixed(hn) ) {
+              local_degree_zero_hypernodes.push_back(hn);
+            }
+          }
+          return local_stats;
+        }, [&](const DegreeStatistics& lhs, const DegreeStatistics& rhs) {
+          return DegreeStatistics { lhs.squared_deviation + rhs.squared_deviation,
+                                    lhs.num_high_degree_nodes + rhs.num_high_degree_nodes };
+        });
+      const double stdev_hn_degree = std::sqrt(degree_stats.squared_deviation / (num_nodes - 1));
+      stats.is_mesh_graph = stdev_hn_degree <= avg_hn_degree / 2 &&
+        degree_stats.num_high_degree_nodes <= num_nodes / 1000;
+      stats.degree_zero_hypernodes = collectSorted(degree_zero_hypernodes);
+    }, [&] {
+      tbb::enumerable_thread_specific<vec<HyperedgeID>> large_hyperedges;
+      stats.is_graph = tbb::parallel_reduce(tbb::blocked_range<HyperedgeID>(
+        ID(0), hypergraph.initialNumEdges()), true, [&](const tbb::blocked_range<HyperedgeID>& range, bool is_graph) {
+        vec<HyperedgeID>& local_large_hyperedges = large_hyperedges.local();
+        for ( HyperedgeID he = range.begin(); he < range.end(); ++he ) {
+          if ( hypergraph.edgeIsEnabled(he) ) {
+            const HypernodeID edge_size = hypergraph.edgeSize(he);
+            is_graph &= (edge_size == 2);
+            if ( edge_size > large_hyperedge_threshold ) {
+              local_large_hyperedges.push_back(he);
+            }
+          }
+        }
+        return is_graph;
+      }, [&](const bool lhs, const bool rhs) {
+        return lhs && rhs;
+      }) || Hypergraph::is_graph;
+      stats.large_hyperedges = collectSorted(large_hyperedges);
+    });
+    return stats;
+  }
+
   void sanitize(Hypergraph& hypergraph, Context& context,
+                const InputStatistics& stats,
                 DegreeZeroHypernodeRemover& degree_zero_hn_remover,
                 LargeHyperedgeRemover& large_he_remover) {
 
     utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
     timer.start_timer("degree_zero_hypernode_removal", "Degree Zero Hypernode Removal");
     const HypernodeID num_removed_degree_zero_hypernodes =
-            degree_zero_hn_remover.removeDegreeZeroHypernodes(hypergraph);
+            degree_zero_hn_remover.removeDegreeZeroHypernodes(hypergraph, stats.degree_zero_hypernodes);
     timer.stop_timer("degree_zero_hypernode_removal");
 
     timer.start_timer("large_hyperedge_removal", "Large Hyperedge Removal");
     const HypernodeID num_removed_large_hyperedges =
-            large_he_remover.removeLargeHyperedges(hypergraph);
+            large_he_remover.removeLargeHyperedges(hypergraph, stats.large_hyperedges);
     timer.stop_timer("large_hyperedge_removal");
 
     const HyperedgeID num_removed_single_node_hes = hypergraph.numRemovedHyperedges();
@@ -113,79 +267,106 @@ namespace mt_kahypar {
     }
   }
 
-  bool isGraph(const Hypergraph& hypergraph) {
-    if (Hypergraph::is_graph) {
-      return true;
+  // ! Fingerprint of the hypergraph and all parameters that influence the result
+  // ! of the community detection. Note that the seed is not part of the fingerprint,
+  // ! since the communities are reused if only the seed changes.
+  uint64_t communityDetectionFingerprint(const Hypergraph& hypergraph,
+                                         const Context& context,
+                                         const bool is_graph) {
+    using namespace hashing::integer;
+    const CommunityDetectionParameters& params = context.preprocessing.community_detection;
+    const double min_vertex_move_fraction = params.min_vertex_move_fraction;
+    uint64_t min_vertex_move_fraction_bits = 0;
+    std::memcpy(&min_vertex_move_fraction_bits, &min_vertex_move_fraction, sizeof(double));
+    uint64_t fingerprint = utils::hypergraphFingerprint(hypergraph);
+    for ( const uint64_t value : { static_cast<uint64_t>(is_graph),
+                                   static_cast<uint64_t>(params.edge_weight_function),
+                                   static_cast<uint64_t>(params.max_pass_iterations),
+                                   min_vertex_move_fraction_bits,
+                                   static_cast<uint64_t>(params.vertex_degree_sampling_threshold),
+                                   static_cast<uint64_t>(params.use_active_set_pruning),
+                                   static_cast<uint64_t>(params.high_degree_vertex_threshold),
+                                   static_cast<uint64_t>(context.partition.deterministic),
+                                   static_cast<uint64_t>(params.num_sub_rounds_deterministic) } ) {
+      fingerprint = combine64(fingerprint, hash64(value));
     }
-    return tbb::parallel_reduce(tbb::blocked_range<HyperedgeID>(
-            ID(0), hypergraph.initialNumEdges()), true, [&](const tbb::blocked_range<HyperedgeID>& range, bool isGraph) {
-      if ( isGraph ) {
-        bool tmp_is_graph = isGraph;
-        for (HyperedgeID he = range.begin(); he < range.end(); ++he) {
-          if ( hypergraph.edgeIsEnabled(he) ) {
-            tmp_is_graph &= (hypergraph.edgeSize(he) == 2);
-          }
-        }
-        return tmp_is_graph;
-      }
-      return false;
-    }, [&](const bool lhs, const bool rhs) {
-      return lhs && rhs;
-    });
+    return fingerprint;
   }
 
-  bool isMeshGraph(const Hypergraph& graph) {
-    const HypernodeID num_nodes = graph.initialNumNodes();
-    const double avg_hn_degree = utils::avgHypernodeDegree(graph);
-    std::vector<HyperedgeID> hn_degrees;
-    hn_degrees.resize(graph.initialNumNodes());
-    graph.doParallelForAllNodes([&](const HypernodeID& hn) {
-      hn_degrees[hn] = graph.nodeDegree(hn);
-    });
-    const double stdev_hn_degree = utils::parallel_stdev(hn_degrees, avg_hn_degree, num_nodes);
-    if (stdev_hn_degree > avg_hn_degree / 2) {
-      return false;
-    }
+  std::string communityCacheFilename(const Context& context, const uint64_t fingerprint) {
+    std::stringstream filename;
+    filename << context.preprocessing.community_detection.cache_directory << "/"
+             << std::hex << fingerprint << ".community";
+    return filename.str();
+  }
 
-    // test whether 99.9th percentile hypernode degree is at most 4 times the average degree
-    tbb::enumerable_thread_specific<size_t> num_high_degree_nodes(0);
-    graph.doParallelForAllNodes([&](const HypernodeID& node) {
-      if (graph.nodeDegree(node) > 4 * avg_hn_degree) {
-        num_high_degree_nodes.local() += 1;
+  // ! Runs the louvain method on the star-expansion of the hypergraph. For static hypergraphs,
+  // ! the first level can run on an implicit view of the star-expansion instead of a materialized graph.
+  template<typename HG>
+  ds::Clustering detectCommunities(HG& hypergraph, const Context& context, const bool is_graph) {
+    utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
+    ds::Clustering communities;
+    if constexpr ( !HG::is_graph && HG::is_static_hypergraph ) {
+      if ( context.preprocessing.community_detection.implicit_star_expansion && !is_graph ) {
+        timer.start_timer("construct_graph", "Construct Graph");
+        ds::StarExpansionView graph(hypergraph, context.preprocessing.community_detection.edge_weight_function);
+        timer.stop_timer("construct_graph");
+        timer.start_timer("perform_community_detection", "Perform Community Detection");
+        communities = community_detection::run_parallel_louvain(graph, context);
+        graph.restrictClusteringToHypernodes(hypergraph, communities);
+        timer.stop_timer("perform_community_detection");
+        return communities;
       }
-    });
-    return num_high_degree_nodes.combine(std::plus<>()) <= num_nodes / 1000;
+    }
+
+    timer.start_timer("construct_graph", "Construct Graph");
+    Graph graph(hypergraph, context.preprocessing.community_detection.edge_weight_function, is_graph);
+    if ( !context.preprocessing.community_detection.low_memory_contraction ) {
+      graph.allocateContractionBuffers();
+    }
+    timer.stop_timer("construct_graph");
+    timer.start_timer("perform_community_detection", "Perform Community Detection");
+    communities = community_detection::run_parallel_louvain(graph, context);
+    graph.restrictClusteringToHypernodes(hypergraph, communities);
+    timer.stop_timer("perform_community_detection");
+    return communities;
   }
 
-  void preprocess(Hypergraph& hypergraph, Context& context) {
+  void preprocess(Hypergraph& hypergraph, Context& context, const InputStatistics& stats) {
     bool use_community_detection = context.preprocessing.use_community_detection;
-    bool is_graph = false;
+    const bool is_graph = stats.is_graph;
+    if ( is_graph && context.preprocessing.disable_community_detection_for_mesh_graphs ) {
+      use_community_detection &= !stats.is_mesh_graph;
+    }
 
     utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
-    if ( context.preprocessing.use_community_detection ) {
-      timer.start_timer("detect_graph_structure", "Detect Graph Structure");
-      is_graph = isGraph(hypergraph);
-      if ( is_graph && context.preprocessing.disable_community_detection_for_mesh_graphs ) {
-        use_community_detection = !isMeshGraph(hypergraph);
-      }
-      timer.stop_timer("detect_graph_structure");
-    }
 
     if ( use_community_detection ) {
       io::printTopLevelPreprocessingBanner(context);
 
       timer.start_timer("community_detection", "Community Detection");
-      timer.start_timer("construct_graph", "Construct Graph");
-      Graph graph(hypergraph, context.preprocessing.community_detection.edge_weight_function, is_graph);
-      if ( !context.preprocessing.community_detection.low_memory_contraction ) {
-        graph.allocateContractionBuffers();
+      const bool use_cache = !context.preprocessing.community_detection.cache_directory.empty();
+      std::string cache_filename;
+      uint64_t fingerprint = 0;
+      ds::Clustering communities;
+      bool cache_hit = false;
+      if ( use_cache ) {
+        fingerprint = communityDetectionFingerprint(hypergraph, context, is_graph);
+        cache_filename = communityCacheFilename(context, fingerprint);
+        cache_hit = io::readCommunityCacheFile(cache_filename, fingerprint, communities) &&
+          communities.size() == hypergraph.initialNumNodes();
+        if ( cache_hit && context.partition.verbose_output ) {
+          LOG << "Read communities from" << cache_filename;
+        }
+      }
+
+      if ( !cache_hit ) {
+        communities = detectCommunities(hypergraph, context, is_graph);
+        if ( use_cache ) {
+          io::writeCommunityCacheFile(cache_filename, fingerprint, communities);
+        }
       }
-      timer.stop_timer("construct_graph");
-      timer.start_timer("perform_community_detection", "Perform Community Detection");
-      ds::Clustering communities = community_detection::run_parallel_louvain(graph, context);
-      graph.restrictClusteringToHypernodes(hypergraph, communities);
       hypergraph.setCommunityIDs(std::move(communities));
-      timer.stop_timer("perform_community_detection");
       timer.stop_timer("community_detection");
 
       if (context.partition.verbose_output) {
@@ -193,9 +374,13 @@ namespace mt_kahypar {
       }
     }
     parallel::MemoryPool::instance().release_mem_group("Preprocessing");
+    if ( context.shared_memory.release_memory_between_phases ) {
+      // The graph used for community detection is not required any more
+      parallel::MemoryPool::instance().release_allocator_caches();
+    }
   }
 
-  PartitionedHypergraph partition(Hypergraph& hypergraph, Context& context) {
+  PartitionedHypergraph partitionInputHypergraph(Hypergraph& hypergraph, Context& context) {
     configurePreprocessing(hypergraph, context);
     setupContext(hypergraph, context);
 
@@ -206,27 +391,76 @@ namespace mt_kahypar {
     // ################## PREPROCESSING ##################
     utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
     timer.start_timer("preprocessing", "Preprocessing");
-    preprocess(hypergraph, context);
-
+    context.startBudgetPhase(utils::BudgetPhase::preprocessing);
     DegreeZeroHypernodeRemover degree_zero_hn_remover(context);
     LargeHyperedgeRemover large_he_remover(context);
-    sanitize(hypergraph, context, degree_zero_hn_remover, large_he_remover);
+    timer.start_timer("detect_graph_structure", "Detect Graph Structure");
+    const InputStatistics stats = computeInputStatistics(
+      hypergraph, large_he_remover.largeHyperedgeThreshold());
+    timer.stop_timer("detect_graph_structure");
+
+    preprocess(hypergraph, context, stats);
+    sanitize(hypergraph, context, stats, degree_zero_hn_remover, large_he_remover);
+
+    // Twins are merged in a reduced copy of the hypergraph, which is partitioned instead
+    TwinVertexRemover twin_vertex_remover(context);
+    Hypergraph reduced_hypergraph;
+    bool has_removed_twins = false;
+    if ( context.preprocessing.remove_twin_vertices ) {
+      timer.start_timer("twin_vertex_removal", "Twin Vertex Removal");
+      const HypernodeID num_removed_twins =
+        twin_vertex_remover.removeTwinVertices(hypergraph, reduced_hypergraph);
+      has_removed_twins = num_removed_twins > 0;
+      timer.stop_timer("twin_vertex_removal");
+      if ( context.partition.verbose_output && has_removed_twins ) {
+        LOG << "\033[1m\033[31m" << " # merged" << num_removed_twins
+            << "twin vertices ( reduced hypergraph has"
+            << reduced_hypergraph.initialNumNodes() << "vertices and"
+            << reduced_hypergraph.initialNumEdges() << "hyperedges )" << "\033[0m";
+        io::printStripe();
+      }
+    }
+    Hypergraph& input_hypergraph = has_removed_twins ? reduced_hypergraph : hypergraph;
     timer.stop_timer("preprocessing");
 
     // ################## MULTILEVEL & VCYCLE ##################
     PartitionedHypergraph partitioned_hypergraph;
     if (context.partition.mode == Mode::direct) {
-      partitioned_hypergraph = multilevel::partition(hypergraph, context);
+      multilevel::PartitionCallback on_improved_partition = nullptr;
+      if ( context.on_improved_partition ) {
+        auto report_partition = [&](const PartitionedHypergraph& phg) {
+          // Degree-zero vertices are only assigned to a block after partitioning
+          vec<PartitionID> partition(phg.initialNumNodes());
+          phg.copyPartIDs(partition.data());
+          degree_zero_hn_remover.assignDegreeZeroHypernodes(phg, partition);
+          context.on_improved_partition(partition);
+        };
+        on_improved_partition = [&](const PartitionedHypergraph& phg) {
+          if ( has_removed_twins ) {
+            report_partition(twin_vertex_remover.restoreTwinVertices(hypergraph, phg));
+          } else {
+            report_partition(phg);
+          }
+        };
+      }
+      partitioned_hypergraph = multilevel::partition(input_hypergraph, context, on_improved_partition);
     } else if (context.partition.mode == Mode::recursive_bipartitioning) {
-      partitioned_hypergraph = recursive_bipartitioning::partition(hypergraph, context);
+      partitioned_hypergraph = recursive_bipartitioning::partition(input_hypergraph, context);
     } else if (context.partition.mode == Mode::deep_multilevel) {
-      partitioned_hypergraph = deep_multilevel::partition(hypergraph, context);
+      partitioned_hypergraph = deep_multilevel::partition(input_hypergraph, context);
+    } else if (context.partition.mode == Mode::streaming) {
+      partitioned_hypergraph = streaming::partition(input_hypergraph, context);
+    } else if (context.partition.mode == Mode::multisection) {
+      partitioned_hypergraph = multisection::partition(input_hypergraph, context);
     } else {
       ERR("Invalid mode: " << context.partition.mode);
     }
 
     // ################## POSTPROCESSING ##################
     timer.start_timer("postprocessing", "Postprocessing");
+    if ( has_removed_twins ) {
+      partitioned_hypergraph = twin_vertex_remover.restoreTwinVertices(hypergraph, partitioned_hypergraph);
+    }
     large_he_remover.restoreLargeHyperedges(partitioned_hypergraph);
     degree_zero_hn_remover.restoreDegreeZeroHypernodes(partitioned_hypergraph);
     timer.stop_timer("postprocessing");
@@ -237,9 +471,149 @@ namespace mt_kahypar {
       io::printStripe();
     }
 
+    if ( context.reportsProgress() ) {
+      utils::ProgressUpdate update;
+      update.phase = utils::ProgressPhase::finished;
+      update.objective = metrics::objective(partitioned_hypergraph, context.partition.objective);
+      update.imbalance = metrics::imbalance(partitioned_hypergraph, context);
+      context.reportProgress(update);
+    }
+
     return partitioned_hypergraph;
   }
 
+  // ! Partitions a tiny input with the sequential variants of the refinement algorithms
+  // ! in a single-thread task arena. Then, all parallel constructs execute inline on
+  // ! the calling thread and no tasks are spawned for work packages of a few vertices.
+  PartitionedHypergraph partitionSmallInstance(Hypergraph& hypergraph, Context& context) {
+    context.shared_memory.num_threads = 1;
+    context.shared_memory.elastic_num_threads = false;
+    context.shared_memory.numa_aware_refinement = false;
+    context.refinement.label_propagation.execute_sequential = true;
+    if ( context.partition.verbose_output ) {
+      LOG << "Input has less than" << context.partition.small_instance_num_pins_threshold
+          << "pins -> partition it sequentially";
+    }
+
+    PartitionedHypergraph partitioned_hypergraph;
+    tbb::task_arena sequential_arena(1, 1);
+    sequential_arena.execute([&] {
+      partitioned_hypergraph = partitionInputHypergraph(hypergraph, context);
+    });
+    return partitioned_hypergraph;
+  }
+
+  PartitionedHypergraph partition(Hypergraph& hypergraph, Context& context) {
+    if ( context.isSmallInstance(hypergraph.initialNumPins()) ) {
+      // Reordering for locality does not pay off for inputs that fit into the cache
+      return partitionSmallInstance(hypergraph, context);
+    }
+    if ( !context.preprocessing.reorder_for_locality ) {
+      return partitionInputHypergraph(hypergraph, context);
+    }
+
+    // The reordered hypergraph is partitioned instead and its partition is mapped back
+    utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
+    timer.start_timer("locality_reordering", "Locality Reordering");
+    LocalityReordering reordering;
+    Hypergraph reordered_hypergraph = reordering.reorder(hypergraph);
+    timer.stop_timer("locality_reordering");
+
+    auto on_improved_partition = context.on_improved_partition;
+    if ( on_improved_partition ) {
+      context.on_improved_partition = [&](const vec<PartitionID>& partition) {
+        on_improved_partition(reordering.restorePartition(partition));
+      };
+    }
+    PartitionedHypergraph reordered_phg = partitionInputHypergraph(reordered_hypergraph, context);
+    context.on_improved_partition = on_improved_partition;
+    return reordering.restorePartition(hypergraph, reordered_phg);
+  }
+
+
+  vec<parallel::scalable_vector<PartitionID>> partitionMultipleTargets(
+    Hypergraph& hypergraph,
+    const vec<std::pair<PartitionID, double>>& targets,
+    Context& context) {
+    ASSERT(!targets.empty());
+    if ( context.partition.mode != Mode::direct ||
+         context.partition.use_individual_part_weights ||
+         context.coarsening.algorithm == CoarseningAlgorithm::nlevel_coarsener ) {
+      ERR("Partitioning multiple targets with the same hierarchy is only supported"
+        << "for direct k-way partitioning with a multilevel coarsener");
+    }
+
+    // The hierarchy is coarsened with the largest k and the smallest epsilon of all targets,
+    // which results in the smallest maximum allowed node weight. Thus, each level respects
+    // the maximum allowed node weight of each target.
+    context.partition.k = 0;
+    context.partition.epsilon = std::numeric_limits<double>::max();
+    for ( const auto& target : targets ) {
+      context.partition.k = std::max(context.partition.k, target.first);
+      context.partition.epsilon = std::min(context.partition.epsilon, target.second);
+    }
+    configurePreprocessing(hypergraph, context);
+    setupContext(hypergraph, context);
+
+    // The target contexts keep the coarsening parameters of the hierarchy (e.g., contraction limit).
+    // Thus, degree-zero vertices are removed in the same way for each target.
+    vec<Context> target_contexts;
+    for ( const auto& target : targets ) {
+      Context target_context(context);
+      target_context.partition.k = target.first;
+      target_context.partition.epsilon = target.second;
+      target_context.setupPartWeights(hypergraph.totalWeight());
+      target_context.setupThreadsPerFlowSearch();
+      target_contexts.push_back(std::move(target_context));
+    }
+
+    io::printContext(context);
+    io::printMemoryPoolConsumption(context);
+    io::printInputInformation(context, hypergraph);
+
+    // ################## PREPROCESSING ##################
+    utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
+    timer.start_timer("preprocessing", "Preprocessing");
+    // The removed vertices and hyperedges are restored after each target and then
+    // removed again for the next target, since restoring depends on k
+    std::unique_ptr<DegreeZeroHypernodeRemover> degree_zero_hn_remover =
+      std::make_unique<DegreeZeroHypernodeRemover>(target_contexts[0]);
+    std::unique_ptr<LargeHyperedgeRemover> large_he_remover =
+      std::make_unique<LargeHyperedgeRemover>(target_contexts[0]);
+    timer.start_timer("detect_graph_structure", "Detect Graph Structure");
+    const InputStatistics stats = computeInputStatistics(
+      hypergraph, large_he_remover->largeHyperedgeThreshold());
+    timer.stop_timer("detect_graph_structure");
+
+    preprocess(hypergraph, context, stats);
+    sanitize(hypergraph, target_contexts[0], stats, *degree_zero_hn_remover, *large_he_remover);
+    timer.stop_timer("preprocessing");
+
+    // ################## MULTILEVEL ##################
+    vec<parallel::scalable_vector<PartitionID>> partitions(targets.size());
+    multilevel::partitionMultipleTargets(hypergraph, context, target_contexts,
+      [&](PartitionedHypergraph& partitioned_hg, const size_t i) {
+      // ################## POSTPROCESSING ##################
+      timer.start_timer("postprocessing", "Postprocessing");
+      large_he_remover->restoreLargeHyperedges(partitioned_hg);
+      degree_zero_hn_remover->restoreDegreeZeroHypernodes(partitioned_hg);
+      partitions[i].resize(partitioned_hg.initialNumNodes());
+      partitioned_hg.doParallelForAllNodes([&](const HypernodeID& hn) {
+        partitions[i][hn] = partitioned_hg.partID(hn);
+      });
+      timer.stop_timer("postprocessing");
+
+      if ( i + 1 < targets.size() ) {
+        timer.start_timer("preprocessing", "Preprocessing");
+        degree_zero_hn_remover = std::make_unique<DegreeZeroHypernodeRemover>(target_contexts[i + 1]);
+        large_he_remover = std::make_unique<LargeHyperedgeRemover>(target_contexts[i + 1]);
+        sanitize(hypergraph, target_contexts[i + 1], stats, *degree_zero_hn_remover, *large_he_remover);
+        timer.stop_timer("preprocessing");
+      }
+    });
+
+    return partitions;
+  }
 
   void partitionVCycle(PartitionedHypergraph& partitioned_hg, Context& context) {
     Hypergraph& hypergraph = partitioned_hg.hypergraph();
@@ -256,7 +630,9 @@ namespace mt_kahypar {
     timer.start_timer("preprocessing", "Preprocessing");
     DegreeZeroHypernodeRemover degree_zero_hn_remover(context);
     LargeHyperedgeRemover large_he_remover(context);
-    sanitize(hypergraph, context, degree_zero_hn_remover, large_he_remover);
+    const InputStatistics stats = computeInputStatistics(
+      hypergraph, large_he_remover.largeHyperedgeThreshold());
+    sanitize(hypergraph, context, stats, degree_zero_hn_remover, large_he_remover);
     timer.stop_timer("preprocessing");
 
     // ################## MULTILEVEL & VCYCLE ##################
@@ -279,6 +655,88 @@ namespace mt_kahypar {
     }
   }
 
+  namespace {
+    // ! Assigns a vertex that is not part of the previous partition to the block to which
+    // ! it is most strongly connected among all blocks to which it can be moved without
+    // ! violating the balance constraint. If no such block exists, the vertex is assigned
+    // ! to the lightest block.
+    PartitionID assignToBestBlock(PartitionedHypergraph& partitioned_hg,
+                                  const HypernodeID hn,
+                                  vec<HypernodeWeight>& part_weights,
+                                  vec<HyperedgeWeight>& connectivity,
+                                  vec<HyperedgeID>& last_visited_edge,
+                                  const Context& context) {
+      const PartitionID k = context.partition.k;
+      connectivity.assign(k, 0);
+      for ( const HyperedgeID& he : partitioned_hg.incidentEdges(hn) ) {
+        for ( const HypernodeID& pin : partitioned_hg.pins(he) ) {
+          const PartitionID block = partitioned_hg.partID(pin);
+          if ( block != kInvalidPartition && last_visited_edge[block] != he ) {
+            last_visited_edge[block] = he;
+            connectivity[block] += partitioned_hg.edgeWeight(he);
+          }
+        }
+      }
+
+      const HypernodeWeight weight = partitioned_hg.nodeWeight(hn);
+      PartitionID best_block = kInvalidPartition;
+      PartitionID lightest_block = 0;
+      for ( PartitionID block = 0; block < k; ++block ) {
+        if ( part_weights[block] + weight <= context.partition.max_part_weights[block] &&
+             ( best_block == kInvalidPartition || connectivity[block] > connectivity[best_block] ) ) {
+          best_block = block;
+        }
+        if ( part_weights[block] < part_weights[lightest_block] ) {
+          lightest_block = block;
+        }
+      }
+      if ( best_block == kInvalidPartition ) {
+        best_block = lightest_block;
+      }
+      part_weights[best_block] += weight;
+      return best_block;
+    }
+  }
+
+  PartitionedHypergraph repartition(Hypergraph& hypergraph,
+                                    const parallel::scalable_vector<PartitionID>& previous_partition,
+                                    Context& context) {
+    ASSERT(previous_partition.size() == hypergraph.initialNumNodes());
+    context.setupPartWeights(hypergraph.totalWeight());
+    const PartitionID k = context.partition.k;
+    PartitionedHypergraph partitioned_hg(k, hypergraph, parallel_tag_t());
+
+    // Vertices contained in the previous partition keep their block
+    vec<HypernodeWeight> part_weights(k, 0);
+    vec<HypernodeID> new_vertices;
+    for ( const HypernodeID& hn : hypergraph.nodes() ) {
+      const PartitionID block = previous_partition[hn];
+      if ( block != kInvalidPartition ) {
+        if ( block < 0 || block >= k ) {
+          ERR("Block" << block << "of vertex" << hn << "in the previous partition is not in the range [0," << k << ")");
+        }
+        partitioned_hg.setOnlyNodePart(hn, block);
+        part_weights[block] += hypergraph.nodeWeight(hn);
+      } else {
+        new_vertices.push_back(hn);
+      }
+    }
+
+    // Inserted vertices are assigned greedily to the block to which they are most strongly connected
+    vec<HyperedgeWeight> connectivity(k, 0);
+    vec<HyperedgeID> last_visited_edge(k, kInvalidHyperedge);
+    for ( const HypernodeID& hn : new_vertices ) {
+      partitioned_hg.setOnlyNodePart(hn, assignToBestBlock(
+        partitioned_hg, hn, part_weights, connectivity, last_visited_edge, context));
+    }
+    partitioned_hg.initializePartition();
+
+    if ( context.partition.num_vcycles > 0 ) {
+      partitionVCycle(partitioned_hg, context);
+    }
+    return partitioned_hg;
+  }
+
 
 
 }
\ No newline at end of file
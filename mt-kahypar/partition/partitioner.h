@@ -33,4 +33,19 @@
 namespace mt_kahypar {
   PartitionedHypergraph partition(Hypergraph& hypergraph, Context& context);
   void partitionVCycle(PartitionedHypergraph& partitioned_hg, Context& context);
+  // ! Computes a partition for each (k, epsilon) target. Preprocessing and coarsening
+  // ! are performed only once and all targets share the same multilevel hierarchy.
+  // ! Returns the block IDs of all vertices for each target (in the order of the targets).
+  // ! Note, this is only supported for direct k-way partitioning with a multilevel coarsener.
+  vec<parallel::scalable_vector<PartitionID>> partitionMultipleTargets(
+    Hypergraph& hypergraph,
+    const vec<std::pair<PartitionID, double>>& targets,
+    Context& context);
+  // ! Computes a partition of an updated hypergraph starting from a previous partition.
+  // ! previous_partition contains the block of each vertex in the previous partition or
+  // ! kInvalidPartition for vertices that were inserted since then. Afterwards,
+  // ! context.partition.num_vcycles V-cycles are performed to improve the partition.
+  PartitionedHypergraph repartition(Hypergraph& hypergraph,
+                                    const parallel::scalable_vector<PartitionID>& previous_partition,
+                                    Context& context);
 }  // namespace mt_kahypar
@@ -35,7 +35,8 @@
 #include <tbb/parallel_sort.h>
 
 namespace mt_kahypar::metrics {
-double modularity(const Graph& graph, const ds::Clustering& communities) {
+template<typename GraphT>
+double modularity(const GraphT& graph, const ds::Clustering& communities) {
   ASSERT(graph.canBeUsed());
   ASSERT(graph.numNodes() == communities.size());
   vec<NodeID> nodes(graph.numNodes());
@@ -75,11 +76,15 @@ double modularity(const Graph& graph, const ds::Clustering& communities) {
   };
   return tbb::parallel_deterministic_reduce(r, 0.0, combine_range, std::plus<>()) / graph.totalVolume();
 }
+
+template double modularity(const Graph& graph, const ds::Clustering& communities);
+template double modularity(const ds::StarExpansionView& graph, const ds::Clustering& communities);
 }
 
 namespace mt_kahypar::community_detection {
 
-bool ParallelLocalMovingModularity::localMoving(Graph& graph, ds::Clustering& communities) {
+template<typename GraphT>
+bool ParallelLocalMovingModularity::localMoving(GraphT& graph, ds::Clustering& communities) {
   ASSERT(graph.canBeUsed());
   _max_degree = graph.max_degree();
   _reciprocal_total_volume = 1.0 / graph.totalVolume();
@@ -99,6 +104,9 @@ bool ParallelLocalMovingModularity::localMoving(Graph& graph, ds::Clustering& co
       communities[u] = u;
       _cluster_volumes[u].store(graph.nodeVolume(u), std::memory_order_relaxed);
     });
+    if ( _use_active_set_pruning ) {
+      _next_active.reset();
+    }
   }
 
   DBG << "Louvain level" << V(graph.numNodes()) << V(graph.numArcs());
@@ -122,7 +130,8 @@ bool ParallelLocalMovingModularity::localMoving(Graph& graph, ds::Clustering& co
   return clustering_changed;
 }
 
-size_t ParallelLocalMovingModularity::synchronousParallelRound(const Graph& graph, ds::Clustering& communities) {
+template<typename GraphT>
+size_t ParallelLocalMovingModularity::synchronousParallelRound(const GraphT& graph, ds::Clustering& communities) {
   if (graph.numNodes() < 200) {
     return sequentialRound(graph, communities);
   }
@@ -204,7 +213,8 @@ size_t ParallelLocalMovingModularity::synchronousParallelRound(const Graph& grap
   return num_moved_nodes;
 }
 
-size_t ParallelLocalMovingModularity::sequentialRound(const Graph& graph, ds::Clustering& communities) {
+template<typename GraphT>
+size_t ParallelLocalMovingModularity::sequentialRound(const GraphT& graph, ds::Clustering& communities) {
   size_t seed = prng();
   permutation.sequential_fallback(graph.numNodes(), seed);
   size_t num_moved = 0;
@@ -221,22 +231,34 @@ size_t ParallelLocalMovingModularity::sequentialRound(const Graph& graph, ds::Cl
   return num_moved;
 }
 
-size_t ParallelLocalMovingModularity::parallelNonDeterministicRound(const Graph& graph, ds::Clustering& communities) {
+template<typename GraphT>
+size_t ParallelLocalMovingModularity::parallelNonDeterministicRound(const GraphT& graph, ds::Clustering& communities) {
   auto& nodes = permutation.permutation;
   if ( !_disable_randomization ) {
     utils::Randomize::instance().parallelShuffleVector(nodes, UL(0), nodes.size());
   }
 
   tbb::enumerable_thread_specific<size_t> local_number_of_nodes_moved(0);
-  auto moveNode = [&](const NodeID u) {
+  auto applyMove = [&](const NodeID u, const PartitionID best_cluster) {
     const ArcWeight volU = graph.nodeVolume(u);
     const PartitionID from = communities[u];
-    PartitionID best_cluster = computeMaxGainCluster(graph, communities, u);
     if (best_cluster != from) {
       _cluster_volumes[best_cluster] += volU;
       _cluster_volumes[from] -= volU;
       communities[u] = best_cluster;
       ++local_number_of_nodes_moved.local();
+      if ( _use_active_set_pruning ) {
+        activateNeighbors(graph, u);
+      }
+    }
+  };
+
+  auto moveNode = [&](const NodeID u) {
+    if ( graph.degree(u) > _high_degree_vertex_threshold ) {
+      // High-degree vertices are moved after all other vertices
+      _high_degree_nodes.stream(u);
+    } else {
+      applyMove(u, computeMaxGainCluster(graph, communities, u));
     }
   };
 
@@ -245,12 +267,86 @@ size_t ParallelLocalMovingModularity::parallelNonDeterministicRound(const Graph&
 #else
   tbb::parallel_for(UL(0), nodes.size(), [&](size_t i) { moveNode(nodes[i]); });
 #endif
+
+  // Moving a high-degree vertex is too expensive for a single thread. Therefore, we process
+  // them one after another and aggregate their incident cluster weights in parallel.
+  if ( _high_degree_nodes.size() > 0 ) {
+    const parallel::scalable_vector<NodeID> high_degree_nodes = _high_degree_nodes.copy_parallel();
+    _high_degree_nodes.clear_parallel();
+    for ( const NodeID u : high_degree_nodes ) {
+      applyMove(u, computeMaxGainClusterOfHighDegreeVertex(graph, communities, u));
+    }
+  }
+
+  if ( _use_active_set_pruning ) {
+    // Only neighbors of moved vertices are visited in the next round
+    nodes = _next_active_nodes.copy_parallel();
+    _next_active_nodes.clear_parallel();
+    _next_active.reset();
+  }
+
   size_t number_of_nodes_moved = local_number_of_nodes_moved.combine(std::plus<>());
   return number_of_nodes_moved;
 }
 
+template<typename GraphT>
+void ParallelLocalMovingModularity::activateNeighbors(const GraphT& graph, const NodeID u) {
+  auto activate = [&](const Arc& arc) {
+    if ( _next_active.compare_and_set_to_true(arc.head) ) {
+      _next_active_nodes.stream(arc.head);
+    }
+  };
+
+  if ( graph.degree(u) > _high_degree_vertex_threshold ) {
+    auto arcs = graph.arcsOf(u);
+    tbb::parallel_for(UL(0), graph.degree(u), [&](const size_t i) {
+      activate(*(arcs.begin() + i));
+    });
+  } else {
+    for ( const Arc& arc : graph.arcsOf(u) ) {
+      activate(arc);
+    }
+  }
+}
+
+template<typename GraphT>
+PartitionID ParallelLocalMovingModularity::computeMaxGainClusterOfHighDegreeVertex(const GraphT& graph,
+                                                                                   const ds::Clustering& communities,
+                                                                                   const NodeID u) {
+  // Each thread aggregates the weights of a subset of the arcs in its clear list
+  auto arcs = graph.arcsOf(u);
+  tbb::parallel_for(tbb::blocked_range<size_t>(UL(0), graph.degree(u)),
+    [&](const tbb::blocked_range<size_t>& range) {
+    ClearList& incident_cluster_weights = non_sampling_incident_cluster_weights.local();
+    auto& weights = incident_cluster_weights.weights;
+    auto& used = incident_cluster_weights.used;
+    for ( size_t i = range.begin(); i < range.end(); ++i ) {
+      const Arc& arc = *(arcs.begin() + i);
+      const auto cv = communities[arc.head];
+      if (weights[cv] == 0.0) used.push_back(cv);
+      weights[cv] += arc.weight;
+    }
+  });
 
-bool ParallelLocalMovingModularity::verifyGain(const Graph& graph, const ds::Clustering& communities, const NodeID u,
+  // Merge the clear lists of all threads into the clear list of the calling thread
+  ClearList& incident_cluster_weights = non_sampling_incident_cluster_weights.local();
+  for ( ClearList& local_weights : non_sampling_incident_cluster_weights ) {
+    if ( &local_weights != &incident_cluster_weights ) {
+      for ( const PartitionID cv : local_weights.used ) {
+        if (incident_cluster_weights.weights[cv] == 0.0) incident_cluster_weights.used.push_back(cv);
+        incident_cluster_weights.weights[cv] += local_weights.weights[cv];
+        local_weights.weights[cv] = 0.0;
+      }
+      local_weights.used.clear();
+    }
+  }
+
+  return computeMaxGainClusterFromIncidentClusterWeights(graph, communities, u, incident_cluster_weights);
+}
+
+
+template<typename GraphT>
+bool ParallelLocalMovingModularity::verifyGain(const GraphT& graph, const ds::Clustering& communities, const NodeID u,
                                                const PartitionID to, double gain, double weight_from, double weight_to) {
   if (_context.partition.deterministic) {
     // the check is omitted, since changing the cluster volumes breaks determinism
@@ -302,8 +398,9 @@ bool ParallelLocalMovingModularity::verifyGain(const Graph& graph, const ds::Clu
   return result;
 }
 
+template<typename GraphT>
 std::pair<ArcWeight, ArcWeight> ParallelLocalMovingModularity::intraClusterWeightsAndSumOfSquaredClusterVolumes(
-        const Graph& graph, const ds::Clustering& communities) {
+        const GraphT& graph, const ds::Clustering& communities) {
   ArcWeight intraClusterWeights = 0;
   ArcWeight sumOfSquaredClusterVolumes = 0;
   vec<ArcWeight> cluster_volumes(graph.numNodes(), 0);
@@ -337,6 +434,13 @@ void ParallelLocalMovingModularity::initializeClusterVolumes(const Graph& graph,
   });
 }
 
+template bool ParallelLocalMovingModularity::localMoving(Graph& graph, ds::Clustering& communities);
+template bool ParallelLocalMovingModularity::localMoving(ds::StarExpansionView& graph, ds::Clustering& communities);
+template PartitionID ParallelLocalMovingModularity::computeMaxGainClusterOfHighDegreeVertex(
+  const Graph& graph, const ds::Clustering& communities, const NodeID u);
+template bool ParallelLocalMovingModularity::verifyGain(const Graph& graph, const ds::Clustering& communities, NodeID u,
+  PartitionID to, double gain, double weight_from, double weight_to);
+
 ParallelLocalMovingModularity::~ParallelLocalMovingModularity() {
 /*
   tbb::parallel_invoke([&] {
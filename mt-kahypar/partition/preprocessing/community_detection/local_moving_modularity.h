@@ -31,9 +31,12 @@
 
 #include "mt-kahypar/datastructures/sparse_map.h"
 #include "mt-kahypar/datastructures/buffered_vector.h"
+#include "mt-kahypar/datastructures/streaming_vector.h"
+#include "mt-kahypar/datastructures/thread_safe_fast_reset_flag_array.h"
 
 #include "mt-kahypar/macros.h"
 #include "mt-kahypar/datastructures/graph.h"
+#include "mt-kahypar/datastructures/star_expansion_view.h"
 #include "mt-kahypar/partition/context.h"
 #include "mt-kahypar/parallel/atomic_wrapper.h"
 #include "mt-kahypar/utils/randomize.h"
@@ -43,7 +46,8 @@
 #include "gtest/gtest_prod.h"
 
 namespace mt_kahypar::metrics {
-  double modularity(const Graph& graph, const ds::Clustering& communities);
+  template<typename GraphT>
+  double modularity(const GraphT& graph, const ds::Clustering& communities);
 }
 
 namespace mt_kahypar::community_detection {
@@ -64,22 +68,36 @@ class ParallelLocalMovingModularity {
           _context(context),
           _max_degree(numNodes),
           _vertex_degree_sampling_threshold(context.preprocessing.community_detection.vertex_degree_sampling_threshold),
+          _use_active_set_pruning(context.preprocessing.community_detection.use_active_set_pruning),
+          _high_degree_vertex_threshold(context.preprocessing.community_detection.high_degree_vertex_threshold),
           _cluster_volumes(numNodes),
           non_sampling_incident_cluster_weights(numNodes),
           _disable_randomization(disable_randomization),
           prng(context.partition.seed),
           volume_updates_to(0),
-          volume_updates_from(0)
+          volume_updates_from(0),
+          _next_active(_use_active_set_pruning ? numNodes : 0),
+          _next_active_nodes(),
+          _high_degree_nodes()
   { }
 
   ~ParallelLocalMovingModularity();
 
-  bool localMoving(Graph& graph, ds::Clustering& communities);
+  // ! The graph is either a ds::Graph or an implicit ds::StarExpansionView of the input hypergraph
+  template<typename GraphT>
+  bool localMoving(GraphT& graph, ds::Clustering& communities);
 
  private:
-  size_t parallelNonDeterministicRound(const Graph& graph, ds::Clustering& communities);
-  size_t synchronousParallelRound(const Graph& graph, ds::Clustering& communities);
-  size_t sequentialRound(const Graph& graph, ds::Clustering& communities);
+  template<typename GraphT>
+  size_t parallelNonDeterministicRound(const GraphT& graph, ds::Clustering& communities);
+  template<typename GraphT>
+  size_t synchronousParallelRound(const GraphT& graph, ds::Clustering& communities);
+  template<typename GraphT>
+  size_t sequentialRound(const GraphT& graph, ds::Clustering& communities);
+
+  // ! Marks all neighbors of u as active for the next round
+  template<typename GraphT>
+  void activateNeighbors(const GraphT& graph, const NodeID u);
 
   struct ClearList {
     vec<double> weights;
@@ -88,7 +106,8 @@ class ParallelLocalMovingModularity {
   };
 
 
-  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool ratingsFitIntoSmallSparseMap(const Graph& graph,
+  template<typename GraphT>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool ratingsFitIntoSmallSparseMap(const GraphT& graph,
                                                                        const HypernodeID u)  {
     static constexpr size_t cache_efficient_map_size = CacheEfficientIncidentClusterWeights::MAP_SIZE / 3UL;
     return std::min(_vertex_degree_sampling_threshold, _max_degree) > cache_efficient_map_size &&
@@ -102,19 +121,18 @@ class ParallelLocalMovingModularity {
   // ! Only for testing
   void initializeClusterVolumes(const Graph& graph, ds::Clustering& communities);
 
-  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE PartitionID computeMaxGainCluster(const Graph& graph,
+  template<typename GraphT>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE PartitionID computeMaxGainCluster(const GraphT& graph,
                                                                        const ds::Clustering& communities,
                                                                        const NodeID u) {
     return computeMaxGainCluster(graph, communities, u, non_sampling_incident_cluster_weights.local());
   }
 
-  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE PartitionID computeMaxGainCluster(const Graph& graph,
+  template<typename GraphT>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE PartitionID computeMaxGainCluster(const GraphT& graph,
                                                                        const ds::Clustering& communities,
                                                                        const NodeID u,
                                                                        ClearList& incident_cluster_weights) {
-    const PartitionID from = communities[u];
-    PartitionID bestCluster = communities[u];
-
     auto& weights = incident_cluster_weights.weights;
     auto& used = incident_cluster_weights.used;
 
@@ -124,6 +142,28 @@ class ParallelLocalMovingModularity {
       weights[cv] += arc.weight;
     }
 
+    return computeMaxGainClusterFromIncidentClusterWeights(graph, communities, u, incident_cluster_weights);
+  }
+
+  // ! Computes the best cluster of a high-degree vertex. The incident cluster weights
+  // ! are aggregated in parallel over all arcs of u (without sampling).
+  template<typename GraphT>
+  PartitionID computeMaxGainClusterOfHighDegreeVertex(const GraphT& graph,
+                                                      const ds::Clustering& communities,
+                                                      const NodeID u);
+
+  // ! Evaluates the incident cluster weights of u (and resets them)
+  template<typename GraphT>
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE PartitionID computeMaxGainClusterFromIncidentClusterWeights(const GraphT& graph,
+                                                                                                 const ds::Clustering& communities,
+                                                                                                 const NodeID u,
+                                                                                                 ClearList& incident_cluster_weights) {
+    const PartitionID from = communities[u];
+    PartitionID bestCluster = communities[u];
+
+    auto& weights = incident_cluster_weights.weights;
+    auto& used = incident_cluster_weights.used;
+
     const ArcWeight volume_from = _cluster_volumes[from].load(std::memory_order_relaxed);
     const ArcWeight volU = graph.nodeVolume(u);
     const ArcWeight weight_from = weights[from];
@@ -172,14 +212,18 @@ class ParallelLocalMovingModularity {
   }
 
 
-  bool verifyGain(const Graph& graph, const ds::Clustering& communities, NodeID u, PartitionID to, double gain,
+  template<typename GraphT>
+  bool verifyGain(const GraphT& graph, const ds::Clustering& communities, NodeID u, PartitionID to, double gain,
                   double weight_from, double weight_to);
 
-  static std::pair<ArcWeight, ArcWeight> intraClusterWeightsAndSumOfSquaredClusterVolumes(const Graph& graph, const ds::Clustering& communities);
+  template<typename GraphT>
+  static std::pair<ArcWeight, ArcWeight> intraClusterWeightsAndSumOfSquaredClusterVolumes(const GraphT& graph, const ds::Clustering& communities);
 
   const Context& _context;
   size_t _max_degree;
   const size_t _vertex_degree_sampling_threshold;
+  const bool _use_active_set_pruning;
+  const size_t _high_degree_vertex_threshold;
   double _reciprocal_total_volume = 0.0;
   double _vol_multiplier_div_by_node_vol = 0.0;
   vec<parallel::AtomicWrapper<ArcWeight>> _cluster_volumes;
@@ -198,6 +242,12 @@ class ParallelLocalMovingModularity {
   };
   ds::BufferedVector<ClusterMove> volume_updates_to, volume_updates_from;
 
+  // ! Vertices visited in the next round if active set pruning is enabled
+  ds::ThreadSafeFastResetFlagArray<> _next_active;
+  ds::StreamingVector<NodeID> _next_active_nodes;
+  // ! High-degree vertices of the current round
+  ds::StreamingVector<NodeID> _high_degree_nodes;
+
 
 
   FRIEND_TEST(ALouvain, ComputesMaxGainMove1);
@@ -210,5 +260,6 @@ class ParallelLocalMovingModularity {
   FRIEND_TEST(ALouvain, ComputesMaxGainMove8);
   FRIEND_TEST(ALouvain, ComputesMaxGainMove9);
   FRIEND_TEST(ALouvain, ComputesMaxGainMove10);
+  FRIEND_TEST(ALouvain, ComputesMaxGainMoveOfHighDegreeVertex);
 };
 }
@@ -32,7 +32,8 @@
 
 namespace mt_kahypar::community_detection {
 
-  ds::Clustering local_moving_contract_recurse(Graph& fine_graph, ParallelLocalMovingModularity& mlv, const Context& context) {
+  template<typename GraphT>
+  ds::Clustering local_moving_contract_recurse(GraphT& fine_graph, ParallelLocalMovingModularity& mlv, const Context& context) {
     utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
     timer.start_timer("local_moving", "Local Moving");
     ds::Clustering communities(fine_graph.numNodes());
@@ -61,9 +62,14 @@ namespace mt_kahypar::community_detection {
     return communities;
   }
 
-  ds::Clustering run_parallel_louvain(Graph& graph, const Context& context, bool disable_randomization) {
+  template<typename GraphT>
+  ds::Clustering run_parallel_louvain(GraphT& graph, const Context& context, bool disable_randomization) {
     ParallelLocalMovingModularity mlv(context, graph.numNodes(), disable_randomization);
     ds::Clustering communities = local_moving_contract_recurse(graph, mlv, context);
     return communities;
   }
+
+  template ds::Clustering local_moving_contract_recurse(Graph& fine_graph, ParallelLocalMovingModularity& mlv, const Context& context);
+  template ds::Clustering run_parallel_louvain(Graph& graph, const Context& context, bool disable_randomization);
+  template ds::Clustering run_parallel_louvain(ds::StarExpansionView& graph, const Context& context, bool disable_randomization);
 }
\ No newline at end of file
@@ -31,6 +31,11 @@
 #include "mt-kahypar/partition/preprocessing/community_detection/local_moving_modularity.h"
 
 namespace mt_kahypar::community_detection {
-  ds::Clustering local_moving_contract_recurse(Graph& fine_graph, ParallelLocalMovingModularity& mlv, const Context& context);
-  ds::Clustering run_parallel_louvain(Graph& graph, const Context& context, bool disable_randomization = false);
+  template<typename GraphT>
+  ds::Clustering local_moving_contract_recurse(GraphT& fine_graph, ParallelLocalMovingModularity& mlv, const Context& context);
+
+  // ! The graph is either a ds::Graph or an implicit ds::StarExpansionView of the input hypergraph.
+  // ! In the latter case, only the contracted Louvain levels are materialized.
+  template<typename GraphT>
+  ds::Clustering run_parallel_louvain(GraphT& graph, const Context& context, bool disable_randomization = false);
 }
@@ -0,0 +1,203 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <utility>
+
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+
+namespace mt_kahypar {
+
+/*!
+ * Renumbers the vertices and nets of the input hypergraph such that vertices
+ * (and nets) that are close in the hypergraph have close IDs. This improves the
+ * locality of traversals of pins(he) and incidentEdges(hn), if the IDs of the
+ * input are (almost) random. The vertices are numbered in Cuthill-McKee order,
+ * i.e., each connected component is traversed in BFS order starting from its
+ * vertex with smallest degree. The nets are numbered in the order in which the
+ * BFS scans them. After partitioning, the partition of the reordered hypergraph
+ * is mapped back onto the input hypergraph.
+ */
+class LocalityReordering {
+
+  // ! The BFS does not expand nets larger than this threshold, since all of their
+  // ! pins would be numbered consecutively (they are still numbered in scan order)
+  static constexpr HypernodeID MAX_EXPANDED_NET_SIZE = 1000;
+
+  using HyperedgeVector = parallel::scalable_vector<parallel::scalable_vector<HypernodeID>>;
+
+ public:
+  LocalityReordering() :
+    _new_id() { }
+
+  LocalityReordering(const LocalityReordering&) = delete;
+  LocalityReordering & operator= (const LocalityReordering &) = delete;
+
+  LocalityReordering(LocalityReordering&&) = delete;
+  LocalityReordering & operator= (LocalityReordering &&) = delete;
+
+  // ! Returns a copy of the hypergraph with renumbered vertices and nets
+  Hypergraph reorder(const Hypergraph& hypergraph) {
+    const HypernodeID num_nodes = hypergraph.initialNumNodes();
+    const HyperedgeID num_edges = numNets(hypergraph);
+
+    // Each component starts at its unvisited vertex with smallest degree
+    vec<HypernodeID> start_vertices(num_nodes, kInvalidHypernode);
+    tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID& hn) {
+      start_vertices[hn] = hn;
+    });
+    tbb::parallel_sort(start_vertices.begin(), start_vertices.end(),
+      [&](const HypernodeID& lhs, const HypernodeID& rhs) {
+        return std::make_pair(hypergraph.nodeDegree(lhs), lhs) <
+          std::make_pair(hypergraph.nodeDegree(rhs), rhs);
+      });
+
+    // The vertex order also serves as BFS queue
+    _new_id.assign(num_nodes, kInvalidHypernode);
+    vec<HypernodeID> node_order;
+    node_order.reserve(num_nodes);
+    vec<HyperedgeID> net_order;
+    net_order.reserve(num_edges);
+    vec<bool> scanned_net(num_edges, false);
+    auto visit = [&](const HypernodeID hn) {
+      if ( _new_id[hn] == kInvalidHypernode ) {
+        _new_id[hn] = node_order.size();
+        node_order.push_back(hn);
+      }
+    };
+    for ( const HypernodeID& start : start_vertices ) {
+      if ( _new_id[start] != kInvalidHypernode ) {
+        continue;
+      }
+      size_t head = node_order.size();
+      visit(start);
+      while ( head < node_order.size() ) {
+        const HypernodeID hn = node_order[head++];
+        for ( const HyperedgeID& he : hypergraph.incidentEdges(hn) ) {
+          const HyperedgeID net = netID(hypergraph, he);
+          if ( !scanned_net[net] ) {
+            scanned_net[net] = true;
+            net_order.push_back(he);
+            if ( hypergraph.edgeSize(he) <= MAX_EXPANDED_NET_SIZE ) {
+              for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+                visit(pin);
+              }
+            }
+          }
+        }
+      }
+    }
+    // Nets without pins are not reached by the BFS
+    for ( const HyperedgeID& he : hypergraph.edges() ) {
+      const HyperedgeID net = netID(hypergraph, he);
+      if ( !scanned_net[net] ) {
+        scanned_net[net] = true;
+        net_order.push_back(he);
+      }
+    }
+    ASSERT(node_order.size() == num_nodes);
+    ASSERT(net_order.size() == num_edges);
+
+    HyperedgeVector edge_vector(num_edges);
+    vec<HyperedgeWeight> edge_weights(num_edges, 0);
+    tbb::parallel_for(ID(0), num_edges, [&](const HyperedgeID& new_he) {
+      const HyperedgeID he = net_order[new_he];
+      edge_weights[new_he] = hypergraph.edgeWeight(he);
+      edge_vector[new_he].reserve(hypergraph.edgeSize(he));
+      for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+        edge_vector[new_he].push_back(_new_id[pin]);
+      }
+    });
+    vec<HypernodeWeight> node_weights(num_nodes, 0);
+    tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID& new_hn) {
+      node_weights[new_hn] = hypergraph.nodeWeight(node_order[new_hn]);
+    });
+
+    Hypergraph reordered_hypergraph = HypergraphFactory::construct(num_nodes, num_edges,
+      edge_vector, edge_weights.data(), node_weights.data(), true);
+    if ( hypergraph.hasFixedVertices() ) {
+      for ( const HypernodeID& hn : hypergraph.nodes() ) {
+        if ( hypergraph.isFixed(hn) ) {
+          reordered_hypergraph.fixToBlock(_new_id[hn], hypergraph.fixedVertexBlock(hn));
+        }
+      }
+    }
+    return reordered_hypergraph;
+  }
+
+  // ! Maps the partition of the reordered hypergraph back onto the input hypergraph
+  PartitionedHypergraph restorePartition(Hypergraph& hypergraph,
+                                         const PartitionedHypergraph& reordered_phg) const {
+    ASSERT(_new_id.size() == hypergraph.initialNumNodes());
+    PartitionedHypergraph partitioned_hg(reordered_phg.k(), hypergraph, parallel_tag_t());
+    hypergraph.doParallelForAllNodes([&](const HypernodeID& hn) {
+      partitioned_hg.setOnlyNodePart(hn, reordered_phg.partID(_new_id[hn]));
+    });
+    partitioned_hg.initializePartition();
+    return partitioned_hg;
+  }
+
+  // ! Maps the block IDs of the vertices of the reordered hypergraph back to the input vertices
+  vec<PartitionID> restorePartition(const vec<PartitionID>& reordered_partition) const {
+    ASSERT(reordered_partition.size() == _new_id.size());
+    vec<PartitionID> partition(_new_id.size(), kInvalidPartition);
+    tbb::parallel_for(UL(0), _new_id.size(), [&](const size_t hn) {
+      partition[hn] = reordered_partition[_new_id[hn]];
+    });
+    return partition;
+  }
+
+ private:
+  // ! Both directions of an undirected edge of a graph are the same net
+  template<typename HyperGraph>
+  static HyperedgeID netID(const HyperGraph& hypergraph, const HyperedgeID he) {
+    if constexpr ( HyperGraph::is_graph ) {
+      return hypergraph.uniqueEdgeID(he);
+    } else {
+      unused(hypergraph);
+      return he;
+    }
+  }
+
+  template<typename HyperGraph>
+  static HyperedgeID numNets(const HyperGraph& hypergraph) {
+    if constexpr ( HyperGraph::is_graph ) {
+      return hypergraph.maxUniqueID();
+    } else {
+      return hypergraph.initialNumEdges();
+    }
+  }
+
+  // ! Maps each vertex of the input hypergraph to its vertex in the reordered hypergraph
+  vec<HypernodeID> _new_id;
+};
+
+}  // namespace mt_kahypar
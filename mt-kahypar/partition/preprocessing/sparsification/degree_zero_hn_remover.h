@@ -50,14 +50,21 @@ class DegreeZeroHypernodeRemover {
 
   // ! Remove all degree zero vertices
   HypernodeID removeDegreeZeroHypernodes(Hypergraph& hypergraph) {
+    return removeDegreeZeroHypernodes(hypergraph, hypergraph.nodes());
+  }
+
+  // ! Same as above, but only the given vertices (in increasing order of their IDs)
+  // ! are considered, e.g., if the degree-zero vertices are already known
+  template<typename Hypernodes>
+  HypernodeID removeDegreeZeroHypernodes(Hypergraph& hypergraph, Hypernodes&& hypernodes) {
     const HypernodeID current_num_nodes =
       hypergraph.initialNumNodes() - hypergraph.numRemovedHypernodes();
     HypernodeID num_removed_degree_zero_hypernodes = 0;
-    for ( const HypernodeID& hn : hypergraph.nodes()  ) {
+    for ( const HypernodeID& hn : hypernodes ) {
       if ( current_num_nodes - num_removed_degree_zero_hypernodes <= _context.coarsening.contraction_limit) {
         break;
       }
-      if ( hypergraph.nodeDegree(hn) == 0 ) {
+      if ( hypergraph.nodeDegree(hn) == 0 && !hypergraph.isFixed(hn) ) {
         hypergraph.removeDegreeZeroHypernode(hn);
         _removed_hns.push_back(hn);
         ++num_removed_degree_zero_hypernodes;
@@ -68,6 +75,35 @@ class DegreeZeroHypernodeRemover {
 
   // ! Restore degree-zero vertices
   void restoreDegreeZeroHypernodes(PartitionedHypergraph& hypergraph) {
+    binPacking(hypergraph,
+      [&](const PartitionID block) { return hypergraph.partWeight(block); },
+      [&](const HypernodeID hn, const PartitionID to) {
+        hypergraph.restoreDegreeZeroHypernode(hn, to);
+      });
+    _removed_hns.clear();
+  }
+
+  // ! Writes the blocks to which restoreDegreeZeroHypernodes(...) would assign
+  // ! the degree-zero vertices into the partition without restoring them
+  void assignDegreeZeroHypernodes(const PartitionedHypergraph& hypergraph,
+                                  vec<PartitionID>& partition) {
+    vec<HypernodeWeight> part_weights(_context.partition.k, 0);
+    for ( PartitionID block = 0; block < _context.partition.k; ++block ) {
+      part_weights[block] = hypergraph.partWeight(block);
+    }
+    binPacking(hypergraph,
+      [&](const PartitionID block) { return part_weights[block]; },
+      [&](const HypernodeID hn, const PartitionID to) {
+        partition[hn] = to;
+        part_weights[to] += hypergraph.nodeWeight(hn);
+      });
+  }
+
+ private:
+  template<typename PartWeightFunc, typename AssignFunc>
+  void binPacking(const PartitionedHypergraph& hypergraph,
+                  const PartWeightFunc& part_weight,
+                  const AssignFunc& assign) {
     // Sort degree-zero vertices in decreasing order of their weight
     tbb::parallel_sort(_removed_hns.begin(), _removed_hns.end(),
       [&](const HypernodeID& lhs, const HypernodeID& rhs) {
@@ -76,7 +112,7 @@ class DegreeZeroHypernodeRemover {
       });
     // Sort blocks of partition in increasing order of their weight
     auto distance_to_max = [&](const PartitionID block) {
-      return hypergraph.partWeight(block) - _context.partition.max_part_weights[block];
+      return part_weight(block) - _context.partition.max_part_weights[block];
     };
     parallel::scalable_vector<PartitionID> blocks(_context.partition.k, 0);
     std::iota(blocks.begin(), blocks.end(), 0);
@@ -88,7 +124,7 @@ class DegreeZeroHypernodeRemover {
     // Perform Bin-Packing
     for ( const HypernodeID& hn : _removed_hns ) {
       PartitionID to = blocks.front();
-      hypergraph.restoreDegreeZeroHypernode(hn, to);
+      assign(hn, to);
       PartitionID i = 0;
       while ( i + 1 < _context.partition.k &&
               distance_to_max(blocks[i]) > distance_to_max(blocks[i + 1]) ) {
@@ -96,10 +132,8 @@ class DegreeZeroHypernodeRemover {
         ++i;
       }
     }
-    _removed_hns.clear();
   }
 
- private:
   const Context& _context;
   parallel::scalable_vector<HypernodeID> _removed_hns;
 };
@@ -48,9 +48,20 @@ class LargeHyperedgeRemover {
   // ! Removes large hyperedges from the hypergraph
   // ! Returns the number of removed large hyperedges.
   HypernodeID removeLargeHyperedges(Hypergraph& hypergraph) {
+    return removeLargeHyperedges(hypergraph, hypergraph.edges());
+  }
+
+  // ! Same as above, but only the given hyperedges (in increasing order of their IDs)
+  // ! are considered, e.g., if the large hyperedges are already known
+  template<typename Hyperedges>
+  HypernodeID removeLargeHyperedges(Hypergraph& hypergraph, Hyperedges&& hyperedges) {
     HypernodeID num_removed_large_hyperedges = 0;
     #ifndef USE_GRAPH_PARTITIONER
-    for ( const HyperedgeID& he : hypergraph.edges() ) {
+    if ( _context.partition.large_hyperedge_pin_sample_size > 0 ) {
+      // Large hyperedges are kept and sampled during rating
+      return num_removed_large_hyperedges;
+    }
+    for ( const HyperedgeID& he : hyperedges ) {
       if ( hypergraph.edgeSize(he) > largeHyperedgeThreshold() ) {
         hypergraph.removeLargeEdge(he);
         _removed_hes.push_back(he);
@@ -60,6 +71,7 @@ class LargeHyperedgeRemover {
     std::reverse(_removed_hes.begin(), _removed_hes.end());
     #else
     unused(hypergraph);
+    unused(hyperedges);
     #endif
     return num_removed_large_hyperedges;
   }
@@ -0,0 +1,426 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_invoke.h"
+#include "tbb/parallel_sort.h"
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/parallel/parallel_prefix_sum.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/utils/hash.h"
+
+namespace mt_kahypar {
+
+/*!
+ * Merges similar nets of a hypergraph into one weighted net. Candidates are found
+ * via locality-sensitive hashing: the signature of a net combines several MinHash
+ * values of its pins, such that nets with a large Jaccard similarity are likely to
+ * have the same signature. Nets with the same signature are compared explicitly and
+ * a net is merged into the first net of its group whose Jaccard similarity is at
+ * least the configured threshold. The pins of a merged net are determined by the
+ * similar net combiner strategy and its weight is the sum of the weights of its nets.
+ * The sparsified hypergraph contains the same vertices as the input hypergraph,
+ * which is why a partition of one is also a partition of the other.
+ */
+class MinHashSparsifier {
+
+  static constexpr bool debug = false;
+  // ! Maximum number of nets to which a net is compared within a group
+  static constexpr size_t MAX_NUM_COMPARISONS = 16;
+
+  struct Signature {
+    uint64_t hash;
+    HyperedgeID he;
+  };
+
+  struct MergedNet {
+    HyperedgeID representative;
+    HyperedgeWeight weight;
+    size_t local_id;
+    size_t first_pin;
+    size_t size;
+  };
+
+ public:
+  MinHashSparsifier(const Context& context) :
+    _context(context) { }
+
+  MinHashSparsifier(const MinHashSparsifier&) = delete;
+  MinHashSparsifier & operator= (const MinHashSparsifier &) = delete;
+
+  MinHashSparsifier(MinHashSparsifier&&) = delete;
+  MinHashSparsifier & operator= (MinHashSparsifier &&) = delete;
+
+  // ! Merges similar nets of the hypergraph. Returns the number of removed nets.
+  // ! If it is greater than zero, sparsified_hypergraph contains the sparsified hypergraph.
+  HyperedgeID sparsify(const Hypergraph& hypergraph, Hypergraph& sparsified_hypergraph) {
+    #ifndef USE_GRAPH_PARTITIONER
+    if ( !Hypergraph::is_static_hypergraph || hypergraph.numRemovedHypernodes() > 0 ) {
+      // The sparsified hypergraph must contain the same vertex IDs
+      return 0;
+    }
+
+    const HyperedgeID num_edges = hypergraph.initialNumEdges();
+    const size_t num_hash_functions = std::max(UL(1), _context.coarsening.min_hash_num_hash_functions);
+    vec<Signature> signatures(num_edges, Signature { 0, kInvalidHyperedge });
+    hypergraph.doParallelForAllEdges([&](const HyperedgeID& he) {
+      if ( hypergraph.edgeSize(he) > 1 ) {
+        uint64_t hash = 0;
+        for ( size_t i = 0; i < num_hash_functions; ++i ) {
+          const uint64_t seed = hashing::integer::hash64(i + 1);
+          uint64_t min_hash = std::numeric_limits<uint64_t>::max();
+          for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+            min_hash = std::min(min_hash, hashing::integer::hash64(pin ^ seed));
+          }
+          hash = hashing::integer::combine64(hash, hashing::integer::hash64(min_hash));
+        }
+        signatures[he] = Signature { hash, he };
+      }
+    });
+    // Nets without a signature are moved to the end
+    tbb::parallel_sort(signatures.begin(), signatures.end(),
+      [&](const Signature& lhs, const Signature& rhs) {
+        return std::make_tuple(lhs.he == kInvalidHyperedge, lhs.hash, lhs.he) <
+          std::make_tuple(rhs.he == kInvalidHyperedge, rhs.hash, rhs.he);
+      });
+    const size_t num_candidates = std::partition_point(signatures.begin(), signatures.end(),
+      [&](const Signature& sig) { return sig.he != kInvalidHyperedge; }) - signatures.begin();
+
+    // Each group of nets with the same signature is processed by the thread
+    // that processes its first net
+    vec<HyperedgeID> representative(num_edges, kInvalidHyperedge);
+    tbb::enumerable_thread_specific<NetGroup> local_groups;
+    tbb::enumerable_thread_specific<MergedNets> local_merged_nets;
+    tbb::enumerable_thread_specific<HyperedgeID> num_removed_nets(0);
+    tbb::parallel_for(UL(0), num_candidates, [&](const size_t start) {
+      if ( start > 0 && signatures[start - 1].hash == signatures[start].hash ) {
+        return;
+      }
+      size_t end = start + 1;
+      while ( end < num_candidates && signatures[end].hash == signatures[start].hash ) {
+        ++end;
+      }
+      if ( end - start == 1 ) {
+        return;
+      }
+
+      NetGroup& group = local_groups.local();
+      group.clear();
+      for ( size_t i = start; i < end; ++i ) {
+        const HyperedgeID he = signatures[i].he;
+        group.sortPins(hypergraph, he);
+        bool merged = false;
+        const size_t first_class = group.classes.size() > MAX_NUM_COMPARISONS ?
+          group.classes.size() - MAX_NUM_COMPARISONS : 0;
+        for ( size_t c = first_class; c < group.classes.size(); ++c ) {
+          if ( group.jaccardSimilarity(group.classes[c]) >=
+               _context.coarsening.min_hash_similarity_threshold ) {
+            representative[he] = group.classes[c].representative;
+            group.members.emplace_back(c, he);
+            ++num_removed_nets.local();
+            merged = true;
+            break;
+          }
+        }
+        if ( merged ) {
+          group.discardPins();
+        } else {
+          group.addClass(he);
+        }
+      }
+      if ( !group.members.empty() ) {
+        combineNets(hypergraph, group, local_merged_nets.local());
+      }
+    });
+
+    const HyperedgeID num_removed = num_removed_nets.combine(std::plus<>());
+    DBG << "Merged" << num_removed << "similar nets";
+    if ( num_removed > 0 ) {
+      sparsified_hypergraph = constructSparsifiedHypergraph(
+        hypergraph, representative, local_merged_nets, num_removed);
+    }
+    return num_removed;
+    #else
+    unused(hypergraph);
+    unused(sparsified_hypergraph);
+    return 0;
+    #endif
+  }
+
+ private:
+  struct NetClass {
+    HyperedgeID representative;
+    // ! Range of the sorted pins of the representative in NetGroup::pins
+    size_t first_pin;
+    size_t size;
+  };
+
+  // ! Classes of similar nets of a group of nets with the same signature
+  struct NetGroup {
+    void clear() {
+      classes.clear();
+      pins.clear();
+      members.clear();
+    }
+
+    // ! Stores the sorted pins of he at the end of pins
+    void sortPins(const Hypergraph& hypergraph, const HyperedgeID he) {
+      current_first_pin = pins.size();
+      for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+        pins.push_back(pin);
+      }
+      std::sort(pins.begin() + current_first_pin, pins.end());
+    }
+
+    double jaccardSimilarity(const NetClass& net_class) const {
+      auto lhs = pins.begin() + net_class.first_pin;
+      const auto lhs_end = lhs + net_class.size;
+      auto rhs = pins.begin() + current_first_pin;
+      const auto rhs_end = pins.end();
+      const size_t union_size = net_class.size + (pins.size() - current_first_pin);
+      size_t intersection_size = 0;
+      while ( lhs != lhs_end && rhs != rhs_end ) {
+        if ( *lhs < *rhs ) {
+          ++lhs;
+        } else if ( *rhs < *lhs ) {
+          ++rhs;
+        } else {
+          ++intersection_size;
+          ++lhs;
+          ++rhs;
+        }
+      }
+      return static_cast<double>(intersection_size) /
+        static_cast<double>(union_size - intersection_size);
+    }
+
+    // ! Removes the pins of the net whose pins were sorted last
+    void discardPins() {
+      pins.resize(current_first_pin);
+    }
+
+    // ! Creates a new class for the net whose pins were sorted last
+    void addClass(const HyperedgeID he) {
+      classes.push_back(NetClass { he, current_first_pin, pins.size() - current_first_pin });
+    }
+
+    vec<NetClass> classes;
+    vec<HypernodeID> pins;
+    // ! Nets merged into a class (class index, net)
+    vec<std::pair<size_t, HyperedgeID>> members;
+    size_t current_first_pin = 0;
+  };
+
+  // ! Merged nets of a thread
+  struct MergedNets {
+    vec<MergedNet> nets;
+    vec<HypernodeID> pins;
+    // ! Temporary buffer for (pin, weight) pairs
+    vec<std::pair<HypernodeID, HyperedgeWeight>> weighted_pins;
+  };
+
+  // ! Computes the pins and weight of each class with at least two nets
+  // ! according to the similar net combiner strategy
+  void combineNets(const Hypergraph& hypergraph,
+                   NetGroup& group,
+                   MergedNets& merged_nets) {
+    std::sort(group.members.begin(), group.members.end());
+    const SimiliarNetCombinerStrategy strategy = _context.coarsening.similar_net_combiner_strategy;
+    for ( size_t i = 0; i < group.members.size(); ) {
+      const size_t c = group.members[i].first;
+      size_t end = i;
+      while ( end < group.members.size() && group.members[end].first == c ) {
+        ++end;
+      }
+      const NetClass& net_class = group.classes[c];
+      const HyperedgeID rep = net_class.representative;
+      HyperedgeWeight weight = hypergraph.edgeWeight(rep);
+      HyperedgeID largest_net = rep;
+      for ( size_t j = i; j < end; ++j ) {
+        const HyperedgeID he = group.members[j].second;
+        weight += hypergraph.edgeWeight(he);
+        if ( hypergraph.edgeSize(he) > hypergraph.edgeSize(largest_net) ) {
+          largest_net = he;
+        }
+      }
+
+      const size_t first_pin = merged_nets.pins.size();
+      if ( strategy == SimiliarNetCombinerStrategy::union_nets ) {
+        merged_nets.pins.insert(merged_nets.pins.end(),
+          group.pins.begin() + net_class.first_pin,
+          group.pins.begin() + net_class.first_pin + net_class.size);
+        for ( size_t j = i; j < end; ++j ) {
+          for ( const HypernodeID& pin : hypergraph.pins(group.members[j].second) ) {
+            merged_nets.pins.push_back(pin);
+          }
+        }
+        std::sort(merged_nets.pins.begin() + first_pin, merged_nets.pins.end());
+        merged_nets.pins.erase(std::unique(merged_nets.pins.begin() + first_pin,
+          merged_nets.pins.end()), merged_nets.pins.end());
+      } else if ( strategy == SimiliarNetCombinerStrategy::importance ) {
+        // Keeps the pins that are contained in nets with at least half of the total weight
+        auto& weighted_pins = merged_nets.weighted_pins;
+        weighted_pins.clear();
+        auto add_pins = [&](const HyperedgeID he) {
+          for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+            weighted_pins.emplace_back(pin, hypergraph.edgeWeight(he));
+          }
+        };
+        add_pins(rep);
+        for ( size_t j = i; j < end; ++j ) {
+          add_pins(group.members[j].second);
+        }
+        std::sort(weighted_pins.begin(), weighted_pins.end());
+        for ( size_t j = 0; j < weighted_pins.size(); ) {
+          HyperedgeWeight pin_weight = 0;
+          size_t k = j;
+          for ( ; k < weighted_pins.size() && weighted_pins[k].first == weighted_pins[j].first; ++k ) {
+            pin_weight += weighted_pins[k].second;
+          }
+          if ( 2 * pin_weight >= weight ) {
+            merged_nets.pins.push_back(weighted_pins[j].first);
+          }
+          j = k;
+        }
+      }
+      if ( strategy == SimiliarNetCombinerStrategy::max_size ||
+           merged_nets.pins.size() - first_pin < 2 ) {
+        merged_nets.pins.resize(first_pin);
+        for ( const HypernodeID& pin : hypergraph.pins(largest_net) ) {
+          merged_nets.pins.push_back(pin);
+        }
+      }
+      merged_nets.nets.push_back(MergedNet { rep, weight, 0, first_pin,
+        merged_nets.pins.size() - first_pin });
+      i = end;
+    }
+  }
+
+  #ifndef USE_GRAPH_PARTITIONER
+  Hypergraph constructSparsifiedHypergraph(const Hypergraph& hypergraph,
+                                           const vec<HyperedgeID>& representative,
+                                           tbb::enumerable_thread_specific<MergedNets>& local_merged_nets,
+                                           const HyperedgeID num_removed) {
+    const HypernodeID num_nodes = hypergraph.initialNumNodes();
+    const HyperedgeID num_edges = hypergraph.initialNumEdges();
+
+    // Maps each representative of a class with at least two nets to its merged net
+    vec<const MergedNets*> locals;
+    for ( const MergedNets& merged_nets : local_merged_nets ) {
+      locals.push_back(&merged_nets);
+    }
+    vec<MergedNet> merged_net_of(num_edges, MergedNet { kInvalidHyperedge, 0, 0, 0, 0 });
+    tbb::parallel_for(UL(0), locals.size(), [&](const size_t local_id) {
+      for ( MergedNet net : locals[local_id]->nets ) {
+        net.local_id = local_id;
+        merged_net_of[net.representative] = net;
+      }
+    });
+
+    // Compactify the IDs of the remaining nets
+    vec<HyperedgeID> he_mapping(num_edges + 1, 0);
+    hypergraph.doParallelForAllEdges([&](const HyperedgeID& he) {
+      he_mapping[he + 1] = representative[he] == kInvalidHyperedge;
+    });
+    parallel_prefix_sum(he_mapping.begin(), he_mapping.end(),
+      he_mapping.begin(), std::plus<HyperedgeID>(), 0);
+    const HyperedgeID num_sparsified_edges = he_mapping.back();
+    ASSERT(num_sparsified_edges + num_removed == num_edges - hypergraph.numRemovedHyperedges());
+    unused(num_removed);
+
+    parallel::scalable_vector<size_t> pin_offsets(num_sparsified_edges + 1, 0);
+    vec<HyperedgeWeight> hyperedge_weight(num_sparsified_edges);
+    vec<HypernodeWeight> hypernode_weight(num_nodes);
+    tbb::parallel_invoke([&] {
+      hypergraph.doParallelForAllEdges([&](const HyperedgeID& he) {
+        if ( representative[he] == kInvalidHyperedge ) {
+          const MergedNet& merged_net = merged_net_of[he];
+          const bool is_merged = merged_net.representative != kInvalidHyperedge;
+          hyperedge_weight[he_mapping[he]] = is_merged ? merged_net.weight : hypergraph.edgeWeight(he);
+          pin_offsets[he_mapping[he] + 1] = is_merged ? merged_net.size : hypergraph.edgeSize(he);
+        }
+      });
+      parallel_prefix_sum(pin_offsets.begin(), pin_offsets.end(),
+        pin_offsets.begin(), std::plus<size_t>(), UL(0));
+    }, [&] {
+      hypergraph.doParallelForAllNodes([&](const HypernodeID& hn) {
+        hypernode_weight[hn] = hypergraph.nodeWeight(hn);
+      });
+    });
+
+    ds::Array<HypernodeID> incidence_array;
+    incidence_array.resize(pin_offsets.back());
+    hypergraph.doParallelForAllEdges([&](const HyperedgeID& he) {
+      if ( representative[he] == kInvalidHyperedge ) {
+        size_t pos = pin_offsets[he_mapping[he]];
+        const MergedNet& merged_net = merged_net_of[he];
+        if ( merged_net.representative != kInvalidHyperedge ) {
+          const vec<HypernodeID>& pins = locals[merged_net.local_id]->pins;
+          for ( size_t i = 0; i < merged_net.size; ++i ) {
+            incidence_array[pos++] = pins[merged_net.first_pin + i];
+          }
+        } else {
+          for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+            incidence_array[pos++] = pin;
+          }
+        }
+        ASSERT(pos == pin_offsets[he_mapping[he] + 1]);
+      }
+    });
+
+    Hypergraph sparsified_hypergraph = HypergraphFactory::construct_from_incidence_array(
+      num_nodes, num_sparsified_edges, pin_offsets, std::move(incidence_array),
+      hyperedge_weight.data(), hypernode_weight.data(),
+      _context.preprocessing.stable_construction_of_incident_edges);
+    hypergraph.doParallelForAllNodes([&](const HypernodeID& hn) {
+      sparsified_hypergraph.setCommunityID(hn, hypergraph.communityID(hn));
+    });
+    if ( hypergraph.hasFixedVertices() ) {
+      for ( const HypernodeID& hn : hypergraph.nodes() ) {
+        if ( hypergraph.isFixed(hn) ) {
+          sparsified_hypergraph.fixToBlock(hn, hypergraph.fixedVertexBlock(hn));
+        }
+      }
+    }
+    return sparsified_hypergraph;
+  }
+  #endif
+
+  const Context& _context;
+};
+
+}  // namespace mt_kahypar
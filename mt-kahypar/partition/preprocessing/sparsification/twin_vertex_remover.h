@@ -0,0 +1,232 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2020 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <algorithm>
+#include <tuple>
+
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/utils/hash.h"
+
+namespace mt_kahypar {
+
+/*!
+ * Merges vertices with identical sets of incident nets (twins) into one weighted
+ * vertex before coarsening. Twins are found by sorting the vertices by a
+ * fingerprint of their incident nets. Vertices with the same fingerprint are
+ * compared explicitly to exclude hash collisions. The reduced hypergraph is
+ * obtained by contracting the twin classes, which also removes nets that become
+ * single-pin nets and merges identical nets. After partitioning, the partition
+ * of the reduced hypergraph is projected back onto the input hypergraph.
+ */
+class TwinVertexRemover {
+
+  static constexpr bool debug = false;
+
+  struct Fingerprint {
+    uint64_t hash;
+    HypernodeID hn;
+  };
+
+ public:
+  TwinVertexRemover(const Context& context) :
+    _context(context),
+    _communities() { }
+
+  TwinVertexRemover(const TwinVertexRemover&) = delete;
+  TwinVertexRemover & operator= (const TwinVertexRemover &) = delete;
+
+  TwinVertexRemover(TwinVertexRemover&&) = delete;
+  TwinVertexRemover & operator= (TwinVertexRemover &&) = delete;
+
+  // ! Merges twins as long as the weight of a merged vertex does not exceed the maximum
+  // ! allowed node weight. Fixed vertices are not merged. Returns the number of removed
+  // ! vertices. If it is greater than zero, reduced_hypergraph contains the reduced hypergraph.
+  HypernodeID removeTwinVertices(Hypergraph& hypergraph, Hypergraph& reduced_hypergraph) {
+    if ( Hypergraph::is_graph || !Hypergraph::is_static_hypergraph ) {
+      // Vertices of a graph are never incident to the same edges and
+      // the dynamic hypergraph does not support contracting a clustering
+      return 0;
+    }
+
+    const HypernodeID num_nodes = hypergraph.initialNumNodes();
+    _communities.assign(num_nodes, 0);
+    tbb::parallel_for(ID(0), num_nodes, [&](const HypernodeID& hn) {
+      _communities[hn] = hn;
+    });
+
+    // The fingerprint of a vertex does not depend on the order of its incident nets
+    vec<Fingerprint> fingerprints(num_nodes, Fingerprint { 0, kInvalidHypernode });
+    hypergraph.doParallelForAllNodes([&](const HypernodeID& hn) {
+      if ( hypergraph.nodeDegree(hn) > 0 && !hypergraph.isFixed(hn) ) {
+        uint64_t hash = hashing::integer::hash64(hypergraph.nodeDegree(hn));
+        for ( const HyperedgeID& he : hypergraph.incidentEdges(hn) ) {
+          hash += hashing::integer::hash64(he);
+        }
+        fingerprints[hn] = Fingerprint { hash, hn };
+      }
+    });
+    // Vertices without a fingerprint are moved to the end
+    tbb::parallel_sort(fingerprints.begin(), fingerprints.end(),
+      [&](const Fingerprint& lhs, const Fingerprint& rhs) {
+        return std::make_tuple(lhs.hn == kInvalidHypernode, lhs.hash, lhs.hn) <
+          std::make_tuple(rhs.hn == kInvalidHypernode, rhs.hash, rhs.hn);
+      });
+    const size_t num_candidates = std::partition_point(fingerprints.begin(), fingerprints.end(),
+      [&](const Fingerprint& fp) { return fp.hn != kInvalidHypernode; }) - fingerprints.begin();
+
+    // Each group of vertices with the same fingerprint is processed by the thread
+    // that processes its first vertex
+    tbb::enumerable_thread_specific<HypernodeID> num_removed_twins(0);
+    tbb::enumerable_thread_specific<TwinClasses> local_twin_classes;
+    const HypernodeWeight max_node_weight = _context.coarsening.max_allowed_node_weight;
+    tbb::parallel_for(UL(0), num_candidates, [&](const size_t start) {
+      if ( start > 0 && fingerprints[start - 1].hash == fingerprints[start].hash ) {
+        return;
+      }
+      size_t end = start + 1;
+      while ( end < num_candidates && fingerprints[end].hash == fingerprints[start].hash ) {
+        ++end;
+      }
+      if ( end - start == 1 ) {
+        return;
+      }
+
+      TwinClasses& twin_classes = local_twin_classes.local();
+      twin_classes.clear();
+      for ( size_t i = start; i < end; ++i ) {
+        const HypernodeID hn = fingerprints[i].hn;
+        const HypernodeWeight weight = hypergraph.nodeWeight(hn);
+        twin_classes.sortIncidentNets(hypergraph, hn);
+        bool merged = false;
+        for ( TwinClass& twin_class : twin_classes.classes ) {
+          if ( twin_classes.hasSameIncidentNets(twin_class) ) {
+            if ( twin_class.weight + weight <= max_node_weight ) {
+              _communities[hn] = twin_class.representative;
+              twin_class.weight += weight;
+              ++num_removed_twins.local();
+            } else {
+              // The class is (almost) full => subsequent twins start a new class
+              twin_class.representative = hn;
+              twin_class.weight = weight;
+            }
+            merged = true;
+            break;
+          }
+        }
+        if ( merged ) {
+          twin_classes.discardIncidentNets();
+        } else {
+          twin_classes.addClass(hn, weight);
+        }
+      }
+    });
+
+    const HypernodeID num_removed = num_removed_twins.combine(std::plus<>());
+    DBG << "Found" << num_removed << "twin vertices";
+    if ( num_removed > 0 ) {
+      reduced_hypergraph = hypergraph.contract(_communities, _context.coarsening.low_memory_contraction);
+      hypergraph.freeTmpContractionBuffer();
+    } else {
+      _communities.clear();
+    }
+    return num_removed;
+  }
+
+  // ! Projects the partition of the reduced hypergraph onto the input hypergraph
+  PartitionedHypergraph restoreTwinVertices(Hypergraph& hypergraph,
+                                            const PartitionedHypergraph& reduced_phg) {
+    ASSERT(_communities.size() == hypergraph.initialNumNodes());
+    PartitionedHypergraph partitioned_hg(_context.partition.k, hypergraph, parallel_tag_t());
+    hypergraph.doParallelForAllNodes([&](const HypernodeID& hn) {
+      ASSERT(_communities[hn] != kInvalidHypernode);
+      partitioned_hg.setOnlyNodePart(hn, reduced_phg.partID(_communities[hn]));
+    });
+    partitioned_hg.initializePartition();
+    return partitioned_hg;
+  }
+
+ private:
+  struct TwinClass {
+    HypernodeID representative;
+    HypernodeWeight weight;
+    // ! Range of the sorted incident nets of the class in TwinClasses::nets
+    size_t first_net;
+    size_t degree;
+  };
+
+  // ! Twin classes of a group of vertices with the same fingerprint
+  struct TwinClasses {
+    void clear() {
+      classes.clear();
+      nets.clear();
+    }
+
+    // ! Stores the sorted incident nets of hn at the end of nets
+    void sortIncidentNets(const Hypergraph& hypergraph, const HypernodeID hn) {
+      current_first_net = nets.size();
+      for ( const HyperedgeID& he : hypergraph.incidentEdges(hn) ) {
+        nets.push_back(he);
+      }
+      std::sort(nets.begin() + current_first_net, nets.end());
+    }
+
+    bool hasSameIncidentNets(const TwinClass& twin_class) const {
+      return twin_class.degree == nets.size() - current_first_net &&
+        std::equal(nets.begin() + twin_class.first_net,
+                   nets.begin() + twin_class.first_net + twin_class.degree,
+                   nets.begin() + current_first_net);
+    }
+
+    // ! Removes the incident nets of the vertex whose nets were sorted last
+    void discardIncidentNets() {
+      nets.resize(current_first_net);
+    }
+
+    // ! Creates a new class for the vertex whose nets were sorted last
+    void addClass(const HypernodeID hn, const HypernodeWeight weight) {
+      classes.push_back(TwinClass { hn, weight, current_first_net, nets.size() - current_first_net });
+    }
+
+    vec<TwinClass> classes;
+    vec<HyperedgeID> nets;
+    size_t current_first_net = 0;
+  };
+
+  const Context& _context;
+  // ! Maps each vertex of the input hypergraph to its representative and,
+  // ! after contraction, to its vertex in the reduced hypergraph
+  parallel::scalable_vector<HypernodeID> _communities;
+};
+
+}  // namespace mt_kahypar
@@ -171,24 +171,58 @@ namespace tmp {
     return rb_context;
   }
 
-  // Takes a hypergraph partitioned into two blocks as input and then recursively
-  // partitions one block into (k1 - b0) blocks
+  // Restricts the multilevel hierarchy of the bipartitioned hypergraph to the extracted
+  // hypergraphs of the given blocks. Since each block is restricted separately, clusters
+  // that straddle the cut are split into one cluster per block.
+  vec<multilevel::CoarseningHierarchy> restrictHierarchy(const PartitionedHypergraph& phg,
+                                                         const multilevel::CoarseningHierarchy& hierarchy,
+                                                         const vec<PartitionID>& blocks,
+                                                         const vec<HypernodeID>& block_sizes,
+                                                         const vec<HypernodeID>& mapping) {
+    vec<multilevel::CoarseningHierarchy> restricted_hierarchies(blocks.size());
+    for ( size_t i = 0; i < blocks.size(); ++i ) {
+      restricted_hierarchies[i].assign(hierarchy.size(), vec<HypernodeID>(block_sizes[i]));
+    }
+    phg.doParallelForAllNodes([&](const HypernodeID& hn) {
+      const PartitionID block = phg.partID(hn);
+      for ( size_t i = 0; i < blocks.size(); ++i ) {
+        if ( block == blocks[i] ) {
+          ASSERT(mapping[hn] < block_sizes[i]);
+          for ( size_t level = 0; level < hierarchy.size(); ++level ) {
+            restricted_hierarchies[i][level][mapping[hn]] = hierarchy[level][hn];
+          }
+        }
+      }
+    });
+    return restricted_hierarchies;
+  }
+
+  // Takes a hypergraph partitioned into two blocks and the extracted hypergraph of one
+  // of its blocks as input and then recursively partitions the block into (k1 - b0) blocks
   void recursively_bipartition_block(PartitionedHypergraph& phg,
                                      const Context& context,
                                      const PartitionID block, const PartitionID k0, const PartitionID k1,
+                                     Hypergraph& rb_hg,
+                                     const vec<HypernodeID>& mapping,
                                      const OriginalHypergraphInfo& info,
-                                     const double degree_of_parallism);
+                                     const double degree_of_parallism,
+                                     multilevel::CoarseningHierarchy& hierarchy);
 
-  // Uses multilevel recursive bipartitioning to partition the given hypergraph into (k1 - k0) blocks
+  // Uses multilevel recursive bipartitioning to partition the given hypergraph into (k1 - k0) blocks.
+  // If enabled, the first levels of the multilevel hierarchy are contracted according to the given
+  // hierarchy (restricted from the bipartition of the parent call).
   void recursive_bipartitioning(PartitionedHypergraph& phg,
                                 const Context& context,
                                 const PartitionID k0, const PartitionID k1,
-                                const OriginalHypergraphInfo& info) {
+                                const OriginalHypergraphInfo& info,
+                                multilevel::CoarseningHierarchy& hierarchy) {
     // Multilevel Bipartitioning
     Hypergraph& hg = phg.hypergraph();
     Context b_context = setupBipartitioningContext(hg, context, info);
     DBG << "Multilevel Bipartitioning - Range = (" << k0 << "," << k1 << "), Epsilon =" << b_context.partition.epsilon;
-    PartitionedHypergraph bipartitioned_hg = multilevel::partition(hg, b_context);
+    const bool reuse_hierarchy = context.coarsening.reuse_hierarchy_in_rb;
+    PartitionedHypergraph bipartitioned_hg = reuse_hierarchy ?
+      multilevel::partitionWithHierarchy(hg, b_context, hierarchy) : multilevel::partition(hg, b_context);
     DBG << "Bipartitioning Result -"
         << "Objective =" << metrics::objective(bipartitioned_hg, context.partition.objective)
         << "Imbalance =" << metrics::imbalance(bipartitioned_hg, b_context)
@@ -216,22 +250,44 @@ namespace tmp {
     ASSERT(context.partition.k >= 2);
     PartitionID rb_k0 = context.partition.k / 2 + context.partition.k % 2;
     PartitionID rb_k1 = context.partition.k / 2;
+    const bool cut_net_splitting = context.partition.objective == Objective::km1;
     if ( rb_k0 >= 2 && rb_k1 >= 2 ) {
       // Both blocks of the bipartition must to be further partitioned into at least two blocks.
       DBG << "Current k = " << context.partition.k << "\n"
           << "Block" << block_0 << "is further partitioned into k =" << rb_k0 << "blocks\n"
           << "Block" << block_1 << "is further partitioned into k =" << rb_k1 << "blocks\n";
+      // Extracts both blocks with a single pass over the hypergraph
+      auto extracted_blocks = phg.extractAllBlocks(cut_net_splitting,
+        context.preprocessing.stable_construction_of_incident_edges);
+      vec<Hypergraph>& rb_hgs = extracted_blocks.first;
+      const auto& mapping = extracted_blocks.second;
+      vec<multilevel::CoarseningHierarchy> rb_hierarchies(2);
+      if ( reuse_hierarchy && !hierarchy.empty() ) {
+        rb_hierarchies = restrictHierarchy(phg, hierarchy, { block_0, block_1 },
+          { rb_hgs[block_0].initialNumNodes(), rb_hgs[block_1].initialNumNodes() }, mapping);
+        multilevel::CoarseningHierarchy().swap(hierarchy);
+      }
       tbb::task_group tg;
-      tg.run([&] { recursively_bipartition_block(phg, context, block_0, 0, rb_k0, info, 0.5); });
-      tg.run([&] { recursively_bipartition_block(phg, context, block_1, rb_k0, rb_k0 + rb_k1, info, 0.5); });
+      tg.run([&] { recursively_bipartition_block(phg, context, block_0, 0, rb_k0,
+        rb_hgs[block_0], mapping, info, 0.5, rb_hierarchies[0]); });
+      tg.run([&] { recursively_bipartition_block(phg, context, block_1, rb_k0, rb_k0 + rb_k1,
+        rb_hgs[block_1], mapping, info, 0.5, rb_hierarchies[1]); });
       tg.wait();
     } else if ( rb_k0 >= 2 ) {
       ASSERT(rb_k1 < 2);
       // Only the first block needs to be further partitioned into at least two blocks.
       DBG << "Current k = " << context.partition.k << "\n"
           << "Block" << block_0 << "is further partitioned into k =" << rb_k0 << "blocks\n";
-      recursively_bipartition_block(phg, context,
-        block_0, 0, rb_k0, info, 1.0);
+      auto copy_hypergraph = phg.extract(block_0, cut_net_splitting,
+        context.preprocessing.stable_construction_of_incident_edges);
+      vec<multilevel::CoarseningHierarchy> rb_hierarchies(1);
+      if ( reuse_hierarchy && !hierarchy.empty() ) {
+        rb_hierarchies = restrictHierarchy(phg, hierarchy, { block_0 },
+          { copy_hypergraph.first.initialNumNodes() }, copy_hypergraph.second);
+        multilevel::CoarseningHierarchy().swap(hierarchy);
+      }
+      recursively_bipartition_block(phg, context, block_0, 0, rb_k0,
+        copy_hypergraph.first, copy_hypergraph.second, info, 1.0, rb_hierarchies[0]);
     }
   }
 }
@@ -239,20 +295,17 @@ namespace tmp {
 void tmp::recursively_bipartition_block(PartitionedHypergraph& phg,
                                         const Context& context,
                                         const PartitionID block, const PartitionID k0, const PartitionID k1,
+                                        Hypergraph& rb_hg,
+                                        const vec<HypernodeID>& mapping,
                                         const OriginalHypergraphInfo& info,
-                                        const double degree_of_parallism) {
+                                        const double degree_of_parallism,
+                                        multilevel::CoarseningHierarchy& hierarchy) {
   Context rb_context = setupRecursiveBipartitioningContext(context, k0, k1, degree_of_parallism);
-  // Extracts the block of the hypergraph which we recursively want to partition
-  bool cut_net_splitting = context.partition.objective == Objective::km1;
-  auto copy_hypergraph = phg.extract(block, cut_net_splitting,
-    context.preprocessing.stable_construction_of_incident_edges);
-  Hypergraph& rb_hg = copy_hypergraph.first;
-  auto& mapping = copy_hypergraph.second;
 
   if ( rb_hg.initialNumNodes() > 0 ) {
     // Recursively partition the given block into (k1 - k0) blocks
     PartitionedHypergraph rb_phg(rb_context.partition.k, rb_hg, parallel_tag_t());
-    recursive_bipartitioning(rb_phg, rb_context, k0, k1, info);
+    recursive_bipartitioning(rb_phg, rb_context, k0, k1, info, hierarchy);
 
     ASSERT(phg.initialNumNodes() == mapping.size());
     // Apply k-way partition to the input hypergraph
@@ -295,8 +348,10 @@ namespace recursive_bipartitioning {
       utils.getStats(context.utility_id).disable();
     }
 
+    multilevel::CoarseningHierarchy hierarchy;
     tmp::recursive_bipartitioning(hypergraph, context, 0, context.partition.k,
-      OriginalHypergraphInfo { hypergraph.totalWeight(), context.partition.k, context.partition.epsilon });
+      OriginalHypergraphInfo { hypergraph.totalWeight(), context.partition.k, context.partition.epsilon },
+      hierarchy);
 
     if (context.type == ContextType::main) {
       parallel::MemoryPool::instance().activate_unused_memory_allocations();
@@ -0,0 +1,281 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "mt-kahypar/partition/refinement/deterministic/deterministic_fm_refiner.h"
+
+#include <algorithm>
+
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_scan.h"
+
+#include "mt-kahypar/parallel/chunking.h"
+#include "mt-kahypar/parallel/parallel_prefix_sum.h"
+#include "mt-kahypar/partition/metrics.h"
+#include "mt-kahypar/partition/refinement/fm/stop_rule.h"
+#include "mt-kahypar/utils/timer.h"
+#include "mt-kahypar/utils/utilities.h"
+
+namespace mt_kahypar {
+
+  namespace {
+    // ! Orders the PQ by gain and prefers the smaller vertex ID on ties
+    bool hasLowerPriority(const std::pair<Gain, HypernodeID>& lhs,
+                          const std::pair<Gain, HypernodeID>& rhs) {
+      return lhs.first < rhs.first || ( lhs.first == rhs.first && lhs.second > rhs.second );
+    }
+  }
+
+  bool DeterministicFMRefiner::refineImpl(PartitionedHypergraph& phg,
+                                          const vec<HypernodeID>& refinement_nodes,
+                                          Metrics& best_metrics,
+                                          const double) {
+    const bool update_gain_cache = _context.forceGainCacheUpdates() && phg.isGainCacheInitialized();
+    const size_t seeds_per_search = std::max(_context.refinement.fm.num_seed_nodes, UL(1));
+    vec<HypernodeWeight> initial_part_weights(_context.partition.k, 0);
+    utils::Timer& timer = utils::Utilities::instance().getTimer(_context.utility_id);
+
+    Gain overall_improvement = 0;
+    for ( size_t round = 0; round < _context.refinement.fm.multitry_rounds; ++round ) {
+      for ( PartitionID i = 0; i < _context.partition.k; ++i ) {
+        initial_part_weights[i] = phg.partWeight(i);
+      }
+
+      timer.start_timer("collect_border_nodes", "Collect Border Nodes");
+      collectSeeds(phg, refinement_nodes);
+      timer.stop_timer("collect_border_nodes");
+      if ( _seeds.empty() ) {
+        break;
+      }
+
+      timer.start_timer("find_moves", "Find Moves");
+      const SearchID num_searches = parallel::chunking::idiv_ceil(_seeds.size(), seeds_per_search);
+      if ( _search_moves.size() < num_searches ) {
+        _search_moves.resize(num_searches);
+      }
+      _num_moves_of_search.assign(num_searches, 0);
+      tbb::parallel_for(SearchID(0), num_searches, [&](const SearchID search_id) {
+        const auto [first, last] = parallel::chunking::bounds(search_id, _seeds.size(), seeds_per_search);
+        localSearch(phg, search_id, first, last);
+      });
+      timer.stop_timer("find_moves");
+
+      timer.start_timer("apply_moves", "Apply Moves");
+      const MoveID num_moves = resolveConflicts(num_searches);
+      phg.resetMoveState();
+      applyMoves(phg, num_searches, num_moves, update_gain_cache);
+      timer.stop_timer("apply_moves");
+
+      timer.start_timer("rollback", "Rollback to Best Solution");
+      phg.resetMoveState();
+      const HyperedgeWeight improvement = update_gain_cache ?
+        _global_rollback.revertToBestPrefix<true>(phg, _shared_data, initial_part_weights) :
+        _global_rollback.revertToBestPrefix<false>(phg, _shared_data, initial_part_weights);
+      timer.stop_timer("rollback");
+      overall_improvement += improvement;
+
+      DBG << V(round) << V(_seeds.size()) << V(num_searches) << V(num_moves) << V(improvement)
+          << V(best_metrics.km1 - overall_improvement);
+
+      if ( improvement <= 0 || _context.isCancelled() ) {
+        break;
+      }
+    }
+
+    best_metrics.km1 -= overall_improvement;
+    best_metrics.imbalance = metrics::imbalance(phg, _context);
+    HEAVY_REFINEMENT_ASSERT(best_metrics.km1 == metrics::km1(phg),
+      V(best_metrics.km1) << V(metrics::km1(phg)));
+    utils::Utilities::instance().getStats(_context.utility_id).update_stat(
+      "deterministic_fm_improvement", overall_improvement);
+    return overall_improvement > 0;
+  }
+
+  void DeterministicFMRefiner::collectSeeds(const PartitionedHypergraph& phg,
+                                            const vec<HypernodeID>& refinement_nodes) {
+    const size_t num_candidates = refinement_nodes.empty() ?
+      phg.initialNumNodes() : refinement_nodes.size();
+    _permutation.create_integer_permutation(num_candidates,
+      _context.shared_memory.static_balancing_work_packages, _prng);
+    auto candidate = [&](const size_t pos) {
+      const HypernodeID i = _permutation.at(pos);
+      return refinement_nodes.empty() ? i : refinement_nodes[i];
+    };
+
+    // Filter the border vertices without changing their order
+    _is_seed.assign(num_candidates, 0);
+    tbb::parallel_for(UL(0), num_candidates, [&](const size_t pos) {
+      const HypernodeID u = candidate(pos);
+      _is_seed[pos] = phg.nodeIsEnabled(u) && phg.isBorderNode(u) && !phg.isFixed(u) &&
+        phg.nodeDegree(u) < PartitionedHypergraph::HIGH_DEGREE_THRESHOLD;
+    });
+    parallel::TBBPrefixSum<size_t> seed_prefix_sum(_is_seed);
+    tbb::parallel_scan(tbb::blocked_range<size_t>(UL(0), num_candidates), seed_prefix_sum);
+    _seeds.resize(seed_prefix_sum.total_sum());
+    tbb::parallel_for(UL(0), num_candidates, [&](const size_t pos) {
+      if ( seed_prefix_sum.value(pos) ) {
+        _seeds[seed_prefix_sum[pos]] = candidate(pos);
+      }
+    });
+  }
+
+  void DeterministicFMRefiner::localSearch(PartitionedHypergraph& phg,
+                                           const SearchID search_id,
+                                           const size_t first,
+                                           const size_t last) {
+    LocalSearch& search = _ets_search.local();
+    DeltaPartitionedHypergraph& delta_phg = search.delta_phg;
+    vec<Move>& moves = _search_moves[search_id];
+    moves.clear();
+    delta_phg.setPartitionedHypergraph(&phg);
+    search.startNewSearch();
+    for ( size_t i = first; i < last; ++i ) {
+      insertIntoPQ(phg, search, _seeds[i]);
+    }
+
+    StopRule stop_rule(phg.initialNumNodes());
+    Gain estimated_improvement = 0;
+    Gain best_improvement = 0;
+    size_t best_index = 0;
+    while ( !search.pq.empty() && !stop_rule.searchShouldStop() ) {
+      std::pop_heap(search.pq.begin(), search.pq.end(), hasLowerPriority);
+      const auto [expected_gain, u] = search.pq.back();
+      search.pq.pop_back();
+
+      const auto [to, gain] = search.gain_computer.computeBestTargetBlock(
+        delta_phg, u, _context.partition.max_part_weights);
+      if ( to == kInvalidPartition ) {
+        continue;
+      } else if ( gain < expected_gain ) {
+        // Gain decreased since u was inserted => reinsert
+        search.pq.emplace_back(gain, u);
+        std::push_heap(search.pq.begin(), search.pq.end(), hasLowerPriority);
+        continue;
+      }
+
+      const PartitionID from = delta_phg.partID(u);
+      if ( delta_phg.changeNodePart(u, from, to, _context.partition.max_part_weights[to]) ) {
+        moves.push_back(Move { from, to, u, gain });
+        estimated_improvement += gain;
+        stop_rule.update(gain);
+        if ( estimated_improvement > best_improvement ) {
+          best_improvement = estimated_improvement;
+          best_index = moves.size();
+          stop_rule.reset();
+        }
+
+        for ( const HyperedgeID& he : phg.incidentEdges(u) ) {
+          if ( phg.edgeSize(he) < _context.partition.ignore_hyperedge_size_threshold ) {
+            for ( const HypernodeID& pin : phg.pins(he) ) {
+              insertIntoPQ(phg, search, pin);
+            }
+          }
+        }
+      }
+    }
+
+    moves.resize(best_index);
+    delta_phg.clear();
+  }
+
+  void DeterministicFMRefiner::insertIntoPQ(const PartitionedHypergraph& phg,
+                                            LocalSearch& search,
+                                            const HypernodeID u) {
+    if ( !phg.isFixed(u) && phg.nodeDegree(u) < PartitionedHypergraph::HIGH_DEGREE_THRESHOLD &&
+         search.touch(u) ) {
+      const auto [to, gain] = search.gain_computer.computeBestTargetBlock(
+        search.delta_phg, u, _context.partition.max_part_weights);
+      if ( to != kInvalidPartition ) {
+        search.pq.emplace_back(gain, u);
+        std::push_heap(search.pq.begin(), search.pq.end(), hasLowerPriority);
+      }
+    }
+  }
+
+  MoveID DeterministicFMRefiner::resolveConflicts(const SearchID num_searches) {
+    tbb::parallel_for(SearchID(0), num_searches, [&](const SearchID search_id) {
+      for ( const Move& m : _search_moves[search_id] ) {
+        SearchID current = _search_of_node[m.node].load(std::memory_order_relaxed);
+        while ( search_id < current && !_search_of_node[m.node].compare_exchange_weak(
+                  current, search_id, std::memory_order_relaxed) ) { }
+      }
+    });
+
+    // Truncate each move sequence before its first vertex owned by another search
+    // and keep the best prefix (w.r.t. the estimated gains) of the remaining moves
+    tbb::parallel_for(SearchID(0), num_searches, [&](const SearchID search_id) {
+      const vec<Move>& moves = _search_moves[search_id];
+      Gain estimated_improvement = 0;
+      Gain best_improvement = 0;
+      MoveID best_index = 0;
+      for ( MoveID i = 0; i < moves.size(); ++i ) {
+        if ( _search_of_node[moves[i].node].load(std::memory_order_relaxed) != search_id ) {
+          break;
+        }
+        estimated_improvement += moves[i].gain;
+        if ( estimated_improvement > best_improvement ) {
+          best_improvement = estimated_improvement;
+          best_index = i + 1;
+        }
+      }
+      _num_moves_of_search[search_id] = best_index;
+    });
+
+    tbb::parallel_for(SearchID(0), num_searches, [&](const SearchID search_id) {
+      for ( const Move& m : _search_moves[search_id] ) {
+        _search_of_node[m.node].store(NO_SEARCH, std::memory_order_relaxed);
+      }
+    });
+
+    parallel::TBBPrefixSum<MoveID> move_prefix_sum(_num_moves_of_search);
+    tbb::parallel_scan(tbb::blocked_range<size_t>(UL(0), num_searches), move_prefix_sum);
+    return move_prefix_sum.total_sum();
+  }
+
+  void DeterministicFMRefiner::applyMoves(PartitionedHypergraph& phg,
+                                          const SearchID num_searches,
+                                          const MoveID num_moves,
+                                          const bool update_gain_cache) {
+    // _num_moves_of_search contains the inclusive prefix sum of the number of moves
+    parallel::TBBPrefixSum<MoveID> move_prefix_sum(_num_moves_of_search);
+    GlobalMoveTracker& tracker = _shared_data.moveTracker;
+    tbb::parallel_for(SearchID(0), num_searches, [&](const SearchID search_id) {
+      const vec<Move>& moves = _search_moves[search_id];
+      const MoveID first_move = move_prefix_sum[search_id];
+      for ( MoveID i = 0; i < move_prefix_sum.value(search_id); ++i ) {
+        const Move& m = moves[i];
+        ASSERT(phg.partID(m.node) == m.from);
+        if ( update_gain_cache ) {
+          phg.changeNodePartWithGainCacheUpdate(m.node, m.from, m.to);
+        } else {
+          phg.changeNodePart(m.node, m.from, m.to);
+        }
+        tracker.insertMoveAt(m, first_move + i);
+      }
+    });
+    tracker.commitMoves(num_moves);
+  }
+
+}  // namespace mt_kahypar
@@ -0,0 +1,172 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/refinement/i_refiner.h"
+#include "mt-kahypar/partition/refinement/fm/fm_commons.h"
+#include "mt-kahypar/partition/refinement/fm/global_rollback.h"
+#include "mt-kahypar/partition/refinement/fm/strategies/km1_gains.h"
+#include "mt-kahypar/utils/reproducible_random.h"
+
+namespace mt_kahypar {
+
+/*!
+ * Localized FM whose result does not depend on the number of threads or the
+ * thread schedule. Each round consists of the following steps:
+ *  1) The border vertices are shuffled with a seeded permutation and split into
+ *     consecutive groups of fm.num_seed_nodes vertices. Each group is the seed set
+ *     of one localized search. Thus, the searches only depend on the permutation.
+ *  2) All searches run in parallel on their own delta partition on top of the
+ *     partition at the beginning of the round, which is not modified during this
+ *     step. Each search returns its best move prefix.
+ *  3) A vertex moved by several searches is assigned to the search with the
+ *     smallest ID. The other searches truncate their prefix before the vertex.
+ *  4) The remaining prefixes are concatenated in the order of the search IDs,
+ *     applied to the partition and the global rollback reverts to the best
+ *     balanced prefix of this move sequence based on the exact gains.
+ */
+class DeterministicFMRefiner final : public IRefiner {
+
+  static constexpr bool debug = false;
+  static constexpr bool enable_heavy_assert = false;
+
+  static constexpr SearchID NO_SEARCH = std::numeric_limits<SearchID>::max();
+
+  using PQElement = std::pair<Gain, HypernodeID>;
+
+  // ! Data of the localized search running on a thread
+  struct LocalSearch {
+    LocalSearch(const Context& context, const HypernodeID num_nodes) :
+      delta_phg(context),
+      gain_computer(context),
+      pq(),
+      last_touched(num_nodes, 0),
+      timestamp(0) { }
+
+    // ! Returns true, if u was not touched by the current search before
+    bool touch(const HypernodeID u) {
+      if ( last_touched[u] != timestamp ) {
+        last_touched[u] = timestamp;
+        return true;
+      }
+      return false;
+    }
+
+    void startNewSearch() {
+      if ( ++timestamp == 0 ) {
+        last_touched.assign(last_touched.size(), 0);
+        timestamp = 1;
+      }
+      pq.clear();
+    }
+
+    DeltaPartitionedHypergraph delta_phg;
+    Km1GainComputer gain_computer;
+    // ! Binary max-heap ordered by gain (ties are broken by the smaller vertex ID)
+    vec<PQElement> pq;
+    vec<uint32_t> last_touched;
+    uint32_t timestamp;
+  };
+
+ public:
+  explicit DeterministicFMRefiner(Hypergraph& hypergraph,
+                                  const Context& context) :
+    _context(context),
+    _prng(context.partition.seed),
+    _permutation(),
+    _seeds(),
+    _is_seed(),
+    _search_moves(),
+    _num_moves_of_search(),
+    _search_of_node(hypergraph.initialNumNodes(), CAtomic<SearchID>(NO_SEARCH)),
+    _ets_search([&context, num_nodes = hypergraph.initialNumNodes()] {
+      return LocalSearch(context, num_nodes);
+    }),
+    _shared_data(),
+    _global_rollback(hypergraph, context) {
+    _shared_data.moveTracker.moveOrder.resize(hypergraph.initialNumNodes());
+    _shared_data.moveTracker.moveOfNode.resize(hypergraph.initialNumNodes(), 0);
+  }
+
+  DeterministicFMRefiner(const DeterministicFMRefiner&) = delete;
+  DeterministicFMRefiner(DeterministicFMRefiner&&) = delete;
+
+  DeterministicFMRefiner & operator= (const DeterministicFMRefiner &) = delete;
+  DeterministicFMRefiner & operator= (DeterministicFMRefiner &&) = delete;
+
+ private:
+  bool refineImpl(PartitionedHypergraph& phg,
+                  const vec<HypernodeID>& refinement_nodes,
+                  Metrics& best_metrics,
+                  double) final;
+
+  void initializeImpl(PartitionedHypergraph&) final { /* nothing to do */ }
+
+  // ! Stores the border vertices in the order of a seeded random permutation
+  void collectSeeds(const PartitionedHypergraph& phg,
+                    const vec<HypernodeID>& refinement_nodes);
+
+  // ! Runs a localized search initialized with the seeds in range [first, last)
+  // ! and stores its best move prefix in _search_moves[search_id]
+  void localSearch(PartitionedHypergraph& phg,
+                   const SearchID search_id,
+                   const size_t first,
+                   const size_t last);
+
+  void insertIntoPQ(const PartitionedHypergraph& phg, LocalSearch& search, const HypernodeID u);
+
+  // ! Assigns each moved vertex to the search with the smallest ID and truncates
+  // ! the move prefixes of the other searches. Returns the total number of moves.
+  MoveID resolveConflicts(const SearchID num_searches);
+
+  // ! Applies the remaining moves of all searches to the partition
+  // ! and stores them in the move tracker ordered by their search ID
+  void applyMoves(PartitionedHypergraph& phg,
+                  const SearchID num_searches,
+                  const MoveID num_moves,
+                  const bool update_gain_cache);
+
+  const Context& _context;
+  std::mt19937 _prng;
+  utils::ParallelPermutation<HypernodeID> _permutation;
+  vec<HypernodeID> _seeds;
+  vec<size_t> _is_seed;
+  // ! Best move prefix of each search
+  vec<vec<Move>> _search_moves;
+  // ! Number of moves of each search that survived the conflict resolution
+  vec<MoveID> _num_moves_of_search;
+  vec<CAtomic<SearchID>> _search_of_node;
+  tbb::enumerable_thread_specific<LocalSearch> _ets_search;
+  FMSharedData _shared_data;
+  GlobalRollback _global_rollback;
+};
+
+}  // namespace mt_kahypar
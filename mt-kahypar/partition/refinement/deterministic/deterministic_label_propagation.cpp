@@ -29,12 +29,29 @@
 #include "mt-kahypar/partition/metrics.h"
 #include "mt-kahypar/parallel/chunking.h"
 #include "mt-kahypar/parallel/parallel_counting_sort.h"
+#include "mt-kahypar/parallel/parallel_prefix_sum.h"
 
 #include <tbb/parallel_sort.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_reduce.h>
 
 namespace mt_kahypar {
 
+  // moves of one direction (from -> to) are stored in sorted_moves[begin, end).
+  // the moves in [begin, approved_end) are applied in the first apply function.
+  struct BlockPairMoves {
+    PartitionID from, to;
+    uint32_t begin, end, approved_end;
+  };
+
+  // the first a moves of one direction and the first b moves of the opposite direction
+  struct BlockPairPrefixes {
+    int64_t gain;
+    size_t a, b;
+  };
+
+  static constexpr size_t kInvalidDirection = std::numeric_limits<size_t>::max();
+
   bool DeterministicLabelPropagationRefiner::refineImpl(PartitionedHypergraph& phg,
                                                         const vec<HypernodeID>&,
                                                         Metrics& best_metrics,
@@ -161,7 +178,18 @@ namespace mt_kahypar {
     return tbb::parallel_reduce(range, 0, accum, std::plus<>());
   }
 
-  vec<HypernodeWeight> aggregatePartWeightDeltas(PartitionedHypergraph& phg, const vec<Move>& moves, size_t end) {
+  vec<HypernodeWeight> aggregatePartWeightDeltas(PartitionedHypergraph& phg, const vec<Move>& moves, size_t end,
+                                                 const size_t num_threads) {
+    if (static_cast<size_t>(phg.k()) * num_threads > end) {
+      // for large k, thread-local vectors are more expensive to combine than the moves to aggregate.
+      // the result is still deterministic since integer addition is commutative.
+      vec<HypernodeWeight> res(phg.k(), 0);
+      tbb::parallel_for(UL(0), end, [&](const size_t i) {
+        __atomic_fetch_sub(&res[moves[i].from], phg.nodeWeight(moves[i].node), __ATOMIC_RELAXED);
+        __atomic_fetch_add(&res[moves[i].to], phg.nodeWeight(moves[i].node), __ATOMIC_RELAXED);
+      });
+      return res;
+    }
     // parallel reduce makes way too many vector copies
     tbb::enumerable_thread_specific<vec< HypernodeWeight>>
     ets_part_weight_diffs(phg.k(), 0);
@@ -191,7 +219,8 @@ namespace mt_kahypar {
 
     const auto& max_part_weights = context.partition.max_part_weights;
     size_t num_overloaded_blocks = 0, num_overloaded_before_round = 0;
-    vec<HypernodeWeight> part_weights = aggregatePartWeightDeltas(phg, moves.getData(), num_moves);
+    vec<HypernodeWeight> part_weights = aggregatePartWeightDeltas(phg, moves.getData(), num_moves,
+                                                                   context.shared_memory.num_threads);
     for (PartitionID i = 0; i < phg.k(); ++i) {
       part_weights[i] += phg.partWeight(i);
       if (part_weights[i] > max_part_weights[i]) {
@@ -274,57 +303,121 @@ namespace mt_kahypar {
     return gain;
   }
 
-  Gain DeterministicLabelPropagationRefiner::applyMovesByMaximalPrefixesInBlockPairs(PartitionedHypergraph& phg) {
-    PartitionID k = phg.k();
-    PartitionID max_key = k * k;
-    auto index = [&](PartitionID b1, PartitionID b2) { return b1 * k + b2; };
-    auto get_key = [&](const Move& m) { return index(m.from, m.to); };
+  // Prefixes of the move sequences A and B (sorted by gain) with maximal summed gain such that the
+  // weight moved into the target block of A (B) exceeds the opposite direction by at most slack_A (slack_B).
+  // w_A[a - 1] and g_A[a - 1] contain the weight and gain sum of the first a moves of A (same for B).
+  // Since all moves have positive gain, it suffices to consider the longest feasible prefix of B
+  // for each prefix of A, which is found by binary search. Ties are broken deterministically.
+  BlockPairPrefixes selectBalancedPrefixes(const int64_t* w_A, const int64_t* g_A, const size_t len_A,
+                                           const int64_t* w_B, const int64_t* g_B, const size_t len_B,
+                                           const int64_t slack_A, const int64_t slack_B) {
+    auto better = [](const BlockPairPrefixes& lhs, const BlockPairPrefixes& rhs) {
+      return lhs.gain > rhs.gain || (lhs.gain == rhs.gain && (lhs.a + lhs.b < rhs.a + rhs.b ||
+        (lhs.a + lhs.b == rhs.a + rhs.b && lhs.a < rhs.a)));
+    };
+    auto best_in_range = [&](const tbb::blocked_range<size_t>& r, BlockPairPrefixes best) {
+      for (size_t a = r.begin(); a < r.end(); ++a) {
+        const int64_t weight_A = a == 0 ? 0 : w_A[a - 1];
+        const int64_t bound = weight_A + slack_B;
+        if (bound < 0) continue;
+        const size_t b = std::upper_bound(w_B, w_B + len_B, bound) - w_B;
+        const int64_t weight_B = b == 0 ? 0 : w_B[b - 1];
+        if (weight_A - weight_B <= slack_A) {
+          const BlockPairPrefixes candidate { (a == 0 ? 0 : g_A[a - 1]) + (b == 0 ? 0 : g_B[b - 1]), a, b };
+          if (better(candidate, best)) {
+            best = candidate;
+          }
+        }
+      }
+      return best;
+    };
+    return tbb::parallel_reduce(tbb::blocked_range<size_t>(UL(0), len_A + 1, 1024), BlockPairPrefixes { 0, 0, 0 },
+      best_in_range, [&](const BlockPairPrefixes& lhs, const BlockPairPrefixes& rhs) {
+        return better(rhs, lhs) ? rhs : lhs;
+      });
+  }
 
+  Gain DeterministicLabelPropagationRefiner::applyMovesByMaximalPrefixesInBlockPairs(PartitionedHypergraph& phg) {
+    const PartitionID k = phg.k();
     const size_t num_moves = moves.size();
+    if (weight_prefix_sums.size() < num_moves) {
+      weight_prefix_sums.resize(max_num_nodes);
+      gain_prefix_sums.resize(max_num_nodes);
+    }
 
-    // aggregate moves by direction. not in-place because of counting sort.
-    // but it gives us the positions of the buckets right away
-    auto positions = parallel::counting_sort(moves, sorted_moves, max_key, get_key,
+    // aggregate moves by source block (k buckets instead of k^2 buckets for each direction).
+    // not in-place because of counting sort, but it gives us the positions of the buckets right away.
+    auto get_key = [&](const Move& m) { return m.from; };
+    auto positions = parallel::counting_sort(moves, sorted_moves, k, get_key,
                                              context.shared_memory.num_threads);
 
-    auto has_moves = [&](PartitionID p1, PartitionID p2) {
-      size_t direction = index(p1, p2);
-      return positions[direction + 1] != positions[direction];
+    // sort the moves of each source block by target block and then by gain (alternative: gain / weight?)
+    tbb::parallel_for(PartitionID(0), k, [&](const PartitionID from) {
+      tbb::parallel_sort(sorted_moves.begin() + positions[from], sorted_moves.begin() + positions[from + 1],
+        [](const Move& m1, const Move& m2) {
+          return m1.to < m2.to || (m1.to == m2.to &&
+            (m1.gain > m2.gain || (m1.gain == m2.gain && m1.node < m2.node)));
+        });
+    });
+
+    // collect the directions (from, to) with at least one move, ordered by (from, to)
+    vec<uint32_t> first_direction(k + 1, 0);
+    tbb::parallel_for(PartitionID(0), k, [&](const PartitionID from) {
+      for (uint32_t pos = positions[from]; pos < positions[from + 1]; ++pos) {
+        first_direction[from + 1] += (pos == positions[from] || sorted_moves[pos].to != sorted_moves[pos - 1].to);
+      }
+    });
+    std::partial_sum(first_direction.begin(), first_direction.end(), first_direction.begin());
+    vec<BlockPairMoves> directions(first_direction[k]);
+    tbb::parallel_for(PartitionID(0), k, [&](const PartitionID from) {
+      uint32_t d = first_direction[from];
+      for (uint32_t pos = positions[from]; pos < positions[from + 1]; ++pos) {
+        if (pos == positions[from] || sorted_moves[pos].to != sorted_moves[pos - 1].to) {
+          directions[d++] = BlockPairMoves { from, sorted_moves[pos].to, pos, pos, pos };
+        }
+        ++directions[d - 1].end;
+      }
+    });
+    auto find_direction = [&](const PartitionID from, const PartitionID to) {
+      auto first = directions.begin() + first_direction[from], last = directions.begin() + first_direction[from + 1];
+      auto it = std::lower_bound(first, last, to, [](const BlockPairMoves& d, const PartitionID t) { return d.to < t; });
+      return it != last && it->to == to ? static_cast<size_t>(it - directions.begin()) : kInvalidDirection;
     };
 
-    vec<std::pair<PartitionID, PartitionID>> relevant_block_pairs;
+    // relevant block pairs (p1 < p2) and the indices of their directions (p1 -> p2, p2 -> p1)
+    vec<std::pair<size_t, size_t>> relevant_block_pairs;
     vec<size_t> involvements(k, 0);
-    for (PartitionID p1 = 0; p1 < k; ++p1) {
-      for (PartitionID p2 = p1 + 1; p2 < k; ++p2) {
-        if (has_moves(p1, p2) || has_moves(p2, p1)) {
-          relevant_block_pairs.emplace_back(p1, p2);
-        }
-        // more involvements reduce slack --> only increment involvements if vertices are moved into that block
-        if (has_moves(p1, p2)) {
-          involvements[p2]++;
-        }
-        if (has_moves(p2, p1)) {
-          involvements[p1]++;
-        }
+    for (size_t d = 0; d < directions.size(); ++d) {
+      const auto& direction = directions[d];
+      // more involvements reduce slack --> only increment involvements if vertices are moved into that block
+      involvements[direction.to]++;
+      if (direction.from < direction.to) {
+        relevant_block_pairs.emplace_back(d, find_direction(direction.to, direction.from));
+      } else if (find_direction(direction.to, direction.from) == kInvalidDirection) {
+        relevant_block_pairs.emplace_back(kInvalidDirection, d);
       }
     }
 
-    // swap_prefix[index(p1,p2)] stores the first position of moves to revert out of the sequence of moves from p1 to p2
-    vec<size_t> swap_prefix(max_key, 0);
-    vec<int64_t> part_weight_deltas(k, 0);
-
     tbb::parallel_for(UL(0), relevant_block_pairs.size(), [&](size_t bp_index) {
-      // sort both directions by gain (alternative: gain / weight?)
-      auto[p1, p2] = relevant_block_pairs[bp_index];
-      auto comp = [&](const Move& m1, const Move& m2) {
-        return m1.gain > m2.gain || (m1.gain == m2.gain && m1.node < m2.node);
+      auto [d1, d2] = relevant_block_pairs[bp_index];
+      const PartitionID p1 = d1 != kInvalidDirection ? directions[d1].from : directions[d2].to;
+      const PartitionID p2 = d1 != kInvalidDirection ? directions[d1].to : directions[d2].from;
+      auto prefix_sums = [&](const size_t d) -> size_t {
+        if (d == kInvalidDirection) return 0;
+        const uint32_t first = directions[d].begin, last = directions[d].end;
+        tbb::parallel_for(first, last, [&](const uint32_t pos) {
+          weight_prefix_sums[pos] = phg.nodeWeight(sorted_moves[pos].node);
+          gain_prefix_sums[pos] = sorted_moves[pos].gain;
+        });
+        parallel_prefix_sum(weight_prefix_sums.begin() + first, weight_prefix_sums.begin() + last,
+                            weight_prefix_sums.begin() + first, std::plus<>(), int64_t(0));
+        parallel_prefix_sum(gain_prefix_sums.begin() + first, gain_prefix_sums.begin() + last,
+                            gain_prefix_sums.begin() + first, std::plus<>(), int64_t(0));
+        return last - first;
       };
-      const auto b = sorted_moves.begin();
-      size_t i = positions[index(p1, p2)], i_last = positions[index(p1, p2) + 1],
-              j = positions[index(p2, p1)], j_last = positions[index(p2, p1) + 1];
-      std::sort(b + i, b + i_last, comp);
-      std::sort(b + j, b + j_last, comp);
-
+      const size_t len_1 = prefix_sums(d1), len_2 = prefix_sums(d2);
+      const uint32_t first_1 = d1 != kInvalidDirection ? directions[d1].begin : 0,
+                     first_2 = d2 != kInvalidDirection ? directions[d2].begin : 0;
 
       // get balanced swap prefix
       HypernodeWeight budget_p1 = context.partition.max_part_weights[p1] - phg.partWeight(p1),
@@ -332,77 +425,42 @@ namespace mt_kahypar {
       HypernodeWeight slack_p1 = budget_p1 / std::max(UL(1), involvements[p1]),
                       slack_p2 = budget_p2 / std::max(UL(1), involvements[p2]);
 
-      int64_t balance = 0;
-      std::tuple<size_t, size_t, int64_t> best{0, 0, 0};
-
-      /*
-       * this can be parallelized as follows.
-       * 1. prefix sums of node weights over both move sequences
-       * 2. pick middle of larger sequence, binary search for its prefix sum in the smaller sequence
-       * 3. search for prefixes independently in both halves, and pick the better one
-       *
-       * in most cases we're expecting to take roughly as many moves as the size of the shorter sequence, from each of the sequences.
-       * can we bias the search towards that?
-       */
-
-      // gain > 0 first. alternate depending on balance
-      while (i < i_last && sorted_moves[i].gain > 0 && j < j_last && sorted_moves[j].gain > 0) {
-        if (balance < 0 || (balance == 0 && sorted_moves[i].gain > sorted_moves[j].gain)) {
-          // perform next move from p1 to p2
-          balance += phg.nodeWeight(sorted_moves[i++].node);
-        } else {
-          // perform next move from p2 to p1
-          balance -= phg.nodeWeight(sorted_moves[j++].node);
-        }
-
-        if (-balance <= slack_p1 && balance <= slack_p2) {
-          best = {i, j, balance};
-        }
-      }
-
-      // if one sequence is depleted or gain == 0. only do rebalancing in the other direction
-      if (j == j_last || sorted_moves[j].gain == 0) {
-        while (i < i_last && balance <= slack_p2 && (balance < 0 || sorted_moves[i].gain > 0)) {
-          balance += phg.nodeWeight(sorted_moves[i++].node);
-          if (-balance <= slack_p1 && balance <= slack_p2) {
-            best = {i, j, balance};
-          }
-        }
-      }
-      if (i == i_last || sorted_moves[i].gain == 0) {
-        while (j < j_last && -balance <= slack_p1 && (balance > 0 || sorted_moves[j].gain > 0)) {
-          balance -= phg.nodeWeight(sorted_moves[j++].node);
-          if (-balance <= slack_p1 && balance <= slack_p2) {
-            best = {i, j, balance};
-          }
-        }
+      // iterate over the prefixes of the shorter sequence and search in the longer one
+      const int64_t* w_1 = weight_prefix_sums.data() + first_1, *g_1 = gain_prefix_sums.data() + first_1;
+      const int64_t* w_2 = weight_prefix_sums.data() + first_2, *g_2 = gain_prefix_sums.data() + first_2;
+      size_t i = 0, j = 0;
+      if (len_1 <= len_2) {
+        const BlockPairPrefixes best = selectBalancedPrefixes(w_1, g_1, len_1, w_2, g_2, len_2, slack_p2, slack_p1);
+        i = best.a;
+        j = best.b;
+      } else {
+        const BlockPairPrefixes best = selectBalancedPrefixes(w_2, g_2, len_2, w_1, g_1, len_1, slack_p1, slack_p2);
+        i = best.b;
+        j = best.a;
       }
-
-      swap_prefix[index(p1, p2)] = std::get<0>(best);
-      swap_prefix[index(p2, p1)] = std::get<1>(best);
-      int64_t best_balance = std::get<2>(best);
-
-      // balance < 0 --> p1 got more weight, balance > 0 --> p2 got more weight
-      __atomic_fetch_add(&part_weight_deltas[p1], best_balance, __ATOMIC_RELAXED);
-      __atomic_fetch_sub(&part_weight_deltas[p2], best_balance, __ATOMIC_RELAXED);
+      if (d1 != kInvalidDirection) directions[d1].approved_end = first_1 + i;
+      if (d2 != kInvalidDirection) directions[d2].approved_end = first_2 + j;
     });
 
+    // moves that are not approved are kept for the second apply function
     moves.clear();
-    Gain actual_gain = applyMovesIf(phg, sorted_moves, num_moves, [&](size_t pos) {
-      if (pos < swap_prefix[index(sorted_moves[pos].from, sorted_moves[pos].to)]) {
-        return true;
-      } else {
+    tbb::parallel_for(UL(0), directions.size(), [&](const size_t d) {
+      for (uint32_t pos = directions[d].approved_end; pos < directions[d].end; ++pos) {
         moves.push_back_buffered(sorted_moves[pos]);
-        return false;
+        sorted_moves[pos].invalidate();
       }
     });
     moves.finalize();
 
+    Gain actual_gain = applyMovesIf(phg, sorted_moves, num_moves, [&](size_t pos) {
+      return sorted_moves[pos].isValid();
+    });
+
     // revert everything if that decreased solution quality
     if (actual_gain < 0) {
       DBG << "Kommando zurück" << V(actual_gain);
       actual_gain += applyMovesIf(phg, sorted_moves, num_moves, [&](size_t pos) {
-        if (pos < swap_prefix[index(sorted_moves[pos].from, sorted_moves[pos].to)]) {
+        if (sorted_moves[pos].isValid()) {
           std::swap(sorted_moves[pos].from, sorted_moves[pos].to);
           return true;
         } else {
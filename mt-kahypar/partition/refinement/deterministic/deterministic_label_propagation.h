@@ -108,6 +108,9 @@ private:
   tbb::enumerable_thread_specific<Km1GainComputer> compute_gains;
   ds::BufferedVector<Move> moves;
   vec<Move> sorted_moves;
+  // prefix sums of the node weights and gains of the moves in sorted_moves per direction
+  vec<int64_t> weight_prefix_sums;   // gets memory only once used
+  vec<int64_t> gain_prefix_sums;
 
   std::mt19937 prng;
   utils::ParallelPermutation<HypernodeID> permutation;  // gets memory only once used
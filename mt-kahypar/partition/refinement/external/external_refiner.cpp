@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "mt-kahypar/partition/refinement/external/external_refiner.h"
+
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_invoke.h"
+#include "tbb/parallel_scan.h"
+
+#include "mt-kahypar/parallel/parallel_prefix_sum.h"
+#include "mt-kahypar/partition/metrics.h"
+#include "mt-kahypar/utils/timer.h"
+
+namespace mt_kahypar {
+
+  void ExternalRefiner::initializeImpl(PartitionedHypergraph& phg) {
+    // The incidence structure only changes if we move to the next level
+    if ( !_is_exported ) {
+      exportHypergraph(phg);
+      _is_exported = true;
+    }
+  }
+
+  bool ExternalRefiner::refineImpl(PartitionedHypergraph& phg,
+                                   const parallel::scalable_vector<HypernodeID>&,
+                                   Metrics& best_metrics,
+                                   const double) {
+    ASSERT(_context.external_refinement_hook);
+    ASSERT(_is_exported);
+    const PartitionID k = phg.k();
+    _block_weights.resize(k);
+    for ( PartitionID block = 0; block < k; ++block ) {
+      _block_weights[block] = phg.partWeight(block);
+    }
+    _part_ids.resize(phg.initialNumNodes());
+    phg.copyPartIDs(_part_ids.data());
+
+    utils::ExternalRefinementLevel level;
+    level.level = _level;
+    level.num_levels = _num_levels;
+    level.k = k;
+    level.num_nodes = phg.initialNumNodes();
+    level.num_edges = phg.initialNumEdges();
+    level.hyperedge_indices = _hyperedge_indices.data();
+    level.pins = _pins.data();
+    level.incident_net_indices = _incident_net_indices.data();
+    level.incident_nets = _incident_nets.data();
+    level.node_weights = _node_weights.data();
+    level.edge_weights = _edge_weights.data();
+    level.part_ids = _part_ids.data();
+    level.block_weights = _block_weights.data();
+    level.max_block_weights = _context.partition.max_part_weights.data();
+    level.pin_count_in_part = &ExternalRefiner::pinCountInPart;
+    level.partitioned_hg = &phg;
+
+    _move_nodes.resize(phg.initialNumNodes());
+    _move_blocks.resize(phg.initialNumNodes());
+    const size_t num_moves = std::min(_context.external_refinement_hook->refine(
+      level, _move_nodes.data(), _move_blocks.data()), _move_nodes.size());
+
+    // Apply the moves of the external refiner
+    const bool update_gain_cache = _context.forceGainCacheUpdates() && phg.isGainCacheInitialized();
+    tbb::parallel_for(UL(0), num_moves, [&](const size_t i) {
+      const uint64_t u = _move_nodes[i];
+      const PartitionID to = _move_blocks[i];
+      if ( u < phg.initialNumNodes() && phg.nodeIsEnabled(u) && to >= 0 && to < k ) {
+        const PartitionID from = phg.partID(u);
+        if ( from != to ) {
+          if ( update_gain_cache ) {
+            phg.changeNodePartWithGainCacheUpdate(u, from, to,
+              _context.partition.max_part_weights[to], [] { }, NoOpDeltaFunc());
+          } else {
+            phg.changeNodePart(u, from, to,
+              _context.partition.max_part_weights[to], [] { }, NoOpDeltaFunc());
+          }
+        }
+      }
+    });
+
+    const HyperedgeWeight objective_before = best_metrics.getMetric(
+      _context.partition.mode, _context.partition.objective);
+    best_metrics.km1 = metrics::km1(phg);
+    best_metrics.cut = metrics::hyperedgeCut(phg);
+    best_metrics.imbalance = metrics::imbalance(phg, _context);
+    const HyperedgeWeight objective_after = best_metrics.getMetric(
+      _context.partition.mode, _context.partition.objective);
+    DBG << "External refiner on level" << _level << ":" << V(num_moves)
+        << V(objective_before) << V(objective_after);
+    return objective_after < objective_before;
+  }
+
+  void ExternalRefiner::exportHypergraph(const PartitionedHypergraph& phg) {
+    const HypernodeID num_nodes = phg.initialNumNodes();
+    const HyperedgeID num_edges = phg.initialNumEdges();
+    _hyperedge_indices.assign(num_edges + 1, 0);
+    _incident_net_indices.assign(num_nodes + 1, 0);
+    _node_weights.assign(num_nodes, 0);
+    _edge_weights.assign(num_edges, 0);
+    tbb::parallel_invoke([&] {
+      phg.doParallelForAllEdges([&](const HyperedgeID he) {
+        _hyperedge_indices[he + 1] = phg.edgeSize(he);
+        _edge_weights[he] = phg.edgeWeight(he);
+      });
+      parallel::TBBPrefixSum<size_t> prefix_sum(_hyperedge_indices);
+      tbb::parallel_scan(tbb::blocked_range<size_t>(UL(0), _hyperedge_indices.size()), prefix_sum);
+    }, [&] {
+      phg.doParallelForAllNodes([&](const HypernodeID hn) {
+        _incident_net_indices[hn + 1] = phg.nodeDegree(hn);
+        _node_weights[hn] = phg.nodeWeight(hn);
+      });
+      parallel::TBBPrefixSum<size_t> prefix_sum(_incident_net_indices);
+      tbb::parallel_scan(tbb::blocked_range<size_t>(UL(0), _incident_net_indices.size()), prefix_sum);
+    });
+
+    _pins.resize(_hyperedge_indices.back());
+    _incident_nets.resize(_incident_net_indices.back());
+    tbb::parallel_invoke([&] {
+      phg.doParallelForAllEdges([&](const HyperedgeID he) {
+        size_t pos = _hyperedge_indices[he];
+        for ( const HypernodeID& pin : phg.pins(he) ) {
+          _pins[pos++] = pin;
+        }
+      });
+    }, [&] {
+      phg.doParallelForAllNodes([&](const HypernodeID hn) {
+        size_t pos = _incident_net_indices[hn];
+        for ( const HyperedgeID& he : phg.incidentEdges(hn) ) {
+          _incident_nets[pos++] = he;
+        }
+      });
+    });
+  }
+
+  HypernodeID ExternalRefiner::pinCountInPart(const void* phg,
+                                              const HyperedgeID he,
+                                              const PartitionID block) {
+    return static_cast<const PartitionedHypergraph*>(phg)->pinCountInPart(he, block);
+  }
+
+} // namespace mt_kahypar
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/refinement/i_refiner.h"
+#include "mt-kahypar/utils/external_refinement_hook.h"
+
+namespace mt_kahypar {
+
+/*!
+ * Passes the current level of the uncoarsening phase to a user-defined refiner
+ * (see utils::ExternalRefinementHook) and applies the moves it returns. Moves that
+ * would violate the maximum allowed block weight of their target block are skipped.
+ * The incidence structure of a level is exported once and reused by all refinement
+ * rounds on that level (see setLevel(...)).
+ */
+class ExternalRefiner final : public IRefiner {
+
+  static constexpr bool debug = false;
+
+ public:
+  explicit ExternalRefiner(const Context& context) :
+    _context(context),
+    _hyperedge_indices(),
+    _pins(),
+    _incident_net_indices(),
+    _incident_nets(),
+    _node_weights(),
+    _edge_weights(),
+    _part_ids(),
+    _block_weights(),
+    _move_nodes(),
+    _move_blocks() { }
+
+  ExternalRefiner(const ExternalRefiner&) = delete;
+  ExternalRefiner(ExternalRefiner&&) = delete;
+  ExternalRefiner & operator= (const ExternalRefiner &) = delete;
+  ExternalRefiner & operator= (ExternalRefiner &&) = delete;
+
+  // ! Must be called before the first refinement round on each level
+  void setLevel(const size_t level, const size_t num_levels) {
+    _level = level;
+    _num_levels = num_levels;
+    _is_exported = false;
+  }
+
+ private:
+  void initializeImpl(PartitionedHypergraph& phg) final;
+
+  bool refineImpl(PartitionedHypergraph& phg,
+                  const parallel::scalable_vector<HypernodeID>& refinement_nodes,
+                  Metrics& best_metrics,
+                  const double time_limit) final;
+
+  void exportHypergraph(const PartitionedHypergraph& phg);
+
+  static HypernodeID pinCountInPart(const void* phg, const HyperedgeID he, const PartitionID block);
+
+  const Context& _context;
+  size_t _level = 0;
+  size_t _num_levels = 0;
+  vec<size_t> _hyperedge_indices;
+  vec<uint64_t> _pins;
+  vec<size_t> _incident_net_indices;
+  vec<uint64_t> _incident_nets;
+  vec<HypernodeWeight> _node_weights;
+  vec<HyperedgeWeight> _edge_weights;
+  // ! Snapshot of the block IDs (the partitioned hypergraph may store them with a narrow type)
+  vec<PartitionID> _part_ids;
+  vec<HypernodeWeight> _block_weights;
+  vec<uint64_t> _move_nodes;
+  vec<PartitionID> _move_blocks;
+  // ! True, if the incidence structure of the current level is exported
+  bool _is_exported = false;
+};
+
+}  // namespace mt_kahypar
@@ -32,6 +32,7 @@
 #include "tbb/parallel_reduce.h"
 #include "tbb/parallel_scan.h"
 #include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
 
 namespace mt_kahypar {
 
@@ -114,6 +115,73 @@ void FlowHypergraphBuilder::finalizeHyperedges() {
   hyperedges.emplace_back( HyperedgeData { whfc::PinIndex(num_pins), whfc::Flow(0) } ); // sentinel
 }
 
+const vec<whfc::Node>& FlowHypergraphBuilder::reorderNodes(const whfc::Node source,
+                                                           const whfc::Node sink) {
+  ASSERT(source != sink);
+  const size_t num_nodes = numNodes();
+  tbb::parallel_invoke([&] {
+    _first_occurrence.assign(num_nodes, std::numeric_limits<size_t>::max());
+  }, [&] {
+    _new_node_id.resize(num_nodes);
+  }, [&] {
+    _tmp_nodes.resize(nodes.size());
+    std::copy(nodes.begin(), nodes.end(), _tmp_nodes.begin());
+  });
+
+  // Determine the first position of each node in the pin lists
+  tbb::parallel_for(UL(0), numPins(), [&](const size_t i) {
+    const whfc::Node u = pins[i].pin;
+    if ( u != source && u != sink ) {
+      size_t first = __atomic_load_n(&_first_occurrence[u], __ATOMIC_RELAXED);
+      while ( i < first && !__atomic_compare_exchange_n(&_first_occurrence[u],
+                &first, i, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED) ) { }
+    }
+  });
+
+  // The i-th node in the new order receives the i-th ID that is
+  // not occupied by the source or the sink
+  const size_t lower_terminal = std::min(static_cast<size_t>(source), static_cast<size_t>(sink));
+  const size_t upper_terminal = std::max(static_cast<size_t>(source), static_cast<size_t>(sink));
+  auto node_id_at = [&](const size_t i) {
+    size_t id = i;
+    id += ( id >= lower_terminal );
+    id += ( id >= upper_terminal );
+    return whfc::Node(id);
+  };
+  _node_order.resize(num_nodes - 2);
+  tbb::parallel_for(UL(0), _node_order.size(), [&](const size_t i) {
+    _node_order[i] = node_id_at(i);
+  });
+  tbb::parallel_sort(_node_order.begin(), _node_order.end(),
+    [&](const whfc::Node& lhs, const whfc::Node& rhs) {
+      return _first_occurrence[lhs] < _first_occurrence[rhs] ||
+        ( _first_occurrence[lhs] == _first_occurrence[rhs] && lhs < rhs );
+    });
+  _new_node_id[source] = source;
+  _new_node_id[sink] = sink;
+  tbb::parallel_for(UL(0), _node_order.size(), [&](const size_t i) {
+    _new_node_id[_node_order[i]] = node_id_at(i);
+  });
+
+  // Apply permutation to node weights, node degrees and pin lists. Note that
+  // before finalizeParallel() is called, nodes[u + 1].first_out contains
+  // the degree of node u.
+  tbb::parallel_invoke([&] {
+    tbb::parallel_for(UL(0), num_nodes, [&](const size_t i) {
+      const whfc::Node u(i);
+      const whfc::Node new_u = _new_node_id[u];
+      nodes[new_u].weight = _tmp_nodes[u].weight;
+      nodes[new_u + 1].first_out = _tmp_nodes[u + 1].first_out;
+    });
+  }, [&] {
+    tbb::parallel_for(UL(0), numPins(), [&](const size_t i) {
+      pins[i].pin = _new_node_id[pins[i].pin];
+    });
+  });
+
+  return _new_node_id;
+}
+
 void FlowHypergraphBuilder::finalizeParallel() {
   ASSERT(verifyParallelConstructedHypergraph(), "Parallel construction failed!");
 
@@ -46,11 +46,16 @@ namespace mt_kahypar {
         _num_pins(0),
         _global_start_pin_idx(0) { }
 
+      // ! The buckets are reused for all flow problems of a refiner. All entries
+      // ! are written before they are read, so we only grow the buffers and never
+      // ! clear them, which avoids zeroing them for each flow problem.
       void initialize(const size_t num_hes, const size_t num_pins) {
-        _hes.clear();
-        _pins.clear();
-        _hes.resize(num_hes + 1);
-        _pins.resize(num_pins);
+        if ( _hes.size() < num_hes + 1 ) {
+          _hes.resize(num_hes + 1);
+        }
+        if ( _pins.size() < num_pins ) {
+          _pins.resize(num_pins);
+        }
         _num_hes = whfc::Hyperedge(0);
         _global_start_he = whfc::Hyperedge(0);
         _num_pins = 0;
@@ -98,8 +103,9 @@ namespace mt_kahypar {
       }
 
       void finalize() {
-        _hes.resize(_num_hes + 1);
-        _pins.resize(_num_pins);
+        // Buffers keep their capacity (see initialize(...))
+        ASSERT(static_cast<size_t>(_num_hes + 1) <= _hes.size());
+        ASSERT(_num_pins <= _pins.size());
       }
 
       void copyDataToFlowHypergraph(std::vector<FlowHypergraph::HyperedgeData>& hyperedges,
@@ -135,7 +141,11 @@ namespace mt_kahypar {
       _finalized(false),
       _numPinsAtHyperedgeStart(0),
       _tmp_csr_buckets(),
-      _inc_he_pos() {
+      _inc_he_pos(),
+      _first_occurrence(),
+      _node_order(),
+      _new_node_id(),
+      _tmp_nodes() {
       clear();
     }
 
@@ -144,7 +154,11 @@ namespace mt_kahypar {
       _finalized(false),
       _numPinsAtHyperedgeStart(0),
       _tmp_csr_buckets(),
-      _inc_he_pos() {
+      _inc_he_pos(),
+      _first_occurrence(),
+      _node_order(),
+      _new_node_id(),
+      _tmp_nodes() {
       reinitialize(num_nodes);
     }
 
@@ -249,6 +263,14 @@ namespace mt_kahypar {
 
     void finalizeHyperedges();
 
+    // ! Renumbers the nodes in the order in which they first occur in the pin lists
+    // ! of the hyperedges. Since the hyperedges are added in the order in which the
+    // ! region was grown, nodes that share hyperedges receive close IDs, which improves
+    // ! the locality of the flow algorithm. Source and sink keep their IDs.
+    // ! Must be called after finalizeHyperedges() and before finalizeParallel().
+    // ! Returns the new ID of each node.
+    const vec<whfc::Node>& reorderNodes(const whfc::Node source, const whfc::Node sink);
+
     void finalizeParallel();
 
     // ####################### Common Functions #######################
@@ -290,5 +312,11 @@ namespace mt_kahypar {
 
     vec<TmpCSRBucket> _tmp_csr_buckets;
     vec<uint32_t> _inc_he_pos;
+
+    // ! Data required to renumber the nodes (see reorderNodes(...))
+    vec<size_t> _first_occurrence;
+    vec<whfc::Node> _node_order;
+    vec<whfc::Node> _new_node_id;
+    vec<NodeData> _tmp_nodes;
   };
 }
@@ -29,6 +29,7 @@
 #include "mt-kahypar/utils/utilities.h"
 
 #include "tbb/concurrent_queue.h"
+#include "tbb/parallel_for.h"
 
 namespace mt_kahypar {
 
@@ -37,6 +38,13 @@ MoveSequence FlowRefiner::refineImpl(const PartitionedHypergraph& phg,
                                      const HighResClockTimepoint& start) {
   MoveSequence sequence { { }, 0 };
   utils::Timer& timer = utils::Utilities::instance().getTimer(_context.utility_id);
+  // Sequential and parallel flow algorithm operate on different flow cutter instances.
+  // Thus, the decision must remain the same for the whole search.
+  // The portfolio uses the threads of the search for several sequential flowcutters
+  _use_portfolio = usePortfolio();
+  _use_parallel_flow_algorithm = !_use_portfolio && useParallelFlowAlgorithm();
+  _portfolio_winner = 0;
+
   // Construct flow network that contains all vertices given in refinement nodes
   timer.start_timer("construct_flow_network", "Construct Flow Network", true);
   FlowProblem flow_problem = constructFlowHypergraph(phg, sub_hg);
@@ -54,10 +62,11 @@ MoveSequence FlowRefiner::refineImpl(const PartitionedHypergraph& phg,
 
       HyperedgeWeight new_cut = flow_problem.non_removable_cut;
       HypernodeWeight max_part_weight;
-      const bool sequential = _context.shared_memory.num_threads == _context.refinement.flows.num_parallel_searches;
+      const bool sequential = !_use_parallel_flow_algorithm;
       if (sequential) {
-        new_cut += _sequential_hfc.cs.flow_algo.flow_value;
-        max_part_weight = std::max(_sequential_hfc.cs.source_weight, _sequential_hfc.cs.target_weight);
+        SequentialFlowCutter& hfc = sequentialFlowCutter();
+        new_cut += hfc.cs.flow_algo.flow_value;
+        max_part_weight = std::max(hfc.cs.source_weight, hfc.cs.target_weight);
       } else {
         new_cut += _parallel_hfc.cs.flow_algo.flow_value;
         max_part_weight = std::max(_parallel_hfc.cs.source_weight, _parallel_hfc.cs.target_weight);
@@ -75,7 +84,7 @@ MoveSequence FlowRefiner::refineImpl(const PartitionedHypergraph& phg,
             const PartitionID from = phg.partID(hn);
             PartitionID to;
             if (sequential) {
-              to = _sequential_hfc.cs.flow_algo.isSource(u) ? _block_0 : _block_1;
+              to = sequentialFlowCutter().cs.flow_algo.isSource(u) ? _block_0 : _block_1;
             } else {
               to = _parallel_hfc.cs.flow_algo.isSource(u) ? _block_0 : _block_1;
             }
@@ -117,7 +126,11 @@ bool FlowRefiner::runFlowCutter(const FlowProblem& flow_problem,
   };
 
 
-  const bool sequential = _context.shared_memory.num_threads == _context.refinement.flows.num_parallel_searches;
+  if ( _use_portfolio ) {
+    return runPortfolio(flow_problem, start, time_limit_reached);
+  }
+
+  const bool sequential = !_use_parallel_flow_algorithm;
   if (sequential) {
     _sequential_hfc.cs.setMaxBlockWeight(0, std::max(
             flow_problem.weight_of_block_0, _context.partition.max_part_weights[_block_0]));
@@ -140,6 +153,67 @@ bool FlowRefiner::runFlowCutter(const FlowProblem& flow_problem,
   return result;
 }
 
+bool FlowRefiner::runPortfolio(const FlowProblem& flow_problem,
+                               const HighResClockTimepoint& start,
+                               bool& time_limit_reached) {
+  const size_t num_members = std::min(_num_available_threads,
+    _context.refinement.flows.most_balanced_cut_portfolio_size);
+  while ( _portfolio.size() + 1 < num_members ) {
+    _portfolio.emplace_back(std::make_unique<PortfolioMember>(
+      _context.partition.seed + _portfolio.size() + 1, _context));
+  }
+
+  // Each member operates on its own copy of the flow network
+  tbb::parallel_for(UL(1), num_members, [&](const size_t i) {
+    PortfolioMember& member = *_portfolio[i - 1];
+    static_cast<whfc::FlowHypergraph&>(member.flow_hg) = _flow_hg;
+    if ( _context.refinement.flows.determine_distance_from_cut ) {
+      member.hfc.cs.border_nodes.distance = _sequential_hfc.cs.border_nodes.distance;
+    }
+  });
+
+  // The first member that finds a balanced cut cancels all others
+  CAtomic<bool> found_balanced_cut(false);
+  CAtomic<bool> reached_time_limit(false);
+  _portfolio_winner = 0;
+  tbb::parallel_for(UL(0), num_members, [&](const size_t i) {
+    SequentialFlowCutter& hfc = i == 0 ? _sequential_hfc : _portfolio[i - 1]->hfc;
+    size_t iteration = 0;
+    auto on_cut = [&] {
+      if ( found_balanced_cut.load(std::memory_order_relaxed) ) {
+        return false;
+      }
+      if (++iteration == 25) {
+        iteration = 0;
+        double elapsed = RUNNING_TIME(start);
+        if (elapsed > _time_limit) {
+          reached_time_limit.store(true, std::memory_order_relaxed);
+          return false;
+        }
+      }
+      return true;
+    };
+
+    hfc.cs.setMaxBlockWeight(0, std::max(
+            flow_problem.weight_of_block_0, _context.partition.max_part_weights[_block_0]));
+    hfc.cs.setMaxBlockWeight(1, std::max(
+            flow_problem.weight_of_block_1, _context.partition.max_part_weights[_block_1]));
+
+    hfc.reset();
+    hfc.setFlowBound(flow_problem.total_cut - flow_problem.non_removable_cut);
+    if ( hfc.enumerateCutsUntilBalancedOrFlowBoundExceeded(flow_problem.source, flow_problem.sink, on_cut) ) {
+      bool expected = false;
+      if ( found_balanced_cut.compare_exchange_strong(expected, true) ) {
+        _portfolio_winner = i;
+      }
+    }
+  });
+
+  const bool result = found_balanced_cut.load();
+  time_limit_reached = !result && reached_time_limit.load();
+  return result;
+}
+
 FlowProblem FlowRefiner::constructFlowHypergraph(const PartitionedHypergraph& phg,
                                                  const Subhypergraph& sub_hg) {
   _block_0 = sub_hg.block_0;
@@ -148,7 +222,7 @@ FlowProblem FlowRefiner::constructFlowHypergraph(const PartitionedHypergraph& ph
   FlowProblem flow_problem;
 
 
-  const bool sequential = _context.shared_memory.num_threads == _context.refinement.flows.num_parallel_searches;
+  const bool sequential = !_use_parallel_flow_algorithm;
   if ( sequential ) {
     flow_problem = _sequential_construction.constructFlowHypergraph(
       phg, sub_hg, _block_0, _block_1, _whfc_to_node);
@@ -48,12 +48,36 @@ class FlowRefiner final : public IFlowRefiner {
 
   static constexpr bool debug = false;
 
+  using SequentialFlowCutter = whfc::HyperFlowCutter<whfc::SequentialPushRelabel>;
+
+  /**
+   * Member of the portfolio for the most balanced cut search. Each member
+   * operates on its own copy of the flow network and uses a different seed
+   * for its piercing decisions.
+   */
+  struct PortfolioMember {
+    explicit PortfolioMember(const int seed,
+                             const Context& context) :
+      flow_hg(),
+      hfc(flow_hg, seed) {
+      hfc.find_most_balanced = context.refinement.flows.find_most_balanced_cut;
+      hfc.timer.active = false;
+      hfc.forceSequential(true);
+      hfc.setBulkPiercing(context.refinement.flows.pierce_in_bulk);
+    }
+
+    FlowHypergraphBuilder flow_hg;
+    SequentialFlowCutter hfc;
+  };
+
  public:
   explicit FlowRefiner(const Hypergraph& hg,
                        const Context& context) :
     _phg(nullptr),
     _context(context),
     _num_available_threads(0),
+    _use_parallel_flow_algorithm(false),
+    _use_portfolio(false),
     _block_0(kInvalidPartition),
     _block_1(kInvalidPartition),
     _flow_hg(),
@@ -61,7 +85,9 @@ class FlowRefiner final : public IFlowRefiner {
     _parallel_hfc(_flow_hg, context.partition.seed),
     _whfc_to_node(),
     _sequential_construction(hg, _flow_hg, _sequential_hfc, context),
-    _parallel_construction(hg, _flow_hg, _parallel_hfc, context)
+    _parallel_construction(hg, _flow_hg, _parallel_hfc, context),
+    _portfolio(),
+    _portfolio_winner(0)
     {
       _sequential_hfc.find_most_balanced = _context.refinement.flows.find_most_balanced_cut;
       _sequential_hfc.timer.active = false;
@@ -71,7 +97,7 @@ class FlowRefiner final : public IFlowRefiner {
       _parallel_hfc.find_most_balanced = _context.refinement.flows.find_most_balanced_cut;
       _parallel_hfc.timer.active = false;
       _parallel_hfc.forceSequential(false);
-      _sequential_hfc.setBulkPiercing(context.refinement.flows.pierce_in_bulk);
+      _parallel_hfc.setBulkPiercing(context.refinement.flows.pierce_in_bulk);
   }
 
   FlowRefiner(const FlowRefiner&) = delete;
@@ -101,6 +127,10 @@ class FlowRefiner final : public IFlowRefiner {
                      const HighResClockTimepoint& start,
                      bool& time_limit_reached);
 
+  bool runPortfolio(const FlowProblem& flow_problem,
+                    const HighResClockTimepoint& start,
+                    bool& time_limit_reached);
+
   FlowProblem constructFlowHypergraph(const PartitionedHypergraph& phg,
                                       const Subhypergraph& sub_hg);
 
@@ -112,6 +142,28 @@ class FlowRefiner final : public IFlowRefiner {
     _num_available_threads = num_threads;
   }
 
+  // ! If the thread organizer assigns more than one thread to the current search
+  // ! (e.g., if k is small and only a few block pairs can be refined concurrently),
+  // ! we construct the flow network in parallel and use the parallel
+  // ! push-relabel algorithm for solving the flow problem.
+  bool useParallelFlowAlgorithm() const {
+    return _num_available_threads > 1;
+  }
+
+  // ! If more than one thread is assigned to the current search and we search for
+  // ! the most balanced minimum cut, we can alternatively run a portfolio of
+  // ! sequential flowcutters with different seeds and take the first balanced cut.
+  bool usePortfolio() const {
+    return _num_available_threads > 1 &&
+      _context.refinement.flows.find_most_balanced_cut &&
+      _context.refinement.flows.most_balanced_cut_portfolio_size > 1;
+  }
+
+  // ! Sequential flowcutter that computed the cut of the last flow problem
+  SequentialFlowCutter& sequentialFlowCutter() {
+    return _portfolio_winner == 0 ? _sequential_hfc : _portfolio[_portfolio_winner - 1]->hfc;
+  }
+
   bool canHyperedgeBeDropped(const PartitionedHypergraph& phg,
                              const HyperedgeID he) {
     return _context.partition.objective == Objective::cut &&
@@ -122,15 +174,22 @@ class FlowRefiner final : public IFlowRefiner {
   const Context& _context;
   using IFlowRefiner::_time_limit;
   size_t _num_available_threads;
+  bool _use_parallel_flow_algorithm;
+  bool _use_portfolio;
 
   mutable PartitionID _block_0;
   mutable PartitionID _block_1;
   FlowHypergraphBuilder _flow_hg;
-  whfc::HyperFlowCutter<whfc::SequentialPushRelabel> _sequential_hfc;
+  SequentialFlowCutter _sequential_hfc;
   whfc::HyperFlowCutter<whfc::ParallelPushRelabel> _parallel_hfc;
 
   vec<HypernodeID> _whfc_to_node;
   SequentialConstruction _sequential_construction;
   ParallelConstruction _parallel_construction;
+
+  // ! Additional members of the most balanced cut portfolio
+  // ! (the first member is _sequential_hfc)
+  vec<std::unique_ptr<PortfolioMember>> _portfolio;
+  size_t _portfolio_winner;
 };
 }  // namespace mt_kahypar
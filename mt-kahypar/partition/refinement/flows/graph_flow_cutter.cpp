@@ -0,0 +1,301 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "mt-kahypar/partition/refinement/flows/graph_flow_cutter.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace mt_kahypar {
+
+// ####################### Construction #######################
+
+void GraphFlowCutter::clear() {
+  _node_weight.assign(2, 0);
+  _edges.clear();
+  _first_out.clear();
+  _incident_edges.clear();
+  _flow_value = 0;
+}
+
+void GraphFlowCutter::finalize() {
+  const size_t num_nodes = numNodes();
+  _first_out.assign(num_nodes + 1, 0);
+  for ( const Edge& edge : _edges ) {
+    ++_first_out[edge.u + 1];
+    ++_first_out[edge.v + 1];
+  }
+  for ( size_t u = 0; u < num_nodes; ++u ) {
+    _first_out[u + 1] += _first_out[u];
+  }
+
+  _incident_edges.resize(2 * _edges.size());
+  _current_edge.assign(_first_out.begin(), _first_out.end() - 1);
+  for ( EdgeID e = 0; e < _edges.size(); ++e ) {
+    _incident_edges[_current_edge[_edges[e].u]++] = e;
+    _incident_edges[_current_edge[_edges[e].v]++] = e;
+  }
+
+  _total_weight = 0;
+  for ( const HypernodeWeight& weight : _node_weight ) {
+    _total_weight += weight;
+  }
+  _terminal.resize(num_nodes);
+  _level.resize(num_nodes);
+  _reachable_from_source.resize(num_nodes);
+  _reaches_sink.resize(num_nodes);
+}
+
+// ####################### Flow Computation #######################
+
+void GraphFlowCutter::initializeTerminals() {
+  ASSERT(_first_out.size() == numNodes() + 1, "Flow graph is not finalized");
+  std::fill(_terminal.begin(), _terminal.end(), Terminal::NONE);
+  _terminal[source] = Terminal::SOURCE;
+  _terminal[sink] = Terminal::SINK;
+  _source_terminals.assign(1, source);
+  _sink_terminals.assign(1, sink);
+  for ( Edge& edge : _edges ) {
+    edge.flow = 0;
+  }
+  _flow_value = 0;
+  _cut_at_source_side = true;
+}
+
+void GraphFlowCutter::augmentFlow(const Flow flow_bound) {
+  while ( _flow_value <= flow_bound && computeLevels() ) {
+    for ( size_t i = 0; i < _source_terminals.size() && _flow_value <= flow_bound; ++i ) {
+      _flow_value += blockingFlow(_source_terminals[i]);
+    }
+  }
+}
+
+bool GraphFlowCutter::computeLevels() {
+  std::fill(_level.begin(), _level.end(), INVALID_LEVEL);
+  _queue.clear();
+  for ( const NodeID& s : _source_terminals ) {
+    _level[s] = 0;
+    _queue.push_back(s);
+  }
+
+  bool found_sink = false;
+  for ( size_t i = 0; i < _queue.size(); ++i ) {
+    const NodeID u = _queue[i];
+    if ( _terminal[u] == Terminal::SINK ) {
+      // Paths end at the first sink terminal
+      found_sink = true;
+      continue;
+    }
+    for ( size_t j = _first_out[u]; j < _first_out[u + 1]; ++j ) {
+      const EdgeID e = _incident_edges[j];
+      const NodeID v = head(e, u);
+      if ( _level[v] == INVALID_LEVEL && residualCapacity(e, u) > 0 ) {
+        _level[v] = _level[u] + 1;
+        _queue.push_back(v);
+      }
+    }
+  }
+
+  std::copy(_first_out.begin(), _first_out.end() - 1, _current_edge.begin());
+  return found_sink;
+}
+
+GraphFlowCutter::Flow GraphFlowCutter::blockingFlow(const NodeID s) {
+  Flow flow = 0;
+  _path.clear();
+  NodeID u = s;
+  while ( true ) {
+    if ( _terminal[u] == Terminal::SINK ) {
+      // Augment flow along the path
+      Flow bottleneck = std::numeric_limits<Flow>::max();
+      for ( const PathEdge& path_edge : _path ) {
+        bottleneck = std::min(bottleneck, residualCapacity(path_edge.e, path_edge.from));
+      }
+      for ( const PathEdge& path_edge : _path ) {
+        pushFlow(path_edge.e, path_edge.from, bottleneck);
+      }
+      flow += bottleneck;
+
+      // Continue at the tail of the first saturated edge
+      size_t i = 0;
+      while ( residualCapacity(_path[i].e, _path[i].from) > 0 ) {
+        ++i;
+      }
+      u = _path[i].from;
+      _path.resize(i);
+      continue;
+    }
+
+    bool advanced = false;
+    for ( ; _current_edge[u] < _first_out[u + 1]; ++_current_edge[u] ) {
+      const EdgeID e = _incident_edges[_current_edge[u]];
+      const NodeID v = head(e, u);
+      if ( _level[v] == _level[u] + 1 && residualCapacity(e, u) > 0 ) {
+        _path.push_back(PathEdge { e, u });
+        u = v;
+        advanced = true;
+        break;
+      }
+    }
+
+    if ( !advanced ) {
+      // No sink terminal reachable from u => retreat
+      _level[u] = INVALID_LEVEL;
+      if ( _path.empty() ) {
+        break;
+      }
+      u = _path.back().from;
+      _path.pop_back();
+      ++_current_edge[u];
+    }
+  }
+  return flow;
+}
+
+void GraphFlowCutter::computeReachableSets() {
+  auto bfs = [&](const vec<NodeID>& terminals,
+                 vec<bool>& visited,
+                 vec<NodeID>& nodes,
+                 HypernodeWeight& weight,
+                 const bool forward) {
+    std::fill(visited.begin(), visited.end(), false);
+    nodes.clear();
+    weight = 0;
+    for ( const NodeID& t : terminals ) {
+      visited[t] = true;
+      nodes.push_back(t);
+    }
+    for ( size_t i = 0; i < nodes.size(); ++i ) {
+      const NodeID u = nodes[i];
+      weight += _node_weight[u];
+      for ( size_t j = _first_out[u]; j < _first_out[u + 1]; ++j ) {
+        const EdgeID e = _incident_edges[j];
+        const NodeID v = head(e, u);
+        if ( !visited[v] && ( forward ? residualCapacity(e, u) : residualCapacity(e, v) ) > 0 ) {
+          visited[v] = true;
+          nodes.push_back(v);
+        }
+      }
+    }
+  };
+
+  bfs(_source_terminals, _reachable_from_source, _source_side_nodes, _source_side_weight, true);
+  bfs(_sink_terminals, _reaches_sink, _sink_side_nodes, _sink_side_weight, false);
+  ASSERT([&] {
+    for ( const NodeID& u : _source_side_nodes ) {
+      if ( _reaches_sink[u] ) {
+        return false;
+      }
+    }
+    return true;
+  }(), "Flow is not maximal");
+}
+
+bool GraphFlowCutter::selectBalancedCut(const HypernodeWeight max_weight_source_side,
+                                        const HypernodeWeight max_weight_sink_side) {
+  // Cut closest to the source terminals
+  const HypernodeWeight source_cut_max_weight = std::max(
+    _source_side_weight, _total_weight - _source_side_weight);
+  const bool is_source_cut_balanced = _source_side_weight <= max_weight_source_side &&
+    _total_weight - _source_side_weight <= max_weight_sink_side;
+  // Cut closest to the sink terminals
+  const HypernodeWeight sink_cut_max_weight = std::max(
+    _sink_side_weight, _total_weight - _sink_side_weight);
+  const bool is_sink_cut_balanced = _sink_side_weight <= max_weight_sink_side &&
+    _total_weight - _sink_side_weight <= max_weight_source_side;
+
+  if ( is_source_cut_balanced && ( !is_sink_cut_balanced || source_cut_max_weight <= sink_cut_max_weight ) ) {
+    _cut_at_source_side = true;
+    return true;
+  } else if ( is_sink_cut_balanced ) {
+    _cut_at_source_side = false;
+    return true;
+  }
+  return false;
+}
+
+bool GraphFlowCutter::pierce(const HypernodeWeight max_weight_source_side,
+                             const HypernodeWeight max_weight_sink_side) {
+  // We grow the lighter side. If this is not possible, we try the other one.
+  if ( _source_side_weight <= _sink_side_weight ) {
+    return pierceSide(Terminal::SOURCE, max_weight_source_side) ||
+           pierceSide(Terminal::SINK, max_weight_sink_side);
+  } else {
+    return pierceSide(Terminal::SINK, max_weight_sink_side) ||
+           pierceSide(Terminal::SOURCE, max_weight_source_side);
+  }
+}
+
+bool GraphFlowCutter::pierceSide(const Terminal side, const HypernodeWeight max_weight) {
+  const bool is_source = side == Terminal::SOURCE;
+  const vec<NodeID>& side_nodes = is_source ? _source_side_nodes : _sink_side_nodes;
+  const vec<bool>& in_side = is_source ? _reachable_from_source : _reaches_sink;
+  const vec<bool>& in_other_side = is_source ? _reaches_sink : _reachable_from_source;
+  const Terminal other_terminal = is_source ? Terminal::SINK : Terminal::SOURCE;
+  const HypernodeWeight side_weight = is_source ? _source_side_weight : _sink_side_weight;
+
+  // Search for a piercing node at the boundary of the side. We scan the side
+  // in reverse BFS order, since the nodes last visited are closest to the cut.
+  NodeID piercing_node = INVALID_NODE;
+  for ( auto it = side_nodes.rbegin(); it != side_nodes.rend(); ++it ) {
+    const NodeID u = *it;
+    for ( size_t j = _first_out[u]; j < _first_out[u + 1]; ++j ) {
+      const NodeID v = head(_incident_edges[j], u);
+      if ( !in_side[v] && _terminal[v] != other_terminal &&
+           side_weight + _node_weight[v] <= max_weight ) {
+        if ( !in_other_side[v] ) {
+          // Piercing v does not create an augmenting path
+          piercing_node = v;
+          break;
+        } else if ( piercing_node == INVALID_NODE ) {
+          piercing_node = v;
+        }
+      }
+    }
+    if ( piercing_node != INVALID_NODE && !in_other_side[piercing_node] ) {
+      break;
+    }
+  }
+
+  if ( piercing_node == INVALID_NODE ) {
+    return false;
+  }
+
+  // Assimilate side into the terminal set and add the piercing node
+  vec<NodeID>& terminals = is_source ? _source_terminals : _sink_terminals;
+  terminals.clear();
+  for ( const NodeID& u : side_nodes ) {
+    _terminal[u] = side;
+    terminals.push_back(u);
+  }
+  _terminal[piercing_node] = side;
+  terminals.push_back(piercing_node);
+  DBG << "Pierce node" << piercing_node << "on" << (is_source ? "source" : "sink") << "side"
+      << V(_flow_value) << V(_source_side_weight) << V(_sink_side_weight);
+  return true;
+}
+
+}  // namespace mt_kahypar
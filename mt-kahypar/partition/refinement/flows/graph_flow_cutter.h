@@ -0,0 +1,266 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+#include "mt-kahypar/datastructures/hypergraph_common.h"
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+
+namespace mt_kahypar {
+
+/*!
+ * FlowCutter (Hamann and Strasser) on an undirected flow graph in CSR format.
+ * On graphs, each edge of the flow network connects exactly two nodes. Thus,
+ * we can compute the flow directly on the edges instead of expanding each edge
+ * into a hyperedge of the WHFC flow network.
+ *
+ * The algorithm computes a maximum flow between the source and sink terminal
+ * sets (Dinic's algorithm). If one of the two cuts closest to the terminal sets
+ * induces a balanced bipartition, we are done. Otherwise, the lighter side is
+ * assimilated into its terminal set and one additional node is pierced, which
+ * augments the flow incrementally in the next iteration. Piercing nodes that do
+ * not create an augmenting path are preferred.
+ */
+class GraphFlowCutter {
+
+  static constexpr bool debug = false;
+
+ public:
+  using NodeID = uint32_t;
+  using EdgeID = uint32_t;
+  using Flow = HyperedgeWeight;
+
+  static constexpr NodeID source = 0;
+  static constexpr NodeID sink = 1;
+
+ private:
+  static constexpr int INVALID_LEVEL = -1;
+  static constexpr NodeID INVALID_NODE = std::numeric_limits<NodeID>::max();
+
+  enum class Terminal : uint8_t {
+    NONE,
+    SOURCE,
+    SINK
+  };
+
+  struct Edge {
+    NodeID u;
+    NodeID v;
+    Flow capacity;
+    // ! Flow from u to v (negative, if flow is sent from v to u)
+    Flow flow;
+  };
+
+  struct PathEdge {
+    EdgeID e;
+    NodeID from;
+  };
+
+ public:
+  GraphFlowCutter() :
+    _node_weight(),
+    _edges(),
+    _first_out(),
+    _incident_edges(),
+    _terminal(),
+    _source_terminals(),
+    _sink_terminals(),
+    _level(),
+    _current_edge(),
+    _queue(),
+    _path(),
+    _reachable_from_source(),
+    _reaches_sink(),
+    _source_side_nodes(),
+    _sink_side_nodes(),
+    _source_side_weight(0),
+    _sink_side_weight(0),
+    _total_weight(0),
+    _flow_value(0),
+    _cut_at_source_side(true) {
+    clear();
+  }
+
+  GraphFlowCutter(const GraphFlowCutter&) = delete;
+  GraphFlowCutter(GraphFlowCutter&&) = delete;
+  GraphFlowCutter & operator= (const GraphFlowCutter &) = delete;
+  GraphFlowCutter & operator= (GraphFlowCutter &&) = delete;
+
+  // ####################### Construction #######################
+
+  // ! Removes all nodes and edges except source and sink
+  void clear();
+
+  NodeID addNode(const HypernodeWeight weight) {
+    _node_weight.push_back(weight);
+    return _node_weight.size() - 1;
+  }
+
+  void setNodeWeight(const NodeID u, const HypernodeWeight weight) {
+    ASSERT(u < numNodes());
+    _node_weight[u] = weight;
+  }
+
+  void addEdge(const NodeID u, const NodeID v, const Flow capacity) {
+    ASSERT(u < numNodes() && v < numNodes() && u != v);
+    _edges.push_back(Edge { u, v, capacity, 0 });
+  }
+
+  // ! Builds the adjacency arrays. Must be called after all edges are added.
+  void finalize();
+
+  // ####################### Flow Computation #######################
+
+  // ! Computes minimum cuts until the bipartition induced by one of them is
+  // ! balanced. Returns false, if the flow exceeds the flow bound, no node can
+  // ! be pierced anymore or on_cut() returns false (called after each cut).
+  template<typename F>
+  bool computeBalancedCut(const HypernodeWeight max_weight_source_side,
+                          const HypernodeWeight max_weight_sink_side,
+                          const Flow flow_bound,
+                          const F& on_cut) {
+    initializeTerminals();
+    while ( true ) {
+      augmentFlow(flow_bound);
+      if ( _flow_value > flow_bound ) {
+        return false;
+      }
+
+      computeReachableSets();
+      if ( selectBalancedCut(max_weight_source_side, max_weight_sink_side) ) {
+        return true;
+      }
+
+      if ( !on_cut() || !pierce(max_weight_source_side, max_weight_sink_side) ) {
+        return false;
+      }
+    }
+  }
+
+  Flow flowValue() const {
+    return _flow_value;
+  }
+
+  // ! Returns true, if node u is on the source side of the last balanced cut
+  bool isSource(const NodeID u) const {
+    ASSERT(u < numNodes());
+    return _cut_at_source_side ? _reachable_from_source[u] : !_reaches_sink[u];
+  }
+
+  // ! Weight of the source side of the last balanced cut
+  HypernodeWeight sourceWeight() const {
+    return _cut_at_source_side ? _source_side_weight : _total_weight - _sink_side_weight;
+  }
+
+  // ! Weight of the sink side of the last balanced cut
+  HypernodeWeight sinkWeight() const {
+    return _total_weight - sourceWeight();
+  }
+
+  size_t numNodes() const {
+    return _node_weight.size();
+  }
+
+  size_t numEdges() const {
+    return _edges.size();
+  }
+
+ private:
+  void initializeTerminals();
+
+  // ! Augments the flow until no augmenting path exists or
+  // ! the flow value exceeds the flow bound
+  void augmentFlow(const Flow flow_bound);
+
+  // ! Computes the BFS levels of all nodes reachable from the source terminals.
+  // ! Returns true, if a sink terminal is reachable.
+  bool computeLevels();
+
+  // ! Sends a blocking flow from source terminal s along the level graph
+  Flow blockingFlow(const NodeID s);
+
+  void computeReachableSets();
+
+  bool selectBalancedCut(const HypernodeWeight max_weight_source_side,
+                         const HypernodeWeight max_weight_sink_side);
+
+  // ! Assimilates the lighter side into its terminal set and adds a
+  // ! further node to it. Returns false, if no node can be pierced.
+  bool pierce(const HypernodeWeight max_weight_source_side,
+              const HypernodeWeight max_weight_sink_side);
+
+  bool pierceSide(const Terminal side, const HypernodeWeight max_weight);
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE NodeID head(const EdgeID e, const NodeID from) const {
+    return _edges[e].u == from ? _edges[e].v : _edges[e].u;
+  }
+
+  // ! Residual capacity of edge e in direction from -> head(e, from)
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE Flow residualCapacity(const EdgeID e, const NodeID from) const {
+    const Edge& edge = _edges[e];
+    return edge.u == from ? edge.capacity - edge.flow : edge.capacity + edge.flow;
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE void pushFlow(const EdgeID e, const NodeID from, const Flow delta) {
+    Edge& edge = _edges[e];
+    edge.flow += edge.u == from ? delta : -delta;
+  }
+
+  vec<HypernodeWeight> _node_weight;
+  vec<Edge> _edges;
+  vec<size_t> _first_out;
+  vec<EdgeID> _incident_edges;
+
+  vec<Terminal> _terminal;
+  vec<NodeID> _source_terminals;
+  vec<NodeID> _sink_terminals;
+
+  // ! Data of Dinic's algorithm
+  vec<int> _level;
+  vec<size_t> _current_edge;
+  vec<NodeID> _queue;
+  vec<PathEdge> _path;
+
+  // ! Nodes reachable from the source terminals and nodes that can reach
+  // ! the sink terminals in the residual network (in BFS order)
+  vec<bool> _reachable_from_source;
+  vec<bool> _reaches_sink;
+  vec<NodeID> _source_side_nodes;
+  vec<NodeID> _sink_side_nodes;
+  HypernodeWeight _source_side_weight;
+  HypernodeWeight _sink_side_weight;
+
+  HypernodeWeight _total_weight;
+  Flow _flow_value;
+  // ! True, if the last balanced cut is the one closest to the source terminals
+  bool _cut_at_source_side;
+};
+
+}  // namespace mt_kahypar
@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "mt-kahypar/partition/refinement/flows/graph_flow_refiner.h"
+#include "mt-kahypar/utils/utilities.h"
+
+namespace mt_kahypar {
+
+MoveSequence GraphFlowRefiner::refineImpl(const PartitionedHypergraph& phg,
+                                          const Subhypergraph& sub_hg,
+                                          const HighResClockTimepoint& start) {
+  MoveSequence sequence { { }, 0 };
+  utils::Timer& timer = utils::Utilities::instance().getTimer(_context.utility_id);
+
+  timer.start_timer("construct_flow_network", "Construct Flow Network", true);
+  const HyperedgeWeight total_cut = constructFlowGraph(phg, sub_hg);
+  timer.stop_timer("construct_flow_network");
+  if ( total_cut > 0 ) {
+    const HypernodeWeight weight_of_block_0 = phg.partWeight(_block_0);
+    const HypernodeWeight weight_of_block_1 = phg.partWeight(_block_1);
+    const HypernodeWeight max_weight_block_0 = std::max(
+      weight_of_block_0, _context.partition.max_part_weights[_block_0]);
+    const HypernodeWeight max_weight_block_1 = std::max(
+      weight_of_block_1, _context.partition.max_part_weights[_block_1]);
+
+    bool time_limit_reached = false;
+    size_t iteration = 0;
+    auto on_cut = [&] {
+      if (++iteration == 25) {
+        iteration = 0;
+        const double elapsed = std::chrono::duration<double>(
+          std::chrono::high_resolution_clock::now() - start).count();
+        if (elapsed > _time_limit) {
+          time_limit_reached = true;
+          return false;
+        }
+      }
+      return true;
+    };
+
+    // Solve max-flow min-cut problem
+    timer.start_timer("graph_flow_cutter", "Graph FlowCutter", true);
+    const bool flowcutter_succeeded = _flow_graph.computeBalancedCut(
+      max_weight_block_0, max_weight_block_1, total_cut, on_cut);
+    timer.stop_timer("graph_flow_cutter");
+    if ( flowcutter_succeeded ) {
+      // We apply the solution if it either improves the cut or the balance of
+      // the bipartition induced by the two blocks
+      const HyperedgeWeight new_cut = _flow_graph.flowValue();
+      const HypernodeWeight max_part_weight = std::max(
+        _flow_graph.sourceWeight(), _flow_graph.sinkWeight());
+      const bool improved_solution = new_cut < total_cut ||
+        (new_cut == total_cut && max_part_weight < std::max(weight_of_block_0, weight_of_block_1));
+
+      // Extract move sequence
+      if ( improved_solution ) {
+        sequence.expected_improvement = total_cut - new_cut;
+        for ( NodeID u = 0; u < _flow_graph.numNodes(); ++u ) {
+          const HypernodeID hn = _flow_to_node[u];
+          if ( hn != kInvalidHypernode ) {
+            const PartitionID from = phg.partID(hn);
+            const PartitionID to = _flow_graph.isSource(u) ? _block_0 : _block_1;
+            if ( from != to ) {
+              sequence.moves.push_back(Move { from, to, hn, kInvalidGain });
+            }
+          }
+        }
+      }
+    } else if ( time_limit_reached ) {
+      sequence.state = MoveSequenceState::TIME_LIMIT;
+    }
+  }
+  return sequence;
+}
+
+HyperedgeWeight GraphFlowRefiner::constructFlowGraph(const PartitionedHypergraph& phg,
+                                                     const Subhypergraph& sub_hg) {
+  _block_0 = sub_hg.block_0;
+  _block_1 = sub_hg.block_1;
+  ASSERT(_block_0 != kInvalidPartition && _block_1 != kInvalidPartition);
+  _flow_graph.clear();
+  _node_to_flow.clear();
+  _flow_to_node.assign(2, kInvalidHypernode);
+
+  // All vertices of block 0 (block 1) not contained in the region are
+  // contracted into the source (sink)
+  _flow_graph.setNodeWeight(GraphFlowCutter::source,
+    std::max(0, phg.partWeight(_block_0) - sub_hg.weight_of_block_0));
+  _flow_graph.setNodeWeight(GraphFlowCutter::sink,
+    std::max(0, phg.partWeight(_block_1) - sub_hg.weight_of_block_1));
+  auto add_node = [&](const HypernodeID hn) {
+    _node_to_flow[hn] = _flow_graph.addNode(phg.nodeWeight(hn));
+    _flow_to_node.push_back(hn);
+  };
+  for ( const HypernodeID& hn : sub_hg.nodes_of_block_0 ) {
+    add_node(hn);
+  }
+  for ( const HypernodeID& hn : sub_hg.nodes_of_block_1 ) {
+    add_node(hn);
+  }
+
+  HyperedgeWeight total_cut = 0;
+  for ( NodeID u = 2; u < _flow_graph.numNodes(); ++u ) {
+    const HypernodeID hn = _flow_to_node[u];
+    const PartitionID block_of_hn = phg.partID(hn);
+    HyperedgeWeight capacity_to_source = 0;
+    HyperedgeWeight capacity_to_sink = 0;
+    for ( const HyperedgeID& he : phg.incidentEdges(hn) ) {
+      ASSERT(phg.edgeSize(he) == 2, "Graph flow refiner only works for graphs");
+      HypernodeID target = hn;
+      for ( const HypernodeID& pin : phg.pins(he) ) {
+        if ( pin != hn ) {
+          target = pin;
+        }
+      }
+
+      const HyperedgeWeight edge_weight = phg.edgeWeight(he);
+      const PartitionID block_of_target = phg.partID(target);
+      const NodeID* v = _node_to_flow.get_if_contained(target);
+      if ( v ) {
+        // Both endpoints are contained in the flow network. Each edge
+        // is visited from both endpoints, so we add it only once.
+        if ( u < *v ) {
+          _flow_graph.addEdge(u, *v, edge_weight);
+          total_cut += block_of_hn != block_of_target ? edge_weight : 0;
+        }
+      } else if ( block_of_target == _block_0 ) {
+        capacity_to_source += edge_weight;
+        total_cut += block_of_hn == _block_1 ? edge_weight : 0;
+      } else if ( block_of_target == _block_1 ) {
+        capacity_to_sink += edge_weight;
+        total_cut += block_of_hn == _block_0 ? edge_weight : 0;
+      }
+      // Edges to other blocks remain cut edges => not part of the flow network
+    }
+
+    // Parallel edges to the source or sink are merged into one edge
+    if ( capacity_to_source > 0 ) {
+      _flow_graph.addEdge(GraphFlowCutter::source, u, capacity_to_source);
+    }
+    if ( capacity_to_sink > 0 ) {
+      _flow_graph.addEdge(u, GraphFlowCutter::sink, capacity_to_sink);
+    }
+  }
+  _flow_graph.finalize();
+
+  DBG << "Flow Graph [ Nodes =" << _flow_graph.numNodes()
+      << ", Edges =" << _flow_graph.numEdges()
+      << ", Blocks = (" << _block_0 << "," << _block_1 << ") ]";
+
+  return total_cut;
+}
+
+} // namespace mt_kahypar
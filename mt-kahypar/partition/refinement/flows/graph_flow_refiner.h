@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/refinement/flows/i_flow_refiner.h"
+#include "mt-kahypar/partition/refinement/flows/graph_flow_cutter.h"
+#include "mt-kahypar/datastructures/sparse_map.h"
+
+namespace mt_kahypar {
+
+/*!
+ * Flow-based refiner for plain graphs. The flow network is a subgraph of the
+ * input graph in which all vertices outside of the region of block 0 (block 1)
+ * are contracted into the source (sink). The flow network is not expanded into
+ * a flow hypergraph, which halves the memory of the flow network and lets us
+ * push flow directly along the edges (see GraphFlowCutter).
+ * Since each edge has exactly two pins, the refiner must only be used for
+ * graphs.
+ */
+class GraphFlowRefiner final : public IFlowRefiner {
+
+  static constexpr bool debug = false;
+
+  using NodeID = GraphFlowCutter::NodeID;
+
+ public:
+  explicit GraphFlowRefiner(const Hypergraph&,
+                            const Context& context) :
+    _phg(nullptr),
+    _context(context),
+    _block_0(kInvalidPartition),
+    _block_1(kInvalidPartition),
+    _flow_graph(),
+    _node_to_flow(),
+    _flow_to_node() { }
+
+  GraphFlowRefiner(const GraphFlowRefiner&) = delete;
+  GraphFlowRefiner(GraphFlowRefiner&&) = delete;
+  GraphFlowRefiner & operator= (const GraphFlowRefiner &) = delete;
+  GraphFlowRefiner & operator= (GraphFlowRefiner &&) = delete;
+
+  virtual ~GraphFlowRefiner() = default;
+
+ private:
+  void initializeImpl(const PartitionedHypergraph& phg) {
+    _phg = &phg;
+    _time_limit = std::numeric_limits<double>::max();
+    _block_0 = kInvalidPartition;
+    _block_1 = kInvalidPartition;
+    _flow_graph.clear();
+    _flow_to_node.clear();
+  }
+
+  MoveSequence refineImpl(const PartitionedHypergraph& phg,
+                          const Subhypergraph& sub_hg,
+                          const HighResClockTimepoint& start);
+
+  // ! Constructs the flow network and returns the weight of the cut
+  // ! edges between both blocks contained in the flow network
+  HyperedgeWeight constructFlowGraph(const PartitionedHypergraph& phg,
+                                     const Subhypergraph& sub_hg);
+
+  PartitionID maxNumberOfBlocksPerSearchImpl() const {
+    return 2;
+  }
+
+  // ! The flow computation is sequential
+  void setNumThreadsForSearchImpl(const size_t) { }
+
+  const PartitionedHypergraph* _phg;
+  const Context& _context;
+  using IFlowRefiner::_time_limit;
+
+  PartitionID _block_0;
+  PartitionID _block_1;
+  GraphFlowCutter _flow_graph;
+  ds::DynamicSparseMap<HypernodeID, NodeID> _node_to_flow;
+  vec<HypernodeID> _flow_to_node;
+};
+}  // namespace mt_kahypar
@@ -102,6 +102,9 @@ FlowProblem ParallelConstruction::constructFlowHypergraph(const PartitionedHyper
     flow_problem.non_removable_cut = 0;
     flow_problem.total_cut = 0;
   } else {
+    if ( _context.refinement.flows.reorder_nodes ) {
+      reorderNodes(flow_problem, whfc_to_node);
+    }
     _flow_hg.finalizeParallel();
 
     if ( _context.refinement.flows.determine_distance_from_cut ) {
@@ -145,6 +148,9 @@ FlowProblem ParallelConstruction::constructFlowHypergraph(const PartitionedHyper
     flow_problem.non_removable_cut = 0;
     flow_problem.total_cut = 0;
   } else {
+    if ( _context.refinement.flows.reorder_nodes ) {
+      reorderNodes(flow_problem, whfc_to_node);
+    }
     _flow_hg.finalizeParallel();
 
     if ( _context.refinement.flows.determine_distance_from_cut ) {
@@ -512,6 +518,18 @@ FlowProblem ParallelConstruction::constructOptimizedForLargeHEs(const Partitione
   return flow_problem;
 }
 
+void ParallelConstruction::reorderNodes(const FlowProblem& flow_problem,
+                                        vec<HypernodeID>& whfc_to_node) {
+  const vec<whfc::Node>& new_node_id =
+    _flow_hg.reorderNodes(flow_problem.source, flow_problem.sink);
+  _tmp_whfc_to_node.resize(whfc_to_node.size());
+  std::copy(whfc_to_node.begin(), whfc_to_node.end(), _tmp_whfc_to_node.begin());
+  tbb::parallel_for(UL(0), static_cast<size_t>(_flow_hg.numNodes()), [&](const size_t i) {
+    const whfc::Node u(i);
+    whfc_to_node[new_node_id[u]] = _tmp_whfc_to_node[u];
+  });
+}
+
 namespace {
 template<typename T>
 class BFSQueue {
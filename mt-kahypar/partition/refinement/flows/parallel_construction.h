@@ -122,7 +122,8 @@ class ParallelConstruction {
     _cut_hes(),
     _pins(),
     _he_to_whfc(),
-    _identical_nets(hg, flow_hg, context) { }
+    _identical_nets(hg, flow_hg, context),
+    _tmp_whfc_to_node() { }
 
   ParallelConstruction(const ParallelConstruction&) = delete;
   ParallelConstruction(ParallelConstruction&&) = delete;
@@ -159,6 +160,11 @@ class ParallelConstruction {
                                             const PartitionID block_1,
                                             vec<HypernodeID>& whfc_to_node);
 
+  // ! Renumbers the nodes of the flow network to improve locality
+  // ! (see FlowHypergraphBuilder::reorderNodes(...))
+  void reorderNodes(const FlowProblem& flow_problem,
+                    vec<HypernodeID>& whfc_to_node);
+
   void determineDistanceFromCut(const PartitionedHypergraph& phg,
                                 const whfc::Node source,
                                 const whfc::Node sink,
@@ -188,5 +194,7 @@ class ParallelConstruction {
   ds::ConcurrentFlatMap<HyperedgeID, HyperedgeID> _he_to_whfc;
 
   DynamicIdenticalNetDetection _identical_nets;
+
+  vec<HypernodeID> _tmp_whfc_to_node;
 };
 }  // namespace mt_kahypar
@@ -44,9 +44,18 @@ void ProblemConstruction::BFSData::reset() {
   queue_weight_block_1 = 0;
   lock_queue = false;
   clearQueue();
-  std::fill(visited_hn.begin(), visited_hn.end(), false);
-  std::fill(visited_he.begin(), visited_he.end(), false);
-  std::fill(contained_hes.begin(), contained_hes.end(), false);
+  for ( const HypernodeID& hn : touched_hns ) {
+    visited_hn[hn] = false;
+  }
+  for ( const HyperedgeID& he : touched_hes ) {
+    visited_he[he] = false;
+  }
+  for ( const HyperedgeID& id : touched_contained_hes ) {
+    contained_hes[id] = false;
+  }
+  touched_hns.clear();
+  touched_hes.clear();
+  touched_contained_hes.clear();
   std::fill(locked_blocks.begin(), locked_blocks.end(), false);
 }
 
@@ -70,15 +79,19 @@ void ProblemConstruction::BFSData::add_pins_of_hyperedge_to_queue(
           const PartitionID block = phg.partID(pin);
           const bool is_block_0 = blocks.i == block;
           const bool is_block_1 = blocks.j == block;
-          if ( (is_block_0 || is_block_1) && !locked_blocks[block] ) {
+          // Fixed vertices are never added to the region. Thus, they are
+          // contracted into the source or sink of the flow problem.
+          if ( (is_block_0 || is_block_1) && !locked_blocks[block] && !phg.isFixed(pin) ) {
             next_queue.push(pin);
             queue_weight_block_0 += is_block_0 ? phg.nodeWeight(pin) : 0;
             queue_weight_block_1 += is_block_1 ? phg.nodeWeight(pin) : 0;
           }
           visited_hn[pin] = true;
+          touched_hns.push_back(pin);
         }
       }
       visited_he[he] = true;
+      touched_hes.push_back(he);
     }
   }
 
@@ -92,38 +105,98 @@ namespace {
   using assert_map = std::unordered_map<HyperedgeID, bool>;
 }
 
-Subhypergraph ProblemConstruction::construct(const SearchID search_id,
-                                             QuotientGraph& quotient_graph,
-                                             const PartitionedHypergraph& phg) {
+Subhypergraph ProblemConstruction::initializeConstruction(BFSData& bfs,
+                                                          const BlockPair& blocks,
+                                                          const PartitionedHypergraph& phg,
+                                                          HypernodeWeight& max_weight_block_0,
+                                                          HypernodeWeight& max_weight_block_1) {
   Subhypergraph sub_hg;
-  BFSData& bfs = _local_bfs.local();
   bfs.reset();
-  bfs.blocks = quotient_graph.getBlockPair(search_id);
+  bfs.blocks = blocks;
   sub_hg.block_0 = bfs.blocks.i;
   sub_hg.block_1 = bfs.blocks.j;
   sub_hg.weight_of_block_0 = 0;
   sub_hg.weight_of_block_1 = 0;
   sub_hg.num_pins = 0;
-  const HypernodeWeight max_weight_block_0 =
+  max_weight_block_0 =
     _scaling * _context.partition.perfect_balance_part_weights[sub_hg.block_1] - phg.partWeight(sub_hg.block_1);
-  const HypernodeWeight max_weight_block_1 =
+  max_weight_block_1 =
     _scaling * _context.partition.perfect_balance_part_weights[sub_hg.block_0] - phg.partWeight(sub_hg.block_0);
-  const size_t max_bfs_distance = _context.refinement.flows.max_bfs_distance;
+  bfs.clearQueue();
+  return sub_hg;
+}
 
+Subhypergraph ProblemConstruction::construct(const SearchID search_id,
+                                             QuotientGraph& quotient_graph,
+                                             const PartitionedHypergraph& phg) {
+  BFSData& bfs = _local_bfs.local();
+  HypernodeWeight max_weight_block_0 = 0;
+  HypernodeWeight max_weight_block_1 = 0;
+  Subhypergraph sub_hg = initializeConstruction(bfs, quotient_graph.getBlockPair(search_id),
+    phg, max_weight_block_0, max_weight_block_1);
+  const size_t max_bfs_distance = _context.refinement.flows.max_bfs_distance;
 
   // We initialize the BFS with all cut hyperedges running
   // between the involved block associated with the search
-  bfs.clearQueue();
   quotient_graph.doForAllCutHyperedgesOfSearch(search_id, [&](const HyperedgeID& he) {
     bfs.add_pins_of_hyperedge_to_queue(he, phg, max_bfs_distance,
       max_weight_block_0, max_weight_block_1);
   });
   bfs.swap_with_next_queue();
 
-  // BFS
+  growRegion(bfs, sub_hg, phg, max_weight_block_0, max_weight_block_1, max_bfs_distance);
+  DBG << "Search ID:" << search_id << "-" << sub_hg;
+  return sub_hg;
+}
+
+Subhypergraph ProblemConstruction::constructAroundSeeds(const BlockPair& blocks,
+                                                        const vec<HypernodeID>& seeds,
+                                                        const PartitionedHypergraph& phg) {
+  BFSData& bfs = _local_bfs.local();
+  HypernodeWeight max_weight_block_0 = 0;
+  HypernodeWeight max_weight_block_1 = 0;
+  Subhypergraph sub_hg = initializeConstruction(bfs, blocks,
+    phg, max_weight_block_0, max_weight_block_1);
+  const size_t max_bfs_distance = _context.refinement.flows.localized_max_bfs_distance;
+
+  // We initialize the BFS with all cut hyperedges between both
+  // blocks that are incident to a seed vertex
+  for ( const HypernodeID& hn : seeds ) {
+    ASSERT(phg.partID(hn) == blocks.i || phg.partID(hn) == blocks.j);
+    for ( const HyperedgeID& he : phg.incidentEdges(hn) ) {
+      if ( phg.pinCountInPart(he, blocks.i) > 0 && phg.pinCountInPart(he, blocks.j) > 0 ) {
+        bfs.add_pins_of_hyperedge_to_queue(he, phg, max_bfs_distance,
+          max_weight_block_0, max_weight_block_1);
+      }
+    }
+  }
+  bfs.swap_with_next_queue();
+
+  growRegion(bfs, sub_hg, phg, max_weight_block_0, max_weight_block_1, max_bfs_distance);
+  DBG << "Localized Search ( Blocks = (" << blocks.i << "," << blocks.j << "), Seeds ="
+      << seeds.size() << ") -" << sub_hg;
+  return sub_hg;
+}
+
+void ProblemConstruction::growRegion(BFSData& bfs,
+                                     Subhypergraph& sub_hg,
+                                     const PartitionedHypergraph& phg,
+                                     const HypernodeWeight max_weight_block_0,
+                                     const HypernodeWeight max_weight_block_1,
+                                     const size_t max_bfs_distance) {
+  const size_t max_num_pins = reservePins();
   while ( !bfs.is_empty() &&
           !isMaximumProblemSizeReached(sub_hg,
-            max_weight_block_0, max_weight_block_1, bfs.locked_blocks) ) {
+            max_weight_block_0, max_weight_block_1, max_num_pins, bfs.locked_blocks) ) {
+    if ( sub_hg.num_pins >= _context.refinement.flows.min_num_pins_for_parallel_region_growing &&
+         _parallel_bfs_lock.tryLock() ) {
+      // Region becomes large => continue with parallel BFS
+      growRegionInParallel(bfs, sub_hg, phg, max_weight_block_0,
+        max_weight_block_1, max_num_pins, max_bfs_distance);
+      _parallel_bfs_lock.unlock();
+      break;
+    }
+
     HypernodeID hn = bfs.pop_hypernode();
     PartitionID block = phg.partID(hn);
     const bool is_block_contained = block == sub_hg.block_0 || block == sub_hg.block_1;
@@ -145,6 +218,7 @@ Subhypergraph ProblemConstruction::construct(const SearchID search_id,
         if ( !bfs.contained_hes[phg.uniqueEdgeID(he)] ) {
           sub_hg.hes.push_back(he);
           bfs.contained_hes[phg.uniqueEdgeID(he)] = true;
+          bfs.touched_contained_hes.push_back(phg.uniqueEdgeID(he));
         }
       }
     }
@@ -154,8 +228,6 @@ Subhypergraph ProblemConstruction::construct(const SearchID search_id,
     }
   }
 
-  DBG << "Search ID:" << search_id << "-" << sub_hg;
-
   // Check if all touched hyperedges are contained in subhypergraph
   ASSERT([&]() {
     assert_map expected_hes;
@@ -201,7 +273,170 @@ Subhypergraph ProblemConstruction::construct(const SearchID search_id,
     return true;
   }(), "Subhypergraph construction failed!");
 
-  return sub_hg;
+  if ( usePinBudget() ) {
+    // The region can exceed the reserved pins by the degree of the vertices
+    // added last => adapt reservation to the actual number of pins
+    if ( sub_hg.num_pins < max_num_pins ) {
+      _num_reserved_pins.fetch_sub(max_num_pins - sub_hg.num_pins, std::memory_order_relaxed);
+    } else {
+      _num_reserved_pins.fetch_add(sub_hg.num_pins - max_num_pins, std::memory_order_relaxed);
+    }
+  }
+}
+
+size_t ProblemConstruction::reservePins() {
+  const size_t max_num_pins = _context.refinement.flows.max_num_pins;
+  if ( !usePinBudget() ) {
+    return max_num_pins;
+  }
+
+  const size_t budget = _context.refinement.flows.max_num_pins_of_concurrent_searches;
+  const size_t fair_share = budget / std::max(UL(1), _context.refinement.flows.num_parallel_searches);
+  size_t reserved = _num_reserved_pins.load(std::memory_order_relaxed);
+  size_t num_pins = 0;
+  do {
+    const size_t available = budget - std::min(budget, reserved);
+    num_pins = std::min({ max_num_pins, available, std::max(fair_share, available / 2) });
+  } while ( !_num_reserved_pins.compare_exchange_weak(
+    reserved, reserved + num_pins, std::memory_order_relaxed) );
+  DBG << "Reserved" << num_pins << "pins ( Total Reserved =" << ( reserved + num_pins )
+      << ", Budget =" << budget << ")";
+  return num_pins;
+}
+
+void ProblemConstruction::growRegionInParallel(BFSData& bfs,
+                                               Subhypergraph& sub_hg,
+                                               const PartitionedHypergraph& phg,
+                                               const HypernodeWeight max_weight_block_0,
+                                               const HypernodeWeight max_weight_block_1,
+                                               const size_t max_num_pins,
+                                               const size_t max_bfs_distance) {
+  ParallelBFSData& par_bfs = _parallel_bfs;
+  par_bfs.initialize(_num_nodes, _num_edges);
+  par_bfs.reset();
+  // Transfer visited flags of the sequential BFS
+  for ( const HypernodeID& hn : bfs.touched_hns ) {
+    par_bfs.visited_hn.setUnsafe(hn, true);
+  }
+  for ( const HyperedgeID& he : bfs.touched_hes ) {
+    par_bfs.visited_he.setUnsafe(he, true);
+  }
+  for ( const HyperedgeID& id : bfs.touched_contained_hes ) {
+    par_bfs.contained_hes.setUnsafe(id, true);
+  }
+
+  // Remaining vertices of the current level and vertices of the next level
+  vec<HypernodeID> current_level;
+  while ( !bfs.queue.empty() ) {
+    current_level.push_back(bfs.pop_hypernode());
+  }
+  vec<HypernodeID> next_level;
+  while ( !bfs.next_queue.empty() ) {
+    next_level.push_back(bfs.next_queue.front());
+    bfs.next_queue.pop();
+  }
+
+  struct LocalRegion {
+    vec<HypernodeID> nodes_of_block_0;
+    vec<HypernodeID> nodes_of_block_1;
+    vec<HyperedgeID> hes;
+    vec<HypernodeID> next_level;
+  };
+  tbb::enumerable_thread_specific<LocalRegion> local_region;
+
+  const PartitionID block_0 = sub_hg.block_0;
+  const PartitionID block_1 = sub_hg.block_1;
+  CAtomic<HypernodeWeight> weight_of_block_0(sub_hg.weight_of_block_0);
+  CAtomic<HypernodeWeight> weight_of_block_1(sub_hg.weight_of_block_1);
+  CAtomic<size_t> num_pins(sub_hg.num_pins);
+  CAtomic<HypernodeWeight> queue_weight_block_0(bfs.queue_weight_block_0);
+  CAtomic<HypernodeWeight> queue_weight_block_1(bfs.queue_weight_block_1);
+  CAtomic<bool> lock_queue(bfs.lock_queue);
+  vec<bool>& locked_blocks = bfs.locked_blocks;
+  while ( !current_level.empty() && !( locked_blocks[block_0] && locked_blocks[block_1] ) ) {
+    const bool expand = bfs.current_distance <= max_bfs_distance;
+    const bool block_0_locked = locked_blocks[block_0];
+    const bool block_1_locked = locked_blocks[block_1];
+    tbb::parallel_for(UL(0), current_level.size(), [&](const size_t i) {
+      const HypernodeID hn = current_level[i];
+      const PartitionID block = phg.partID(hn);
+      if ( ( block != block_0 || block_0_locked ) && ( block != block_1 || block_1_locked ) ) {
+        return;
+      }
+
+      // Reserve weight and pins of the vertex in the region. Similar to the
+      // sequential BFS, a vertex is added as long as the limits are not reached
+      // before adding it.
+      const HypernodeWeight weight = phg.nodeWeight(hn);
+      const HypernodeID degree = phg.nodeDegree(hn);
+      CAtomic<HypernodeWeight>& block_weight = block == block_0 ? weight_of_block_0 : weight_of_block_1;
+      const HypernodeWeight max_block_weight = block == block_0 ? max_weight_block_0 : max_weight_block_1;
+      if ( block_weight.fetch_add(weight, std::memory_order_relaxed) >= max_block_weight ) {
+        block_weight.fetch_sub(weight, std::memory_order_relaxed);
+        return;
+      }
+      if ( num_pins.fetch_add(degree, std::memory_order_relaxed) >= max_num_pins ) {
+        num_pins.fetch_sub(degree, std::memory_order_relaxed);
+        block_weight.fetch_sub(weight, std::memory_order_relaxed);
+        return;
+      }
+
+      LocalRegion& region = local_region.local();
+      ( block == block_0 ? region.nodes_of_block_0 : region.nodes_of_block_1 ).push_back(hn);
+      for ( const HyperedgeID& he : phg.incidentEdges(hn) ) {
+        if ( expand && !lock_queue.load(std::memory_order_relaxed) &&
+             par_bfs.visited_he.compare_and_set_to_true(he) ) {
+          // Push all pins of he into the next level
+          for ( const HypernodeID& pin : phg.pins(he) ) {
+            if ( par_bfs.visited_hn.compare_and_set_to_true(pin) ) {
+              const PartitionID block_of_pin = phg.partID(pin);
+              if ( ( ( block_of_pin == block_0 && !block_0_locked ) ||
+                     ( block_of_pin == block_1 && !block_1_locked ) ) && !phg.isFixed(pin) ) {
+                region.next_level.push_back(pin);
+                const HypernodeWeight pin_weight = phg.nodeWeight(pin);
+                const HypernodeWeight queue_weight_0 = block_of_pin == block_0 ?
+                  queue_weight_block_0.add_fetch(pin_weight, std::memory_order_relaxed) :
+                  queue_weight_block_0.load(std::memory_order_relaxed);
+                const HypernodeWeight queue_weight_1 = block_of_pin == block_1 ?
+                  queue_weight_block_1.add_fetch(pin_weight, std::memory_order_relaxed) :
+                  queue_weight_block_1.load(std::memory_order_relaxed);
+                if ( queue_weight_0 >= max_weight_block_0 && queue_weight_1 >= max_weight_block_1 ) {
+                  lock_queue.store(true, std::memory_order_relaxed);
+                }
+              }
+            }
+          }
+        }
+        if ( par_bfs.contained_hes.compare_and_set_to_true(phg.uniqueEdgeID(he)) ) {
+          region.hes.push_back(he);
+        }
+      }
+    });
+
+    // Collect vertices and hyperedges added to the region and
+    // the vertices of the next level
+    for ( LocalRegion& region : local_region ) {
+      sub_hg.nodes_of_block_0.insert(sub_hg.nodes_of_block_0.end(),
+        region.nodes_of_block_0.begin(), region.nodes_of_block_0.end());
+      sub_hg.nodes_of_block_1.insert(sub_hg.nodes_of_block_1.end(),
+        region.nodes_of_block_1.begin(), region.nodes_of_block_1.end());
+      sub_hg.hes.insert(sub_hg.hes.end(), region.hes.begin(), region.hes.end());
+      next_level.insert(next_level.end(), region.next_level.begin(), region.next_level.end());
+      region.nodes_of_block_0.clear();
+      region.nodes_of_block_1.clear();
+      region.hes.clear();
+      region.next_level.clear();
+    }
+    sub_hg.weight_of_block_0 = weight_of_block_0.load(std::memory_order_relaxed);
+    sub_hg.weight_of_block_1 = weight_of_block_1.load(std::memory_order_relaxed);
+    sub_hg.num_pins = num_pins.load(std::memory_order_relaxed);
+    isMaximumProblemSizeReached(sub_hg, max_weight_block_0,
+      max_weight_block_1, max_num_pins, locked_blocks);
+
+    std::swap(current_level, next_level);
+    next_level.clear();
+    ++bfs.current_distance;
+  }
 }
 
 void ProblemConstruction::changeNumberOfBlocks(const PartitionID new_k) {
@@ -216,6 +451,7 @@ MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool ProblemConstruction::isMaximumProblemSiz
   const Subhypergraph& sub_hg,
   const HypernodeWeight max_weight_block_0,
   const HypernodeWeight max_weight_block_1,
+  const size_t max_num_pins,
   vec<bool>& locked_blocks) const {
   if ( sub_hg.weight_of_block_0 >= max_weight_block_0 ) {
     locked_blocks[sub_hg.block_0] = true;
@@ -223,7 +459,7 @@ MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool ProblemConstruction::isMaximumProblemSiz
   if ( sub_hg.weight_of_block_1 >= max_weight_block_1 ) {
     locked_blocks[sub_hg.block_1] = true;
   }
-  if ( sub_hg.num_pins >= _context.refinement.flows.max_num_pins ) {
+  if ( sub_hg.num_pins >= max_num_pins ) {
     locked_blocks[sub_hg.block_0] = true;
     locked_blocks[sub_hg.block_1] = true;
   }
@@ -31,6 +31,7 @@
 #include "mt-kahypar/definitions.h"
 #include "mt-kahypar/partition/context.h"
 #include "mt-kahypar/datastructures/sparse_map.h"
+#include "mt-kahypar/datastructures/thread_safe_fast_reset_flag_array.h"
 #include "mt-kahypar/partition/refinement/flows/refiner_adapter.h"
 #include "mt-kahypar/partition/refinement/flows/quotient_graph.h"
 #include "mt-kahypar/parallel/stl/scalable_vector.h"
@@ -57,6 +58,9 @@ class ProblemConstruction {
       visited_hn(num_nodes, false),
       visited_he(num_edges, false),
       contained_hes(num_edges, false),
+      touched_hns(),
+      touched_hes(),
+      touched_contained_hes(),
       locked_blocks(k, false),
       queue_weight_block_0(0),
       queue_weight_block_1(0),
@@ -96,19 +100,59 @@ class ProblemConstruction {
     vec<bool> visited_hn;
     vec<bool> visited_he;
     vec<bool> contained_hes;
+    // ! Entries set in visited_hn, visited_he and contained_hes. Thus, resetting
+    // ! the BFS data is proportional to the size of the last region and not to
+    // ! the size of the hypergraph.
+    vec<HypernodeID> touched_hns;
+    vec<HyperedgeID> touched_hes;
+    vec<HyperedgeID> touched_contained_hes;
     vec<bool> locked_blocks;
     HypernodeWeight queue_weight_block_0;
     HypernodeWeight queue_weight_block_1;
     bool lock_queue;
   };
 
+  /**
+   * Visited flags of the level-synchronous parallel BFS. They are shared
+   * by all searches, but only one search can grow its region in parallel
+   * at a time (see _parallel_bfs_lock).
+   */
+  struct ParallelBFSData {
+    ParallelBFSData() :
+      visited_hn(),
+      visited_he(),
+      contained_hes() { }
+
+    void initialize(const HypernodeID num_nodes,
+                    const HyperedgeID num_edges) {
+      visited_hn.resize(num_nodes);
+      visited_he.resize(num_edges);
+      contained_hes.resize(num_edges);
+    }
+
+    void reset() {
+      visited_hn.reset();
+      visited_he.reset();
+      contained_hes.reset();
+    }
+
+    ds::ThreadSafeFastResetFlagArray<> visited_hn;
+    ds::ThreadSafeFastResetFlagArray<> visited_he;
+    ds::ThreadSafeFastResetFlagArray<> contained_hes;
+  };
+
  public:
   explicit ProblemConstruction(const Hypergraph& hg,
                                const Context& context) :
     _context(context),
     _scaling(1.0 + _context.refinement.flows.alpha *
       std::min(0.05, _context.partition.epsilon)),
-    _local_bfs(hg.initialNumNodes(), hg.initialNumEdges(), context.partition.k) { }
+    _local_bfs(hg.initialNumNodes(), hg.initialNumEdges(), context.partition.k),
+    _num_nodes(hg.initialNumNodes()),
+    _num_edges(hg.initialNumEdges()),
+    _parallel_bfs_lock(),
+    _parallel_bfs(),
+    _num_reserved_pins(0) { }
 
   ProblemConstruction(const ProblemConstruction&) = delete;
   ProblemConstruction(ProblemConstruction&&) = delete;
@@ -120,21 +164,92 @@ class ProblemConstruction {
                           QuotientGraph& quotient_graph,
                           const PartitionedHypergraph& phg);
 
+  // ! Grows a flow problem between the two blocks around the cut hyperedges
+  // ! incident to the seed vertices (used for localized flow refinement).
+  // ! The maximum BFS distance is r-flow-localized-max-bfs-distance.
+  Subhypergraph constructAroundSeeds(const BlockPair& blocks,
+                                     const vec<HypernodeID>& seeds,
+                                     const PartitionedHypergraph& phg);
+
+  // ! Returns the pins of the flow problem to the global pin budget
+  // ! shared by all concurrent searches. Must be called once the flow
+  // ! problem is solved.
+  void releasePins(const Subhypergraph& sub_hg) {
+    if ( usePinBudget() ) {
+      ASSERT(sub_hg.num_pins <= _num_reserved_pins.load(std::memory_order_relaxed));
+      _num_reserved_pins.fetch_sub(sub_hg.num_pins, std::memory_order_relaxed);
+    }
+  }
+
+  // ! Only for testing
+  size_t numReservedPins() const {
+    return _num_reserved_pins.load(std::memory_order_relaxed);
+  }
+
   void changeNumberOfBlocks(const PartitionID new_k);
 
  private:
 
+  bool usePinBudget() const {
+    return _context.refinement.flows.max_num_pins_of_concurrent_searches !=
+      std::numeric_limits<size_t>::max();
+  }
+
+  // ! Reserves pins for a new flow problem from the global pin budget and returns
+  // ! the maximum number of pins of the flow problem. If the budget is tight,
+  // ! the flow problem shrinks instead of exceeding the budget. A search gets at
+  // ! least its fair share of the budget (if available) and at most half of the
+  // ! remaining budget beyond that, such that concurrent searches are not starved.
+  size_t reservePins();
+
+  // ! Initializes the BFS and the subhypergraph for the given block pair
+  Subhypergraph initializeConstruction(BFSData& bfs,
+                                       const BlockPair& blocks,
+                                       const PartitionedHypergraph& phg,
+                                       HypernodeWeight& max_weight_block_0,
+                                       HypernodeWeight& max_weight_block_1);
+
+  // ! Adds the vertices in the queue of the BFS to the subhypergraph and
+  // ! continues the BFS until the maximum problem size is reached
+  void growRegion(BFSData& bfs,
+                  Subhypergraph& sub_hg,
+                  const PartitionedHypergraph& phg,
+                  const HypernodeWeight max_weight_block_0,
+                  const HypernodeWeight max_weight_block_1,
+                  const size_t max_bfs_distance);
+
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE bool isMaximumProblemSizeReached(
     const Subhypergraph& sub_hg,
     const HypernodeWeight max_weight_block_0,
     const HypernodeWeight max_weight_block_1,
+    const size_t max_num_pins,
     vec<bool>& locked_blocks) const;
 
+  // ! Continues the BFS of a search with a level-synchronous parallel BFS.
+  // ! Vertices of the current level are processed in parallel and added to
+  // ! the region as long as the corresponding block is not full.
+  void growRegionInParallel(BFSData& bfs,
+                            Subhypergraph& sub_hg,
+                            const PartitionedHypergraph& phg,
+                            const HypernodeWeight max_weight_block_0,
+                            const HypernodeWeight max_weight_block_1,
+                            const size_t max_num_pins,
+                            const size_t max_bfs_distance);
+
   const Context& _context;
   double _scaling;
 
   // ! Contains data required for BFS construction algorithm
   tbb::enumerable_thread_specific<BFSData> _local_bfs;
+
+  const HypernodeID _num_nodes;
+  const HyperedgeID _num_edges;
+  SpinLock _parallel_bfs_lock;
+  // ! Contains data required for the parallel BFS (allocated on first use)
+  ParallelBFSData _parallel_bfs;
+  // ! Number of pins of all flow problems that are currently constructed or
+  // ! solved (only maintained if r-flow-max-num-pins-of-concurrent-searches is set)
+  CAtomic<size_t> _num_reserved_pins;
 };
 
 }  // namespace kahypar
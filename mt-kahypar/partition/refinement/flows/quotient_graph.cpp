@@ -27,8 +27,11 @@
 
 #include "mt-kahypar/partition/refinement/flows/quotient_graph.h"
 
+#include <cstdlib>
 #include <queue>
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_reduce.h"
 #include "tbb/parallel_sort.h"
 
 #include "mt-kahypar/datastructures/sparse_map.h"
@@ -54,7 +57,9 @@ void QuotientGraph::QuotientGraphEdge::reset() {
 bool QuotientGraph::ActiveBlockSchedulingRound::popBlockPairFromQueue(BlockPair& blocks) {
   blocks.i = kInvalidPartition;
   blocks.j = kInvalidPartition;
-  if ( _unscheduled_blocks.try_pop(blocks) ) {
+  ScheduledBlockPair scheduled_blocks { blocks, 0.0 };
+  if ( _unscheduled_blocks.try_pop(scheduled_blocks) ) {
+    blocks = scheduled_blocks.blocks;
     _quotient_graph[blocks.i][blocks.j].markAsNotInQueue();
   }
   return blocks.i != kInvalidPartition && blocks.j != kInvalidPartition;
@@ -80,7 +85,7 @@ void QuotientGraph::ActiveBlockSchedulingRound::finalizeSearch(const BlockPair&
 bool QuotientGraph::ActiveBlockSchedulingRound::pushBlockPairIntoQueue(const BlockPair& blocks) {
   QuotientGraphEdge& qg_edge = _quotient_graph[blocks.i][blocks.j];
   if ( qg_edge.markAsInQueue() ) {
-    _unscheduled_blocks.push(blocks);
+    _unscheduled_blocks.push(ScheduledBlockPair { blocks, priority(blocks) });
     ++_remaining_blocks;
     return true;
   } else {
@@ -88,6 +93,27 @@ bool QuotientGraph::ActiveBlockSchedulingRound::pushBlockPairIntoQueue(const Blo
   }
 }
 
+double QuotientGraph::ActiveBlockSchedulingRound::priority(const BlockPair& blocks) {
+  if ( !_context.refinement.flows.prioritize_block_pairs ) {
+    return -static_cast<double>(_num_pushed_blocks++);
+  }
+
+  const QuotientGraphEdge& qg_edge = _quotient_graph[blocks.i][blocks.j];
+  const size_t num_searches = qg_edge.num_searches.load(std::memory_order_relaxed);
+  const size_t region_num_pins = qg_edge.region_num_pins.load(std::memory_order_relaxed);
+  if ( num_searches == 0 || region_num_pins == 0 ) {
+    // Block pair was not searched before
+    return std::numeric_limits<double>::max();
+  }
+
+  const size_t num_improvements = qg_edge.num_improvements_found.load(std::memory_order_relaxed);
+  const double cut_weight = qg_edge.cut_he_weight.load(std::memory_order_relaxed);
+  const double success_rate = ( num_improvements + 1.0 ) / ( num_searches + 2.0 );
+  const double improvement = num_improvements > 0 ? std::min(cut_weight,
+    static_cast<double>(qg_edge.total_improvement.load(std::memory_order_relaxed)) / num_improvements) : cut_weight;
+  return success_rate * improvement / region_num_pins;
+}
+
 void QuotientGraph::ActiveBlockScheduler::initialize(const vec<uint8_t>& active_blocks,
                                                      const bool is_input_hypergraph) {
   reset();
@@ -104,7 +130,8 @@ void QuotientGraph::ActiveBlockScheduler::initialize(const vec<uint8_t>& active_
   vec<BlockPair> active_block_pairs;
   for ( PartitionID i = 0; i < _context.partition.k; ++i ) {
     for ( PartitionID j = i + 1; j < _context.partition.k; ++j ) {
-      if ( isActiveBlockPair(i, j) && ( active_blocks[i] || active_blocks[j] ) ) {
+      if ( isActiveBlockPair(i, j) && ( active_blocks[i] || active_blocks[j] ) &&
+           !_quotient_graph[i][j].is_unproductive ) {
         active_block_pairs.push_back( BlockPair { i, j } );
       }
     }
@@ -287,10 +314,15 @@ void QuotientGraph::addNewCutHyperedge(const HyperedgeID he,
   }
 }
 
-void QuotientGraph::finalizeConstruction(const SearchID search_id) {
+void QuotientGraph::finalizeConstruction(const SearchID search_id,
+                                         const size_t region_num_pins) {
   ASSERT(search_id < _searches.size());
   _searches[search_id].is_finalized = true;
   const BlockPair& blocks = _searches[search_id].blocks;
+  if ( region_num_pins > 0 ) {
+    _quotient_graph[blocks.i][blocks.j].region_num_pins.store(
+      region_num_pins, std::memory_order_relaxed);
+  }
   _quotient_graph[blocks.i][blocks.j].release(search_id);
 }
 
@@ -302,6 +334,7 @@ void QuotientGraph::finalizeSearch(const SearchID search_id,
 
   const BlockPair& blocks = _searches[search_id].blocks;
   QuotientGraphEdge& qg_edge = _quotient_graph[blocks.i][blocks.j];
+  ++qg_edge.num_searches;
   if ( total_improvement > 0 ) {
     // If the search improves the quality of the partition, we reinsert
     // all hyperedges that were used by the search and are still cut.
@@ -315,7 +348,7 @@ void QuotientGraph::finalizeSearch(const SearchID search_id,
   --_num_active_searches;
 }
 
-void QuotientGraph::initialize(const PartitionedHypergraph& phg) {
+void QuotientGraph::initialize(PartitionedHypergraph& phg) {
   _phg = &phg;
 
   // Reset internal members
@@ -324,9 +357,7 @@ void QuotientGraph::initialize(const PartitionedHypergraph& phg) {
   _searches.clear();
 
   // Find all cut hyperedges between the blocks
-  tbb::enumerable_thread_specific<HyperedgeID> local_num_hes(0);
-  phg.doParallelForAllEdges([&](const HyperedgeID he) {
-    ++local_num_hes.local();
+  auto add_cut_hyperedge = [&](const HyperedgeID he) {
     const HyperedgeWeight edge_weight = phg.edgeWeight(he);
     for ( const PartitionID i : phg.connectivitySet(he) ) {
       for ( const PartitionID j : phg.connectivitySet(he) ) {
@@ -335,8 +366,29 @@ void QuotientGraph::initialize(const PartitionedHypergraph& phg) {
         }
       }
     }
-  });
-  _current_num_edges = local_num_hes.combine(std::plus<HyperedgeID>());
+  };
+  if ( phg.isCutNetTracked() ) {
+    // The cut hyperedges are maintained incrementally by the partitioned hypergraph
+    // across moves and uncontractions => visiting them takes time linear in the size of
+    // the cut. Counting the enabled hyperedges only requires a scan over the enable flags.
+    phg.doParallelForAllCutNets(add_cut_hyperedge);
+    _current_num_edges = tbb::parallel_reduce(
+      tbb::blocked_range<HyperedgeID>(ID(0), phg.initialNumEdges()), ID(0),
+      [&](const tbb::blocked_range<HyperedgeID>& range, HyperedgeID num_edges) {
+        for ( HyperedgeID he = range.begin(); he < range.end(); ++he ) {
+          num_edges += phg.edgeIsEnabled(he);
+        }
+        return num_edges;
+      }, std::plus<HyperedgeID>());
+  } else {
+    tbb::enumerable_thread_specific<HyperedgeID> local_num_hes(0);
+    phg.doParallelForAllEdges([&](const HyperedgeID he) {
+      ++local_num_hes.local();
+      add_cut_hyperedge(he);
+    });
+    _current_num_edges = local_num_hes.combine(std::plus<HyperedgeID>());
+  }
+  updateUnproductiveBlockPairs();
 
   // Initalize block scheduler queue
   vec<uint8_t> active_blocks(_context.partition.k, true);
@@ -349,6 +401,12 @@ void QuotientGraph::changeNumberOfBlocks(const PartitionID new_k) {
     for ( size_t j = 0; j < _quotient_graph.size(); ++j ) {
       _quotient_graph[i][j].num_improvements_found.store(0, std::memory_order_relaxed);
       _quotient_graph[i][j].total_improvement.store(0, std::memory_order_relaxed);
+      _quotient_graph[i][j].num_searches.store(0, std::memory_order_relaxed);
+      _quotient_graph[i][j].region_num_pins.store(0, std::memory_order_relaxed);
+      _quotient_graph[i][j].num_searches_at_initialization = 0;
+      _quotient_graph[i][j].num_improvements_at_initialization = 0;
+      _quotient_graph[i][j].cut_he_weight_at_initialization = 0;
+      _quotient_graph[i][j].is_unproductive = false;
     }
   }
 
@@ -370,4 +428,26 @@ void QuotientGraph::resetQuotientGraphEdges() {
   }
 }
 
+void QuotientGraph::updateUnproductiveBlockPairs() {
+  const double max_cut_change = _context.refinement.flows.unproductive_block_pair_cut_change;
+  for ( PartitionID i = 0; i < _context.partition.k; ++i ) {
+    for ( PartitionID j = i + 1; j < _context.partition.k; ++j ) {
+      QuotientGraphEdge& qg_edge = _quotient_graph[i][j];
+      const size_t num_searches = qg_edge.num_searches.load(std::memory_order_relaxed);
+      const size_t num_improvements = qg_edge.num_improvements_found.load(std::memory_order_relaxed);
+      const HyperedgeWeight cut_weight = qg_edge.cut_he_weight.load(std::memory_order_relaxed);
+      const bool failed = num_searches > qg_edge.num_searches_at_initialization &&
+        num_improvements == qg_edge.num_improvements_at_initialization;
+      const HyperedgeWeight cut_change = std::abs(cut_weight - qg_edge.cut_he_weight_at_initialization);
+      // Note that a skipped block pair is not searched again unless one of its blocks becomes
+      // active. In that case, it is not marked as unproductive at the next initialization.
+      qg_edge.is_unproductive = max_cut_change > 0.0 && failed &&
+        cut_change <= max_cut_change * qg_edge.cut_he_weight_at_initialization;
+      qg_edge.num_searches_at_initialization = num_searches;
+      qg_edge.num_improvements_at_initialization = num_improvements;
+      qg_edge.cut_he_weight_at_initialization = cut_weight;
+    }
+  }
+}
+
 } // namespace mt_kahypar
\ No newline at end of file
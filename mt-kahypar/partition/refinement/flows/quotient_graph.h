@@ -26,7 +26,7 @@
 
 #pragma once
 
-#include "tbb/concurrent_queue.h"
+#include "tbb/concurrent_priority_queue.h"
 #include "tbb/concurrent_vector.h"
 #include "tbb/enumerable_thread_specific.h"
 
@@ -57,7 +57,13 @@ class QuotientGraph {
       num_cut_hes(0),
       cut_he_weight(0),
       num_improvements_found(0),
-      total_improvement(0) { }
+      total_improvement(0),
+      num_searches(0),
+      region_num_pins(0),
+      num_searches_at_initialization(0),
+      num_improvements_at_initialization(0),
+      cut_he_weight_at_initialization(0),
+      is_unproductive(false) { }
 
     // ! Adds a cut hyperedge to this quotient graph edge
     void add_hyperedge(const HyperedgeID he,
@@ -120,6 +126,35 @@ class QuotientGraph {
     CAtomic<size_t> num_improvements_found;
     // ! Total improvement found on this block pair
     CAtomic<HyperedgeWeight> total_improvement;
+    // ! Number of searches performed on this block pair
+    CAtomic<size_t> num_searches;
+    // ! Number of pins of the last region grown around the cut of this block pair
+    CAtomic<size_t> region_num_pins;
+    // ! Search history at the last initialization of the quotient graph (usually the
+    // ! previous level of the multilevel hierarchy)
+    size_t num_searches_at_initialization;
+    size_t num_improvements_at_initialization;
+    HyperedgeWeight cut_he_weight_at_initialization;
+    // ! True, if all searches on this block pair failed since the last initialization
+    // ! and its cut weight changed only marginally (see r-flow-unproductive-block-pair-cut-change)
+    bool is_unproductive;
+#ifdef KAHYPAR_PAD_HOT_ATOMICS
+    // ! Block pairs are updated concurrently by different searches. The padding
+    // ! ensures that the atomics of two adjacent block pairs never share a cache line.
+    uint8_t padding[CACHE_LINE_SIZE];
+#endif
+  };
+
+  // ! Block pair contained in the queue of an active block scheduling round
+  struct ScheduledBlockPair {
+    BlockPair blocks;
+    double priority;
+  };
+
+  struct ScheduledBlockPairComparator {
+    bool operator()(const ScheduledBlockPair& lhs, const ScheduledBlockPair& rhs) const {
+      return lhs.priority < rhs.priority;
+    }
   };
 
   /**
@@ -136,7 +171,8 @@ class QuotientGraph {
       _round_improvement(0),
       _active_blocks_lock(),
       _active_blocks(context.partition.k, false),
-      _remaining_blocks(0) { }
+      _remaining_blocks(0),
+      _num_pushed_blocks(0) { }
 
     // ! Pops a block pair from the queue.
     // ! Returns true, if a block pair was successfully popped from the queue.
@@ -168,18 +204,29 @@ class QuotientGraph {
       return _remaining_blocks;
     }
 
+   private:
+    // ! Block pairs are scheduled in FIFO order. If r-flow-prioritize-block-pairs is set,
+    // ! they are ordered by their expected improvement per unit of construction cost.
+    // ! The expected improvement is estimated from the success rate of previous
+    // ! searches, the average improvement found and the cut weight. The cost is the
+    // ! size of the last region grown for the block pair. Block pairs that were never
+    // ! searched before are scheduled first.
+    double priority(const BlockPair& blocks);
+
    const Context& _context;
    // ! Quotient graph
     vec<vec<QuotientGraphEdge>>& _quotient_graph;
     // ! Queue that contains all unscheduled block pairs of the current round
-    tbb::concurrent_queue<BlockPair> _unscheduled_blocks;
+    tbb::concurrent_priority_queue<ScheduledBlockPair, ScheduledBlockPairComparator> _unscheduled_blocks;
     // ! Current improvement made in this round
-    CAtomic<HyperedgeWeight> _round_improvement;
+    PaddedCAtomic<HyperedgeWeight> _round_improvement;
     // Active blocks for next round
     SpinLock _active_blocks_lock;
     vec<uint8_t> _active_blocks;
     // Remaining active block pairs in the current round.
-    CAtomic<size_t> _remaining_blocks;
+    PaddedCAtomic<size_t> _remaining_blocks;
+    // Number of block pairs pushed into the queue (used for FIFO order)
+    PaddedCAtomic<size_t> _num_pushed_blocks;
   };
 
   /**
@@ -361,9 +408,12 @@ public:
   /**
    * Notify the quotient graph that the construction of the corresponding
    * search is completed. The corresponding block pairs associated with the
-   * search are made available again for other searches.
+   * search are made available again for other searches. The number of pins
+   * of the constructed region is used to estimate the cost of future searches
+   * on the same block pair.
    */
-  void finalizeConstruction(const SearchID search_id);
+  void finalizeConstruction(const SearchID search_id,
+                            const size_t region_num_pins = 0);
 
   /**
    * Notify the quotient graph that the corrseponding search terminated.
@@ -375,8 +425,9 @@ public:
                       const HyperedgeWeight total_improvement);
 
   // ! Initializes the quotient graph. This includes to find
-  // ! all cut hyperedges between all block pairs
-  void initialize(const PartitionedHypergraph& phg);
+  // ! all cut hyperedges between all block pairs. If cut net tracking
+  // ! is enabled, only the cut hyperedges are visited.
+  void initialize(PartitionedHypergraph& phg);
 
   void setObjective(const HyperedgeWeight objective) {
     _active_block_scheduler.setObjective(objective);
@@ -398,6 +449,11 @@ public:
 
   void resetQuotientGraphEdges();
 
+  // ! Marks block pairs that were searched without success since the last initialization
+  // ! and whose cut weight has not changed much as unproductive. Unproductive block pairs
+  // ! are not scheduled in the first round of active block scheduling.
+  void updateUnproductiveBlockPairs();
+
   bool isInputHypergraph() const {
     return _current_num_edges == _initial_num_edges;
   }
@@ -416,7 +472,7 @@ public:
   ActiveBlockScheduler _active_block_scheduler;
 
   // ! Number of active searches
-  CAtomic<size_t> _num_active_searches;
+  PaddedCAtomic<size_t> _num_active_searches;
   // ! Information about searches that are currently running
   tbb::concurrent_vector<Search> _searches;
 };
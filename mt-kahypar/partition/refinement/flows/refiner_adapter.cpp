@@ -71,7 +71,15 @@ MoveSequence FlowRefinerAdapter::refine(const SearchID search_id,
 
   // Perform refinement
   const size_t refiner_idx = _active_searches[search_id].refiner_idx;
-  const size_t num_free_threads = _threads.acquireFreeThreads();
+  size_t num_free_threads = _threads.acquireFreeThreads();
+  if ( num_free_threads > 1 &&
+       sub_hg.num_pins < _context.refinement.flows.min_num_pins_for_parallel_flow ) {
+    // Small flow problems do not benefit from the parallel flow algorithm.
+    // We solve them sequentially and leave the other threads to searches on
+    // larger flow problems.
+    _threads.releaseUnusedThreads(num_free_threads - 1);
+    num_free_threads = 1;
+  }
   _refiner[refiner_idx]->setNumThreadsForSearch(num_free_threads);
   MoveSequence moves = _refiner[refiner_idx]->refine(phg, sub_hg, _active_searches[search_id].start);
   _threads.releaseThreads(num_free_threads);
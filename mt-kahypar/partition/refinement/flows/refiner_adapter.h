@@ -71,6 +71,15 @@ class FlowRefinerAdapter {
       return num_free_threads;
     }
 
+    // ! Returns threads to the pool that were acquired by an active refiner,
+    // ! but are not used by it
+    void releaseUnusedThreads(const size_t num_threads) {
+      lock.lock();
+      ASSERT(num_threads <= num_used_threads);
+      num_used_threads -= num_threads;
+      lock.unlock();
+    }
+
     void releaseThreads(const size_t num_threads) {
       lock.lock();
       ASSERT(num_threads <= num_used_threads);
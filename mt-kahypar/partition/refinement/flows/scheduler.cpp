@@ -26,9 +26,13 @@
 
 #include "mt-kahypar/partition/refinement/flows/scheduler.h"
 
+#include <algorithm>
+#include <thread>
+
 #include "mt-kahypar/partition/metrics.h"
 #include "mt-kahypar/io/partitioning_output.h"
 #include "mt-kahypar/utils/utilities.h"
+#include "mt-kahypar/utils/trace_recorder.h"
 
 namespace mt_kahypar {
 
@@ -105,9 +109,13 @@ inline std::ostream & operator<< (std::ostream& str, const FlowRefinementSchedul
 
 bool FlowRefinementScheduler::refineImpl(
                 PartitionedHypergraph& phg,
-                const parallel::scalable_vector<HypernodeID>&,
+                const parallel::scalable_vector<HypernodeID>& refinement_nodes,
                 Metrics& best_metrics,
                 const double)  {
+  if ( !refinement_nodes.empty() ) {
+    return refineLocalized(phg, refinement_nodes, best_metrics);
+  }
+
   phg.resetMoveState();
   ASSERT(_phg == &phg);
   _quotient_graph.setObjective(best_metrics.getMetric(
@@ -119,7 +127,9 @@ bool FlowRefinementScheduler::refineImpl(
     while ( i < std::max(UL(1), static_cast<size_t>(
         std::ceil(_context.refinement.flows.parallel_searches_multiplier *
             _quotient_graph.numActiveBlockPairs()))) ) {
-      SearchID search_id = _quotient_graph.requestNewSearch(_refiner);
+      // No new searches are started, once the partitioning run is cancelled
+      SearchID search_id = _context.isCancelled() ? QuotientGraph::INVALID_SEARCH_ID :
+        _quotient_graph.requestNewSearch(_refiner);
       if ( search_id != QuotientGraph::INVALID_SEARCH_ID ) {
         DBG << "Start search" << search_id
             << "( Blocks =" << blocksOfSearch(search_id)
@@ -127,7 +137,7 @@ bool FlowRefinementScheduler::refineImpl(
         timer.start_timer("region_growing", "Grow Region", true);
         const Subhypergraph sub_hg =
           _constructor.construct(search_id, _quotient_graph, phg);
-        _quotient_graph.finalizeConstruction(search_id);
+        _quotient_graph.finalizeConstruction(search_id, sub_hg.num_pins);
         timer.stop_timer("region_growing");
 
         HyperedgeWeight delta = 0;
@@ -148,6 +158,7 @@ bool FlowRefinementScheduler::refineImpl(
                 << _refiner.timeLimit() << "s )" << END;
           }
         }
+        _constructor.releasePins(sub_hg);
         _quotient_graph.finalizeSearch(search_id, improved_solution ? delta : 0);
         _refiner.finalizeSearch(search_id);
         DBG << "End search" << search_id
@@ -224,6 +235,138 @@ void FlowRefinementScheduler::initializeImpl(PartitionedHypergraph& phg)  {
   _refiner.initialize(max_parallism);
 }
 
+bool FlowRefinementScheduler::refineLocalized(PartitionedHypergraph& phg,
+                                              const vec<HypernodeID>& refinement_nodes,
+                                              Metrics& best_metrics) {
+  phg.resetMoveState();
+  _phg = &phg;
+  _is_localized_refinement = true;
+  resizeDataStructuresForCurrentK();
+  for ( PartitionID i = 0; i < _context.partition.k; ++i ) {
+    _part_weights[i] = phg.partWeight(i);
+    _max_part_weights[i] = std::max(
+      phg.partWeight(i), _context.partition.max_part_weights[i]);
+  }
+
+  collectLocalizedSearches(phg, refinement_nodes);
+  std::atomic<HyperedgeWeight> overall_delta(0);
+  if ( !_localized_searches.empty() ) {
+    _refiner.initialize(std::max(UL(1), std::min(_localized_searches.size(),
+      _context.refinement.flows.num_parallel_searches)));
+    utils::Timer& timer = utils::Utilities::instance().getTimer(_context.utility_id);
+    CAtomic<size_t> next_search(0);
+    tbb::parallel_for(UL(0), _refiner.numAvailableRefiner(), [&](const size_t) {
+      // Each refiner processes at most one search at a time => registration always succeeds
+      for ( size_t idx = next_search.fetch_add(1);
+            idx < _localized_searches.size() && !_context.isCancelled();
+            idx = next_search.fetch_add(1) ) {
+        const SearchID search_id = idx;
+        const LocalizedSearch& search = _localized_searches[idx];
+        MT_KAHYPAR_TRACE_SCOPE("flows", "localized_flow_search");
+        const bool success = _refiner.registerNewSearch(search_id, phg);
+        ASSERT(success); unused(success);
+
+        timer.start_timer("region_growing", "Grow Region", true);
+        const Subhypergraph sub_hg = _constructor.constructAroundSeeds(
+          search.blocks, search.seeds, phg);
+        timer.stop_timer("region_growing");
+
+        if ( sub_hg.numNodes() > 0 ) {
+          ++_stats.num_refinements;
+          MoveSequence sequence = _refiner.refine(search_id, phg, sub_hg);
+          if ( !sequence.moves.empty() ) {
+            timer.start_timer("apply_moves", "Apply Moves", true);
+            overall_delta -= applyMoves(search_id, sequence);
+            vec<HypernodeID>& moved_nodes = _localized_moved_nodes.local();
+            for ( const Move& move : sequence.moves ) {
+              moved_nodes.push_back(move.node);
+            }
+            timer.stop_timer("apply_moves");
+          } else if ( sequence.state == MoveSequenceState::TIME_LIMIT ) {
+            ++_stats.num_time_limits;
+          }
+        }
+        _constructor.releasePins(sub_hg);
+        _refiner.finalizeSearch(search_id);
+      }
+      _refiner.terminateRefiner();
+    });
+  }
+
+  // Update metrics statistics
+  HyperedgeWeight current_metric = best_metrics.getMetric(
+    Mode::direct, _context.partition.objective);
+  HEAVY_REFINEMENT_ASSERT(current_metric + overall_delta ==
+                          metrics::objective(phg, _context.partition.objective),
+                          V(current_metric) << V(overall_delta) <<
+                          V(metrics::objective(phg, _context.partition.objective)));
+  best_metrics.updateMetric(current_metric + overall_delta,
+    Mode::direct, _context.partition.objective);
+  best_metrics.imbalance = metrics::imbalance(phg, _context);
+  _stats.update_global_stats();
+
+  // Update Gain Cache (only for the moved nodes)
+  for ( vec<HypernodeID>& moved_nodes : _localized_moved_nodes ) {
+    for ( const HypernodeID& hn : moved_nodes ) {
+      if ( _was_moved[hn] ) {
+        if ( _context.forceGainCacheUpdates() && phg.isGainCacheInitialized() ) {
+          phg.recomputeMoveFromPenalty(hn);
+        }
+        _was_moved[hn] = uint8_t(false);
+      }
+    }
+    moved_nodes.clear();
+  }
+
+  HEAVY_REFINEMENT_ASSERT(phg.checkTrackedPartitionInformation());
+  _is_localized_refinement = false;
+  _phg = nullptr;
+  return overall_delta.load(std::memory_order_relaxed) < 0;
+}
+
+void FlowRefinementScheduler::collectLocalizedSearches(const PartitionedHypergraph& phg,
+                                                       const vec<HypernodeID>& refinement_nodes) {
+  struct Seed {
+    PartitionID i;
+    PartitionID j;
+    HypernodeID hn;
+  };
+
+  vec<Seed> seeds;
+  for ( const HypernodeID& hn : refinement_nodes ) {
+    const PartitionID from = phg.partID(hn);
+    for ( const HyperedgeID& he : phg.incidentEdges(hn) ) {
+      if ( phg.connectivity(he) > 1 ) {
+        for ( const PartitionID& to : phg.connectivitySet(he) ) {
+          if ( to != from ) {
+            seeds.push_back(Seed { std::min(from, to), std::max(from, to), hn });
+          }
+        }
+      }
+    }
+  }
+  std::sort(seeds.begin(), seeds.end(), [&](const Seed& lhs, const Seed& rhs) {
+    return lhs.i < rhs.i || (lhs.i == rhs.i && (lhs.j < rhs.j ||
+      (lhs.j == rhs.j && lhs.hn < rhs.hn)));
+  });
+
+  _localized_searches.clear();
+  for ( size_t idx = 0; idx < seeds.size(); ++idx ) {
+    const Seed& seed = seeds[idx];
+    if ( _localized_searches.empty() ||
+         _localized_searches.back().blocks.i != seed.i ||
+         _localized_searches.back().blocks.j != seed.j ) {
+      _localized_searches.push_back(LocalizedSearch { BlockPair { seed.i, seed.j }, { } });
+    }
+    vec<HypernodeID>& search_seeds = _localized_searches.back().seeds;
+    if ( search_seeds.empty() || search_seeds.back() != seed.hn ) {
+      search_seeds.push_back(seed.hn);
+    }
+  }
+  DBG << "Localized Flow Refinement: Seeds =" << refinement_nodes.size()
+      << ", Block Pairs =" << _localized_searches.size();
+}
+
 void FlowRefinementScheduler::resizeDataStructuresForCurrentK() {
   if ( _current_k != _context.partition.k ) {
     _current_k = _context.partition.k;
@@ -233,6 +376,7 @@ void FlowRefinementScheduler::resizeDataStructuresForCurrentK() {
     if ( static_cast<size_t>(_current_k) > _part_weights.size() ) {
       _part_weights.resize(_current_k);
       _max_part_weights.resize(_current_k);
+      _block_locks.resize(_current_k);
     }
     _quotient_graph.changeNumberOfBlocks(_current_k);
     _constructor.changeNumberOfBlocks(_current_k);
@@ -241,11 +385,6 @@ void FlowRefinementScheduler::resizeDataStructuresForCurrentK() {
 
 namespace {
 
-struct NewCutHyperedge {
-  HyperedgeID he;
-  PartitionID block;
-};
-
 template<typename F>
 bool changeNodePart(PartitionedHypergraph& phg,
                     const HypernodeID hn,
@@ -265,13 +404,13 @@ bool changeNodePart(PartitionedHypergraph& phg,
   return success;
 }
 
-template<typename F>
+template<typename F, typename NewCutHyperedges>
 void applyMoveSequence(PartitionedHypergraph& phg,
                        const MoveSequence& sequence,
                        const F& objective_delta,
                        const bool gain_cache_update,
                        vec<uint8_t>& was_moved,
-                       vec<NewCutHyperedge>& new_cut_hes) {
+                       NewCutHyperedges& new_cut_hes) {
   for ( const Move& move : sequence.moves ) {
     ASSERT(move.from == phg.partID(move.node));
     if ( move.from != move.to ) {
@@ -301,9 +440,10 @@ void revertMoveSequence(PartitionedHypergraph& phg,
   }
 }
 
+template<typename NewCutHyperedges>
 void addCutHyperedgesToQuotientGraph(QuotientGraph& quotient_graph,
-                                     const vec<NewCutHyperedge>& new_cut_hes) {
-  for ( const NewCutHyperedge& new_cut_he : new_cut_hes ) {
+                                     const NewCutHyperedges& new_cut_hes) {
+  for ( const auto& new_cut_he : new_cut_hes ) {
     ASSERT(new_cut_he.block != kInvalidPartition);
     quotient_graph.addNewCutHyperedge(new_cut_he.he, new_cut_he.block);
   }
@@ -313,12 +453,93 @@ void addCutHyperedgesToQuotientGraph(QuotientGraph& quotient_graph,
 
 HyperedgeWeight FlowRefinementScheduler::applyMoves(const SearchID search_id,
                                                         MoveSequence& sequence) {
-  unused(search_id);
   ASSERT(_phg);
+  ApplyMovesRequest request(search_id, sequence);
+  if ( _context.refinement.flows.parallel_apply_moves ) {
+    // Move sequences on disjoint blocks do not interfere: the objective delta of a
+    // move only depends on the pin counts of its source and target block. Thus,
+    // we only serialize move sequences that touch a common block.
+    const vec<PartitionID> locked_blocks = lockBlocksOfMoveSequence(sequence);
+    applyMoveSequenceOfRequest(request);
+    for ( const PartitionID block : locked_blocks ) {
+      _block_locks[block].unlock();
+    }
+  } else {
+    applyMovesInBatches(request);
+  }
 
-  // TODO: currently we lock the applyMoves method
-  // => find something smarter here
-  _apply_moves_lock.lock();
+  const HyperedgeWeight improvement = request.improvement;
+  if ( sequence.state == MoveSequenceState::SUCCESS && improvement > 0 ) {
+    if ( !_is_localized_refinement ) {
+      addCutHyperedgesToQuotientGraph(_quotient_graph, request.new_cut_hes);
+    }
+    _stats.total_improvement += improvement;
+  }
+
+  return improvement;
+}
+
+void FlowRefinementScheduler::applyMovesInBatches(ApplyMovesRequest& request) {
+  _apply_moves_requests.push(&request);
+
+  // The thread holding the apply lock processes all enqueued requests. Requests
+  // are only enqueued before trying to acquire the lock and the lock holder
+  // drains the queue before releasing it. Thus, either we acquire the lock and
+  // process our own request, or the current lock holder processes it.
+  while ( !request.done.load(std::memory_order_acquire) ) {
+    if ( _apply_moves_lock.tryLock() ) {
+      ApplyMovesRequest* next = nullptr;
+      while ( _apply_moves_requests.try_pop(next) ) {
+        applyMoveSequenceOfRequest(*next);
+        // Note that the request is owned by the waiting thread and must
+        // not be accessed after it is marked as done
+        next->done.store(true, std::memory_order_release);
+      }
+      _apply_moves_lock.unlock();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+vec<PartitionID> FlowRefinementScheduler::lockBlocksOfMoveSequence(const MoveSequence& sequence) {
+  ASSERT(_phg);
+  vec<PartitionID> blocks;
+  while ( true ) {
+    blocks.clear();
+    for ( const Move& move : sequence.moves ) {
+      blocks.push_back(_phg->partID(move.node));
+      blocks.push_back(move.to);
+    }
+    std::sort(blocks.begin(), blocks.end());
+    blocks.erase(std::unique(blocks.begin(), blocks.end()), blocks.end());
+    for ( const PartitionID block : blocks ) {
+      _block_locks[block].lock();
+    }
+
+    // A vertex can only change its block while the lock of its block is held.
+    // Thus, if all vertices are still in a locked block, they can not be moved
+    // by another thread until we release the locks.
+    bool is_stable = true;
+    for ( const Move& move : sequence.moves ) {
+      if ( !std::binary_search(blocks.begin(), blocks.end(), _phg->partID(move.node)) ) {
+        is_stable = false;
+        break;
+      }
+    }
+    if ( is_stable ) {
+      return blocks;
+    }
+    for ( const PartitionID block : blocks ) {
+      _block_locks[block].unlock();
+    }
+  }
+}
+
+void FlowRefinementScheduler::applyMoveSequenceOfRequest(ApplyMovesRequest& request) {
+  const SearchID search_id = request.search_id;
+  MoveSequence& sequence = request.sequence;
+  unused(search_id);
 
   // Compute Part Weight Deltas
   vec<HypernodeWeight> part_weight_deltas(_context.partition.k, 0);
@@ -331,8 +552,8 @@ HyperedgeWeight FlowRefinementScheduler::applyMoves(const SearchID search_id,
     }
   }
 
-  HyperedgeWeight improvement = 0;
-  vec<NewCutHyperedge> new_cut_hes;
+  HyperedgeWeight& improvement = request.improvement;
+  vec<NewCutHyperedge>& new_cut_hes = request.new_cut_hes;
   auto delta_func = [&](const HyperedgeID he,
                         const HyperedgeWeight edge_weight,
                         const HypernodeID edge_size,
@@ -400,15 +621,6 @@ HyperedgeWeight FlowRefinementScheduler::applyMoves(const SearchID search_id,
         << ", Expected Improvement =" << sequence.expected_improvement
         << ", Search ID =" << search_id << ")" << END;
   }
-
-  _apply_moves_lock.unlock();
-
-  if ( sequence.state == MoveSequenceState::SUCCESS && improvement > 0 ) {
-    addCutHyperedgesToQuotientGraph(_quotient_graph, new_cut_hes);
-    _stats.total_improvement += improvement;
-  }
-
-  return improvement;
 }
 
 FlowRefinementScheduler::PartWeightUpdateResult FlowRefinementScheduler::partWeightUpdate(
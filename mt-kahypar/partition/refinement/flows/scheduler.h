@@ -26,6 +26,11 @@
 
 #pragma once
 
+#include <atomic>
+
+#include "tbb/concurrent_queue.h"
+#include "tbb/enumerable_thread_specific.h"
+
 #include "mt-kahypar/definitions.h"
 #include "mt-kahypar/partition/context.h"
 #include "mt-kahypar/partition/refinement/i_refiner.h"
@@ -81,6 +86,37 @@ class FlowRefinementScheduler final : public IRefiner {
     CAtomic<HyperedgeWeight> total_improvement;
   };
 
+  // ! Flow problem of a localized refinement grown around the seed
+  // ! vertices incident to cut hyperedges between the two blocks
+  struct LocalizedSearch {
+    BlockPair blocks;
+    vec<HypernodeID> seeds;
+  };
+
+  // ! Hyperedge with a new block in its connectivity set after applying a move sequence
+  struct NewCutHyperedge {
+    HyperedgeID he;
+    PartitionID block;
+  };
+
+  // ! Move sequence of a search that waits to be applied to the partition.
+  // ! Requests are enqueued by the searches and processed in batches by the
+  // ! thread that currently holds the apply lock (see applyMoves(...)).
+  struct ApplyMovesRequest {
+    ApplyMovesRequest(const SearchID id, MoveSequence& seq) :
+      search_id(id),
+      sequence(seq),
+      improvement(0),
+      new_cut_hes(),
+      done(false) { }
+
+    const SearchID search_id;
+    MoveSequence& sequence;
+    HyperedgeWeight improvement;
+    vec<NewCutHyperedge> new_cut_hes;
+    std::atomic<bool> done;
+  };
+
   struct PartWeightUpdateResult {
     bool is_balanced = true;
     PartitionID overloaded_block = kInvalidPartition;
@@ -103,7 +139,12 @@ public:
     _part_weights(context.partition.k, 0),
     _max_part_weights(context.partition.k, 0),
     _stats(utils::Utilities::instance().getStats(context.utility_id)),
-    _apply_moves_lock() { }
+    _apply_moves_lock(),
+    _apply_moves_requests(),
+    _block_locks(context.partition.k),
+    _is_localized_refinement(false),
+    _localized_searches(),
+    _localized_moved_nodes() { }
 
   FlowRefinementScheduler(const FlowRefinementScheduler&) = delete;
   FlowRefinementScheduler(FlowRefinementScheduler&&) = delete;
@@ -116,6 +157,15 @@ public:
    * The method ensures that the move sequence does not violate
    * the balance constaint and not worsen solution quality.
    * Returns, improvement in solution quality.
+   *
+   * Concurrent calls are combined: each call enqueues its move sequence
+   * and the thread that acquires the apply lock applies all enqueued
+   * sequences one after another. Thus, the part weights and the partition
+   * stay in the cache of one thread while the lock is contended and the
+   * lock is not handed over once per move sequence.
+   *
+   * If r-flow-parallel-apply-moves is set, move sequences are instead applied
+   * concurrently if they touch disjoint sets of blocks (see lockBlocksOfMoveSequence(...)).
    */
   HyperedgeWeight applyMoves(const SearchID search_id,
                              MoveSequence& sequence);
@@ -142,8 +192,35 @@ private:
 
   void initializeImpl(PartitionedHypergraph& phg) final;
 
+  // ! Runs flow-based refinement on small flow problems grown around the
+  // ! refinement nodes (e.g., the border vertices of an uncontracted batch
+  // ! in n-level uncoarsening). In contrast to the active block scheduling,
+  // ! this does not require an initialized quotient graph such that the
+  // ! running time is proportional to the size of the flow problems.
+  bool refineLocalized(PartitionedHypergraph& phg,
+                       const vec<HypernodeID>& refinement_nodes,
+                       Metrics& best_metrics);
+
+  // ! Groups the refinement nodes by the block pairs of their incident
+  // ! cut hyperedges (one localized search per block pair)
+  void collectLocalizedSearches(const PartitionedHypergraph& phg,
+                                const vec<HypernodeID>& refinement_nodes);
+
   void resizeDataStructuresForCurrentK();
 
+  // ! Enqueues the request and waits until the thread holding the apply lock
+  // ! (possibly the calling thread) applied its move sequence
+  void applyMovesInBatches(ApplyMovesRequest& request);
+
+  // ! Acquires the locks of all blocks that contain a vertex of the move sequence
+  // ! or are the target of a move (in increasing order to avoid deadlocks).
+  // ! Returns the locked blocks.
+  vec<PartitionID> lockBlocksOfMoveSequence(const MoveSequence& sequence);
+
+  // ! Applies the move sequence of the request (apply lock or the
+  // ! locks of all blocks touched by the move sequence must be held)
+  void applyMoveSequenceOfRequest(ApplyMovesRequest& request);
+
   PartWeightUpdateResult partWeightUpdate(const vec<HypernodeWeight>& part_weight_deltas,
                                           const bool rollback);
 
@@ -179,6 +256,16 @@ private:
   RefinementStats _stats;
 
   SpinLock _apply_moves_lock;
+  tbb::concurrent_queue<ApplyMovesRequest*> _apply_moves_requests;
+  // ! A vertex is only moved by a thread that holds the lock of its block
+  // ! and of its target block (only used if r-flow-parallel-apply-moves is set)
+  vec<SpinLock> _block_locks;
+
+  // ! True, if moves are applied by a localized refinement (the quotient
+  // ! graph is not initialized in this case)
+  bool _is_localized_refinement;
+  vec<LocalizedSearch> _localized_searches;
+  tbb::enumerable_thread_specific<vec<HypernodeID>> _localized_moved_nodes;
 };
 
 }  // namespace kahypar
@@ -30,65 +30,85 @@
 #include <mt-kahypar/datastructures/priority_queue.h>
 #include <mt-kahypar/partition/context.h>
 #include <mt-kahypar/parallel/work_stack.h>
+#include <mt-kahypar/parallel/multi_queue.h>
 
 #include "external_tools/kahypar/kahypar/datastructure/fast_reset_flag_array.h"
 
+#include <tbb/concurrent_vector.h>
 #include <tbb/parallel_for.h>
 
 namespace mt_kahypar {
 
 
+// ! Stores the sequence of moves performed in the current round. Internally, moves
+// ! are tagged with 64-bit IDs that increase monotonically over all rounds. Thus, a
+// ! move ID stored for a node can never be confused with an ID of a later round and
+// ! the IDs never have to be reset. The IDs handed out to the callers (MoveID) are
+// ! relative to the first move of the current round and start at 1.
 struct GlobalMoveTracker {
+  using GlobalMoveID = uint64_t;
+
   vec<Move> moveOrder;
-  vec<MoveID> moveOfNode;
-  CAtomic<MoveID> runningMoveID;
-  MoveID firstMoveID = 1;
+  vec<GlobalMoveID> moveOfNode;
+  // ! Padded, since it is incremented concurrently for each move
+  PaddedCAtomic<GlobalMoveID> runningMoveID;
+  GlobalMoveID firstMoveID = 1;
 
   explicit GlobalMoveTracker(size_t numNodes = 0) :
           moveOrder(numNodes),
           moveOfNode(numNodes, 0),
           runningMoveID(1) { }
 
-  // Returns true if stored move IDs should be reset
-  bool reset() {
-    if (runningMoveID.load() >= std::numeric_limits<MoveID>::max() - moveOrder.size() - 20) {
-      tbb::parallel_for(UL(0), moveOfNode.size(), [&](size_t i) { moveOfNode[i] = 0; }, tbb::static_partitioner());
-      firstMoveID = 1;
-      runningMoveID.store(1);
-      return true;
-    } else {
-      firstMoveID = ++runningMoveID;
-      return false;
-    }
+  // Starts a new round. Moves of previous rounds become stale.
+  void reset() {
+    firstMoveID = ++runningMoveID;
   }
 
   MoveID insertMove(Move &m) {
-    const MoveID move_id = runningMoveID.fetch_add(1, std::memory_order_relaxed);
-    assert(move_id - firstMoveID < moveOrder.size());
-    moveOrder[move_id - firstMoveID] = m;
-    moveOrder[move_id - firstMoveID].gain = 0;      // set to zero so the recalculation can safely distribute
-    moveOfNode[m.node] = move_id;
-    return move_id;
+    const GlobalMoveID global_move_id = runningMoveID.fetch_add(1, std::memory_order_relaxed);
+    const size_t index = global_move_id - firstMoveID;
+    assert(index < moveOrder.size());
+    moveOrder[index] = m;
+    moveOrder[index].gain = 0;      // set to zero so the recalculation can safely distribute
+    moveOfNode[m.node] = global_move_id;
+    return static_cast<MoveID>(index + 1);
+  }
+
+  // ! Stores move m at position index of the current round. In contrast to insertMove(...),
+  // ! the move order does not depend on the thread schedule. The moves become visible
+  // ! after commitMoves(...) is called with the total number of stored moves.
+  void insertMoveAt(const Move& m, const size_t index) {
+    assert(index < moveOrder.size());
+    moveOrder[index] = m;
+    moveOrder[index].gain = 0;      // set to zero so the recalculation can safely distribute
+    moveOfNode[m.node] = firstMoveID + index;
+  }
+
+  void commitMoves(const MoveID num_moves) {
+    assert(numPerformedMoves() == 0);
+    runningMoveID.store(firstMoveID + num_moves, std::memory_order_relaxed);
   }
 
   Move& getMove(MoveID move_id) {
-    assert(move_id - firstMoveID < moveOrder.size());
-    return moveOrder[move_id - firstMoveID];
+    assert(move_id > 0 && move_id - 1 < moveOrder.size());
+    return moveOrder[move_id - 1];
+  }
+
+  // ! Returns the ID of the last move of node u (only valid if wasNodeMovedInThisRound(u))
+  MoveID moveIDOfNode(HypernodeID u) const {
+    assert(moveOfNode[u] >= firstMoveID);
+    return static_cast<MoveID>(moveOfNode[u] - firstMoveID + 1);
   }
 
   bool wasNodeMovedInThisRound(HypernodeID u) const {
-    const MoveID m_id = moveOfNode[u];
+    const GlobalMoveID m_id = moveOfNode[u];
     return m_id >= firstMoveID
            && m_id < runningMoveID.load(std::memory_order_relaxed)  // active move ID
            && moveOrder[m_id - firstMoveID].isValid();      // not reverted already
   }
 
   MoveID numPerformedMoves() const {
-    return runningMoveID.load(std::memory_order_relaxed) - firstMoveID;
-  }
-
-  bool isMoveStale(const MoveID move_id) const {
-    return move_id < firstMoveID;
+    return static_cast<MoveID>(runningMoveID.load(std::memory_order_relaxed) - firstMoveID);
   }
 };
 
@@ -97,7 +117,7 @@ struct NodeTracker {
 
   SearchID releasedMarker = 1;
   SearchID deactivatedNodeMarker = 2;
-  CAtomic<SearchID> highestActiveSearchID { 2 };
+  PaddedCAtomic<SearchID> highestActiveSearchID { 2 };
 
   explicit NodeTracker(size_t numNodes = 0) : searchOfNode(numNodes, CAtomic<SearchID>(0)) { }
 
@@ -150,9 +170,18 @@ struct FMSharedData {
   // ! Nodes to initialize the localized FM searches with
   WorkContainer<HypernodeID> refinementNodes;
 
+  // ! Nodes to initialize the localized FM searches with ordered by their gain
+  // ! (replaces refinementNodes if useSeedQueue is true)
+  MultiQueue<HypernodeID, Gain> seedQueue;
+  bool useSeedQueue = false;
+
   // ! PQ handles shared by all threads (each vertex is only held by one thread)
   vec<PosT> vertexPQHandles;
 
+  // ! Upper bound for the absolute gain values in the vertex PQs. If it is greater
+  // ! than zero, the vertex PQs are bucket queues, and binary heaps otherwise.
+  Gain vertexPQMaxKey = 0;
+
   // ! Stores the sequence of performed moves and assigns IDs to moves that can be used in the global rollback code
   GlobalMoveTracker moveTracker;
 
@@ -162,8 +191,11 @@ struct FMSharedData {
   // ! Stores the designated target part of a vertex, i.e. the part with the highest gain to which moving is feasible
   vec<PartitionID> targetPart;
 
+  // ! High-degree vertices whose moves are deferred to a dedicated phase after the rollback
+  tbb::concurrent_vector<HypernodeID> deferredHighDegreeNodes;
+
   // ! Stop parallel refinement if finishedTasks > finishedTasksLimit to avoid long-running single searches
-  CAtomic<size_t> finishedTasks;
+  PaddedCAtomic<size_t> finishedTasks;
   size_t finishedTasksLimit = std::numeric_limits<size_t>::max();
 
   // ! Switch to applying moves directly if the use of local delta partitions exceeded a memory limit
@@ -173,9 +205,13 @@ struct FMSharedData {
   bool release_nodes = true;
   bool perform_moves_global = true;
 
+  // ! Sensitivity of the adaptive stop rule of the localized searches
+  double stopRuleAlpha = 1.0;
+
   FMSharedData(size_t numNodes = 0, size_t numThreads = 0, size_t numPQHandles = 0) :
     numberOfNodes(numNodes),
     refinementNodes(), //numNodes, numThreads),
+    seedQueue(),
     vertexPQHandles(), //numPQHandles, invalid_position),
     moveTracker(), //numNodes),
     nodeTracker(), //numNodes),
@@ -194,7 +230,11 @@ struct FMSharedData {
     }, [&] {
       vertexPQHandles.resize(numPQHandles, invalid_position);
     }, [&] {
-      refinementNodes.tls_queues.resize(numThreads);
+      refinementNodes.resize(numThreads);
+      refinementNodes.setLocalityGroups(
+        TBBInitializer::instance().numa_node_of_threads(numThreads));
+    }, [&] {
+      seedQueue.initialize(numThreads);
     }, [&] {
       targetPart.resize(numNodes, kInvalidPartition);
     });
@@ -208,6 +248,14 @@ struct FMSharedData {
         context.partition.k, numNodes))  { }
 
 
+  size_t numRefinementNodes() const {
+    return useSeedQueue ? seedQueue.unsafe_size() : refinementNodes.unsafe_size();
+  }
+
+  bool tryPopSeedNode(HypernodeID& dest, const size_t thread_id) {
+    return useSeedQueue ? seedQueue.try_pop(dest, thread_id) : refinementNodes.try_pop(dest, thread_id);
+  }
+
   size_t getNumberOfPQHandles(const FMAlgorithm algorithm,
                               const PartitionID k,
                               const size_t numNodes) {
@@ -237,10 +285,11 @@ struct FMSharedData {
     pq_handles_node->updateSize(vertexPQHandles.capacity() * sizeof(PosT));
     utils::MemoryTreeNode* move_tracker_node = shared_fm_data_node->addChild("Move Tracker");
     move_tracker_node->updateSize(moveTracker.moveOrder.capacity() * sizeof(Move) +
-                                  moveTracker.moveOfNode.capacity() * sizeof(MoveID));
+                                  moveTracker.moveOfNode.capacity() * sizeof(GlobalMoveTracker::GlobalMoveID));
     utils::MemoryTreeNode* node_tracker_node = shared_fm_data_node->addChild("Node Tracker");
     node_tracker_node->updateSize(nodeTracker.searchOfNode.capacity() * sizeof(SearchID));
     refinementNodes.memoryConsumption(shared_fm_data_node);
+    seedQueue.memoryConsumption(shared_fm_data_node);
   }
 };
 
@@ -26,7 +26,10 @@
 
 #include "mt-kahypar/partition/refinement/fm/global_rollback.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_for.h"
 #include "tbb/parallel_scan.h"
+#include "mt-kahypar/parallel/scratch_arena.h"
 #include "mt-kahypar/partition/metrics.h"
 #include "mt-kahypar/utils/timer.h"
 
@@ -214,13 +217,19 @@ namespace mt_kahypar {
     GlobalMoveTracker& tracker = sharedData.moveTracker;
 
     auto recalculate_and_distribute_for_hyperedge = [&](const HyperedgeID e) {
+      if ( !PartitionedHypergraph::is_graph && phg.edgeSize(e) > HUGE_NET_THRESHOLD ) {
+        // huge nets are processed afterwards with a nested parallel reduction
+        ets_huge_nets.local().push_back(e);
+        return;
+      }
+
       // TODO reduce .local() calls using the blocked_range interface
       auto& r = ets_recalc_data.local();
 
       // compute auxiliary data
       for (HypernodeID v : phg.pins(e)) {
         if (tracker.wasNodeMovedInThisRound(v)) {
-          const MoveID m_id = tracker.moveOfNode[v];
+          const MoveID m_id = tracker.moveIDOfNode(v);
           const Move& m = tracker.getMove(m_id);
           r[m.to].first_in = std::min(r[m.to].first_in, m_id);
           r[m.from].last_out = std::max(r[m.from].last_out, m_id);
@@ -234,11 +243,11 @@ namespace mt_kahypar {
       const HyperedgeWeight we = phg.edgeWeight(e);
       for (HypernodeID v : phg.pins(e)) {
         if (tracker.wasNodeMovedInThisRound(v)) {
-          const MoveID m_id = tracker.moveOfNode[v];
+          const MoveID m_id = tracker.moveIDOfNode(v);
           Move& m = tracker.getMove(m_id);
 
-          const bool benefit = r[m.from].last_out == m_id && r[m.from].first_in > m_id && r[m.from].remaining_pins == 0;
-          const bool penalty = r[m.to].first_in == m_id && r[m.to].last_out < m_id && r[m.to].remaining_pins == 0;
+          const bool benefit = r.data[m.from].last_out == m_id && r.data[m.from].first_in > m_id && r.data[m.from].remaining_pins == 0;
+          const bool penalty = r.data[m.to].first_in == m_id && r.data[m.to].last_out < m_id && r.data[m.to].remaining_pins == 0;
 
           if (benefit && !penalty) {    // only apply update if they're mutually exclusive
             // increase gain of v by w(e)
@@ -252,22 +261,8 @@ namespace mt_kahypar {
         }
       }
 
-      if (context.partition.k <= static_cast<int>(2 * phg.edgeSize(e))) {
-        // this branch is an optimization. in case it is cheaper to iterate over the parts, do that
-        for (PartitionID i = 0; i < context.partition.k; ++i) {
-          r[i] = RecalculationData();
-        }
-      } else {
-        for (HypernodeID v : phg.pins(e)) {
-          if (tracker.wasNodeMovedInThisRound(v)) {
-            const Move& m = tracker.getMove(tracker.moveOfNode[v]);
-            r[m.from] = RecalculationData();
-            r[m.to] = RecalculationData();
-          } else {
-            r[phg.partID(v)].remaining_pins = 0;
-          }
-        }
-      }
+      // only reset the entries of the blocks touched by this net
+      r.reset();
     };
 
     if (context.refinement.fm.iter_moves_on_recalc) {
@@ -292,6 +287,80 @@ namespace mt_kahypar {
     } else{
       tbb::parallel_for(0U, phg.initialNumEdges(), recalculate_and_distribute_for_hyperedge);
     }
+
+    // Huge nets are processed one after another, but each of them in parallel.
+    // Note that this happens outside of the parallel loop above, such that the
+    // thread-local recalculation buffers are not in use.
+    for ( vec<HyperedgeID>& huge_nets : ets_huge_nets ) {
+      for ( const HyperedgeID e : huge_nets ) {
+        recalculateGainsOfHugeNet(phg, tracker, e);
+      }
+      huge_nets.clear();
+    }
+  }
+
+  template<typename PHG>
+  void GlobalRollback::recalculateGainsOfHugeNet(PHG& phg, GlobalMoveTracker& tracker, const HyperedgeID e) {
+    if constexpr ( !PHG::is_graph ) {
+      const auto first_pin = phg.pins(e).begin();
+      const HypernodeID edge_size = phg.edgeSize(e);
+
+      // compute auxiliary data in the thread-local buffers
+      tbb::parallel_for(tbb::blocked_range<HypernodeID>(0, edge_size),
+        [&](const tbb::blocked_range<HypernodeID>& range) {
+        RecalculationBuffer& r = ets_recalc_data.local();
+        for ( HypernodeID i = range.begin(); i < range.end(); ++i ) {
+          const HypernodeID v = *(first_pin + i);
+          if (tracker.wasNodeMovedInThisRound(v)) {
+            const MoveID m_id = tracker.moveIDOfNode(v);
+            const Move& m = tracker.getMove(m_id);
+            r[m.to].first_in = std::min(r[m.to].first_in, m_id);
+            r[m.from].last_out = std::max(r[m.from].last_out, m_id);
+          } else {
+            r[phg.partID(v)].remaining_pins++;
+          }
+        }
+      });
+
+      // combine the thread-local buffers
+      parallel::ScratchArena::Scope scratch_scope;
+      RecalculationData* combined = parallel::ScratchArena::local().allocate<RecalculationData>(
+        context.partition.k, RecalculationData());
+      for ( RecalculationBuffer& r : ets_recalc_data ) {
+        for ( const PartitionID block : r.touched_blocks ) {
+          combined[block].merge(r.data[block]);
+        }
+        r.reset();
+      }
+
+      // distribute gains to pins
+      const HyperedgeWeight we = phg.edgeWeight(e);
+      tbb::parallel_for(tbb::blocked_range<HypernodeID>(0, edge_size),
+        [&](const tbb::blocked_range<HypernodeID>& range) {
+        for ( HypernodeID i = range.begin(); i < range.end(); ++i ) {
+          const HypernodeID v = *(first_pin + i);
+          if (tracker.wasNodeMovedInThisRound(v)) {
+            const MoveID m_id = tracker.moveIDOfNode(v);
+            Move& m = tracker.getMove(m_id);
+
+            const bool benefit = combined[m.from].last_out == m_id && combined[m.from].first_in > m_id && combined[m.from].remaining_pins == 0;
+            const bool penalty = combined[m.to].first_in == m_id && combined[m.to].last_out < m_id && combined[m.to].remaining_pins == 0;
+
+            if (benefit && !penalty) {
+              __atomic_fetch_add(&m.gain, we, __ATOMIC_RELAXED);
+            }
+
+            if (!benefit && penalty) {
+              __atomic_fetch_sub(&m.gain, we, __ATOMIC_RELAXED);
+            }
+          }
+        }
+      });
+    } else {
+      unused(phg);
+      unused(tracker);
+      unused(e);
+    }
   }
 
   template<bool update_gain_cache>
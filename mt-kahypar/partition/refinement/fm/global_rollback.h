@@ -35,11 +35,17 @@ namespace mt_kahypar {
 
 class GlobalRollback {
   static constexpr bool enable_heavy_assert = false;
+
+  // ! Nets with more pins than this threshold are not processed by a single thread
+  // ! during gain recalculation. Instead, we use a nested parallel reduction over their pins.
+  static constexpr HypernodeID HUGE_NET_THRESHOLD = 100000;
+
 public:
   explicit GlobalRollback(const Hypergraph& hg, const Context& context) :
     context(context),
     max_part_weight_scaling(context.refinement.fm.rollback_balance_violation_factor),
-    ets_recalc_data([&] { return vec<RecalculationData>(context.partition.k); }),
+    ets_recalc_data([&] { return RecalculationBuffer(context.partition.k); }),
+    ets_huge_nets(),
     last_recalc_round(),
     round(1) {
     if (context.refinement.fm.iter_moves_on_recalc && context.refinement.fm.rollback_parallel) {
@@ -79,8 +85,9 @@ public:
 
   void changeNumberOfBlocks(const PartitionID new_k) {
     for ( auto& recalc_data : ets_recalc_data ) {
-      if ( static_cast<size_t>(new_k) > recalc_data.size() ) {
-        recalc_data.resize(new_k);
+      if ( static_cast<size_t>(new_k) > recalc_data.data.size() ) {
+        recalc_data.data.resize(new_k);
+        recalc_data.is_touched.resize(new_k, uint8_t(false));
       }
     }
   }
@@ -89,6 +96,9 @@ public:
   bool verifyGains(PartitionedHypergraph& phg, FMSharedData& sharedData);
 
 private:
+  template<typename PHG>
+  void recalculateGainsOfHugeNet(PHG& phg, GlobalMoveTracker& tracker, const HyperedgeID e);
+
   const Context& context;
 
   // ! Factor to multiply max part weight with, in order to relax or disable the balance criterion. Set to zero for disabling
@@ -102,9 +112,46 @@ private:
       last_out(std::numeric_limits<MoveID>::min()),
       remaining_pins(0)
       { }
+
+    void merge(const RecalculationData& o) {
+      first_in = std::min(first_in, o.first_in);
+      last_out = std::max(last_out, o.last_out);
+      remaining_pins += o.remaining_pins;
+    }
+  };
+
+  // ! Recalculation data of all blocks and the blocks touched by the current net.
+  // ! Only the touched entries are reset after a net is processed, which avoids an
+  // ! O(k) reset per net.
+  struct RecalculationBuffer {
+    explicit RecalculationBuffer(const PartitionID k) :
+      data(k),
+      is_touched(k, uint8_t(false)),
+      touched_blocks() { }
+
+    RecalculationData& operator[](const PartitionID block) {
+      if ( !is_touched[block] ) {
+        is_touched[block] = uint8_t(true);
+        touched_blocks.push_back(block);
+      }
+      return data[block];
+    }
+
+    void reset() {
+      for ( const PartitionID block : touched_blocks ) {
+        data[block] = RecalculationData();
+        is_touched[block] = uint8_t(false);
+      }
+      touched_blocks.clear();
+    }
+
+    vec<RecalculationData> data;
+    vec<uint8_t> is_touched;
+    vec<PartitionID> touched_blocks;
   };
 
-  tbb::enumerable_thread_specific< vec<RecalculationData> > ets_recalc_data;
+  tbb::enumerable_thread_specific<RecalculationBuffer> ets_recalc_data;
+  tbb::enumerable_thread_specific< vec<HyperedgeID> > ets_huge_nets;
   vec<CAtomic<uint32_t>> last_recalc_round;
   uint32_t round;
 };
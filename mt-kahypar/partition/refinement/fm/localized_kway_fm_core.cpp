@@ -27,15 +27,18 @@
 
 #include "mt-kahypar/partition/refinement/fm/localized_kway_fm_core.h"
 
+#include "mt-kahypar/utils/trace_recorder.h"
+
 namespace mt_kahypar {
 
   template<typename FMStrategy>
   bool LocalizedKWayFM<FMStrategy>::findMoves(PartitionedHypergraph& phg, size_t taskID, size_t numSeeds) {
+    MT_KAHYPAR_TRACE_SCOPE("fm", "localized_fm_search");
     localMoves.clear();
     thisSearch = ++sharedData.nodeTracker.highestActiveSearchID;
 
     HypernodeID seedNode;
-    while (runStats.pushes < numSeeds && sharedData.refinementNodes.try_pop(seedNode, taskID)) {
+    while (runStats.pushes < numSeeds && sharedData.tryPopSeedNode(seedNode, taskID)) {
       SearchID previousSearchOfSeedNode = sharedData.nodeTracker.searchOfNode[seedNode].load(std::memory_order_relaxed);
       if (sharedData.nodeTracker.tryAcquireNode(seedNode, thisSearch)) {
         fm_strategy.insertIntoPQ(phg, seedNode, previousSearchOfSeedNode);
@@ -92,7 +95,7 @@ namespace mt_kahypar {
             SearchID searchOfV = sharedData.nodeTracker.searchOfNode[v].load(std::memory_order_relaxed);
             if (searchOfV == thisSearch) {
               fm_strategy.updateGain(phg, v, move);
-            } else if (sharedData.nodeTracker.tryAcquireNode(v, thisSearch)) {
+            } else if (!phg.isFixed(v) && sharedData.nodeTracker.tryAcquireNode(v, thisSearch)) {
               fm_strategy.insertIntoPQ(phg, v, searchOfV);
             }
             neighborDeduplicator[v] = deduplicationTime;
@@ -111,7 +114,7 @@ namespace mt_kahypar {
   template<typename FMStrategy>
   template<bool use_delta>
   void LocalizedKWayFM<FMStrategy>::internalFindMoves(PartitionedHypergraph& phg) {
-    StopRule stopRule(phg.initialNumNodes());
+    StopRule stopRule(phg.initialNumNodes(), sharedData.stopRuleAlpha);
     Move move;
 
     auto delta_func = [&](const HyperedgeID he,
@@ -164,6 +167,14 @@ namespace mt_kahypar {
       bool expect_improvement = estimatedImprovement + move.gain > bestImprovement;
       bool high_deg = phg.nodeDegree(move.node) >= PartitionedHypergraph::HIGH_DEGREE_THRESHOLD;
 
+      if constexpr (FMStrategy::maintain_gain_cache_between_rounds) {
+        // defer the move to a dedicated phase after the rollback (see MultiTryKWayFM)
+        if (high_deg && context.refinement.defer_high_degree_moves) {
+          sharedData.deferredHighDegreeNodes.push_back(move.node);
+          continue;
+        }
+      }
+
       // skip if high degree (unless it nets actual improvement; but don't apply on deltaPhg then)
       if (!expect_improvement && high_deg) {
         continue;
@@ -401,10 +412,12 @@ namespace mt_kahypar {
 #include "mt-kahypar/partition/refinement/fm/strategies/gain_delta_strategy.h"
 #include "mt-kahypar/partition/refinement/fm/strategies/recompute_gain_strategy.h"
 #include <mt-kahypar/partition/refinement/fm/strategies/gain_cache_on_demand_strategy.h>
+#include <mt-kahypar/partition/refinement/fm/strategies/gain_cache_lazy_strategy.h>
 
 namespace mt_kahypar {
   template class LocalizedKWayFM<GainCacheStrategy>;
   template class LocalizedKWayFM<GainDeltaStrategy>;
   template class LocalizedKWayFM<RecomputeGainStrategy>;
   template class LocalizedKWayFM<GainCacheOnDemandStrategy>;
+  template class LocalizedKWayFM<GainCacheLazyStrategy>;
 }
@@ -59,6 +59,21 @@ public:
 
   void changeNumberOfBlocks(const PartitionID new_k);
 
+  // ! Switches between bucket queues (max_key > 0) and binary heaps for the vertex PQs
+  void setVertexPQMaxKey(const Gain max_key) {
+    fm_strategy.setVertexPQMaxKey(max_key);
+  }
+
+  // ! Recomputes the gain cache entries that the searches of this object initialized
+  // ! during the last round (only if the FM strategy initializes the gain cache lazily)
+  void recomputeInitializedGainCacheEntries(PartitionedHypergraph& phg) {
+    if constexpr ( FMStrategy::initializes_gain_cache_lazily ) {
+      fm_strategy.recomputeInitializedGainCacheEntries(phg);
+    } else {
+      unused(phg);
+    }
+  }
+
   FMStats stats;
 
 private:
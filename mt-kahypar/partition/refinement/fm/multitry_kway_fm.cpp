@@ -27,6 +27,11 @@
 
 #include "mt-kahypar/partition/refinement/fm/multitry_kway_fm.h"
 
+#include "tbb/blocked_range.h"
+#include "tbb/parallel_reduce.h"
+
+#include "mt-kahypar/parallel/chunking.h"
+#include "mt-kahypar/parallel/parallel_counting_sort.h"
 #include "mt-kahypar/utils/utilities.h"
 #include "mt-kahypar/partition/metrics.h"
 #include "mt-kahypar/utils/memory_tree.h"
@@ -42,12 +47,17 @@ namespace mt_kahypar {
 
     if (!is_initialized) throw std::runtime_error("Call initialize on fm before calling refine");
     resizeDataStructuresForCurrentK();
+    setupVertexPQs(phg, !refinement_nodes.empty());
 
     Gain overall_improvement = 0;
+    Gain previous_improvement = 0;
     size_t consecutive_rounds_with_too_little_improvement = 0;
     enable_light_fm = false;
     sharedData.release_nodes = context.refinement.fm.release_nodes;
     sharedData.perform_moves_global = context.refinement.fm.perform_moves_global;
+    // Seeds can only be ordered by their gain if the gain cache is valid at the beginning of each round
+    sharedData.useSeedQueue = context.refinement.fm.order_seeds_by_gain &&
+      FMStrategy::maintain_gain_cache_between_rounds;
     double current_time_limit = time_limit;
     tbb::task_group tg;
     vec<HypernodeWeight> initialPartWeights(size_t(context.partition.k));
@@ -63,7 +73,7 @@ namespace mt_kahypar {
       roundInitialization(phg, refinement_nodes);
       timer.stop_timer("collect_border_nodes");
 
-      size_t num_border_nodes = sharedData.refinementNodes.unsafe_size();
+      size_t num_border_nodes = sharedData.numRefinementNodes();
       if (num_border_nodes == 0) {
         break;
       }
@@ -96,8 +106,24 @@ namespace mt_kahypar {
       phg.resetMoveState();
       HyperedgeWeight improvement = globalRollback.revertToBestPrefix
         <FMStrategy::maintain_gain_cache_between_rounds>(phg, sharedData, initialPartWeights);
+      if constexpr ( FMStrategy::initializes_gain_cache_lazily ) {
+        // Gain cache entries initialized during the round may not reflect concurrent moves
+        tbb::parallel_for(ets_fm.range(), [&](const auto& range) {
+          for ( auto& fm : range ) {
+            fm.recomputeInitializedGainCacheEntries(phg);
+          }
+        });
+      }
       timer.stop_timer("rollback");
 
+      if constexpr ( FMStrategy::maintain_gain_cache_between_rounds ) {
+        if ( !sharedData.deferredHighDegreeNodes.empty() ) {
+          timer.start_timer("high_degree_moves", "Move High-Degree Vertices");
+          improvement += moveHighDegreeVertices(phg);
+          timer.stop_timer("high_degree_moves");
+        }
+      }
+
       const double roundImprovementFraction = improvementFraction(improvement, metrics.km1 - overall_improvement);
       overall_improvement += improvement;
       if (roundImprovementFraction < context.refinement.fm.min_improvement) {
@@ -108,16 +134,28 @@ namespace mt_kahypar {
 
       HighResClockTimepoint fm_timestamp = std::chrono::high_resolution_clock::now();
       const double elapsed_time = std::chrono::duration<double>(fm_timestamp - fm_start).count();
-      if (debug && context.type == ContextType::main) {
+      if ((debug && context.type == ContextType::main) || context.refinement.fm.adaptive_stop_rule) {
         FMStats stats;
         for (auto& fm : ets_fm) {
           fm.stats.merge(stats);
         }
-        LOG << V(round) << V(improvement) << V(metrics::km1(phg)) << V(metrics::imbalance(phg, context))
-            << V(num_border_nodes) << V(roundImprovementFraction) << V(elapsed_time) << V(current_time_limit)
-            << stats.serialize();
+        if (context.refinement.fm.adaptive_stop_rule) {
+          adaptStopRule(stats);
+        }
+        if (debug && context.type == ContextType::main) {
+          LOG << V(round) << V(improvement) << V(metrics::km1(phg)) << V(metrics::imbalance(phg, context))
+              << V(num_border_nodes) << V(roundImprovementFraction) << V(elapsed_time) << V(current_time_limit)
+              << V(sharedData.stopRuleAlpha) << stats.serialize();
+        }
       }
 
+      // Learn how fast the improvement of consecutive rounds decreases
+      if (round > 0 && previous_improvement > 0) {
+        improvement_decay_sum += std::min(improvementFraction(improvement, previous_improvement), 1.0);
+        ++num_improvement_decays;
+      }
+      previous_improvement = improvement;
+
       // Enforce a time limit (based on k and coarsening time).
       // Switch to more "light-weight" FM after reaching it the first time. Abort after second time.
       if ( elapsed_time > current_time_limit ) {
@@ -136,6 +174,18 @@ namespace mt_kahypar {
       if (improvement <= 0 || consecutive_rounds_with_too_little_improvement >= 2) {
         break;
       }
+
+      if ( context.isCancelled() ) {
+        DBG << RED << "Partitioning run was cancelled => ABORT" << END;
+        break;
+      }
+
+      if (context.refinement.fm.min_expected_improvement > 0 &&
+          roundImprovementFraction * expectedImprovementDecay() < context.refinement.fm.min_expected_improvement) {
+        DBG << "Expected improvement of next round is too small => ABORT" << V(round)
+            << V(roundImprovementFraction) << V(expectedImprovementDecay());
+        break;
+      }
     }
 
     if (context.partition.show_memory_consumption && context.partition.verbose_output
@@ -154,13 +204,77 @@ namespace mt_kahypar {
     return overall_improvement > 0;
   }
 
+  template<typename FMStrategy>
+  Gain MultiTryKWayFM<FMStrategy>::moveHighDegreeVertices(PartitionedHypergraph& phg) {
+    // The gain cache is up-to-date after the rollback and no other vertex moves
+    // concurrently => the gain cache yields the exact gain of each move
+    Gain improvement = 0;
+    for ( const HypernodeID u : sharedData.deferredHighDegreeNodes ) {
+      const PartitionID from = phg.partID(u);
+      const HypernodeWeight weight_of_u = phg.nodeWeight(u);
+      PartitionID to = kInvalidPartition;
+      Gain best_gain = 0;
+      for ( PartitionID p = 0; p < context.partition.k; ++p ) {
+        if ( p != from && phg.partWeight(p) + weight_of_u <= context.partition.max_part_weights[p] ) {
+          const Gain gain = phg.km1Gain(u, from, p);
+          if ( gain > best_gain ) {
+            best_gain = gain;
+            to = p;
+          }
+        }
+      }
+
+      if ( to != kInvalidPartition && phg.changeNodePartWithGainCacheUpdateInParallel(u, from, to,
+            context.partition.max_part_weights[to], [] { }, NoOpDeltaFunc()) ) {
+        phg.recomputeMoveFromPenalty(u);
+        improvement += best_gain;
+      }
+    }
+    sharedData.deferredHighDegreeNodes.clear();
+    return improvement;
+  }
+
+  template<typename FMStrategy>
+  void MultiTryKWayFM<FMStrategy>::adaptStopRule(const FMStats& stats) {
+    if (stats.moves > 0) {
+      const double local_revert_fraction = static_cast<double>(stats.local_reverts) / stats.moves;
+      if (local_revert_fraction > MAX_LOCAL_REVERT_FRACTION) {
+        // Searches run for too long => stop earlier
+        sharedData.stopRuleAlpha = std::max(sharedData.stopRuleAlpha * 0.8, MIN_STOP_RULE_ALPHA);
+      } else if (local_revert_fraction < MIN_LOCAL_REVERT_FRACTION) {
+        sharedData.stopRuleAlpha = std::min(sharedData.stopRuleAlpha * 1.25, MAX_STOP_RULE_ALPHA);
+      }
+    }
+  }
+
   template<typename FMStrategy>
   void MultiTryKWayFM<FMStrategy>::roundInitialization(PartitionedHypergraph& phg,
                                                        const vec<HypernodeID>& refinement_nodes) {
     // clear border nodes
     sharedData.refinementNodes.clear();
+    sharedData.seedQueue.clear();
 
-    if ( refinement_nodes.empty() ) {
+    // Border nodes are seed nodes => their gain cache entries must be initialized
+    tbb::enumerable_thread_specific< vec<Gain> > ets_benefit_aggregator(context.partition.k, 0);
+    auto initialize_gain_cache_entry = [&](const HypernodeID u) {
+      if constexpr ( FMStrategy::initializes_gain_cache_lazily ) {
+        phg.initializeGainCacheEntryIfInvalid(u, ets_benefit_aggregator.local());
+      } else {
+        unused(u);
+      }
+    };
+
+    if ( refinement_nodes.empty() && phg.isCutNetTracked() ) {
+      // log(n) level case with cut net tracking
+      // only the pins of cut hyperedges are visited
+      phg.doParallelForAllBorderNodes([&](const HypernodeID u) {
+        const int task_id = tbb::this_task_arena::current_thread_index();
+        if ( task_id >= 0 && task_id < TBBInitializer::instance().total_number_of_threads() && !phg.isFixed(u) ) {
+          initialize_gain_cache_entry(u);
+          insertRefinementNode(phg, u, task_id);
+        }
+      });
+    } else if ( refinement_nodes.empty() ) {
       // log(n) level case
       // iterate over all nodes and insert border nodes into task queue
       tbb::parallel_for(tbb::blocked_range<HypernodeID>(0, phg.initialNumNodes()),
@@ -174,8 +288,9 @@ namespace mt_kahypar {
           // the segmentation fault.
           if ( task_id >= 0 && task_id < TBBInitializer::instance().total_number_of_threads() ) {
             for (HypernodeID u = r.begin(); u < r.end(); ++u) {
-              if (phg.nodeIsEnabled(u) && phg.isBorderNode(u)) {
-                sharedData.refinementNodes.safe_push(u, task_id);
+              if (phg.nodeIsEnabled(u) && phg.isBorderNode(u) && !phg.isFixed(u)) {
+                initialize_gain_cache_entry(u);
+                insertRefinementNode(phg, u, task_id);
               }
             }
           }
@@ -186,21 +301,110 @@ namespace mt_kahypar {
         const HypernodeID u = refinement_nodes[i];
         const int task_id = tbb::this_task_arena::current_thread_index();
         if ( task_id >= 0 && task_id < TBBInitializer::instance().total_number_of_threads() ) {
-          if (phg.nodeIsEnabled(u) && phg.isBorderNode(u)) {
-            sharedData.refinementNodes.safe_push(u, task_id);
+          if (phg.nodeIsEnabled(u) && phg.isBorderNode(u) && !phg.isFixed(u)) {
+            initialize_gain_cache_entry(u);
+            insertRefinementNode(phg, u, task_id);
           }
         }
       });
     }
 
-    // shuffle task queue if requested
-    if (context.refinement.fm.shuffle) {
+    if ( context.shared_memory.numa_aware_refinement && !sharedData.useSeedQueue &&
+         TBBInitializer::instance().num_used_numa_nodes() > 1 ) {
+      distributeSeedNodesByNumaNode(phg);
+    }
+
+    if (sharedData.useSeedQueue) {
+      sharedData.seedQueue.build();
+    } else if (context.refinement.fm.shuffle) {
+      // shuffle task queue if requested
       sharedData.refinementNodes.shuffle();
     }
 
     // requesting new searches activates all nodes by raising the deactivated node marker
     // also clears the array tracking search IDs in case of overflow
-    sharedData.nodeTracker.requestNewSearches(static_cast<SearchID>(sharedData.refinementNodes.unsafe_size()));
+    sharedData.nodeTracker.requestNewSearches(static_cast<SearchID>(sharedData.numRefinementNodes()));
+  }
+
+  template<typename FMStrategy>
+  void MultiTryKWayFM<FMStrategy>::distributeSeedNodesByNumaNode(const PartitionedHypergraph& phg) {
+    WorkContainer<HypernodeID>& seeds = sharedData.refinementNodes;
+    const size_t num_threads = seeds.tls_queues.size();
+    vec<size_t> queue_begins(num_threads + 1, 0);
+    for ( size_t t = 0; t < num_threads; ++t ) {
+      queue_begins[t + 1] = queue_begins[t] + seeds.tls_queues[t].elements.size();
+    }
+    vec<HypernodeID> seed_nodes(queue_begins.back());
+    tbb::parallel_for(UL(0), num_threads, [&](const size_t t) {
+      const vec<HypernodeID>& elements = seeds.tls_queues[t].elements;
+      std::copy(elements.begin(), elements.end(), seed_nodes.begin() + queue_begins[t]);
+    });
+
+    // Group the seed nodes by the NUMA node of their node ID range
+    const std::vector<size_t> boundaries =
+      TBBInitializer::instance().numa_node_boundaries(phg.initialNumNodes());
+    const size_t num_numa_nodes = boundaries.size() - 1;
+    auto numa_node_of = [&](const HypernodeID u) {
+      return static_cast<size_t>(std::upper_bound(boundaries.begin() + 1,
+        boundaries.end() - 1, static_cast<size_t>(u)) - ( boundaries.begin() + 1 ));
+    };
+    vec<HypernodeID> grouped_seed_nodes(seed_nodes.size());
+    const vec<uint32_t> domain_begins = parallel::counting_sort(seed_nodes,
+      grouped_seed_nodes, num_numa_nodes, numa_node_of, num_threads);
+
+    // Each thread receives an equal share of the seed nodes of its NUMA node. The seed
+    // nodes of a NUMA node without threads are distributed among all threads.
+    const std::vector<int> numa_node_of_thread =
+      TBBInitializer::instance().numa_node_of_threads(num_threads);
+    vec<vec<size_t>> threads_of_numa_node(num_numa_nodes);
+    for ( size_t t = 0; t < num_threads; ++t ) {
+      const size_t node = static_cast<size_t>(numa_node_of_thread[t]);
+      if ( node < num_numa_nodes ) {
+        threads_of_numa_node[node].push_back(t);
+      }
+    }
+
+    seeds.clear();
+    tbb::parallel_for(UL(0), num_threads, [&](const size_t t) {
+      for ( size_t node = 0; node < num_numa_nodes; ++node ) {
+        const vec<size_t>& threads = threads_of_numa_node[node];
+        size_t rank = t;
+        size_t num_shares = num_threads;
+        if ( !threads.empty() ) {
+          auto it = std::find(threads.begin(), threads.end(), t);
+          if ( it == threads.end() ) {
+            continue;
+          }
+          rank = static_cast<size_t>(it - threads.begin());
+          num_shares = threads.size();
+        }
+        const size_t num_domain_seeds = domain_begins[node + 1] - domain_begins[node];
+        const size_t chunk_size = parallel::chunking::idiv_ceil(num_domain_seeds, num_shares);
+        const auto [first, last] = parallel::chunking::bounds(rank, num_domain_seeds, chunk_size);
+        for ( size_t i = first; i < last; ++i ) {
+          seeds.safe_push(grouped_seed_nodes[domain_begins[node] + i], t);
+        }
+      }
+    });
+  }
+
+  template<typename FMStrategy>
+  void MultiTryKWayFM<FMStrategy>::insertRefinementNode(const PartitionedHypergraph& phg,
+                                                        const HypernodeID u,
+                                                        const size_t task_id) {
+    if (sharedData.useSeedQueue) {
+      // The key of a seed node is its highest gain in the gain cache (ignoring the balance constraint)
+      const PartitionID from = phg.partID(u);
+      Gain max_gain = std::numeric_limits<Gain>::min() + 1;
+      for (PartitionID to = 0; to < context.partition.k; ++to) {
+        if (to != from) {
+          max_gain = std::max(max_gain, static_cast<Gain>(phg.km1Gain(u, from, to)));
+        }
+      }
+      sharedData.seedQueue.safe_push(u, max_gain, task_id);
+    } else {
+      sharedData.refinementNodes.safe_push(u, task_id);
+    }
   }
 
 
@@ -211,7 +415,11 @@ namespace mt_kahypar {
     }
 
     if (!phg.isGainCacheInitialized() && FMStrategy::maintain_gain_cache_between_rounds) {
-      phg.initializeGainCache();
+      if ( FMStrategy::initializes_gain_cache_lazily ) {
+        phg.initializeGainCacheLazily(context.partition.ignore_hyperedge_size_threshold);
+      } else {
+        phg.initializeGainCache();
+      }
     }
 
     is_initialized = true;
@@ -239,6 +447,46 @@ namespace mt_kahypar {
     }
   }
 
+  template<typename FMStrategy>
+  void MultiTryKWayFM<FMStrategy>::setupVertexPQs(const PartitionedHypergraph& phg,
+                                                  const bool is_localized_refinement) {
+    // The gain of a move is bounded by the weighted degree of the moved vertex for the
+    // cut and km1 metric. In n-level refinement, the hypergraph changes between
+    // successive calls and we do not recompute the bound.
+    Gain max_key = 0;
+    const HyperedgeWeight max_gain = context.refinement.fm.bucket_queue_max_gain;
+    if ( max_gain > 0 && !is_localized_refinement &&
+         ( context.partition.objective == Objective::km1 ||
+           context.partition.objective == Objective::cut ) ) {
+      const HyperedgeWeight max_weighted_degree = tbb::parallel_reduce(
+        tbb::blocked_range<HypernodeID>(ID(0), phg.initialNumNodes()), 0,
+        [&](const tbb::blocked_range<HypernodeID>& range, HyperedgeWeight init) {
+          for ( HypernodeID hn = range.begin(); hn < range.end(); ++hn ) {
+            if ( phg.nodeIsEnabled(hn) ) {
+              HyperedgeWeight weighted_degree = 0;
+              for ( const HyperedgeID& he : phg.incidentEdges(hn) ) {
+                weighted_degree += phg.edgeWeight(he);
+              }
+              init = std::max(init, weighted_degree);
+            }
+          }
+          return init;
+        }, [](const HyperedgeWeight lhs, const HyperedgeWeight rhs) {
+          return std::max(lhs, rhs);
+        });
+      if ( max_weighted_degree <= max_gain ) {
+        max_key = max_weighted_degree;
+      }
+    }
+
+    if ( max_key != sharedData.vertexPQMaxKey ) {
+      sharedData.vertexPQMaxKey = max_key;
+      for ( auto& localized_fm : ets_fm ) {
+        localized_fm.setVertexPQMaxKey(max_key);
+      }
+    }
+  }
+
   template<typename FMStrategy>
   void MultiTryKWayFM<FMStrategy>::printMemoryConsumption() {
     utils::MemoryTreeNode fm_memory("Multitry k-Way FM", utils::OutputType::MEGABYTE);
@@ -259,10 +507,12 @@ namespace mt_kahypar {
 #include "mt-kahypar/partition/refinement/fm/strategies/gain_delta_strategy.h"
 #include "mt-kahypar/partition/refinement/fm/strategies/recompute_gain_strategy.h"
 #include "mt-kahypar/partition/refinement/fm/strategies/gain_cache_on_demand_strategy.h"
+#include "mt-kahypar/partition/refinement/fm/strategies/gain_cache_lazy_strategy.h"
 
 namespace mt_kahypar {
   template class MultiTryKWayFM<GainCacheStrategy>;
   template class MultiTryKWayFM<GainDeltaStrategy>;
   template class MultiTryKWayFM<RecomputeGainStrategy>;
   template class MultiTryKWayFM<GainCacheOnDemandStrategy>;
+  template class MultiTryKWayFM<GainCacheLazyStrategy>;
 }
@@ -44,6 +44,14 @@ class MultiTryKWayFM final : public IRefiner {
   static constexpr bool debug = false;
   static constexpr bool enable_heavy_assert = false;
 
+  // ! Bounds for the sensitivity of the adaptive stop rule (see StopRule)
+  static constexpr double MIN_STOP_RULE_ALPHA = 0.75;
+  static constexpr double MAX_STOP_RULE_ALPHA = 2.0;
+  // ! If more than MAX_LOCAL_REVERT_FRACTION of all moves of a round are reverted by the
+  // ! localized searches, the stop rule becomes more aggressive. If less than
+  // ! MIN_LOCAL_REVERT_FRACTION are reverted, it becomes more relaxed.
+  static constexpr double MAX_LOCAL_REVERT_FRACTION = 0.9;
+  static constexpr double MIN_LOCAL_REVERT_FRACTION = 0.6;
 
  public:
 
@@ -74,6 +82,29 @@ class MultiTryKWayFM final : public IRefiner {
   void roundInitialization(PartitionedHypergraph& phg,
                            const vec<HypernodeID>& refinement_nodes);
 
+  void insertRefinementNode(const PartitionedHypergraph& phg,
+                            const HypernodeID u,
+                            const size_t task_id);
+
+  // ! Redistributes the seed nodes such that each seed node is held by a thread
+  // ! running on the NUMA node of its node ID range (see numa_aware_refinement)
+  void distributeSeedNodesByNumaNode(const PartitionedHypergraph& phg);
+
+  // ! Moves the high-degree vertices deferred by the localized searches of the last
+  // ! round one after another, each updating its incident hyperedges in parallel.
+  // ! Returns the improvement of the applied moves.
+  Gain moveHighDegreeVertices(PartitionedHypergraph& phg);
+
+  // ! Adapts the sensitivity of the stop rule to the fraction
+  // ! of moves reverted by the localized searches of the last round
+  void adaptStopRule(const FMStats& stats);
+
+  // ! Average ratio between the improvements of consecutive multitry rounds
+  // ! observed so far (over all levels)
+  double expectedImprovementDecay() const {
+    return num_improvement_decays > 0 ? improvement_decay_sum / num_improvement_decays : 1.0;
+  }
+
 
   LocalizedKWayFM<FMStrategy> constructLocalizedKWayFMSearch() {
     return LocalizedKWayFM<FMStrategy>(context, initial_num_nodes, sharedData);
@@ -88,8 +119,13 @@ class MultiTryKWayFM final : public IRefiner {
 
   void resizeDataStructuresForCurrentK();
 
+  // ! Uses bucket queues as vertex PQs, if the gains are in a small range
+  void setupVertexPQs(const PartitionedHypergraph& phg, const bool is_localized_refinement);
+
   bool is_initialized = false;
   bool enable_light_fm = false;
+  double improvement_decay_sum = 0.0;
+  size_t num_improvement_decays = 0;
   const HypernodeID initial_num_nodes;
   const Context& context;
   PartitionID current_k;
@@ -0,0 +1,425 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "mt-kahypar/partition/refinement/fm/pairwise_fm_refiner.h"
+
+#include <algorithm>
+
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+
+#include "mt-kahypar/partition/metrics.h"
+#include "mt-kahypar/partition/refinement/fm/stop_rule.h"
+#include "mt-kahypar/utils/utilities.h"
+
+namespace mt_kahypar {
+
+namespace {
+
+template<typename F>
+bool changeNodePart(PartitionedHypergraph& phg,
+                    const HypernodeID hn,
+                    const PartitionID from,
+                    const PartitionID to,
+                    const HypernodeWeight max_weight_to,
+                    const F& objective_delta,
+                    const bool gain_cache_update) {
+  if ( gain_cache_update && phg.isGainCacheInitialized() ) {
+    return phg.changeNodePartWithGainCacheUpdate(hn, from, to,
+      max_weight_to, [] { }, objective_delta);
+  } else {
+    return phg.changeNodePart(hn, from, to,
+      max_weight_to, [] { }, objective_delta);
+  }
+}
+
+} // namespace
+
+bool PairwiseFMRefiner::refineImpl(PartitionedHypergraph& phg,
+                                   const vec<HypernodeID>& refinement_nodes,
+                                   Metrics& best_metrics,
+                                   const double) {
+  resizeDataStructuresForCurrentK();
+  std::fill(_is_active_block.begin(), _is_active_block.begin() + _current_k, uint8_t(true));
+
+  Gain overall_improvement = 0;
+  const size_t max_rounds = std::max(_context.refinement.fm.multitry_rounds, UL(1));
+  for ( size_t round = 0; round < max_rounds; ++round ) {
+    // Each round searches all block pairs with at least one active block once
+    vec<MatchedBlockPair> block_pairs = collectActiveBlockPairs(phg);
+    if ( block_pairs.empty() ) {
+      break;
+    }
+    collectBorderNodes(phg, refinement_nodes);
+
+    vec<uint8_t> next_active_blocks(_current_k, uint8_t(false));
+    Gain round_improvement = 0;
+    while ( !block_pairs.empty() ) {
+      const vec<MatchedBlockPair> matching = extractMatching(block_pairs);
+      collectSeeds(phg, matching);
+
+      tbb::enumerable_thread_specific<Gain> local_improvement(0);
+      tbb::parallel_for(UL(0), matching.size(), [&](const size_t idx) {
+        const Gain improvement = twoWayFM(phg, matching[idx], idx);
+        if ( improvement > 0 ) {
+          // The block pairs of a matching are disjoint
+          next_active_blocks[matching[idx].i] = uint8_t(true);
+          next_active_blocks[matching[idx].j] = uint8_t(true);
+          local_improvement.local() += improvement;
+        }
+      });
+      round_improvement += local_improvement.combine(std::plus<Gain>());
+    }
+
+    DBG << "Pairwise FM round" << (round + 1) << ":" << V(round_improvement);
+    overall_improvement += round_improvement;
+    std::copy(next_active_blocks.begin(), next_active_blocks.end(), _is_active_block.begin());
+    if ( round_improvement == 0 ) {
+      break;
+    }
+  }
+
+  const Objective objective = _context.partition.objective;
+  best_metrics.updateMetric(best_metrics.getMetric(Mode::direct, objective) - overall_improvement,
+    Mode::direct, objective);
+  best_metrics.imbalance = metrics::imbalance(phg, _context);
+  HEAVY_REFINEMENT_ASSERT(best_metrics.getMetric(Mode::direct, objective) == metrics::objective(phg, objective),
+    V(best_metrics.getMetric(Mode::direct, objective)) << V(metrics::objective(phg, objective)));
+
+  utils::Utilities::instance().getStats(_context.utility_id).update_stat(
+    "pairwise_fm_improvement", overall_improvement);
+  return overall_improvement > 0;
+}
+
+void PairwiseFMRefiner::resizeDataStructuresForCurrentK() {
+  if ( _current_k != _context.partition.k ) {
+    _current_k = _context.partition.k;
+    const size_t num_block_pairs = static_cast<size_t>(_current_k) * _current_k;
+    if ( num_block_pairs > _cut_weight.size() ) {
+      _cut_weight.assign(num_block_pairs, CAtomic<HyperedgeWeight>(0));
+    }
+    if ( static_cast<size_t>(_current_k) > _is_active_block.size() ) {
+      _is_active_block.assign(_current_k, uint8_t(true));
+      _partner.assign(_current_k, kInvalidPartition);
+    }
+  }
+}
+
+vec<PairwiseFMRefiner::MatchedBlockPair> PairwiseFMRefiner::collectActiveBlockPairs(
+  const PartitionedHypergraph& phg) {
+  const PartitionID k = _current_k;
+  tbb::parallel_for(UL(0), static_cast<size_t>(k) * k, [&](const size_t pos) {
+    _cut_weight[pos].store(0, std::memory_order_relaxed);
+  });
+  phg.doParallelForAllEdges([&](const HyperedgeID he) {
+    if ( phg.connectivity(he) > 1 ) {
+      const HyperedgeWeight edge_weight = phg.edgeWeight(he);
+      for ( const PartitionID i : phg.connectivitySet(he) ) {
+        for ( const PartitionID j : phg.connectivitySet(he) ) {
+          if ( i < j ) {
+            _cut_weight[i * k + j].fetch_add(edge_weight, std::memory_order_relaxed);
+          }
+        }
+      }
+    }
+  });
+
+  vec<MatchedBlockPair> block_pairs;
+  for ( PartitionID i = 0; i < k; ++i ) {
+    for ( PartitionID j = i + 1; j < k; ++j ) {
+      const HyperedgeWeight cut_weight = _cut_weight[i * k + j].load(std::memory_order_relaxed);
+      if ( cut_weight > 0 && ( _is_active_block[i] || _is_active_block[j] ) ) {
+        block_pairs.push_back(MatchedBlockPair { i, j, cut_weight });
+      }
+    }
+  }
+  std::sort(block_pairs.begin(), block_pairs.end(),
+    [&](const MatchedBlockPair& lhs, const MatchedBlockPair& rhs) {
+      return lhs.cut_weight > rhs.cut_weight || ( lhs.cut_weight == rhs.cut_weight &&
+        ( lhs.i < rhs.i || ( lhs.i == rhs.i && lhs.j < rhs.j ) ) );
+    });
+  return block_pairs;
+}
+
+vec<PairwiseFMRefiner::MatchedBlockPair> PairwiseFMRefiner::extractMatching(
+  vec<MatchedBlockPair>& block_pairs) {
+  vec<MatchedBlockPair> matching;
+  vec<MatchedBlockPair> remaining_block_pairs;
+  std::fill(_partner.begin(), _partner.begin() + _current_k, kInvalidPartition);
+  for ( const MatchedBlockPair& pair : block_pairs ) {
+    if ( _partner[pair.i] == kInvalidPartition && _partner[pair.j] == kInvalidPartition ) {
+      _partner[pair.i] = pair.j;
+      _partner[pair.j] = pair.i;
+      matching.push_back(pair);
+    } else {
+      remaining_block_pairs.push_back(pair);
+    }
+  }
+  block_pairs = std::move(remaining_block_pairs);
+  return matching;
+}
+
+void PairwiseFMRefiner::collectBorderNodes(const PartitionedHypergraph& phg,
+                                           const vec<HypernodeID>& refinement_nodes) {
+  tbb::enumerable_thread_specific<vec<HypernodeID>> local_border_nodes;
+  auto add_if_border_node = [&](const HypernodeID hn) {
+    for ( const HyperedgeID& he : phg.incidentEdges(hn) ) {
+      if ( phg.connectivity(he) > 1 ) {
+        local_border_nodes.local().push_back(hn);
+        break;
+      }
+    }
+  };
+  if ( refinement_nodes.empty() ) {
+    phg.doParallelForAllNodes(add_if_border_node);
+  } else {
+    tbb::parallel_for(UL(0), refinement_nodes.size(), [&](const size_t i) {
+      add_if_border_node(refinement_nodes[i]);
+    });
+  }
+
+  _border_nodes.clear();
+  for ( const vec<HypernodeID>& border_nodes : local_border_nodes ) {
+    _border_nodes.insert(_border_nodes.end(), border_nodes.begin(), border_nodes.end());
+  }
+  // Makes the order of the seeds independent of the scheduling of the threads
+  tbb::parallel_sort(_border_nodes.begin(), _border_nodes.end());
+}
+
+void PairwiseFMRefiner::collectSeeds(const PartitionedHypergraph& phg,
+                                     const vec<MatchedBlockPair>& matching) {
+  // Index of the block pair of each block in the current matching
+  vec<size_t> pair_index(_current_k, matching.size());
+  for ( size_t idx = 0; idx < matching.size(); ++idx ) {
+    pair_index[matching[idx].i] = idx;
+    pair_index[matching[idx].j] = idx;
+  }
+
+  // Count seeds of each block pair ...
+  vec<uint8_t> is_seed(_border_nodes.size(), uint8_t(false));
+  vec<CAtomic<size_t>> num_seeds(matching.size() + 1, CAtomic<size_t>(0));
+  tbb::parallel_for(UL(0), _border_nodes.size(), [&](const size_t pos) {
+    const HypernodeID hn = _border_nodes[pos];
+    const PartitionID partner = _partner[phg.partID(hn)];
+    if ( partner != kInvalidPartition ) {
+      for ( const HyperedgeID& he : phg.incidentEdges(hn) ) {
+        if ( phg.pinCountInPart(he, partner) > 0 ) {
+          is_seed[pos] = uint8_t(true);
+          num_seeds[pair_index[partner] + 1].fetch_add(1, std::memory_order_relaxed);
+          break;
+        }
+      }
+    }
+  });
+
+  // ... and store them consecutively
+  _seed_offsets.assign(matching.size() + 1, 0);
+  for ( size_t idx = 0; idx < matching.size(); ++idx ) {
+    _seed_offsets[idx + 1] = _seed_offsets[idx] + num_seeds[idx + 1].load(std::memory_order_relaxed);
+  }
+  _seeds.resize(_seed_offsets.back());
+  vec<size_t> insert_pos(_seed_offsets.begin(), _seed_offsets.end() - 1);
+  for ( size_t pos = 0; pos < _border_nodes.size(); ++pos ) {
+    if ( is_seed[pos] ) {
+      const HypernodeID hn = _border_nodes[pos];
+      _seeds[insert_pos[pair_index[phg.partID(hn)]]++] = hn;
+    }
+  }
+}
+
+Gain PairwiseFMRefiner::twoWayFM(PartitionedHypergraph& phg,
+                                 const MatchedBlockPair& pair,
+                                 const size_t pair_idx) {
+  LocalSearchData& data = _local_data.local();
+  const PartitionID blocks[2] = { pair.i, pair.j };
+  auto side = [&](const PartitionID block) {
+    ASSERT(block == pair.i || block == pair.j);
+    return block == pair.i ? 0 : 1;
+  };
+
+  for ( size_t pos = _seed_offsets[pair_idx]; pos < _seed_offsets[pair_idx + 1]; ++pos ) {
+    const HypernodeID hn = _seeds[pos];
+    const PartitionID from = phg.partID(hn);
+    const PartitionID to = _partner[from];
+    data.pq[side(from)].insert(hn, computeGain(phg, hn, from, to));
+  }
+
+  const Objective objective = _context.partition.objective;
+  Gain delta = 0;
+  auto delta_func = [&](const HyperedgeID he,
+                        const HyperedgeWeight edge_weight,
+                        const HypernodeID edge_size,
+                        const HypernodeID pin_count_in_from_part_after,
+                        const HypernodeID pin_count_in_to_part_after) {
+    if ( objective == Objective::cut ) {
+      delta += cutDelta(he, edge_weight, edge_size,
+        pin_count_in_from_part_after, pin_count_in_to_part_after);
+    } else {
+      delta += km1Delta(he, edge_weight, edge_size,
+        pin_count_in_from_part_after, pin_count_in_to_part_after);
+    }
+  };
+
+  Gain current_improvement = 0;
+  Gain best_improvement = 0;
+  size_t best_prefix = 0;
+  StopRule stopping_rule(phg.initialNumNodes());
+  while ( !stopping_rule.searchShouldStop() ) {
+    // Vertices that do not fit into the other block are skipped
+    for ( int s = 0; s < 2; ++s ) {
+      const PartitionID to = blocks[1 - s];
+      while ( !data.pq[s].empty() && phg.partWeight(to) + phg.nodeWeight(data.pq[s].top()) >
+              _context.partition.max_part_weights[to] ) {
+        data.pq[s].deleteTop();
+      }
+    }
+    if ( data.pq[0].empty() && data.pq[1].empty() ) {
+      break;
+    }
+
+    const int s = data.pq[1].empty() || ( !data.pq[0].empty() &&
+      data.pq[0].topKey() >= data.pq[1].topKey() ) ? 0 : 1;
+    const HypernodeID hn = data.pq[s].top();
+    const Gain expected_gain = data.pq[s].topKey();
+    data.pq[s].deleteTop();
+    const PartitionID from = blocks[s];
+    const PartitionID to = blocks[1 - s];
+    ASSERT(phg.partID(hn) == from);
+    HEAVY_REFINEMENT_ASSERT(expected_gain == computeGain(phg, hn, from, to));
+
+    delta = 0;
+    if ( changeNodePart(phg, hn, from, to, _context.partition.max_part_weights[to],
+           delta_func, _context.forceGainCacheUpdates()) ) {
+      ASSERT(expected_gain == -delta, V(expected_gain) << V(delta));
+      _is_moved[hn] = uint8_t(true);
+      data.moves.push_back(hn);
+      current_improvement -= delta;
+      stopping_rule.update(expected_gain);
+      if ( current_improvement > best_improvement ) {
+        best_improvement = current_improvement;
+        best_prefix = data.moves.size();
+        stopping_rule.reset();
+      }
+      updateNeighbors(phg, data, hn, from, to, s);
+    }
+  }
+
+  // Revert all moves after the best prefix
+  for ( size_t i = data.moves.size(); i > best_prefix; --i ) {
+    const HypernodeID hn = data.moves[i - 1];
+    const PartitionID from = phg.partID(hn);
+    changeNodePart(phg, hn, from, _partner[from], std::numeric_limits<HypernodeWeight>::max(),
+      [](const HyperedgeID, const HyperedgeWeight, const HypernodeID,
+         const HypernodeID, const HypernodeID) { }, _context.forceGainCacheUpdates());
+  }
+  for ( const HypernodeID& hn : data.moves ) {
+    if ( _context.forceGainCacheUpdates() && phg.isGainCacheInitialized() ) {
+      phg.recomputeMoveFromPenalty(hn);
+    }
+    _is_moved[hn] = uint8_t(false);
+  }
+  DBG << "2-way FM on blocks (" << pair.i << "," << pair.j << "): Moves =" << data.moves.size()
+      << ", Best Prefix =" << best_prefix << ", Improvement =" << best_improvement;
+  data.moves.clear();
+  data.pq[0].clear();
+  data.pq[1].clear();
+  return best_improvement;
+}
+
+void PairwiseFMRefiner::updateNeighbors(const PartitionedHypergraph& phg,
+                                        LocalSearchData& data,
+                                        const HypernodeID u,
+                                        const PartitionID from,
+                                        const PartitionID to,
+                                        const int from_side) {
+  const int to_side = 1 - from_side;
+  for ( const HyperedgeID& he : phg.incidentEdges(u) ) {
+    const HypernodeID edge_size = phg.edgeSize(he);
+    if ( edge_size <= 1 ) {
+      continue;
+    }
+    const HyperedgeWeight edge_weight = phg.edgeWeight(he);
+    const HypernodeID pin_count_from = phg.pinCountInPart(he, from);
+    const HypernodeID pin_count_to = phg.pinCountInPart(he, to);
+    // The gain contribution of the hyperedge is the same for all pins of a block
+    const Gain delta_from = gainContribution(pin_count_from, pin_count_to, edge_size, edge_weight) -
+      gainContribution(pin_count_from + 1, pin_count_to - 1, edge_size, edge_weight);
+    const Gain delta_to = gainContribution(pin_count_to, pin_count_from, edge_size, edge_weight) -
+      gainContribution(pin_count_to - 1, pin_count_from + 1, edge_size, edge_weight);
+    // If u is the first pin in block 'to', the pins in block 'from' become border vertices
+    const bool became_cut = pin_count_to == 1 && pin_count_from > 0;
+    if ( delta_from == 0 && delta_to == 0 && !became_cut ) {
+      continue;
+    }
+
+    for ( const HypernodeID& pin : phg.pins(he) ) {
+      if ( _is_moved[pin] ) {
+        continue;
+      }
+      // Note that pins in other blocks are never moved to 'from' or 'to' concurrently,
+      // since the block pairs of a matching are disjoint
+      const PartitionID block = phg.partID(pin);
+      if ( block == from ) {
+        if ( data.pq[from_side].contains(pin) ) {
+          if ( delta_from != 0 ) {
+            data.pq[from_side].adjustKey(pin, data.pq[from_side].keyOf(pin) + delta_from);
+          }
+        } else if ( became_cut ) {
+          data.new_border_nodes.push_back(pin);
+        }
+      } else if ( block == to && delta_to != 0 && data.pq[to_side].contains(pin) ) {
+        data.pq[to_side].adjustKey(pin, data.pq[to_side].keyOf(pin) + delta_to);
+      }
+    }
+  }
+
+  // The gains of new border vertices are computed after all delta gain updates
+  // (otherwise, the updates of the remaining hyperedges would be applied twice)
+  for ( const HypernodeID& hn : data.new_border_nodes ) {
+    if ( !data.pq[from_side].contains(hn) ) {
+      data.pq[from_side].insert(hn, computeGain(phg, hn, from, to));
+    }
+  }
+  data.new_border_nodes.clear();
+}
+
+Gain PairwiseFMRefiner::computeGain(const PartitionedHypergraph& phg,
+                                    const HypernodeID u,
+                                    const PartitionID from,
+                                    const PartitionID to) const {
+  ASSERT(phg.partID(u) == from);
+  Gain gain = 0;
+  for ( const HyperedgeID& he : phg.incidentEdges(u) ) {
+    const HypernodeID edge_size = phg.edgeSize(he);
+    if ( edge_size > 1 ) {
+      gain += gainContribution(phg.pinCountInPart(he, from),
+        phg.pinCountInPart(he, to), edge_size, phg.edgeWeight(he));
+    }
+  }
+  return gain;
+}
+
+}  // namespace mt_kahypar
@@ -0,0 +1,184 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include "mt-kahypar/datastructures/priority_queue.h"
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/refinement/i_refiner.h"
+
+namespace mt_kahypar {
+
+/*!
+ * Pairwise 2-way FM refinement in the style of KaFFPa.
+ * Each round computes the cut weight between all pairs of blocks (quotient graph)
+ * and decomposes the block pairs with at least one active block into a sequence of
+ * matchings (heaviest pairs first). The block pairs of a matching are disjoint and
+ * are refined in parallel by a sequential 2-way FM local search that only moves
+ * border vertices between the two blocks. Since the objective delta of a move only
+ * depends on the pin counts of its source and target block, the searches do not
+ * interfere and each search can compute its gains and improvement exactly.
+ * A block becomes active for the next round, if a search on one of its block pairs
+ * improved the partition.
+ */
+class PairwiseFMRefiner final : public IRefiner {
+
+  static constexpr bool debug = false;
+  static constexpr bool enable_heavy_assert = false;
+
+  using VertexPriorityQueue = ds::MaxHeap<Gain, HypernodeID>;
+
+  struct MatchedBlockPair {
+    PartitionID i;
+    PartitionID j;
+    HyperedgeWeight cut_weight;
+  };
+
+  // ! Data of a 2-way FM local search (one per thread)
+  struct LocalSearchData {
+    explicit LocalSearchData(PosT* pq_handles, const size_t num_handles) :
+      pq { VertexPriorityQueue(pq_handles, num_handles),
+           VertexPriorityQueue(pq_handles, num_handles) },
+      moves(),
+      new_border_nodes() { }
+
+    // ! pq[0] contains the vertices of the first block of the pair and
+    // ! pq[1] the vertices of the second block (keyed by the gain of moving
+    // ! them to the other block)
+    VertexPriorityQueue pq[2];
+    vec<HypernodeID> moves;
+    vec<HypernodeID> new_border_nodes;
+  };
+
+ public:
+  explicit PairwiseFMRefiner(Hypergraph& hypergraph,
+                             const Context& context) :
+    _context(context),
+    _current_k(context.partition.k),
+    _pq_handles(hypergraph.initialNumNodes(), invalid_position),
+    _is_moved(hypergraph.initialNumNodes(), uint8_t(false)),
+    _cut_weight(context.partition.k * context.partition.k, CAtomic<HyperedgeWeight>(0)),
+    _is_active_block(context.partition.k, uint8_t(true)),
+    _partner(context.partition.k, kInvalidPartition),
+    _border_nodes(),
+    _seeds(),
+    _seed_offsets(),
+    _local_data([&] {
+      return LocalSearchData(_pq_handles.data(), _pq_handles.size());
+    }) { }
+
+  PairwiseFMRefiner(const PairwiseFMRefiner&) = delete;
+  PairwiseFMRefiner(PairwiseFMRefiner&&) = delete;
+
+  PairwiseFMRefiner & operator= (const PairwiseFMRefiner &) = delete;
+  PairwiseFMRefiner & operator= (PairwiseFMRefiner &&) = delete;
+
+ private:
+  bool refineImpl(PartitionedHypergraph& phg,
+                  const vec<HypernodeID>& refinement_nodes,
+                  Metrics& best_metrics,
+                  double) final;
+
+  void initializeImpl(PartitionedHypergraph&) final { /* nothing to do */ }
+
+  void resizeDataStructuresForCurrentK();
+
+  // ! Computes the weight of all hyperedges cut between each pair of blocks
+  // ! and returns the block pairs with at least one active block (heaviest first)
+  vec<MatchedBlockPair> collectActiveBlockPairs(const PartitionedHypergraph& phg);
+
+  // ! Removes a greedy matching of block pairs from the given pairs and returns it
+  vec<MatchedBlockPair> extractMatching(vec<MatchedBlockPair>& block_pairs);
+
+  // ! Collects all vertices incident to a cut hyperedge
+  void collectBorderNodes(const PartitionedHypergraph& phg,
+                          const vec<HypernodeID>& refinement_nodes);
+
+  // ! Assigns each border vertex adjacent to the partner block of its
+  // ! block to the search of the corresponding block pair
+  void collectSeeds(const PartitionedHypergraph& phg,
+                    const vec<MatchedBlockPair>& matching);
+
+  // ! Runs a 2-way FM local search on the block pair (pair.i, pair.j)
+  // ! and returns the improvement of the objective function
+  Gain twoWayFM(PartitionedHypergraph& phg,
+                const MatchedBlockPair& pair,
+                const size_t pair_idx);
+
+  // ! Updates the gains of the neighbors of u after u was moved from block
+  // ! 'from' to block 'to' and inserts new border vertices into the PQs
+  // ! (data.pq[from_side] contains the vertices of block 'from')
+  void updateNeighbors(const PartitionedHypergraph& phg,
+                       LocalSearchData& data,
+                       const HypernodeID u,
+                       const PartitionID from,
+                       const PartitionID to,
+                       const int from_side);
+
+  Gain computeGain(const PartitionedHypergraph& phg,
+                   const HypernodeID u,
+                   const PartitionID from,
+                   const PartitionID to) const;
+
+  // ! Contribution of a hyperedge to the gain of moving one of its pins from its
+  // ! block to the other block, if the hyperedge has pin_count_own pins in the block
+  // ! of the pin and pin_count_other pins in the other block
+  Gain gainContribution(const HypernodeID pin_count_own,
+                        const HypernodeID pin_count_other,
+                        const HypernodeID edge_size,
+                        const HyperedgeWeight edge_weight) const {
+    if ( _context.partition.objective == Objective::cut ) {
+      return ( pin_count_other + 1 == edge_size ? edge_weight : 0 ) -
+        ( pin_count_own == edge_size ? edge_weight : 0 );
+    } else {
+      return ( pin_count_own == 1 ? edge_weight : 0 ) -
+        ( pin_count_other == 0 ? edge_weight : 0 );
+    }
+  }
+
+  const Context& _context;
+  PartitionID _current_k;
+  // ! Handles of the PQs of all local searches. The block pairs of a matching are
+  // ! disjoint, such that each vertex is contained in at most one PQ.
+  vec<PosT> _pq_handles;
+  vec<uint8_t> _is_moved;
+  // ! Cut weight between block i and j at position i * k + j (i < j)
+  vec<CAtomic<HyperedgeWeight>> _cut_weight;
+  vec<uint8_t> _is_active_block;
+  // ! Block with which a block is matched in the current matching
+  vec<PartitionID> _partner;
+  vec<HypernodeID> _border_nodes;
+  // ! Seeds of the i-th block pair of the current matching are stored in
+  // ! _seeds[_seed_offsets[i]] to _seeds[_seed_offsets[i + 1] - 1]
+  vec<HypernodeID> _seeds;
+  vec<size_t> _seed_offsets;
+  tbb::enumerable_thread_specific<LocalSearchData> _local_data;
+};
+
+}  // namespace mt_kahypar
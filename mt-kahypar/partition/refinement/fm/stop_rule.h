@@ -34,7 +34,10 @@ namespace mt_kahypar {
 // adaptive random walk stopping rule from KaHyPar
 class StopRule {
 public:
-  StopRule(HypernodeID numNodes) : beta(std::log(numNodes)) { }
+  // ! A larger alpha lets the local search run longer before it is stopped
+  StopRule(HypernodeID numNodes, double alpha = 1.0) :
+    stopFactor((alpha / 2.0) - 0.25),
+    beta(std::log(numNodes)) { }
 
   bool searchShouldStop() {
     return (numSteps > beta) && (Mk == 0 || numSteps >= ( variance / (Mk*Mk) ) * stopFactor );
@@ -65,8 +68,7 @@ public:
 private:
   size_t numSteps = 0;
   double variance = 0.0, Mk = 0.0, MkPrevious = 0.0, Sk = 0.0, SkPrevious = 0.0;
-  const double alpha = 1.0;   // make parameter if it doesn't work well
-  const double stopFactor = (alpha / 2.0) - 0.25;
+  const double stopFactor;
   double beta;
 };
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "mt-kahypar/partition/refinement/fm/fm_commons.h"
+#include "gain_cache_strategy.h"
+
+namespace mt_kahypar {
+
+  /*!
+   * Uses a gain cache that is initialized lazily: at the beginning of each level, only
+   * the entries of border nodes and their neighbors are computed. The entry of every other
+   * node is computed when it is inserted into a PQ for the first time. In contrast to
+   * GainCacheOnDemandStrategy, an initialized entry is kept up-to-date by delta updates
+   * and reused in all subsequent rounds. Since an entry initialized during a round may miss
+   * (or count twice) concurrent moves of neighbors, these entries are recomputed after the round.
+   */
+  class GainCacheLazyStrategy : public GainCacheStrategy {
+  public:
+
+    static constexpr bool initializes_gain_cache_lazily = true;
+
+    GainCacheLazyStrategy(const Context& context,
+                          FMSharedData& sharedData,
+                          FMStats& runStats) :
+            GainCacheStrategy(context, sharedData, runStats),
+            gainCacheInitMem(context.partition.k, 0),
+            initializedNodes()
+    { }
+
+    template<typename PHG>
+    MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
+    void insertIntoPQ(PHG& phg, const HypernodeID v, const SearchID previous_search_of_v) {
+      if (phg.initializeGainCacheEntryIfInvalid(v, gainCacheInitMem)) {
+        initializedNodes.push_back(v);
+      }
+      GainCacheStrategy::insertIntoPQ(phg, v, previous_search_of_v);
+    }
+
+    // ! Recomputes all entries initialized during the last round.
+    // ! Must not run concurrently to moves.
+    void recomputeInitializedGainCacheEntries(PartitionedHypergraph& phg) {
+      for ( const HypernodeID& v : initializedNodes ) {
+        phg.initializeGainCacheEntry(v, gainCacheInitMem);
+      }
+      initializedNodes.clear();
+    }
+
+    void changeNumberOfBlocks(const PartitionID new_k) {
+      if ( static_cast<size_t>(new_k) > gainCacheInitMem.size() ) {
+        gainCacheInitMem.assign(new_k, 0);
+      }
+      GainCacheStrategy::changeNumberOfBlocks(new_k);
+    }
+
+    void memoryConsumption(utils::MemoryTreeNode *parent) const {
+      GainCacheStrategy::memoryConsumption(parent);
+      parent->addChild("Initial Gain Comp", gainCacheInitMem.size() * sizeof(Gain) +
+        initializedNodes.capacity() * sizeof(HypernodeID));
+    }
+
+  private:
+    vec<Gain> gainCacheInitMem;
+
+    // ! Nodes whose gain cache entries were initialized during the current round
+    vec<HypernodeID> initializedNodes;
+  };
+
+
+}
@@ -63,7 +63,8 @@ namespace mt_kahypar {
         pq.setHandle(sharedData.vertexPQHandles.data(), sharedData.numberOfNodes);
       }
       while ( static_cast<size_t>(new_k) > vertexPQs.size() ) {
-        vertexPQs.emplace_back(sharedData.vertexPQHandles.data(), sharedData.numberOfNodes);
+        vertexPQs.emplace_back(sharedData.vertexPQHandles.data(),
+          sharedData.numberOfNodes, sharedData.vertexPQMaxKey);
       }
     }
 
@@ -34,12 +34,15 @@ namespace mt_kahypar {
   /*
    * FMStrategy interface
    * static constexpr bool uses_gain_cache
+   * static constexpr bool maintain_gain_cache_between_rounds
+   * static constexpr bool initializes_gain_cache_lazily
    * Constructor(context, numNodes, sharedData, runStats)
    * insertIntoPQ(phg, node)
    * updateGain(phg, node, move)
    * findNextMove(phg, move)
    * clearPQs()
    * updatePQs()
+   * setVertexPQMaxKey(max_key)
    * memoryConsumption(utils::MemoryTreeNode* parent) const
    *
    *
@@ -49,10 +52,11 @@ class GainCacheStrategy {
 public:
 
   using BlockPriorityQueue = ds::ExclusiveHandleHeap< ds::MaxHeap<Gain, PartitionID> >;
-  using VertexPriorityQueue = ds::MaxHeap<Gain, HypernodeID>;    // these need external handles
+  using VertexPriorityQueue = ds::AdaptiveMaxPQ<Gain, HypernodeID>;    // these need external handles
 
   static constexpr bool uses_gain_cache = true;
   static constexpr bool maintain_gain_cache_between_rounds = true;
+  static constexpr bool initializes_gain_cache_lazily = false;
 
   GainCacheStrategy(const Context& context,
                     FMSharedData& sharedData,
@@ -62,7 +66,8 @@ public:
       sharedData(sharedData),
       blockPQ(static_cast<size_t>(context.partition.k)),
       vertexPQs(static_cast<size_t>(context.partition.k),
-        VertexPriorityQueue(sharedData.vertexPQHandles.data(), sharedData.numberOfNodes)) { }
+        VertexPriorityQueue(sharedData.vertexPQHandles.data(), sharedData.numberOfNodes,
+                            sharedData.vertexPQMaxKey)) { }
 
   template<typename PHG>
   MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE
@@ -171,7 +176,14 @@ public:
       pq.setHandle(sharedData.vertexPQHandles.data(), sharedData.numberOfNodes);
     }
     while ( static_cast<size_t>(new_k) > vertexPQs.size() ) {
-      vertexPQs.emplace_back(sharedData.vertexPQHandles.data(), sharedData.numberOfNodes);
+      vertexPQs.emplace_back(sharedData.vertexPQHandles.data(),
+        sharedData.numberOfNodes, sharedData.vertexPQMaxKey);
+    }
+  }
+
+  void setVertexPQMaxKey(const Gain max_key) {
+    for ( VertexPriorityQueue& pq : vertexPQs ) {
+      pq.setMaxKey(max_key);
     }
   }
 
@@ -207,10 +219,9 @@ private:
     PartitionID to = kInvalidPartition;
     HyperedgeWeight to_benefit = std::numeric_limits<HyperedgeWeight>::min();
     HypernodeWeight best_to_weight = from_weight - wu;
-    for (PartitionID i = 0; i < context.partition.k; ++i) {
+    auto consider_block = [&](const PartitionID i, const HyperedgeWeight penalty) {
       if (i != from) {
         const HypernodeWeight to_weight = phg.partWeight(i);
-        const HyperedgeWeight penalty = phg.moveToBenefit(u, i);
         if ( ( penalty > to_benefit || ( penalty == to_benefit && to_weight < best_to_weight ) ) &&
              to_weight + wu <= context.partition.max_part_weights[i] ) {
           to_benefit = penalty;
@@ -218,6 +229,19 @@ private:
           best_to_weight = to_weight;
         }
       }
+    };
+
+    bool visited_all_non_zero_benefit_terms = false;
+    if constexpr ( PHG::supports_sparse_gain_cache ) {
+      // For large k, the gain cache only stores the benefit terms of adjacent blocks.
+      // We only have to look at all blocks if none of them is a feasible target with
+      // a positive benefit term, since all other blocks have a benefit term of zero.
+      visited_all_non_zero_benefit_terms = phg.doForAllSparseBenefitTerms(u, consider_block);
+    }
+    if ( !visited_all_non_zero_benefit_terms || to_benefit <= 0 ) {
+      for (PartitionID i = 0; i < context.partition.k; ++i) {
+        consider_block(i, phg.moveToBenefit(u, i));
+      }
     }
     const Gain gain = to != kInvalidPartition ? to_benefit - phg.moveFromPenalty(u)
                                               : std::numeric_limits<HyperedgeWeight>::min();
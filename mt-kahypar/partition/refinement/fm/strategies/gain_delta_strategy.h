@@ -34,10 +34,11 @@ namespace mt_kahypar {
   class GainDeltaStrategy {
   public:
 
-    using VertexPriorityQueue = ds::MaxHeap<Gain, HypernodeID>;
+    using VertexPriorityQueue = ds::AdaptiveMaxPQ<Gain, HypernodeID>;
 
     static constexpr bool uses_gain_cache = false;
     static constexpr bool maintain_gain_cache_between_rounds = false;
+    static constexpr bool initializes_gain_cache_lazily = false;
 
     GainDeltaStrategy(const Context& context,
                           FMSharedData& sharedData,
@@ -51,7 +52,7 @@ namespace mt_kahypar {
       for (PartitionID i = 0; i < context.partition.k; ++i) {
         vertexPQs.emplace_back(
           sharedData.vertexPQHandles.data() + (i * sharedData.numberOfNodes),
-          sharedData.numberOfNodes);
+          sharedData.numberOfNodes, sharedData.vertexPQMaxKey);
       }
     }
 
@@ -207,7 +208,13 @@ namespace mt_kahypar {
       for (PartitionID i = current_k; i < new_k; ++i) {
         vertexPQs.emplace_back(
           sharedData.vertexPQHandles.data() + (i * sharedData.numberOfNodes),
-          sharedData.numberOfNodes);
+          sharedData.numberOfNodes, sharedData.vertexPQMaxKey);
+      }
+    }
+
+    void setVertexPQMaxKey(const Gain max_key) {
+      for ( VertexPriorityQueue& pq : vertexPQs ) {
+        pq.setMaxKey(max_key);
       }
     }
 
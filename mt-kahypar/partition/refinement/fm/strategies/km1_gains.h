@@ -48,15 +48,21 @@ struct Km1GainComputer {
     assert(std::all_of(gains.begin(), gains.end(), [](const Gain& g) { return g == 0; }));
     const PartitionID from = phg.partID(u);
     Gain internal_weight = 0;   // weight that will not be removed from the objective
-    for (HyperedgeID e : phg.incidentEdges(u)) {
+    phg.forEachIncidentEdgeWithPrefetching(u, [&](const HyperedgeID e) {
       HyperedgeWeight edge_weight = phg.edgeWeight(e);
       if (phg.pinCountInPart(e, from) > 1) {
         internal_weight += edge_weight;
       }
 
       if constexpr (PHG::supports_connectivity_set) {
-        for (PartitionID i : phg.connectivitySet(e)) {
-          gains[i] += edge_weight;
+        if constexpr (PHG::is_graph) {
+          for (PartitionID i : phg.connectivitySet(e)) {
+            gains[i] += edge_weight;
+          }
+        } else {
+          // For k <= 64, the edge weight is added to all blocks with a masked
+          // addition over the connectivity bitset (vectorized by the compiler)
+          phg.aggregateBenefit(e, edge_weight, gains);
         }
       } else {
         // case for deltaPhg since maintaining connectivity sets is too slow
@@ -66,7 +72,7 @@ struct Km1GainComputer {
           }
         }
       }
-    }
+    });
     return internal_weight;
   }
 
@@ -103,10 +109,25 @@ struct Km1GainComputer {
     return std::make_pair(best_target, best_gain);
   }
 
-  std::pair<PartitionID, HyperedgeWeight> computeBestTargetBlockIgnoringBalance(const PartitionedHypergraph& phg,
+  template<typename PHG>
+  std::pair<PartitionID, HyperedgeWeight> computeBestTargetBlockIgnoringBalance(const PHG& phg,
                                                                                 const HypernodeID u) {
     const PartitionID from = phg.partID(u);
-    const Gain internal_weight = computeGainsPlusInternalWeight(phg, u);
+    Gain internal_weight = 0;
+    if constexpr ( PHG::is_graph ) {
+      // On graphs, we sum up the edge weights by neighbor block in a tight
+      // loop over the adjacency array instead of computing connectivity sets
+      phg.forEachIncidentEdgeWithPrefetching(u, [&](const HyperedgeID e) {
+        if (!phg.isSinglePin(e)) {
+          const PartitionID to = phg.partID(phg.edgeTarget(e));
+          const HyperedgeWeight edge_weight = phg.edgeWeight(e);
+          gains[to] += edge_weight;
+          internal_weight += to == from ? edge_weight : 0;
+        }
+      });
+    } else {
+      internal_weight = computeGainsPlusInternalWeight(phg, u);
+    }
     PartitionID best_target = kInvalidPartition;
     Gain best_gain = std::numeric_limits<Gain>::min();
     for (PartitionID target = 0; target < context.partition.k; ++target) {
@@ -125,14 +146,24 @@ struct Km1GainComputer {
 };
 
 struct TwoWayGainComputer {
-  static Gain gainToOtherBlock(const PartitionedHypergraph& phg, const HypernodeID u) {
+  template<typename PHG>
+  static Gain gainToOtherBlock(const PHG& phg, const HypernodeID u) {
     Gain gain = 0;
     const PartitionID from = phg.partID(u);
-    for (HyperedgeID e : phg.incidentEdges(u)) {
-      const auto pcip = phg.pinCountInPart(e, from);
-      const auto weight = phg.edgeWeight(e);
-      if (pcip == 1) { gain += weight; }
-      else if (pcip == phg.edgeSize(e)) { gain -= weight; }
+    if constexpr ( PHG::is_graph ) {
+      for (HyperedgeID e : phg.incidentEdges(u)) {
+        if (!phg.isSinglePin(e)) {
+          const auto weight = phg.edgeWeight(e);
+          gain += phg.partID(phg.edgeTarget(e)) == from ? -weight : weight;
+        }
+      }
+    } else {
+      for (HyperedgeID e : phg.incidentEdges(u)) {
+        const auto pcip = phg.pinCountInPart(e, from);
+        const auto weight = phg.edgeWeight(e);
+        if (pcip == 1) { gain += weight; }
+        else if (pcip == phg.edgeSize(e)) { gain -= weight; }
+      }
     }
     return gain;
   }
@@ -35,10 +35,11 @@ namespace mt_kahypar {
   class RecomputeGainStrategy {
   public:
 
-    using VertexPriorityQueue = ds::MaxHeap<Gain, HypernodeID>;
+    using VertexPriorityQueue = ds::AdaptiveMaxPQ<Gain, HypernodeID>;
 
     static constexpr bool uses_gain_cache = false;
     static constexpr bool maintain_gain_cache_between_rounds = false;
+    static constexpr bool initializes_gain_cache_lazily = false;
 
     RecomputeGainStrategy(const Context& context,
                       FMSharedData& sharedData,
@@ -46,7 +47,8 @@ namespace mt_kahypar {
       context(context),
       runStats(runStats),
       sharedData(sharedData),
-      pq(VertexPriorityQueue(sharedData.vertexPQHandles.data(), sharedData.numberOfNodes)),
+      pq(VertexPriorityQueue(sharedData.vertexPQHandles.data(),
+        sharedData.numberOfNodes, sharedData.vertexPQMaxKey)),
       gc(context) { }
 
     template<typename PHG>
@@ -110,6 +112,10 @@ namespace mt_kahypar {
       pq.setHandle(sharedData.vertexPQHandles.data(), sharedData.numberOfNodes);
     }
 
+    void setVertexPQMaxKey(const Gain max_key) {
+      pq.setMaxKey(max_key);
+    }
+
     void memoryConsumption(utils::MemoryTreeNode *parent) const {
       parent->addChild("PQs", pq.size_in_bytes());
       parent->addChild("Initial Gain Comp", gc.gains.size() * sizeof(Gain));
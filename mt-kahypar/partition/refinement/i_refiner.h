@@ -58,6 +58,12 @@ class IRefiner {
     return refineImpl(hypergraph, refinement_nodes, best_metrics, time_limit);
   }
 
+  // ! Returns the vertices moved by the last call to refine(...). Refiners that
+  // ! do not track their moves return an empty set.
+  const parallel::scalable_vector<HypernodeID>& movedNodes() const {
+    return movedNodesImpl();
+  }
+
  protected:
   IRefiner() = default;
 
@@ -68,6 +74,11 @@ class IRefiner {
                           const parallel::scalable_vector<HypernodeID>& refinement_nodes,
                           Metrics& best_metrics,
                           const double time_limit) = 0;
+
+  virtual const parallel::scalable_vector<HypernodeID>& movedNodesImpl() const {
+    static const parallel::scalable_vector<HypernodeID> no_moved_nodes;
+    return no_moved_nodes;
+  }
 };
 
 }  // namespace mt_kahypar
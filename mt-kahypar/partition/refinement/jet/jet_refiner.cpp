@@ -0,0 +1,266 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "mt-kahypar/partition/refinement/jet/jet_refiner.h"
+
+#include <cmath>
+
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_reduce.h"
+
+#include "mt-kahypar/partition/metrics.h"
+#include "mt-kahypar/partition/refinement/rebalancing/rebalancer.h"
+#include "mt-kahypar/utils/utilities.h"
+
+namespace mt_kahypar {
+
+  bool JetRefiner::refineImpl(PartitionedHypergraph& phg,
+                              const vec<HypernodeID>& refinement_nodes,
+                              Metrics& best_metrics,
+                              const double) {
+    // Vertices moved in the last round of the previous call are not locked
+    ++_round;
+
+    Metrics current_metrics = best_metrics;
+    bool best_is_balanced = metrics::isBalanced(phg, _context);
+    bool current_is_best = true;
+    Gain overall_improvement = 0;
+    size_t rounds_without_improvement = 0;
+    const size_t max_rounds_without_improvement =
+      std::max(_context.refinement.fm.multitry_rounds, UL(1));
+    while ( rounds_without_improvement < max_rounds_without_improvement ) {
+      ++_round;
+
+      // Phase 1: Compute move candidates (ignoring the balance constraint)
+      computeMoveCandidates(phg, refinement_nodes);
+      if ( _candidates.size() == 0 ) {
+        break;
+      }
+
+      if ( current_is_best ) {
+        storeCurrentPartition(phg);
+      }
+
+      // Phase 2: Filter candidates that are harmful in combination with other moves
+      afterburner(phg);
+
+      // Phase 3: Apply remaining moves and restore the balance constraint
+      const Gain round_improvement = applyMoves(phg);
+      current_metrics.km1 -= round_improvement;
+      if ( !metrics::isBalanced(phg, _context) ) {
+        Km1Rebalancer rebalancer(phg, _context);
+        rebalancer.rebalance(current_metrics);
+      }
+      current_metrics.imbalance = metrics::imbalance(phg, _context);
+      HEAVY_REFINEMENT_ASSERT(current_metrics.km1 == metrics::km1(phg),
+        V(current_metrics.km1) << V(metrics::km1(phg)));
+
+      const bool is_balanced = metrics::isBalanced(phg, _context);
+      if ( is_balanced && ( current_metrics.km1 < best_metrics.km1 || !best_is_balanced ) ) {
+        overall_improvement += best_metrics.km1 - current_metrics.km1;
+        best_metrics = current_metrics;
+        best_is_balanced = true;
+        current_is_best = true;
+        rounds_without_improvement = 0;
+      } else {
+        current_is_best = false;
+        ++rounds_without_improvement;
+      }
+      DBG << "Jet round" << _round << ":" << V(_candidates.size()) << V(round_improvement)
+          << V(current_metrics.km1) << V(current_metrics.imbalance) << V(best_metrics.km1);
+    }
+
+    if ( !current_is_best ) {
+      const Gain revert_improvement = revertToBestPartition(phg);
+      unused(revert_improvement);
+      ASSERT(current_metrics.km1 - revert_improvement == best_metrics.km1,
+        V(current_metrics.km1) << V(revert_improvement) << V(best_metrics.km1));
+      HEAVY_REFINEMENT_ASSERT(best_metrics.km1 == metrics::km1(phg),
+        V(best_metrics.km1) << V(metrics::km1(phg)));
+    }
+    best_metrics.imbalance = metrics::imbalance(phg, _context);
+
+    utils::Utilities::instance().getStats(_context.utility_id).update_stat("jet_improvement", overall_improvement);
+    return overall_improvement > 0;
+  }
+
+  void JetRefiner::computeMoveCandidates(const PartitionedHypergraph& phg,
+                                         const vec<HypernodeID>& refinement_nodes) {
+    _candidates.clear();
+    if ( refinement_nodes.empty() ) {
+      phg.doParallelForAllNodes([&](const HypernodeID u) {
+        computeMoveCandidate(phg, u);
+      });
+    } else {
+      tbb::parallel_for(UL(0), refinement_nodes.size(), [&](const size_t i) {
+        computeMoveCandidate(phg, refinement_nodes[i]);
+      });
+    }
+    _candidates.finalize();
+  }
+
+  void JetRefiner::computeMoveCandidate(const PartitionedHypergraph& phg, const HypernodeID u) {
+    if ( !phg.isBorderNode(u) || isLocked(u) || phg.isFixed(u) ) {
+      return;
+    }
+
+    Km1GainComputer& gain_computer = _gain_computer.local();
+    const PartitionID from = phg.partID(u);
+    const Gain internal_weight = gain_computer.computeGainsPlusInternalWeight(phg, u);
+    PartitionID best_target = kInvalidPartition;
+    Gain best_benefit = std::numeric_limits<Gain>::min();
+    for ( PartitionID to = 0; to < _context.partition.k; ++to ) {
+      if ( to != from && gain_computer.gains[to] > best_benefit ) {
+        best_benefit = gain_computer.gains[to];
+        best_target = to;
+      }
+      gain_computer.gains[to] = 0;
+    }
+
+    const Gain gain = best_benefit - internal_weight;
+    if ( best_target != kInvalidPartition &&
+         ( gain >= 0 || -gain < std::floor(
+            _context.refinement.fm.jet_negative_gain_factor * internal_weight) ) ) {
+      _target[u] = best_target;
+      _gain[u] = gain;
+      _candidates.push_back_buffered(u);
+    }
+  }
+
+  void JetRefiner::afterburner(const PartitionedHypergraph& phg) {
+    tbb::parallel_for(UL(0), _candidates.size(), [&](const size_t i) {
+      const HypernodeID u = _candidates[i];
+      const PartitionID from = phg.partID(u);
+      const PartitionID to = _target[u];
+      Gain gain = 0;
+      for ( const HyperedgeID& he : phg.incidentEdges(u) ) {
+        HypernodeID pin_count_in_from_part = phg.pinCountInPart(he, from);
+        HypernodeID pin_count_in_to_part = phg.pinCountInPart(he, to);
+        if ( phg.edgeSize(he) <= MAX_AFTERBURNER_EDGE_SIZE ) {
+          // Apply the moves of all candidates with a higher priority
+          for ( const HypernodeID& pin : phg.pins(he) ) {
+            const PartitionID target_of_pin = _target[pin];
+            if ( pin != u && target_of_pin != kInvalidPartition && hasHigherPriority(pin, u) ) {
+              const PartitionID block_of_pin = phg.partID(pin);
+              pin_count_in_from_part -= ( block_of_pin == from );
+              pin_count_in_from_part += ( target_of_pin == from );
+              pin_count_in_to_part -= ( block_of_pin == to );
+              pin_count_in_to_part += ( target_of_pin == to );
+            }
+          }
+        }
+
+        const HyperedgeWeight edge_weight = phg.edgeWeight(he);
+        if ( pin_count_in_from_part == 1 ) {
+          gain += edge_weight;
+        }
+        if ( pin_count_in_to_part == 0 ) {
+          gain -= edge_weight;
+        }
+      }
+      _afterburner_gain[i] = gain;
+    });
+  }
+
+  Gain JetRefiner::applyMoves(PartitionedHypergraph& phg) {
+    const bool update_gain_cache = _context.forceGainCacheUpdates() && phg.isGainCacheInitialized();
+    const Gain improvement = tbb::parallel_reduce(
+      tbb::blocked_range<size_t>(UL(0), _candidates.size()), 0,
+      [&](const tbb::blocked_range<size_t>& range, Gain local_improvement) {
+        auto objective_delta = [&](const HyperedgeID he,
+                                   const HyperedgeWeight edge_weight,
+                                   const HypernodeID edge_size,
+                                   const HypernodeID pin_count_in_from_part_after,
+                                   const HypernodeID pin_count_in_to_part_after) {
+          local_improvement -= km1Delta(he, edge_weight, edge_size,
+            pin_count_in_from_part_after, pin_count_in_to_part_after);
+        };
+        for ( size_t i = range.begin(); i < range.end(); ++i ) {
+          if ( _afterburner_gain[i] >= 0 ) {
+            const HypernodeID u = _candidates[i];
+            const PartitionID from = phg.partID(u);
+            const PartitionID to = _target[u];
+            if ( update_gain_cache ) {
+              phg.changeNodePartWithGainCacheUpdate(u, from, to,
+                std::numeric_limits<HypernodeWeight>::max(), [] { }, objective_delta);
+            } else {
+              phg.changeNodePart(u, from, to, objective_delta);
+            }
+            _moved_in_round[u] = _round;
+          }
+        }
+        return local_improvement;
+      }, std::plus<Gain>());
+
+    tbb::parallel_for(UL(0), _candidates.size(), [&](const size_t i) {
+      const HypernodeID u = _candidates[i];
+      if ( update_gain_cache && _afterburner_gain[i] >= 0 ) {
+        phg.recomputeMoveFromPenalty(u);
+      }
+      _target[u] = kInvalidPartition;
+    });
+    return improvement;
+  }
+
+  void JetRefiner::storeCurrentPartition(const PartitionedHypergraph& phg) {
+    phg.doParallelForAllNodes([&](const HypernodeID u) {
+      _best_partition[u] = phg.partID(u);
+    });
+  }
+
+  Gain JetRefiner::revertToBestPartition(PartitionedHypergraph& phg) {
+    const bool update_gain_cache = _context.forceGainCacheUpdates() && phg.isGainCacheInitialized();
+    tbb::enumerable_thread_specific<Gain> ets_improvement(0);
+    auto objective_delta = [&](const HyperedgeID he,
+                               const HyperedgeWeight edge_weight,
+                               const HypernodeID edge_size,
+                               const HypernodeID pin_count_in_from_part_after,
+                               const HypernodeID pin_count_in_to_part_after) {
+      ets_improvement.local() -= km1Delta(he, edge_weight, edge_size,
+        pin_count_in_from_part_after, pin_count_in_to_part_after);
+    };
+    phg.doParallelForAllNodes([&](const HypernodeID u) {
+      const PartitionID from = phg.partID(u);
+      const PartitionID to = _best_partition[u];
+      if ( from != to ) {
+        if ( update_gain_cache ) {
+          phg.changeNodePartWithGainCacheUpdate(u, from, to,
+            std::numeric_limits<HypernodeWeight>::max(), [] { }, objective_delta);
+        } else {
+          phg.changeNodePart(u, from, to, objective_delta);
+        }
+      }
+    });
+
+    if ( update_gain_cache ) {
+      phg.doParallelForAllNodes([&](const HypernodeID u) {
+        phg.recomputeMoveFromPenalty(u);
+      });
+    }
+    return ets_improvement.combine(std::plus<Gain>());
+  }
+
+}  // namespace mt_kahypar
@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include "tbb/enumerable_thread_specific.h"
+
+#include "mt-kahypar/datastructures/buffered_vector.h"
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/refinement/i_refiner.h"
+#include "mt-kahypar/partition/refinement/fm/strategies/km1_gains.h"
+
+namespace mt_kahypar {
+
+/*!
+ * Unconstrained parallel refinement in the style of Jet (Gilbert et al.).
+ * Each round consists of three phases:
+ *  1) For each unlocked border vertex, we compute its best target block ignoring
+ *     the balance constraint. Vertices with a positive or only slightly negative
+ *     gain become move candidates (gain >= -negative_gain_factor * weight of the
+ *     nets that connect the vertex to its own block).
+ *  2) Afterburner: The gain of each candidate is recomputed under the assumption
+ *     that all candidates with a higher priority (higher gain, ties broken by ID)
+ *     are moved before. Only candidates with a non-negative recomputed gain remain.
+ *  3) All remaining moves are applied in parallel and the partition is rebalanced.
+ * Vertices moved in a round are locked in the next round to prevent oscillation.
+ * Since a round can worsen the solution, we keep the best balanced partition and
+ * revert to it at the end.
+ */
+class JetRefiner final : public IRefiner {
+
+  static constexpr bool debug = false;
+  static constexpr bool enable_heavy_assert = false;
+
+  // ! Nets larger than this threshold are not considered by the afterburner
+  // ! (the gain of a candidate is computed w.r.t. the current pin counts instead)
+  static constexpr HypernodeID MAX_AFTERBURNER_EDGE_SIZE = 1000;
+
+ public:
+  explicit JetRefiner(Hypergraph& hypergraph,
+                      const Context& context) :
+    _context(context),
+    _gain_computer(context),
+    _candidates(hypergraph.initialNumNodes()),
+    _target(hypergraph.initialNumNodes(), kInvalidPartition),
+    _gain(hypergraph.initialNumNodes(), 0),
+    _afterburner_gain(hypergraph.initialNumNodes(), 0),
+    _moved_in_round(hypergraph.initialNumNodes(), 0),
+    _best_partition(hypergraph.initialNumNodes(), kInvalidPartition),
+    _round(1) { }
+
+  JetRefiner(const JetRefiner&) = delete;
+  JetRefiner(JetRefiner&&) = delete;
+
+  JetRefiner & operator= (const JetRefiner &) = delete;
+  JetRefiner & operator= (JetRefiner &&) = delete;
+
+ private:
+  bool refineImpl(PartitionedHypergraph& phg,
+                  const vec<HypernodeID>& refinement_nodes,
+                  Metrics& best_metrics,
+                  double) final;
+
+  void initializeImpl(PartitionedHypergraph&) final { /* nothing to do */ }
+
+  void computeMoveCandidates(const PartitionedHypergraph& phg,
+                             const vec<HypernodeID>& refinement_nodes);
+
+  void computeMoveCandidate(const PartitionedHypergraph& phg, const HypernodeID u);
+
+  void afterburner(const PartitionedHypergraph& phg);
+
+  // ! Applies all moves that survived the afterburner and
+  // ! returns the improvement of the objective function
+  Gain applyMoves(PartitionedHypergraph& phg);
+
+  void storeCurrentPartition(const PartitionedHypergraph& phg);
+
+  // ! Reverts the partition to the stored best partition and
+  // ! returns the improvement of the objective function
+  Gain revertToBestPartition(PartitionedHypergraph& phg);
+
+  bool isLocked(const HypernodeID u) const {
+    return _moved_in_round[u] != 0 && _moved_in_round[u] + 1 == _round;
+  }
+
+  // ! Returns true, if candidate u is moved before candidate v in the afterburner
+  bool hasHigherPriority(const HypernodeID u, const HypernodeID v) const {
+    return _gain[u] > _gain[v] || ( _gain[u] == _gain[v] && u < v );
+  }
+
+  const Context& _context;
+  tbb::enumerable_thread_specific<Km1GainComputer> _gain_computer;
+  ds::BufferedVector<HypernodeID> _candidates;
+  // ! Target block of a move candidate (kInvalidPartition, if the vertex is no candidate)
+  vec<PartitionID> _target;
+  vec<Gain> _gain;
+  // ! Recomputed gain of the i-th candidate
+  vec<Gain> _afterburner_gain;
+  vec<uint32_t> _moved_in_round;
+  vec<PartitionID> _best_partition;
+  uint32_t _round;
+};
+
+}  // namespace mt_kahypar
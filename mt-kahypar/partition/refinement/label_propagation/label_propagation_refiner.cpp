@@ -28,7 +28,9 @@
 #include "mt-kahypar/partition/refinement/label_propagation/label_propagation_refiner.h"
 
 #include "tbb/parallel_for.h"
+#include "tbb/parallel_for_each.h"
 
+#include "mt-kahypar/parallel/parallel_counting_sort.h"
 #include "mt-kahypar/partition/metrics.h"
 #include "mt-kahypar/utils/randomize.h"
 #include "mt-kahypar/utils/utilities.h"
@@ -46,12 +48,18 @@ namespace mt_kahypar {
     hypergraph.resetMoveState();
     _gain.reset();
     _next_active.reset();
+    _was_moved.reset();
+    _moved_nodes.clear();
 
     // Initialize set of active vertices
     initializeActiveNodes(hypergraph, refinement_nodes);
 
     // Perform Label Propagation
     labelPropagation(hypergraph);
+    if ( _context.refinement.fuse_lp_and_fm ) {
+      _moved_nodes = _moved_nodes_stream.copy_parallel();
+      _moved_nodes_stream.clear_parallel();
+    }
 
     // Update global part weight and sizes
     best_metrics.imbalance = metrics::imbalance(hypergraph, _context);
@@ -86,15 +94,26 @@ namespace mt_kahypar {
         labelPropagationRound(hypergraph, next_active_nodes);
       }
 
+      // Similar to direction-optimizing BFS, a small frontier is kept as a sparse list, whereas
+      // a large frontier is collected from the activation bitmap such that the next round
+      // visits the nodes (almost) in ID order.
+      const size_t num_next_active = next_active_nodes.size();
+      _dense_frontier = !_context.refinement.label_propagation.execute_sequential &&
+        num_next_active > _context.refinement.label_propagation.dense_frontier_threshold *
+          hypergraph.initialNumNodes();
       if ( _context.refinement.label_propagation.execute_sequential ) {
         _active_nodes = next_active_nodes.copy_sequential();
         next_active_nodes.clear_sequential();
+      } else if ( _dense_frontier ) {
+        collectDenseFrontier(hypergraph);
+        ASSERT(_active_nodes.size() == num_next_active);
+        next_active_nodes.clear_parallel();
       } else {
         _active_nodes = next_active_nodes.copy_parallel();
         next_active_nodes.clear_parallel();
       }
 
-      if ( _active_nodes.size() == 0 ) {
+      if ( _active_nodes.size() == 0 || _context.isCancelled() ) {
         break;
       }
     }
@@ -132,17 +151,45 @@ namespace mt_kahypar {
         }
       }
     } else {
-      utils::Randomize::instance().parallelShuffleVector(
-              _active_nodes, UL(0), _active_nodes.size());
-
-      tbb::parallel_for(UL(0), _active_nodes.size(), [&](const size_t& j) {
+      auto process_active_node = [&](const size_t j) {
         const HypernodeID hn = _active_nodes[j];
-        if ( moveVertex(hypergraph, hn, next_active_nodes, objective_delta) ) {
+        if ( deferMove(hypergraph, hn) ) {
+          _deferred_moves.stream(j);
+        } else if ( moveVertex(hypergraph, hn, next_active_nodes, objective_delta) ) {
           _active_node_was_moved[j] = uint8_t(true);
         } else {
           converged = false;
         }
-      });
+      };
+
+      if ( _context.shared_memory.numa_aware_refinement &&
+           TBBInitializer::instance().has_numa_arenas() ) {
+        // Each NUMA node processes the active nodes of its node ID range with its own threads.
+        // Moves across the ranges are thread-safe, and high-degree vertices are still
+        // deferred to the end of the round, which is executed on all NUMA nodes.
+        const vec<uint32_t> domain_begins = groupActiveNodesByNumaNode(hypergraph);
+        for ( size_t node = 0; node + 1 < domain_begins.size(); ++node ) {
+          utils::Randomize::instance().parallelShuffleVector(
+            _active_nodes, domain_begins[node], domain_begins[node + 1]);
+        }
+        TBBInitializer::instance().execute_on_numa_nodes([&](const int node) {
+          tbb::parallel_for(size_t(domain_begins[node]),
+            size_t(domain_begins[node + 1]), process_active_node);
+        });
+      } else {
+        if ( _dense_frontier ) {
+          utils::Randomize::instance().parallelTiledShuffleVector(
+            _active_nodes, UL(0), _active_nodes.size(), DENSE_FRONTIER_TILE_SIZE);
+        } else {
+          utils::Randomize::instance().parallelShuffleVector(
+            _active_nodes, UL(0), _active_nodes.size());
+        }
+        tbb::parallel_for(UL(0), _active_nodes.size(), process_active_node);
+      }
+
+      if ( _deferred_moves.size() > 0 ) {
+        moveHighDegreeVertices(hypergraph, next_active_nodes);
+      }
     }
 
     if ( _context.forceGainCacheUpdates() && hypergraph.isGainCacheInitialized() ) {
@@ -166,6 +213,114 @@ namespace mt_kahypar {
     return converged;
   }
 
+  template <template <typename> class GainPolicy>
+  vec<uint32_t> LabelPropagationRefiner<GainPolicy>::groupActiveNodesByNumaNode(
+                                                      const PartitionedHypergraph& hypergraph) {
+    const std::vector<size_t> boundaries =
+      TBBInitializer::instance().numa_node_boundaries(hypergraph.initialNumNodes());
+    const size_t num_numa_nodes = boundaries.size() - 1;
+    auto numa_node_of = [&](const HypernodeID hn) {
+      return static_cast<size_t>(std::upper_bound(boundaries.begin() + 1,
+        boundaries.end() - 1, static_cast<size_t>(hn)) - ( boundaries.begin() + 1 ));
+    };
+    ActiveNodes grouped_active_nodes(_active_nodes.size());
+    vec<uint32_t> domain_begins = parallel::counting_sort(_active_nodes,
+      grouped_active_nodes, num_numa_nodes, numa_node_of, _context.shared_memory.num_threads);
+    _active_nodes = std::move(grouped_active_nodes);
+    ASSERT(domain_begins.size() == num_numa_nodes + 1);
+    return domain_begins;
+  }
+
+  template <template <typename> class GainPolicy>
+  void LabelPropagationRefiner<GainPolicy>::moveHighDegreeVertices(PartitionedHypergraph& hypergraph,
+                                                                   NextActiveNodes& next_active_nodes) {
+    auto objective_delta = [&](const HyperedgeID he,
+                               const HyperedgeWeight edge_weight,
+                               const HypernodeID edge_size,
+                               const HypernodeID pin_count_in_from_part_after,
+                               const HypernodeID pin_count_in_to_part_after) {
+      _gain.computeDeltaForHyperedge(he, edge_weight, edge_size,
+                                     pin_count_in_from_part_after, pin_count_in_to_part_after);
+    };
+
+    const parallel::scalable_vector<size_t> deferred_moves = _deferred_moves.copy_sequential();
+    _deferred_moves.clear_sequential();
+    for ( const size_t j : deferred_moves ) {
+      const HypernodeID hn = _active_nodes[j];
+      if ( !hypergraph.isBorderNode(hn) || hypergraph.isFixed(hn) ) {
+        continue;
+      }
+
+      const Move best_move = _gain.computeMaxGainMoveInParallel(hypergraph, hn);
+      if ( performMove(hypergraph, best_move) ) {
+        // No other vertex moves concurrently => the real gain of the move is the
+        // difference of the overall delta (summed over all threads) before and after
+        const Gain delta_before = _gain.delta();
+        if ( changeNodePartInParallel(hypergraph, hn, best_move.from, best_move.to, objective_delta) ) {
+          _active_node_was_moved[j] = uint8_t(true);
+          const Gain move_delta = _gain.delta() - delta_before;
+          if ( move_delta == best_move.gain || move_delta <= 0 ) {
+            auto incident_edges = hypergraph.incidentEdges(hn);
+            tbb::parallel_for_each(incident_edges.begin(), incident_edges.end(), [&](const HyperedgeID he) {
+              if ( hypergraph.edgeSize(he) <=
+                    ID(_context.refinement.label_propagation.hyperedge_size_activation_threshold) &&
+                   !_visited_he[he] ) {
+                for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+                  if ( _next_active.compare_and_set_to_true(pin) ) {
+                    next_active_nodes.stream(pin);
+                  }
+                }
+                _visited_he.set(he, true);
+              }
+            });
+            if ( _next_active.compare_and_set_to_true(hn) ) {
+              next_active_nodes.stream(hn);
+            }
+            if ( _context.refinement.fuse_lp_and_fm && _was_moved.compare_and_set_to_true(hn) ) {
+              _moved_nodes_stream.stream(hn);
+            }
+          } else {
+            changeNodePartInParallel(hypergraph, hn, best_move.to, best_move.from, objective_delta);
+          }
+        }
+      }
+    }
+  }
+
+  template <template <typename> class GainPolicy>
+  void LabelPropagationRefiner<GainPolicy>::collectDenseFrontier(const PartitionedHypergraph& hypergraph) {
+    // The activation flags of the last round are still set => scan them block-wise,
+    // compute the offset of each block and write the active nodes in ID order
+    const size_t num_nodes = hypergraph.initialNumNodes();
+    const size_t num_blocks = num_nodes / DENSE_FRONTIER_SCAN_BLOCK_SIZE +
+      ( num_nodes % DENSE_FRONTIER_SCAN_BLOCK_SIZE != 0 );
+    parallel::scalable_vector<size_t> block_offsets(num_blocks + 1, 0);
+    tbb::parallel_for(UL(0), num_blocks, [&](const size_t b) {
+      const size_t start = b * DENSE_FRONTIER_SCAN_BLOCK_SIZE;
+      const size_t end = std::min(start + DENSE_FRONTIER_SCAN_BLOCK_SIZE, num_nodes);
+      size_t num_active = 0;
+      for ( size_t hn = start; hn < end; ++hn ) {
+        num_active += _next_active[hn];
+      }
+      block_offsets[b + 1] = num_active;
+    });
+    for ( size_t b = 0; b < num_blocks; ++b ) {
+      block_offsets[b + 1] += block_offsets[b];
+    }
+
+    _active_nodes.resize(block_offsets[num_blocks]);
+    tbb::parallel_for(UL(0), num_blocks, [&](const size_t b) {
+      const size_t start = b * DENSE_FRONTIER_SCAN_BLOCK_SIZE;
+      const size_t end = std::min(start + DENSE_FRONTIER_SCAN_BLOCK_SIZE, num_nodes);
+      size_t pos = block_offsets[b];
+      for ( size_t hn = start; hn < end; ++hn ) {
+        if ( _next_active[hn] ) {
+          _active_nodes[pos++] = hn;
+        }
+      }
+    });
+  }
+
   template <template <typename> class GainPolicy>
   void LabelPropagationRefiner<GainPolicy>::initializeImpl(PartitionedHypergraph& hypergraph) {
     ActiveNodes tmp_active_nodes;
@@ -199,6 +354,7 @@ namespace mt_kahypar {
                               const parallel::scalable_vector<HypernodeID>& refinement_nodes) {
     ActiveNodes tmp_active_nodes;
     _active_nodes = std::move(tmp_active_nodes);
+    _dense_frontier = false;
 
     if ( refinement_nodes.empty() ) {
       if ( _context.refinement.label_propagation.execute_sequential ) {
@@ -47,6 +47,9 @@ class LabelPropagationRefiner final : public IRefiner {
 
   static constexpr bool debug = false;
   static constexpr bool enable_heavy_assert = false;
+  // ! Dense frontiers are only shuffled within tiles of this size
+  static constexpr size_t DENSE_FRONTIER_TILE_SIZE = 4096;
+  static constexpr size_t DENSE_FRONTIER_SCAN_BLOCK_SIZE = 16384;
 
  public:
   explicit LabelPropagationRefiner(Hypergraph& hypergraph,
@@ -57,9 +60,14 @@ class LabelPropagationRefiner final : public IRefiner {
     _current_num_edges(kInvalidHyperedge),
     _gain(context),
     _active_nodes(),
+    _dense_frontier(false),
     _active_node_was_moved(hypergraph.initialNumNodes(), uint8_t(false)),
     _next_active(hypergraph.initialNumNodes()),
-    _visited_he(hypergraph.initialNumEdges()) { }
+    _visited_he(hypergraph.initialNumEdges()),
+    _was_moved(context.refinement.fuse_lp_and_fm ? hypergraph.initialNumNodes() : 0),
+    _moved_nodes_stream(),
+    _moved_nodes(),
+    _deferred_moves() { }
 
   LabelPropagationRefiner(const LabelPropagationRefiner&) = delete;
   LabelPropagationRefiner(LabelPropagationRefiner&&) = delete;
@@ -75,8 +83,39 @@ class LabelPropagationRefiner final : public IRefiner {
 
   void labelPropagation(PartitionedHypergraph& hypergraph);
 
+  // ! Collects the active nodes of the next round from the activation bitmap in ID order
+  void collectDenseFrontier(const PartitionedHypergraph& hypergraph);
+
   bool labelPropagationRound(PartitionedHypergraph& hypergraph, NextActiveNodes& next_active_nodes);
 
+  // ! Moves the high-degree vertices deferred by the last round one after another. The gain
+  // ! of each vertex is computed and its incident hyperedges are updated with nested parallel
+  // ! loops (see defer_high_degree_moves)
+  void moveHighDegreeVertices(PartitionedHypergraph& hypergraph, NextActiveNodes& next_active_nodes);
+
+  // ! Groups the active nodes by the NUMA node of their node ID range
+  // ! (see TBBInitializer::numa_node_boundaries(...)) and returns the
+  // ! begin of each group (followed by the end of the last group)
+  vec<uint32_t> groupActiveNodesByNumaNode(const PartitionedHypergraph& hypergraph);
+
+  bool deferMove(const PartitionedHypergraph& hypergraph, const HypernodeID hn) const {
+    return _context.refinement.defer_high_degree_moves &&
+      hypergraph.nodeDegree(hn) > PartitionedHypergraph::HIGH_DEGREE_THRESHOLD;
+  }
+
+  // ! We perform a move if it either improves the solution quality or, in case of a
+  // ! zero gain move, the balance of the solution.
+  bool performMove(const PartitionedHypergraph& hypergraph, const Move& best_move) const {
+    const bool positive_gain = best_move.gain < 0;
+    const bool zero_gain_move = (_context.refinement.label_propagation.rebalancing &&
+                                  best_move.gain == 0 &&
+                                  hypergraph.partWeight(best_move.from) - 1 >
+                                  hypergraph.partWeight(best_move.to) + 1 &&
+                                  hypergraph.partWeight(best_move.to) <
+                                  _context.partition.perfect_balance_part_weights[best_move.to]);
+    return best_move.from != best_move.to && ( positive_gain || zero_gain_move );
+  }
+
   template<typename F>
   bool moveVertex(PartitionedHypergraph& hypergraph,
                   const HypernodeID hn,
@@ -84,21 +123,11 @@ class LabelPropagationRefiner final : public IRefiner {
                   const F& objective_delta) {
     bool is_moved = false;
     ASSERT(hn != kInvalidHypernode);
-    if ( hypergraph.isBorderNode(hn) ) {
+    if ( hypergraph.isBorderNode(hn) && !hypergraph.isFixed(hn) ) {
       ASSERT(hypergraph.nodeIsEnabled(hn));
 
       Move best_move = _gain.computeMaxGainMove(hypergraph, hn);
-      // We perform a move if it either improves the solution quality or, in case of a
-      // zero gain move, the balance of the solution.
-      const bool positive_gain = best_move.gain < 0;
-      const bool zero_gain_move = (_context.refinement.label_propagation.rebalancing &&
-                                    best_move.gain == 0 &&
-                                    hypergraph.partWeight(best_move.from) - 1 >
-                                    hypergraph.partWeight(best_move.to) + 1 &&
-                                    hypergraph.partWeight(best_move.to) <
-                                    _context.partition.perfect_balance_part_weights[best_move.to]);
-      const bool perform_move = positive_gain || zero_gain_move;
-      if (best_move.from != best_move.to && perform_move) {
+      if (performMove(hypergraph, best_move)) {
         PartitionID from = best_move.from;
         PartitionID to = best_move.to;
 
@@ -132,6 +161,9 @@ class LabelPropagationRefiner final : public IRefiner {
             if ( _next_active.compare_and_set_to_true(hn) ) {
               next_active_nodes.stream(hn);
             }
+            if ( _context.refinement.fuse_lp_and_fm && _was_moved.compare_and_set_to_true(hn) ) {
+              _moved_nodes_stream.stream(hn);
+            }
           } else {
             DBG << "Revert move of hypernode" << hn << "from block" << from << "to block" << to
                 << "( Expected Gain:" << best_move.gain << ", Real Gain:" << move_delta << ")";
@@ -152,6 +184,10 @@ class LabelPropagationRefiner final : public IRefiner {
 
   void initializeImpl(PartitionedHypergraph&) final;
 
+  const parallel::scalable_vector<HypernodeID>& movedNodesImpl() const final {
+    return _moved_nodes;
+  }
+
   template<typename F>
   bool changeNodePart(PartitionedHypergraph& phg,
                       const HypernodeID hn,
@@ -169,6 +205,23 @@ class LabelPropagationRefiner final : public IRefiner {
     return success;
   }
 
+  template<typename F>
+  bool changeNodePartInParallel(PartitionedHypergraph& phg,
+                                const HypernodeID hn,
+                                const PartitionID from,
+                                const PartitionID to,
+                                const F& objective_delta) {
+    bool success = false;
+    if ( _context.forceGainCacheUpdates() && phg.isGainCacheInitialized() ) {
+      success = phg.changeNodePartWithGainCacheUpdateInParallel(hn, from, to,
+        _context.partition.max_part_weights[to], [] { }, objective_delta);
+    } else {
+      success = phg.changeNodePartInParallel(hn, from, to,
+        _context.partition.max_part_weights[to], []{}, objective_delta);
+    }
+    return success;
+  }
+
   void resizeDataStructuresForCurrentK() {
     // If the number of blocks changes, we resize data structures
     // (can happen during deep multilevel partitioning)
@@ -184,9 +237,18 @@ class LabelPropagationRefiner final : public IRefiner {
   HyperedgeID _current_num_edges;
   GainCalculator _gain;
   ActiveNodes _active_nodes;
+  // ! True, if the active nodes are sorted by ID (see collectDenseFrontier(...))
+  bool _dense_frontier;
   parallel::scalable_vector<uint8_t> _active_node_was_moved;
   ds::ThreadSafeFastResetFlagArray<> _next_active;
   kahypar::ds::FastResetFlagArray<> _visited_he;
+  // ! Vertices moved by the last call to refine(...) (only tracked if LP and FM are fused)
+  ds::ThreadSafeFastResetFlagArray<> _was_moved;
+  NextActiveNodes _moved_nodes_stream;
+  ActiveNodes _moved_nodes;
+  // ! Positions of high-degree vertices in _active_nodes whose moves are deferred
+  // ! to the end of the current round (only used if defer_high_degree_moves is set)
+  ds::StreamingVector<size_t> _deferred_moves;
 };
 
 using LabelPropagationKm1Refiner = LabelPropagationRefiner<Km1Policy>;
@@ -29,6 +29,7 @@
 #include <vector>
 
 #include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for_each.h"
 
 #include "kahypar/meta/policy_registry.h"
 #include "kahypar/meta/typelist.h"
@@ -59,6 +60,32 @@ class GainPolicy : public kahypar::meta::PolicyBase {
     return static_cast<Derived*>(this)->computeMaxGainMoveImpl(hypergraph, hn, rebalance);
   }
 
+  // ! Same as computeMaxGainMove(...), but the scores of the incident hyperedges are
+  // ! accumulated with a nested parallel loop. Intended for vertices with a huge number
+  // ! of incident hyperedges, which would otherwise stall the calling thread.
+  Move computeMaxGainMoveInParallel(const HyperGraph& hypergraph,
+                                    const HypernodeID hn,
+                                    const bool rebalance = false) {
+    const PartitionID from = hypergraph.partID(hn);
+    const PartitionID k = _context.partition.k;
+    tbb::enumerable_thread_specific<parallel::scalable_vector<Gain>> local_scores(k, 0);
+    tbb::enumerable_thread_specific<Gain> local_internal_weight(0);
+    auto incident_edges = hypergraph.incidentEdges(hn);
+    tbb::parallel_for_each(incident_edges.begin(), incident_edges.end(), [&](const HyperedgeID he) {
+      local_internal_weight.local() += static_cast<Derived*>(this)->accumulateEdgeScore(
+        hypergraph, he, from, local_scores.local());
+    });
+
+    parallel::scalable_vector<Gain>& tmp_scores = _tmp_scores.local();
+    for ( const parallel::scalable_vector<Gain>& scores : local_scores ) {
+      for ( PartitionID to = 0; to < k; ++to ) {
+        tmp_scores[to] += scores[to];
+      }
+    }
+    const Gain internal_weight = local_internal_weight.combine(std::plus<Gain>());
+    return static_cast<Derived*>(this)->selectBestMove(hypergraph, hn, from, internal_weight, rebalance);
+  }
+
   inline void computeDeltaForHyperedge(const HyperedgeID he,
                                        const HyperedgeWeight edge_weight,
                                        const HypernodeID edge_size,
@@ -101,6 +128,63 @@ class GainPolicy : public kahypar::meta::PolicyBase {
   }
 
  protected:
+  // ! In a graph, each edge connects hn to exactly one other node. Moving hn to
+  // ! block 'to' removes all edges to neighbors in 'to' from the cut and adds all
+  // ! edges to neighbors in its own block, which is the gain for both the cut
+  // ! and km1 metric. Therefore, we can sum up edge weights by neighbor block in a
+  // ! tight loop over the adjacency array without computing connectivity sets.
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE Gain accumulateGraphScores(const HyperGraph& graph,
+                                                                const HypernodeID hn,
+                                                                const PartitionID from,
+                                                                parallel::scalable_vector<Gain>& tmp_scores) {
+    Gain internal_weight = 0;
+    graph.forEachIncidentEdgeWithPrefetching(hn, [&](const HyperedgeID e) {
+      internal_weight += accumulateGraphEdgeScore(graph, e, from, tmp_scores);
+    });
+    return internal_weight;
+  }
+
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE static Gain accumulateGraphEdgeScore(const HyperGraph& graph,
+                                                                         const HyperedgeID e,
+                                                                         const PartitionID from,
+                                                                         parallel::scalable_vector<Gain>& tmp_scores) {
+    const PartitionID to = graph.partID(graph.edgeTarget(e));
+    const HyperedgeWeight edge_weight = graph.edgeWeight(e);
+    tmp_scores[to] -= edge_weight;
+    return to == from ? edge_weight : 0;
+  }
+
+  // ! Returns the move to the block with the best score among all blocks that can take hn.
+  // ! Ties are broken randomly, unless randomization is disabled. Resets the scores.
+  Move selectBestMove(const HyperGraph& hypergraph,
+                      const HypernodeID hn,
+                      const PartitionID from,
+                      const Gain internal_weight,
+                      const bool rebalance,
+                      const bool disable_randomization) {
+    parallel::scalable_vector<Gain>& tmp_scores = _tmp_scores.local();
+    Move best_move { from, from, hn, rebalance ? std::numeric_limits<Gain>::max() : 0 };
+    HypernodeWeight hn_weight = hypergraph.nodeWeight(hn);
+    int cpu_id = SCHED_GETCPU;
+    utils::Randomize& rand = utils::Randomize::instance();
+    for (PartitionID to = 0; to < _context.partition.k; ++to) {
+      if (from != to) {
+        Gain score = tmp_scores[to] + internal_weight;
+        bool new_best_gain = (score < best_move.gain) ||
+                             (score == best_move.gain &&
+                              !disable_randomization &&
+                              rand.flipCoin(cpu_id));
+        if (new_best_gain &&
+            hypergraph.partWeight(to) + hn_weight <= _context.partition.max_part_weights[to]) {
+          best_move.to = to;
+          best_move.gain = score;
+        }
+      }
+      tmp_scores[to] = 0;
+    }
+    return best_move;
+  }
+
   const Context& _context;
   DeltaGain _deltas;
   TmpScores _tmp_scores;
@@ -133,50 +217,53 @@ class Km1Policy : public GainPolicy<Km1Policy<HyperGraph>, HyperGraph> {
     PartitionID from = hypergraph.partID(hn);
     parallel::scalable_vector<Gain>& tmp_scores = _tmp_scores.local();
     Gain internal_weight = 0;
-    for (const HyperedgeID& he : hypergraph.incidentEdges(hn)) {
+    if constexpr ( HyperGraph::is_graph ) {
+      internal_weight = Base::accumulateGraphScores(hypergraph, hn, from, tmp_scores);
+    } else {
+      hypergraph.forEachIncidentEdgeWithPrefetching(hn, [&](const HyperedgeID he) {
+        internal_weight += accumulateEdgeScore(hypergraph, he, from, tmp_scores);
+      });
+    }
+    return selectBestMove(hypergraph, hn, from, internal_weight, rebalance);
+  }
+
+  // ! Adds the contribution of hyperedge he to the scores of all blocks
+  // ! and returns its contribution to the internal weight of hn
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE Gain accumulateEdgeScore(const HyperGraph& hypergraph,
+                                                             const HyperedgeID he,
+                                                             const PartitionID from,
+                                                             parallel::scalable_vector<Gain>& tmp_scores) const {
+    if constexpr ( HyperGraph::is_graph ) {
+      return Base::accumulateGraphEdgeScore(hypergraph, he, from, tmp_scores);
+    } else {
       HypernodeID pin_count_in_from_part = hypergraph.pinCountInPart(he, from);
       HyperedgeWeight he_weight = hypergraph.edgeWeight(he);
 
+      // Substract edge weight of all incident blocks.
+      // Note, in case the pin count in from part is greater than one
+      // we will later add that edge weight to the gain (see internal_weight).
+      // The connectivity set always contains the block of the vertex. We subtract
+      // the edge weight from all blocks with one masked addition and restore the
+      // score of block from afterwards.
+      hypergraph.aggregateBenefit(he, -he_weight, tmp_scores);
+      tmp_scores[from] += he_weight;
+
       // In case, there is more one than one pin left in from part, we would
       // increase the connectivity, if we would move the pin to one block
       // no contained in the connectivity set. In such cases, we can only
       // increase the connectivity of a hyperedge and therefore gather
       // the edge weight of all those edges and add it later to move gain
       // to all other blocks.
-      if ( pin_count_in_from_part > 1 ) {
-        internal_weight += he_weight;
-      }
-
-      // Substract edge weight of all incident blocks.
-      // Note, in case the pin count in from part is greater than one
-      // we will later add that edge weight to the gain (see internal_weight).
-      for (const PartitionID& to : hypergraph.connectivitySet(he)) {
-        if (from != to) {
-          tmp_scores[to] -= he_weight;
-        }
-      }
+      return pin_count_in_from_part > 1 ? he_weight : 0;
     }
+  }
 
-    Move best_move { from, from, hn, rebalance ? std::numeric_limits<Gain>::max() : 0 };
-    HypernodeWeight hn_weight = hypergraph.nodeWeight(hn);
-    int cpu_id = SCHED_GETCPU;
-    utils::Randomize& rand = utils::Randomize::instance();
-    for (PartitionID to = 0; to < _context.partition.k; ++to) {
-      if (from != to) {
-        Gain score = tmp_scores[to] + internal_weight;
-        bool new_best_gain = (score < best_move.gain) ||
-                             (score == best_move.gain &&
-                              !_disable_randomization &&
-                              rand.flipCoin(cpu_id));
-        if (new_best_gain &&
-            hypergraph.partWeight(to) + hn_weight <= _context.partition.max_part_weights[to]) {
-          best_move.to = to;
-          best_move.gain = score;
-        }
-      }
-      tmp_scores[to] = 0;
-    }
-    return best_move;
+  Move selectBestMove(const HyperGraph& hypergraph,
+                      const HypernodeID hn,
+                      const PartitionID from,
+                      const Gain internal_weight,
+                      const bool rebalance) {
+    return Base::selectBestMove(hypergraph, hn, from, internal_weight, rebalance, _disable_randomization);
   }
 
   inline void computeDeltaForHyperedgeImpl(const HyperedgeID he,
@@ -222,7 +309,25 @@ class CutPolicy : public GainPolicy<CutPolicy<HyperGraph>, HyperGraph> {
     PartitionID from = hypergraph.partID(hn);
     parallel::scalable_vector<Gain>& tmp_scores = _tmp_scores.local();
     Gain internal_weight = 0;
-    for (const HyperedgeID& he : hypergraph.incidentEdges(hn)) {
+    if constexpr ( HyperGraph::is_graph ) {
+      internal_weight = Base::accumulateGraphScores(hypergraph, hn, from, tmp_scores);
+    } else {
+      hypergraph.forEachIncidentEdgeWithPrefetching(hn, [&](const HyperedgeID he) {
+        internal_weight += accumulateEdgeScore(hypergraph, he, from, tmp_scores);
+      });
+    }
+    return selectBestMove(hypergraph, hn, from, internal_weight, rebalance);
+  }
+
+  // ! Adds the contribution of hyperedge he to the scores of all blocks
+  // ! and returns its contribution to the internal weight of hn
+  MT_KAHYPAR_ATTRIBUTE_ALWAYS_INLINE Gain accumulateEdgeScore(const HyperGraph& hypergraph,
+                                                             const HyperedgeID he,
+                                                             const PartitionID from,
+                                                             parallel::scalable_vector<Gain>& tmp_scores) const {
+    if constexpr ( HyperGraph::is_graph ) {
+      return Base::accumulateGraphEdgeScore(hypergraph, he, from, tmp_scores);
+    } else {
       PartitionID connectivity = hypergraph.connectivity(he);
       HypernodeID pin_count_in_from_part = hypergraph.pinCountInPart(he, from);
       HyperedgeWeight weight = hypergraph.edgeWeight(he);
@@ -230,7 +335,7 @@ class CutPolicy : public GainPolicy<CutPolicy<HyperGraph>, HyperGraph> {
         ASSERT(hypergraph.edgeSize(he) > 1);
         // In case, the hyperedge is a non-cut hyperedge, we would increase
         // the cut, if we move vertex hn to an other block.
-        internal_weight += weight;
+        return weight;
       } else if (connectivity == 2 && pin_count_in_from_part == 1) {
         for (const PartitionID& to : hypergraph.connectivitySet(he)) {
           // In case there are only two blocks contained in the current
@@ -242,28 +347,16 @@ class CutPolicy : public GainPolicy<CutPolicy<HyperGraph>, HyperGraph> {
           }
         }
       }
+      return 0;
     }
+  }
 
-    Move best_move { from, from, hn, rebalance ? std::numeric_limits<Gain>::max() : 0 };
-    HypernodeWeight hn_weight = hypergraph.nodeWeight(hn);
-    int cpu_id = SCHED_GETCPU;
-    utils::Randomize& rand = utils::Randomize::instance();
-    for (PartitionID to = 0; to < _context.partition.k; ++to) {
-      if (from != to) {
-        Gain score = tmp_scores[to] + internal_weight;
-        bool new_best_gain = (score < best_move.gain) ||
-                             (score == best_move.gain &&
-                              !_disable_randomization &&
-                              rand.flipCoin(cpu_id));
-        if (new_best_gain && hypergraph.partWeight(to) + hn_weight <=
-            _context.partition.max_part_weights[to]) {
-          best_move.to = to;
-          best_move.gain = score;
-        }
-      }
-      tmp_scores[to] = 0;
-    }
-    return best_move;
+  Move selectBestMove(const HyperGraph& hypergraph,
+                      const HypernodeID hn,
+                      const PartitionID from,
+                      const Gain internal_weight,
+                      const bool rebalance) {
+    return Base::selectBestMove(hypergraph, hn, from, internal_weight, rebalance, _disable_randomization);
   }
 
   inline void computeDeltaForHyperedgeImpl(const HyperedgeID he,
@@ -34,6 +34,9 @@
 
 #include "tbb/enumerable_thread_specific.h"
 #include "tbb/parallel_for.h"
+#include "tbb/parallel_sort.h"
+#include "mt-kahypar/parallel/parallel_prefix_sum.h"
+#include "mt-kahypar/parallel/scratch_arena.h"
 #include "mt-kahypar/partition/metrics.h"
 
 namespace mt_kahypar {
@@ -78,7 +81,8 @@ namespace mt_kahypar {
       });
       _hg.doParallelForAllNodes([&](const HypernodeID& hn) {
         const PartitionID from = _hg.partID(hn);
-        if ( _hg.isBorderNode(hn) && _hg.partWeight(from) > _context.partition.max_part_weights[from] ) {
+        if ( _hg.isBorderNode(hn) && !_hg.isFixed(hn) &&
+             _hg.partWeight(from) > _context.partition.max_part_weights[from] ) {
           Move rebalance_move = _gain.computeMaxGainMove(_hg, hn, true /* rebalance move */);
           if ( rebalance_move.gain <= 0 ) {
             moveVertex(hn, rebalance_move, objective_delta);
@@ -97,6 +101,15 @@ namespace mt_kahypar {
         return true;
       }(), "Rebalancer part weights are wrong");
 
+      // If partition is still imbalanced, we move the vertices with the best ratio
+      // of objective delta and weight out of each overloaded block in bulk
+      for ( size_t round = 0; round < MAX_BULK_REBALANCING_ROUNDS &&
+              !metrics::isBalanced(_hg, _context); ++round ) {
+        if ( !performBulkRebalancingMoves(objective_delta) ) {
+          break;
+        }
+      }
+
       // If partition is still imbalanced, we try execute moves stored into
       // the thread local priority queue which could possibly worsen solution quality
       if ( !metrics::isBalanced(_hg, _context) ) {
@@ -171,6 +184,96 @@ namespace mt_kahypar {
     }
   }
 
+  template <template <typename> class GainPolicy>
+  template<typename F>
+  bool Rebalancer<GainPolicy>::performBulkRebalancingMoves(const F& objective_delta) {
+    const PartitionID k = _context.partition.k;
+    auto is_overloaded = [&](const PartitionID block) {
+      return _hg.partWeight(block) > _context.partition.max_part_weights[block];
+    };
+
+    // Collect the best move of each border vertex in an overloaded block
+    tbb::enumerable_thread_specific< vec<Move> > ets_candidates;
+    _hg.doParallelForAllNodes([&](const HypernodeID hn) {
+      const PartitionID from = _hg.partID(hn);
+      if ( _hg.isBorderNode(hn) && !_hg.isFixed(hn) && is_overloaded(from) ) {
+        Move move = _gain.computeMaxGainMove(_hg, hn, true /* rebalance move */);
+        if ( move.from != move.to && move.gain != std::numeric_limits<Gain>::max() ) {
+          ets_candidates.local().push_back(move);
+        }
+      }
+    });
+
+    vec<Move> candidates;
+    for ( const vec<Move>& local_candidates : ets_candidates ) {
+      candidates.insert(candidates.end(), local_candidates.begin(), local_candidates.end());
+    }
+    if ( candidates.empty() ) {
+      return false;
+    }
+
+    // Group candidates by their block and sort them by objective delta per unit of
+    // weight (note that the gain of a rebalance move is the delta of the objective)
+    tbb::parallel_sort(candidates.begin(), candidates.end(), [&](const Move& lhs, const Move& rhs) {
+      if ( lhs.from != rhs.from ) {
+        return lhs.from < rhs.from;
+      }
+      const int64_t lhs_rating = static_cast<int64_t>(lhs.gain) * _hg.nodeWeight(rhs.node);
+      const int64_t rhs_rating = static_cast<int64_t>(rhs.gain) * _hg.nodeWeight(lhs.node);
+      return lhs_rating < rhs_rating || ( lhs_rating == rhs_rating && lhs.node < rhs.node );
+    });
+
+    // Compute the prefix of each block whose weight covers the overload of the block.
+    // The temporary arrays are allocated in the scratch arena of this thread.
+    parallel::ScratchArena::Scope scratch_scope;
+    parallel::ScratchArena& scratch = parallel::ScratchArena::local();
+    HypernodeWeight* weight_prefix_sum = scratch.allocate<HypernodeWeight>(candidates.size());
+    tbb::parallel_for(UL(0), candidates.size(), [&](const size_t i) {
+      weight_prefix_sum[i] = _hg.nodeWeight(candidates[i].node);
+    });
+    parallel_prefix_sum(weight_prefix_sum, weight_prefix_sum + candidates.size(),
+      weight_prefix_sum, std::plus<HypernodeWeight>(), 0);
+
+    size_t* block_begin = scratch.allocate<size_t>(k, 0);
+    size_t* block_end = scratch.allocate<size_t>(k, 0);
+    tbb::parallel_for(UL(0), candidates.size(), [&](const size_t i) {
+      const PartitionID block = candidates[i].from;
+      if ( i == 0 || candidates[i - 1].from != block ) {
+        block_begin[block] = i;
+      }
+      if ( i + 1 == candidates.size() || candidates[i + 1].from != block ) {
+        block_end[block] = i + 1;
+      }
+    });
+
+    size_t* prefix_end = scratch.allocate<size_t>(k, 0);
+    for ( PartitionID block = 0; block < k; ++block ) {
+      const size_t begin = block_begin[block];
+      const size_t end = block_end[block];
+      if ( begin < end ) {
+        const HypernodeWeight overload = _hg.partWeight(block) - _context.partition.max_part_weights[block];
+        const HypernodeWeight weight_before = begin > 0 ? weight_prefix_sum[begin - 1] : 0;
+        const size_t covering = std::lower_bound(weight_prefix_sum + begin,
+          weight_prefix_sum + end, weight_before + overload) - weight_prefix_sum;
+        prefix_end[block] = std::min(covering + 1, end);
+      }
+    }
+
+    // Apply the selected moves in parallel (moves to blocks that would
+    // become overloaded are rejected by moveVertex(...))
+    CAtomic<size_t> num_moves(0);
+    tbb::parallel_for(UL(0), candidates.size(), [&](const size_t i) {
+      const Move& move = candidates[i];
+      if ( i < prefix_end[move.from] && _hg.partID(move.node) == move.from ) {
+        if ( moveVertex(move.node, move, objective_delta) ) {
+          num_moves.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+    DBG << "Bulk rebalancing moved" << num_moves.load() << "of" << candidates.size() << "candidates";
+    return num_moves.load() > 0;
+  }
+
   template <template <typename> class GainPolicy>
   vec<Move> Rebalancer<GainPolicy>::repairEmptyBlocks() {
     // First detect if there are any empty blocks.
@@ -194,6 +297,9 @@ namespace mt_kahypar {
       tbb::enumerable_thread_specific< vec< vec<Move> > > ets_best_move(k);
 
       _hg.doParallelForAllNodes([&](const HypernodeID u) {
+        if ( _hg.isFixed(u) ) {
+          return;
+        }
         vec<Gain>& scores = ets_scores.local();
         vec< vec<Move> >& move_proposals = ets_best_move.local();
 
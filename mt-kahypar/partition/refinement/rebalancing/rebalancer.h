@@ -44,6 +44,7 @@ class Rebalancer {
   static constexpr bool enable_heavy_assert = false;
 
   static constexpr Gain MIN_PQ_GAIN_THRESHOLD = 5;
+  static constexpr size_t MAX_BULK_REBALANCING_ROUNDS = 5;
 
 public:
 
@@ -83,6 +84,13 @@ public:
 
 private:
 
+  // ! Moves vertices out of all overloaded blocks in bulk. For each overloaded block,
+  // ! the candidate moves are sorted by their objective delta per unit of weight and
+  // ! we apply the shortest prefix whose total weight covers the overload of the block.
+  // ! Returns true, if at least one vertex was moved.
+  template<typename F>
+  bool performBulkRebalancingMoves(const F& objective_delta);
+
   template<typename F>
   bool moveVertex(const HypernodeID hn, const Move& move, const F& objective_delta) {
     ASSERT(_hg.partID(hn) == move.from);
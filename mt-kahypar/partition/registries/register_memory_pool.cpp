@@ -27,8 +27,14 @@
 
 #include "register_memory_pool.h"
 
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+
 #include "mt-kahypar/datastructures/pin_count_in_part.h"
 #include "mt-kahypar/datastructures/connectivity_set.h"
+#include "mt-kahypar/datastructures/gain_cache.h"
+#include "mt-kahypar/datastructures/priority_queue.h"
 #include "mt-kahypar/parallel/memory_pool.h"
 #include "mt-kahypar/parallel/atomic_wrapper.h"
 #include "mt-kahypar/utils/memory_tree.h"
@@ -36,100 +42,255 @@
 
 namespace mt_kahypar {
 
-  void register_memory_pool(const Hypergraph& hypergraph,
-                            const Context& context) {
+  namespace {
+    // ! Each pin of a flow problem requires roughly this many bytes (flow hypergraph
+    // ! with pins and incident hyperedges, flow values and the mappings to the input)
+    static constexpr size_t FLOW_BYTES_PER_PIN = 48;
+    // ! Lower bound for the pins of concurrent flow problems, if we shrink them due to the memory limit
+    static constexpr size_t MIN_NUM_PINS_OF_CONCURRENT_SEARCHES = 100000;
 
-    if (context.partition.mode == Mode::direct) {
+    size_t size_in_mb(const size_t size_in_bytes) {
+      return size_in_bytes / 1000000;
+    }
+
+    // ! Calls register_group(group, stage) and register_chunk(group, key, num_elements, size)
+    // ! for all memory chunks that the partitioner requests from the memory pool
+    template<typename GroupFunc, typename ChunkFunc>
+    void for_each_memory_chunk(const Hypergraph& hypergraph,
+                               const Context& context,
+                               const GroupFunc& register_group,
+                               const ChunkFunc& register_chunk) {
 
       // ########## Preprocessing Memory ##########
 
       const HypernodeID num_hypernodes = hypergraph.initialNumNodes();
       const HyperedgeID num_hyperedges = hypergraph.initialNumEdges();
-      const HypernodeID num_pins = hypergraph.initialNumPins();
-
-      auto& pool = parallel::MemoryPool::instance();
+      const size_t num_pins = hypergraph.initialNumPins();
+      const bool uses_gain_cache =
+        context.refinement.fm.algorithm == FMAlgorithm::fm_gain_cache ||
+        context.refinement.fm.algorithm == FMAlgorithm::fm_gain_cache_on_demand ||
+        context.refinement.fm.algorithm == FMAlgorithm::fm_gain_cache_lazy;
 
       if ( context.preprocessing.use_community_detection ) {
         const bool is_graph = hypergraph.maxEdgeSize() == 2;
         const size_t num_star_expansion_nodes = num_hypernodes + (is_graph ? 0 : num_hyperedges);
         const size_t num_star_expansion_edges = is_graph ? num_pins : (2UL * num_pins);
 
-        pool.register_memory_group("Preprocessing", 1);
-        pool.register_memory_chunk("Preprocessing", "indices", num_star_expansion_nodes + 1, sizeof(size_t));
-        pool.register_memory_chunk("Preprocessing", "arcs", num_star_expansion_edges, sizeof(Arc));
-        pool.register_memory_chunk("Preprocessing", "node_volumes", num_star_expansion_nodes, sizeof(ArcWeight));
-
-        if ( !context.preprocessing.community_detection.low_memory_contraction ) {
-          pool.register_memory_chunk("Preprocessing", "tmp_indices",
-                                    num_star_expansion_nodes + 1, sizeof(parallel::IntegralAtomicWrapper<size_t>));
-          pool.register_memory_chunk("Preprocessing", "tmp_pos",
-                                    num_star_expansion_nodes, sizeof(parallel::IntegralAtomicWrapper<size_t>));
-          pool.register_memory_chunk("Preprocessing", "tmp_arcs", num_star_expansion_edges, sizeof(Arc));
-          pool.register_memory_chunk("Preprocessing", "valid_arcs", num_star_expansion_edges, sizeof(size_t));
-          pool.register_memory_chunk("Preprocessing", "tmp_node_volumes",
-                                    num_star_expansion_nodes, sizeof(parallel::AtomicWrapper<ArcWeight>));
+        // the implicit star-expansion only stores node volumes and always uses the low memory contraction
+        const bool implicit_star_expansion = !Hypergraph::is_graph && Hypergraph::is_static_hypergraph &&
+          !is_graph && context.preprocessing.community_detection.implicit_star_expansion;
+
+        register_group("Preprocessing", 1);
+        if ( !implicit_star_expansion ) {
+          register_chunk("Preprocessing", "indices", num_star_expansion_nodes + 1, sizeof(size_t));
+          register_chunk("Preprocessing", "arcs", num_star_expansion_edges, sizeof(Arc));
+        }
+        register_chunk("Preprocessing", "node_volumes", num_star_expansion_nodes, sizeof(ArcWeight));
+
+        if ( !context.preprocessing.community_detection.low_memory_contraction && !implicit_star_expansion ) {
+          register_chunk("Preprocessing", "tmp_indices",
+                         num_star_expansion_nodes + 1, sizeof(parallel::IntegralAtomicWrapper<size_t>));
+          register_chunk("Preprocessing", "tmp_pos",
+                         num_star_expansion_nodes, sizeof(parallel::IntegralAtomicWrapper<size_t>));
+          register_chunk("Preprocessing", "tmp_arcs", num_star_expansion_edges, sizeof(Arc));
+          register_chunk("Preprocessing", "valid_arcs", num_star_expansion_edges, sizeof(size_t));
+          register_chunk("Preprocessing", "tmp_node_volumes",
+                         num_star_expansion_nodes, sizeof(parallel::AtomicWrapper<ArcWeight>));
         }
       }
 
       // ########## Coarsening Memory ##########
 
-      pool.register_memory_group("Coarsening", 2);
+      register_group("Coarsening", 2);
       if ( context.partition.paradigm == Paradigm::multilevel ) {
         if (Hypergraph::is_graph) {
-          pool.register_memory_chunk("Coarsening", "mapping", num_hypernodes, sizeof(HypernodeID));
-          pool.register_memory_chunk("Coarsening", "tmp_nodes", num_hypernodes, Hypergraph::SIZE_OF_HYPERNODE);
-          pool.register_memory_chunk("Coarsening", "node_sizes", num_hypernodes, sizeof(HyperedgeID));
-          pool.register_memory_chunk("Coarsening", "tmp_num_incident_edges",
-                                     num_hypernodes, sizeof(parallel::IntegralAtomicWrapper<HyperedgeID>));
-          pool.register_memory_chunk("Coarsening", "node_weights",
-                                     num_hypernodes, sizeof(parallel::IntegralAtomicWrapper<HypernodeWeight>));
-          pool.register_memory_chunk("Coarsening", "tmp_edges", num_hyperedges, Hypergraph::SIZE_OF_HYPEREDGE);
-          pool.register_memory_chunk("Coarsening", "edge_id_mapping", num_hyperedges / 2, sizeof(HyperedgeID));
+          register_chunk("Coarsening", "mapping", num_hypernodes, sizeof(HypernodeID));
+          register_chunk("Coarsening", "tmp_nodes", num_hypernodes, Hypergraph::SIZE_OF_HYPERNODE);
+          register_chunk("Coarsening", "node_sizes", num_hypernodes, sizeof(HyperedgeID));
+          register_chunk("Coarsening", "tmp_num_incident_edges",
+                         num_hypernodes, sizeof(parallel::IntegralAtomicWrapper<HyperedgeID>));
+          register_chunk("Coarsening", "node_weights",
+                         num_hypernodes, sizeof(parallel::IntegralAtomicWrapper<HypernodeWeight>));
+          register_chunk("Coarsening", "tmp_edges", num_hyperedges, Hypergraph::SIZE_OF_HYPEREDGE);
+          register_chunk("Coarsening", "edge_id_mapping", num_hyperedges / 2, sizeof(HyperedgeID));
         } else {
-          pool.register_memory_chunk("Coarsening", "mapping", num_hypernodes, sizeof(size_t));
-          pool.register_memory_chunk("Coarsening", "tmp_hypernodes", num_hypernodes, Hypergraph::SIZE_OF_HYPERNODE);
-          pool.register_memory_chunk("Coarsening", "tmp_incident_nets", num_pins, sizeof(HyperedgeID));
-          pool.register_memory_chunk("Coarsening", "tmp_num_incident_nets",
-                                    num_hypernodes, sizeof(parallel::IntegralAtomicWrapper<size_t>));
-          pool.register_memory_chunk("Coarsening", "hn_weights",
-                                    num_hypernodes, sizeof(parallel::IntegralAtomicWrapper<HypernodeWeight>));
-          pool.register_memory_chunk("Coarsening", "tmp_hyperedges", num_hyperedges, Hypergraph::SIZE_OF_HYPEREDGE);
-          pool.register_memory_chunk("Coarsening", "tmp_incidence_array", num_pins, sizeof(HypernodeID));
-          pool.register_memory_chunk("Coarsening", "he_sizes", num_hyperedges, sizeof(size_t));
-          pool.register_memory_chunk("Coarsening", "valid_hyperedges", num_hyperedges, sizeof(size_t));
+          register_chunk("Coarsening", "mapping", num_hypernodes, sizeof(size_t));
+          register_chunk("Coarsening", "tmp_num_incident_nets",
+                         num_hypernodes, sizeof(parallel::IntegralAtomicWrapper<size_t>));
+          register_chunk("Coarsening", "hn_weights",
+                         num_hypernodes, sizeof(parallel::IntegralAtomicWrapper<HypernodeWeight>));
+          if ( !context.coarsening.low_memory_contraction ) {
+            // Low memory contraction does not use temporary buffers for pins and incident nets
+            register_chunk("Coarsening", "tmp_hypernodes", num_hypernodes, Hypergraph::SIZE_OF_HYPERNODE);
+            register_chunk("Coarsening", "tmp_incident_nets", num_pins, sizeof(HyperedgeID));
+            register_chunk("Coarsening", "tmp_hyperedges", num_hyperedges, Hypergraph::SIZE_OF_HYPEREDGE);
+            register_chunk("Coarsening", "tmp_incidence_array", num_pins, sizeof(HypernodeID));
+          }
+          register_chunk("Coarsening", "he_sizes", num_hyperedges, sizeof(size_t));
+          register_chunk("Coarsening", "valid_hyperedges", num_hyperedges, sizeof(size_t));
         }
       }
 
       // ########## Refinement Memory ##########
 
-      pool.register_memory_group("Refinement", 3);
-      pool.register_memory_chunk("Refinement", "part_ids", num_hypernodes, sizeof(PartitionID));
+      register_group("Refinement", 3);
+      register_chunk("Refinement", "part_ids", num_hypernodes, sizeof(PartitionID));
 
       if (Hypergraph::is_graph) {
         #ifdef USE_GRAPH_PARTITIONER // SIZE_OF_EDGE_LOCK is only available in the graph data structure
-          pool.register_memory_chunk("Refinement", "edge_locks", num_hyperedges, PartitionedHypergraph::SIZE_OF_EDGE_LOCK);
+          register_chunk("Refinement", "edge_locks", num_hyperedges, PartitionedHypergraph::SIZE_OF_EDGE_LOCK);
         #endif
-        if ( context.refinement.fm.algorithm != FMAlgorithm::do_nothing ) {
-          pool.register_memory_chunk("Refinement", "incident_weight_in_part",
-                                    static_cast<size_t>(num_hypernodes) * ( context.partition.k + 1 ),
-                                    sizeof(CAtomic<HyperedgeWeight>));
-        }
       } else {
         const HypernodeID max_he_size = hypergraph.maxEdgeSize();
-        pool.register_memory_chunk("Refinement", "pin_count_in_part",
-                                  ds::PinCountInPart::num_elements(num_hyperedges, context.partition.k, max_he_size),
-                                  sizeof(ds::PinCountInPart::Value));
-        pool.register_memory_chunk("Refinement", "connectivity_set",
-                                  ds::ConnectivitySets::num_elements(num_hyperedges, context.partition.k),
-                                  sizeof(ds::ConnectivitySets::UnsafeBlock));
-        if ( context.refinement.fm.algorithm != FMAlgorithm::do_nothing ) {
-          pool.register_memory_chunk("Refinement", "gain_cache",
-                                    static_cast<size_t>(num_hypernodes) * ( context.partition.k + 1 ),
-                                    sizeof(CAtomic<HyperedgeWeight>));
+        register_chunk("Refinement", "pin_count_in_part",
+                       ds::PinCountInPart::num_elements(num_hyperedges, context.partition.k, max_he_size),
+                       sizeof(ds::PinCountInPart::Value));
+        register_chunk("Refinement", "connectivity_set",
+                       ds::ConnectivitySets::num_elements(num_hyperedges, context.partition.k),
+                       sizeof(ds::ConnectivitySets::UnsafeBlock));
+        register_chunk("Refinement", "pin_count_update_ownership",
+                       num_hyperedges, sizeof(SpinLock));
+      }
+
+      // The graph and hypergraph data structures share the gain cache
+      if ( uses_gain_cache ) {
+        register_chunk("Refinement", "gain_cache",
+                       ds::GainCache::num_elements(num_hypernodes, context.partition.k),
+                       sizeof(ds::GainCache::Value));
+        if ( ds::GainCache::use_sparse_representation(context.partition.k) ) {
+          register_chunk("Refinement", "gain_cache_blocks",
+                         ds::GainCache::num_sparse_block_elements(num_hypernodes, context.partition.k),
+                         sizeof(CAtomic<PartitionID>));
+        }
+      }
+    }
+
+    // ! Predicts the memory of the memory pool. Memory groups of different stages
+    // ! share memory chunks, thus the memory pool requires roughly the memory of
+    // ! its largest stage.
+    size_t estimate_memory_pool_size(const Hypergraph& hypergraph, const Context& context) {
+      std::unordered_map<std::string, size_t> group_sizes;
+      for_each_memory_chunk(hypergraph, context,
+        [&](const std::string& group, const size_t) {
+          group_sizes.emplace(group, 0);
+        }, [&](const std::string& group, const std::string&, const size_t num_elements, const size_t size) {
+          group_sizes[group] += num_elements * size;
+        });
+      size_t max_group_size = 0;
+      for ( const auto& group_size : group_sizes ) {
+        max_group_size = std::max(max_group_size, group_size.second);
+      }
+      return max_group_size;
+    }
+
+    bool uses_flows(const Context& context) {
+      return context.refinement.flows.algorithm != FlowAlgorithm::do_nothing;
+    }
+
+    size_t estimate_flow_memory(const Hypergraph& hypergraph, const Context& context) {
+      if ( uses_flows(context) ) {
+        return std::min(context.refinement.flows.max_num_pins_of_concurrent_searches,
+          static_cast<size_t>(hypergraph.initialNumPins())) * FLOW_BYTES_PER_PIN;
+      }
+      return 0;
+    }
+
+    // ! Predicts the peak memory of the partitioner based on the size of the input,
+    // ! k and the chosen algorithms
+    size_t estimate_peak_memory(const Hypergraph& hypergraph, const Context& context) {
+      const size_t num_hypernodes = hypergraph.initialNumNodes();
+      const size_t num_hyperedges = hypergraph.initialNumEdges();
+      const size_t num_pins = hypergraph.initialNumPins();
+      const size_t input_size = num_hypernodes * Hypergraph::SIZE_OF_HYPERNODE +
+        num_hyperedges * Hypergraph::SIZE_OF_HYPEREDGE +
+        num_pins * ( sizeof(HypernodeID) + sizeof(HyperedgeID) );
+      // The coarsened hypergraphs of the multilevel hierarchy are bounded by the
+      // size of the input (geometric series). In the n-level setting, the dynamic
+      // hypergraph stores the contraction forest and the removed hyperedges.
+      const size_t hierarchy_size = input_size;
+      size_t fm_size = 0;
+      if ( context.refinement.fm.algorithm != FMAlgorithm::do_nothing ) {
+        // PQ handles, move tracker and node tracker
+        const size_t pq_handles_per_node =
+          context.refinement.fm.algorithm == FMAlgorithm::fm_gain_delta ? context.partition.k : 1;
+        fm_size = num_hypernodes * ( pq_handles_per_node * sizeof(PosT) +
+          sizeof(Move) + sizeof(MoveID) + sizeof(SearchID) );
+      }
+      return input_size + hierarchy_size + estimate_memory_pool_size(hypergraph, context) +
+        fm_size + estimate_flow_memory(hypergraph, context);
+    }
+  } // namespace
+
+  void apply_memory_limit(const Hypergraph& hypergraph, Context& context) {
+    if ( context.partition.memory_limit == 0 ) {
+      return;
+    }
+
+    const size_t memory_limit = context.partition.memory_limit * UL(1000000);
+    size_t predicted_memory = estimate_peak_memory(hypergraph, context);
+    if ( context.partition.verbose_output ) {
+      LOG << "Predicted peak memory is" << size_in_mb(predicted_memory) << "MB"
+          << "( memory limit =" << context.partition.memory_limit << "MB )";
+    }
+
+    auto degrade = [&](const std::string& description, const auto& change_context) {
+      if ( predicted_memory > memory_limit ) {
+        change_context();
+        predicted_memory = estimate_peak_memory(hypergraph, context);
+        if ( context.partition.verbose_output ) {
+          LOG << "Memory limit exceeded:" << description
+              << "( predicted peak memory =" << size_in_mb(predicted_memory) << "MB )";
         }
-        pool.register_memory_chunk("Refinement", "pin_count_update_ownership",
-                                  num_hyperedges, sizeof(SpinLock));
       }
+    };
+
+    // We apply the alternatives in the order of their expected impact on the solution quality
+    degrade("Use low-memory contraction", [&] {
+      context.preprocessing.community_detection.low_memory_contraction = true;
+      context.coarsening.low_memory_contraction = true;
+    });
+    if ( uses_flows(context) ) {
+      degrade("Reduce the size of concurrent flow problems", [&] {
+        const size_t flow_memory = estimate_flow_memory(hypergraph, context);
+        const size_t remaining_memory = memory_limit -
+          std::min(memory_limit, predicted_memory - flow_memory);
+        context.refinement.flows.max_num_pins_of_concurrent_searches = std::max(
+          remaining_memory / FLOW_BYTES_PER_PIN, MIN_NUM_PINS_OF_CONCURRENT_SEARCHES);
+      });
+    }
+    if ( context.refinement.fm.algorithm == FMAlgorithm::fm_gain_cache ||
+         context.refinement.fm.algorithm == FMAlgorithm::fm_gain_cache_on_demand ||
+         context.refinement.fm.algorithm == FMAlgorithm::fm_gain_cache_lazy ) {
+      degrade("Use FM without gain cache", [&] {
+        context.refinement.fm.algorithm = FMAlgorithm::fm_recompute_gain;
+      });
+    }
+    if ( context.refinement.fm.algorithm != FMAlgorithm::do_nothing ) {
+      degrade("Disable FM refinement", [&] {
+        context.refinement.fm.algorithm = FMAlgorithm::do_nothing;
+      });
+    }
+
+    if ( predicted_memory > memory_limit ) {
+      WARNING("Predicted peak memory (" << size_in_mb(predicted_memory) << "MB) exceeds the memory limit ("
+        << context.partition.memory_limit << "MB) even with all low-memory alternatives enabled");
+    }
+  }
+
+  void register_memory_pool(const Hypergraph& hypergraph,
+                            const Context& context) {
+
+    // Small instances are partitioned without the memory pool, since allocating
+    // its chunks takes longer than the partitioning itself (see partitioner.cpp)
+    if (context.partition.mode == Mode::direct &&
+        !context.isSmallInstance(hypergraph.initialNumPins())) {
+      auto& pool = parallel::MemoryPool::instance();
+      for_each_memory_chunk(hypergraph, context,
+        [&](const std::string& group, const size_t stage) {
+          pool.register_memory_group(group, stage);
+        }, [&](const std::string& group, const std::string& key, const size_t num_elements, const size_t size) {
+          pool.register_memory_chunk(group, key, num_elements, size);
+        });
 
       // Allocate Memory
       utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
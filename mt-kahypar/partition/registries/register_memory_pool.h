@@ -31,6 +31,11 @@
 
 namespace mt_kahypar {
 
+// ! Predicts the peak memory of the partitioner and switches to lower-memory
+// ! algorithms, if the prediction exceeds the memory limit of the context.
+// ! Must be called before the memory pool is registered.
+void apply_memory_limit(const Hypergraph& hypergraph, Context& context);
+
 void register_memory_pool(const Hypergraph& hypergraph, const Context& context);
 
 } // namespace mt_kahypar
\ No newline at end of file
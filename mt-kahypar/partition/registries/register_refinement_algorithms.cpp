@@ -32,13 +32,18 @@
 #include "mt-kahypar/partition/refinement/do_nothing_refiner.h"
 #include "mt-kahypar/partition/refinement/flows/do_nothing_refiner.h"
 #include "mt-kahypar/partition/refinement/flows/flow_refiner.h"
+#include "mt-kahypar/partition/refinement/flows/graph_flow_refiner.h"
 #include "mt-kahypar/partition/refinement/label_propagation/label_propagation_refiner.h"
 #include "mt-kahypar/partition/refinement/deterministic/deterministic_label_propagation.h"
+#include "mt-kahypar/partition/refinement/deterministic/deterministic_fm_refiner.h"
 #include "mt-kahypar/partition/refinement/fm/multitry_kway_fm.h"
+#include "mt-kahypar/partition/refinement/fm/pairwise_fm_refiner.h"
 #include "mt-kahypar/partition/refinement/fm/strategies/gain_cache_strategy.h"
 #include "mt-kahypar/partition/refinement/fm/strategies/gain_delta_strategy.h"
 #include "mt-kahypar/partition/refinement/fm/strategies/recompute_gain_strategy.h"
 #include "mt-kahypar/partition/refinement/fm/strategies/gain_cache_on_demand_strategy.h"
+#include "mt-kahypar/partition/refinement/fm/strategies/gain_cache_lazy_strategy.h"
+#include "mt-kahypar/partition/refinement/jet/jet_refiner.h"
 
 #define REGISTER_LP_REFINER(id, refiner, t)                                                     \
   static kahypar::meta::Registrar<LabelPropagationFactory> JOIN(register_ ## refiner, t)(       \
@@ -69,15 +74,21 @@ REGISTER_LP_REFINER(LabelPropagationAlgorithm::do_nothing, DoNothingRefiner, 1);
 
 using MultiTryKWayFMWithGainGache = MultiTryKWayFM<GainCacheStrategy>;
 using MultiTryKWayFMWithGainGacheOnDemand = MultiTryKWayFM<GainCacheOnDemandStrategy>;
+using MultiTryKWayFMWithLazyGainGache = MultiTryKWayFM<GainCacheLazyStrategy>;
 using MultiTryKWayFMWithGainDelta = MultiTryKWayFM<GainDeltaStrategy>;
 using MultiTryKWayFMWithGainRecomputation = MultiTryKWayFM<RecomputeGainStrategy>;
 REGISTER_FM_REFINER(FMAlgorithm::fm_gain_cache, MultiTryKWayFMWithGainGache, FMWithGainCache);
 REGISTER_FM_REFINER(FMAlgorithm::fm_gain_cache_on_demand, MultiTryKWayFMWithGainGacheOnDemand, FMWithGainCacheOnDemand);
+REGISTER_FM_REFINER(FMAlgorithm::fm_gain_cache_lazy, MultiTryKWayFMWithLazyGainGache, FMWithLazyGainCache);
 REGISTER_FM_REFINER(FMAlgorithm::fm_gain_delta, MultiTryKWayFMWithGainDelta, FMWithGainDelta);
 REGISTER_FM_REFINER(FMAlgorithm::fm_recompute_gain, MultiTryKWayFMWithGainRecomputation, FMWithGainRecomputation);
+REGISTER_FM_REFINER(FMAlgorithm::jet, JetRefiner, Jet);
+REGISTER_FM_REFINER(FMAlgorithm::pairwise_fm, PairwiseFMRefiner, PairwiseFM);
+REGISTER_FM_REFINER(FMAlgorithm::deterministic, DeterministicFMRefiner, DeterministicFM);
 REGISTER_FM_REFINER(FMAlgorithm::do_nothing, DoNothingRefiner, 2);
 
 REGISTER_FLOW_REFINER(FlowAlgorithm::do_nothing, DoNothingFlowRefiner, 3);
 REGISTER_FLOW_REFINER(FlowAlgorithm::flow_cutter, FlowRefiner, Flows);
+REGISTER_FLOW_REFINER(FlowAlgorithm::graph_flow_cutter, GraphFlowRefiner, GraphFlows);
 
 }  // namespace mt_kahypar
@@ -0,0 +1,278 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "mt-kahypar/partition/streaming.h"
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+#include "mt-kahypar/utils/timer.h"
+#include "mt-kahypar/utils/utilities.h"
+
+namespace mt_kahypar {
+namespace streaming {
+
+namespace {
+
+static constexpr bool debug = false;
+
+// ! Exponent of the Fennel balance penalty (Tsourakakis et al.)
+static constexpr double GAMMA = 1.5;
+
+// ! Sum of the weights of the incident nets of a vertex per adjacent block
+struct IncidentWeights {
+  explicit IncidentWeights(const PartitionID k) :
+    weight_in_block(k, 0),
+    adjacent_blocks() { }
+
+  void add(const PartitionID block, const HyperedgeWeight weight) {
+    if ( weight_in_block[block] == 0 ) {
+      adjacent_blocks.push_back(block);
+    }
+    weight_in_block[block] += weight;
+  }
+
+  void clear() {
+    for ( const PartitionID block : adjacent_blocks ) {
+      weight_in_block[block] = 0;
+    }
+    adjacent_blocks.clear();
+  }
+
+  vec<HyperedgeWeight> weight_in_block;
+  vec<PartitionID> adjacent_blocks;
+};
+
+// ! Returns the weight of all incident nets of u and collects the weight of
+// ! the incident nets that contain an (assigned) pin of each block
+HyperedgeWeight collectIncidentWeights(const PartitionedHypergraph& phg,
+                                       const HypernodeID u,
+                                       IncidentWeights& incident_weights) {
+  HyperedgeWeight total_weight = 0;
+  for ( const HyperedgeID& he : phg.incidentEdges(u) ) {
+    const HyperedgeWeight edge_weight = phg.edgeWeight(he);
+    total_weight += edge_weight;
+    for ( const PartitionID& block : phg.connectivitySet(he) ) {
+      incident_weights.add(block, edge_weight);
+    }
+  }
+  return total_weight;
+}
+
+// ! Lazy min-heap over the block weights. Outdated entries are
+// ! skipped as long as the block weights only increase.
+class LightestBlock {
+  using Entry = std::pair<HypernodeWeight, PartitionID>;
+
+ public:
+  explicit LightestBlock(const PartitionedHypergraph& phg) :
+    _phg(phg),
+    _pq() {
+    rebuild();
+  }
+
+  void rebuild() {
+    vec<Entry> entries;
+    for ( PartitionID block = 0; block < _phg.k(); ++block ) {
+      entries.emplace_back(_phg.partWeight(block), block);
+    }
+    _pq = PQ(std::greater<Entry>(), std::move(entries));
+  }
+
+  void update(const PartitionID block) {
+    _pq.emplace(_phg.partWeight(block), block);
+  }
+
+  PartitionID top() {
+    while ( _pq.top().first != _phg.partWeight(_pq.top().second) ) {
+      _pq.pop();
+    }
+    return _pq.top().second;
+  }
+
+ private:
+  using PQ = std::priority_queue<Entry, vec<Entry>, std::greater<Entry>>;
+
+  const PartitionedHypergraph& _phg;
+  PQ _pq;
+};
+
+double fennelAlpha(const PartitionedHypergraph& phg) {
+  tbb::enumerable_thread_specific<HyperedgeWeight> local_edge_weight(0);
+  phg.doParallelForAllEdges([&](const HyperedgeID& he) {
+    local_edge_weight.local() += phg.edgeWeight(he);
+  });
+  HyperedgeWeight total_edge_weight = local_edge_weight.combine(std::plus<HyperedgeWeight>());
+  if ( PartitionedHypergraph::is_graph ) {
+    total_edge_weight /= 2;
+  }
+  const double total_node_weight = std::max(phg.totalWeight(), HypernodeWeight(1));
+  return std::sqrt(static_cast<double>(phg.k())) *
+    static_cast<double>(total_edge_weight) / std::pow(total_node_weight, GAMMA);
+}
+
+// ! Assigns u to the block that maximizes the Fennel objective
+// ! (incident net weight in the block minus the balance penalty)
+PartitionID assignVertex(PartitionedHypergraph& phg,
+                         const Context& context,
+                         const HypernodeID u,
+                         const double alpha,
+                         LightestBlock& lightest_block,
+                         IncidentWeights& incident_weights) {
+  collectIncidentWeights(phg, u, incident_weights);
+  const HypernodeWeight weight = phg.nodeWeight(u);
+  auto score = [&](const PartitionID block) {
+    const double part_weight = phg.partWeight(block);
+    return incident_weights.weight_in_block[block] -
+      alpha * GAMMA * std::pow(part_weight, GAMMA - 1.0) * weight;
+  };
+  auto fits = [&](const PartitionID block) {
+    return phg.partWeight(block) + weight <= context.partition.max_part_weights[block];
+  };
+
+  // Among all non-adjacent blocks, the lightest has the best score
+  const PartitionID lightest = lightest_block.top();
+  PartitionID best_block = fits(lightest) ? lightest : kInvalidPartition;
+  double best_score = best_block != kInvalidPartition ?
+    score(lightest) : std::numeric_limits<double>::lowest();
+  for ( const PartitionID block : incident_weights.adjacent_blocks ) {
+    const double block_score = score(block);
+    if ( fits(block) && block_score > best_score ) {
+      best_block = block;
+      best_score = block_score;
+    }
+  }
+  incident_weights.clear();
+
+  if ( best_block == kInvalidPartition ) {
+    // No block can take the vertex without violating the balance constraint
+    best_block = lightest;
+  }
+  phg.setNodePart(u, best_block);
+  lightest_block.update(best_block);
+  return best_block;
+}
+
+// ! Label propagation restricted to the vertices of the buffer. Returns the number of moved vertices.
+HypernodeID refineBuffer(PartitionedHypergraph& phg,
+                         const Context& context,
+                         const HypernodeID begin,
+                         const HypernodeID end,
+                         tbb::enumerable_thread_specific<IncidentWeights>& local_incident_weights) {
+  tbb::enumerable_thread_specific<HypernodeID> local_moved_vertices(0);
+  tbb::parallel_for(begin, end, [&](const HypernodeID u) {
+    if ( !phg.nodeIsEnabled(u) ) {
+      return;
+    }
+    IncidentWeights& incident_weights = local_incident_weights.local();
+    const PartitionID from = phg.partID(u);
+    HyperedgeWeight penalty = 0;
+    for ( const HyperedgeID& he : phg.incidentEdges(u) ) {
+      if ( phg.pinCountInPart(he, from) == 1 ) {
+        penalty += phg.edgeWeight(he);
+      }
+    }
+    const HyperedgeWeight total_weight = collectIncidentWeights(phg, u, incident_weights);
+
+    // Moving u to block 'to' removes 'from' from all nets where u is the only pin in 'from'
+    // and adds 'to' to all nets that have no pin in 'to' (km1 gain)
+    const HypernodeWeight weight = phg.nodeWeight(u);
+    PartitionID best_block = kInvalidPartition;
+    Gain best_gain = 0;
+    for ( const PartitionID to : incident_weights.adjacent_blocks ) {
+      const Gain gain = penalty - (total_weight - incident_weights.weight_in_block[to]);
+      if ( to != from && gain > best_gain &&
+           phg.partWeight(to) + weight <= context.partition.max_part_weights[to] ) {
+        best_block = to;
+        best_gain = gain;
+      }
+    }
+    incident_weights.clear();
+
+    if ( best_block != kInvalidPartition &&
+         phg.changeNodePart(u, from, best_block,
+           context.partition.max_part_weights[best_block], []{}, NoOpDeltaFunc()) ) {
+      ++local_moved_vertices.local();
+    }
+  });
+  return local_moved_vertices.combine(std::plus<HypernodeID>());
+}
+
+} // namespace
+
+PartitionedHypergraph partition(Hypergraph& hypergraph, const Context& context) {
+  PartitionedHypergraph partitioned_hypergraph(
+    context.partition.k, hypergraph, parallel_tag_t());
+  partition(partitioned_hypergraph, context);
+  return partitioned_hypergraph;
+}
+
+void partition(PartitionedHypergraph& phg, const Context& context) {
+  ASSERT(context.partition.streaming_buffer_size > 0);
+  utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
+  timer.start_timer("streaming", "Streaming Partitioning");
+
+  const double alpha = fennelAlpha(phg);
+  const HypernodeID num_nodes = phg.initialNumNodes();
+  const HypernodeID buffer_size = context.partition.streaming_buffer_size;
+  IncidentWeights incident_weights(phg.k());
+  tbb::enumerable_thread_specific<IncidentWeights> local_incident_weights(phg.k());
+  LightestBlock lightest_block(phg);
+  HypernodeID num_moved_vertices = 0;
+  for ( HypernodeID begin = 0; begin < num_nodes; begin += buffer_size ) {
+    const HypernodeID end = std::min(begin + buffer_size, num_nodes);
+    for ( HypernodeID u = begin; u < end; ++u ) {
+      if ( phg.nodeIsEnabled(u) && phg.partID(u) == kInvalidPartition ) {
+        assignVertex(phg, context, u, alpha, lightest_block, incident_weights);
+      }
+    }
+
+    if ( context.partition.streaming_refinement_rounds > 0 ) {
+      for ( size_t round = 0; round < context.partition.streaming_refinement_rounds; ++round ) {
+        const HypernodeID moved_vertices = refineBuffer(phg, context, begin, end, local_incident_weights);
+        num_moved_vertices += moved_vertices;
+        if ( moved_vertices == 0 ) {
+          break;
+        }
+      }
+      lightest_block.rebuild();
+    }
+  }
+
+  DBG << "Streaming partitioning with" << V(alpha) << V(buffer_size)
+      << "moved" << num_moved_vertices << "vertices during buffer refinement";
+  timer.stop_timer("streaming");
+}
+
+}  // namespace streaming
+}  // namespace mt_kahypar
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace mt_kahypar {
+namespace utils {
+
+/*!
+ * Cooperative cancellation of a partitioning run. The token is shared by all
+ * copies of a context (see Context::isCancelled()). The partitioner polls it at
+ * points where the partition is consistent: initial partitioning stops
+ * scheduling further runs, the refiners stop after their current round and
+ * no further V-cycles are started. Coarsening is not interrupted, since a
+ * small coarsest hypergraph is required for fast initial partitioning. The partition of the current level is still
+ * projected to the input hypergraph, such that a cancelled run returns the
+ * best partition found so far.
+ */
+class CancellationToken {
+
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr int64_t NO_DEADLINE = std::numeric_limits<int64_t>::max();
+
+ public:
+  CancellationToken() :
+    _cancelled(false),
+    _deadline(NO_DEADLINE) { }
+
+  CancellationToken(const CancellationToken&) = delete;
+  CancellationToken(CancellationToken&&) = delete;
+  CancellationToken & operator= (const CancellationToken &) = delete;
+  CancellationToken & operator= (CancellationToken &&) = delete;
+
+  void cancel() {
+    _cancelled.store(true, std::memory_order_relaxed);
+  }
+
+  // ! The token is cancelled once the deadline is reached. If a deadline
+  // ! was already set, the earlier one is kept.
+  void setDeadline(const Clock::time_point deadline) {
+    const int64_t ticks = deadline.time_since_epoch().count();
+    int64_t current = _deadline.load(std::memory_order_relaxed);
+    while ( ticks < current && !_deadline.compare_exchange_weak(
+              current, ticks, std::memory_order_relaxed) ) { }
+  }
+
+  void setTimeLimit(const double seconds) {
+    setDeadline(Clock::now() + std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(seconds)));
+  }
+
+  bool isCancelled() const {
+    if ( _cancelled.load(std::memory_order_relaxed) ) {
+      return true;
+    }
+    const int64_t deadline = _deadline.load(std::memory_order_relaxed);
+    if ( deadline != NO_DEADLINE && Clock::now().time_since_epoch().count() >= deadline ) {
+      _cancelled.store(true, std::memory_order_relaxed);
+      return true;
+    }
+    return false;
+  }
+
+ private:
+  mutable std::atomic<bool> _cancelled;
+  // ! Ticks of the deadline since the epoch of the steady clock
+  std::atomic<int64_t> _deadline;
+};
+
+}  // namespace utils
+}  // namespace mt_kahypar
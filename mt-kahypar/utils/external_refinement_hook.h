@@ -0,0 +1,99 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+#include "mt-kahypar/datastructures/hypergraph_common.h"
+
+namespace mt_kahypar {
+namespace utils {
+
+/*!
+ * Read-only view of the (hyper)graph and the partition on the current level of the
+ * uncoarsening phase that is passed to an external refiner. The partition points
+ * directly into the partitioned hypergraph and pin counts are queried from it. The
+ * incidence structure is stored in CSR format with 64-bit IDs such that it can be
+ * passed through the C interface without conversion. All pointers are only valid
+ * during the callback.
+ */
+struct ExternalRefinementLevel {
+  // ! Current level of the multilevel hierarchy (0 = input hypergraph)
+  size_t level = 0;
+  size_t num_levels = 0;
+  PartitionID k = 0;
+  uint64_t num_nodes = 0;
+  uint64_t num_edges = 0;
+  // ! Pins of hyperedge e are pins[hyperedge_indices[e]] ... pins[hyperedge_indices[e + 1] - 1]
+  const size_t* hyperedge_indices = nullptr;
+  const uint64_t* pins = nullptr;
+  // ! Incident nets of node u are incident_nets[incident_net_indices[u]] ... incident_nets[incident_net_indices[u + 1] - 1]
+  const size_t* incident_net_indices = nullptr;
+  const uint64_t* incident_nets = nullptr;
+  const HypernodeWeight* node_weights = nullptr;
+  const HyperedgeWeight* edge_weights = nullptr;
+  // ! Block of each node (kInvalidPartition for disabled nodes)
+  const PartitionID* part_ids = nullptr;
+  const HypernodeWeight* block_weights = nullptr;
+  const HypernodeWeight* max_block_weights = nullptr;
+  // ! Returns the number of pins of a hyperedge in a block (reads the pin counts of the partitioned hypergraph)
+  HypernodeID (*pin_count_in_part)(const void* partitioned_hg, const HyperedgeID he, const PartitionID block) = nullptr;
+  const void* partitioned_hg = nullptr;
+};
+
+/*!
+ * Calls a user-defined refiner on each level of the uncoarsening phase of the main
+ * context (after the built-in refiners). The callback writes the moves it wants to
+ * perform into 'nodes' and 'blocks' (at most num_nodes moves, each node at most once)
+ * and returns the number of moves. The moves are then applied by the partitioner
+ * (see ExternalRefiner). As the hook is shared by all copies of a context, it is
+ * only called for the main context.
+ */
+class ExternalRefinementHook {
+
+ public:
+  using Callback = std::function<size_t(const ExternalRefinementLevel&, uint64_t* nodes, PartitionID* blocks)>;
+
+  explicit ExternalRefinementHook(Callback callback) :
+    _callback(std::move(callback)) { }
+
+  ExternalRefinementHook(const ExternalRefinementHook&) = delete;
+  ExternalRefinementHook(ExternalRefinementHook&&) = delete;
+  ExternalRefinementHook & operator= (const ExternalRefinementHook &) = delete;
+  ExternalRefinementHook & operator= (ExternalRefinementHook &&) = delete;
+
+  size_t refine(const ExternalRefinementLevel& level, uint64_t* nodes, PartitionID* blocks) const {
+    return _callback(level, nodes, blocks);
+  }
+
+ private:
+  Callback _callback;
+};
+
+}  // namespace utils
+}  // namespace mt_kahypar
@@ -0,0 +1,249 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#undef __TBB_ARENA_OBSERVER
+#define __TBB_ARENA_OBSERVER true
+#include "tbb/task_scheduler_observer.h"
+#undef __TBB_ARENA_OBSERVER
+
+#include "mt-kahypar/macros.h"
+
+namespace mt_kahypar {
+namespace utils {
+
+enum class HardwareCounter : uint8_t {
+  cycles,
+  llc_misses,
+  branch_misses,
+  remote_numa_accesses,
+  NUM_HARDWARE_COUNTERS
+};
+
+static constexpr size_t NUM_HARDWARE_COUNTERS =
+  static_cast<size_t>(HardwareCounter::NUM_HARDWARE_COUNTERS);
+
+// ! Values of all hardware counters at a given point in time (or the difference
+// ! between two points in time)
+struct HardwareCounterValues {
+  HardwareCounterValues() :
+    values() {
+    values.fill(0);
+  }
+
+  uint64_t operator[] (const HardwareCounter counter) const {
+    return values[static_cast<size_t>(counter)];
+  }
+
+  HardwareCounterValues& operator+= (const HardwareCounterValues& other) {
+    for ( size_t i = 0; i < NUM_HARDWARE_COUNTERS; ++i ) {
+      values[i] += other.values[i];
+    }
+    return *this;
+  }
+
+  HardwareCounterValues operator- (const HardwareCounterValues& other) const {
+    HardwareCounterValues diff;
+    for ( size_t i = 0; i < NUM_HARDWARE_COUNTERS; ++i ) {
+      // Counters of threads that are registered after the start value
+      // was taken can make the difference negative for a short period
+      diff.values[i] = values[i] >= other.values[i] ? values[i] - other.values[i] : 0;
+    }
+    return diff;
+  }
+
+  std::array<uint64_t, NUM_HARDWARE_COUNTERS> values;
+};
+
+/**
+ * Measures cycles, last-level cache misses, branch mispredictions and accesses to
+ * memory of a remote NUMA node via the perf_event interface of the linux kernel.
+ * The counters are opened for each thread that joins the global task arena (and
+ * for the thread that activates the counters). Reading the counters returns the sum
+ * over all measured threads, which makes the values only meaningful for phases
+ * that are started and stopped from a sequential context.
+ * Counters that are not supported by the hardware (or if the access to the
+ * performance monitoring unit is restricted via perf_event_paranoid) are marked
+ * as unavailable and always report zero.
+ */
+class HardwareCounters : public tbb::task_scheduler_observer {
+
+  using Base = tbb::task_scheduler_observer;
+  using CounterFileDescriptors = std::array<int, NUM_HARDWARE_COUNTERS>;
+
+ public:
+  HardwareCounters() :
+    Base(),
+    _mutex(),
+    _is_available(),
+    _registered_threads(),
+    _fds() {
+    _is_available.fill(false);
+  }
+
+  HardwareCounters(const HardwareCounters&) = delete;
+  HardwareCounters & operator= (const HardwareCounters &) = delete;
+
+  HardwareCounters(HardwareCounters&&) = delete;
+  HardwareCounters & operator= (HardwareCounters &&) = delete;
+
+  ~HardwareCounters() {
+    observe(false);
+    #ifdef __linux__
+    for ( const CounterFileDescriptors& fds : _fds ) {
+      for ( const int fd : fds ) {
+        if ( fd != -1 ) {
+          close(fd);
+        }
+      }
+    }
+    #endif
+  }
+
+  // ! Opens the counters for the calling thread and all threads that
+  // ! join the global task arena afterwards. Returns false, if none of the
+  // ! counters is supported on this machine.
+  bool activate() {
+    registerCurrentThread();
+    if ( isAvailable() ) {
+      observe(true);
+    }
+    return isAvailable();
+  }
+
+  bool isAvailable() const {
+    for ( const bool is_available : _is_available ) {
+      if ( is_available ) return true;
+    }
+    return false;
+  }
+
+  bool isAvailable(const HardwareCounter counter) const {
+    return _is_available[static_cast<size_t>(counter)];
+  }
+
+  // ! Returns the sum of the counters over all registered threads
+  HardwareCounterValues read() {
+    HardwareCounterValues counters;
+    #ifdef __linux__
+    std::lock_guard<std::mutex> lock(_mutex);
+    for ( const CounterFileDescriptors& fds : _fds ) {
+      for ( size_t i = 0; i < NUM_HARDWARE_COUNTERS; ++i ) {
+        uint64_t value = 0;
+        if ( fds[i] != -1 && ::read(fds[i], &value, sizeof(uint64_t)) == sizeof(uint64_t) ) {
+          counters.values[i] += value;
+        }
+      }
+    }
+    #endif
+    return counters;
+  }
+
+  void on_scheduler_entry(bool) override {
+    registerCurrentThread();
+  }
+
+  static const char* name(const HardwareCounter counter) {
+    switch ( counter ) {
+      case HardwareCounter::cycles: return "cycles";
+      case HardwareCounter::llc_misses: return "llc_misses";
+      case HardwareCounter::branch_misses: return "branch_misses";
+      case HardwareCounter::remote_numa_accesses: return "remote_numa_accesses";
+      case HardwareCounter::NUM_HARDWARE_COUNTERS: break;
+    }
+    return "UNDEFINED";
+  }
+
+ private:
+  void registerCurrentThread() {
+    #ifdef __linux__
+    const pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+    std::lock_guard<std::mutex> lock(_mutex);
+    if ( _registered_threads.insert(tid).second ) {
+      CounterFileDescriptors fds;
+      for ( size_t i = 0; i < NUM_HARDWARE_COUNTERS; ++i ) {
+        fds[i] = openCounter(static_cast<HardwareCounter>(i), tid);
+        _is_available[i] = _is_available[i] || fds[i] != -1;
+      }
+      _fds.push_back(fds);
+    }
+    #endif
+  }
+
+  #ifdef __linux__
+  static int openCounter(const HardwareCounter counter, const pid_t tid) {
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(struct perf_event_attr));
+    attr.size = sizeof(struct perf_event_attr);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    switch ( counter ) {
+      case HardwareCounter::cycles:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+      case HardwareCounter::llc_misses:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+      case HardwareCounter::branch_misses:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+      case HardwareCounter::remote_numa_accesses:
+        // Misses in the local NUMA node are served by a remote NUMA node
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_NODE |
+          (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+      case HardwareCounter::NUM_HARDWARE_COUNTERS: return -1;
+    }
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0));
+  }
+  #endif
+
+  std::mutex _mutex;
+  std::array<bool, NUM_HARDWARE_COUNTERS> _is_available;
+  std::unordered_set<int> _registered_threads;
+  std::vector<CounterFileDescriptors> _fds;
+};
+
+}  // namespace utils
+}  // namespace mt_kahypar
@@ -26,11 +26,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include <random>
 #include <type_traits>
 
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
 
 namespace mt_kahypar::hashing {
 
@@ -136,6 +143,107 @@ template<typename T> T hash(T x) {
 
 } // namespace integer
 
+namespace set {
+
+// per-element mix of the set footprint (lowbias32), each step has a SIMD counterpart
+inline uint32_t mix32(uint32_t x) {
+  x ^= x >> 16;
+  x *= 0x7feb352d;
+  x ^= x >> 15;
+  x *= 0x846ca68b;
+  x ^= x >> 16;
+  return x;
+}
+
+#if defined(__AVX2__)
+inline __m256i mix32(__m256i x) {
+  x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+  x = _mm256_mullo_epi32(x, _mm256_set1_epi32(0x7feb352d));
+  x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 15));
+  x = _mm256_mullo_epi32(x, _mm256_set1_epi32(static_cast<int>(0x846ca68b)));
+  return _mm256_xor_si256(x, _mm256_srli_epi32(x, 16));
+}
+#elif defined(__SSE4_1__)
+inline __m128i mix32(__m128i x) {
+  x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+  x = _mm_mullo_epi32(x, _mm_set1_epi32(0x7feb352d));
+  x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+  x = _mm_mullo_epi32(x, _mm_set1_epi32(static_cast<int>(0x846ca68b)));
+  return _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+}
+#endif
+
+/*!
+ * Computes an order-independent footprint of a set of integers (e.g., the pins of a net).
+ * The footprint is the sum of the mixed elements, combined with the size and the
+ * minimum element of the set. For 32-bit elements, the sum and the minimum are computed
+ * with 8 (AVX2) or 4 (SSE4.1) elements per instruction. Equal sets always have
+ * equal footprints, regardless of the instruction set used.
+ */
+template<typename T>
+inline uint64_t footprint(const T* elements, const size_t size) {
+  static_assert(std::is_unsigned_v<T>, "set footprint is only intended for unsigned integers");
+  if constexpr ( sizeof(T) == 4 ) {
+    uint32_t sum = 0;
+    uint32_t min = std::numeric_limits<uint32_t>::max();
+    size_t i = 0;
+    #if defined(__AVX2__)
+    constexpr size_t LANES = 8;
+    if ( size >= LANES ) {
+      __m256i vsum = _mm256_setzero_si256();
+      __m256i vmin = _mm256_set1_epi32(-1);
+      for ( ; i + LANES <= size; i += LANES ) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(elements + i));
+        vmin = _mm256_min_epu32(vmin, x);
+        vsum = _mm256_add_epi32(vsum, mix32(x));
+      }
+      alignas(32) uint32_t lane_sum[LANES];
+      alignas(32) uint32_t lane_min[LANES];
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lane_sum), vsum);
+      _mm256_store_si256(reinterpret_cast<__m256i*>(lane_min), vmin);
+      for ( size_t l = 0; l < LANES; ++l ) {
+        sum += lane_sum[l];
+        min = std::min(min, lane_min[l]);
+      }
+    }
+    #elif defined(__SSE4_1__)
+    constexpr size_t LANES = 4;
+    if ( size >= LANES ) {
+      __m128i vsum = _mm_setzero_si128();
+      __m128i vmin = _mm_set1_epi32(-1);
+      for ( ; i + LANES <= size; i += LANES ) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(elements + i));
+        vmin = _mm_min_epu32(vmin, x);
+        vsum = _mm_add_epi32(vsum, mix32(x));
+      }
+      alignas(16) uint32_t lane_sum[LANES];
+      alignas(16) uint32_t lane_min[LANES];
+      _mm_store_si128(reinterpret_cast<__m128i*>(lane_sum), vsum);
+      _mm_store_si128(reinterpret_cast<__m128i*>(lane_min), vmin);
+      for ( size_t l = 0; l < LANES; ++l ) {
+        sum += lane_sum[l];
+        min = std::min(min, lane_min[l]);
+      }
+    }
+    #endif
+    for ( ; i < size; ++i ) {
+      sum += mix32(elements[i]);
+      min = std::min(min, static_cast<uint32_t>(elements[i]));
+    }
+    return integer::combine64(integer::hash64((static_cast<uint64_t>(min) << 32) | size), sum);
+  } else {
+    uint64_t sum = 0;
+    T min = std::numeric_limits<T>::max();
+    for ( size_t i = 0; i < size; ++i ) {
+      sum += integer::hash64_2(elements[i]);
+      min = std::min(min, elements[i]);
+    }
+    return integer::combine64(integer::hash64(integer::combine64(min, size)), sum);
+  }
+}
+
+} // namespace set
+
 
 // from thrill
 
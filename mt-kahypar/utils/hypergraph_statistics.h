@@ -25,11 +25,14 @@
  * SOFTWARE.
  ******************************************************************************/
 
+#include <cmath>
 #include <vector>
 
+#include "tbb/enumerable_thread_specific.h"
 #include "tbb/parallel_reduce.h"
 
 #include "mt-kahypar/definitions.h"
+#include "mt-kahypar/utils/hash.h"
 
 
 namespace mt_kahypar {
@@ -72,5 +75,70 @@ static inline double avgHypernodeDegree(const Hypergraph& hypergraph) {
     return static_cast<double>(hypergraph.initialNumPins()) / hypergraph.initialNumNodes();
 }
 
+// ! Parallel hash of the enabled vertices and hyperedges including their weights.
+// ! The hash of a hyperedge does not depend on the order of its pins and the
+// ! hashes of all hyperedges are summed up, which makes it independent of the
+// ! order in which they are processed.
+static inline uint64_t hypergraphFingerprint(const Hypergraph& hypergraph) {
+    using namespace hashing::integer;
+    const uint64_t edge_hash_sum = tbb::parallel_reduce(tbb::blocked_range<HyperedgeID>(
+      ID(0), hypergraph.initialNumEdges()), UL(0), [&](const tbb::blocked_range<HyperedgeID>& range, uint64_t sum) {
+      for ( HyperedgeID he = range.begin(); he < range.end(); ++he ) {
+        if ( hypergraph.edgeIsEnabled(he) ) {
+          uint64_t pin_hash_sum = 0;
+          for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+            pin_hash_sum += hash64(pin);
+          }
+          sum += hash64(combine64(combine64(hash64(he), pin_hash_sum),
+            hash64(hypergraph.edgeWeight(he))));
+        }
+      }
+      return sum;
+    }, std::plus<uint64_t>());
+    const uint64_t node_hash_sum = tbb::parallel_reduce(tbb::blocked_range<HypernodeID>(
+      ID(0), hypergraph.initialNumNodes()), UL(0), [&](const tbb::blocked_range<HypernodeID>& range, uint64_t sum) {
+      for ( HypernodeID hn = range.begin(); hn < range.end(); ++hn ) {
+        if ( hypergraph.nodeIsEnabled(hn) ) {
+          sum += hash64(combine64(hash64(hn), hash64(hypergraph.nodeWeight(hn))));
+        }
+      }
+      return sum;
+    }, std::plus<uint64_t>());
+    uint64_t fingerprint = hash64(hypergraph.initialNumNodes());
+    for ( const uint64_t value : { static_cast<uint64_t>(hypergraph.initialNumEdges()),
+                                   edge_hash_sum, node_hash_sum } ) {
+      fingerprint = combine64(fingerprint, hash64(value));
+    }
+    return fingerprint;
+}
+
+// ! Returns the p-th percentile (0 <= p <= 100) of a sorted vector
+template<typename T>
+T percentile(const std::vector<T>& sorted_data, const double p) {
+    ASSERT(!sorted_data.empty() && p >= 0.0 && p <= 100.0);
+    return sorted_data[std::ceil(p / 100.0 * (sorted_data.size() - 1))];
+}
+
+// ! Returns the number of hyperedges with connectivity i for each 0 <= i <= k
+static inline std::vector<HyperedgeID> connectivityHistogram(const PartitionedHypergraph& phg) {
+    tbb::enumerable_thread_specific<std::vector<HyperedgeID>> local_histogram(phg.k() + 1, 0);
+    phg.doParallelForAllEdges([&](const HyperedgeID& he) {
+      ++local_histogram.local()[phg.connectivity(he)];
+    });
+    std::vector<HyperedgeID> histogram(phg.k() + 1, 0);
+    for ( const std::vector<HyperedgeID>& local : local_histogram ) {
+      for ( size_t i = 0; i < histogram.size(); ++i ) {
+        histogram[i] += local[i];
+      }
+    }
+    if ( Hypergraph::is_graph ) {
+      // Each undirected edge is represented by two directed edges
+      for ( HyperedgeID& count : histogram ) {
+        count /= 2;
+      }
+    }
+    return histogram;
+}
+
 } // namespace utils
 } // namespace mt_kahypar
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "mt-kahypar/macros.h"
+
+namespace mt_kahypar {
+namespace utils {
+
+/**
+ * Records per-level statistics of the multilevel uncoarsening phase: the size of
+ * the hypergraph on each level and the objective before and after each refiner run.
+ */
+class LevelStats {
+
+ public:
+  struct RefinerRun {
+    std::string refiner;
+    int64_t objective_before;
+    int64_t objective_after;
+    double seconds;
+  };
+
+  struct Level {
+    int level;
+    uint64_t num_nodes;
+    uint64_t num_edges;
+    uint64_t num_pins;
+    std::vector<RefinerRun> refiner_runs;
+  };
+
+  explicit LevelStats() :
+    _mutex(),
+    _levels(),
+    _enable(true) { }
+
+  LevelStats(const LevelStats& other) :
+    _mutex(),
+    _levels(other._levels),
+    _enable(other._enable) { }
+
+  LevelStats & operator= (const LevelStats &) = delete;
+
+  LevelStats(LevelStats&& other) :
+    _mutex(),
+    _levels(std::move(other._levels)),
+    _enable(other._enable) { }
+
+  LevelStats & operator= (LevelStats &&) = delete;
+
+  void enable() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _enable = true;
+  }
+
+  void disable() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _enable = false;
+  }
+
+  void startLevel(const int level,
+                  const uint64_t num_nodes,
+                  const uint64_t num_edges,
+                  const uint64_t num_pins) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if ( _enable ) {
+      _levels.push_back(Level { level, num_nodes, num_edges, num_pins, { } });
+    }
+  }
+
+  // ! Adds a refiner run to the most recently started level
+  void addRefinerRun(const std::string& refiner,
+                     const int64_t objective_before,
+                     const int64_t objective_after,
+                     const double seconds) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if ( _enable && !_levels.empty() ) {
+      _levels.back().refiner_runs.push_back(
+        RefinerRun { refiner, objective_before, objective_after, seconds });
+    }
+  }
+
+  const std::vector<Level>& levels() const {
+    return _levels;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _levels.clear();
+  }
+
+  void serializeJSON(std::ostream& str) const {
+    str << "[";
+    for ( size_t i = 0; i < _levels.size(); ++i ) {
+      const Level& level = _levels[i];
+      str << (i == 0 ? "" : ",") << "{\"level\":" << level.level
+          << ",\"num_nodes\":" << level.num_nodes
+          << ",\"num_edges\":" << level.num_edges
+          << ",\"num_pins\":" << level.num_pins
+          << ",\"refiners\":[";
+      for ( size_t j = 0; j < level.refiner_runs.size(); ++j ) {
+        const RefinerRun& run = level.refiner_runs[j];
+        str << (j == 0 ? "" : ",") << "{\"refiner\":\"" << run.refiner
+            << "\",\"objective_before\":" << run.objective_before
+            << ",\"objective_after\":" << run.objective_after
+            << ",\"seconds\":" << run.seconds << "}";
+      }
+      str << "]}";
+    }
+    str << "]";
+  }
+
+ private:
+  std::mutex _mutex;
+  std::vector<Level> _levels;
+  bool _enable;
+};
+
+}  // namespace utils
+}  // namespace mt_kahypar
@@ -62,6 +62,16 @@ namespace mt_kahypar::utils {
     }
   }
 
+  void MemoryTreeNode::serializeJSON(std::ostream& str) const {
+    str << "{\"name\":\"" << _name << "\",\"bytes\":" << _size_in_bytes << ",\"children\":[";
+    bool first = true;
+    for ( const auto& child : _children ) {
+      str << (first ? "" : ",");
+      child.second->serializeJSON(str);
+      first = false;
+    }
+    str << "]}";
+  }
 
   std::string serialize_in_bytes(const size_t size_in_bytes) {
     std::stringstream ss;
@@ -54,6 +54,14 @@ class MemoryTreeNode {
 
   void finalize();
 
+  size_t sizeInBytes() const {
+    return _size_in_bytes;
+  }
+
+  // ! Writes the tree as JSON object with the name, the size in bytes
+  // ! and the children of each node (must be called after finalize())
+  void serializeJSON(std::ostream& str) const;
+
  private:
 
   void dfs(std::ostream& str, const size_t parent_size_in_bytes, int level) const ;
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+#include "mt-kahypar/datastructures/hypergraph_common.h"
+
+namespace mt_kahypar {
+namespace utils {
+
+enum class ProgressPhase : uint8_t {
+  coarsening,
+  initial_partitioning,
+  refinement,
+  vcycle,
+  finished
+};
+
+struct ProgressUpdate {
+  ProgressPhase phase = ProgressPhase::coarsening;
+  // ! Number of the current V-cycle (0 = initial multilevel cycle)
+  size_t vcycle = 0;
+  // ! Current level of the multilevel hierarchy during refinement (0 = input hypergraph)
+  size_t level = 0;
+  size_t num_levels = 0;
+  // ! Objective and imbalance of the current partition (-1, if there is no partition yet)
+  HyperedgeWeight objective = -1;
+  double imbalance = -1.0;
+  // ! Seconds since the start of the partitioning run
+  double elapsed_seconds = 0.0;
+};
+
+/*!
+ * Reports phase transitions and the metrics of the current partition after each
+ * level of the uncoarsening phase to a user-defined callback. The callback can
+ * request to stop the run by returning false (e.g., if the partition is good
+ * enough or the improvement rate flattens). As the reporter is shared by all
+ * copies of a context, only updates of the main context are reported (see
+ * Context::reportProgress(...)).
+ */
+class ProgressReporter {
+
+  using Clock = std::chrono::steady_clock;
+
+ public:
+  using Callback = std::function<bool(const ProgressUpdate&)>;
+
+  explicit ProgressReporter(Callback callback) :
+    _callback(std::move(callback)),
+    _start(Clock::now()),
+    _vcycle(0) { }
+
+  ProgressReporter(const ProgressReporter&) = delete;
+  ProgressReporter(ProgressReporter&&) = delete;
+  ProgressReporter & operator= (const ProgressReporter &) = delete;
+  ProgressReporter & operator= (ProgressReporter &&) = delete;
+
+  // ! Called at the beginning of each partitioning run
+  void start() {
+    _start = Clock::now();
+    _vcycle = 0;
+  }
+
+  // ! Returns false, if the callback requests to stop the run
+  bool report(ProgressUpdate update) {
+    if ( update.phase == ProgressPhase::vcycle ) {
+      _vcycle = update.vcycle;
+    }
+    update.vcycle = _vcycle;
+    update.elapsed_seconds = std::chrono::duration<double>(Clock::now() - _start).count();
+    return _callback(update);
+  }
+
+ private:
+  Callback _callback;
+  Clock::time_point _start;
+  size_t _vcycle;
+};
+
+}  // namespace utils
+}  // namespace mt_kahypar
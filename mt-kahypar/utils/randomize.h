@@ -27,7 +27,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <istream>
 #include <limits>
+#include <ostream>
 #include <random>
 #include <thread>
 #include <vector>
@@ -41,9 +45,53 @@
 
 namespace mt_kahypar::utils {
 
+// ! Counter-based random number generator: returns the i-th random number of the
+// ! stream defined by the seed (SplitMix64 finalizer on the seeded counter). The
+// ! result only depends on its arguments. Thus, random numbers can be generated in
+// ! parallel without any state and independent of the number of threads.
+inline uint64_t counterBasedRandom(const uint64_t seed, const uint64_t i) {
+  auto mix = [](uint64_t z) {
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    return z ^ (z >> 31);
+  };
+  return mix(mix(seed) + (i + 1) * UINT64_C(0x9E3779B97F4A7C15));
+}
+
+// ! UniformRandomBitGenerator on top of counterBasedRandom(...). In contrast to
+// ! std::mt19937 (5 KB of state), it is cheap to construct one generator per block
+// ! of a parallel loop, which makes the results independent of the scheduling.
+class CounterBasedRNG {
+ public:
+  using result_type = uint64_t;
+
+  CounterBasedRNG(const uint64_t seed, const uint64_t stream) :
+    _key(counterBasedRandom(seed, stream)),
+    _counter(0) { }
+
+  static constexpr result_type min() {
+    return std::numeric_limits<result_type>::min();
+  }
+
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  result_type operator()() {
+    return counterBasedRandom(_key, _counter++);
+  }
+
+ private:
+  uint64_t _key;
+  uint64_t _counter;
+};
+
 class Randomize {
   static constexpr bool debug = false;
-  static constexpr size_t PRECOMPUTED_FLIP_COINS = 128;
+  // ! Number of blocks of parallelShuffleVector(...). It does not depend on the
+  // ! number of threads such that the permutation is independent of it.
+  static constexpr size_t NUM_PARALLEL_SHUFFLE_BLOCKS = 256;
+  static constexpr size_t MIN_PARALLEL_SHUFFLE_BLOCK_SIZE = 1024;
 
   using SwapBlock = std::pair<size_t, size_t>;
 
@@ -53,21 +101,24 @@ class Randomize {
       _seed(-1),
       _gen(),
       _next_coin_flip(0),
-      _precomputed_flip_coins(PRECOMPUTED_FLIP_COINS),
+      _coin_flips(0),
       _int_dist(0, std::numeric_limits<int>::max()),
       _float_dist(0, 1),
-      _norm_dist(0, 1) {
-      precompute_flip_coins();
-    }
+      _norm_dist(0, 1) { }
 
     void setSeed(int seed) {
       _seed = seed;
       _gen.seed(_seed);
-      precompute_flip_coins();
+      _next_coin_flip = 0;
     }
 
+    // ! Each counter-based random number provides 64 coin flips
     bool flipCoin() {
-      return _precomputed_flip_coins[++_next_coin_flip % PRECOMPUTED_FLIP_COINS];
+      const size_t bit = _next_coin_flip++ % 64;
+      if ( bit == 0 ) {
+        _coin_flips = counterBasedRandom(_seed, _next_coin_flip / 64);
+      }
+      return (_coin_flips >> bit) & 1;
     }
 
     // returns uniformly random int from the interval [low, high]
@@ -88,18 +139,21 @@ class Randomize {
       return _gen;
     }
 
-   private:
-    void precompute_flip_coins() {
-      std::uniform_int_distribution<int> bool_dist(0,1);
-      for (size_t i = 0; i < PRECOMPUTED_FLIP_COINS; ++i) {
-        _precomputed_flip_coins[i] = static_cast<bool>(bool_dist(_gen));
-      }
+    void serialize(std::ostream& out) const {
+      out << _seed << ' ' << _gen << ' ' << _next_coin_flip << ' ' << _coin_flips << ' '
+          << _int_dist << ' ' << _float_dist << ' ' << _norm_dist;
     }
 
+    bool deserialize(std::istream& in) {
+      in >> _seed >> _gen >> _next_coin_flip >> _coin_flips >> _int_dist >> _float_dist >> _norm_dist;
+      return static_cast<bool>(in);
+    }
+
+   private:
     int _seed;
     std::mt19937 _gen;
     size_t _next_coin_flip;
-    std::vector<bool> _precomputed_flip_coins;
+    uint64_t _coin_flips;
     std::uniform_int_distribution<int> _int_dist;
     std::uniform_real_distribution<float> _float_dist;
     std::normal_distribution<float> _norm_dist;
@@ -120,6 +174,8 @@ class Randomize {
     for (uint32_t i = 0; i < std::thread::hardware_concurrency(); ++i) {
       _rand[i].setSeed(seed + i);
     }
+    _seed = seed;
+    _num_parallel_shuffles.store(0, std::memory_order_relaxed);
   }
 
   bool flipCoin(int cpu_id) {
@@ -173,29 +229,43 @@ class Randomize {
     }
   }
 
+  // ! Shuffles the range [i, j) in parallel. The range is split into a fixed number of blocks,
+  // ! which are randomly matched. Each pair of blocks is swapped and both blocks are shuffled.
+  // ! The permutation only depends on the seed and the number of previous parallel shuffles,
+  // ! but not on the number of threads or the scheduling.
   template <typename T>
   void parallelShuffleVector(parallel::scalable_vector<T>& vector, const size_t i, const size_t j) {
     ASSERT(i <= j && j <= vector.size());
-    const size_t P = 2 * std::thread::hardware_concurrency();
+    const uint64_t seed = nextParallelShuffleSeed();
     const size_t N = j - i;
-    const size_t step = N / P;
 
     if ( _perform_localized_random_shuffle ) {
-      tbb::parallel_for(UL(0), P, [&](const size_t k) {
-        const size_t start = i + k * step;
-        const size_t end = i + (k == P - 1 ? N : (k + 1) * step);
-        localizedShuffleVector(vector, start, end, SCHED_GETCPU);
+      const size_t num_blocks = N / _localized_random_shuffle_block_size +
+        ( N % _localized_random_shuffle_block_size != 0 );
+      tbb::parallel_for(UL(0), num_blocks, [&](const size_t k) {
+        const size_t start = i + k * _localized_random_shuffle_block_size;
+        const size_t end = std::min(start + _localized_random_shuffle_block_size, j);
+        CounterBasedRNG rng(seed, k);
+        std::shuffle(vector.begin() + start, vector.begin() + end, rng);
       });
+    } else if ( N < 2 * MIN_PARALLEL_SHUFFLE_BLOCK_SIZE ) {
+      CounterBasedRNG rng(seed, 0);
+      std::shuffle(vector.begin() + i, vector.begin() + j, rng);
     } else {
+      // The number of blocks must be even such that all blocks can be matched
+      const size_t P = std::max(UL(2), std::min(NUM_PARALLEL_SHUFFLE_BLOCKS,
+        N / MIN_PARALLEL_SHUFFLE_BLOCK_SIZE) & ~UL(1));
+      const size_t step = N / P;
+
       // Compute blocks that should be swapped before
       // random shuffling
       parallel::scalable_vector<SwapBlock> swap_blocks;
       parallel::scalable_vector<bool> matched_blocks(P, false);
-      int cpu_id = SCHED_GETCPU;
+      CounterBasedRNG rng(seed, P);
       for ( size_t a = 0; a < P; ++a ) {
         if ( !matched_blocks[a] ) {
           matched_blocks[a] = true;
-          size_t b = getRandomInt(0, P - 1, cpu_id);
+          size_t b = rng() % P;
           while ( matched_blocks[b] ) {
             b = ( b + 1 ) % P;
           }
@@ -212,14 +282,33 @@ class Randomize {
         const size_t end_1 = i + (block_1 == P - 1 ? N : (block_1 + 1) * step);
         const size_t start_2 = i + block_2 * step;
         const size_t end_2 = i + (block_2 == P - 1 ? N : (block_2 + 1) * step);
-        const int cpu_id = SCHED_GETCPU;
+        CounterBasedRNG block_rng(seed, k);
         swapBlocks(vector, start_1, end_1, start_2, end_2);
-        std::shuffle(vector.begin() + start_1, vector.begin() + end_1, _rand[cpu_id].getGenerator());
-        std::shuffle(vector.begin() + start_2, vector.begin() + end_2, _rand[cpu_id].getGenerator());
+        std::shuffle(vector.begin() + start_1, vector.begin() + end_1, block_rng);
+        std::shuffle(vector.begin() + start_2, vector.begin() + end_2, block_rng);
       });
     }
   }
 
+  // ! Shuffles the elements within consecutive tiles of the given size in parallel.
+  // ! In contrast to parallelShuffleVector(...), elements are never moved to a different tile.
+  template <typename T>
+  void parallelTiledShuffleVector(parallel::scalable_vector<T>& vector,
+                                  const size_t i,
+                                  const size_t j,
+                                  const size_t tile_size) {
+    ASSERT(i <= j && j <= vector.size());
+    ASSERT(tile_size > 0);
+    const uint64_t seed = nextParallelShuffleSeed();
+    const size_t num_tiles = ( j - i ) / tile_size + ( ( j - i ) % tile_size != 0 );
+    tbb::parallel_for(UL(0), num_tiles, [&](const size_t tile) {
+      const size_t start = i + tile * tile_size;
+      const size_t end = std::min(start + tile_size, j);
+      CounterBasedRNG rng(seed, tile);
+      std::shuffle(vector.begin() + start, vector.begin() + end, rng);
+    });
+  }
+
   // returns uniformly random int from the interval [low, high]
   int getRandomInt(int low, int high, int cpu_id) {
     ASSERT(cpu_id < (int)std::thread::hardware_concurrency());
@@ -242,12 +331,56 @@ class Randomize {
     return _rand[cpu_id].getGenerator();
   }
 
+  // ! Writes the state of all random number generators to the stream
+  // ! such that a checkpointed run continues with the same random sequence
+  void serializeState(std::ostream& out) const {
+    const auto precision = out.precision(std::numeric_limits<double>::max_digits10);
+    out << _seed << ' ' << _num_parallel_shuffles.load(std::memory_order_relaxed) << ' ' << _rand.size();
+    for ( const RandomFunctions& rand : _rand ) {
+      out << ' ';
+      rand.serialize(out);
+    }
+    out.precision(precision);
+  }
+
+  // ! Restores the state written by serializeState(...). Returns false and leaves
+  // ! the current state untouched, if the state is invalid or was written on a
+  // ! machine with a different number of hardware threads.
+  bool deserializeState(std::istream& in) {
+    int seed = 0;
+    uint64_t num_parallel_shuffles = 0;
+    size_t num_generators = 0;
+    in >> seed >> num_parallel_shuffles >> num_generators;
+    if ( !in || num_generators != _rand.size() ) {
+      return false;
+    }
+    std::vector<RandomFunctions> rand(_rand);
+    for ( RandomFunctions& r : rand ) {
+      if ( !r.deserialize(in) ) {
+        return false;
+      }
+    }
+    _rand = std::move(rand);
+    _seed = seed;
+    _num_parallel_shuffles.store(num_parallel_shuffles, std::memory_order_relaxed);
+    return true;
+  }
+
  private:
   explicit Randomize() :
     _rand(std::thread::hardware_concurrency()),
+    _seed(-1),
+    _num_parallel_shuffles(0),
     _perform_localized_random_shuffle(false),
     _localized_random_shuffle_block_size(1024) { }
 
+  // ! Parallel shuffles are called from the top-level of the partitioner
+  // ! => the sequence of their seeds is deterministic
+  uint64_t nextParallelShuffleSeed() {
+    return counterBasedRandom(_seed,
+      _num_parallel_shuffles.fetch_add(1, std::memory_order_relaxed));
+  }
+
   template <typename T>
   void swapBlocks(parallel::scalable_vector<T>& vector,
                   const size_t start_1,
@@ -274,6 +407,8 @@ class Randomize {
   }
 
   std::vector<RandomFunctions> _rand;
+  int _seed;
+  std::atomic<uint64_t> _num_parallel_shuffles;
   bool _perform_localized_random_shuffle;
   size_t _localized_random_shuffle_block_size;
 };
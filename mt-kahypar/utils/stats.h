@@ -30,6 +30,9 @@
 #include <string>
 #include <unordered_map>
 #include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <vector>
 
 #include "mt-kahypar/macros.h"
 
@@ -114,6 +117,22 @@ class Stats {
 
     friend std::ostream & operator<< (std::ostream& str, const Stat& stat);
 
+    // ! Writes the value as a JSON literal (non-finite numbers become null)
+    void serializeJSON(std::ostream& str) const {
+      switch (_type) {
+        case Type::BOOLEAN: str << (_value_1 ? "true" : "false"); break;
+        case Type::INT32: str << _value_2; break;
+        case Type::INT64: str << _value_3; break;
+        case Type::FLOAT:
+          if ( std::isfinite(_value_4) ) str << _value_4; else str << "null";
+          break;
+        case Type::DOUBLE:
+          if ( std::isfinite(_value_5) ) str << _value_5; else str << "null";
+          break;
+        default: str << "null"; break;
+      }
+    }
+
    private:
     Type _type;
     bool _value_1;
@@ -186,6 +205,22 @@ class Stats {
 
   friend std::ostream & operator<< (std::ostream& str, const Stats& stats);
 
+  // ! Writes all stats as a flat JSON object with sorted keys
+  void serializeJSON(std::ostream& str) const {
+    std::vector<std::string> keys;
+    for (const auto& stat : _stats) {
+      keys.emplace_back(stat.first);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    str << "{";
+    for (size_t i = 0; i < keys.size(); ++i) {
+      str << (i == 0 ? "" : ",") << "\"" << keys[i] << "\":";
+      _stats.at(keys[i]).serializeJSON(str);
+    }
+    str << "}";
+  }
+
  private:
   std::mutex _stat_mutex;
   std::unordered_map<std::string, Stat> _stats;
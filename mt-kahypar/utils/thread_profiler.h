@@ -0,0 +1,195 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <time.h>
+#endif
+
+#undef __TBB_ARENA_OBSERVER
+#define __TBB_ARENA_OBSERVER true
+#include "tbb/task_scheduler_observer.h"
+#undef __TBB_ARENA_OBSERVER
+
+#include "mt-kahypar/macros.h"
+
+namespace mt_kahypar {
+namespace utils {
+
+// ! CPU time of each registered thread (in registration order) at a given point
+// ! in time (or the difference between two points in time)
+struct ThreadBusyTimes {
+  ThreadBusyTimes& operator+= (const ThreadBusyTimes& other) {
+    if ( seconds.size() < other.seconds.size() ) {
+      seconds.resize(other.seconds.size(), 0.0);
+    }
+    for ( size_t i = 0; i < other.seconds.size(); ++i ) {
+      seconds[i] += other.seconds[i];
+    }
+    return *this;
+  }
+
+  ThreadBusyTimes operator- (const ThreadBusyTimes& other) const {
+    // Threads registered after the start value was taken were idle before
+    ThreadBusyTimes diff = *this;
+    for ( size_t i = 0; i < std::min(seconds.size(), other.seconds.size()); ++i ) {
+      diff.seconds[i] = std::max(seconds[i] - other.seconds[i], 0.0);
+    }
+    return diff;
+  }
+
+  double total() const {
+    double sum = 0.0;
+    for ( const double s : seconds ) {
+      sum += s;
+    }
+    return sum;
+  }
+
+  // ! Index of the thread with the largest busy time
+  size_t slowestThread() const {
+    return std::max_element(seconds.begin(), seconds.end()) - seconds.begin();
+  }
+
+  double max() const {
+    return seconds.empty() ? 0.0 : seconds[slowestThread()];
+  }
+
+  // ! Busy time of all threads divided by the wall time available on all threads
+  double parallelEfficiency(const double wall_time) const {
+    return wall_time > 0.0 && !seconds.empty() ?
+      total() / ( wall_time * seconds.size() ) : 0.0;
+  }
+
+  // ! Busy time of the slowest thread divided by the average busy time
+  double loadImbalance() const {
+    const double avg = seconds.empty() ? 0.0 : total() / seconds.size();
+    return avg > 0.0 ? max() / avg : 0.0;
+  }
+
+  std::vector<double> seconds;
+};
+
+/**
+ * Measures the busy time of each thread that joins the global task arena (and
+ * of the thread that activates the profiler) via its CPU time clock. Comparing
+ * the busy times of a phase with its wall time reveals phases that do not scale:
+ * a low parallel efficiency shows that threads are idle (e.g., due to sequential
+ * parts), and a high load imbalance shows that the work is unevenly distributed.
+ * The busy time of the slowest thread is a lower bound for the critical path of
+ * the phase. Note that threads waiting for work spin for a short period before
+ * they sleep, which is counted as busy time.
+ * As hardware counters, busy times are only meaningful for phases that are
+ * started and stopped from a sequential context.
+ */
+class ThreadProfiler : public tbb::task_scheduler_observer {
+
+  using Base = tbb::task_scheduler_observer;
+
+ public:
+  ThreadProfiler() :
+    Base(),
+    _mutex(),
+    _clocks() { }
+
+  ThreadProfiler(const ThreadProfiler&) = delete;
+  ThreadProfiler & operator= (const ThreadProfiler &) = delete;
+
+  ThreadProfiler(ThreadProfiler&&) = delete;
+  ThreadProfiler & operator= (ThreadProfiler &&) = delete;
+
+  ~ThreadProfiler() {
+    observe(false);
+  }
+
+  // ! Registers the calling thread and all threads that join the global
+  // ! task arena afterwards. Returns false, if thread CPU clocks are not
+  // ! supported on this platform.
+  bool activate() {
+    #ifdef __linux__
+    registerCurrentThread();
+    observe(true);
+    return true;
+    #else
+    return false;
+    #endif
+  }
+
+  // ! Returns the CPU time of all registered threads
+  ThreadBusyTimes read() {
+    ThreadBusyTimes times;
+    #ifdef __linux__
+    std::lock_guard<std::mutex> lock(_mutex);
+    times.seconds.resize(_clocks.size(), 0.0);
+    for ( size_t i = 0; i < _clocks.size(); ++i ) {
+      struct timespec ts;
+      if ( clock_gettime(_clocks[i].clock, &ts) == 0 ) {
+        times.seconds[i] = ts.tv_sec + ts.tv_nsec / 1e9;
+      }
+    }
+    #endif
+    return times;
+  }
+
+  void on_scheduler_entry(bool) override {
+    registerCurrentThread();
+  }
+
+ private:
+  #ifdef __linux__
+  struct ThreadClock {
+    pthread_t thread;
+    clockid_t clock;
+  };
+  #else
+  struct ThreadClock { };
+  #endif
+
+  void registerCurrentThread() {
+    #ifdef __linux__
+    const pthread_t thread = pthread_self();
+    std::lock_guard<std::mutex> lock(_mutex);
+    const bool is_registered = std::any_of(_clocks.begin(), _clocks.end(),
+      [&](const ThreadClock& c) { return pthread_equal(c.thread, thread); });
+    clockid_t clock;
+    if ( !is_registered && pthread_getcpuclockid(thread, &clock) == 0 ) {
+      _clocks.push_back(ThreadClock { thread, clock });
+    }
+    #endif
+  }
+
+  std::mutex _mutex;
+  std::vector<ThreadClock> _clocks;
+};
+
+}  // namespace utils
+}  // namespace mt_kahypar
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace mt_kahypar {
+namespace utils {
+
+enum class BudgetPhase : uint8_t {
+  preprocessing,
+  coarsening,
+  initial_partitioning,
+  refinement,
+  NUM_PHASES
+};
+
+/*!
+ * Divides the time limit of a partitioning run across its phases and the levels
+ * of the uncoarsening phase. Each phase receives a slice of the remaining time
+ * proportional to its predicted cost relative to the predicted costs of the
+ * remaining phases. Thus, time not used by a phase is handed on to the later phases
+ * (and vice versa). Within the refinement phase, each level receives a slice of the
+ * remaining phase time proportional to its number of pins. The refiners use the slice
+ * of the current level as time limit. In contrast to the cancellation token, the
+ * slices are soft limits that only make the refiners finish early.
+ *
+ * The phases are started by the main thread of the main context, while the
+ * remaining time can be queried concurrently.
+ */
+class TimeBudget {
+
+  using Clock = std::chrono::steady_clock;
+  static constexpr size_t NUM_PHASES = static_cast<size_t>(BudgetPhase::NUM_PHASES);
+
+ public:
+  using PhaseCosts = std::array<double, NUM_PHASES>;
+
+  TimeBudget(const double time_limit, const PhaseCosts& predicted_costs) :
+    _start(Clock::now()),
+    _time_limit(time_limit),
+    _predicted_costs(predicted_costs),
+    _phase_start(_start),
+    _phase_budget(std::numeric_limits<double>::max()),
+    _level_start(_start),
+    _level_budget(std::numeric_limits<double>::max()) { }
+
+  TimeBudget(const TimeBudget&) = delete;
+  TimeBudget(TimeBudget&&) = delete;
+  TimeBudget & operator= (const TimeBudget &) = delete;
+  TimeBudget & operator= (TimeBudget &&) = delete;
+
+  void startPhase(const BudgetPhase phase) {
+    double remaining_cost = 0.0;
+    for ( size_t i = static_cast<size_t>(phase); i < NUM_PHASES; ++i ) {
+      remaining_cost += _predicted_costs[i];
+    }
+    const double cost = _predicted_costs[static_cast<size_t>(phase)];
+    const double remaining_time = std::max(remainingTime(), 0.0);
+    _phase_start = Clock::now();
+    _phase_budget = remaining_cost > 0.0 ? remaining_time * cost / remaining_cost : remaining_time;
+    _level_start = _phase_start;
+    _level_budget = _phase_budget;
+  }
+
+  // ! Starts a level of the refinement phase. The cost of the current level is
+  // ! included in the remaining cost of the phase.
+  void startLevel(const double cost, const double remaining_cost) {
+    const double remaining_time = std::max(remainingPhaseTime(), 0.0);
+    _level_start = Clock::now();
+    _level_budget = remaining_cost > 0.0 ?
+      remaining_time * std::min(cost / remaining_cost, 1.0) : remaining_time;
+  }
+
+  // ! Remaining time of the run in seconds (can be negative)
+  double remainingTime() const {
+    return _time_limit - elapsedSince(_start);
+  }
+
+  // ! Remaining time of the current phase in seconds (can be negative)
+  double remainingPhaseTime() const {
+    return std::min(_phase_budget - elapsedSince(_phase_start), remainingTime());
+  }
+
+  // ! Remaining time of the current level in seconds (can be negative)
+  double remainingLevelTime() const {
+    return std::min(_level_budget - elapsedSince(_level_start), remainingPhaseTime());
+  }
+
+  double phaseBudget() const {
+    return _phase_budget;
+  }
+
+ private:
+  static double elapsedSince(const Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  const Clock::time_point _start;
+  const double _time_limit;
+  const PhaseCosts _predicted_costs;
+  Clock::time_point _phase_start;
+  double _phase_budget;
+  Clock::time_point _level_start;
+  double _level_budget;
+};
+
+}  // namespace utils
+}  // namespace mt_kahypar
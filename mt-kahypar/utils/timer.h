@@ -29,6 +29,7 @@
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -36,6 +37,9 @@
 #include <tbb/enumerable_thread_specific.h>
 
 #include "mt-kahypar/macros.h"
+#include "mt-kahypar/utils/hardware_counters.h"
+#include "mt-kahypar/utils/thread_profiler.h"
+#include "mt-kahypar/utils/trace_recorder.h"
 
 namespace mt_kahypar {
 namespace utils {
@@ -74,14 +78,20 @@ class Timer {
     ActiveTiming() :
       _key(""),
       _description(""),
-      _start() { }
+      _start(),
+      _counters(),
+      _busy_times() { }
 
     ActiveTiming(const std::string& key,
                  const std::string& description,
-                 const HighResClockTimepoint& start) :
+                 const HighResClockTimepoint& start,
+                 const HardwareCounterValues& counters = HardwareCounterValues(),
+                 const ThreadBusyTimes& busy_times = ThreadBusyTimes()) :
       _key(key),
       _description(description),
-      _start(start) { }
+      _start(start),
+      _counters(counters),
+      _busy_times(busy_times) { }
 
     std::string key() const {
       return _key;
@@ -95,10 +105,20 @@ class Timer {
       return _start;
     }
 
+    const HardwareCounterValues& counters() const {
+      return _counters;
+    }
+
+    const ThreadBusyTimes& busy_times() const {
+      return _busy_times;
+    }
+
    private:
     std::string _key;
     std::string _description;
     HighResClockTimepoint _start;
+    HardwareCounterValues _counters;
+    ThreadBusyTimes _busy_times;
   };
 
   class Timing {
@@ -111,7 +131,11 @@ class Timer {
       _description(description),
       _parent(parent),
       _order(order),
-      _timing(0.0) { }
+      _timing(0.0),
+      _counters(),
+      _has_counters(false),
+      _busy_times(),
+      _has_busy_times(false) { }
 
     std::string key() const {
       return _key;
@@ -141,12 +165,42 @@ class Timer {
       _timing += timing;
     }
 
+    const HardwareCounterValues& counters() const {
+      return _counters;
+    }
+
+    bool has_counters() const {
+      return _has_counters;
+    }
+
+    void add_counters(const HardwareCounterValues& counters) {
+      _counters += counters;
+      _has_counters = true;
+    }
+
+    const ThreadBusyTimes& busy_times() const {
+      return _busy_times;
+    }
+
+    bool has_busy_times() const {
+      return _has_busy_times;
+    }
+
+    void add_busy_times(const ThreadBusyTimes& busy_times) {
+      _busy_times += busy_times;
+      _has_busy_times = true;
+    }
+
    private:
     std::string _key;
     std::string _description;
     std::string _parent;
     int _order;
     double _timing;
+    HardwareCounterValues _counters;
+    bool _has_counters;
+    ThreadBusyTimes _busy_times;
+    bool _has_busy_times;
   };
 
   using ActiveTimingStack = std::vector<ActiveTiming>;
@@ -161,7 +215,9 @@ class Timer {
     _index(0),
     _is_enabled(true),
     _show_detailed_timings(false),
-    _max_output_depth(std::numeric_limits<size_t>::max()) { }
+    _max_output_depth(std::numeric_limits<size_t>::max()),
+    _hardware_counters(nullptr),
+    _thread_profiler(nullptr) { }
 
   Timer(const Timer& other) :
     _timing_mutex(),
@@ -171,7 +227,9 @@ class Timer {
     _index(other._index.load(std::memory_order_relaxed)),
     _is_enabled(other._is_enabled),
     _show_detailed_timings(other._show_detailed_timings),
-    _max_output_depth(other._max_output_depth) { }
+    _max_output_depth(other._max_output_depth),
+    _hardware_counters(other._hardware_counters),
+    _thread_profiler(other._thread_profiler) { }
 
   Timer & operator= (const Timer &) = delete;
 
@@ -183,7 +241,9 @@ class Timer {
     _index(other._index.load(std::memory_order_relaxed)),
     _is_enabled(std::move(other._is_enabled)),
     _show_detailed_timings(std::move(other._show_detailed_timings)),
-    _max_output_depth(std::move(other._max_output_depth)) { }
+    _max_output_depth(std::move(other._max_output_depth)),
+    _hardware_counters(std::move(other._hardware_counters)),
+    _thread_profiler(std::move(other._thread_profiler)) { }
 
   Timer & operator= (Timer &&) = delete;
 
@@ -199,6 +259,43 @@ class Timer {
     return _is_enabled;
   }
 
+  // ! Attaches hardware counters (cycles, LLC misses, branch mispredictions
+  // ! and remote NUMA accesses) to all timings started in a sequential context.
+  // ! Returns false, if hardware counters are not supported on this machine.
+  bool enableHardwareCounters() {
+    std::lock_guard<std::mutex> lock(_timing_mutex);
+    if ( !_hardware_counters ) {
+      _hardware_counters = std::make_shared<HardwareCounters>();
+      if ( !_hardware_counters->activate() ) {
+        _hardware_counters = nullptr;
+      }
+    }
+    return _hardware_counters != nullptr;
+  }
+
+  bool measuresHardwareCounters() const {
+    return _hardware_counters != nullptr;
+  }
+
+  // ! Measures the busy time of each thread for all timings started in a
+  // ! sequential context and reports the parallel efficiency, load imbalance
+  // ! and slowest thread of each phase. Returns false, if per-thread CPU
+  // ! clocks are not supported on this machine.
+  bool enableThreadProfiling() {
+    std::lock_guard<std::mutex> lock(_timing_mutex);
+    if ( !_thread_profiler ) {
+      _thread_profiler = std::make_shared<ThreadProfiler>();
+      if ( !_thread_profiler->activate() ) {
+        _thread_profiler = nullptr;
+      }
+    }
+    return _thread_profiler != nullptr;
+  }
+
+  bool profilesThreads() const {
+    return _thread_profiler != nullptr;
+  }
+
   void enable() {
     std::lock_guard<std::mutex> lock(_timing_mutex);
     _is_enabled = true;
@@ -225,7 +322,11 @@ class Timer {
       if (force || is_parallel_context) {
         _local_active_timings.local().emplace_back(key, description, std::chrono::high_resolution_clock::now());
       } else {
-        _active_timings.emplace_back(key, description, std::chrono::high_resolution_clock::now());
+        // Hardware counters and busy times are measured over all threads.
+        // Therefore, we only attach them to timings in a sequential context.
+        _active_timings.emplace_back(key, description, std::chrono::high_resolution_clock::now(),
+          _hardware_counters ? _hardware_counters->read() : HardwareCounterValues(),
+          _thread_profiler ? _thread_profiler->read() : ThreadBusyTimes());
       }
     }
   }
@@ -237,6 +338,10 @@ class Timer {
       HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
       ASSERT(!force || !_local_active_timings.local().empty());
       ActiveTiming current_timing;
+      bool measured_counters = false;
+      HardwareCounterValues counters;
+      bool measured_busy_times = false;
+      ThreadBusyTimes busy_times;
       // First check if there are some active timings on the local stack
       // (in that case we are in a parallel context) and if there are
       // no active timings we pop from global stack
@@ -250,6 +355,14 @@ class Timer {
         ASSERT(_active_timings.back().key() == key, V(_active_timings.back().key()) << V(key));
         current_timing = _active_timings.back();
         _active_timings.pop_back();
+        if ( _hardware_counters ) {
+          counters = _hardware_counters->read() - current_timing.counters();
+          measured_counters = true;
+        }
+        if ( _thread_profiler ) {
+          busy_times = _thread_profiler->read() - current_timing.busy_times();
+          measured_busy_times = true;
+        }
       }
 
       // Parent is either the last element on the local stack and
@@ -273,6 +386,15 @@ class Timer {
       }
       double time = std::chrono::duration<double>(end - current_timing.start()).count();
       _timings.at(timing_key).add_timing(time);
+      #ifdef KAHYPAR_ENABLE_TRACING
+      TraceRecorder::instance().record("timer", current_timing.key(), current_timing.start(), end);
+      #endif
+      if ( measured_counters ) {
+        _timings.at(timing_key).add_counters(counters);
+      }
+      if ( measured_busy_times ) {
+        _timings.at(timing_key).add_busy_times(busy_times);
+      }
     }
   }
 
@@ -287,9 +409,27 @@ class Timer {
         });
 
     if (!timings.empty()) {
-      auto print = [&](const std::string& key, const double time, const bool is_root) {
+      auto print = [&](const std::string& key, const double time,
+                       const HardwareCounterValues& counters,
+                       const bool has_counters,
+                       const ThreadBusyTimes& busy_times,
+                       const bool has_busy_times, const bool is_root) {
                      if (_show_detailed_timings || is_root) {
                        str << " " << key << "=" << time;
+                       if ( _hardware_counters && has_counters ) {
+                         for ( size_t i = 0; i < NUM_HARDWARE_COUNTERS; ++i ) {
+                           const HardwareCounter counter = static_cast<HardwareCounter>(i);
+                           if ( _hardware_counters->isAvailable(counter) ) {
+                             str << " " << key << "_" << HardwareCounters::name(counter)
+                                 << "=" << counters[counter];
+                           }
+                         }
+                       }
+                       if ( _thread_profiler && has_busy_times ) {
+                         str << " " << key << "_efficiency=" << busy_times.parallelEfficiency(time)
+                             << " " << key << "_imbalance=" << busy_times.loadImbalance()
+                             << " " << key << "_critical_path=" << busy_times.max();
+                       }
                      }
                    };
 
@@ -297,20 +437,75 @@ class Timer {
       // but different parent
       std::string last_key = timings[0].key();
       double time = timings[0].timing();
+      HardwareCounterValues counters = timings[0].counters();
+      bool has_counters = timings[0].has_counters();
+      ThreadBusyTimes busy_times = timings[0].busy_times();
+      bool has_busy_times = timings[0].has_busy_times();
       bool is_root = timings[0].is_root();
       for (size_t i = 1; i < timings.size(); ++i) {
         if (last_key == timings[i].key()) {
           time += timings[i].timing();
+          counters += timings[i].counters();
+          has_counters |= timings[i].has_counters();
+          busy_times += timings[i].busy_times();
+          has_busy_times |= timings[i].has_busy_times();
           is_root |= timings[i].is_root();
         } else {
-          print(last_key, time, is_root);
+          print(last_key, time, counters, has_counters, busy_times, has_busy_times, is_root);
           last_key = timings[i].key();
           time = timings[i].timing();
+          counters = timings[i].counters();
+          has_counters = timings[i].has_counters();
+          busy_times = timings[i].busy_times();
+          has_busy_times = timings[i].has_busy_times();
           is_root = timings[i].is_root();
         }
       }
-      print(last_key, time, is_root);
+      print(last_key, time, counters, has_counters, busy_times, has_busy_times, is_root);
+    }
+  }
+
+  // ! Writes the timing tree as JSON array of the root timings. Each timing is
+  // ! an object with its key, description, time in seconds and its children
+  // ! (and the busy time of each thread, if thread profiling is enabled).
+  void serializeJSON(std::ostream& str) const {
+    std::vector<Timing> timings;
+    for (const auto& timing : _timings) {
+      timings.emplace_back(timing.second);
     }
+    std::sort(timings.begin(), timings.end(),
+              [&](const Timing& lhs, const Timing& rhs) {
+          return lhs.order() < rhs.order();
+        });
+
+    std::function<void(const std::string&)> dfs = [&](const std::string& parent) {
+      str << "[";
+      bool first = true;
+      for (const Timing& timing : timings) {
+        if (timing.parent() == parent) {
+          str << (first ? "" : ",") << "{\"key\":\"" << timing.key()
+              << "\",\"description\":\"" << timing.description()
+              << "\",\"seconds\":" << timing.timing();
+          if (_thread_profiler && timing.has_busy_times()) {
+            const ThreadBusyTimes& busy_times = timing.busy_times();
+            str << ",\"parallel_efficiency\":" << busy_times.parallelEfficiency(timing.timing())
+                << ",\"load_imbalance\":" << busy_times.loadImbalance()
+                << ",\"slowest_thread\":" << busy_times.slowestThread()
+                << ",\"thread_busy_seconds\":[";
+            for (size_t i = 0; i < busy_times.seconds.size(); ++i) {
+              str << (i == 0 ? "" : ",") << busy_times.seconds[i];
+            }
+            str << "]";
+          }
+          str << ",\"children\":";
+          dfs(timing.key());
+          str << "}";
+          first = false;
+        }
+      }
+      str << "]";
+    };
+    dfs("");
   }
 
   friend std::ostream & operator<< (std::ostream& str, const Timer& timer);
@@ -325,6 +520,28 @@ class Timer {
     return 0.0;
   }
 
+  // ! Returns the hardware counters measured for the given key (all zero,
+  // ! if hardware counters are not enabled)
+  HardwareCounterValues get_counters(std::string key) const {
+    for (const auto& x : _timings) {
+      if (x.first.key == key) {
+        return x.second.counters();
+      }
+    }
+    return HardwareCounterValues();
+  }
+
+  // ! Returns the busy time of each thread measured for the given key (empty,
+  // ! if thread profiling is not enabled)
+  ThreadBusyTimes get_busy_times(std::string key) const {
+    for (const auto& x : _timings) {
+      if (x.first.key == key) {
+        return x.second.busy_times();
+      }
+    }
+    return ThreadBusyTimes();
+  }
+
  private:
   std::mutex _timing_mutex;
   std::unordered_map<Key, Timing, KeyHasher, KeyEqual> _timings;
@@ -340,6 +557,8 @@ class Timer {
   bool _is_enabled;
   bool _show_detailed_timings;
   size_t _max_output_depth;
+  std::shared_ptr<HardwareCounters> _hardware_counters;
+  std::shared_ptr<ThreadProfiler> _thread_profiler;
 };
 
 inline char Timer::TOP_LEVEL_PREFIX[] = " + ";
@@ -367,7 +586,24 @@ inline std::ostream & operator<< (std::ostream& str, const Timer& timer) {
                  if (length < Timer::MAX_LINE_LENGTH) {
                    str << std::string(Timer::MAX_LINE_LENGTH - length, ' ');
                  }
-                 str << " = " << timing.timing() << " s\n";
+                 str << " = " << timing.timing() << " s";
+                 if ( timer._hardware_counters && timing.has_counters() ) {
+                   const HardwareCounterValues& counters = timing.counters();
+                   for ( size_t i = 0; i < NUM_HARDWARE_COUNTERS; ++i ) {
+                     const HardwareCounter counter = static_cast<HardwareCounter>(i);
+                     if ( timer._hardware_counters->isAvailable(counter) ) {
+                       str << " " << HardwareCounters::name(counter) << "=" << counters[counter];
+                     }
+                   }
+                 }
+                 if ( timer._thread_profiler && timing.has_busy_times() ) {
+                   const ThreadBusyTimes& busy_times = timing.busy_times();
+                   str << " efficiency=" << busy_times.parallelEfficiency(timing.timing())
+                       << " imbalance=" << busy_times.loadImbalance()
+                       << " slowest_thread=" << busy_times.slowestThread()
+                       << " (" << busy_times.max() << " s)";
+                 }
+                 str << "\n";
                };
 
   std::function<void(std::ostream&, const Timer::Timing&, int)> dfs =
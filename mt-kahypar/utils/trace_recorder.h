@@ -0,0 +1,211 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <string>
+
+#include <tbb/enumerable_thread_specific.h>
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/parallel/stl/scalable_vector.h"
+
+namespace mt_kahypar {
+namespace utils {
+
+/**
+ * Records the start and end of timer phases, initial partitioning runs, flow
+ * searches and localized FM searches together with the thread that executed
+ * them. The events can be exported in the Chrome trace event format (viewable
+ * with chrome://tracing or https://ui.perfetto.dev), which visualizes the
+ * occupancy of each thread over time.
+ *
+ * Each thread records into its own ring buffer. Thus, recording does not
+ * require synchronization and, if a buffer is full, the oldest events of the
+ * thread are overwritten. Events are only recorded, if Mt-KaHyPar is compiled
+ * with KAHYPAR_ENABLE_TRACING and the recorder is activated. Otherwise, the
+ * MT_KAHYPAR_TRACE_SCOPE macro expands to nothing.
+ */
+class TraceRecorder {
+
+  using HighResClockTimepoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+
+  static constexpr size_t RING_BUFFER_SIZE = 1UL << 16;
+
+  struct Event {
+    const char* category;
+    std::string name;
+    HighResClockTimepoint start;
+    HighResClockTimepoint end;
+  };
+
+  struct ThreadBuffer {
+    ThreadBuffer() :
+      thread_id(next_thread_id().fetch_add(1, std::memory_order_relaxed)),
+      events(),
+      num_recorded_events(0) { }
+
+    size_t thread_id;
+    vec<Event> events;
+    size_t num_recorded_events;
+  };
+
+ public:
+  TraceRecorder(const TraceRecorder&) = delete;
+  TraceRecorder & operator= (const TraceRecorder &) = delete;
+
+  TraceRecorder(TraceRecorder&&) = delete;
+  TraceRecorder & operator= (TraceRecorder &&) = delete;
+
+  static TraceRecorder& instance() {
+    static TraceRecorder instance;
+    return instance;
+  }
+
+  static constexpr bool isCompiledIn() {
+    #ifdef KAHYPAR_ENABLE_TRACING
+    return true;
+    #else
+    return false;
+    #endif
+  }
+
+  void activate() {
+    _origin = std::chrono::high_resolution_clock::now();
+    _is_active = true;
+  }
+
+  bool isActive() const {
+    return _is_active;
+  }
+
+  void record(const char* category,
+              const std::string& name,
+              const HighResClockTimepoint& start,
+              const HighResClockTimepoint& end) {
+    if ( _is_active ) {
+      ThreadBuffer& buffer = _buffers.local();
+      if ( buffer.events.size() < RING_BUFFER_SIZE ) {
+        buffer.events.push_back(Event { category, name, start, end });
+      } else {
+        buffer.events[buffer.num_recorded_events % RING_BUFFER_SIZE] =
+          Event { category, name, start, end };
+      }
+      ++buffer.num_recorded_events;
+    }
+  }
+
+  // ! Writes all recorded events as Chrome trace JSON. Must not be called
+  // ! concurrently to record(...).
+  void writeChromeTrace(std::ostream& out) const {
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for ( const ThreadBuffer& buffer : _buffers ) {
+      if ( buffer.num_recorded_events > buffer.events.size() ) {
+        WARNING("Trace buffer of thread" << buffer.thread_id << "overflowed, the"
+          << (buffer.num_recorded_events - buffer.events.size()) << "oldest events are lost");
+      }
+      for ( const Event& event : buffer.events ) {
+        out << (first ? "" : ",") << "\n{\"name\":\"" << event.name
+            << "\",\"cat\":\"" << event.category
+            << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer.thread_id
+            << ",\"ts\":" << microseconds(_origin, event.start)
+            << ",\"dur\":" << microseconds(event.start, event.end) << "}";
+        first = false;
+      }
+    }
+    out << "\n]}\n";
+  }
+
+  void writeChromeTrace(const std::string& filename) const {
+    std::ofstream out(filename.c_str());
+    if ( out ) {
+      writeChromeTrace(out);
+    } else {
+      WARNING("Could not open:" << filename);
+    }
+  }
+
+  void clear() {
+    _buffers.clear();
+  }
+
+ private:
+  TraceRecorder() :
+    _is_active(false),
+    _origin(std::chrono::high_resolution_clock::now()),
+    _buffers() { }
+
+  static std::atomic<size_t>& next_thread_id() {
+    static std::atomic<size_t> id(0);
+    return id;
+  }
+
+  static double microseconds(const HighResClockTimepoint& from, const HighResClockTimepoint& to) {
+    return std::chrono::duration<double, std::micro>(to - from).count();
+  }
+
+  bool _is_active;
+  HighResClockTimepoint _origin;
+  tbb::enumerable_thread_specific<ThreadBuffer> _buffers;
+};
+
+// ! Records an event from its construction until its destruction
+class TraceScope {
+ public:
+  TraceScope(const char* category, std::string name) :
+    _category(category),
+    _name(std::move(name)),
+    _start(std::chrono::high_resolution_clock::now()) { }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope & operator= (const TraceScope &) = delete;
+
+  ~TraceScope() {
+    TraceRecorder::instance().record(_category, _name,
+      _start, std::chrono::high_resolution_clock::now());
+  }
+
+ private:
+  const char* _category;
+  std::string _name;
+  std::chrono::time_point<std::chrono::high_resolution_clock> _start;
+};
+
+}  // namespace utils
+}  // namespace mt_kahypar
+
+#ifdef KAHYPAR_ENABLE_TRACING
+#define MT_KAHYPAR_TRACE_CONCAT_IMPL(a, b) a ## b
+#define MT_KAHYPAR_TRACE_CONCAT(a, b) MT_KAHYPAR_TRACE_CONCAT_IMPL(a, b)
+#define MT_KAHYPAR_TRACE_SCOPE(category, name)                                  \
+  mt_kahypar::utils::TraceScope MT_KAHYPAR_TRACE_CONCAT(trace_scope_, __LINE__)(category, name)
+#else
+#define MT_KAHYPAR_TRACE_SCOPE(category, name)
+#endif
@@ -32,6 +32,7 @@
 #include "mt-kahypar/macros.h"
 #include "mt-kahypar/utils/stats.h"
 #include "mt-kahypar/utils/initial_partitioning_stats.h"
+#include "mt-kahypar/utils/level_stats.h"
 #include "mt-kahypar/utils/timer.h"
 
 namespace mt_kahypar {
@@ -44,10 +45,12 @@ class Utilities {
     UtilityObjects() :
       stats(),
       ip_stats(),
+      level_stats(),
       timer() { }
 
     Stats stats;
     InitialPartitioningStats ip_stats;
+    LevelStats level_stats;
     Timer timer;
   };
 
@@ -80,6 +83,11 @@ class Utilities {
     return _utilities[id].ip_stats;
   }
 
+  LevelStats& getLevelStats(const size_t id) {
+    ASSERT(id < _utilities.size());
+    return _utilities[id].level_stats;
+  }
+
   Timer& getTimer(const size_t id) {
     ASSERT(id < _utilities.size());
     return _utilities[id].timer;
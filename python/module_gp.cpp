@@ -27,9 +27,12 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 
 #include "tbb/parallel_for.h"
+#include "tbb/task_group.h"
 
+#include <optional>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -44,6 +47,7 @@
 #include "mt-kahypar/partition/partitioner.h"
 #include "mt-kahypar/io/command_line_options.h"
 #include "mt-kahypar/io/hypergraph_io.h"
+#include "mt-kahypar/io/json_report.h"
 
 namespace py = pybind11;
 
@@ -51,6 +55,45 @@ namespace {
   template<typename T>
   using vec = mt_kahypar::parallel::scalable_vector<T>;
 
+  // ! NumPy array that is passed to C++ without a copy, if it is contiguous and
+  // ! has the expected data type (otherwise, pybind11 converts it once)
+  template<typename T>
+  using numpy_array = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+  // ! Read-only NumPy array that refers to the block IDs of the partitioned
+  // ! (hyper)graph without copying them. The array keeps its owner alive.
+  py::array_t<mt_kahypar::PartitionID> partition_view(const py::object& owner) {
+    const auto& partitioned_hg = owner.cast<const mt_kahypar::PartitionedHypergraph&>();
+    py::array_t<mt_kahypar::PartitionID> view(
+      partitioned_hg.initialNumNodes(), partitioned_hg.partIDs(), owner);
+    view.attr("setflags")(py::arg("write") = false);
+    return view;
+  }
+
+  py::array_t<mt_kahypar::HypernodeWeight> block_weights(const mt_kahypar::PartitionedHypergraph& partitioned_hg) {
+    py::array_t<mt_kahypar::HypernodeWeight> weights(partitioned_hg.k());
+    auto w = weights.mutable_unchecked<1>();
+    for ( mt_kahypar::PartitionID i = 0; i < partitioned_hg.k(); ++i ) {
+      w(i) = partitioned_hg.partWeight(i);
+    }
+    return weights;
+  }
+
+  // ! Returns a NumPy array of size n with entry i = f(i). The array
+  // ! is filled in parallel and without holding the GIL.
+  template<typename T, typename F>
+  py::array_t<T> bulk_array(const size_t n, const F& f) {
+    py::array_t<T> result(n);
+    T* data = result.mutable_data();
+    {
+      py::gil_scoped_release release;
+      tbb::parallel_for(UL(0), n, [&](const size_t i) {
+        data[i] = f(i);
+      });
+    }
+    return result;
+  }
+
   void initialize_thread_pool(const size_t num_threads) {
     size_t P = num_threads;
     size_t num_available_cpus = mt_kahypar::HardwareTopology::instance().num_cpus();
@@ -127,6 +170,39 @@ namespace {
     return mt_kahypar::partition(graph, context);
   }
 
+  std::vector<mt_kahypar::PartitionedHypergraph> partition_batch(const std::vector<mt_kahypar::Hypergraph*>& graphs,
+                                                                 const std::vector<mt_kahypar::Context*>& contexts,
+                                                                 const size_t num_threads_per_job) {
+    if ( graphs.size() != contexts.size() ) {
+      ERR("Number of graphs (" << graphs.size() << ") and contexts ("
+        << contexts.size() << ") do not match");
+    }
+    std::vector<mt_kahypar::PartitionedHypergraph> partitioned_graphs(graphs.size());
+    if ( graphs.empty() ) {
+      return partitioned_graphs;
+    }
+
+    // The thread budget of a job is modeled via the number of threads in its context
+    const size_t num_threads = mt_kahypar::TBBInitializer::instance().total_number_of_threads();
+    const size_t threads_per_job = num_threads_per_job > 0 ?
+      std::min(num_threads_per_job, num_threads) : std::max(num_threads / graphs.size(), UL(1));
+    for ( mt_kahypar::Context* context : contexts ) {
+      prepare_context(*context);
+      context->shared_memory.original_num_threads = threads_per_job;
+      context->shared_memory.num_threads = threads_per_job;
+    }
+    mt_kahypar::utils::Randomize::instance().setSeed(contexts[0]->partition.seed);
+
+    tbb::task_group tg;
+    for ( size_t i = 0; i < graphs.size(); ++i ) {
+      tg.run([&, i] {
+        partitioned_graphs[i] = mt_kahypar::partition(*graphs[i], *contexts[i]);
+      });
+    }
+    tg.wait();
+    return partitioned_graphs;
+  }
+
   void improve_partition(mt_kahypar::PartitionedHypergraph& partitioned_graph,
                          mt_kahypar::Context& context,
                          const size_t num_vcycles) {
@@ -156,6 +232,14 @@ PYBIND11_MODULE(mtkahypargp, m) {
     .value("CUT", Objective::cut)
     .value("KM1", Objective::km1);
 
+  using mt_kahypar::utils::ProgressPhase;
+  py::enum_<ProgressPhase>(m, "ProgressPhase")
+    .value("COARSENING", ProgressPhase::coarsening)
+    .value("INITIAL_PARTITIONING", ProgressPhase::initial_partitioning)
+    .value("REFINEMENT", ProgressPhase::refinement)
+    .value("VCYCLE", ProgressPhase::vcycle)
+    .value("FINISHED", ProgressPhase::finished);
+
   // ####################### Initialize Thread Pool #######################
 
   m.def("initializeThreadPool", &initialize_thread_pool,
@@ -213,6 +297,35 @@ Construct a weighted graph.
         return mt_kahypar::io::readInputFile(file_name, file_format, true);
       }), "Reads a graph from a file (supported file formats are METIS and HMETIS)",
       py::arg("path to graph file"), py::arg("file format"))
+    .def_static("fromCSR", [](const numpy_array<size_t>& xadj,
+                              const numpy_array<HypernodeID>& adjncy,
+                              const std::optional<numpy_array<HypernodeWeight>>& node_weights,
+                              const std::optional<numpy_array<HyperedgeWeight>>& edge_weights) {
+        if ( xadj.size() == 0 || static_cast<size_t>(adjncy.size()) != xadj.at(xadj.size() - 1) ) {
+          ERR("xadj does not match the size of the adjacency array");
+        }
+        const HypernodeID num_nodes = xadj.size() - 1;
+        if ( ( node_weights && static_cast<size_t>(node_weights->size()) != num_nodes ) ||
+             ( edge_weights && edge_weights->size() != adjncy.size() ) ) {
+          ERR("Number of weights does not match the number of nodes or adjacency entries");
+        }
+        // The arrays are kept alive by the caller => construct without the GIL
+        py::gil_scoped_release release;
+        return GraphFactory::construct_from_csr(num_nodes, xadj.data(), adjncy.data(),
+          edge_weights ? edge_weights->data() : nullptr,
+          node_weights ? node_weights->data() : nullptr);
+      }, R"pbdoc(
+Construct a graph from NumPy arrays in CSR format (as used by METIS).
+
+:param xadj: The neighbors of node u are stored in adjncy[xadj[u]:xadj[u+1]]
+:param adjncy: Adjacency array (each edge must be contained in both directions)
+:param node_weights: Weights of all nodes (optional)
+:param edge_weights: Weight of each entry of the adjacency array (optional)
+          )pbdoc",
+      py::arg("xadj"),
+      py::arg("adjncy"),
+      py::arg("node_weights") = py::none(),
+      py::arg("edge_weights") = py::none())
     .def("numNodes", &Graph::initialNumNodes,
       "Number of nodes")
     .def("numEdges", [](Graph& graph) {
@@ -226,6 +339,18 @@ Construct a weighted graph.
       "Degree of node", py::arg("node"))
     .def("nodeWeight", &Graph::nodeWeight,
       "Weight of node", py::arg("node"))
+    .def("nodeWeights", [](const Graph& graph) {
+        return bulk_array<HypernodeWeight>(graph.initialNumNodes(),
+          [&](const HypernodeID u) { return graph.nodeWeight(u); });
+      }, "NumPy array of the weights of all nodes")
+    .def("nodeDegrees", [](const Graph& graph) {
+        return bulk_array<HyperedgeID>(graph.initialNumNodes(),
+          [&](const HypernodeID u) { return graph.nodeDegree(u); });
+      }, "NumPy array of the degrees of all nodes")
+    .def("edgeWeights", [](const Graph& graph) {
+        return bulk_array<HyperedgeWeight>(graph.initialNumEdges(),
+          [&](const HyperedgeID e) { return graph.edgeWeight(e); });
+      }, "NumPy array of the weights of all directed edges")
     .def("edgeWeight", &Graph::edgeWeight,
       "Weight of edge", py::arg("edge"))
     .def("source", &Graph::edgeSource,
@@ -272,7 +397,11 @@ Construct a weighted graph.
   py::class_<PartitionedGraph>(m, "PartitionedGraph")
     .def(py::init<>([](Graph& graph,
                        const PartitionID num_blocks,
-                       const vec<PartitionID>& partition) {
+                       const numpy_array<PartitionID>& partition_array) {
+        if ( static_cast<size_t>(partition_array.size()) != graph.initialNumNodes() ) {
+          ERR("Size of the partition does not match the number of nodes");
+        }
+        const PartitionID* partition = partition_array.data();
         PartitionedGraph partitioned_graph(num_blocks, graph, mt_kahypar::parallel_tag_t { });
         partitioned_graph.doParallelForAllNodes([&](const HypernodeID& hn) {
           if ( partition[hn] < 0 || partition[hn] >= num_blocks ) {
@@ -287,7 +416,7 @@ Construct a partitioned graph.
 
 :param graph: graph object
 :param num_blocks: number of block in which the graph should be partitioned into
-:param partition: List of block IDs for each node
+:param partition: List or NumPy array of block IDs for each node
           )pbdoc",
       py::arg("graph"),
       py::arg("number of blocks"),
@@ -322,6 +451,14 @@ Construct a partitioned graph.
       "Weight of all nodes in corresponding block", py::arg("block"))
     .def("blockID", &PartitionedGraph::partID,
       "Block ID of node", py::arg("node"))
+    .def("partition", &partition_view,
+      "Read-only NumPy array of the block IDs of all nodes (without copying them)")
+    .def("blockWeights", &block_weights,
+      "NumPy array of the weights of all blocks")
+    .def("connectivities", [](const PartitionedGraph& partitioned_graph) {
+        return bulk_array<PartitionID>(partitioned_graph.initialNumEdges(),
+          [&](const HyperedgeID e) { return partitioned_graph.connectivity(e); });
+      }, "NumPy array of the connectivity (number of blocks) of all directed edges")
     .def("isIncidentToCutEdge", &PartitionedGraph::isBorderNode,
       "Returns true, if the corresponding node is incident to a cut edge",
       py::arg("node"))
@@ -347,20 +484,34 @@ Construct a partitioned graph.
       },
       "Computes the edge-cut metric for the partitioned graph")
     .def("writePartitionToFile", [](PartitionedGraph& partitioned_graph,
-                                    const std::string& partition_file) {
-        mt_kahypar::io::writePartitionFile(partitioned_graph, partition_file);
-      }, "Writes the partition to a file",
-      py::arg("target partition file"));
+                                    const std::string& partition_file,
+                                    const bool binary) {
+        mt_kahypar::io::writePartitionFile(partitioned_graph, partition_file, binary);
+      }, "Writes the partition to a file (binary = header followed by an int32 array of the block IDs)",
+      py::arg("target partition file"), py::arg("binary") = false)
+    .def("report", [](const PartitionedGraph& partitioned_graph, const mt_kahypar::Context& context) {
+        return mt_kahypar::io::json::serializeRunReport(partitioned_graph, context);
+      }, "Returns a JSON report of the partitioning run (metrics, timings, stats, per-level refinement statistics and memory consumption)",
+      py::arg("context"));
 
   // ####################### Partitioning #######################
 
   m.def(
-    "partition", &partition,
+    "partition", &partition, py::call_guard<py::gil_scoped_release>(),
     "Compute a k-way partition of the graph",
     py::arg("graph"), py::arg("context"));
 
   m.def(
-    "improvePartition", &improve_partition,
+    "partitionBatch", &partition_batch, py::call_guard<py::gil_scoped_release>(),
+    R"pbdoc(
+Partitions several graphs concurrently. Each job runs with a budget of the given number of
+threads and idle threads steal work from other jobs. If the number of threads per job is zero,
+the threads are evenly distributed among the jobs. Each job requires its own context.
+          )pbdoc",
+    py::arg("graphs"), py::arg("contexts"), py::arg("number of threads per job") = 0);
+
+  m.def(
+    "improvePartition", &improve_partition, py::call_guard<py::gil_scoped_release>(),
     "Improves a k-way partition (using the V-cycle technique)",
     py::arg("partitioned graph"), py::arg("context"), py::arg("number of V-cycles"));
 
@@ -428,6 +579,33 @@ Construct a partitioned graph.
         context.partition.num_vcycles = num_vcycles;
       }, "Sets the number of V-cycles",
       py::arg("number of vcycles"))
+    .def("setProgressCallback", [](Context& context, py::function callback) {
+        context.progress_reporter = std::make_shared<mt_kahypar::utils::ProgressReporter>(
+          [callback](const mt_kahypar::utils::ProgressUpdate& update) {
+            py::gil_scoped_acquire acquire;
+            try {
+              py::dict progress;
+              progress["phase"] = update.phase;
+              progress["vcycle"] = update.vcycle;
+              progress["level"] = update.level;
+              progress["num_levels"] = update.num_levels;
+              progress["objective"] = update.objective;
+              progress["imbalance"] = update.imbalance;
+              progress["elapsed_seconds"] = update.elapsed_seconds;
+              const py::object result = callback(progress);
+              return result.is_none() || result.cast<bool>();
+            } catch ( py::error_already_set& e ) {
+              // An exception in the callback stops the run
+              e.discard_as_unraisable(__func__);
+              return false;
+            }
+          });
+      }, R"pbdoc(
+Registers a callback that receives a dict with the current phase, V-cycle, level, objective,
+imbalance and elapsed time on each phase transition and after each level of the uncoarsening
+phase. Returning False stops the partitioner as soon as possible.
+          )pbdoc",
+      py::arg("callback"))
     .def("enableLogging", [](Context& context, const bool verbose) {
         context.partition.verbose_output = verbose;
       }, "Enable partitioning output",
@@ -27,9 +27,12 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 
 #include "tbb/parallel_for.h"
+#include "tbb/task_group.h"
 
+#include <optional>
 #include <string>
 #include <vector>
 #include <iostream>
@@ -40,6 +43,7 @@
 #include "mt-kahypar/partition/partitioner.h"
 #include "mt-kahypar/io/command_line_options.h"
 #include "mt-kahypar/io/hypergraph_io.h"
+#include "mt-kahypar/io/json_report.h"
 
 namespace py = pybind11;
 
@@ -47,6 +51,53 @@ namespace {
   template<typename T>
   using vec = mt_kahypar::parallel::scalable_vector<T>;
 
+  // ! NumPy array that is passed to C++ without a copy, if it is contiguous and
+  // ! has the expected data type (otherwise, pybind11 converts it once)
+  template<typename T>
+  using numpy_array = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+  // ! Read-only NumPy array that refers to the block IDs of the partitioned
+  // ! (hyper)graph without copying them. The array keeps its owner alive.
+  // ! If the block IDs are stored with a narrow type, they are copied instead.
+  py::array_t<mt_kahypar::PartitionID> partition_view(const py::object& owner) {
+    const auto& partitioned_hg = owner.cast<const mt_kahypar::PartitionedHypergraph&>();
+    if ( partitioned_hg.partIDs() != nullptr ) {
+      py::array_t<mt_kahypar::PartitionID> view(
+        partitioned_hg.initialNumNodes(), partitioned_hg.partIDs(), owner);
+      view.attr("setflags")(py::arg("write") = false);
+      return view;
+    } else {
+      py::array_t<mt_kahypar::PartitionID> partition(partitioned_hg.initialNumNodes());
+      partitioned_hg.copyPartIDs(partition.mutable_data());
+      partition.attr("setflags")(py::arg("write") = false);
+      return partition;
+    }
+  }
+
+  py::array_t<mt_kahypar::HypernodeWeight> block_weights(const mt_kahypar::PartitionedHypergraph& partitioned_hg) {
+    py::array_t<mt_kahypar::HypernodeWeight> weights(partitioned_hg.k());
+    auto w = weights.mutable_unchecked<1>();
+    for ( mt_kahypar::PartitionID i = 0; i < partitioned_hg.k(); ++i ) {
+      w(i) = partitioned_hg.partWeight(i);
+    }
+    return weights;
+  }
+
+  // ! Returns a NumPy array of size n with entry i = f(i). The array
+  // ! is filled in parallel and without holding the GIL.
+  template<typename T, typename F>
+  py::array_t<T> bulk_array(const size_t n, const F& f) {
+    py::array_t<T> result(n);
+    T* data = result.mutable_data();
+    {
+      py::gil_scoped_release release;
+      tbb::parallel_for(UL(0), n, [&](const size_t i) {
+        data[i] = f(i);
+      });
+    }
+    return result;
+  }
+
   void initialize_thread_pool(const size_t num_threads) {
     size_t P = num_threads;
     size_t num_available_cpus = mt_kahypar::HardwareTopology::instance().num_cpus();
@@ -123,6 +174,39 @@ namespace {
     return mt_kahypar::partition(hypergraph, context);
   }
 
+  std::vector<mt_kahypar::PartitionedHypergraph> partition_batch(const std::vector<mt_kahypar::Hypergraph*>& hypergraphs,
+                                                                 const std::vector<mt_kahypar::Context*>& contexts,
+                                                                 const size_t num_threads_per_job) {
+    if ( hypergraphs.size() != contexts.size() ) {
+      ERR("Number of hypergraphs (" << hypergraphs.size() << ") and contexts ("
+        << contexts.size() << ") do not match");
+    }
+    std::vector<mt_kahypar::PartitionedHypergraph> partitioned_hypergraphs(hypergraphs.size());
+    if ( hypergraphs.empty() ) {
+      return partitioned_hypergraphs;
+    }
+
+    // The thread budget of a job is modeled via the number of threads in its context
+    const size_t num_threads = mt_kahypar::TBBInitializer::instance().total_number_of_threads();
+    const size_t threads_per_job = num_threads_per_job > 0 ?
+      std::min(num_threads_per_job, num_threads) : std::max(num_threads / hypergraphs.size(), UL(1));
+    for ( mt_kahypar::Context* context : contexts ) {
+      prepare_context(*context);
+      context->shared_memory.original_num_threads = threads_per_job;
+      context->shared_memory.num_threads = threads_per_job;
+    }
+    mt_kahypar::utils::Randomize::instance().setSeed(contexts[0]->partition.seed);
+
+    tbb::task_group tg;
+    for ( size_t i = 0; i < hypergraphs.size(); ++i ) {
+      tg.run([&, i] {
+        partitioned_hypergraphs[i] = mt_kahypar::partition(*hypergraphs[i], *contexts[i]);
+      });
+    }
+    tg.wait();
+    return partitioned_hypergraphs;
+  }
+
   void improve_partition(mt_kahypar::PartitionedHypergraph& partitioned_hg,
                          mt_kahypar::Context& context,
                          const size_t num_vcycles) {
@@ -152,6 +236,14 @@ PYBIND11_MODULE(mtkahyparhgp, m) {
     .value("CUT", Objective::cut)
     .value("KM1", Objective::km1);
 
+  using mt_kahypar::utils::ProgressPhase;
+  py::enum_<ProgressPhase>(m, "ProgressPhase")
+    .value("COARSENING", ProgressPhase::coarsening)
+    .value("INITIAL_PARTITIONING", ProgressPhase::initial_partitioning)
+    .value("REFINEMENT", ProgressPhase::refinement)
+    .value("VCYCLE", ProgressPhase::vcycle)
+    .value("FINISHED", ProgressPhase::finished);
+
   // ####################### Initialize Thread Pool #######################
 
   m.def("initializeThreadPool", &initialize_thread_pool,
@@ -208,6 +300,59 @@ Construct a weighted hypergraph.
         return mt_kahypar::io::readInputFile(file_name, file_format, true);
       }), "Reads a hypergraph from a file (supported file formats are METIS and HMETIS)",
       py::arg("path to hypergraph file"), py::arg("file format"))
+    .def_static("fromCSR", [](const HypernodeID num_hypernodes,
+                              const numpy_array<size_t>& hyperedge_indices,
+                              const numpy_array<HypernodeID>& hyperedges,
+                              const std::optional<numpy_array<HypernodeWeight>>& node_weights,
+                              const std::optional<numpy_array<HyperedgeWeight>>& hyperedge_weights) {
+        if ( hyperedge_indices.size() == 0 || hyperedge_indices.at(0) != 0 ||
+             static_cast<size_t>(hyperedges.size()) != hyperedge_indices.at(hyperedge_indices.size() - 1) ) {
+          ERR("Hyperedge indices do not match the size of the pin array");
+        }
+        const HyperedgeID num_hyperedges = hyperedge_indices.size() - 1;
+        if ( ( node_weights && static_cast<size_t>(node_weights->size()) != num_hypernodes ) ||
+             ( hyperedge_weights && static_cast<size_t>(hyperedge_weights->size()) != num_hyperedges ) ) {
+          ERR("Number of weights does not match the number of nodes or hyperedges");
+        }
+        const size_t* indices = hyperedge_indices.data();
+        const HypernodeID* pins = hyperedges.data();
+        const HypernodeWeight* node_weight_data = node_weights ? node_weights->data() : nullptr;
+        const HyperedgeWeight* hyperedge_weight_data = hyperedge_weights ? hyperedge_weights->data() : nullptr;
+        // The arrays are kept alive by the caller => construct without the GIL
+        py::gil_scoped_release release;
+        // Copy the CSR arrays into the incidence array of the hypergraph
+        // (no intermediate edge vector is required)
+        vec<size_t> pin_offsets(indices, indices + num_hyperedges + 1);
+        mt_kahypar::ds::Array<HypernodeID> incidence_array;
+        incidence_array.resize(pin_offsets.back());
+        tbb::parallel_for<HyperedgeID>(0, num_hyperedges, [&](const HyperedgeID he) {
+          if ( pin_offsets[he] > pin_offsets[he + 1] ) {
+            ERR("Hyperedge indices must be non-decreasing");
+          }
+          for ( size_t pos = pin_offsets[he]; pos < pin_offsets[he + 1]; ++pos ) {
+            if ( pins[pos] >= num_hypernodes ) {
+              ERR("Invalid pin" << pins[pos] << "in hyperedge" << he);
+            }
+            incidence_array[pos] = pins[pos];
+          }
+        });
+        return mt_kahypar::HypergraphFactory::construct_from_incidence_array(
+          num_hypernodes, num_hyperedges, pin_offsets, std::move(incidence_array),
+          hyperedge_weight_data, node_weight_data);
+      }, R"pbdoc(
+Construct a hypergraph from NumPy arrays in CSR format.
+
+:param num_hypernodes: Number of nodes
+:param hyperedge_indices: The pins of hyperedge i are stored in hyperedges[hyperedge_indices[i]:hyperedge_indices[i+1]]
+:param hyperedges: Pins of all hyperedges
+:param node_weights: Weights of all hypernodes (optional)
+:param hyperedge_weights: Weights of all hyperedges (optional)
+          )pbdoc",
+      py::arg("num_hypernodes"),
+      py::arg("hyperedge_indices"),
+      py::arg("hyperedges"),
+      py::arg("node_weights") = py::none(),
+      py::arg("hyperedge_weights") = py::none())
     .def("numNodes", &Hypergraph::initialNumNodes,
       "Number of nodes")
     .def("numEdges", &Hypergraph::initialNumEdges,
@@ -224,6 +369,22 @@ Construct a weighted hypergraph.
       "Size of hyperedge", py::arg("hyperedge"))
     .def("edgeWeight", &Hypergraph::edgeWeight,
       "Weight of hyperedge", py::arg("hyperedge"))
+    .def("nodeWeights", [](const Hypergraph& hypergraph) {
+        return bulk_array<HypernodeWeight>(hypergraph.initialNumNodes(),
+          [&](const HypernodeID hn) { return hypergraph.nodeWeight(hn); });
+      }, "NumPy array of the weights of all nodes")
+    .def("nodeDegrees", [](const Hypergraph& hypergraph) {
+        return bulk_array<HyperedgeID>(hypergraph.initialNumNodes(),
+          [&](const HypernodeID hn) { return hypergraph.nodeDegree(hn); });
+      }, "NumPy array of the degrees of all nodes")
+    .def("edgeSizes", [](const Hypergraph& hypergraph) {
+        return bulk_array<HypernodeID>(hypergraph.initialNumEdges(),
+          [&](const HyperedgeID he) { return hypergraph.edgeSize(he); });
+      }, "NumPy array of the sizes of all hyperedges")
+    .def("edgeWeights", [](const Hypergraph& hypergraph) {
+        return bulk_array<HyperedgeWeight>(hypergraph.initialNumEdges(),
+          [&](const HyperedgeID he) { return hypergraph.edgeWeight(he); });
+      }, "NumPy array of the weights of all hyperedges")
     .def("doForAllNodes", [&](Hypergraph& hypergraph,
                               const std::function<void(const HypernodeID&)>& f) {
         for ( const HypernodeID& hn : hypergraph.nodes() ) {
@@ -262,7 +423,11 @@ Construct a weighted hypergraph.
   py::class_<PartitionedHypergraph>(m, "PartitionedHypergraph")
     .def(py::init<>([](Hypergraph& hypergraph,
                        const PartitionID num_blocks,
-                       const vec<PartitionID>& partition) {
+                       const numpy_array<PartitionID>& partition_array) {
+        if ( static_cast<size_t>(partition_array.size()) != hypergraph.initialNumNodes() ) {
+          ERR("Size of the partition does not match the number of nodes");
+        }
+        const PartitionID* partition = partition_array.data();
         PartitionedHypergraph partitioned_hg(num_blocks, hypergraph, mt_kahypar::parallel_tag_t { });
         partitioned_hg.doParallelForAllNodes([&](const HypernodeID& hn) {
           if ( partition[hn] < 0 || partition[hn] >= num_blocks ) {
@@ -277,7 +442,7 @@ Construct a partitioned hypergraph.
 
 :param hypergraph: hypergraph object
 :param num_blocks: number of block in which the hypergraph should be partitioned into
-:param partition: List of block IDs for each node
+:param partition: List or NumPy array of block IDs for each node
           )pbdoc",
       py::arg("hypergraph"),
       py::arg("number of blocks"),
@@ -312,6 +477,30 @@ Construct a partitioned hypergraph.
       "Weight of all nodes in corresponding block", py::arg("block"))
     .def("blockID", &PartitionedHypergraph::partID,
       "Block ID of node", py::arg("node"))
+    .def("partition", &partition_view,
+      "Read-only NumPy array of the block IDs of all nodes (without copying them)")
+    .def("blockWeights", &block_weights,
+      "NumPy array of the weights of all blocks")
+    .def("connectivities", [](const PartitionedHypergraph& partitioned_hg) {
+        return bulk_array<PartitionID>(partitioned_hg.initialNumEdges(),
+          [&](const HyperedgeID he) { return partitioned_hg.connectivity(he); });
+      }, "NumPy array of the connectivity (number of blocks) of all hyperedges")
+    .def("pinCountsInBlocks", [](const PartitionedHypergraph& partitioned_hg) {
+        const size_t k = partitioned_hg.k();
+        py::array_t<HypernodeID> pin_counts({
+          static_cast<size_t>(partitioned_hg.initialNumEdges()), k });
+        HypernodeID* data = pin_counts.mutable_data();
+        {
+          py::gil_scoped_release release;
+          tbb::parallel_for(ID(0), partitioned_hg.initialNumEdges(), [&](const HyperedgeID he) {
+            for ( PartitionID block = 0; block < partitioned_hg.k(); ++block ) {
+              data[he * k + block] = partitioned_hg.pinCountInPart(he, block);
+            }
+          });
+        }
+        return pin_counts;
+      }, "NumPy array of shape (number of hyperedges, number of blocks), where entry [e, i] "
+         "is the number of pins of hyperedge e in block i")
     .def("isIncidentToCutEdge", &PartitionedHypergraph::isBorderNode,
       "Returns true, if the corresponding node is incident to a cut hyperedge",
       py::arg("node"))
@@ -348,20 +537,34 @@ Construct a partitioned hypergraph.
       },
       "Computes the sum-of-external-degree metric for the partitioned hypergraph")
     .def("writePartitionToFile", [](PartitionedHypergraph& partitioned_hg,
-                                    const std::string& partition_file) {
-        mt_kahypar::io::writePartitionFile(partitioned_hg, partition_file);
-      }, "Writes the partition to a file",
-      py::arg("target partition file"));
+                                    const std::string& partition_file,
+                                    const bool binary) {
+        mt_kahypar::io::writePartitionFile(partitioned_hg, partition_file, binary);
+      }, "Writes the partition to a file (binary = header followed by an int32 array of the block IDs)",
+      py::arg("target partition file"), py::arg("binary") = false)
+    .def("report", [](const PartitionedHypergraph& partitioned_hg, const mt_kahypar::Context& context) {
+        return mt_kahypar::io::json::serializeRunReport(partitioned_hg, context);
+      }, "Returns a JSON report of the partitioning run (metrics, timings, stats, per-level refinement statistics and memory consumption)",
+      py::arg("context"));
 
   // ####################### Partitioning #######################
 
   m.def(
-    "partition", &partition,
+    "partition", &partition, py::call_guard<py::gil_scoped_release>(),
     "Compute a k-way partition of the hypergraph",
     py::arg("hypergraph"), py::arg("context"));
 
   m.def(
-    "improvePartition", &improve_partition,
+    "partitionBatch", &partition_batch, py::call_guard<py::gil_scoped_release>(),
+    R"pbdoc(
+Partitions several hypergraphs concurrently. Each job runs with a budget of the given number of
+threads and idle threads steal work from other jobs. If the number of threads per job is zero,
+the threads are evenly distributed among the jobs. Each job requires its own context.
+          )pbdoc",
+    py::arg("hypergraphs"), py::arg("contexts"), py::arg("number of threads per job") = 0);
+
+  m.def(
+    "improvePartition", &improve_partition, py::call_guard<py::gil_scoped_release>(),
     "Improves a k-way partition (using the V-cycle technique)",
     py::arg("partitioned hypergraph"), py::arg("context"), py::arg("number of V-cycles"));
 
@@ -429,6 +632,33 @@ Construct a partitioned hypergraph.
         context.partition.num_vcycles = num_vcycles;
       }, "Sets the number of V-cycles",
       py::arg("number of vcycles"))
+    .def("setProgressCallback", [](Context& context, py::function callback) {
+        context.progress_reporter = std::make_shared<mt_kahypar::utils::ProgressReporter>(
+          [callback](const mt_kahypar::utils::ProgressUpdate& update) {
+            py::gil_scoped_acquire acquire;
+            try {
+              py::dict progress;
+              progress["phase"] = update.phase;
+              progress["vcycle"] = update.vcycle;
+              progress["level"] = update.level;
+              progress["num_levels"] = update.num_levels;
+              progress["objective"] = update.objective;
+              progress["imbalance"] = update.imbalance;
+              progress["elapsed_seconds"] = update.elapsed_seconds;
+              const py::object result = callback(progress);
+              return result.is_none() || result.cast<bool>();
+            } catch ( py::error_already_set& e ) {
+              // An exception in the callback stops the run
+              e.discard_as_unraisable(__func__);
+              return false;
+            }
+          });
+      }, R"pbdoc(
+Registers a callback that receives a dict with the current phase, V-cycle, level, objective,
+imbalance and elapsed time on each phase transition and after each level of the uncoarsening
+phase. Returning False stops the partitioner as soon as possible.
+          )pbdoc",
+      py::arg("callback"))
     .def("enableLogging", [](Context& context, const bool verbose) {
         context.partition.verbose_output = verbose;
       }, "Enable partitioning output",
@@ -28,6 +28,7 @@ import unittest
 import os
 import multiprocessing
 import math
+import numpy as np
 
 import mtkahypargp as gp
 
@@ -150,6 +151,34 @@ class MainTest(unittest.TestCase):
     self.assertEqual(partitioned_graph.blockWeight(1), 2)
     self.assertEqual(partitioned_graph.blockWeight(2), 2)
 
+  def test_construct_from_numpy_arrays(self):
+    graph = gp.Graph.fromCSR(
+      np.array([0,2,5,8,11,12], dtype=np.uint64),
+      np.array([1,2,0,2,3,0,1,3,1,2,4,3]))
+    partitioned_graph = gp.PartitionedGraph(graph, 3, np.array([0,1,1,2,2]))
+
+    self.assertEqual(graph.numNodes(), 5)
+    self.assertEqual(graph.numEdges(), 6)
+    self.assertEqual(partitioned_graph.cut(), 4)
+
+  def test_partition_and_block_weights_as_numpy_arrays(self):
+    graph = gp.Graph(5, 6, [(0,1),(0,2),(1,2),(1,3),(2,3),(3,4)])
+    partitioned_graph = gp.PartitionedGraph(graph, 3, [0,1,1,2,2])
+    partition = partitioned_graph.partition()
+
+    self.assertEqual(partition.tolist(), [0,1,1,2,2])
+    self.assertFalse(partition.flags.writeable)
+    self.assertEqual(partitioned_graph.blockWeights().tolist(), [1,2,2])
+
+  def test_bulk_accessors_as_numpy_arrays(self):
+    graph = gp.Graph(5, 6, [(0,1),(0,2),(1,2),(1,3),(2,3),(3,4)])
+    partitioned_graph = gp.PartitionedGraph(graph, 3, [0,1,1,2,2])
+
+    self.assertEqual(graph.nodeDegrees().tolist(), [2,3,3,3,1])
+    self.assertEqual(graph.nodeWeights().tolist(), [1,1,1,1,1])
+    self.assertEqual(graph.edgeWeights().tolist(), [1] * 12)
+    self.assertEqual(sorted(partitioned_graph.connectivities().tolist()), [1] * 4 + [2] * 8)
+
   def test_cut_metric(self):
     graph = gp.Graph(5, 6, [(0,1),(0,2),(1,2),(1,3),(2,3),(3,4)])
     partitioned_graph = gp.PartitionedGraph(graph, 3, [0,1,1,2,2])
@@ -238,6 +267,10 @@ class MainTest(unittest.TestCase):
       self.partitioned_graph = gp.partition(self.graph, self.context)
       self.__verifyPartition()
 
+    def setPartition(self, partitioned_graph):
+      self.partitioned_graph = partitioned_graph
+      self.__verifyPartition()
+
     def improvePartition(self, num_vcycles):
       objective_before = self.partitioned_graph.cut()
       gp.improvePartition(self.partitioned_graph, self.context, num_vcycles)
@@ -324,5 +357,14 @@ class MainTest(unittest.TestCase):
     partitioner.partition()
     partitioner.improvePartition(1)
 
+  def test_partitions_several_graphs_in_a_batch(self):
+    partitioners = [ self.GraphPartitioner(gp.PresetType.SPEED, k, 0.03, gp.Objective.CUT, False)
+                     for k in [2, 4, 8] ]
+    partitioned_graphs = gp.partitionBatch([ p.graph for p in partitioners ],
+                                           [ p.context for p in partitioners ], 1)
+    self.assertEqual(len(partitioned_graphs), len(partitioners))
+    for partitioner, partitioned_graph in zip(partitioners, partitioned_graphs):
+      partitioner.setPartition(partitioned_graph)
+
 if __name__ == '__main__':
   unittest.main()
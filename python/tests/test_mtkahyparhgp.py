@@ -28,6 +28,7 @@ import unittest
 import os
 import multiprocessing
 import math
+import numpy as np
 
 import mtkahyparhgp as hgp
 
@@ -127,6 +128,37 @@ class MainTest(unittest.TestCase):
     self.assertEqual(partitioned_hg.blockWeight(1), 3)
     self.assertEqual(partitioned_hg.blockWeight(2), 1)
 
+  def test_construct_from_numpy_arrays(self):
+    hypergraph = hgp.Hypergraph.fromCSR(7,
+      np.array([0,2,6,9,12], dtype=np.uint64),
+      np.array([0,2,0,1,3,4,3,4,6,2,5,6]))
+    partitioned_hg = hgp.PartitionedHypergraph(hypergraph, 3, np.array([0,0,0,1,1,1,2]))
+
+    self.assertEqual(hypergraph.numEdges(), 4)
+    self.assertEqual(hypergraph.numPins(), 12)
+    self.assertEqual(partitioned_hg.km1(), 4)
+
+  def test_partition_and_block_weights_as_numpy_arrays(self):
+    hypergraph = hgp.Hypergraph(7, 4, [[0,2],[0,1,3,4],[3,4,6],[2,5,6]])
+    partitioned_hg = hgp.PartitionedHypergraph(hypergraph, 3, [0,0,0,1,1,1,2])
+    partition = partitioned_hg.partition()
+
+    self.assertEqual(partition.tolist(), [0,0,0,1,1,1,2])
+    self.assertFalse(partition.flags.writeable)
+    self.assertEqual(partitioned_hg.blockWeights().tolist(), [3,3,1])
+
+  def test_bulk_accessors_as_numpy_arrays(self):
+    hypergraph = hgp.Hypergraph(7, 4, [[0,2],[0,1,3,4],[3,4,6],[2,5,6]])
+    partitioned_hg = hgp.PartitionedHypergraph(hypergraph, 3, [0,0,0,1,1,1,2])
+
+    self.assertEqual(hypergraph.nodeDegrees().tolist(), [2,1,2,2,2,1,2])
+    self.assertEqual(hypergraph.edgeSizes().tolist(), [2,4,3,3])
+    self.assertEqual(hypergraph.nodeWeights().tolist(), [1,1,1,1,1,1,1])
+    self.assertEqual(hypergraph.edgeWeights().tolist(), [1,1,1,1])
+    self.assertEqual(partitioned_hg.connectivities().tolist(), [1,2,2,3])
+    self.assertEqual(partitioned_hg.pinCountsInBlocks().tolist(),
+      [[2,0,0],[2,2,0],[0,2,1],[1,1,1]])
+
   def test_metrics(self):
     hypergraph = hgp.Hypergraph(7, 4, [[0,2],[0,1,3,4],[3,4,6],[2,5,6]])
     partitioned_hg = hgp.PartitionedHypergraph(hypergraph, 3, [0,0,0,1,1,1,2])
@@ -232,6 +264,10 @@ class MainTest(unittest.TestCase):
       self.partitioned_hg = hgp.partition(self.hypergraph, self.context)
       self.__verifyPartition()
 
+    def setPartition(self, partitioned_hg):
+      self.partitioned_hg = partitioned_hg
+      self.__verifyPartition()
+
     def improvePartition(self, num_vcycles):
       objective_before = self.partitioned_hg.km1()
       hgp.improvePartition(self.partitioned_hg, self.context, num_vcycles)
@@ -319,5 +355,14 @@ class MainTest(unittest.TestCase):
     partitioner.partition()
     partitioner.improvePartition(1)
 
+  def test_partitions_several_hypergraphs_in_a_batch(self):
+    partitioners = [ self.HypergraphPartitioner(hgp.PresetType.SPEED, k, 0.03, hgp.Objective.KM1, False)
+                     for k in [2, 4, 8] ]
+    partitioned_hgs = hgp.partitionBatch([ p.hypergraph for p in partitioners ],
+                                         [ p.context for p in partitioners ], 1)
+    self.assertEqual(len(partitioned_hgs), len(partitioners))
+    for partitioner, partitioned_hg in zip(partitioners, partitioned_hgs):
+      partitioner.setPartition(partitioned_hg)
+
 if __name__ == '__main__':
   unittest.main()
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "tests/datastructures/hypergraph_fixtures.h"
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/datastructures/static_hypergraph.h"
+#include "mt-kahypar/datastructures/static_hypergraph_factory.h"
+#include "mt-kahypar/datastructures/compressed_incidence_array.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+namespace ds {
+
+using ACompressedIncidenceArray = HypergraphFixture<StaticHypergraph, StaticHypergraphFactory>;
+
+template<typename Range>
+std::vector<typename Range::Iterator::value_type> toVector(Range range) {
+  std::vector<typename Range::Iterator::value_type> ids;
+  for ( const auto& id : range ) {
+    ids.push_back(id);
+  }
+  return ids;
+}
+
+TEST_F(ACompressedIncidenceArray, DecodesPinsOfHyperedges) {
+  auto pins = CompressedIncidenceArray<HypernodeID>::fromPins(hypergraph);
+  ASSERT_EQ(4, pins.numLists());
+  ASSERT_EQ(12, pins.numEntries());
+  ASSERT_EQ(std::vector<HypernodeID>({ 0, 2 }), toVector(pins.get(0)));
+  ASSERT_EQ(std::vector<HypernodeID>({ 0, 1, 3, 4 }), toVector(pins.get(1)));
+  ASSERT_EQ(std::vector<HypernodeID>({ 3, 4, 6 }), toVector(pins.get(2)));
+  ASSERT_EQ(std::vector<HypernodeID>({ 2, 5, 6 }), toVector(pins.get(3)));
+  ASSERT_EQ(4, pins.size(1));
+}
+
+TEST_F(ACompressedIncidenceArray, DecodesIncidentNetsOfVertices) {
+  auto incident_nets = CompressedIncidenceArray<HyperedgeID>::fromIncidentNets(hypergraph);
+  ASSERT_EQ(7, incident_nets.numLists());
+  ASSERT_EQ(12, incident_nets.numEntries());
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    std::vector<HyperedgeID> expected = toVector(hypergraph.incidentEdges(hn));
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected, toVector(incident_nets.get(hn)));
+    ASSERT_EQ(expected.size(), incident_nets.size(hn));
+  }
+}
+
+TEST_F(ACompressedIncidenceArray, SortsListsAndHandlesEmptyLists) {
+  const std::vector<std::vector<HypernodeID>> lists = { { 5, 1, 3 }, { }, { 7 } };
+  CompressedIncidenceArray<HypernodeID> compressed_lists(lists.size(),
+    [&](const size_t i) { return IteratorRange<std::vector<HypernodeID>::const_iterator>(
+      lists[i].cbegin(), lists[i].cend()); });
+  ASSERT_EQ(std::vector<HypernodeID>({ 1, 3, 5 }), toVector(compressed_lists.get(0)));
+  ASSERT_TRUE(compressed_lists.get(1).empty());
+  ASSERT_EQ(0, compressed_lists.size(1));
+  ASSERT_EQ(std::vector<HypernodeID>({ 7 }), toVector(compressed_lists.get(2)));
+}
+
+TEST_F(ACompressedIncidenceArray, EncodesLargeDifferencesWithMultipleBytes) {
+  const std::vector<HypernodeID> list = { 0, 127, 128, 16511, 2113663,
+    std::numeric_limits<HypernodeID>::max() };
+  CompressedIncidenceArray<HypernodeID> compressed_list(1,
+    [&](const size_t) { return IteratorRange<std::vector<HypernodeID>::const_iterator>(
+      list.cbegin(), list.cend()); });
+  ASSERT_EQ(list, toVector(compressed_list.get(0)));
+  ASSERT_EQ(list.size(), compressed_list.size(0));
+}
+
+}
+} // namespace mt_kahypar
@@ -90,6 +90,13 @@ void verify(const ConnectivitySets& conn_set,
     ++connectivity;
   }
   ASSERT_EQ(contained.size(), connectivity);
+
+  // Verify vectorized aggregation
+  std::vector<int32_t> aggregator(k, 1);
+  conn_set.addToAllBlocks(0, 5, aggregator.data());
+  for (PartitionID i = 0; i < k; ++i) {
+    ASSERT_EQ(contained.find(i) != contained.end() ? 6 : 1, aggregator[i]) << V(i);
+  }
 }
 
 TEST(AConnectivitySet, IsCorrectInitialized) {
@@ -97,6 +104,12 @@ TEST(AConnectivitySet, IsCorrectInitialized) {
   verify(conn_set, 32, { });
 }
 
+TEST(AConnectivitySet, AddsValueToAllBlocksContainedInSeveralBitsets) {
+  ConnectivitySets conn_set(1, 150);
+  add(conn_set, { 0, 63, 64, 100, 128, 149 });
+  verify(conn_set, 150, { 0, 63, 64, 100, 128, 149 });
+}
+
 TEST(AConnectivitySet, AddOnePartition1) {
   ConnectivitySets conn_set(1, 32);
   conn_set.add(0, 2);
@@ -736,5 +749,46 @@ TEST(AConnectivitySet, IteratesThroughPartitionsAndSimultanouslyAddAndRemoveElem
   }
 }
 
+TEST(AConnectivitySet, SkipsEmptyBlocksForLargeK) {
+  const PartitionID k = 5000;
+  ConnectivitySets conn_set(3, k);
+  add(conn_set, { 1, 63, 64, 4095, 4096, 4999 });
+  verify(conn_set, k, { 1, 63, 64, 4095, 4096, 4999 });
+  remove(conn_set, { 63, 64, 4999 });
+  verify(conn_set, k, { 1, 4095, 4096 });
+  remove(conn_set, { 1, 4095, 4096 });
+  verify(conn_set, k, { });
+
+  // Connectivity sets of different hyperedges do not interfere
+  conn_set.add(1, 4500);
+  conn_set.add(2, 0);
+  conn_set.add(2, 4999);
+  verify(conn_set, k, { });
+  std::vector<PartitionID> parts;
+  for (const PartitionID id : conn_set.connectivitySet(2)) {
+    parts.push_back(id);
+  }
+  ASSERT_EQ(std::vector<PartitionID>({ 0, 4999 }), parts);
+  ASSERT_EQ(1, conn_set.connectivity(1));
+  ASSERT_TRUE(conn_set.contains(1, 4500));
+  conn_set.clear(2);
+  ASSERT_EQ(0, conn_set.connectivity(2));
+}
+
+TEST(AConnectivitySet, IteratesInIncreasingOrderForLargeK) {
+  const PartitionID k = 300;
+  ConnectivitySets conn_set(1, k);
+  std::vector<PartitionID> expected;
+  for (PartitionID p = 3; p < k; p += 37) {
+    conn_set.add(0, p);
+    expected.push_back(p);
+  }
+  std::vector<PartitionID> parts;
+  for (const PartitionID id : conn_set.connectivitySet(0)) {
+    parts.push_back(id);
+  }
+  ASSERT_EQ(expected, parts);
+}
+
 }  // namespace ds
 }  // namespace mt_kahypar
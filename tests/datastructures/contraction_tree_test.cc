@@ -337,6 +337,46 @@ TEST(AContractionTree, ContainsCorrectVersionRoots4) {
   verifyChildsOfVersion(tree, 7, 2, { 9 });
 }
 
+TEST(AContractionTree, ComputesSubtreeSizesAfterRegisteredContractions) {
+  ContractionTree tree;
+  tree.initialize(5);
+  tree.registerContraction(0, 1);
+  tree.registerContraction(0, 2);
+  tree.registerContraction(1, 3);
+  ASSERT_EQ(2, tree.pendingContractions(0));
+  ASSERT_EQ(1, tree.pendingContractions(1));
+  tree.unregisterContraction(1, 3, 0, 1);
+  tree.unregisterContraction(0, 1, 1, 2);
+  tree.unregisterContraction(0, 2, 2, 3);
+  tree.finalize();
+
+  verifyChilds(tree, 0, { 1, 2 });
+  verifyChilds(tree, 1, { 3 });
+  ASSERT_EQ(3, tree.subtreeSize(0));
+  ASSERT_EQ(1, tree.subtreeSize(1));
+  ASSERT_EQ(0, tree.subtreeSize(2));
+  ASSERT_EQ(0, tree.subtreeSize(3));
+  ASSERT_EQ(0, tree.subtreeSize(4));
+  verifyRoots(tree.roots(), { 0 });
+}
+
+TEST(AContractionTree, CanBeFinalizedAgainAfterReset) {
+  ContractionTree tree;
+  tree.initialize(4);
+  tree.setParent(1, 0);
+  tree.setParent(2, 0);
+  tree.finalize();
+  ASSERT_EQ(2, tree.subtreeSize(0));
+
+  tree.reset();
+  tree.setParent(3, 2);
+  tree.finalize();
+  verifyChilds(tree, 0, { });
+  verifyChilds(tree, 2, { 3 });
+  ASSERT_EQ(0, tree.subtreeSize(0));
+  ASSERT_EQ(1, tree.subtreeSize(2));
+  verifyRoots(tree.roots(), { 2 });
+}
 
 } // namespace ds
 } // namespace mt_kahypar
\ No newline at end of file
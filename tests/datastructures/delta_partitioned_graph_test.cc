@@ -158,5 +158,49 @@ TEST_F(ADeltaPartitionedGraph, MovesVertices) {
   verifyKm1Gain(6, { -2, -2, 0 });
 }
 
+TEST(ADeltaPartitionedGraphWithManyBlocks, TracksIncidentWeightsOfManyTouchedBlocks) {
+  // Star with center 0 => moving the leaves touches all blocks of the center
+  Hypergraph hg = mt_kahypar::HypergraphFactory::construct(6, 5,
+    { {0, 1}, {0, 2}, {0, 3}, {0, 4}, {0, 5} }, nullptr, nullptr, true);
+  mt_kahypar::PartitionedHypergraph phg(6, hg, parallel_tag_t());
+  for ( const HypernodeID& hn : hg.nodes() ) {
+    phg.setOnlyNodePart(hn, 0);
+  }
+  phg.initializePartition();
+  phg.initializeGainCache();
+
+  Context context;
+  context.partition.k = 6;
+  ds::DeltaPartitionedGraph<mt_kahypar::PartitionedHypergraph> delta_phg(context);
+  delta_phg.setPartitionedHypergraph(&phg);
+
+  const vec<std::pair<HypernodeID, PartitionID>> moves =
+    { {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}, {1, 4}, {3, 0}, {5, 1} };
+  for ( const auto& move : moves ) {
+    ASSERT_TRUE(delta_phg.changeNodePartWithGainCacheUpdate(
+      move.first, delta_phg.partID(move.first), move.second, 1000));
+  }
+  vec<PartitionID> delta_part_ids;
+  vec<HyperedgeWeight> delta_incident_weights;
+  for ( const HypernodeID& hn : hg.nodes() ) {
+    delta_part_ids.push_back(delta_phg.partID(hn));
+    for ( PartitionID block = 0; block < 6; ++block ) {
+      delta_incident_weights.push_back(delta_phg.moveToBenefit(hn, block));
+    }
+  }
+
+  // Apply the same moves to the partitioned graph
+  for ( const auto& move : moves ) {
+    ASSERT_TRUE(phg.changeNodePartWithGainCacheUpdate(
+      move.first, phg.partID(move.first), move.second));
+  }
+  for ( const HypernodeID& hn : hg.nodes() ) {
+    ASSERT_EQ(phg.partID(hn), delta_part_ids[hn]);
+    for ( PartitionID block = 0; block < 6; ++block ) {
+      ASSERT_EQ(phg.moveToBenefit(hn, block), delta_incident_weights[6 * hn + block]) << V(hn) << V(block);
+    }
+  }
+}
+
 } // namespace ds
 } // namespace mt_kahypar
\ No newline at end of file
@@ -188,5 +188,22 @@ TEST_F(ADeltaPartitionedHypergraph, MovesSeveralVertices) {
   verifymoveToBenefit(6, { 0, 2, 0 });
 }
 
+TEST_F(ADeltaPartitionedHypergraph, AggregatesGainCacheUpdatesOfAMove) {
+  // Both nets of vertex 4 become cut nets in block 1
+  delta_phg.changeNodePartWithGainCacheUpdate(3, 1, 2, 1000);
+  ASSERT_EQ(0, delta_phg.moveFromPenalty(4));
+  ASSERT_EQ(2, delta_phg.moveFromPenalty(6));
+  verifymoveToBenefit(0, { 2, 1, 1 });
+  verifymoveToBenefit(4, { 1, 2, 2 });
+
+  delta_phg.changeNodePartWithGainCacheUpdate(3, 2, 1, 1000);
+  ASSERT_EQ(2, delta_phg.moveFromPenalty(4));
+  ASSERT_EQ(1, delta_phg.moveFromPenalty(6));
+  verifymoveToBenefit(0, { 2, 1, 0 });
+  verifymoveToBenefit(3, { 1, 2, 1 });
+  verifymoveToBenefit(4, { 1, 2, 1 });
+  verifymoveToBenefit(6, { 1, 1, 2 });
+}
+
 } // namespace ds
 } // namespace mt_kahypar
\ No newline at end of file
@@ -435,5 +435,24 @@ TEST(ADynamicAdjacencyArray, RestoresParrallelEdges2) {
   }
 }
 
+TEST(ADynamicAdjacencyArray, RemovesAndRestoresParallelEdgesOfACopy) {
+  DynamicAdjacencyArray original(
+    7, {{1, 2}, {2, 3}, {1, 4}, {4, 5}, {4, 6}, {5, 6}});
+  original.contract(2, 4);
+  DynamicAdjacencyArray adjacency_array = original.copy(parallel_tag_t());
+  auto edges_to_restore = adjacency_array.removeSinglePinAndParallelEdges();
+  verifyNeighbors(2, 7, adjacency_array, { 1, 3, 5, 6 });
+  verifyEdgeWeight(adjacency_array, 2, 1, 2);
+  adjacency_array.restoreSinglePinAndParallelEdges(edges_to_restore);
+  adjacency_array.uncontract(2, 4);
+  verifyNeighbors(1, 7, adjacency_array, { 2, 4 });
+  verifyNeighbors(2, 7, adjacency_array, { 1, 3 });
+  verifyNeighbors(4, 7, adjacency_array, { 1, 5, 6 });
+
+  for (HyperedgeID e: adjacency_array.edges()) {
+    ASSERT_EQ(1, adjacency_array.edge(e).weight);
+  }
+}
+
 }  // namespace ds
 }  // namespace mt_kahypar
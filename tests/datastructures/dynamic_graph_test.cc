@@ -161,6 +161,22 @@ TEST_F(ADynamicGraph, RemovesVertices) {
   ASSERT_EQ(2, hypergraph.numRemovedHypernodes());
 }
 
+TEST_F(ADynamicGraph, ConstructsSameGraphFromCSR) {
+  const std::vector<size_t> xadj = { 0, 0, 2, 4, 5, 8, 10, 12 };
+  const std::vector<HypernodeID> adjncy = { 4, 2, 3, 1, 2, 6, 1, 5, 4, 6, 5, 4 };
+  DynamicGraph graph = DynamicGraphFactory::construct_from_csr(7, xadj.data(), adjncy.data());
+
+  ASSERT_EQ(hypergraph.initialNumNodes(), graph.initialNumNodes());
+  ASSERT_EQ(hypergraph.initialNumEdges(), graph.initialNumEdges());
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    ASSERT_EQ(hypergraph.nodeDegree(hn), graph.nodeDegree(hn));
+  }
+  for ( const HyperedgeID& he : hypergraph.edges() ) {
+    ASSERT_EQ(hypergraph.edgeSource(he), graph.edgeSource(he));
+    ASSERT_EQ(hypergraph.edgeTarget(he), graph.edgeTarget(he));
+  }
+}
+
 TEST_F(ADynamicGraph, VerifiesEdgeWeights) {
   for ( const HyperedgeID& he : hypergraph.edges() ) {
     ASSERT_EQ(1, hypergraph.edgeWeight(he));
@@ -441,6 +457,20 @@ TEST_F(ADynamicGraph, PerformsAContractionWithWeightGreaterThanMaxNodeWeight) {
   ASSERT_EQ(0, hypergraph.pendingContractions(1));
 }
 
+TEST_F(ADynamicGraph, ContractsAMatching) {
+  ASSERT_EQ(2, hypergraph.contractMatching({ Memento { 1, 2 }, Memento { 4, 5 } }));
+
+  ASSERT_FALSE(hypergraph.nodeIsEnabled(2));
+  ASSERT_FALSE(hypergraph.nodeIsEnabled(5));
+  ASSERT_EQ(2, hypergraph.nodeWeight(1));
+  ASSERT_EQ(2, hypergraph.nodeWeight(4));
+  ASSERT_EQ(0, hypergraph.pendingContractions(1));
+  ASSERT_EQ(0, hypergraph.pendingContractions(4));
+
+  verifyNeighbors(1, hypergraph, { 1, 3, 4 });
+  verifyNeighbors(4, hypergraph, { 1, 4, 6 });
+}
+
 void verifyEqualityOfDynamicGraphs(DynamicGraph& expected_graph,
                                    DynamicGraph& actual_graph) {
   expected_graph.sortIncidentEdges();
@@ -501,6 +531,31 @@ void verifyBatchUncontractions(DynamicGraph& graph,
   verifyEqualityOfDynamicGraphs(expected_graph, graph);
 }
 
+void verifyBatchUncontractionsOfMatchings(DynamicGraph& graph,
+                                          const parallel::scalable_vector<Batch>& matchings,
+                                          const size_t batch_size) {
+  DynamicGraph expected_graph = graph.copy();
+
+  // Perform contractions
+  for ( const Batch& matching : matchings ) {
+    ASSERT_EQ(matching.size(), graph.contractMatching(matching));
+  }
+
+  auto versioned_batches = graph.createBatchUncontractionHierarchy(batch_size);
+
+  while ( !versioned_batches.empty() ) {
+    BatchVector& batches = versioned_batches.back();
+    while ( !batches.empty() ) {
+      const parallel::scalable_vector<Memento> batch = batches.back();
+      graph.uncontract(batch, [](const HyperedgeID&) { return false; });
+      batches.pop_back();
+    }
+    versioned_batches.pop_back();
+  }
+
+  verifyEqualityOfDynamicGraphs(expected_graph, graph);
+}
+
 TEST_F(ADynamicGraph, PerformsBatchUncontractions1) {
   verifyBatchUncontractions(hypergraph,
     { Memento { 0, 2 }, Memento { 3, 4 }, Memento { 5, 6 } }, 3);
@@ -529,6 +584,12 @@ TEST_F(ADynamicGraph, PerformsBatchUncontractions5) {
       Memento { 1, 4 }, Memento { 0, 1 }, Memento { 0, 2 } }, 2);
 }
 
+TEST_F(ADynamicGraph, PerformsBatchUncontractionsOfContractedMatchings) {
+  verifyBatchUncontractionsOfMatchings(hypergraph,
+    { { Memento { 1, 2 }, Memento { 4, 5 } },
+      { Memento { 4, 1 }, Memento { 6, 3 } } }, 2);
+}
+
 TEST_F(ADynamicGraph, GeneratesACompactifiedHypergraph) {
   const parallel::scalable_vector<Memento> contractions =
    { Memento { 0, 3 }, Memento { 1, 5 }, Memento { 6, 2 }, Memento { 6, 4 } };
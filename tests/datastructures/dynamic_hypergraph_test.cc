@@ -947,6 +947,35 @@ TEST_F(ADynamicHypergraph, PerformAContractionsInParallel3) {
     { {6}, {6}, {6}, {5, 6} });
 }
 
+TEST_F(ADynamicHypergraph, ContractsAMatching) {
+  ASSERT_EQ(2, hypergraph.contractMatching({ Memento { 1, 0 }, Memento { 3, 4 } }));
+
+  ASSERT_FALSE(hypergraph.nodeIsEnabled(0));
+  ASSERT_FALSE(hypergraph.nodeIsEnabled(4));
+  ASSERT_EQ(2, hypergraph.nodeWeight(1));
+  ASSERT_EQ(2, hypergraph.nodeWeight(3));
+  ASSERT_EQ(0, hypergraph.pendingContractions(1));
+  ASSERT_EQ(0, hypergraph.pendingContractions(3));
+
+  verifyIncidentNets(1, {0, 1});
+  verifyIncidentNets(3, {1, 2});
+  verifyPins({ 0, 1, 2, 3 },
+    { {1, 2}, {1, 3}, {3, 6}, {2, 5, 6} });
+}
+
+TEST_F(ADynamicHypergraph, ContractsAMatchingWithWeightGreaterThanMaxNodeWeight) {
+  ASSERT_EQ(1, hypergraph.contractMatching({ Memento { 1, 0 } }));
+  ASSERT_EQ(1, hypergraph.contractMatching({ Memento { 1, 2 }, Memento { 3, 4 } }, 2));
+
+  ASSERT_TRUE(hypergraph.nodeIsEnabled(2));
+  ASSERT_FALSE(hypergraph.nodeIsEnabled(4));
+  ASSERT_EQ(2, hypergraph.nodeWeight(1));
+  ASSERT_EQ(2, hypergraph.contractionTree(2));
+  ASSERT_EQ(0, hypergraph.pendingContractions(1));
+  verifyPins({ 0, 1, 2, 3 },
+    { {1, 2}, {1, 3}, {3, 6}, {2, 5, 6} });
+}
+
 void verifyBatchUncontractionHierarchy(ContractionTree& tree,
                                        const VersionedBatchVector& versioned_batches,
                                        const size_t batch_size,
@@ -1269,6 +1298,31 @@ void verifyBatchUncontractions(DynamicHypergraph& hypergraph,
   verifyEqualityOfDynamicHypergraphs(expected_hypergraph, hypergraph);
 }
 
+void verifyBatchUncontractionsOfMatchings(DynamicHypergraph& hypergraph,
+                                          const parallel::scalable_vector<Batch>& matchings,
+                                          const size_t batch_size) {
+  DynamicHypergraph expected_hypergraph = hypergraph.copy();
+
+  // Perform contractions
+  for ( const Batch& matching : matchings ) {
+    ASSERT_EQ(matching.size(), hypergraph.contractMatching(matching));
+  }
+
+  auto versioned_batches = hypergraph.createBatchUncontractionHierarchy(batch_size);
+
+  while ( !versioned_batches.empty() ) {
+    BatchVector& batches = versioned_batches.back();
+    while ( !batches.empty() ) {
+      const parallel::scalable_vector<Memento> batch = batches.back();
+      hypergraph.uncontract(batch);
+      batches.pop_back();
+    }
+    versioned_batches.pop_back();
+  }
+
+  verifyEqualityOfDynamicHypergraphs(expected_hypergraph, hypergraph);
+}
+
 TEST_F(ADynamicHypergraph, PerformsBatchUncontractions1) {
   verifyBatchUncontractions(hypergraph,
     { Memento { 0, 2 }, Memento { 3, 4 }, Memento { 5, 6 } }, 3);
@@ -1298,6 +1352,12 @@ TEST_F(ADynamicHypergraph, PerformsBatchUncontractions5) {
       Memento { 1, 4 }, Memento { 0, 1 }, Memento { 0, 2 } }, 2);
 }
 
+TEST_F(ADynamicHypergraph, PerformsBatchUncontractionsOfContractedMatchings) {
+  verifyBatchUncontractionsOfMatchings(hypergraph,
+    { { Memento { 0, 2 }, Memento { 3, 4 }, Memento { 5, 6 } },
+      { Memento { 0, 3 }, Memento { 5, 1 } } }, 2);
+}
+
 TEST_F(ADynamicHypergraph, RemovesSinglePinAndParallelNets1) {
   const parallel::scalable_vector<Memento> contractions =
    { Memento { 0, 2 }, Memento { 0, 1 }, Memento { 3, 6 }, Memento { 4, 5 } };
@@ -1448,4 +1508,4 @@ TEST_F(ADynamicHypergraph, GeneratesACompactifiedHypergraph2) {
 }
 
 } // namespace ds
-} // namespace mt_kahypar
\ No newline at end of file
+} // namespace mt_kahypar
@@ -0,0 +1,200 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2019 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include <atomic>
+#include <mt-kahypar/macros.h>
+
+#include "gmock/gmock.h"
+#include "tbb/task_group.h"
+
+#include "mt-kahypar/datastructures/gain_cache.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+namespace ds {
+
+template <class F, class K>
+void executeConcurrent(F f1, K f2) {
+  std::atomic<int> cnt(0);
+  tbb::task_group group;
+
+  group.run([&] {
+        cnt++;
+        while (cnt < 2) { }
+        f1();
+      });
+
+  group.run([&] {
+        cnt++;
+        while (cnt < 2) { }
+        f2();
+      });
+
+  group.wait();
+}
+
+vec<std::pair<PartitionID, HyperedgeWeight>> sparseBenefitTerms(const GainCache& gain_cache,
+                                                                const HypernodeID u) {
+  vec<std::pair<PartitionID, HyperedgeWeight>> benefit_terms;
+  const bool success = gain_cache.doForAllSparseBenefitTerms(u,
+    [&](const PartitionID p, const HyperedgeWeight benefit) {
+      benefit_terms.emplace_back(p, benefit);
+    });
+  if ( !success ) {
+    benefit_terms.clear();
+  }
+  return benefit_terms;
+}
+
+TEST(AGainCache, UsesDenseRepresentationForSmallK) {
+  GainCache gain_cache;
+  gain_cache.initialize(10, GainCache::SPARSE_THRESHOLD_K);
+  ASSERT_FALSE(gain_cache.isSparse());
+  ASSERT_EQ(GainCache::num_elements(10, GainCache::SPARSE_THRESHOLD_K),
+    10 * static_cast<size_t>(GainCache::SPARSE_THRESHOLD_K + 1));
+  ASSERT_FALSE(gain_cache.doForAllSparseBenefitTerms(0, [&](const PartitionID, const HyperedgeWeight) { }));
+}
+
+TEST(AGainCache, UsesSparseRepresentationForLargeK) {
+  GainCache gain_cache;
+  gain_cache.initialize(10, 1024);
+  ASSERT_TRUE(gain_cache.isSparse());
+  ASSERT_EQ(GainCache::num_elements(10, 1024), 10 * ( GainCache::NUM_SPARSE_ENTRIES + 1 ));
+}
+
+TEST(AGainCache, IsZeroInitialized) {
+  for ( const PartitionID k : { 32, 1024 } ) {
+    GainCache gain_cache;
+    gain_cache.initialize(10, k);
+    for ( HypernodeID u = 0; u < 10; ++u ) {
+      ASSERT_EQ(0, gain_cache.penalty(u));
+      for ( PartitionID p = 0; p < k; ++p ) {
+        ASSERT_EQ(0, gain_cache.benefit(u, p));
+      }
+    }
+  }
+}
+
+TEST(AGainCache, StoresAndUpdatesPenaltyAndBenefitTerms) {
+  for ( const PartitionID k : { 32, 1024 } ) {
+    GainCache gain_cache;
+    gain_cache.initialize(10, k);
+    gain_cache.storePenalty(3, 5);
+    gain_cache.addPenalty(3, -2);
+    gain_cache.storeBenefit(3, 17, 4);
+    gain_cache.addBenefit(3, 17, 3);
+    gain_cache.addBenefit(3, 21, 2);
+    gain_cache.addBenefit(3, 21, -2);
+    ASSERT_EQ(3, gain_cache.penalty(3));
+    ASSERT_EQ(7, gain_cache.benefit(3, 17));
+    ASSERT_EQ(0, gain_cache.benefit(3, 21));
+    ASSERT_EQ(0, gain_cache.benefit(3, 18));
+    ASSERT_EQ(0, gain_cache.benefit(2, 17));
+    ASSERT_EQ(0, gain_cache.benefit(4, 17));
+  }
+}
+
+TEST(AGainCache, DoesNotInsertZeroBenefitTerms) {
+  GainCache gain_cache;
+  gain_cache.initialize(10, 1024);
+  gain_cache.storeBenefit(3, 17, 0);
+  gain_cache.storeBenefit(3, 42, 1);
+  auto benefit_terms = sparseBenefitTerms(gain_cache, 3);
+  ASSERT_EQ(1, benefit_terms.size());
+  ASSERT_EQ(42, benefit_terms[0].first);
+  ASSERT_EQ(1, benefit_terms[0].second);
+}
+
+TEST(AGainCache, VisitsAllStoredBenefitTerms) {
+  GainCache gain_cache;
+  gain_cache.initialize(10, 1024);
+  gain_cache.addBenefit(5, 1000, 2);
+  gain_cache.addBenefit(5, 3, 1);
+  gain_cache.addBenefit(5, 1000, 2);
+  auto benefit_terms = sparseBenefitTerms(gain_cache, 5);
+  ASSERT_EQ(2, benefit_terms.size());
+  ASSERT_EQ(1000, benefit_terms[0].first);
+  ASSERT_EQ(4, benefit_terms[0].second);
+  ASSERT_EQ(3, benefit_terms[1].first);
+  ASSERT_EQ(1, benefit_terms[1].second);
+  ASSERT_EQ(0, sparseBenefitTerms(gain_cache, 4).size());
+}
+
+TEST(AGainCache, SpillsBenefitTermsIfAllSparseEntriesAreUsed) {
+  GainCache gain_cache;
+  gain_cache.initialize(10, 1024);
+  const PartitionID num_blocks = 2 * GainCache::NUM_SPARSE_ENTRIES;
+  for ( PartitionID p = 0; p < num_blocks; ++p ) {
+    gain_cache.addBenefit(2, 10 * p, p + 1);
+  }
+  for ( PartitionID p = 0; p < num_blocks; ++p ) {
+    ASSERT_EQ(p + 1, gain_cache.benefit(2, 10 * p));
+    ASSERT_EQ(0, gain_cache.benefit(2, 10 * p + 1));
+  }
+  gain_cache.addBenefit(2, 10 * ( num_blocks - 1 ), -num_blocks);
+  ASSERT_EQ(0, gain_cache.benefit(2, 10 * ( num_blocks - 1 )));
+  // Benefit terms of a node with spilled entries can not be enumerated
+  ASSERT_FALSE(gain_cache.doForAllSparseBenefitTerms(2, [&](const PartitionID, const HyperedgeWeight) { }));
+  ASSERT_TRUE(gain_cache.doForAllSparseBenefitTerms(3, [&](const PartitionID, const HyperedgeWeight) { }));
+}
+
+TEST(AGainCache, ResetsAllEntries) {
+  GainCache gain_cache;
+  gain_cache.initialize(10, 1024);
+  gain_cache.storePenalty(2, 3);
+  for ( PartitionID p = 0; p < 2 * static_cast<PartitionID>(GainCache::NUM_SPARSE_ENTRIES); ++p ) {
+    gain_cache.addBenefit(2, p, 1);
+  }
+  gain_cache.reset();
+  ASSERT_EQ(0, gain_cache.penalty(2));
+  for ( PartitionID p = 0; p < 1024; ++p ) {
+    ASSERT_EQ(0, gain_cache.benefit(2, p));
+  }
+  ASSERT_EQ(0, sparseBenefitTerms(gain_cache, 2).size());
+}
+
+TEST(AGainCache, UpdatesSparseEntriesConcurrently) {
+  GainCache gain_cache;
+  gain_cache.initialize(10, 1024);
+  const PartitionID num_blocks = 3 * GainCache::NUM_SPARSE_ENTRIES;
+  executeConcurrent([&] {
+    for ( PartitionID p = 0; p < num_blocks; ++p ) {
+      gain_cache.addBenefit(1, p, 1);
+    }
+  }, [&] {
+    for ( PartitionID p = num_blocks - 1; p >= 0; --p ) {
+      gain_cache.addBenefit(1, p, 2);
+    }
+  });
+  for ( PartitionID p = 0; p < num_blocks; ++p ) {
+    ASSERT_EQ(3, gain_cache.benefit(1, p));
+  }
+}
+
+}  // namespace ds
+}  // namespace mt_kahypar
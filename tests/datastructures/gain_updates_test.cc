@@ -80,6 +80,39 @@ TEST(GainUpdates, Example1) {
   ASSERT_EQ(phg.km1Gain(6, 0, 1), 0);
 }
 
+void verifyGainCacheAfterRandomMoves(const PartitionID k, const PartitionID num_used_blocks) {
+  Hypergraph hg = io::readHypergraphFile("../tests/instances/contracted_ibm01.hgr", 0);
+  mt_kahypar::PartitionedHypergraph phg(k, hg);
+  std::mt19937 rng(420);
+  std::uniform_int_distribution<PartitionID> block_dist(0, num_used_blocks - 1);
+  std::uniform_int_distribution<HypernodeID> node_dist(0, hg.initialNumNodes() - 1);
+  for ( const HypernodeID& u : hg.nodes() ) {
+    phg.setNodePart(u, block_dist(rng));
+  }
+
+  phg.initializeGainCache();
+  ASSERT_TRUE(phg.checkTrackedPartitionInformation());
+
+  for ( size_t i = 0; i < 100; ++i ) {
+    const HypernodeID u = node_dist(rng);
+    const PartitionID from = phg.partID(u);
+    const PartitionID to = block_dist(rng);
+    if ( from != to ) {
+      phg.changeNodePartWithGainCacheUpdate(u, from, to);
+      phg.recomputeMoveFromPenalty(u);
+    }
+  }
+  ASSERT_TRUE(phg.checkTrackedPartitionInformation());
+}
+
+TEST(GainUpdates, WithSparseGainCacheAndFewAdjacentBlocks) {
+  verifyGainCacheAfterRandomMoves(1024, 4);
+}
+
+TEST(GainUpdates, WithSparseGainCacheAndManyAdjacentBlocks) {
+  verifyGainCacheAfterRandomMoves(1024, 1024);
+}
+
 
 }  // namespace ds
 }  // namespace mt_kahypar
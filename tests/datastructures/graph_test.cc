@@ -29,6 +29,7 @@
 #include "tests/datastructures/hypergraph_fixtures.h"
 #include "mt-kahypar/definitions.h"
 #include "mt-kahypar/datastructures/graph.h"
+#include "mt-kahypar/datastructures/star_expansion_view.h"
 
 using ::testing::Test;
 
@@ -357,4 +358,94 @@ TEST_F(AGraph, HasSameTotalVolumeAfterTwoContractions) {
   ASSERT_EQ(6,  coarse_coarse_graph.nodeVolume(2));
 }
 
+
+void verifyStarExpansionView(Hypergraph& hypergraph, const LouvainEdgeWeight edge_weight_type) {
+  Graph graph(hypergraph, edge_weight_type);
+  StarExpansionView view(hypergraph, edge_weight_type);
+  ASSERT_EQ(graph.numNodes(), view.numNodes());
+  ASSERT_EQ(graph.numArcs(), view.numArcs());
+  ASSERT_EQ(graph.max_degree(), view.max_degree());
+  ASSERT_EQ(graph.totalVolume(), view.totalVolume());
+  for ( const NodeID u : graph.nodes() ) {
+    ASSERT_EQ(graph.degree(u), view.degree(u));
+    ASSERT_EQ(graph.nodeVolume(u), view.nodeVolume(u));
+    std::vector<Arc> arcs;
+    for ( const Arc& arc : graph.arcsOf(u) ) {
+      arcs.push_back(arc);
+    }
+    size_t pos = 0;
+    for ( const Arc& arc : view.arcsOf(u) ) {
+      ASSERT_LT(pos, arcs.size());
+      ASSERT_EQ(arcs[pos].head, arc.head);
+      ASSERT_EQ(arcs[pos].weight, arc.weight);
+      ++pos;
+    }
+    ASSERT_EQ(arcs.size(), pos);
+  }
+}
+
+TEST_F(AGraph, HasSameArcsAsStarExpansionViewForUniformEdgeWeight) {
+  verifyStarExpansionView(hypergraph, LouvainEdgeWeight::uniform);
+}
+
+TEST_F(AGraph, HasSameArcsAsStarExpansionViewForNonUniformEdgeWeight) {
+  verifyStarExpansionView(hypergraph, LouvainEdgeWeight::non_uniform);
+}
+
+TEST_F(AGraph, HasSameArcsAsStarExpansionViewForDegreeEdgeWeight) {
+  verifyStarExpansionView(hypergraph, LouvainEdgeWeight::degree);
+}
+
+TEST_F(AGraph, ContractsStarExpansionView) {
+  StarExpansionView view(hypergraph, LouvainEdgeWeight::uniform);
+  Clustering communities = clustering( { 3, 3, 3, 2, 2, 4, 4, 3, 3, 2, 4 } );
+  Graph coarse_graph = view.contract(communities, false);
+
+  ASSERT_EQ(view.totalVolume(), coarse_graph.totalVolume());
+  ASSERT_EQ(2, coarse_graph.max_degree());
+  ASSERT_EQ(7,  coarse_graph.nodeVolume(0));
+  ASSERT_EQ(11, coarse_graph.nodeVolume(1));
+  ASSERT_EQ(6,  coarse_graph.nodeVolume(2));
+
+  verifyArcIterator(coarse_graph, 0, {1, 2}, {2, 1});
+  verifyArcIterator(coarse_graph, 1, {0, 2}, {2, 1});
+  verifyArcIterator(coarse_graph, 2, {0, 1}, {1, 1});
+}
+
+TEST_F(AGraph, ContractCommunitiesWithAHighDegreeNode) {
+  // Star with a path over its leaves, where the center exceeds the high degree threshold
+  const HypernodeID num_leaves = 100002;
+  parallel::scalable_vector<parallel::scalable_vector<HypernodeID>> edges;
+  for ( HypernodeID leaf = 1; leaf <= num_leaves; ++leaf ) {
+    edges.push_back({ 0, leaf });
+    if ( leaf < num_leaves ) {
+      edges.push_back({ leaf, leaf + 1 });
+    }
+  }
+  Hypergraph graph_hg = HypergraphFactory::construct(num_leaves + 1, edges.size(), edges);
+  Graph graph(graph_hg, LouvainEdgeWeight::uniform, true);
+  Clustering communities(num_leaves + 1, 0);
+  std::vector<std::vector<ArcWeight>> weights(4, std::vector<ArcWeight>(4, 0.0));
+  for ( HypernodeID leaf = 1; leaf <= num_leaves; ++leaf ) {
+    communities[leaf] = 1 + leaf % 3;
+    weights[0][communities[leaf]] += 1.0;
+    weights[communities[leaf]][0] += 1.0;
+    if ( leaf < num_leaves ) {
+      const PartitionID next = 1 + (leaf + 1) % 3;
+      weights[communities[leaf]][next] += 1.0;
+      weights[next][communities[leaf]] += 1.0;
+    }
+  }
+  Graph coarse_graph = graph.contract(communities, false);
+
+  ASSERT_EQ(graph.totalVolume(), coarse_graph.totalVolume());
+  ASSERT_EQ(4, coarse_graph.numNodes());
+  ASSERT_EQ(12, coarse_graph.numArcs());
+  ASSERT_EQ(3, coarse_graph.max_degree());
+  verifyArcIterator(coarse_graph, 0, {1, 2, 3}, {weights[0][1], weights[0][2], weights[0][3]});
+  verifyArcIterator(coarse_graph, 1, {0, 2, 3}, {weights[1][0], weights[1][2], weights[1][3]});
+  verifyArcIterator(coarse_graph, 2, {0, 1, 3}, {weights[2][0], weights[2][1], weights[2][3]});
+  verifyArcIterator(coarse_graph, 3, {0, 1, 2}, {weights[3][0], weights[3][1], weights[3][2]});
+}
+
 } // namespace mt_kahypar::ds
\ No newline at end of file
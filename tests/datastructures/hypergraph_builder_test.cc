@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include <algorithm>
+
+#include "gmock/gmock.h"
+
+#include "tbb/parallel_for.h"
+
+#include "mt-kahypar/datastructures/hypergraph_builder.h"
+#include "mt-kahypar/datastructures/static_hypergraph.h"
+#include "mt-kahypar/datastructures/static_hypergraph_factory.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+namespace ds {
+
+using Builder = HypergraphBuilder<StaticHypergraph, StaticHypergraphFactory>;
+
+vec<HypernodeID> sortedPins(const StaticHypergraph& hypergraph, const HyperedgeID he) {
+  vec<HypernodeID> pins;
+  for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+    pins.push_back(pin);
+  }
+  std::sort(pins.begin(), pins.end());
+  return pins;
+}
+
+TEST(AHypergraphBuilder, ConstructsHyperedgesInInsertionOrder) {
+  const HypernodeWeight node_weights[] = { 1, 2, 3, 4, 5, 6, 7 };
+  Builder builder(7, node_weights);
+  const vec<vec<HypernodeID>> edges = { {0, 2}, {0, 1, 3, 4}, {3, 4, 6}, {2, 5, 6} };
+  for ( size_t i = 0; i < edges.size(); ++i ) {
+    builder.addHyperedge(edges[i].data(), edges[i].size(), static_cast<HyperedgeWeight>(i + 1));
+  }
+  ASSERT_EQ(4, builder.numAddedHyperedges());
+
+  StaticHypergraph hypergraph = builder.finalize();
+  ASSERT_EQ(7, hypergraph.initialNumNodes());
+  ASSERT_EQ(4, hypergraph.initialNumEdges());
+  ASSERT_EQ(12, hypergraph.initialNumPins());
+  ASSERT_EQ(28, hypergraph.totalWeight());
+  for ( HyperedgeID he = 0; he < 4; ++he ) {
+    ASSERT_EQ(edges[he], sortedPins(hypergraph, he));
+    ASSERT_EQ(static_cast<HyperedgeWeight>(he + 1), hypergraph.edgeWeight(he));
+  }
+  ASSERT_EQ(0, builder.numAddedHyperedges());
+}
+
+TEST(AHypergraphBuilder, ConstructsHyperedgesAddedConcurrently) {
+  const HypernodeID num_nodes = 1000;
+  const HyperedgeID num_edges = 100000;
+  Builder builder(num_nodes);
+  tbb::parallel_for(ID(0), num_edges, [&](const HyperedgeID he) {
+    // The hyperedge ID is encoded in its weight and its size
+    const HypernodeID pins[] = { he % num_nodes, (he + 1) % num_nodes, (he + 2) % num_nodes };
+    builder.addHyperedge(pins, 2 + he % 2, static_cast<HyperedgeWeight>(he + 1));
+  });
+
+  StaticHypergraph hypergraph = builder.finalize();
+  ASSERT_EQ(num_edges, hypergraph.initialNumEdges());
+  ASSERT_EQ(num_edges * 2 + num_edges / 2, hypergraph.initialNumPins());
+  vec<bool> seen(num_edges, false);
+  for ( const HyperedgeID& he : hypergraph.edges() ) {
+    const HyperedgeID original_he = hypergraph.edgeWeight(he) - 1;
+    ASSERT_FALSE(seen[original_he]);
+    seen[original_he] = true;
+    vec<HypernodeID> expected = { original_he % num_nodes, (original_he + 1) % num_nodes };
+    if ( original_he % 2 == 1 ) {
+      expected.push_back((original_he + 2) % num_nodes);
+    }
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected, sortedPins(hypergraph, he));
+  }
+}
+
+}  // namespace ds
+}  // namespace mt_kahypar
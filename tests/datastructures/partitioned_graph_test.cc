@@ -347,6 +347,37 @@ TYPED_TEST(APartitionedGraph, ExtractBlockZeroWithCommunityInformation) {
   ASSERT_EQ(2, hg.communityID(mapping[2]));
 }
 
+TYPED_TEST(APartitionedGraph, ExtractsAllBlocks) {
+  this->hypergraph.setCommunityID(0, 0);
+  this->hypergraph.setCommunityID(1, 1);
+  this->hypergraph.setCommunityID(2, 2);
+  this->hypergraph.setCommunityID(3, 4);
+  this->hypergraph.setCommunityID(4, 3);
+  this->hypergraph.setCommunityID(5, 4);
+  this->hypergraph.setCommunityID(6, 5);
+
+  auto extracted_blocks = this->partitioned_hypergraph.extractAllBlocks(true, true);
+  auto& hgs = extracted_blocks.first;
+  auto& mapping = extracted_blocks.second;
+  ASSERT_EQ(3, hgs.size());
+
+  ASSERT_EQ(3, hgs[0].initialNumNodes());
+  ASSERT_EQ(2, hgs[0].initialNumEdges());
+  this->verifyPins(hgs[0], {0, 1},
+    { {mapping[1], mapping[2]}, {mapping[1], mapping[2]} });
+  ASSERT_EQ(0, hgs[0].communityID(mapping[0]));
+  ASSERT_EQ(1, hgs[0].communityID(mapping[1]));
+  ASSERT_EQ(2, hgs[0].communityID(mapping[2]));
+
+  ASSERT_EQ(2, hgs[1].initialNumNodes());
+  ASSERT_EQ(0, hgs[1].initialNumEdges());
+
+  ASSERT_EQ(2, hgs[2].initialNumNodes());
+  ASSERT_EQ(2, hgs[2].initialNumEdges());
+  this->verifyPins(hgs[2], {0, 1},
+    { {mapping[5], mapping[6]}, {mapping[5], mapping[6]} });
+}
+
 TYPED_TEST(APartitionedGraph, ComputesPartInfoCorrectlyIfNodePartsAreSetOnly) {
   this->partitioned_hypergraph.resetPartition();
   this->partitioned_hypergraph.setOnlyNodePart(0, 0);
@@ -409,5 +440,43 @@ TYPED_TEST(APartitionedGraph, ComputesDeltaAndGainsCorrectlyIfAllNodesMoveConcur
   this->verifyGains(6, {0, -2, -2});
 }
 
+TEST(APartitionedGraphWithLargeK, UsesSparseGainCacheAndComputesGainsCorrectly) {
+  const PartitionID k = GainCache::SPARSE_THRESHOLD_K + 44;
+  StaticGraph graph = StaticGraphFactory::construct(7 , 6,
+    { {1, 2}, {2, 3}, {1, 4}, {4, 5}, {4, 6}, {5, 6} }, nullptr, nullptr, true);
+  PartitionedGraph<StaticGraph, StaticGraphFactory> partitioned_graph(k, graph);
+  const vec<PartitionID> blocks = { 0, 0, 0, 100, 100, k - 1, k - 1 };
+  for ( const HypernodeID& hn : graph.nodes() ) {
+    partitioned_graph.setNodePart(hn, blocks[hn]);
+  }
+  partitioned_graph.initializeGainCache();
+
+  ASSERT_EQ(1, partitioned_graph.km1Gain(3, 100, 0));
+  ASSERT_EQ(0, partitioned_graph.km1Gain(3, 100, 50));
+  ASSERT_EQ(2, partitioned_graph.km1Gain(4, 100, k - 1));
+  ASSERT_TRUE(partitioned_graph.changeNodePartWithGainCacheUpdate(4, 100, k - 1, 5, []{},
+    [&](auto, auto, auto, auto, auto) { }));
+  ASSERT_EQ(0, partitioned_graph.km1Gain(1, 0, k - 1));
+  ASSERT_EQ(-1, partitioned_graph.km1Gain(4, k - 1, 0));
+  ASSERT_EQ(-2, partitioned_graph.km1Gain(4, k - 1, 100));
+  ASSERT_EQ(1, partitioned_graph.km1Gain(3, 100, 0));
+
+  // Node 4 is adjacent to blocks 0 and k - 1
+  HyperedgeWeight benefit_0 = 0;
+  HyperedgeWeight benefit_k_minus_1 = 0;
+  ASSERT_TRUE(partitioned_graph.doForAllSparseBenefitTerms(4,
+    [&](const PartitionID p, const HyperedgeWeight benefit) {
+      if ( p == 0 ) {
+        benefit_0 = benefit;
+      } else if ( p == k - 1 ) {
+        benefit_k_minus_1 = benefit;
+      } else {
+        ASSERT_EQ(0, benefit) << V(p);
+      }
+    }));
+  ASSERT_EQ(1, benefit_0);
+  ASSERT_EQ(2, benefit_k_minus_1);
+}
+
 }  // namespace ds
 }  // namespace mt_kahypar
\ No newline at end of file
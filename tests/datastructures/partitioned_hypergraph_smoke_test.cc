@@ -26,6 +26,9 @@
 
 #include "tests/datastructures/hypergraph_fixtures.h"
 
+#include <map>
+#include <set>
+
 #include <boost/range/irange.hpp>
 #include <mt-kahypar/partition/refinement/policies/gain_policy.h>
 #include "gmock/gmock.h"
@@ -220,6 +223,36 @@ void verifyBorderNodes(HyperGraph& hypergraph) {
   }
 }
 
+template<typename HyperGraph>
+void verifyBlockPairCuts(HyperGraph& hypergraph,
+                         const PartitionID k) {
+  std::map<std::pair<PartitionID, PartitionID>, HyperedgeWeight> expected_cuts;
+  for (const HyperedgeID& he : hypergraph.edges()) {
+    std::set<PartitionID> blocks;
+    for (const HypernodeID& pin : hypergraph.pins(he)) {
+      blocks.insert(hypergraph.partID(pin));
+    }
+    for (const PartitionID block_0 : blocks) {
+      for (const PartitionID block_1 : blocks) {
+        if (block_0 < block_1) {
+          expected_cuts[std::make_pair(block_0, block_1)] += hypergraph.edgeWeight(he);
+        }
+      }
+    }
+  }
+
+  const vec<metrics::BlockPairCut> block_pair_cuts = metrics::blockPairCuts(hypergraph);
+  ASSERT_EQ(expected_cuts.size(), block_pair_cuts.size());
+  size_t i = 0;
+  for (const auto& expected_cut : expected_cuts) {
+    ASSERT(block_pair_cuts[i].block_1 < k);
+    ASSERT_EQ(expected_cut.first.first, block_pair_cuts[i].block_0);
+    ASSERT_EQ(expected_cut.first.second, block_pair_cuts[i].block_1);
+    ASSERT_EQ(expected_cut.second, block_pair_cuts[i].weight);
+    ++i;
+  }
+}
+
 TYPED_TEST(AConcurrentHypergraph, VerifyBlockWeightsSmokeTest) {
   moveAllNodesOfHypergraphRandom(this->hypergraph, this->k, this->objective, false);
   verifyBlockWeightsAndSizes(this->hypergraph, this->k);
@@ -240,6 +273,11 @@ TYPED_TEST(AConcurrentHypergraph, VerifyBorderNodesSmokeTest) {
   verifyBorderNodes(this->hypergraph);
 }
 
+TYPED_TEST(AConcurrentHypergraph, VerifyBlockPairCutsSmokeTest) {
+  moveAllNodesOfHypergraphRandom(this->hypergraph, this->k, this->objective, false);
+  verifyBlockPairCuts(this->hypergraph, this->k);
+}
+
 
 }  // namespace ds
 }  // namespace mt_kahypar
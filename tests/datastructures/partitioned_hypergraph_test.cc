@@ -30,6 +30,7 @@
 #include <mt-kahypar/parallel/tbb_initializer.h>
 
 #include "gmock/gmock.h"
+#include "tbb/concurrent_vector.h"
 
 #ifdef USE_STRONG_PARTITIONER
 #include "mt-kahypar/datastructures/dynamic_hypergraph_factory.h"
@@ -123,6 +124,14 @@ class APartitionedHypergraph : public Test {
     return km1;
   }
 
+  HyperedgeWeight compute_cut() {
+    HyperedgeWeight cut = 0;
+    for (const HyperedgeID& he : partitioned_hypergraph.edges()) {
+      cut += partitioned_hypergraph.connectivity(he) > 1 ? partitioned_hypergraph.edgeWeight(he) : 0;
+    }
+    return cut;
+  }
+
   void verifyAllKm1GainValues() {
     for ( const HypernodeID hn : hypergraph.nodes() ) {
       const PartitionID from = partitioned_hypergraph.partID(hn);
@@ -183,6 +192,30 @@ TYPED_TEST(APartitionedHypergraph, HasCorrectPartWeightAndSizes) {
   ASSERT_EQ(2, this->partitioned_hypergraph.partWeight(2));
 }
 
+TYPED_TEST(APartitionedHypergraph, VisitsIncidentNetsAndPinsInOrderWithPrefetching) {
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    std::vector<HyperedgeID> expected;
+    for ( const HyperedgeID& he : this->partitioned_hypergraph.incidentEdges(hn) ) {
+      expected.push_back(he);
+    }
+    std::vector<HyperedgeID> actual;
+    this->partitioned_hypergraph.forEachIncidentEdgeWithPrefetching(hn,
+      [&](const HyperedgeID he) { actual.push_back(he); });
+    ASSERT_EQ(expected, actual) << V(hn);
+  }
+
+  for ( const HyperedgeID& he : this->hypergraph.edges() ) {
+    std::vector<HypernodeID> expected;
+    for ( const HypernodeID& pin : this->partitioned_hypergraph.pins(he) ) {
+      expected.push_back(pin);
+    }
+    std::vector<HypernodeID> actual;
+    this->partitioned_hypergraph.template forEachPinWithPrefetching<1>(he,
+      [&](const HypernodeID pin) { actual.push_back(pin); });
+    ASSERT_EQ(expected, actual) << V(he);
+  }
+}
+
 TYPED_TEST(APartitionedHypergraph, HasCorrectPartWeightsIfOnlyOneThreadPerformsModifications) {
   ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(0, 0, 1));
 
@@ -191,6 +224,18 @@ TYPED_TEST(APartitionedHypergraph, HasCorrectPartWeightsIfOnlyOneThreadPerformsM
   ASSERT_EQ(2, this->partitioned_hypergraph.partWeight(2));
 }
 
+TYPED_TEST(APartitionedHypergraph, RejectsMoveThatViolatesMaximumPartWeight) {
+  ASSERT_FALSE(this->partitioned_hypergraph.changeNodePart(0, 0, 1, 2, []{ }, NOOP_FUNC));
+  ASSERT_EQ(0, this->partitioned_hypergraph.partID(0));
+  ASSERT_EQ(3, this->partitioned_hypergraph.partWeight(0));
+  ASSERT_EQ(2, this->partitioned_hypergraph.partWeight(1));
+
+  ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(0, 0, 1, 3, []{ }, NOOP_FUNC));
+  ASSERT_EQ(1, this->partitioned_hypergraph.partID(0));
+  ASSERT_EQ(2, this->partitioned_hypergraph.partWeight(0));
+  ASSERT_EQ(3, this->partitioned_hypergraph.partWeight(1));
+}
+
 TYPED_TEST(APartitionedHypergraph, PerformsConcurrentMovesWhereAllSucceed) {
   executeConcurrent([&] {
     ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(0, 0, 1));
@@ -209,6 +254,63 @@ TYPED_TEST(APartitionedHypergraph, PerformsConcurrentMovesWhereAllSucceed) {
 
 
 
+TYPED_TEST(APartitionedHypergraph, HasCorrectConnectivityAndGainCacheForBipartitions) {
+  using PartitionedHyperGraph = std::remove_reference_t<decltype(this->partitioned_hypergraph)>;
+  PartitionedHyperGraph phg(2, this->hypergraph, parallel_tag_t());
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    phg.setNodePart(hn, hn < 3 ? 0 : 1);
+  }
+  phg.initializeGainCache();
+  ASSERT_EQ(1, phg.connectivity(0));
+  ASSERT_EQ(2, phg.connectivity(1));
+  ASSERT_EQ(1, phg.connectivity(2));
+  ASSERT_EQ(2, phg.connectivity(3));
+
+  ASSERT_TRUE(phg.changeNodePartWithGainCacheUpdate(2, 0, 1));
+  ASSERT_EQ(2, phg.connectivity(0));
+  ASSERT_EQ(1, phg.connectivity(3));
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    ASSERT_EQ(phg.moveFromPenaltyRecomputed(hn), phg.moveFromPenalty(hn)) << V(hn);
+    for ( PartitionID block = 0; block < 2; ++block ) {
+      ASSERT_EQ(phg.moveToBenefitRecomputed(hn, block), phg.moveToBenefit(hn, block)) << V(hn) << V(block);
+    }
+  }
+}
+
+TYPED_TEST(APartitionedHypergraph, InitializesGainCacheOfBorderNodesAndTheirNeighborsLazily) {
+  using PartitionedHyperGraph = std::remove_reference_t<decltype(this->partitioned_hypergraph)>;
+  PartitionedHyperGraph phg(2, this->hypergraph, parallel_tag_t());
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    phg.setNodePart(hn, hn == 5 ? 1 : 0);
+  }
+  // Border nodes are 2, 5 and 6 => only net {0, 2} is small enough to expand
+  phg.initializeGainCacheLazily(3);
+  ASSERT_TRUE(phg.isGainCacheInitialized());
+  const std::set<HypernodeID> valid_nodes = { 0, 2, 5, 6 };
+  auto verify_gain_cache_entry = [&](const HypernodeID hn) {
+    ASSERT_EQ(phg.moveFromPenaltyRecomputed(hn), phg.moveFromPenalty(hn)) << V(hn);
+    for ( PartitionID block = 0; block < 2; ++block ) {
+      ASSERT_EQ(phg.moveToBenefitRecomputed(hn, block), phg.moveToBenefit(hn, block)) << V(hn) << V(block);
+    }
+  };
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    ASSERT_EQ(valid_nodes.count(hn) > 0, phg.isGainCacheEntryValid(hn)) << V(hn);
+    if ( phg.isGainCacheEntryValid(hn) ) {
+      verify_gain_cache_entry(hn);
+    }
+  }
+
+  // Valid entries are maintained by delta updates, invalid ones are initialized on demand
+  ASSERT_TRUE(phg.changeNodePartWithGainCacheUpdate(6, 0, 1));
+  phg.recomputeMoveFromPenalty(6);
+  vec<Gain> benefit_aggregator(2, 0);
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    ASSERT_EQ(valid_nodes.count(hn) == 0, phg.initializeGainCacheEntryIfInvalid(hn, benefit_aggregator));
+    ASSERT_TRUE(phg.isGainCacheEntryValid(hn));
+    verify_gain_cache_entry(hn);
+  }
+}
+
 TYPED_TEST(APartitionedHypergraph, HasCorrectInitialPartitionPinCounts) {
   this->verifyPartitionPinCounts(0, { 2, 0, 0 });
   this->verifyPartitionPinCounts(1, { 2, 2, 0 });
@@ -685,6 +787,81 @@ TYPED_TEST(APartitionedHypergraph, ExtractBlockTwoWithCommunityInformation) {
   ASSERT_EQ(5, hg.communityID(map_from_original_to_extracted_hg(6)));
 }
 
+TYPED_TEST(APartitionedHypergraph, ExtractsAllBlocksWithCutNetSplitting) {
+  auto extracted_blocks = this->partitioned_hypergraph.extractAllBlocks(true, true);
+  auto& hgs = extracted_blocks.first;
+  auto& hn_mapping = extracted_blocks.second;
+  ASSERT_EQ(3, hgs.size());
+
+  ASSERT_EQ(3, hgs[0].initialNumNodes());
+  ASSERT_EQ(2, hgs[0].initialNumEdges());
+  this->verifyPins(hgs[0], {0, 1},
+    { {hn_mapping[0], hn_mapping[2]}, {hn_mapping[0], hn_mapping[1]} });
+
+  ASSERT_EQ(2, hgs[1].initialNumNodes());
+  ASSERT_EQ(2, hgs[1].initialNumEdges());
+  this->verifyPins(hgs[1], {0, 1},
+    { {hn_mapping[3], hn_mapping[4]}, {hn_mapping[3], hn_mapping[4]} });
+
+  ASSERT_EQ(2, hgs[2].initialNumNodes());
+  ASSERT_EQ(1, hgs[2].initialNumEdges());
+  this->verifyPins(hgs[2], {0},
+    { {hn_mapping[5], hn_mapping[6]} });
+}
+
+TYPED_TEST(APartitionedHypergraph, ExtractsAllBlocksWithCutNetRemoval) {
+  this->partitioned_hypergraph.changeNodePart(6, 2, 1);
+  auto extracted_blocks = this->partitioned_hypergraph.extractAllBlocks(false, true);
+  auto& hgs = extracted_blocks.first;
+  auto& hn_mapping = extracted_blocks.second;
+  ASSERT_EQ(3, hgs.size());
+
+  ASSERT_EQ(3, hgs[0].initialNumNodes());
+  ASSERT_EQ(1, hgs[0].initialNumEdges());
+  this->verifyPins(hgs[0], {0},
+    { {hn_mapping[0], hn_mapping[2]} });
+
+  ASSERT_EQ(3, hgs[1].initialNumNodes());
+  ASSERT_EQ(1, hgs[1].initialNumEdges());
+  this->verifyPins(hgs[1], {0},
+    { {hn_mapping[3], hn_mapping[4], hn_mapping[6]} });
+
+  ASSERT_EQ(1, hgs[2].initialNumNodes());
+  ASSERT_EQ(0, hgs[2].initialNumEdges());
+}
+
+TYPED_TEST(APartitionedHypergraph, ExtractsAllBlocksLikeExtractingEachBlockSeparately) {
+  this->hypergraph.setCommunityID(0, 0);
+  this->hypergraph.setCommunityID(1, 1);
+  this->hypergraph.setCommunityID(2, 0);
+  this->hypergraph.setCommunityID(3, 2);
+  this->hypergraph.setCommunityID(4, 3);
+  this->hypergraph.setCommunityID(5, 4);
+  this->hypergraph.setCommunityID(6, 5);
+
+  auto extracted_blocks = this->partitioned_hypergraph.extractAllBlocks(true, true);
+  for ( PartitionID block = 0; block < 3; ++block ) {
+    auto extracted_hg = this->partitioned_hypergraph.extract(block, true, true);
+    auto& expected_hg = extracted_hg.first;
+    auto& actual_hg = extracted_blocks.first[block];
+    ASSERT_EQ(expected_hg.initialNumNodes(), actual_hg.initialNumNodes());
+    ASSERT_EQ(expected_hg.initialNumEdges(), actual_hg.initialNumEdges());
+    ASSERT_EQ(expected_hg.initialNumPins(), actual_hg.initialNumPins());
+    for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+      if ( this->partitioned_hypergraph.partID(hn) == block ) {
+        const HypernodeID extracted_hn = extracted_blocks.second[hn];
+        ASSERT_EQ(extracted_hg.second[hn], extracted_hn);
+        ASSERT_EQ(expected_hg.nodeWeight(extracted_hn), actual_hg.nodeWeight(extracted_hn));
+        ASSERT_EQ(expected_hg.communityID(extracted_hn), actual_hg.communityID(extracted_hn));
+      }
+    }
+    for ( const HyperedgeID& he : expected_hg.edges() ) {
+      ASSERT_EQ(expected_hg.edgeWeight(he), actual_hg.edgeWeight(he));
+      ASSERT_EQ(expected_hg.edgeSize(he), actual_hg.edgeSize(he));
+    }
+  }
+}
+
 
 TYPED_TEST(APartitionedHypergraph, ComputesPartInfoCorrectIfNodePartsAreSetOnly) {
   this->partitioned_hypergraph.resetPartition();
@@ -719,6 +896,27 @@ TYPED_TEST(APartitionedHypergraph, SetPinCountsInPartCorrectIfNodePartsAreSetOnl
   this->verifyPartitionPinCounts(3, { 1, 0, 2 });
 }
 
+TYPED_TEST(APartitionedHypergraph, SetPinCountsInPartCorrectIfBlocksOutnumberPins) {
+  using PartitionedHyperGraph = typename TypeParam::PartitionedHyperGraph;
+  PartitionedHyperGraph phg(8, this->hypergraph, parallel_tag_t());
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    phg.setOnlyNodePart(hn, static_cast<PartitionID>(hn));
+  }
+  phg.initializePartition();
+
+  for ( const HyperedgeID& he : this->hypergraph.edges() ) {
+    std::set<PartitionID> expected_connectivity_set;
+    for ( const HypernodeID& pin : this->hypergraph.pins(he) ) {
+      expected_connectivity_set.insert(static_cast<PartitionID>(pin));
+    }
+    ASSERT_EQ(expected_connectivity_set.size(), phg.connectivity(he)) << V(he);
+    for ( PartitionID block = 0; block < 8; ++block ) {
+      const HypernodeID expected_pin_count = expected_connectivity_set.count(block);
+      ASSERT_EQ(expected_pin_count, phg.pinCountInPart(he, block)) << V(he) << V(block);
+    }
+  }
+}
+
 TYPED_TEST(APartitionedHypergraph, ComputesConnectivitySetCorrectIfNodePartsAreSetOnly) {
   this->partitioned_hypergraph.resetPartition();
   this->partitioned_hypergraph.setOnlyNodePart(0, 0);
@@ -764,5 +962,178 @@ TYPED_TEST(APartitionedHypergraph, ComputesBorderNodesCorrectIfNodePartsAreSetOn
   ASSERT_TRUE(this->partitioned_hypergraph.isBorderNode(6));
 }
 
+TYPED_TEST(APartitionedHypergraph, TracksObjectiveIfNodesMoveConcurrently) {
+  this->partitioned_hypergraph.enableObjectiveTracking();
+  ASSERT_EQ(this->compute_km1(), this->partitioned_hypergraph.trackedKm1());
+  ASSERT_EQ(this->compute_cut(), this->partitioned_hypergraph.trackedCut());
+
+  executeConcurrent([&] {
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(0, 0, 1));
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(2, 0, 2));
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(4, 1, 0));
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(6, 2, 1));
+  }, [&] {
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(1, 0, 2));
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(3, 1, 0));
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(5, 2, 1));
+  });
+
+  ASSERT_EQ(this->compute_km1(), this->partitioned_hypergraph.trackedKm1());
+  ASSERT_EQ(this->compute_cut(), this->partitioned_hypergraph.trackedCut());
+}
+
+TYPED_TEST(APartitionedHypergraph, UpdatesGainCacheAndObjectiveIfNodesAreMovedInParallel) {
+  this->partitioned_hypergraph.enableObjectiveTracking();
+  this->partitioned_hypergraph.initializeGainCache();
+
+  std::atomic<HyperedgeWeight> km1_delta(0);
+  auto delta_func = [&](const HyperedgeID, const HyperedgeWeight edge_weight, const HypernodeID,
+                        const HypernodeID pin_count_in_from_part_after, const HypernodeID pin_count_in_to_part_after) {
+    km1_delta += TrackedObjective::km1Delta(edge_weight, pin_count_in_from_part_after, pin_count_in_to_part_after);
+  };
+  const HyperedgeWeight km1_before = this->compute_km1();
+  ASSERT_TRUE(this->partitioned_hypergraph.changeNodePartWithGainCacheUpdateInParallel(
+    0, 0, 1, std::numeric_limits<HypernodeWeight>::max(), [] { }, delta_func));
+  ASSERT_TRUE(this->partitioned_hypergraph.changeNodePartWithGainCacheUpdateInParallel(
+    6, 2, 1, std::numeric_limits<HypernodeWeight>::max(), [] { }, delta_func));
+  this->partitioned_hypergraph.recomputeMoveFromPenalty(0);
+  this->partitioned_hypergraph.recomputeMoveFromPenalty(6);
+
+  this->verifyPartitionPinCounts(0, { 1, 1, 0 });
+  this->verifyPartitionPinCounts(1, { 1, 3, 0 });
+  this->verifyPartitionPinCounts(2, { 0, 3, 0 });
+  this->verifyPartitionPinCounts(3, { 1, 1, 1 });
+  ASSERT_EQ(this->compute_km1(), km1_before + km1_delta);
+  ASSERT_EQ(this->compute_km1(), this->partitioned_hypergraph.trackedKm1());
+  ASSERT_EQ(this->compute_cut(), this->partitioned_hypergraph.trackedCut());
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    ASSERT_EQ(this->partitioned_hypergraph.moveFromPenaltyRecomputed(hn),
+              this->partitioned_hypergraph.moveFromPenalty(hn)) << V(hn);
+    for ( PartitionID block = 0; block < 3; ++block ) {
+      ASSERT_EQ(this->partitioned_hypergraph.moveToBenefitRecomputed(hn, block),
+                this->partitioned_hypergraph.moveToBenefit(hn, block)) << V(hn) << V(block);
+    }
+  }
+}
+
+TYPED_TEST(APartitionedHypergraph, TracksObjectiveIfPartitionIsReinitialized) {
+  this->partitioned_hypergraph.enableObjectiveTracking();
+  this->partitioned_hypergraph.resetPartition();
+  ASSERT_EQ(0, this->partitioned_hypergraph.trackedKm1());
+  ASSERT_EQ(0, this->partitioned_hypergraph.trackedCut());
+
+  // Assign blocks incrementally
+  this->initializePartition();
+  ASSERT_EQ(this->compute_km1(), this->partitioned_hypergraph.trackedKm1());
+  ASSERT_EQ(this->compute_cut(), this->partitioned_hypergraph.trackedCut());
+
+  // Assign blocks in bulk
+  this->partitioned_hypergraph.resetPartition();
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    this->partitioned_hypergraph.setOnlyNodePart(hn, hn % 2);
+  }
+  this->partitioned_hypergraph.initializePartition();
+  ASSERT_EQ(this->compute_km1(), this->partitioned_hypergraph.trackedKm1());
+  ASSERT_EQ(this->compute_cut(), this->partitioned_hypergraph.trackedCut());
+}
+
+template<typename PHG>
+void verifyTrackedCutNets(PHG& phg) {
+  vec<HyperedgeID> expected_cut_nets;
+  for ( const HyperedgeID& he : phg.edges() ) {
+    if ( phg.connectivity(he) > 1 ) {
+      expected_cut_nets.push_back(he);
+    }
+  }
+  vec<HyperedgeID> cut_nets = phg.cutNets();
+  std::sort(cut_nets.begin(), cut_nets.end());
+  ASSERT_EQ(expected_cut_nets, cut_nets);
+
+  tbb::concurrent_vector<HyperedgeID> concurrent_cut_nets;
+  phg.doParallelForAllCutNets([&](const HyperedgeID he) {
+    concurrent_cut_nets.push_back(he);
+  });
+  vec<HyperedgeID> visited_cut_nets(concurrent_cut_nets.begin(), concurrent_cut_nets.end());
+  std::sort(visited_cut_nets.begin(), visited_cut_nets.end());
+  ASSERT_EQ(expected_cut_nets, visited_cut_nets);
+
+  vec<HypernodeID> expected_border_nodes;
+  for ( const HypernodeID& hn : phg.nodes() ) {
+    if ( phg.isBorderNode(hn) ) {
+      expected_border_nodes.push_back(hn);
+    }
+  }
+  tbb::concurrent_vector<HypernodeID> concurrent_border_nodes;
+  phg.doParallelForAllBorderNodes([&](const HypernodeID hn) {
+    concurrent_border_nodes.push_back(hn);
+  });
+  vec<HypernodeID> border_nodes(concurrent_border_nodes.begin(), concurrent_border_nodes.end());
+  std::sort(border_nodes.begin(), border_nodes.end());
+  ASSERT_EQ(expected_border_nodes, border_nodes);
+}
+
+TYPED_TEST(APartitionedHypergraph, TracksCutNetsIfNodesMoveConcurrently) {
+  this->partitioned_hypergraph.enableCutNetTracking();
+  verifyTrackedCutNets(this->partitioned_hypergraph);
+
+  executeConcurrent([&] {
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(0, 0, 1));
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(2, 0, 2));
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(4, 1, 0));
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(6, 2, 1));
+  }, [&] {
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(1, 0, 2));
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(3, 1, 0));
+    ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(5, 2, 1));
+  });
+  verifyTrackedCutNets(this->partitioned_hypergraph);
+
+  // Moves all nodes into block 0 => no cut nets
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    const PartitionID from = this->partitioned_hypergraph.partID(hn);
+    if ( from != 0 ) {
+      ASSERT_TRUE(this->partitioned_hypergraph.changeNodePart(hn, from, 0));
+    }
+  }
+  ASSERT_EQ(0, this->partitioned_hypergraph.cutNets().size());
+  verifyTrackedCutNets(this->partitioned_hypergraph);
+}
+
+TYPED_TEST(APartitionedHypergraph, TracksCutNetsIfPartitionIsReinitialized) {
+  this->partitioned_hypergraph.enableCutNetTracking();
+  this->partitioned_hypergraph.resetPartition();
+  ASSERT_EQ(0, this->partitioned_hypergraph.cutNets().size());
+
+  // Assign blocks incrementally
+  this->initializePartition();
+  verifyTrackedCutNets(this->partitioned_hypergraph);
+
+  // Assign blocks in bulk
+  this->partitioned_hypergraph.resetPartition();
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    this->partitioned_hypergraph.setOnlyNodePart(hn, hn % 2);
+  }
+  this->partitioned_hypergraph.initializePartition();
+  verifyTrackedCutNets(this->partitioned_hypergraph);
+}
+
+TYPED_TEST(APartitionedHypergraph, EnumeratesCutNetsBetweenTwoBlocks) {
+  this->partitioned_hypergraph.enableCutNetTracking();
+  for ( PartitionID i = 0; i < this->partitioned_hypergraph.k(); ++i ) {
+    for ( PartitionID j = i + 1; j < this->partitioned_hypergraph.k(); ++j ) {
+      vec<HyperedgeID> expected_cut_nets;
+      for ( const HyperedgeID& he : this->partitioned_hypergraph.edges() ) {
+        if ( this->partitioned_hypergraph.pinCountInPart(he, i) > 0 &&
+             this->partitioned_hypergraph.pinCountInPart(he, j) > 0 ) {
+          expected_cut_nets.push_back(he);
+        }
+      }
+      vec<HyperedgeID> cut_nets = this->partitioned_hypergraph.cutNetsBetween(i, j);
+      std::sort(cut_nets.begin(), cut_nets.end());
+      ASSERT_EQ(expected_cut_nets, cut_nets);
+    }
+  }
+}
+
 }  // namespace ds
 }  // namespace mt_kahypar
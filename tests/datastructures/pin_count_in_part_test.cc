@@ -713,5 +713,115 @@ TEST(APinCountInPart, ModifyTwoHyperedgesConcurrently3_k30_Max30) {
   ASSERT_EQ(30, pin_count.pinCountInPart(7, 19));
 }
 
+TEST(APinCountInPart, UsesDenseRepresentationForSmallK) {
+  PinCountInPart pin_count(100, 32, 2);
+  ASSERT_FALSE(pin_count.isSparse());
+}
+
+TEST(APinCountInPart, UsesSparseRepresentationForLargeK) {
+  PinCountInPart pin_count(100, 4096, 10);
+  ASSERT_TRUE(pin_count.isSparse());
+  ASSERT_EQ(100 * PinCountInPart::NUM_SPARSE_ENTRIES,
+    PinCountInPart::num_elements(100, 4096, 10));
+}
+
+TEST(APinCountInPart, IsZeroInitialized_k4096_Max10) {
+  const HyperedgeID num_hyperedges = 10;
+  const PartitionID k = 4096;
+  const HypernodeID max_value = 10;
+  PinCountInPart pin_count(num_hyperedges, k, max_value);
+
+  for ( HyperedgeID he = 0; he < num_hyperedges; ++he ) {
+    for ( PartitionID block = 0; block < k; ++block ) {
+      ASSERT_EQ(0, pin_count.pinCountInPart(he, block));
+    }
+  }
+}
+
+TEST(APinCountInPart, IncrementsAndDecrementsPinCountInPart_k4096_Max10) {
+  const HyperedgeID num_hyperedges = 100;
+  const PartitionID k = 4096;
+  const HypernodeID max_value = 10;
+  PinCountInPart pin_count(num_hyperedges, k, max_value);
+
+  ASSERT_EQ(1, pin_count.incrementPinCountInPart(5, 4095));
+  ASSERT_EQ(2, pin_count.incrementPinCountInPart(5, 4095));
+  ASSERT_EQ(1, pin_count.incrementPinCountInPart(5, 17));
+  ASSERT_EQ(1, pin_count.decrementPinCountInPart(5, 4095));
+  ASSERT_EQ(0, pin_count.decrementPinCountInPart(5, 17));
+  ASSERT_EQ(1, pin_count.pinCountInPart(5, 4095));
+  ASSERT_EQ(0, pin_count.pinCountInPart(5, 17));
+  ASSERT_EQ(0, pin_count.pinCountInPart(4, 4095));
+}
+
+TEST(APinCountInPart, SpillsPinCountsIfAllSparseEntriesAreUsed_k4096_Max10) {
+  const HyperedgeID num_hyperedges = 100;
+  const PartitionID k = 4096;
+  const HypernodeID max_value = 10;
+  PinCountInPart pin_count(num_hyperedges, k, max_value);
+
+  // Uses more blocks than entries available per hyperedge
+  const PartitionID num_blocks = 3 * PinCountInPart::NUM_SPARSE_ENTRIES;
+  for ( PartitionID i = 0; i < num_blocks; ++i ) {
+    pin_count.setPinCountInPart(42, 100 * i, i % max_value + 1);
+  }
+  for ( PartitionID i = 0; i < num_blocks; ++i ) {
+    ASSERT_EQ(i % max_value + 1, pin_count.pinCountInPart(42, 100 * i));
+    ASSERT_EQ(0, pin_count.pinCountInPart(42, 100 * i + 1));
+  }
+
+  // Removing blocks frees entries that are reused by new blocks
+  for ( PartitionID i = 0; i < num_blocks; i += 2 ) {
+    pin_count.setPinCountInPart(42, 100 * i, 0);
+  }
+  for ( PartitionID i = 0; i < num_blocks; i += 2 ) {
+    pin_count.incrementPinCountInPart(42, 100 * i + 1);
+  }
+  for ( PartitionID i = 0; i < num_blocks; ++i ) {
+    ASSERT_EQ(i % 2 == 0 ? 0 : i % max_value + 1, pin_count.pinCountInPart(42, 100 * i));
+    ASSERT_EQ(i % 2 == 0 ? 1 : 0, pin_count.pinCountInPart(42, 100 * i + 1));
+  }
+  ASSERT_EQ(0, pin_count.pinCountInPart(41, 0));
+}
+
+TEST(APinCountInPart, ResetsSparsePinCounts_k4096_Max10) {
+  const HyperedgeID num_hyperedges = 100;
+  const PartitionID k = 4096;
+  const HypernodeID max_value = 10;
+  PinCountInPart pin_count(num_hyperedges, k, max_value);
+
+  for ( PartitionID block = 0; block < 2 * static_cast<PartitionID>(PinCountInPart::NUM_SPARSE_ENTRIES); ++block ) {
+    pin_count.setPinCountInPart(7, block, 3);
+  }
+  pin_count.reset();
+  for ( PartitionID block = 0; block < k; ++block ) {
+    ASSERT_EQ(0, pin_count.pinCountInPart(7, block));
+  }
+}
+
+TEST(APinCountInPart, ModifyTwoHyperedgesConcurrently_k4096_Max10) {
+  const HyperedgeID num_hyperedges = 100;
+  const PartitionID k = 4096;
+  const HypernodeID max_value = 10;
+  PinCountInPart pin_count(num_hyperedges, k, max_value);
+
+  executeConcurrent([&] {
+    for ( PartitionID block = 0; block < 64; ++block ) {
+      pin_count.setPinCountInPart(5, block, 5);
+      pin_count.decrementPinCountInPart(5, block);
+    }
+  }, [&] {
+    for ( PartitionID block = 0; block < 64; ++block ) {
+      pin_count.setPinCountInPart(6, k - block - 1, 5);
+      pin_count.incrementPinCountInPart(6, k - block - 1);
+    }
+  });
+
+  for ( PartitionID block = 0; block < 64; ++block ) {
+    ASSERT_EQ(4, pin_count.pinCountInPart(5, block));
+    ASSERT_EQ(6, pin_count.pinCountInPart(6, k - block - 1));
+  }
+}
+
 }  // namespace ds
 }  // namespace mt_kahypar
@@ -270,5 +270,116 @@ namespace BinaryHeap {
 
 }
 
+namespace BucketPQ {
+  using EBucketQueue = ExclusiveHandleHeap<BucketQueue<int, int>>;
+
+  TEST(ABucketQueue, ReturnsMax) {
+    EBucketQueue h(400);
+    h.setMaxKey(10);
+    h.insert(3, 4);
+    h.insert(2, 5);
+    h.insert(1, -7);
+    ASSERT_EQ(h.top(), 2);
+    ASSERT_EQ(h.topKey(), 5);
+    h.deleteTop();
+    ASSERT_EQ(h.top(), 3);
+    ASSERT_EQ(h.topKey(), 4);
+    h.deleteTop();
+    ASSERT_EQ(h.top(), 1);
+    ASSERT_EQ(h.topKey(), -7);
+  }
+
+  TEST(ABucketQueue, AdjustKeyWorks) {
+    EBucketQueue h(400);
+    h.setMaxKey(10);
+    h.insert(3, 2);
+    h.insert(2, 5);
+    h.insert(1, 1);
+    h.adjustKey(1, 9);
+    ASSERT_EQ(h.top(), 1);
+    ASSERT_EQ(h.topKey(), 9);
+    h.adjustKey(1, -3);
+    ASSERT_EQ(h.top(), 2);
+    ASSERT_EQ(h.keyOf(1), -3);
+  }
+
+  TEST(ABucketQueue, HandlesKeysOutsideOfTheRange) {
+    EBucketQueue h(400);
+    h.setMaxKey(3);
+    h.insert(0, std::numeric_limits<int>::min());
+    h.insert(1, -3);
+    ASSERT_EQ(h.top(), 1);
+    h.deleteTop();
+    ASSERT_EQ(h.top(), 0);
+    ASSERT_EQ(h.topKey(), std::numeric_limits<int>::min());
+  }
+
+  TEST(ABucketQueue, RemoveLeavesRestIntact) {
+    EBucketQueue h(400);
+    h.setMaxKey(20);
+    h.insert(5, 10);
+    h.insert(2, 11);
+    h.insert(1, 12);
+    h.insert(4, 9);
+    h.insert(0, 8);
+    h.insert(6, 14);
+    h.insert(7, 13);
+
+    ASSERT_TRUE(h.contains(2));
+    h.remove(2);
+    ASSERT_FALSE(h.contains(2));
+
+    std::vector<int> expected_id_order = {6, 7, 1, 5, 4, 0};
+    ASSERT_EQ(expected_id_order.size(), h.size());
+    size_t i = 0;
+    while (!h.empty()) {
+      ASSERT_EQ(h.top(), expected_id_order[i++]);
+      h.deleteTop();
+    }
+    ASSERT_TRUE(h.empty());
+  }
+
+  TEST(ABucketQueue, BehavesLikeABinaryHeap) {
+    const int n = 1000;
+    const int max_key = 50;
+    ExclusiveHandleHeap<MaxHeap<int, int>> heap(n);
+    EBucketQueue buckets(n);
+    buckets.setMaxKey(max_key);
+    std::mt19937 rng(420);
+    std::uniform_int_distribution<int> node_dist(0, n - 1);
+    std::uniform_int_distribution<int> key_dist(-max_key, max_key);
+    for (size_t i = 0; i < 100000; ++i) {
+      const int u = node_dist(rng);
+      const int key = key_dist(rng);
+      if (heap.contains(u)) {
+        ASSERT_TRUE(buckets.contains(u));
+        if (key % 3 == 0) {
+          heap.remove(u);
+          buckets.remove(u);
+        } else {
+          heap.adjustKey(u, key);
+          buckets.adjustKey(u, key);
+        }
+      } else {
+        ASSERT_FALSE(buckets.contains(u));
+        heap.insert(u, key);
+        buckets.insert(u, key);
+      }
+      ASSERT_EQ(heap.size(), buckets.size());
+      if (!heap.empty()) {
+        ASSERT_EQ(heap.topKey(), buckets.topKey());
+        ASSERT_EQ(heap.keyOf(buckets.top()), buckets.topKey());
+      }
+      if (i % 1000 == 0) {
+        buckets.deleteTop();
+        heap.clear();
+        for (PosT pos = 0; pos < buckets.size(); ++pos) {
+          heap.insert(buckets.at(pos), buckets.keyAtPos(pos));
+        }
+      }
+    }
+  }
+}
+
 }  // namespace ds
 }  // namespace mt_kahypar
@@ -101,5 +101,111 @@ TYPED_TEST(ADynamicSparseMap, IsForcedToGrow) {
   }
 }
 
+TYPED_TEST(ADynamicSparseMap, ReinsertsElementsAfterClear) {
+  auto& map = this->map;
+  map.initialize(64);
+  for ( size_t i = 0; i < 20; ++i ) {
+    map[64 * i] = i;
+  }
+  map.clear();
+  ASSERT_EQ(0, map.size());
+  for ( size_t i = 0; i < 20; ++i ) {
+    ASSERT_FALSE(map.contains(64 * i));
+  }
+
+  for ( size_t i = 0; i < 20; ++i ) {
+    map[64 * i + 1] = 2 * i;
+  }
+  ASSERT_EQ(20, map.size());
+  for ( size_t i = 0; i < 20; ++i ) {
+    ASSERT_FALSE(map.contains(64 * i));
+    ASSERT_EQ(2 * i, map.get(64 * i + 1));
+  }
+}
+
+TEST(AFixedSizeSparseMap, AddsAndModifiesManyElements) {
+  FixedSizeSparseMap<size_t, double> map(256, 0.0);
+  // Keys with the same lowest bits
+  for ( size_t i = 0; i < 200; ++i ) {
+    map[1024 * i] += 1.0;
+  }
+  for ( size_t i = 0; i < 200; i += 2 ) {
+    map[1024 * i] += 1.0;
+  }
+  ASSERT_EQ(200, map.size());
+  for ( size_t i = 0; i < 200; ++i ) {
+    ASSERT_TRUE(map.contains(1024 * i));
+    ASSERT_FALSE(map.contains(1024 * i + 1));
+    ASSERT_EQ(i % 2 == 0 ? 2.0 : 1.0, map.get(1024 * i));
+  }
+
+  size_t i = 0;
+  for ( const auto& element : map ) {
+    ASSERT_EQ(1024 * i, element.key);
+    ++i;
+  }
+  ASSERT_EQ(200, i);
+}
+
+TEST(AFixedSizeSparseMap, IsReusableAfterClear) {
+  FixedSizeSparseMap<size_t, size_t> map(64, 0);
+  for ( size_t round = 0; round < 10; ++round ) {
+    for ( size_t i = 0; i < 50; ++i ) {
+      map[i + round] += i;
+    }
+    ASSERT_EQ(50, map.size());
+    ASSERT_FALSE(map.contains(round + 50));
+    for ( size_t i = 0; i < 50; ++i ) {
+      ASSERT_EQ(i, map.get(i + round));
+    }
+    map.clear();
+    ASSERT_EQ(0, map.size());
+    ASSERT_FALSE(map.contains(round));
+  }
+}
+
+TEST(AFixedSizeSparseMap, HasAtLeastOneGroupOfSlots) {
+  FixedSizeSparseMap<size_t, size_t> map(3, 0);
+  ASSERT_EQ(GroupedSparseIndex<size_t>::GROUP_SIZE, map.capacity());
+  for ( size_t i = 0; i < map.capacity() - 1; ++i ) {
+    map[i] = i;
+  }
+  for ( size_t i = 0; i < map.capacity() - 1; ++i ) {
+    ASSERT_EQ(i, map.get(i));
+  }
+}
+
+TEST(ASmallSparseMap, AddsAndModifiesElements) {
+  SmallSparseMap<size_t, double, 8> map(0.0);
+  map[4] += 1.5;
+  map[8] += 1.0;
+  map[4] += 2.0;
+  ASSERT_EQ(2, map.size());
+  ASSERT_TRUE(map.contains(4));
+  ASSERT_TRUE(map.contains(8));
+  ASSERT_FALSE(map.contains(1));
+  ASSERT_EQ(3.5, map.get(4));
+  ASSERT_EQ(1.0, map.get(8));
+}
+
+TEST(ASmallSparseMap, IteratesOverAllElements) {
+  SmallSparseMap<size_t, size_t, 8> map(0);
+  for ( size_t i = 0; i < map.capacity(); ++i ) {
+    map[2 * i] = i;
+  }
+  ASSERT_EQ(map.capacity(), map.size());
+  size_t i = 0;
+  for ( const auto& element : map ) {
+    ASSERT_EQ(2 * i, element.key);
+    ASSERT_EQ(i, element.value);
+    ++i;
+  }
+
+  map.clear();
+  ASSERT_EQ(0, map.size());
+  ASSERT_FALSE(map.contains(0));
+  ASSERT_EQ(0, map[0]);
+}
+
 }  // namespace ds
 }  // namespace mt_kahypar
@@ -149,6 +149,54 @@ TEST_F(AStaticGraph, VerifiesEdgeIDs) {
   ASSERT_EQ(5, hypergraph.uniqueEdgeID(11));
 }
 
+TEST_F(AStaticGraph, ConstructsSameGraphFromCSR) {
+  const std::vector<size_t> xadj = { 0, 0, 2, 4, 5, 8, 10, 12 };
+  // Unsorted adjacency lists
+  const std::vector<HypernodeID> adjncy = { 4, 2, 3, 1, 2, 6, 1, 5, 4, 6, 5, 4 };
+  StaticGraph graph = StaticGraphFactory::construct_from_csr(7, xadj.data(), adjncy.data());
+
+  ASSERT_EQ(hypergraph.initialNumNodes(), graph.initialNumNodes());
+  ASSERT_EQ(hypergraph.initialNumEdges(), graph.initialNumEdges());
+  ASSERT_EQ(hypergraph.totalWeight(), graph.totalWeight());
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    ASSERT_EQ(hypergraph.nodeDegree(hn), graph.nodeDegree(hn));
+  }
+  for ( const HyperedgeID& he : hypergraph.edges() ) {
+    ASSERT_EQ(hypergraph.edgeSource(he), graph.edgeSource(he));
+    ASSERT_EQ(hypergraph.edgeTarget(he), graph.edgeTarget(he));
+    ASSERT_EQ(hypergraph.edgeWeight(he), graph.edgeWeight(he));
+  }
+
+  // Forward edges are numbered in the order of their source node
+  const std::vector<HyperedgeID> expected_ids = { 0, 1, 0, 2, 2, 1, 3, 4, 3, 5, 4, 5 };
+  for ( const HyperedgeID& he : graph.edges() ) {
+    ASSERT_EQ(expected_ids[he], graph.uniqueEdgeID(he));
+  }
+}
+
+TEST_F(AStaticGraph, ConstructsGraphWithParallelEdgesFromCSR) {
+  const std::vector<size_t> xadj = { 0, 3, 5, 6 };
+  const std::vector<HypernodeID> adjncy = { 1, 2, 1, 0, 0, 0 };
+  const std::vector<HyperedgeWeight> adjwgt = { 2, 4, 3, 2, 3, 4 };
+  const std::vector<HypernodeWeight> node_weight = { 1, 2, 3 };
+  StaticGraph graph = StaticGraphFactory::construct_from_csr(
+    3, xadj.data(), adjncy.data(), adjwgt.data(), node_weight.data());
+
+  ASSERT_EQ(3, graph.initialNumNodes());
+  ASSERT_EQ(6, graph.initialNumEdges());
+  ASSERT_EQ(6, graph.totalWeight());
+  for ( const HyperedgeID& he : graph.edges() ) {
+    for ( const HyperedgeID& reverse_he : graph.incidentEdges(graph.edgeTarget(he)) ) {
+      if ( graph.uniqueEdgeID(reverse_he) == graph.uniqueEdgeID(he) ) {
+        ASSERT_EQ(graph.edgeSource(he), graph.edgeTarget(reverse_he));
+        ASSERT_EQ(graph.edgeWeight(he), graph.edgeWeight(reverse_he));
+      }
+    }
+  }
+  verifyIncidentNets(graph, 0, { 0, 1, 2 });
+  ASSERT_EQ(4, graph.edgeWeight(2));
+}
+
 TEST_F(AStaticGraph, RemovesVertices) {
   hypergraph.removeDegreeZeroHypernode(0);
   ASSERT_EQ(1, hypergraph.numRemovedHypernodes());
@@ -350,5 +398,57 @@ TEST_F(AStaticGraph, ContractsCommunities2) {
   verifyPins(c_graph, { 1 }, { {1, 2} });
 }
 
+TEST_F(AStaticGraph, ContractsCommunitiesWithAHighDegreeVertex) {
+  // Star with a path over its leaves, where the center exceeds the high degree threshold
+  const HypernodeID num_leaves = 100002;
+  parallel::scalable_vector<parallel::scalable_vector<HypernodeID>> edges;
+  for ( HypernodeID leaf = 1; leaf <= num_leaves; ++leaf ) {
+    edges.push_back({ 0, leaf });
+    if ( leaf < num_leaves ) {
+      edges.push_back({ leaf, leaf + 1 });
+    }
+  }
+  StaticGraph graph = StaticGraphFactory::construct(num_leaves + 1, edges.size(), edges);
+  parallel::scalable_vector<HypernodeID> c_mapping(num_leaves + 1, 0);
+  std::vector<std::vector<HyperedgeWeight>> expected_weights(4, std::vector<HyperedgeWeight>(4, 0));
+  for ( HypernodeID leaf = 1; leaf <= num_leaves; ++leaf ) {
+    c_mapping[leaf] = 1 + leaf % 3;
+    ++expected_weights[0][c_mapping[leaf]];
+    ++expected_weights[c_mapping[leaf]][0];
+    if ( leaf < num_leaves ) {
+      const HypernodeID next = 1 + (leaf + 1) % 3;
+      ++expected_weights[c_mapping[leaf]][next];
+      ++expected_weights[next][c_mapping[leaf]];
+    }
+  }
+  StaticGraph c_graph = graph.contract(c_mapping);
+
+  ASSERT_EQ(4, c_graph.initialNumNodes());
+  ASSERT_EQ(12, c_graph.initialNumEdges());
+  ASSERT_EQ(num_leaves + 1, c_graph.totalWeight());
+  ASSERT_EQ(1, c_graph.nodeWeight(0));
+  std::vector<HyperedgeID> edge_of_unique_id(6, kInvalidHyperedge);
+  for ( const HypernodeID& hn : c_graph.nodes() ) {
+    ASSERT_EQ(3, c_graph.nodeDegree(hn));
+    HypernodeID last_target = 0;
+    for ( const HyperedgeID& he : c_graph.incidentEdges(hn) ) {
+      const HypernodeID target = c_graph.edgeTarget(he);
+      ASSERT_NE(hn, target);
+      ASSERT_TRUE(last_target == 0 || last_target < target);
+      last_target = target;
+      ASSERT_EQ(expected_weights[hn][target], c_graph.edgeWeight(he));
+      const HyperedgeID id = c_graph.uniqueEdgeID(he);
+      ASSERT_LT(id, 6);
+      if ( edge_of_unique_id[id] == kInvalidHyperedge ) {
+        edge_of_unique_id[id] = he;
+      } else {
+        // both directions of an edge share the same id
+        ASSERT_EQ(hn, c_graph.edgeTarget(edge_of_unique_id[id]));
+        ASSERT_EQ(target, c_graph.edgeSource(edge_of_unique_id[id]));
+      }
+    }
+  }
+}
+
 }
 } // namespace mt_kahypar
\ No newline at end of file
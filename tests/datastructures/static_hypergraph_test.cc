@@ -30,6 +30,7 @@
 #include "mt-kahypar/definitions.h"
 #include "mt-kahypar/datastructures/static_hypergraph.h"
 #include "mt-kahypar/datastructures/static_hypergraph_factory.h"
+#include "mt-kahypar/utils/hash.h"
 
 using ::testing::Test;
 
@@ -317,6 +318,144 @@ TEST_F(AStaticHypergraph, ComparesCommunityIdsIfCopiedSequential) {
   ASSERT_EQ(hypergraph.communityID(6), copy_hg.communityID(6));
 }
 
+TEST_F(AStaticHypergraph, SharesIncidenceArraysWithCopyOnWrite) {
+  StaticHypergraph copy_hg = hypergraph.copyOnWrite(parallel_tag_t());
+  copy_hg.setNodeWeight(0, 5);
+  ASSERT_EQ(1, hypergraph.nodeWeight(0));
+  ASSERT_EQ(5, copy_hg.nodeWeight(0));
+  verifyIncidentNets(copy_hg, 2, { 0, 3 });
+  verifyPins(copy_hg, { 0, 1, 2, 3 },
+    { {0, 2}, {0, 1, 3, 4}, {3, 4, 6}, {2, 5, 6} });
+}
+
+TEST_F(AStaticHypergraph, CopiesIncidentNetsOnWriteIfHyperedgeIsRemovedFromCopy) {
+  StaticHypergraph copy_hg = hypergraph.copyOnWrite(parallel_tag_t());
+  copy_hg.removeEdge(3);
+  verifyIncidentNets(copy_hg, 2, { 0 });
+  verifyIncidentNets(copy_hg, 5, { });
+  verifyIncidentNets(copy_hg, 6, { 2 });
+  verifyIncidentNets(2, { 0, 3 });
+  verifyIncidentNets(5, { 3 });
+  verifyIncidentNets(6, { 2, 3 });
+}
+
+TEST_F(AStaticHypergraph, CopiesIncidentNetsOnWriteIfHyperedgeIsRemovedFromOriginal) {
+  StaticHypergraph copy_hg = hypergraph.copyOnWrite(parallel_tag_t());
+  hypergraph.removeEdge(3);
+  verifyIncidentNets(2, { 0 });
+  verifyIncidentNets(5, { });
+  verifyIncidentNets(6, { 2 });
+  verifyIncidentNets(copy_hg, 2, { 0, 3 });
+  verifyIncidentNets(copy_hg, 5, { 3 });
+  verifyIncidentNets(copy_hg, 6, { 2, 3 });
+}
+
+TEST_F(AStaticHypergraph, KeepsSharedIncidenceArraysAliveIfOriginalIsDestroyed) {
+  StaticHypergraph copy_hg = hypergraph.copyOnWrite(parallel_tag_t());
+  StaticHypergraph second_copy_hg = copy_hg.copyOnWrite(parallel_tag_t());
+  hypergraph = StaticHypergraph();
+  copy_hg = StaticHypergraph();
+  verifyIncidentNets(second_copy_hg, 0, { 0, 1 });
+  verifyIncidentNets(second_copy_hg, 6, { 2, 3 });
+  verifyPins(second_copy_hg, { 0, 1, 2, 3 },
+    { {0, 2}, {0, 1, 3, 4}, {3, 4, 6}, {2, 5, 6} });
+}
+
+TEST_F(AStaticHypergraph, HasSortedIncidentNetsWithStableConstruction) {
+  const HypernodeID num_hypernodes = 100;
+  const HyperedgeID num_hyperedges = 10000;
+  vec<vec<HypernodeID>> edges;
+  for ( HyperedgeID he = 0; he < num_hyperedges; ++he ) {
+    edges.push_back({ he % num_hypernodes, (7 * he + 3) % num_hypernodes, (13 * he + 5) % num_hypernodes });
+  }
+  StaticHypergraph hg = StaticHypergraphFactory::construct(num_hypernodes, num_hyperedges, edges);
+  StaticHypergraph stable_hg = StaticHypergraphFactory::construct(
+    num_hypernodes, num_hyperedges, edges, nullptr, nullptr, true);
+
+  ASSERT_EQ(hg.initialNumPins(), stable_hg.initialNumPins());
+  ASSERT_EQ(hg.maxEdgeSize(), stable_hg.maxEdgeSize());
+  for ( const HypernodeID& hn : hg.nodes() ) {
+    vec<HyperedgeID> expected_incident_nets;
+    for ( const HyperedgeID& he : hg.incidentEdges(hn) ) {
+      expected_incident_nets.push_back(he);
+    }
+    std::sort(expected_incident_nets.begin(), expected_incident_nets.end());
+    vec<HyperedgeID> incident_nets;
+    for ( const HyperedgeID& he : stable_hg.incidentEdges(hn) ) {
+      incident_nets.push_back(he);
+    }
+    ASSERT_EQ(expected_incident_nets, incident_nets);
+  }
+}
+
+TEST_F(AStaticHypergraph, IteratesOverEnabledElementsAcrossBlocksOfTheEnabledFlags) {
+  const HypernodeID num_hypernodes = 200;
+  const HyperedgeID num_hyperedges = 150;
+  vec<vec<HypernodeID>> edges;
+  for ( HyperedgeID he = 0; he < num_hyperedges; ++he ) {
+    edges.push_back({ he, he + 1 + he % 3 });
+  }
+  StaticHypergraph hg = StaticHypergraphFactory::construct(num_hypernodes, num_hyperedges, edges);
+  vec<HypernodeID> expected_nodes;
+  for ( HypernodeID hn = 0; hn < num_hypernodes; ++hn ) {
+    if ( hn % 64 == 0 || hn % 64 == 63 || ( hn >= 70 && hn < 140 ) ) {
+      hg.disableHypernode(hn);
+    } else {
+      expected_nodes.push_back(hn);
+    }
+  }
+  vec<HyperedgeID> expected_edges;
+  for ( HyperedgeID he = 0; he < num_hyperedges; ++he ) {
+    if ( he < 64 || he == 149 ) {
+      hg.disableHyperedge(he);
+    } else {
+      expected_edges.push_back(he);
+      ASSERT_EQ(2, hg.edgeSize(he));
+    }
+  }
+
+  vec<HypernodeID> nodes;
+  for ( const HypernodeID& hn : hg.nodes() ) {
+    nodes.push_back(hn);
+  }
+  vec<HyperedgeID> edges_of_hg;
+  for ( const HyperedgeID& he : hg.edges() ) {
+    edges_of_hg.push_back(he);
+  }
+  ASSERT_EQ(expected_nodes, nodes);
+  ASSERT_EQ(expected_edges, edges_of_hg);
+}
+
+TEST_F(AStaticHypergraph, DerivesEdgeSizesFromThePinOffsets) {
+  for ( const HyperedgeID& he : hypergraph.edges() ) {
+    size_t num_pins = 0;
+    for ( const HypernodeID& pin : hypergraph.pins(he) ) {
+      unused(pin);
+      ++num_pins;
+    }
+    ASSERT_EQ(num_pins, hypergraph.edgeSize(he));
+  }
+
+  // Removing a net shrinks the degree of its pins, but not the size of the other nets
+  hypergraph.removeEdge(1);
+  ASSERT_EQ(1, hypergraph.nodeDegree(0));
+  ASSERT_EQ(0, hypergraph.nodeDegree(1));
+  ASSERT_EQ(2, hypergraph.edgeSize(0));
+  ASSERT_EQ(3, hypergraph.edgeSize(2));
+  ASSERT_EQ(3, hypergraph.edgeSize(3));
+
+  parallel::scalable_vector<HypernodeID> c_mapping = {0, 0, 1, 2, 2, 1, 3};
+  StaticHypergraph c_hypergraph = hypergraph.contract(c_mapping);
+  for ( const HyperedgeID& he : c_hypergraph.edges() ) {
+    size_t num_pins = 0;
+    for ( const HypernodeID& pin : c_hypergraph.pins(he) ) {
+      unused(pin);
+      ++num_pins;
+    }
+    ASSERT_EQ(num_pins, c_hypergraph.edgeSize(he));
+  }
+}
+
 TEST_F(AStaticHypergraph, ContractsCommunities1) {
   parallel::scalable_vector<HypernodeID> c_mapping = {1, 4, 1, 5, 5, 4, 5};
   StaticHypergraph c_hypergraph = hypergraph.contract(c_mapping);
@@ -520,6 +659,201 @@ TEST_F(AStaticHypergraph, ContractCommunitiesIfCommunityInformationAreAvailable)
 
 }
 
+TEST_F(AStaticHypergraph, ContractsCommunitiesWithManyParallelHyperedges) {
+  const HyperedgeID num_hyperedges = 1000;
+  vec<vec<HypernodeID>> edges;
+  for ( HyperedgeID he = 0; he < num_hyperedges; ++he ) {
+    edges.push_back(he % 2 == 0 ? vec<HypernodeID>{ 0, 1, 2 } : vec<HypernodeID>{ 3, 2, 4 });
+  }
+  StaticHypergraph hg = StaticHypergraphFactory::construct(5, num_hyperedges, edges);
+
+  parallel::scalable_vector<HypernodeID> c_mapping = {0, 0, 1, 2, 3};
+  StaticHypergraph c_hypergraph = hg.contract(c_mapping);
+
+  ASSERT_EQ(4, c_hypergraph.initialNumNodes());
+  ASSERT_EQ(2, c_hypergraph.initialNumEdges());
+  ASSERT_EQ(5, c_hypergraph.initialNumPins());
+  ASSERT_EQ(num_hyperedges / 2, c_hypergraph.edgeWeight(0));
+  ASSERT_EQ(num_hyperedges / 2, c_hypergraph.edgeWeight(1));
+  verifyPins(c_hypergraph, { 0, 1 }, { {0, 1}, {1, 2, 3} });
+}
+
+TEST_F(AStaticHypergraph, ContractsCommunitiesIntoTheLevelArena) {
+  parallel::LevelArena& arena = parallel::LevelArena::instance();
+  arena.acquire(UL(1) << 16);
+  {
+    for ( const bool low_memory : { false, true } ) {
+      parallel::scalable_vector<HypernodeID> c_mapping = {1, 4, 1, 5, 5, 6, 5};
+      StaticHypergraph c_hypergraph = hypergraph.contract(c_mapping, low_memory);
+      ASSERT_EQ(4, c_hypergraph.initialNumNodes());
+      ASSERT_EQ(2, c_hypergraph.initialNumEdges());
+      ASSERT_EQ(6, c_hypergraph.initialNumPins());
+      verifyIncidentNets(c_hypergraph, 0, { 0, 1 });
+      verifyIncidentNets(c_hypergraph, 1, { 0 });
+      verifyIncidentNets(c_hypergraph, 2, { 0, 1 });
+      verifyIncidentNets(c_hypergraph, 3, { 1 });
+      verifyPins(c_hypergraph, { 0, 1 }, { {0, 1, 2}, {0, 2, 3} });
+    }
+    ASSERT_GT(arena.usedBytes(), 0);
+    ASSERT_EQ(0, arena.numFailedRequests());
+  }
+  arena.release();
+}
+
+TEST_F(AStaticHypergraph, ContractsCommunitiesWithLowMemoryContraction) {
+  parallel::scalable_vector<HypernodeID> c_mapping = {1, 4, 1, 5, 5, 4, 5};
+  StaticHypergraph c_hypergraph = hypergraph.contract(c_mapping, true /* low memory */);
+
+  // Verify Stats
+  ASSERT_EQ(3, c_hypergraph.initialNumNodes());
+  ASSERT_EQ(1, c_hypergraph.initialNumEdges());
+  ASSERT_EQ(3, c_hypergraph.initialNumPins());
+  ASSERT_EQ(3, c_hypergraph.initialTotalVertexDegree());
+  ASSERT_EQ(7, c_hypergraph.totalWeight());
+  ASSERT_EQ(3, c_hypergraph.maxEdgeSize());
+
+  // Verify Vertex and Hyperedge Weights
+  ASSERT_EQ(2, c_hypergraph.nodeWeight(0));
+  ASSERT_EQ(2, c_hypergraph.nodeWeight(1));
+  ASSERT_EQ(3, c_hypergraph.nodeWeight(2));
+  ASSERT_EQ(2, c_hypergraph.edgeWeight(0));
+
+  // Verify Hypergraph Structure
+  verifyIncidentNets(c_hypergraph, 0, { 0 });
+  verifyIncidentNets(c_hypergraph, 1, { 0 });
+  verifyIncidentNets(c_hypergraph, 2, { 0 });
+  verifyPins(c_hypergraph, { 0 }, { {0, 1, 2} });
+}
+
+TEST_F(AStaticHypergraph, HasSameContractedHypergraphWithLowMemoryContraction) {
+  hypergraph.disableHypernode(6);
+  hypergraph.disableHyperedge(1);
+  hypergraph.computeAndSetTotalNodeWeight(parallel_tag_t());
+  StaticHypergraph copy_hg = hypergraph.copy();
+
+  parallel::scalable_vector<HypernodeID> c_mapping = {2, 2, 0, 5, 3, 1, 6};
+  parallel::scalable_vector<HypernodeID> low_memory_c_mapping = c_mapping;
+  StaticHypergraph c_hypergraph = hypergraph.contract(c_mapping);
+  StaticHypergraph low_memory_c_hypergraph = copy_hg.contract(low_memory_c_mapping, true);
+
+  ASSERT_EQ(c_mapping, low_memory_c_mapping);
+  ASSERT_EQ(c_hypergraph.initialNumNodes(), low_memory_c_hypergraph.initialNumNodes());
+  ASSERT_EQ(c_hypergraph.initialNumEdges(), low_memory_c_hypergraph.initialNumEdges());
+  ASSERT_EQ(c_hypergraph.initialNumPins(), low_memory_c_hypergraph.initialNumPins());
+  ASSERT_EQ(c_hypergraph.initialTotalVertexDegree(), low_memory_c_hypergraph.initialTotalVertexDegree());
+  ASSERT_EQ(c_hypergraph.totalWeight(), low_memory_c_hypergraph.totalWeight());
+  ASSERT_EQ(c_hypergraph.maxEdgeSize(), low_memory_c_hypergraph.maxEdgeSize());
+  for ( const HypernodeID& hn : c_hypergraph.nodes() ) {
+    ASSERT_EQ(c_hypergraph.nodeWeight(hn), low_memory_c_hypergraph.nodeWeight(hn));
+    std::set<HyperedgeID> expected_incident_nets;
+    for ( const HyperedgeID& he : c_hypergraph.incidentEdges(hn) ) {
+      expected_incident_nets.insert(he);
+    }
+    verifyIncidentNets(low_memory_c_hypergraph, hn, expected_incident_nets);
+  }
+  for ( const HyperedgeID& he : c_hypergraph.edges() ) {
+    ASSERT_EQ(c_hypergraph.edgeWeight(he), low_memory_c_hypergraph.edgeWeight(he));
+    std::set<HypernodeID> expected_pins;
+    for ( const HypernodeID& pin : c_hypergraph.pins(he) ) {
+      expected_pins.insert(pin);
+    }
+    verifyPins(low_memory_c_hypergraph, { he }, { expected_pins });
+  }
+}
+
+TEST_F(AStaticHypergraph, HasNoFixedVerticesByDefault) {
+  ASSERT_FALSE(hypergraph.hasFixedVertices());
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    ASSERT_FALSE(hypergraph.isFixed(hn));
+    ASSERT_EQ(kInvalidPartition, hypergraph.fixedVertexBlock(hn));
+  }
+}
+
+TEST_F(AStaticHypergraph, FixesVerticesToBlocks) {
+  hypergraph.fixToBlock(0, 1);
+  hypergraph.fixToBlock(3, 0);
+  hypergraph.fixToBlock(3, 0);
+  ASSERT_TRUE(hypergraph.hasFixedVertices());
+  ASSERT_EQ(2, hypergraph.fixedVertexSupport().numFixedVertices());
+  ASSERT_EQ(1, hypergraph.fixedVertexBlock(0));
+  ASSERT_EQ(0, hypergraph.fixedVertexBlock(3));
+  ASSERT_FALSE(hypergraph.isFixed(1));
+}
+
+TEST_F(AStaticHypergraph, ContractsFixedVertices) {
+  hypergraph.fixToBlock(0, 1);
+  hypergraph.fixToBlock(2, 1);
+  hypergraph.fixToBlock(3, 0);
+  parallel::scalable_vector<HypernodeID> c_mapping = {1, 4, 1, 5, 5, 4, 5};
+  StaticHypergraph c_hypergraph = hypergraph.contract(c_mapping);
+
+  ASSERT_TRUE(c_hypergraph.hasFixedVertices());
+  ASSERT_EQ(2, c_hypergraph.fixedVertexSupport().numFixedVertices());
+  ASSERT_EQ(1, c_hypergraph.fixedVertexBlock(0));
+  ASSERT_EQ(kInvalidPartition, c_hypergraph.fixedVertexBlock(1));
+  ASSERT_EQ(0, c_hypergraph.fixedVertexBlock(2));
+}
+
+TEST_F(AStaticHypergraph, ContractsFixedVerticesWithLowMemoryContraction) {
+  hypergraph.fixToBlock(1, 0);
+  hypergraph.fixToBlock(6, 1);
+  parallel::scalable_vector<HypernodeID> c_mapping = {1, 4, 1, 5, 5, 4, 5};
+  StaticHypergraph c_hypergraph = hypergraph.contract(c_mapping, true /* low memory */);
+
+  ASSERT_EQ(kInvalidPartition, c_hypergraph.fixedVertexBlock(0));
+  ASSERT_EQ(0, c_hypergraph.fixedVertexBlock(1));
+  ASSERT_EQ(1, c_hypergraph.fixedVertexBlock(2));
+}
+
+TEST_F(AStaticHypergraph, CopiesFixedVertices) {
+  hypergraph.fixToBlock(4, 1);
+  StaticHypergraph copy_hg = hypergraph.copy(parallel_tag_t());
+  ASSERT_TRUE(copy_hg.hasFixedVertices());
+  ASSERT_EQ(1, copy_hg.fixedVertexBlock(4));
+  ASSERT_FALSE(copy_hg.isFixed(5));
+}
+
+TEST_F(AStaticHypergraph, ContractsASharedCopy) {
+  hypergraph.fixToBlock(4, 1);
+  {
+    StaticHypergraph shared_hg = hypergraph.sharedCopy();
+    ASSERT_EQ(hypergraph.initialNumPins(), shared_hg.initialNumPins());
+    ASSERT_EQ(1, shared_hg.fixedVertexBlock(4));
+    verifyPins(shared_hg, { 0, 1, 2, 3 },
+      { {0, 2}, {0, 1, 3, 4}, {3, 4, 6}, {2, 5, 6} });
+
+    parallel::scalable_vector<HypernodeID> c_mapping = {1, 4, 1, 5, 5, 4, 5};
+    StaticHypergraph c_hypergraph = shared_hg.contract(c_mapping);
+    ASSERT_EQ(3, c_hypergraph.initialNumNodes());
+    ASSERT_EQ(1, c_hypergraph.initialNumEdges());
+    ASSERT_EQ(1, c_hypergraph.fixedVertexBlock(2));
+  }
+  // The shared structure is still valid after destroying the copy
+  verifyPins(hypergraph, { 0, 1, 2, 3 },
+    { {0, 2}, {0, 1, 3, 4}, {3, 4, 6}, {2, 5, 6} });
+}
+
+TEST(ANetFootprint, IsIndependentOfThePinOrder) {
+  // Large enough to use all SIMD lanes and the scalar remainder
+  vec<HypernodeID> pins;
+  for ( HypernodeID pin = 0; pin < 37; ++pin ) {
+    pins.push_back(3 * pin + 5);
+  }
+  const uint64_t footprint = hashing::set::footprint(pins.data(), pins.size());
+  std::reverse(pins.begin(), pins.end());
+  ASSERT_EQ(footprint, hashing::set::footprint(pins.data(), pins.size()));
+  std::rotate(pins.begin(), pins.begin() + 11, pins.end());
+  ASSERT_EQ(footprint, hashing::set::footprint(pins.data(), pins.size()));
+}
+
+TEST(ANetFootprint, DistinguishesNetsWithDifferentPins) {
+  const vec<HypernodeID> lhs = { 0, 3, 4, 7, 8, 9, 12, 13, 20 };
+  const vec<HypernodeID> rhs = { 1, 3, 4, 7, 8, 9, 12, 13, 20 };
+  ASSERT_NE(hashing::set::footprint(lhs.data(), lhs.size()),
+            hashing::set::footprint(rhs.data(), rhs.size()));
+  ASSERT_NE(hashing::set::footprint(lhs.data(), lhs.size()),
+            hashing::set::footprint(lhs.data(), lhs.size() - 1));
+}
 
 }
-} // namespace mt_kahypar
\ No newline at end of file
+} // namespace mt_kahypar
@@ -27,7 +27,12 @@
 
 #include "gmock/gmock.h"
 
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <numeric>
 #include <thread>
+#include <vector>
 
 #include "tbb/parallel_invoke.h"
 
@@ -88,6 +93,22 @@ namespace mt_kahypar {
     mt_kahypar_free_hypergraph(hypergraph);
   }
 
+  TEST(MtKaHyPar, ReadGraphFileAsHypergraphWithQualityPreset) {
+    mt_kahypar_context_t* context = mt_kahypar_context_new();
+    mt_kahypar_load_preset(context, QUALITY);
+
+    mt_kahypar_hypergraph_t* hypergraph =
+      mt_kahypar_read_hypergraph_from_file("test_instances/delaunay_n15.graph", context, METIS);
+
+    ASSERT_EQ(32768, mt_kahypar_num_hypernodes(hypergraph));
+    ASSERT_EQ(98274, mt_kahypar_num_hyperedges(hypergraph));
+    ASSERT_EQ(196548, mt_kahypar_num_pins(hypergraph));
+    ASSERT_EQ(32768, mt_kahypar_hypergraph_weight(hypergraph));
+
+    mt_kahypar_free_context(context);
+    mt_kahypar_free_hypergraph(hypergraph);
+  }
+
   TEST(MtKaHyPar, ConstructUnweightedHypergraph) {
     const mt_kahypar_hypernode_id_t num_vertices = 7;
     const mt_kahypar_hyperedge_id_t num_hyperedges = 4;
@@ -113,6 +134,40 @@ namespace mt_kahypar {
     mt_kahypar_free_hypergraph(hypergraph);
   }
 
+  TEST(MtKaHyPar, ConstructsHypergraphIncrementallyWithBuilder) {
+    std::unique_ptr<mt_kahypar_hypernode_weight_t[]> vertex_weights =
+      std::make_unique<mt_kahypar_hypernode_weight_t[]>(7);
+    vertex_weights[0] = 1; vertex_weights[1] = 2; vertex_weights[2] = 3;
+    vertex_weights[3] = 4; vertex_weights[4] = 5; vertex_weights[5] = 6;
+    vertex_weights[6] = 7;
+
+    mt_kahypar_hypergraph_builder_t* builder = mt_kahypar_hypergraph_builder_new(7, vertex_weights.get());
+    // Two threads add two hyperedges each
+    std::thread first([&] {
+      const mt_kahypar_hypernode_id_t e_0[] = { 0, 2 };
+      const mt_kahypar_hypernode_id_t e_1[] = { 0, 1, 3, 4 };
+      mt_kahypar_hypergraph_builder_add_hyperedge(builder, e_0, 2, 1);
+      mt_kahypar_hypergraph_builder_add_hyperedge(builder, e_1, 4, 1);
+    });
+    std::thread second([&] {
+      const mt_kahypar_hypernode_id_t e_2[] = { 3, 4, 6 };
+      const mt_kahypar_hypernode_id_t e_3[] = { 2, 5, 6 };
+      mt_kahypar_hypergraph_builder_add_hyperedge(builder, e_2, 3, 1);
+      mt_kahypar_hypergraph_builder_add_hyperedge(builder, e_3, 3, 1);
+    });
+    first.join();
+    second.join();
+    mt_kahypar_hypergraph_t* hypergraph = mt_kahypar_hypergraph_builder_finalize(builder);
+    mt_kahypar_free_hypergraph_builder(builder);
+
+    ASSERT_EQ(7, mt_kahypar_num_hypernodes(hypergraph));
+    ASSERT_EQ(4, mt_kahypar_num_hyperedges(hypergraph));
+    ASSERT_EQ(12, mt_kahypar_num_pins(hypergraph));
+    ASSERT_EQ(28, mt_kahypar_hypergraph_weight(hypergraph));
+
+    mt_kahypar_free_hypergraph(hypergraph);
+  }
+
   TEST(MtKaHyPar, ConstructUnweightedGraph) {
     const mt_kahypar_hypernode_id_t num_vertices = 5;
     const mt_kahypar_hyperedge_id_t num_hyperedges = 6;
@@ -228,6 +283,12 @@ namespace mt_kahypar {
       ASSERT_EQ(partition[hn], actual_partition[hn]);
     }
 
+    const mt_kahypar_partition_id_t* partition_view =
+      mt_kahypar_get_hypergraph_partition_view(partitioned_hg);
+    for ( mt_kahypar_hypernode_id_t hn = 0; hn < 7; ++hn ) {
+      ASSERT_EQ(partition[hn], partition_view[hn]);
+    }
+
     mt_kahypar_free_hypergraph(hypergraph);
     mt_kahypar_free_partitioned_hypergraph(partitioned_hg);
   }
@@ -270,6 +331,12 @@ namespace mt_kahypar {
       ASSERT_EQ(partition[hn], actual_partition[hn]);
     }
 
+    const mt_kahypar_partition_id_t* partition_view =
+      mt_kahypar_get_graph_partition_view(partitioned_graph);
+    for ( mt_kahypar_hypernode_id_t hn = 0; hn < 5; ++hn ) {
+      ASSERT_EQ(partition[hn], partition_view[hn]);
+    }
+
     mt_kahypar_free_graph(graph);
     mt_kahypar_free_partitioned_graph(partitioned_graph);
   }
@@ -365,6 +432,425 @@ namespace mt_kahypar {
     mt_kahypar_free_partitioned_graph(partitioned_graph_2);
   }
 
+  TEST(MtKaHyPar, PartitionsSeveralHypergraphsWithinASession) {
+    mt_kahypar_session_t* session = mt_kahypar_session_new();
+    for ( const mt_kahypar_partition_id_t num_blocks : { 2, 8, 4 } ) {
+      mt_kahypar_context_t* context = mt_kahypar_context_new();
+      mt_kahypar_load_preset(context, SPEED);
+      mt_kahypar_set_partitioning_parameters(context, num_blocks, 0.03, KM1, 0);
+      mt_kahypar_set_context_parameter(context, VERBOSE, "0");
+      mt_kahypar_hypergraph_t* hypergraph =
+        mt_kahypar_read_hypergraph_from_file("test_instances/ibm01.hgr", context, HMETIS);
+      mt_kahypar_graph_t* graph =
+        mt_kahypar_read_graph_from_file("test_instances/delaunay_n15.graph", context, METIS);
+
+      std::unique_ptr<mt_kahypar_partition_id_t[]> hg_partition =
+        std::make_unique<mt_kahypar_partition_id_t[]>(mt_kahypar_num_hypernodes(hypergraph));
+      mt_kahypar_session_partition_hypergraph(session, hypergraph, context, hg_partition.get());
+      std::unique_ptr<mt_kahypar_partition_id_t[]> graph_partition =
+        std::make_unique<mt_kahypar_partition_id_t[]>(mt_kahypar_num_nodes(graph));
+      mt_kahypar_session_partition_graph(session, graph, context, graph_partition.get());
+
+      mt_kahypar_partitioned_hypergraph_t* partitioned_hg =
+        mt_kahypar_create_partitioned_hypergraph(hypergraph, num_blocks, hg_partition.get());
+      mt_kahypar_partitioned_graph_t* partitioned_graph =
+        mt_kahypar_create_partitioned_graph(graph, num_blocks, graph_partition.get());
+      ASSERT_LE(mt_kahypar_hypergraph_imbalance(partitioned_hg, context), 0.03);
+      ASSERT_LE(mt_kahypar_graph_imbalance(partitioned_graph, context), 0.03);
+
+      mt_kahypar_free_partitioned_hypergraph(partitioned_hg);
+      mt_kahypar_free_partitioned_graph(partitioned_graph);
+      mt_kahypar_free_hypergraph(hypergraph);
+      mt_kahypar_free_graph(graph);
+      mt_kahypar_free_context(context);
+    }
+    mt_kahypar_free_session(session);
+  }
+
+  TEST(MtKaHyPar, PartitionsSeveralHypergraphsInABatch) {
+    const std::vector<mt_kahypar_partition_id_t> num_blocks = { 2, 4, 8, 2 };
+    std::vector<mt_kahypar_context_t*> contexts;
+    std::vector<mt_kahypar_hypergraph_t*> hypergraphs;
+    for ( const mt_kahypar_partition_id_t k : num_blocks ) {
+      mt_kahypar_context_t* context = mt_kahypar_context_new();
+      // Mixes jobs of the static and dynamic hypergraph backend
+      mt_kahypar_load_preset(context, contexts.size() % 2 == 0 ? SPEED : QUALITY);
+      mt_kahypar_set_partitioning_parameters(context, k, 0.03, KM1, 0);
+      mt_kahypar_set_context_parameter(context, VERBOSE, "0");
+      contexts.push_back(context);
+      hypergraphs.push_back(mt_kahypar_read_hypergraph_from_file(
+        "test_instances/ibm01.hgr", context, HMETIS));
+    }
+
+    std::vector<mt_kahypar_partitioned_hypergraph_t*> partitioned_hgs(num_blocks.size(), nullptr);
+    mt_kahypar_partition_hypergraphs(hypergraphs.data(), contexts.data(),
+      num_blocks.size(), 1, partitioned_hgs.data());
+
+    for ( size_t i = 0; i < num_blocks.size(); ++i ) {
+      ASSERT_NE(nullptr, partitioned_hgs[i]);
+      std::unique_ptr<mt_kahypar_partition_id_t[]> partition =
+        std::make_unique<mt_kahypar_partition_id_t[]>(mt_kahypar_num_hypernodes(hypergraphs[i]));
+      mt_kahypar_get_hypergraph_partition(partitioned_hgs[i], partition.get());
+      for ( mt_kahypar_hypernode_id_t hn = 0; hn < mt_kahypar_num_hypernodes(hypergraphs[i]); ++hn ) {
+        ASSERT_GE(partition[hn], 0);
+        ASSERT_LT(partition[hn], num_blocks[i]);
+      }
+      ASSERT_LE(mt_kahypar_hypergraph_imbalance(partitioned_hgs[i], contexts[i]), 0.03);
+      mt_kahypar_free_partitioned_hypergraph(partitioned_hgs[i]);
+      mt_kahypar_free_hypergraph(hypergraphs[i]);
+      mt_kahypar_free_context(contexts[i]);
+    }
+  }
+
+  TEST(MtKaHyPar, PartitionsHypergraphsConcurrentlyInSeparateThreadPools) {
+    const std::vector<mt_kahypar_partition_id_t> num_blocks = { 2, 4 };
+    std::vector<mt_kahypar_thread_pool_t*> thread_pools;
+    std::vector<mt_kahypar_context_t*> contexts;
+    std::vector<mt_kahypar_hypergraph_t*> hypergraphs;
+    std::vector<mt_kahypar_partitioning_job_t*> jobs;
+    for ( const mt_kahypar_partition_id_t k : num_blocks ) {
+      thread_pools.push_back(mt_kahypar_thread_pool_new(1, nullptr));
+      mt_kahypar_context_t* context = mt_kahypar_context_new();
+      mt_kahypar_load_preset(context, SPEED);
+      mt_kahypar_set_partitioning_parameters(context, k, 0.03, KM1, 0);
+      mt_kahypar_set_context_parameter(context, VERBOSE, "0");
+      mt_kahypar_set_thread_pool(context, thread_pools.back());
+      contexts.push_back(context);
+      hypergraphs.push_back(mt_kahypar_read_hypergraph_from_file(
+        "test_instances/ibm01.hgr", context, HMETIS));
+      jobs.push_back(mt_kahypar_partition_hypergraph_async(hypergraphs.back(), context, 0.0));
+    }
+    // The contexts keep the thread pools alive
+    for ( mt_kahypar_thread_pool_t* thread_pool : thread_pools ) {
+      mt_kahypar_free_thread_pool(thread_pool);
+    }
+
+    for ( size_t i = 0; i < num_blocks.size(); ++i ) {
+      mt_kahypar_partitioned_hypergraph_t* partitioned_hg =
+        mt_kahypar_wait_hypergraph_partitioning_job(jobs[i]);
+      ASSERT_NE(nullptr, partitioned_hg);
+      ASSERT_LE(mt_kahypar_hypergraph_imbalance(partitioned_hg, contexts[i]), 0.03);
+      mt_kahypar_free_partitioned_hypergraph(partitioned_hg);
+      mt_kahypar_free_partitioning_job(jobs[i]);
+      mt_kahypar_free_hypergraph(hypergraphs[i]);
+      mt_kahypar_free_context(contexts[i]);
+    }
+  }
+
+  TEST(MtKaHyPar, PartitionsAHypergraphAsynchronously) {
+    mt_kahypar_context_t* context = mt_kahypar_context_new();
+    mt_kahypar_load_preset(context, SPEED);
+    mt_kahypar_set_partitioning_parameters(context, 4, 0.03, KM1, 0);
+    mt_kahypar_set_context_parameter(context, VERBOSE, "0");
+    mt_kahypar_hypergraph_t* hypergraph =
+      mt_kahypar_read_hypergraph_from_file("test_instances/ibm01.hgr", context, HMETIS);
+
+    mt_kahypar_partitioning_job_t* job =
+      mt_kahypar_partition_hypergraph_async(hypergraph, context, 0.0);
+    mt_kahypar_partitioned_hypergraph_t* partitioned_hg =
+      mt_kahypar_wait_hypergraph_partitioning_job(job);
+    ASSERT_TRUE(mt_kahypar_poll_partitioning_job(job));
+    ASSERT_NE(nullptr, partitioned_hg);
+    ASSERT_LE(mt_kahypar_hypergraph_imbalance(partitioned_hg, context), 0.03);
+
+    mt_kahypar_free_partitioning_job(job);
+    mt_kahypar_free_partitioned_hypergraph(partitioned_hg);
+    mt_kahypar_free_hypergraph(hypergraph);
+    mt_kahypar_free_context(context);
+  }
+
+  TEST(MtKaHyPar, ReturnsCachedPartitionForTheSameInputAndParameters) {
+    const std::string cache_directory = "result_cache";
+    std::filesystem::remove_all(cache_directory);
+    std::filesystem::create_directories(cache_directory);
+    auto num_cached_partitions = [&] {
+      return std::distance(std::filesystem::directory_iterator(cache_directory),
+                           std::filesystem::directory_iterator());
+    };
+
+    mt_kahypar_context_t* context = mt_kahypar_context_new();
+    mt_kahypar_load_preset(context, SPEED);
+    mt_kahypar_set_partitioning_parameters(context, 4, 0.03, KM1, 0);
+    mt_kahypar_set_context_parameter(context, VERBOSE, "0");
+    mt_kahypar_set_context_parameter(context, RESULT_CACHE_SIZE, "2");
+    mt_kahypar_set_context_parameter(context, RESULT_CACHE_DIRECTORY, cache_directory.c_str());
+    mt_kahypar_hypergraph_t* hypergraph =
+      mt_kahypar_read_hypergraph_from_file("test_instances/ibm01.hgr", context, HMETIS);
+    const mt_kahypar_hypernode_id_t num_nodes = mt_kahypar_num_hypernodes(hypergraph);
+
+    mt_kahypar_partitioned_hypergraph_t* first = mt_kahypar_partition_hypergraph(hypergraph, context);
+    ASSERT_EQ(1, num_cached_partitions());
+    mt_kahypar_partitioned_hypergraph_t* second = mt_kahypar_partition_hypergraph(hypergraph, context);
+    ASSERT_EQ(1, num_cached_partitions());
+    const mt_kahypar_partition_id_t* first_partition = mt_kahypar_get_hypergraph_partition_view(first);
+    const mt_kahypar_partition_id_t* second_partition = mt_kahypar_get_hypergraph_partition_view(second);
+    for ( mt_kahypar_hypernode_id_t hn = 0; hn < num_nodes; ++hn ) {
+      ASSERT_EQ(first_partition[hn], second_partition[hn]);
+    }
+
+    // A different number of blocks results in a different key
+    mt_kahypar_set_context_parameter(context, NUM_BLOCKS, "8");
+    mt_kahypar_partitioned_hypergraph_t* third = mt_kahypar_partition_hypergraph(hypergraph, context);
+    ASSERT_EQ(2, num_cached_partitions());
+    ASSERT_LE(mt_kahypar_hypergraph_imbalance(third, context), 0.03);
+
+    mt_kahypar_free_partitioned_hypergraph(first);
+    mt_kahypar_free_partitioned_hypergraph(second);
+    mt_kahypar_free_partitioned_hypergraph(third);
+    mt_kahypar_free_hypergraph(hypergraph);
+    mt_kahypar_free_context(context);
+    std::filesystem::remove_all(cache_directory);
+  }
+
+  TEST(MtKaHyPar, ExportsAJSONReportOfThePartitioningRun) {
+    mt_kahypar_context_t* context = mt_kahypar_context_new();
+    mt_kahypar_load_preset(context, SPEED);
+    mt_kahypar_set_partitioning_parameters(context, 4, 0.03, KM1, 0);
+    mt_kahypar_set_context_parameter(context, VERBOSE, "0");
+    mt_kahypar_hypergraph_t* hypergraph =
+      mt_kahypar_read_hypergraph_from_file("test_instances/ibm01.hgr", context, HMETIS);
+    mt_kahypar_partitioned_hypergraph_t* partitioned_hg = mt_kahypar_partition_hypergraph(hypergraph, context);
+
+    const size_t length = mt_kahypar_get_hypergraph_report(partitioned_hg, context, nullptr, 0);
+    ASSERT_GT(length, 0);
+    std::vector<char> buffer(length + 1);
+    ASSERT_EQ(length, mt_kahypar_get_hypergraph_report(partitioned_hg, context, buffer.data(), buffer.size()));
+    const std::string report(buffer.data());
+    ASSERT_EQ(length, report.size());
+    ASSERT_EQ('{', report.front());
+    ASSERT_EQ('}', report.back());
+    ASSERT_NE(std::string::npos, report.find("\"km1\":" + std::to_string(mt_kahypar_km1(partitioned_hg))));
+    ASSERT_NE(std::string::npos, report.find("\"timings\":[{"));
+    ASSERT_NE(std::string::npos, report.find("\"levels\":[{"));
+    ASSERT_NE(std::string::npos, report.find("\"objective_before\":"));
+    ASSERT_NE(std::string::npos, report.find("\"memory\":{"));
+
+    // A too small buffer receives a truncated, null-terminated report
+    std::vector<char> small_buffer(10);
+    ASSERT_EQ(length, mt_kahypar_get_hypergraph_report(partitioned_hg, context, small_buffer.data(), small_buffer.size()));
+    ASSERT_EQ(9, std::string(small_buffer.data()).size());
+
+    mt_kahypar_free_partitioned_hypergraph(partitioned_hg);
+    mt_kahypar_free_hypergraph(hypergraph);
+    mt_kahypar_free_context(context);
+  }
+
+  TEST(MtKaHyPar, ReturnsTheCutWeightsBetweenAllPairsOfBlocks) {
+    mt_kahypar_context_t* context = mt_kahypar_context_new();
+    mt_kahypar_load_preset(context, SPEED);
+    mt_kahypar_set_partitioning_parameters(context, 8, 0.03, CUT, 0);
+    mt_kahypar_set_context_parameter(context, VERBOSE, "0");
+    mt_kahypar_graph_t* graph =
+      mt_kahypar_read_graph_from_file("test_instances/delaunay_n15.graph", context, METIS);
+    mt_kahypar_partitioned_graph_t* partitioned_graph = mt_kahypar_partition_graph(graph, context);
+
+    const size_t num_pairs = mt_kahypar_get_graph_block_pair_cuts(
+      partitioned_graph, nullptr, nullptr, nullptr, 0);
+    ASSERT_GT(num_pairs, 0);
+    ASSERT_LE(num_pairs, 8 * 7 / 2);
+    std::vector<mt_kahypar_partition_id_t> block_0(num_pairs);
+    std::vector<mt_kahypar_partition_id_t> block_1(num_pairs);
+    std::vector<mt_kahypar_hyperedge_weight_t> weights(num_pairs);
+    ASSERT_EQ(num_pairs, mt_kahypar_get_graph_block_pair_cuts(
+      partitioned_graph, block_0.data(), block_1.data(), weights.data(), num_pairs));
+
+    // Each cut edge connects exactly one pair of blocks
+    mt_kahypar_hyperedge_weight_t cut = 0;
+    for ( size_t i = 0; i < num_pairs; ++i ) {
+      ASSERT_LT(block_0[i], block_1[i]);
+      ASSERT_GT(weights[i], 0);
+      if ( i > 0 ) {
+        ASSERT_TRUE(block_0[i - 1] < block_0[i] ||
+          ( block_0[i - 1] == block_0[i] && block_1[i - 1] < block_1[i] ));
+      }
+      cut += weights[i];
+    }
+    ASSERT_EQ(mt_kahypar_graph_cut(partitioned_graph), cut);
+
+    mt_kahypar_free_partitioned_graph(partitioned_graph);
+    mt_kahypar_free_graph(graph);
+    mt_kahypar_free_context(context);
+  }
+
+  TEST(MtKaHyPar, PublishesImprovedPartitionsInAnytimeMode) {
+    mt_kahypar_context_t* context = mt_kahypar_context_new();
+    mt_kahypar_load_preset(context, SPEED);
+    mt_kahypar_set_partitioning_parameters(context, 4, 0.03, KM1, 0);
+    mt_kahypar_set_context_parameter(context, VERBOSE, "0");
+    mt_kahypar_set_context_parameter(context, ANYTIME, "1");
+    mt_kahypar_set_context_parameter(context, NUM_VCYCLES, "2");
+    mt_kahypar_hypergraph_t* hypergraph =
+      mt_kahypar_read_hypergraph_from_file("test_instances/ibm01.hgr", context, HMETIS);
+    const mt_kahypar_hypernode_id_t num_nodes = mt_kahypar_num_hypernodes(hypergraph);
+
+    mt_kahypar_partitioning_job_t* job =
+      mt_kahypar_partition_hypergraph_async(hypergraph, context, 0.0);
+    mt_kahypar_partitioned_hypergraph_t* partitioned_hg =
+      mt_kahypar_wait_hypergraph_partitioning_job(job);
+
+    std::unique_ptr<mt_kahypar_partition_id_t[]> snapshot =
+      std::make_unique<mt_kahypar_partition_id_t[]>(num_nodes);
+    ASSERT_GE(mt_kahypar_get_partitioning_job_snapshot(job, snapshot.get()), 1);
+    for ( mt_kahypar_hypernode_id_t hn = 0; hn < num_nodes; ++hn ) {
+      ASSERT_GE(snapshot[hn], 0);
+      ASSERT_LT(snapshot[hn], 4);
+    }
+    ASSERT_LE(mt_kahypar_hypergraph_imbalance(partitioned_hg, context), 0.03);
+
+    mt_kahypar_free_partitioning_job(job);
+    mt_kahypar_free_partitioned_hypergraph(partitioned_hg);
+    mt_kahypar_free_hypergraph(hypergraph);
+    mt_kahypar_free_context(context);
+  }
+
+  TEST(MtKaHyPar, CancelsAnAsynchronousPartitioningJob) {
+    mt_kahypar_context_t* context = mt_kahypar_context_new();
+    mt_kahypar_load_preset(context, SPEED);
+    mt_kahypar_set_partitioning_parameters(context, 8, 0.03, KM1, 0);
+    mt_kahypar_set_context_parameter(context, VERBOSE, "0");
+    mt_kahypar_graph_t* graph =
+      mt_kahypar_read_graph_from_file("test_instances/delaunay_n15.graph", context, METIS);
+
+    mt_kahypar_partitioning_job_t* job =
+      mt_kahypar_partition_graph_async(graph, context, 0.0);
+    mt_kahypar_cancel_partitioning_job(job);
+    mt_kahypar_partitioned_graph_t* partitioned_graph =
+      mt_kahypar_wait_graph_partitioning_job(job);
+
+    // A cancelled job still computes a complete partition
+    ASSERT_NE(nullptr, partitioned_graph);
+    const mt_kahypar_partition_id_t* partition =
+      mt_kahypar_get_graph_partition_view(partitioned_graph);
+    for ( mt_kahypar_hypernode_id_t hn = 0; hn < mt_kahypar_num_nodes(graph); ++hn ) {
+      ASSERT_GE(partition[hn], 0);
+      ASSERT_LT(partition[hn], 8);
+    }
+
+    mt_kahypar_free_partitioning_job(job);
+    mt_kahypar_free_partitioned_graph(partitioned_graph);
+    mt_kahypar_free_graph(graph);
+    mt_kahypar_free_context(context);
+  }
+
+  TEST(MtKaHyPar, ReportsProgressToTheProgressCallback) {
+    mt_kahypar_context_t* context = mt_kahypar_context_new();
+    mt_kahypar_load_preset(context, SPEED);
+    mt_kahypar_set_partitioning_parameters(context, 4, 0.03, KM1, 0);
+    mt_kahypar_set_context_parameter(context, VERBOSE, "0");
+    std::vector<mt_kahypar_progress_t> updates;
+    mt_kahypar_set_progress_callback(context,
+      [](const mt_kahypar_progress_t* progress, void* user_data) {
+        reinterpret_cast<std::vector<mt_kahypar_progress_t>*>(user_data)->push_back(*progress);
+        return true;
+      }, &updates);
+    mt_kahypar_hypergraph_t* hypergraph =
+      mt_kahypar_read_hypergraph_from_file("test_instances/ibm01.hgr", context, HMETIS);
+
+    mt_kahypar_partitioned_hypergraph_t* partitioned_hg =
+      mt_kahypar_partition_hypergraph(hypergraph, context);
+
+    ASSERT_GE(updates.size(), 4);
+    ASSERT_EQ(PHASE_COARSENING, updates.front().phase);
+    ASSERT_EQ(PHASE_INITIAL_PARTITIONING, updates[1].phase);
+    ASSERT_EQ(PHASE_FINISHED, updates.back().phase);
+    ASSERT_EQ(mt_kahypar_km1(partitioned_hg), updates.back().objective);
+    size_t last_level = std::numeric_limits<size_t>::max();
+    for ( size_t i = 2; i + 1 < updates.size(); ++i ) {
+      ASSERT_EQ(PHASE_REFINEMENT, updates[i].phase);
+      ASSERT_LT(updates[i].level, last_level);
+      ASSERT_GE(updates[i].objective, 0);
+      ASSERT_GE(updates[i].elapsed_seconds, updates[i - 1].elapsed_seconds);
+      last_level = updates[i].level;
+    }
+    ASSERT_EQ(0, last_level);
+
+    mt_kahypar_free_partitioned_hypergraph(partitioned_hg);
+    mt_kahypar_free_hypergraph(hypergraph);
+    mt_kahypar_free_context(context);
+  }
+
+  TEST(MtKaHyPar, CallsTheRefinementCallbackOnEachLevel) {
+    mt_kahypar_context_t* context = mt_kahypar_context_new();
+    mt_kahypar_load_preset(context, SPEED);
+    mt_kahypar_set_partitioning_parameters(context, 4, 0.03, KM1, 0);
+    mt_kahypar_set_context_parameter(context, VERBOSE, "0");
+    std::vector<size_t> levels;
+    mt_kahypar_set_refinement_callback(context,
+      [](const mt_kahypar_refinement_level_t* level,
+         mt_kahypar_hypernode_id_t* nodes,
+         mt_kahypar_partition_id_t* blocks,
+         void* user_data) {
+        reinterpret_cast<std::vector<size_t>*>(user_data)->push_back(level->level);
+        // Verify the exported incidence structure and pin counts
+        for ( mt_kahypar_hyperedge_id_t he = 0; he < level->num_edges; ++he ) {
+          std::vector<mt_kahypar_hypernode_id_t> pin_count_in_part(level->num_blocks, 0);
+          for ( size_t i = level->hyperedge_indices[he]; i < level->hyperedge_indices[he + 1]; ++i ) {
+            ++pin_count_in_part[level->partition[level->pins[i]]];
+          }
+          for ( mt_kahypar_partition_id_t block = 0; block < level->num_blocks; ++block ) {
+            EXPECT_EQ(pin_count_in_part[block], mt_kahypar_refinement_level_pin_count_in_part(level, he, block));
+          }
+        }
+        // Request to move all nodes to block 0 (only moves that preserve the balance are applied)
+        size_t num_moves = 0;
+        for ( mt_kahypar_hypernode_id_t hn = 0; hn < level->num_nodes; ++hn ) {
+          if ( level->incident_net_indices[hn] < level->incident_net_indices[hn + 1] &&
+               level->partition[hn] != 0 ) {
+            nodes[num_moves] = hn;
+            blocks[num_moves++] = 0;
+          }
+        }
+        return num_moves;
+      }, &levels);
+    mt_kahypar_hypergraph_t* hypergraph =
+      mt_kahypar_read_hypergraph_from_file("test_instances/ibm01.hgr", context, HMETIS);
+
+    mt_kahypar_partitioned_hypergraph_t* partitioned_hg =
+      mt_kahypar_partition_hypergraph(hypergraph, context);
+
+    ASSERT_FALSE(levels.empty());
+    ASSERT_EQ(0, levels.back());
+    ASSERT_LE(mt_kahypar_hypergraph_imbalance(partitioned_hg, context), 0.03);
+
+    mt_kahypar_free_partitioned_hypergraph(partitioned_hg);
+    mt_kahypar_free_hypergraph(hypergraph);
+    mt_kahypar_free_context(context);
+  }
+
+  TEST(MtKaHyPar, StopsPartitioningIfTheProgressCallbackReturnsFalse) {
+    mt_kahypar_context_t* context = mt_kahypar_context_new();
+    mt_kahypar_load_preset(context, SPEED);
+    mt_kahypar_set_partitioning_parameters(context, 8, 0.03, KM1, 0);
+    mt_kahypar_set_context_parameter(context, VERBOSE, "0");
+    mt_kahypar_set_context_parameter(context, NUM_VCYCLES, "3");
+    size_t num_vcycles = 0;
+    mt_kahypar_set_progress_callback(context,
+      [](const mt_kahypar_progress_t* progress, void* user_data) {
+        size_t& vcycles = *reinterpret_cast<size_t*>(user_data);
+        vcycles += progress->phase == PHASE_VCYCLE;
+        // Stop after the first level of the uncoarsening phase
+        return progress->phase != PHASE_REFINEMENT;
+      }, &num_vcycles);
+    mt_kahypar_graph_t* graph =
+      mt_kahypar_read_graph_from_file("test_instances/delaunay_n15.graph", context, METIS);
+
+    mt_kahypar_partitioned_graph_t* partitioned_graph =
+      mt_kahypar_partition_graph(graph, context);
+
+    // No V-cycles are started after the run was stopped
+    ASSERT_EQ(0, num_vcycles);
+    const mt_kahypar_partition_id_t* partition =
+      mt_kahypar_get_graph_partition_view(partitioned_graph);
+    for ( mt_kahypar_hypernode_id_t hn = 0; hn < mt_kahypar_num_nodes(graph); ++hn ) {
+      ASSERT_GE(partition[hn], 0);
+      ASSERT_LT(partition[hn], 8);
+    }
+
+    mt_kahypar_free_partitioned_graph(partitioned_graph);
+    mt_kahypar_free_graph(graph);
+    mt_kahypar_free_context(context);
+  }
+
   namespace {
     mt_kahypar_partitioned_hypergraph_t* partition(const char* filename,
                                                    const mt_kahypar_file_format_type_t file_format,
@@ -537,6 +1023,123 @@ namespace mt_kahypar {
       ASSERT_LE(after, before);
     }
 
+    void RepartitionHypergraph(const mt_kahypar_partition_id_t num_blocks,
+                               const size_t num_vcycles,
+                               const mt_kahypar_hypernode_id_t new_vertex_interval) {
+      // Every new_vertex_interval-th vertex is marked as inserted since the previous partition
+      const mt_kahypar_hypernode_id_t num_nodes = mt_kahypar_num_hypernodes(hypergraph);
+      std::unique_ptr<mt_kahypar_partition_id_t[]> previous_partition =
+        std::make_unique<mt_kahypar_partition_id_t[]>(num_nodes);
+      mt_kahypar_get_hypergraph_partition(partitioned_hg, previous_partition.get());
+      for ( mt_kahypar_hypernode_id_t hn = 0; hn < num_nodes; hn += new_vertex_interval ) {
+        previous_partition[hn] = MT_KAHYPAR_NEW_VERTEX;
+      }
+
+      mt_kahypar_partitioned_hypergraph_t* repartitioned_hg =
+        mt_kahypar_repartition_hypergraph(hypergraph, context, previous_partition.get(), num_vcycles);
+      ASSERT_LE(mt_kahypar_hypergraph_imbalance(repartitioned_hg, context), 0.03);
+
+      std::unique_ptr<mt_kahypar_partition_id_t[]> partition =
+        std::make_unique<mt_kahypar_partition_id_t[]>(num_nodes);
+      mt_kahypar_get_hypergraph_partition(repartitioned_hg, partition.get());
+      for ( mt_kahypar_hypernode_id_t hn = 0; hn < num_nodes; ++hn ) {
+        ASSERT_GE(partition[hn], 0);
+        ASSERT_LT(partition[hn], num_blocks);
+        if ( num_vcycles == 0 && previous_partition[hn] != MT_KAHYPAR_NEW_VERTEX ) {
+          ASSERT_EQ(previous_partition[hn], partition[hn]);
+        }
+      }
+      mt_kahypar_free_partitioned_hypergraph(repartitioned_hg);
+    }
+
+    void RepartitionGraph(const mt_kahypar_partition_id_t num_blocks,
+                          const size_t num_vcycles,
+                          const mt_kahypar_hypernode_id_t new_vertex_interval) {
+      // Every new_vertex_interval-th vertex is marked as inserted since the previous partition
+      const mt_kahypar_hypernode_id_t num_nodes = mt_kahypar_num_nodes(graph);
+      std::unique_ptr<mt_kahypar_partition_id_t[]> previous_partition =
+        std::make_unique<mt_kahypar_partition_id_t[]>(num_nodes);
+      mt_kahypar_get_graph_partition(partitioned_graph, previous_partition.get());
+      for ( mt_kahypar_hypernode_id_t hn = 0; hn < num_nodes; hn += new_vertex_interval ) {
+        previous_partition[hn] = MT_KAHYPAR_NEW_VERTEX;
+      }
+
+      mt_kahypar_partitioned_graph_t* repartitioned_graph =
+        mt_kahypar_repartition_graph(graph, context, previous_partition.get(), num_vcycles);
+      ASSERT_LE(mt_kahypar_graph_imbalance(repartitioned_graph, context), 0.03);
+
+      std::unique_ptr<mt_kahypar_partition_id_t[]> partition =
+        std::make_unique<mt_kahypar_partition_id_t[]>(num_nodes);
+      mt_kahypar_get_graph_partition(repartitioned_graph, partition.get());
+      for ( mt_kahypar_hypernode_id_t hn = 0; hn < num_nodes; ++hn ) {
+        ASSERT_GE(partition[hn], 0);
+        ASSERT_LT(partition[hn], num_blocks);
+        if ( num_vcycles == 0 && previous_partition[hn] != MT_KAHYPAR_NEW_VERTEX ) {
+          ASSERT_EQ(previous_partition[hn], partition[hn]);
+        }
+      }
+      mt_kahypar_free_partitioned_graph(repartitioned_graph);
+    }
+
+    template<typename Handle, typename CreatePartitionFunc, typename BlockWeightsFunc, typename FreeFunc>
+    void VerifyPartitionsForTargets(Handle* handle,
+                                    const mt_kahypar_hypernode_id_t num_nodes,
+                                    const std::vector<mt_kahypar_partition_id_t>& num_blocks,
+                                    const std::vector<double>& epsilons,
+                                    const std::vector<mt_kahypar_partition_id_t>& partitions,
+                                    const CreatePartitionFunc& create_partition,
+                                    const BlockWeightsFunc& block_weights_of,
+                                    const FreeFunc& free_partition) {
+      for ( size_t i = 0; i < num_blocks.size(); ++i ) {
+        const mt_kahypar_partition_id_t* partition = partitions.data() + i * num_nodes;
+        for ( mt_kahypar_hypernode_id_t hn = 0; hn < num_nodes; ++hn ) {
+          ASSERT_GE(partition[hn], 0);
+          ASSERT_LT(partition[hn], num_blocks[i]);
+        }
+
+        // Verify balance constraint
+        auto* partitioned_handle = create_partition(handle, num_blocks[i], partition);
+        std::vector<mt_kahypar_hypernode_weight_t> block_weights(num_blocks[i]);
+        block_weights_of(partitioned_handle, block_weights.data());
+        const mt_kahypar_hypernode_weight_t total_weight =
+          std::accumulate(block_weights.begin(), block_weights.end(), 0);
+        const mt_kahypar_hypernode_weight_t max_block_weight = std::floor((1.0 + epsilons[i]) *
+          std::ceil(static_cast<double>(total_weight) / num_blocks[i]));
+        for ( const mt_kahypar_hypernode_weight_t weight : block_weights ) {
+          ASSERT_LE(weight, max_block_weight);
+        }
+        free_partition(partitioned_handle);
+      }
+    }
+
+    void PartitionHypergraphForTargets(const std::vector<mt_kahypar_partition_id_t>& num_blocks,
+                                       const std::vector<double>& epsilons) {
+      SetUpContext(SPEED, 2, 0.03, KM1, false);
+      LoadHypergraph();
+
+      const mt_kahypar_hypernode_id_t num_nodes = mt_kahypar_num_hypernodes(hypergraph);
+      std::vector<mt_kahypar_partition_id_t> partitions(num_blocks.size() * num_nodes, -1);
+      mt_kahypar_partition_hypergraph_for_targets(hypergraph, context,
+        num_blocks.size(), num_blocks.data(), epsilons.data(), partitions.data());
+      VerifyPartitionsForTargets(hypergraph, num_nodes, num_blocks, epsilons, partitions,
+        mt_kahypar_create_partitioned_hypergraph, mt_kahypar_get_hypergraph_block_weights,
+        mt_kahypar_free_partitioned_hypergraph);
+    }
+
+    void PartitionGraphForTargets(const std::vector<mt_kahypar_partition_id_t>& num_blocks,
+                                  const std::vector<double>& epsilons) {
+      SetUpContext(SPEED, 2, 0.03, CUT, false);
+      LoadGraph();
+
+      const mt_kahypar_hypernode_id_t num_nodes = mt_kahypar_num_nodes(graph);
+      std::vector<mt_kahypar_partition_id_t> partitions(num_blocks.size() * num_nodes, -1);
+      mt_kahypar_partition_graph_for_targets(graph, context,
+        num_blocks.size(), num_blocks.data(), epsilons.data(), partitions.data());
+      VerifyPartitionsForTargets(graph, num_nodes, num_blocks, epsilons, partitions,
+        mt_kahypar_create_partitioned_graph, mt_kahypar_get_graph_block_weights,
+        mt_kahypar_free_partitioned_graph);
+    }
+
     void SetUp()  {
       mt_kahypar_initialize_thread_pool(std::thread::hardware_concurrency(), false);
       context = mt_kahypar_context_new();
@@ -612,6 +1215,22 @@ namespace mt_kahypar {
     PartitionGraph(HIGH_QUALITY, 4, 0.03, CUT, false);
   }
 
+  TEST_F(APartitioner, PartitionsAHypergraphInTwoBlocksWithQualityPreset) {
+    PartitionHypergraph(QUALITY, 2, 0.03, KM1, false);
+  }
+
+  TEST_F(APartitioner, PartitionsAGraphInTwoBlocksWithQualityPreset) {
+    PartitionGraph(QUALITY, 2, 0.03, CUT, false);
+  }
+
+  TEST_F(APartitioner, PartitionsAHypergraphInFourBlocksWithHighestQualityPreset) {
+    PartitionHypergraph(HIGHEST_QUALITY, 4, 0.03, KM1, false);
+  }
+
+  TEST_F(APartitioner, PartitionsAGraphInFourBlocksWithHighestQualityPreset) {
+    PartitionGraph(HIGHEST_QUALITY, 4, 0.03, CUT, false);
+  }
+
   TEST_F(APartitioner, PartitionsAHypergraphInTwoBlocksWithDeterministicPreset) {
     PartitionHypergraph(DETERMINISTIC, 2, 0.03, KM1, false);
   }
@@ -688,6 +1307,34 @@ namespace mt_kahypar {
     ImproveGraphPartition(SPEED, 3, false);
   }
 
+  TEST_F(APartitioner, RepartitionsHypergraphWithInsertedVertices) {
+    PartitionHypergraph(SPEED, 4, 0.03, KM1, false);
+    RepartitionHypergraph(4, 0, 20);
+  }
+
+  TEST_F(APartitioner, RepartitionsGraphWithInsertedVertices) {
+    PartitionGraph(SPEED, 4, 0.03, CUT, false);
+    RepartitionGraph(4, 0, 20);
+  }
+
+  TEST_F(APartitioner, RepartitionsHypergraphWithInsertedVerticesAndOneVCycle) {
+    PartitionHypergraph(SPEED, 4, 0.03, KM1, false);
+    RepartitionHypergraph(4, 1, 20);
+  }
+
+  TEST_F(APartitioner, RepartitionsGraphWithInsertedVerticesAndOneVCycle) {
+    PartitionGraph(SPEED, 4, 0.03, CUT, false);
+    RepartitionGraph(4, 1, 20);
+  }
+
+  TEST_F(APartitioner, PartitionsHypergraphForSeveralTargetsWithTheSameHierarchy) {
+    PartitionHypergraphForTargets({ 2, 4, 8, 4 }, { 0.03, 0.03, 0.03, 0.1 });
+  }
+
+  TEST_F(APartitioner, PartitionsGraphForSeveralTargetsWithTheSameHierarchy) {
+    PartitionGraphForTargets({ 2, 4, 8, 4 }, { 0.03, 0.03, 0.03, 0.1 });
+  }
+
   TEST_F(APartitioner, PartitionsHypergraphWithIndividualBlockWeights) {
     // Setup Individual Block Weights
     std::unique_ptr<mt_kahypar_hypernode_weight_t[]> block_weights =
@@ -774,6 +1421,8 @@ namespace mt_kahypar {
     ASSERT_EQ(0, mt_kahypar_set_context_parameter(context, SEED, "42"));
     ASSERT_EQ(0, mt_kahypar_set_context_parameter(context, NUM_VCYCLES, "3"));
     ASSERT_EQ(0, mt_kahypar_set_context_parameter(context, VERBOSE, "1"));
+    ASSERT_EQ(0, mt_kahypar_set_context_parameter(context, RESULT_CACHE_SIZE, "8"));
+    ASSERT_EQ(0, mt_kahypar_set_context_parameter(context, RESULT_CACHE_DIRECTORY, "cache"));
 
 
     Context& c = *reinterpret_cast<Context*>(context);
@@ -783,6 +1432,8 @@ namespace mt_kahypar {
     ASSERT_EQ(42, c.partition.seed);
     ASSERT_EQ(3, c.partition.num_vcycles);
     ASSERT_TRUE(c.partition.verbose_output);
+    ASSERT_EQ(8, c.partition.result_cache_size);
+    ASSERT_EQ("cache", c.partition.result_cache_directory);
 
     mt_kahypar_free_context(context);
   }
@@ -805,6 +1456,10 @@ namespace mt_kahypar {
       ASSERT_EQ(lhs.partition.large_hyperedge_size_threshold, rhs.partition.large_hyperedge_size_threshold);
       ASSERT_EQ(lhs.partition.smallest_large_he_size_threshold, rhs.partition.smallest_large_he_size_threshold);
       ASSERT_EQ(lhs.partition.ignore_hyperedge_size_threshold, rhs.partition.ignore_hyperedge_size_threshold);
+      ASSERT_EQ(lhs.partition.large_hyperedge_pin_sample_size, rhs.partition.large_hyperedge_pin_sample_size);
+      ASSERT_EQ(lhs.partition.streaming_buffer_size, rhs.partition.streaming_buffer_size);
+      ASSERT_EQ(lhs.partition.streaming_refinement_rounds, rhs.partition.streaming_refinement_rounds);
+      ASSERT_EQ(lhs.partition.multisection_k1, rhs.partition.multisection_k1);
       ASSERT_EQ(lhs.partition.verbose_output, rhs.partition.verbose_output);
       ASSERT_EQ(lhs.partition.show_detailed_timings, rhs.partition.show_detailed_timings);
       ASSERT_EQ(lhs.partition.show_detailed_clustering_timings, rhs.partition.show_detailed_clustering_timings);
@@ -816,6 +1471,7 @@ namespace mt_kahypar {
       ASSERT_EQ(lhs.partition.sp_process_output, rhs.partition.sp_process_output);
       ASSERT_EQ(lhs.partition.csv_output, rhs.partition.csv_output);
       ASSERT_EQ(lhs.partition.write_partition_file, rhs.partition.write_partition_file);
+      ASSERT_EQ(lhs.partition.binary_partition_file, rhs.partition.binary_partition_file);
       ASSERT_EQ(lhs.partition.deterministic, rhs.partition.deterministic);
 
       // shared memory
@@ -832,6 +1488,10 @@ namespace mt_kahypar {
                 rhs.preprocessing.use_community_detection);
       ASSERT_EQ(lhs.preprocessing.disable_community_detection_for_mesh_graphs,
                 rhs.preprocessing.disable_community_detection_for_mesh_graphs);
+      ASSERT_EQ(lhs.preprocessing.remove_twin_vertices,
+                rhs.preprocessing.remove_twin_vertices);
+      ASSERT_EQ(lhs.preprocessing.reorder_for_locality,
+                rhs.preprocessing.reorder_for_locality);
 
       // community detection
       ASSERT_EQ(lhs.preprocessing.community_detection.edge_weight_function,
@@ -840,6 +1500,8 @@ namespace mt_kahypar {
                 rhs.preprocessing.community_detection.max_pass_iterations);
       ASSERT_EQ(lhs.preprocessing.community_detection.low_memory_contraction,
                 rhs.preprocessing.community_detection.low_memory_contraction);
+      ASSERT_EQ(lhs.preprocessing.community_detection.implicit_star_expansion,
+                rhs.preprocessing.community_detection.implicit_star_expansion);
       ASSERT_DOUBLE_EQ(lhs.preprocessing.community_detection.min_vertex_move_fraction,
                        rhs.preprocessing.community_detection.min_vertex_move_fraction);
       ASSERT_EQ(lhs.preprocessing.community_detection.vertex_degree_sampling_threshold,
@@ -856,6 +1518,15 @@ namespace mt_kahypar {
       ASSERT_EQ(lhs.coarsening.maximum_shrink_factor, rhs.coarsening.maximum_shrink_factor);
       ASSERT_EQ(lhs.coarsening.vertex_degree_sampling_threshold, rhs.coarsening.vertex_degree_sampling_threshold);
       ASSERT_EQ(lhs.coarsening.num_sub_rounds_deterministic, rhs.coarsening.num_sub_rounds_deterministic);
+      ASSERT_EQ(lhs.coarsening.deterministic_conflict_resolution, rhs.coarsening.deterministic_conflict_resolution);
+      ASSERT_EQ(lhs.coarsening.nlevel_contraction_batch_size, rhs.coarsening.nlevel_contraction_batch_size);
+      ASSERT_EQ(lhs.coarsening.order_clusters_by_community, rhs.coarsening.order_clusters_by_community);
+      ASSERT_EQ(lhs.coarsening.use_min_hash_sparsifier, rhs.coarsening.use_min_hash_sparsifier);
+      ASSERT_EQ(lhs.coarsening.reuse_hierarchy_in_rb, rhs.coarsening.reuse_hierarchy_in_rb);
+      ASSERT_EQ(lhs.coarsening.min_hash_num_hash_functions, rhs.coarsening.min_hash_num_hash_functions);
+      ASSERT_EQ(lhs.coarsening.min_hash_similarity_threshold, rhs.coarsening.min_hash_similarity_threshold);
+      ASSERT_EQ(lhs.coarsening.similar_net_combiner_strategy, rhs.coarsening.similar_net_combiner_strategy);
+      ASSERT_EQ(lhs.coarsening.level_arena_factor, rhs.coarsening.level_arena_factor);
       ASSERT_EQ(lhs.coarsening.max_allowed_node_weight, rhs.coarsening.max_allowed_node_weight);
       ASSERT_EQ(lhs.coarsening.contraction_limit, rhs.coarsening.contraction_limit);
 
@@ -953,6 +1624,10 @@ namespace mt_kahypar {
                 rhs.initial_partitioning.refinement.flows.skip_unpromising_blocks);
       ASSERT_EQ(lhs.initial_partitioning.refinement.flows.pierce_in_bulk,
                 rhs.initial_partitioning.refinement.flows.pierce_in_bulk);
+      ASSERT_EQ(lhs.initial_partitioning.refinement.flows.unproductive_block_pair_cut_change,
+                rhs.initial_partitioning.refinement.flows.unproductive_block_pair_cut_change);
+      ASSERT_EQ(lhs.initial_partitioning.refinement.flows.parallel_apply_moves,
+                rhs.initial_partitioning.refinement.flows.parallel_apply_moves);
 
       // initial partitioning -> refinement -> deterministic
       ASSERT_EQ(lhs.initial_partitioning.refinement.deterministic_refinement.num_sub_rounds_sync_lp,
@@ -982,6 +1657,16 @@ namespace mt_kahypar {
                 rhs.refinement.max_batch_size);
       ASSERT_EQ(lhs.refinement.min_border_vertices_per_thread,
                 rhs.refinement.min_border_vertices_per_thread);
+      ASSERT_EQ(lhs.refinement.track_objective,
+                rhs.refinement.track_objective);
+      ASSERT_EQ(lhs.refinement.track_cut_nets,
+                rhs.refinement.track_cut_nets);
+      ASSERT_EQ(lhs.refinement.defer_high_degree_moves,
+                rhs.refinement.defer_high_degree_moves);
+      ASSERT_EQ(lhs.refinement.low_value_level_border_fraction,
+                rhs.refinement.low_value_level_border_fraction);
+      ASSERT_EQ(lhs.refinement.max_uncoarsening_time,
+                rhs.refinement.max_uncoarsening_time);
 
 
       // refinement -> label propagation
@@ -1050,6 +1735,10 @@ namespace mt_kahypar {
                 rhs.refinement.flows.skip_unpromising_blocks);
       ASSERT_EQ(lhs.refinement.flows.pierce_in_bulk,
                 rhs.refinement.flows.pierce_in_bulk);
+      ASSERT_EQ(lhs.refinement.flows.unproductive_block_pair_cut_change,
+                rhs.refinement.flows.unproductive_block_pair_cut_change);
+      ASSERT_EQ(lhs.refinement.flows.parallel_apply_moves,
+                rhs.refinement.flows.parallel_apply_moves);
 
       // refinement -> deterministic
       ASSERT_EQ(lhs.refinement.deterministic_refinement.num_sub_rounds_sync_lp,
@@ -26,9 +26,18 @@
 
 #include "gmock/gmock.h"
 
+#include <fstream>
+#include <sstream>
+
+#ifdef KAHYPAR_ENABLE_COMPRESSED_INPUT
+#include <zlib.h>
+#endif
+
 #include "tests/datastructures/hypergraph_fixtures.h"
 #include "mt-kahypar/definitions.h"
 #include "mt-kahypar/io/hypergraph_io.h"
+#include "mt-kahypar/io/partition_checkpoint.h"
+#include "mt-kahypar/utils/randomize.h"
 
 using ::testing::Test;
 
@@ -423,6 +432,40 @@ TEST_F(AHypergraphReader, ReadsAMetisGraphNoNewline) {
   );
 }
 
+TEST_F(AHypergraphReader, ReadsALargeMetisGraphSplitIntoSeveralChunks) {
+  // A weighted cycle with comment lines, which is large enough to be read in several chunks
+  const HypernodeID num_nodes = 100000;
+  const std::string filename = "large_cycle_graph_test.graph";
+  std::ofstream out_stream(filename.c_str());
+  out_stream << "% cycle graph\n" << num_nodes << " " << num_nodes << " 11\n";
+  for ( HypernodeID u = 0; u < num_nodes; ++u ) {
+    if ( u % 1000 == 0 ) {
+      out_stream << "% vertex " << (u + 1) << "\n";
+    }
+    const HypernodeID prev = (u + num_nodes - 1) % num_nodes;
+    const HypernodeID next = (u + 1) % num_nodes;
+    out_stream << (u % 7 + 1) << " " << (next + 1) << " " << (std::max(u, next) % 5 + 1)
+               << " " << (prev + 1) << " " << (std::max(u, prev) % 5 + 1) << "\n";
+  }
+  out_stream << "\n";
+  out_stream.close();
+
+  this->hypergraph = readGraphFile(filename, true);
+  std::remove(filename.c_str());
+
+  ASSERT_EQ(num_nodes, this->hypergraph.initialNumNodes());
+  ASSERT_EQ(2 * num_nodes, this->hypergraph.initialNumEdges());
+  for ( HypernodeID u = 0; u < num_nodes; ++u ) {
+    ASSERT_EQ(u % 7 + 1, this->hypergraph.nodeWeight(u));
+    ASSERT_EQ(2, this->hypergraph.nodeDegree(u));
+    for ( const HyperedgeID e : this->hypergraph.incidentEdges(u) ) {
+      const HypernodeID v = this->hypergraph.edgeTarget(e);
+      ASSERT_TRUE(v == (u + 1) % num_nodes || v == (u + num_nodes - 1) % num_nodes);
+      ASSERT_EQ(std::max(u, v) % 5 + 1, this->hypergraph.edgeWeight(e));
+    }
+  }
+}
+
 TEST_F(AHypergraphReader, ReadsAMetisGraphWithNodeWeights) {
   this->hypergraph = readGraphFile("../tests/instances/graph_with_node_weights.graph", true);
 
@@ -575,5 +618,327 @@ TEST_F(AHypergraphReader, ReadsAMetisGraphWithNodeAndEdgeWeights) {
 }
 #endif
 
+#if !defined(USE_GRAPH_PARTITIONER) && !defined(USE_STRONG_PARTITIONER)
+TEST_F(AHypergraphReader, ReadsAHypergraphSnapshot) {
+  Hypergraph original = readHypergraphFile(
+    "../tests/instances/hypergraph_with_node_and_edge_weights.hgr");
+  writeHypergraphSnapshot(original, "hypergraph_with_node_and_edge_weights.snapshot");
+  this->hypergraph = readInputFile(
+    "hypergraph_with_node_and_edge_weights.snapshot", FileFormat::Snapshot);
+
+  ASSERT_EQ(original.initialNumNodes(), this->hypergraph.initialNumNodes());
+  ASSERT_EQ(original.initialNumEdges(), this->hypergraph.initialNumEdges());
+  ASSERT_EQ(original.initialNumPins(), this->hypergraph.initialNumPins());
+  ASSERT_EQ(original.initialTotalVertexDegree(), this->hypergraph.initialTotalVertexDegree());
+  ASSERT_EQ(original.totalWeight(), this->hypergraph.totalWeight());
+  ASSERT_EQ(original.maxEdgeSize(), this->hypergraph.maxEdgeSize());
+
+  // Verify Incident Nets
+  this->verifyIncidentNets(
+    { { 0, 1 }, { 1 }, { 0, 3 }, { 1, 2 },
+      {1, 2}, { 3 }, { 2, 3 } });
+
+  // Verify Pins
+  this->verifyPins({ { 0, 2 }, { 0, 1, 3, 4 },
+    { 3, 4, 6 }, { 2, 5, 6 } });
+
+  // Verify Node Weights
+  for ( const HypernodeID& hn : original.nodes() ) {
+    ASSERT_EQ(original.nodeWeight(hn), this->hypergraph.nodeWeight(hn));
+  }
+
+  // Verify Edge Weights
+  for ( const HyperedgeID& he : original.edges() ) {
+    ASSERT_EQ(original.edgeWeight(he), this->hypergraph.edgeWeight(he));
+  }
+}
+
+TEST_F(AHypergraphReader, DoesNotModifyTheSnapshotFileWhenModifyingTheHypergraph) {
+  Hypergraph original = readHypergraphFile(
+    "../tests/instances/hypergraph_with_node_and_edge_weights.hgr");
+  writeHypergraphSnapshot(original, "hypergraph_with_node_and_edge_weights.snapshot");
+  {
+    Hypergraph snapshot = readHypergraphSnapshot("hypergraph_with_node_and_edge_weights.snapshot");
+    snapshot.setNodeWeight(0, 42);
+    snapshot.removeEdge(1);
+  }
+  this->hypergraph = readHypergraphSnapshot("hypergraph_with_node_and_edge_weights.snapshot");
+
+  ASSERT_EQ(5, this->hypergraph.nodeWeight(0));
+  ASSERT_TRUE(this->hypergraph.edgeIsEnabled(1));
+  this->verifyPins({ { 0, 2 }, { 0, 1, 3, 4 },
+    { 3, 4, 6 }, { 2, 5, 6 } });
+}
+
+#ifdef __linux__
+TEST_F(AHypergraphReader, ReadsAHypergraphSnapshotFromSharedMemory) {
+  const std::string name = "/mt_kahypar_test_" + std::to_string(getpid());
+  Hypergraph original = readHypergraphFile(
+    "../tests/instances/hypergraph_with_node_and_edge_weights.hgr");
+  writeHypergraphSnapshotToSharedMemory(original, name);
+  {
+    Hypergraph snapshot = readSharedHypergraphSnapshot(name);
+    snapshot.setNodeWeight(0, 42);
+    snapshot.removeEdge(1);
+  }
+  this->hypergraph = readInputFile(name, FileFormat::SharedSnapshot);
+  removeSharedHypergraphSnapshot(name);
+
+  ASSERT_EQ(original.initialNumNodes(), this->hypergraph.initialNumNodes());
+  ASSERT_EQ(original.initialNumEdges(), this->hypergraph.initialNumEdges());
+  ASSERT_EQ(original.initialNumPins(), this->hypergraph.initialNumPins());
+  ASSERT_EQ(original.totalWeight(), this->hypergraph.totalWeight());
+  ASSERT_EQ(5, this->hypergraph.nodeWeight(0));
+  ASSERT_TRUE(this->hypergraph.edgeIsEnabled(1));
+  this->verifyPins({ { 0, 2 }, { 0, 1, 3, 4 },
+    { 3, 4, 6 }, { 2, 5, 6 } });
+}
+#endif
+
+TEST_F(AHypergraphReader, OffloadsAHypergraphToDisk) {
+  this->hypergraph = readHypergraphFile(
+    "../tests/instances/hypergraph_with_node_and_edge_weights.hgr");
+  const HypernodeWeight total_weight = this->hypergraph.totalWeight();
+  offloadHypergraphToDisk(this->hypergraph, ".");
+
+  ASSERT_EQ(7, this->hypergraph.initialNumNodes());
+  ASSERT_EQ(4, this->hypergraph.initialNumEdges());
+  ASSERT_EQ(12, this->hypergraph.initialNumPins());
+  ASSERT_EQ(total_weight, this->hypergraph.totalWeight());
+  this->verifyIncidentNets(
+    { { 0, 1 }, { 1 }, { 0, 3 }, { 1, 2 },
+      {1, 2}, { 3 }, { 2, 3 } });
+  this->verifyPins({ { 0, 2 }, { 0, 1, 3, 4 },
+    { 3, 4, 6 }, { 2, 5, 6 } });
+
+  // The offloaded hypergraph remains modifiable
+  this->hypergraph.setNodeWeight(0, 42);
+  ASSERT_EQ(42, this->hypergraph.nodeWeight(0));
+}
+
+TEST_F(AHypergraphReader, OffloadsAContractedHypergraphToDisk) {
+  Hypergraph original = readHypergraphFile(
+    "../tests/instances/hypergraph_with_node_and_edge_weights.hgr");
+  parallel::scalable_vector<HypernodeID> communities = { 0, 0, 0, 3, 3, 5, 5 };
+  this->hypergraph = original.contract(communities);
+  offloadHypergraphToDisk(this->hypergraph, ".");
+
+  ASSERT_EQ(3, this->hypergraph.initialNumNodes());
+  ASSERT_EQ(3, this->hypergraph.initialNumEdges());
+  ASSERT_EQ(6, this->hypergraph.initialNumPins());
+  ASSERT_EQ(original.totalWeight(), this->hypergraph.totalWeight());
+  this->verifyIncidentNets({ { 0, 2 }, { 0, 1 }, { 1, 2 } });
+  this->verifyPins({ { 0, 1 }, { 1, 2 }, { 0, 2 } });
+}
+
+TEST_F(AHypergraphReader, ReadsTheSameHypergraphAsTheEdgeVectorConstruction) {
+  HyperedgeID num_hyperedges = 0;
+  HypernodeID num_hypernodes = 0;
+  HyperedgeID num_removed_single_pin_hyperedges = 0;
+  HyperedgeVector hyperedges;
+  parallel::scalable_vector<HyperedgeWeight> hyperedges_weight;
+  parallel::scalable_vector<HypernodeWeight> hypernodes_weight;
+  readHypergraphFile("../tests/instances/ibm01.hgr", num_hyperedges, num_hypernodes,
+    num_removed_single_pin_hyperedges, hyperedges, hyperedges_weight, hypernodes_weight, true);
+  Hypergraph reference = HypergraphFactory::construct(num_hypernodes, num_hyperedges,
+    hyperedges, hyperedges_weight.data(), hypernodes_weight.data(), true);
+  this->hypergraph = readHypergraphFile("../tests/instances/ibm01.hgr", true, true);
+
+  ASSERT_EQ(reference.initialNumNodes(), this->hypergraph.initialNumNodes());
+  ASSERT_EQ(reference.initialNumEdges(), this->hypergraph.initialNumEdges());
+  ASSERT_EQ(reference.initialNumPins(), this->hypergraph.initialNumPins());
+  ASSERT_EQ(reference.maxEdgeSize(), this->hypergraph.maxEdgeSize());
+  ASSERT_EQ(reference.totalWeight(), this->hypergraph.totalWeight());
+  ASSERT_EQ(num_removed_single_pin_hyperedges, this->hypergraph.numRemovedHyperedges());
+  for ( const HyperedgeID& he : reference.edges() ) {
+    ASSERT_EQ(reference.edgeWeight(he), this->hypergraph.edgeWeight(he));
+    const std::vector<HypernodeID> expected_pins(
+      reference.pins(he).begin(), reference.pins(he).end());
+    const std::vector<HypernodeID> actual_pins(
+      this->hypergraph.pins(he).begin(), this->hypergraph.pins(he).end());
+    ASSERT_EQ(expected_pins, actual_pins);
+  }
+  for ( const HypernodeID& hn : reference.nodes() ) {
+    ASSERT_EQ(reference.nodeWeight(hn), this->hypergraph.nodeWeight(hn));
+    const std::vector<HyperedgeID> expected_nets(
+      reference.incidentEdges(hn).begin(), reference.incidentEdges(hn).end());
+    const std::vector<HyperedgeID> actual_nets(
+      this->hypergraph.incidentEdges(hn).begin(), this->hypergraph.incidentEdges(hn).end());
+    ASSERT_EQ(expected_nets, actual_nets);
+  }
+}
+#endif
+
+#ifdef KAHYPAR_ENABLE_COMPRESSED_INPUT
+// Writes the file in the BGZF format of bgzip with the given number of bytes per block
+void writeBGZFFile(const std::string& input, const std::string& output, const size_t block_size) {
+  std::ifstream in(input, std::ios::binary);
+  std::stringstream buffer;
+  buffer << in.rdbuf();
+  const std::string data = buffer.str();
+  std::ofstream out(output, std::ios::binary);
+  auto write_le = [&](const uint32_t value, const size_t num_bytes) {
+    for ( size_t i = 0; i < num_bytes; ++i ) {
+      out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+  };
+  for ( size_t pos = 0; pos <= data.size(); pos += block_size ) {
+    // The last block is empty (EOF marker)
+    const size_t size = std::min(block_size, data.size() - pos);
+    const Bytef* in_data = reinterpret_cast<const Bytef*>(data.data() + pos);
+    std::vector<Bytef> compressed(compressBound(size) + 64);
+    z_stream stream = { };
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    stream.next_in = const_cast<Bytef*>(in_data);
+    stream.avail_in = size;
+    stream.next_out = compressed.data();
+    stream.avail_out = compressed.size();
+    ASSERT_EQ(Z_STREAM_END, deflate(&stream, Z_FINISH));
+    const size_t compressed_size = stream.total_out;
+    deflateEnd(&stream);
+
+    const char header[] = { 31, static_cast<char>(139), 8, 4, 0, 0, 0, 0, 0, static_cast<char>(255), 6, 0, 'B', 'C', 2, 0 };
+    out.write(header, sizeof(header));
+    write_le(compressed_size + 25, 2);
+    out.write(reinterpret_cast<const char*>(compressed.data()), compressed_size);
+    write_le(crc32(0, in_data, size), 4);
+    write_le(size, 4);
+    if ( size == 0 ) {
+      break;
+    }
+  }
+}
+
+TEST_F(AHypergraphReader, ReadsABGZFCompressedHypergraph) {
+  const std::string filename = "test_ibm01.hgr.gz";
+  writeBGZFFile("../tests/instances/contracted_ibm01.hgr", filename, 4096);
+  Hypergraph compressed_hg = readInputFile(filename, FileFormat::hMetis);
+  this->hypergraph = readInputFile("../tests/instances/contracted_ibm01.hgr", FileFormat::hMetis);
+  std::remove(filename.c_str());
+
+  ASSERT_EQ(this->hypergraph.initialNumNodes(), compressed_hg.initialNumNodes());
+  ASSERT_EQ(this->hypergraph.initialNumEdges(), compressed_hg.initialNumEdges());
+  ASSERT_EQ(this->hypergraph.initialNumPins(), compressed_hg.initialNumPins());
+  for ( const HyperedgeID& he : this->hypergraph.edges() ) {
+    ASSERT_EQ(this->hypergraph.edgeWeight(he), compressed_hg.edgeWeight(he));
+    ASSERT_EQ(std::vector<HypernodeID>(this->hypergraph.pins(he).begin(), this->hypergraph.pins(he).end()),
+              std::vector<HypernodeID>(compressed_hg.pins(he).begin(), compressed_hg.pins(he).end()));
+  }
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    ASSERT_EQ(this->hypergraph.nodeWeight(hn), compressed_hg.nodeWeight(hn));
+  }
+}
+
+TEST_F(AHypergraphReader, ReadsABGZFCompressedMetisGraph) {
+  const std::string filename = "test_graph.graph.gz";
+  writeBGZFFile("../tests/instances/graph_with_node_and_edge_weights.graph", filename, 16);
+  Hypergraph compressed_hg = readInputFile(filename, FileFormat::Metis);
+  this->hypergraph = readInputFile("../tests/instances/graph_with_node_and_edge_weights.graph", FileFormat::Metis);
+  std::remove(filename.c_str());
+
+  ASSERT_EQ(this->hypergraph.initialNumNodes(), compressed_hg.initialNumNodes());
+  ASSERT_EQ(this->hypergraph.initialNumEdges(), compressed_hg.initialNumEdges());
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    ASSERT_EQ(this->hypergraph.nodeWeight(hn), compressed_hg.nodeWeight(hn));
+    ASSERT_EQ(this->hypergraph.nodeDegree(hn), compressed_hg.nodeDegree(hn));
+  }
+}
+#endif
+
+TEST(ACommunityCacheFile, StoresAndLoadsCommunities) {
+  const std::string filename = "test_communities.community";
+  ds::Clustering communities = { 0, 0, 1, 1, 2, 0, 2 };
+  writeCommunityCacheFile(filename, 42, communities);
+
+  ds::Clustering read_communities;
+  ASSERT_TRUE(readCommunityCacheFile(filename, 42, read_communities));
+  ASSERT_EQ(communities, read_communities);
+
+  // Different fingerprint
+  ds::Clustering other_communities;
+  ASSERT_FALSE(readCommunityCacheFile(filename, 43, other_communities));
+  ASSERT_TRUE(other_communities.empty());
+  std::remove(filename.c_str());
+
+  // File does not exist
+  ASSERT_FALSE(readCommunityCacheFile(filename, 42, other_communities));
+}
+
+TEST_F(AHypergraphReader, WritesAndReadsAPartitionFileInTextAndBinaryFormat) {
+  const std::string filename = "test_partition.part";
+  this->hypergraph = readInputFile("../tests/instances/contracted_ibm01.hgr", FileFormat::hMetis);
+  PartitionedHypergraph partitioned_hg(12, this->hypergraph);
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    partitioned_hg.setOnlyNodePart(hn, hn % 12);
+  }
+  partitioned_hg.initializePartition();
+
+  for ( const bool binary : { false, true } ) {
+    writePartitionFile(partitioned_hg, filename, binary);
+    std::vector<PartitionID> partition;
+    readPartitionFile(filename, partition);
+    ASSERT_EQ(this->hypergraph.initialNumNodes(), partition.size());
+    for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+      ASSERT_EQ(partitioned_hg.partID(hn), partition[hn]) << V(hn) << V(binary);
+    }
+    std::remove(filename.c_str());
+  }
+}
+
+TEST(APartitionFile, IsReadWithUnassignedVerticesAndWindowsLineEndings) {
+  const std::string filename = "test_partition_windows.part";
+  {
+    std::ofstream out(filename, std::ios::binary);
+    out << "0\r\n-1\r\n 12 \r\n\r\n3";
+  }
+  std::vector<PartitionID> partition;
+  readPartitionFile(filename, partition);
+  ASSERT_EQ(std::vector<PartitionID>({ 0, -1, 12, 3 }), partition);
+  std::remove(filename.c_str());
+}
+
+TEST_F(AHypergraphReader, StoresAndRestoresAPartitionCheckpoint) {
+  const std::string filename = "test_partition.checkpoint";
+  this->hypergraph = readInputFile("../tests/instances/unweighted_graph.graph", FileFormat::Metis);
+  Context context;
+  context.partition.k = 3;
+  context.partition.seed = 42;
+  PartitionedHypergraph partitioned_hg(3, this->hypergraph);
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    partitioned_hg.setOnlyNodePart(hn, hn % 3);
+  }
+  partitioned_hg.initializePartition();
+
+  utils::Randomize& randomize = utils::Randomize::instance();
+  randomize.setSeed(42);
+  {
+    PartitionCheckpointWriter writer(filename, this->hypergraph, context);
+    writer.writeAsync(partitioned_hg, 2);
+  }
+  const int expected_random_int = randomize.getRandomInt(0, 1000000, 0);
+
+  PartitionCheckpoint checkpoint;
+  ASSERT_TRUE(readPartitionCheckpoint(filename, this->hypergraph, context, checkpoint));
+  ASSERT_EQ(2, checkpoint.num_completed_vcycles);
+  ASSERT_EQ(this->hypergraph.initialNumNodes(), checkpoint.partition.size());
+  for ( const HypernodeID& hn : this->hypergraph.nodes() ) {
+    ASSERT_EQ(partitioned_hg.partID(hn), checkpoint.partition[hn]);
+  }
+  std::istringstream random_state(checkpoint.random_state);
+  ASSERT_TRUE(randomize.deserializeState(random_state));
+  ASSERT_EQ(expected_random_int, randomize.getRandomInt(0, 1000000, 0));
+
+  // Different seed
+  context.partition.seed = 0;
+  PartitionCheckpoint other_checkpoint;
+  ASSERT_FALSE(readPartitionCheckpoint(filename, this->hypergraph, context, other_checkpoint));
+  ASSERT_TRUE(other_checkpoint.partition.empty());
+  std::remove(filename.c_str());
+
+  // File does not exist
+  context.partition.seed = 42;
+  ASSERT_FALSE(readPartitionCheckpoint(filename, this->hypergraph, context, other_checkpoint));
+}
+
 }  // namespace io
 }  // namespace mt_kahypar
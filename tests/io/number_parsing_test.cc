@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+#include "mt-kahypar/io/number_parsing.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+namespace io {
+
+void verifyNumbers(const std::string& line, const std::vector<int64_t>& expected) {
+  // Small inputs are parsed with the scalar fallback, therefore
+  // we append padding to also test the vectorized code path
+  for ( const std::string& input : { line, line + std::string(32, '\0') } ) {
+    const size_t length = input.size();
+    size_t pos = 0;
+    size_t scalar_pos = 0;
+    for ( const int64_t number : expected ) {
+      ASSERT_EQ(number, read_number(input.c_str(), pos, length));
+      ASSERT_EQ(number, read_number_scalar(input.c_str(), scalar_pos, length));
+      ASSERT_EQ(scalar_pos, pos);
+    }
+    ASSERT_TRUE(pos == line.size() || is_line_ending(input.c_str(), pos));
+  }
+}
+
+TEST(ANumberParser, ReadsSingleDigits) {
+  verifyNumbers("1 2 3 4 5 6 7 8 9 0\n", { 1, 2, 3, 4, 5, 6, 7, 8, 9, 0 });
+}
+
+TEST(ANumberParser, ReadsNumbersWithUpToEightDigits) {
+  verifyNumbers("12 345 6789 10111 213141 5161718 19202122\n",
+    { 12, 345, 6789, 10111, 213141, 5161718, 19202122 });
+}
+
+TEST(ANumberParser, ReadsNumbersWithMoreThanEightDigits) {
+  verifyNumbers("123456789 1234567890 12345678901234 123456789012345\n",
+    { 123456789, 1234567890, 12345678901234, 123456789012345 });
+}
+
+TEST(ANumberParser, ReadsNumbersWithMoreThanSixteenDigits) {
+  verifyNumbers("1234567890123456789 42\n", { 1234567890123456789, 42 });
+}
+
+TEST(ANumberParser, SkipsMultipleSpaces) {
+  verifyNumbers("   7   42     1000000 \n", { 7, 42, 1000000 });
+}
+
+TEST(ANumberParser, StopsAtWindowsLineEndings) {
+  verifyNumbers("3 14 159\r\n26 5\r\n", { 3, 14, 159 });
+}
+
+}  // namespace io
+}  // namespace mt_kahypar
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "gmock/gmock.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <thread>
+
+#include "mt-kahypar/io/partitioning_daemon.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+namespace io {
+
+namespace {
+  const std::string job_args = "-p ../config/default_preset.ini -k 4 -e 0.03 -o km1 -m direct -t 1";
+
+  Context createContext(const std::string& filename) {
+    Context context;
+    context.partition.graph_filename = filename;
+    context.partition.file_format = FileFormat::hMetis;
+    return context;
+  }
+
+  std::string sendRequest(const std::string& socket_path, const std::string& request) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    // The daemon might not listen yet
+    while ( ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    const std::string line = request + "\n";
+    EXPECT_EQ(static_cast<ssize_t>(line.size()), ::send(fd, line.data(), line.size(), 0));
+    std::string response;
+    char buffer[256];
+    ssize_t num_bytes = 0;
+    while ( (num_bytes = ::recv(fd, buffer, sizeof(buffer), 0)) > 0 ) {
+      response.append(buffer, num_bytes);
+    }
+    ::close(fd);
+    return response;
+  }
+}
+
+TEST(AnInputCache, ReturnsCachedHypergraph) {
+  InputCache cache(2);
+  Context context = createContext("../tests/instances/test_instance.hgr");
+  std::shared_ptr<const Hypergraph> first = cache.get(context);
+  std::shared_ptr<const Hypergraph> second = cache.get(context);
+  ASSERT_EQ(first.get(), second.get());
+  ASSERT_EQ(100, first->initialNumNodes());
+  ASSERT_EQ(1, cache.size());
+}
+
+TEST(AnInputCache, EvictsLeastRecentlyUsedHypergraph) {
+  InputCache cache(2);
+  Context first = createContext("../tests/instances/test_instance.hgr");
+  Context second = createContext("../tests/instances/unweighted_hypergraph.hgr");
+  Context third = createContext("../tests/instances/hypergraph_with_edge_weights.hgr");
+  std::shared_ptr<const Hypergraph> hg_first = cache.get(first);
+  std::shared_ptr<const Hypergraph> hg_second = cache.get(second);
+  // first is now the most recently used hypergraph
+  ASSERT_EQ(hg_first.get(), cache.get(first).get());
+  cache.get(third);
+  ASSERT_EQ(2, cache.size());
+  ASSERT_EQ(hg_first.get(), cache.get(first).get());
+  ASSERT_NE(hg_second.get(), cache.get(second).get());
+}
+
+TEST(AnInputCache, DoesNotCacheIfCapacityIsZero) {
+  InputCache cache(0);
+  Context context = createContext("../tests/instances/test_instance.hgr");
+  ASSERT_NE(cache.get(context).get(), cache.get(context).get());
+  ASSERT_EQ(0, cache.size());
+}
+
+TEST(AnInputCache, ThrowsIfInputFileDoesNotExist) {
+  InputCache cache(2);
+  Context context = createContext("../tests/instances/does_not_exist.hgr");
+  ASSERT_THROW(cache.get(context), std::invalid_argument);
+}
+
+TEST(APartitioningDaemon, RejectsInvalidRequests) {
+  DaemonParameters params;
+  PartitioningDaemon daemon(params);
+  ASSERT_EQ("ERROR empty request", daemon.processRequest("  ", 0));
+  ASSERT_EQ(0, daemon.processRequest("--help", 0).find("ERROR"));
+  ASSERT_EQ(0, daemon.processRequest("-k 4 -e 0.03 -o km1 -m direct", 0).find("ERROR"));
+  ASSERT_EQ(0, daemon.processRequest(
+    "-h ../tests/instances/does_not_exist.hgr " + job_args, 0).find("ERROR"));
+}
+
+TEST(APartitioningDaemon, PartitionsCachedInputs) {
+  DaemonParameters params;
+  PartitioningDaemon daemon(params);
+  const std::string request = "-h ../tests/instances/test_instance.hgr " + job_args;
+  const std::string first = daemon.processRequest(request, 0);
+  ASSERT_EQ(0, first.find("OK objective=")) << first;
+  const std::string second = daemon.processRequest(request, 0);
+  ASSERT_EQ(0, second.find("OK objective=")) << second;
+  ASSERT_EQ(1, daemon.inputCache().size());
+}
+
+TEST(APartitioningDaemon, ProcessesJobsReceivedOnSocket) {
+  DaemonParameters params;
+  params.socket_path = "/tmp/mt_kahypar_daemon_test_" + std::to_string(::getpid()) + ".sock";
+  params.max_concurrent_jobs = 2;
+  PartitioningDaemon daemon(params);
+  std::thread daemon_thread([&] {
+    daemon.run();
+  });
+
+  const std::string response = sendRequest(params.socket_path,
+    "-h ../tests/instances/test_instance.hgr " + job_args);
+  EXPECT_EQ(0, response.find("OK objective=")) << response;
+  ASSERT_EQ("OK\n", sendRequest(params.socket_path, "shutdown"));
+  daemon_thread.join();
+  ASSERT_NE(0, ::access(params.socket_path.c_str(), F_OK));
+}
+
+}  // namespace io
+}  // namespace mt_kahypar
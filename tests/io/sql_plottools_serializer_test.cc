@@ -56,11 +56,12 @@ std::unordered_map<std::string, std::string> target_struct_prefix =
     {"DeterministicRefinement", "sync_lp_"}, {"FlowParameters", "flow_"} };
 
 std::set<std::string> excluded_members =
-  { "verbose_output", "show_detailed_timings", "show_detailed_clustering_timings", "timings_output_depth", "show_memory_consumption", "show_advanced_cut_analysis", "enable_progress_bar", "sp_process_output",
-    "measure_detailed_uncontraction_timings", "write_partition_file", "graph_partition_output_folder", "graph_partition_filename", "graph_community_filename", "community_detection",
+  { "verbose_output", "show_detailed_timings", "show_detailed_clustering_timings", "timings_output_depth", "measure_hardware_counters", "profile_scalability", "show_memory_consumption", "show_advanced_cut_analysis", "enable_progress_bar", "sp_process_output",
+    "measure_detailed_uncontraction_timings", "write_partition_file", "binary_partition_file", "graph_partition_output_folder", "graph_partition_filename", "graph_community_filename", "community_detection",
     "community_redistribution", "coarsening_rating", "label_propagation", "lp_execute_sequential", "deterministic_refinement",
     "snapshot_interval", "initial_partitioning_refinement", "initial_partitioning_enabled_ip_algos", "original_num_threads",
-    "stable_construction_of_incident_edges", "fm", "global_fm", "flows", "csv_output", "preset_file", "preset_type", "instance_type", "degree_of_parallelism" };
+    "stable_construction_of_incident_edges", "fm", "global_fm", "flows", "csv_output", "preset_file", "preset_type", "instance_type", "degree_of_parallelism",
+    "community_cache_directory", "coarsening_offload_directory", "checkpoint_file", "fixed_vertex_filename", "trace_file" };
 
 bool is_target_struct(const std::string& line) {
   for ( const std::string& target_struct : target_structs ) {
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "gmock/gmock.h"
+
+#include <atomic>
+
+#include "mt-kahypar/parallel/chunking.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+namespace parallel {
+
+void verifyChunksCoverRange(const chunking::WeightedChunks& chunks, const size_t n) {
+  size_t expected_first = 0;
+  for ( size_t c = 0; c < chunks.numChunks(); ++c ) {
+    const auto [first, last] = chunks.chunk(c);
+    ASSERT_EQ(expected_first, first);
+    ASSERT_LT(first, last);
+    expected_first = last;
+  }
+  ASSERT_EQ(n, expected_first);
+}
+
+TEST(WeightedChunks, SplitsUniformWeightsIntoChunksOfEqualSize) {
+  chunking::WeightedChunks chunks;
+  chunks.build(100000, 4, [](const size_t) { return 1; });
+  verifyChunksCoverRange(chunks, 100000);
+  ASSERT_EQ(4, chunks.numChunks());
+  for ( size_t c = 0; c < chunks.numChunks(); ++c ) {
+    const auto [first, last] = chunks.chunk(c);
+    ASSERT_NEAR(25000, last - first, 256);
+  }
+}
+
+TEST(WeightedChunks, BalancesSkewedWeights) {
+  // The first 1% of the indices have 99% of the weight
+  const size_t n = 1000000;
+  auto weight = [&](const size_t i) { return i < n / 100 ? 9900 : 1; };
+  chunking::WeightedChunks chunks;
+  chunks.build(n, 8, weight);
+  verifyChunksCoverRange(chunks, n);
+
+  uint64_t total_weight = 0;
+  for ( size_t i = 0; i < n; ++i ) {
+    total_weight += weight(i) + 1;
+  }
+  for ( size_t c = 0; c < chunks.numChunks(); ++c ) {
+    const auto [first, last] = chunks.chunk(c);
+    uint64_t chunk_weight = 0;
+    for ( size_t i = first; i < last; ++i ) {
+      chunk_weight += weight(i) + 1;
+    }
+    // One block of 256 indices can exceed the target weight
+    ASSERT_LE(chunk_weight, total_weight / 8 + 256 * 9901);
+  }
+}
+
+TEST(WeightedChunks, VisitsEachIndexExactlyOnce) {
+  const size_t n = 12345;
+  std::vector<std::atomic<int>> visited(n);
+  chunking::WeightedChunks chunks;
+  chunks.build(n, 16, [](const size_t i) { return i % 7 == 0 ? 1000 : 0; });
+  chunks.parallelFor([&](const size_t first, const size_t last) {
+    for ( size_t i = first; i < last; ++i ) {
+      ++visited[i];
+    }
+  });
+  for ( size_t i = 0; i < n; ++i ) {
+    ASSERT_EQ(1, visited[i].load());
+  }
+}
+
+TEST(WeightedChunks, HandlesAnEmptyRange) {
+  chunking::WeightedChunks chunks;
+  chunks.build(0, 4, [](const size_t) { return 1; });
+  ASSERT_EQ(0, chunks.numChunks());
+}
+
+}  // namespace parallel
+}  // namespace mt_kahypar
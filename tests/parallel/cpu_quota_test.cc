@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "mt-kahypar/parallel/cpu_quota.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+namespace parallel {
+
+TEST(ACpuQuota, IsUnlimitedForCgroupV2WithoutQuota) {
+  ASSERT_EQ(0, cpu_quota::parse_cgroup_v2_cpu_max("max 100000\n"));
+}
+
+TEST(ACpuQuota, RoundsUpCgroupV2QuotaToFullCPUs) {
+  ASSERT_EQ(4, cpu_quota::parse_cgroup_v2_cpu_max("400000 100000\n"));
+  ASSERT_EQ(2, cpu_quota::parse_cgroup_v2_cpu_max("150000 100000\n"));
+  ASSERT_EQ(1, cpu_quota::parse_cgroup_v2_cpu_max("50000 100000"));
+}
+
+TEST(ACpuQuota, IgnoresMalformedCgroupV2Content) {
+  ASSERT_EQ(0, cpu_quota::parse_cgroup_v2_cpu_max(""));
+  ASSERT_EQ(0, cpu_quota::parse_cgroup_v2_cpu_max("100000"));
+  ASSERT_EQ(0, cpu_quota::parse_cgroup_v2_cpu_max("abc 100000"));
+  ASSERT_EQ(0, cpu_quota::parse_cgroup_v2_cpu_max("100000 0"));
+}
+
+TEST(ACpuQuota, ParsesCgroupV1Quota) {
+  ASSERT_EQ(0, cpu_quota::parse_cgroup_v1_cpu_quota(-1, 100000));
+  ASSERT_EQ(3, cpu_quota::parse_cgroup_v1_cpu_quota(300000, 100000));
+  ASSERT_EQ(3, cpu_quota::parse_cgroup_v1_cpu_quota(250000, 100000));
+  ASSERT_EQ(0, cpu_quota::parse_cgroup_v1_cpu_quota(100000, 0));
+}
+
+}  // namespace parallel
+}  // namespace mt_kahypar
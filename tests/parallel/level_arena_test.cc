@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "mt-kahypar/parallel/level_arena.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+namespace parallel {
+
+TEST(ALevelArena, IsInactiveWithoutUsers) {
+  LevelArena& arena = LevelArena::instance();
+  ASSERT_FALSE(arena.isActive());
+  ASSERT_EQ(nullptr, arena.request(100));
+}
+
+TEST(ALevelArena, ServesAlignedRequests) {
+  LevelArena& arena = LevelArena::instance();
+  arena.acquire(1000);
+  ASSERT_TRUE(arena.isActive());
+  char* first = arena.request(10);
+  char* second = arena.request(100);
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(first) % 64);
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(second) % 64);
+  ASSERT_EQ(64, second - first);
+  ASSERT_EQ(64 + 128, arena.usedBytes());
+  arena.release();
+  ASSERT_FALSE(arena.isActive());
+}
+
+TEST(ALevelArena, RejectsRequestsIfExhausted) {
+  LevelArena& arena = LevelArena::instance();
+  arena.acquire(1024);
+  ASSERT_NE(nullptr, arena.request(1000));
+  ASSERT_EQ(nullptr, arena.request(64));
+  ASSERT_EQ(1, arena.numFailedRequests());
+  arena.release();
+}
+
+TEST(ALevelArena, RejectsRequestsIfSealed) {
+  LevelArena& arena = LevelArena::instance();
+  arena.acquire(1024);
+  arena.seal();
+  ASSERT_EQ(nullptr, arena.request(64));
+  arena.release();
+}
+
+TEST(ALevelArena, IsFreedWhenTheLastUserReleasesIt) {
+  LevelArena& arena = LevelArena::instance();
+  arena.acquire(1024);
+  arena.acquire(2048);
+  // The region of the first user is shared
+  ASSERT_EQ(1024, arena.sizeInBytes());
+  arena.release();
+  ASSERT_TRUE(arena.isActive());
+  ASSERT_NE(nullptr, arena.request(64));
+  arena.release();
+  ASSERT_FALSE(arena.isActive());
+}
+
+}  // namespace parallel
+}  // namespace mt_kahypar
@@ -455,6 +455,118 @@ TEST(AMemoryPool, MemoryPoolIsCorrectlyResetted) {
   MemoryPool::instance().free_memory_chunks();
 }
 
+TEST(AMemoryPool, AppliesMemoryPlacementToLargeMemoryChunks) {
+  std::vector<std::pair<const char*, size_t>> placed_memory;
+  MemoryPool::instance().register_memory_placement_function(
+    [&](const char* data, const size_t size_in_bytes) {
+      placed_memory.emplace_back(data, size_in_bytes);
+    });
+  MemoryPool::instance().register_memory_group("TEST_GROUP_1", 1);
+  MemoryPool::instance().register_memory_chunk("TEST_GROUP_1", "TEST_CHUNK_1",
+    MemoryPool::MINIMUM_PLACEMENT_SIZE, sizeof(char));
+  MemoryPool::instance().register_memory_chunk("TEST_GROUP_1", "TEST_CHUNK_2", 5, sizeof(size_t));
+  MemoryPool::instance().allocate_memory_chunks(false);
+
+  ASSERT_EQ(1, placed_memory.size());
+  ASSERT_EQ(MemoryPool::instance().mem_chunk("TEST_GROUP_1", "TEST_CHUNK_1"), placed_memory[0].first);
+  ASSERT_EQ(MemoryPool::MINIMUM_PLACEMENT_SIZE, placed_memory[0].second);
+
+  MemoryPool::instance().register_memory_placement_function(nullptr);
+  MemoryPool::instance().free_memory_chunks();
+}
+
+TEST(AMemoryPool, DoesNotReallocateMemoryIfRegisteredSizeDoesNotIncrease) {
+  setupMemoryPool(false);
+  char* chunk = MemoryPool::instance().mem_chunk("TEST_GROUP_1", "TEST_CHUNK_1");
+  MemoryPool::instance().register_memory_group("TEST_GROUP_1", 1);
+  MemoryPool::instance().register_memory_chunk("TEST_GROUP_1", "TEST_CHUNK_1", 3, sizeof(size_t));
+  MemoryPool::instance().allocate_memory_chunks(false);
+
+  ASSERT_EQ(chunk, MemoryPool::instance().mem_chunk("TEST_GROUP_1", "TEST_CHUNK_1"));
+  ASSERT_EQ(5 * sizeof(size_t), MemoryPool::instance().size_in_bytes("TEST_GROUP_1", "TEST_CHUNK_1"));
+
+  MemoryPool::instance().free_memory_chunks();
+}
+
+TEST(AMemoryPool, ReallocatesMemoryIfRegisteredSizeIncreases) {
+  setupMemoryPool(false);
+  MemoryPool::instance().register_memory_group("TEST_GROUP_1", 1);
+  MemoryPool::instance().register_memory_chunk("TEST_GROUP_1", "TEST_CHUNK_1", 10, sizeof(size_t));
+  MemoryPool::instance().allocate_memory_chunks(false);
+
+  ASSERT_EQ(10 * sizeof(size_t), MemoryPool::instance().size_in_bytes("TEST_GROUP_1", "TEST_CHUNK_1"));
+  ASSERT_EQ(5 * sizeof(int), MemoryPool::instance().size_in_bytes("TEST_GROUP_1", "TEST_CHUNK_2"));
+  ASSERT_NE(nullptr, MemoryPool::instance().request_mem_chunk("TEST_GROUP_1", "TEST_CHUNK_1", 10, sizeof(size_t)));
+
+  MemoryPool::instance().free_memory_chunks();
+}
+
+TEST(AMemoryPool, ReallocatesMemoryIfANewMemoryChunkIsRegistered) {
+  setupMemoryPool(false);
+  MemoryPool::instance().register_memory_group("TEST_GROUP_3", 3);
+  MemoryPool::instance().register_memory_chunk("TEST_GROUP_3", "TEST_CHUNK_1", 5, sizeof(size_t));
+  MemoryPool::instance().allocate_memory_chunks(false);
+
+  ASSERT_NE(nullptr, MemoryPool::instance().mem_chunk("TEST_GROUP_3", "TEST_CHUNK_1"));
+  ASSERT_NE(nullptr, MemoryPool::instance().mem_chunk("TEST_GROUP_1", "TEST_CHUNK_1"));
+  ASSERT_EQ(5 * sizeof(size_t), MemoryPool::instance().size_in_bytes("TEST_GROUP_3", "TEST_CHUNK_1"));
+
+  MemoryPool::instance().free_memory_chunks();
+}
+
+TEST(AMemoryPool, DoesNotServeRequestsIfDisabled) {
+  setupMemoryPool(false);
+  MemoryPool::instance().disable_memory_requests();
+  ASSERT_EQ(nullptr, MemoryPool::instance().request_mem_chunk("TEST_GROUP_1", "TEST_CHUNK_1", 5, sizeof(size_t)));
+  ASSERT_EQ(nullptr, MemoryPool::instance().request_unused_mem_chunk(5, sizeof(size_t)));
+  MemoryPool::instance().enable_memory_requests();
+  ASSERT_EQ(MemoryPool::instance().mem_chunk("TEST_GROUP_1", "TEST_CHUNK_1"),
+            MemoryPool::instance().request_mem_chunk("TEST_GROUP_1", "TEST_CHUNK_1", 5, sizeof(size_t)));
+
+  MemoryPool::instance().free_memory_chunks();
+}
+
+#ifdef __linux__
+TEST(AMemoryPool, AllocatesLargeMemoryChunksWithHugePages) {
+  const size_t num_elements = 1000000;
+  MemoryPool::instance().deactivate_minimum_allocation_size();
+  MemoryPool::instance().activate_huge_pages();
+  MemoryPool::instance().register_memory_group("TEST_GROUP_1", 1);
+  MemoryPool::instance().register_memory_chunk("TEST_GROUP_1", "TEST_CHUNK_1", num_elements, sizeof(size_t));
+  MemoryPool::instance().register_memory_chunk("TEST_GROUP_1", "TEST_CHUNK_2", 5, sizeof(size_t));
+  MemoryPool::instance().allocate_memory_chunks(false);
+
+  ASSERT_EQ(num_elements * sizeof(size_t), MemoryPool::instance().huge_page_size_of_memory_chunks());
+  size_t* data = reinterpret_cast<size_t*>(MemoryPool::instance().request_mem_chunk(
+    "TEST_GROUP_1", "TEST_CHUNK_1", num_elements, sizeof(size_t)));
+  ASSERT_NE(nullptr, data);
+  // Memory chunks are zero initialized
+  for ( size_t i = 0; i < num_elements; ++i ) {
+    ASSERT_EQ(0, data[i]);
+    data[i] = i;
+  }
+  ASSERT_EQ(num_elements - 1, data[num_elements - 1]);
+
+  MemoryPool::instance().free_memory_chunks();
+  ASSERT_EQ(0, MemoryPool::instance().huge_page_size_of_memory_chunks());
+  MemoryPool::instance().deactivate_huge_pages();
+}
+
+TEST(AMemoryPool, AllocatesLargeArraysOutsideOfThePoolWithHugePages) {
+  const size_t size_in_bytes = 4194304; // 4 MB
+  MemoryPool::instance().activate_huge_pages();
+  ASSERT_EQ(nullptr, MemoryPool::instance().allocate_huge_pages(1000));
+  char* data = MemoryPool::instance().allocate_huge_pages(size_in_bytes);
+  ASSERT_NE(nullptr, data);
+  ASSERT_EQ(size_in_bytes, MemoryPool::instance().huge_page_size_of_arrays());
+  data[0] = 1;
+  data[size_in_bytes - 1] = 1;
+  MemoryPool::instance().free_huge_pages(data, size_in_bytes);
+  ASSERT_EQ(0, MemoryPool::instance().huge_page_size_of_arrays());
+  MemoryPool::instance().deactivate_huge_pages();
+}
+#endif
+
 
 }  // namespace parallel
 }  // namespace mt_kahypar
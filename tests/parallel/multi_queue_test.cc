@@ -0,0 +1,121 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2020 Lars Gottesbüren <lars.gottesbueren@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include <mt-kahypar/parallel/multi_queue.h>
+#include <thread>
+
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/task_group.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+namespace parallel {
+
+TEST(MultiQueue, HasCorrectSizeAfterParallelInsertionAndDeletion) {
+  int m = 75000;
+  MultiQueue<int, int> mq(std::thread::hardware_concurrency());
+  tbb::parallel_for(0, m, [&](int i) {
+    mq.safe_push(i, i, tbb::this_task_arena::current_thread_index());
+  });
+  ASSERT_EQ(mq.unsafe_size(), m);
+  mq.build();
+
+  tbb::enumerable_thread_specific<int> counters;
+  tbb::task_group tg;
+  int num_tasks = std::thread::hardware_concurrency();
+  for (int i = 0; i < num_tasks; ++i) {
+    tg.run([&, i]() {
+      int res = 0;
+      int& lc = counters.local();
+      while (mq.try_pop(res, i)) {
+        lc++;
+      }
+    });
+  }
+  tg.wait();
+
+  int overall = counters.combine(std::plus<int>());
+  ASSERT_EQ(overall, m);
+  ASSERT_EQ(mq.unsafe_size(), 0);
+}
+
+TEST(MultiQueue, ClearWorks) {
+  MultiQueue<int, int> mq(std::thread::hardware_concurrency());
+  mq.safe_push(5, 5, 0);
+  mq.safe_push(420, 420, 0);
+  ASSERT_EQ(mq.unsafe_size(), 2);
+  mq.clear();
+  ASSERT_EQ(mq.unsafe_size(), 0);
+  int res = 0;
+  ASSERT_FALSE(mq.try_pop(res, 0));
+}
+
+TEST(MultiQueue, ExtractsElementsInOrderOfTheirKeysWithinOneHeap) {
+  MultiQueue<int, int> mq(1);
+  mq.safe_push(1, 10, 0);
+  mq.safe_push(2, 30, 0);
+  mq.safe_push(3, 20, 0);
+  mq.safe_push(4, -5, 0);
+  mq.build();
+
+  // With one thread, all elements are either in the first or second heap.
+  // Extracted elements must have a key at least as high as the top of the other heap.
+  std::vector<int> extracted;
+  int res = 0;
+  while (mq.try_pop(res, 0)) {
+    extracted.push_back(res);
+  }
+  ASSERT_EQ(4, extracted.size());
+  ASSERT_EQ(2, extracted[0]);
+  std::sort(extracted.begin(), extracted.end());
+  ASSERT_EQ(std::vector<int>({ 1, 2, 3, 4 }), extracted);
+}
+
+TEST(MultiQueue, ExtractsHighPriorityElementsFirst) {
+  const int m = 100000;
+  const size_t num_threads = std::thread::hardware_concurrency();
+  MultiQueue<int, int> mq(num_threads);
+  tbb::parallel_for(0, m, [&](int i) {
+    mq.safe_push(i, i, tbb::this_task_arena::current_thread_index());
+  });
+  mq.build();
+
+  // The first extracted elements should be among the elements with the highest keys
+  int res = 0;
+  long long sum = 0;
+  const int num_extractions = 100;
+  for (int i = 0; i < num_extractions; ++i) {
+    ASSERT_TRUE(mq.try_pop(res, 0));
+    sum += res;
+  }
+  ASSERT_GE(sum / num_extractions, m / 2);
+}
+
+}  // namespace parallel
+}  // namespace mt_kahypar
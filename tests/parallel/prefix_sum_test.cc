@@ -88,6 +88,21 @@ namespace mt_kahypar {
     ASSERT_EQ(in, in_stl);
   }
 
+  TEST(PrefixSumTest, MatchesSequentialIfSizeIsNotAMultipleOfTheBlockSize) {
+    size_t n = (1 << 19) + 1337;
+    vec<uint32_t> in(n, 0);
+    std::mt19937 rng(422);
+    std::generate(in.begin(), in.end(), [&] { return rng() % 100; });
+
+    vec<uint32_t> out_parallel(n, 420);
+    parallel_prefix_sum(in.begin(), in.end(), out_parallel.begin(), std::plus<uint32_t>(), 0);
+
+    vec<uint32_t> out_stl;
+    std::partial_sum(in.begin(), in.end(), std::back_inserter(out_stl), std::plus<uint32_t>());
+
+    ASSERT_EQ(out_parallel, out_stl);
+  }
+
   TEST(PrefixSumTest, WorksInplaceSmall) {
     size_t n = 1 << 12;
     vec<size_t> in(n, 0);
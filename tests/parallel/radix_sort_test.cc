@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "gmock/gmock.h"
+
+#include <algorithm>
+#include <random>
+
+#include "mt-kahypar/parallel/parallel_radix_sort.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+namespace parallel {
+
+struct KeyValue {
+  uint64_t key;
+  size_t value;
+};
+
+TEST(ARadixSort, SortsStablyByKey) {
+  const size_t n = 300000;
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<uint64_t> key_dist(0, (UL(1) << 30) - 1);
+  vec<KeyValue> data(n);
+  for ( size_t i = 0; i < n; ++i ) {
+    // Few distinct keys in the upper bits to create many equal keys
+    data[i] = KeyValue { key_dist(rng) & ~((UL(1) << 20) - 1), i };
+  }
+  vec<KeyValue> expected = data;
+  std::stable_sort(expected.begin(), expected.end(),
+    [](const KeyValue& lhs, const KeyValue& rhs) { return lhs.key < rhs.key; });
+
+  vec<KeyValue> buffer;
+  auto get_key = [](const KeyValue& kv) { return kv.key; };
+  radix_sort(data, buffer, (UL(1) << 30) - 1, get_key, 4);
+  ASSERT_EQ(n, data.size());
+  for ( size_t i = 0; i < n; ++i ) {
+    ASSERT_EQ(expected[i].key, data[i].key);
+    ASSERT_EQ(expected[i].value, data[i].value);
+  }
+}
+
+TEST(ARadixSort, SortsElementsWithKeyZero) {
+  vec<KeyValue> data = { {0, 0}, {0, 1}, {0, 2} };
+  vec<KeyValue> buffer;
+  auto get_key = [](const KeyValue& kv) { return kv.key; };
+  radix_sort(data, buffer, 0, get_key, 4);
+  ASSERT_EQ(3, data.size());
+  for ( size_t i = 0; i < data.size(); ++i ) {
+    ASSERT_EQ(i, data[i].value);
+  }
+}
+
+void verifyReducedRuns(const vec<KeyValue>& data, const size_t num_tasks) {
+  vec<size_t> expected(data.size(), 0);
+  for ( size_t i = 0, run_begin = 0; i < data.size(); ++i ) {
+    if ( i > 0 && data[i - 1].key != data[i].key ) {
+      run_begin = i;
+    }
+    expected[run_begin] += data[i].value;
+  }
+
+  vec<size_t> actual(data.size(), 0);
+  vec<size_t> num_writes(data.size(), 0);
+  reduce_runs(data,
+    [](const KeyValue& lhs, const KeyValue& rhs) { return lhs.key == rhs.key; },
+    [](KeyValue& lhs, const KeyValue& rhs) { lhs.value += rhs.value; },
+    [&](const size_t pos, const KeyValue& kv) {
+      actual[pos] = kv.value;
+      ++num_writes[pos];
+    }, num_tasks);
+  for ( size_t i = 0; i < data.size(); ++i ) {
+    const bool is_run_begin = i == 0 || data[i - 1].key != data[i].key;
+    ASSERT_EQ(is_run_begin ? 1 : 0, num_writes[i]) << V(i);
+    ASSERT_EQ(expected[i], actual[i]) << V(i);
+  }
+}
+
+TEST(AReductionOfRuns, CombinesAllElementsOfEachRun) {
+  vec<KeyValue> data;
+  for ( size_t key = 0; key < 100; ++key ) {
+    for ( size_t i = 0; i <= key % 7; ++i ) {
+      data.push_back(KeyValue { key, key + i });
+    }
+  }
+  verifyReducedRuns(data, 4);
+}
+
+TEST(AReductionOfRuns, CombinesRunsSpanningSeveralChunks) {
+  vec<KeyValue> data;
+  data.push_back(KeyValue { 0, 1 });
+  for ( size_t i = 0; i < 700; ++i ) {
+    data.push_back(KeyValue { 1, i });
+  }
+  for ( size_t i = 0; i < 300; ++i ) {
+    data.push_back(KeyValue { 2 + i / 3, i });
+  }
+  verifyReducedRuns(data, 4);
+  verifyReducedRuns(data, 1);
+}
+
+TEST(AReductionOfRuns, CombinesASingleRun) {
+  vec<KeyValue> data(1000, KeyValue { 5, 1 });
+  verifyReducedRuns(data, 8);
+}
+
+}  // namespace parallel
+}  // namespace mt_kahypar
@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "tbb/parallel_for.h"
+
+#include "mt-kahypar/parallel/scratch_arena.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+namespace parallel {
+
+TEST(AScratchArena, AllocatesInitializedArrays) {
+  ScratchArena::Scope scope;
+  int* data = ScratchArena::local().allocate<int>(100, 42);
+  for ( size_t i = 0; i < 100; ++i ) {
+    ASSERT_EQ(42, data[i]);
+  }
+}
+
+TEST(AScratchArena, AlignsAllocations) {
+  ScratchArena::Scope scope;
+  ScratchArena& arena = ScratchArena::local();
+  arena.allocate<uint8_t>(3);
+  uint64_t* data = arena.allocate<uint64_t>(10);
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(data) % alignof(uint64_t));
+}
+
+TEST(AScratchArena, ReusesMemoryAfterScopeEnds) {
+  ScratchArena& arena = ScratchArena::local();
+  int* first = nullptr;
+  {
+    ScratchArena::Scope scope;
+    first = arena.allocate<int>(1000);
+  }
+  {
+    ScratchArena::Scope scope;
+    ASSERT_EQ(first, arena.allocate<int>(1000));
+  }
+}
+
+TEST(AScratchArena, ReleasesOnlyAllocationsOfInnerScope) {
+  ScratchArena& arena = ScratchArena::local();
+  ScratchArena::Scope outer_scope;
+  int* outer = arena.allocate<int>(10, 1);
+  int* inner = nullptr;
+  {
+    ScratchArena::Scope inner_scope;
+    inner = arena.allocate<int>(10, 2);
+  }
+  int* next = arena.allocate<int>(10, 3);
+  ASSERT_EQ(inner, next);
+  for ( size_t i = 0; i < 10; ++i ) {
+    ASSERT_EQ(1, outer[i]);
+  }
+}
+
+TEST(AScratchArena, GrowsIfAllocationsExceedBlockSize) {
+  ScratchArena& arena = ScratchArena::local();
+  const size_t n = 1UL << 18;
+  {
+    ScratchArena::Scope scope;
+    size_t* small = arena.allocate<size_t>(100, 7);
+    size_t* large = arena.allocate<size_t>(n, 0);
+    for ( size_t i = 0; i < n; ++i ) {
+      large[i] = i;
+    }
+    for ( size_t i = 0; i < 100; ++i ) {
+      ASSERT_EQ(7, small[i]);
+    }
+    ASSERT_EQ(n - 1, large[n - 1]);
+  }
+  const size_t size_in_bytes = arena.sizeInBytes();
+  ASSERT_GE(size_in_bytes, n * sizeof(size_t));
+  {
+    // The memory is retained
+    ScratchArena::Scope scope;
+    arena.allocate<size_t>(100);
+    arena.allocate<size_t>(n);
+  }
+  ASSERT_EQ(size_in_bytes, arena.sizeInBytes());
+}
+
+TEST(AScratchArena, CanBeUsedConcurrently) {
+  tbb::parallel_for(UL(0), UL(1000), [&](const size_t i) {
+    ScratchArena::Scope scope;
+    size_t* data = ScratchArena::local().allocate<size_t>(i + 1, i);
+    for ( size_t j = 0; j <= i; ++j ) {
+      ASSERT_EQ(i, data[j]);
+    }
+  });
+}
+
+}  // namespace parallel
+}  // namespace mt_kahypar
@@ -115,5 +115,26 @@ TEST(WorkContainer, WorkStealingWorks) {
   ASSERT_EQ(steals + own_pops, m);
 }
 
+TEST(WorkContainer, StealsFromThreadsOfTheSameLocalityGroupFirst) {
+  WorkContainer<int> cdc(4);
+  cdc.setLocalityGroups({ 0, 1, 0, 1 });
+  cdc.safe_push(1, 1);
+  cdc.safe_push(2, 2);
+
+  int stolen_element = -1;
+  ASSERT_TRUE(cdc.try_pop(stolen_element, 0));
+  ASSERT_EQ(2, stolen_element);
+  ASSERT_TRUE(cdc.try_pop(stolen_element, 0));
+  ASSERT_EQ(1, stolen_element);
+  ASSERT_FALSE(cdc.try_pop(stolen_element, 0));
+  ASSERT_TRUE(cdc.exhausted.load());
+
+  cdc.clear();
+  ASSERT_FALSE(cdc.exhausted.load());
+  cdc.safe_push(3, 3);
+  ASSERT_TRUE(cdc.try_pop(stolen_element, 0));
+  ASSERT_EQ(3, stolen_element);
+}
+
 }  // namespace parallel
 }  // namespace mt_kahypar
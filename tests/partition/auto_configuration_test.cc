@@ -0,0 +1,125 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include <cmath>
+
+#include "gmock/gmock.h"
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/auto_configuration.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+
+class AAutoConfiguration : public Test {
+ public:
+  AAutoConfiguration() :
+    hypergraph(HypergraphFactory::construct(7 , 4, { {0, 2}, {0, 1, 3, 4}, {3, 4, 6}, {2, 5, 6} })),
+    context() {
+    context.load_default_flow_preset();
+    context.partition.preset_type = PresetType::auto_preset;
+    context.partition.k = 2;
+    context.partition.mode = Mode::direct;
+    context.partition.verbose_output = false;
+    context.shared_memory.num_threads = 1;
+  }
+
+  InstanceFeatures largeInstance() const {
+    InstanceFeatures features;
+    features.num_nodes = 10000000;
+    features.num_edges = 10000000;
+    features.num_pins = 100000000;
+    features.k = 64;
+    return features;
+  }
+
+  Hypergraph hypergraph;
+  Context context;
+};
+
+TEST_F(AAutoConfiguration, ComputesInstanceFeatures) {
+  const InstanceFeatures features = computeInstanceFeatures(hypergraph, context);
+  ASSERT_EQ(7, features.num_nodes);
+  ASSERT_EQ(4, features.num_edges);
+  ASSERT_EQ(12, features.num_pins);
+  ASSERT_EQ(2, features.k);
+  ASSERT_FALSE(features.is_graph);
+  ASSERT_LT(0.0, features.node_degree_skew);
+  ASSERT_LT(0.0, features.edge_size_skew);
+}
+
+TEST_F(AAutoConfiguration, PredictsLongerRunningTimesForStrongerConfigurations) {
+  const InstanceFeatures features = largeInstance();
+  double last_time = 0.0;
+  for ( uint8_t i = 0; i <= static_cast<uint8_t>(AutoRefinementConfiguration::fm_and_flows); ++i ) {
+    const double time = predictRunningTime(features, static_cast<AutoRefinementConfiguration>(i), 1);
+    ASSERT_LT(last_time, time);
+    last_time = time;
+  }
+  ASSERT_GT(predictRunningTime(features, AutoRefinementConfiguration::fm, 1),
+            predictRunningTime(features, AutoRefinementConfiguration::fm, 16));
+}
+
+TEST_F(AAutoConfiguration, SelectsTheStrongestConfigurationWithoutTimeLimit) {
+  ASSERT_EQ(AutoRefinementConfiguration::fm_and_flows,
+            selectRefinementConfiguration(largeInstance(), 0, 1));
+}
+
+TEST_F(AAutoConfiguration, SelectsLabelPropagationIfNoConfigurationFitsIntoTheTimeLimit) {
+  ASSERT_EQ(AutoRefinementConfiguration::label_propagation,
+            selectRefinementConfiguration(largeInstance(), 1, 1));
+}
+
+TEST_F(AAutoConfiguration, SelectsAConfigurationThatFitsIntoTheTimeLimit) {
+  const InstanceFeatures features = largeInstance();
+  const double fm_time = predictRunningTime(features, AutoRefinementConfiguration::fm, 1);
+  const int time_limit = static_cast<int>(std::ceil(fm_time));
+  const AutoRefinementConfiguration config = selectRefinementConfiguration(features, time_limit, 1);
+  ASSERT_LE(predictRunningTime(features, config, 1), time_limit);
+  ASSERT_LE(static_cast<uint8_t>(AutoRefinementConfiguration::fm), static_cast<uint8_t>(config));
+}
+
+TEST_F(AAutoConfiguration, KeepsTheFlowPresetForSmallInstances) {
+  const FlowAlgorithm flow_algorithm = context.refinement.flows.algorithm;
+  const FMAlgorithm fm_algorithm = context.refinement.fm.algorithm;
+  apply_auto_configuration(hypergraph, context);
+  ASSERT_EQ(flow_algorithm, context.refinement.flows.algorithm);
+  ASSERT_EQ(fm_algorithm, context.refinement.fm.algorithm);
+}
+
+TEST_F(AAutoConfiguration, SwitchesToDeepMultilevelIfThereAreTooFewNodesPerBlock) {
+  apply_auto_configuration(hypergraph, context);
+  ASSERT_EQ(Mode::deep_multilevel, context.partition.mode);
+}
+
+TEST_F(AAutoConfiguration, DoesNotModifyOtherPresets) {
+  context.partition.preset_type = PresetType::default_flows;
+  apply_auto_configuration(hypergraph, context);
+  ASSERT_EQ(Mode::direct, context.partition.mode);
+}
+
+}  // namespace mt_kahypar
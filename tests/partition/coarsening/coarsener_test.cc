@@ -100,4 +100,184 @@ TEST_F(ACoarsener, ProjectsPartitionBackToOriginalHypergraph) {
   }
 }
 
+#ifndef USE_STRONG_PARTITIONER
+TEST_F(ACoarsener, ClustersUnmatchedLeavesOfAStarWithTwoHopCoarsening) {
+  auto coarsen_star = [&](const CoarseningAlgorithm algorithm) {
+    Hypergraph star = HypergraphFactory::construct(9, 8,
+      { { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { 0, 6 }, { 0, 7 }, { 0, 8 } });
+    context.coarsening.algorithm = algorithm;
+    context.coarsening.contraction_limit = 2;
+    context.coarsening.max_allowed_node_weight = 3;
+    UncoarseningData uncoarseningData(nlevel, star, context);
+    Coarsener coarsener(star, context, uncoarseningData);
+    doCoarsening(coarsener);
+    return coarsener.coarsestHypergraph().initialNumNodes();
+  };
+
+  // The cluster of the center reaches the maximum allowed node weight
+  // and all remaining leaves stay unmatched.
+  ASSERT_EQ(7, coarsen_star(CoarseningAlgorithm::multilevel_coarsener));
+  // Two-hop coarsening clusters the remaining leaves, since they
+  // share the same preferred neighbor.
+  ASSERT_EQ(3, coarsen_star(CoarseningAlgorithm::two_hop_multilevel_coarsener));
+}
+
+TEST_F(ACoarsener, DoesNotContractVerticesFixedToDifferentBlocks) {
+  auto coarsen_star = [&](const CoarseningAlgorithm algorithm) {
+    Hypergraph star = HypergraphFactory::construct(9, 8,
+      { { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { 0, 6 }, { 0, 7 }, { 0, 8 } });
+    for ( HypernodeID leaf = 1; leaf < 9; ++leaf ) {
+      star.fixToBlock(leaf, leaf % 2);
+    }
+    context.coarsening.algorithm = algorithm;
+    context.coarsening.contraction_limit = 2;
+    UncoarseningData uncoarseningData(nlevel, star, context);
+    Coarsener coarsener(star, context, uncoarseningData);
+    doCoarsening(coarsener);
+
+    // Contracting vertices fixed to different blocks fails
+    // when the fixed vertices are propagated to the coarse hypergraph
+    Hypergraph& coarsest = coarsener.coarsestHypergraph();
+    vec<HypernodeWeight> fixed_weight(2, 0);
+    for ( const HypernodeID& hn : coarsest.nodes() ) {
+      if ( coarsest.isFixed(hn) ) {
+        fixed_weight[coarsest.fixedVertexBlock(hn)] += coarsest.nodeWeight(hn);
+      }
+    }
+    ASSERT_GE(coarsest.initialNumNodes(), 2);
+    ASSERT_GE(fixed_weight[0], 4);
+    ASSERT_GE(fixed_weight[1], 4);
+  };
+
+  coarsen_star(CoarseningAlgorithm::multilevel_coarsener);
+  coarsen_star(CoarseningAlgorithm::two_hop_multilevel_coarsener);
+}
+
+TEST_F(ACoarsener, ContractsVerticesConnectedBySampledLargeHyperedges) {
+  auto coarsen_large_hyperedge = [&](const HypernodeID pin_sample_size) {
+    Hypergraph hg = HypergraphFactory::construct(8, 1, { { 0, 1, 2, 3, 4, 5, 6, 7 } });
+    context.partition.ignore_hyperedge_size_threshold = 4;
+    context.partition.large_hyperedge_pin_sample_size = pin_sample_size;
+    context.coarsening.contraction_limit = 2;
+    UncoarseningData uncoarseningData(nlevel, hg, context);
+    Coarsener coarsener(hg, context, uncoarseningData);
+    doCoarsening(coarsener);
+    return coarsener.coarsestHypergraph().initialNumNodes();
+  };
+
+  // Vertices are only connected by an ignored hyperedge
+  ASSERT_EQ(8, coarsen_large_hyperedge(0));
+  ASSERT_LT(coarsen_large_hyperedge(3), 8);
+}
+
+TEST_F(ACoarsener, ProjectsPartitionBackToOriginalHypergraphWithoutRefinementBudget) {
+  context.coarsening.contraction_limit = 4;
+  context.refinement.low_value_level_border_fraction = 1.0;
+  context.refinement.max_uncoarsening_time = 0.0;
+  context.refinement.label_propagation.algorithm = LabelPropagationAlgorithm::do_nothing;
+  context.refinement.fm.algorithm = FMAlgorithm::do_nothing;
+  context.refinement.flows.algorithm = FlowAlgorithm::do_nothing;
+  UncoarseningData uncoarseningData(nlevel, hypergraph, context);
+  Coarsener coarsener(hypergraph, context, uncoarseningData);
+  Uncoarsener uncoarsener(hypergraph, context, uncoarseningData);
+  context.type = ContextType::initial_partitioning;
+  doCoarsening(coarsener);
+  PartitionedHyperGraph& coarsest_partitioned_hypergraph =
+    coarsener.coarsestPartitionedHypergraph();
+  assignPartitionIDs(coarsest_partitioned_hypergraph);
+  PartitionedHyperGraph partitioned_hypergraph = uncoarsener.uncoarsen();
+  for ( const HypernodeID& hn : partitioned_hypergraph.nodes() ) {
+    PartitionID part_id = 0;
+    ASSERT_EQ(part_id, partitioned_hypergraph.partID(hn));
+  }
+}
+
+TEST_F(ACoarsener, AssignsConsecutiveCoarseVertexIDsToVerticesOfTheSameCommunity) {
+  context.coarsening.order_clusters_by_community = true;
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    hypergraph.setCommunityID(hn, 3 - hn / 4);
+  }
+  parallel::scalable_vector<HypernodeID> clustering(hypergraph.initialNumNodes());
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    clustering[hn] = hn - hn % 2;
+  }
+  UncoarseningData uncoarseningData(nlevel, hypergraph, context);
+  uncoarseningData.performMultilevelContraction(
+    std::move(clustering), std::chrono::high_resolution_clock::now());
+
+  const Level& level = uncoarseningData.hierarchy.back();
+  const Hypergraph& coarse_hg = level.contractedHypergraph();
+  ASSERT_EQ(8, coarse_hg.initialNumNodes());
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    const HypernodeID coarse_hn = level.mapToContractedHypergraph(hn);
+    ASSERT_EQ(hypergraph.communityID(hn), coarse_hg.communityID(coarse_hn));
+    ASSERT_EQ(2 * ( 3 - hn / 4 ) + ( hn % 4 ) / 2, coarse_hn);
+  }
+}
+
+TEST_F(ACoarsener, ContractsTheNextLevelFromTheSparsifiedHypergraph) {
+  context.coarsening.use_min_hash_sparsifier = true;
+  context.coarsening.min_hash_num_hash_functions = 1;
+  context.coarsening.min_hash_similarity_threshold = 0.7;
+  context.coarsening.similar_net_combiner_strategy = SimiliarNetCombinerStrategy::union_nets;
+  context.coarsening.contraction_limit = 1;
+  Hypergraph hg = HypergraphFactory::construct(8, 3,
+    { { 0, 1, 2, 3, 4, 5 }, { 0, 1, 2, 3, 4, 5, 6 }, { 6, 7 } });
+  parallel::scalable_vector<HypernodeID> clustering(hg.initialNumNodes());
+  for ( const HypernodeID& hn : hg.nodes() ) {
+    clustering[hn] = hn / 2;
+  }
+  UncoarseningData uncoarseningData(nlevel, hg, context);
+  uncoarseningData.performMultilevelContraction(
+    std::move(clustering), std::chrono::high_resolution_clock::now());
+
+  // The coarse nets {0, 1, 2} and {0, 1, 2, 3} are merged
+  Level& level = uncoarseningData.hierarchy.back();
+  ASSERT_EQ(4, level.contractedHypergraph().initialNumNodes());
+  ASSERT_EQ(2, level.contractedHypergraph().initialNumEdges());
+  ASSERT_EQ(4, level.coarseningHypergraph().initialNumNodes());
+  ASSERT_EQ(1, level.coarseningHypergraph().initialNumEdges());
+  ASSERT_EQ(2, level.coarseningHypergraph().edgeWeight(0));
+
+  parallel::scalable_vector<HypernodeID> next_clustering = { 0, 1, 2, 2 };
+  uncoarseningData.performMultilevelContraction(
+    std::move(next_clustering), std::chrono::high_resolution_clock::now());
+  const Hypergraph& coarsest_hg = uncoarseningData.hierarchy.back().contractedHypergraph();
+  ASSERT_EQ(3, coarsest_hg.initialNumNodes());
+  ASSERT_EQ(1, coarsest_hg.initialNumEdges());
+  ASSERT_EQ(2, coarsest_hg.edgeWeight(0));
+  ASSERT_EQ(4, uncoarseningData.hierarchy[0].contractedHypergraph().initialNumNodes());
+  ASSERT_EQ(2, uncoarseningData.hierarchy[0].contractedHypergraph().initialNumEdges());
+}
+#else
+TEST_F(ACoarsener, DecreasesNumberOfPinsWithBatchContractions) {
+  context.coarsening.contraction_limit = 4;
+  context.coarsening.nlevel_contraction_batch_size = 2;
+  UncoarseningData uncoarseningData(nlevel, hypergraph, context);
+  Coarsener coarsener(hypergraph, context, uncoarseningData);
+  decreasesNumberOfPins(coarsener, 6);
+}
+
+TEST_F(ACoarsener, ProjectsPartitionBackToOriginalHypergraphWithBatchContractions) {
+  context.coarsening.contraction_limit = 4;
+  context.coarsening.nlevel_contraction_batch_size = 2;
+  context.refinement.label_propagation.algorithm = LabelPropagationAlgorithm::do_nothing;
+  context.refinement.fm.algorithm = FMAlgorithm::do_nothing;
+  context.refinement.flows.algorithm = FlowAlgorithm::do_nothing;
+  UncoarseningData uncoarseningData(nlevel, hypergraph, context);
+  Coarsener coarsener(hypergraph, context, uncoarseningData);
+  Uncoarsener uncoarsener(hypergraph, context, uncoarseningData);
+  context.type = ContextType::initial_partitioning;
+  doCoarsening(coarsener);
+  PartitionedHyperGraph& coarsest_partitioned_hypergraph =
+    coarsener.coarsestPartitionedHypergraph();
+  assignPartitionIDs(coarsest_partitioned_hypergraph);
+  PartitionedHyperGraph partitioned_hypergraph = uncoarsener.uncoarsen();
+  for ( const HypernodeID& hn : partitioned_hypergraph.nodes() ) {
+    PartitionID part_id = 0;
+    ASSERT_EQ(part_id, partitioned_hypergraph.partID(hn));
+  }
+}
+#endif
+
 }  // namespace mt_kahypar
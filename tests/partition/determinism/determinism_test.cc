@@ -134,6 +134,38 @@ namespace mt_kahypar {
       }
     }
 
+    void performRepeatedCoarsening() {
+      Hypergraph first;
+      for (size_t i = 0; i < num_repetitions; ++i) {
+        UncoarseningData uncoarseningData(false, hypergraph, context);
+        DeterministicMultilevelCoarsener coarsener(hypergraph, context, uncoarseningData);
+        coarsener.coarsen();
+        if (i == 0) {
+          first = coarsener.coarsestHypergraph().copy();
+        } else {
+          const Hypergraph& other = coarsener.coarsestHypergraph();
+          ASSERT_EQ(other.initialNumNodes(), first.initialNumNodes());
+          ASSERT_EQ(other.initialNumEdges(), first.initialNumEdges());
+          ASSERT_EQ(other.initialNumPins(), first.initialNumPins());
+          vec<HyperedgeID> inets_first, inets_other;
+          for (HypernodeID u : first.nodes()) {
+            for (HyperedgeID e : first.incidentEdges(u)) inets_first.push_back(e);
+            for (HyperedgeID e : other.incidentEdges(u)) inets_other.push_back(e);
+            ASSERT_EQ(inets_first, inets_other);
+            inets_first.clear(); inets_other.clear();
+          }
+
+          vec<HypernodeID> pins_first, pins_other;
+          for (HyperedgeID e : first.edges()) {
+            for (HypernodeID v : first.pins(e)) pins_first.push_back(v);
+            for (HypernodeID v : other.pins(e)) pins_other.push_back(v);
+            ASSERT_EQ(pins_first, pins_other);
+            pins_first.clear(); pins_other.clear();
+          }
+        }
+      }
+    }
+
     Hypergraph hypergraph;
     PartitionedHypergraph partitioned_hypergraph;
     Context context;
@@ -165,35 +197,13 @@ namespace mt_kahypar {
   }
 
   TEST_F(DeterminismTest, Coarsening) {
-    Hypergraph first;
-    for (size_t i = 0; i < num_repetitions; ++i) {
-      UncoarseningData uncoarseningData(false, hypergraph, context);
-      DeterministicMultilevelCoarsener coarsener(hypergraph, context, uncoarseningData);
-      coarsener.coarsen();
-      if (i == 0) {
-        first = coarsener.coarsestHypergraph().copy();
-      } else {
-        const Hypergraph& other = coarsener.coarsestHypergraph();
-        ASSERT_EQ(other.initialNumNodes(), first.initialNumNodes());
-        ASSERT_EQ(other.initialNumEdges(), first.initialNumEdges());
-        ASSERT_EQ(other.initialNumPins(), first.initialNumPins());
-        vec<HyperedgeID> inets_first, inets_other;
-        for (HypernodeID u : first.nodes()) {
-          for (HyperedgeID e : first.incidentEdges(u)) inets_first.push_back(e);
-          for (HyperedgeID e : other.incidentEdges(u)) inets_other.push_back(e);
-          ASSERT_EQ(inets_first, inets_other);
-          inets_first.clear(); inets_other.clear();
-        }
+    performRepeatedCoarsening();
+  }
 
-        vec<HypernodeID> pins_first, pins_other;
-        for (HyperedgeID e : first.edges()) {
-          for (HypernodeID v : first.pins(e)) pins_first.push_back(v);
-          for (HypernodeID v : other.pins(e)) pins_other.push_back(v);
-          ASSERT_EQ(pins_first, pins_other);
-          pins_first.clear(); pins_other.clear();
-        }
-      }
-    }
+  TEST_F(DeterminismTest, CoarseningWithConflictResolution) {
+    context.coarsening.deterministic_conflict_resolution = true;
+    context.coarsening.num_sub_rounds_deterministic = 1;
+    performRepeatedCoarsening();
   }
 
   TEST_F(DeterminismTest, Refinement) {
@@ -32,6 +32,8 @@
 #include "mt-kahypar/partition/context.h"
 #include "mt-kahypar/partition/recursive_bipartitioning.h"
 #include "mt-kahypar/partition/deep_multilevel.h"
+#include "mt-kahypar/partition/streaming.h"
+#include "mt-kahypar/partition/multisection.h"
 
 using ::testing::Test;
 
@@ -118,6 +120,10 @@ class AInitialPartitionerTest : public Test {
         recursive_bipartitioning::partition(partitioned_hypergraph, context); break;
       case Mode::deep_multilevel:
         deep_multilevel::partition(partitioned_hypergraph, context); break;
+      case Mode::streaming:
+        streaming::partition(partitioned_hypergraph, context); break;
+      case Mode::multisection:
+        multisection::partition(partitioned_hypergraph, context); break;
       case Mode::direct:
       case Mode::UNDEFINED:
         ERR("Undefined initial partitioning algorithm.");
@@ -139,7 +145,11 @@ typedef ::testing::Types<TestConfig<Mode::deep_multilevel, 2>,
                          TestConfig<Mode::deep_multilevel, 4>,
                          TestConfig<Mode::recursive_bipartitioning, 2>,
                          TestConfig<Mode::recursive_bipartitioning, 3>,
-                         TestConfig<Mode::recursive_bipartitioning, 4> > TestConfigs;
+                         TestConfig<Mode::recursive_bipartitioning, 4>,
+                         TestConfig<Mode::streaming, 2>,
+                         TestConfig<Mode::streaming, 4>,
+                         TestConfig<Mode::multisection, 4>,
+                         TestConfig<Mode::multisection, 6> > TestConfigs;
 
 TYPED_TEST_CASE(AInitialPartitionerTest, TestConfigs);
 
@@ -59,6 +59,92 @@ class AInitialPartitioningDataContainer : public ds::HypergraphFixture<Hypergrap
   Context context;
 };
 
+TEST_F(AInitialPartitioningDataContainer, ProvidesFlatCopyOfTheIncidenceStructure) {
+  PartitionedHypergraph partitioned_hypergraph(
+    context.partition.k, hypergraph);
+  InitialPartitioningDataContainer ip_data(
+    partitioned_hypergraph, context, true);
+  const CompactHypergraph& compact_hg = ip_data.compact_hypergraph();
+  ASSERT_TRUE(compact_hg.isInitialized());
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    std::vector<HyperedgeID> expected(hypergraph.incidentEdges(hn).begin(),
+                                      hypergraph.incidentEdges(hn).end());
+    std::vector<HyperedgeID> actual(compact_hg.incidentEdges(hn).begin(),
+                                    compact_hg.incidentEdges(hn).end());
+    ASSERT_EQ(expected, actual);
+  }
+  for ( const HyperedgeID& he : hypergraph.edges() ) {
+    std::vector<HypernodeID> expected(hypergraph.pins(he).begin(),
+                                      hypergraph.pins(he).end());
+    std::vector<HypernodeID> actual(compact_hg.pins(he).begin(),
+                                    compact_hg.pins(he).end());
+    ASSERT_EQ(expected, actual);
+  }
+}
+
+TEST_F(AInitialPartitioningDataContainer, DoesNotStorePinsOfLargeHyperedgesInFlatCopy) {
+  context.partition.ignore_hyperedge_size_threshold = 3;
+  PartitionedHypergraph partitioned_hypergraph(
+    context.partition.k, hypergraph);
+  InitialPartitioningDataContainer ip_data(
+    partitioned_hypergraph, context, true);
+  const CompactHypergraph& compact_hg = ip_data.compact_hypergraph();
+  ASSERT_TRUE(compact_hg.isInitialized());
+  ASSERT_TRUE(compact_hg.pins(1).empty());
+  ASSERT_FALSE(compact_hg.pins(2).empty());
+}
+
+TEST_F(AInitialPartitioningDataContainer, AssignsHeavyVerticesWithLPTBinPacking) {
+  hypergraph.setNodeWeight(0, 5);
+  hypergraph.setNodeWeight(1, 4);
+  hypergraph.setNodeWeight(2, 3);
+  // Max Part Weight = 9
+  context.setupPartWeights(16);
+  context.initial_partitioning.heavy_vertex_weight_fraction = 0.3;
+  PartitionedHypergraph partitioned_hypergraph(
+    context.partition.k, hypergraph);
+  InitialPartitioningDataContainer ip_data(
+    partitioned_hypergraph, context, true);
+
+  using HeavyVertex = std::pair<HypernodeID, PartitionID>;
+  const auto& heavy_vertices = ip_data.heavy_vertex_assignment().nodes;
+  ASSERT_EQ(3, heavy_vertices.size());
+  ASSERT_EQ(HeavyVertex(0, 0), heavy_vertices[0]);
+  ASSERT_EQ(HeavyVertex(1, 1), heavy_vertices[1]);
+  ASSERT_EQ(HeavyVertex(2, 1), heavy_vertices[2]);
+  ASSERT_TRUE(ip_data.is_heavy_vertex(2));
+  ASSERT_FALSE(ip_data.is_heavy_vertex(3));
+}
+
+TEST_F(AInitialPartitioningDataContainer, DoesNotAssignHeavyVerticesIfDisabled) {
+  hypergraph.setNodeWeight(0, 5);
+  context.setupPartWeights(11);
+  PartitionedHypergraph partitioned_hypergraph(
+    context.partition.k, hypergraph);
+  InitialPartitioningDataContainer ip_data(
+    partitioned_hypergraph, context, true);
+  ASSERT_TRUE(ip_data.heavy_vertex_assignment().nodes.empty());
+  ASSERT_FALSE(ip_data.is_heavy_vertex(0));
+}
+
+TEST_F(AInitialPartitioningDataContainer, SkipsHeavyVerticesWhenReturningAnUnassignedHypernode) {
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    if ( hn != 3 ) {
+      hypergraph.setNodeWeight(hn, 5);
+    }
+  }
+  // Max Part Weight = 19
+  context.setupPartWeights(31);
+  context.initial_partitioning.heavy_vertex_weight_fraction = 0.1;
+  PartitionedHypergraph partitioned_hypergraph(
+    context.partition.k, hypergraph);
+  InitialPartitioningDataContainer ip_data(
+    partitioned_hypergraph, context, true);
+  std::mt19937 prng(420);
+  ip_data.reset_unassigned_hypernodes(prng);
+  ASSERT_EQ(3, ip_data.get_unassigned_hypernode(kInvalidPartition, true));
+}
+
 TEST_F(AInitialPartitioningDataContainer, ReturnsAnUnassignedLocalHypernode1) {
   PartitionedHypergraph partitioned_hypergraph(
     context.partition.k, hypergraph);
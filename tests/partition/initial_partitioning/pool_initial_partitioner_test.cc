@@ -27,6 +27,7 @@
 #include "gmock/gmock.h"
 
 #include <atomic>
+#include <thread>
 
 #include "tbb/parallel_invoke.h"
 
@@ -120,5 +121,18 @@ TYPED_TEST(APoolInitialPartitionerTest, HasNoSignificantLowPartitionWeights) {
   }
 }
 
+TYPED_TEST(APoolInitialPartitionerTest, HasValidImbalanceWithRacingScheduler) {
+  this->context.initial_partitioning.use_adaptive_ip_runs = true;
+  this->context.initial_partitioning.min_adaptive_ip_runs = 1;
+  this->context.initial_partitioning.use_ip_racing_scheduler = true;
+  this->context.shared_memory.num_threads = std::thread::hardware_concurrency();
+  pool::bipartition(this->partitioned_hypergraph, this->context);
+
+  for ( const HypernodeID& hn : this->partitioned_hypergraph.nodes() ) {
+    ASSERT_NE(this->partitioned_hypergraph.partID(hn), -1);
+  }
+  ASSERT_LE(metrics::imbalance(this->partitioned_hypergraph, this->context),
+            this->context.partition.epsilon);
+}
 
 }  // namespace mt_kahypar
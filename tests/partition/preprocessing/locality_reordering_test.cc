@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include <algorithm>
+
+#include "gmock/gmock.h"
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/metrics.h"
+#include "mt-kahypar/partition/preprocessing/locality_reordering.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+
+class ALocalityReordering : public Test {
+
+ public:
+  // The vertices form the path 3 - 0 - 4 - 1 - 5 - 2
+  ALocalityReordering() :
+    hypergraph(HypergraphFactory::construct(6, 5,
+      { {3, 0}, {0, 4}, {4, 1}, {1, 5}, {5, 2} })) {
+    for ( const HyperedgeID& he : hypergraph.edges() ) {
+      hypergraph.setEdgeWeight(he, he + 1);
+    }
+  }
+
+  vec<HypernodeID> sortedPins(const Hypergraph& hg, const HyperedgeID he) const {
+    vec<HypernodeID> pins;
+    for ( const HypernodeID& pin : hg.pins(he) ) {
+      pins.push_back(pin);
+    }
+    std::sort(pins.begin(), pins.end());
+    return pins;
+  }
+
+  Hypergraph hypergraph;
+};
+
+TEST_F(ALocalityReordering, NumbersVerticesInBFSOrder) {
+  LocalityReordering reordering;
+  Hypergraph reordered_hypergraph = reordering.reorder(hypergraph);
+  ASSERT_EQ(hypergraph.initialNumNodes(), reordered_hypergraph.initialNumNodes());
+  ASSERT_EQ(hypergraph.initialNumEdges(), reordered_hypergraph.initialNumEdges());
+  ASSERT_EQ(hypergraph.initialNumPins(), reordered_hypergraph.initialNumPins());
+  // The BFS starts at vertex 2 (smallest degree and ID) and follows the path
+  ASSERT_EQ(vec<HypernodeID>({ 0, 1 }), sortedPins(reordered_hypergraph, 0));
+  ASSERT_EQ(vec<HypernodeID>({ 1, 2 }), sortedPins(reordered_hypergraph, 1));
+  ASSERT_EQ(vec<HypernodeID>({ 2, 3 }), sortedPins(reordered_hypergraph, 2));
+  ASSERT_EQ(vec<HypernodeID>({ 3, 4 }), sortedPins(reordered_hypergraph, 3));
+  ASSERT_EQ(vec<HypernodeID>({ 4, 5 }), sortedPins(reordered_hypergraph, 4));
+  // The nets are numbered in the order in which they are scanned
+  ASSERT_EQ(5, reordered_hypergraph.edgeWeight(0));
+  ASSERT_EQ(4, reordered_hypergraph.edgeWeight(1));
+  ASSERT_EQ(3, reordered_hypergraph.edgeWeight(2));
+  ASSERT_EQ(2, reordered_hypergraph.edgeWeight(3));
+  ASSERT_EQ(1, reordered_hypergraph.edgeWeight(4));
+}
+
+TEST_F(ALocalityReordering, RenumbersFixedVertices) {
+  hypergraph.fixToBlock(3, 1);
+  LocalityReordering reordering;
+  Hypergraph reordered_hypergraph = reordering.reorder(hypergraph);
+  ASSERT_EQ(1, reordered_hypergraph.fixedVertexSupport().numFixedVertices());
+  ASSERT_TRUE(reordered_hypergraph.isFixed(5));
+  ASSERT_EQ(1, reordered_hypergraph.fixedVertexBlock(5));
+}
+
+TEST_F(ALocalityReordering, MapsThePartitionBackOntoTheInputHypergraph) {
+  LocalityReordering reordering;
+  Hypergraph reordered_hypergraph = reordering.reorder(hypergraph);
+  PartitionedHypergraph reordered_phg(2, reordered_hypergraph);
+  for ( const HypernodeID& hn : reordered_hypergraph.nodes() ) {
+    reordered_phg.setNodePart(hn, hn < 3 ? 0 : 1);
+  }
+
+  PartitionedHypergraph phg = reordering.restorePartition(hypergraph, reordered_phg);
+  ASSERT_EQ(0, phg.partID(2));
+  ASSERT_EQ(0, phg.partID(5));
+  ASSERT_EQ(0, phg.partID(1));
+  ASSERT_EQ(1, phg.partID(4));
+  ASSERT_EQ(1, phg.partID(0));
+  ASSERT_EQ(1, phg.partID(3));
+  ASSERT_EQ(metrics::km1(reordered_phg), metrics::km1(phg));
+
+  vec<PartitionID> reordered_partition(reordered_phg.initialNumNodes());
+  reordered_phg.copyPartIDs(reordered_partition.data());
+  const vec<PartitionID> partition = reordering.restorePartition(reordered_partition);
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    ASSERT_EQ(phg.partID(hn), partition[hn]);
+  }
+}
+
+}  // namespace mt_kahypar
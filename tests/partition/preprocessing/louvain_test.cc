@@ -165,6 +165,16 @@ TEST_F(ALouvain, ComputesMaxGainMove10) {
   ASSERT_EQ(4, to);
 }
 
+TEST_F(ALouvain, ComputesMaxGainMoveOfHighDegreeVertex) {
+  ParallelLocalMovingModularity plm(context, graph->numNodes());
+  ds::Clustering communities = clustering( { 0, 1, 0, 2, 2, 0, 4, 1, 3, 3, 4 } );
+  plm.initializeClusterVolumes(*graph, communities);
+  for ( const NodeID u : graph->nodes() ) {
+    ASSERT_EQ(plm.computeMaxGainCluster(*graph, communities, u),
+              plm.computeMaxGainClusterOfHighDegreeVertex(*graph, communities, u));
+  }
+}
+
 TEST_F(ALouvain, KarateClubTest) {
     tbb::task_arena sequential_arena(1);
 #ifdef KAHYPAR_TRAVIS_BUILD
@@ -186,4 +196,21 @@ TEST_F(ALouvain, KarateClubTest) {
             metrics::modularity(*karate_club_graph, expected_comm));
 }
 
+TEST_F(ALouvain, KarateClubTestWithActiveSetPruningAndHighDegreeVertices) {
+  context.preprocessing.community_detection.use_active_set_pruning = true;
+  context.preprocessing.community_detection.high_degree_vertex_threshold = 5;
+  ds::Clustering communities = run_parallel_louvain(*karate_club_graph, context, false);
+  karate_club_graph = std::make_unique<Graph>(karate_club_hg, LouvainEdgeWeight::uniform, true);
+  ASSERT_GE(metrics::modularity(*karate_club_graph, communities), 0.35);
+}
+
+TEST_F(ALouvain, ComputesSameCommunitiesOnStarExpansionView) {
+  context.partition.deterministic = true;
+  context.preprocessing.community_detection.low_memory_contraction = true;
+  ds::StarExpansionView view(hypergraph, LouvainEdgeWeight::uniform);
+  ds::Clustering view_communities = run_parallel_louvain(view, context);
+  ds::Clustering graph_communities = run_parallel_louvain(*graph, context);
+  ASSERT_EQ(graph_communities, view_communities);
+}
+
 }  // namespace mt_kahypar
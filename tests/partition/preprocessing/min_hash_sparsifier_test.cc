@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "gmock/gmock.h"
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/metrics.h"
+#include "mt-kahypar/partition/preprocessing/sparsification/min_hash_sparsifier.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+
+class AMinHashSparsifier : public Test {
+
+ public:
+  AMinHashSparsifier() :
+    hypergraph(HypergraphFactory::construct(8, 5,
+      { {0, 1, 2, 3}, {0, 1, 2, 3}, {4, 5, 6}, {4, 5, 6, 7}, {0, 7} },
+      std::vector<HyperedgeWeight>({ 1, 2, 1, 3, 1 }).data())),
+    sparsified_hypergraph(),
+    context() {
+    context.coarsening.min_hash_num_hash_functions = 1;
+    context.coarsening.min_hash_similarity_threshold = 0.75;
+    context.coarsening.similar_net_combiner_strategy = SimiliarNetCombinerStrategy::union_nets;
+  }
+
+  vec<HypernodeID> sortedPins(const HyperedgeID he) {
+    vec<HypernodeID> pins;
+    for ( const HypernodeID& pin : sparsified_hypergraph.pins(he) ) {
+      pins.push_back(pin);
+    }
+    std::sort(pins.begin(), pins.end());
+    return pins;
+  }
+
+  Hypergraph hypergraph;
+  Hypergraph sparsified_hypergraph;
+  Context context;
+};
+
+TEST_F(AMinHashSparsifier, MergesIdenticalNets) {
+  context.coarsening.min_hash_num_hash_functions = 4;
+  context.coarsening.min_hash_similarity_threshold = 1.0;
+  MinHashSparsifier sparsifier(context);
+  ASSERT_EQ(1, sparsifier.sparsify(hypergraph, sparsified_hypergraph));
+  ASSERT_EQ(hypergraph.initialNumNodes(), sparsified_hypergraph.initialNumNodes());
+  ASSERT_EQ(4, sparsified_hypergraph.initialNumEdges());
+  ASSERT_EQ(3, sparsified_hypergraph.edgeWeight(0));
+  ASSERT_EQ(vec<HypernodeID>({ 0, 1, 2, 3 }), sortedPins(0));
+}
+
+TEST_F(AMinHashSparsifier, DoesNotMergeNetsBelowTheSimilarityThreshold) {
+  context.coarsening.min_hash_similarity_threshold = 0.8;
+  MinHashSparsifier sparsifier(context);
+  // The Jaccard similarity of {4, 5, 6} and {4, 5, 6, 7} is 0.75
+  ASSERT_EQ(1, sparsifier.sparsify(hypergraph, sparsified_hypergraph));
+  ASSERT_EQ(4, sparsified_hypergraph.initialNumEdges());
+}
+
+TEST_F(AMinHashSparsifier, CombinesSimilarNetsWithUnionStrategy) {
+  context.coarsening.min_hash_similarity_threshold = 0.7;
+  hypergraph = HypergraphFactory::construct(8, 3,
+    { {0, 1, 2, 3, 4, 5}, {0, 1, 2, 3, 4, 6}, {6, 7} },
+    std::vector<HyperedgeWeight>({ 1, 2, 1 }).data());
+  MinHashSparsifier sparsifier(context);
+  ASSERT_EQ(1, sparsifier.sparsify(hypergraph, sparsified_hypergraph));
+  ASSERT_EQ(2, sparsified_hypergraph.initialNumEdges());
+  ASSERT_EQ(3, sparsified_hypergraph.edgeWeight(0));
+  ASSERT_EQ(vec<HypernodeID>({ 0, 1, 2, 3, 4, 5, 6 }), sortedPins(0));
+}
+
+TEST_F(AMinHashSparsifier, CombinesSimilarNetsWithMaxSizeStrategy) {
+  context.coarsening.min_hash_num_hash_functions = 4;
+  context.coarsening.min_hash_similarity_threshold = 0.5;
+  context.coarsening.similar_net_combiner_strategy = SimiliarNetCombinerStrategy::max_size;
+  hypergraph = HypergraphFactory::construct(8, 3,
+    { {0, 1, 2, 3, 4}, {0, 1, 2, 3, 4, 5}, {6, 7} });
+  MinHashSparsifier sparsifier(context);
+  ASSERT_EQ(1, sparsifier.sparsify(hypergraph, sparsified_hypergraph));
+  ASSERT_EQ(2, sparsified_hypergraph.initialNumEdges());
+  ASSERT_EQ(2, sparsified_hypergraph.edgeWeight(0));
+  ASSERT_EQ(vec<HypernodeID>({ 0, 1, 2, 3, 4, 5 }), sortedPins(0));
+}
+
+TEST_F(AMinHashSparsifier, CombinesSimilarNetsWithImportanceStrategy) {
+  context.coarsening.min_hash_num_hash_functions = 4;
+  context.coarsening.min_hash_similarity_threshold = 1.0;
+  context.coarsening.similar_net_combiner_strategy = SimiliarNetCombinerStrategy::importance;
+  MinHashSparsifier sparsifier(context);
+  ASSERT_EQ(1, sparsifier.sparsify(hypergraph, sparsified_hypergraph));
+  ASSERT_EQ(vec<HypernodeID>({ 0, 1, 2, 3 }), sortedPins(0));
+}
+
+TEST_F(AMinHashSparsifier, KeepsVertexWeightsAndCommunities) {
+  context.coarsening.min_hash_num_hash_functions = 4;
+  context.coarsening.min_hash_similarity_threshold = 1.0;
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    hypergraph.setNodeWeight(hn, hn + 1);
+    hypergraph.setCommunityID(hn, hn / 2);
+  }
+  hypergraph.computeAndSetTotalNodeWeight(parallel_tag_t());
+  MinHashSparsifier sparsifier(context);
+  ASSERT_EQ(1, sparsifier.sparsify(hypergraph, sparsified_hypergraph));
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    ASSERT_EQ(hypergraph.nodeWeight(hn), sparsified_hypergraph.nodeWeight(hn));
+    ASSERT_EQ(hypergraph.communityID(hn), sparsified_hypergraph.communityID(hn));
+  }
+  ASSERT_EQ(hypergraph.totalWeight(), sparsified_hypergraph.totalWeight());
+}
+
+}  // namespace mt_kahypar
@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include "gmock/gmock.h"
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/metrics.h"
+#include "mt-kahypar/partition/preprocessing/sparsification/twin_vertex_remover.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+
+class ATwinVertexRemover : public Test {
+
+ public:
+  ATwinVertexRemover() :
+    hypergraph(HypergraphFactory::construct(8, 5,
+      { {0, 1, 2, 3}, {0, 1, 4}, {2, 3, 5}, {4, 5, 6, 7}, {6, 7} })),
+    reduced_hypergraph(),
+    context() {
+    context.partition.k = 2;
+    context.coarsening.max_allowed_node_weight = 2;
+  }
+
+  Hypergraph hypergraph;
+  Hypergraph reduced_hypergraph;
+  Context context;
+};
+
+TEST_F(ATwinVertexRemover, MergesVerticesWithIdenticalIncidentNets) {
+  TwinVertexRemover remover(context);
+  ASSERT_EQ(3, remover.removeTwinVertices(hypergraph, reduced_hypergraph));
+  ASSERT_EQ(5, reduced_hypergraph.initialNumNodes());
+  ASSERT_EQ(hypergraph.totalWeight(), reduced_hypergraph.totalWeight());
+  // Net {6, 7} becomes a single-pin net
+  ASSERT_EQ(4, reduced_hypergraph.initialNumEdges());
+}
+
+TEST_F(ATwinVertexRemover, RespectsTheMaximumAllowedNodeWeight) {
+  context.coarsening.max_allowed_node_weight = 1;
+  TwinVertexRemover remover(context);
+  ASSERT_EQ(0, remover.removeTwinVertices(hypergraph, reduced_hypergraph));
+}
+
+TEST_F(ATwinVertexRemover, DoesNotMergeFixedVertices) {
+  hypergraph.fixToBlock(0, 0);
+  hypergraph.fixToBlock(6, 1);
+  TwinVertexRemover remover(context);
+  ASSERT_EQ(1, remover.removeTwinVertices(hypergraph, reduced_hypergraph));
+  ASSERT_EQ(7, reduced_hypergraph.initialNumNodes());
+}
+
+TEST_F(ATwinVertexRemover, ProjectsThePartitionOfTheReducedHypergraph) {
+  TwinVertexRemover remover(context);
+  ASSERT_EQ(3, remover.removeTwinVertices(hypergraph, reduced_hypergraph));
+  PartitionedHypergraph reduced_phg(context.partition.k, reduced_hypergraph);
+  for ( const HypernodeID& hn : reduced_hypergraph.nodes() ) {
+    reduced_phg.setNodePart(hn, hn % 2);
+  }
+
+  PartitionedHypergraph phg = remover.restoreTwinVertices(hypergraph, reduced_phg);
+  ASSERT_EQ(phg.partID(0), phg.partID(1));
+  ASSERT_EQ(phg.partID(2), phg.partID(3));
+  ASSERT_EQ(phg.partID(6), phg.partID(7));
+  ASSERT_EQ(reduced_phg.partWeight(0), phg.partWeight(0));
+  ASSERT_EQ(reduced_phg.partWeight(1), phg.partWeight(1));
+  ASSERT_EQ(metrics::km1(reduced_phg), metrics::km1(phg));
+}
+
+}  // namespace mt_kahypar
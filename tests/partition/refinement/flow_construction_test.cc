@@ -395,4 +395,49 @@ TYPED_TEST(AFlowHypergraphConstructor, ConstructsAFlowHypergraphWithAllHypernode
   verifyFlowProblemStats(expected_prob, actual_prob);
 }
 
+TYPED_TEST(AFlowHypergraphConstructor, ConstructsAFlowHypergraphWithReorderedNodes) {
+  this->context.refinement.flows.reorder_nodes = true;
+  Subhypergraph sub_hg { 0, 1, {0, 1, 2, 3}, {4, 5, 6, 7}, 0, 0, {}, 0 };
+  constructSubhypergraph(this->phg, sub_hg);
+
+  FlowProblem actual_prob = this->constructor->constructFlowHypergraph(
+    this->phg, sub_hg, 0, 1, this->whfc_to_node, this->is_default_construction());
+  FlowProblem expected_prob { NODE(0), NODE(5), 0, 0, 4, 4 };
+  verifyFlowProblemStats(expected_prob, actual_prob);
+
+  // Each node must be mapped to a different hypernode with the same weight
+  vec<bool> contained(this->phg.initialNumNodes(), false);
+  for ( const whfc::Node& u : this->flow_hg.nodeIDs() ) {
+    const HypernodeID hn = this->whfc_to_node[u];
+    if ( u == actual_prob.source || u == actual_prob.sink ) {
+      ASSERT_EQ(kInvalidHypernode, hn);
+    } else {
+      ASSERT_NE(kInvalidHypernode, hn);
+      ASSERT_FALSE(contained[hn]);
+      contained[hn] = true;
+      ASSERT_EQ(this->phg.nodeWeight(hn), this->flow_hg.nodeWeight(u));
+    }
+  }
+
+  // The pins of each hyperedge must be pins of the same hyperedge in the original hypergraph
+  for ( const whfc::Hyperedge& e : this->flow_hg.hyperedgeIDs() ) {
+    bool found = false;
+    for ( const HyperedgeID& he : this->phg.edges() ) {
+      bool contains_all_pins = true;
+      for ( const auto& p : this->flow_hg.pinsOf(e) ) {
+        const HypernodeID hn = this->whfc_to_node[p.pin];
+        if ( hn != kInvalidHypernode ) {
+          bool is_pin = false;
+          for ( const HypernodeID& pin : this->phg.pins(he) ) {
+            is_pin |= pin == hn;
+          }
+          contains_all_pins &= is_pin;
+        }
+      }
+      found |= contains_all_pins;
+    }
+    ASSERT_TRUE(found);
+  }
+}
+
 }
\ No newline at end of file
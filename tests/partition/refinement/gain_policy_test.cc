@@ -225,6 +225,17 @@ TEST_F(AKm1PolicyK4, ComputesCorrectMoveGainForVertex3) {
   ASSERT_EQ(0, move.gain);
 }
 
+TEST_F(AKm1PolicyK4, ComputesSameMoveGainsInParallel) {
+  assignPartitionIDs({ 0, 1, 2, 3, 3, 1, 2 });
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    const Move move = gain->computeMaxGainMove(hypergraph, hn);
+    const Move parallel_move = gain->computeMaxGainMoveInParallel(hypergraph, hn);
+    ASSERT_EQ(move.from, parallel_move.from);
+    ASSERT_EQ(move.to, parallel_move.to);
+    ASSERT_EQ(move.gain, parallel_move.gain);
+  }
+}
+
 using ACutPolicyK4 = AGainPolicy<CutPolicy, 4>;
 
 TEST_F(ACutPolicyK4, ComputesCorrectMoveGainForVertex1) {
@@ -278,4 +289,15 @@ TEST_F(ACutPolicyK4, ComputesCorrectMoveGainForVertex3) {
   ASSERT_EQ(2, move.to);
   ASSERT_EQ(0, move.gain);
 }
+
+TEST_F(ACutPolicyK4, ComputesSameMoveGainsInParallel) {
+  assignPartitionIDs({ 0, 3, 1, 2, 2, 0, 3 });
+  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+    const Move move = gain->computeMaxGainMove(hypergraph, hn);
+    const Move parallel_move = gain->computeMaxGainMoveInParallel(hypergraph, hn);
+    ASSERT_EQ(move.from, parallel_move.from);
+    ASSERT_EQ(move.to, parallel_move.to);
+    ASSERT_EQ(move.gain, parallel_move.gain);
+  }
+}
 }  // namespace mt_kahypar
@@ -147,4 +147,20 @@ namespace mt_kahypar {
     ASSERT_EQ(3, to);
     ASSERT_EQ(0, g);
   }
+
+
+  using Km1GainsK64 = GainComputerTest<64>;
+
+  TEST_F(Km1GainsK64, ComputesCorrectMoveGainForVertex) {
+    assignPartitionIDs({0, 63, 1, 40, 40, 0, 63});
+    auto [to, g] = gain->computeBestTargetBlock(phg, 6, context.partition.max_part_weights);
+
+    gain->computeGains(phg, 6);
+    ASSERT_EQ(gain->gains[0], 1);
+    ASSERT_EQ(gain->gains[1], 1);
+    ASSERT_EQ(gain->gains[40], 1);
+    ASSERT_EQ(gain->gains[2], 0);
+    ASSERT_EQ(1, to); // block 1 is lighter than block 0
+    ASSERT_EQ(1, g);
+  }
 } // namespace
\ No newline at end of file
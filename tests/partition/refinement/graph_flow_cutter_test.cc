@@ -0,0 +1,89 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "gmock/gmock.h"
+
+#include "mt-kahypar/partition/refinement/flows/graph_flow_cutter.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+
+class AGraphFlowCutter : public Test {
+ public:
+  using NodeID = GraphFlowCutter::NodeID;
+
+  AGraphFlowCutter() :
+    flow_graph() {
+    // Source - 2 - 3 - 4 - 5 - Sink with a heavy edge between 3 and 4
+    flow_graph.clear();
+    for ( NodeID u = 2; u < 6; ++u ) {
+      flow_graph.addNode(1);
+    }
+    flow_graph.addEdge(GraphFlowCutter::source, 2, 5);
+    flow_graph.addEdge(2, 3, 2);
+    flow_graph.addEdge(3, 4, 4);
+    flow_graph.addEdge(4, 5, 2);
+    flow_graph.addEdge(5, GraphFlowCutter::sink, 5);
+    // Parallel path 2 - 5
+    flow_graph.addEdge(2, 5, 1);
+    flow_graph.finalize();
+  }
+
+  GraphFlowCutter flow_graph;
+};
+
+TEST_F(AGraphFlowCutter, ComputesAMinimumCut) {
+  const bool success = flow_graph.computeBalancedCut(6, 6, 10, [] { return true; });
+  ASSERT_TRUE(success);
+  ASSERT_EQ(3, flow_graph.flowValue());
+  ASSERT_TRUE(flow_graph.isSource(GraphFlowCutter::source));
+  ASSERT_FALSE(flow_graph.isSource(GraphFlowCutter::sink));
+  ASSERT_TRUE(flow_graph.isSource(2));
+  ASSERT_FALSE(flow_graph.isSource(5));
+}
+
+TEST_F(AGraphFlowCutter, PiercesNodesToComputeABalancedCut) {
+  // Minimum cut [source, 2, 3] vs [4, 5, sink] => both sides have weight 2
+  flow_graph.setNodeWeight(GraphFlowCutter::source, 0);
+  flow_graph.setNodeWeight(GraphFlowCutter::sink, 0);
+  const bool success = flow_graph.computeBalancedCut(2, 2, 10, [] { return true; });
+  ASSERT_TRUE(success);
+  ASSERT_EQ(2, flow_graph.sourceWeight());
+  ASSERT_EQ(2, flow_graph.sinkWeight());
+  ASSERT_TRUE(flow_graph.isSource(2));
+  ASSERT_TRUE(flow_graph.isSource(3));
+  ASSERT_FALSE(flow_graph.isSource(4));
+  ASSERT_FALSE(flow_graph.isSource(5));
+}
+
+TEST_F(AGraphFlowCutter, FailsIfFlowExceedsFlowBound) {
+  const bool success = flow_graph.computeBalancedCut(6, 6, 2, [] { return true; });
+  ASSERT_FALSE(success);
+}
+
+}  // namespace mt_kahypar
@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+
+#include "gmock/gmock.h"
+
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/refinement/policies/gain_policy.h"
+
+using ::testing::Test;
+
+namespace mt_kahypar {
+
+template <typename GainCalculator>
+class AGraphGainPolicy : public Test {
+ public:
+  AGraphGainPolicy() :
+    graph(),
+    partitioned_graph(),
+    context(),
+    gain(nullptr) {
+    const std::vector<HyperedgeWeight> edge_weights = { 1, 2, 3, 1, 1, 2 };
+    graph = HypergraphFactory::construct(6, 6,
+      { {0, 1}, {0, 2}, {0, 3}, {1, 2}, {3, 4}, {4, 5} }, edge_weights.data());
+    context.partition.k = 3;
+    context.partition.max_part_weights.assign(3, std::numeric_limits<HypernodeWeight>::max());
+    gain = std::make_unique<GainCalculator>(context, true  /* disable randomization */);
+    partitioned_graph = PartitionedHypergraph(3, graph);
+    HypernodeID hn = 0;
+    for ( const PartitionID block : { 0, 0, 1, 2, 2, 1 } ) {
+      partitioned_graph.setNodePart(hn++, block);
+    }
+  }
+
+  void verifyMove(const HypernodeID hn,
+                  const PartitionID expected_from,
+                  const PartitionID expected_to,
+                  const Gain expected_gain) {
+    Move move = gain->computeMaxGainMove(partitioned_graph, hn);
+    ASSERT_EQ(expected_from, move.from) << V(hn);
+    ASSERT_EQ(expected_to, move.to) << V(hn);
+    ASSERT_EQ(expected_gain, move.gain) << V(hn);
+  }
+
+  Hypergraph graph;
+  PartitionedHypergraph partitioned_graph;
+  Context context;
+  std::unique_ptr<GainCalculator> gain;
+};
+
+typedef ::testing::Types<Km1Policy<PartitionedHypergraph>,
+                         CutPolicy<PartitionedHypergraph>> TestConfigs;
+
+TYPED_TEST_CASE(AGraphGainPolicy, TestConfigs);
+
+TYPED_TEST(AGraphGainPolicy, ComputesCorrectMoveGainForVertex0) {
+  this->verifyMove(0, 0, 2, -2);
+}
+
+TYPED_TEST(AGraphGainPolicy, ComputesCorrectMoveGainForVertex1) {
+  this->verifyMove(1, 0, 0, 0);
+}
+
+TYPED_TEST(AGraphGainPolicy, ComputesCorrectMoveGainForVertex4) {
+  this->verifyMove(4, 2, 1, -1);
+}
+
+TYPED_TEST(AGraphGainPolicy, ComputesCorrectMoveGainForVertex5) {
+  this->verifyMove(5, 1, 2, -2);
+}
+
+TYPED_TEST(AGraphGainPolicy, ResetsScoresAfterComputingMoveGain) {
+  this->verifyMove(0, 0, 2, -2);
+  this->verifyMove(0, 0, 2, -2);
+  this->verifyMove(5, 1, 2, -2);
+}
+
+}  // namespace mt_kahypar
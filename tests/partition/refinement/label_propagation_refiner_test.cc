@@ -200,4 +200,44 @@ TYPED_TEST(ALabelPropagationRefiner, IncreasesTheNumberOfBlocks) {
   ASSERT_TRUE(has_moved_nodes);
 }
 
+TYPED_TEST(ALabelPropagationRefiner, UpdatesMetricsCorrectlyWithDenseFrontiers) {
+  // Each round after the first collects its active nodes from the activation bitmap
+  this->context.refinement.label_propagation.maximum_iterations = 5;
+  this->context.refinement.label_propagation.dense_frontier_threshold = 0.0;
+  this->refiner = std::make_unique<typename TypeParam::Refiner>(this->hypergraph, this->context);
+  this->refiner->initialize(this->partitioned_hypergraph);
+  HyperedgeWeight objective_before = metrics::objective(this->partitioned_hypergraph, this->context.partition.objective);
+  this->refiner->refine(this->partitioned_hypergraph, {}, this->metrics, std::numeric_limits<double>::max());
+  ASSERT_EQ(metrics::objective(this->partitioned_hypergraph, this->context.partition.objective),
+            this->metrics.getMetric(Mode::direct, this->context.partition.objective));
+  ASSERT_LE(this->metrics.getMetric(Mode::direct, this->context.partition.objective), objective_before);
+  ASSERT_LE(this->metrics.imbalance, this->context.partition.epsilon + EPS);
+}
+
+TYPED_TEST(ALabelPropagationRefiner, MaintainsGainCacheAndTracksMovedNodesIfFusedWithFM) {
+  this->context.refinement.fuse_lp_and_fm = true;
+  this->refiner = std::make_unique<typename TypeParam::Refiner>(this->hypergraph, this->context);
+  this->refiner->initialize(this->partitioned_hypergraph);
+  this->partitioned_hypergraph.allocateGainTableIfNecessary();
+  this->partitioned_hypergraph.initializeGainCache();
+  vec<PartitionID> partition_before(this->hypergraph.initialNumNodes(), kInvalidPartition);
+  for ( const HypernodeID hn : this->partitioned_hypergraph.nodes() ) {
+    partition_before[hn] = this->partitioned_hypergraph.partID(hn);
+  }
+
+  this->refiner->refine(this->partitioned_hypergraph, {}, this->metrics, std::numeric_limits<double>::max());
+  ASSERT_TRUE(this->partitioned_hypergraph.checkTrackedPartitionInformation());
+
+  vec<bool> is_tracked(this->hypergraph.initialNumNodes(), false);
+  for ( const HypernodeID hn : this->refiner->movedNodes() ) {
+    ASSERT_FALSE(is_tracked[hn]);
+    is_tracked[hn] = true;
+  }
+  for ( const HypernodeID hn : this->partitioned_hypergraph.nodes() ) {
+    if ( partition_before[hn] != this->partitioned_hypergraph.partID(hn) ) {
+      ASSERT_TRUE(is_tracked[hn]) << V(hn);
+    }
+  }
+}
+
 }  // namespace mt_kahypar
@@ -31,6 +31,7 @@
 
 #include "mt-kahypar/partition/refinement/fm/multitry_kway_fm.h"
 #include "mt-kahypar/partition/refinement/fm/strategies/gain_cache_strategy.h"
+#include "mt-kahypar/partition/refinement/fm/strategies/gain_cache_lazy_strategy.h"
 
 #include "mt-kahypar/partition/initial_partitioning/bfs_initial_partitioner.h"
 
@@ -140,6 +141,17 @@ class MultiTryFMTest : public ::testing::TestWithParam<PartitionID> {
     ASSERT_DOUBLE_EQ(metrics::imbalance(this->partitioned_hypergraph, this->context), this->metrics.imbalance);
   }
 
+  TEST_P(MultiTryFMTest, WorksWithSeedNodesOrderedByGain) {
+    context.refinement.fm.order_seeds_by_gain = true;
+    HyperedgeWeight objective_before = metrics::objective(this->partitioned_hypergraph, this->context.partition.objective);
+    this->refiner->refine(this->partitioned_hypergraph, {}, this->metrics, std::numeric_limits<double>::max());
+    ASSERT_LE(this->metrics.getMetric(Mode::direct, this->context.partition.objective), objective_before);
+    ASSERT_EQ(metrics::objective(this->partitioned_hypergraph, this->context.partition.objective),
+              this->metrics.getMetric(Mode::direct, this->context.partition.objective));
+    ASSERT_LE(this->metrics.imbalance, this->context.partition.epsilon);
+    ASSERT_DOUBLE_EQ(metrics::imbalance(this->partitioned_hypergraph, this->context), this->metrics.imbalance);
+  }
+
   TEST_P(MultiTryFMTest, WorksWithRefinementNodes) {
     parallel::scalable_vector<HypernodeID> refinement_nodes;
     for (HypernodeID u = 0; u < this->partitioned_hypergraph.initialNumNodes(); ++u) {
@@ -159,6 +171,34 @@ class MultiTryFMTest : public ::testing::TestWithParam<PartitionID> {
     std::cout.rdbuf(old);                                   // and reset again
   }
 
+  TEST_P(MultiTryFMTest, WorksWithLazyGainCacheInitialization) {
+    context.refinement.fm.algorithm = FMAlgorithm::fm_gain_cache_lazy;
+    PartitionedHypergraph phg(context.partition.k, hypergraph, parallel_tag_t());
+    this->partitioned_hypergraph.doParallelForAllNodes([&](const HypernodeID hn) {
+      phg.setOnlyNodePart(hn, this->partitioned_hypergraph.partID(hn));
+    });
+    phg.initializePartition();
+    MultiTryKWayFM<GainCacheLazyStrategy> lazy_refiner(hypergraph, context);
+    lazy_refiner.initialize(phg);
+
+    HyperedgeWeight objective_before = metrics::objective(phg, this->context.partition.objective);
+    lazy_refiner.refine(phg, {}, this->metrics, std::numeric_limits<double>::max());
+    ASSERT_LE(this->metrics.getMetric(Mode::direct, this->context.partition.objective), objective_before);
+    ASSERT_EQ(metrics::objective(phg, this->context.partition.objective),
+              this->metrics.getMetric(Mode::direct, this->context.partition.objective));
+    ASSERT_LE(this->metrics.imbalance, this->context.partition.epsilon);
+
+    // Valid gain cache entries must be exact
+    for ( const HypernodeID& hn : hypergraph.nodes() ) {
+      if ( phg.isGainCacheEntryValid(hn) ) {
+        ASSERT_EQ(phg.moveFromPenaltyRecomputed(hn), phg.moveFromPenalty(hn)) << V(hn);
+        for ( PartitionID block = 0; block < context.partition.k; ++block ) {
+          ASSERT_EQ(phg.moveToBenefitRecomputed(hn, block), phg.moveToBenefit(hn, block)) << V(hn) << V(block);
+        }
+      }
+    }
+  }
+
   TEST_P(MultiTryFMTest, IncreasesTheNumberOfBlocks) {
     HyperedgeWeight objective_before = metrics::objective(this->partitioned_hypergraph, this->context.partition.objective);
     this->refiner->refine(this->partitioned_hypergraph, {}, this->metrics, std::numeric_limits<double>::max());
@@ -159,6 +159,151 @@ TEST_F(AProblemConstruction, GrowAnFlowProblemAroundTwoBlocks2) {
   verifyThatPartWeightsAreLessEqualToMaxPartWeight(sub_hg, search_id, qg);
 }
 
+TEST_F(AProblemConstruction, GrowsTwoFlowProblemsConsecutivelyWithSameBFSData) {
+  ProblemConstruction constructor(hg, context);
+  FlowRefinerAdapter refiner(hg, context);
+  QuotientGraph qg(hg, context);
+  refiner.initialize(context.shared_memory.num_threads);
+  qg.initialize(phg);
+
+  max_part_weights.assign(context.partition.k, 400);
+  SearchID search_id = qg.requestNewSearch(refiner);
+  Subhypergraph sub_hg_1 = constructor.construct(search_id, qg, phg);
+  // Second construction only resets the entries touched by the first one
+  Subhypergraph sub_hg_2 = constructor.construct(search_id, qg, phg);
+
+  verifyThatPartWeightsAreLessEqualToMaxPartWeight(sub_hg_2, search_id, qg);
+  ASSERT_EQ(sub_hg_1.block_0, sub_hg_2.block_0);
+  ASSERT_EQ(sub_hg_1.block_1, sub_hg_2.block_1);
+  ASSERT_GT(sub_hg_2.nodes_of_block_0.size() + sub_hg_2.nodes_of_block_1.size(), 0);
+  std::set<HyperedgeID> contained_hes(sub_hg_2.hes.begin(), sub_hg_2.hes.end());
+  ASSERT_EQ(sub_hg_2.hes.size(), contained_hes.size());
+  for ( const vec<HypernodeID>& nodes : { sub_hg_2.nodes_of_block_0, sub_hg_2.nodes_of_block_1 } ) {
+    for ( const HypernodeID& hn : nodes ) {
+      for ( const HyperedgeID& he : phg.incidentEdges(hn) ) {
+        ASSERT_TRUE(contained_hes.count(he) > 0);
+      }
+    }
+  }
+}
+
+TEST_F(AProblemConstruction, GrowsAnFlowProblemAroundTwoBlocksWithParallelBFS) {
+  context.refinement.flows.min_num_pins_for_parallel_region_growing = 0;
+  ProblemConstruction constructor(hg, context);
+  FlowRefinerAdapter refiner(hg, context);
+  QuotientGraph qg(hg, context);
+  refiner.initialize(context.shared_memory.num_threads);
+  qg.initialize(phg);
+
+  max_part_weights.assign(context.partition.k, 400);
+  SearchID search_id = qg.requestNewSearch(refiner);
+  Subhypergraph sub_hg = constructor.construct(search_id, qg, phg);
+
+  verifyThatPartWeightsAreLessEqualToMaxPartWeight(sub_hg, search_id, qg);
+  ASSERT_GT(sub_hg.nodes_of_block_0.size() + sub_hg.nodes_of_block_1.size(), 0);
+  std::set<HypernodeID> contained_hns;
+  for ( const vec<HypernodeID>& nodes : { sub_hg.nodes_of_block_0, sub_hg.nodes_of_block_1 } ) {
+    for ( const HypernodeID& hn : nodes ) {
+      ASSERT_TRUE(contained_hns.insert(hn).second);
+    }
+  }
+  std::set<HyperedgeID> contained_hes(sub_hg.hes.begin(), sub_hg.hes.end());
+  ASSERT_EQ(sub_hg.hes.size(), contained_hes.size());
+  for ( const HypernodeID& hn : contained_hns ) {
+    for ( const HyperedgeID& he : phg.incidentEdges(hn) ) {
+      ASSERT_TRUE(contained_hes.count(he) > 0);
+    }
+  }
+}
+
+TEST_F(AProblemConstruction, GrowsFlowProblemsWithinAGlobalPinBudget) {
+  context.refinement.flows.max_num_pins_of_concurrent_searches = 1000;
+  context.refinement.flows.num_parallel_searches = 4;
+  ProblemConstruction constructor(hg, context);
+  FlowRefinerAdapter refiner(hg, context);
+  QuotientGraph qg(hg, context);
+  refiner.initialize(context.shared_memory.num_threads);
+  qg.initialize(phg);
+
+  HypernodeID max_degree = 0;
+  for ( const HypernodeID& hn : phg.nodes() ) {
+    max_degree = std::max(max_degree, phg.nodeDegree(hn));
+  }
+
+  // First search gets at most half of the budget
+  SearchID search_id = qg.requestNewSearch(refiner);
+  Subhypergraph sub_hg_1 = constructor.construct(search_id, qg, phg);
+  ASSERT_GT(sub_hg_1.numNodes(), 0);
+  ASSERT_LT(sub_hg_1.num_pins, 500 + max_degree);
+  ASSERT_EQ(sub_hg_1.num_pins, constructor.numReservedPins());
+
+  // Second search shrinks its flow problem to the remaining budget
+  Subhypergraph sub_hg_2 = constructor.construct(search_id, qg, phg);
+  ASSERT_GT(sub_hg_2.numNodes(), 0);
+  ASSERT_LT(sub_hg_2.num_pins, 1000 - sub_hg_1.num_pins + max_degree);
+  ASSERT_EQ(sub_hg_1.num_pins + sub_hg_2.num_pins, constructor.numReservedPins());
+
+  constructor.releasePins(sub_hg_1);
+  constructor.releasePins(sub_hg_2);
+  ASSERT_EQ(0, constructor.numReservedPins());
+}
+
+TEST_F(AProblemConstruction, GrowsAnFlowProblemAroundSeedVertices) {
+  context.refinement.flows.localized_max_bfs_distance = 1;
+  context.refinement.flows.alpha = 16;
+  ProblemConstruction constructor(hg, context);
+
+  // Seeds are the vertices of block 0 and 1 incident to a cut hyperedge between both blocks
+  const BlockPair blocks { 0, 1 };
+  vec<HypernodeID> seeds;
+  for ( const HypernodeID& hn : phg.nodes() ) {
+    const PartitionID block = phg.partID(hn);
+    if ( ( block == blocks.i || block == blocks.j ) && seeds.size() < 5 ) {
+      for ( const HyperedgeID& he : phg.incidentEdges(hn) ) {
+        if ( phg.pinCountInPart(he, blocks.i) > 0 && phg.pinCountInPart(he, blocks.j) > 0 ) {
+          seeds.push_back(hn);
+          break;
+        }
+      }
+    }
+  }
+  ASSERT_EQ(5, seeds.size());
+
+  Subhypergraph sub_hg = constructor.constructAroundSeeds(blocks, seeds, phg);
+  ASSERT_EQ(blocks.i, sub_hg.block_0);
+  ASSERT_EQ(blocks.j, sub_hg.block_1);
+  ASSERT_GT(sub_hg.nodes_of_block_0.size(), 0);
+  ASSERT_GT(sub_hg.nodes_of_block_1.size(), 0);
+  for ( const HypernodeID& hn : sub_hg.nodes_of_block_0 ) {
+    ASSERT_EQ(blocks.i, phg.partID(hn));
+  }
+  for ( const HypernodeID& hn : sub_hg.nodes_of_block_1 ) {
+    ASSERT_EQ(blocks.j, phg.partID(hn));
+  }
+
+  // All vertices are contained in a cut hyperedge incident to a seed
+  // vertex or in a hyperedge incident to such a vertex
+  std::set<HypernodeID> neighborhood;
+  for ( const HypernodeID& seed : seeds ) {
+    for ( const HyperedgeID& he : phg.incidentEdges(seed) ) {
+      if ( phg.pinCountInPart(he, blocks.i) > 0 && phg.pinCountInPart(he, blocks.j) > 0 ) {
+        for ( const HypernodeID& pin : phg.pins(he) ) {
+          for ( const HyperedgeID& incident_he : phg.incidentEdges(pin) ) {
+            for ( const HypernodeID& neighbor : phg.pins(incident_he) ) {
+              neighborhood.insert(neighbor);
+            }
+          }
+        }
+      }
+    }
+  }
+  for ( const vec<HypernodeID>& nodes : { sub_hg.nodes_of_block_0, sub_hg.nodes_of_block_1 } ) {
+    for ( const HypernodeID& hn : nodes ) {
+      ASSERT_TRUE(neighborhood.count(hn) > 0);
+    }
+  }
+}
+
 TEST_F(AProblemConstruction, GrowTwoFlowProblemAroundTwoBlocksSimultanously) {
   ProblemConstruction constructor(hg, context);
   FlowRefinerAdapter refiner(hg, context);
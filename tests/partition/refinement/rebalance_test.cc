@@ -108,4 +108,34 @@ TEST(RebalanceTests, FindsMoves) {
   ASSERT_EQ(moves_to_empty_blocks.size(), 0);
 }
 
-}
\ No newline at end of file
+TEST(RebalanceTests, RestoresBalanceOfHeavilyOverloadedBlock) {
+  PartitionID k = 4;
+  Context context;
+  context.partition.k = k;
+  context.partition.epsilon = 0.03;
+  context.partition.objective = Objective::km1;
+  Hypergraph hg = io::readHypergraphFile("../tests/instances/contracted_ibm01.hgr", true /* enable stable construction */);
+  context.setupPartWeights(hg.totalWeight());
+  PartitionedHypergraph phg = PartitionedHypergraph(k, hg);
+
+  // block 0 contains roughly 70% of the vertices
+  for (HypernodeID u = 0; u < hg.initialNumNodes(); ++u) {
+    phg.setOnlyNodePart(u, u % 10 < 7 ? 0 : 1 + static_cast<PartitionID>(u % 3));
+  }
+  phg.initializePartition();
+
+  Metrics metrics;
+  metrics.km1 = metrics::km1(phg);
+  metrics.cut = metrics::hyperedgeCut(phg);
+  metrics.imbalance = metrics::imbalance(phg, context);
+  ASSERT_FALSE(metrics::isBalanced(phg, context));
+
+  Km1Rebalancer rebalancer(phg, context);
+  rebalancer.rebalance(metrics);
+
+  ASSERT_TRUE(metrics::isBalanced(phg, context));
+  ASSERT_EQ(metrics::km1(phg), metrics.km1);
+  ASSERT_TRUE(phg.checkTrackedPartitionInformation());
+}
+
+}
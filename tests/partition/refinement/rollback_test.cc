@@ -149,6 +149,33 @@ TEST(RollbackTests, GainRecalculation2) {
   grb.verifyGains<true>(phg, sharedData);
 }
 
+TEST(RollbackTests, MoveTrackerForgetsMovesOfPreviousRounds) {
+  GlobalMoveTracker tracker(4);
+  Move m_0 = { 0, 1, 0, 5 };
+  Move m_1 = { 1, 0, 2, 3 };
+  ASSERT_EQ(1, tracker.insertMove(m_0));
+  ASSERT_EQ(2, tracker.insertMove(m_1));
+  ASSERT_EQ(2, tracker.numPerformedMoves());
+  ASSERT_TRUE(tracker.wasNodeMovedInThisRound(0));
+  ASSERT_TRUE(tracker.wasNodeMovedInThisRound(2));
+  ASSERT_EQ(2, tracker.moveIDOfNode(2));
+  ASSERT_EQ(2, tracker.getMove(tracker.moveIDOfNode(2)).node);
+  ASSERT_EQ(0, tracker.getMove(1).gain);
+
+  for ( size_t i = 0; i < 1000; ++i ) {
+    tracker.reset();
+  }
+  ASSERT_EQ(0, tracker.numPerformedMoves());
+  ASSERT_FALSE(tracker.wasNodeMovedInThisRound(0));
+  ASSERT_FALSE(tracker.wasNodeMovedInThisRound(2));
+
+  Move m_2 = { 1, 0, 3, 1 };
+  ASSERT_EQ(1, tracker.insertMove(m_2));
+  ASSERT_TRUE(tracker.wasNodeMovedInThisRound(3));
+  ASSERT_FALSE(tracker.wasNodeMovedInThisRound(0));
+  ASSERT_EQ(1, tracker.moveIDOfNode(3));
+}
+
 //#endif
 
 }   // namespace mt_kahypar
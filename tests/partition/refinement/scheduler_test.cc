@@ -146,6 +146,29 @@ TEST_F(AFlowRefinementScheduler, MovesAVertexThatViolatesBalanceConstraint) {
   verifyPartWeights(refiner.partWeights(), { 4, 3 });
 }
 
+TEST_F(AFlowRefinementScheduler, MovesVerticesWithParallelApplicationOfMoveSequences) {
+  context.refinement.flows.parallel_apply_moves = true;
+  FlowRefinementScheduler refiner(hg, context);
+  refiner.initialize(phg);
+  MoveSequence sequence_1 { { MOVE(5, 1, 0), MOVE(1, 0, 1), MOVE(3, 0, 1) }, 1 };
+  MoveSequence sequence_2 { { MOVE(0, 0, 1) }, 1 };
+
+  const HyperedgeWeight improvement_1 = refiner.applyMoves(
+    QuotientGraph::INVALID_SEARCH_ID, sequence_1);
+  ASSERT_EQ(sequence_1.state, MoveSequenceState::SUCCESS);
+  ASSERT_EQ(improvement_1, sequence_1.expected_improvement);
+  ASSERT_EQ(1, phg.partID(1));
+  ASSERT_EQ(1, phg.partID(3));
+  ASSERT_EQ(0, phg.partID(5));
+
+  const HyperedgeWeight improvement_2 = refiner.applyMoves(
+    QuotientGraph::INVALID_SEARCH_ID, sequence_2);
+  ASSERT_EQ(sequence_2.state, MoveSequenceState::VIOLATES_BALANCE_CONSTRAINT);
+  ASSERT_EQ(improvement_2, 0);
+  ASSERT_EQ(0, phg.partID(0));
+  verifyPartWeights(refiner.partWeights(), { 3, 4 });
+}
+
 TEST_F(AFlowRefinementScheduler, MovesTwoVerticesConcurrently) {
   context.partition.max_part_weights.assign(2, 5);
   FlowRefinementScheduler refiner(hg, context);
@@ -355,5 +378,32 @@ TEST_F(AFlowRefinementEndToEnd, SmokeTestWithFourBlocksPerRefiner) {
   }
 }
 
+TEST_F(AFlowRefinementEndToEnd, SmokeTestWithLocalizedRefinement) {
+  context.refinement.flows.localized_max_bfs_distance = 1;
+  context.refinement.flows.num_parallel_searches = context.shared_memory.num_threads;
+  FlowRefinementScheduler scheduler(hg, context);
+
+  Metrics metrics;
+  metrics.cut = metrics::hyperedgeCut(phg);
+  metrics.km1 = metrics::km1(phg);
+  metrics.imbalance = metrics::imbalance(phg, context);
+  const HyperedgeWeight km1_before = metrics.km1;
+
+  // Localized refinement does not require an initialized scheduler
+  vec<HypernodeID> refinement_nodes;
+  for ( const HypernodeID& hn : phg.nodes() ) {
+    if ( phg.isBorderNode(hn) && refinement_nodes.size() < 100 ) {
+      refinement_nodes.push_back(hn);
+    }
+  }
+  scheduler.refine(phg, refinement_nodes, metrics, 0.0);
 
-}
\ No newline at end of file
+  ASSERT_EQ(metrics::km1(phg), metrics.km1);
+  ASSERT_LE(metrics.km1, km1_before);
+  ASSERT_EQ(metrics::imbalance(phg, context), metrics.imbalance);
+  for ( PartitionID i = 0; i < context.partition.k; ++i ) {
+    ASSERT_LE(phg.partWeight(i), context.partition.max_part_weights[i]);
+  }
+}
+
+}
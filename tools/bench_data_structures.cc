@@ -0,0 +1,314 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "tbb/enumerable_thread_specific.h"
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/datastructures/connectivity_set.h"
+#include "mt-kahypar/datastructures/delta_partitioned_hypergraph.h"
+#include "mt-kahypar/datastructures/pin_count_in_part.h"
+#include "mt-kahypar/datastructures/priority_queue.h"
+#include "mt-kahypar/datastructures/sparse_map.h"
+
+using namespace mt_kahypar;
+
+/*!
+ * Micro benchmarks for the data structure operations that dominate our profiles.
+ * All benchmarks are parameterized by the number of blocks k, a degree parameter
+ * (see the individual benchmarks) and the number of threads. Each iteration
+ * performs a fixed number of operations in parallel inside a task arena with
+ * the given number of threads.
+ *
+ * Example: ./mt_kahypar_microbenchmarks --benchmark_filter=ChangeNodePart
+ */
+
+namespace {
+
+constexpr HypernodeID NUM_NODES = 100000;
+constexpr HypernodeID EDGE_SIZE = 8;
+constexpr int SEED = 42;
+
+// ! Random hypergraph where each hyperedge contains EDGE_SIZE random pins and the
+// ! expected degree of a node is avg_degree
+Hypergraph generateRandomHypergraph(const HypernodeID num_nodes,
+                                    const HyperedgeID avg_degree,
+                                    const HypernodeID edge_size) {
+  const HyperedgeID num_edges = static_cast<HyperedgeID>(num_nodes) * avg_degree / edge_size;
+  std::mt19937 rng(SEED);
+  std::uniform_int_distribution<HypernodeID> node_dist(0, num_nodes - 1);
+  vec<vec<HypernodeID>> edges(num_edges);
+  for ( vec<HypernodeID>& pins : edges ) {
+    while ( pins.size() < edge_size ) {
+      const HypernodeID pin = node_dist(rng);
+      if ( std::find(pins.begin(), pins.end(), pin) == pins.end() ) {
+        pins.push_back(pin);
+      }
+    }
+  }
+  return HypergraphFactory::construct(num_nodes, num_edges, edges);
+}
+
+void assignRandomPartition(PartitionedHypergraph& phg, const PartitionID k) {
+  std::mt19937 rng(SEED);
+  std::uniform_int_distribution<PartitionID> block_dist(0, k - 1);
+  for ( const HypernodeID& hn : phg.nodes() ) {
+    phg.setOnlyNodePart(hn, block_dist(rng));
+  }
+  phg.initializePartition();
+}
+
+// ! Random values in [min, max]
+template<typename T>
+vec<T> randomValues(const size_t n, const T min, const T max) {
+  std::mt19937 rng(SEED);
+  std::uniform_int_distribution<T> dist(min, max);
+  vec<T> values(n);
+  for ( T& value : values ) {
+    value = dist(rng);
+  }
+  return values;
+}
+
+// ! Arguments: k, degree and number of threads
+void benchmarkArguments(benchmark::internal::Benchmark* b) {
+  b->ArgNames({ "k", "degree", "threads" })
+   ->ArgsProduct({ { 2, 8, 64 }, { 4, 16 }, { 1, 4 } })
+   ->Unit(benchmark::kMillisecond)
+   ->UseRealTime();
+}
+
+}  // namespace
+
+// ! Moves each node once to a random block (degree = expected node degree)
+void BM_ChangeNodePartWithGainCacheUpdate(benchmark::State& state) {
+  const PartitionID k = state.range(0);
+  Hypergraph hg = generateRandomHypergraph(NUM_NODES, state.range(1), EDGE_SIZE);
+  PartitionedHypergraph phg(k, hg, parallel_tag_t());
+  assignRandomPartition(phg, k);
+  phg.initializeGainCache();
+  const vec<PartitionID> offset = randomValues<PartitionID>(NUM_NODES, 1, k - 1);
+
+  tbb::task_arena arena(state.range(2));
+  for ( auto _ : state ) {
+    arena.execute([&] {
+      tbb::parallel_for(ID(0), NUM_NODES, [&](const HypernodeID hn) {
+        const PartitionID from = phg.partID(hn);
+        phg.changeNodePartWithGainCacheUpdate(hn, from, (from + offset[hn]) % k);
+      });
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_NODES);
+}
+BENCHMARK(BM_ChangeNodePartWithGainCacheUpdate)->Apply(benchmarkArguments);
+
+// ! Increments and decrements the pin counts of degree random blocks of each hyperedge
+void BM_PinCountInPartIncrementDecrement(benchmark::State& state) {
+  const PartitionID k = state.range(0);
+  const size_t degree = state.range(1);
+  const HyperedgeID num_edges = NUM_NODES;
+  ds::PinCountInPart pin_counts(num_edges, k, EDGE_SIZE);
+  const vec<PartitionID> blocks = randomValues<PartitionID>(num_edges * degree, 0, k - 1);
+
+  tbb::task_arena arena(state.range(2));
+  for ( auto _ : state ) {
+    arena.execute([&] {
+      tbb::parallel_for(ID(0), num_edges, [&](const HyperedgeID he) {
+        for ( size_t i = 0; i < degree; ++i ) {
+          const PartitionID block = blocks[he * degree + i];
+          if ( pin_counts.pinCountInPart(he, block) < EDGE_SIZE ) {
+            pin_counts.incrementPinCountInPart(he, block);
+          }
+        }
+        for ( size_t i = 0; i < degree; ++i ) {
+          const PartitionID block = blocks[he * degree + i];
+          if ( pin_counts.pinCountInPart(he, block) > 0 ) {
+            pin_counts.decrementPinCountInPart(he, block);
+          }
+        }
+      });
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * num_edges * degree * 2);
+}
+BENCHMARK(BM_PinCountInPartIncrementDecrement)->Apply(benchmarkArguments);
+
+// ! Adds degree random blocks to the connectivity set of each
+// ! hyperedge, iterates over the set and clears it again
+void BM_ConnectivitySetsAddIterateRemove(benchmark::State& state) {
+  const PartitionID k = state.range(0);
+  const size_t degree = state.range(1);
+  const HyperedgeID num_edges = NUM_NODES;
+  ds::ConnectivitySets connectivity_sets(num_edges, k);
+  const vec<PartitionID> blocks = randomValues<PartitionID>(num_edges * degree, 0, k - 1);
+
+  tbb::task_arena arena(state.range(2));
+  for ( auto _ : state ) {
+    arena.execute([&] {
+      tbb::parallel_for(ID(0), num_edges, [&](const HyperedgeID he) {
+        for ( size_t i = 0; i < degree; ++i ) {
+          const PartitionID block = blocks[he * degree + i];
+          if ( !connectivity_sets.contains(he, block) ) {
+            connectivity_sets.add(he, block);
+          }
+        }
+        PartitionID sum = 0;
+        for ( const PartitionID block : connectivity_sets.connectivitySet(he) ) {
+          sum += block;
+        }
+        benchmark::DoNotOptimize(sum);
+        connectivity_sets.clear(he);
+      });
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * num_edges * degree);
+}
+BENCHMARK(BM_ConnectivitySetsAddIterateRemove)->Apply(benchmarkArguments);
+
+// ! Aggregates ratings of degree random clusters per node in a thread-local
+// ! sparse map (as done by the vertex pair rater). The cluster IDs are drawn
+// ! from k * 1000 clusters to vary the size of the key space.
+void BM_FixedSizeSparseMapRatingInserts(benchmark::State& state) {
+  using RatingMap = ds::FixedSizeSparseMap<HypernodeID, double>;
+  const HypernodeID num_clusters = state.range(0) * 1000;
+  const size_t degree = state.range(1);
+  const vec<HypernodeID> clusters = randomValues<HypernodeID>(NUM_NODES * degree, 0, num_clusters - 1);
+  tbb::enumerable_thread_specific<RatingMap> rating_maps(0.0);
+
+  tbb::task_arena arena(state.range(2));
+  for ( auto _ : state ) {
+    arena.execute([&] {
+      tbb::parallel_for(ID(0), NUM_NODES, [&](const HypernodeID hn) {
+        RatingMap& ratings = rating_maps.local();
+        for ( size_t i = 0; i < degree; ++i ) {
+          ratings[clusters[hn * degree + i]] += 1.0 / ( i + 1 );
+        }
+        double max_rating = 0.0;
+        for ( const auto& entry : ratings ) {
+          max_rating = std::max(max_rating, entry.value);
+        }
+        benchmark::DoNotOptimize(max_rating);
+        ratings.clear();
+      });
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_NODES * degree);
+}
+BENCHMARK(BM_FixedSizeSparseMapRatingInserts)->Apply(benchmarkArguments);
+
+// ! Block priority queue of the FM gain cache strategy: inserts all k blocks,
+// ! performs degree key adjustments and extracts all blocks
+void BM_ExclusiveHandleHeapOperations(benchmark::State& state) {
+  using BlockPriorityQueue = ds::ExclusiveHandleHeap< ds::MaxHeap<Gain, PartitionID> >;
+  const PartitionID k = state.range(0);
+  const size_t degree = state.range(1);
+  const size_t num_rounds = NUM_NODES / 10;
+  const vec<Gain> gains = randomValues<Gain>(num_rounds * ( k + degree ), -100, 100);
+  const vec<PartitionID> blocks = randomValues<PartitionID>(num_rounds * degree, 0, k - 1);
+  tbb::enumerable_thread_specific<BlockPriorityQueue> pqs(k);
+
+  tbb::task_arena arena(state.range(2));
+  for ( auto _ : state ) {
+    arena.execute([&] {
+      tbb::parallel_for(UL(0), num_rounds, [&](const size_t round) {
+        BlockPriorityQueue& pq = pqs.local();
+        const Gain* round_gains = gains.data() + round * ( k + degree );
+        for ( PartitionID block = 0; block < k; ++block ) {
+          pq.insert(block, round_gains[block]);
+        }
+        for ( size_t i = 0; i < degree; ++i ) {
+          pq.adjustKey(blocks[round * degree + i], round_gains[k + i]);
+        }
+        Gain sum = 0;
+        while ( !pq.empty() ) {
+          sum += pq.topKey();
+          pq.deleteTop();
+        }
+        benchmark::DoNotOptimize(sum);
+      });
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * num_rounds * ( 2 * k + degree ));
+}
+BENCHMARK(BM_ExclusiveHandleHeapOperations)->Apply(benchmarkArguments);
+
+// ! Each task applies degree local moves to a thread-local delta partition (as
+// ! done by localized FM) and looks up the block IDs and pin counts of all
+// ! pins and incident hyperedges of the moved nodes
+void BM_DeltaPartitionedHypergraphLookups(benchmark::State& state) {
+  using DeltaPartitionedHypergraph = ds::DeltaPartitionedHypergraph<PartitionedHypergraph>;
+  const PartitionID k = state.range(0);
+  const HypernodeID degree = state.range(1);
+  Hypergraph hg = generateRandomHypergraph(NUM_NODES, degree, EDGE_SIZE);
+  PartitionedHypergraph phg(k, hg, parallel_tag_t());
+  assignRandomPartition(phg, k);
+  phg.initializeGainCache();
+  const vec<PartitionID> offset = randomValues<PartitionID>(NUM_NODES, 1, k - 1);
+  Context context;
+  context.partition.k = k;
+  tbb::enumerable_thread_specific<DeltaPartitionedHypergraph> delta_phgs([&] {
+    DeltaPartitionedHypergraph delta_phg(context);
+    delta_phg.setPartitionedHypergraph(&phg);
+    return delta_phg;
+  });
+
+  const HypernodeID num_tasks = NUM_NODES / degree;
+  tbb::task_arena arena(state.range(2));
+  for ( auto _ : state ) {
+    arena.execute([&] {
+      tbb::parallel_for(ID(0), num_tasks, [&](const HypernodeID task) {
+        DeltaPartitionedHypergraph& delta_phg = delta_phgs.local();
+        HypernodeID sum = 0;
+        for ( HypernodeID hn = task * degree; hn < ( task + 1 ) * degree; ++hn ) {
+          const PartitionID from = delta_phg.partID(hn);
+          delta_phg.changeNodePart(hn, from, (from + offset[hn]) % k,
+            std::numeric_limits<HypernodeWeight>::max());
+          for ( const HyperedgeID& he : phg.incidentEdges(hn) ) {
+            for ( const HypernodeID& pin : phg.pins(he) ) {
+              sum += delta_phg.partID(pin);
+            }
+            sum += delta_phg.pinCountInPart(he, from);
+          }
+        }
+        benchmark::DoNotOptimize(sum);
+        delta_phg.clear();
+      });
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * NUM_NODES);
+}
+BENCHMARK(BM_DeltaPartitionedHypergraphLookups)->Apply(benchmarkArguments);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mt-kahypar/io/number_parsing.h"
+
+using namespace mt_kahypar;
+namespace po = boost::program_options;
+
+// Parses all numbers of an hMetis or Metis file and returns their sum
+template<typename ReadNumber>
+int64_t parseAllNumbers(const std::string& content, const ReadNumber& read_number) {
+  const char* data = content.c_str();
+  const size_t length = content.size();
+  size_t pos = 0;
+  int64_t sum = 0;
+  while ( pos < length ) {
+    if ( data[pos] == '%' ) {
+      while ( pos < length && data[pos] != '\n' ) {
+        ++pos;
+      }
+      ++pos;
+    } else if ( io::is_line_ending(data, pos) ) {
+      ++pos;
+    } else {
+      sum += read_number(data, pos, length);
+    }
+  }
+  return sum;
+}
+
+template<typename ReadNumber>
+double benchmark(const std::string& content,
+                 const size_t num_repetitions,
+                 const ReadNumber& read_number,
+                 int64_t& checksum) {
+  const auto start = std::chrono::high_resolution_clock::now();
+  for ( size_t i = 0; i < num_repetitions; ++i ) {
+    checksum = parseAllNumbers(content, read_number);
+  }
+  const auto end = std::chrono::high_resolution_clock::now();
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  return ( static_cast<double>(content.size()) * num_repetitions ) / ( 1024.0 * 1024.0 * seconds );
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<std::string> filenames;
+  size_t num_repetitions = 10;
+
+  po::options_description options("Options");
+  options.add_options()
+    ("input,i",
+    po::value<std::vector<std::string>>(&filenames)->value_name("<string>")->required()->multitoken(),
+    "Hypergraph or graph files (e.g., tests/instances/*)")
+    ("repetitions,r",
+    po::value<size_t>(&num_repetitions)->value_name("<size_t>"),
+    "Number of times each file is parsed (default: 10)");
+
+  po::positional_options_description positional;
+  positional.add("input", -1);
+
+  po::variables_map cmd_vm;
+  po::store(po::command_line_parser(argc, argv).options(options).positional(positional).run(), cmd_vm);
+  po::notify(cmd_vm);
+
+  #ifdef MT_KAHYPAR_SIMD_NUMBER_PARSING
+  std::cout << "Vectorized number parsing is enabled" << std::endl;
+  #else
+  std::cout << "Vectorized number parsing is disabled (scalar fallback)" << std::endl;
+  #endif
+
+  std::cout << std::left << std::setw(60) << "file" << std::right
+            << std::setw(12) << "size [MB]" << std::setw(16) << "scalar [MB/s]"
+            << std::setw(16) << "read [MB/s]" << std::setw(10) << "speedup" << std::endl;
+  for ( const std::string& filename : filenames ) {
+    std::ifstream file(filename, std::ios::binary);
+    if ( !file ) {
+      std::cerr << "Could not open: " << filename << std::endl;
+      return 1;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string content = buffer.str();
+
+    int64_t scalar_checksum = 0;
+    int64_t checksum = 0;
+    const double scalar_throughput = benchmark(content, num_repetitions,
+      [](const char* data, size_t& pos, const size_t length) {
+        return io::read_number_scalar(data, pos, length);
+      }, scalar_checksum);
+    const double throughput = benchmark(content, num_repetitions,
+      [](const char* data, size_t& pos, const size_t length) {
+        return io::read_number(data, pos, length);
+      }, checksum);
+    if ( checksum != scalar_checksum ) {
+      std::cerr << "Checksum mismatch for " << filename << ": "
+                << scalar_checksum << " vs. " << checksum << std::endl;
+      return 1;
+    }
+
+    std::cout << std::left << std::setw(60) << filename << std::right << std::fixed
+              << std::setprecision(2) << std::setw(12) << content.size() / ( 1024.0 * 1024.0 )
+              << std::setw(16) << scalar_throughput << std::setw(16) << throughput
+              << std::setw(10) << throughput / scalar_throughput << std::endl;
+  }
+
+  return 0;
+}
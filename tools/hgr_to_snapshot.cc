@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <string>
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/io/hypergraph_io.h"
+
+using namespace mt_kahypar;
+namespace po = boost::program_options;
+
+int main(int argc, char* argv[]) {
+  std::string input_filename;
+  std::string snapshot_filename;
+  bool shared_memory = false;
+  FileFormat file_format = FileFormat::hMetis;
+
+  po::options_description options("Options");
+  options.add_options()
+    ("hypergraph,h",
+    po::value<std::string>(&input_filename)->value_name("<string>")->required(),
+    "Hypergraph filename")
+    ("snapshot,s",
+    po::value<std::string>(&snapshot_filename)->value_name("<string>")->required(),
+    "Snapshot filename")
+    ("shared-memory",
+    po::value<bool>(&shared_memory)->value_name("<bool>"),
+    "If true, the snapshot is written into a POSIX shared memory segment named by --snapshot\n"
+    "(e.g., /my_hypergraph) instead of a file. Partitioner processes can attach to it\n"
+    "via --input-file-format=shared_snapshot. The segment persists until it is removed.")
+    ("input-file-format",
+    po::value<std::string>()->value_name("<string>")->notifier([&](const std::string& s) {
+      if (s == "hmetis") {
+        file_format = FileFormat::hMetis;
+      } else if (s == "metis") {
+        file_format = FileFormat::Metis;
+      }
+    }),
+    "Input file format: \n"
+    " - hmetis : hMETIS hypergraph file format \n"
+    " - metis : METIS graph file format");
+
+  po::variables_map cmd_vm;
+  po::store(po::parse_command_line(argc, argv, options), cmd_vm);
+  po::notify(cmd_vm);
+
+  // Incident nets are sorted such that the snapshot does not depend on the scheduling
+  Hypergraph hypergraph = io::readInputFile(input_filename, file_format, true);
+  if ( shared_memory ) {
+    io::writeHypergraphSnapshotToSharedMemory(hypergraph, snapshot_filename);
+  } else {
+    io::writeHypergraphSnapshot(hypergraph, snapshot_filename);
+  }
+
+  LOG << "Wrote snapshot of hypergraph with" << hypergraph.initialNumNodes() << "nodes,"
+      << hypergraph.initialNumEdges() << "hyperedges and" << hypergraph.initialNumPins()
+      << "pins to" << snapshot_filename;
+
+  return 0;
+}
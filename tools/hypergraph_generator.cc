@@ -0,0 +1,474 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tbb/global_control.h"
+#include "tbb/parallel_for.h"
+#include "tbb/enumerable_thread_specific.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/datastructures/array.h"
+#include "mt-kahypar/io/hypergraph_io.h"
+#include "mt-kahypar/parallel/parallel_prefix_sum.h"
+#include "mt-kahypar/utils/randomize.h"
+
+using namespace mt_kahypar;
+namespace po = boost::program_options;
+
+/*!
+ * Generates synthetic hypergraphs and graphs for scalability experiments. Each net is
+ * generated independently from a counter-based random number generator seeded with
+ * the net ID. Thus, the output only depends on the parameters and the seed, but not on
+ * the number of threads. Nets are generated in parallel and written in batches, such
+ * that hMetis files with many billion pins can be generated with bounded memory.
+ *
+ * Models:
+ *  - uniform   : net sizes and pins are chosen uniformly at random
+ *  - powerlaw  : net sizes and vertex degrees follow power-law distributions
+ *  - mesh      : vertices are placed on a 2D grid, the pins of a net are chosen
+ *                from the neighborhood of a vertex
+ *  - planted   : vertices are split into blocks, each pin lies in the block of its
+ *                net with probability --p-intra (the planted partition can be written
+ *                via --planted-partition)
+ */
+
+enum class Model : uint8_t { uniform, powerlaw, mesh, planted };
+
+struct GeneratorConfig {
+  Model model = Model::uniform;
+  uint64_t num_nodes = 0;
+  uint64_t num_nets = 0;
+  uint64_t min_net_size = 2;
+  uint64_t max_net_size = 10;
+  double net_size_exponent = 2.5;
+  double degree_exponent = 0.8;
+  uint64_t num_blocks = 2;
+  double p_intra = 0.9;
+  uint64_t seed = 0;
+  bool scramble_ids = true;
+};
+
+class NetGenerator {
+  static constexpr double kTwoToMinus53 = 1.0 / static_cast<double>(UINT64_C(1) << 53);
+
+ public:
+  explicit NetGenerator(const GeneratorConfig& config) :
+    _config(config),
+    _grid_width(std::max(UINT64_C(1), static_cast<uint64_t>(
+      std::ceil(std::sqrt(static_cast<double>(config.num_nodes)))))),
+    _perm_a(1),
+    _perm_b(0) {
+    if ( config.scramble_ids && config.num_nodes > 1 ) {
+      // Random affine bijection on [0, n) such that the node IDs of
+      // the models (e.g., blocks of planted partitions) are not contiguous
+      utils::CounterBasedRNG rng(config.seed, std::numeric_limits<uint64_t>::max());
+      do {
+        _perm_a = ( rng() % config.num_nodes ) | 1;
+      } while ( std::gcd(_perm_a, config.num_nodes) != 1 );
+      _perm_b = rng() % config.num_nodes;
+    }
+  }
+
+  // ! Computes the pins of net e (sorted, without duplicates)
+  void generate(const uint64_t e, std::vector<uint64_t>& pins) const {
+    pins.clear();
+    utils::CounterBasedRNG rng(_config.seed, e);
+    const uint64_t n = _config.num_nodes;
+    switch ( _config.model ) {
+      case Model::uniform: {
+        const uint64_t size = uniformInt(rng, _config.min_net_size, _config.max_net_size);
+        for ( uint64_t i = 0; i < size; ++i ) {
+          pins.push_back(rng() % n);
+        }
+      } break;
+      case Model::powerlaw: {
+        const uint64_t size = powerLaw(rng, _config.min_net_size,
+          _config.max_net_size, _config.net_size_exponent);
+        for ( uint64_t i = 0; i < size; ++i ) {
+          // Vertex i is chosen with a probability that decreases polynomially in i
+          pins.push_back(powerLaw(rng, 1, n, _config.degree_exponent) - 1);
+        }
+      } break;
+      case Model::mesh: {
+        const uint64_t size = uniformInt(rng, _config.min_net_size, _config.max_net_size);
+        const uint64_t center = e % n;
+        const int64_t radius = std::max(INT64_C(1), static_cast<int64_t>(
+          std::ceil(std::sqrt(static_cast<double>(size)) / 2.0)));
+        const int64_t x = center % _grid_width;
+        const int64_t y = center / _grid_width;
+        pins.push_back(center);
+        for ( uint64_t i = 1; i < size; ++i ) {
+          const int64_t nx = x + static_cast<int64_t>(uniformInt(rng, 0, 2 * radius)) - radius;
+          const int64_t ny = y + static_cast<int64_t>(uniformInt(rng, 0, 2 * radius)) - radius;
+          if ( nx >= 0 && ny >= 0 && nx < static_cast<int64_t>(_grid_width) ) {
+            const uint64_t v = static_cast<uint64_t>(ny) * _grid_width + nx;
+            if ( v < n ) {
+              pins.push_back(v);
+            }
+          }
+        }
+      } break;
+      case Model::planted: {
+        const uint64_t size = uniformInt(rng, _config.min_net_size, _config.max_net_size);
+        const uint64_t block = rng() % _config.num_blocks;
+        const uint64_t block_begin = blockBegin(block);
+        const uint64_t block_size = blockBegin(block + 1) - block_begin;
+        for ( uint64_t i = 0; i < size; ++i ) {
+          if ( block_size > 0 && uniformReal(rng) < _config.p_intra ) {
+            pins.push_back(block_begin + rng() % block_size);
+          } else {
+            pins.push_back(rng() % n);
+          }
+        }
+      } break;
+    }
+
+    for ( uint64_t& pin : pins ) {
+      pin = scramble(pin);
+    }
+    std::sort(pins.begin(), pins.end());
+    pins.erase(std::unique(pins.begin(), pins.end()), pins.end());
+  }
+
+  // ! Block of the (scrambled) node ID in the planted partition
+  void plantedPartition(std::vector<PartitionID>& partition) const {
+    partition.assign(_config.num_nodes, 0);
+    tbb::parallel_for(UL(0), _config.num_blocks, [&](const uint64_t block) {
+      tbb::parallel_for(blockBegin(block), blockBegin(block + 1), [&](const uint64_t v) {
+        partition[scramble(v)] = static_cast<PartitionID>(block);
+      });
+    });
+  }
+
+ private:
+  uint64_t scramble(const uint64_t v) const {
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(_perm_a) * v + _perm_b) %
+      std::max(UINT64_C(1), _config.num_nodes));
+  }
+
+  uint64_t blockBegin(const uint64_t block) const {
+    return static_cast<uint64_t>(static_cast<unsigned __int128>(_config.num_nodes) *
+      block / _config.num_blocks);
+  }
+
+  static double uniformReal(utils::CounterBasedRNG& rng) {
+    return static_cast<double>(rng() >> 11) * kTwoToMinus53;
+  }
+
+  static uint64_t uniformInt(utils::CounterBasedRNG& rng, const uint64_t low, const uint64_t high) {
+    return low + rng() % ( high - low + 1 );
+  }
+
+  // ! Samples x in [low, high] with P(x) ~ x^(-exponent) via inverse transform sampling
+  static uint64_t powerLaw(utils::CounterBasedRNG& rng, const uint64_t low,
+                           const uint64_t high, const double exponent) {
+    const double e = 1.0 - exponent;
+    const double lo = std::pow(static_cast<double>(low), e);
+    const double hi = std::pow(static_cast<double>(high + 1), e);
+    const double x = std::pow(lo + ( hi - lo ) * uniformReal(rng), 1.0 / e);
+    return std::min(high, std::max(low, static_cast<uint64_t>(x)));
+  }
+
+  const GeneratorConfig& _config;
+  const uint64_t _grid_width;
+  uint64_t _perm_a;
+  uint64_t _perm_b;
+};
+
+// ! Generates the nets [first, last) in parallel and returns their pins in net order
+void generateBatch(const NetGenerator& generator,
+                   const uint64_t first,
+                   const uint64_t last,
+                   std::vector<std::vector<uint64_t>>& nets) {
+  nets.resize(last - first);
+  tbb::parallel_for(first, last, [&](const uint64_t e) {
+    generator.generate(e, nets[e - first]);
+  });
+}
+
+void writeHMetis(const GeneratorConfig& config,
+                 const NetGenerator& generator,
+                 const std::string& filename) {
+  static constexpr uint64_t BATCH_SIZE = UINT64_C(1) << 18;
+  std::ofstream out(filename);
+  if ( !out ) {
+    ERR("Could not open output file:" << filename);
+  }
+  out << config.num_nets << " " << config.num_nodes << "\n";
+  std::vector<std::vector<uint64_t>> nets;
+  std::vector<std::string> lines;
+  uint64_t num_pins = 0;
+  for ( uint64_t first = 0; first < config.num_nets; first += BATCH_SIZE ) {
+    const uint64_t last = std::min(config.num_nets, first + BATCH_SIZE);
+    generateBatch(generator, first, last, nets);
+    // Format the nets in parallel in chunks and write the chunks in order
+    static constexpr uint64_t CHUNK_SIZE = 1024;
+    const uint64_t num_chunks = ( last - first + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+    lines.assign(num_chunks, std::string());
+    tbb::parallel_for(UL(0), num_chunks, [&](const uint64_t chunk) {
+      std::string& line = lines[chunk];
+      const uint64_t end = std::min(nets.size(), ( chunk + 1 ) * CHUNK_SIZE);
+      for ( uint64_t i = chunk * CHUNK_SIZE; i < end; ++i ) {
+        for ( size_t j = 0; j < nets[i].size(); ++j ) {
+          if ( j > 0 ) line += ' ';
+          line += std::to_string(nets[i][j] + 1);
+        }
+        line += '\n';
+      }
+    });
+    for ( const std::string& line : lines ) {
+      out << line;
+    }
+    for ( const std::vector<uint64_t>& net : nets ) {
+      num_pins += net.size();
+    }
+  }
+  LOG << "Wrote hypergraph with" << config.num_nodes << "nodes," << config.num_nets
+      << "nets and" << num_pins << "pins to" << filename;
+}
+
+void writeMetis(const GeneratorConfig& config,
+                const NetGenerator& generator,
+                const std::string& filename) {
+  // Each net of size two is an edge. Since METIS files store the adjacency list of
+  // each node, the graph is built in memory (self loops and parallel edges are removed).
+  std::vector<std::vector<uint64_t>> nets;
+  generateBatch(generator, 0, config.num_nets, nets);
+  std::vector<uint64_t> degrees(config.num_nodes + 1, 0);
+  for ( const std::vector<uint64_t>& net : nets ) {
+    if ( net.size() == 2 ) {
+      ++degrees[net[0] + 1];
+      ++degrees[net[1] + 1];
+    }
+  }
+  std::partial_sum(degrees.begin(), degrees.end(), degrees.begin());
+  std::vector<uint64_t> adjacency(degrees.back());
+  std::vector<uint64_t> pos(degrees.begin(), degrees.end() - 1);
+  for ( const std::vector<uint64_t>& net : nets ) {
+    if ( net.size() == 2 ) {
+      adjacency[pos[net[0]]++] = net[1];
+      adjacency[pos[net[1]]++] = net[0];
+    }
+  }
+  std::vector<uint64_t> num_neighbors(config.num_nodes, 0);
+  tbb::parallel_for(UL(0), config.num_nodes, [&](const uint64_t u) {
+    auto begin = adjacency.begin() + degrees[u];
+    auto end = adjacency.begin() + degrees[u + 1];
+    std::sort(begin, end);
+    num_neighbors[u] = std::unique(begin, end) - begin;
+  });
+  const uint64_t num_edges = std::accumulate(
+    num_neighbors.begin(), num_neighbors.end(), UINT64_C(0)) / 2;
+
+  std::ofstream out(filename);
+  if ( !out ) {
+    ERR("Could not open output file:" << filename);
+  }
+  out << config.num_nodes << " " << num_edges << "\n";
+  for ( uint64_t u = 0; u < config.num_nodes; ++u ) {
+    for ( uint64_t i = 0; i < num_neighbors[u]; ++i ) {
+      if ( i > 0 ) out << ' ';
+      out << adjacency[degrees[u] + i] + 1;
+    }
+    out << '\n';
+  }
+  LOG << "Wrote graph with" << config.num_nodes << "nodes and" << num_edges << "edges to" << filename;
+}
+
+#if !defined(USE_GRAPH_PARTITIONER) && !defined(USE_STRONG_PARTITIONER)
+void writeSnapshot(const GeneratorConfig& config,
+                   const NetGenerator& generator,
+                   const std::string& filename) {
+  if ( config.num_nodes > std::numeric_limits<HypernodeID>::max() ||
+       config.num_nets > std::numeric_limits<HyperedgeID>::max() ) {
+    ERR("The hypergraph exceeds the ID range of the hypergraph data structure");
+  }
+  // The nets are generated twice: once to compute the pin offsets
+  // and once to write the pins directly into the incidence array
+  tbb::enumerable_thread_specific<std::vector<uint64_t>> local_pins;
+  parallel::scalable_vector<size_t> pin_offsets(config.num_nets + 1, 0);
+  tbb::parallel_for(UL(0), config.num_nets, [&](const uint64_t e) {
+    std::vector<uint64_t>& pins = local_pins.local();
+    generator.generate(e, pins);
+    pin_offsets[e + 1] = pins.size();
+  });
+  parallel::TBBPrefixSum<size_t, parallel::scalable_vector> prefix_sum(pin_offsets);
+  tbb::parallel_scan(tbb::blocked_range<size_t>(UL(0), pin_offsets.size()), prefix_sum);
+
+  ds::Array<HypernodeID> incidence_array(pin_offsets.back());
+  tbb::parallel_for(UL(0), config.num_nets, [&](const uint64_t e) {
+    std::vector<uint64_t>& pins = local_pins.local();
+    generator.generate(e, pins);
+    for ( size_t i = 0; i < pins.size(); ++i ) {
+      incidence_array[pin_offsets[e] + i] = static_cast<HypernodeID>(pins[i]);
+    }
+  });
+
+  Hypergraph hypergraph = HypergraphFactory::construct_from_incidence_array(
+    config.num_nodes, config.num_nets, pin_offsets, std::move(incidence_array), nullptr, nullptr, true);
+  io::writeHypergraphSnapshot(hypergraph, filename);
+  LOG << "Wrote snapshot of hypergraph with" << hypergraph.initialNumNodes() << "nodes,"
+      << hypergraph.initialNumEdges() << "hyperedges and" << hypergraph.initialNumPins()
+      << "pins to" << filename;
+}
+#endif
+
+int main(int argc, char* argv[]) {
+  GeneratorConfig config;
+  std::string output_filename;
+  std::string output_format = "hmetis";
+  std::string planted_partition_filename;
+  size_t num_threads = std::thread::hardware_concurrency();
+
+  po::options_description options("Options");
+  options.add_options()
+    ("output,o",
+    po::value<std::string>(&output_filename)->value_name("<string>")->required(),
+    "Output filename")
+    ("output-format",
+    po::value<std::string>(&output_format)->value_name("<string>"),
+    "Output format: \n"
+    " - hmetis : hMETIS hypergraph file format (written in batches, default) \n"
+    " - metis : METIS graph file format (requires --min-net-size=2 and --max-net-size=2) \n"
+    " - snapshot : binary snapshot of a static hypergraph (see --input-file-format=snapshot)")
+    ("model,m",
+    po::value<std::string>()->value_name("<string>")->notifier([&](const std::string& s) {
+      if (s == "uniform") {
+        config.model = Model::uniform;
+      } else if (s == "powerlaw") {
+        config.model = Model::powerlaw;
+      } else if (s == "mesh") {
+        config.model = Model::mesh;
+      } else if (s == "planted") {
+        config.model = Model::planted;
+      } else {
+        ERR("Illegal model:" << s);
+      }
+    }),
+    "Model: \n"
+    " - uniform : uniform net sizes and pins (default) \n"
+    " - powerlaw : power-law distributed net sizes and vertex degrees \n"
+    " - mesh : pins are chosen from the grid neighborhood of a vertex \n"
+    " - planted : nets prefer the pins of a planted block")
+    ("num-nodes,n",
+    po::value<uint64_t>(&config.num_nodes)->value_name("<uint64_t>")->required(),
+    "Number of nodes")
+    ("num-nets,e",
+    po::value<uint64_t>(&config.num_nets)->value_name("<uint64_t>")->required(),
+    "Number of nets (edges)")
+    ("min-net-size",
+    po::value<uint64_t>(&config.min_net_size)->value_name("<uint64_t>"),
+    "Minimum net size (default 2)")
+    ("max-net-size",
+    po::value<uint64_t>(&config.max_net_size)->value_name("<uint64_t>"),
+    "Maximum net size (default 10)")
+    ("net-size-exponent",
+    po::value<double>(&config.net_size_exponent)->value_name("<double>"),
+    "Exponent of the net size distribution of the powerlaw model (default 2.5)")
+    ("degree-exponent",
+    po::value<double>(&config.degree_exponent)->value_name("<double>"),
+    "Exponent of the vertex popularity of the powerlaw model (default 0.8, must not be 1)")
+    ("num-blocks",
+    po::value<uint64_t>(&config.num_blocks)->value_name("<uint64_t>"),
+    "Number of blocks of the planted model (default 2)")
+    ("p-intra",
+    po::value<double>(&config.p_intra)->value_name("<double>"),
+    "Probability that a pin lies in the block of its net in the planted model (default 0.9)")
+    ("planted-partition",
+    po::value<std::string>(&planted_partition_filename)->value_name("<string>"),
+    "If set, the planted partition is written to this file (one block per line)")
+    ("scramble-ids",
+    po::value<bool>(&config.scramble_ids)->value_name("<bool>"),
+    "If true, node IDs are permuted randomly such that they do not reveal the structure (default true)")
+    ("seed",
+    po::value<uint64_t>(&config.seed)->value_name("<uint64_t>"),
+    "Seed of the generator (the output does not depend on the number of threads)")
+    ("threads,t",
+    po::value<size_t>(&num_threads)->value_name("<size_t>"),
+    "Number of threads");
+
+  po::variables_map cmd_vm;
+  po::store(po::parse_command_line(argc, argv, options), cmd_vm);
+  po::notify(cmd_vm);
+
+  if ( config.num_nodes == 0 ) {
+    ERR("Number of nodes must be greater than zero");
+  }
+  if ( config.min_net_size == 0 || config.min_net_size > config.max_net_size ) {
+    ERR("Net sizes must satisfy 0 < min-net-size <= max-net-size");
+  }
+  if ( config.model == Model::powerlaw &&
+       ( config.net_size_exponent == 1.0 || config.degree_exponent == 1.0 ) ) {
+    ERR("Exponents of the powerlaw model must not be 1");
+  }
+  if ( config.num_blocks == 0 ) {
+    ERR("Number of blocks must be greater than zero");
+  }
+
+  tbb::global_control gc(tbb::global_control::max_allowed_parallelism, num_threads);
+  NetGenerator generator(config);
+
+  if ( output_format == "hmetis" ) {
+    writeHMetis(config, generator, output_filename);
+  } else if ( output_format == "metis" ) {
+    if ( config.min_net_size != 2 || config.max_net_size != 2 ) {
+      ERR("Graphs require --min-net-size=2 and --max-net-size=2");
+    }
+    writeMetis(config, generator, output_filename);
+  #if !defined(USE_GRAPH_PARTITIONER) && !defined(USE_STRONG_PARTITIONER)
+  } else if ( output_format == "snapshot" ) {
+    writeSnapshot(config, generator, output_filename);
+  #endif
+  } else {
+    ERR("Illegal output format:" << output_format);
+  }
+
+  if ( !planted_partition_filename.empty() ) {
+    if ( config.model != Model::planted ) {
+      ERR("A planted partition is only available for the planted model");
+    }
+    std::vector<PartitionID> partition;
+    generator.plantedPartition(partition);
+    std::ofstream out(planted_partition_filename);
+    for ( const PartitionID block : partition ) {
+      out << block << "\n";
+    }
+  }
+
+  return 0;
+}
@@ -40,6 +40,7 @@
 #include "mt-kahypar/partition/context.h"
 #include "mt-kahypar/partition/metrics.h"
 #include "mt-kahypar/io/hypergraph_io.h"
+#include "mt-kahypar/io/partitioning_output.h"
 #include "mt-kahypar/utils/hypergraph_statistics.h"
 
 #include "kahypar/utils/math.h"
@@ -53,6 +54,7 @@ struct Statistic {
   uint64_t med = 0;
   uint64_t q3 = 0;
   uint64_t top90 = 0;
+  uint64_t top99 = 0;
   uint64_t max = 0;
   double avg = 0.0;
   double sd = 0.0;
@@ -67,7 +69,8 @@ Statistic createStats(const std::vector<T>& vec, const double avg, const double
     stats.q1 = quartiles.first;
     stats.med = kahypar::math::median(vec);
     stats.q3 = quartiles.second;
-    stats.top90 = vec[ceil(90.0 / 100 * (vec.size() - 1))];
+    stats.top90 = utils::percentile(vec, 90.0);
+    stats.top99 = utils::percentile(vec, 99.0);
     stats.max = vec.back();
     stats.avg = avg;
     stats.sd = stdev;
@@ -75,6 +78,44 @@ Statistic createStats(const std::vector<T>& vec, const double avg, const double
   return stats;
 }
 
+// ! Prints the objectives, the connectivity histogram and the cut matrix of a partition
+void printPartitionStats(Hypergraph& hg, Context& context, const std::string& graph_name) {
+  PartitionedHypergraph phg(context.partition.k, hg, parallel_tag_t());
+  context.setupPartWeights(hg.totalWeight());
+
+  std::vector<PartitionID> partition;
+  io::readPartitionFile(context.partition.graph_partition_filename, partition);
+  if ( partition.size() != hg.initialNumNodes() ) {
+    ERR("Partition file contains" << partition.size() << "entries, but the hypergraph has"
+      << hg.initialNumNodes() << "nodes");
+  }
+  phg.doParallelForAllNodes([&](const HypernodeID& hn) {
+    if ( partition[hn] < 0 || partition[hn] >= context.partition.k ) {
+      ERR("Hypernode" << hn << "is assigned to invalid block" << partition[hn]);
+    }
+    phg.setOnlyNodePart(hn, partition[hn]);
+  });
+  phg.initializePartition();
+
+  const std::vector<HyperedgeID> connectivity_histogram = utils::connectivityHistogram(phg);
+  std::cout << "RESULT graph=" << graph_name
+            << " k=" << context.partition.k
+            << " cut=" << metrics::hyperedgeCut(phg, true)
+            << " km1=" << metrics::km1(phg, true)
+            << " soed=" << metrics::soed(phg, true)
+            << " imbalance=" << metrics::imbalance(phg, context);
+  for ( PartitionID i = 1; i <= context.partition.k; ++i ) {
+    if ( connectivity_histogram[i] > 0 ) {
+      std::cout << " numHEsWithConnectivity" << i << "=" << connectivity_histogram[i];
+    }
+  }
+  std::cout << std::endl;
+
+  if ( context.partition.k <= 64 ) {
+    io::printCutMatrix(phg);
+  }
+}
+
 int main(int argc, char* argv[]) {
   Context context;
 
@@ -93,7 +134,17 @@ int main(int argc, char* argv[]) {
             }),
             "Input file format: \n"
             " - hmetis : hMETIS hypergraph file format \n"
-            " - metis : METIS graph file format");
+            " - metis : METIS graph file format")
+          ("partition-file,b",
+           po::value<std::string>(&context.partition.graph_partition_filename)->value_name("<string>"),
+           "Partition Filename (optional). If specified, the objectives, the connectivity histogram\n"
+           "and the cut matrix (k <= 64) of the partition are printed.")
+          ("blocks,k",
+           po::value<PartitionID>(&context.partition.k)->value_name("<int>"),
+           "Number of Blocks (required, if a partition file is specified)")
+          ("epsilon,e",
+           po::value<double>(&context.partition.epsilon)->value_name("<double>")->default_value(0.03),
+           "Imbalance (used to compute the imbalance of the partition)");
 
   po::variables_map cmd_vm;
   po::store(po::parse_command_line(argc, argv, options), cmd_vm);
@@ -185,6 +236,7 @@ int main(int argc, char* argv[]) {
              << " sdHEsize=" << he_size_stats.sd
              << " minHEsize=" << he_size_stats.min
              << " heSize90thPercentile=" << he_size_stats.top90
+             << " heSize99thPercentile=" << he_size_stats.top99
              << " Q1HEsize=" << he_size_stats.q1
              << " medHEsize=" << he_size_stats.med
              << " Q3HEsize=" << he_size_stats.q3
@@ -201,6 +253,7 @@ int main(int argc, char* argv[]) {
              << " sdHNdegree=" << hn_degree_stats.sd
              << " minHnDegree=" << hn_degree_stats.min
              << " hnDegree90thPercentile=" << hn_degree_stats.top90
+             << " hnDegree99thPercentile=" << hn_degree_stats.top99
              << " maxHnDegree=" << hn_degree_stats.max
              << " Q1HNdegree=" << hn_degree_stats.q1
              << " medHNdegree=" << hn_degree_stats.med
@@ -216,5 +269,12 @@ int main(int argc, char* argv[]) {
              << " density=" << static_cast<double>(hg.initialNumEdges()) / hg.initialNumNodes()
              << std::endl;
 
+  if ( !context.partition.graph_partition_filename.empty() ) {
+    if ( context.partition.k < 2 ) {
+      ERR("Number of blocks must be specified, if a partition file is given");
+    }
+    printPartitionStats(hg, context, graph_name);
+  }
+
   return 0;
 }
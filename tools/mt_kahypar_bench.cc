@@ -0,0 +1,341 @@
+/*******************************************************************************
+ * MIT License
+ *
+ * This file is part of Mt-KaHyPar.
+ *
+ * Copyright (C) 2023 Tobias Heuer <tobias.heuer@kit.edu>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ ******************************************************************************/
+
+#include <boost/program_options.hpp>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tbb/task_arena.h"
+
+#include "mt-kahypar/macros.h"
+#include "mt-kahypar/definitions.h"
+#include "mt-kahypar/partition/context.h"
+#include "mt-kahypar/partition/metrics.h"
+#include "mt-kahypar/partition/partitioner.h"
+#include "mt-kahypar/partition/auto_configuration.h"
+#include "mt-kahypar/partition/registries/register_memory_pool.h"
+#include "mt-kahypar/io/hypergraph_io.h"
+#include "mt-kahypar/utils/memory_tree.h"
+#include "mt-kahypar/utils/randomize.h"
+#include "mt-kahypar/utils/utilities.h"
+
+using namespace mt_kahypar;
+namespace po = boost::program_options;
+
+/*!
+ * Runs an instance suite across presets and thread counts and writes one JSON
+ * record per run (timer tree, memory consumption and quality metrics). The
+ * output is meant to be compared between commits to detect regressions.
+ */
+
+struct BenchmarkConfig {
+  std::vector<std::string> instances;
+  FileFormat file_format = FileFormat::hMetis;
+  std::vector<std::string> presets { "default" };
+  std::vector<size_t> threads { 1 };
+  size_t repetitions = 1;
+  PartitionID k = 2;
+  double epsilon = 0.03;
+  Objective objective = Objective::km1;
+  int seed = 0;
+  std::string output_file;
+};
+
+std::string escapeJSON(const std::string& str) {
+  std::string escaped;
+  for ( const char c : str ) {
+    if ( c == '"' || c == '\\' ) {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+// ! Maximum resident set size of the process so far (not reset between runs)
+size_t maxResidentSetSizeInBytes() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<size_t>(usage.ru_maxrss) * 1024;
+}
+
+void setupContext(Context& context,
+                  const BenchmarkConfig& config,
+                  const PresetType preset,
+                  const size_t num_threads,
+                  const int seed) {
+  switch ( preset ) {
+    case PresetType::deterministic: context.load_deterministic_preset(); break;
+    case PresetType::default_preset: context.load_default_preset(); break;
+    case PresetType::default_flows: context.load_default_flow_preset(); break;
+    case PresetType::quality_preset: context.load_quality_preset(); break;
+    case PresetType::quality_flows: context.load_quality_flow_preset(); break;
+    case PresetType::auto_preset:
+      context.load_default_flow_preset();
+      context.partition.preset_type = PresetType::auto_preset;
+      break;
+    case PresetType::UNDEFINED: ERR("Undefined preset type");
+  }
+  context.partition.k = config.k;
+  context.partition.epsilon = config.epsilon;
+  context.partition.objective = config.objective;
+  context.partition.seed = seed;
+  context.partition.mode = Mode::direct;
+#ifdef USE_STRONG_PARTITIONER
+  context.partition.paradigm = Paradigm::nlevel;
+#else
+  context.partition.paradigm = Paradigm::multilevel;
+#endif
+  context.partition.verbose_output = false;
+  context.shared_memory.original_num_threads = num_threads;
+  context.shared_memory.num_threads = num_threads;
+  context.utility_id = utils::Utilities::instance().registerNewUtilityObjects();
+
+  const LabelPropagationAlgorithm lp_algorithm = config.objective == Objective::cut ?
+    LabelPropagationAlgorithm::label_propagation_cut : LabelPropagationAlgorithm::label_propagation_km1;
+  if ( context.refinement.label_propagation.algorithm != LabelPropagationAlgorithm::do_nothing &&
+       context.refinement.label_propagation.algorithm != LabelPropagationAlgorithm::deterministic ) {
+    context.refinement.label_propagation.algorithm = lp_algorithm;
+  }
+  if ( context.initial_partitioning.refinement.label_propagation.algorithm != LabelPropagationAlgorithm::do_nothing &&
+       context.initial_partitioning.refinement.label_propagation.algorithm != LabelPropagationAlgorithm::deterministic ) {
+    context.initial_partitioning.refinement.label_propagation.algorithm = lp_algorithm;
+  }
+}
+
+// ! Partitions the hypergraph once and writes the JSON record of the run
+void runBenchmark(Hypergraph& input,
+                  const BenchmarkConfig& config,
+                  const std::string& instance,
+                  const std::string& preset_name,
+                  const size_t num_threads,
+                  const size_t repetition,
+                  const bool first_record,
+                  std::ostream& out) {
+  Context context;
+  const int seed = config.seed + static_cast<int>(repetition);
+  setupContext(context, config, presetTypeFromString(preset_name), num_threads, seed);
+  utils::Randomize::instance().setSeed(seed);
+
+  // Partitioning modifies the input hypergraph => each run works on a copy
+  // that shares the incidence arrays with the input
+  Hypergraph hypergraph = input.copyOnWrite(parallel_tag_t());
+  parallel::MemoryPool& pool = parallel::MemoryPool::instance();
+  apply_auto_configuration(hypergraph, context);
+  apply_memory_limit(hypergraph, context);
+  register_memory_pool(hypergraph, context);
+  pool.enable_memory_requests();
+
+  utils::Timer& timer = utils::Utilities::instance().getTimer(context.utility_id);
+  timer.clear();
+  const HighResClockTimepoint start = std::chrono::high_resolution_clock::now();
+  PartitionedHypergraph partitioned_hg = partition(hypergraph, context);
+  const HighResClockTimepoint end = std::chrono::high_resolution_clock::now();
+  const double total_time = std::chrono::duration<double>(end - start).count();
+
+  utils::MemoryTreeNode hypergraph_memory("Partitioned Hypergraph", utils::OutputType::BYTES);
+  partitioned_hg.memoryConsumption(&hypergraph_memory);
+  hypergraph_memory.finalize();
+  utils::MemoryTreeNode memory_pool("Memory Pool", utils::OutputType::BYTES);
+  pool.memory_consumption(&memory_pool);
+  memory_pool.finalize();
+
+  out << (first_record ? "" : ",") << "\n    {"
+      << "\"instance\":\"" << escapeJSON(instance) << "\""
+      << ",\"preset\":\"" << preset_name << "\""
+      << ",\"threads\":" << num_threads
+      << ",\"repetition\":" << repetition
+      << ",\"seed\":" << seed
+      << ",\"num_nodes\":" << input.initialNumNodes()
+      << ",\"num_edges\":" << input.initialNumEdges()
+      << ",\"total_time\":" << total_time
+      << ",\"km1\":" << metrics::km1(partitioned_hg)
+      << ",\"cut\":" << metrics::hyperedgeCut(partitioned_hg)
+      << ",\"soed\":" << metrics::soed(partitioned_hg)
+      << ",\"imbalance\":" << metrics::imbalance(partitioned_hg, context)
+      << ",\"max_rss_bytes\":" << maxResidentSetSizeInBytes()
+      << ",\"memory\":";
+  hypergraph_memory.serializeJSON(out);
+  out << ",\"memory_pool\":";
+  memory_pool.serializeJSON(out);
+  out << ",\"timings\":";
+  timer.serializeJSON(out);
+  out << "}";
+
+  // Progress is written to stderr, since the JSON output might go to stdout
+  std::cerr << instance << " preset=" << preset_name << " threads=" << num_threads
+            << " repetition=" << repetition << " time=" << total_time << "s"
+            << " " << config.objective << "=" << metrics::objective(partitioned_hg, config.objective)
+            << std::endl;
+
+  // All data structures allocated from the memory pool
+  // are destroyed at the end of this function
+  pool.reset();
+  pool.disable_memory_requests();
+}
+
+int main(int argc, char* argv[]) {
+  BenchmarkConfig config;
+  std::string instance_list;
+
+  po::options_description options("Options");
+  options.add_options()
+    ("help", "show help message")
+    ("instances,i",
+    po::value<std::vector<std::string>>(&config.instances)->value_name("<string>")->multitoken(),
+    "Hypergraph files of the instance suite")
+    ("instance-list",
+    po::value<std::string>(&instance_list)->value_name("<string>"),
+    "File containing one hypergraph file per line (added to --instances)")
+    ("input-file-format",
+    po::value<std::string>()->value_name("<string>")->notifier([&](const std::string& s) {
+      if ( s == "hmetis" ) {
+        config.file_format = FileFormat::hMetis;
+      } else if ( s == "metis" ) {
+        config.file_format = FileFormat::Metis;
+      } else if ( s == "snapshot" ) {
+        config.file_format = FileFormat::Snapshot;
+      } else if ( s == "shared_snapshot" ) {
+        config.file_format = FileFormat::SharedSnapshot;
+      } else {
+        ERR("Illegal input file format: " + s);
+      }
+    }),
+    "Input file format of all instances (hmetis, metis, snapshot or shared_snapshot; default: hmetis)")
+    ("presets,p",
+    po::value<std::vector<std::string>>(&config.presets)->value_name("<string>")->multitoken(),
+    "Preset types (deterministic, default, default_flows, quality, quality_flows; default: default)")
+    ("threads,t",
+    po::value<std::vector<size_t>>(&config.threads)->value_name("<size_t>")->multitoken(),
+    "Thread counts (default: 1)")
+    ("repetitions,r",
+    po::value<size_t>(&config.repetitions)->value_name("<size_t>"),
+    "Number of repetitions with different seeds (default: 1)")
+    ("blocks,k",
+    po::value<PartitionID>(&config.k)->value_name("<int>"),
+    "Number of blocks (default: 2)")
+    ("epsilon,e",
+    po::value<double>(&config.epsilon)->value_name("<double>"),
+    "Imbalance (default: 0.03)")
+    ("objective,o",
+    po::value<std::string>()->value_name("<string>")->notifier([&](const std::string& s) {
+      if ( s == "cut" ) {
+        config.objective = Objective::cut;
+      } else if ( s == "km1" ) {
+        config.objective = Objective::km1;
+      } else {
+        ERR("Illegal objective function: " + s);
+      }
+    }),
+    "Objective function (cut or km1; default: km1)")
+    ("seed,s",
+    po::value<int>(&config.seed)->value_name("<int>"),
+    "Seed of the first repetition (repetition i uses seed + i; default: 0)")
+    ("output,f",
+    po::value<std::string>(&config.output_file)->value_name("<string>"),
+    "JSON output file (default: stdout)");
+
+  po::variables_map cmd_vm;
+  po::store(po::parse_command_line(argc, argv, options), cmd_vm);
+  if ( cmd_vm.count("help") != 0 || argc == 1 ) {
+    LOG << options;
+    return 0;
+  }
+  po::notify(cmd_vm);
+
+  if ( !instance_list.empty() ) {
+    std::ifstream file(instance_list);
+    if ( !file ) {
+      ERR("Could not open instance list: " + instance_list);
+    }
+    std::string line;
+    while ( std::getline(file, line) ) {
+      if ( !line.empty() && line[0] != '#' ) {
+        config.instances.push_back(line);
+      }
+    }
+  }
+  if ( config.instances.empty() ) {
+    ERR("No instances given (use --instances or --instance-list)");
+  }
+  for ( const std::string& preset : config.presets ) {
+    presetTypeFromString(preset);
+  }
+
+  // The thread pool is initialized with the maximum thread count. Each run is
+  // executed in a task arena that limits the number of threads.
+  const size_t num_available_cpus = HardwareTopology::instance().num_cpus();
+  for ( size_t& num_threads : config.threads ) {
+    if ( num_threads == 0 || num_threads > num_available_cpus ) {
+      WARNING("Setting number of threads from" << num_threads << "to" << num_available_cpus);
+      num_threads = num_available_cpus;
+    }
+  }
+  TBBInitializer::instance(*std::max_element(config.threads.begin(), config.threads.end()));
+
+  std::ofstream output_file;
+  if ( !config.output_file.empty() ) {
+    output_file.open(config.output_file);
+    if ( !output_file ) {
+      ERR("Could not open output file: " + config.output_file);
+    }
+  }
+  std::ostream& out = config.output_file.empty() ? std::cout : output_file;
+
+  out << "{\n  \"k\":" << config.k
+      << ",\n  \"epsilon\":" << config.epsilon
+      << ",\n  \"objective\":\"" << config.objective << "\""
+      << ",\n  \"runs\":[";
+  bool first_record = true;
+  for ( const std::string& instance : config.instances ) {
+    Hypergraph hypergraph = io::readInputFile(instance, config.file_format, true);
+    for ( const std::string& preset : config.presets ) {
+      for ( const size_t num_threads : config.threads ) {
+        tbb::task_arena arena(static_cast<int>(num_threads));
+        for ( size_t repetition = 0; repetition < config.repetitions; ++repetition ) {
+          arena.execute([&] {
+            runBenchmark(hypergraph, config, instance, preset,
+              num_threads, repetition, first_record, out);
+          });
+          first_record = false;
+        }
+      }
+    }
+  }
+  out << "\n  ]\n}" << std::endl;
+
+  parallel::MemoryPool::instance().free_memory_chunks();
+  TBBInitializer::instance().terminate();
+  return 0;
+}
@@ -31,6 +31,8 @@
 #include <sstream>
 #include <string>
 
+#include "tbb/parallel_reduce.h"
+
 #include "mt-kahypar/macros.h"
 #include "mt-kahypar/definitions.h"
 #include "mt-kahypar/partition/context.h"
@@ -44,18 +46,39 @@ bool readPartitionFile(const std::string& partition_file, PartitionedHypergraph&
   bool success = true;
   std::vector<PartitionID> partition;
   mt_kahypar::io::readPartitionFile(partition_file, partition);
-  for ( const HypernodeID& hn : hypergraph.nodes() ) {
+  if ( partition.size() != hypergraph.initialNumNodes() ) {
+    LOG << RED << "[ERROR]" << END << "Partition file contains" << partition.size()
+        << "entries, but the hypergraph has" << hypergraph.initialNumNodes() << "nodes";
+    return false;
+  }
+  // Returns the first node with an invalid block assignment
+  const HypernodeID first_invalid_node = tbb::parallel_reduce(
+    tbb::blocked_range<HypernodeID>(ID(0), hypergraph.initialNumNodes()), kInvalidHypernode,
+    [&](const tbb::blocked_range<HypernodeID>& range, HypernodeID first_invalid) {
+      for ( HypernodeID hn = range.begin(); hn < range.end(); ++hn ) {
+        if ( partition[hn] == kInvalidPartition || partition[hn] >= hypergraph.k() ) {
+          first_invalid = std::min(first_invalid, hn);
+        } else {
+          hypergraph.setOnlyNodePart(hn, partition[hn]);
+        }
+      }
+      return first_invalid;
+    }, [](const HypernodeID lhs, const HypernodeID rhs) {
+      return std::min(lhs, rhs);
+    });
+
+  if ( first_invalid_node != kInvalidHypernode ) {
+    const HypernodeID hn = first_invalid_node;
     if ( partition[hn] == kInvalidPartition ) {
       LOG << RED << "[ERROR]" << END << "Hypernode" << hn << "is not assigned to a block";
-      success = false;
-    } else if ( partition[hn] >= hypergraph.k() ) {
+    } else {
       LOG << RED << "[ERROR]" << END << "Hypernode" << hn << "is assigned to block"
           << ( partition[hn] + 1 ) << ", but there are only" << hypergraph.k() << "blocks";
-      success = false;
     }
-    hypergraph.setOnlyNodePart(hn, partition[hn]);
+    success = false;
+  } else {
+    hypergraph.initializePartition();
   }
-  hypergraph.initializePartition();
   return success;
 }
 
@@ -75,14 +98,26 @@ int main(int argc, char* argv[]) {
            "Number of Blocks")
            ("epsilon,e",
            po::value<double>(&context.partition.epsilon)->value_name("<double>")->required(),
-           "Imbalance");
+           "Imbalance")
+          ("input-file-format",
+            po::value<std::string>()->value_name("<string>")->notifier([&](const std::string& s) {
+              if (s == "hmetis") {
+                context.partition.file_format = FileFormat::hMetis;
+              } else if (s == "metis") {
+                context.partition.file_format = FileFormat::Metis;
+              }
+            }),
+            "Input file format: \n"
+            " - hmetis : hMETIS hypergraph file format \n"
+            " - metis : METIS graph file format");
 
   po::variables_map cmd_vm;
   po::store(po::parse_command_line(argc, argv, options), cmd_vm);
   po::notify(cmd_vm);
 
   // Read Hypergraph
-  Hypergraph hg = mt_kahypar::io::readHypergraphFile(context.partition.graph_filename, true);
+  Hypergraph hg = mt_kahypar::io::readInputFile(
+    context.partition.graph_filename, context.partition.file_format, true, false);
   PartitionedHypergraph phg(context.partition.k, hg, parallel_tag_t());
 
   // Setup Context
@@ -90,6 +125,9 @@ int main(int argc, char* argv[]) {
 
   // Read Partition File
   bool success = readPartitionFile(context.partition.graph_partition_filename, phg);
+  if ( !success ) {
+    return -1;
+  }
 
   for ( PartitionID i = 0; i < context.partition.k; ++i ) {
     if ( phg.partWeight(i) == 0 ) {
@@ -103,5 +141,15 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  std::string graph_name = context.partition.graph_filename.substr(
+    context.partition.graph_filename.find_last_of("/") + 1);
+  std::cout << "RESULT graph=" << graph_name
+            << " k=" << context.partition.k
+            << " epsilon=" << context.partition.epsilon
+            << " cut=" << metrics::hyperedgeCut(phg, true)
+            << " km1=" << metrics::km1(phg, true)
+            << " imbalance=" << metrics::imbalance(phg, context)
+            << " valid=" << success << std::endl;
+
   return success ? 0 : -1;
 }